@@ -13,6 +13,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QEventLoop>
+#include <QtCore/QJsonObject>
 #include <QtCore/QStandardPaths>
 #include <QtNetwork/QNetworkDiskCache>
 #include <QtNetwork/QNetworkRequest>
@@ -22,6 +23,7 @@
 #include <AnimationCacheScriptingInterface.h>
 #include <AssetClient.h>
 #include <AvatarHashMap.h>
+#include <AudioInjector.h>
 #include <AudioInjectorManager.h>
 #include <AssetClient.h>
 #include <DebugDraw.h>
@@ -94,6 +96,9 @@ Agent::Agent(ReceivedMessage& message) :
     DependencyManager::set<AudioScriptingInterface>();
     DependencyManager::set<AudioInjectorManager>();
 
+    // the audio mixer sits next to us and can fetch our sounds itself, so only control injectors from here
+    AudioInjector::setHostedInjectionEnabled(true);
+
     DependencyManager::set<recording::Deck>();
     DependencyManager::set<recording::Recorder>();
     DependencyManager::set<recording::ClipCache>();
@@ -150,7 +155,7 @@ void Agent::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNo
             // pull out the piggybacked packet and create a new QSharedPointer<NLPacket> for it
             int piggyBackedSizeWithHeader = message->getSize() - statsMessageLength;
 
-            auto buffer = std::unique_ptr<char[]>(new char[piggyBackedSizeWithHeader]);
+            auto buffer = udt::PacketBufferPool::allocate(piggyBackedSizeWithHeader);
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggyBackedSizeWithHeader);
 
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggyBackedSizeWithHeader, message->getSenderSockAddr());
@@ -545,6 +550,35 @@ QUuid Agent::getSessionUUID() const {
     return DependencyManager::get<NodeList>()->getSessionUUID();
 }
 
+void Agent::sendStatsPacket() {
+    QJsonObject statsObject;
+
+    // what a load test needs to know of each of its bots: whether it is playing its recording, and the round trip to
+    // and the traffic with the mixers, as this agent sees them
+    QJsonObject botStats;
+    auto recordingInterface = DependencyManager::get<RecordingScriptingInterface>();
+    botStats["is_avatar"] = _isAvatar;
+    botStats["is_playing_recording"] = recordingInterface->isPlaying();
+    botStats["recording_elapsed_s"] = recordingInterface->playerElapsed();
+    botStats["recording_length_s"] = recordingInterface->playerLength();
+    statsObject["bot_stats"] = botStats;
+
+    QJsonObject mixersObject;
+    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+        if (node->getType() != NodeType::AvatarMixer && node->getType() != NodeType::AudioMixer) {
+            return;
+        }
+        QJsonObject mixerStats;
+        mixerStats["ping_ms"] = node->getPingMs();
+        mixerStats["outbound_kbps"] = node->getOutboundKbps();
+        mixerStats["inbound_kbps"] = node->getInboundKbps();
+        mixersObject[NodeType::getNodeTypeName(node->getType())] = mixerStats;
+    });
+    statsObject["mixers"] = mixersObject;
+
+    addPacketStatsAndSendStatsPacket(statsObject);
+}
+
 void Agent::setIsListeningToAudioStream(bool isListeningToAudioStream) {
     // this must happen on Agent's main thread
     if (QThread::currentThread() != thread()) {
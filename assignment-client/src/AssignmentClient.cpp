@@ -27,6 +27,7 @@
 #include <LogUtils.h>
 #include <LimitedNodeList.h>
 #include <NodeList.h>
+#include <plugins/PluginManager.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <ShutdownEventListener.h>
@@ -97,9 +98,15 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
         qCDebug(assignment_client) << "- will attempt to connect to domain-server on" << _assignmentServerSocket.getPort();
     }
 
+    // load the codec libraries now, while this is still a spare, rather than once an audio mixer is assigned
+    PluginManager::preloadPluginLibraries(&PluginManager::isCodecPlugin);
+
     connect(&_requestTimer, SIGNAL(timeout()), SLOT(sendAssignmentRequest()));
     _requestTimer.start(ASSIGNMENT_REQUEST_INTERVAL_MSECS);
 
+    // don't wait for the first tick of the timer to ask for an assignment
+    QTimer::singleShot(0, this, &AssignmentClient::sendAssignmentRequest);
+
     // connections to AccountManager for authentication
     connect(DependencyManager::get<AccountManager>().data(), &AccountManager::authRequired,
             this, &AssignmentClient::handleAuthenticationRequest);
@@ -156,6 +163,9 @@ void AssignmentClient::setUpStatusToMonitor() {
     // send a stats packet every 1 seconds
     connect(&_statsTimerACM, &QTimer::timeout, this, &AssignmentClient::sendStatusPacketToACM);
     _statsTimerACM.start(1000);
+
+    // let the monitor count this child as a spare right away
+    QTimer::singleShot(0, this, &AssignmentClient::sendStatusPacketToACM);
 }
 
 void AssignmentClient::sendStatusPacketToACM() {
@@ -168,10 +178,14 @@ void AssignmentClient::sendStatusPacketToACM() {
         assignmentType = _currentAssignment->getType();
     }
 
-    auto statusPacket = NLPacket::create(PacketType::AssignmentClientStatus, sizeof(assignmentType) + NUM_BYTES_RFC4122_UUID);
+    qint64 pid = QCoreApplication::applicationPid();
+
+    auto statusPacket = NLPacket::create(PacketType::AssignmentClientStatus,
+                                         sizeof(assignmentType) + NUM_BYTES_RFC4122_UUID + sizeof(pid));
 
     statusPacket->write(_childAssignmentUUID.toRfc4122());
     statusPacket->writePrimitive(assignmentType);
+    statusPacket->writePrimitive(pid);
     
     nodeList->sendPacket(std::move(statusPacket), _assignmentClientMonitorSocket);
 }
@@ -257,6 +271,11 @@ void AssignmentClient::handleCreateAssignmentPacket(QSharedPointer<ReceivedMessa
 
         // Starts an event loop, and emits workerThread->started()
         workerThread->start();
+
+        // the monitor starts another spare as soon as it hears this one is taken
+        if (!_assignmentClientMonitorSocket.isNull()) {
+            sendStatusPacketToACM();
+        }
     } else {
         qCWarning(assignment_client) << "ALERT: Received an assignment that could not be unpacked. Re-requesting.";
     }
@@ -324,4 +343,11 @@ void AssignmentClient::assignmentCompleted() {
     nodeList->resetNodeInterestSet();
     
     _isAssigned = false;
+
+    if (!_assignmentClientMonitorSocket.isNull()) {
+        sendStatusPacketToACM();
+    }
+
+    // ask for the next assignment right away
+    sendAssignmentRequest();
 }
@@ -15,6 +15,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QPointer>
 
+#include "MetricsExporter.h"
 #include "ThreadedAssignment.h"
 
 class QSharedMemory;
@@ -53,6 +54,7 @@ private:
     QTimer _requestTimer; // timer for requesting and assignment
     QTimer _statsTimerACM; // timer for sending stats to assignment client monitor
     QUuid _childAssignmentUUID = QUuid::createUuid();
+    MetricsExporter _metricsExporter;
 
  protected:
     HifiSockAddr _assignmentClientMonitorSocket;
@@ -90,6 +90,11 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     const QCommandLineOption maxChildsOption(ASSIGNMENT_MAX_FORKS_OPTION, "maximum number of children", "child-count");
     parser.addOption(maxChildsOption);
 
+    const QCommandLineOption numSparesOption(ASSIGNMENT_NUM_SPARES_OPTION,
+                                             "number of idle children to keep ready for assignments (default: 1)",
+                                             "child-count");
+    parser.addOption(numSparesOption);
+
     const QCommandLineOption monitorPortOption(ASSIGNMENT_CLIENT_MONITOR_PORT_OPTION, "assignment-client monitor port", "port");
     parser.addOption(monitorPortOption);
 
@@ -135,6 +140,11 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
         maxForks = parser.value(maxChildsOption).toInt();
     }
 
+    unsigned int numSpares = 1;
+    if (parser.isSet(numSparesOption)) {
+        numSpares = parser.value(numSparesOption).toInt();
+    }
+
     unsigned short monitorPort = 0;
     if (parser.isSet(monitorPortOption)) {
         monitorPort = parser.value(monitorPortOption).toUShort();
@@ -242,12 +252,14 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
 
     LogHandler::getInstance().moveToThread(thread());
     LogHandler::getInstance().setupRepeatedMessageFlusher();
+    LogHandler::getInstance().setCategoryRateLimit(DEFAULT_CATEGORY_RATE_LIMIT);
+    LogHandler::getInstance().startAsyncWriter();
 
     DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
     DependencyManager::set<ScriptInitializers>();
 
     if (numForks || minForks || maxForks) {
-        AssignmentClientMonitor* monitor =  new AssignmentClientMonitor(numForks, minForks, maxForks,
+        AssignmentClientMonitor* monitor =  new AssignmentClientMonitor(numForks, minForks, maxForks, numSpares,
                                                                         requestAssignmentType, assignmentPool, listenPort,
                                                                         childMinListenPort, walletUUID, assignmentServerHostname,
                                                                         assignmentServerPort, httpStatusPort, logDirectory);
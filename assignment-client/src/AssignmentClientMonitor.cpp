@@ -39,6 +39,7 @@ void* PROCESS_GROUP = createProcessGroup();
 AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmentClientForks,
                                                  const unsigned int minAssignmentClientForks,
                                                  const unsigned int maxAssignmentClientForks,
+                                                 const unsigned int numSpareAssignmentClients,
                                                  Assignment::Type requestAssignmentType, QString assignmentPool,
                                                  quint16 listenPort, quint16 childMinListenPort, QUuid walletUUID, QString assignmentServerHostname,
                                                  quint16 assignmentServerPort, quint16 httpStatusServerPort, QString logDirectory) :
@@ -46,6 +47,7 @@ AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmen
     _numAssignmentClientForks(numAssignmentClientForks),
     _minAssignmentClientForks(minAssignmentClientForks),
     _maxAssignmentClientForks(maxAssignmentClientForks),
+    _numSpareAssignmentClients(numSpareAssignmentClients),
     _requestAssignmentType(requestAssignmentType),
     _assignmentPool(assignmentPool),
     _walletUUID(walletUUID),
@@ -122,10 +124,29 @@ void AssignmentClientMonitor::childProcessFinished(qint64 pid, quint16 listenPor
             qCritical() << qPrintable(message.arg("crashed"));
             break;
     }
+
+    // forget the child now rather than once it has gone silent, so that it isn't counted while it is replaced
+    auto nodeList = DependencyManager::get<NodeList>();
+    QUuid finishedNodeID;
+    nodeList->eachNode([&](const SharedNodePointer& node) {
+        auto childData = static_cast<AssignmentClientChildData*>(node->getLinkedData());
+        if (childData && childData->getPID() == pid) {
+            finishedNodeID = node->getUUID();
+        }
+    });
+    if (!finishedNodeID.isNull()) {
+        nodeList->killNodeWithUUID(finishedNodeID);
+    }
+
+    if (!_isStopping) {
+        scheduleCheckSpares();
+    }
 }
 
 void AssignmentClientMonitor::stopChildProcesses() {
     qDebug() << "Stopping child processes";
+    _isStopping = true;
+    _checkSparesTimer.stop();
     auto nodeList = DependencyManager::get<NodeList>();
 
     // ask child processes to terminate
@@ -284,33 +305,60 @@ void AssignmentClientMonitor::spawnChildClient() {
     }
 }
 
+void AssignmentClientMonitor::scheduleCheckSpares() {
+    // a child finishing or taking an assignment is a spare less, don't wait for the timer to replace it
+    if (!_isCheckSparesScheduled) {
+        _isCheckSparesScheduled = true;
+        QTimer::singleShot(0, this, &AssignmentClientMonitor::checkSpares);
+    }
+}
+
 void AssignmentClientMonitor::checkSpares() {
+    _isCheckSparesScheduled = false;
+    if (_isStopping) {
+        return;
+    }
+
     auto nodeList = DependencyManager::get<NodeList>();
     QUuid aSpareId = "";
     unsigned int spareCount = 0;
-    unsigned int totalCount = 0;
+    unsigned int nodeCount = 0;
+    QSet<qint64> reportedPIDs;
 
     nodeList->removeSilentNodes();
 
     nodeList->eachNode([&](const SharedNodePointer& node) {
         AssignmentClientChildData* childData = static_cast<AssignmentClientChildData*>(node->getLinkedData());
-        totalCount ++;
+        nodeCount++;
+        reportedPIDs.insert(childData->getPID());
         if (childData->getChildType() == Assignment::Type::AllTypes) {
             ++spareCount;
             aSpareId = node->getUUID();
         }
     });
 
+    // children that are still starting up haven't reported yet, but they will be spares once they have
+    for (auto pid : _childProcesses.keys()) {
+        if (!reportedPIDs.contains(pid)) {
+            ++spareCount;
+        }
+    }
+    unsigned int totalCount = std::max(nodeCount, (unsigned int)_childProcesses.size());
+
     // Spawn or kill children, as needed.  If --min or --max weren't specified, allow the child count
     // to drift up or down as far as needed.
 
-    if (spareCount < 1 || totalCount < _minAssignmentClientForks) {
-        if (!_maxAssignmentClientForks || totalCount < _maxAssignmentClientForks) {
-            spawnChildClient();
+    while (spareCount < _numSpareAssignmentClients || totalCount < _minAssignmentClientForks) {
+        if (_maxAssignmentClientForks && totalCount >= _maxAssignmentClientForks) {
+            break;
         }
+        spawnChildClient();
+        ++spareCount;
+        ++totalCount;
     }
 
-    if (spareCount > 1) {
+    // only a spare that has reported can be asked to exit, one at a time so that the count is right again next time
+    if (spareCount > _numSpareAssignmentClients && !aSpareId.isNull()) {
         if (!_minAssignmentClientForks || totalCount > _minAssignmentClientForks) {
             // kill aSpareId
             qDebug() << "asking child" << aSpareId << "to exit.";
@@ -368,7 +416,18 @@ void AssignmentClientMonitor::handleChildStatusPacket(QSharedPointer<ReceivedMes
         quint8 assignmentType;
         message->readPrimitive(&assignmentType);
 
+        // older children don't send their process ID
+        if (message->getBytesLeftToRead() >= (qint64)sizeof(qint64)) {
+            qint64 pid;
+            message->readPrimitive(&pid);
+            childData->setPID(pid);
+        }
+
+        bool wasSpare = childData->getChildType() == Assignment::Type::AllTypes;
         childData->setChildType(Assignment::Type(assignmentType));
+        if (wasSpare && childData->getChildType() != Assignment::Type::AllTypes) {
+            scheduleCheckSpares();
+        }
 
         // note when this child talked
         matchingNode->setLastHeardMicrostamp(usecTimestampNow());
@@ -36,7 +36,8 @@ class AssignmentClientMonitor : public QObject, public HTTPRequestHandler {
     Q_OBJECT
 public:
     AssignmentClientMonitor(const unsigned int numAssignmentClientForks, const unsigned int minAssignmentClientForks,
-                            const unsigned int maxAssignmentClientForks, Assignment::Type requestAssignmentType,
+                            const unsigned int maxAssignmentClientForks, const unsigned int numSpareAssignmentClients,
+                            Assignment::Type requestAssignmentType,
                             QString assignmentPool, quint16 listenPort, quint16 childMinListenPort, QUuid walletUUID,
                             QString assignmentServerHostname, quint16 assignmentServerPort, quint16 httpStatusServerPort,
                             QString logDirectory);
@@ -55,6 +56,7 @@ public slots:
 
 private:
     void spawnChildClient();
+    void scheduleCheckSpares();
     void simultaneousWaitOnChildren(int waitMsecs);
     void adjustOSResources(unsigned int numForks) const;
 
@@ -68,6 +70,10 @@ private:
     const unsigned int _minAssignmentClientForks;
     const unsigned int _maxAssignmentClientForks;
 
+    // idle children kept running with their libraries loaded, so that an assignment that goes down
+    // is picked up again by one that is already started rather than waiting for a new process
+    const unsigned int _numSpareAssignmentClients;
+
     Assignment::Type _requestAssignmentType;
     QString _assignmentPool;
     QUuid _walletUUID;
@@ -80,6 +86,8 @@ private:
     QSet<quint16> _childListenPorts;
 
     bool _wantsChildFileLogging { false };
+    bool _isStopping { false };
+    bool _isCheckSparesScheduled { false };
 };
 
 #endif // hifi_AssignmentClientMonitor_h
@@ -0,0 +1,60 @@
+//
+//  MetricsExporter.cpp
+//  assignment-client/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MetricsExporter.h"
+
+#include <limits>
+
+#include <QtCore/QProcessEnvironment>
+#include <QtNetwork/QTcpServer>
+
+#include <HTTPConnection.h>
+#include <udt/NetworkMetrics.h>
+
+#include "AssignmentClientLogging.h"
+
+static const QString METRICS_PORT_ENV = "HIFI_METRICS_PORT";
+static const int MAX_METRICS_PORT_ATTEMPTS = 64;
+static const char* OPENMETRICS_CONTENT_TYPE = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+MetricsExporter::MetricsExporter(QObject* parent) :
+    QObject(parent)
+{
+    bool ok = false;
+    int basePort = QProcessEnvironment::systemEnvironment().value(METRICS_PORT_ENV).toInt(&ok);
+    if (!ok || basePort <= 0) {
+        return;
+    }
+
+    // HTTPManager exits the process if it cannot bind, so find a port it will get first
+    for (int port = basePort; port < basePort + MAX_METRICS_PORT_ATTEMPTS && port <= std::numeric_limits<quint16>::max(); ++port) {
+        QTcpServer probe;
+        if (probe.listen(QHostAddress::AnyIPv4, port)) {
+            probe.close();
+
+            _httpManager.reset(new HTTPManager(QHostAddress::AnyIPv4, port, "", this));
+            qCDebug(assignment_client) << "Serving network metrics on port" << port;
+            return;
+        }
+    }
+
+    qCWarning(assignment_client) << "Could not find a free port for network metrics starting at" << basePort;
+}
+
+bool MetricsExporter::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
+    if (url.path() == "/metrics") {
+        connection->respond(HTTPConnection::StatusCode200, udt::NetworkMetrics::getInstance().toOpenMetrics(),
+                            OPENMETRICS_CONTENT_TYPE);
+    } else {
+        connection->respond(HTTPConnection::StatusCode404);
+    }
+
+    return true;
+}
@@ -0,0 +1,37 @@
+//
+//  MetricsExporter.h
+//  assignment-client/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MetricsExporter_h
+#define hifi_MetricsExporter_h
+
+#include <memory>
+
+#include <QtCore/QObject>
+
+#include <HTTPManager.h>
+
+// Serves the process' udt::NetworkMetrics at /metrics for Prometheus style scrapers.
+//
+// Enabled by setting HIFI_METRICS_PORT. Forked assignment clients share the environment, so each one takes the first
+// free port at or after it.
+class MetricsExporter : public QObject, public HTTPRequestHandler {
+    Q_OBJECT
+public:
+    MetricsExporter(QObject* parent = nullptr);
+
+    bool isEnabled() const { return (bool)_httpManager; }
+
+    bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
+
+private:
+    std::unique_ptr<HTTPManager> _httpManager;
+};
+
+#endif // hifi_MetricsExporter_h
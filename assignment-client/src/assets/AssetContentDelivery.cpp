@@ -0,0 +1,65 @@
+//
+//  AssetContentDelivery.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetContentDelivery.h"
+
+#include <algorithm>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QUrlQuery>
+
+#include "AssetServerLogging.h"
+
+static const QString CDN_BASE_URL_OPTION = "cdn_base_url";
+static const QString CDN_SIGNING_KEY_OPTION = "cdn_signing_key";
+static const QString CDN_MIN_FILE_SIZE_OPTION = "cdn_min_file_size";
+static const QString CDN_URL_LIFETIME_OPTION = "cdn_url_lifetime";
+
+void AssetContentDelivery::readSettings(const QJsonObject& assetServerSettings) {
+    auto baseURL = QUrl(assetServerSettings[CDN_BASE_URL_OPTION].toString());
+    auto signingKey = assetServerSettings[CDN_SIGNING_KEY_OPTION].toString().toUtf8();
+    if (baseURL.isEmpty()) {
+        return;
+    }
+
+    if (!baseURL.isValid() || (baseURL.scheme() != "http" && baseURL.scheme() != "https") || signingKey.isEmpty()) {
+        qCWarning(asset_server) << "Not sending assets through" << baseURL << "- it needs to be an HTTP URL with a signing key";
+        return;
+    }
+
+    // the hashes go under the base URL, not in place of its last part
+    if (!baseURL.path().endsWith('/')) {
+        baseURL.setPath(baseURL.path() + '/');
+    }
+
+    _baseURL = baseURL;
+    _signer.setKey(signingKey.constData(), signingKey.size());
+    _minFileSize = (qint64)assetServerSettings[CDN_MIN_FILE_SIZE_OPTION].toInt(DEFAULT_MIN_FILE_SIZE_KB) * 1024;
+    _urlLifetime = std::max(assetServerSettings[CDN_URL_LIFETIME_OPTION].toInt(DEFAULT_URL_LIFETIME_SECS), 1);
+
+    qCInfo(asset_server) << "Sending assets of" << _minFileSize << "bytes or more through" << _baseURL;
+}
+
+QUrl AssetContentDelivery::getSignedURL(const QString& hexHash) const {
+    auto expires = QString::number(QDateTime::currentSecsSinceEpoch() + _urlLifetime);
+    auto signedText = (hexHash + ":" + expires).toUtf8();
+
+    HMACAuth::HMACHash signature;
+    _signer.calculateHash(signature, signedText.constData(), signedText.size());
+
+    QUrlQuery query;
+    query.addQueryItem("expires", expires);
+    query.addQueryItem("signature",
+        QByteArray(reinterpret_cast<const char*>(signature.data()), (int)signature.size()).toHex());
+
+    QUrl url = _baseURL.resolved(QUrl(hexHash));
+    url.setQuery(query);
+    return url;
+}
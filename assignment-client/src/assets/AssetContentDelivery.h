@@ -0,0 +1,47 @@
+//
+//  AssetContentDelivery.h
+//  assignment-client/src/assets
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetContentDelivery_h
+#define hifi_AssetContentDelivery_h
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+
+#include <HMACAuth.h>
+
+// Sends clients that ask for big assets to an HTTP server that has a copy of the asset files directory, such as a CDN,
+// rather than sending the bytes over the asset server's own connections. The URLs are the file's hash under the base
+// URL, signed so that the HTTP server can tell they came from the asset server and haven't expired:
+//
+//  <base URL><hash>?expires=<unix time>&signature=<hex HMAC-SHA256 of "<hash>:<unix time>" with the signing key>
+//
+// Clients ask the HTTP server for the same byte range they asked the asset server for.
+class AssetContentDelivery {
+public:
+    static const int DEFAULT_MIN_FILE_SIZE_KB = 1024;
+    static const int DEFAULT_URL_LIFETIME_SECS = 300;
+
+    // reads the settings from the asset server's section of the domain settings
+    void readSettings(const QJsonObject& assetServerSettings);
+
+    bool isEnabled() const { return _baseURL.isValid(); }
+    bool shouldRedirect(qint64 fileSize) const { return isEnabled() && fileSize >= _minFileSize; }
+
+    QUrl getSignedURL(const QString& hexHash) const;
+
+private:
+    QUrl _baseURL;
+    mutable HMACAuth _signer { HMACAuth::SHA256 };
+    qint64 _minFileSize { 0 };
+    int _urlLifetime { DEFAULT_URL_LIFETIME_SECS };
+};
+
+#endif // hifi_AssetContentDelivery_h
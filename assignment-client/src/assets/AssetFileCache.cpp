@@ -0,0 +1,96 @@
+//
+//  AssetFileCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetFileCache.h"
+
+#include <QtCore/QMutexLocker>
+
+AssetFileCache::MappedFile::~MappedFile() {
+    if (_data && _size > 0) {
+        _file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(_data)));
+    }
+}
+
+bool AssetFileCache::MappedFile::map() {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    _size = _file.size();
+    if (_size == 0) {
+        return true;
+    }
+    _data = reinterpret_cast<const char*>(_file.map(0, _size));
+    return _data != nullptr;
+}
+
+void AssetFileCache::setBudget(qint64 budget) {
+    QMutexLocker locker(&_mutex);
+    _budget = budget;
+    evict();
+}
+
+void AssetFileCache::evict() {
+    while (_bytesCached > _budget && !_order.empty()) {
+        auto it = _entries.find(_order.back());
+        _bytesCached -= it->file->getSize();
+        _entries.erase(it);
+        _order.pop_back();
+    }
+}
+
+AssetFileCache::MappedFilePointer AssetFileCache::getFile(const QDir& directory, const QString& hexHash) {
+    {
+        QMutexLocker locker(&_mutex);
+        auto it = _entries.find(hexHash);
+        if (it != _entries.end()) {
+            _order.splice(_order.begin(), _order, it->position);
+            _hits++;
+            return it->file;
+        }
+        _misses++;
+    }
+
+    // map the file without holding the lock, the disk can be slow
+    MappedFilePointer file { new MappedFile(directory.filePath(hexHash)) };
+    if (!file->map()) {
+        return MappedFilePointer();
+    }
+
+    QMutexLocker locker(&_mutex);
+    if (file->getSize() <= _budget / MAX_FILE_BUDGET_DIVISOR && !_entries.contains(hexHash)) {
+        _order.push_front(hexHash);
+        _entries.insert(hexHash, { file, _order.begin() });
+        _bytesCached += file->getSize();
+        evict();
+    }
+    return file;
+}
+
+void AssetFileCache::removeFile(const QString& hexHash) {
+    QMutexLocker locker(&_mutex);
+    auto it = _entries.find(hexHash);
+    if (it != _entries.end()) {
+        _bytesCached -= it->file->getSize();
+        _order.erase(it->position);
+        _entries.erase(it);
+    }
+}
+
+QJsonObject AssetFileCache::getStats() const {
+    QMutexLocker locker(&_mutex);
+    QJsonObject stats;
+    stats["1. Budget (B)"] = (double)_budget;
+    stats["2. Cached (B)"] = (double)_bytesCached;
+    stats["3. Cached Files"] = _entries.size();
+    stats["4. Hits"] = (double)_hits;
+    stats["5. Misses"] = (double)_misses;
+    stats["6. Hit Rate"] = _hits + _misses > 0 ? (double)_hits / (double)(_hits + _misses) : 0.0;
+    return stats;
+}
@@ -0,0 +1,80 @@
+//
+//  AssetFileCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetFileCache_h
+#define hifi_AssetFileCache_h
+
+#include <list>
+#include <memory>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+
+// Keeps the asset files that were asked for most recently memory mapped, up to a budget of bytes, so that popular
+// assets are served from memory rather than read from disk for every request. Asset files are named by the hash of
+// what is in them and never change, so a file only has to be dropped when it is deleted.
+class AssetFileCache {
+public:
+    class MappedFile {
+    public:
+        ~MappedFile();
+
+        const char* getData() const { return _data; }
+        qint64 getSize() const { return _size; }
+
+    private:
+        friend class AssetFileCache;
+        MappedFile(const QString& filePath) : _file(filePath) {}
+        bool map();
+
+        QFile _file;
+        const char* _data { nullptr };
+        qint64 _size { 0 };
+    };
+    using MappedFilePointer = std::shared_ptr<MappedFile>;
+
+    // files bigger than this part of the budget are mapped for the one request but not kept
+    static const int MAX_FILE_BUDGET_DIVISOR = 4;
+
+    void setBudget(qint64 budget);
+
+    // the file with the hash in the directory, or null when there is no such file. it stays mapped for as long as it is
+    // held, even once it has been pushed out of the cache.
+    MappedFilePointer getFile(const QDir& directory, const QString& hexHash);
+
+    void removeFile(const QString& hexHash);
+
+    QJsonObject getStats() const;
+
+private:
+    using Order = std::list<QString>;
+
+    class Entry {
+    public:
+        MappedFilePointer file;
+        Order::iterator position;
+    };
+
+    void evict();
+
+    mutable QMutex _mutex;
+    qint64 _budget { 0 };
+    qint64 _bytesCached { 0 };
+    QHash<QString, Entry> _entries;
+    Order _order; // most recently used first
+
+    quint64 _hits { 0 };
+    quint64 _misses { 0 };
+};
+
+#endif // hifi_AssetFileCache_h
@@ -12,6 +12,9 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <thread>
 #include <memory>
 
@@ -23,7 +26,6 @@
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QJsonDocument>
-#include <QtCore/QSaveFile>
 #include <QtCore/QString>
 #include <QtGui/QImageReader>
 #include <QtCore/QVector>
@@ -125,12 +127,73 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
         connect(task.get(), &BakeAssetTask::bakeFailed, this, &AssetServer::handleFailedBake);
         connect(task.get(), &BakeAssetTask::bakeAborted, this, &AssetServer::handleAbortedBake);
 
+        task->setNiceness(_bakeNiceness);
         _bakingTaskPool.start(task.get());
     } else {
         qDebug() << "Already in queue";
     }
 }
 
+void AssetServer::prioritizeBake(const AssetUtils::AssetHash& assetHash) {
+    auto it = _pendingBakes.find(assetHash);
+    if (it == _pendingBakes.end() || !_bakingTaskPool.tryTake(it->get())) {
+        // not baking this asset, or the oven already has it
+        return;
+    }
+
+    if (_lastBakePriority == std::numeric_limits<int>::max()) {
+        // what has been asked for already stays ahead of what hasn't
+        _lastBakePriority = 0;
+    }
+    _bakingTaskPool.start(it->get(), ++_lastBakePriority);
+}
+
+void AssetServer::finishBake(const AssetUtils::AssetHash& assetHash, bool succeeded) {
+    auto it = _pendingBakes.find(assetHash);
+    if (it == _pendingBakes.end()) {
+        return;
+    }
+
+    auto startTime = (*it)->getStartTime();
+    if (startTime > 0) {
+        _totalBakeTime += usecTimestampNow() - startTime;
+        if (succeeded) {
+            ++_numCompletedBakes;
+        } else {
+            ++_numFailedBakes;
+        }
+    }
+    _pendingBakes.erase(it);
+}
+
+QJsonObject AssetServer::getBakingStats() const {
+    int numBaking = 0;
+    for (const auto& task : _pendingBakes) {
+        if (task->isBaking()) {
+            ++numBaking;
+        }
+    }
+    int numQueued = _pendingBakes.size() - numBaking;
+    int concurrency = _bakingTaskPool.maxThreadCount();
+
+    QJsonObject stats;
+    stats["1. Queued"] = numQueued;
+    stats["2. Baking"] = numBaking;
+    stats["3. Concurrency"] = concurrency;
+    stats["4. Completed"] = _numCompletedBakes;
+    stats["5. Failed"] = _numFailedBakes;
+
+    int numFinished = _numCompletedBakes + _numFailedBakes;
+    if (numFinished > 0) {
+        float averageBakeTime = (float)_totalBakeTime / numFinished / USECS_PER_SECOND;
+        stats["6. Avg Bake (s)"] = averageBakeTime;
+
+        // the ones baking now are counted as having all of their time left
+        stats["7. ETA (s)"] = averageBakeTime * _pendingBakes.size() / std::max(concurrency, 1);
+    }
+    return stats;
+}
+
 QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash) {
     return _filesDirectory.absoluteFilePath(assetHash);
 }
@@ -424,8 +487,16 @@ void AssetServer::completeSetup() {
         return;
     }
 
-    // load whatever mappings we currently have from the local file
-    if (loadMappingsFromFile()) {
+    // get how many assets are baked at once and how far their priority is lowered, before any bakes are started
+    static const QString BAKE_CONCURRENCY_OPTION = "bake_concurrency";
+    static const QString BAKE_NICENESS_OPTION = "bake_niceness";
+    static const int DEFAULT_BAKE_CONCURRENCY = 1;
+    static const int DEFAULT_BAKE_NICENESS = 10;
+    _bakingTaskPool.setMaxThreadCount(std::max(assetServerObject[BAKE_CONCURRENCY_OPTION].toInt(DEFAULT_BAKE_CONCURRENCY), 1));
+    _bakeNiceness = assetServerObject[BAKE_NICENESS_OPTION].toInt(DEFAULT_BAKE_NICENESS);
+
+    // load whatever mappings we currently have from the local files
+    if (_fileMappings.open(_resourcesDirectory)) {
         qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
 
         // Check the asset directory to output some information about what we have
@@ -458,6 +529,15 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get how much memory to keep the most requested asset files mapped in
+    static const QString HOT_ASSET_CACHE_SIZE_OPTION = "hot_asset_cache_size";
+    static const int DEFAULT_HOT_ASSET_CACHE_SIZE = 256;
+    static const qint64 BYTES_PER_MEGABYTES = 1000 * 1000;
+    auto hotAssetCacheSize = assetServerObject[HOT_ASSET_CACHE_SIZE_OPTION].toInt(DEFAULT_HOT_ASSET_CACHE_SIZE);
+    _fileCache.setBudget((qint64)std::max(hotAssetCacheSize, 0) * BYTES_PER_MEGABYTES);
+
+    _contentDelivery.readSettings(assetServerObject);
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -527,20 +607,15 @@ void AssetServer::cleanupUnmappedFiles() {
     for (const auto& fileInfo : files) {
         auto filename = fileInfo.fileName();
         if (hashFileRegex.exactMatch(filename)) {
-            bool matched { false };
-            for (auto& pair : _fileMappings) {
-                if (pair.second == filename) {
-                    matched = true;
-                    break;
-                }
-            }
-            if (!matched) {
+            if (!_fileMappings.isMapped(filename)) {
                 // remove the unmapped file
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
                     qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
 
+                    _fileCache.removeFile(filename);
+
                     removeBakedPathsForDeletedAsset(filename);
                 } else {
                     qCDebug(asset_server) << "\tAttempt to delete unmapped file" << filename << "failed";
@@ -555,27 +630,19 @@ void AssetServer::cleanupBakedFilesForDeletedAssets() {
 
     std::set<AssetUtils::AssetHash> bakedHashes;
 
-    for (const auto& it : _fileMappings) {
-        // check if this is a mapping to baked content
-        if (it.first.startsWith(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER)) {
-            // extract the hash from the baked mapping
-            AssetUtils::AssetHash hash = it.first.mid(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER.length(),
-                                                      AssetUtils::SHA256_HASH_HEX_LENGTH);
+    for (const auto& path : _fileMappings.getPathsWithPrefix(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER)) {
+        // extract the hash from the baked mapping
+        AssetUtils::AssetHash hash = path.mid(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER.length(),
+                                              AssetUtils::SHA256_HASH_HEX_LENGTH);
 
-            // add the hash to our set of hashes for which we have baked content
-            bakedHashes.insert(hash);
-        }
+        // add the hash to our set of hashes for which we have baked content
+        bakedHashes.insert(hash);
     }
 
     // enumerate the hashes for which we have baked content
     for (const auto& hash : bakedHashes) {
         // check if we have a mapping that points to this hash
-        auto matchingMapping = std::find_if(std::begin(_fileMappings), std::end(_fileMappings),
-                                            [&hash](const std::pair<AssetUtils::AssetPath, AssetUtils::AssetHash> mappingPair) {
-            return mappingPair.second == hash;
-        });
-
-        if (matchingMapping == std::end(_fileMappings)) {
+        if (!_fileMappings.isMapped(hash)) {
             // we didn't find a mapping for this hash, remove any baked content we still have for it
             removeBakedPathsForDeletedAsset(hash);
         }
@@ -604,7 +671,7 @@ void AssetServer::handleAssetMappingOperation(QSharedPointer<ReceivedMessage> me
             handleGetMappingOperation(*message, *replyPacket);
             break;
         case AssetMappingOperationType::GetAll:
-            handleGetAllMappingOperation(*replyPacket);
+            handleGetAllMappingOperation(*message, *replyPacket);
             break;
         case AssetMappingOperationType::Set:
             handleSetMappingOperation(*message, canWriteToAssetServer, *replyPacket);
@@ -639,6 +706,9 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
 
         // check if we should re-direct to a baked asset
         auto originalAssetHash = it->second;
+
+        // someone wants this asset now, so a bake of it that hasn't started goes first
+        prioritizeBake(originalAssetHash);
         QString redirectedAssetHash;
         quint8 wasRedirected = false;
         bool bakingDisabled = false;
@@ -701,14 +771,32 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
     }
 }
 
-void AssetServer::handleGetAllMappingOperation(NLPacketList& replyPacket) {
-    replyPacket.writePrimitive(AssetUtils::AssetServerError::NoError);
+void AssetServer::handleGetAllMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket) {
+    // clients from before pages were added ask for every mapping at once
+    bool isPaged = message.getBytesLeftToRead() > 0;
+    AssetUtils::AssetPath afterPath;
+    uint32_t limit = std::numeric_limits<uint32_t>::max();
+    if (isPaged) {
+        afterPath = message.readString();
+        message.readPrimitive(&limit);
+    }
 
-    uint32_t count = (uint32_t)_fileMappings.size();
+    auto begin = _fileMappings.lowerBound(afterPath);
+    if (begin != _fileMappings.cend() && !afterPath.isEmpty() && begin->first == afterPath) {
+        ++begin;
+    }
+    auto end = begin;
+    uint32_t count = 0;
+    while (end != _fileMappings.cend() && count < limit) {
+        ++end;
+        ++count;
+    }
+
+    replyPacket.writePrimitive(AssetUtils::AssetServerError::NoError);
 
     replyPacket.writePrimitive(count);
 
-    for (auto it = _fileMappings.cbegin(); it != _fileMappings.cend(); ++ it) {
+    for (auto it = begin; it != end; ++it) {
         auto mapping = it->first;
         auto hash = it->second;
         replyPacket.writeString(mapping);
@@ -722,6 +810,11 @@ void AssetServer::handleGetAllMappingOperation(NLPacketList& replyPacket) {
             replyPacket.writeString(lastBakeErrors);
         }
     }
+
+    if (isPaged) {
+        // where the next page starts, or nothing once this is the last one
+        replyPacket.writeString(end != _fileMappings.cend() && count > 0 ? std::prev(end)->first : AssetUtils::AssetPath());
+    }
 }
 
 void AssetServer::handleSetMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket) {
@@ -867,7 +960,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _fileCache, _contentDelivery);
     _transferTaskPool.start(task);
 }
 
@@ -957,99 +1050,13 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    serverStats["Asset Cache"] = _fileCache.getStats();
+    serverStats["Baking"] = getBakingStats();
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
 
-static const QString MAP_FILE_NAME = "map.json";
-
-bool AssetServer::loadMappingsFromFile() {
-
-    auto mapFilePath = _resourcesDirectory.absoluteFilePath(MAP_FILE_NAME);
-
-    QFile mapFile { mapFilePath };
-    if (mapFile.exists()) {
-        if (mapFile.open(QIODevice::ReadOnly)) {
-            QJsonParseError error;
-
-            auto jsonDocument = QJsonDocument::fromJson(mapFile.readAll(), &error);
-
-            if (error.error == QJsonParseError::NoError) {
-                if (!jsonDocument.isObject()) {
-                    qCWarning(asset_server) << "Failed to read mapping file, root value in" << mapFilePath << "is not an object";
-                    return false;
-                }
-
-                //_fileMappings = jsonDocument.object().toVariantHash();
-                auto root = jsonDocument.object();
-                for (auto it = root.begin(); it != root.end(); ++it) {
-                    auto key = it.key();
-                    auto value = it.value();
-
-                    if (!value.isString()) {
-                        qCWarning(asset_server) << "Skipping" << key << ":" << value << "because it is not a string";
-                        continue;
-                    }
-
-                    if (!AssetUtils::isValidFilePath(key)) {
-                        qCWarning(asset_server) << "Will not keep mapping for" << key << "since it is not a valid path.";
-                        continue;
-                    }
-
-                    if (!AssetUtils::isValidHash(value.toString())) {
-                        qCWarning(asset_server) << "Will not keep mapping for" << key << "since it does not have a valid hash.";
-                        continue;
-                    }
-
-
-                    qDebug() << "Added " << key << value.toString();
-                    _fileMappings[key] = value.toString();
-                }
-
-                qCInfo(asset_server) << "Loaded" << _fileMappings.size() << "mappings from map file at" << mapFilePath;
-                return true;
-            }
-        }
-
-        qCCritical(asset_server) << "Failed to read mapping file at" << mapFilePath;
-        return false;
-    } else {
-        qCInfo(asset_server) << "No existing mappings loaded from file since no file was found at" << mapFilePath;
-    }
-
-    return true;
-}
-
-bool AssetServer::writeMappingsToFile() {
-    auto mapFilePath = _resourcesDirectory.absoluteFilePath(MAP_FILE_NAME);
-
-    QSaveFile mapFile { mapFilePath };
-    if (mapFile.open(QIODevice::WriteOnly)) {
-        QJsonObject root;
-
-        for (auto it : _fileMappings) {
-            root[it.first] = it.second;
-        }
-
-        QJsonDocument jsonDocument { root };
-
-        if (mapFile.write(jsonDocument.toJson()) != -1) {
-            if (mapFile.commit()) {
-                qCDebug(asset_server) << "Wrote JSON mappings to file at" << mapFilePath;
-                return true;
-            } else {
-                qCWarning(asset_server) << "Failed to commit JSON mappings to file at" << mapFilePath;
-            }
-        } else {
-            qCWarning(asset_server) << "Failed to write JSON mappings to file at" << mapFilePath;
-        }
-    } else {
-        qCWarning(asset_server) << "Failed to open map file at" << mapFilePath;
-    }
-
-    return false;
-}
-
 bool AssetServer::setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash hash) {
     path = path.trimmed();
 
@@ -1063,27 +1070,15 @@ bool AssetServer::setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash h
         return false;
     }
 
-    // remember what the old mapping was in case persistence fails
-    auto it = _fileMappings.find(path);
-    auto oldMapping = it != _fileMappings.end() ? it->second : "";
+    MappingStore::Transaction transaction;
+    transaction.set(path, hash);
 
-    // update the in memory QHash
-    _fileMappings[path] = hash;
-
-    // attempt to write to file
-    if (writeMappingsToFile()) {
-        // persistence succeeded, we are good to go
+    // the mapping only changes once it has been persisted
+    if (_fileMappings.commit(transaction)) {
         qCDebug(asset_server) << "Set mapping:" << path << "=>" << hash;
         maybeBake(path, hash);
         return true;
     } else {
-        // failed to persist this mapping to file - put back the old one in our in-memory representation
-        if (oldMapping.isEmpty()) {
-            _fileMappings.erase(_fileMappings.find(path));
-        } else {
-            _fileMappings[path] = oldMapping;
-        }
-
         qCWarning(asset_server) << "Failed to persist mapping:" << path << "=>" << hash;
 
         return false;
@@ -1107,8 +1102,7 @@ void AssetServer::removeBakedPathsForDeletedAsset(AssetUtils::AssetHash hash) {
 }
 
 bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
-    // take a copy of the current mappings in case persistence of these deletes fails
-    auto oldMappings = _fileMappings;
+    MappingStore::Transaction transaction;
 
     QSet<QString> hashesToCheckForDeletion;
 
@@ -1118,24 +1112,17 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
 
         // figure out if this path will delete a file or folder
         if (pathIsFolder(path)) {
-            // enumerate the in memory file mappings and remove anything that matches
-            auto it = _fileMappings.begin();
-            auto sizeBefore = _fileMappings.size();
+            // find the file mappings in the folder and remove them
+            auto folderPaths = _fileMappings.getPathsWithPrefix(path);
+            for (const auto& folderPath : folderPaths) {
+                // add this hash to the list we need to check for asset removal from the server
+                hashesToCheckForDeletion << _fileMappings.find(folderPath)->second;
 
-            while (it != _fileMappings.end()) {
-                if (it->first.startsWith(path)) {
-                    // add this hash to the list we need to check for asset removal from the server
-                    hashesToCheckForDeletion << it->second;
-
-                    it = _fileMappings.erase(it);
-                } else {
-                    ++it;
-                }
+                transaction.remove(folderPath);
             }
 
-            auto sizeNow = _fileMappings.size();
-            if (sizeBefore != sizeNow) {
-                qCDebug(asset_server) << "Deleted" << sizeBefore - sizeNow << "mappings in folder: " << path;
+            if (!folderPaths.empty()) {
+                qCDebug(asset_server) << "Deleted" << folderPaths.size() << "mappings in folder: " << path;
             } else {
                 qCDebug(asset_server) << "Did not find any mappings to delete in folder:" << path;
             }
@@ -1147,34 +1134,30 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
                 hashesToCheckForDeletion << it->second;
 
                 qCDebug(asset_server) << "Deleted a mapping:" << path << "=>" << it->second;
-                
-                _fileMappings.erase(it);
+
+                transaction.remove(path);
             } else {
                 qCDebug(asset_server) << "Unable to delete a mapping that was not found:" << path;
             }
         }
     }
 
-    // deleted the old mappings, attempt to persist to file
-    if (writeMappingsToFile()) {
-        // persistence succeeded we are good to go
-
-        // TODO iterate through hashesToCheckForDeletion instead
-        for (auto& pair : _fileMappings) {
-            auto it = hashesToCheckForDeletion.find(pair.second);
-            if (it != hashesToCheckForDeletion.end()) {
-                hashesToCheckForDeletion.erase(it);
+    // the mappings are only deleted once that has been persisted
+    if (_fileMappings.commit(transaction)) {
+        // we now have a set of hashes that may be unmapped - we will delete those asset files
+        for (auto& hash : hashesToCheckForDeletion) {
+            if (_fileMappings.isMapped(hash)) {
+                continue;
             }
-        }
 
-        // we now have a set of hashes that are unmapped - we will delete those asset files
-        for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
 
+                _fileCache.removeFile(hash);
+
                 removeBakedPathsForDeletedAsset(hash);
             } else {
                 qCDebug(asset_server) << "\tAttempt to delete unmapped file" << hash << "failed";
@@ -1185,9 +1168,6 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
     } else {
         qCWarning(asset_server) << "Failed to persist deleted mappings, rolling back";
 
-        // we didn't delete the previous mapping, put it back in our in-memory representation
-        _fileMappings = oldMappings;
-
         return false;
     }
 }
@@ -1212,35 +1192,22 @@ bool AssetServer::renameMapping(AssetUtils::AssetPath oldPath, AssetUtils::Asset
             return false;
         }
 
-        // take a copy of the old mappings
-        auto oldMappings = _fileMappings;
+        // move every mapping in the renamed folder
+        MappingStore::Transaction transaction;
+        for (const auto& oldKey : _fileMappings.getPathsWithPrefix(oldPath)) {
+            auto newKey = oldKey;
+            newKey.replace(0, oldPath.size(), newPath);
 
-        // iterate the current mappings and adjust any that matches the renamed folder
-        auto it = oldMappings.begin();
-
-        while (it != oldMappings.end()) {
-            auto& oldKey = it->first;
-            if (oldKey.startsWith(oldPath)) {
-                auto newKey = oldKey;
-                newKey.replace(0, oldPath.size(), newPath);
-
-                // remove the old version from the in memory file mappings
-                _fileMappings.erase(_fileMappings.find(oldKey));
-                _fileMappings[newKey] = it->second;
-            }
-
-            ++it;
+            transaction.remove(oldKey);
+            transaction.set(newKey, _fileMappings.find(oldKey)->second);
         }
 
-        if (writeMappingsToFile()) {
+        if (_fileMappings.commit(transaction)) {
             // persisted the changed mappings, return success
             qCDebug(asset_server) << "Renamed folder mapping:" << oldPath << "=>" << newPath;
 
             return true;
         } else {
-            // couldn't persist the renamed paths, rollback and return failure
-            _fileMappings = oldMappings;
-
             qCWarning(asset_server) << "Failed to persist renamed folder mapping:" << oldPath << "=>" << newPath;
 
             return false;
@@ -1255,38 +1222,24 @@ bool AssetServer::renameMapping(AssetUtils::AssetPath oldPath, AssetUtils::Asset
 
         // take the old hash to remove the old mapping
         auto it = _fileMappings.find(oldPath);
-        auto oldSourceMapping = it->second;
-        _fileMappings.erase(it);
-
-        // in case we're overwriting, keep the current destination mapping for potential rollback
-        auto oldDestinationIt = _fileMappings.find(newPath);
-
-        if (!oldSourceMapping.isEmpty()) {
-            _fileMappings[newPath] = oldSourceMapping;
-
-            if (writeMappingsToFile()) {
-                // persisted the renamed mapping, return success
-                qCDebug(asset_server) << "Renamed mapping:" << oldPath << "=>" << newPath;
-
-                return true;
-            } else {
-                // we couldn't persist the renamed mapping, rollback and return failure
-                _fileMappings[oldPath] = oldSourceMapping;
+        if (it == _fileMappings.end() || it->second.isEmpty()) {
+            // failed to find a mapping that was to be renamed, return failure
+            return false;
+        }
 
-                if (oldDestinationIt != _fileMappings.end()) {
-                    // put back the overwritten mapping for the destination path
-                    _fileMappings[newPath] = oldDestinationIt->second;
-                } else {
-                    // clear the new mapping
-                    _fileMappings.erase(_fileMappings.find(newPath));
-                }
+        // this overwrites whatever the destination was mapped to
+        MappingStore::Transaction transaction;
+        transaction.remove(oldPath);
+        transaction.set(newPath, it->second);
 
-                qCDebug(asset_server) << "Failed to persist renamed mapping:" << oldPath << "=>" << newPath;
+        if (_fileMappings.commit(transaction)) {
+            // persisted the renamed mapping, return success
+            qCDebug(asset_server) << "Renamed mapping:" << oldPath << "=>" << newPath;
 
-                return false;
-            }
+            return true;
         } else {
-            // failed to find a mapping that was to be renamed, return failure
+            qCDebug(asset_server) << "Failed to persist renamed mapping:" << oldPath << "=>" << newPath;
+
             return false;
         }
     }
@@ -1309,7 +1262,7 @@ void AssetServer::handleFailedBake(QString originalAssetHash, QString assetPath,
 
     writeMetaFile(originalAssetHash, meta);
 
-    _pendingBakes.remove(originalAssetHash);
+    finishBake(originalAssetHash, false);
 }
 
 void AssetServer::handleCompletedBake(QString originalAssetHash, QString originalAssetPath,
@@ -1332,7 +1285,7 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
 
         writeMetaFile(originalAssetHash, meta);
 
-        _pendingBakes.remove(originalAssetHash);
+        finishBake(originalAssetHash, !errorCompletingBake);
     };
 
     bool errorCompletingBake { false };
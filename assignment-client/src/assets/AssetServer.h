@@ -13,12 +13,16 @@
 #define hifi_AssetServer_h
 
 #include <QtCore/QDir>
+#include <QtCore/QJsonObject>
 #include <QtCore/QThreadPool>
 #include <QRunnable>
 
 #include <ThreadedAssignment.h>
 
+#include "AssetContentDelivery.h"
+#include "AssetFileCache.h"
 #include "AssetUtils.h"
+#include "MappingStore.h"
 #include "ReceivedMessage.h"
 
 #include "RegisteredMetaTypes.h"
@@ -41,6 +45,7 @@ enum class BakedAssetType : int {
 enum class ModelBakeVersion : BakeVersion {
     Initial = INITIAL_BAKE_VERSION,
     MetaTextureJson,
+    MeshLods,
 
     COUNT
 };
@@ -49,6 +54,7 @@ enum class ModelBakeVersion : BakeVersion {
 enum class TextureBakeVersion : BakeVersion {
     Initial = INITIAL_BAKE_VERSION,
     MetaTextureJson,
+    BasisTextures,
 
     COUNT
 };
@@ -95,7 +101,7 @@ private:
     void replayRequests();
 
     void handleGetMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket);
-    void handleGetAllMappingOperation(NLPacketList& replyPacket);
+    void handleGetAllMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket);
     void handleSetMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
     void handleDeleteMappingsOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
     void handleRenameMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
@@ -104,10 +110,6 @@ private:
     void handleAssetServerBackup(ReceivedMessage& message, NLPacketList& replyPacket);
     void handleAssetServerRestore(ReceivedMessage& message, NLPacketList& replyPacket);
 
-    // Mapping file operations must be called from main assignment thread only
-    bool loadMappingsFromFile();
-    bool writeMappingsToFile();
-
     /// Set the mapping for path to hash
     bool setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash hash);
 
@@ -136,6 +138,11 @@ private:
     bool needsToBeBaked(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& assetHash);
     void bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
 
+    /// Move a bake still waiting for the oven ahead of the others, for an asset that was just asked for
+    void prioritizeBake(const AssetUtils::AssetHash& assetHash);
+    void finishBake(const AssetUtils::AssetHash& assetHash, bool succeeded);
+    QJsonObject getBakingStats() const;
+
     /// Move baked content for asset to baked directory and update baked status
     void handleCompletedBake(QString originalAssetHash, QString assetPath, QString bakedTempOutputDir);
     void handleFailedBake(QString originalAssetHash, QString assetPath, QString errors);
@@ -148,7 +155,8 @@ private:
     /// Remove baked paths when the original asset is deleteds
     void removeBakedPathsForDeletedAsset(AssetUtils::AssetHash originalAssetHash);
 
-    AssetUtils::Mappings _fileMappings;
+    // Mapping operations must be called from main assignment thread only
+    MappingStore _fileMappings;
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
@@ -156,8 +164,22 @@ private:
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
+    /// The asset files most recently sent, kept mapped in memory for the download tasks
+    AssetFileCache _fileCache;
+
+    /// Where big assets are sent from instead, when there is somewhere
+    AssetContentDelivery _contentDelivery;
+
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
+    int _bakeNiceness { 0 };
+
+    // bakes for assets that were asked for go ahead of the rest, the most recently asked for first
+    int _lastBakePriority { 0 };
+
+    int _numCompletedBakes { 0 };
+    int _numFailedBakes { 0 };
+    quint64 _totalBakeTime { 0 };
 
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
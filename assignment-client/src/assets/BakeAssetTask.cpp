@@ -11,12 +11,25 @@
 
 #include "BakeAssetTask.h"
 
+#include <algorithm>
 #include <mutex>
 
 #include <QtCore/QThread>
 #include <QCoreApplication>
 
 #include <PathUtils.h>
+#include <SharedUtil.h>
+
+#ifdef Q_OS_WIN
+#include <Windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 static const int OVEN_STATUS_CODE_SUCCESS { 0 };
 static const int OVEN_STATUS_CODE_FAIL { 1 };
@@ -24,6 +37,43 @@ static const int OVEN_STATUS_CODE_ABORT { 2 };
 
 std::once_flag registerMetaTypesFlag;
 
+static const int MAX_NICENESS { 19 };
+
+// lowers the priority of the oven so that it bakes with what the asset server doesn't need for sending assets
+static void lowerProcessPriority(QProcess& process, int niceness) {
+    if (niceness <= 0) {
+        return;
+    }
+    niceness = std::min(niceness, MAX_NICENESS);
+
+#ifdef Q_OS_WIN
+    // Windows lowers the IO priority of the process along with its priority class
+    auto priorityClass = niceness == MAX_NICENESS ? IDLE_PRIORITY_CLASS : BELOW_NORMAL_PRIORITY_CLASS;
+    if (!SetPriorityClass(process.pid()->hProcess, priorityClass)) {
+        qWarning() << "Failed to lower the priority of the oven process";
+    }
+#else
+    auto pid = process.processId();
+    if (setpriority(PRIO_PROCESS, (id_t)pid, niceness) != 0) {
+        qWarning() << "Failed to lower the CPU priority of the oven process";
+    }
+
+#ifdef Q_OS_LINUX
+    // a best effort IO priority from 0 to 7, or only when the disk is idle at the most nice
+    static const int IOPRIO_WHO_PROCESS { 1 };
+    static const int IOPRIO_CLASS_SHIFT { 13 };
+    static const int IOPRIO_CLASS_BE { 2 };
+    static const int IOPRIO_CLASS_IDLE { 3 };
+    static const int IOPRIO_BE_LEVELS { 8 };
+    int ioPriority = niceness == MAX_NICENESS ? (IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT)
+        : (IOPRIO_CLASS_BE << IOPRIO_CLASS_SHIFT) | (niceness * IOPRIO_BE_LEVELS / (MAX_NICENESS + 1));
+    if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, (int)pid, ioPriority) != 0) {
+        qWarning() << "Failed to lower the IO priority of the oven process";
+    }
+#endif
+#endif
+}
+
 BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) :
     _assetHash(assetHash),
     _assetPath(assetPath),
@@ -125,6 +175,9 @@ void BakeAssetTask::run() {
         return;
     }
 
+    lowerProcessPriority(*_ovenProcess, _niceness);
+
+    _startTime = usecTimestampNow();
     _isBaking = true;
 
     loop.exec();
@@ -27,9 +27,13 @@ class BakeAssetTask : public QObject, public QRunnable {
 public:
     BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
 
+    // how far below normal the oven's CPU and IO priority is, from 0 (not lowered) to 19 (only when idle)
+    void setNiceness(int niceness) { _niceness = niceness; }
+
     // Thread-safe inspection methods
     bool isBaking() { return _isBaking.load(); }
     bool wasAborted() const { return _wasAborted.load(); }
+    quint64 getStartTime() const { return _startTime.load(); }
 
     void run() override;
 
@@ -48,6 +52,8 @@ private:
     QString _filePath;
     std::unique_ptr<QProcess> _ovenProcess { nullptr };
     std::atomic<bool> _wasAborted { false };
+    std::atomic<quint64> _startTime { 0 };
+    int _niceness { 0 };
 };
 
 #endif // hifi_BakeAssetTask_h
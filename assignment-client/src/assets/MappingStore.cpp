@@ -0,0 +1,244 @@
+//
+//  MappingStore.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MappingStore.h"
+
+#include <algorithm>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+
+#include "AssetServerLogging.h"
+
+static const QString MAP_FILE_NAME = "map.json";
+static const QString JOURNAL_FILE_NAME = "map.journal";
+
+static const QString JOURNAL_REMOVE_KEY = "remove";
+static const QString JOURNAL_SET_KEY = "set";
+
+// the snapshot isn't rewritten for a journal smaller than this, however few mappings there are
+static const qint64 MIN_JOURNAL_SIZE_TO_COMPACT = 64 * 1024;
+
+bool MappingStore::open(const QDir& directory) {
+    _directory = directory;
+    if (!readSnapshot() || !readJournal()) {
+        return false;
+    }
+
+    qCInfo(asset_server) << "Loaded" << _mappings.size() << "mappings from" << _directory.absolutePath();
+    return true;
+}
+
+bool MappingStore::readSnapshot() {
+    auto mapFilePath = _directory.absoluteFilePath(MAP_FILE_NAME);
+
+    QFile mapFile { mapFilePath };
+    if (!mapFile.exists()) {
+        qCInfo(asset_server) << "No existing mappings loaded from file since no file was found at" << mapFilePath;
+        return true;
+    }
+
+    if (!mapFile.open(QIODevice::ReadOnly)) {
+        qCCritical(asset_server) << "Failed to read mapping file at" << mapFilePath;
+        return false;
+    }
+
+    _snapshotSize = mapFile.size();
+
+    QJsonParseError error;
+    auto jsonDocument = QJsonDocument::fromJson(mapFile.readAll(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        qCCritical(asset_server) << "Failed to read mapping file at" << mapFilePath;
+        return false;
+    }
+
+    if (!jsonDocument.isObject()) {
+        qCWarning(asset_server) << "Failed to read mapping file, root value in" << mapFilePath << "is not an object";
+        return false;
+    }
+
+    auto root = jsonDocument.object();
+    for (auto it = root.begin(); it != root.end(); ++it) {
+        auto key = it.key();
+        auto value = it.value();
+
+        if (!value.isString()) {
+            qCWarning(asset_server) << "Skipping" << key << ":" << value << "because it is not a string";
+            continue;
+        }
+
+        if (!AssetUtils::isValidFilePath(key)) {
+            qCWarning(asset_server) << "Will not keep mapping for" << key << "since it is not a valid path.";
+            continue;
+        }
+
+        if (!AssetUtils::isValidHash(value.toString())) {
+            qCWarning(asset_server) << "Will not keep mapping for" << key << "since it does not have a valid hash.";
+            continue;
+        }
+
+        setMapping(key, value.toString());
+    }
+
+    return true;
+}
+
+bool MappingStore::readJournal() {
+    _journal.setFileName(_directory.absoluteFilePath(JOURNAL_FILE_NAME));
+    if (!_journal.open(QIODevice::ReadWrite | QIODevice::Append)) {
+        qCCritical(asset_server) << "Failed to open mapping journal at" << _journal.fileName();
+        return false;
+    }
+
+    _journal.seek(0);
+    int numTransactions = 0;
+    while (!_journal.atEnd()) {
+        auto line = _journal.readLine();
+
+        QJsonParseError error;
+        auto jsonDocument = QJsonDocument::fromJson(line, &error);
+        if (error.error != QJsonParseError::NoError || !jsonDocument.isObject()) {
+            // only the last transaction can be cut short, by the asset server going down while writing it
+            if (_journal.atEnd()) {
+                qCWarning(asset_server) << "Ignoring an unfinished transaction at the end of" << _journal.fileName();
+                break;
+            }
+            qCCritical(asset_server) << "Failed to read mapping journal at" << _journal.fileName();
+            return false;
+        }
+
+        Transaction transaction;
+        auto root = jsonDocument.object();
+        for (const auto& path : root[JOURNAL_REMOVE_KEY].toArray()) {
+            transaction.remove(path.toString());
+        }
+        auto sets = root[JOURNAL_SET_KEY].toObject();
+        for (auto it = sets.begin(); it != sets.end(); ++it) {
+            transaction.set(it.key(), it.value().toString());
+        }
+        apply(transaction);
+        numTransactions++;
+    }
+
+    if (numTransactions > 0) {
+        qCInfo(asset_server) << "Replayed" << numTransactions << "mapping transactions from" << _journal.fileName();
+
+        // start again from a snapshot of all of it, which also drops anything left unfinished
+        if (!writeSnapshot()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MappingStore::commit(const Transaction& transaction) {
+    if (transaction.isEmpty()) {
+        return true;
+    }
+
+    QJsonArray removals;
+    for (const auto& path : transaction._removals) {
+        removals.append(path);
+    }
+    QJsonObject sets;
+    for (const auto& mapping : transaction._sets) {
+        sets[mapping.first] = mapping.second;
+    }
+    QJsonObject root;
+    root[JOURNAL_REMOVE_KEY] = removals;
+    root[JOURNAL_SET_KEY] = sets;
+
+    auto line = QJsonDocument(root).toJson(QJsonDocument::Compact) + '\n';
+    auto journalSize = _journal.size();
+    if (_journal.write(line) != line.size() || !_journal.flush()) {
+        qCWarning(asset_server) << "Failed to write mapping transaction to" << _journal.fileName();
+
+        // don't leave a part of it behind to be read back
+        _journal.resize(journalSize);
+        return false;
+    }
+
+    apply(transaction);
+
+    if (_journal.size() > std::max(_snapshotSize, MIN_JOURNAL_SIZE_TO_COMPACT)) {
+        // it is already in the journal, a snapshot that fails is tried again with the next transaction
+        writeSnapshot();
+    }
+    return true;
+}
+
+bool MappingStore::writeSnapshot() {
+    auto mapFilePath = _directory.absoluteFilePath(MAP_FILE_NAME);
+
+    QJsonObject root;
+    for (const auto& mapping : _mappings) {
+        root[mapping.first] = mapping.second;
+    }
+    auto json = QJsonDocument(root).toJson();
+
+    QSaveFile mapFile { mapFilePath };
+    if (!mapFile.open(QIODevice::WriteOnly) || mapFile.write(json) != json.size() || !mapFile.commit()) {
+        qCWarning(asset_server) << "Failed to write JSON mappings to file at" << mapFilePath;
+        return false;
+    }
+    _snapshotSize = json.size();
+
+    // replaying the journal over the new snapshot would still come out the same if the server went down here
+    if (!_journal.resize(0)) {
+        qCWarning(asset_server) << "Failed to clear mapping journal at" << _journal.fileName();
+    }
+
+    qCDebug(asset_server) << "Wrote JSON mappings to file at" << mapFilePath;
+    return true;
+}
+
+void MappingStore::apply(const Transaction& transaction) {
+    for (const auto& path : transaction._removals) {
+        removeMapping(path);
+    }
+    for (const auto& mapping : transaction._sets) {
+        setMapping(mapping.first, mapping.second);
+    }
+}
+
+void MappingStore::setMapping(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) {
+    auto it = _mappings.find(path);
+    if (it != _mappings.end()) {
+        if (it->second == hash) {
+            return;
+        }
+        removeMapping(path);
+    }
+    _mappings[path] = hash;
+    _hashReferences[hash]++;
+}
+
+void MappingStore::removeMapping(const AssetUtils::AssetPath& path) {
+    auto it = _mappings.find(path);
+    if (it == _mappings.end()) {
+        return;
+    }
+
+    auto referencesIt = _hashReferences.find(it->second);
+    if (referencesIt != _hashReferences.end() && --(*referencesIt) <= 0) {
+        _hashReferences.erase(referencesIt);
+    }
+    _mappings.erase(it);
+}
+
+std::vector<AssetUtils::AssetPath> MappingStore::getPathsWithPrefix(const QString& prefix) const {
+    std::vector<AssetUtils::AssetPath> paths;
+    for (auto it = _mappings.lower_bound(prefix); it != _mappings.end() && it->first.startsWith(prefix); ++it) {
+        paths.push_back(it->first);
+    }
+    return paths;
+}
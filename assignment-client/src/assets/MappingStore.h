@@ -0,0 +1,85 @@
+//
+//  MappingStore.h
+//  assignment-client/src/assets
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MappingStore_h
+#define hifi_MappingStore_h
+
+#include <utility>
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+
+#include "AssetUtils.h"
+
+// The asset server's mappings from paths to hashes, kept sorted in memory so that finding a path or the paths in a
+// folder takes O(log n). On disk they are a snapshot, the map file the asset server has always written, and a journal
+// of the changes made since, one line per transaction. A change only appends its own line, and the snapshot is
+// rewritten once the journal has grown bigger than it. A transaction is applied whole or not at all: it is written to
+// the journal before it changes anything in memory, and a line cut short by a crash is ignored when the journal is read.
+class MappingStore {
+public:
+    using const_iterator = AssetUtils::Mappings::const_iterator;
+
+    class Transaction {
+    public:
+        void set(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) { _sets.emplace_back(path, hash); }
+        void remove(const AssetUtils::AssetPath& path) { _removals.push_back(path); }
+
+        bool isEmpty() const { return _sets.empty() && _removals.empty(); }
+
+    private:
+        friend class MappingStore;
+
+        // removals happen first, so that a path can be removed and set again in one transaction
+        std::vector<AssetUtils::AssetPath> _removals;
+        std::vector<std::pair<AssetUtils::AssetPath, AssetUtils::AssetHash>> _sets;
+    };
+
+    // reads the snapshot and the journal in the directory, returns false if either can't be read
+    bool open(const QDir& directory);
+
+    bool commit(const Transaction& transaction);
+
+    const_iterator begin() const { return _mappings.cbegin(); }
+    const_iterator end() const { return _mappings.cend(); }
+    const_iterator cbegin() const { return _mappings.cbegin(); }
+    const_iterator cend() const { return _mappings.cend(); }
+    const_iterator find(const AssetUtils::AssetPath& path) const { return _mappings.find(path); }
+    size_t size() const { return _mappings.size(); }
+
+    // the first mapping with the path or one that sorts after it
+    const_iterator lowerBound(const AssetUtils::AssetPath& path) const { return _mappings.lower_bound(path); }
+
+    // the paths that start with the prefix, such as everything in a folder
+    std::vector<AssetUtils::AssetPath> getPathsWithPrefix(const QString& prefix) const;
+
+    // whether any path maps to the hash
+    bool isMapped(const AssetUtils::AssetHash& hash) const { return _hashReferences.contains(hash); }
+
+private:
+    void apply(const Transaction& transaction);
+    void setMapping(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash);
+    void removeMapping(const AssetUtils::AssetPath& path);
+
+    bool readSnapshot();
+    bool readJournal();
+    bool writeSnapshot();
+
+    QDir _directory;
+    AssetUtils::Mappings _mappings;
+    QHash<AssetUtils::AssetHash, int> _hashReferences;
+
+    QFile _journal;
+    qint64 _snapshotSize { 0 };
+};
+
+#endif // hifi_MappingStore_h
@@ -11,9 +11,10 @@
 
 #include "SendAssetTask.h"
 
+#include <algorithm>
 #include <cmath>
 
-#include <QFile>
+#include <QtCore/QFileInfo>
 
 #include <DependencyManager.h>
 #include <NetworkLogging.h>
@@ -26,11 +27,14 @@
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             AssetFileCache& fileCache, const AssetContentDelivery& contentDelivery) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _fileCache(fileCache),
+    _contentDelivery(contentDelivery)
 {
     
 }
@@ -60,21 +64,35 @@ void SendAssetTask::run() {
 
     replyPacketList->writePrimitive(messageID);
 
+    QFileInfo fileInfo(_resourcesDir.filePath(hexHash));
+
     if (!byteRange.isValid()) {
         replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
+    } else if (fileInfo.isFile() && _contentDelivery.shouldRedirect(fileInfo.size())) {
+        // the client gets the same range over HTTP instead
+        auto url = _contentDelivery.getSignedURL(hexHash).toEncoded();
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::Redirected);
+        replyPacketList->writePrimitive((AssetUtils::DataOffset)url.size());
+        replyPacketList->write(url);
+
+        qCDebug(networking) << "Redirecting asset: " << hexHash;
     } else {
-        QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
-        QFile file { filePath };
+        auto file = _fileCache.getFile(_resourcesDir, hexHash);
 
-        if (file.open(QIODevice::ReadOnly)) {
+        if (file) {
 
             // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+            byteRange.fixupRange(file->getSize());
+
+            // a range that runs past the end of the file is cut short there, so that clients fetching an asset in
+            // stripes can ask for the first one before they know how big the asset is
+            if (byteRange.fromInclusive >= 0 && byteRange.fromInclusive < file->getSize()) {
+                byteRange.toExclusive = std::min(byteRange.toExclusive, (int64_t)file->getSize());
+            }
 
             // check if we're being asked to read data that we just don't have
             // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
+            if (file->getSize() < byteRange.fromInclusive || file->getSize() < byteRange.toExclusive) {
                 replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " "
                     << byteRange.fromInclusive << ":" << byteRange.toExclusive;
@@ -82,31 +100,17 @@ void SendAssetTask::run() {
                 // we have a valid byte range, handle it and send the asset
                 auto size = byteRange.size();
 
-                if (byteRange.fromInclusive >= 0) {
-
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
-
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
-
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
+                // a negative range starts back from the end of the file
+                auto offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : file->getSize() + byteRange.fromInclusive;
 
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
-                }
+                replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+                replyPacketList->writePrimitive(size);
+                replyPacketList->write(file->getData() + offset, size);
 
                 qCDebug(networking) << "Sending asset: " << hexHash;
             }
-            file.close();
         } else {
-            qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
+            qCDebug(networking) << "Asset not found: " << _resourcesDir.filePath(hexHash) << "(" << hexHash << ")";
             replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
         }
     }
@@ -17,6 +17,8 @@
 #include <QtCore/QString>
 #include <QtCore/QRunnable>
 
+#include "AssetContentDelivery.h"
+#include "AssetFileCache.h"
 #include "AssetUtils.h"
 #include "AssetServer.h"
 #include "Node.h"
@@ -25,7 +27,8 @@ class NLPacket;
 
 class SendAssetTask : public QRunnable {
 public:
-    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir);
+    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                  AssetFileCache& fileCache, const AssetContentDelivery& contentDelivery);
 
     void run() override;
 
@@ -33,6 +36,8 @@ private:
     QSharedPointer<ReceivedMessage> _message;
     SharedNodePointer _senderNode;
     QDir _resourcesDir;
+    AssetFileCache& _fileCache;
+    const AssetContentDelivery& _contentDelivery;
 };
 
 #endif
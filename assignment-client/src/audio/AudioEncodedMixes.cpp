@@ -0,0 +1,81 @@
+//
+//  AudioEncodedMixes.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioEncodedMixes.h"
+
+#include <functional>
+
+#include <QtCore/QHash>
+
+#include <plugins/CodecPlugin.h>
+
+const quint64 AudioEncodedMixes::INITIAL_HISTORY = 0;
+const quint64 AudioEncodedMixes::FLUSHED_HISTORY = 1;
+
+static const quint64 FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const quint64 FNV_PRIME = 1099511628211ULL;
+
+quint64 AudioEncodedMixes::hashFrame(const QByteArray& decodedBuffer) {
+    // 64-bit FNV-1a, the history is a chain of these so it needs more bits than qHash gives
+    quint64 hash = FNV_OFFSET_BASIS;
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(decodedBuffer.constData());
+    for (int i = 0; i < decodedBuffer.size(); ++i) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+quint64 AudioEncodedMixes::nextHistory(quint64 history, quint64 frameHash) {
+    quint64 next = (history ^ frameHash) * FNV_PRIME;
+
+    // keep clear of the reserved values so a history can't be mistaken for a fresh or flushed encoder
+    return next <= FLUSHED_HISTORY ? next + FLUSHED_HISTORY + 1 : next;
+}
+
+size_t AudioEncodedMixes::KeyHasher::operator()(const Key& key) const {
+    size_t hash = qHash(key.codecName);
+    hash = hash * 31 + std::hash<quint64>()(key.history);
+    hash = hash * 31 + std::hash<quint64>()(key.frameHash);
+    return hash;
+}
+
+bool AudioEncodedMixes::find(const QString& codecName, quint64 history, quint64 frameHash,
+                             const QByteArray& decodedBuffer, Encoder& encoder, QByteArray& encodedBuffer) {
+    const EncodedFrame* frame = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _frames.find({ codecName, history, frameHash });
+        if (it == _frames.end()) {
+            return false;
+        }
+        frame = &it->second;
+    }
+
+    // entries are only added until the next clear, so the frame and its encoder can be read without the lock
+    if (frame->decodedBuffer != decodedBuffer) {
+        return false;
+    }
+
+    if (!encoder.isStateless() && !encoder.copyStateFrom(*frame->encoder)) {
+        return false;
+    }
+
+    encodedBuffer = frame->encodedBuffer;
+    return true;
+}
+
+void AudioEncodedMixes::insert(const QString& codecName, quint64 history, quint64 frameHash,
+                               const QByteArray& decodedBuffer, const Encoder& encoder,
+                               const QByteArray& encodedBuffer) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // if another listener got here first with the same frame, theirs is as good as ours
+    _frames.emplace(Key { codecName, history, frameHash }, EncodedFrame { decodedBuffer, encodedBuffer, &encoder });
+}
@@ -0,0 +1,82 @@
+//
+//  AudioEncodedMixes.h
+//  assignment-client/src/audio
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioEncodedMixes_h
+#define hifi_AudioEncodedMixes_h
+
+#include <mutex>
+#include <unordered_map>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+class Encoder;
+
+// The frames encoded for listeners so far this frame, so that a listener whose mix and encoder state match one of
+// them can send that payload instead of running its own encoder.
+//
+// Encoder state is tracked as a history hash that every listener folds each frame it encodes into. Listeners with
+// the same history have fed their encoders the same frames since the codec was set up, or since their encoder was
+// last flushed to silence, so for the same mix they produce the same payload and the listener that reuses it copies
+// the encoder state along with it. Stateless codecs ignore the history.
+class AudioEncodedMixes {
+public:
+    // the history of a freshly set up encoder
+    static const quint64 INITIAL_HISTORY;
+    // the history of an encoder that was flushed to silence, the listener's decoder has been interpolating
+    // toward silence since and does not follow the encoder's exact state anymore
+    static const quint64 FLUSHED_HISTORY;
+
+    static quint64 hashFrame(const QByteArray& decodedBuffer);
+    static quint64 nextHistory(quint64 history, quint64 frameHash);
+
+    bool isEnabled() const { return _isEnabled; }
+    void setEnabled(bool enabled) { _isEnabled = enabled; }
+
+    // thread-safe, returns true and fills encodedBuffer (and the encoder's state) if a listener
+    // already encoded this frame from the same state
+    bool find(const QString& codecName, quint64 history, quint64 frameHash, const QByteArray& decodedBuffer,
+              Encoder& encoder, QByteArray& encodedBuffer);
+
+    // thread-safe, offers a frame this listener encoded itself to the listeners that follow it this frame,
+    // the encoder must not be used again until the next clear
+    void insert(const QString& codecName, quint64 history, quint64 frameHash, const QByteArray& decodedBuffer,
+                const Encoder& encoder, const QByteArray& encodedBuffer);
+
+    // not thread-safe, called between mixes
+    void clear() { _frames.clear(); }
+
+private:
+    struct Key {
+        QString codecName;
+        quint64 history;
+        quint64 frameHash;
+
+        bool operator==(const Key& other) const {
+            return frameHash == other.frameHash && history == other.history && codecName == other.codecName;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct EncodedFrame {
+        QByteArray decodedBuffer; // to rule out hash collisions
+        QByteArray encodedBuffer;
+        const Encoder* encoder;
+    };
+
+    std::mutex _mutex;
+    std::unordered_map<Key, EncodedFrame, KeyHasher> _frames;
+    bool _isEnabled { false };
+};
+
+#endif // hifi_AudioEncodedMixes_h
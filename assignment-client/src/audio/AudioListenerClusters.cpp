@@ -0,0 +1,97 @@
+//
+//  AudioListenerClusters.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioListenerClusters.h"
+
+#include <algorithm>
+#include <functional>
+
+#include <glm/gtx/norm.hpp>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+
+const float AudioListenerClusters::CELL_SIZE = 1.0f;
+const int AudioListenerClusters::NUM_YAW_BUCKETS;
+
+// a source this far from the center is at most a few degrees off for any listener in the cell
+const float AudioListenerClusters::FAR_FIELD_DISTANCE = 8.0f;
+
+// clusters nobody has been in for this long are dropped, along with their HRTF state
+static const unsigned int CLUSTER_EXPIRY_FRAMES = 100;
+
+size_t AudioListenerClusters::KeyHasher::operator()(const Key& key) const {
+    size_t hash = std::hash<int>()(key.cell.x);
+    hash = hash * 31 + std::hash<int>()(key.cell.y);
+    hash = hash * 31 + std::hash<int>()(key.cell.z);
+    hash = hash * 31 + std::hash<int>()(key.yawBucket);
+    hash = hash * 31 + std::hash<float>()(key.masterAvatarGain);
+    hash = hash * 31 + std::hash<float>()(key.masterInjectorGain);
+    return hash;
+}
+
+bool AudioListenerClusters::Cluster::isFarField(const PositionalAudioStream& stream) const {
+    // ignore boxes are tested per listener, so sources that have one enabled are left to each listener
+    if (stream.isIgnoreBoxEnabled()) {
+        return false;
+    }
+
+    return glm::length2(stream.getPosition() - _center) > FAR_FIELD_DISTANCE * FAR_FIELD_DISTANCE;
+}
+
+AudioListenerClusters::Cluster* AudioListenerClusters::clusterFor(const glm::vec3& position, const glm::quat& orientation,
+                                                                  float masterAvatarGain, float masterInjectorGain,
+                                                                  unsigned int frame) {
+    glm::ivec3 cell = glm::ivec3(glm::floor(position / CELL_SIZE));
+
+    // only yaw changes the azimuth of a distant source enough to matter
+    glm::vec3 front = orientation * Vectors::FRONT;
+    float yaw = atan2f(-front.x, -front.z) + PI;
+    int yawBucket = std::min((int)(yaw / TWO_PI * NUM_YAW_BUCKETS), NUM_YAW_BUCKETS - 1);
+
+    Key key { cell, yawBucket, masterAvatarGain, masterInjectorGain };
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto& cluster = _clusters[key];
+    if (!cluster) {
+        cluster.reset(new Cluster((glm::vec3(cell) + 0.5f) * CELL_SIZE));
+    }
+    cluster->_lastUsedFrame = frame;
+
+    return cluster.get();
+}
+
+void AudioListenerClusters::prune(unsigned int frame, const std::vector<Node::LocalID>& removedNodes,
+                                  const std::vector<NodeIDStreamID>& removedStreams) {
+    for (auto it = _clusters.begin(); it != _clusters.end();) {
+        auto& cluster = *it->second;
+
+        if (frame - cluster._lastUsedFrame > CLUSTER_EXPIRY_FRAMES) {
+            it = _clusters.erase(it);
+            continue;
+        }
+
+        // a stream's address can be reused once it is gone, so don't let its HRTF state outlive it
+        if (!removedNodes.empty() || !removedStreams.empty()) {
+            for (auto streamIt = cluster.streams.begin(); streamIt != cluster.streams.end();) {
+                const auto& nodeStreamID = streamIt->second.nodeStreamID;
+
+                bool isRemoved = std::find(removedNodes.begin(), removedNodes.end(), nodeStreamID.nodeLocalID) !=
+                    removedNodes.end() ||
+                    std::find(removedStreams.begin(), removedStreams.end(), nodeStreamID) != removedStreams.end();
+
+                streamIt = isRemoved ? cluster.streams.erase(streamIt) : std::next(streamIt);
+            }
+        }
+
+        ++it;
+    }
+}
@@ -0,0 +1,99 @@
+//
+//  AudioListenerClusters.h
+//  assignment-client/src/audio
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioListenerClusters_h
+#define hifi_AudioListenerClusters_h
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <Node.h>
+#include <PositionalAudioStream.h>
+
+// Groups listeners that stand in the same cell facing about the same way, so that the sources far enough away from
+// the cell to sound the same to all of them are spatialized once for the group instead of once per listener.
+// Sources near the cell, the listener's own echo and anything the listener filters are still mixed per listener.
+class AudioListenerClusters {
+public:
+    static const float CELL_SIZE; // meters
+    static const int NUM_YAW_BUCKETS = 32;
+    static const float FAR_FIELD_DISTANCE; // meters from the cell center
+
+    struct Key {
+        glm::ivec3 cell;
+        int yawBucket;
+        float masterAvatarGain;
+        float masterInjectorGain;
+
+        bool operator==(const Key& other) const {
+            return cell == other.cell && yawBucket == other.yawBucket &&
+                masterAvatarGain == other.masterAvatarGain && masterInjectorGain == other.masterInjectorGain;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct ClusterStream {
+        NodeIDStreamID nodeStreamID;
+        std::unique_ptr<AudioHRTF> hrtf { new AudioHRTF };
+        unsigned int mixedFrame { 0 };
+
+        ClusterStream(const NodeIDStreamID& nodeStreamID) : nodeStreamID(nodeStreamID) {}
+    };
+
+    class Cluster {
+    public:
+        Cluster(const glm::vec3& center) : _center(center) {}
+
+        // true for sources whose spatialization is shared by every listener in the cluster
+        bool isFarField(const PositionalAudioStream& stream) const;
+
+        // guards everything below, the first listener of a frame to lock it renders the mix for the others
+        std::mutex mutex;
+        unsigned int mixedFrame { 0 };
+        float mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+        std::unordered_map<const PositionalAudioStream*, ClusterStream> streams;
+
+    private:
+        friend class AudioListenerClusters;
+
+        const glm::vec3 _center;
+        unsigned int _lastUsedFrame { 0 }; // guarded by the AudioListenerClusters mutex
+    };
+
+    bool isEnabled() const { return _isEnabled; }
+    void setEnabled(bool enabled) { _isEnabled = enabled; }
+
+    // thread-safe, returns the cluster for a listener at this position and orientation, creating it if needed
+    Cluster* clusterFor(const glm::vec3& position, const glm::quat& orientation,
+                        float masterAvatarGain, float masterInjectorGain, unsigned int frame);
+
+    // not thread-safe, called between mixes to drop clusters nobody is in and state for streams that went away
+    void prune(unsigned int frame, const std::vector<Node::LocalID>& removedNodes,
+               const std::vector<NodeIDStreamID>& removedStreams);
+
+    int getNumClusters() const { return (int)_clusters.size(); }
+
+private:
+    std::mutex _mutex;
+    std::unordered_map<Key, std::unique_ptr<Cluster>, KeyHasher> _clusters;
+    bool _isEnabled { false };
+};
+
+#endif // hifi_AudioListenerClusters_h
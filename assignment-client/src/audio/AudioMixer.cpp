@@ -26,6 +26,9 @@
 #include <OctreeConstants.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
+#include <ResourceCache.h>
+#include <ResourceManager.h>
+#include <SoundCache.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <StDev.h>
@@ -69,12 +72,8 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     // hash the available codecs (on the mixer)
     _availableCodecs.clear(); // Make sure struct is clean
     auto pluginManager = DependencyManager::set<PluginManager>();
-    // Only load codec plugins; for now assume codec plugins have 'codec' in their name.
-    auto codecPluginFilter = [](const QJsonObject& metaData) {
-        QJsonValue nameValue = metaData["MetaData"]["name"];
-        return nameValue.toString().contains("codec", Qt::CaseInsensitive);
-    };
-    pluginManager->setPluginFilter(codecPluginFilter);
+    // Only load codec plugins
+    pluginManager->setPluginFilter(&PluginManager::isCodecPlugin);
 
     auto codecPlugins = pluginManager->getCodecPlugins();
     for_each(codecPlugins.cbegin(), codecPlugins.cend(),
@@ -82,16 +81,25 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
             _availableCodecs[codec->getName()] = codec;
         });
 
+    // hosted injectors are played from sounds the mixer fetches and decodes itself
+    DependencyManager::set<ResourceManager>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+    DependencyManager::set<SoundCache>();
+
     auto nodeList = DependencyManager::get<NodeList>();
     auto& packetReceiver = nodeList->getPacketReceiver();
 
-    // packets whose consequences are limited to their own node can be parallelized
-    packetReceiver.registerListenerForTypes({
+    // the bulk of the audio stream arrives as these, queue them without going through the event loop per packet
+    _audioPacketQueue = packetReceiver.registerQueuedListenerForTypes({
             PacketType::MicrophoneAudioNoEcho,
             PacketType::MicrophoneAudioWithEcho,
             PacketType::InjectAudio,
+            PacketType::SilentAudioFrame },
+            this, "drainQueuedAudioPackets");
+
+    // packets whose consequences are limited to their own node can be parallelized
+    packetReceiver.registerListenerForTypes({
             PacketType::AudioStreamStats,
-            PacketType::SilentAudioFrame,
             PacketType::NegotiateAudioFormat,
             PacketType::MuteEnvironment,
             PacketType::NodeIgnoreRequest,
@@ -100,7 +108,8 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
             PacketType::PerAvatarGainSet,
             PacketType::InjectorGainSet,
             PacketType::AudioSoloRequest,
-            PacketType::StopInjector },
+            PacketType::StopInjector,
+            PacketType::HostedInjectorControl },
             this, "queueAudioPacket");
 
     // packets whose consequences are global should be processed on the main thread
@@ -121,6 +130,12 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
 }
 
 void AudioMixer::aboutToFinish() {
+    DependencyManager::get<ResourceManager>()->cleanup();
+
+    DependencyManager::destroy<SoundCache>();
+    DependencyManager::destroy<ResourceManager>();
+    DependencyManager::destroy<ResourceCacheSharedItems>();
+
     DependencyManager::destroy<PluginManager>();
 }
 
@@ -132,6 +147,16 @@ void AudioMixer::queueAudioPacket(QSharedPointer<ReceivedMessage> message, Share
     getOrCreateClientData(node.data())->queuePacket(message, node);
 }
 
+void AudioMixer::drainQueuedAudioPackets() {
+    if (_audioPacketQueue) {
+        _audioPacketQueue->drain([this](QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+            if (node) {
+                queueAudioPacket(message, node);
+            }
+        });
+    }
+}
+
 void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> message) {
     // make sure we have a replicated node for the original sender of the packet
     auto nodeList = DependencyManager::get<NodeList>();
@@ -326,10 +351,14 @@ void AudioMixer::sendStatsPacket() {
     mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    mixStats["1_field_encodes"] = (int)(_stats.fieldEncodes / (float)_numStatFrames);
+    mixStats["1_bed_encodes"] = (int)(_stats.bedEncodes / (float)_numStatFrames);
+    mixStats["1_field_renders"] = (int)(_stats.fieldRenders / (float)_numStatFrames);
 
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
     mixStats["2_active_streams"] = (int)(_stats.active / (float)_numStatFrames);
+    mixStats["2_culled_streams"] = (int)(_stats.culled / (float)_numStatFrames);
 
     mixStats["3_skippped_to_active"] = (int)(_stats.skippedToActive / (float)_numStatFrames);
     mixStats["3_skippped_to_inactive"] = (int)(_stats.skippedToInactive / (float)_numStatFrames);
@@ -337,14 +366,43 @@ void AudioMixer::sendStatsPacket() {
     mixStats["3_inactive_to_active"] = (int)(_stats.inactiveToActive / (float)_numStatFrames);
     mixStats["3_active_to_skippped"] = (int)(_stats.activeToSkipped / (float)_numStatFrames);
     mixStats["3_active_to_inactive"] = (int)(_stats.activeToInactive / (float)_numStatFrames);
+    mixStats["3_to_culled"] = (int)(_stats.toCulled / (float)_numStatFrames);
+    mixStats["3_culled_to_inactive"] = (int)(_stats.culledToInactive / (float)_numStatFrames);
+
+    if (_workerSharedData.listenerClusters.isEnabled()) {
+        mixStats["4_clustered_listeners"] = (int)(_stats.clusteredListeners / (float)_numStatFrames);
+        mixStats["4_cluster_mixes"] = (int)(_stats.clusterMixes / (float)_numStatFrames);
+        mixStats["4_clustered_streams"] = (int)(_stats.clusteredStreams / (float)_numStatFrames);
+        mixStats["4_clusters"] = _workerSharedData.listenerClusters.getNumClusters();
+    }
+
+    if (_workerSharedData.encodedMixes.isEnabled()) {
+        mixStats["4_shared_encodes"] = (int)(_stats.sharedEncodes / (float)_numStatFrames);
+    }
 
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
 
     statsObject["mix_stats"] = mixStats;
 
+    // scheduling stats, a slave that is busy much less than the others is waiting on them
+    QJsonObject slaveStats;
+
+    for (int i = 0; i < (int)_slaveStats.size() && i < _slavePool.numThreads(); ++i) {
+        const auto& stats = _slaveStats[i];
+        slaveStats[QString("%_utilization_%1").arg(i)] = (stats.poolTime > 0) ?
+            (float)stats.busyTime / (float)stats.poolTime * 100.0f : 0.0f;
+        slaveStats[QString("stolen_nodes_%1").arg(i)] = stats.stolenNodes / (float)_numStatFrames;
+    }
+    slaveStats["%_utilization"] = (_stats.poolTime > 0) ? (float)_stats.busyTime / (float)_stats.poolTime * 100.0f : 0.0f;
+
+    statsObject["slave_stats"] = slaveStats;
+
+    _workerSharedData.profiler.addStats(statsObject);
+
     _numStatFrames = _numSilentPackets = 0;
     _stats.reset();
+    _slaveStats.clear();
 
     // add stats for each listerner
     auto nodeList = DependencyManager::get<NodeList>();
@@ -402,7 +460,8 @@ void AudioMixer::start() {
     // prepare the NodeList
     nodeList->addSetOfNodeTypesToNodeInterestSet({
         NodeType::Agent, NodeType::EntityScriptServer,
-        NodeType::UpstreamAudioMixer, NodeType::DownstreamAudioMixer
+        NodeType::UpstreamAudioMixer, NodeType::DownstreamAudioMixer,
+        NodeType::AssetServer // for the sounds of hosted injectors
     });
     nodeList->linkedDataCreateCallback = [&](Node* node) { getOrCreateClientData(node); };
 
@@ -428,6 +487,7 @@ void AudioMixer::start() {
         }
 
         auto frameTimer = _frameTiming.timer();
+        _workerSharedData.profiler.beginFrame(frame);
 
         // process (node-isolated) audio packets across slave threads
         {
@@ -451,24 +511,56 @@ void AudioMixer::start() {
 
             // since we're a while loop we need to yield to qt's event processing
             QCoreApplication::processEvents();
+
+            if (_workerSharedData.listenerClusters.isEnabled()) {
+                _workerSharedData.listenerClusters.prune(frame, _workerSharedData.removedNodes,
+                                                         _workerSharedData.removedStreams);
+            }
         }
 
+        // index where every source is this frame, so listeners only look at the ones within their range
+        _workerSharedData.audioSources.clear();
+        nodeList->eachNode([&](const SharedNodePointer& node) {
+            AudioMixerClientData* data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+            if (data) {
+                for (const auto& stream : data->getAudioStreams()) {
+                    _workerSharedData.audioSources.insert(*stream);
+                }
+            }
+        });
+
         int numToRetain = -1;
         assert(_throttlingRatio >= 0.0f && _throttlingRatio <= 1.0f);
         if (_throttlingRatio > EPSILON) {
             numToRetain = nodeList->size() * (1.0f - _throttlingRatio);
         }
+        _workerSharedData.throttlingRatio = _throttlingRatio;
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // mix across slave threads
             auto mixTimer = _mixTiming.timer();
             _slavePool.mix(cbegin, cend, frame, numToRetain);
         });
 
+        // the frame's mixes are all out, send whatever was held to be packed with them
+        nodeList->flushCoalescedPackets();
+
+        // encoded frames are only shared within a frame, the encoders behind them move on in the next one
+        _workerSharedData.encodedMixes.clear();
+
         // gather stats
+        size_t slaveIndex = 0;
         _slavePool.each([&](AudioMixerSlave& slave) {
+            if (slaveIndex == _slaveStats.size()) {
+                _slaveStats.emplace_back();
+            }
+            _slaveStats[slaveIndex++].accumulate(slave.stats);
+
             _stats.accumulate(slave.stats);
             slave.stats.reset();
+
+            _workerSharedData.profiler.gather(slave.profileSamples);
         });
+        _workerSharedData.profiler.endFrame();
 
         ++frame;
         ++_numStatFrames;
@@ -588,6 +680,43 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         }
 
         qCDebug(audio) << "Throttle Start:" << _throttleStartTarget << "Throttle Backoff:" << _throttleBackoffTarget;
+
+        const QString LISTENER_CLUSTERING_KEY = "listener_clustering";
+        bool enableListenerClustering = audioThreadingGroupObject[LISTENER_CLUSTERING_KEY].toBool(false);
+        _workerSharedData.listenerClusters.setEnabled(enableListenerClustering);
+        qCDebug(audio) << "Listener clustering:" << (enableListenerClustering ? "enabled" : "disabled");
+
+        const QString ENCODE_SHARING_KEY = "encode_sharing";
+        bool enableEncodeSharing = audioThreadingGroupObject[ENCODE_SHARING_KEY].toBool(false);
+        _workerSharedData.encodedMixes.setEnabled(enableEncodeSharing);
+        qCDebug(audio) << "Encode sharing:" << (enableEncodeSharing ? "enabled" : "disabled");
+
+        const QString MAX_HRTF_SOURCES_KEY = "max_hrtf_sources";
+        const QString MAX_FIELD_SOURCES_KEY = "max_field_sources";
+        bool ok;
+        int maxHRTFSources = audioThreadingGroupObject[MAX_HRTF_SOURCES_KEY].toString().toInt(&ok);
+        _workerSharedData.maxHRTFSources = ok ? std::max(maxHRTFSources, 0) : 0;
+        int maxFieldSources = audioThreadingGroupObject[MAX_FIELD_SOURCES_KEY].toString().toInt(&ok);
+        _workerSharedData.maxFieldSources = ok ? std::max(maxFieldSources, 0) : 0;
+        qCDebug(audio) << "Max HRTF sources:" << _workerSharedData.maxHRTFSources
+                       << "Max field sources:" << _workerSharedData.maxFieldSources;
+
+        const QString PROFILE_SAMPLE_INTERVAL_KEY = "profile_sample_interval";
+        const QString PROFILE_TRACE_FILE_KEY = "profile_trace_file";
+        const QString PROFILE_TRACE_FRAMES_KEY = "profile_trace_frames";
+        int profileSampleInterval = audioThreadingGroupObject[PROFILE_SAMPLE_INTERVAL_KEY].toString().toInt(&ok);
+        profileSampleInterval = ok ? std::max(profileSampleInterval, 0) : 0;
+        _workerSharedData.profiler.setSampleInterval(profileSampleInterval);
+
+        // tracing is part of sampling, so only sampled frames are traced
+        QString profileTraceFile = profileSampleInterval > 0 ?
+            audioThreadingGroupObject[PROFILE_TRACE_FILE_KEY].toString() : QString();
+        int profileTraceFrames = audioThreadingGroupObject[PROFILE_TRACE_FRAMES_KEY].toString().toInt(&ok);
+        profileTraceFrames = ok ? std::max(profileTraceFrames, 0) : 0;
+        _workerSharedData.profiler.setTrace(profileTraceFile, profileTraceFrames);
+
+        qCDebug(audio) << "Profile sample interval:" << profileSampleInterval
+                       << "Profile trace file:" << profileTraceFile << "Profile trace frames:" << profileTraceFrames;
     }
 
     if (settingsObject.contains(AUDIO_BUFFER_GROUP_KEY)) {
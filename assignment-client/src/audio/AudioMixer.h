@@ -78,6 +78,7 @@ private slots:
     void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
 
     void queueAudioPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
+    void drainQueuedAudioPackets();
     void queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> packet);
     void removeHRTFsForFinishedInjector(const QUuid& streamID);
     void start();
@@ -102,8 +103,12 @@ private:
 
     int _numSilentPackets { 0 };
 
+    // microphone and injector audio skips the Qt event queue and is drained in batches
+    PacketReceiver::MessageQueuePointer _audioPacketQueue;
+
     int _numStatFrames { 0 };
     AudioMixerStats _stats;
+    std::vector<AudioMixerStats> _slaveStats; // kept apart to show how evenly the work is spread
 
     AudioMixerSlavePool _slavePool { _workerSharedData };
 
@@ -11,6 +11,7 @@
 
 #include "AudioMixerClientData.h"
 
+#include <algorithm>
 #include <random>
 
 #include <glm/common.hpp>
@@ -21,12 +22,18 @@
 #include <udt/PacketHeaders.h>
 #include <UUID.h>
 
+#include "HostedInjectorStream.h"
 #include "InjectedAudioStream.h"
 
 #include "AudioLogging.h"
 #include "AudioHelpers.h"
 #include "AudioMixer.h"
 
+// the levels the encoders adapt in, few enough that most listeners still share their encoded mixes
+static const int NUM_ENCODER_QUALITY_LEVELS = 4;
+static const float ENCODER_LOSS_LEVELS[] = { 0.0f, 0.01f, 0.05f, 0.15f };
+static const int NUM_ENCODER_LOSS_LEVELS = sizeof(ENCODER_LOSS_LEVELS) / sizeof(ENCODER_LOSS_LEVELS[0]);
+
 AudioMixerClientData::AudioMixerClientData(const QUuid& nodeID, Node::LocalID nodeLocalID) :
     NodeData(nodeID, nodeLocalID),
     audioLimiter(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO),
@@ -107,6 +114,9 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
             case PacketType::StopInjector:
                 parseStopInjectorPacket(packet);
                 break;
+            case PacketType::HostedInjectorControl:
+                parseHostedInjectorControl(*packet, addedStreams);
+                break;
             default:
                 Q_UNREACHABLE();
         }
@@ -229,6 +239,15 @@ void AudioMixerClientData::setGainForAvatar(QUuid nodeID, float gain) {
 
     if (it != _streams.active.cend()) {
         it->hrtf->setGainAdjustment(gain);
+        return;
+    }
+
+    auto culledIt = std::find_if(_streams.culled.cbegin(), _streams.culled.cend(), [nodeID](const auto& culled) {
+        return culled.second.nodeStreamID.nodeID == nodeID && culled.second.nodeStreamID.streamID.isNull();
+    });
+
+    if (culledIt != _streams.culled.cend()) {
+        culledIt->second.hrtf->setGainAdjustment(gain);
     }
 }
 
@@ -361,6 +380,7 @@ void AudioMixerClientData::removeAgentAvatarAudioStream() {
         _streams.skipped.clear();
         _streams.inactive.clear();
         _streams.active.clear();
+        _streams.culled.clear();
     }
 }
 
@@ -382,6 +402,12 @@ int AudioMixerClientData::parseData(ReceivedMessage& message) {
         // read the downstream audio stream stats
         message.readPrimitive(&_downstreamAudioStreamStats);
 
+        float lossRate = _downstreamAudioStreamStats._packetStreamWindowStats.getLostRate();
+        _encoderLossLevel = 0;
+        while (_encoderLossLevel + 1 < NUM_ENCODER_LOSS_LEVELS && lossRate >= ENCODER_LOSS_LEVELS[_encoderLossLevel + 1]) {
+            _encoderLossLevel++;
+        }
+
         return message.getPosition();
     }
 
@@ -552,6 +578,14 @@ int AudioMixerClientData::checkBuffersBeforeFrameSend() {
     while (it != _audioStreams.end()) {
         SharedStreamPointer stream = *it;
 
+        // hosted injectors are rendered here rather than filled by packets
+        auto hostedStream = dynamic_cast<HostedInjectorStream*>(stream.get());
+        if (hostedStream && !hostedStream->renderNextFrame()) {
+            emit injectorStreamFinished(stream->getStreamIdentifier());
+            it = _audioStreams.erase(it);
+            continue;
+        }
+
         if (stream->popFrames(1, true) > 0) {
             stream->updateLastPopOutputLoudnessAndTrailingLoudness();
         }
@@ -559,8 +593,8 @@ int AudioMixerClientData::checkBuffersBeforeFrameSend() {
         static const int INJECTOR_MAX_INACTIVE_BLOCKS = 500;
 
         // if we don't have new data for an injected stream in the last INJECTOR_MAX_INACTIVE_BLOCKS then
-        // we remove the injector from our streams
-        if (stream->getType() == PositionalAudioStream::Injector
+        // we remove the injector from our streams (hosted injectors wait for their sound, and are stopped explicitly)
+        if (stream->getType() == PositionalAudioStream::Injector && !hostedStream
             && stream->getConsecutiveNotMixedCount() > INJECTOR_MAX_INACTIVE_BLOCKS) {
             // this is an inactive injector, pull it from our streams
 
@@ -590,6 +624,31 @@ void AudioMixerClientData::parseStopInjectorPacket(QSharedPointer<ReceivedMessag
     }
 }
 
+void AudioMixerClientData::parseHostedInjectorControl(ReceivedMessage& message, ConcurrentAddedStreams& addedStreams) {
+    auto streamID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+
+    HostedInjectorCommand command;
+    message.readPrimitive(&command);
+
+    auto it = std::find_if(std::begin(_audioStreams), std::end(_audioStreams), [&](const SharedStreamPointer& stream) {
+        return streamID == stream->getStreamIdentifier();
+    });
+
+    if (it != std::end(_audioStreams)) {
+        // the stream ID might belong to an injector that is streamed to us
+        if (auto hostedStream = dynamic_cast<HostedInjectorStream*>(it->get())) {
+            hostedStream->parseControl(command, message);
+        }
+    } else if (command == HostedInjectorCommand::Start) {
+        auto hostedStream = new HostedInjectorStream(streamID);
+        hostedStream->parseControl(command, message);
+
+        _audioStreams.push_back(SharedStreamPointer(hostedStream));
+        addedStreams.push_back(AddedStream(getNodeID(), getNodeLocalID(), streamID, hostedStream));
+    }
+    // updates that overtake the start of their injector are dropped, a later one will follow
+}
+
 bool AudioMixerClientData::shouldSendStats(int frameNumber) {
     return frameNumber == _frameToSendStats;
 }
@@ -679,6 +738,9 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
         AudioStreamStats streamStats = avatarAudioStream->getAudioStreamStats();
         upstreamStats["mic.desired"] = streamStats._desiredJitterBufferFrames;
         upstreamStats["desired_calc"] = avatarAudioStream->getCalculatedJitterBufferFrames();
+        upstreamStats["desired_predicted"] = avatarAudioStream->getPredictedJitterBufferFrames();
+        upstreamStats["target_gap"] = formatUsecTime(avatarAudioStream->getPercentileTimeGap());
+        upstreamStats["concealed"] = avatarAudioStream->getConcealedFrames();
         upstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
         upstreamStats["available"] = (double) streamStats._framesAvailable;
         upstreamStats["unplayed"] = (double) streamStats._unplayedMs;
@@ -709,6 +771,9 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
             AudioStreamStats streamStats = injectorPair->getAudioStreamStats();
             upstreamStats["inj.desired"]  = streamStats._desiredJitterBufferFrames;
             upstreamStats["desired_calc"] = injectorPair->getCalculatedJitterBufferFrames();
+            upstreamStats["desired_predicted"] = injectorPair->getPredictedJitterBufferFrames();
+            upstreamStats["target_gap"] = formatUsecTime(injectorPair->getPercentileTimeGap());
+            upstreamStats["concealed"] = injectorPair->getConcealedFrames();
             upstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
             upstreamStats["available"] = (double) streamStats._framesAvailable;
             upstreamStats["unplayed"] = (double) streamStats._unplayedMs;
@@ -745,6 +810,57 @@ void AudioMixerClientData::sendSelectAudioFormat(SharedNodePointer node, const Q
     nodeList->sendPacket(std::move(replyPacket), *node);
 }
 
+bool AudioMixerClientData::encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer,
+                                  AudioEncodedMixes& encodedMixes) {
+    // once you have encoded, you need to flush eventually.
+    _shouldFlushEncoder = true;
+
+    if (!_encoder) {
+        encodedBuffer = decodedBuffer;
+        return false;
+    }
+
+    if (!encodedMixes.isEnabled()) {
+        _encoder->encode(decodedBuffer, encodedBuffer);
+        return false;
+    }
+
+    bool isStateless = _encoder->isStateless();
+    quint64 history = isStateless ? AudioEncodedMixes::INITIAL_HISTORY : _encoderHistory;
+    quint64 frameHash = AudioEncodedMixes::hashFrame(decodedBuffer);
+    _encoderHistory = AudioEncodedMixes::nextHistory(_encoderHistory, frameHash);
+
+    if (encodedMixes.find(_encodedMixesCodecName, history, frameHash, decodedBuffer, *_encoder, encodedBuffer)) {
+        return true;
+    }
+
+    _encoder->encode(decodedBuffer, encodedBuffer);
+    encodedMixes.insert(_encodedMixesCodecName, history, frameHash, decodedBuffer, *_encoder, encodedBuffer);
+    return false;
+}
+
+void AudioMixerClientData::adaptEncoder(float throttlingRatio) {
+    if (!_encoder) {
+        return;
+    }
+
+    int qualityLevel = (int)((1.0f - throttlingRatio) * (NUM_ENCODER_QUALITY_LEVELS - 1) + 0.5f);
+    if (_encoderLossLevel == NUM_ENCODER_LOSS_LEVELS - 1) {
+        // that much loss is most likely the listener's link being congested, which a lower bitrate relieves
+        qualityLevel = std::max(qualityLevel - 1, 0);
+    }
+    int level = qualityLevel * NUM_ENCODER_LOSS_LEVELS + _encoderLossLevel;
+    if (level == _encoderLevel) {
+        return;
+    }
+    _encoderLevel = level;
+    _encoder->adapt((float)qualityLevel / (NUM_ENCODER_QUALITY_LEVELS - 1), ENCODER_LOSS_LEVELS[_encoderLossLevel]);
+
+    // what the encoder outputs from now on depends on its level too
+    _encoderHistory = AudioEncodedMixes::nextHistory(_encoderHistory, (quint64)level);
+    _encodedMixesCodecName = _selectedCodecName + "/" + QString::number(level);
+}
+
 void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
     static QByteArray zeros(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
     if (_shouldFlushEncoder) {
@@ -753,6 +869,7 @@ void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
         } else {
             encodedZeros = zeros;
         }
+        _encoderHistory = AudioEncodedMixes::FLUSHED_HISTORY;
     }
     _shouldFlushEncoder = false;
 }
@@ -761,6 +878,9 @@ void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& c
     cleanupCodec(); // cleanup any previously allocated coders first
     _codec = codec;
     _selectedCodecName = codecName;
+    _encoderHistory = AudioEncodedMixes::INITIAL_HISTORY;
+    _encoderLevel = -1;
+    _encodedMixesCodecName = codecName;
     if (codec) {
         _encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
         _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
@@ -13,12 +13,14 @@
 #define hifi_AudioMixerClientData_h
 
 #include <queue>
+#include <unordered_map>
 
 #include <tbb/concurrent_vector.h>
 
 #include <QtCore/QJsonObject>
 
 #include <AABox.h>
+#include <AudioFOA.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
 #include <UUIDHasher.h>
@@ -26,6 +28,7 @@
 #include <plugins/Forward.h>
 #include <plugins/CodecPlugin.h>
 
+#include "AudioEncodedMixes.h"
 #include "PositionalAudioStream.h"
 #include "AvatarAudioStream.h"
 
@@ -68,6 +71,7 @@ public:
     void parseRadiusIgnoreRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
     void parseSoloRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
     void parseStopInjectorPacket(QSharedPointer<ReceivedMessage> packet);
+    void parseHostedInjectorControl(ReceivedMessage& message, ConcurrentAddedStreams& addedStreams);
 
     // attempt to pop a frame from each audio stream, and return the number of streams from this client
     int checkBuffersBeforeFrameSend();
@@ -89,22 +93,25 @@ public:
 
     AudioLimiter audioLimiter;
 
+    // mid and far range sources are summed into this sound field when the mixer limits per-source HRTF
+    AudioFOA listenerField;
+    bool listenerFieldHasTail { false }; // rendered last frame, so it needs one more frame to ring out
+
     void setupCodec(CodecPluginPointer codec, const QString& codecName);
     void cleanupCodec();
-    void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
-        if (_encoder) {
-            _encoder->encode(decodedBuffer, encodedBuffer);
-        } else {
-            encodedBuffer = decodedBuffer;
-        }
-        // once you have encoded, you need to flush eventually.
-        _shouldFlushEncoder = true;
-    }
+    // returns true if the payload was taken from another listener's identical frame instead of being encoded
+    bool encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer, AudioEncodedMixes& encodedMixes);
+    // adapts the encoder to the load of the mixer, from 0 to 1, and to the loss the listener reports
+    void adaptEncoder(float throttlingRatio);
     void encodeFrameOfZeros(QByteArray& encodedZeros);
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
 
     QString getCodecName() { return _selectedCodecName; }
 
+    // usecs the last mix for this listener took, including encoding and sending
+    uint64_t getLastMixCost() const { return _lastMixCost; }
+    void setLastMixCost(uint64_t cost) { _lastMixCost = cost; }
+
     bool shouldMuteClient() { return _shouldMuteClient; }
     void setShouldMuteClient(bool shouldMuteClient) { _shouldMuteClient = shouldMuteClient; }
     glm::vec3 getPosition() { return getAvatarAudioStream() ? getAvatarAudioStream()->getPosition() : glm::vec3(0); }
@@ -120,6 +127,10 @@ public:
         PositionalAudioStream* positionalStream;
         bool ignoredByListener { false };
         bool ignoringListener { false };
+        bool isMixedByCluster { false }; // spatialized in the listener's cluster mix instead of with hrtf
+        bool isMixedByField { false }; // encoded into the listener's ambisonic field instead of with hrtf
+        bool hasFieldGains { false };
+        float fieldGains[4]; // W, X, Y, Z gains it was last encoded with, the next frame ramps from them
 
         MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream) :
             nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
@@ -132,6 +143,8 @@ public:
         MixableStreamsVector active;
         MixableStreamsVector inactive;
         MixableStreamsVector skipped;
+        // out of audible range, not looked at again until the source grid finds them within range
+        std::unordered_map<const PositionalAudioStream*, MixableStream> culled;
     };
 
     Streams& getStreams() { return _streams; }
@@ -199,8 +212,13 @@ private:
     Decoder* _decoder{ nullptr }; // for mic stream
 
     bool _shouldFlushEncoder { false };
+    quint64 _encoderHistory { AudioEncodedMixes::INITIAL_HISTORY }; // what the encoder has been fed, see AudioEncodedMixes
+    int _encoderLossLevel { 0 }; // of the loss the listener reports, see adaptEncoder
+    int _encoderLevel { -1 }; // the quality and loss levels the encoder was last adapted to
+    QString _encodedMixesCodecName; // the codec and the encoder level, only the mixes encoded alike are shared
 
     bool _shouldMuteClient { false };
+    uint64_t _lastMixCost { 0 };
     bool _requestsDomainListData { false };
 
     std::vector<AddedStream> _newAddedStreams;
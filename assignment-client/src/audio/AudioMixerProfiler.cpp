@@ -0,0 +1,179 @@
+//
+//  AudioMixerProfiler.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerProfiler.h"
+
+#include <algorithm>
+
+#include <QtCore/QLoggingCategory>
+
+#include <NodeList.h>
+#include <Trace.h>
+#include <UUID.h>
+
+#include "AudioLogging.h"
+
+Q_LOGGING_CATEGORY(trace_audio_mixer, "trace.audio.mixer")
+
+static const char* STAGE_NAMES[AudioMixerProfiler::NUM_STAGES] = {
+    "process_packets",
+    "prepare_mix",
+    "add_streams",
+    "encode",
+    "send"
+};
+
+// the listeners with the costliest mixes are listed by name in the stats
+static const int NUM_SLOWEST_LISTENERS = 5;
+
+// reorders the durations
+static int64_t percentile(std::vector<int64_t>& durations, float fraction) {
+    if (durations.empty()) {
+        return 0;
+    }
+    auto nth = durations.begin() + std::min((size_t)(fraction * durations.size()), durations.size() - 1);
+    std::nth_element(durations.begin(), nth, durations.end());
+    return *nth;
+}
+
+AudioMixerProfiler::Scope::Scope(const AudioMixerProfiler& profiler, Samples& samples, Stage stage,
+                                 Node::LocalID node) :
+    _stage(stage),
+    _node(node)
+{
+    if (profiler._isSampling) {
+        _samples = &samples;
+        _isTracing = profiler._isTracing;
+        _start = tracing::Tracer::now();
+    }
+}
+
+AudioMixerProfiler::Scope::~Scope() {
+    if (!_samples) {
+        return;
+    }
+
+    int64_t duration = tracing::Tracer::now() - _start;
+    _samples->push_back({ _stage, _node, _start, duration });
+
+    // traced from here so that the trace shows which slave thread did the work
+    if (_isTracing) {
+        tracing::traceEvent(trace_audio_mixer(), _start, STAGE_NAMES[_stage], tracing::Complete, "",
+                            { { "node", _node } }, { { "dur", (qint64)duration } });
+    }
+}
+
+void AudioMixerProfiler::setTrace(const QString& filename, int numFrames) {
+    _traceFilename = filename;
+    _numTraceFramesLeft = filename.isEmpty() ? 0 : std::max(numFrames, 0);
+}
+
+void AudioMixerProfiler::beginFrame(unsigned int frame) {
+    _isSampling = _sampleInterval > 0 && frame % _sampleInterval == 0;
+    if (!_isSampling) {
+        return;
+    }
+
+    if (_numTraceFramesLeft > 0 && !_isTracing && DependencyManager::isSet<tracing::Tracer>()) {
+        auto tracer = DependencyManager::get<tracing::Tracer>();
+        if (!tracer->isEnabled()) {
+            tracer->startTracing();
+            _isTracing = true;
+        }
+    }
+
+    _frame = frame;
+    _frameStart = tracing::Tracer::now();
+}
+
+void AudioMixerProfiler::gather(Samples& samples) {
+    for (const auto& sample : samples) {
+        _stageDurations[sample.stage].push_back(sample.duration);
+        if (sample.stage != AddStreams) {
+            _frameCosts[sample.node] += sample.duration;
+        }
+    }
+    samples.clear();
+}
+
+void AudioMixerProfiler::endFrame() {
+    if (!_isSampling) {
+        return;
+    }
+
+    ++_numSampledFrames;
+    for (const auto& frameCost : _frameCosts) {
+        _nodeCosts[frameCost.first].push_back(frameCost.second);
+    }
+    _frameCosts.clear();
+
+    if (_isTracing) {
+        int64_t duration = tracing::Tracer::now() - _frameStart;
+        tracing::traceEvent(trace_audio_mixer(), _frameStart, "frame", tracing::Complete, "",
+                            { { "frame", _frame } }, { { "dur", (qint64)duration } });
+
+        if (--_numTraceFramesLeft == 0) {
+            // this stalls the frame it is written in, the trace is only taken once
+            auto tracer = DependencyManager::get<tracing::Tracer>();
+            tracer->stopTracing();
+            tracer->serialize(_traceFilename);
+            _isTracing = false;
+            qCDebug(audio) << "Wrote audio mixer trace to" << _traceFilename;
+        }
+    }
+
+    _isSampling = false;
+}
+
+void AudioMixerProfiler::addStats(QJsonObject& statsObject) {
+    if (_sampleInterval <= 0) {
+        return;
+    }
+
+    QJsonObject profileStats;
+    profileStats["sampled_frames"] = _numSampledFrames;
+
+    for (int i = 0; i < NUM_STAGES; ++i) {
+        auto& durations = _stageDurations[i];
+        QString name = STAGE_NAMES[i];
+
+        // per node and frame, in usecs
+        profileStats["us_p50_" + name] = (qint64)percentile(durations, 0.50f);
+        profileStats["us_p95_" + name] = (qint64)percentile(durations, 0.95f);
+        profileStats["us_p99_" + name] = (qint64)percentile(durations, 0.99f);
+        durations.clear();
+    }
+
+    // the listeners whose frames cost the most are the ones pushing the mixer into throttling
+    std::vector<std::pair<int64_t, Node::LocalID>> nodeCosts;
+    for (auto& costs : _nodeCosts) {
+        nodeCosts.emplace_back(percentile(costs.second, 0.99f), costs.first);
+    }
+    auto numSlowest = std::min((int)nodeCosts.size(), NUM_SLOWEST_LISTENERS);
+    std::partial_sort(nodeCosts.begin(), nodeCosts.begin() + numSlowest, nodeCosts.end(),
+                      [](const std::pair<int64_t, Node::LocalID>& a, const std::pair<int64_t, Node::LocalID>& b) {
+        return a.first > b.first;
+    });
+
+    QJsonObject slowestListeners;
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (int i = 0; i < numSlowest; ++i) {
+        auto node = nodeList->nodeWithLocalID(nodeCosts[i].second);
+        if (node) {
+            slowestListeners[uuidStringWithoutCurlyBraces(node->getUUID())] = (qint64)nodeCosts[i].first;
+        }
+    }
+    profileStats["us_p99_slowest_listeners"] = slowestListeners;
+
+    statsObject["profile_stats"] = profileStats;
+
+    _numSampledFrames = 0;
+    _nodeCosts.clear();
+}
@@ -0,0 +1,88 @@
+//
+//  AudioMixerProfiler.h
+//  assignment-client/src/audio
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerProfiler_h
+#define hifi_AudioMixerProfiler_h
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+#include <Node.h>
+
+// Samples every Nth frame of the mixer, timing each node through the stages of its part of the frame.
+// The timings are summarized as percentiles per stage and per listener in the mixer stats, and the first
+// frames sampled can be written out as a Chrome trace.
+class AudioMixerProfiler {
+public:
+    enum Stage {
+        ProcessPackets,
+        PrepareMix,
+        AddStreams, // nested in PrepareMix
+        Encode,
+        Send,
+        NUM_STAGES
+    };
+
+    struct Sample {
+        Stage stage;
+        Node::LocalID node;
+        int64_t start; // usecs, on the tracer's clock
+        int64_t duration; // usecs
+    };
+    using Samples = std::vector<Sample>;
+
+    // times a stage for a node into a slave's samples, if the frame is sampled
+    class Scope {
+    public:
+        Scope(const AudioMixerProfiler& profiler, Samples& samples, Stage stage, Node::LocalID node);
+        ~Scope();
+
+    private:
+        Samples* _samples { nullptr }; // null when the frame isn't sampled
+        Stage _stage;
+        Node::LocalID _node;
+        int64_t _start { 0 };
+        bool _isTracing { false };
+    };
+
+    // 0 turns sampling off
+    void setSampleInterval(int frames) { _sampleInterval = frames; }
+    // traces the next numFrames sampled frames, then writes them to filename
+    void setTrace(const QString& filename, int numFrames);
+
+    // mixer thread, around the frame the slaves run
+    void beginFrame(unsigned int frame);
+    void gather(Samples& samples); // for each slave, clears its samples
+    void endFrame();
+
+    // mixer thread, adds the percentiles since the last call and resets them
+    void addStats(QJsonObject& statsObject);
+
+private:
+    int _sampleInterval { 0 };
+    bool _isSampling { false }; // read by the slaves during the frame
+    bool _isTracing { false }; // read by the slaves during the frame
+    QString _traceFilename;
+    int _numTraceFramesLeft { 0 };
+
+    unsigned int _frame { 0 };
+    int64_t _frameStart { 0 };
+    int _numSampledFrames { 0 };
+
+    std::vector<int64_t> _stageDurations[NUM_STAGES];
+    std::unordered_map<Node::LocalID, int64_t> _frameCosts; // this frame, per node
+    std::unordered_map<Node::LocalID, std::vector<int64_t>> _nodeCosts; // per sampled frame, per node
+};
+
+#endif // hifi_AudioMixerProfiler_h
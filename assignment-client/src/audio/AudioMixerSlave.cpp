@@ -12,6 +12,9 @@
 #include "AudioMixerSlave.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
@@ -54,10 +57,15 @@ inline float computeGain(float masterAvatarGain, float masterInjectorGain, const
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
+float computeAudibleDistance(float masterAvatarGain, float masterInjectorGain,
+        const AvatarAudioStream& listeningNodeStream);
 
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
+        AudioMixerProfiler::Scope profile(_sharedData.profiler, profileSamples, AudioMixerProfiler::ProcessPackets,
+                                          node->getLocalID());
+
         // process packets and collect the number of streams available for this frame
         stats.sumStreams += data->processPackets(_sharedData.addedStreams);
     }
@@ -87,6 +95,8 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         return;
     }
 
+    auto mixStart = p_high_resolution_clock::now();
+
     // send mute packet, if necessary
     if (AudioMixer::shouldMute(avatarStream->getQuietestFrameLoudness()) || data->shouldMuteClient()) {
         sendMutePacket(node, *data);
@@ -97,20 +107,36 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         ++stats.sumListeners;
 
         // mix the audio
-        bool mixHasAudio = prepareMix(node);
+        bool mixHasAudio;
+        {
+            AudioMixerProfiler::Scope profile(_sharedData.profiler, profileSamples, AudioMixerProfiler::PrepareMix,
+                                              node->getLocalID());
+            mixHasAudio = prepareMix(node);
+        }
 
-        // send audio packet
-        if (mixHasAudio || data->shouldFlushEncoder()) {
-            QByteArray encodedBuffer;
+        // encode the audio
+        bool shouldSendMix = mixHasAudio || data->shouldFlushEncoder();
+        QByteArray encodedBuffer;
+        if (shouldSendMix) {
+            AudioMixerProfiler::Scope profile(_sharedData.profiler, profileSamples, AudioMixerProfiler::Encode,
+                                              node->getLocalID());
             if (mixHasAudio) {
-                // encode the audio
+                data->adaptEncoder(_sharedData.throttlingRatio);
                 QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
+                if (data->encode(decodedBuffer, encodedBuffer, _sharedData.encodedMixes)) {
+                    ++stats.sharedEncodes;
+                }
             } else {
                 // time to flush (resets shouldFlush until the next encode)
                 data->encodeFrameOfZeros(encodedBuffer);
             }
+        }
 
+        AudioMixerProfiler::Scope profile(_sharedData.profiler, profileSamples, AudioMixerProfiler::Send,
+                                          node->getLocalID());
+
+        // send audio packet
+        if (shouldSendMix) {
             sendMixPacket(node, *data, encodedBuffer);
         } else {
             ++stats.sumListenersSilent;
@@ -126,6 +152,10 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
             data->sendAudioStreamStatsPackets(node);
         }
     }
+
+    // the pool weighs this node by it when it deals out the next frame
+    auto mixCost = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - mixStart);
+    data->setLastMixCost(mixCost.count());
 }
 
 
@@ -312,13 +342,80 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
     // zero out the mix for this listener
     memset(_mixSamples, 0, sizeof(_mixSamples));
+    _fieldHasAudio = false; // the field is zeroed by the first source encoded into it
 
     bool isThrottling = _numToRetain != -1;
     bool isSoloing = !listenerData->getSoloedNodes().empty();
 
+    // listeners that filter what they hear can't share a mix with anyone
+    _cluster = nullptr;
+    if (_sharedData.listenerClusters.isEnabled() && !isSoloing && listener->getIgnoredNodeIDs().empty() &&
+        listenerData->getIgnoringNodeIDs().empty() && !listenerAudioStream->isIgnoreBoxEnabled()) {
+        _cluster = _sharedData.listenerClusters.clusterFor(listenerAudioStream->getPosition(),
+                                                           listenerAudioStream->getOrientation(),
+                                                           listenerData->getMasterAvatarGain(),
+                                                           listenerData->getMasterInjectorGain(), _frame);
+        ++stats.clusteredListeners;
+    }
+
     auto& streams = listenerData->getStreams();
 
-    addStreams(*listener, *listenerData);
+    {
+        AudioMixerProfiler::Scope profile(_sharedData.profiler, profileSamples, AudioMixerProfiler::AddStreams,
+                                          listener->getLocalID());
+        addStreams(*listener, *listenerData);
+    }
+
+    // sources further than this can't be heard, so they are culled until the source grid finds them within range
+    float audibleDistance = isSoloing ? std::numeric_limits<float>::infinity()
+        : computeAudibleDistance(listenerData->getMasterAvatarGain(), listenerData->getMasterInjectorGain(),
+                                 *listenerAudioStream);
+    float audibleDistance2 = audibleDistance * audibleDistance;
+    auto isOutOfRange = [&](const MixableStream& stream) {
+        return stream.nodeStreamID.nodeLocalID != listener->getLocalID() &&
+            glm::distance2(stream.positionalStream->getPosition(), listenerAudioStream->getPosition()) > audibleDistance2;
+    };
+
+    // bring culled streams back as inactive, the passes below sort them out
+    if (!streams.culled.empty()) {
+        if (!_sharedData.removedNodes.empty() || !_sharedData.removedStreams.empty()) {
+            for (auto it = streams.culled.begin(); it != streams.culled.end();) {
+                it = shouldBeRemoved(it->second, _sharedData) ? streams.culled.erase(it) : std::next(it);
+            }
+        }
+
+        bool hasStagedIgnoreChanges = !listenerData->getNewIgnoredNodeIDs().empty() ||
+            !listenerData->getNewUnignoredNodeIDs().empty() || !listenerData->getNewIgnoringNodeIDs().empty() ||
+            !listenerData->getNewUnignoringNodeIDs().empty();
+
+        auto revive = [&](MixableStream& stream) {
+            streams.inactive.push_back(move(stream));
+            ++stats.culledToInactive;
+        };
+
+        if (std::isinf(audibleDistance) || hasStagedIgnoreChanges) {
+            // everything is back in range, or the ignore flags culled streams carry need updating
+            for (auto& culled : streams.culled) {
+                revive(culled.second);
+            }
+            streams.culled.clear();
+        } else {
+            _sharedData.audioSources.forEachWithin(listenerAudioStream->getPosition(), audibleDistance,
+                                                   [&](const PositionalAudioStream& source) {
+                auto it = streams.culled.find(&source);
+                if (it != streams.culled.end()) {
+                    revive(it->second);
+                    streams.culled.erase(it);
+                }
+            });
+        }
+    }
+
+    auto cull = [&](MixableStream& stream) {
+        const PositionalAudioStream* positionalStream = stream.positionalStream;
+        streams.culled.emplace(positionalStream, move(stream));
+        ++stats.toCulled;
+    };
 
     // Process skipped streams
     erase_if(streams.skipped, [&](MixableStream& stream) {
@@ -350,6 +447,11 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             return true;
         }
 
+        if (isOutOfRange(stream)) {
+            cull(stream);
+            return true;
+        }
+
         if (shouldBeSkipped(stream, *listener, *listenerAudioStream, *listenerData)) {
             streams.skipped.push_back(move(stream));
             ++stats.inactiveToSkipped;
@@ -369,12 +471,42 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         return false;
     });
 
+    // pick the distances that split the active streams into tiers by how much of the listener's budget they get
+    _hrtfDistanceLimit2 = _directionalDistanceLimit2 = std::numeric_limits<float>::infinity();
+    int maxHRTFSources = _sharedData.maxHRTFSources;
+    if (maxHRTFSources > 0 && (int)streams.active.size() > maxHRTFSources) {
+        std::vector<float> distances2;
+        distances2.reserve(streams.active.size());
+        for (const auto& stream : streams.active) {
+            distances2.push_back(glm::distance2(stream.positionalStream->getPosition(), listenerAudioStream->getPosition()));
+        }
+
+        auto nthDistance2 = [&](int n) {
+            std::nth_element(distances2.begin(), distances2.begin() + n, distances2.end());
+            return distances2[n];
+        };
+
+        _hrtfDistanceLimit2 = nthDistance2(maxHRTFSources - 1);
+
+        int maxDirectionalSources = maxHRTFSources + std::max(_sharedData.maxFieldSources, 0);
+        if ((int)distances2.size() > maxDirectionalSources) {
+            _directionalDistanceLimit2 = nthDistance2(maxDirectionalSources - 1);
+        }
+    }
+
     // Process active streams
     erase_if(streams.active, [&](MixableStream& stream) {
         if (shouldBeRemoved(stream, _sharedData)) {
             return true;
         }
 
+        if (isOutOfRange(stream)) {
+            // the stream faded below audibility on the way out, so there is no tail worth keeping
+            resetHRTFState(stream);
+            cull(stream);
+            return true;
+        }
+
         if (isThrottling) {
             // we're throttling, so we need to update the approximate volume for any un-skipped streams
             // unless this is simply for an echo (in which case the approx volume is 1.0)
@@ -463,10 +595,43 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     stats.skipped += (int)streams.skipped.size();
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
+    stats.culled += (int)streams.culled.size();
 
     // clear the newly ignored, un-ignored, ignoring, and un-ignoring streams now that we've processed them
     listenerData->clearStagedIgnoreChanges();
 
+    if (_cluster) {
+        std::lock_guard<std::mutex> lock(_cluster->mutex);
+
+        // the first listener in the cluster this frame renders the far field for everyone
+        if (_cluster->mixedFrame != _frame) {
+            mixCluster(*_cluster, streams.active, *listenerAudioStream,
+                       listenerData->getMasterAvatarGain(), listenerData->getMasterInjectorGain());
+        }
+
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
+            _mixSamples[i] += _cluster->mixSamples[i];
+        }
+
+        _cluster = nullptr;
+    }
+
+    // a field that was rendered last frame gets one more, even if silent, so the FOA filters ring out
+    if (_fieldHasAudio || listenerData->listenerFieldHasTail) {
+        if (!_fieldHasAudio) {
+            memset(_fieldSamples, 0, sizeof(_fieldSamples));
+        }
+
+        // encoded relative to the listener already, so no rotation
+        const float* field[4] = { _fieldSamples[0], _fieldSamples[1], _fieldSamples[2], _fieldSamples[3] };
+        const int HRTF_DATASET_INDEX = 1;
+        listenerData->listenerField.render(field, _mixSamples, HRTF_DATASET_INDEX, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+                                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        ++stats.fieldRenders;
+
+        listenerData->listenerFieldHasTail = _fieldHasAudio;
+    }
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     auto mixEnd = p_high_resolution_clock::now();
     auto mixTime = std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - mixStart);
@@ -494,35 +659,78 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
                                 float masterAvatarGain,
                                 float masterInjectorGain,
                                 bool isSoloing) {
-    ++stats.totalMixes;
+    if (_cluster && _cluster->isFarField(*mixableStream.positionalStream)) {
+        // spatialized once for everyone in the cluster, by mixCluster
+        mixableStream.isMixedByCluster = true;
+        ++stats.clusteredStreams;
+        return;
+    }
 
-    auto streamToAdd = mixableStream.positionalStream;
+    if (mixableStream.isMixedByCluster) {
+        // our HRTF has not followed this stream while the cluster mixed it, start it over
+        mixableStream.isMixedByCluster = false;
+        resetHRTFState(mixableStream);
+    }
+
+    PositionalAudioStream& streamToAdd = *mixableStream.positionalStream;
+    bool isEcho = (&streamToAdd == &listeningNodeStream);
+
+    // stereo and echo sources don't go through the HRTF, so there is nothing to save on them
+    if (!isEcho && !streamToAdd.isStereo()) {
+        float distance2 = glm::distance2(streamToAdd.getPosition(), listeningNodeStream.getPosition());
+        if (distance2 > _hrtfDistanceLimit2) {
+            mixableStream.isMixedByField = true;
+            encodeStream(mixableStream, listeningNodeStream, masterAvatarGain, masterInjectorGain, isSoloing,
+                         distance2 <= _directionalDistanceLimit2);
+            return;
+        }
+    }
+
+    if (mixableStream.isMixedByField) {
+        // same as for the cluster, the HRTF has been idle while the field had this stream
+        mixableStream.isMixedByField = false;
+        mixableStream.hasFieldGains = false;
+        resetHRTFState(mixableStream);
+    }
+
+    renderStream(*mixableStream.hrtf, *mixableStream.positionalStream, listeningNodeStream,
+                 masterAvatarGain, masterInjectorGain, isSoloing, _mixSamples);
+}
+
+void AudioMixerSlave::renderStream(AudioHRTF& hrtf,
+                                   PositionalAudioStream& streamToAdd,
+                                   AvatarAudioStream& listeningNodeStream,
+                                   float masterAvatarGain,
+                                   float masterInjectorGain,
+                                   bool isSoloing,
+                                   float* mixSamples) {
+    ++stats.totalMixes;
 
     // check if this is a server echo of a source back to itself
-    bool isEcho = (streamToAdd == &listeningNodeStream);
+    bool isEcho = (&streamToAdd == &listeningNodeStream);
 
-    glm::vec3 relativePosition = streamToAdd->getPosition() - listeningNodeStream.getPosition();
+    glm::vec3 relativePosition = streamToAdd.getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
     float gain = isEcho ? 1.0f
                         : (isSoloing ? masterAvatarGain
-                                     : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, *streamToAdd,
+                                     : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, streamToAdd,
                                                    relativePosition, distance));
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
 
     const int HRTF_DATASET_INDEX = 1;
 
-    if (!streamToAdd->lastPopSucceeded()) {
+    if (!streamToAdd.lastPopSucceeded()) {
         bool forceSilentBlock = true;
 
-        if (!streamToAdd->getLastPopOutput().isNull()) {
-            bool isInjector = dynamic_cast<const InjectedAudioStream*>(streamToAdd);
+        if (!streamToAdd.getLastPopOutput().isNull()) {
+            bool isInjector = dynamic_cast<const InjectedAudioStream*>(&streamToAdd);
 
             // in an injector, just go silent - the injector has likely ended
             // in other inputs (microphone, &c.), repeat with fade to avoid the harsh jump to silence
             if (!isInjector) {
                 // calculate its fade factor, which depends on how many times it's already been repeated.
-                float fadeFactor = calculateRepeatedFrameFadeFactor(streamToAdd->getConsecutiveNotMixedCount() - 1);
+                float fadeFactor = calculateRepeatedFrameFadeFactor(streamToAdd.getConsecutiveNotMixedCount() - 1);
                 if (fadeFactor > 0.0f) {
                     // apply the fadeFactor to the gain
                     gain *= fadeFactor;
@@ -534,10 +742,10 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
         if (forceSilentBlock) {
             // call renderSilent with a forced silent block to reduce artifacts
             // (this is not done for stereo streams since they do not go through the HRTF)
-            if (!streamToAdd->isStereo() && !isEcho) {
+            if (!streamToAdd.isStereo() && !isEcho) {
                 static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                hrtf.render(silentMonoBlock, mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                            AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
                 ++stats.hrtfRenders;
             }
@@ -547,14 +755,14 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
     }
 
     // grab the stream from the ring buffer
-    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd->getLastPopOutput();
+    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd.getLastPopOutput();
 
-    if (streamToAdd->isStereo()) {
+    if (streamToAdd.isStereo()) {
 
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
 
         // stereo sources are not passed through HRTF
-        mixableStream.hrtf->mixStereo(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        hrtf.mixStereo(_bufferSamples, mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualStereoMixes;
     } else if (isEcho) {
@@ -562,19 +770,133 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         // echo sources are not passed through HRTF
-        mixableStream.hrtf->mixMono(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        hrtf.mixMono(_bufferSamples, mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualEchoMixes;
     } else {
 
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-        mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                   AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        hrtf.render(_bufferSamples, mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
         ++stats.hrtfRenders;
     }
 }
 
+void AudioMixerSlave::encodeStream(AudioMixerClientData::MixableStream& mixableStream,
+                                   AvatarAudioStream& listeningNodeStream,
+                                   float masterAvatarGain,
+                                   float masterInjectorGain,
+                                   bool isSoloing,
+                                   bool isDirectional) {
+    ++stats.totalMixes;
+
+    PositionalAudioStream& streamToAdd = *mixableStream.positionalStream;
+
+    glm::vec3 relativePosition = streamToAdd.getPosition() - listeningNodeStream.getPosition();
+
+    float distance = glm::max(glm::length(relativePosition), EPSILON);
+    float gain = isSoloing ? masterAvatarGain
+                           : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, streamToAdd,
+                                         relativePosition, distance);
+
+    // the HRTF would have applied the per-avatar gain
+    gain *= mixableStream.hrtf->getGainAdjustment();
+
+    // repeat with fade like renderStream does, an injector that didn't pop has likely ended
+    if (!streamToAdd.lastPopSucceeded()) {
+        bool isInjector = dynamic_cast<const InjectedAudioStream*>(&streamToAdd);
+        float fadeFactor = (streamToAdd.getLastPopOutput().isNull() || isInjector) ? 0.0f
+            : calculateRepeatedFrameFadeFactor(streamToAdd.getConsecutiveNotMixedCount() - 1);
+
+        if (fadeFactor <= 0.0f) {
+            // nothing to fade out with, the field has no tail of its own to flush per source
+            mixableStream.hasFieldGains = false;
+            return;
+        }
+        gain *= fadeFactor;
+    }
+
+    // encode in B-format (FuMa), in the listener's frame and Z-up, which is what AudioFOA takes
+    const float SQRT1_2 = 0.707106781f;
+    float gains[4] = { gain * SQRT1_2, 0.0f, 0.0f, 0.0f };
+    if (isDirectional) {
+        glm::vec3 direction = (glm::inverse(listeningNodeStream.getOrientation()) * relativePosition) / distance;
+        gains[1] = gain * -direction.z;
+        gains[2] = gain * -direction.x;
+        gains[3] = gain * direction.y;
+    }
+
+    if (!mixableStream.hasFieldGains) {
+        memcpy(mixableStream.fieldGains, gains, sizeof(gains));
+        mixableStream.hasFieldGains = true;
+    }
+
+    if (!_fieldHasAudio) {
+        memset(_fieldSamples, 0, sizeof(_fieldSamples));
+        _fieldHasAudio = true;
+    }
+
+    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd.getLastPopOutput();
+    streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    // ramp from last frame's gains so that sources moving around the field don't zipper
+    const int numFrames = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    for (int n = 0; n < 4; ++n) {
+        float gain0 = mixableStream.fieldGains[n] * (1 / 32768.0f);
+        float gainStep = (gains[n] - mixableStream.fieldGains[n]) * (1 / 32768.0f) / numFrames;
+        if (gain0 == 0.0f && gainStep == 0.0f) {
+            continue;
+        }
+
+        float* field = _fieldSamples[n];
+        for (int i = 0; i < numFrames; ++i) {
+            field[i] += (float)_bufferSamples[i] * (gain0 + gainStep * (i + 1));
+        }
+    }
+
+    memcpy(mixableStream.fieldGains, gains, sizeof(gains));
+
+    if (isDirectional) {
+        ++stats.fieldEncodes;
+    } else {
+        ++stats.bedEncodes;
+    }
+}
+
+void AudioMixerSlave::mixCluster(AudioListenerClusters::Cluster& cluster,
+                                 MixableStreamsVector& activeStreams,
+                                 AvatarAudioStream& listeningNodeStream,
+                                 float masterAvatarGain,
+                                 float masterInjectorGain) {
+    memset(cluster.mixSamples, 0, sizeof(cluster.mixSamples));
+
+    // every listener in the cluster has the same active far field streams, so this listener's stand in for all
+    for (auto& stream : activeStreams) {
+        if (!cluster.isFarField(*stream.positionalStream)) {
+            continue;
+        }
+
+        auto it = cluster.streams.find(stream.positionalStream);
+        if (it == cluster.streams.end()) {
+            it = cluster.streams.emplace(stream.positionalStream,
+                                         AudioListenerClusters::ClusterStream(stream.nodeStreamID)).first;
+        }
+
+        renderStream(*it->second.hrtf, *stream.positionalStream, listeningNodeStream,
+                     masterAvatarGain, masterInjectorGain, false, cluster.mixSamples);
+        it->second.mixedFrame = _frame;
+    }
+
+    // forget the streams that went quiet or moved into the near field, they start over if they come back
+    for (auto it = cluster.streams.begin(); it != cluster.streams.end();) {
+        it = (it->second.mixedFrame != _frame) ? cluster.streams.erase(it) : std::next(it);
+    }
+
+    cluster.mixedFrame = _frame;
+    ++stats.clusterMixes;
+}
+
 void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream& mixableStream,
                                            AvatarAudioStream& listeningNodeStream,
                                            float masterAvatarGain,
@@ -797,6 +1119,54 @@ float computeGain(float masterAvatarGain,
     return gain;
 }
 
+float computeAudibleDistance(float masterAvatarGain,
+                             float masterInjectorGain,
+                             const AvatarAudioStream& listeningNodeStream) {
+    // the loudest a source can reach the listener before distance attenuation, with its own gain at the maximum
+    static const float MAX_SOURCE_GAIN = unpackFloatGainFromByte(std::numeric_limits<uint8_t>::max());
+    float maxGain = std::max(masterAvatarGain, masterInjectorGain) * MAX_SOURCE_GAIN;
+
+    // below the last bit of the mix even for a full scale source
+    const float AUDIBILITY_THRESHOLD = 1.0f / 32768.0f;
+    // computeGain approximates the log and exp, leave some room for that
+    const float DISTANCE_MARGIN = 1.1f;
+
+    if (maxGain < AUDIBILITY_THRESHOLD) {
+        return 0.0f;
+    }
+
+    auto distanceForCoefficient = [&](float attenuationPerDoublingInDistance) {
+        if (attenuationPerDoublingInDistance < 0.0f) {
+            // a negative zone setting is a hard distance limit, see computeGain
+            const float MIN_DISTANCE_LIMIT = ATTN_DISTANCE_REF + 1.0f;
+            return std::max(-attenuationPerDoublingInDistance, MIN_DISTANCE_LIMIT) * DISTANCE_MARGIN;
+        }
+
+        const float MIN_ATTENUATION_COEFFICIENT = 0.001f;
+        float g = glm::clamp(1.0f - attenuationPerDoublingInDistance, MIN_ATTENUATION_COEFFICIENT, 1.0f);
+        if (g >= 1.0f) {
+            return std::numeric_limits<float>::infinity();
+        }
+
+        // solve maxGain * g^log2(distance / ATTN_DISTANCE_REF) = AUDIBILITY_THRESHOLD
+        float doublings = std::log2(AUDIBILITY_THRESHOLD / maxGain) / std::log2(g);
+        return ATTN_DISTANCE_REF * std::exp2(doublings) * DISTANCE_MARGIN;
+    };
+
+    // which setting applies depends on where the source is as well, so take the furthest any of them can reach
+    auto& audioZones = AudioMixer::getAudioZones();
+    auto& zoneSettings = AudioMixer::getZoneSettings();
+
+    float audibleDistance = distanceForCoefficient(AudioMixer::getAttenuationPerDoublingInDistance());
+    for (const auto& settings : zoneSettings) {
+        if (audioZones[settings.listener].area.contains(listeningNodeStream.getPosition())) {
+            audibleDistance = std::max(audibleDistance, distanceForCoefficient(settings.coefficient));
+        }
+    }
+
+    return audibleDistance;
+}
+
 float computeAzimuth(const AvatarAudioStream& listeningNodeStream,
                      const PositionalAudioStream& streamToAdd,
                      const glm::vec3& relativePosition) {
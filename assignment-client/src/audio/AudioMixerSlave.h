@@ -22,8 +22,12 @@
 #include <NodeList.h>
 #include <PositionalAudioStream.h>
 
+#include "AudioEncodedMixes.h"
+#include "AudioListenerClusters.h"
 #include "AudioMixerClientData.h"
+#include "AudioMixerProfiler.h"
 #include "AudioMixerStats.h"
+#include "AudioSourceGrid.h"
 
 class AvatarAudioStream;
 class AudioHRTF;
@@ -36,6 +40,18 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioListenerClusters listenerClusters;
+        AudioEncodedMixes encodedMixes;
+        AudioSourceGrid audioSources;
+        AudioMixerProfiler profiler;
+
+        // per-listener source level of detail, the nearest get HRTF, the next are encoded into an ambisonic
+        // field with direction, the rest into the same field without, 0 HRTF sources turns it off
+        int maxHRTFSources { 0 };
+        int maxFieldSources { 0 };
+
+        // the fraction of the streams the mixer is throttling away, the encoders trade quality for time as it grows
+        float throttlingRatio { 0.0f };
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -51,6 +67,7 @@ public:
     void mix(const SharedNodePointer& node);
 
     AudioMixerStats stats;
+    AudioMixerProfiler::Samples profileSamples; // gathered by the profiler after each sampled frame
 
 private:
     // create mix, returns true if mix has audio
@@ -60,6 +77,24 @@ private:
                    float masterAvatarGain,
                    float masterInjectorGain,
                    bool isSoloing);
+    void renderStream(AudioHRTF& hrtf,
+                      PositionalAudioStream& streamToAdd,
+                      AvatarAudioStream& listeningNodeStream,
+                      float masterAvatarGain,
+                      float masterInjectorGain,
+                      bool isSoloing,
+                      float* mixSamples);
+    void encodeStream(AudioMixerClientData::MixableStream& mixableStream,
+                      AvatarAudioStream& listeningNodeStream,
+                      float masterAvatarGain,
+                      float masterInjectorGain,
+                      bool isSoloing,
+                      bool isDirectional);
+    void mixCluster(AudioListenerClusters::Cluster& cluster,
+                    AudioMixerClientData::MixableStreamsVector& activeStreams,
+                    AvatarAudioStream& listeningNodeStream,
+                    float masterAvatarGain,
+                    float masterInjectorGain);
     void updateHRTFParameters(AudioMixerClientData::MixableStream& mixableStream,
                               AvatarAudioStream& listeningNodeStream,
                               float masterAvatarGain,
@@ -71,6 +106,8 @@ private:
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    float _fieldSamples[4][AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL]; // W, X, Y, Z
+    bool _fieldHasAudio { false };
 
     // frame state
     ConstIter _begin;
@@ -78,6 +115,11 @@ private:
     unsigned int _frame { 0 };
     int _numToRetain { -1 };
 
+    // listener state
+    AudioListenerClusters::Cluster* _cluster { nullptr }; // far field sources come from here if set
+    float _hrtfDistanceLimit2 { 0.0f }; // squared, sources further than this go into the listener's field
+    float _directionalDistanceLimit2 { 0.0f }; // squared, sources further than this go in without direction
+
     SharedData& _sharedData;
 };
 
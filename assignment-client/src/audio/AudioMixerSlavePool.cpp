@@ -13,16 +13,29 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <chrono>
+#include <functional>
+
+#include <PortableHighResolutionClock.h>
 
 void AudioMixerSlaveThread::run() {
     while (true) {
         wait();
 
-        // iterate over all available nodes
+        auto start = p_high_resolution_clock::now();
+
+        // iterate over our own nodes, then help the slaves that are still busy
         SharedNodePointer node;
         while (try_pop(node)) {
             (this->*_function)(node);
         }
+        while (try_steal(node)) {
+            (this->*_function)(node);
+            ++stats.stolenNodes;
+        }
+
+        auto busy = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - start);
+        stats.busyTime += busy.count();
 
         bool stopping = _stop;
         notify(stopping);
@@ -61,13 +74,39 @@ void AudioMixerSlaveThread::notify(bool stopping) {
 }
 
 bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+    Lock lock(_queueMutex);
+    if (_queue.empty()) {
+        return false;
+    }
+
+    node = std::move(_queue.front());
+    _queue.pop_front();
+    return true;
+}
+
+bool AudioMixerSlaveThread::try_steal(SharedNodePointer& node) {
+    // start with our neighbour so that idle slaves don't all pile onto the same victim
+    size_t numSlaves = _pool._slaves.size();
+    for (size_t i = 1; i < numSlaves; ++i) {
+        auto& victim = *_pool._slaves[(_index + i) % numSlaves];
+
+        Lock lock(victim._queueMutex);
+        if (!victim._queue.empty()) {
+            node = std::move(victim._queue.back());
+            victim._queue.pop_back();
+            return true;
+        }
+    }
+
+    return false;
 }
 
 void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     _function = &AudioMixerSlave::processPackets;
     _configure = [](AudioMixerSlave& slave) {};
-    run(begin, end);
+
+    // there's nothing to go on for packets, so deal them out evenly
+    run(begin, end, [](const SharedNodePointer& node) { return 1; });
 }
 
 void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain) {
@@ -76,17 +115,43 @@ void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame
         slave.configureMix(_begin, _end, frame, numToRetain);
     };
 
-    run(begin, end);
+    run(begin, end, [](const SharedNodePointer& node) {
+        auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+
+        // nodes that have not been mixed yet are weighed as cheap, they are likely to be
+        const uint64_t MIN_MIX_COST = 1;
+        return data ? std::max(data->getLastMixCost(), MIN_MIX_COST) : MIN_MIX_COST;
+    });
 }
 
-void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AudioMixerSlavePool::run(ConstIter begin, ConstIter end,
+                              std::function<uint64_t(const SharedNodePointer& node)> weigh) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
+    // fill the queues, heaviest nodes first, each to the least loaded slave
+    std::vector<std::pair<uint64_t, SharedNodePointer>> nodes;
     std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
+        nodes.emplace_back(weigh(node), node);
     });
+    std::stable_sort(nodes.begin(), nodes.end(), [](const std::pair<uint64_t, SharedNodePointer>& a,
+                                                    const std::pair<uint64_t, SharedNodePointer>& b) {
+        return a.first > b.first;
+    });
+
+    for (auto& slave : _slaves) {
+        slave->_queuedCost = 0;
+    }
+    for (auto& node : nodes) {
+        auto& slave = *std::min_element(_slaves.begin(), _slaves.end(),
+            [](const std::unique_ptr<AudioMixerSlaveThread>& a, const std::unique_ptr<AudioMixerSlaveThread>& b) {
+                return a->_queuedCost < b->_queuedCost;
+            });
+        slave->_queuedCost += node.first;
+        slave->_queue.push_back(std::move(node.second));
+    }
+
+    auto start = p_high_resolution_clock::now();
 
     {
         Lock lock(_mutex);
@@ -104,7 +169,11 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
         assert(_numStarted == _numThreads);
     }
 
-    assert(_queue.empty());
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - start);
+    for (auto& slave : _slaves) {
+        assert(slave->_queue.empty());
+        slave->stats.poolTime += elapsed.count();
+    }
 }
 
 void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> functor) {
@@ -157,6 +226,7 @@ void AudioMixerSlavePool::resize(int numThreads) {
         // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
             auto slave = new AudioMixerSlaveThread(*this, _workerSharedData);
+            slave->_index = _slaves.size();
             slave->start();
             _slaves.emplace_back(slave);
         }
@@ -13,12 +13,12 @@
 #define hifi_AudioMixerSlavePool_h
 
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <vector>
 
 #include <QThread>
 #include <shared/QtHelpers.h>
-#include <TBBHelpers.h>
 
 #include "AudioMixerSlave.h"
 
@@ -42,16 +42,25 @@ private:
     void wait();
     void notify(bool stopping);
     bool try_pop(SharedNodePointer& node);
+    bool try_steal(SharedNodePointer& node);
 
     AudioMixerSlavePool& _pool;
+
+    // this slave's share of the frame, heaviest first, other slaves steal from the back once theirs run out
+    Mutex _queueMutex;
+    std::deque<SharedNodePointer> _queue;
+    uint64_t _queuedCost { 0 }; // only used by the pool while filling the queues
+    size_t _index { 0 };
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
     bool _stop { false };
 };
 
 // Slave pool for audio mixers
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
+//
+//   Each frame the nodes are dealt to the slaves heaviest first, always to the least loaded slave, weighted by what
+//   they cost to mix last frame. Slaves that run out of work steal the lightest nodes left on the others.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -80,7 +89,7 @@ public:
     int numThreads() { return _numThreads; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, std::function<uint64_t(const SharedNodePointer& node)> weigh);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
@@ -88,6 +97,7 @@ private:
     friend void AudioMixerSlaveThread::wait();
     friend void AudioMixerSlaveThread::notify(bool stopping);
     friend bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend bool AudioMixerSlaveThread::try_steal(SharedNodePointer& node);
 
     // synchronization state
     Mutex _mutex;
@@ -101,7 +111,6 @@ private:
     int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
     ConstIter _begin;
     ConstIter _end;
 
@@ -25,16 +25,33 @@ void AudioMixerStats::reset() {
     manualStereoMixes = 0;
     manualEchoMixes = 0;
 
+    fieldEncodes = 0;
+    bedEncodes = 0;
+    fieldRenders = 0;
+
+    clusteredListeners = 0;
+    clusterMixes = 0;
+    clusteredStreams = 0;
+
+    sharedEncodes = 0;
+
     skippedToActive = 0;
     skippedToInactive = 0;
     inactiveToSkipped = 0;
     inactiveToActive = 0;
     activeToSkipped = 0;
     activeToInactive = 0;
+    toCulled = 0;
+    culledToInactive = 0;
 
     skipped = 0;
     inactive = 0;
     active = 0;
+    culled = 0;
+
+    stolenNodes = 0;
+    busyTime = 0;
+    poolTime = 0;
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
@@ -55,16 +72,33 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
 
+    fieldEncodes += otherStats.fieldEncodes;
+    bedEncodes += otherStats.bedEncodes;
+    fieldRenders += otherStats.fieldRenders;
+
+    clusteredListeners += otherStats.clusteredListeners;
+    clusterMixes += otherStats.clusterMixes;
+    clusteredStreams += otherStats.clusteredStreams;
+
+    sharedEncodes += otherStats.sharedEncodes;
+
     skippedToActive += otherStats.skippedToActive;
     skippedToInactive += otherStats.skippedToInactive;
     inactiveToSkipped += otherStats.inactiveToSkipped;
     inactiveToActive += otherStats.inactiveToActive;
     activeToSkipped += otherStats.activeToSkipped;
     activeToInactive += otherStats.activeToInactive;
+    toCulled += otherStats.toCulled;
+    culledToInactive += otherStats.culledToInactive;
 
     skipped += otherStats.skipped;
     inactive += otherStats.inactive;
     active += otherStats.active;
+    culled += otherStats.culled;
+
+    stolenNodes += otherStats.stolenNodes;
+    busyTime += otherStats.busyTime;
+    poolTime += otherStats.poolTime;
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
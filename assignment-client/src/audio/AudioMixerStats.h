@@ -12,9 +12,7 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
 #include <cstdint>
-#endif
 
 struct AudioMixerStats {
     int sumStreams { 0 };
@@ -30,16 +28,34 @@ struct AudioMixerStats {
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
+    int fieldEncodes { 0 };
+    int bedEncodes { 0 };
+    int fieldRenders { 0 };
+
+    int clusteredListeners { 0 };
+    int clusterMixes { 0 };
+    int clusteredStreams { 0 };
+
+    int sharedEncodes { 0 };
+
     int skippedToActive { 0 };
     int skippedToInactive { 0 };
     int inactiveToSkipped { 0 };
     int inactiveToActive { 0 };
     int activeToSkipped { 0 };
     int activeToInactive { 0 };
+    int toCulled { 0 };
+    int culledToInactive { 0 };
 
     int skipped { 0 };
     int inactive { 0 };
     int active { 0 };
+    int culled { 0 };
+
+    // scheduling, per slave until accumulated
+    int stolenNodes { 0 };
+    uint64_t busyTime { 0 }; // usecs spent on nodes
+    uint64_t poolTime { 0 }; // usecs the pool was running, busy or not
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
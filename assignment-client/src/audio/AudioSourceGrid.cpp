@@ -0,0 +1,41 @@
+//
+//  AudioSourceGrid.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSourceGrid.h"
+
+#include <functional>
+
+// about the range of a distance limited zone, so a typical query touches a handful of cells
+const float AudioSourceGrid::CELL_SIZE = 16.0f;
+
+size_t AudioSourceGrid::CellHasher::operator()(const glm::ivec3& cell) const {
+    size_t hash = std::hash<int>()(cell.x);
+    hash = hash * 31 + std::hash<int>()(cell.y);
+    hash = hash * 31 + std::hash<int>()(cell.z);
+    return hash;
+}
+
+void AudioSourceGrid::clear() {
+    // keep the cells' storage around, most sources stay in the same cell from one frame to the next
+    for (auto it = _cells.begin(); it != _cells.end();) {
+        if (it->second.empty()) {
+            it = _cells.erase(it);
+        } else {
+            it->second.clear();
+            ++it;
+        }
+    }
+    _numSources = 0;
+}
+
+void AudioSourceGrid::insert(const PositionalAudioStream& stream) {
+    _cells[cellFor(stream.getPosition())].push_back({ stream.getPosition(), &stream });
+    ++_numSources;
+}
@@ -0,0 +1,93 @@
+//
+//  AudioSourceGrid.h
+//  assignment-client/src/audio
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSourceGrid_h
+#define hifi_AudioSourceGrid_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/norm.hpp>
+
+#include <PositionalAudioStream.h>
+
+// Where every audio source is this frame, bucketed into a sparse uniform grid so that a listener can find the
+// sources within its audible range without looking at the others.
+class AudioSourceGrid {
+public:
+    static const float CELL_SIZE; // meters
+
+    // not thread-safe, called between mixes once the frame's positions are in
+    void clear();
+    void insert(const PositionalAudioStream& stream);
+
+    // thread-safe once built, calls f with every source within radius of the center
+    template <typename F>
+    void forEachWithin(const glm::vec3& center, float radius, F f) const;
+
+    int getNumSources() const { return _numSources; }
+
+private:
+    struct Source {
+        glm::vec3 position;
+        const PositionalAudioStream* stream;
+    };
+
+    struct CellHasher {
+        size_t operator()(const glm::ivec3& cell) const;
+    };
+
+    static glm::ivec3 cellFor(const glm::vec3& position) { return glm::ivec3(glm::floor(position / CELL_SIZE)); }
+
+    std::unordered_map<glm::ivec3, std::vector<Source>, CellHasher> _cells;
+    int _numSources { 0 };
+};
+
+template <typename F>
+void AudioSourceGrid::forEachWithin(const glm::vec3& center, float radius, F f) const {
+    float radius2 = radius * radius;
+    auto visit = [&](const std::vector<Source>& sources) {
+        for (const auto& source : sources) {
+            if (glm::length2(source.position - center) <= radius2) {
+                f(*source.stream);
+            }
+        }
+    };
+
+    // past this the cell coordinates of the range don't fit in an int, and it covers the domain anyway
+    const float MAX_CELL_RADIUS = CELL_SIZE * (1 << 20);
+    bool isWide = radius > MAX_CELL_RADIUS;
+
+    glm::ivec3 minCell = isWide ? glm::ivec3() : cellFor(center - glm::vec3(radius));
+    glm::ivec3 maxCell = isWide ? glm::ivec3() : cellFor(center + glm::vec3(radius));
+    glm::dvec3 extent = glm::dvec3(maxCell - minCell) + 1.0;
+
+    if (isWide || extent.x * extent.y * extent.z > (double)_cells.size()) {
+        // the range covers more cells than are occupied, so look at the occupied ones instead
+        for (const auto& cell : _cells) {
+            visit(cell.second);
+        }
+        return;
+    }
+
+    for (int x = minCell.x; x <= maxCell.x; ++x) {
+        for (int y = minCell.y; y <= maxCell.y; ++y) {
+            for (int z = minCell.z; z <= maxCell.z; ++z) {
+                auto it = _cells.find(glm::ivec3(x, y, z));
+                if (it != _cells.end()) {
+                    visit(it->second);
+                }
+            }
+        }
+    }
+}
+
+#endif // hifi_AudioSourceGrid_h
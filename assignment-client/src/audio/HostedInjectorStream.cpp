@@ -0,0 +1,131 @@
+//
+//  HostedInjectorStream.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HostedInjectorStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <AudioHelpers.h>
+#include <SoundCache.h>
+
+#include "AudioLogging.h"
+
+HostedInjectorStream::HostedInjectorStream(const QUuid& streamIdentifier) :
+    InjectedAudioStream(streamIdentifier, false) {}
+
+void HostedInjectorStream::parseControl(HostedInjectorCommand command, ReceivedMessage& message) {
+    glm::vec3 position;
+    glm::quat orientation;
+    quint8 volume;
+    message.readPrimitive(&position);
+    message.readPrimitive(&orientation);
+    message.readPrimitive(&volume);
+
+    if (glm::any(glm::isnan(position)) || glm::isnan(orientation.x)) {
+        qCDebug(audio) << "Ignoring hosted injector control from" << message.getSourceID() << "with invalid position";
+        return;
+    }
+
+    _position = position;
+    _orientation = orientation;
+    _attenuationRatio = unpackFloatGainFromByte(volume);
+
+    if (command != HostedInjectorCommand::Start) {
+        return;
+    }
+
+    bool isStereo;
+    quint32 byteOffset;
+    message.readPrimitive(&isStereo);
+    message.readPrimitive(&_loop);
+    message.readPrimitive(&_ignorePenumbra);
+    message.readPrimitive(&byteOffset);
+    QUrl url(message.readString());
+
+    // a start on a stream we already have is a restart, possibly of a different sound
+    setStereo(isStereo);
+    clearBuffer();
+    _nextSample = byteOffset / AudioConstants::SAMPLE_SIZE;
+    _isFinished = false;
+    _audioData.reset();
+    _sound = DependencyManager::get<SoundCache>()->getSound(url);
+}
+
+bool HostedInjectorStream::renderNextFrame() {
+    if (_isFinished) {
+        return false;
+    }
+
+    if (!_audioData) {
+        if (!_sound || _sound->isFailed()) {
+            _isFinished = true;
+            return false;
+        }
+        if (!_sound->isReady()) {
+            // nothing to play until the sound is in the cache, the stream stays starved meanwhile
+            return true;
+        }
+
+        _audioData = _sound->getAudioData();
+        if (_audioData->getNumSamples() == 0 || _audioData->isAmbisonic()) {
+            qCDebug(audio) << "Hosted injector" << _streamIdentifier << "can't play" << _sound->getURL();
+            _isFinished = true;
+            return false;
+        }
+
+        setStereo(_audioData->isStereo());
+        _nextSample -= _nextSample % _audioData->getNumChannels();
+    }
+
+    using AudioConstants::AudioSample;
+    AudioSample frame[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+
+    const AudioSample* samples = _audioData->data();
+    uint32_t numSamples = _audioData->getNumSamples();
+    int numFrameSamples = _ringBuffer.getNumFrameSamples();
+
+    int numRendered = 0;
+    while (numRendered < numFrameSamples) {
+        if (_nextSample >= numSamples) {
+            if (!_loop) {
+                break;
+            }
+            _nextSample = 0;
+        }
+
+        int numToCopy = std::min(numFrameSamples - numRendered, (int)(numSamples - _nextSample));
+        memcpy(&frame[numRendered], &samples[_nextSample], numToCopy * sizeof(AudioSample));
+        numRendered += numToCopy;
+        _nextSample += numToCopy;
+    }
+
+    if (numRendered == 0) {
+        _isFinished = true;
+        return false;
+    }
+    memset(&frame[numRendered], 0, (numFrameSamples - numRendered) * sizeof(AudioSample));
+
+    _ringBuffer.writeSamples(frame, numFrameSamples);
+
+    // frames are produced in step with the mix, so there is no jitter to buffer against
+    _isStarved = false;
+
+    return true;
+}
+
+void HostedInjectorStream::setStereo(bool isStereo) {
+    if (isStereo != _isStereo) {
+        _ringBuffer.resizeForFrameSize(isStereo
+                                       ? AudioConstants::NETWORK_FRAME_SAMPLES_STEREO
+                                       : AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        _isStereo = isStereo;
+    }
+}
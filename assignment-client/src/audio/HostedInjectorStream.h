@@ -0,0 +1,46 @@
+//
+//  HostedInjectorStream.h
+//  assignment-client/src/audio
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HostedInjectorStream_h
+#define hifi_HostedInjectorStream_h
+
+#include <ReceivedMessage.h>
+#include <Sound.h>
+
+#include "InjectedAudioStream.h"
+
+// An injector whose sound the mixer plays from its own SoundCache. The sending node only controls it with
+// HostedInjectorControl packets (start, position, orientation and volume) and stops it with a StopInjector packet.
+class HostedInjectorStream : public InjectedAudioStream {
+public:
+    HostedInjectorStream(const QUuid& streamIdentifier);
+
+    // parses the rest of a HostedInjectorControl packet, after the stream identifier and command
+    void parseControl(HostedInjectorCommand command, ReceivedMessage& message);
+
+    // called once per frame before the stream is popped, writes the next frame of the sound to the ring buffer
+    // returns false once a sound that doesn't loop has played out, or it can't be played at all
+    bool renderNextFrame();
+
+private:
+    // disallow copying of HostedInjectorStream objects
+    HostedInjectorStream(const HostedInjectorStream&);
+    HostedInjectorStream& operator= (const HostedInjectorStream&);
+
+    void setStereo(bool isStereo);
+
+    SharedSoundPointer _sound;
+    AudioDataPointer _audioData;
+    bool _loop { false };
+    uint32_t _nextSample { 0 };
+    bool _isFinished { false };
+};
+
+#endif // hifi_HostedInjectorStream_h
@@ -15,7 +15,9 @@
 #include <chrono>
 #include <memory>
 #include <random>
+#include <set>
 #include <thread>
+#include <tuple>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
@@ -91,6 +93,7 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     }, this, "handleReplicatedPacket");
 
     packetReceiver.registerListener(PacketType::ReplicatedBulkAvatarData, this, "handleReplicatedBulkAvatarPacket");
+    packetReceiver.registerListener(PacketType::AvatarReplicationInterest, this, "handleAvatarReplicationInterestPacket");
 
     auto nodeList = DependencyManager::get<NodeList>();
     connect(nodeList.data(), &NodeList::packetVersionMismatch, this, &AvatarMixer::handlePacketVersionMismatch);
@@ -168,6 +171,63 @@ void AvatarMixer::handleReplicatedBulkAvatarPacket(QSharedPointer<ReceivedMessag
     }
 }
 
+void AvatarMixer::handleAvatarReplicationInterestPacket(QSharedPointer<ReceivedMessage> message) {
+    // the packet is non-sourced, so match it to the downstream mixer by where it came from
+    auto downstreamNode = DependencyManager::get<NodeList>()->findNodeWithAddr(message->getSenderSockAddr());
+    if (downstreamNode && downstreamNode->getType() == NodeType::DownstreamAvatarMixer) {
+        getOrCreateClientData(downstreamNode)->processReplicationInterestMessage(*message);
+    }
+}
+
+void AvatarMixer::sendReplicationInterest() {
+    const quint64 REPLICATION_INTEREST_INTERVAL_USECS = USECS_PER_SECOND;
+    auto now = usecTimestampNow();
+    if (_replicationInterestRadius <= 0.0f || now - _lastReplicationInterestSent < REPLICATION_INTEREST_INTERVAL_USECS) {
+        return;
+    }
+    _lastReplicationInterestSent = now;
+
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    std::vector<glm::vec3> listenerPositions;
+    nodeList->eachNode([&](const SharedNodePointer& node) {
+        if (node->getType() == NodeType::Agent && node->getLinkedData() && !node->isUpstream()) {
+            listenerPositions.push_back(static_cast<AvatarMixerClientData*>(node->getLinkedData())->getPosition());
+        }
+    });
+
+    // one region per occupied cell, with the cells made coarser until they fit in a single packet
+    const int MAX_REGIONS = (int)((NLPacket::maxPayloadSize(PacketType::AvatarReplicationInterest) - sizeof(quint16)) /
+                                  sizeof(glm::vec4));
+    float cellSize = AvatarSpatialGrid::CELL_SIZE;
+    std::set<std::tuple<int, int, int>> cells;
+    do {
+        cells.clear();
+        for (const auto& position : listenerPositions) {
+            glm::ivec3 cell = glm::ivec3(glm::floor(position / cellSize));
+            cells.emplace(cell.x, cell.y, cell.z);
+        }
+        cellSize *= 2.0f;
+    } while ((int)cells.size() > MAX_REGIONS);
+    cellSize /= 2.0f;
+
+    // enough to cover every listener in the cell and what it can see around it
+    float regionRadius = _replicationInterestRadius + 0.5f * SQRT_THREE * cellSize;
+
+    auto packet = NLPacket::create(PacketType::AvatarReplicationInterest);
+    packet->writePrimitive((quint16)cells.size());
+    for (const auto& cell : cells) {
+        glm::vec3 center = (glm::vec3(std::get<0>(cell), std::get<1>(cell), std::get<2>(cell)) + 0.5f) * cellSize;
+        packet->writePrimitive(glm::vec4(center, regionRadius));
+    }
+
+    nodeList->eachMatchingNode([](const SharedNodePointer& node) {
+        return node->getType() == NodeType::UpstreamAvatarMixer;
+    }, [&](const SharedNodePointer& node) {
+        nodeList->sendUnreliablePacket(*packet, *node);
+    });
+}
+
 void AvatarMixer::optionallyReplicatePacket(ReceivedMessage& message, const Node& node) {
     // first, make sure that this is a packet from a node we are supposed to replicate
     if (node.isReplicated()) {
@@ -189,8 +249,16 @@ void AvatarMixer::optionallyReplicatePacket(ReceivedMessage& message, const Node
         std::unique_ptr<NLPacket> packet;
 
         auto nodeList = DependencyManager::get<NodeList>();
+        // kills always go out, a downstream mixer may have the avatar from before it left its interest
+        auto nodeData = static_cast<const AvatarMixerClientData*>(node.getLinkedData());
+        bool needsInterest = nodeData && replicatedType != PacketType::ReplicatedKillAvatar;
+
         nodeList->eachMatchingNode([&](const SharedNodePointer& downstreamNode) {
-            return shouldReplicateTo(node, *downstreamNode);
+            if (!shouldReplicateTo(node, *downstreamNode)) {
+                return false;
+            }
+            auto downstreamData = static_cast<const AvatarMixerClientData*>(downstreamNode->getLinkedData());
+            return !needsInterest || !downstreamData || downstreamData->isInReplicationInterest(nodeData->getPosition());
         }, [&](const SharedNodePointer& node) {
             if (!packet) {
                 // construct an NLPacket to send to the replicant that has the contents of the received packet
@@ -317,6 +385,21 @@ void AvatarMixer::start() {
             _broadcastAvatarDataNodeFunctor += functor;
         }
 
+        // bucket this frame's avatar positions so that each listener can tell the far avatars from the near ones
+        {
+            auto& avatarGrid = _slaveSharedData.avatarGrid;
+            avatarGrid.clear();
+            nodeList->eachNode([&](const SharedNodePointer& node) {
+                if (node->getType() == NodeType::Agent && node->getLinkedData()) {
+                    const auto& avatar = static_cast<AvatarMixerClientData*>(node->getLinkedData())->getAvatar();
+                    glm::vec3 boxScale = avatar.getGlobalBoundingBox().getScale();
+                    float radius = 0.5f * glm::max(boxScale.x, glm::max(boxScale.y, boxScale.z));
+                    avatarGrid.insert(node->getLocalID(), avatar.getClientGlobalPosition(), radius);
+                }
+            });
+            _slaveSharedData.frame = frame;
+        }
+
         // this is where we need to put the real work...
         {
             auto start = usecTimestampNow();
@@ -326,6 +409,8 @@ void AvatarMixer::start() {
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
             }, &lockWait, &nodeTransform, &functor);
+            nodeList->flushCoalescedPackets();
+
             auto end = usecTimestampNow();
             _broadcastAvatarDataElapsedTime += (end - start);
 
@@ -334,6 +419,8 @@ void AvatarMixer::start() {
             _broadcastAvatarDataNodeFunctor += functor;
         }
 
+        sendReplicationInterest();
+
         ++frame;
         ++_numTightLoopFrames;
         _loopRate.increment();
@@ -826,6 +913,7 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["received_1_nodesProcessed"] = TIGHT_LOOP_STAT(aggregateStats.nodesProcessed);
 
     slavesAggregatObject["sent_1_nodesBroadcastedTo"] = TIGHT_LOOP_STAT(aggregateStats.nodesBroadcastedTo);
+    slavesAggregatObject["nodesStolen"] = TIGHT_LOOP_STAT(aggregateStats.nodesStolen);
 
     float averageNodes = ((float)aggregateStats.nodesBroadcastedTo / (float)tightLoopFrames);
 
@@ -839,6 +927,10 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
 
+    float averageFarAvatarsDeferred = averageNodes ? aggregateStats.numFarAvatarsDeferred / averageNodes : 0.0f;
+    slavesAggregatObject["sent_8_averageFarAvatarsDeferred"] = TIGHT_LOOP_STAT(averageFarAvatarsDeferred);
+    slavesAggregatObject["sent_9_averageSharedEncodings"] = TIGHT_LOOP_STAT(aggregateStats.numSharedEncodingsSent);
+
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
     slavesAggregatObject["timing_3_toByteArray"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayElapsedTime);
@@ -1029,6 +1121,40 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         }
     }
 
+    {
+        static const QString FAR_AVATAR_UPDATE_INTERVAL_KEY = "far_avatar_update_interval";
+        bool ok;
+        int farAvatarUpdateInterval = avatarMixerGroupObject[FAR_AVATAR_UPDATE_INTERVAL_KEY].toString().toInt(&ok);
+        if (ok) {
+            _slaveSharedData.farAvatarUpdateInterval = std::max(farAvatarUpdateInterval, 1);
+        }
+        qCDebug(avatars) << "Avatar mixer will update far, out of view avatars every"
+                         << _slaveSharedData.farAvatarUpdateInterval << "frames";
+    }
+
+    {
+        static const QString REPLICATION_INTEREST_RADIUS_KEY = "replication_interest_radius";
+        bool ok;
+        float replicationInterestRadius =
+            avatarMixerGroupObject[REPLICATION_INTEREST_RADIUS_KEY].toString().toFloat(&ok);
+        _replicationInterestRadius = ok ? std::max(replicationInterestRadius, 0.0f) : 0.0f;
+        if (_replicationInterestRadius > 0.0f) {
+            qCDebug(avatars) << "Avatar mixer will only ask upstream mixers for avatars within"
+                             << _replicationInterestRadius << "meters of its clients";
+        }
+    }
+
+    {
+        static const QString MIN_AVATAR_UPDATE_RATE_KEY = "min_avatar_update_rate";
+        bool ok;
+        int minAvatarUpdateRate = avatarMixerGroupObject[MIN_AVATAR_UPDATE_RATE_KEY].toString().toInt(&ok);
+        if (ok) {
+            _slaveSharedData.minAvatarUpdateRate = std::max(minAvatarUpdateRate, 1);
+        }
+        qCDebug(avatars) << "Avatar mixer will update every avatar a client is sent at least"
+                         << _slaveSharedData.minAvatarUpdateRate << "times a second";
+    }
+
     const QString AVATARS_SETTINGS_KEY = "avatars";
 
     static const QString MIN_HEIGHT_OPTION = "min_avatar_height";
@@ -1095,7 +1221,7 @@ void AvatarMixer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, Sh
         const auto piggyBackedSizeWithHeader = message->getBytesLeftToRead();
         if (piggyBackedSizeWithHeader > 0) {
             // pull out the piggybacked packet and create a new QSharedPointer<NLPacket> for it
-            auto buffer = std::unique_ptr<char[]>(new char[piggyBackedSizeWithHeader]);
+            auto buffer = udt::PacketBufferPool::allocate(piggyBackedSizeWithHeader);
             memcpy(buffer.get(), message->getRawMessage() + message->getPosition(), piggyBackedSizeWithHeader);
 
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggyBackedSizeWithHeader, message->getSenderSockAddr());
@@ -62,6 +62,7 @@ private slots:
     void handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleReplicatedPacket(QSharedPointer<ReceivedMessage> message);
     void handleReplicatedBulkAvatarPacket(QSharedPointer<ReceivedMessage> message);
+    void handleAvatarReplicationInterestPacket(QSharedPointer<ReceivedMessage> message);
     void domainSettingsRequestComplete();
     void handlePacketVersionMismatch(PacketType type, const HifiSockAddr& senderSockAddr, const QUuid& senderUUID);
     void handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
@@ -79,6 +80,9 @@ private:
 
     void optionallyReplicatePacket(ReceivedMessage& message, const Node& node);
 
+    // as a downstream mixer, tells the upstream mixers which regions we have listeners in
+    void sendReplicationInterest();
+
     void setupEntityQuery();
 
     p_high_resolution_clock::time_point _lastFrameTimestamp;
@@ -98,6 +102,9 @@ private:
 
     float _maxKbpsPerNode = 0.0f;
 
+    float _replicationInterestRadius { 0.0f }; // 0 asks upstream mixers for every avatar
+    quint64 _lastReplicationInterestSent { 0 };
+
     float _domainMinimumHeight { MIN_AVATAR_HEIGHT };
     float _domainMaximumHeight { MAX_AVATAR_HEIGHT };
 
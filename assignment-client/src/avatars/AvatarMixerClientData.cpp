@@ -269,6 +269,38 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
     }
 }
 
+void AvatarMixerClientData::processReplicationInterestMessage(ReceivedMessage& message) {
+    quint16 numRegions;
+    if (message.getBytesLeftToRead() < qint64(sizeof(numRegions))) {
+        return;
+    }
+    message.readPrimitive(&numRegions);
+
+    if (message.getBytesLeftToRead() < qint64(numRegions * sizeof(glm::vec4))) {
+        qCWarning(avatars) << "Malformed replication interest packet from downstream mixer" << getNodeID();
+        return;
+    }
+
+    _replicationInterest.resize(numRegions);
+    for (auto& region : _replicationInterest) {
+        message.readPrimitive(&region);
+    }
+    _replicationInterestTimestamp = usecTimestampNow();
+}
+
+bool AvatarMixerClientData::isInReplicationInterest(const glm::vec3& position) const {
+    // the downstream mixer refreshes its interest every second, one that went quiet gets everything again
+    const quint64 REPLICATION_INTEREST_TIMEOUT_USECS = 5 * USECS_PER_SECOND;
+    if (usecTimestampNow() - _replicationInterestTimestamp > REPLICATION_INTEREST_TIMEOUT_USECS) {
+        return true;
+    }
+
+    return std::any_of(_replicationInterest.begin(), _replicationInterest.end(), [&](const glm::vec4& region) {
+        glm::vec3 offset = position - glm::vec3(region);
+        return glm::dot(offset, offset) <= region.w * region.w;
+    });
+}
+
 void AvatarMixerClientData::processBulkAvatarTraitsAckMessage(ReceivedMessage& message) {
     // Avatar Traits flow control marks each outgoing avatar traits packet with a
     // sequence number. The mixer caches the traits sent in the traits packet.
@@ -463,6 +495,9 @@ void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
     jsonObject["num_avs_sent_last_frame"] = _numAvatarsSentLastFrame;
     jsonObject["avg_other_av_starves_per_second"] = getAvgNumOtherAvatarStarvesPerSecond();
     jsonObject["avg_other_av_skips_per_second"] = getAvgNumOtherAvatarSkipsPerSecond();
+    jsonObject["avg_other_av_updates_per_second"] = getAvgNumOtherAvatarUpdatesPerSecond();
+    jsonObject["avg_other_av_overdue_per_second"] = getAvgNumOtherAvatarsOverduePerSecond();
+    jsonObject["max_other_av_update_age"] = _maxOtherAvatarUpdateAge;
     jsonObject["total_num_out_of_order_sends"] = _numOutOfOrderSends;
 
     jsonObject[OUTBOUND_AVATAR_DATA_STATS_KEY] = getOutboundAvatarDataKbps();
@@ -488,6 +523,7 @@ void AvatarMixerClientData::cleanupKilledNode(const QUuid&, Node::LocalID nodeLo
     removeLastBroadcastSequenceNumber(nodeLocalID);
     removeLastBroadcastTime(nodeLocalID);
     _lastSentTraitsTimestamps.erase(nodeLocalID);
+    _otherAvatarSchedules.erase(nodeLocalID);
     _perNodeSentTraitVersions.erase(nodeLocalID);
     _perNodeAckedTraitVersions.erase(nodeLocalID);
     for (auto&& pendingTraitVersions : _perNodePendingTraitVersions) {
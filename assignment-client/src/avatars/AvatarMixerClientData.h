@@ -82,12 +82,32 @@ public:
     void recordNumOtherAvatarSkips(int numOtherAvatarSkips) { _otherAvatarSkips.updateAverage((float) numOtherAvatarSkips); }
     float getAvgNumOtherAvatarSkipsPerSecond() const { return _otherAvatarSkips.getAverageSampleValuePerSecond(); }
 
+    // what the bandwidth scheduler achieved for this listener in a frame, maxUpdateAge is in seconds
+    void recordOtherAvatarUpdates(int numUpdates, int numOverdue, float maxUpdateAge) {
+        _otherAvatarUpdates.updateAverage((float)numUpdates);
+        _otherAvatarsOverdue.updateAverage((float)numOverdue);
+        _maxOtherAvatarUpdateAge = maxUpdateAge;
+    }
+    float getAvgNumOtherAvatarUpdatesPerSecond() const { return _otherAvatarUpdates.getAverageSampleValuePerSecond(); }
+    float getAvgNumOtherAvatarsOverduePerSecond() const { return _otherAvatarsOverdue.getAverageSampleValuePerSecond(); }
+
+    // the bandwidth scheduler's state for another avatar sent to this listener
+    struct OtherAvatarSchedule {
+        float deficit { 0.0f }; // bytes the avatar is owed out of this listener's budget
+        int lastSentBytes { 0 };
+    };
+    OtherAvatarSchedule& getOtherAvatarSchedule(Node::LocalID otherAvatar) { return _otherAvatarSchedules[otherAvatar]; }
+
     void incrementNumOutOfOrderSends() { ++_numOutOfOrderSends; }
 
     int getNumFramesSinceFRDAdjustment() const { return _numFramesSinceAdjustment; }
     void incrementNumFramesSinceFRDAdjustment() { ++_numFramesSinceAdjustment; }
     void resetNumFramesSinceFRDAdjustment() { _numFramesSinceAdjustment = 0; }
 
+    // how long the last broadcast to this node took, in microseconds
+    uint64_t getLastBroadcastCost() const { return _lastBroadcastCost; }
+    void setLastBroadcastCost(uint64_t cost) { _lastBroadcastCost = cost; }
+
     void recordSentAvatarData(int numDataBytes, int numTraitsBytes = 0) {
         _avgOtherAvatarDataRate.updateAverage(numDataBytes);
         _avgOtherAvatarTraitsRate.updateAverage(numTraitsBytes);
@@ -133,6 +153,11 @@ public:
 
     void processSetTraitsMessage(ReceivedMessage& message, const SlaveSharedData& slaveSharedData, Node& sendingNode);
     void processBulkAvatarTraitsAckMessage(ReceivedMessage& message);
+
+    // for data of a downstream avatar mixer, the regions it has listeners in
+    void processReplicationInterestMessage(ReceivedMessage& message);
+    // true if the downstream mixer wants this avatar, always true for mixers that haven't asked for only some
+    bool isInReplicationInterest(const glm::vec3& position) const;
     void checkSkeletonURLAgainstWhitelist(const SlaveSharedData& slaveSharedData, Node& sendingNode,
                                           AvatarTraits::TraitVersion traitVersion);
 
@@ -158,6 +183,9 @@ public:
 
     void resetSentTraitData(Node::LocalID nodeID);
 
+    // mirrors the trait blobs this node holds, so that blobs it already has are sent as just their hash
+    AvatarTraits::TraitBlobCache& getSentTraitBlobs() { return _sentTraitBlobs; }
+
 private:
     struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
         QWeakPointer<Node> node;
@@ -184,10 +212,15 @@ private:
 
     SimpleMovingAverage _otherAvatarStarves;
     SimpleMovingAverage _otherAvatarSkips;
+    SimpleMovingAverage _otherAvatarUpdates;
+    SimpleMovingAverage _otherAvatarsOverdue;
+    float _maxOtherAvatarUpdateAge { 0.0f };
+    std::unordered_map<Node::LocalID, OtherAvatarSchedule> _otherAvatarSchedules;
     int _numOutOfOrderSends = 0;
 
     SimpleMovingAverage _avgOtherAvatarDataRate;
     SimpleMovingAverage _avgOtherAvatarTraitsRate;
+    uint64_t _lastBroadcastCost { 0 };
     std::vector<QUuid> _radiusIgnoredOthers;
     ConicalViewFrustums _currentViewFrustums;
 
@@ -222,7 +255,12 @@ private:
     // prevent sending traits that have already been sent.
     PerNodeTraitVersions _perNodeSentTraitVersions;
 
+    AvatarTraits::TraitBlobCache _sentTraitBlobs;
+
     std::atomic_bool _isIgnoreRadiusEnabled { false };
+
+    std::vector<glm::vec4> _replicationInterest; // center and radius of each region
+    quint64 _replicationInterestTimestamp { 0 };
 };
 
 #endif // hifi_AvatarMixerClientData_h
@@ -141,8 +141,10 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
                 if (lastReceivedVersion > lastSentVersionRef) {
                     bytesWritten += addTraitsNodeHeader(listeningNodeData, sendingNodeData, traitsPacketList, bytesWritten);
                     // there is an update to this trait, add it to the traits packet
-                    bytesWritten += AvatarTraits::packVersionedTrait(traitType, traitsPacketList,
-                                                                     lastReceivedVersion, *sendingAvatar);
+                    bytesWritten += AvatarTraits::packVersionedTraitBlob(traitType, traitsPacketList,
+                                                                         lastReceivedVersion,
+                                                                         sendingAvatar->getTraitBlob(traitType),
+                                                                         listeningNodeData->getSentTraitBlobs());
                     // update the last sent version
                     lastSentVersionRef = lastReceivedVersion;
                     // Remember which versions we sent in this particular packet
@@ -197,8 +199,12 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
                     bytesWritten += addTraitsNodeHeader(listeningNodeData, sendingNodeData, traitsPacketList, bytesWritten);
 
                     // this instance version exists and has never been sent or is newer so we need to send it
-                    bytesWritten += AvatarTraits::packVersionedTraitInstance(traitType, instanceID, traitsPacketList,
-                                                                             receivedVersion, *sendingAvatar);
+                    // it's sent as a blob shared with every other listener, just by hash if this one holds it
+                    bytesWritten += AvatarTraits::packVersionedTraitInstanceBlob(traitType, instanceID, traitsPacketList,
+                                                                                 receivedVersion,
+                                                                                 sendingAvatar->getTraitBlob(traitType,
+                                                                                                             instanceID),
+                                                                                 listeningNodeData->getSentTraitBlobs());
 
                     if (sentInstanceIt != sentIDValuePairs.end()) {
                         sentInstanceIt->value = receivedVersion;
@@ -273,6 +279,12 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
 
     quint64 end = usecTimestampNow();
     _stats.jobElapsedTime += (end - start);
+
+    // the pool deals out next frame's nodes by what they cost this frame
+    auto nodeData = static_cast<AvatarMixerClientData*>(node->getLinkedData());
+    if (nodeData) {
+        nodeData->setLastBroadcastCost(end - start);
+    }
 }
 
 AABox computeBubbleBox(const AvatarData& avatar, float bubbleExpansionFactor) {
@@ -386,6 +398,21 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
     avatarPriorityQueues[kNonhero].reserve(_end - _begin);
 
+    // Only avatars in cells near the listener or possibly in one of its views get the full priority computation.
+    // The others would score below OUT_OF_VIEW_THRESHOLD and be sent minimum data anyway, so they are scored by age
+    // alone and only looked at every few frames.
+    const auto& avatarGrid = _sharedData->avatarGrid;
+    const int farAvatarUpdateInterval = _sharedData->farAvatarUpdateInterval;
+    bool defersFarAvatars = farAvatarUpdateInterval > 1 && avatarGrid.getNumCells() > 1;
+    if (defersFarAvatars) {
+        const float NEAR_AVATAR_DISTANCE = 2.0f * AvatarSpatialGrid::CELL_SIZE;
+        avatarGrid.findNearCells(cameraViews, NEAR_AVATAR_DISTANCE, _nearCells);
+    }
+    const quint64 usecNow = usecTimestampNow();
+
+    // past this an out-of-view avatar's age alone could lift it over OUT_OF_VIEW_THRESHOLD, so it gets a full sort
+    const quint64 FAR_AVATAR_MAX_AGE_USECS = USECS_PER_SECOND;
+
     for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
         Node* otherNodeRaw = (*listedNode).data();
         if (otherNodeRaw->getType() != NodeType::Agent
@@ -432,6 +459,20 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             }
         }
 
+        bool isFarAvatar = false;
+        if (sendAvatar && defersFarAvatars && !sourceAvatarNodeData->getConstAvatarData()->getHasPriority()) {
+            Node::LocalID sourceID = sourceAvatarNode->getLocalID();
+            int cellIndex = avatarGrid.cellIndexOf(sourceID);
+            isFarAvatar = cellIndex >= 0 && !_nearCells[cellIndex] &&
+                usecNow - destinationNodeData->getLastOtherAvatarEncodeTime(sourceID) < FAR_AVATAR_MAX_AGE_USECS;
+
+            // staggered by ID so that a listener's far avatars are spread evenly over the interval
+            if (isFarAvatar && (_sharedData->frame + sourceID) % farAvatarUpdateInterval != 0) {
+                ++_stats.numFarAvatarsDeferred;
+                sendAvatar = false;
+            }
+        }
+
         if (sendAvatar) {
             AvatarDataSequenceNumber lastSeqToReceiver = destinationNodeData->getLastBroadcastSequenceNumber(sourceAvatarNode->getLocalID());
             AvatarDataSequenceNumber lastSeqFromSender = sourceAvatarNodeData->getLastReceivedSequenceNumber();
@@ -454,7 +495,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                 // This is important for Agent scripts that are not avatar
                 // so that they don't appear to be an avatar at the origin
                 sendAvatar = false;
-            } else if (lastSeqFromSender - lastSeqToReceiver > 1) {
+            } else if (lastSeqFromSender - lastSeqToReceiver > 1 && !isFarAvatar) {
                 // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
                 ++numAvatarsWithSkippedFrames;
             }
@@ -468,8 +509,16 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             const MixerAvatar* avatarNodeData = sourceAvatarNodeData->getConstAvatarData();
             auto lastEncodeTime = destinationNodeData->getLastOtherAvatarEncodeTime(sourceAvatarNode->getLocalID());
 
-            avatarPriorityQueues[avatarNodeData->getHasPriority() ? kHero : kNonhero].push(
-                SortableAvatar(avatarNodeData, sourceAvatarNode, lastEncodeTime));
+            if (isFarAvatar) {
+                float age = (float)(usecNow - lastEncodeTime) / USECS_PER_SECOND;
+                float priority = std::min(OUT_OF_VIEW_PENALTY + AvatarData::_avatarSortCoefficientAge * age,
+                                          OUT_OF_VIEW_THRESHOLD);
+                avatarPriorityQueues[kNonhero].push(SortableAvatar(avatarNodeData, sourceAvatarNode, lastEncodeTime),
+                                                    priority);
+            } else {
+                avatarPriorityQueues[avatarNodeData->getHasPriority() ? kHero : kNonhero].push(
+                    SortableAvatar(avatarNodeData, sourceAvatarNode, lastEncodeTime));
+            }
         }
         
         // If Node A's PAL WAS open but is no longer open, AND
@@ -505,10 +554,69 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     int numAvatarsSent = 0;
     auto identityPacketList = NLPacketList::create(PacketType::AvatarIdentity, QByteArray(), true, true);
 
+    // Unless the PAL is open, the non-hero avatars share what's left of the budget by deficit round robin: each frame
+    // every avatar is owed a share of the budget weighted by its priority, and those owed at least what they cost
+    // last time go first. Avatars that haven't been sent for longer than the minimum update interval always go, with
+    // minimum data if the budget is spent, so that a busy listener sees every avatar move rather than some stop.
+    struct ScheduledAvatar {
+        const SortableAvatar* sortable;
+        AvatarMixerClientData::OtherAvatarSchedule* schedule; // null outside of the round robin
+        bool isOverdue;
+        bool isFirstPass;
+    };
+    std::vector<ScheduledAvatar> scheduledAvatars;
+    const quint64 minUpdateIntervalUsecs = USECS_PER_SECOND / std::max(_sharedData->minAvatarUpdateRate, 1);
+    const float MAX_DEFICIT = (float)avatarPacketCapacity;
+    int numOverdueAvatars = 0;
+    int numAvatarUpdates = 0;
+    quint64 maxUpdateAge = 0;
+
     // Loop over two priorities - hero avatars then everyone else:
     for (PriorityVariants currentVariant = kHero; currentVariant <= kNonhero; ++((int&)currentVariant)) {
         const auto& sortedAvatarVector = avatarPriorityQueues[currentVariant].getSortedVector(numToSendEst);
-        for (const auto& sortedAvatar : sortedAvatarVector) {
+
+        scheduledAvatars.clear();
+        if (currentVariant == kNonhero && !PALIsOpen) {
+            float budget = (float)std::max(maxAvatarBytesPerFrame - (identityBytesSent + traitBytesSent + numAvatarDataBytes), 0);
+
+            // out-of-view avatars weigh little, but they are sent minimum data and so cost little too
+            const float MIN_WEIGHT = 0.1f;
+            auto weigh = [&](const SortableAvatar& sortable) {
+                return std::max(sortable.getPriority() - OUT_OF_VIEW_PENALTY, MIN_WEIGHT);
+            };
+            float totalWeight = 0.0f;
+            for (const auto& sortedAvatar : sortedAvatarVector) {
+                totalWeight += weigh(sortedAvatar);
+            }
+
+            std::vector<ScheduledAvatar> secondPass;
+            for (const auto& sortedAvatar : sortedAvatarVector) {
+                auto& schedule = destinationNodeData->getOtherAvatarSchedule(sortedAvatar.getNode()->getLocalID());
+                schedule.deficit = std::min(schedule.deficit + budget * weigh(sortedAvatar) / totalWeight, MAX_DEFICIT);
+
+                quint64 lastEncodeTime = sortedAvatar.getTimestamp();
+                bool isOverdue = usecNow - lastEncodeTime >= minUpdateIntervalUsecs;
+                if (lastEncodeTime != 0) {
+                    maxUpdateAge = std::max(maxUpdateAge, usecNow - lastEncodeTime);
+                }
+                numOverdueAvatars += isOverdue ? 1 : 0;
+
+                if (isOverdue || schedule.deficit >= (float)schedule.lastSentBytes) {
+                    scheduledAvatars.push_back({ &sortedAvatar, &schedule, isOverdue, true });
+                } else {
+                    secondPass.push_back({ &sortedAvatar, &schedule, false, false });
+                }
+            }
+            // whatever budget is left goes to the others, by priority
+            scheduledAvatars.insert(scheduledAvatars.end(), secondPass.begin(), secondPass.end());
+        } else {
+            for (const auto& sortedAvatar : sortedAvatarVector) {
+                scheduledAvatars.push_back({ &sortedAvatar, nullptr, false, false });
+            }
+        }
+
+        for (const auto& scheduledAvatar : scheduledAvatars) {
+            const auto& sortedAvatar = *scheduledAvatar.sortable;
             const Node* sourceNode = sortedAvatar.getNode();
             auto lastEncodeForOther = sortedAvatar.getTimestamp();
 
@@ -525,6 +633,13 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                 if (PALIsOpen) {
                     _stats.overBudgetAvatars++;
                     detail = AvatarData::PALMinimum;
+                } else if (scheduledAvatar.isOverdue) {
+                    detail = AvatarData::MinimumData;
+                } else if (scheduledAvatar.isFirstPass) {
+                    // there may still be overdue avatars further on
+                    _stats.overBudgetAvatars++;
+                    remainingAvatars--;
+                    continue;
                 } else {
                     _stats.overBudgetAvatars += remainingAvatars;
                     break;
@@ -537,6 +652,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             }
 
             auto startAvatarDataPacking = chrono::high_resolution_clock::now();
+            int avatarDataBytesBefore = numAvatarDataBytes;
 
             const AvatarMixerClientData* sourceNodeData = reinterpret_cast<const AvatarMixerClientData*>(sourceNode->getLinkedData());
             const MixerAvatar* sourceAvatar = sourceNodeData->getConstAvatarData();
@@ -569,26 +685,51 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             AvatarDataPacket::SendStatus sendStatus;
             sendStatus.sendUUID = true;
 
-            do {
-                auto startSerialize = chrono::high_resolution_clock::now();
-                QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                    sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
-                    &lastSentJointsForOther, avatarSpaceAvailable);
-                auto endSerialize = chrono::high_resolution_clock::now();
-                _stats.toByteArrayElapsedTime +=
-                    (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
-
-                avatarPacket->write(bytes);
-                avatarSpaceAvailable -= bytes.size();
-                numAvatarDataBytes += bytes.size();
-                if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
-                    // Weren't able to fit everything.
+            // the levels of detail that don't depend on the listener are encoded once per frame and shared
+            auto startSharedSerialize = chrono::high_resolution_clock::now();
+            auto sharedEncoding = sourceAvatar->getSharedEncoding(detail, lastEncodeForOther, _sharedData->frame);
+            auto endSharedSerialize = chrono::high_resolution_clock::now();
+            _stats.toByteArrayElapsedTime +=
+                (quint64)chrono::duration_cast<chrono::microseconds>(endSharedSerialize - startSharedSerialize).count();
+
+            if (!sharedEncoding.bytes.isEmpty() && sharedEncoding.bytes.size() <= avatarSpaceAvailable) {
+                avatarPacket->write(sharedEncoding.bytes);
+                avatarSpaceAvailable -= sharedEncoding.bytes.size();
+                numAvatarDataBytes += sharedEncoding.bytes.size();
+                if (detail == AvatarData::SendAllData) {
+                    lastSentJointsForOther = sharedEncoding.sentJoints;
+                }
+                ++_stats.numSharedEncodingsSent;
+
+                if (avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
                     nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
                     ++numPacketsSent;
                     avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
                     avatarSpaceAvailable = avatarPacketCapacity;
                 }
-            } while (!sendStatus);
+            } else {
+                // delta encoded against what this listener was last sent, or split over packets
+                do {
+                    auto startSerialize = chrono::high_resolution_clock::now();
+                    QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
+                        sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
+                        &lastSentJointsForOther, avatarSpaceAvailable);
+                    auto endSerialize = chrono::high_resolution_clock::now();
+                    _stats.toByteArrayElapsedTime +=
+                        (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+
+                    avatarPacket->write(bytes);
+                    avatarSpaceAvailable -= bytes.size();
+                    numAvatarDataBytes += bytes.size();
+                    if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        // Weren't able to fit everything.
+                        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+                } while (!sendStatus);
+            }
 
             if (detail != AvatarData::NoData) {
                 _stats.numOthersIncluded++;
@@ -603,6 +744,14 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                 destinationNodeData->setLastBroadcastSequenceNumber(sourceNode->getLocalID(),
                     sourceNodeData->getLastReceivedSequenceNumber());
                 destinationNodeData->setLastOtherAvatarEncodeTime(sourceNode->getLocalID(), usecTimestampNow());
+                ++numAvatarUpdates;
+            }
+
+            if (scheduledAvatar.schedule) {
+                int avatarDataBytes = numAvatarDataBytes - avatarDataBytesBefore;
+                scheduledAvatar.schedule->deficit = std::max(scheduledAvatar.schedule->deficit - (float)avatarDataBytes,
+                                                             -MAX_DEFICIT);
+                scheduledAvatar.schedule->lastSentBytes = avatarDataBytes;
             }
 
             auto endAvatarDataPacking = chrono::high_resolution_clock::now();
@@ -662,6 +811,8 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     // record the number of avatars held back this frame
     destinationNodeData->recordNumOtherAvatarStarves(numAvatarsHeldBack);
     destinationNodeData->recordNumOtherAvatarSkips(numAvatarsWithSkippedFrames);
+    destinationNodeData->recordOtherAvatarUpdates(numAvatarUpdates, numOverdueAvatars,
+                                                  (float)maxUpdateAge / USECS_PER_SECOND);
 
     quint64 endPacketSending = usecTimestampNow();
     _stats.packetSendingElapsedTime += (endPacketSending - startPacketSending);
@@ -694,6 +845,11 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
         if (agentNode->getType() == NodeType::Agent && agentNode->getLinkedData() && agentNode->isReplicated()) {
             const AvatarMixerClientData* agentNodeData = reinterpret_cast<const AvatarMixerClientData*>(agentNode->getLinkedData());
 
+            // downstream mixers that asked for only the regions their listeners are in don't get the rest
+            if (!nodeData->isInReplicationInterest(agentNodeData->getPosition())) {
+                return;
+            }
+
             AvatarSharedPointer otherAvatar = agentNodeData->getAvatarSharedPointer();
 
             quint64 startAvatarDataPacking = usecTimestampNow();
@@ -14,6 +14,8 @@
 
 #include <NodeList.h>
 
+#include "AvatarSpatialGrid.h"
+
 class AvatarMixerClientData;
 
 class AvatarMixerSlaveStats {
@@ -33,6 +35,9 @@ public:
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int numFarAvatarsDeferred { 0 };
+    int numSharedEncodingsSent { 0 };
+    int nodesStolen { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -59,6 +64,9 @@ public:
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        numFarAvatarsDeferred = 0;
+        numSharedEncodingsSent = 0;
+        nodesStolen = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -83,6 +91,9 @@ public:
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        numFarAvatarsDeferred += rhs.numFarAvatarsDeferred;
+        numSharedEncodingsSent += rhs.numSharedEncodingsSent;
+        nodesStolen += rhs.nodesStolen;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -100,6 +111,16 @@ struct SlaveSharedData {
     QStringList skeletonURLWhitelist;
     QUrl skeletonReplacementURL;
     EntityTreePointer entityTree;
+
+    // rebuilt by the mixer before each broadcast, read by the slaves while broadcasting
+    AvatarSpatialGrid avatarGrid;
+    unsigned int frame { 0 };
+
+    // avatars out of every view and not near a listener are only considered for it every this many frames
+    int farAvatarUpdateInterval { 4 };
+
+    // every avatar a listener is sent is updated at least this many times a second, even when it is over budget
+    int minAvatarUpdateRate { 5 };
 };
 
 class AvatarMixerSlave {
@@ -118,6 +139,9 @@ public:
 
     void harvestStats(AvatarMixerSlaveStats& stats);
 
+    // called by the pool for nodes taken from another slave's share of the frame
+    void recordStolenNode() { ++_stats.nodesStolen; }
+
 private:
     int sendIdentityPacket(NLPacketList& packet, const AvatarMixerClientData* nodeData, const Node& destinationNode);
     int sendReplicatedIdentityPacket(const Node& agentNode, const AvatarMixerClientData* nodeData, const Node& destinationNode);
@@ -143,6 +167,9 @@ private:
     float _throttlingRatio { 0.0f };
     float _avatarHeroFraction { 0.4f };
 
+    // per listener, which of the avatar grid's cells get the full priority sort
+    std::vector<bool> _nearCells;
+
     AvatarMixerSlaveStats _stats;
     SlaveSharedData* _sharedData;
 };
@@ -13,16 +13,23 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <functional>
+
+#include "AvatarMixerClientData.h"
 
 void AvatarMixerSlaveThread::run() {
     while (true) {
         wait();
 
-        // iterate over all available nodes
+        // iterate over our own nodes, then help the slaves that are still busy
         SharedNodePointer node;
         while (try_pop(node)) {
             (this->*_function)(node);
         }
+        while (try_steal(node)) {
+            (this->*_function)(node);
+            recordStolenNode();
+        }
 
         bool stopping = _stop;
         notify(stopping);
@@ -60,7 +67,31 @@ void AvatarMixerSlaveThread::notify(bool stopping) {
 }
 
 bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+    Lock lock(_queueMutex);
+    if (_queue.empty()) {
+        return false;
+    }
+
+    node = std::move(_queue.front());
+    _queue.pop_front();
+    return true;
+}
+
+bool AvatarMixerSlaveThread::try_steal(SharedNodePointer& node) {
+    // start with our neighbour so that idle slaves don't all pile onto the same victim
+    size_t numSlaves = _pool._slaves.size();
+    for (size_t i = 1; i < numSlaves; ++i) {
+        auto& victim = *_pool._slaves[(_index + i) % numSlaves];
+
+        Lock lock(victim._queueMutex);
+        if (!victim._queue.empty()) {
+            node = std::move(victim._queue.back());
+            victim._queue.pop_back();
+            return true;
+        }
+    }
+
+    return false;
 }
 
 void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end) {
@@ -68,7 +99,9 @@ void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end
     _configure = [=](AvatarMixerSlave& slave) { 
         slave.configure(begin, end);
     };
-    run(begin, end);
+
+    // there's nothing to go on for packets, so deal them out evenly
+    run(begin, end, [](const SharedNodePointer& node) { return 1; });
 }
 
 void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end, 
@@ -79,18 +112,43 @@ void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end,
         slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio,
             _priorityReservedFraction);
    };
-    run(begin, end);
+
+    run(begin, end, [](const SharedNodePointer& node) {
+        auto data = static_cast<AvatarMixerClientData*>(node->getLinkedData());
+
+        // nodes that have not been broadcast to yet are weighed as cheap, they are likely to be
+        const uint64_t MIN_BROADCAST_COST = 1;
+        return data ? std::max(data->getLastBroadcastCost(), MIN_BROADCAST_COST) : MIN_BROADCAST_COST;
+    });
 }
 
-void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end,
+                               std::function<uint64_t(const SharedNodePointer& node)> weigh) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
+    // fill the queues, heaviest nodes first, each to the least loaded slave
+    std::vector<std::pair<uint64_t, SharedNodePointer>> nodes;
     std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
+        nodes.emplace_back(weigh(node), node);
+    });
+    std::stable_sort(nodes.begin(), nodes.end(), [](const std::pair<uint64_t, SharedNodePointer>& a,
+                                                    const std::pair<uint64_t, SharedNodePointer>& b) {
+        return a.first > b.first;
     });
 
+    for (auto& slave : _slaves) {
+        slave->_queuedCost = 0;
+    }
+    for (auto& node : nodes) {
+        auto& slave = *std::min_element(_slaves.begin(), _slaves.end(),
+            [](const std::unique_ptr<AvatarMixerSlaveThread>& a, const std::unique_ptr<AvatarMixerSlaveThread>& b) {
+                return a->_queuedCost < b->_queuedCost;
+            });
+        slave->_queuedCost += node.first;
+        slave->_queue.push_back(std::move(node.second));
+    }
+
     {
         Lock lock(_mutex);
 
@@ -107,7 +165,9 @@ void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
         assert(_numStarted == _numThreads);
     }
 
-    assert(_queue.empty());
+    for (auto& slave : _slaves) {
+        assert(slave->_queue.empty());
+    }
 }
 
 
@@ -161,6 +221,7 @@ void AvatarMixerSlavePool::resize(int numThreads) {
         // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
             auto slave = new AvatarMixerSlaveThread(*this, _slaveSharedData);
+            slave->_index = _slaves.size();
             slave->start();
             _slaves.emplace_back(slave);
         }
@@ -0,0 +1,78 @@
+//
+//  AvatarSpatialGrid.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarSpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+// a few times an avatar's height, so a crowd lands in a handful of cells
+const float AvatarSpatialGrid::CELL_SIZE = 8.0f;
+
+// from a cell's center to its corners
+static const float CELL_BOUNDING_RADIUS = 0.5f * AvatarSpatialGrid::CELL_SIZE * sqrtf(3.0f);
+
+size_t AvatarSpatialGrid::CellHasher::operator()(const glm::ivec3& cell) const {
+    size_t hash = std::hash<int>()(cell.x);
+    hash = hash * 31 + std::hash<int>()(cell.y);
+    hash = hash * 31 + std::hash<int>()(cell.z);
+    return hash;
+}
+
+void AvatarSpatialGrid::clear() {
+    _cells.clear();
+    _cellIndices.clear();
+    _avatarCells.clear();
+}
+
+void AvatarSpatialGrid::insert(Node::LocalID avatarID, const glm::vec3& position, float radius) {
+    glm::ivec3 coordinates = cellFor(position);
+
+    auto it = _cellIndices.find(coordinates);
+    if (it == _cellIndices.end()) {
+        it = _cellIndices.emplace(coordinates, (int)_cells.size()).first;
+        _cells.push_back({ coordinates, 0.0f });
+    }
+
+    // an avatar can stick out of its cell, so the cell's bounds grow with its largest avatar
+    auto& cell = _cells[it->second];
+    cell.maxAvatarRadius = std::max(cell.maxAvatarRadius, radius);
+
+    _avatarCells[avatarID] = it->second;
+}
+
+void AvatarSpatialGrid::findNearCells(const ConicalViewFrustums& views, float nearDistance,
+                                      std::vector<bool>& nearCells) const {
+    nearCells.assign(_cells.size(), false);
+
+    for (size_t i = 0; i < _cells.size(); ++i) {
+        const auto& cell = _cells[i];
+        glm::vec3 center = (glm::vec3(cell.coordinates) + 0.5f) * CELL_SIZE;
+        float radius = CELL_BOUNDING_RADIUS + cell.maxAvatarRadius;
+
+        for (const auto& view : views) {
+            glm::vec3 offset = center - view.getPosition();
+            float distance = glm::length(offset);
+
+            // the same keyhole and frustum tests the priority sort makes, on the sphere bounding the whole cell
+            if (distance - radius <= std::max(nearDistance, view.getRadius()) ||
+                view.intersects(offset, distance, radius)) {
+                nearCells[i] = true;
+                break;
+            }
+        }
+    }
+}
+
+int AvatarSpatialGrid::cellIndexOf(Node::LocalID avatarID) const {
+    auto it = _avatarCells.find(avatarID);
+    return it != _avatarCells.end() ? it->second : -1;
+}
@@ -0,0 +1,59 @@
+//
+//  AvatarSpatialGrid.h
+//  assignment-client/src/avatars
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarSpatialGrid_h
+#define hifi_AvatarSpatialGrid_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Node.h>
+#include <shared/ConicalViewFrustum.h>
+
+// Where every avatar is this frame, bucketed into a sparse uniform grid so that a listener can tell which avatars
+// are near it or possibly in its views by looking at the occupied cells instead of at every avatar.
+class AvatarSpatialGrid {
+public:
+    static const float CELL_SIZE; // meters
+
+    // not thread-safe, called between frames once the frame's positions are in
+    void clear();
+    void insert(Node::LocalID avatarID, const glm::vec3& position, float radius);
+
+    // thread-safe once built, sets an entry per occupied cell to whether any of its avatars can be within
+    // nearDistance of a view or inside a view's keyhole or frustum
+    void findNearCells(const ConicalViewFrustums& views, float nearDistance, std::vector<bool>& nearCells) const;
+
+    // thread-safe once built, the index of the avatar's cell into what findNearCells() fills, or -1 if not in the grid
+    int cellIndexOf(Node::LocalID avatarID) const;
+
+    int getNumAvatars() const { return (int)_avatarCells.size(); }
+    int getNumCells() const { return (int)_cells.size(); }
+
+private:
+    struct Cell {
+        glm::ivec3 coordinates;
+        float maxAvatarRadius;
+    };
+
+    struct CellHasher {
+        size_t operator()(const glm::ivec3& cell) const;
+    };
+
+    static glm::ivec3 cellFor(const glm::vec3& position) { return glm::ivec3(glm::floor(position / CELL_SIZE)); }
+
+    std::vector<Cell> _cells;
+    std::unordered_map<glm::ivec3, int, CellHasher> _cellIndices;
+    std::unordered_map<Node::LocalID, int> _avatarCells;
+};
+
+#endif // hifi_AvatarSpatialGrid_h
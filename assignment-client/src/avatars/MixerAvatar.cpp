@@ -69,6 +69,65 @@ void MixerAvatar::challengeTimeout() {
     }
 }
 
+MixerAvatar::SharedEncoding MixerAvatar::getSharedEncoding(AvatarDataDetail detail, quint64 lastSentTime,
+                                                           unsigned int frame) const {
+    // culled joint deltas depend on what each listener was last sent and how far away it is
+    if (detail != PALMinimum && detail != MinimumData && detail != SendAllData) {
+        return SharedEncoding();
+    }
+
+    // otherwise the bytes only depend on which sections are included, the mixer never drops face tracking
+    const bool dropFaceTracking = false;
+    AvatarDataPacket::HasFlags flags = getWantedFlags(detail, lastSentTime, dropFaceTracking);
+
+    QMutexLocker lock(&_sharedEncodingsLock);
+
+    // the avatar doesn't change while a frame is broadcast, so encodings are good until the next one
+    if (_sharedEncodingsFrame != frame) {
+        _sharedEncodings.clear();
+        _sharedEncodingsFrame = frame;
+    }
+
+    for (const auto& entry : _sharedEncodings) {
+        if (entry.detail == detail && entry.flags == flags) {
+            return entry.encoding;
+        }
+    }
+
+    SharedEncoding encoding;
+    AvatarDataPacket::SendStatus sendStatus;
+    sendStatus.sendUUID = true;
+    // with SendAllData every joint that isn't in its default pose is sent, whatever the listener had
+    encoding.bytes = toByteArray(detail, lastSentTime, encoding.sentJoints, sendStatus, dropFaceTracking, false,
+                                 glm::vec3(0.0f), &encoding.sentJoints);
+
+    _sharedEncodings.push_back({ detail, flags, encoding });
+    return encoding;
+}
+
+AvatarTraits::TraitBlob MixerAvatar::getTraitBlob(AvatarTraits::TraitType traitType,
+                                                  AvatarTraits::TraitInstanceID instanceID) {
+    // packing is cheap, it's the hash and compression that are worth sharing
+    auto traitBinaryData = AvatarTraits::isSimpleTrait(traitType) ? packTrait(traitType)
+                                                                  : packTraitInstance(traitType, instanceID);
+    auto key = std::make_pair(traitType, instanceID);
+
+    QMutexLocker lock(&_traitBlobsLock);
+
+    if (traitBinaryData.isNull()) {
+        // the instance is gone, so is its blob
+        _traitBlobs.erase(key);
+        return AvatarTraits::TraitBlob();
+    }
+
+    // compared by content, the mixer can change a trait under the same version (e.g. a skeleton that isn't whitelisted)
+    auto& blob = _traitBlobs[key];
+    if (blob.data != traitBinaryData) {
+        blob = AvatarTraits::TraitBlob::fromData(traitBinaryData);
+    }
+    return blob;
+}
+
 void MixerAvatar::fetchAvatarFST() {
     if (_verifyState >= requestingFST && _verifyState <= challengeClient) {
         qCDebug(avatars) << "WARNING: Avatar verification restarted; old state:" << stateToName(_verifyState);
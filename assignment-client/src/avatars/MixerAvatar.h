@@ -14,7 +14,11 @@
 #ifndef hifi_MixerAvatar_h
 #define hifi_MixerAvatar_h
 
+#include <map>
+#include <vector>
+
 #include <AvatarData.h>
+#include <TraitBlobCache.h>
 
 class ResourceRequest;
 
@@ -36,6 +40,21 @@ public:
 
     void stopChallengeTimer();
 
+    // An encoding of this avatar that doesn't depend on who it is sent to.
+    struct SharedEncoding {
+        QByteArray bytes;
+        QVector<JointData> sentJoints; // what a listener has been sent once it gets the bytes
+    };
+
+    // thread-safe, encodes this avatar at most once per frame for every level of detail and set of sections that
+    // doesn't depend on the listener (PALMinimum, MinimumData and SendAllData), returns no bytes for the other levels
+    SharedEncoding getSharedEncoding(AvatarDataDetail detail, quint64 lastSentTime, unsigned int frame) const;
+
+    // thread-safe, packs a trait as it currently is, hashing and compressing it only when it changed so that every
+    // listener is sent the same blob, pass a null instance ID for simple traits
+    AvatarTraits::TraitBlob getTraitBlob(AvatarTraits::TraitType traitType,
+                                         AvatarTraits::TraitInstanceID instanceID = AvatarTraits::TraitInstanceID());
+
     // Avatar certification/verification:
     enum VerifyState {
         nonCertified, requestingFST, receivedFST, staticValidation, requestingOwner, ownerResponse,
@@ -66,6 +85,18 @@ private:
     bool _certifyFailed { false };
     bool _needsIdentityUpdate { false };
 
+    struct SharedEncodingEntry {
+        AvatarDataDetail detail;
+        AvatarDataPacket::HasFlags flags;
+        SharedEncoding encoding;
+    };
+    mutable QMutex _sharedEncodingsLock;
+    mutable std::vector<SharedEncodingEntry> _sharedEncodings;
+    mutable unsigned int _sharedEncodingsFrame { 0 };
+
+    QMutex _traitBlobsLock;
+    std::map<std::pair<AvatarTraits::TraitType, AvatarTraits::TraitInstanceID>, AvatarTraits::TraitBlob> _traitBlobs;
+
     bool generateFSTHash();
     bool validateFSTHash(const QString& publicKey) const;
     QByteArray canonicalJson(const QString fstFile);
@@ -19,6 +19,7 @@
 #include <EntityTree.h>
 #include <ResourceCache.h>
 #include <ScriptCache.h>
+#include <StreamUtils.h>
 #include <plugins/PluginManager.h>
 #include <EntityEditFilters.h>
 #include <NetworkingConstants.h>
@@ -347,6 +348,23 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
         tree->setEntityScriptSourceWhitelist("");
     }
     
+    QString ownedRegion;
+    if (readOptionString("ownedRegion", settingsSectionObject, ownedRegion) && !ownedRegion.isEmpty()) {
+        // the minimum and maximum corners, as "x,y,z,x,y,z"
+        QStringList values = ownedRegion.split(',');
+        glm::vec3 corners[2];
+        bool valid = values.size() == 6;
+        for (int i = 0; valid && i < 6; i++) {
+            corners[i / 3][i % 3] = values[i].trimmed().toFloat(&valid);
+        }
+        if (valid && glm::all(glm::lessThan(corners[0], corners[1]))) {
+            tree->setOwnedRegion(AABox(corners[0], corners[1] - corners[0]));
+            qDebug() << "Entity server owns the region from" << corners[0] << "to" << corners[1];
+        } else {
+            qWarning() << "Ignoring invalid ownedRegion setting" << ownedRegion;
+        }
+    }
+
     auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
     
     QString filterURL;
@@ -405,6 +423,20 @@ void EntityServer::trackViewerGone(const QUuid& sessionID) {
     }
 }
 
+// the memory stats are collected again when they are asked for after being this old
+const quint64 MEMORY_STATS_MAX_AGE = 10 * USECS_PER_SECOND;
+
+const EntityTreeMemoryStats& EntityServer::getMemoryStats() {
+    if (usecTimestampNow() - _memoryStats.getCollectedTime() > MEMORY_STATS_MAX_AGE) {
+        _memoryStats.collect(std::static_pointer_cast<EntityTree>(_tree));
+    }
+    return _memoryStats;
+}
+
+void EntityServer::addServerSubclassStats(QJsonObject& statsObject) {
+    statsObject["5. memory"] = getMemoryStats().toJson();
+}
+
 QString EntityServer::serverSubclassStats() {
     QLocale locale(QLocale::English);
     QString statsString;
@@ -413,6 +445,12 @@ QString EntityServer::serverSubclassStats() {
     statsString += "<b>Entity Server Memory Statistics</b>\r\n";
     statsString += QString().sprintf("EntityTreeElement size... %ld bytes\r\n", sizeof(EntityTreeElement));
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
+    statsString += "\r\n";
+    statsString += getMemoryStats().toString();
+    statsString += "\r\n\r\n";
+
+    statsString += "<b>Entity Edit Filter Statistics</b>\r\n";
+    statsString += DependencyManager::get<EntityEditFilters>()->getStatsString();
     statsString += "\r\n\r\n";
 
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
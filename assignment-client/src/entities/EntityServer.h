@@ -16,8 +16,11 @@
 
 #include <memory>
 
+#include <DiffTraversal.h>
+#include <EntityEncodeCache.h>
 #include <EntityItem.h>
 #include <EntityTree.h>
+#include <EntityTreeMemoryStats.h>
 #include <SimpleEntitySimulation.h>
 
 #include "EntityServerConsts.h"
@@ -53,12 +56,17 @@ public:
     virtual void entityCreated(const EntityItem& newEntity, const SharedNodePointer& senderNode) override;
     virtual void readAdditionalConfiguration(const QJsonObject& settingsSectionObject) override;
     virtual QString serverSubclassStats() override;
+    virtual void addServerSubclassStats(QJsonObject& statsObject) override;
 
     virtual void trackSend(const QUuid& dataID, quint64 dataLastEdited, const QUuid& sessionID) override;
     virtual void trackViewerGone(const QUuid& sessionID) override;
 
     virtual void aboutToFinish() override;
 
+    // shared by the send threads, which each run on their own
+    DiffTraversalCache& getTraversalCache() { return _traversalCache; }
+    EntityEncodeCache& getEncodeCache() { return _encodeCache; }
+
 public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
@@ -86,6 +94,12 @@ private:
     int _MAXIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = DEFAULT_MAXIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS;  // 1h
     QTimer _dynamicDomainVerificationTimer;
     void startDynamicDomainVerification();
+
+    const EntityTreeMemoryStats& getMemoryStats();
+    EntityTreeMemoryStats _memoryStats;
+
+    DiffTraversalCache _traversalCache;
+    EntityEncodeCache _encodeCache;
 };
 
 #endif  // hifi_EntityServer_h
@@ -22,6 +22,7 @@ EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedN
 {
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::editingEntityPointer, this, &EntityTreeSendThread::editingEntityPointer, Qt::QueuedConnection);
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntityPointer, this, &EntityTreeSendThread::deletingEntityPointer, Qt::QueuedConnection);
+    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntity, this, &EntityTreeSendThread::deletingEntity, Qt::QueuedConnection);
 
     // connect to connection ID change on EntityNodeData so we can clear state for this receiver
     auto nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
@@ -33,6 +34,11 @@ void EntityTreeSendThread::resetState() {
 
     _knownState.clear();
     _traversal.reset();
+
+    auto node = _node.toStrongRef();
+    if (node) {
+        static_cast<EntityNodeData*>(node->getLinkedData())->resetSentPropertyValues();
+    }
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -101,12 +107,16 @@ void EntityTreeSendThread::preDistributionProcessing() {
 
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
-    if (viewFrustumChanged || _traversal.finished()) {
+    // clients that only have interest regions can ask for their changes less often
+    bool updateIsDue = isFullScene ||
+        usecTimestampNow() - _traversal.getCurrentView().startTime >= _traversal.getCurrentView().getUpdatePeriod();
+    if (viewFrustumChanged || (_traversal.finished() && updateIsDue)) {
         EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
 
 
         DiffTraversal::View newView;
         newView.viewFrustums = nodeData->getCurrentViews();
+        newView.regions = nodeData->getCurrentInterestRegions();
 
         int32_t lodLevelOffset = nodeData->getBoundaryLevelAdjust() + (viewFrustumChanged ? LOW_RES_MOVING_ADJUST : NO_BOUNDARY_ADJUST);
         newView.lodScaleFactor = powf(2.0f, lodLevelOffset);
@@ -116,30 +126,11 @@ bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, O
         // When the viewFrustum changed the sort order may be incorrect, so we re-sort
         // and also use the opportunity to cull anything no longer in view
         if (viewFrustumChanged && !_sendQueue.empty()) {
-            EntityPriorityQueue prevSendQueue;
-            std::swap(_sendQueue, prevSendQueue);
-            assert(_sendQueue.empty());
-
-            // Re-add elements from previous traversal if they still need to be sent
-            while (!prevSendQueue.empty()) {
-                EntityItemPointer entity = prevSendQueue.top().getEntity();
-                bool forceRemove = prevSendQueue.top().shouldForceRemove();
-                prevSendQueue.pop();
-                if (entity) {
-                    float priority = PrioritizedEntity::DO_NOT_SEND;
-
-                    if (forceRemove) {
-                        priority = PrioritizedEntity::FORCE_REMOVE;
-                    } else {
-                        const auto& view = _traversal.getCurrentView();
-                        priority = view.computePriority(entity);
-                    }
-
-                    if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority, forceRemove);
-                    }
-                }
-            }
+            // Keep elements from previous traversal if they still need to be sent
+            const auto& view = _traversal.getCurrentView();
+            _sendQueue.reprioritize([&](const EntityItemPointer& entity, const PrioritizedEntity& queued) {
+                return queued.shouldForceRemove() ? PrioritizedEntity::FORCE_REMOVE : view.computePriority(entity);
+            });
         }
     }
 
@@ -228,7 +219,9 @@ bool EntityTreeSendThread::addDescendantsToExtraFlaggedEntities(const QUuid& fil
 void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root,
                                              bool forceFirstPass) {
 
-    DiffTraversal::Type type = _traversal.prepareNewTraversal(view, root, forceFirstPass);
+    // clients with similar views share the work of finding what is in view
+    auto& traversalCache = static_cast<EntityServer*>(_myServer)->getTraversalCache();
+    DiffTraversal::Type type = _traversal.prepareNewTraversal(view, root, forceFirstPass, &traversalCache);
     // there are three types of traversal:
     //
     //      (1) FirstTime = at login --> find everything in view
@@ -362,6 +355,10 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
     nodeData->stats.encodeStarted();
     auto entityNode = _node.toStrongRef();
     auto entityNodeData = static_cast<EntityNodeData*>(entityNode->getLinkedData());
+    if (entityNodeData->takeAckResetRequest()) {
+        entityNodeData->resetSentPropertyValues();
+    }
+    auto& encodeCache = static_cast<EntityServer*>(_myServer)->getEncodeCache();
     while(!_sendQueue.empty()) {
         PrioritizedEntity queuedItem = _sendQueue.top();
         EntityItemPointer entity = queuedItem.getEntity();
@@ -377,7 +374,23 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
                     // Record explicitly filtered-in entity so that extra entities can be flagged.
                     entityNodeData->insertSentFilteredEntity(entityID);
                 }
-                OctreeElement::AppendState appendEntityState = entity->appendEntityData(&_packetData, params, _extraEncodeData, entityNode->getCanGetAndSetPrivateUserData());
+                // an entity the client doesn't know about yet gets the same encoding as every other client loading it
+                bool canGetPrivateUserData = entityNode->getCanGetAndSetPrivateUserData();
+                OctreeElement::AppendState appendEntityState;
+                bool isNewToClient = _knownState.find(entity.get()) == _knownState.end() &&
+                    !_extraEncodeData->entities.contains(entity->getEntityItemID());
+                if (isNewToClient && encodeCache.appendEntity(&_packetData, params, entity, canGetPrivateUserData)) {
+                    appendEntityState = OctreeElement::COMPLETED;
+                } else {
+                    appendEntityState = entity->appendEntityData(&_packetData, params, _extraEncodeData, canGetPrivateUserData);
+                }
+
+                if (appendEntityState == OctreeElement::NONE) {
+                    entityNodeData->discardSentPropertyValues();
+                } else {
+                    // this payload goes out in the current packet or, if that gets flushed first, the next one
+                    entityNodeData->commitSentPropertyValues(entityNodeData->getSequenceNumber() + 1);
+                }
 
                 if (appendEntityState != OctreeElement::COMPLETED) {
                     if (appendEntityState == OctreeElement::PARTIAL) {
@@ -420,14 +433,15 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
 
 void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity) {
     if (entity) {
-        if (!_sendQueue.contains(entity.get()) && _knownState.find(entity.get()) != _knownState.end()) {
+        if (_knownState.find(entity.get()) != _knownState.end()) {
             const auto& view = _traversal.getCurrentView();
             float priority = view.computePriority(entity);
 
-            // We can force a removal from _knownState if the current view is used and entity is out of view
+            // We can force a removal from _knownState if the current view is used and entity is out of view.
+            // An entity that is already queued is moved rather than queued again.
             if (priority == PrioritizedEntity::DO_NOT_SEND) {
-                _sendQueue.emplace(entity, PrioritizedEntity::FORCE_REMOVE, true);
-            } else if (priority == PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY) {
+                _sendQueue.update(entity, PrioritizedEntity::FORCE_REMOVE, true);
+            } else if (priority == PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY && !_sendQueue.contains(entity.get())) {
                 _sendQueue.emplace(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY, true);
             }
         }
@@ -436,4 +450,17 @@ void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity)
 
 void EntityTreeSendThread::deletingEntityPointer(EntityItem* entity) {
     _knownState.erase(entity);
+
+    // by now the address may belong to a new entity, which is left queued
+    const PrioritizedEntity* queued = _sendQueue.find(entity);
+    if (queued && !queued->getEntity()) {
+        _sendQueue.remove(entity);
+    }
+}
+
+void EntityTreeSendThread::deletingEntity(const EntityItemID& entityID) {
+    auto node = _node.toStrongRef();
+    if (node) {
+        static_cast<EntityNodeData*>(node->getLinkedData())->removeSentPropertyValues(entityID);
+    }
 }
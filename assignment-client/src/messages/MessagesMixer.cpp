@@ -21,6 +21,9 @@
 
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
 
+// messages that arrive this close together go to each subscriber in one packet list
+const int SEND_PENDING_MESSAGES_INTERVAL_MSECS = 10;
+
 MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(message)
 {
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &MessagesMixer::nodeKilled);
@@ -28,12 +31,19 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
     packetReceiver.registerListener(PacketType::MessagesData, this, "handleMessages");
     packetReceiver.registerListener(PacketType::MessagesSubscribe, this, "handleMessagesSubscribe");
     packetReceiver.registerListener(PacketType::MessagesUnsubscribe, this, "handleMessagesUnsubscribe");
+
+    // parented so that it moves to the assignment's thread along with the mixer
+    _sendPendingMessagesTimer = new QTimer(this);
+    _sendPendingMessagesTimer->setSingleShot(true);
+    _sendPendingMessagesTimer->setInterval(SEND_PENDING_MESSAGES_INTERVAL_MSECS);
+    connect(_sendPendingMessagesTimer, &QTimer::timeout, this, &MessagesMixer::sendPendingMessages);
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
     for (auto& channel : _channelSubscribers) {
         channel.remove(killedNode->getUUID());
     }
+    _pendingMessages.remove(killedNode->getUUID());
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
@@ -41,19 +51,49 @@ void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessa
     QByteArray data;
     QUuid senderID;
     bool isText;
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
 
+    while (receivedMessage->getBytesLeftToRead() > 0) {
+        MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+
+        auto payload = isText ? message.toUtf8() : data;
+
+        auto& stats = _channelStats[channel];
+        ++stats.numMessages;
+        stats.numBytes += payload.size();
+
+        auto subscribersIt = _channelSubscribers.constFind(channel);
+        if (subscribersIt == _channelSubscribers.cend() || subscribersIt->isEmpty()) {
+            continue;
+        }
+
+        // encoded once for all of the subscribers
+        auto encodedMessage = MessagesClient::encodeMessage(channel, isText, payload, senderID);
+        for (const auto& subscriberID : *subscribersIt) {
+            _pendingMessages[subscriberID].append(encodedMessage);
+            ++stats.numMessagesSent;
+            stats.numBytesSent += encodedMessage.size();
+        }
+    }
+
+    if (!_pendingMessages.isEmpty() && !_sendPendingMessagesTimer->isActive()) {
+        _sendPendingMessagesTimer->start();
+    }
+}
+
+void MessagesMixer::sendPendingMessages() {
     auto nodeList = DependencyManager::get<NodeList>();
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
+    for (auto it = _pendingMessages.cbegin(); it != _pendingMessages.cend(); ++it) {
+        auto node = nodeList->nodeWithUUID(it.key());
+        if (!node || !node->getActiveSocket()) {
+            continue;
+        }
+
+        auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+        packetList->write(it.value());
         nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    }
+    _pendingMessages.clear();
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -81,6 +121,27 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    auto now = usecTimestampNow();
+    float elapsedSecs = _lastStatsTime > 0 ? (float)(now - _lastStatsTime) / USECS_PER_SECOND : 0.0f;
+    _lastStatsTime = now;
+
+    // the rate each channel has been busy at since the last stats packet
+    QJsonObject channelsObject;
+    for (auto it = _channelStats.cbegin(); it != _channelStats.cend(); ++it) {
+        QJsonObject channelStats;
+        channelStats["subscribers"] = _channelSubscribers.value(it.key()).size();
+        channelStats["messages"] = it->numMessages;
+        channelStats["messages_sent"] = it->numMessagesSent;
+        if (elapsedSecs > 0.0f) {
+            channelStats["messages_per_second"] = it->numMessages / elapsedSecs;
+            channelStats["inbound_kbps"] = it->numBytes * BITS_IN_BYTE / elapsedSecs / BYTES_PER_KILOBYTE;
+            channelStats["outbound_kbps"] = it->numBytesSent * BITS_IN_BYTE / elapsedSecs / BYTES_PER_KILOBYTE;
+        }
+        channelsObject[it.key()] = channelStats;
+    }
+    _channelStats.clear();
+    statsObject["channels"] = channelsObject;
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
@@ -15,6 +15,10 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
+
 #include <ThreadedAssignment.h>
 
 /// Handles assignments of type MessagesMixer - distribution of avatar data to various clients
@@ -33,8 +37,25 @@ private slots:
     void handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
+    void sendPendingMessages();
+
 private:
+    class ChannelStats {
+    public:
+        int numMessages { 0 };
+        qint64 numBytes { 0 }; // of the payloads received
+        int numMessagesSent { 0 };
+        qint64 numBytesSent { 0 };
+    };
+
     QHash<QString,QSet<QUuid>> _channelSubscribers;
+
+    // the messages for each subscriber since the last send, encoded one after another for a single packet list
+    QHash<QUuid, QByteArray> _pendingMessages;
+    QTimer* _sendPendingMessagesTimer { nullptr };
+
+    QHash<QString, ChannelStats> _channelStats;
+    quint64 _lastStatsTime { 0 };
 };
 
 #endif // hifi_MessagesMixer_h
@@ -24,6 +24,7 @@ void OctreeHeadlessViewer::queryOctree() {
     } else {
         _octreeQuery.clearConicalViews();
     }
+    _octreeQuery.setInterestRegions(_interestRegions);
 
     auto nodeList = DependencyManager::get<NodeList>();
 
@@ -42,6 +43,23 @@ void OctreeHeadlessViewer::queryOctree() {
 }
 
 
+void OctreeHeadlessViewer::addInterestSphere(const glm::vec3& center, float radius, float minEntitySize, int updatePeriod) {
+    InterestRegion region;
+    region.setSphere(center, radius);
+    region.setMinEntitySize(minEntitySize);
+    region.setUpdatePeriod((uint32_t)std::max(updatePeriod, 0));
+    _interestRegions.push_back(region);
+}
+
+void OctreeHeadlessViewer::addInterestBox(const glm::vec3& corner, const glm::vec3& dimensions, float minEntitySize,
+                                          int updatePeriod) {
+    InterestRegion region;
+    region.setBox(corner, dimensions);
+    region.setMinEntitySize(minEntitySize);
+    region.setUpdatePeriod((uint32_t)std::max(updatePeriod, 0));
+    _interestRegions.push_back(region);
+}
+
 int OctreeHeadlessViewer::parseOctreeStats(QSharedPointer<ReceivedMessage> message, SharedNodePointer sourceNode) {
 
     OctreeSceneStats temp;
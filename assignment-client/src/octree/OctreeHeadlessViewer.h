@@ -67,6 +67,37 @@ public slots:
     void setKeyholeRadius(float radius) { _hasViewFrustum = true; _viewFrustum.setCenterRadius(radius); } // TODO: remove this legacy support
 
 
+    // interest regions, for viewers that want the entities in an area rather than in view
+
+    /**jsdoc
+     * Adds a sphere to the regions that entities are received in, besides those in the view frustum if one is set.
+     * @function EntityViewer.addInterestSphere
+     * @param {Vec3} center - The center of the sphere.
+     * @param {number} radius - The radius of the sphere.
+     * @param {number} [minEntitySize=0] - The size of the smallest entities to receive in the sphere.
+     * @param {number} [updatePeriod=0] - How often, in milliseconds, changes to the entities are wanted. If every region
+     *     asks for updates less often and there is no view frustum, the entity server sends changes at that rate.
+     */
+    void addInterestSphere(const glm::vec3& center, float radius, float minEntitySize = 0.0f, int updatePeriod = 0);
+
+    /**jsdoc
+     * Adds a box to the regions that entities are received in, besides those in the view frustum if one is set.
+     * @function EntityViewer.addInterestBox
+     * @param {Vec3} corner - The minimum corner of the box.
+     * @param {Vec3} dimensions - The dimensions of the box.
+     * @param {number} [minEntitySize=0] - The size of the smallest entities to receive in the box.
+     * @param {number} [updatePeriod=0] - How often, in milliseconds, changes to the entities are wanted.
+     */
+    void addInterestBox(const glm::vec3& corner, const glm::vec3& dimensions, float minEntitySize = 0.0f,
+                        int updatePeriod = 0);
+
+    /**jsdoc
+     * Removes all the interest regions.
+     * @function EntityViewer.clearInterestRegions
+     */
+    void clearInterestRegions() { _interestRegions.clear(); }
+
+
     // setters for LOD and PPS
 
     /**jsdoc
@@ -143,6 +174,7 @@ private:
 
     bool _hasViewFrustum { false };
     ViewFrustum _viewFrustum;
+    InterestRegions _interestRegions;
 };
 
 #endif // hifi_OctreeHeadlessViewer_h
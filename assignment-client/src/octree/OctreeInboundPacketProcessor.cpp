@@ -172,11 +172,16 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
 
             quint64 startProcess, startLock = usecTimestampNow();
             int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
-                editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
+            auto octree = _myServer->getOctree();
+            if (octree->locksForEditPackets()) {
+                startProcess = startLock;
+                editDataBytesRead = octree->processEditPacketData(*message, editData, maxSize, sendingNode);
+            } else {
+                octree->withWriteLock([&] {
+                    startProcess = usecTimestampNow();
+                    editDataBytesRead = octree->processEditPacketData(*message, editData, maxSize, sendingNode);
+                });
+            }
             quint64 endProcess = usecTimestampNow();
 
             if (debugProcessPacket) {
@@ -317,6 +317,8 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         preDistributionProcessing();
     }
 
+    updateSendWindow(nodeData);
+
     _truePacketsSent = 0;
     _trueBytesSent = 0;
     _packetsSentThisInterval = 0;
@@ -385,12 +387,8 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         _totalSpecialBytes += specialBytesSent;
     }
 
-    // calculate max number of packets that can be sent during this interval
-    int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
-    int maxPacketsPerInterval = std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
-
     // Re-send packets that were nacked by the client
-    while (nodeData->hasNextNackedPacket() && _packetsSentThisInterval < maxPacketsPerInterval) {
+    while (nodeData->hasNextNackedPacket() && _packetsSentThisInterval < _maxPacketsPerInterval) {
         const NLPacket* packet = nodeData->getNextNackedPacket();
         if (packet) {
             DependencyManager::get<NodeList>()->sendUnreliablePacket(*packet, *node);
@@ -425,11 +423,44 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     return _truePacketsSent;
 }
 
-bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged, bool isFullScene) {
-    // calculate max number of packets that can be sent during this interval
+// the window starts small and doubles each interval that fills it, until the client first loses packets
+const float INITIAL_SEND_WINDOW = 2.0f;
+const float SEND_WINDOW_DECREASE = 0.5f;
+// the client reports what it missed about once a second, so the window is cut at most that often
+const quint64 MIN_USECS_BETWEEN_SEND_WINDOW_DECREASES = USECS_PER_SECOND;
+// a client that hasn't acknowledged this many intervals worth of packets is behind, and more would only queue up
+const int MAX_UNACKED_INTERVALS = INTERVALS_PER_SECOND / 2;
+
+void OctreeSendThread::updateSendWindow(OctreeQueryNode* nodeData) {
     int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
-    int maxPacketsPerInterval = std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
+    float ceiling = (float)std::max(1, std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval()));
+    if (_sendWindow <= 0.0f) {
+        _sendWindow = std::min(INITIAL_SEND_WINDOW, ceiling);
+    }
+
+    int unackedPackets = 0;
+    OCTREE_PACKET_SEQUENCE ackedSequenceNumber;
+    if (nodeData->getAckedSequenceNumber(ackedSequenceNumber)) {
+        unackedPackets = (OCTREE_PACKET_SEQUENCE)(nodeData->getSequenceNumber() - ackedSequenceNumber);
+    }
+    bool fellBehind = unackedPackets > _sendWindow * MAX_UNACKED_INTERVALS;
+
+    quint64 now = usecTimestampNow();
+    int nackedPackets = nodeData->takeNumNackedPackets();
+    if ((nackedPackets > 0 || fellBehind) && now - _lastSendWindowDecrease > MIN_USECS_BETWEEN_SEND_WINDOW_DECREASES) {
+        _sendWindow *= SEND_WINDOW_DECREASE;
+        _sendWindowSlowStart = false;
+        _lastSendWindowDecrease = now;
+    } else if (!fellBehind && _packetsSentThisInterval >= _maxPacketsPerInterval) {
+        // only grow while the window is what held the sending back
+        _sendWindow = _sendWindowSlowStart ? 2.0f * _sendWindow : _sendWindow + 1.0f;
+    }
 
+    _sendWindow = std::max(1.0f, std::min(_sendWindow, ceiling));
+    _maxPacketsPerInterval = (int)_sendWindow;
+}
+
+bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged, bool isFullScene) {
     int extraPackingAttempts = 0;
 
     // init params once outside the while loop
@@ -441,7 +472,7 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
 
     bool somethingToSend = true; // assume we have something
     bool hadSomething = hasSomethingToSend(nodeData);
-    while (somethingToSend && _packetsSentThisInterval < maxPacketsPerInterval && !nodeData->isShuttingDown()) {
+    while (somethingToSend && _packetsSentThisInterval < _maxPacketsPerInterval && !nodeData->isShuttingDown()) {
         float compressAndWriteElapsedUsec = OctreeServer::SKIP_TIME;
         float packetSendingElapsedUsec = OctreeServer::SKIP_TIME;
 
@@ -505,8 +536,8 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
 
     if (somethingToSend && _myServer->wantsVerboseDebug()) {
         qCDebug(octree) << "Hit PPS Limit, packetsSentThisInterval =" << _packetsSentThisInterval
-                        << "  maxPacketsPerInterval = " << maxPacketsPerInterval
-                        << "  clientMaxPacketsPerInterval = " << clientMaxPacketsPerInterval;
+                        << "  maxPacketsPerInterval = " << _maxPacketsPerInterval
+                        << "  sendWindow = " << _sendWindow;
     }
 
     return params.stopReason == EncodeBitstreamParams::FINISHED;
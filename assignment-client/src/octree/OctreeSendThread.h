@@ -66,6 +66,7 @@ private:
     virtual void preDistributionProcessing() = 0;
     int handlePacketSend(SharedNodePointer node, OctreeQueryNode* nodeData, bool dontSuppressDuplicate = false);
     int packetDistributor(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged);
+    void updateSendWindow(OctreeQueryNode* nodeData);
 
     virtual bool hasSomethingToSend(OctreeQueryNode* nodeData) = 0;
     virtual bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) = 0;
@@ -73,6 +74,13 @@ private:
     int _truePacketsSent { 0 }; // available for debug stats
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
+
+    // what the client's link is thought to take, in packets per interval, grown while it keeps up and cut when it loses
+    // packets or falls behind on acknowledging them. capped by the client's and the server's settings.
+    float _sendWindow { 0.0f };
+    bool _sendWindowSlowStart { true };
+    quint64 _lastSendWindowDecrease { 0 };
+    int _maxPacketsPerInterval { 1 };
     bool _isShuttingDown { false };
 };
 
@@ -1047,7 +1047,10 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persistFilePath=" << _persistFilePath;
         qDebug() << "persisAbsoluteFilePath=" << _persistAbsoluteFilePath;
 
-        _persistAsFileType = "json.gz";
+        bool persistBinary = false;
+        readOptionBool(QString("persistBinary"), settingsSectionObject, persistBinary);
+        _persistAsFileType = persistBinary ? OctreeBinaryFile::FILE_TYPE : "json.gz";
+        qDebug() << "persistAsFileType=" << _persistAsFileType;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         int result { -1 };
@@ -1476,6 +1479,7 @@ void OctreeServer::sendStatsPacket() {
     jsonArray["2. octree"] = octreeStats;
     jsonArray["3. outbound"] = statsObject2;
     jsonArray["4. inbound"] = statsObject3;
+    addServerSubclassStats(jsonArray);
 
     QJsonObject statsObject;
     statsObject[QString(getMyServerName()) + "Server"] = jsonArray;
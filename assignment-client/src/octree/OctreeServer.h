@@ -82,6 +82,7 @@ public:
     virtual bool hasSpecialPacketsToSend(const SharedNodePointer& node) { return false; }
     virtual int sendSpecialPackets(const SharedNodePointer& node, OctreeQueryNode* queryNode, int& packetsSent) { return 0; }
     virtual QString serverSubclassStats() { return QString(); }
+    virtual void addServerSubclassStats(QJsonObject& statsObject) { }
     virtual void trackSend(const QUuid& dataID, quint64 dataLastEdited, const QUuid& viewerNode) { }
     virtual void trackViewerGone(const QUuid& viewerNode) { }
 
@@ -0,0 +1,163 @@
+//
+//  EntityScriptEnginePool.cpp
+//  assignment-client/src/scripts
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptEnginePool.h"
+
+#include <cfloat>
+
+#include <QtCore/QJsonArray>
+
+#include <SharedUtil.h>
+
+using Lock = std::lock_guard<std::mutex>;
+
+// the load every script adds to its engine at the least, so that the scripts that hardly run still spread over the engines
+static const float MIN_SCRIPT_LOAD = 0.001f;
+
+void EntityScriptEnginePool::setEngines(const std::vector<ScriptEnginePointer>& engines) {
+    Lock lock(_mutex);
+    _engines.clear();
+    for (const auto& engine : engines) {
+        Engine poolEngine;
+        poolEngine.engine = engine;
+        _engines.push_back(poolEngine);
+    }
+    _entityEngines.clear();
+    _lastLoadUpdate = usecTimestampNow();
+}
+
+std::vector<ScriptEnginePointer> EntityScriptEnginePool::getEngines() const {
+    Lock lock(_mutex);
+    std::vector<ScriptEnginePointer> engines;
+    for (const auto& engine : _engines) {
+        engines.push_back(engine.engine);
+    }
+    return engines;
+}
+
+ScriptEnginePointer EntityScriptEnginePool::getMainEngine() const {
+    Lock lock(_mutex);
+    return _engines.empty() ? ScriptEnginePointer() : _engines[0].engine;
+}
+
+ScriptEnginePointer EntityScriptEnginePool::getEngine(const EntityItemID& entityID) const {
+    Lock lock(_mutex);
+    auto it = _entityEngines.constFind(entityID);
+    return it != _entityEngines.constEnd() ? _engines[it.value()].engine : ScriptEnginePointer();
+}
+
+int EntityScriptEnginePool::chooseEngine() const {
+    std::vector<int> numScripts(_engines.size(), 0);
+    for (int index : _entityEngines) {
+        numScripts[index]++;
+    }
+    int chosen = 0;
+    float minLoad = FLT_MAX;
+    for (size_t i = 0; i < _engines.size(); i++) {
+        float load = _engines[i].load + numScripts[i] * MIN_SCRIPT_LOAD;
+        if (load < minLoad) {
+            minLoad = load;
+            chosen = (int)i;
+        }
+    }
+    return chosen;
+}
+
+void EntityScriptEnginePool::loadEntityScript(const EntityItemID& entityID, const QString& scriptUrl, bool forceRedownload) {
+    ScriptEnginePointer engine;
+    {
+        Lock lock(_mutex);
+        if (_engines.empty()) {
+            return;
+        }
+        auto it = _entityEngines.find(entityID);
+        if (it == _entityEngines.end()) {
+            it = _entityEngines.insert(entityID, chooseEngine());
+        }
+        engine = _engines[it.value()].engine;
+    }
+    engine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+}
+
+void EntityScriptEnginePool::unloadEntityScript(const EntityItemID& entityID) {
+    ScriptEnginePointer engine;
+    {
+        Lock lock(_mutex);
+        auto it = _entityEngines.find(entityID);
+        if (it == _entityEngines.end()) {
+            return;
+        }
+        engine = _engines[it.value()].engine;
+        _entityEngines.erase(it);
+    }
+    engine->unloadEntityScript(entityID, true);
+}
+
+bool EntityScriptEnginePool::getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails& details) const {
+    auto engine = getEngine(entityID);
+    return engine && engine->getEntityScriptDetails(entityID, details);
+}
+
+int EntityScriptEnginePool::getNumRunningEntityScripts() const {
+    int numRunningScripts = 0;
+    for (const auto& engine : getEngines()) {
+        numRunningScripts += engine->getNumRunningEntityScripts();
+    }
+    return numRunningScripts;
+}
+
+void EntityScriptEnginePool::updateLoads() {
+    Lock lock(_mutex);
+    quint64 now = usecTimestampNow();
+    quint64 elapsed = now - _lastLoadUpdate;
+    _lastLoadUpdate = now;
+    for (auto& engine : _engines) {
+        // the time of the scripts that were unloaded since the last update is gone from the total
+        quint64 cpuTime = engine.engine->getEntityScriptsCPUTime();
+        quint64 spent = cpuTime > engine.lastCPUTime ? cpuTime - engine.lastCPUTime : 0;
+        engine.lastCPUTime = cpuTime;
+        engine.load = elapsed > 0 ? (float)spent / (float)elapsed : 0.0f;
+    }
+}
+
+QJsonObject EntityScriptEnginePool::getStats() const {
+    Lock lock(_mutex);
+    std::vector<int> numScripts(_engines.size(), 0);
+    for (int index : _entityEngines) {
+        numScripts[index]++;
+    }
+    QJsonArray enginesStats;
+    for (size_t i = 0; i < _engines.size(); i++) {
+        QJsonObject engineStats;
+        engineStats["number_scripts"] = numScripts[i];
+        engineStats["cpu_load"] = _engines[i].load;
+        engineStats["long_calls"] = (double)_engines[i].engine->getNumLongEntityScriptCalls();
+        enginesStats.append(engineStats);
+    }
+    QJsonObject stats;
+    stats["engines"] = enginesStats;
+    return stats;
+}
+
+void EntityScriptEnginePool::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+        const QStringList& params, const QUuid& remoteCallerID) {
+    if (auto engine = getEngine(entityID)) {
+        engine->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+    }
+}
+
+QFuture<QVariant> EntityScriptEnginePool::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    auto engine = getEngine(entityID);
+    if (!engine) {
+        // the engines answer for the entities they don't run too
+        engine = getMainEngine();
+    }
+    return engine ? engine->getLocalEntityScriptDetails(entityID) : QFuture<QVariant>();
+}
@@ -0,0 +1,67 @@
+//
+//  EntityScriptEnginePool.h
+//  assignment-client/src/scripts
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptEnginePool_h
+#define hifi_EntityScriptEnginePool_h
+
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptEngine.h>
+
+// The script engines of the entity script server, each on its own thread. The script of an entity runs in the engine
+// that was the least busy when it was loaded, and stays there until it is unloaded, since its state lives in that engine.
+// The first engine also runs the updates of the entity tree.
+class EntityScriptEnginePool : public EntitiesScriptEngineProvider {
+public:
+    void setEngines(const std::vector<ScriptEnginePointer>& engines);
+    std::vector<ScriptEnginePointer> getEngines() const;
+    ScriptEnginePointer getMainEngine() const;
+
+    // the engine that runs the script of the entity, if it has one
+    ScriptEnginePointer getEngine(const EntityItemID& entityID) const;
+
+    void loadEntityScript(const EntityItemID& entityID, const QString& scriptUrl, bool forceRedownload);
+    void unloadEntityScript(const EntityItemID& entityID);
+    bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails& details) const;
+
+    int getNumRunningEntityScripts() const;
+
+    // measures the load of every engine over the time since the last call, from the CPU time of their scripts
+    void updateLoads();
+    QJsonObject getStats() const;
+
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+        const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+private:
+    struct Engine {
+        ScriptEnginePointer engine;
+        // the fraction of the time spent in the engine's scripts since the last updateLoads
+        float load { 0.0f };
+        quint64 lastCPUTime { 0 };
+    };
+
+    int chooseEngine() const;
+
+    mutable std::mutex _mutex;
+    std::vector<Engine> _engines;
+    QHash<EntityItemID, int> _entityEngines;
+    quint64 _lastLoadUpdate { 0 };
+};
+
+using EntityScriptEnginePoolPointer = QSharedPointer<EntityScriptEnginePool>;
+
+#endif // hifi_EntityScriptEnginePool_h
@@ -13,6 +13,8 @@
 
 #include <mutex>
 
+#include <QtCore/QThread>
+
 #include <AudioConstants.h>
 #include <AudioInjectorManager.h>
 #include <ClientServerUtils.h>
@@ -21,6 +23,7 @@
 #include <EntityScriptingInterface.h>
 #include <LogHandler.h>
 #include <MessagesClient.h>
+#include <PhysicsHelpers.h>
 #include <plugins/CodecPlugin.h>
 #include <plugins/PluginManager.h>
 #include <ResourceManager.h>
@@ -125,7 +128,7 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        if (_entitiesScriptEngines->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -167,10 +170,88 @@ void EntityScriptServer::handleSettings() {
 
     qDebug() << QString("Received entity script server settings, Max Entity PPS: %1, Entity PPS Per Entity Script: %2")
                 .arg(_maxEntityPPS).arg(_entityPPSPerScript);
+
+    // the domain-server restarts the assignment when this changes, so physics only ever starts here
+    static const QString SIMULATE_PHYSICS_OPTION = "simulate_physics";
+    if (!_hasReceivedSettings) {
+        _hasReceivedSettings = true;
+        _simulatesPhysics = entityScriptServerSettings[SIMULATE_PHYSICS_OPTION].toBool();
+        setupEntityQuery();
+        if (_simulatesPhysics && _entityViewer.getTree() && !_shuttingDown) {
+            startPhysics();
+        }
+    }
+}
+
+void EntityScriptServer::setupEntityQuery() {
+    QJsonObject queryJSONParameters;
+    if (!_simulatesPhysics) {
+        // setup the JSON filter that asks for entities with a non-default serverScripts property
+        queryJSONParameters[EntityJSONQueryProperties::SERVER_SCRIPTS_PROPERTY] = EntityQueryFilterSymbol::NonDefault;
+    }
+    // otherwise all of the entities match, the static ones are needed to collide with
+
+    QJsonObject queryFlags;
+
+    queryFlags[EntityJSONQueryProperties::INCLUDE_ANCESTORS_PROPERTY] = true;
+    queryFlags[EntityJSONQueryProperties::INCLUDE_DESCENDANTS_PROPERTY] = true;
+
+    queryJSONParameters[EntityJSONQueryProperties::FLAGS_PROPERTY] = queryFlags;
+
+    // setup the JSON parameters so that OctreeQuery does not use a frustum and uses our JSON filter
+    _entityViewer.getOctreeQuery().setJSONParameters(queryJSONParameters);
+}
+
+void EntityScriptServer::startPhysics() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    Physics::setSessionUUID(nodeList->getSessionUUID());
+    connect(nodeList.data(), &NodeList::uuidChanged, this, [](const QUuid& sessionUUID) {
+        Physics::setSessionUUID(sessionUUID);
+    });
+
+    // outbid the clients that bump into the objects, but not the ones that grab them
+    EntityMotionState::setVolunteerPriority(RECRUIT_SIMULATION_PRIORITY);
+
+    ObjectMotionState::setShapeManager(&_shapeManager);
+    _physicsEngine = std::make_shared<PhysicsEngine>(Vectors::ZERO);
+    _physicsEngine->init();
+
+    auto tree = _entityViewer.getTree();
+    _physicalEntitySimulation = std::make_shared<PhysicalEntitySimulation>();
+    _physicalEntitySimulation->init(tree, _physicsEngine, &_entityEditSender);
+    tree->setSimulation(_physicalEntitySimulation);
+
+    qCInfo(entity_script_server) << "Simulating the physics of the entities";
+}
+
+void EntityScriptServer::stepPhysics() {
+    auto tree = _entityViewer.getTree();
+    _physicalEntitySimulation->removeDeadEntities();
+    {
+        PhysicsEngine::Transaction transaction;
+        _physicalEntitySimulation->buildPhysicsTransaction(transaction);
+        _physicsEngine->processTransaction(transaction);
+        _physicalEntitySimulation->handleProcessedPhysicsTransaction(transaction);
+    }
+    _physicalEntitySimulation->applyDynamicChanges();
+
+    tree->withWriteLock([&] {
+        _physicsEngine->stepSimulation();
+    });
+
+    if (_physicsEngine->hasOutgoingChanges()) {
+        // grab the collision events BEFORE handleChangedMotionStates(), as in the interface
+        auto& collisionEvents = _physicsEngine->getCollisionEvents();
+        tree->withWriteLock([&] {
+            _physicalEntitySimulation->handleChangedMotionStates(_physicsEngine->getChangedMotionStates());
+            _physicalEntitySimulation->handleDeactivatedMotionStates(_physicsEngine->getDeactivatedMotionStates());
+        });
+        _physicalEntitySimulation->handleCollisionEvents(collisionEvents);
+    }
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = _entitiesScriptEngines->getNumRunningEntityScripts();
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -231,7 +312,7 @@ void EntityScriptServer::pushLogs() {
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptEngine && _entityViewer.getTree() && !_shuttingDown) {
+    if (_entitiesScriptEngines->getMainEngine() && _entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -245,7 +326,7 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptEngine->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        _entitiesScriptEngines->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -283,20 +364,7 @@ void EntityScriptServer::run() {
     entityScriptingInterface->init();
 
     _entityViewer.init();
-    
-    // setup the JSON filter that asks for entities with a non-default serverScripts property
-    QJsonObject queryJSONParameters;
-    queryJSONParameters[EntityJSONQueryProperties::SERVER_SCRIPTS_PROPERTY] = EntityQueryFilterSymbol::NonDefault;
-
-    QJsonObject queryFlags;
-
-    queryFlags[EntityJSONQueryProperties::INCLUDE_ANCESTORS_PROPERTY] = true;
-    queryFlags[EntityJSONQueryProperties::INCLUDE_DESCENDANTS_PROPERTY] = true;
-
-    queryJSONParameters[EntityJSONQueryProperties::FLAGS_PROPERTY] = queryFlags;
-    
-    // setup the JSON parameters so that OctreeQuery does not use a frustum and uses our JSON filter
-    _entityViewer.getOctreeQuery().setJSONParameters(queryJSONParameters);
+    setupEntityQuery();
 
     entityScriptingInterface->setEntityTree(_entityViewer.getTree());
 
@@ -439,7 +507,7 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
+ScriptEnginePointer EntityScriptServer::createEntitiesScriptEngine(bool isMainEngine) {
     auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
     auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
 
@@ -456,35 +524,58 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
     connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
     connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->preUpdate();
-        _entityViewer.getTree()->update();
-    });
+    // the tree is updated once per frame, by the first engine
+    if (isMainEngine) {
+        connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+            if (_hasReceivedSettings) {
+                _entityViewer.queryOctree();
+            }
+            _entityViewer.getTree()->preUpdate();
+            if (_physicsEngine) {
+                stepPhysics();
+            }
+            _entityViewer.getTree()->update();
+        });
+    }
 
     scriptEngines->runScriptInitializers(newEngine);
     newEngine->runInThread();
-    auto newEngineSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngine);
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngineSP);
 
-    if (_entitiesScriptEngine) {
-        disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+    connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+            this, &EntityScriptServer::updateEntityPPS);
+    return newEngine;
+}
+
+void EntityScriptServer::resetEntitiesScriptEngine() {
+    for (const auto& engine : _entitiesScriptEngines->getEngines()) {
+        disconnect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated,
                    this, &EntityScriptServer::updateEntityPPS);
     }
 
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+    // one bad script only holds up the others of its engine, and the engines use as many cores
+    const int MAX_ENTITY_SCRIPT_ENGINES = 4;
+    int numEngines = std::max(1, std::min(QThread::idealThreadCount() / 2, MAX_ENTITY_SCRIPT_ENGINES));
+    std::vector<ScriptEnginePointer> newEngines;
+    for (int i = 0; i < numEngines; i++) {
+        newEngines.push_back(createEntitiesScriptEngine(i == 0));
+    }
+    _entitiesScriptEngines->setEngines(newEngines);
+
+    auto enginesSP = qSharedPointerCast<EntitiesScriptEngineProvider>(_entitiesScriptEngines);
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(enginesSP);
 }
 
 
 void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
+    // unload and stop the engines
+    auto engines = _entitiesScriptEngines->getEngines();
+    for (const auto& engine : engines) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-        _entitiesScriptEngine->waitTillDoneRunning();
+        engine->unloadAllEntityScripts();
+        engine->stop();
+    }
+    for (const auto& engine : engines) {
+        engine->waitTillDoneRunning();
     }
 
     _entityViewer.clear();
@@ -496,17 +587,26 @@ void EntityScriptServer::clear() {
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    for (const auto& engine : _entitiesScriptEngines->getEngines()) {
+        engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
     }
     _shuttingDown = true;
 
     clear(); // always clear() on shutdown
 
+    if (_physicsEngine) {
+        // take the bodies of the entities erased by clear() out of the physics engine before it goes away
+        _physicalEntitySimulation->removeDeadEntities();
+        PhysicsEngine::Transaction transaction;
+        _physicalEntitySimulation->buildPhysicsTransaction(transaction);
+        _physicsEngine->processTransaction(transaction);
+        _physicalEntitySimulation->handleProcessedPhysicsTransaction(transaction);
+    }
+
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptEngine.clear();
+    _entitiesScriptEngines->setEngines(std::vector<ScriptEnginePointer>());
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
@@ -524,8 +624,8 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown) {
+        _entitiesScriptEngines->unloadEntityScript(entityID);
     }
 }
 
@@ -536,20 +636,20 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngines->getMainEngine()) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        bool isRunning = _entitiesScriptEngines->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
             if (isRunning) {
-                _entitiesScriptEngine->unloadEntityScript(entityID, true);
+                _entitiesScriptEngines->unloadEntityScript(entityID);
             }
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                _entitiesScriptEngines->loadEntityScript(entityID, scriptUrl, forceRedownload);
             }
         }
     }
@@ -564,13 +664,9 @@ void EntityScriptServer::sendStatsPacket() {
     octreeStats["leafElementCount"] = (double)OctreeElement::getLeafNodeCount();
     statsObject["octree_stats"] = octreeStats;
 
-    QJsonObject scriptEngineStats;
-    int numberRunningScripts = 0;
-    const auto scriptEngine = _entitiesScriptEngine;
-    if (scriptEngine) {
-        numberRunningScripts = scriptEngine->getNumRunningEntityScripts();
-    }
-    scriptEngineStats["number_running_scripts"] = numberRunningScripts;
+    _entitiesScriptEngines->updateLoads();
+    QJsonObject scriptEngineStats = _entitiesScriptEngines->getStats();
+    scriptEngineStats["number_running_scripts"] = _entitiesScriptEngines->getNumRunningEntityScripts();
     statsObject["script_engine_stats"] = scriptEngineStats;
     
 
@@ -613,7 +709,7 @@ void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> mess
             // pull out the piggybacked packet and create a new QSharedPointer<NLPacket> for it
             int piggyBackedSizeWithHeader = message->getSize() - statsMessageLength;
 
-            auto buffer = std::unique_ptr<char[]>(new char[piggyBackedSizeWithHeader]);
+            auto buffer = udt::PacketBufferPool::allocate(piggyBackedSizeWithHeader);
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggyBackedSizeWithHeader);
 
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggyBackedSizeWithHeader, message->getSenderSockAddr());
@@ -19,11 +19,15 @@
 #include <QtCore/QUuid>
 
 #include <EntityEditPacketSender.h>
+#include <PhysicalEntitySimulation.h>
+#include <PhysicsEngine.h>
 #include <plugins/CodecPlugin.h>
 #include <ScriptEngine.h>
+#include <ShapeManager.h>
 #include <SimpleEntitySimulation.h>
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "EntityScriptEnginePool.h"
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -61,7 +65,12 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
+    void setupEntityQuery();
+    void startPhysics();
+    void stepPhysics();
+
     void resetEntitiesScriptEngine();
+    ScriptEnginePointer createEntitiesScriptEngine(bool isMainEngine);
     void clear();
     void shutdownScriptEngine();
 
@@ -75,11 +84,18 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptEnginePointer _entitiesScriptEngine;
+    EntityScriptEnginePoolPointer _entitiesScriptEngines { new EntityScriptEnginePool() };
     SimpleEntitySimulationPointer _entitySimulation;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
 
+    // the entities are queried once the settings have told whether this server simulates their physics
+    bool _hasReceivedSettings { false };
+    bool _simulatesPhysics { false };
+    ShapeManager _shapeManager;
+    PhysicsEnginePointer _physicsEngine;
+    PhysicalEntitySimulationPointer _physicalEntitySimulation;
+
     int _maxEntityPPS { DEFAULT_MAX_ENTITY_PPS };
     int _entityPPSPerScript { DEFAULT_ENTITY_PPS_PER_SCRIPT };
 
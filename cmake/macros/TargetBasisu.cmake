@@ -0,0 +1,21 @@
+#
+#  Copyright 2020 Project Athena Contributors.
+#
+#  Distributed under the Apache License, Version 2.0.
+#  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+#
+macro(TARGET_BASISU)
+    # optional, the textures are only baked to and transcoded from Basis Universal when it is found
+    if (NOT ANDROID)
+        find_path(BASISU_INCLUDE_DIRS basisu/transcoder/basisu_transcoder.h PATHS ${VCPKG_INSTALL_ROOT}/include NO_DEFAULT_PATH)
+        find_library(BASISU_LIBRARY_DEBUG basisu_encoder PATHS ${VCPKG_INSTALL_ROOT}/debug/lib/ NO_DEFAULT_PATH)
+        find_library(BASISU_LIBRARY_RELEASE basisu_encoder PATHS ${VCPKG_INSTALL_ROOT}/lib/ NO_DEFAULT_PATH)
+
+        if (BASISU_INCLUDE_DIRS AND BASISU_LIBRARY_RELEASE)
+            select_library_configurations(BASISU)
+            target_include_directories(${TARGET_NAME} PRIVATE ${BASISU_INCLUDE_DIRS})
+            target_link_libraries(${TARGET_NAME} ${BASISU_LIBRARIES})
+            target_compile_definitions(${TARGET_NAME} PRIVATE HAVE_BASISU)
+        endif()
+    endif()
+endmacro()
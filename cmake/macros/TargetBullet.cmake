@@ -17,6 +17,8 @@ macro(TARGET_BULLET)
         list(APPEND BULLET_LIBRARIES ${LIB_DIR}/libBulletSoftBody.a)
     else()
         find_package(Bullet REQUIRED)
+        # Bullet is built thread safe, its headers have to be seen the same way
+        target_compile_definitions(${TARGET_NAME} PRIVATE BT_THREADSAFE=1)
    endif()
     # perform the system include hack for OS X to ignore warnings
     if (APPLE)
@@ -1,4 +1,5 @@
 # Updated June 6th, 2019, to force new vckpg hash
+# Built thread safe for the multithreaded dynamics world
 #
 # Common Ambient Variables:
 #
@@ -46,6 +47,7 @@ vcpkg_configure_cmake(
         -DBUILD_UNIT_TESTS=OFF
         -DBUILD_SHARED_LIBS=ON
         -DINSTALL_LIBS=ON
+        -DBT_THREADSAFE=ON
 )
 
 vcpkg_install_cmake()
@@ -394,9 +394,13 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
         return;
     }
 
+    // the assets are content addressed, the ones mapped to several paths are only added once
+    std::set<AssetUtils::AssetHash> hashes;
     for (const auto& mapping : it->mappings) {
-        const auto& hash = mapping.second;
+        hashes.insert(mapping.second);
+    }
 
+    for (const auto& hash : hashes) {
         QDir assetsDir { _assetsDirectory };
         QFile file { assetsDir.filePath(hash) };
         if (!file.open(QFile::ReadOnly)) {
@@ -409,7 +413,9 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
             qCDebug(asset_backup) << "Could not open zip file:" << zipFile.getZipError();
             continue;
         }
-        zipFile.write(file.readAll());
+        if (!copyBackupData(file, zipFile)) {
+            qCDebug(asset_backup) << "Could not write asset file" << file.fileName() << "to zip file";
+        }
         zipFile.close();
         if (zipFile.getZipError() != UNZ_OK) {
             qCDebug(asset_backup) << "Could not close zip file: " << zipFile.getZipError();
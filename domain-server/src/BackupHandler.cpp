@@ -0,0 +1,41 @@
+//
+//  BackupHandler.cpp
+//  domain-server/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BackupHandler.h"
+
+#include <chrono>
+#include <thread>
+
+#include <QIODevice>
+
+#include <NumericalConstants.h>
+#include <PortableHighResolutionClock.h>
+
+static const qint64 BACKUP_CHUNK_SIZE = 1024 * 1024;
+static const qint64 MAX_BACKUP_BYTES_PER_SECOND = 32 * 1024 * 1024;
+
+bool copyBackupData(QIODevice& source, QIODevice& destination) {
+    auto start = p_high_resolution_clock::now();
+    qint64 bytesCopied = 0;
+    while (!source.atEnd()) {
+        QByteArray chunk = source.read(BACKUP_CHUNK_SIZE);
+        if (chunk.isEmpty() || destination.write(chunk) != chunk.size()) {
+            return false;
+        }
+        bytesCopied += chunk.size();
+
+        auto budget = std::chrono::microseconds(bytesCopied * (qint64)USECS_PER_SECOND / MAX_BACKUP_BYTES_PER_SECOND);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - start);
+        if (budget > elapsed) {
+            std::this_thread::sleep_for(budget - elapsed);
+        }
+    }
+    return true;
+}
@@ -16,6 +16,7 @@
 
 #include <QString>
 
+class QIODevice;
 class QuaZip;
 
 class BackupHandlerInterface {
@@ -37,4 +38,8 @@ public:
 };
 using BackupHandlerPointer = std::unique_ptr<BackupHandlerInterface>;
 
+// Streams the rest of a file in or out of a backup a chunk at a time, no faster than the backups are allowed to do IO,
+// so that backing up large content neither holds all of it in memory nor starves the domain's other IO
+bool copyBackupData(QIODevice& source, QIODevice& destination);
+
 #endif /* hifi_BackupHandler_h */
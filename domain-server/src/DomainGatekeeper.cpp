@@ -14,9 +14,12 @@
 #include <openssl/err.h>
 #include <openssl/rsa.h>
 #include <openssl/x509.h>
+#include <algorithm>
 #include <random>
 
 #include <QDataStream>
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
 
 #include <AccountManager.h>
 #include <Assignment.h>
@@ -26,10 +29,27 @@
 
 using SharedAssignmentPointer = QSharedPointer<Assignment>;
 
+// a key this old is still used to verify signatures, but is fetched again rather than relied on when a user connects
+static const quint64 USER_PUBLIC_KEY_TTL_USECS = 10 * 60 * USECS_PER_SECOND;
+
+namespace {
+    class SignatureVerificationTask : public QRunnable {
+    public:
+        SignatureVerificationTask(std::function<void()> task) : _task(task) {}
+
+        void run() override { _task(); }
+
+    private:
+        std::function<void()> _task;
+    };
+}
+
 DomainGatekeeper::DomainGatekeeper(DomainServer* server) :
     _server(server)
 {
     initLocalIDManagement();
+
+    _signatureVerificationPool.setMaxThreadCount(std::max(QThread::idealThreadCount() - 1, 1));
 }
 
 void DomainGatekeeper::addPendingAssignedNode(const QUuid& nodeUUID, const QUuid& assignmentUUID,
@@ -89,6 +109,7 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
 
     SharedNodePointer node;
     QString username;
+    bool isAwaitingVerification = false;
     if (pendingAssignment != _pendingAssignedNodes.end()) {
         node = processAssignmentConnectRequest(nodeConnection, pendingAssignment->second);
     } else if (!STATICALLY_ASSIGNED_NODES.contains(nodeConnection.nodeType)) {
@@ -104,7 +125,7 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
             }
         }
 
-        node = processAgentConnectRequest(nodeConnection, username, usernameSignature);
+        node = processAgentConnectRequest(nodeConnection, username, usernameSignature, message, isAwaitingVerification);
     }
 
     if (node) {
@@ -134,7 +155,7 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
         // signal that we just connected a node so the DomainServer can get it a list
         // and broadcast its presence right away
         emit connectedNode(node, message->getFirstPacketReceiveTime());
-    } else {
+    } else if (!isAwaitingVerification) {
         qDebug() << "Refusing connection from node at" << message->getSenderSockAddr()
             << "with hardware address" << nodeConnection.hardwareAddress
             << "and machine fingerprint" << nodeConnection.machineFingerprint
@@ -392,7 +413,9 @@ const QString MAXIMUM_USER_CAPACITY_REDIRECT_LOCATION = "security.maximum_user_c
 
 SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnectionData& nodeConnection,
                                                                const QString& username,
-                                                               const QByteArray& usernameSignature) {
+                                                               const QByteArray& usernameSignature,
+                                                               const QSharedPointer<ReceivedMessage>& message,
+                                                               bool& isAwaitingVerification) {
 
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
@@ -413,17 +436,27 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
             // user is attempting to prove their identity to us, but we don't have enough information
             sendConnectionTokenPacket(username, nodeConnection.senderSockAddr);
 
-            // ask for their public key right now to make sure we have it
-            requestUserPublicKey(username, true);
+            // ask for their public key right now to make sure we have it, unless we just got it
+            auto publicKeyIt = _userPublicKeys.find(username.toLower());
+            if (publicKeyIt == _userPublicKeys.end() || usecTimestampNow() - publicKeyIt->fetchedAt > USER_PUBLIC_KEY_TTL_USECS) {
+                requestUserPublicKey(username, true);
+            }
             getGroupMemberships(username); // optimistically get started on group memberships
 #ifdef WANT_DEBUG
             qDebug() << "stalling login because we have no username-signature:" << username;
 #endif
             return SharedNodePointer();
-        } else if (verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr)) {
+        }
+
+        auto signatureResult = verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr, message);
+        if (signatureResult == SignatureResult::Verified) {
             // they sent us a username and the signature verifies it
             getGroupMemberships(username);
             verifiedUsername = username.toLower();
+        } else if (signatureResult == SignatureResult::Pending) {
+            // we'll be back here once it has been checked
+            isAwaitingVerification = true;
+            return SharedNodePointer();
         } else {
             // they sent us a username, but it didn't check out
             requestUserPublicKey(username);
@@ -434,8 +467,10 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
         }
     }
 
+    auto permissionsStartTime = usecTimestampNow();
     userPerms = setPermissionsForUser(isLocalUser, verifiedUsername, nodeConnection.senderSockAddr.getAddress(),
                                       nodeConnection.hardwareAddress, nodeConnection.machineFingerprint);
+    _permissionResolutionTimes.record(usecTimestampNow() - permissionsStartTime);
 
     if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
         sendConnectionDeniedPacket("You lack the required permissions to connect to this domain.",
@@ -558,62 +593,66 @@ void DomainGatekeeper::cleanupICEPeerForNode(const QUuid& nodeID) {
     }
 }
 
-bool DomainGatekeeper::verifyUserSignature(const QString& username,
-                                           const QByteArray& usernameSignature,
-                                           const HifiSockAddr& senderSockAddr) {
+DomainGatekeeper::SignatureResult DomainGatekeeper::verifyUserSignature(const QString& username,
+                                                                        const QByteArray& usernameSignature,
+                                                                        const HifiSockAddr& senderSockAddr,
+                                                                        const QSharedPointer<ReceivedMessage>& message) {
     // it's possible this user can be allowed to connect, but we need to check their username signature
     auto lowerUsername = username.toLower();
-    KeyFlagPair publicKeyPair = _userPublicKeys.value(lowerUsername);
-
-    QByteArray publicKeyArray = publicKeyPair.first;
-    bool isOptimisticKey = publicKeyPair.second;
+    auto publicKeyIt = _userPublicKeys.find(lowerUsername);
 
     const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
 
-    if (!publicKeyArray.isEmpty() && !connectionToken.isNull()) {
+    if (publicKeyIt != _userPublicKeys.end() && !publicKeyIt->key.isEmpty() && !connectionToken.isNull()) {
         // if we do have a public key for the user, check for a signature match
-
-        const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
-
-        // first load up the public key into an RSA struct
-        RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
-
         QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
         QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
                                                                 QCryptographicHash::Sha256);
 
-        if (rsaPublicKey) {
-            int decryptResult = RSA_verify(NID_sha256,
-                                           reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
-                                           usernameWithToken.size(),
-                                           reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
-                                           usernameSignature.size(),
-                                           rsaPublicKey);
-
-            if (decryptResult == 1) {
-                qDebug() << "Username signature matches for" << username;
-
-                // free up the public key and remove connection token before we return
-                RSA_free(rsaPublicKey);
-                _connectionTokenHash.remove(username);
-
-                return true;
-
-            } else {
-                // we only send back a LoginError if this wasn't an "optimistic" key
-                // (a key that we hoped would work but is probably stale)
-
-                if (!senderSockAddr.isNull() && !isOptimisticKey) {
-                    qDebug() << "Error decrypting username signature for" << username << "- denying connection.";
-                    sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
-                        DomainHandler::ConnectionRefusedReason::LoginError);
-                } else if (!senderSockAddr.isNull()) {
-                    qDebug() << "Error decrypting username signature for" << username << "with optimisitic key -"
-                        << "re-requesting public key and delaying connection";
-                }
+        QByteArray verificationKey = usernameWithToken + usernameSignature;
+        auto resultIt = _signatureVerificationResults.find(verificationKey);
+        if (resultIt == _signatureVerificationResults.end()) {
+            // the check is done on the verification pool, so that a crowd of users arriving together doesn't hold up
+            // everything else on this thread, and the connect request is processed again with the result
+            if (!_pendingSignatureVerifications.contains(verificationKey)) {
+                auto publicKeyArray = publicKeyIt->key;
+                auto queuedAt = usecTimestampNow();
+                _signatureVerificationPool.start(new SignatureVerificationTask([this, publicKeyArray, usernameWithToken,
+                                                                                usernameSignature, verificationKey, queuedAt] {
+                    auto result = verifySignatureWithKey(publicKeyArray, usernameWithToken, usernameSignature);
+                    auto verifyUsecs = usecTimestampNow() - queuedAt;
+                    QMetaObject::invokeMethod(this, [this, verificationKey, result, verifyUsecs] {
+                        handleSignatureVerified(verificationKey, result, verifyUsecs);
+                    }, Qt::QueuedConnection);
+                }));
+            }
+            // the newest of the repeated connect requests is the one that is processed again
+            _pendingSignatureVerifications[verificationKey] = message;
+            return SignatureResult::Pending;
+        }
+
+        auto result = resultIt.value();
+        bool isOptimisticKey = publicKeyIt->isOptimistic;
+
+        if (result == VerificationResult::Match) {
+            qDebug() << "Username signature matches for" << username;
+
+            // remove connection token before we return
+            _connectionTokenHash.remove(username);
+
+            return SignatureResult::Verified;
 
-                // free up the public key, we don't need it anymore
-                RSA_free(rsaPublicKey);
+        } else if (result == VerificationResult::Mismatch) {
+            // we only send back a LoginError if this wasn't an "optimistic" key
+            // (a key that we hoped would work but is probably stale)
+
+            if (!senderSockAddr.isNull() && !isOptimisticKey) {
+                qDebug() << "Error decrypting username signature for" << username << "- denying connection.";
+                sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
+                    DomainHandler::ConnectionRefusedReason::LoginError);
+            } else if (!senderSockAddr.isNull()) {
+                qDebug() << "Error decrypting username signature for" << username << "with optimisitic key -"
+                    << "re-requesting public key and delaying connection";
             }
 
         } else {
@@ -632,7 +671,46 @@ bool DomainGatekeeper::verifyUserSignature(const QString& username,
     }
 
     requestUserPublicKey(username); // no joy.  maybe next time?
-    return false;
+    return SignatureResult::Failed;
+}
+
+void DomainGatekeeper::handleSignatureVerified(const QByteArray& verificationKey, VerificationResult result,
+                                               quint64 verifyUsecs) {
+    _signatureVerifyTimes.record(verifyUsecs);
+
+    auto message = _pendingSignatureVerifications.take(verificationKey);
+    if (!message) {
+        return;
+    }
+
+    // the result is only good for the connect request that was waiting on it
+    _signatureVerificationResults.insert(verificationKey, result);
+    processConnectRequestPacket(message);
+    _signatureVerificationResults.remove(verificationKey);
+}
+
+DomainGatekeeper::VerificationResult DomainGatekeeper::verifySignatureWithKey(const QByteArray& publicKeyArray,
+                                                                              const QByteArray& usernameWithToken,
+                                                                              const QByteArray& usernameSignature) {
+    const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
+
+    // first load up the public key into an RSA struct
+    RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
+    if (!rsaPublicKey) {
+        return VerificationResult::InvalidKey;
+    }
+
+    int decryptResult = RSA_verify(NID_sha256,
+                                   reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
+                                   usernameWithToken.size(),
+                                   reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
+                                   usernameSignature.size(),
+                                   rsaPublicKey);
+
+    // free up the public key, we don't need it anymore
+    RSA_free(rsaPublicKey);
+
+    return decryptResult == 1 ? VerificationResult::Match : VerificationResult::Mismatch;
 }
 
 bool DomainGatekeeper::isWithinMaxCapacity() {
@@ -667,6 +745,7 @@ void DomainGatekeeper::requestUserPublicKey(const QString& username, bool isOpti
         return;
     }
     _inFlightPublicKeyRequests.insert(lowerUsername, isOptimistic);
+    _publicKeyRequestTimes.insert(lowerUsername, usecTimestampNow());
 
     // even if we have a public key for them right now, request a new one in case it has just changed
     JSONCallbackParameters callbackParams;
@@ -700,6 +779,9 @@ void DomainGatekeeper::publicKeyJSONCallback(QNetworkReply* requestReply) {
     QString username = extractUsernameFromPublicKeyRequest(requestReply);
 
     bool isOptimisticKey = _inFlightPublicKeyRequests.take(username);
+    if (_publicKeyRequestTimes.contains(username)) {
+        _publicKeyFetchTimes.record(usecTimestampNow() - _publicKeyRequestTimes.take(username));
+    }
 
     if (jsonObject["status"].toString() == "success" && !username.isEmpty()) {
         // pull the public key as a QByteArray from this response
@@ -711,7 +793,8 @@ void DomainGatekeeper::publicKeyJSONCallback(QNetworkReply* requestReply) {
         _userPublicKeys[username.toLower()] =
             {
                 QByteArray::fromBase64(jsonObject[JSON_DATA_KEY].toObject()[JSON_PUBLIC_KEY_KEY].toString().toUtf8()),
-                isOptimisticKey
+                isOptimisticKey,
+                usecTimestampNow()
             };
     }
 }
@@ -720,6 +803,7 @@ void DomainGatekeeper::publicKeyJSONErrorCallback(QNetworkReply* requestReply) {
     qDebug() << "publicKey api call failed:" << requestReply->error();
     QString username = extractUsernameFromPublicKeyRequest(requestReply);
     _inFlightPublicKeyRequests.remove(username);
+    _publicKeyRequestTimes.remove(username);
 }
 
 void DomainGatekeeper::sendProtocolMismatchConnectionDenial(const HifiSockAddr& senderSockAddr) {
@@ -1061,3 +1145,27 @@ Node::LocalID DomainGatekeeper::findOrCreateLocalID(const QUuid& uuid) {
     _localIDs.insert(newLocalID);
     return newLocalID;
 }
+
+void DomainGatekeeper::StageTimes::record(quint64 usecs) {
+    ++_count;
+    _totalUsecs += usecs;
+    _maxUsecs = std::max(_maxUsecs, usecs);
+}
+
+QJsonObject DomainGatekeeper::StageTimes::toJson() const {
+    QJsonObject stageJSON;
+    stageJSON["count"] = (qint64)_count;
+    stageJSON["average_usecs"] = _count > 0 ? (qint64)(_totalUsecs / _count) : 0;
+    stageJSON["max_usecs"] = (qint64)_maxUsecs;
+    return stageJSON;
+}
+
+QJsonObject DomainGatekeeper::getConnectionStats() const {
+    QJsonObject statsJSON;
+    statsJSON["public_key_fetch"] = _publicKeyFetchTimes.toJson();
+    statsJSON["signature_verify"] = _signatureVerifyTimes.toJson();
+    statsJSON["permission_resolution"] = _permissionResolutionTimes.toJson();
+    statsJSON["pending_verifications"] = _pendingSignatureVerifications.size();
+    statsJSON["cached_public_keys"] = _userPublicKeys.size();
+    return statsJSON;
+}
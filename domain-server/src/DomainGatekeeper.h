@@ -17,7 +17,9 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
+#include <QtCore/QThreadPool>
 #include <QtNetwork/QNetworkReply>
 
 #include <DomainHandler.h>
@@ -45,6 +47,10 @@ public:
     Node::LocalID findOrCreateLocalID(const QUuid& uuid);
 
     static void sendProtocolMismatchConnectionDenial(const HifiSockAddr& senderSockAddr);
+
+    // how long fetching public keys, verifying username signatures and resolving permissions take
+    QJsonObject getConnectionStats() const;
+
 public slots:
     void processConnectRequestPacket(QSharedPointer<ReceivedMessage> message);
     void processICEPingPacket(QSharedPointer<ReceivedMessage> message);
@@ -76,11 +82,27 @@ private:
                                                       const PendingAssignedNodeData& pendingAssignment);
     SharedNodePointer processAgentConnectRequest(const NodeConnectionData& nodeConnection,
                                                  const QString& username,
-                                                 const QByteArray& usernameSignature);
+                                                 const QByteArray& usernameSignature,
+                                                 const QSharedPointer<ReceivedMessage>& message,
+                                                 bool& isAwaitingVerification);
     SharedNodePointer addVerifiedNodeFromConnectRequest(const NodeConnectionData& nodeConnection);
-    
-    bool verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
-                             const HifiSockAddr& senderSockAddr);
+
+    enum class SignatureResult {
+        Verified,
+        Pending, // being verified on the verification pool, the connect request is processed again once it is done
+        Failed
+    };
+    enum class VerificationResult {
+        Match,
+        Mismatch,
+        InvalidKey
+    };
+
+    SignatureResult verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
+                                        const HifiSockAddr& senderSockAddr, const QSharedPointer<ReceivedMessage>& message);
+    void handleSignatureVerified(const QByteArray& verificationKey, VerificationResult result, quint64 verifyUsecs);
+    static VerificationResult verifySignatureWithKey(const QByteArray& publicKeyArray, const QByteArray& usernameWithToken,
+                                                     const QByteArray& usernameSignature);
     bool isWithinMaxCapacity();
     
     bool shouldAllowConnectionFromNode(const QString& username, const QByteArray& usernameSignature,
@@ -113,10 +135,34 @@ private:
     // we don't send back user signature decryption errors for those keys so that there isn't a thrasing of key re-generation
     // and connection refusal
 
-    using KeyFlagPair = QPair<QByteArray, bool>;
+    struct UserPublicKey {
+        QByteArray key;
+        bool isOptimistic;
+        quint64 fetchedAt; // keys are fetched again once they are older than USER_PUBLIC_KEY_TTL_USECS
+    };
 
-    QHash<QString, KeyFlagPair> _userPublicKeys; // keep track of keys and flag them as optimistic or not
+    QHash<QString, UserPublicKey> _userPublicKeys; // keep track of keys and flag them as optimistic or not
     QHash<QString, bool> _inFlightPublicKeyRequests; // keep track of keys we've asked for (and if it was optimistic)
+    QHash<QString, quint64> _publicKeyRequestTimes;
+
+    // connect requests waiting on their username signature to be verified, and the results to process them again with,
+    // by the username, connection token and signature
+    QHash<QByteArray, QSharedPointer<ReceivedMessage>> _pendingSignatureVerifications;
+    QHash<QByteArray, VerificationResult> _signatureVerificationResults;
+
+    class StageTimes {
+    public:
+        void record(quint64 usecs);
+        QJsonObject toJson() const;
+
+    private:
+        quint64 _count { 0 };
+        quint64 _totalUsecs { 0 };
+        quint64 _maxUsecs { 0 };
+    };
+    StageTimes _publicKeyFetchTimes;
+    StageTimes _signatureVerifyTimes;
+    StageTimes _permissionResolutionTimes;
     QSet<QString> _domainOwnerFriends; // keep track of friends of the domain owner
     QSet<QString> _inFlightGroupMembershipsRequests; // keep track of which we've already asked for
 
@@ -136,6 +182,9 @@ private:
 
     Node::LocalID _currentLocalID;
     Node::LocalID _idIncrement;
+
+    // last, so that it is done with the verifications before anything they use goes away
+    QThreadPool _signatureVerificationPool;
 };
 
 
@@ -178,6 +178,8 @@ DomainServer::DomainServer(int argc, char* argv[]) :
 
     LogHandler::getInstance().moveToThread(thread());
     LogHandler::getInstance().setupRepeatedMessageFlusher();
+    LogHandler::getInstance().setCategoryRateLimit(DEFAULT_CATEGORY_RATE_LIMIT);
+    LogHandler::getInstance().startAsyncWriter();
 
     qDebug() << "Setting up domain-server";
     qDebug() << "[VERSION] Build sequence:" << qPrintable(applicationVersion());
@@ -431,6 +433,9 @@ DomainServer::~DomainServer() {
     _assetClientThread.quit();
     _assetClientThread.wait();
 
+    _nodeStatsThread.quit();
+    _nodeStatsThread.wait();
+
     // destroy the LimitedNodeList before the DomainServer QCoreApplication is down
     DependencyManager::destroy<LimitedNodeList>();
 }
@@ -765,7 +770,7 @@ void DomainServer::setupNodeListAndAssignments() {
     packetReceiver.registerListener(PacketType::RequestAssignment, this, "processRequestAssignmentPacket");
     packetReceiver.registerListener(PacketType::DomainListRequest, this, "processListRequestPacket");
     packetReceiver.registerListener(PacketType::DomainServerPathQuery, this, "processPathQueryPacket");
-    packetReceiver.registerListener(PacketType::NodeJsonStats, this, "processNodeJSONStatsPacket");
+    packetReceiver.registerListener(PacketType::NodeJsonStats, &_nodeStats, "processNodeJSONStatsPacket");
     packetReceiver.registerListener(PacketType::DomainDisconnectRequest, this, "processNodeDisconnectRequestPacket");
 
     // NodeList won't be available to the settings manager when it is created, so call registerListener here
@@ -795,6 +800,12 @@ void DomainServer::setupNodeListAndAssignments() {
     auto assetClient = DependencyManager::set<AssetClient>();
     assetClient->moveToThread(&_assetClientThread);
     _assetClientThread.start();
+
+    // node stats are taken in on their own thread, they're only ever read from here
+    _nodeStatsThread.setObjectName("Node Stats Thread");
+    _nodeStats.moveToThread(&_nodeStatsThread);
+    _nodeStatsThread.start();
+
     // add whatever static assignments that have been parsed to the queue
     addStaticAssignmentsToQueue();
 }
@@ -1075,6 +1086,9 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
     sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
 
+    // and make the change, if there is one, part of the next version of the domain list
+    updateDomainListEntry(sendingNode);
+
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
 
     if (!nodeData->hasCheckedIn()) {
@@ -1091,6 +1105,10 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     }
 
     // update the NodeInterestSet in case there have been any changes
+    if (safeInterestSet != nodeData->getNodeInterestSet()) {
+        // the nodes of the new types haven't necessarily changed since the version this node has
+        nodeData->setDomainListBaseVersion(++_domainListVersion);
+    }
     nodeData->setNodeInterestSet(safeInterestSet);
 
     // update the connecting hostname in case it has changed
@@ -1099,7 +1117,23 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
-    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
+    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false,
+                         nodeRequestData.domainListVersion);
+}
+
+void DomainServer::updateDomainListEntry(const SharedNodePointer& node) {
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    if (!nodeData) {
+        return;
+    }
+
+    QByteArray entry;
+    QDataStream entryStream(&entry, QIODevice::WriteOnly);
+    entryStream << *node.data();
+
+    if (entry != nodeData->getDomainListEntry()) {
+        nodeData->setDomainListEntry(entry, ++_domainListVersion);
+    }
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1177,20 +1211,67 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
         newNode->setIsReplicated(true);
     }
 
+    updateDomainListEntry(newNode);
+
     // send out this node to our other connected nodes
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr, bool newConnection) {
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr,
+                                        bool newConnection, quint32 knownDomainListVersion) {
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
         NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
 
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    // the node is only sent what changed since the version it already has, unless something it needs to hear about
+    // from before then has been forgotten
+    bool isDelta = !newConnection && knownDomainListVersion > 0
+        && knownDomainListVersion >= _oldestDomainListDeltaVersion
+        && knownDomainListVersion >= nodeData->getDomainListBaseVersion()
+        && knownDomainListVersion <= _domainListVersion;
+    quint32 baseVersion = isDelta ? knownDomainListVersion : 0;
+
+    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
+    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+
+    std::vector<SharedNodePointer> changedNodes;
+    std::vector<QUuid> removedNodes;
+    QSet<QUuid> recordUUIDs;
+
+    // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+    if (nodeInterestSet.size() > 0 && nodeData->isAuthenticated()) {
+        // if this authenticated node has any interest types, send back those nodes as well
+        limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
+            if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+                if (!isDelta || !otherNodeData || otherNodeData->getDomainListEntryVersion() > baseVersion) {
+                    changedNodes.push_back(otherNode);
+                    recordUUIDs.insert(otherNode->getUUID());
+                }
+            }
+        });
+
+        if (isDelta) {
+            // the removals are kept in version order, newest last
+            for (auto it = _removedDomainListNodes.rbegin(); it != _removedDomainListNodes.rend() && it->version > baseVersion; ++it) {
+                // a node that came back since it was removed is sent as it is now
+                if (nodeInterestSet.contains(it->type) && it->uuid != node->getUUID() && !recordUUIDs.contains(it->uuid)) {
+                    removedNodes.push_back(it->uuid);
+                    recordUUIDs.insert(it->uuid);
+                }
+            }
+        }
+    }
+
+    // a node that can't be sent other nodes isn't given a version, so that it is sent all of them once it can be
+    quint32 listVersion = nodeData->isAuthenticated() ? _domainListVersion : 0;
+
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
     QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
-    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << limitedNodeList->getSessionLocalID();
@@ -1202,35 +1283,32 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
     extendedHeaderStream << newConnection;
+    extendedHeaderStream << listVersion;
+    extendedHeaderStream << baseVersion;
+    extendedHeaderStream << (quint32)recordUUIDs.size();
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
-
-    if (nodeInterestSet.size() > 0) {
+    for (const auto& removedNodeUUID : removedNodes) {
+        domainListPackets->startSegment();
+        domainListStream << DomainListRecordType::RemovedNode << removedNodeUUID;
+        domainListPackets->endSegment();
+    }
 
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+    for (const auto& otherNode : changedNodes) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+        // don't send avatar nodes to other avatars, that will come from avatar mixer
+        domainListStream << DomainListRecordType::Node << *otherNode.data();
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // pack the secret that these two nodes will use to communicate with each other
+        domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
-        }
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
     }
 
     // send an empty list to the node, in case there were no other nodes
@@ -1857,13 +1935,6 @@ void DomainServer::processOctreeDataRequestMessage(QSharedPointer<ReceivedMessag
     nodeList->sendPacketList(std::move(reply), message->getSenderSockAddr());
 }
 
-void DomainServer::processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode) {
-    auto nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
-    if (nodeData) {
-        nodeData->updateJSONStats(packetList->getMessage());
-    }
-}
-
 QJsonObject DomainServer::jsonForSocket(const HifiSockAddr& socket) {
     QJsonObject socketJSON;
 
@@ -2129,6 +2200,12 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             connection->respond(HTTPConnection::StatusCode200, assignmentDocument.toJson(), qPrintable(JSON_MIME_TYPE));
 
             // we've processed this request
+            return true;
+        } else if (url.path() == "/gatekeeper.json") {
+            // how long letting users in has been taking
+            QJsonDocument statsDocument(_gatekeeper.getConnectionStats());
+            connection->respond(HTTPConnection::StatusCode200, statsDocument.toJson(), qPrintable(JSON_MIME_TYPE));
+
             return true;
         } else if (url.path() == "/transactions.json") {
             // enumerate our pending transactions and display them in an array
@@ -2149,23 +2226,28 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
 
             return true;
         } else if (url.path() == QString("%1.json").arg(URI_NODES)) {
-            // setup the JSON
-            QJsonObject rootJSON;
-            QJsonArray nodesJSONArray;
+            const quint64 NODES_JSON_MAX_AGE_USECS = USECS_PER_SECOND;
+            auto now = usecTimestampNow();
+            if (_nodesJSON.isEmpty() || now - _nodesJSONTimestamp > NODES_JSON_MAX_AGE_USECS) {
+                // setup the JSON
+                QJsonObject rootJSON;
+                QJsonArray nodesJSONArray;
 
-            // enumerate the NodeList to find the assigned nodes
-            nodeList->eachNode([this, &nodesJSONArray](const SharedNodePointer& node){
-                // add the node using the UUID as the key
-                nodesJSONArray.append(jsonObjectForNode(node));
-            });
+                // enumerate the NodeList to find the assigned nodes
+                nodeList->eachNode([this, &nodesJSONArray](const SharedNodePointer& node){
+                    // add the node using the UUID as the key
+                    nodesJSONArray.append(jsonObjectForNode(node));
+                });
 
-            rootJSON["nodes"] = nodesJSONArray;
+                rootJSON["nodes"] = nodesJSONArray;
 
-            // print out the created JSON
-            QJsonDocument nodesDocument(rootJSON);
+                // print out the created JSON
+                _nodesJSON = QJsonDocument(rootJSON).toJson();
+                _nodesJSONTimestamp = now;
+            }
 
             // send the response
-            connection->respond(HTTPConnection::StatusCode200, nodesDocument.toJson(), qPrintable(JSON_MIME_TYPE));
+            connection->respond(HTTPConnection::StatusCode200, _nodesJSON, qPrintable(JSON_MIME_TYPE));
 
             return true;
         } else if (url.path() == URI_API_BACKUPS) {
@@ -2248,17 +2330,16 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
                 // see if we have a node that matches this ID
                 SharedNodePointer matchingNode = nodeList->nodeWithUUID(matchingUUID);
                 if (matchingNode) {
-                    // create a QJsonDocument with the stats QJsonObject
-                    QJsonObject statsObject =
-                        static_cast<DomainServerNodeData*>(matchingNode->getLinkedData())->getStatsJSONObject();
-
-                    // add the node type to the JSON data for output purposes
-                    statsObject["node_type"] = NodeType::getNodeTypeName(matchingNode->getType()).toLower().replace(' ', '-');
-
-                    QJsonDocument statsDocument(statsObject);
+                    auto statsJSON = _nodeStats.getStatsJSON(matchingUUID);
+                    if (statsJSON.isEmpty()) {
+                        // no stats from this node yet, there is still its type
+                        QJsonObject statsObject;
+                        statsObject["node_type"] = NodeType::getNodeTypeName(matchingNode->getType()).toLower().replace(' ', '-');
+                        statsJSON = QJsonDocument(statsObject).toJson();
+                    }
 
                     // send the response
-                    connection->respond(HTTPConnection::StatusCode200, statsDocument.toJson(), qPrintable(JSON_MIME_TYPE));
+                    connection->respond(HTTPConnection::StatusCode200, statsJSON, qPrintable(JSON_MIME_TYPE));
 
                     // tell the caller we processed the request
                     return true;
@@ -3092,8 +3173,14 @@ bool DomainServer::isAssetServerEnabled() {
 void DomainServer::nodeAdded(SharedNodePointer node) {
     // we don't use updateNodeWithData, so add the DomainServerNodeData to the node here
     node->setLinkedData(std::unique_ptr<DomainServerNodeData> { new DomainServerNodeData() });
+
+    _nodesJSON.clear();
 }
 
+// how many removed nodes are remembered for the domain lists, a node with a version from before the oldest of them is
+// sent all of the list
+static const size_t MAX_REMOVED_DOMAIN_LIST_NODES = 1024;
+
 void DomainServer::nodeKilled(SharedNodePointer node) {
     // if this peer connected via ICE then remove them from our ICE peers hash
     _gatekeeper.cleanupICEPeerForNode(node->getUUID());
@@ -3130,6 +3217,16 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
         }
     }
 
+    // nodes that had this one in their version of the domain list hear that it is gone with their next one
+    _removedDomainListNodes.push_back({ ++_domainListVersion, node->getUUID(), node->getType() });
+    while (_removedDomainListNodes.size() > MAX_REMOVED_DOMAIN_LIST_NODES) {
+        _oldestDomainListDeltaVersion = _removedDomainListNodes.front().version;
+        _removedDomainListNodes.pop_front();
+    }
+
+    _nodeStats.removeNode(node->getUUID());
+    _nodesJSON.clear();
+
     broadcastNodeDisconnect(node);
 }
 
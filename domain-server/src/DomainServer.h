@@ -12,6 +12,8 @@
 #ifndef hifi_DomainServer_h
 #define hifi_DomainServer_h
 
+#include <deque>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QHash>
 #include <QtCore/QJsonObject>
@@ -30,6 +32,7 @@
 #include "AssetsBackupHandler.h"
 #include "DomainGatekeeper.h"
 #include "DomainMetadata.h"
+#include "DomainServerNodeStats.h"
 #include "DomainServerSettingsManager.h"
 #include "DomainServerWebSessionData.h"
 #include "WalletTransaction.h"
@@ -91,7 +94,6 @@ public slots:
 private slots:
     void processRequestAssignmentPacket(QSharedPointer<ReceivedMessage> packet);
     void processListRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
-    void processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode);
     void processPathQueryPacket(QSharedPointer<ReceivedMessage> packet);
     void processNodeDisconnectRequestPacket(QSharedPointer<ReceivedMessage> message);
     void processICEServerHeartbeatDenialPacket(QSharedPointer<ReceivedMessage> message);
@@ -175,7 +177,9 @@ private:
     void handleKillNode(SharedNodePointer nodeToKill);
     void broadcastNodeDisconnect(const SharedNodePointer& disconnnectedNode);
 
-    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr, bool newConnection);
+    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr,
+                              bool newConnection, quint32 knownDomainListVersion = 0);
+    void updateDomainListEntry(const SharedNodePointer& node);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -229,6 +233,17 @@ private:
 
     DomainGatekeeper _gatekeeper;
 
+    // every change to a node, as it is sent in the domain lists, gets the next version of the list, so that a node
+    // checking in with the version it has can be sent only the nodes changed or removed since
+    struct RemovedDomainListNode {
+        quint32 version;
+        QUuid uuid;
+        NodeType_t type;
+    };
+    quint32 _domainListVersion { 0 };
+    std::deque<RemovedDomainListNode> _removedDomainListNodes;
+    quint32 _oldestDomainListDeltaVersion { 0 }; // nodes removed before this have been forgotten
+
     HTTPManager _httpManager;
     std::unique_ptr<HTTPSManager> _httpsManager;
 
@@ -294,6 +309,13 @@ private:
     std::unordered_map<int, std::unique_ptr<QTemporaryFile>> _pendingContentFiles;
 
     QThread _assetClientThread;
+
+    DomainServerNodeStats _nodeStats;
+    QThread _nodeStatsThread;
+
+    // the nodes JSON as last served, it is only made again once it is older than a second or the nodes have changed
+    QByteArray _nodesJSON;
+    quint64 _nodesJSONTimestamp { 0 };
 };
 
 
@@ -20,15 +20,15 @@
 #include <udt/PacketHeaders.h>
 
 DomainServerNodeData::StringPairHash DomainServerNodeData::_overrideHash;
+QReadWriteLock DomainServerNodeData::_overrideLock;
 
 DomainServerNodeData::DomainServerNodeData() {
     _paymentIntervalTimer.start();
 }
 
-void DomainServerNodeData::updateJSONStats(QByteArray statsByteArray) {
-    auto document = QJsonDocument::fromBinaryData(statsByteArray);
-    Q_ASSERT(document.isObject());
-    _statsJSONObject = overrideValuesIfNeeded(document.object());
+QJsonObject DomainServerNodeData::applyStatsOverrides(const QJsonObject& stats) {
+    QReadLocker locker(&_overrideLock);
+    return overrideValuesIfNeeded(stats);
 }
 
 QJsonObject DomainServerNodeData::overrideValuesIfNeeded(const QJsonObject& newStats) {
@@ -69,10 +69,12 @@ QJsonArray DomainServerNodeData::overrideValuesIfNeeded(const QJsonArray& newSta
 void DomainServerNodeData::addOverrideForKey(const QString& key, const QString& value,
                                              const QString& overrideValue) {
     // Insert override value
+    QWriteLocker locker(&_overrideLock);
     _overrideHash.insert({key, value}, overrideValue);
 }
 
 void DomainServerNodeData::removeOverrideForKey(const QString& key, const QString& value) {
     // Remove override value
+    QWriteLocker locker(&_overrideLock);
     _overrideHash.remove({key, value});
 }
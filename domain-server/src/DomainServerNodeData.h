@@ -14,6 +14,7 @@
 
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QHash>
+#include <QtCore/QReadWriteLock>
 #include <QtCore/QUuid>
 #include <QtCore/QJsonObject>
 
@@ -26,10 +27,6 @@ class DomainServerNodeData : public NodeData {
 public:
     DomainServerNodeData();
 
-    const QJsonObject& getStatsJSONObject() const { return _statsJSONObject; }
-
-    void updateJSONStats(QByteArray statsByteArray);
-
     void setAssignmentUUID(const QUuid& assignmentUUID) { _assignmentUUID = assignmentUUID; }
     const QUuid& getAssignmentUUID() const { return _assignmentUUID; }
 
@@ -67,6 +64,9 @@ public:
     void addOverrideForKey(const QString& key, const QString& value, const QString& overrideValue);
     void removeOverrideForKey(const QString& key, const QString& value);
 
+    // the stats with the values that have overrides replaced, safe to call from any thread
+    static QJsonObject applyStatsOverrides(const QJsonObject& stats);
+
     const QString& getPlaceName() { return _placeName; }
     void setPlaceName(const QString& placeName) { _placeName = placeName; }
 
@@ -75,10 +75,19 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
+
+    // this node as it was last put in a domain list, and the version of the domain list it last changed in
+    const QByteArray& getDomainListEntry() const { return _domainListEntry; }
+    quint32 getDomainListEntryVersion() const { return _domainListEntryVersion; }
+    void setDomainListEntry(const QByteArray& entry, quint32 version) { _domainListEntry = entry; _domainListEntryVersion = version; }
+
+    // a domain list from before this version can't be brought up to date for this node, it has to be sent all of it
+    quint32 getDomainListBaseVersion() const { return _domainListBaseVersion; }
+    void setDomainListBaseVersion(quint32 version) { _domainListBaseVersion = version; }
     
 private:
-    QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
-    QJsonArray overrideValuesIfNeeded(const QJsonArray& newStats);
+    static QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
+    static QJsonArray overrideValuesIfNeeded(const QJsonArray& newStats);
     
     QHash<QUuid, QUuid> _sessionSecretHash;
     QUuid _assignmentUUID;
@@ -87,8 +96,8 @@ private:
     QElapsedTimer _paymentIntervalTimer;
     
     using StringPairHash = QHash<QPair<QString, QString>, QString>;
-    QJsonObject _statsJSONObject;
     static StringPairHash _overrideHash;
+    static QReadWriteLock _overrideLock;
     
     HifiSockAddr _sendingSockAddr;
     bool _isAuthenticated = true;
@@ -102,6 +111,10 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+
+    QByteArray _domainListEntry;
+    quint32 _domainListEntryVersion { 0 };
+    quint32 _domainListBaseVersion { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -0,0 +1,63 @@
+//
+//  DomainServerNodeStats.cpp
+//  domain-server/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainServerNodeStats.h"
+
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <LimitedNodeList.h>
+
+#include "DomainServerNodeData.h"
+
+void DomainServerNodeStats::processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode) {
+    auto document = QJsonDocument::fromBinaryData(packetList->getMessage());
+    if (!document.isObject()) {
+        return;
+    }
+
+    // the usernames are filled in here rather than when the stats are served, so that it is only done once
+    auto binaryStats = QJsonDocument(DomainServerNodeData::applyStatsOverrides(document.object())).toBinaryData();
+
+    auto nodeUUID = sendingNode->getUUID();
+    {
+        QMutexLocker locker(&_mutex);
+        _nodeStats[nodeUUID] = { sendingNode->getType(), binaryStats, QByteArray() };
+    }
+
+    // the node may have been killed while its stats were on their way here, after it was removed
+    if (!DependencyManager::get<LimitedNodeList>()->nodeWithUUID(nodeUUID)) {
+        removeNode(nodeUUID);
+    }
+}
+
+void DomainServerNodeStats::removeNode(const QUuid& nodeUUID) {
+    QMutexLocker locker(&_mutex);
+    _nodeStats.remove(nodeUUID);
+}
+
+QByteArray DomainServerNodeStats::getStatsJSON(const QUuid& nodeUUID) const {
+    QMutexLocker locker(&_mutex);
+
+    auto it = _nodeStats.find(nodeUUID);
+    if (it == _nodeStats.end()) {
+        return QByteArray();
+    }
+
+    if (it->json.isEmpty()) {
+        auto statsObject = QJsonDocument::fromBinaryData(it->binaryStats).object();
+
+        // add the node type to the JSON data for output purposes
+        statsObject["node_type"] = NodeType::getNodeTypeName(it->type).toLower().replace(' ', '-');
+
+        it->json = QJsonDocument(statsObject).toJson();
+    }
+    return it->json;
+}
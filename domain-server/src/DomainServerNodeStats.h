@@ -0,0 +1,47 @@
+//
+//  DomainServerNodeStats.h
+//  domain-server/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainServerNodeStats_h
+#define hifi_DomainServerNodeStats_h
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QUuid>
+
+#include <Node.h>
+#include <ReceivedMessage.h>
+
+// The stats every node sends the domain server, taken in on a thread of their own so that parsing them doesn't hold up
+// check-ins on the main thread. They're kept in Qt's compact binary JSON form and only turned into the JSON text served
+// for a node when it is asked for, which is then kept until the node sends newer stats.
+class DomainServerNodeStats : public QObject {
+    Q_OBJECT
+public:
+    // the stats of the node as served for it over HTTP, empty if it hasn't sent any
+    QByteArray getStatsJSON(const QUuid& nodeUUID) const;
+
+public slots:
+    void processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode);
+    void removeNode(const QUuid& nodeUUID);
+
+private:
+    struct NodeStats {
+        NodeType_t type;
+        QByteArray binaryStats;
+        QByteArray json; // made from the binary stats the first time it is asked for
+    };
+
+    mutable QMutex _mutex;
+    mutable QHash<QUuid, NodeStats> _nodeStats;
+};
+
+#endif // hifi_DomainServerNodeStats_h
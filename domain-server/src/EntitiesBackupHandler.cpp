@@ -40,12 +40,12 @@ void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip)
 
     if (entitiesFile.open(QIODevice::ReadOnly)) {
         QuaZipFile zipFile { &zip };
-        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath))) {
+        // the entities are gzipped already, so they are stored as they are rather than compressed again
+        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath), nullptr, 0, 0)) {
             qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
             return;
         }
-        auto entityData = entitiesFile.readAll();
-        if (zipFile.write(entityData) != entityData.size()) {
+        if (!copyBackupData(entitiesFile, zipFile)) {
             qCritical() << "Failed to write entities file to backup";
             zipFile.close();
             return;
@@ -54,6 +54,10 @@ NodeConnectionData NodeConnectionData::fromDataStream(QDataStream& dataStream, c
         >> newHeader.publicSockAddr >> newHeader.localSockAddr
         >> newHeader.interestList >> newHeader.placeName;
 
+    if (!isConnectRequest) {
+        dataStream >> newHeader.domainListVersion;
+    }
+
     newHeader.senderSockAddr = senderSockAddr;
     
     if (newHeader.publicSockAddr.getAddress().isNull()) {
@@ -15,6 +15,9 @@
 
 #include <QtCore/QDataStream>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QNetworkRequest>
@@ -29,14 +32,30 @@
 const int CLEAR_INACTIVE_PEERS_INTERVAL_MSECS = 1 * 1000;
 const int PEER_SILENCE_THRESHOLD_MSECS = 5 * 1000;
 
+const quint16 ICE_SERVER_MONITORING_PORT = 40110;
+const int METRICS_INTERVAL_MSECS = 1 * 1000;
+
+namespace {
+    class HeartbeatTask : public QRunnable {
+    public:
+        HeartbeatTask(std::function<void()> task) : _task(task) {}
+
+        void run() override { _task(); }
+
+    private:
+        std::function<void()> _task;
+    };
+}
+
 IceServer::IceServer(int argc, char* argv[]) :
     QCoreApplication(argc, argv),
     _id(QUuid::createUuid()),
     _serverSocket(0, false),
-    _activePeers()
+    _httpManager(QHostAddress::LocalHost, ICE_SERVER_MONITORING_PORT, "", this)
 {
     // start the ice-server socket
     qDebug() << "ice-server socket is listening on" << ICE_SERVER_DEFAULT_PORT;
+    qDebug() << "monitoring http server is listening on" << ICE_SERVER_MONITORING_PORT;
     _serverSocket.bind(QHostAddress::AnyIPv4, ICE_SERVER_DEFAULT_PORT);
 
     // set processPacket as the verified packet callback for the udt::Socket
@@ -46,11 +65,18 @@ IceServer::IceServer(int argc, char* argv[]) :
     using std::placeholders::_1;
     _serverSocket.setPacketFilterOperator(std::bind(&IceServer::packetVersionMatch, this, _1));
 
+    // leave this thread for the socket, the queries and the replies
+    _heartbeatPool.setMaxThreadCount(std::max(QThread::idealThreadCount() - 1, 1));
+
     // setup our timer to clear inactive peers
     QTimer* inactivePeerTimer = new QTimer(this);
     connect(inactivePeerTimer, &QTimer::timeout, this, &IceServer::clearInactivePeers);
     inactivePeerTimer->start(CLEAR_INACTIVE_PEERS_INTERVAL_MSECS);
 
+    QTimer* metricsTimer = new QTimer(this);
+    connect(metricsTimer, &QTimer::timeout, this, &IceServer::updateMetrics);
+    metricsTimer->start(METRICS_INTERVAL_MSECS);
+
     // handle public keys when they arrive from the QNetworkAccessManager
     auto& networkAccessManager = NetworkAccessManager::getInstance();
     connect(&networkAccessManager, &QNetworkAccessManager::finished, this, &IceServer::publicKeyReplyFinished);
@@ -75,20 +101,17 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
     if (nlPacket->getPayloadSize() >= NLPacket::localHeaderSize(PacketType::ICEServerHeartbeat)) {
         
         if (nlPacket->getType() == PacketType::ICEServerHeartbeat) {
-            SharedNetworkPeer peer = addOrUpdateHeartbeatingPeer(*nlPacket);
-            if (peer) {
-                // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
-                peer->activateMatchingOrNewSymmetricSocket(nlPacket->getSenderSockAddr());
-
-                // we have an active and verified heartbeating peer
-                // send them an ACK packet so they know that they are being heard and ready for ICE
-                static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
-                _serverSocket.writePacket(*ackPacket, nlPacket->getSenderSockAddr());
-            } else {
-                // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
-                static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
-                _serverSocket.writePacket(*deniedPacket, nlPacket->getSenderSockAddr());
-            }
+            // the signature check is the expensive part, it happens on the pool and only the reply comes back here
+            std::shared_ptr<NLPacket> heartbeatPacket { std::move(nlPacket) };
+            _heartbeatPool.start(new HeartbeatTask([this, heartbeatPacket] {
+                bool isVerified = !addOrUpdateHeartbeatingPeer(*heartbeatPacket).isNull();
+
+                auto senderSockAddr = heartbeatPacket->getSenderSockAddr();
+                auto receiveTime = heartbeatPacket->getReceiveTime();
+                QMetaObject::invokeMethod(this, [this, isVerified, senderSockAddr, receiveTime] {
+                    sendHeartbeatReply(isVerified, senderSockAddr, receiveTime);
+                }, Qt::QueuedConnection);
+            }));
         } else if (nlPacket->getType() == PacketType::ICEServerQuery) {
             QDataStream heartbeatStream(nlPacket.get());
             
@@ -103,8 +126,12 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
             // check if this node also included a UUID that they would like to connect to
             QUuid connectRequestID;
             heartbeatStream >> connectRequestID;
-            
-            SharedNetworkPeer matchingPeer = _activePeers.value(connectRequestID);
+
+            ++_currentMetrics.numQueries;
+
+            auto& shard = shardForPeer(connectRequestID);
+            QReadLocker peersLocker(&shard.lock);
+            SharedNetworkPeer matchingPeer = shard.activePeers.value(connectRequestID);
             
             if (matchingPeer) {
                 
@@ -119,12 +146,34 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
                 NetworkPeer dummyPeer(senderUUID, publicSocket, localSocket);
                 sendPeerInformationPacket(dummyPeer, matchingPeer->getActiveSocket());
             } else {
+                ++_currentMetrics.numUnmatchedQueries;
                 qDebug() << "Peer" << senderUUID << "asked for" << connectRequestID << "but no matching peer found";
             }
         }
     }
 }
 
+void IceServer::sendHeartbeatReply(bool isVerified, const HifiSockAddr& senderSockAddr,
+                                   p_high_resolution_clock::time_point receiveTime) {
+    if (isVerified) {
+        // we have an active and verified heartbeating peer
+        // send them an ACK packet so they know that they are being heard and ready for ICE
+        static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
+        _serverSocket.writePacket(*ackPacket, senderSockAddr);
+    } else {
+        // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
+        static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
+        _serverSocket.writePacket(*deniedPacket, senderSockAddr);
+        ++_currentMetrics.numDeniedHeartbeats;
+    }
+
+    quint64 latencyUsecs = std::chrono::duration_cast<std::chrono::microseconds>(
+        p_high_resolution_clock::now() - receiveTime).count();
+    ++_currentMetrics.numHeartbeats;
+    _currentMetrics.totalHeartbeatLatencyUsecs += latencyUsecs;
+    _currentMetrics.maxHeartbeatLatencyUsecs = std::max(_currentMetrics.maxHeartbeatLatencyUsecs, latencyUsecs);
+}
+
 SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
 
     // pull the UUID, public and private sock addrs for this peer
@@ -140,13 +189,16 @@ SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
 
     // make sure this is a verified heartbeat before performing any more processing
     if (isVerifiedHeartbeat(senderUUID, signedPlaintext, signature)) {
+        auto& shard = shardForPeer(senderUUID);
+        QWriteLocker peersLocker(&shard.lock);
+
         // make sure we have this sender in our peer hash
-        SharedNetworkPeer matchingPeer = _activePeers.value(senderUUID);
+        SharedNetworkPeer matchingPeer = shard.activePeers.value(senderUUID);
 
         if (!matchingPeer) {
             // if we don't have this sender we need to create them now
             matchingPeer = QSharedPointer<NetworkPeer>::create(senderUUID, publicSocket, localSocket);
-            _activePeers.insert(senderUUID, matchingPeer);
+            shard.activePeers.insert(senderUUID, matchingPeer);
 
             qDebug() << "Added a new network peer" << *matchingPeer;
         } else {
@@ -157,6 +209,9 @@ SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
 
         // update our last heard microstamp for this network peer to now
         matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
+
+        // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
+        matchingPeer->activateMatchingOrNewSymmetricSocket(packet.getSenderSockAddr());
         
         return matchingPeer;
     } else {
@@ -166,47 +221,72 @@ SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
 }
 
 bool IceServer::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature) {
-    // make sure we're not already waiting for a public key for this domain-server
-    if (!_pendingPublicKeyRequests.contains(domainID)) {
+    auto& shard = shardForPeer(domainID);
+
+    // a domain signs the same heartbeat for as long as its sockets don't change
+    QByteArray signedHeartbeat = plaintext + signature;
+
+    bool hasPublicKey = false;
+    RSASharedPtr rsaPublicKey;
+    {
+        QReadLocker peersLocker(&shard.lock);
+        auto verifiedIt = shard.verifiedHeartbeats.constFind(domainID);
+        if (verifiedIt != shard.verifiedHeartbeats.cend() && *verifiedIt == signedHeartbeat) {
+            return true;
+        }
+
         // check if we have a public key for this domain ID - if we do not then fire off the request for it
-        auto it = _domainPublicKeys.find(domainID);
-        if (it != _domainPublicKeys.end()) {
-
-            // attempt to verify the signature for this heartbeat
-            const auto rsaPublicKey = it->second.get();
-
-            if (rsaPublicKey) {
-                auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
-                int verificationResult = RSA_verify(NID_sha256,
-                                                    reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
-                                                    hashedPlaintext.size(),
-                                                    reinterpret_cast<const unsigned char*>(signature.constData()),
-                                                    signature.size(),
-                                                    rsaPublicKey);
-
-                if (verificationResult == 1) {
-                    // this is the only success case - we return true here to indicate that the heartbeat is verified
-                    return true;
-                } else {
-                    qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
-                }
+        auto it = shard.domainPublicKeys.find(domainID);
+        if (it != shard.domainPublicKeys.end()) {
+            hasPublicKey = true;
+            rsaPublicKey = it->second;
+        }
+    }
 
+    if (hasPublicKey) {
+        // attempt to verify the signature for this heartbeat
+        if (rsaPublicKey) {
+            ++_numSignatureChecks;
+
+            auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
+            int verificationResult = RSA_verify(NID_sha256,
+                                                reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
+                                                hashedPlaintext.size(),
+                                                reinterpret_cast<const unsigned char*>(signature.constData()),
+                                                signature.size(),
+                                                rsaPublicKey.get());
+
+            if (verificationResult == 1) {
+                // this is the only success case - we return true here to indicate that the heartbeat is verified
+                QWriteLocker peersLocker(&shard.lock);
+                shard.verifiedHeartbeats[domainID] = signedHeartbeat;
+                return true;
             } else {
-                // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-                qWarning() << "Public key for" << domainID << "is not a usable RSA* public key.";
-                qWarning() << "Re-requesting public key from API";
+                qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
             }
+
+        } else {
+            // we can't let this user in since we couldn't convert their public key to an RSA key we could use
+            qWarning() << "Public key for" << domainID << "is not a usable RSA* public key.";
+            qWarning() << "Re-requesting public key from API";
         }
+    }
 
-        // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
-        // ask the metaverse API for the right public key and return false to indicate that this is not verified
+    // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
+    // ask the metaverse API for the right public key and return false to indicate that this is not verified
+    QMetaObject::invokeMethod(this, [this, domainID] {
         requestDomainPublicKey(domainID);
-    }
+    }, Qt::QueuedConnection);
 
     return false;
 }
 
 void IceServer::requestDomainPublicKey(const QUuid& domainID) {
+    // make sure we're not already waiting for a public key for this domain-server
+    if (_pendingPublicKeyRequests.contains(domainID)) {
+        return;
+    }
+
     // send a request to the metaverse API for the public key for this domain
     auto& networkAccessManager = NetworkAccessManager::getInstance();
 
@@ -255,7 +335,12 @@ void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
                 RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, apiPublicKey.size());
 
                 if (rsaPublicKey) {
-                    _domainPublicKeys[domainID] = { rsaPublicKey, RSA_free };
+                    auto& shard = shardForPeer(domainID);
+                    QWriteLocker peersLocker(&shard.lock);
+                    shard.domainPublicKeys[domainID] = RSASharedPtr { rsaPublicKey, RSA_free };
+
+                    // heartbeats are only trusted again once they are checked against the new key
+                    shard.verifiedHeartbeats.remove(domainID);
                 } else {
                     qWarning() << "Could not convert in-memory public key for" << domainID << "to usable RSA public key.";
                     qWarning() << "Public key will be re-requested on next heartbeat.";
@@ -292,22 +377,69 @@ void IceServer::sendPeerInformationPacket(const NetworkPeer& peer, const HifiSoc
 }
 
 void IceServer::clearInactivePeers() {
-    NetworkPeerHash::iterator peerItem = _activePeers.begin();
+    auto now = usecTimestampNow();
 
-    while (peerItem != _activePeers.end()) {
-        SharedNetworkPeer peer = peerItem.value();
+    // a shard at a time, the heartbeats for the others carry on meanwhile
+    for (auto& shard : _peerShards) {
+        QWriteLocker peersLocker(&shard.lock);
 
-        if ((usecTimestampNow() - peer->getLastHeardMicrostamp()) > (PEER_SILENCE_THRESHOLD_MSECS * 1000)) {
-            qDebug() << "Removing peer from memory for inactivity -" << *peer;
+        NetworkPeerHash::iterator peerItem = shard.activePeers.begin();
 
-            // if we had a public key for this domain, remove it now
-            _domainPublicKeys.erase(peer->getUUID());
+        while (peerItem != shard.activePeers.end()) {
+            SharedNetworkPeer peer = peerItem.value();
 
-            // remove the peer object
-            peerItem = _activePeers.erase(peerItem);
-        } else {
-            // we didn't kill this peer, push the iterator forwards
-            ++peerItem;
+            if ((now - peer->getLastHeardMicrostamp()) > (PEER_SILENCE_THRESHOLD_MSECS * 1000)) {
+                qDebug() << "Removing peer from memory for inactivity -" << *peer;
+
+                // if we had a public key for this domain, remove it now
+                shard.domainPublicKeys.erase(peer->getUUID());
+                shard.verifiedHeartbeats.remove(peer->getUUID());
+
+                // remove the peer object
+                peerItem = shard.activePeers.erase(peerItem);
+            } else {
+                // we didn't kill this peer, push the iterator forwards
+                ++peerItem;
+            }
         }
     }
 }
+
+void IceServer::updateMetrics() {
+    _lastSecondMetrics = _currentMetrics;
+    _lastSecondMetrics.numSignatureChecks = _numSignatureChecks.exchange(0);
+    _currentMetrics = Metrics();
+}
+
+bool IceServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
+    if (url.path() == "/status") {
+        int numPeers = 0;
+        for (const auto& shard : _peerShards) {
+            QReadLocker peersLocker(&shard.lock);
+            numPeers += shard.activePeers.size();
+        }
+
+        const auto& metrics = _lastSecondMetrics;
+
+        QJsonObject lastSecond;
+        lastSecond["heartbeats"] = metrics.numHeartbeats;
+        lastSecond["denied_heartbeats"] = metrics.numDeniedHeartbeats;
+        lastSecond["signature_checks"] = metrics.numSignatureChecks;
+        lastSecond["queries"] = metrics.numQueries;
+        lastSecond["unmatched_queries"] = metrics.numUnmatchedQueries;
+        if (metrics.numHeartbeats > 0) {
+            lastSecond["avg_heartbeat_latency_usecs"] = (qint64)(metrics.totalHeartbeatLatencyUsecs / metrics.numHeartbeats);
+        }
+        lastSecond["max_heartbeat_latency_usecs"] = (qint64)metrics.maxHeartbeatLatencyUsecs;
+
+        QJsonObject status;
+        status["peers"] = numPeers;
+        status["pending_public_key_requests"] = _pendingPublicKeyRequests.size();
+        status["heartbeat_threads"] = _heartbeatPool.maxThreadCount();
+        status["last_second"] = lastSecond;
+
+        connection->respond(HTTPConnection::StatusCode200, QJsonDocument(status).toJson(), "application/json");
+        return true;
+    }
+    return false;
+}
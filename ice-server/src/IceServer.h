@@ -12,8 +12,15 @@
 #ifndef hifi_IceServer_h
 #define hifi_IceServer_h
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
 #include <QtCore/QCoreApplication>
+#include <QtCore/QReadWriteLock>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
 #include <QUdpSocket>
 
 #include <openssl/rsa.h>
@@ -28,34 +35,79 @@
 
 class QNetworkReply;
 
-class IceServer : public QCoreApplication {
+class IceServer : public QCoreApplication, public HTTPRequestHandler {
     Q_OBJECT
 public:
     IceServer(int argc, char* argv[]);
+
+    bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
+
 private slots:
     void clearInactivePeers();
     void publicKeyReplyFinished(QNetworkReply* reply);
+    void updateMetrics();
 private:
+    using NetworkPeerHash = QHash<QUuid, SharedNetworkPeer>;
+
+    using RSASharedPtr = std::shared_ptr<RSA>;
+    using DomainPublicKeyHash = std::unordered_map<QUuid, RSASharedPtr>;
+
+    // the peers are split by ID across shards, each with its own lock,
+    // so that heartbeats verified on different threads rarely wait for each other
+    class PeerShard {
+    public:
+        mutable QReadWriteLock lock;
+        NetworkPeerHash activePeers;
+        DomainPublicKeyHash domainPublicKeys;
+
+        // the last heartbeat verified for each domain, one that repeats it doesn't need its signature checked again
+        QHash<QUuid, QByteArray> verifiedHeartbeats;
+    };
+
+    static const int NUM_PEER_SHARDS = 16;
+
+    class Metrics {
+    public:
+        int numHeartbeats { 0 };
+        int numDeniedHeartbeats { 0 };
+        int numSignatureChecks { 0 };
+        int numQueries { 0 };
+        int numUnmatchedQueries { 0 };
+        quint64 totalHeartbeatLatencyUsecs { 0 };
+        quint64 maxHeartbeatLatencyUsecs { 0 };
+    };
+
+    PeerShard& shardForPeer(const QUuid& peerID) { return _peerShards[qHash(peerID) % NUM_PEER_SHARDS]; }
+
     bool packetVersionMatch(const udt::Packet& packet);
     void processPacket(std::unique_ptr<udt::Packet> packet);
-    
+
+    // called on the heartbeat thread pool
     SharedNetworkPeer addOrUpdateHeartbeatingPeer(NLPacket& incomingPacket);
+    bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
+
+    void sendHeartbeatReply(bool isVerified, const HifiSockAddr& senderSockAddr,
+                            p_high_resolution_clock::time_point receiveTime);
     void sendPeerInformationPacket(const NetworkPeer& peer, const HifiSockAddr* destinationSockAddr);
 
-    bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
     void requestDomainPublicKey(const QUuid& domainID);
 
     QUuid _id;
     udt::Socket _serverSocket;
 
-    using NetworkPeerHash = QHash<QUuid, SharedNetworkPeer>;
-    NetworkPeerHash _activePeers;
+    HTTPManager _httpManager;
 
-    using RSAUniquePtr = std::unique_ptr<RSA, std::function<void(RSA*)>>;
-    using DomainPublicKeyHash = std::unordered_map<QUuid, RSAUniquePtr>;
-    DomainPublicKeyHash _domainPublicKeys;
+    std::array<PeerShard, NUM_PEER_SHARDS> _peerShards;
 
     QSet<QUuid> _pendingPublicKeyRequests;
+
+    // counted since the last second, the one before is what the status page shows
+    Metrics _currentMetrics;
+    Metrics _lastSecondMetrics;
+    std::atomic<int> _numSignatureChecks { 0 };
+
+    // declared last, so that it is done with the heartbeats before the rest of the server goes away
+    QThreadPool _heartbeatPool;
 };
 
 #endif // hifi_IceServer_h
@@ -131,6 +131,10 @@ Item {
                         visible: root.expanded
                         text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatar Joint Rates Full/Reduced/Low: " + root.animationLODAvatarCounts
+                    }
                     StatText {
                         visible: root.expanded
                         text: "Total picks:\n    " +
@@ -333,6 +337,21 @@ Item {
                     StatText {
                         text: "Engine: " + root.engineFrameTime.toFixed(1) + " ms"
                     }
+                    StatText {
+                        text: "Workload: " + root.workloadFrameTime.toFixed(2) + " ms"
+                    }
+                    StatText {
+                        visible: root.expanded
+                        text: "Workload P99: " + root.workloadFrameTimeP99.toFixed(2) +
+                              " ms, Transactions: " + root.workloadTransactionTime.toFixed(2) +
+                              " ms, Classifier: " + root.workloadClassifierTime.toFixed(2) + " ms"
+                    }
+                    StatText {
+                        visible: root.expanded
+                        text: "Workload Regions R1/R2/R3: " + root.workloadRegionCounts +
+                              ", Changes: " + root.workloadRegionChanges +
+                              ", Classified: " + root.workloadClassifiedProxies
+                    }
                     StatText {
                         text: "Batch: " + root.batchFrameTime.toFixed(1) + " ms"
                     }
@@ -80,6 +80,8 @@
 #include <VirtualPadManager.h>
 #include <DebugDraw.h>
 #include <DeferredLightingEffect.h>
+#include <EntityMotionState.h>
+#include <EntityPropertyDelta.h>
 #include <EntityScriptClient.h>
 #include <EntityScriptServerLogClient.h>
 #include <EntityScriptingInterface.h>
@@ -132,6 +134,7 @@
 #include <render/EngineStats.h>
 #include <SecondaryCamera.h>
 #include <ResourceCache.h>
+#include <ResourceMemoryGovernor.h>
 #include <ResourceRequest.h>
 #include <SandboxUtils.h>
 #include <SceneScriptingInterface.h>
@@ -296,6 +299,13 @@ static const uint32_t MAX_CONCURRENT_RESOURCE_DOWNLOADS = 16;
 static const uint32_t MAX_CONCURRENT_RESOURCE_DOWNLOADS = 4;
 #endif
 
+// how many MB the resource caches and GPU memory can hold together before unused resources are evicted, 0 for no limit
+#if !defined(Q_OS_ANDROID)
+static const qint64 DEFAULT_RESOURCE_MEMORY_BUDGET_MB = 0;
+#else
+static const qint64 DEFAULT_RESOURCE_MEMORY_BUDGET_MB = 1024;
+#endif
+
 // For processing on QThreadPool, we target a number of threads after reserving some
 // based on how many are being consumed by the application and the display plugin.  However,
 // we will never drop below the 'min' value
@@ -337,6 +347,8 @@ static const QString DESKTOP_LOCATION = QStandardPaths::writableLocation(QStanda
 Setting::Handle<int> maxOctreePacketsPerSecond{"maxOctreePPS", DEFAULT_MAX_OCTREE_PPS};
 
 Setting::Handle<bool> loginDialogPoppedUp{"loginDialogPoppedUp", false};
+Setting::Handle<bool> multithreadedPhysics{ "multithreadedPhysics", false };
+Setting::Handle<bool> asynchronousPhysics{ "asynchronousPhysics", false };
 
 static const QUrl AVATAR_INPUTS_BAR_QML = PathUtils::qmlUrl("AvatarInputsBar.qml");
 static const QUrl MIC_BAR_APPLICATION_QML = PathUtils::qmlUrl("hifi/audio/MicBarApplication.qml");
@@ -881,6 +893,7 @@ bool setupEssentials(int& argc, char** argv, bool runningMarkerExisted) {
     DependencyManager::set<recording::Recorder>();
     DependencyManager::set<AddressManager>();
     DependencyManager::set<NodeList>(NodeType::Agent, listenPort);
+    DependencyManager::set<ResourceMemoryGovernor>(); // ResourceMemoryGovernor must be set before the resource caches
     DependencyManager::set<recording::ClipCache>();
     DependencyManager::set<GeometryCache>();
     DependencyManager::set<ModelFormatRegistry>(); // ModelFormatRegistry must be defined before ModelCache. See the ModelCache constructor.
@@ -1062,6 +1075,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     _raiseMirror(0.0f),
     _enableProcessOctreeThread(true),
     _lastNackTime(usecTimestampNow()),
+    _lastAckTime(usecTimestampNow()),
     _lastSendDownstreamAudioStats(usecTimestampNow()),
     _notifiedPacketVersionMismatchThisDomain(false),
     _maxOctreePPS(maxOctreePacketsPerSecond.get()),
@@ -1075,6 +1089,8 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
 
     LogHandler::getInstance().moveToThread(thread());
     LogHandler::getInstance().setupRepeatedMessageFlusher();
+    LogHandler::getInstance().setCategoryRateLimit(DEFAULT_CATEGORY_RATE_LIMIT);
+    LogHandler::getInstance().startAsyncWriter();
 
     {
         const QStringList args = arguments();
@@ -1491,6 +1507,17 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     }
     ResourceCache::setRequestLimit(concurrentDownloads);
 
+    QString resourceMemoryBudgetStr = getCmdOption(argc, constArgv, "--resource-memory-budget");
+    qint64 resourceMemoryBudget = resourceMemoryBudgetStr.toLongLong(&success);
+    if (!success) {
+        resourceMemoryBudget = DEFAULT_RESOURCE_MEMORY_BUDGET_MB;
+    }
+    auto resourceMemoryGovernor = DependencyManager::get<ResourceMemoryGovernor>();
+    resourceMemoryGovernor->setGPUMemoryUsageOperator([] {
+        return (qint64)gpu::Context::getTextureGPUMemSize();
+    });
+    resourceMemoryGovernor->setMemoryBudget(resourceMemoryBudget * BYTES_PER_MEGABYTES);
+
     // perhaps override the avatar url.  Since we will test later for validity
     // we don't need to do so here.
     QString avatarURL = getCmdOption(argc, constArgv, "--avatarURL");
@@ -2294,6 +2321,8 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
         bytesDownloaded["total"] = atpBytes + httpBytes + fileBytes;
         properties["bytes_downloaded"] = bytesDownloaded;
 
+        properties["metrics"] = statTracker->toJson();
+
         auto myAvatar = getMyAvatar();
         glm::vec3 avatarPosition = myAvatar->getWorldPosition();
         properties["avatar_has_moved"] = lastAvatarPosition != avatarPosition;
@@ -2874,6 +2903,8 @@ void Application::cleanupBeforeQuit() {
 }
 
 Application::~Application() {
+    _physicsEngine->waitForStepSimulation();
+
     // remove avatars from physics engine
     auto avatarManager = DependencyManager::get<AvatarManager>();
     avatarManager->clearOtherAvatars();
@@ -5267,6 +5298,11 @@ void Application::idle() {
 #endif
     PerformanceWarning warn(showWarnings, "idle()");
 
+    {
+        // the physics step started at the end of the last update runs until here
+        PerformanceTimer perfTimer("waitForPhysics");
+        _physicsEngine->waitForStepSimulation();
+    }
     {
         _gameWorkload.updateViews(_viewFrustum, getMyAvatar()->getHeadPosition());
         _gameWorkload._engine->run();
@@ -5593,11 +5629,20 @@ void Application::init() {
             return 0.0f;
         }
 
+        // the workload region ranks the entities first, then their apparent size within the same region
+        float regionPriority = 0.0f;
+        uint8_t region = getEntities()->getWorkloadSpace()->getRegion(item.getSpaceIndex());
+        if (region <= workload::Region::R3) {
+            regionPriority = (float)(workload::Region::R4 - region) * PI_OVER_TWO;
+        }
+
         auto distance = glm::distance(getMyAvatar()->getWorldPosition(), item.getWorldPosition());
-        return atan2(maxSize, distance);
+        return regionPriority + atan2(maxSize, distance);
     });
 
+    ShapeFactory::setCacheDirectory(PathUtils::getAppLocalDataPath() + "shape_cache/");
     ObjectMotionState::setShapeManager(&_shapeManager);
+    PhysicsEngine::setMultithreaded(multithreadedPhysics.get());
     _physicsEngine->init();
 
     EntityTreePointer tree = getEntities()->getTree();
@@ -5790,7 +5835,7 @@ void Application::unloadAvatarScripts() {
     }
 }
 
-void Application::updateLOD(float deltaTime) const {
+void Application::updateLOD(float deltaTime) {
     PerformanceTimer perfTimer("LOD");
     // adjust it unless we were asked to disable this feature, or if we're currently in throttleRendering mode
     if (!isThrottleRendering()) {
@@ -5801,6 +5846,13 @@ void Application::updateLOD(float deltaTime) const {
         auto lodManager = DependencyManager::get<LODManager>();
         lodManager->setRenderTimes(presentTime, engineRunTime, batchTime, gpuTime);
         lodManager->autoAdjustLOD(deltaTime);
+
+        // the LOD manager adjusts the LOD to the same target, the performance manager steps the rest of the quality
+        float targetFPS = lodManager->getLODTargetFPS();
+        if (targetFPS > 0.0f) {
+            _performanceManager.updateAdaptiveQuality(deltaTime, lodManager->getSmoothRenderTime(),
+                (float)MSECS_PER_SECOND / targetFPS);
+        }
     } else {
         DependencyManager::get<LODManager>()->resetLODAdjust();
     }
@@ -6475,6 +6527,8 @@ void Application::update(float deltaTime) {
         }
 
         if (_physicsEnabled) {
+            EntityMotionState::setAllCollisionEventsWanted(
+                DependencyManager::get<EntityScriptingInterface>()->hasCollisionListeners());
             {
                 PROFILE_RANGE(simulation_physics, "PrepareActions");
                 _entitySimulation->applyDynamicChanges();
@@ -6483,7 +6537,12 @@ void Application::update(float deltaTime) {
                 });
             }
             auto t2 = std::chrono::high_resolution_clock::now();
-            {
+            _isPhysicsAsynchronous = asynchronousPhysics.get();
+            if (_isPhysicsAsynchronous) {
+                // the step starts at the end of the update and runs alongside the rest of the frame,
+                // the changes handled below are those of the step of the last frame
+                _startPhysicsStep = true;
+            } else {
                 PROFILE_RANGE(simulation_physics, "StepPhysics");
                 PerformanceTimer perfTimer("stepPhysics");
                 getEntities()->getTree()->withWriteLock([&] {
@@ -6527,13 +6586,14 @@ void Application::update(float deltaTime) {
                             myAvatar->harvestResultsFromPhysicsSimulation(deltaTime);
                         }
 
-                        if (PerformanceTimer::isActive() &&
-                                Menu::getInstance()->isOptionChecked(MenuOption::DisplayDebugTimingDetails) &&
-                                Menu::getInstance()->isOptionChecked(MenuOption::ExpandPhysicsTiming)) {
-                            _physicsEngine->harvestPerformanceStats();
+                        // the Bullet profile is kept per thread, the asynchronous steps harvest it on the physics thread
+                        if (!_isPhysicsAsynchronous) {
+                            if (shouldHarvestPhysicsStats()) {
+                                _physicsEngine->harvestPerformanceStats();
+                            }
+                            // NOTE: the PhysicsEngine stats are written to stdout NOT to Qt log framework
+                            _physicsEngine->dumpStatsIfNecessary();
                         }
-                        // NOTE: the PhysicsEngine stats are written to stdout NOT to Qt log framework
-                        _physicsEngine->dumpStatsIfNecessary();
                     }
                     auto t4 = std::chrono::high_resolution_clock::now();
 
@@ -6577,6 +6637,12 @@ void Application::update(float deltaTime) {
             qApp->updateMyAvatarLookAtPosition(deltaTime);
             avatarManager->updateMyAvatar(deltaTime);
         }
+
+        {
+            PROFILE_RANGE(simulation, "WorldTransforms");
+            PerformanceTimer perfTimer("worldTransforms");
+            getMyAvatar()->updateWorldTransforms();
+        }
     }
 
     bool showWarnings = Menu::getInstance()->isOptionChecked(MenuOption::PipelineWarnings);
@@ -6648,13 +6714,19 @@ void Application::update(float deltaTime) {
         }
     }
 
-    // sent nack packets containing missing sequence numbers of received packets from nodes
+    // sent nack packets containing missing sequence numbers of received packets from nodes, and more often the
+    // sequence number we have received everything up to, which the entity server sends property deltas against
     {
         quint64 sinceLastNack = now - _lastNackTime;
         const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
-        if (sinceLastNack > TOO_LONG_SINCE_LAST_NACK) {
-            _lastNackTime = now;
-            sendNackPackets();
+        const quint64 TOO_LONG_SINCE_LAST_ACK = 100 * USECS_PER_MSEC;
+        bool shouldNack = sinceLastNack > TOO_LONG_SINCE_LAST_NACK;
+        if (shouldNack || now - _lastAckTime > TOO_LONG_SINCE_LAST_ACK) {
+            if (shouldNack) {
+                _lastNackTime = now;
+            }
+            _lastAckTime = now;
+            sendNackPackets(shouldNack);
         }
     }
 
@@ -6707,6 +6779,30 @@ void Application::update(float deltaTime) {
         PerformanceTimer perfTimer("squeezeVision");
         _visionSqueeze.updateVisionSqueeze(myAvatar->getSensorToWorldMatrix(), deltaTime);
     }
+
+    if (_startPhysicsStep) {
+        _startPhysicsStep = false;
+        auto tree = getEntities()->getTree();
+        // the engine owns the physics thread, it outlives the step
+        PhysicsEngine* physicsEngine = _physicsEngine.get();
+        bool harvestStats = shouldHarvestPhysicsStats();
+        physicsEngine->startStepSimulation([tree, physicsEngine, harvestStats] {
+            PROFILE_RANGE(simulation_physics, "StepPhysics");
+            tree->withWriteLock([&] {
+                physicsEngine->stepSimulation();
+            });
+            if (harvestStats) {
+                physicsEngine->harvestPerformanceStats();
+            }
+            physicsEngine->dumpStatsIfNecessary();
+        });
+    }
+}
+
+bool Application::shouldHarvestPhysicsStats() const {
+    return PerformanceTimer::isActive() &&
+        Menu::getInstance()->isOptionChecked(MenuOption::DisplayDebugTimingDetails) &&
+        Menu::getInstance()->isOptionChecked(MenuOption::ExpandPhysicsTiming);
 }
 
 void Application::updateRenderArgs(float deltaTime) {
@@ -6860,19 +6956,18 @@ void Application::queryAvatars() {
 }
 
 
-int Application::sendNackPackets() {
+int Application::sendNackPackets(bool includeMissing) {
 
     // iterates through all nodes in NodeList
     auto nodeList = DependencyManager::get<NodeList>();
 
     int packetsSent = 0;
+    bool resetAck = EntityPropertyDelta::takeFailedDecodes();
 
     nodeList->eachNode([&](const SharedNodePointer& node){
 
         if (node->getActiveSocket() && node->getType() == NodeType::EntityServer) {
 
-            auto nackPacketList = NLPacketList::create(PacketType::OctreeDataNack);
-
             QUuid nodeUUID = node->getUUID();
 
             // if there are octree packets from this node that are waiting to be processed,
@@ -6882,6 +6977,8 @@ int Application::sendNackPackets() {
             }
 
             QSet<OCTREE_PACKET_SEQUENCE> missingSequenceNumbers;
+            bool hasReceived = false;
+            OCTREE_PACKET_SEQUENCE lastReceivedSequenceNumber = 0;
             _octreeServerSceneStats.withReadLock([&] {
                 // retrieve octree scene stats of this node
                 if (_octreeServerSceneStats.find(nodeUUID) == _octreeServerSceneStats.end()) {
@@ -6891,13 +6988,38 @@ int Application::sendNackPackets() {
                 SequenceNumberStats& sequenceNumberStats = _octreeServerSceneStats[nodeUUID].getIncomingOctreeSequenceNumberStats();
                 sequenceNumberStats.pruneMissingSet();
                 missingSequenceNumbers = sequenceNumberStats.getMissingSet();
+                hasReceived = sequenceNumberStats.getReceived() > 0;
+                lastReceivedSequenceNumber = sequenceNumberStats.getLastReceivedSequence();
             });
 
             _isMissingSequenceNumbers = (missingSequenceNumbers.size() != 0);
 
+            // we have only received everything up to the last packet once nothing is missing
+            OCTREE_NACK_FLAGS ackFlags = resetAck ? OCTREE_NACK_RESET_ACK : 0;
+            bool ackChanged = false;
+            if (hasReceived && !_isMissingSequenceNumbers) {
+                ackFlags |= OCTREE_NACK_HAS_ACK;
+                auto lastSentAck = _lastSentOctreeAcks.find(nodeUUID);
+                ackChanged = lastSentAck == _lastSentOctreeAcks.end() || lastSentAck.value() != lastReceivedSequenceNumber;
+            }
+            if (!resetAck && !ackChanged && !(includeMissing && _isMissingSequenceNumbers)) {
+                return;
+            }
+            if (ackFlags & OCTREE_NACK_HAS_ACK) {
+                _lastSentOctreeAcks[nodeUUID] = lastReceivedSequenceNumber;
+            }
+
+            // every packet starts with the acknowledgement
+            QByteArray ackHeader;
+            ackHeader.append(reinterpret_cast<const char*>(&ackFlags), sizeof(ackFlags));
+            ackHeader.append(reinterpret_cast<const char*>(&lastReceivedSequenceNumber), sizeof(lastReceivedSequenceNumber));
+
             // construct nack packet(s) for this node
-            foreach(const OCTREE_PACKET_SEQUENCE& missingNumber, missingSequenceNumbers) {
-                nackPacketList->writePrimitive(missingNumber);
+            auto nackPacketList = NLPacketList::create(PacketType::OctreeDataNack, ackHeader);
+            if (includeMissing) {
+                foreach(const OCTREE_PACKET_SEQUENCE& missingNumber, missingSequenceNumbers) {
+                    nackPacketList->writePrimitive(missingNumber);
+                }
             }
 
             if (nackPacketList->getNumPackets()) {
@@ -6905,6 +7027,11 @@ int Application::sendNackPackets() {
 
                 // send the packet list
                 nodeList->sendPacketList(std::move(nackPacketList), *node);
+            } else {
+                auto ackPacket = NLPacket::create(PacketType::OctreeDataNack, ackHeader.size());
+                ackPacket->write(ackHeader);
+                packetsSent++;
+                nodeList->sendPacket(std::move(ackPacket), *node);
             }
         }
     });
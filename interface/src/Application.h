@@ -555,14 +555,15 @@ private:
     void update(float deltaTime);
 
     // Various helper functions called during update()
-    void updateLOD(float deltaTime) const;
+    void updateLOD(float deltaTime);
+    bool shouldHarvestPhysicsStats() const;
     void updateThreads(float deltaTime);
     void updateDialogs(float deltaTime) const;
 
     void queryOctree(NodeType_t serverType, PacketType packetType);
     void queryAvatars();
 
-    int sendNackPackets();
+    int sendNackPackets(bool includeMissing);
 
     std::shared_ptr<MyAvatar> getMyAvatar() const;
 
@@ -700,6 +701,8 @@ private:
     TouchEvent _lastTouchEvent;
 
     quint64 _lastNackTime;
+    quint64 _lastAckTime;
+    QHash<QUuid, OCTREE_PACKET_SEQUENCE> _lastSentOctreeAcks;
     quint64 _lastSendDownstreamAudioStats;
 
     bool _notifiedPacketVersionMismatchThisDomain;
@@ -746,6 +749,8 @@ private:
     bool _isForeground = true; // starts out assumed to be in foreground
     bool _isGLInitialized { false };
     bool _physicsEnabled { false };
+    bool _isPhysicsAsynchronous { false };
+    bool _startPhysicsStep { false };
     bool _failedToConnectToEntityServer { false };
 
     bool _reticleClickPressed { false };
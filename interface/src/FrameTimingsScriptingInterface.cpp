@@ -8,7 +8,10 @@
 
 #include "FrameTimingsScriptingInterface.h"
 
+#include <functional>
+
 #include <TextureCache.h>
+#include <render/Engine.h>
 
 void FrameTimingsScriptingInterface::start() {
     _values.clear();
@@ -51,3 +54,32 @@ QVariantList FrameTimingsScriptingInterface::getValues() const {
     }
     return result;
 }
+
+QVariantMap FrameTimingsScriptingInterface::getJobTimings() const {
+    QVariantMap result;
+    auto renderConfig = _renderConfig.lock();
+    if (!renderConfig) {
+        return result;
+    }
+
+    std::function<void(const task::JobConfig&, const QString&)> addTimings;
+    addTimings = [&](const task::JobConfig& config, const QString& path) {
+        QVariantMap timings;
+        timings["cpu"] = config.getCPURunTime();
+        timings["cpuP95"] = config.getCPURunTimeP95();
+        timings["cpuP99"] = config.getCPURunTimeP99();
+        auto gpuConfig = dynamic_cast<const render::GPUJobConfig*>(&config);
+        if (gpuConfig) {
+            timings["gpu"] = gpuConfig->getGPURunTime();
+            timings["gpuP95"] = gpuConfig->getGPURunTimeP95();
+            timings["gpuP99"] = gpuConfig->getGPURunTimeP99();
+        }
+        result[path] = timings;
+
+        for (auto child : config.findChildren<task::JobConfig*>(QString(), Qt::FindDirectChildrenOnly)) {
+            addTimings(*child, path + "." + child->objectName());
+        }
+    };
+    addTimings(*renderConfig, renderConfig->objectName());
+    return result;
+}
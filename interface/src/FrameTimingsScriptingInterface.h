@@ -8,7 +8,13 @@
 
 #pragma once
 #include <stdint.h>
+#include <memory>
 #include <QtCore/QObject>
+#include <QtCore/QVariantMap>
+
+namespace task {
+    class JobConfig;
+}
 
 class FrameTimingsScriptingInterface : public QObject {
     Q_OBJECT
@@ -22,6 +28,12 @@ public:
     Q_INVOKABLE void finish();
     Q_INVOKABLE QVariantList getValues() const;
 
+    // The run times, in msecs, of every job of the render engine by their config path ("RenderMainView.RenderDeferredTask...")
+    // with the cpu time of their last run and the 95th and 99th percentiles of their last runs, plus the same for the gpu
+    // for the jobs that time it
+    Q_INVOKABLE QVariantMap getJobTimings() const;
+
+    void setRenderConfig(const std::shared_ptr<task::JobConfig>& config) { _renderConfig = config; }
 
     uint64_t getMax() const { return _max; }
     uint64_t getMin() const { return _min; }
@@ -35,4 +47,5 @@ protected:
     uint64_t _min { 0 };
     float _stdDev { 0 };
     float _mean { 0 };
+    std::weak_ptr<task::JobConfig> _renderConfig;
 };
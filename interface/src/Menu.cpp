@@ -483,12 +483,35 @@ Menu::Menu() {
 
     addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::ComputeBlendshapes, 0, true,
         DependencyManager::get<ModelBlender>().data(), SLOT(setComputeBlendshapes(bool)));
+    addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::ComputeBlendshapesOnGPU, 0, true,
+        DependencyManager::get<ModelBlender>().data(), SLOT(setComputeBlendshapesOnGPU(bool)));
 
     action = addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::MaterialProceduralShaders, 0, false);
     connect(action, &QAction::triggered, [action] {
         MeshPartPayload::enableMaterialProceduralShaders = action->isChecked();
     });
 
+    action = addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::IndirectDrawModelParts, 0, false);
+    connect(action, &QAction::triggered, [action] {
+        MeshPartPayload::enableIndirectDraw = action->isChecked();
+    });
+
+    action = addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::InstanceModelParts, 0, false);
+    connect(action, &QAction::triggered, [action] {
+        MeshPartPayload::enableInstancedDraw = action->isChecked();
+    });
+
+    action = addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::MeshLods, 0, MeshPartPayload::enableMeshLods);
+    connect(action, &QAction::triggered, [action] {
+        MeshPartPayload::enableMeshLods = action->isChecked();
+    });
+
+    action = addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::TextureMipRequests, 0,
+        MeshPartPayload::enableTextureMipRequests);
+    connect(action, &QAction::triggered, [action] {
+        MeshPartPayload::enableTextureMipRequests = action->isChecked();
+    });
+
     {
         auto drawStatusConfig = qApp->getRenderEngine()->getConfiguration()->getConfig<render::DrawStatus>("RenderMainView.DrawStatus");
         addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::HighlightTransitions, 0, false,
@@ -228,8 +228,13 @@ namespace MenuOption {
     const QString NotificationSoundsTablet = "play_notification_sounds_tablet";
     const QString ForceCoarsePicking = "Force Coarse Picking";
     const QString ComputeBlendshapes = "Compute Blendshapes";
+    const QString ComputeBlendshapesOnGPU = "Compute Blendshapes on GPU";
     const QString HighlightTransitions = "Highlight Transitions";
     const QString MaterialProceduralShaders = "Enable Procedural Materials";
+    const QString IndirectDrawModelParts = "Indirect Draw Model Parts";
+    const QString InstanceModelParts = "Instance Identical Model Parts";
+    const QString MeshLods = "Mesh LODs";
+    const QString TextureMipRequests = "Stream Texture Mips By Screen Size";
 }
 
 #endif // hifi_Menu_h
@@ -10,13 +10,49 @@
 //
 #include "PerformanceManager.h"
 
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
 #include <platform/Platform.h>
 #include <platform/PlatformKeys.h>
 #include <platform/Profiler.h>
 
 #include "scripting/RenderScriptingInterface.h"
+#include "InterfaceLogging.h"
 #include "LODManager.h"
 
+// The steps of the adaptive quality, from the preset's down. The features are only turned off, and the resolution
+// scales the preset's, so a step never renders better than the preset
+struct AdaptiveQualityStep {
+    bool shadowsEnabled;
+    bool ambientOcclusionEnabled;
+    float resolutionScale;
+};
+static const std::array<AdaptiveQualityStep, 6> ADAPTIVE_QUALITY_STEPS = { {
+    { true, true, 1.0f },
+    { false, true, 1.0f },
+    { false, false, 1.0f },
+    { false, false, 0.85f },
+    { false, false, 0.7f },
+    { false, false, 0.5f }
+} };
+static const int MAX_ADAPTIVE_QUALITY_STEP = (int)ADAPTIVE_QUALITY_STEPS.size() - 1;
+
+// the frames are slow past the target by this ratio, and fast with this much headroom under it
+static const float SLOW_FRAME_RATIO = 1.1f;
+static const float FAST_FRAME_RATIO = 0.7f;
+
+// in seconds, the quality drops soon after the frames slow down, and rises back slowly so that it doesn't oscillate.
+// The temperature changes slowly, so a hot device waits longer for the last step to take effect before the next
+static const float STEP_DOWN_PERIOD = 2.0f;
+static const float HOT_STEP_DOWN_PERIOD = 30.0f;
+static const float STEP_UP_PERIOD = 20.0f;
+static const float TEMPERATURE_CHECK_PERIOD = 5.0f;
+
+// in degrees C, of the hottest thermal zone of the device
+static const float HOT_DEVICE_TEMPERATURE = 75.0f;
+static const float COOL_DEVICE_TEMPERATURE = 65.0f;
+
 PerformanceManager::PerformanceManager()
 {
     setPerformancePreset((PerformancePreset) _performancePresetSetting.get());
@@ -50,6 +86,7 @@ void PerformanceManager::setPerformancePreset(PerformanceManager::PerformancePre
         });
 
         applyPerformancePreset(preset);
+        resetAdaptiveQuality();
     }
 }
 
@@ -123,3 +160,97 @@ void PerformanceManager::applyPerformancePreset(PerformanceManager::PerformanceP
         break;
     }
 }
+
+void PerformanceManager::setAdaptiveQualityEnabled(bool enabled) {
+    if (enabled != isAdaptiveQualityEnabled()) {
+        _adaptiveQualitySetting.set(enabled);
+        if (!enabled) {
+            applyAdaptiveQualityStep(0);
+        }
+        resetAdaptiveQuality();
+    }
+}
+
+void PerformanceManager::resetAdaptiveQuality() {
+    _adaptiveQualityStep = 0;
+    _slowTime = 0.0f;
+    _hotTime = 0.0f;
+    _fastTime = 0.0f;
+}
+
+void PerformanceManager::updateAdaptiveQuality(float deltaTime, float renderTime, float targetFrameTime) {
+    if (!isAdaptiveQualityEnabled() || deltaTime <= 0.0f || renderTime <= 0.0f || targetFrameTime <= 0.0f) {
+        return;
+    }
+
+    _temperatureCheckTime -= deltaTime;
+    if (_temperatureCheckTime <= 0.0f) {
+        _temperatureCheckTime = TEMPERATURE_CHECK_PERIOD;
+        _deviceTemperature = readDeviceTemperature();
+    }
+    bool isHot = _deviceTemperature >= HOT_DEVICE_TEMPERATURE;
+    bool isSlow = renderTime > targetFrameTime * SLOW_FRAME_RATIO;
+    bool isFast = renderTime < targetFrameTime * FAST_FRAME_RATIO && _deviceTemperature < COOL_DEVICE_TEMPERATURE;
+
+    _slowTime = isSlow ? _slowTime + deltaTime : 0.0f;
+    _hotTime = isHot ? _hotTime + deltaTime : 0.0f;
+    _fastTime = isFast ? _fastTime + deltaTime : 0.0f;
+
+    int step = _adaptiveQualityStep;
+    if ((_slowTime >= STEP_DOWN_PERIOD || _hotTime >= HOT_STEP_DOWN_PERIOD) && step < MAX_ADAPTIVE_QUALITY_STEP) {
+        step++;
+    } else if (_fastTime >= STEP_UP_PERIOD && step > 0) {
+        step--;
+    }
+    if (step != _adaptiveQualityStep) {
+        qCDebug(interfaceapp) << "PerformanceManager, adaptive quality step" << _adaptiveQualityStep << "->" << step
+            << "render time" << renderTime << "ms of" << targetFrameTime << "ms, temperature" << _deviceTemperature;
+        applyAdaptiveQualityStep(step);
+        _slowTime = 0.0f;
+        _hotTime = 0.0f;
+        _fastTime = 0.0f;
+    }
+}
+
+void PerformanceManager::applyAdaptiveQualityStep(int step) {
+    if (step == _adaptiveQualityStep) {
+        return;
+    }
+    auto renderInterface = RenderScriptingInterface::getInstance();
+    if (_adaptiveQualityStep == 0) {
+        // whatever the user or the preset set is what the quality comes back to
+        _qualityBaseline.shadowsEnabled = renderInterface->getShadowsEnabled();
+        _qualityBaseline.ambientOcclusionEnabled = renderInterface->getAmbientOcclusionEnabled();
+        _qualityBaseline.resolutionScale = renderInterface->getViewportResolutionScale();
+    }
+
+    const auto& quality = ADAPTIVE_QUALITY_STEPS[step];
+    renderInterface->setShadowsEnabled(_qualityBaseline.shadowsEnabled && quality.shadowsEnabled);
+    renderInterface->setAmbientOcclusionEnabled(_qualityBaseline.ambientOcclusionEnabled && quality.ambientOcclusionEnabled);
+    renderInterface->setViewportResolutionScale(_qualityBaseline.resolutionScale * quality.resolutionScale);
+    _adaptiveQualityStep = step;
+}
+
+// The thermal zones of Android are readable on the Quest, elsewhere the temperature is unknown and the steps only
+// follow the render times
+float PerformanceManager::readDeviceTemperature() const {
+    float temperature = 0.0f;
+#ifdef Q_OS_ANDROID
+    QDir thermalDir("/sys/class/thermal");
+    for (const auto& zone : thermalDir.entryList({ "thermal_zone*" }, QDir::Dirs)) {
+        QFile file(thermalDir.filePath(zone + "/temp"));
+        if (file.open(QIODevice::ReadOnly)) {
+            bool ok = false;
+            float zoneTemperature = file.readAll().trimmed().toFloat(&ok);
+            // most of the zones are in milli-degrees
+            if (ok && zoneTemperature > 1000.0f) {
+                zoneTemperature /= 1000.0f;
+            }
+            if (ok) {
+                temperature = std::max(temperature, zoneTemperature);
+            }
+        }
+    }
+#endif
+    return temperature;
+}
@@ -17,6 +17,12 @@
 #include <SettingHandle.h>
 #include <shared/ReadWriteLockable.h>
 
+#ifdef Q_OS_ANDROID
+const bool DEFAULT_ADAPTIVE_QUALITY = true;
+#else
+const bool DEFAULT_ADAPTIVE_QUALITY = false;
+#endif
+
 class PerformanceManager {
 public:
     enum PerformancePreset {
@@ -38,12 +44,40 @@ public:
     void setPerformancePreset(PerformancePreset performancePreset);
     PerformancePreset getPerformancePreset() const;
 
+    // The adaptive quality steps the render quality down from the preset's when the frames run late or the device
+    // heats up, and back up once they have been fast and cool for a while, so that the frame rate holds over long sessions
+    void setAdaptiveQualityEnabled(bool enabled);
+    bool isAdaptiveQualityEnabled() const { return _adaptiveQualitySetting.get(); }
+    int getAdaptiveQualityStep() const { return _adaptiveQualityStep; }
+
+    // Called every frame, with the smoothed render time and the time of a frame at the target rate, in ms
+    void updateAdaptiveQuality(float deltaTime, float renderTime, float targetFrameTime);
+
 private:
+    struct QualityBaseline {
+        bool shadowsEnabled { false };
+        bool ambientOcclusionEnabled { false };
+        float resolutionScale { 1.0f };
+    };
+
     mutable ReadWriteLockable _performancePresetSettingLock;
     Setting::Handle<int> _performancePresetSetting { "performancePreset", PerformanceManager::PerformancePreset::UNKNOWN };
+    Setting::Handle<bool> _adaptiveQualitySetting { "adaptiveQuality", DEFAULT_ADAPTIVE_QUALITY };
+
+    // The render settings of the preset, that the steps scale down from
+    QualityBaseline _qualityBaseline;
+    int _adaptiveQualityStep { 0 };
+    float _slowTime { 0.0f };
+    float _hotTime { 0.0f };
+    float _fastTime { 0.0f };
+    float _temperatureCheckTime { 0.0f };
+    float _deviceTemperature { 0.0f };
 
     // The concrete performance preset changes
     void applyPerformancePreset(PerformanceManager::PerformancePreset performancePreset);
+    void applyAdaptiveQualityStep(int step);
+    void resetAdaptiveQuality();
+    float readDeviceTemperature() const;
 };
 
 #endif
@@ -14,6 +14,7 @@
 #include <string>
 
 #include <QScriptEngine>
+#include <tbb/parallel_for.h>
 
 #include "AvatarLogging.h"
 
@@ -292,6 +293,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     int numHerosUpdated = 0;
     int numAvatarsUpdated = 0;
     int numAvatarsNotUpdated = 0;
+    int numAvatarsPerAnimationLOD[OtherAvatar::NumAnimationLODs] = { 0, 0, 0 };
 
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
@@ -303,6 +305,16 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
         auto passExpiry = updatePriorityExpiries[p];
 
+        // the rigs of the avatars in view are posed on the worker threads, the rest of their update stays serial
+        {
+            PROFILE_RANGE(simulation, "updateJointPoses");
+            tbb::parallel_for((size_t)0, sortedAvatarVector.size(), [&](size_t i) {
+                const SortableAvatar& sortData = sortedAvatarVector[i];
+                const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+                avatar->updateJointPoses(deltaTime, sortData.getPriority() > OUT_OF_VIEW_THRESHOLD);
+            });
+        }
+
         for (auto it = sortedAvatarVector.begin(); it != sortedAvatarVector.end(); ++it) {
             const SortableAvatar& sortData = *it;
             const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
@@ -341,6 +353,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                     avatar->setIsNewAvatar(false);
                 }
                 avatar->simulate(deltaTime, inView);
+                numAvatarsPerAnimationLOD[avatar->getAnimationLOD()]++;
                 if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
                     _myAvatar->addAvatarHandsToFlow(avatar);
                 }
@@ -395,6 +408,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAvatarsNotUpdated;
     _numHeroAvatarsUpdated = numHerosUpdated;
+    std::copy(numAvatarsPerAnimationLOD, numAvatarsPerAnimationLOD + OtherAvatar::NumAnimationLODs, _numAvatarsPerAnimationLOD);
 
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
 }
@@ -299,6 +299,7 @@ class MyAvatar : public Avatar {
      * @borrows Avatar.setJointTranslations as setJointTranslations
      * @borrows Avatar.clearJointsData as clearJointsData
      * @borrows Avatar.getJointIndex as getJointIndex
+     * @borrows Avatar.getJointIndices as getJointIndices
      * @borrows Avatar.getJointNames as getJointNames
      * @borrows Avatar.setBlendshape as setBlendshape
      * @borrows Avatar.getAttachmentsVariant as getAttachmentsVariant
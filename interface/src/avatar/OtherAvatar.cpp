@@ -187,6 +187,22 @@ void OtherAvatar::forgetDetailedMotionStates() {
 void OtherAvatar::setWorkloadRegion(uint8_t region) {
     _workloadRegion = region;
     computeShapeLOD();
+    computeAnimationLOD();
+}
+
+void OtherAvatar::computeAnimationLOD() {
+    switch (_workloadRegion) {
+    case workload::Region::R1:
+        _animationLOD = AnimationLOD::FullRate;
+        break;
+    case workload::Region::R2:
+        _animationLOD = AnimationLOD::ReducedRate;
+        break;
+    default:
+        _animationLOD = AnimationLOD::LowRate;
+        break;
+    }
+    setRendersBlendshapes(_workloadRegion == workload::Region::R1);
 }
 
 void OtherAvatar::computeShapeLOD() {
@@ -243,6 +259,26 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
     }
 }
 
+bool OtherAvatar::needsJointUpdate(float deltaTime) const {
+    // the avatars further away get their new joints less often, the ones in between stay on their last pose
+    static const float JOINT_UPDATE_PERIODS[AnimationLOD::NumAnimationLODs] = { 0.0f, 1.0f / 30.0f, 1.0f / 10.0f };
+    return (_hasNewJointData && _timeSinceJointUpdate + deltaTime >= JOINT_UPDATE_PERIODS[_animationLOD]) || _transit.isActive();
+}
+
+void OtherAvatar::copyJointsIntoRig() {
+    _skeletonModel->getRig().copyJointsFromJointData(_jointData);
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    _skeletonModel->getRig().computeExternalPoses(rootTransform);
+    _areJointPosesUpdated = true;
+}
+
+void OtherAvatar::updateJointPoses(float deltaTime, bool inView) {
+    PROFILE_RANGE(simulation, "updateJointPoses");
+    if (inView && !_areJointPosesUpdated && needsJointUpdate(deltaTime)) {
+        copyJointsIntoRig();
+    }
+}
+
 void OtherAvatar::simulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
 
@@ -256,15 +292,21 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
         _simulationInViewRate.increment();
     }
 
+    bool needsJoints = needsJointUpdate(deltaTime);
+    _timeSinceJointUpdate += deltaTime;
+
     PerformanceTimer perfTimer("simulate");
     {
         PROFILE_RANGE(simulation, "updateJoints");
         if (inView) {
             Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            // the rig may already have been posed by updateJointPoses, even if the transit stopped since then
+            if (needsJoints || _areJointPosesUpdated) {
+                if (!_areJointPosesUpdated) {
+                    copyJointsIntoRig();
+                }
+                _areJointPosesUpdated = false;
+                _timeSinceJointUpdate = 0.0f;
                 _jointDataSimulationRate.increment();
 
                 head->simulate(deltaTime);
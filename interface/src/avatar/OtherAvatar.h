@@ -32,6 +32,14 @@ public:
         MultiSphereHigh // All joints
     };
 
+    // how often the joints from the network are applied to the skeleton
+    enum AnimationLOD {
+        FullRate = 0, // as they arrive
+        ReducedRate,
+        LowRate,
+        NumAnimationLODs
+    };
+
     virtual void instantiableAvatar() override { };
     virtual void createOrb() override;
     virtual void indicateLoadingStatus(LoadingStatus loadingStatus) override;
@@ -57,18 +65,26 @@ public:
     void forgetDetailedMotionStates();
     BodyLOD getBodyLOD() { return _bodyLOD; }
     void computeShapeLOD();
+    AnimationLOD getAnimationLOD() const { return _animationLOD; }
+    void computeAnimationLOD();
 
     void updateCollisionGroup(bool myAvatarCollide);
     bool getCollideWithOtherAvatars() const { return _collideWithOtherAvatars; } 
 
     void setCollisionWithOtherAvatarsFlags() override;
 
+    // Only touches the rig of this avatar, so that AvatarManager can pose the rigs of all the avatars in view on the
+    // worker threads before simulating them one by one. simulate does it itself for the avatars that were left out
+    void updateJointPoses(float deltaTime, bool inView);
+
     void simulate(float deltaTime, bool inView) override;
     void debugJointData() const;
     friend AvatarManager;
 
 protected:
     void handleChangedAvatarEntityData();
+    bool needsJointUpdate(float deltaTime) const;
+    void copyJointsIntoRig();
     void updateAttachedAvatarEntities();
     void onAddAttachedAvatarEntity(const QUuid& id);
     void onRemoveAttachedAvatarEntity(const QUuid& id);
@@ -90,6 +106,9 @@ protected:
     int32_t _spaceIndex { -1 };
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
+    AnimationLOD _animationLOD { AnimationLOD::FullRate };
+    float _timeSinceJointUpdate { 0.0f };
+    bool _areJointPosesUpdated { false };
     bool _needsDetailedRebuild { false };
 };
 
@@ -76,6 +76,7 @@ void GraphicsEngine::initializeRender() {
     _renderEngine->addJob<RenderViewTask>("RenderMainView", cullFunctor, render::ItemKey::TAG_BITS_0, render::ItemKey::TAG_BITS_0);
     _renderEngine->load();
     _renderEngine->registerScene(_renderScene);
+    _frameTimingsScriptingInterface.setRenderConfig(_renderEngine->getConfiguration());
 
     // Now that OpenGL is initialized, we are sure we have a valid context and can create the various pipeline shaders with success.
     DependencyManager::get<GeometryCache>()->initializeShapePipelines();
@@ -196,6 +197,7 @@ void GraphicsEngine::render_performFrame() {
     }
 
     RenderArgs renderArgs;
+    glm::mat4  view;
     glm::mat4  HMDSensorPose;
     glm::mat4  eyeToWorld;
     glm::mat4  sensorToWorld;
@@ -214,6 +216,7 @@ void GraphicsEngine::render_performFrame() {
             return;
         }
 
+        view = _appRenderArgs._view;
         HMDSensorPose = _appRenderArgs._headPose;
         eyeToWorld = _appRenderArgs._eyeToWorld;
         sensorToWorld = _appRenderArgs._sensorToWorld;
@@ -227,7 +230,7 @@ void GraphicsEngine::render_performFrame() {
 
     {
         PROFILE_RANGE(render, "/gpuContextReset");
-        getGPUContext()->beginFrame(_appRenderArgs._view, HMDSensorPose);
+        getGPUContext()->beginFrame(view, HMDSensorPose);
         // Reset the gpu::Context Stages
         // Back to the default framebuffer;
         gpu::doInBatch("Application_render::gpuContextReset", getGPUContext(), [&](gpu::Batch& batch) {
@@ -323,6 +326,8 @@ void GraphicsEngine::render_performFrame() {
 }
 
 void GraphicsEngine::editRenderArgs(RenderArgsEditor editor) {
+    // the render thread only waits for the copy, not for the whole edit
+    editor(_nextAppRenderArgs);
     QMutexLocker renderLocker(&_renderArgsMutex);
-    editor(_appRenderArgs);
+    _appRenderArgs = _nextAppRenderArgs;
 }
@@ -60,6 +60,8 @@ public:
     float getRenderLoopRate() const { return _renderLoopCounter.rate(); }
 
     // Feed GRaphics Engine with new frame configuration
+    // Only called by the game loop: the editor works on a copy that the render thread doesn't see until it is done, so
+    // the render of the previous frame goes on while the next one is prepared
     void editRenderArgs(RenderArgsEditor editor);
 
 private:
@@ -70,7 +72,8 @@ private:
 protected:
 
     mutable QMutex _renderArgsMutex{ QMutex::Recursive };
-    AppRenderArgs _appRenderArgs;
+    AppRenderArgs _appRenderArgs; // the args of the next frame to render, guarded by _renderArgsMutex
+    AppRenderArgs _nextAppRenderArgs; // the args being prepared by the game loop
 
     RateCounter<500> _renderLoopCounter;
 
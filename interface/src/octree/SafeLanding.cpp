@@ -18,10 +18,21 @@
 #include "Application.h"
 
 
-CalculateEntityLoadingPriority SafeLanding::entityLoadingOperatorElevateCollidables = [](const EntityItem& entityItem) {
-    const int COLLIDABLE_ENTITY_PRIORITY = 10.0f;
-    return entityItem.getCollisionless() * COLLIDABLE_ENTITY_PRIORITY;
-};
+// The models of the collidable entities load first, since physics waits for their shapes, and the closer they are to the
+// landing point the sooner they load. The entities that are far away and the ones that don't collide come in behind them
+CalculateEntityLoadingPriority SafeLanding::makeEntityLoadingPriorityOperator(const glm::vec3& landingPoint) {
+    return [landingPoint](const EntityItem& entityItem) {
+        const float COLLIDABLE_ENTITY_PRIORITY = 10.0f;
+        const float CLOSE_ENTITY_PRIORITY = 5.0f;
+        const float CLOSE_ENTITY_DISTANCE = 10.0f;
+        float distance = glm::distance(entityItem.getWorldPosition(), landingPoint);
+        float priority = CLOSE_ENTITY_PRIORITY * CLOSE_ENTITY_DISTANCE / (CLOSE_ENTITY_DISTANCE + distance);
+        if (!entityItem.getCollisionless()) {
+            priority += COLLIDABLE_ENTITY_PRIORITY;
+        }
+        return priority;
+    };
+}
 
 namespace {
     template<typename T> bool lessThanWraparound(int32_t a, int32_t b) {
@@ -50,6 +61,9 @@ void SafeLanding::startTracking(QSharedPointer<EntityTreeRenderer> entityTreeRen
             _sequenceNumbers.clear();
             _trackingEntities = true;
             _startTime = usecTimestampNow();
+            _entitiesReceivedTime = 0;
+            _physicsReadyTime = 0;
+            _visuallyReadyTime = 0;
 
             connect(std::const_pointer_cast<EntityTree>(entityTree).get(),
                 &EntityTree::addingEntity, this, &SafeLanding::addTrackedEntity, Qt::DirectConnection);
@@ -57,7 +71,8 @@ void SafeLanding::startTracking(QSharedPointer<EntityTreeRenderer> entityTreeRen
                 &EntityTree::deletingEntity, this, &SafeLanding::deleteTrackedEntity);
 
             _prevEntityLoadingPriorityOperator = EntityTreeRenderer::getEntityLoadingPriorityOperator();
-            EntityTreeRenderer::setEntityLoadingPriorityFunction(entityLoadingOperatorElevateCollidables);
+            EntityTreeRenderer::setEntityLoadingPriorityFunction(
+                makeEntityLoadingPriorityOperator(qApp->getMyAvatar()->getWorldPosition()));
         }
     }
 }
@@ -91,6 +106,7 @@ void SafeLanding::finishSequence(OCTREE_PACKET_SEQUENCE first, OCTREE_PACKET_SEQ
     if (_trackingEntities) {
         _sequenceStart = first;
         _sequenceEnd = last;
+        _entitiesReceivedTime = usecTimestampNow();
     }
 }
 
@@ -107,6 +123,8 @@ void SafeLanding::updateTracking() {
     {
         Locker lock(_lock);
         bool enableInterstitial = DependencyManager::get<NodeList>()->getDomainHandler().getInterstitialModeEnabled();
+        int numPhysicsPending = 0;
+        int numVisuallyPending = 0;
         auto entityMapIter = _trackedEntities.begin();
         while (entityMapIter != _trackedEntities.end()) {
             auto entity = entityMapIter->second;
@@ -118,15 +136,29 @@ void SafeLanding::updateTracking() {
                 }
                 isVisuallyReady = entity->isVisuallyReady() || (!entityRenderable && !entity->isParentPathComplete());
             }
-            if (isEntityPhysicsReady(entity) && isVisuallyReady) {
+            bool isPhysicsReady = isEntityPhysicsReady(entity);
+            if (isPhysicsReady && isVisuallyReady) {
                 entityMapIter = _trackedEntities.erase(entityMapIter);
             } else {
+                numPhysicsPending += isPhysicsReady ? 0 : 1;
+                numVisuallyPending += isVisuallyReady ? 0 : 1;
                 entityMapIter++;
             }
         }
         if (enableInterstitial) {
             _trackedEntityStabilityCount++;
         }
+
+        // the stages only end once all the entities have been received
+        if (_entitiesReceivedTime != 0) {
+            quint64 now = usecTimestampNow();
+            if (numPhysicsPending == 0 && _physicsReadyTime == 0) {
+                _physicsReadyTime = now;
+            }
+            if (numVisuallyPending == 0 && _visuallyReadyTime == 0) {
+                _visuallyReadyTime = now;
+            }
+        }
     }
 
     if (_trackedEntities.empty()) {
@@ -146,6 +178,7 @@ void SafeLanding::updateTracking() {
                      ((distance(startIter, endIter) == sequenceSize - 1) || !missingSequenceNumbers)));
             }
             if (shouldStop) {
+                logStageTimes();
                 stopTracking();
             }
         }
@@ -230,6 +263,16 @@ bool SafeLanding::isEntityPhysicsReady(const EntityItemPointer& entity) {
     return true;
 }
 
+void SafeLanding::logStageTimes() const {
+    auto secondsSinceStart = [this](quint64 time) {
+        return time != 0 ? (float)(time - _startTime) / USECS_PER_SECOND : -1.0f;
+    };
+    qCDebug(interfaceapp).nospace() << "SafeLanding done in " << secondsSinceStart(usecTimestampNow()) << "s with "
+        << _maxTrackedEntityCount << " entities: received at " << secondsSinceStart(_entitiesReceivedTime)
+        << "s, collision shapes at " << secondsSinceStart(_physicsReadyTime)
+        << "s, models at " << secondsSinceStart(_visuallyReadyTime) << "s";
+}
+
 void SafeLanding::debugDumpSequenceIDs() const {
     qCDebug(interfaceapp) << "Sequence set size:" << _sequenceNumbers.size();
 
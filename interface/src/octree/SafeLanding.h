@@ -50,6 +50,7 @@ private slots:
 private:
     bool isEntityPhysicsReady(const EntityItemPointer& entity);
     void debugDumpSequenceIDs() const;
+    void logStageTimes() const;
 
     std::mutex _lock;
     using Locker = std::lock_guard<std::mutex>;
@@ -65,6 +66,12 @@ private:
 
     quint64 _startTime { 0 };
 
+    // when each stage of the entry was done: all the entities received, the collision shapes near the landing point
+    // built, and the models loaded
+    quint64 _entitiesReceivedTime { 0 };
+    quint64 _physicsReadyTime { 0 };
+    quint64 _visuallyReadyTime { 0 };
+
     struct SequenceLessThan {
         bool operator()(const OCTREE_PACKET_SEQUENCE& a, const OCTREE_PACKET_SEQUENCE& b) const;
     };
@@ -72,7 +79,7 @@ private:
     using SequenceSet = std::set<OCTREE_PACKET_SEQUENCE, SequenceLessThan>;
     SequenceSet _sequenceNumbers;
 
-    static CalculateEntityLoadingPriority entityLoadingOperatorElevateCollidables;
+    static CalculateEntityLoadingPriority makeEntityLoadingPriorityOperator(const glm::vec3& landingPoint);
     CalculateEntityLoadingPriority _prevEntityLoadingPriorityOperator { nullptr };
 };
 
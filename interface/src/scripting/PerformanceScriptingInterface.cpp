@@ -47,6 +47,19 @@ QStringList PerformanceScriptingInterface::getRefreshRateProfileNames() const {
     return refreshRateProfileNames;
 }
 
+void PerformanceScriptingInterface::setAdaptiveQualityEnabled(bool enabled) {
+    qApp->getPerformanceManager().setAdaptiveQualityEnabled(enabled);
+    emit settingsChanged();
+}
+
+bool PerformanceScriptingInterface::getAdaptiveQualityEnabled() const {
+    return qApp->getPerformanceManager().isAdaptiveQualityEnabled();
+}
+
+int PerformanceScriptingInterface::getAdaptiveQualityStep() const {
+    return qApp->getPerformanceManager().getAdaptiveQualityStep();
+}
+
 int PerformanceScriptingInterface::getActiveRefreshRate() const {
     return qApp->getRefreshRateManager().getActiveRefreshRate();
 }
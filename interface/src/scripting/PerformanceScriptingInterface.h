@@ -22,6 +22,7 @@ class PerformanceScriptingInterface : public QObject {
     Q_OBJECT
     Q_PROPERTY(PerformancePreset performancePreset READ getPerformancePreset WRITE setPerformancePreset NOTIFY settingsChanged)
     Q_PROPERTY(RefreshRateProfile refreshRateProfile READ getRefreshRateProfile WRITE setRefreshRateProfile NOTIFY settingsChanged)
+    Q_PROPERTY(bool adaptiveQualityEnabled READ getAdaptiveQualityEnabled WRITE setAdaptiveQualityEnabled NOTIFY settingsChanged)
 
 public:
 
@@ -55,6 +56,11 @@ public slots:
     RefreshRateProfile getRefreshRateProfile() const;
     QStringList getRefreshRateProfileNames() const;
 
+    void setAdaptiveQualityEnabled(bool enabled);
+    bool getAdaptiveQualityEnabled() const;
+    // how many steps the quality is below the preset's, 0 while it is at the preset's
+    int getAdaptiveQualityStep() const;
+
     int getActiveRefreshRate() const;
     RefreshRateManager::UXMode getUXMode() const;
     RefreshRateManager::RefreshRateRegime getRefreshRateRegime() const;
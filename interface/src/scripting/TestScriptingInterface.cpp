@@ -105,6 +105,31 @@ bool TestScriptingInterface::stopTracing(QString filename) {
     return true;
 }
 
+bool TestScriptingInterface::startContinuousTracing() {
+    if (!DependencyManager::isSet<tracing::Tracer>()) {
+        return false;
+    }
+
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    if (!tracer->isContinuousTracing()) {
+        tracer->startContinuousTracing();
+    }
+    return true;
+}
+
+bool TestScriptingInterface::saveRecentTrace(QString filename, float seconds) {
+    if (!DependencyManager::isSet<tracing::Tracer>()) {
+        return false;
+    }
+
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    if (!tracer->isContinuousTracing()) {
+        return false;
+    }
+    tracer->serializeRecent(filename, seconds);
+    return true;
+}
+
 void TestScriptingInterface::clear() {
     qApp->postLambdaEvent([] {
         qApp->getEntities()->clear();
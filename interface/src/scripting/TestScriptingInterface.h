@@ -99,6 +99,24 @@ public slots:
     */
     bool stopTracing(QString filename);
 
+    /**jsdoc
+    * Start recording the recent tracing events into per-thread rings, which is cheap enough to leave running. Only the
+    * names and times of the events are recorded, not their arguments
+    * @function Test.startContinuousTracing
+    * @returns {bool} True if successful.
+    */
+    bool startContinuousTracing();
+
+    /**jsdoc
+    * Serialize the tracing events of the last seconds recorded since startContinuousTracing to a file, in the same format
+    * as stopTracing. Recording continues
+    * @function Test.saveRecentTrace
+    * @param {string} filename - Name of file to save to
+    * @param {number} seconds - How far back to save the events from
+    * @returns {bool} True if successful.
+    */
+    bool saveRecentTrace(QString filename, float seconds);
+
     /**jsdoc
     * Starts a specific trace event
     * @function Test.startTraceEvent
@@ -29,6 +29,9 @@
 #include <PickManager.h>
 
 #include <gl/Context.h>
+#include <workload/RegionState.h>
+#include <workload/RegionTracker.h>
+#include <workload/SpaceClassifier.h>
 
 #include "Menu.h"
 #include "Util.h"
@@ -130,6 +133,10 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(updatedHeroAvatarCount, avatarManager->getNumHeroAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
+    STAT_UPDATE(animationLODAvatarCounts, QString("%1/%2/%3")
+        .arg(avatarManager->getNumAvatarsWithAnimationLOD(OtherAvatar::FullRate))
+        .arg(avatarManager->getNumAvatarsWithAnimationLOD(OtherAvatar::ReducedRate))
+        .arg(avatarManager->getNumAvatarsWithAnimationLOD(OtherAvatar::LowRate)));
     STAT_UPDATE(serverCount, (int)nodeList->size());
     STAT_UPDATE_FLOAT(renderrate, qApp->getRenderLoopRate(), 0.1f);
     RefreshRateManager& refreshRateManager = qApp->getRefreshRateManager();
@@ -387,6 +394,8 @@ void Stats::updateStats(bool force) {
     auto config = qApp->getRenderEngine()->getConfiguration().get();
     STAT_UPDATE(engineFrameTime, (float) config->getCPURunTime());
     STAT_UPDATE(avatarSimulationTime, (float)avatarManager->getAvatarSimulationTime());
+    auto workloadConfig = qApp->getGameWorkload()._engine->getConfiguration().get();
+    STAT_UPDATE(workloadFrameTime, (float)workloadConfig->getCPURunTime());
 
     if (_expanded) {
         STAT_UPDATE(gpuBuffers, (int)gpu::Context::getBufferGPUCount());
@@ -410,6 +419,25 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(gpuFreeMemory, (int)BYTES_TO_MB(gpu::Context::getFreeGPUMemSize()));
         STAT_UPDATE(rectifiedTextureCount, (int)RECTIFIED_TEXTURE_COUNT.load());
         STAT_UPDATE(decimatedTextureCount, (int)DECIMATED_TEXTURE_COUNT.load());
+
+        STAT_UPDATE(workloadFrameTimeP99, (float)workloadConfig->getCPURunTimeP99());
+        auto transactionConfig = workloadConfig->getConfig<workload::PerformSpaceTransaction>("spaceClassifier.updateSpace");
+        if (transactionConfig) {
+            STAT_UPDATE(workloadTransactionTime, (float)transactionConfig->getCPURunTime());
+        }
+        auto regionTrackerConfig = workloadConfig->getConfig<workload::RegionTracker>("spaceClassifier.regionTracker");
+        if (regionTrackerConfig) {
+            STAT_UPDATE(workloadClassifierTime, (float)regionTrackerConfig->getCPURunTime());
+            STAT_UPDATE(workloadRegionChanges, (int)regionTrackerConfig->getNumChanges());
+            STAT_UPDATE(workloadClassifiedProxies, (int)regionTrackerConfig->getNumClassifiedProxies());
+        }
+        auto regionStateConfig = workloadConfig->getConfig<workload::RegionState>("spaceClassifier.regionState");
+        if (regionStateConfig) {
+            STAT_UPDATE(workloadRegionCounts, QString("%1/%2/%3")
+                .arg(regionStateConfig->getNumR1())
+                .arg(regionStateConfig->getNumR2())
+                .arg(regionStateConfig->getNumR3()));
+        }
     }
 
     gpu::ContextStats gpuFrameStats;
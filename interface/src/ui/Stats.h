@@ -55,6 +55,8 @@ private: \
  * @property {number} updatedAvatarCount - <em>Read-only.</em>
  * @property {number} updatedHeroAvatarCount - <em>Read-only.</em>
  * @property {number} notUpdatedAvatarCount - <em>Read-only.</em>
+ * @property {string} animationLODAvatarCounts - The numbers of avatars whose joints are updated at the full, reduced, and
+ *     low rates. <em>Read-only.</em>
  * @property {number} packetInCount - <em>Read-only.</em>
  * @property {number} packetOutCount - <em>Read-only.</em>
  * @property {number} mbpsIn - <em>Read-only.</em>
@@ -141,6 +143,18 @@ private: \
  * @property {number} batchFrameTime - <em>Read-only.</em>
  * @property {number} engineFrameTime - <em>Read-only.</em>
  * @property {number} avatarSimulationTime - <em>Read-only.</em>
+ * @property {number} workloadFrameTime - The CPU time of the last run of the workload engine, in ms. <em>Read-only.</em>
+ * @property {number} workloadFrameTimeP99 - The 99th percentile of the CPU times of the last runs of the workload engine,
+ *     in ms. <em>Read-only.</em>
+ * @property {number} workloadTransactionTime - The CPU time spent applying the proxy transactions of the workload space
+ *     in the last run, in ms. <em>Read-only.</em>
+ * @property {number} workloadClassifierTime - The CPU time spent classifying the proxies of the workload space in the
+ *     last run, in ms. <em>Read-only.</em>
+ * @property {string} workloadRegionCounts - The numbers of workload proxies in regions 1, 2, and 3. <em>Read-only.</em>
+ * @property {number} workloadRegionChanges - The number of workload proxies that changed region in the last run.
+ *     <em>Read-only.</em>
+ * @property {number} workloadClassifiedProxies - The number of workload proxies that were classified again in the last
+ *     run. <em>Read-only.</em>
  *
  *
  * @property {number} x
@@ -219,6 +233,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
+    STATS_PROPERTY(QString, animationLODAvatarCounts, QString())
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -308,6 +323,13 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(float, batchFrameTime, 0)
     STATS_PROPERTY(float, engineFrameTime, 0)
     STATS_PROPERTY(float, avatarSimulationTime, 0)
+    STATS_PROPERTY(float, workloadFrameTime, 0)
+    STATS_PROPERTY(float, workloadFrameTimeP99, 0)
+    STATS_PROPERTY(float, workloadTransactionTime, 0)
+    STATS_PROPERTY(float, workloadClassifierTime, 0)
+    STATS_PROPERTY(QString, workloadRegionCounts, QString())
+    STATS_PROPERTY(int, workloadRegionChanges, 0)
+    STATS_PROPERTY(int, workloadClassifiedProxies, 0)
 
     STATS_PROPERTY(int, stylusPicksCount, 0)
     STATS_PROPERTY(int, rayPicksCount, 0)
@@ -489,6 +511,13 @@ signals:
      */
     void notUpdatedAvatarCountChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>animationLODAvatarCounts</code> property changes.
+     * @function Stats.animationLODAvatarCountsChanged
+     * @returns {Signal}
+     */
+    void animationLODAvatarCountsChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>packetInCount</code> property changes.
      * @function Stats.packetInCountChanged
@@ -1086,6 +1115,55 @@ signals:
      */
     void avatarSimulationTimeChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>workloadFrameTime</code> property changes.
+     * @function Stats.workloadFrameTimeChanged
+     * @returns {Signal}
+     */
+    void workloadFrameTimeChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>workloadFrameTimeP99</code> property changes.
+     * @function Stats.workloadFrameTimeP99Changed
+     * @returns {Signal}
+     */
+    void workloadFrameTimeP99Changed();
+
+    /**jsdoc
+     * Triggered when the value of the <code>workloadTransactionTime</code> property changes.
+     * @function Stats.workloadTransactionTimeChanged
+     * @returns {Signal}
+     */
+    void workloadTransactionTimeChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>workloadClassifierTime</code> property changes.
+     * @function Stats.workloadClassifierTimeChanged
+     * @returns {Signal}
+     */
+    void workloadClassifierTimeChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>workloadRegionCounts</code> property changes.
+     * @function Stats.workloadRegionCountsChanged
+     * @returns {Signal}
+     */
+    void workloadRegionCountsChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>workloadRegionChanges</code> property changes.
+     * @function Stats.workloadRegionChangesChanged
+     * @returns {Signal}
+     */
+    void workloadRegionChangesChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>workloadClassifiedProxies</code> property changes.
+     * @function Stats.workloadClassifiedProxiesChanged
+     * @returns {Signal}
+     */
+    void workloadClassifiedProxiesChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>rectifiedTextureCount</code> property changes.
      * @function Stats.rectifiedTextureCountChanged
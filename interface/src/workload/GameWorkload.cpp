@@ -14,6 +14,7 @@
 #include <workload/SpaceClassifier.h>
 
 #include "PhysicsBoundary.h"
+#include "ResourceBoundary.h"
 
 class WorkloadEngineBuilder {
 public:
@@ -33,6 +34,7 @@ public:
         const auto regionTrackerOut = model.addJob<workload::SpaceClassifierTask>("spaceClassifier", fixedViews);
 
         model.addJob<PhysicsBoundary>("PhysicsBoundary", regionTrackerOut);
+        model.addJob<ResourceBoundary>("ResourceBoundary", regionTrackerOut);
 
         model.addJob<GameSpaceToRender>("SpaceToRender");
 
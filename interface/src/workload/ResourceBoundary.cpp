@@ -0,0 +1,35 @@
+//
+//  ResourceBoundary.cpp
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceBoundary.h"
+
+#include <EntityTreeRenderer.h>
+#include <RenderableModelEntityItem.h>
+#include <workload/Space.h>
+
+void ResourceBoundary::run(const workload::WorkloadContextPointer& context, const Inputs& inputs) {
+    auto space = context->_space;
+    if (!space) {
+        return;
+    }
+    const auto& regionChanges = inputs.get0();
+    for (uint32_t i = 0; i < (uint32_t)regionChanges.size(); ++i) {
+        const workload::Space::Change& change = regionChanges[i];
+        auto nestable = space->getOwner(change.proxyId).get<SpatiallyNestablePointer>();
+        if (nestable && nestable->getNestableType() == NestableType::Entity) {
+            auto entity = std::static_pointer_cast<EntityItem>(nestable);
+            if (entity->getType() == EntityTypes::Model) {
+                auto model = std::static_pointer_cast<RenderableModelEntityItem>(entity)->getModel();
+                if (model && !model->isLoaded()) {
+                    model->setLoadingPriority(EntityTreeRenderer::getEntityLoadingPriority(*entity));
+                }
+            }
+        }
+    }
+}
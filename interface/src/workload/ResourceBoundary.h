@@ -0,0 +1,27 @@
+//
+//  ResourceBoundary.h
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_ResourceBoundary_h
+#define hifi_ResourceBoundary_h
+
+#include <workload/Engine.h>
+#include <workload/RegionTracker.h>
+
+// Reorders the pending models of the entities that change region, so that the ones nearer the views load first
+class ResourceBoundary {
+public:
+    using Config = workload::Job::Config;
+    using Inputs = workload::RegionTracker::Outputs;
+    using JobModel = workload::Job::ModelI<ResourceBoundary, Inputs, Config>;
+
+    ResourceBoundary() {}
+    void configure(const Config& config) { }
+    void run(const workload::WorkloadContextPointer& context, const Inputs& inputs);
+};
+
+#endif // hifi_ResourceBoundary_h
@@ -11,6 +11,9 @@
 #include "AnimClip.h"
 
 #include <assert.h>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 #include "GLMHelpers.h"
 #include "AnimationLogging.h"
@@ -29,6 +32,11 @@
 #define ASSERT assert
 #endif
 
+// how far the compressed frames may stray from the retargeted ones
+static const float ROTATION_TOLERANCE = 0.0005f; // radians
+static const float TRANSLATION_TOLERANCE = 0.0001f; // meters
+static const float SCALE_TOLERANCE = 0.0001f;
+
 static std::vector<int> buildJointIndexMap(const AnimSkeleton& dstSkeleton, const AnimSkeleton& srcSkeleton) {
     std::vector<int> jointIndexMap;
     int srcJointCount = srcSkeleton.getNumJoints();
@@ -223,6 +231,54 @@ static std::vector<AnimPoseVec> copyAndRetargetFromNetworkAnim(AnimationPointer
     return anim;
 }
 
+static AnimCompressedClip compressAnim(const std::vector<AnimPoseVec>& anim, AnimSkeleton::ConstPointer avatarSkeleton) {
+    // the translations are in the units of the avatar
+    const float EPSILON = 0.0001f;
+    const float avatarUnitScale = extractScale(avatarSkeleton->getGeometryOffset()).y;
+    float translationTolerance = avatarUnitScale > EPSILON ? TRANSLATION_TOLERANCE / avatarUnitScale : TRANSLATION_TOLERANCE;
+    return AnimCompressedClip(anim, ROTATION_TOLERANCE, translationTolerance, SCALE_TOLERANCE);
+}
+
+// The retargeted animations are shared by the clips that play the same animation on the same skeleton, like the states of
+// an anim graph that reuse an animation or the rigs of the avatars that use the same model
+using SharedAnimKey = std::tuple<QString, size_t, int, QString, int>;
+static std::mutex sharedAnimsMutex;
+static std::map<SharedAnimKey, std::weak_ptr<const AnimCompressedClip>> sharedAnims;
+
+template <typename F>
+static std::shared_ptr<const AnimCompressedClip> getSharedAnim(const SharedAnimKey& key, F buildAnim) {
+    {
+        std::lock_guard<std::mutex> lock(sharedAnimsMutex);
+        auto itr = sharedAnims.find(key);
+        if (itr != sharedAnims.end()) {
+            auto anim = itr->second.lock();
+            if (anim) {
+                return anim;
+            }
+        }
+    }
+
+    auto anim = std::make_shared<const AnimCompressedClip>(buildAnim());
+
+    std::lock_guard<std::mutex> lock(sharedAnimsMutex);
+    // forget the animations that aren't played anymore
+    for (auto itr = sharedAnims.begin(); itr != sharedAnims.end();) {
+        if (itr->second.expired()) {
+            itr = sharedAnims.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    auto& sharedAnim = sharedAnims[key];
+    auto otherAnim = sharedAnim.lock();
+    if (otherAnim) {
+        // built by another clip in the meantime
+        return otherAnim;
+    }
+    sharedAnim = anim;
+    return anim;
+}
+
 AnimClip::AnimClip(const QString& id, const QString& url, float startFrame, float endFrame, float timeScale, bool loopFlag, bool mirrorFlag,
                    AnimBlendType blendType, const QString& baseURL, float baseFrame) :
     AnimNode(AnimNode::Type::Clip, id),
@@ -263,51 +319,50 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
     // poll network anim to see if it's finished loading yet.
     if (_blendType == AnimBlendType_Normal) {
         if (_networkAnim && _networkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+            // loading is complete, copy, retarget & compress animation, unless another clip already did it.
+            SharedAnimKey key(_url, _skeleton->getHash(), (int)_blendType, QString(), 0);
+            _anim = getSharedAnim(key, [&] {
+                return compressAnim(copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton), _skeleton);
+            });
 
             // we no longer need the actual animation resource anymore.
             _networkAnim.reset();
 
-            // mirrorAnim will be re-built on demand, if needed.
-            _mirrorAnim.clear();
-
             _poses.resize(_skeleton->getNumJoints());
+            _nextPoses.resize(_skeleton->getNumJoints());
         }
     } else {
         // an additive blend type
         if (_networkAnim && _networkAnim->isLoaded() && _baseNetworkAnim && _baseNetworkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+            // loading is complete, copy & retarget animation, unless another clip already did it.
+            SharedAnimKey key(_url, _skeleton->getHash(), (int)_blendType, _baseURL, (int)_baseFrame);
+            _anim = getSharedAnim(key, [&] {
+                auto anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+
+                // copy & retarget baseAnim!
+                auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
+
+                if (_blendType == AnimBlendType_AddAbsolute) {
+                    bakeAbsoluteDeltaAnim(anim, baseAnim[(int)_baseFrame], _skeleton);
+                } else {
+                    // AnimBlendType_AddRelative
+                    bakeRelativeDeltaAnim(anim, baseAnim[(int)_baseFrame]);
+                }
+
+                // the deltas are compressed once they are baked
+                return compressAnim(anim, _skeleton);
+            });
 
             // we no longer need the actual animation resource anymore.
             _networkAnim.reset();
 
-            // mirrorAnim will be re-built on demand, if needed.
             // TODO: handle mirrored relative animations.
-            _mirrorAnim.clear();
-
             _poses.resize(_skeleton->getNumJoints());
-
-            // copy & retarget baseAnim!
-            auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
-
-            if (_blendType == AnimBlendType_AddAbsolute) {
-                bakeAbsoluteDeltaAnim(_anim, baseAnim[(int)_baseFrame], _skeleton);
-            } else {
-                // AnimBlendType_AddRelative
-                bakeRelativeDeltaAnim(_anim, baseAnim[(int)_baseFrame]);
-            }
+            _nextPoses.resize(_skeleton->getNumJoints());
         }
     }
 
-    if (_anim.size()) {
-
-        // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
-            buildMirrorAnim();
-        }
-
+    if (_anim && !_anim->isEmpty() && _anim->getJointCount() == (int)_poses.size()) {
         int prevIndex = (int)glm::floor(_frame);
         int nextIndex;
         if (_loopFlag && _frame >= _endFrame) {
@@ -318,15 +373,22 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = _anim->getFrameCount();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
+        // the frames are sampled from the compressed tracks, then blended in place
+        _anim->sampleFrame(prevIndex, &_poses[0]);
         float alpha = glm::fract(_frame);
+        if (nextIndex != prevIndex && alpha > 0.0f) {
+            _anim->sampleFrame(nextIndex, &_nextPoses[0]);
+            ::blend(_poses.size(), &_poses[0], &_nextPoses[0], alpha, &_poses[0]);
+        }
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        // mirroring the blended poses is the same as blending the mirrored frames
+        if (_mirrorFlag) {
+            _skeleton->mirrorRelativePoses(_poses);
+        }
     }
 
     processOutputJoints(triggersOut);
@@ -341,17 +403,6 @@ void AnimClip::setCurrentFrameInternal(float frame) {
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame + _startFrame, dt, _loopFlag, _id, triggers);
 }
 
-void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
-
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
-    }
-}
-
 const AnimPoseVec& AnimClip::getPosesInternal() const {
     return _poses;
 }
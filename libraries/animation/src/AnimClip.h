@@ -13,6 +13,7 @@
 
 #include <string>
 #include "AnimationCache.h"
+#include "AnimCompressedClip.h"
 #include "AnimNode.h"
 
 // Playback a single animation timeline.
@@ -61,8 +62,6 @@ protected:
 
     virtual void setCurrentFrameInternal(float frame) override;
 
-    void buildMirrorAnim();
-
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
 
@@ -70,10 +69,9 @@ protected:
     AnimationPointer _baseNetworkAnim;
 
     AnimPoseVec _poses;
+    AnimPoseVec _nextPoses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    std::shared_ptr<const AnimCompressedClip> _anim;
 
     QString _url;
     float _startFrame;
@@ -0,0 +1,238 @@
+//
+//  AnimCompressedClip.cpp
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimCompressedClip.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "AnimationLogging.h"
+
+static const float ROTATION_QUANTIZATION = 32767.0f;
+static const float VEC3_QUANTIZATION = 65535.0f;
+
+// the key frames are 16 bits
+static const int MAX_FRAME_COUNT = std::numeric_limits<uint16_t>::max() + 1;
+
+// the keys of a track are at most this many frames apart, which bounds the cost of the reduction
+static const int MAX_KEY_SPACING = 64;
+
+static glm::i16vec4 quantizeRotation(const glm::quat& rotation) {
+    return glm::i16vec4(glm::round(glm::vec4(rotation.x, rotation.y, rotation.z, rotation.w) * ROTATION_QUANTIZATION));
+}
+
+static glm::quat dequantizeRotation(const glm::i16vec4& value) {
+    glm::vec4 components = glm::vec4(value) / ROTATION_QUANTIZATION;
+    return glm::normalize(glm::quat(components.w, components.x, components.y, components.z));
+}
+
+// the rotations of a track are kept in the same hemisphere from one frame to the next, so they don't need to be aligned here
+static glm::quat lerpRotation(const glm::quat& a, const glm::quat& b, float alpha) {
+    return glm::normalize(a * (1.0f - alpha) + b * alpha);
+}
+
+static float segmentAlpha(int startFrame, int endFrame, int frame) {
+    return endFrame > startFrame ? (float)(frame - startFrame) / (float)(endFrame - startFrame) : 0.0f;
+}
+
+// Returns the frames to keep as keys, so that isInterpolated(startKey, endKey, frame) holds for every frame in between.
+// A track that holds still only keeps its first frame
+template <typename F>
+static std::vector<int> reduceKeys(int frameCount, F isInterpolated) {
+    std::vector<int> keys { 0 };
+    bool isConstant = true;
+    for (int frame = 1; frame < frameCount && isConstant; frame++) {
+        isConstant = isInterpolated(0, 0, frame);
+    }
+    if (isConstant) {
+        return keys;
+    }
+
+    int start = 0;
+    while (start < frameCount - 1) {
+        // extend the segment for as long as all of its frames stay close enough to the line between its ends
+        int end = start + 1;
+        while (end + 1 < frameCount && end + 1 - start <= MAX_KEY_SPACING) {
+            bool fits = true;
+            for (int frame = start + 1; frame <= end && fits; frame++) {
+                fits = isInterpolated(start, end + 1, frame);
+            }
+            if (!fits) {
+                break;
+            }
+            end++;
+        }
+        keys.push_back(end);
+        start = end;
+    }
+    return keys;
+}
+
+// finds the keys of a track around a frame, past its ends the track holds its first and last keys
+static void findKeys(const uint16_t* keyFrames, uint32_t numKeys, int frame, uint32_t& keyOut, float& alphaOut) {
+    keyOut = 0;
+    alphaOut = 0.0f;
+    if (numKeys == 1 || frame <= keyFrames[0]) {
+        return;
+    }
+    const uint16_t* nextKeyFrame = std::upper_bound(keyFrames, keyFrames + numKeys, (uint16_t)frame);
+    if (nextKeyFrame == keyFrames + numKeys) {
+        keyOut = numKeys - 1;
+        return;
+    }
+    keyOut = (uint32_t)(nextKeyFrame - keyFrames) - 1;
+    alphaOut = segmentAlpha(keyFrames[keyOut], *nextKeyFrame, frame);
+}
+
+AnimCompressedClip::AnimCompressedClip(const std::vector<AnimPoseVec>& anim, float rotationTolerance,
+        float translationTolerance, float scaleTolerance) {
+    if (anim.empty()) {
+        return;
+    }
+    _frameCount = (int)anim.size();
+    if (_frameCount > MAX_FRAME_COUNT) {
+        qCWarning(animation) << "AnimCompressedClip, only the first" << MAX_FRAME_COUNT << "of" << _frameCount << "frames are kept";
+        _frameCount = MAX_FRAME_COUNT;
+    }
+
+    size_t jointCount = anim[0].size();
+    std::vector<glm::quat> rotations(_frameCount);
+    std::vector<glm::vec3> translations(_frameCount);
+    std::vector<glm::vec3> scales(_frameCount);
+    for (size_t joint = 0; joint < jointCount; joint++) {
+        for (int frame = 0; frame < _frameCount; frame++) {
+            const AnimPose& pose = anim[frame][joint];
+            rotations[frame] = pose.rot();
+            translations[frame] = pose.trans();
+            scales[frame] = pose.scale();
+        }
+        addRotationTrack(_rotations, rotations, rotationTolerance);
+        addVec3Track(_translations, translations, translationTolerance);
+        addVec3Track(_scales, scales, scaleTolerance);
+    }
+}
+
+void AnimCompressedClip::addRotationTrack(RotationChannel& channel, const std::vector<glm::quat>& rotations, float tolerance) {
+    int frameCount = (int)rotations.size();
+
+    // the keys are interpolated from their quantized values
+    std::vector<glm::i16vec4> values(frameCount);
+    std::vector<glm::quat> dequantized(frameCount);
+    glm::quat previous = rotations[0];
+    for (int frame = 0; frame < frameCount; frame++) {
+        glm::quat rotation = rotations[frame];
+        if (glm::dot(rotation, previous) < 0.0f) {
+            rotation = -rotation;
+        }
+        previous = rotation;
+        values[frame] = quantizeRotation(rotation);
+        dequantized[frame] = dequantizeRotation(values[frame]);
+    }
+
+    const float minCosHalfAngle = cosf(0.5f * tolerance);
+    std::vector<int> keys = reduceKeys(frameCount, [&](int startKey, int endKey, int frame) {
+        glm::quat rotation = lerpRotation(dequantized[startKey], dequantized[endKey], segmentAlpha(startKey, endKey, frame));
+        return fabsf(glm::dot(rotation, rotations[frame])) >= minCosHalfAngle;
+    });
+
+    Track track;
+    track.firstKey = (uint32_t)channel.keyFrames.size();
+    track.numKeys = (uint32_t)keys.size();
+    channel.tracks.push_back(track);
+    for (int key : keys) {
+        channel.keyFrames.push_back((uint16_t)key);
+        channel.values.push_back(values[key]);
+    }
+}
+
+void AnimCompressedClip::addVec3Track(Vec3Channel& channel, const std::vector<glm::vec3>& vectors, float tolerance) {
+    int frameCount = (int)vectors.size();
+
+    glm::vec3 minVector = vectors[0];
+    glm::vec3 maxVector = vectors[0];
+    for (const auto& vector : vectors) {
+        minVector = glm::min(minVector, vector);
+        maxVector = glm::max(maxVector, vector);
+    }
+    Vec3Channel::Range range;
+    range.offset = minVector;
+    range.step = (maxVector - minVector) / VEC3_QUANTIZATION;
+
+    std::vector<glm::u16vec3> values(frameCount);
+    std::vector<glm::vec3> dequantized(frameCount);
+    for (int frame = 0; frame < frameCount; frame++) {
+        glm::vec3 steps;
+        for (int i = 0; i < 3; i++) {
+            steps[i] = range.step[i] > 0.0f ? glm::round((vectors[frame][i] - range.offset[i]) / range.step[i]) : 0.0f;
+        }
+        values[frame] = glm::u16vec3(glm::clamp(steps, glm::vec3(0.0f), glm::vec3(VEC3_QUANTIZATION)));
+        dequantized[frame] = range.offset + range.step * glm::vec3(values[frame]);
+    }
+
+    std::vector<int> keys = reduceKeys(frameCount, [&](int startKey, int endKey, int frame) {
+        glm::vec3 vector = glm::mix(dequantized[startKey], dequantized[endKey], segmentAlpha(startKey, endKey, frame));
+        return glm::distance(vector, vectors[frame]) <= tolerance;
+    });
+
+    Track track;
+    track.firstKey = (uint32_t)channel.keyFrames.size();
+    track.numKeys = (uint32_t)keys.size();
+    channel.tracks.push_back(track);
+    channel.ranges.push_back(range);
+    for (int key : keys) {
+        channel.keyFrames.push_back((uint16_t)key);
+        channel.values.push_back(values[key]);
+    }
+}
+
+glm::quat AnimCompressedClip::sampleRotation(const RotationChannel& channel, int track, int frame) {
+    const Track& rotationTrack = channel.tracks[track];
+    uint32_t key;
+    float alpha;
+    findKeys(&channel.keyFrames[rotationTrack.firstKey], rotationTrack.numKeys, frame, key, alpha);
+    const glm::i16vec4* values = &channel.values[rotationTrack.firstKey];
+    glm::quat rotation = dequantizeRotation(values[key]);
+    if (alpha > 0.0f) {
+        rotation = lerpRotation(rotation, dequantizeRotation(values[key + 1]), alpha);
+    }
+    return rotation;
+}
+
+glm::vec3 AnimCompressedClip::sampleVec3(const Vec3Channel& channel, int track, int frame) {
+    const Track& vec3Track = channel.tracks[track];
+    uint32_t key;
+    float alpha;
+    findKeys(&channel.keyFrames[vec3Track.firstKey], vec3Track.numKeys, frame, key, alpha);
+    const Vec3Channel::Range& range = channel.ranges[track];
+    const glm::u16vec3* values = &channel.values[vec3Track.firstKey];
+    glm::vec3 steps = glm::vec3(values[key]);
+    if (alpha > 0.0f) {
+        steps = glm::mix(steps, glm::vec3(values[key + 1]), alpha);
+    }
+    return range.offset + range.step * steps;
+}
+
+void AnimCompressedClip::sampleFrame(int frame, AnimPose* posesOut) const {
+    int jointCount = getJointCount();
+    for (int joint = 0; joint < jointCount; joint++) {
+        posesOut[joint] = AnimPose(sampleVec3(_scales, joint, frame), sampleRotation(_rotations, joint, frame),
+            sampleVec3(_translations, joint, frame));
+    }
+}
+
+size_t AnimCompressedClip::getMemorySize() const {
+    size_t size = _rotations.tracks.size() * sizeof(Track) + _rotations.keyFrames.size() * sizeof(uint16_t) +
+        _rotations.values.size() * sizeof(glm::i16vec4);
+    for (const auto* channel : { &_translations, &_scales }) {
+        size += channel->tracks.size() * (sizeof(Track) + sizeof(Vec3Channel::Range)) +
+            channel->keyFrames.size() * sizeof(uint16_t) + channel->values.size() * sizeof(glm::u16vec3);
+    }
+    return size;
+}
@@ -0,0 +1,76 @@
+//
+//  AnimCompressedClip.h
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimCompressedClip_h
+#define hifi_AnimCompressedClip_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/gtc/type_precision.hpp>
+
+#include "AnimPose.h"
+
+// The frames of an animation clip, kept as one track per joint for each of the rotations, translations and scales.
+// The rotations are quantized to 16 bits per component, the translations and scales to 16 bits within the range of
+// their track, and a track only keeps the frames that can't be interpolated linearly from the ones around them.
+class AnimCompressedClip {
+public:
+    AnimCompressedClip() {}
+
+    // anim[frame][joint], the rotation tolerance is in radians and the translation tolerance in the units of the poses
+    AnimCompressedClip(const std::vector<AnimPoseVec>& anim, float rotationTolerance, float translationTolerance,
+        float scaleTolerance);
+
+    bool isEmpty() const { return _frameCount == 0; }
+    int getFrameCount() const { return _frameCount; }
+    int getJointCount() const { return (int)_rotations.tracks.size(); }
+
+    // the poses of all the joints at a frame, posesOut holds getJointCount() of them
+    void sampleFrame(int frame, AnimPose* posesOut) const;
+
+    size_t getMemorySize() const;
+
+private:
+    struct Track {
+        uint32_t firstKey { 0 };
+        uint32_t numKeys { 0 };
+    };
+
+    struct RotationChannel {
+        std::vector<Track> tracks;
+        std::vector<uint16_t> keyFrames;
+        std::vector<glm::i16vec4> values;
+    };
+
+    struct Vec3Channel {
+        struct Range {
+            glm::vec3 offset;
+            glm::vec3 step;
+        };
+
+        std::vector<Track> tracks;
+        std::vector<Range> ranges;
+        std::vector<uint16_t> keyFrames;
+        std::vector<glm::u16vec3> values;
+    };
+
+    static void addRotationTrack(RotationChannel& channel, const std::vector<glm::quat>& rotations, float tolerance);
+    static void addVec3Track(Vec3Channel& channel, const std::vector<glm::vec3>& vectors, float tolerance);
+
+    static glm::quat sampleRotation(const RotationChannel& channel, int track, int frame);
+    static glm::vec3 sampleVec3(const Vec3Channel& channel, int track, int frame);
+
+    RotationChannel _rotations;
+    Vec3Channel _translations;
+    Vec3Channel _scales;
+    int _frameCount { 0 };
+};
+
+#endif // hifi_AnimCompressedClip_h
@@ -219,6 +219,11 @@ float AnimInverseKinematics::getInterpolationAlpha(float timer) {
     return alpha;
 }
 
+static bool hasPositionTarget(const IKTarget& target) {
+    return target.getType() == IKTarget::Type::RotationAndPosition || target.getType() == IKTarget::Type::HmdHead ||
+        target.getType() == IKTarget::Type::HipsRelativeRotationAndPosition;
+}
+
 void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<IKTarget>& targets, float dt, JointChainInfoVec& jointChainInfoVec) {
     // compute absolute poses that correspond to relative target poses
     AnimPoseVec absolutePoses;
@@ -235,16 +240,32 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
 
     std::map<int, int> targetToChainMap;
 
+    // a chain whose tip has reached its target isn't solved again, unless the other chains move it away from it
+    const float MAX_REACHED_TARGET_ERROR = 0.001f; // meters
+    const float MAX_REACHED_TARGET_ANGLE = 0.01f; // radians
+    const float MIN_REACHED_TARGET_COS_HALF_ANGLE = cosf(0.5f * MAX_REACHED_TARGET_ANGLE);
+
+    // the loops end early once every target is reached, or once they stop getting the tips any closer to them,
+    // with one more loop to interpolate the chains
+    const float MIN_ERROR_IMPROVEMENT = 0.0001f; // meters
+    std::vector<bool> isTargetReached(targets.size(), false);
+    bool hasConverged = false;
+
     float maxError = 0.0f;
     int numLoops = 0;
     const int MAX_IK_LOOPS = 16;
-    while (numLoops < MAX_IK_LOOPS) {
+    bool isLastLoop = false;
+    while (!isLastLoop) {
         ++numLoops;
+        isLastLoop = numLoops == MAX_IK_LOOPS || hasConverged;
 
-        bool debug = context.getEnableDebugDrawIKChains() && numLoops == MAX_IK_LOOPS;
+        bool debug = context.getEnableDebugDrawIKChains() && isLastLoop;
 
         // solve all targets
         for (size_t i = 0; i < targets.size(); i++) {
+            if (isTargetReached[i] && !debug) {
+                continue;
+            }
             switch (targets[i].getType()) {
             case IKTarget::Type::Unknown:
                 break;
@@ -258,7 +279,7 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
         }
         
         // on last iteration, interpolate jointChains, if necessary
-        if (numLoops == MAX_IK_LOOPS) {
+        if (isLastLoop) {
             for (size_t i = 0; i < _prevJointChainInfoVec.size(); i++) {
                 targetToChainMap.insert(std::pair<int, int>(_prevJointChainInfoVec[i].target.getIndex(), (int)i));
                 if (_prevJointChainInfoVec[i].timer > 0.0f) {
@@ -323,16 +344,22 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
         }
 
         // compute maxError
+        float prevMaxError = maxError;
         maxError = 0.0f;
+        bool areAllTargetsReached = true;
         for (size_t i = 0; i < targets.size(); i++) {
-            if (targets[i].getType() == IKTarget::Type::RotationAndPosition || targets[i].getType() == IKTarget::Type::HmdHead ||
-                targets[i].getType() == IKTarget::Type::HipsRelativeRotationAndPosition) {
-                float error = glm::length(absolutePoses[targets[i].getIndex()].trans() - targets[i].getTranslation());
+            if (hasPositionTarget(targets[i])) {
+                const AnimPose& tipPose = absolutePoses[targets[i].getIndex()];
+                float error = glm::length(tipPose.trans() - targets[i].getTranslation());
                 if (error > maxError) {
                     maxError = error;
                 }
+                isTargetReached[i] = error < MAX_REACHED_TARGET_ERROR &&
+                    fabsf(glm::dot(tipPose.rot(), targets[i].getRotation())) > MIN_REACHED_TARGET_COS_HALF_ANGLE;
+                areAllTargetsReached = areAllTargetsReached && isTargetReached[i];
             }
         }
+        hasConverged = areAllTargetsReached || (numLoops > 1 && prevMaxError - maxError < MIN_ERROR_IMPROVEMENT);
     }
     _maxErrorOnLastSolve = maxError;
 
@@ -13,6 +13,7 @@
 #include <glm/gtx/transform.hpp>
 
 #include <GLMHelpers.h>
+#include <RegisteredMetaTypes.h>
 
 #include "AnimationLogging.h"
 
@@ -294,6 +295,15 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<HFMJoint>& joints,
             _mirrorMap.push_back(i);
         }
     }
+
+    _hash = 0;
+    for (int i = 0; i < 4; i++) {
+        std::hash_combine(_hash, _geometryOffset[i].x, _geometryOffset[i].y, _geometryOffset[i].z, _geometryOffset[i].w);
+    }
+    for (int i = 0; i < _jointsSize; i++) {
+        const AnimPose& pose = _relativeDefaultPoses[i];
+        std::hash_combine(_hash, qHash(_joints[i].name), _parentIndices[i], pose.scale(), pose.rot(), pose.trans());
+    }
 }
 
 void AnimSkeleton::dump(bool verbose) const {
@@ -38,6 +38,9 @@ public:
     const AnimPoseVec& getAbsoluteDefaultPoses() const { return _absoluteDefaultPoses; }
     const glm::mat4& getGeometryOffset() const { return _geometryOffset; }
 
+    // the same for the skeletons built from the same joints, so that they can share what is computed for them
+    size_t getHash() const { return _hash; }
+
     // get pre transform which should include FBX pre potations
     const AnimPose& getPreRotationPose(int jointIndex) const;
 
@@ -86,6 +89,7 @@ protected:
     QHash<QString, int> _jointIndicesByName;
     std::vector<std::vector<HFMCluster>> _clusterBindMatrixOriginalValues;
     glm::mat4 _geometryOffset;
+    size_t _hash { 0 };
 
     // no copies
     AnimSkeleton(const AnimSkeleton&) = delete;
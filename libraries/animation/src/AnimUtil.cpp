@@ -13,9 +13,7 @@
 #include <NumericalConstants.h>
 #include <DebugDraw.h>
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
-void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+static void blend_ref(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
@@ -38,7 +36,8 @@ void blend3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPos
     }
 }
 
-void blend4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, const AnimPose* d, float* alphas, AnimPose* result) {
+static void blend4_ref(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, const AnimPose* d,
+        float* alphas, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
@@ -51,6 +50,49 @@ void blend4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPos
     }
 }
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+#include <CPUDetect.h>
+
+size_t blend_AVX2(size_t numPoses, const float (*a)[10], const float (*b)[10], float alpha, float (*result)[10]);
+size_t blend4_AVX2(size_t numPoses, const float (*a)[10], const float (*b)[10], const float (*c)[10], const float (*d)[10],
+    const float* alphas, float (*result)[10]);
+
+static_assert(sizeof(AnimPose) == 10 * sizeof(float), "AnimPose size doesn't match.");
+
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    size_t numBlended = 0;
+    if (_cpuSupportsAVX2) {
+        // the AVX2 code leaves the poses that don't fill a register to the reference code
+        numBlended = blend_AVX2(numPoses, (const float(*)[10])a, (const float(*)[10])b, alpha, (float(*)[10])result);
+    }
+    blend_ref(numPoses - numBlended, a + numBlended, b + numBlended, alpha, result + numBlended);
+}
+
+void blend4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, const AnimPose* d, float* alphas, AnimPose* result) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    size_t numBlended = 0;
+    if (_cpuSupportsAVX2) {
+        numBlended = blend4_AVX2(numPoses, (const float(*)[10])a, (const float(*)[10])b, (const float(*)[10])c,
+            (const float(*)[10])d, alphas, (float(*)[10])result);
+    }
+    blend4_ref(numPoses - numBlended, a + numBlended, b + numBlended, c + numBlended, d + numBlended, alphas,
+        result + numBlended);
+}
+
+#else   // portable reference code
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    blend_ref(numPoses, a, b, alpha, result);
+}
+
+void blend4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, const AnimPose* d, float* alphas, AnimPose* result) {
+    blend4_ref(numPoses, a, b, c, d, alphas, result);
+}
+#endif
+
 // additive blend
 void blendAdd(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
 
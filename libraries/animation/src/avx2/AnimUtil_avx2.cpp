@@ -0,0 +1,133 @@
+//
+//  AnimUtil_avx2.cpp
+//  libraries/animation/src/avx2
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stddef.h>
+#include <immintrin.h>
+
+// An AnimPose is 10 floats: the scale, the rotation and the translation. The poses are blended 8 at a time, with each of
+// their components gathered into a register, which makes the blend of all the components the same lerp, only the rotation
+// needs its sign adjusted first and normalizing after.
+static const int POSE_SIZE = 10;
+static const int ROT_OFFSET = 3;
+static const int ROT_SIZE = 4;
+
+static inline void gatherPoses(const float (*poses)[POSE_SIZE], __m256* components) {
+    const __m256i indices = _mm256_setr_epi32(0, 10, 20, 30, 40, 50, 60, 70);
+    for (int c = 0; c < POSE_SIZE; c++) {
+        components[c] = _mm256_i32gather_ps(&poses[0][c], indices, 4);
+    }
+}
+
+static inline void scatterPoses(const __m256* components, float (*poses)[POSE_SIZE]) {
+    alignas(32) float transposed[POSE_SIZE][8];
+    for (int c = 0; c < POSE_SIZE; c++) {
+        _mm256_store_ps(transposed[c], components[c]);
+    }
+    for (int j = 0; j < 8; j++) {
+        for (int c = 0; c < POSE_SIZE; c++) {
+            poses[j][c] = transposed[c][j];
+        }
+    }
+}
+
+static inline __m256 dotRotations(const __m256* a, const __m256* b) {
+    __m256 dot = _mm256_mul_ps(a[ROT_OFFSET], b[ROT_OFFSET]);
+    for (int c = ROT_OFFSET + 1; c < ROT_OFFSET + ROT_SIZE; c++) {
+        dot = _mm256_fmadd_ps(a[c], b[c], dot);
+    }
+    return dot;
+}
+
+// flips the rotations of b that aren't in the same hemisphere as those of a
+static inline void alignRotations(const __m256* a, __m256* b) {
+    __m256 sign = _mm256_and_ps(_mm256_cmp_ps(dotRotations(a, b), _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(-0.0f));
+    for (int c = ROT_OFFSET; c < ROT_OFFSET + ROT_SIZE; c++) {
+        b[c] = _mm256_xor_ps(b[c], sign);
+    }
+}
+
+// returns false, leaving the poses to the reference code, when one of the rotations can't be normalized
+static inline bool normalizeRotations(__m256* poses) {
+    __m256 lengthSquared = dotRotations(poses, poses);
+    if (_mm256_movemask_ps(_mm256_cmp_ps(lengthSquared, _mm256_setzero_ps(), _CMP_LE_OQ)) != 0) {
+        return false;
+    }
+    __m256 invLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSquared));
+    for (int c = ROT_OFFSET; c < ROT_OFFSET + ROT_SIZE; c++) {
+        poses[c] = _mm256_mul_ps(poses[c], invLength);
+    }
+    return true;
+}
+
+// returns the number of poses that were blended
+size_t blend_AVX2(size_t numPoses, const float (*a)[10], const float (*b)[10], float alpha, float (*result)[10]) {
+    const __m256 alphaA = _mm256_set1_ps(1.0f - alpha);
+    const __m256 alphaB = _mm256_set1_ps(alpha);
+
+    size_t i = 0;
+    for (; i + 8 <= numPoses; i += 8) {
+        __m256 aPoses[POSE_SIZE];
+        __m256 bPoses[POSE_SIZE];
+        gatherPoses(&a[i], aPoses);
+        gatherPoses(&b[i], bPoses);
+
+        alignRotations(aPoses, bPoses);
+        __m256 poses[POSE_SIZE];
+        for (int c = 0; c < POSE_SIZE; c++) {
+            poses[c] = _mm256_fmadd_ps(bPoses[c], alphaB, _mm256_mul_ps(aPoses[c], alphaA));
+        }
+        if (!normalizeRotations(poses)) {
+            break;
+        }
+        scatterPoses(poses, &result[i]);
+    }
+    return i;
+}
+
+// returns the number of poses that were blended
+size_t blend4_AVX2(size_t numPoses, const float (*a)[10], const float (*b)[10], const float (*c)[10], const float (*d)[10],
+        const float* alphas, float (*result)[10]) {
+    const __m256 alphaA = _mm256_set1_ps(alphas[0]);
+    const __m256 alphaB = _mm256_set1_ps(alphas[1]);
+    const __m256 alphaC = _mm256_set1_ps(alphas[2]);
+    const __m256 alphaD = _mm256_set1_ps(alphas[3]);
+
+    size_t i = 0;
+    for (; i + 8 <= numPoses; i += 8) {
+        __m256 aPoses[POSE_SIZE];
+        __m256 bPoses[POSE_SIZE];
+        __m256 cPoses[POSE_SIZE];
+        __m256 dPoses[POSE_SIZE];
+        gatherPoses(&a[i], aPoses);
+        gatherPoses(&b[i], bPoses);
+        gatherPoses(&c[i], cPoses);
+        gatherPoses(&d[i], dPoses);
+
+        alignRotations(aPoses, bPoses);
+        alignRotations(aPoses, cPoses);
+        alignRotations(aPoses, dPoses);
+        __m256 poses[POSE_SIZE];
+        for (int k = 0; k < POSE_SIZE; k++) {
+            __m256 pose = _mm256_mul_ps(aPoses[k], alphaA);
+            pose = _mm256_fmadd_ps(bPoses[k], alphaB, pose);
+            pose = _mm256_fmadd_ps(cPoses[k], alphaC, pose);
+            poses[k] = _mm256_fmadd_ps(dPoses[k], alphaD, pose);
+        }
+        if (!normalizeRotations(poses)) {
+            break;
+        }
+        scatterPoses(poses, &result[i]);
+    }
+    return i;
+}
+
+#endif
@@ -302,9 +302,6 @@ static inline float convertToFloat(int16_t sample) {
 
 AudioClient::AudioClient() {
 
-    // avoid putting a lock in the device callback
-    assert(_localSamplesAvailable.is_lock_free());
-
     // deprecate legacy settings
     {
         Setting::Handle<int>::Deprecated("maxFramesOverDesired", InboundAudioStream::MAX_FRAMES_OVER_DESIRED);
@@ -1482,12 +1479,11 @@ void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLoc
             localAudioLock->lock();
         }
 
-        // in case of a device switch, consider bufferCapacity volatile across iterations
+        // in case of a device switch, consider the buffer capacity volatile across iterations
         if (_outputPeriod == 0) {
             return;
         }
 
-        int bufferCapacity = _localInjectorsStream.getSampleCapacity();
         int maxOutputSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * AudioConstants::STEREO;
         if (_localToOutputResampler) {
             maxOutputSamples =
@@ -1495,7 +1491,7 @@ void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLoc
                 AudioConstants::STEREO;
         }
 
-        samplesNeeded = bufferCapacity - _localSamplesAvailable.load(std::memory_order_relaxed);
+        samplesNeeded = _localInjectorsStream.spaceAvailable();
         if (samplesNeeded < maxOutputSamples) {
             // avoid overwriting the buffer to prevent losing frames
             break;
@@ -1528,7 +1524,6 @@ void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLoc
                 AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
         }
 
-        _localSamplesAvailable.fetch_add(samples, std::memory_order_release);
         samplesNeeded -= samples;
     }
 }
@@ -2005,11 +2000,12 @@ void AudioClient::setHeadsetPluggedIn(bool pluggedIn) {
 
 void AudioClient::outputNotify() {
     int recentUnfulfilled = _audioOutputIODevice.getRecentUnfulfilledReads();
+    quint64 now = usecTimestampNow() / 1000;
     if (recentUnfulfilled > 0) {
         qCDebug(audioclient, "Starve detected, %d new unfulfilled reads", recentUnfulfilled);
+        _lastOutputStarveTimeMsec = now;
 
         if (_outputStarveDetectionEnabled.get()) {
-            quint64 now = usecTimestampNow() / 1000;
             int dt = (int)(now - _outputStarveDetectionStartTimeMsec);
             if (dt > STARVE_DETECTION_PERIOD) {
                 _outputStarveDetectionStartTimeMsec = now;
@@ -2030,6 +2026,11 @@ void AudioClient::outputNotify() {
                 }
             }
         }
+    } else if (_outputStarveDetectionEnabled.get() && _sessionOutputBufferSizeFrames > _outputBufferSizeFrames.get() &&
+            (int)(now - _lastOutputStarveTimeMsec) > STARVE_RECOVERY_PERIOD) {
+        // the output kept up for a while, so it can do with less latency
+        setOutputBufferSize(_sessionOutputBufferSizeFrames - 1, false);
+        _lastOutputStarveTimeMsec = now;
     }
 }
 
@@ -2050,7 +2051,6 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
     Lock lock(_deviceMutex);
 
     Lock localAudioLock(_localAudioMutex);
-    _localSamplesAvailable.exchange(0, std::memory_order_release);
 
     // cleanup any previously initialized device
     if (_audioOutput) {
@@ -2077,6 +2077,9 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
         _localOutputMixBuffer = NULL;
     }
 
+    // the device is stopped and the injectors are locked out, so neither end of the pipe is running
+    _localInjectorsStream.reset();
+
     // cleanup any resamplers
     if (_networkToOutputResampler) {
         delete _networkToOutputResampler;
@@ -2160,7 +2163,7 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
             // round up to an exact multiple of networkPeriod
             localPeriod = ((localPeriod + networkPeriod - 1) / networkPeriod) * networkPeriod;
             // this ensures lowest latency without stutter from underrun
-            _localInjectorsStream.resizeForFrameSize(localPeriod);
+            _localInjectorsStream.resize(localPeriod);
 
             _audioOutputInitialized = true;
 
@@ -2305,12 +2308,8 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
     int injectorSamplesPopped = 0;
     {
         bool append = networkSamplesPopped > 0;
-        // check the samples we have available locklessly; this is possible because only two functions add to the count:
-        // - prepareLocalAudioInjectors will only increase samples count
-        // - switchOutputToAudioDevice will zero samples count,
-        //   stop the device - so that readData will exhaust the existing buffer or see a zeroed samples count,
-        //   and start the device - which can then only see a zeroed samples count
-        int samplesAvailable = _audio->_localSamplesAvailable.load(std::memory_order_acquire);
+        // this end of the pipe only ever waits on prepareLocalAudioInjectors if it can take the lock right away
+        int samplesAvailable = _localInjectorsStream.samplesAvailable();
 
         // if we do not have enough samples buffered despite having injectors, buffer them synchronously
         if (samplesAvailable < samplesRequested && _audio->_localInjectorsAvailable.load(std::memory_order_acquire)) {
@@ -2318,13 +2317,12 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
             std::unique_ptr<Lock> localAudioLock(new Lock(_audio->_localAudioMutex, std::try_to_lock));
             if (localAudioLock->owns_lock()) {
                 _audio->prepareLocalAudioInjectors(std::move(localAudioLock));
-                samplesAvailable = _audio->_localSamplesAvailable.load(std::memory_order_acquire);
+                samplesAvailable = _localInjectorsStream.samplesAvailable();
             }
         }
 
         samplesRequested = std::min(samplesRequested, samplesAvailable);
         if ((injectorSamplesPopped = _localInjectorsStream.appendSamples(mixBuffer, samplesRequested, append)) > 0) {
-            _audio->_localSamplesAvailable.fetch_sub(injectorSamplesPopped, std::memory_order_release);
             qCDebug(audiostream, "Read %d samples from injectors (%d available, %d requested)", injectorSamplesPopped, _localInjectorsStream.samplesAvailable(), samplesRequested);
         }
     }
@@ -46,6 +46,7 @@
 #include <AudioLimiter.h>
 #include <AudioConstants.h>
 #include <AudioGate.h>
+#include <AudioSPSCRingBuffer.h>
 
 #include <shared/RateCounter.h>
 
@@ -87,7 +88,7 @@ class AudioClient : public AbstractAudioInterface, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
 
-    using LocalInjectorsStream = AudioMixRingBuffer;
+    using LocalInjectorsStream = AudioSPSCRingBuffer<float>;
 public:
     static const int MIN_BUFFER_FRAMES;
     static const int MAX_BUFFER_FRAMES;
@@ -302,6 +303,8 @@ private:
     static const int OUTPUT_CHANNEL_COUNT{ 2 };
     static const int STARVE_DETECTION_THRESHOLD{ 3 };
     static const int STARVE_DETECTION_PERIOD{ 10 * 1000 }; // 10 Seconds
+    // the output buffer gives back the frames the starves added one at a time, after this long without a starve
+    static const int STARVE_RECOVERY_PERIOD{ 60 * 1000 }; // 60 Seconds
 
     static const AudioPositionGetter DEFAULT_POSITION_GETTER;
     static const AudioOrientationGetter DEFAULT_ORIENTATION_GETTER;
@@ -368,10 +371,8 @@ private:
     QAudioOutput* _loopbackAudioOutput{ nullptr };
     QIODevice* _loopbackOutputDevice{ nullptr };
     AudioRingBuffer _inputRingBuffer{ 0 };
-    LocalInjectorsStream _localInjectorsStream{ 0 , 1 };
-    // In order to use _localInjectorsStream as a lock-free pipe,
-    // use it with a single producer/consumer, and track available samples and injectors
-    std::atomic<int> _localSamplesAvailable { 0 };
+    // a wait-free pipe from prepareLocalAudioInjectors, serialized by _localAudioMutex, to the device callback
+    LocalInjectorsStream _localInjectorsStream;
     std::atomic<bool> _localInjectorsAvailable { false };
     MixedProcessedAudioStream _receivedAudioStream{ RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES };
     bool _isStereoInput{ false };
@@ -379,6 +380,7 @@ private:
 
     quint64 _outputStarveDetectionStartTimeMsec{ 0 };
     int _outputStarveDetectionCount { 0 };
+    quint64 _lastOutputStarveTimeMsec{ 0 };
 
     Setting::Handle<int> _outputBufferSizeFrames{"audioOutputBufferFrames", DEFAULT_BUFFER_FRAMES};
     int _sessionOutputBufferSizeFrames{ _outputBufferSizeFrames.get() };
@@ -110,7 +110,8 @@ void AudioIOStats::publish() {
 
     // update the interface
     _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
-    _interface->updateClientStream(stats);
+    _interface->updateClientStream(stats, *_receivedAudioStream);
+    _interface->updateMouthToEar();
 
     // prepare a packet to the mixer
     int statsPacketSize = sizeof(appendFlag) + sizeof(numStreamStatsToPack) + sizeof(stats);
@@ -155,6 +156,12 @@ void AudioStreamStatsInterface::updateStream(const AudioStreamStats& stats) {
     timegapMsAvgWindow(stats._timeGapWindowAverage / USECS_PER_MSEC);
 }
 
+void AudioStreamStatsInterface::updateLocalStream(const InboundAudioStream& stream) {
+    timegapMsTarget(stream.getPercentileTimeGap() / USECS_PER_MSEC);
+    framesPredicted(stream.getPredictedJitterBufferFrames());
+    concealCount(stream.getConcealedFrames());
+}
+
 AudioStatsInterface::AudioStatsInterface(QObject* parent) :
     QObject(parent),
     _client(new AudioStreamStatsInterface(this)),
@@ -180,6 +187,12 @@ void AudioStatsInterface::updateLocalBuffers(const MovingMinMaxAvg<float>& input
     sentTimegapMsAvgWindow(timegaps.getWindowAverage() / USECS_PER_MSEC);
 }
 
+void AudioStatsInterface::updateMouthToEar() {
+    // our stream waits in the jitter buffer of the mixer and for its next mix, then the mix waits in our own jitter buffer
+    mouthToEarMs(inputUnplayedMsMax() + pingMs() + _mixer->unplayedMsMax() + AudioConstants::NETWORK_FRAME_MSECS +
+        _client->unplayedMsMax() + outputUnplayedMsMax());
+}
+
 void AudioStatsInterface::updateInjectorStreams(const QHash<QUuid, AudioStreamStats>& stats) {
     // Get existing injectors
     auto injectorIds = _injectors->dynamicPropertyNames();
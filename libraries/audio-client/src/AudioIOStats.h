@@ -20,6 +20,7 @@
 #include <Node.h>
 #include <NLPacket.h>
 
+class InboundAudioStream;
 class MixedProcessedAudioStream;
 
 #define AUDIO_PROPERTY(TYPE, NAME) \
@@ -62,6 +63,12 @@ class AudioStreamStatsInterface : public QObject {
      * @property {number} timegapMsAvg <em>Read-only.</em>
      * @property {number} timegapMsMaxWindow <em>Read-only.</em>
      * @property {number} timegapMsAvgWindow <em>Read-only.</em>
+     * @property {number} timegapMsTarget - The packet arrival gap the jitter buffer is sized to absorb. Only reported
+     *     for the client stream. <em>Read-only.</em>
+     * @property {number} framesPredicted - The jitter buffer frames needed to absorb that gap. Only reported for the
+     *     client stream. <em>Read-only.</em>
+     * @property {number} concealCount - The number of frames synthesized for lost or late packets. Only reported for the
+     *     client stream. <em>Read-only.</em>
      */
 
     /**jsdoc
@@ -176,8 +183,31 @@ class AudioStreamStatsInterface : public QObject {
      */
     AUDIO_PROPERTY(quint64, timegapMsAvgWindow)
 
+    /**jsdoc
+     * @function AudioStats.AudioStreamStats.timegapMsTargetChanged
+     * @param {number} timegapMsTarget
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(quint64, timegapMsTarget)
+
+    /**jsdoc
+     * @function AudioStats.AudioStreamStats.framesPredictedChanged
+     * @param {number} framesPredicted
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(int, framesPredicted)
+
+    /**jsdoc
+     * @function AudioStats.AudioStreamStats.concealCountChanged
+     * @param {number} concealCount
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(int, concealCount)
+
 public:
     void updateStream(const AudioStreamStats& stats);
+    // stats that aren't part of AudioStreamStats, so are only known where the stream is received
+    void updateLocalStream(const InboundAudioStream& stream);
 
 private:
     friend class AudioStatsInterface;
@@ -203,6 +233,9 @@ class AudioStatsInterface : public QObject {
      * @property {number} sentTimegapMsAvg <em>Read-only.</em>
      * @property {number} sentTimegapMsMaxWindow <em>Read-only.</em>
      * @property {number} sentTimegapMsAvgWindow <em>Read-only.</em>
+     * @property {number} mouthToEarMs - An estimate of the time from the microphone to the speakers through the audio mixer:
+     *     the input buffering, the round trip to the mixer, its jitter buffer and mix, the client jitter buffer and the
+     *     output buffering. <em>Read-only.</em>
      * @property {AudioStats.AudioStreamStats} clientStream <em>Read-only.</em>
      * @property {AudioStats.AudioStreamStats} mixerStream <em>Read-only.</em>
      */
@@ -265,6 +298,13 @@ class AudioStatsInterface : public QObject {
      */
     AUDIO_PROPERTY(quint64, sentTimegapMsAvgWindow);
 
+    /**jsdoc
+     * @function AudioStats.mouthToEarMsChanged
+     * @param {number} mouthToEarMs
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(float, mouthToEarMs);
+
     Q_PROPERTY(AudioStreamStatsInterface* mixerStream READ getMixerStream NOTIFY mixerStreamChanged);
     Q_PROPERTY(AudioStreamStatsInterface* clientStream READ getClientStream NOTIFY clientStreamChanged);
 
@@ -282,7 +322,13 @@ public:
                             const MovingMinMaxAvg<quint64>& timegaps);
     void updateMixerStream(const AudioStreamStats& stats) { _mixer->updateStream(stats); emit mixerStreamChanged(); }
     void updateClientStream(const AudioStreamStats& stats) { _client->updateStream(stats); emit clientStreamChanged(); }
+    void updateClientStream(const AudioStreamStats& stats, const InboundAudioStream& stream) {
+        _client->updateStream(stats);
+        _client->updateLocalStream(stream);
+        emit clientStreamChanged();
+    }
     void updateInjectorStreams(const QHash<QUuid, AudioStreamStats>& stats);
+    void updateMouthToEar();
 
 signals:
 
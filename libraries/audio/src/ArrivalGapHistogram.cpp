@@ -0,0 +1,48 @@
+//
+//  ArrivalGapHistogram.cpp
+//  libraries/audio/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ArrivalGapHistogram.h"
+
+#include <algorithm>
+
+void ArrivalGapHistogram::reset() {
+    _bins.fill(0.0f);
+    _weight = 0.0f;
+}
+
+void ArrivalGapHistogram::addGap(quint64 gapUsecs) {
+    int bin = (int)std::min(gapUsecs / BIN_USECS, (quint64)(NUM_BINS - 1));
+    _bins[bin] += 1.0f;
+    _weight += 1.0f;
+}
+
+void ArrivalGapHistogram::decay(float factor) {
+    for (auto& count : _bins) {
+        count *= factor;
+    }
+    _weight *= factor;
+}
+
+quint64 ArrivalGapHistogram::getPercentileGap(float percentile) const {
+    if (_weight <= 0.0f) {
+        return 0;
+    }
+
+    // walk down from the longest gaps, which keeps the rounding error of the decayed counts out of the tail
+    float tailWeight = (1.0f - percentile) * _weight;
+    float weightAbove = 0.0f;
+    for (int bin = NUM_BINS - 1; bin > 0; --bin) {
+        weightAbove += _bins[bin];
+        if (weightAbove > tailWeight) {
+            return (quint64)(bin + 1) * BIN_USECS;
+        }
+    }
+    return BIN_USECS;
+}
@@ -0,0 +1,44 @@
+//
+//  ArrivalGapHistogram.h
+//  libraries/audio/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ArrivalGapHistogram_h
+#define hifi_ArrivalGapHistogram_h
+
+#include <array>
+
+#include <QtGlobal>
+
+// Histogram of the time gaps between packet arrivals, used to size a jitter buffer from a percentile of the gaps
+// rather than from the single worst gap in a window. Counts are decayed, so the estimate follows a link that gets
+// better as quickly as one that gets worse.
+class ArrivalGapHistogram {
+public:
+    static const int BIN_USECS = 1000;
+    static const int NUM_BINS = 256; // longer gaps are counted in the last bin
+
+    void reset();
+
+    void addGap(quint64 gapUsecs);
+
+    // scales every count by factor, expected to be called at a fixed rate
+    void decay(float factor);
+
+    // the weighted number of gaps in the histogram
+    float getWeight() const { return _weight; }
+
+    // upper edge of the bin holding the gap at this percentile (0 to 1), 0 when empty
+    quint64 getPercentileGap(float percentile) const;
+
+private:
+    std::array<float, NUM_BINS> _bins {};
+    float _weight { 0.0f };
+};
+
+#endif // hifi_ArrivalGapHistogram_h
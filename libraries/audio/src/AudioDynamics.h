@@ -54,6 +54,14 @@ FORCEINLINE static int32_t floatToInt(float x) {
     return _mm_cvt_ss2si(_mm_set_ss(x));
 }
 
+#elif defined(__aarch64__)
+
+#include <arm_neon.h>
+// convert float to int using round-to-nearest
+FORCEINLINE static int32_t floatToInt(float x) {
+    return vcvtns_s32_f32(x);
+}
+
 #else 
 
 // convert float to int using round-to-nearest
@@ -275,6 +283,10 @@ FORCEINLINE static int CLZ(uint32_t u) {
         return 32;
     }
 
+#if (defined(__arm__) || defined(__aarch64__)) && defined(__GNUC__)
+    // a single instruction on ARM, where the emulation costs a branch per step
+    return __builtin_clz(u);
+#else
     int e = 0;
     if (u < 0x00010000) {
         u <<= 16;
@@ -296,6 +308,7 @@ FORCEINLINE static int CLZ(uint32_t u) {
         e += 1;
     }
     return e;
+#endif
 }
 
 //
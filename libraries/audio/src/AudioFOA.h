@@ -40,7 +40,15 @@ public:
     //
     void render(int16_t* input, float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames);
 
+    //
+    // input: deinterleaved First-Order Ambisonic source, as float W, X, Y, Z in B-format (FuMa) normalization
+    // the rest as above
+    //
+    void render(const float* const input[4], float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames);
+
 private:
+    void renderBFormat(float* in[4], float* output, int index, float qw, float qx, float qy, float qz, float gain);
+
     AudioFOA(const AudioFOA&) = delete;
     AudioFOA& operator=(const AudioFOA&) = delete;
 
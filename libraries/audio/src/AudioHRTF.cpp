@@ -476,6 +476,197 @@ static void interpolate(const float* src0, const float* src1, float* dst, float
     (*f)(src0, src1, dst, frac, gain); // dispatch
 }
 
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+// 1 channel input, 4 channel output
+static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t acc0 = vdupq_n_f32(0);
+        float32x4_t acc1 = vdupq_n_f32(0);
+        float32x4_t acc2 = vdupq_n_f32(0);
+        float32x4_t acc3 = vdupq_n_f32(0);
+
+        float* ps = &src[i - HRTF_TAPS + 1];    // process forwards
+
+        static_assert(HRTF_TAPS % 4 == 0, "HRTF_TAPS must be a multiple of 4");
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            float32x4_t x0 = vld1q_f32(&ps[k+0]);
+            acc0 = vmlaq_n_f32(acc0, x0, coef0[-k-0]);
+            acc1 = vmlaq_n_f32(acc1, x0, coef1[-k-0]);
+            acc2 = vmlaq_n_f32(acc2, x0, coef2[-k-0]);
+            acc3 = vmlaq_n_f32(acc3, x0, coef3[-k-0]);
+
+            float32x4_t x1 = vld1q_f32(&ps[k+1]);
+            acc0 = vmlaq_n_f32(acc0, x1, coef0[-k-1]);
+            acc1 = vmlaq_n_f32(acc1, x1, coef1[-k-1]);
+            acc2 = vmlaq_n_f32(acc2, x1, coef2[-k-1]);
+            acc3 = vmlaq_n_f32(acc3, x1, coef3[-k-1]);
+
+            float32x4_t x2 = vld1q_f32(&ps[k+2]);
+            acc0 = vmlaq_n_f32(acc0, x2, coef0[-k-2]);
+            acc1 = vmlaq_n_f32(acc1, x2, coef1[-k-2]);
+            acc2 = vmlaq_n_f32(acc2, x2, coef2[-k-2]);
+            acc3 = vmlaq_n_f32(acc3, x2, coef3[-k-2]);
+
+            float32x4_t x3 = vld1q_f32(&ps[k+3]);
+            acc0 = vmlaq_n_f32(acc0, x3, coef0[-k-3]);
+            acc1 = vmlaq_n_f32(acc1, x3, coef1[-k-3]);
+            acc2 = vmlaq_n_f32(acc2, x3, coef2[-k-3]);
+            acc3 = vmlaq_n_f32(acc3, x3, coef3[-k-3]);
+        }
+
+        vst1q_f32(&dst0[i], acc0);
+        vst1q_f32(&dst1[i], acc1);
+        vst1q_f32(&dst2[i], acc2);
+        vst1q_f32(&dst3[i], acc3);
+    }
+}
+
+// 4 channel planar to interleaved
+static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4x4_t x;
+        x.val[0] = vld1q_f32(&src0[i]);
+        x.val[1] = vld1q_f32(&src1[i]);
+        x.val[2] = vld1q_f32(&src2[i]);
+        x.val[3] = vld1q_f32(&src3[i]);
+
+        // interleaving store
+        vst4q_f32(&dst[4*i], x);
+    }
+}
+
+// process 2 cascaded biquads on 4 channels (interleaved)
+// biquads computed in parallel, by adding one sample of delay
+static void biquad2_4x4(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames) {
+
+#if defined(__aarch64__)
+    // enable flush-to-zero mode to prevent denormals (always on for 32-bit NEON)
+    uint64_t fpcr;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | (1 << 24)));
+#endif
+
+    // restore state
+    float32x4_t y00 = vld1q_f32(&state[0][0]);
+    float32x4_t w10 = vld1q_f32(&state[1][0]);
+    float32x4_t w20 = vld1q_f32(&state[2][0]);
+
+    float32x4_t y01;
+    float32x4_t w11 = vld1q_f32(&state[1][4]);
+    float32x4_t w21 = vld1q_f32(&state[2][4]);
+
+    // first biquad coefs
+    float32x4_t b00 = vld1q_f32(&coef[0][0]);
+    float32x4_t b10 = vld1q_f32(&coef[1][0]);
+    float32x4_t b20 = vld1q_f32(&coef[2][0]);
+    float32x4_t a10 = vld1q_f32(&coef[3][0]);
+    float32x4_t a20 = vld1q_f32(&coef[4][0]);
+
+    // second biquad coefs
+    float32x4_t b01 = vld1q_f32(&coef[0][4]);
+    float32x4_t b11 = vld1q_f32(&coef[1][4]);
+    float32x4_t b21 = vld1q_f32(&coef[2][4]);
+    float32x4_t a11 = vld1q_f32(&coef[3][4]);
+    float32x4_t a21 = vld1q_f32(&coef[4][4]);
+
+    for (int i = 0; i < numFrames; i++) {
+
+        float32x4_t x00 = vld1q_f32(&src[4*i]);
+        float32x4_t x01 = y00;  // first biquad output
+
+        // transposed Direct Form II
+        y00 = vmlaq_f32(w10, x00, b00);
+        y01 = vmlaq_f32(w11, x01, b01);
+
+        w10 = vmlaq_f32(w20, x00, b10);
+        w11 = vmlaq_f32(w21, x01, b11);
+
+        w20 = vmulq_f32(x00, b20);
+        w21 = vmulq_f32(x01, b21);
+
+        w10 = vmlsq_f32(w10, y00, a10);
+        w11 = vmlsq_f32(w11, y01, a11);
+
+        w20 = vmlsq_f32(w20, y00, a20);
+        w21 = vmlsq_f32(w21, y01, a21);
+
+        vst1q_f32(&dst[4*i], y01);  // second biquad output
+    }
+
+    // save state
+    vst1q_f32(&state[0][0], y00);
+    vst1q_f32(&state[1][0], w10);
+    vst1q_f32(&state[2][0], w20);
+
+    vst1q_f32(&state[1][4], w11);
+    vst1q_f32(&state[2][4], w21);
+
+#if defined(__aarch64__)
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+#endif
+}
+
+// crossfade 4 inputs into 2 outputs with accumulation (interleaved)
+static void crossfade_4x2(float* src, float* dst, const float* win, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t f0 = vld1q_f32(&win[i]);
+
+        // deinterleaving loads
+        float32x4x4_t x = vld4q_f32(&src[4*i]);
+        float32x4x2_t y = vld2q_f32(&dst[2*i]);
+
+        // crossfade
+        float32x4_t x0 = vmlaq_f32(x.val[2], f0, vsubq_f32(x.val[0], x.val[2]));
+        float32x4_t x1 = vmlaq_f32(x.val[3], f0, vsubq_f32(x.val[1], x.val[3]));
+
+        // accumulate and interleave
+        y.val[0] = vaddq_f32(y.val[0], x0);
+        y.val[1] = vaddq_f32(y.val[1], x1);
+        vst2q_f32(&dst[2*i], y);
+    }
+}
+
+// linear interpolation with gain
+static void interpolate(const float* src0, const float* src1, float* dst, float frac, float gain) {
+
+    float32x4_t f0 = vdupq_n_f32(gain * (1.0f - frac));
+    float32x4_t f1 = vdupq_n_f32(gain * frac);
+
+    static_assert(HRTF_TAPS % 4 == 0, "HRTF_TAPS must be a multiple of 4");
+
+    for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+        float32x4_t x0 = vld1q_f32(&src0[k]);
+        float32x4_t x1 = vld1q_f32(&src1[k]);
+
+        x0 = vmlaq_f32(vmulq_f32(f0, x0), f1, x1);
+
+        vst1q_f32(&dst[k], x0);
+    }
+}
+
 #else   // portable reference code
 
 // 1 channel input, 4 channel output
@@ -750,6 +941,147 @@ static void interpolate(const float* src0, const float* src1, float* dst, float
 
 #endif
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+// apply gain crossfade with accumulation (interleaved)
+static void gainfade_1x2_SSE(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m128 g1 = _mm_set1_ps(gain1 * (1/32768.0f));  // int16_t to float
+    __m128 gd = _mm_set1_ps((gain0 - gain1) * (1/32768.0f));
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 f0 = _mm_loadu_ps(&win[i]);
+        __m128 g0 = _mm_add_ps(g1, _mm_mul_ps(f0, gd));
+
+        // sign-extend int16_t to int32_t
+        __m128i a0 = _mm_loadl_epi64((__m128i*)&src[i]);
+        a0 = _mm_srai_epi32(_mm_unpacklo_epi16(a0, a0), 16);
+
+        __m128 x0 = _mm_mul_ps(_mm_cvtepi32_ps(a0), g0);
+
+        __m128 y0 = _mm_loadu_ps(&dst[2*i+0]);
+        __m128 y1 = _mm_loadu_ps(&dst[2*i+4]);
+
+        // duplicate to stereo and accumulate
+        y0 = _mm_add_ps(y0, _mm_unpacklo_ps(x0, x0));
+        y1 = _mm_add_ps(y1, _mm_unpackhi_ps(x0, x0));
+
+        _mm_storeu_ps(&dst[2*i+0], y0);
+        _mm_storeu_ps(&dst[2*i+4], y1);
+    }
+}
+
+// apply gain crossfade with accumulation (interleaved)
+static void gainfade_2x2_SSE(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m128 g1 = _mm_set1_ps(gain1 * (1/32768.0f));  // int16_t to float
+    __m128 gd = _mm_set1_ps((gain0 - gain1) * (1/32768.0f));
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 f0 = _mm_loadu_ps(&win[i]);
+        __m128 g0 = _mm_add_ps(g1, _mm_mul_ps(f0, gd));
+
+        // sign-extend int16_t to int32_t
+        __m128i a0 = _mm_loadu_si128((__m128i*)&src[2*i]);
+        __m128i a1 = _mm_srai_epi32(_mm_unpackhi_epi16(a0, a0), 16);
+        a0 = _mm_srai_epi32(_mm_unpacklo_epi16(a0, a0), 16);
+
+        // same gain for both channels of a frame
+        __m128 x0 = _mm_mul_ps(_mm_cvtepi32_ps(a0), _mm_unpacklo_ps(g0, g0));
+        __m128 x1 = _mm_mul_ps(_mm_cvtepi32_ps(a1), _mm_unpackhi_ps(g0, g0));
+
+        __m128 y0 = _mm_loadu_ps(&dst[2*i+0]);
+        __m128 y1 = _mm_loadu_ps(&dst[2*i+4]);
+
+        // accumulate
+        y0 = _mm_add_ps(y0, x0);
+        y1 = _mm_add_ps(y1, x1);
+
+        _mm_storeu_ps(&dst[2*i+0], y0);
+        _mm_storeu_ps(&dst[2*i+4], y1);
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void gainfade_1x2_AVX2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+void gainfade_2x2_AVX2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+void gainfade_1x2_AVX512(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+void gainfade_2x2_AVX512(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+
+static void gainfade_1x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    static auto f = cpuSupportsAVX512() ? gainfade_1x2_AVX512 : (cpuSupportsAVX2() ? gainfade_1x2_AVX2 : gainfade_1x2_SSE);
+    (*f)(src, dst, win, gain0, gain1, numFrames);  // dispatch
+}
+
+static void gainfade_2x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    static auto f = cpuSupportsAVX512() ? gainfade_2x2_AVX512 : (cpuSupportsAVX2() ? gainfade_2x2_AVX2 : gainfade_2x2_SSE);
+    (*f)(src, dst, win, gain0, gain1, numFrames);  // dispatch
+}
+
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+// apply gain crossfade with accumulation (interleaved)
+static void gainfade_1x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    float32x4_t g1 = vdupq_n_f32(gain1 * (1/32768.0f));  // int16_t to float
+    float32x4_t gd = vdupq_n_f32((gain0 - gain1) * (1/32768.0f));
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t g0 = vmlaq_f32(g1, vld1q_f32(&win[i]), gd);
+
+        float32x4_t x0 = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(&src[i]))), g0);
+
+        // deinterleave, accumulate the same sample into both channels, interleave
+        float32x4x2_t y = vld2q_f32(&dst[2*i]);
+        y.val[0] = vaddq_f32(y.val[0], x0);
+        y.val[1] = vaddq_f32(y.val[1], x0);
+        vst2q_f32(&dst[2*i], y);
+    }
+}
+
+// apply gain crossfade with accumulation (interleaved)
+static void gainfade_2x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    float32x4_t g1 = vdupq_n_f32(gain1 * (1/32768.0f));  // int16_t to float
+    float32x4_t gd = vdupq_n_f32((gain0 - gain1) * (1/32768.0f));
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t g0 = vmlaq_f32(g1, vld1q_f32(&win[i]), gd);
+
+        // deinterleave
+        int16x4x2_t a = vld2_s16(&src[2*i]);
+        float32x4_t x0 = vmulq_f32(vcvtq_f32_s32(vmovl_s16(a.val[0])), g0);
+        float32x4_t x1 = vmulq_f32(vcvtq_f32_s32(vmovl_s16(a.val[1])), g0);
+
+        // accumulate and interleave
+        float32x4x2_t y = vld2q_f32(&dst[2*i]);
+        y.val[0] = vaddq_f32(y.val[0], x0);
+        y.val[1] = vaddq_f32(y.val[1], x1);
+        vst2q_f32(&dst[2*i], y);
+    }
+}
+
+#else   // portable reference code
+
 // apply gain crossfade with accumulation (interleaved)
 static void gainfade_1x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
 
@@ -787,6 +1119,8 @@ static void gainfade_2x2(int16_t* src, float* dst, const float* win, float gain0
     }
 }
 
+#endif
+
 // design a 2nd order Thiran allpass
 static void ThiranBiquad(float f, float& b0, float& b1, float& b2, float& a1, float& a2) {
 
@@ -14,6 +14,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDataStream>
 
+#include <NetworkingConstants.h>
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
@@ -29,6 +30,13 @@
 int metaType = qRegisterMetaType<AudioInjectorPointer>("AudioInjectorPointer");
 
 AbstractAudioInterface* AudioInjector::_localAudioInterface{ nullptr };
+bool AudioInjector::_hostedInjectionEnabled{ false };
+
+// the mixer only resolves URLs it can reach the same way we do
+static bool canMixerFetch(const QUrl& url) {
+    auto scheme = url.scheme();
+    return scheme == HIFI_URL_SCHEME_HTTP || scheme == HIFI_URL_SCHEME_HTTPS || scheme == URL_SCHEME_ATP;
+}
 
 AudioInjectorState operator& (AudioInjectorState lhs, AudioInjectorState rhs) {
     return static_cast<AudioInjectorState>(static_cast<uint8_t>(lhs) & static_cast<uint8_t>(rhs));
@@ -135,6 +143,10 @@ bool AudioInjector::inject(bool(AudioInjectorManager::*injection)(const AudioInj
     withWriteLock([&] {
         _state = AudioInjectorState::NotFinished;
         options = _options;
+
+        // pitched sounds are resampled here, so only the sound as the mixer caches it can be hosted
+        _isHosted = _hostedInjectionEnabled && _sound && !options.localOnly && !options.ambisonic &&
+            canMixerFetch(_sound->getURL());
     });
 
     int byteOffset = 0;
@@ -223,6 +235,10 @@ int64_t AudioInjector::injectNextFrame() {
         return _options;
     });
 
+    if (_isHosted) {
+        return injectNextHostedFrame(options);
+    }
+
     if (!_currentPacket) {
         if (_currentSendOffset < 0 ||
             _currentSendOffset >= (int)_audioData->getNumBytes()) {
@@ -405,15 +421,107 @@ int64_t AudioInjector::injectNextFrame() {
     return std::max(INT64_C(0), playNextFrameAt - currentTime);
 }
 
+// how often a hosted injector checks for option changes to forward to the mixer
+static const int64_t HOSTED_INJECTOR_UPDATE_USECS = 5 * AudioConstants::NETWORK_FRAME_USECS;
+
+int64_t AudioInjector::injectNextHostedFrame(const AudioInjectorOptions& options) {
+    int numBytes = (int)_audioData->getNumBytes();
+    if (numBytes == 0) {
+        qCDebug(audio) << "AudioInjector::injectNextHostedFrame() called with no samples to inject. Returning.";
+        return NEXT_FRAME_DELTA_ERROR_OR_FINISHED;
+    }
+
+    if (!_frameTimer) {
+        _frameTimer = std::unique_ptr<QElapsedTimer>(new QElapsedTimer);
+    }
+
+    if (!_hasSentFirstFrame || !_frameTimer->isValid()) {
+        if (_currentSendOffset < 0 || _currentSendOffset >= numBytes) {
+            _currentSendOffset = 0;
+        }
+        _hostedStartOffset = _currentSendOffset;
+        _frameTimer->restart();
+
+        sendHostedInjectorPacket(HostedInjectorCommand::Start, options);
+        _hasSentFirstFrame = true;
+    } else if (options.position != _hostedPosition || options.orientation != _hostedOrientation ||
+               options.volume != _hostedVolume) {
+        sendHostedInjectorPacket(HostedInjectorCommand::Update, options);
+    }
+
+    // follow the mixer's play position so that finishing and loudness behave as they do when streaming
+    int frameBytes = (options.stereo ? 2 : 1) * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
+    int64_t elapsedFrames = _frameTimer->nsecsElapsed() / 1000 / AudioConstants::NETWORK_FRAME_USECS;
+    int64_t playedBytes = _hostedStartOffset + elapsedFrames * frameBytes;
+
+    if (!options.loop && playedBytes >= numBytes) {
+        finishNetworkInjection();
+        return NEXT_FRAME_DELTA_ERROR_OR_FINISHED;
+    }
+    _currentSendOffset = (int)(playedBytes % numBytes);
+
+    auto samples = _audioData->data();
+    auto currentSample = _currentSendOffset / AudioConstants::SAMPLE_SIZE;
+    auto samplesInFrame = frameBytes / AudioConstants::SAMPLE_SIZE;
+
+    withWriteLock([&] {
+        _loudness = 0.0f;
+        for (int i = 0; i < samplesInFrame; ++i) {
+            auto sample = samples[(currentSample + i) % _audioData->getNumSamples()];
+            _loudness += abs(sample) / (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
+        }
+        _loudness /= (float)samplesInFrame;
+    });
+
+    return HOSTED_INJECTOR_UPDATE_USECS;
+}
+
+void AudioInjector::sendHostedInjectorPacket(HostedInjectorCommand command, const AudioInjectorOptions& options) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (!audioMixer) {
+        return;
+    }
+
+    // a lost start would leave the sound unplayed, a lost update is superseded by the next one
+    bool isStart = command == HostedInjectorCommand::Start;
+    auto controlPacket = NLPacket::create(PacketType::HostedInjectorControl, -1, isStart);
+
+    controlPacket->write(_streamID.toRfc4122());
+    controlPacket->writePrimitive(command);
+    controlPacket->writePrimitive(options.position);
+    controlPacket->writePrimitive(options.orientation);
+    controlPacket->writePrimitive(packFloatGainToByte(options.volume));
+
+    if (isStart) {
+        controlPacket->writePrimitive(options.stereo);
+        controlPacket->writePrimitive(options.loop);
+        controlPacket->writePrimitive(options.ignorePenumbra);
+        controlPacket->writePrimitive((quint32)_currentSendOffset);
+        controlPacket->writeString(_sound->getURL().toString());
+
+        nodeList->sendPacket(std::move(controlPacket), *audioMixer);
+    } else {
+        nodeList->sendUnreliablePacket(*controlPacket, *audioMixer);
+    }
+
+    _hostedPosition = options.position;
+    _hostedOrientation = options.orientation;
+    _hostedVolume = options.volume;
+}
 
 void AudioInjector::sendStopInjectorPacket() {
     auto nodeList = DependencyManager::get<NodeList>();
     if (auto audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer)) {
-        // Build packet
-        auto stopInjectorPacket = NLPacket::create(PacketType::StopInjector);
+        // Build packet, a hosted injector keeps playing on the mixer until this arrives so it can't be lost
+        auto stopInjectorPacket = NLPacket::create(PacketType::StopInjector, -1, _isHosted);
         stopInjectorPacket->write(_streamID.toRfc4122());
 
         // Send packet
-        nodeList->sendUnreliablePacket(*stopInjectorPacket, *audioMixer);
+        if (_isHosted) {
+            nodeList->sendPacket(std::move(stopInjectorPacket), *audioMixer);
+        } else {
+            nodeList->sendUnreliablePacket(*stopInjectorPacket, *audioMixer);
+        }
     }
 }
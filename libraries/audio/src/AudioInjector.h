@@ -30,6 +30,7 @@
 #include "AudioInjectorOptions.h"
 #include "AudioHRTF.h"
 #include "AudioFOA.h"
+#include "InjectedAudioStream.h"
 #include "Sound.h"
 
 class AbstractAudioInterface;
@@ -84,6 +85,10 @@ public:
     bool stateHas(AudioInjectorState state) const ;
     static void setLocalAudioInterface(AbstractAudioInterface* audioInterface) { _localAudioInterface = audioInterface; }
 
+    // when enabled, injectors playing a sound the audio mixer can fetch itself only send it control packets,
+    // the mixer plays the sound from its own cache instead of receiving every frame
+    static void setHostedInjectionEnabled(bool enabled) { _hostedInjectionEnabled = enabled; }
+
     void restart();
     void finish();
 
@@ -102,7 +107,11 @@ private:
     bool injectLocally();
     void sendStopInjectorPacket();
 
+    int64_t injectNextHostedFrame(const AudioInjectorOptions& options);
+    void sendHostedInjectorPacket(HostedInjectorCommand command, const AudioInjectorOptions& options);
+
     static AbstractAudioInterface* _localAudioInterface;
+    static bool _hostedInjectionEnabled;
 
     const SharedSoundPointer _sound;
     AudioDataPointer _audioData;
@@ -118,6 +127,13 @@ private:
     std::unique_ptr<QElapsedTimer> _frameTimer { nullptr };
     quint16 _outgoingSequenceNumber { 0 };
 
+    // when hosted, the mixer plays the sound and we only track where it is up to
+    bool _isHosted { false };
+    int _hostedStartOffset { 0 };
+    glm::vec3 _hostedPosition;
+    glm::quat _hostedOrientation;
+    float _hostedVolume { 0.0f };
+
     // when the injector is local, we need this
     AudioHRTF _localHRTF;
     AudioFOA _localFOA;
@@ -0,0 +1,146 @@
+//
+//  AudioSPSCRingBuffer.h
+//  libraries/audio/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSPSCRingBuffer_h
+#define hifi_AudioSPSCRingBuffer_h
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+// A wait-free ring buffer for exactly one producer thread and one consumer thread, such as a device callback that
+// must never block on a thread that can be preempted while holding a lock.
+//
+// Unlike AudioRingBufferTemplate it never overwrites: writes are clipped to the free space and reads to the samples
+// available. Only the producer may call writeSamples(), only the consumer may call readSamples(), appendSamples()
+// and skipSamples(). resize() and reset() must only be called while neither side is running.
+template <class T>
+class AudioSPSCRingBuffer {
+public:
+    using Sample = T;
+    static const int SampleSize = sizeof(Sample);
+
+    AudioSPSCRingBuffer(int sampleCapacity = 0) { resize(sampleCapacity); }
+
+    AudioSPSCRingBuffer(const AudioSPSCRingBuffer&) = delete;
+    AudioSPSCRingBuffer& operator=(const AudioSPSCRingBuffer&) = delete;
+
+    // not thread-safe, discards everything buffered
+    void resize(int sampleCapacity) {
+        // the storage is rounded up to a power of two so that the free-running indices can be masked
+        uint32_t bufferLength = 1;
+        while (bufferLength < (uint32_t)sampleCapacity) {
+            bufferLength <<= 1;
+        }
+        _buffer.reset(new Sample[bufferLength]);
+        _mask = bufferLength - 1;
+        _sampleCapacity = sampleCapacity;
+        reset();
+    }
+
+    // not thread-safe
+    void reset() {
+        _writeIndex.store(0, std::memory_order_relaxed);
+        _readIndex.store(0, std::memory_order_relaxed);
+    }
+
+    int getSampleCapacity() const { return _sampleCapacity; }
+
+    // safe from either side, exact on the calling side and a lower bound of what the other side will see
+    int samplesAvailable() const {
+        return (int)(_writeIndex.load(std::memory_order_acquire) - _readIndex.load(std::memory_order_acquire));
+    }
+    int spaceAvailable() const { return _sampleCapacity - samplesAvailable(); }
+
+    // producer only, returns the number of samples written
+    int writeSamples(const Sample* source, int maxSamples) {
+        uint32_t writeIndex = _writeIndex.load(std::memory_order_relaxed);
+        uint32_t readIndex = _readIndex.load(std::memory_order_acquire);
+        int numSamples = std::min(maxSamples, _sampleCapacity - (int)(writeIndex - readIndex));
+        if (numSamples <= 0) {
+            return 0;
+        }
+
+        uint32_t at = writeIndex & _mask;
+        int samplesToEnd = std::min(numSamples, (int)(_mask + 1 - at));
+        memcpy(&_buffer[at], source, samplesToEnd * SampleSize);
+        memcpy(&_buffer[0], source + samplesToEnd, (numSamples - samplesToEnd) * SampleSize);
+
+        // publish the samples
+        _writeIndex.store(writeIndex + numSamples, std::memory_order_release);
+        return numSamples;
+    }
+
+    // consumer only, returns the number of samples read
+    int readSamples(Sample* destination, int maxSamples) {
+        return consume(maxSamples, [&](const Sample* source, int offset, int numSamples) {
+            memcpy(destination + offset, source, numSamples * SampleSize);
+        });
+    }
+
+    // consumer only, like readSamples() but adds into the destination when append is set
+    int appendSamples(Sample* destination, int maxSamples, bool append = true) {
+        if (!append) {
+            return readSamples(destination, maxSamples);
+        }
+        return consume(maxSamples, [&](const Sample* source, int offset, int numSamples) {
+            for (int i = 0; i < numSamples; i++) {
+                destination[offset + i] += source[i];
+            }
+        });
+    }
+
+    // consumer only, returns the number of samples skipped
+    int skipSamples(int maxSamples) {
+        return consume(maxSamples, [](const Sample*, int, int) {});
+    }
+
+private:
+    template <typename F>
+    int consume(int maxSamples, F&& f) {
+        uint32_t readIndex = _readIndex.load(std::memory_order_relaxed);
+        uint32_t writeIndex = _writeIndex.load(std::memory_order_acquire);
+        int numSamples = std::min(maxSamples, (int)(writeIndex - readIndex));
+        if (numSamples <= 0) {
+            return 0;
+        }
+
+        uint32_t at = readIndex & _mask;
+        int samplesToEnd = std::min(numSamples, (int)(_mask + 1 - at));
+        f(&_buffer[at], 0, samplesToEnd);
+        if (numSamples > samplesToEnd) {
+            f(&_buffer[0], samplesToEnd, numSamples - samplesToEnd);
+        }
+
+        // hand the space back to the producer
+        _readIndex.store(readIndex + numSamples, std::memory_order_release);
+        return numSamples;
+    }
+
+    // each index lives on its own cache line so that the two sides don't invalidate each other's on every access
+    // (padded rather than aligned, as over-aligned heap allocation isn't available before C++17)
+    static const int CACHE_LINE_SIZE = 64;
+
+    char _leadingPad[CACHE_LINE_SIZE];
+    std::atomic<uint32_t> _writeIndex { 0 }; // free-running, masked on access
+    char _writePad[CACHE_LINE_SIZE - sizeof(std::atomic<uint32_t>)];
+    std::atomic<uint32_t> _readIndex { 0 }; // free-running, masked on access
+    char _readPad[CACHE_LINE_SIZE - sizeof(std::atomic<uint32_t>)];
+
+    // read by both sides, written only by resize()
+    std::unique_ptr<Sample[]> _buffer;
+    uint32_t _mask { 0 };
+    int _sampleCapacity { 0 };
+};
+
+#endif // hifi_AudioSPSCRingBuffer_h
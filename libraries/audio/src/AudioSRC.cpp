@@ -1182,6 +1182,282 @@ void AudioSRC::convertOutput(float** inputs, float* output, int numFrames) {
     }
 }
 
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+// convert int16_t to float, deinterleave stereo
+void AudioSRC::convertInput(const int16_t* input, float** outputs, int numFrames) {
+    const float scale = 1/32768.0f;
+
+    if (_numChannels == 1) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            int16x4_t a0 = vld1_s16(&input[i]);
+
+            // sign-extend and convert from Q15
+            float32x4_t f0 = vcvtq_n_f32_s32(vmovl_s16(a0), 15);
+
+            vst1q_f32(&outputs[0][i], f0);
+        }
+        for (; i < numFrames; i++) {
+            outputs[0][i] = (float)input[i] * scale;
+        }
+
+    } else if (_numChannels == 2) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // deinterleaving load
+            int16x4x2_t a = vld2_s16(&input[2*i]);
+
+            // sign-extend and convert from Q15
+            float32x4_t f0 = vcvtq_n_f32_s32(vmovl_s16(a.val[0]), 15);
+            float32x4_t f1 = vcvtq_n_f32_s32(vmovl_s16(a.val[1]), 15);
+
+            vst1q_f32(&outputs[0][i], f0);
+            vst1q_f32(&outputs[1][i], f1);
+        }
+        for (; i < numFrames; i++) {
+            outputs[0][i] = (float)input[2*i + 0] * scale;
+            outputs[1][i] = (float)input[2*i + 1] * scale;
+        }
+
+    } else if (_numChannels == 4) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // deinterleaving load
+            int16x4x4_t a = vld4_s16(&input[4*i]);
+
+            // sign-extend and convert from Q15
+            float32x4_t f0 = vcvtq_n_f32_s32(vmovl_s16(a.val[0]), 15);
+            float32x4_t f1 = vcvtq_n_f32_s32(vmovl_s16(a.val[1]), 15);
+            float32x4_t f2 = vcvtq_n_f32_s32(vmovl_s16(a.val[2]), 15);
+            float32x4_t f3 = vcvtq_n_f32_s32(vmovl_s16(a.val[3]), 15);
+
+            vst1q_f32(&outputs[0][i], f0);
+            vst1q_f32(&outputs[1][i], f1);
+            vst1q_f32(&outputs[2][i], f2);
+            vst1q_f32(&outputs[3][i], f3);
+        }
+        for (; i < numFrames; i++) {
+            outputs[0][i] = (float)input[4*i + 0] * scale;
+            outputs[1][i] = (float)input[4*i + 1] * scale;
+            outputs[2][i] = (float)input[4*i + 2] * scale;
+            outputs[3][i] = (float)input[4*i + 3] * scale;
+        }
+    }
+}
+
+// fast TPDF dither in [-1.0f, 1.0f]
+static inline float32x4_t dither4() {
+    static const int16_t mul[8] = { -3495, 30185, -27591, 19445, -23279, -5975, -25511, 25173 };
+    static const int16_t add[8] = { 28013, -13225, -32679, -7701, -19675, 105, -32767, 13849 };
+    static int16x8_t rz;
+
+    // update the 8 different maximum-length LCGs
+    rz = vmlaq_s16(vld1q_s16(add), rz, vld1q_s16(mul));
+
+    // return (r0 - r1) * (1/65536.0f);
+    uint16x8_t r = vreinterpretq_u16_s16(rz);
+    int32x4_t d0 = vreinterpretq_s32_u32(vsubl_u16(vget_low_u16(r), vget_high_u16(r)));
+    return vcvtq_n_f32_s32(d0, 16);
+}
+
+// round to nearest and saturate to int16_t
+static inline int16x4_t roundSaturate4(float32x4_t f0) {
+#if defined(__aarch64__)
+    int32x4_t a0 = vcvtnq_s32_f32(f0);
+#else
+    // add copysign(0.5f, f0), then truncate
+    float32x4_t h0 = vbslq_f32(vdupq_n_u32(0x80000000), f0, vdupq_n_f32(0.5f));
+    int32x4_t a0 = vcvtq_s32_f32(vaddq_f32(f0, h0));
+#endif
+    return vqmovn_s32(a0);
+}
+
+// convert float to int16_t with dither, interleave stereo
+void AudioSRC::convertOutput(float** inputs, int16_t* output, int numFrames) {
+    const float scale = 32768.0f;
+
+    if (_numChannels == 1) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            float32x4_t f0 = vmulq_n_f32(vld1q_f32(&inputs[0][i]), scale);
+
+            f0 = vaddq_f32(f0, dither4());
+
+            vst1_s16(&output[i], roundSaturate4(f0));
+        }
+        for (; i < numFrames; i++) {
+            float32x4_t f0 = vdupq_n_f32(inputs[0][i] * scale);
+
+            f0 = vaddq_f32(f0, dither4());
+
+            output[i] = vget_lane_s16(roundSaturate4(f0), 0);
+        }
+
+    } else if (_numChannels == 2) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            float32x4_t f0 = vmulq_n_f32(vld1q_f32(&inputs[0][i]), scale);
+            float32x4_t f1 = vmulq_n_f32(vld1q_f32(&inputs[1][i]), scale);
+
+            float32x4_t d0 = dither4();
+            f0 = vaddq_f32(f0, d0);
+            f1 = vaddq_f32(f1, d0);
+
+            // interleaving store
+            int16x4x2_t a;
+            a.val[0] = roundSaturate4(f0);
+            a.val[1] = roundSaturate4(f1);
+            vst2_s16(&output[2*i], a);
+        }
+        for (; i < numFrames; i++) {
+            float32x4_t f0 = vdupq_n_f32(inputs[0][i] * scale);
+            float32x4_t f1 = vdupq_n_f32(inputs[1][i] * scale);
+
+            float32x4_t d0 = dither4();
+            f0 = vaddq_f32(f0, d0);
+            f1 = vaddq_f32(f1, d0);
+
+            output[2*i + 0] = vget_lane_s16(roundSaturate4(f0), 0);
+            output[2*i + 1] = vget_lane_s16(roundSaturate4(f1), 0);
+        }
+
+    } else if (_numChannels == 4) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            float32x4_t f0 = vmulq_n_f32(vld1q_f32(&inputs[0][i]), scale);
+            float32x4_t f1 = vmulq_n_f32(vld1q_f32(&inputs[1][i]), scale);
+            float32x4_t f2 = vmulq_n_f32(vld1q_f32(&inputs[2][i]), scale);
+            float32x4_t f3 = vmulq_n_f32(vld1q_f32(&inputs[3][i]), scale);
+
+            float32x4_t d0 = dither4();
+            f0 = vaddq_f32(f0, d0);
+            f1 = vaddq_f32(f1, d0);
+            f2 = vaddq_f32(f2, d0);
+            f3 = vaddq_f32(f3, d0);
+
+            // interleaving store
+            int16x4x4_t a;
+            a.val[0] = roundSaturate4(f0);
+            a.val[1] = roundSaturate4(f1);
+            a.val[2] = roundSaturate4(f2);
+            a.val[3] = roundSaturate4(f3);
+            vst4_s16(&output[4*i], a);
+        }
+        for (; i < numFrames; i++) {
+            float32x4_t f0 = vdupq_n_f32(inputs[0][i] * scale);
+            float32x4_t f1 = vdupq_n_f32(inputs[1][i] * scale);
+            float32x4_t f2 = vdupq_n_f32(inputs[2][i] * scale);
+            float32x4_t f3 = vdupq_n_f32(inputs[3][i] * scale);
+
+            float32x4_t d0 = dither4();
+            f0 = vaddq_f32(f0, d0);
+            f1 = vaddq_f32(f1, d0);
+            f2 = vaddq_f32(f2, d0);
+            f3 = vaddq_f32(f3, d0);
+
+            output[4*i + 0] = vget_lane_s16(roundSaturate4(f0), 0);
+            output[4*i + 1] = vget_lane_s16(roundSaturate4(f1), 0);
+            output[4*i + 2] = vget_lane_s16(roundSaturate4(f2), 0);
+            output[4*i + 3] = vget_lane_s16(roundSaturate4(f3), 0);
+        }
+    }
+}
+
+// deinterleave stereo
+void AudioSRC::convertInput(const float* input, float** outputs, int numFrames) {
+
+    if (_numChannels == 1) {
+
+        memcpy(outputs[0], input, numFrames * sizeof(float));
+
+    } else if (_numChannels == 2) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // deinterleaving load
+            float32x4x2_t f = vld2q_f32(&input[2*i]);
+
+            vst1q_f32(&outputs[0][i], f.val[0]);
+            vst1q_f32(&outputs[1][i], f.val[1]);
+        }
+        for (; i < numFrames; i++) {
+            outputs[0][i] = input[2*i + 0];
+            outputs[1][i] = input[2*i + 1];
+        }
+
+    } else if (_numChannels == 4) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // deinterleaving load
+            float32x4x4_t f = vld4q_f32(&input[4*i]);
+
+            vst1q_f32(&outputs[0][i], f.val[0]);
+            vst1q_f32(&outputs[1][i], f.val[1]);
+            vst1q_f32(&outputs[2][i], f.val[2]);
+            vst1q_f32(&outputs[3][i], f.val[3]);
+        }
+        for (; i < numFrames; i++) {
+            outputs[0][i] = input[4*i + 0];
+            outputs[1][i] = input[4*i + 1];
+            outputs[2][i] = input[4*i + 2];
+            outputs[3][i] = input[4*i + 3];
+        }
+    }
+}
+
+// interleave stereo
+void AudioSRC::convertOutput(float** inputs, float* output, int numFrames) {
+
+    if (_numChannels == 1) {
+
+        memcpy(output, inputs[0], numFrames * sizeof(float));
+
+    } else if (_numChannels == 2) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // interleaving store
+            float32x4x2_t f;
+            f.val[0] = vld1q_f32(&inputs[0][i]);
+            f.val[1] = vld1q_f32(&inputs[1][i]);
+            vst2q_f32(&output[2*i], f);
+        }
+        for (; i < numFrames; i++) {
+            output[2*i + 0] = inputs[0][i];
+            output[2*i + 1] = inputs[1][i];
+        }
+
+    } else if (_numChannels == 4) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // interleaving store
+            float32x4x4_t f;
+            f.val[0] = vld1q_f32(&inputs[0][i]);
+            f.val[1] = vld1q_f32(&inputs[1][i]);
+            f.val[2] = vld1q_f32(&inputs[2][i]);
+            f.val[3] = vld1q_f32(&inputs[3][i]);
+            vst4q_f32(&output[4*i], f);
+        }
+        for (; i < numFrames; i++) {
+            output[4*i + 0] = inputs[0][i];
+            output[4*i + 1] = inputs[1][i];
+            output[4*i + 2] = inputs[2][i];
+            output[4*i + 3] = inputs[3][i];
+        }
+    }
+}
+
 #else   // portable reference code
 
 // convert int16_t to float, deinterleave stereo
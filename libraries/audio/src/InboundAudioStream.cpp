@@ -26,11 +26,17 @@ const int InboundAudioStream::MAX_FRAMES_OVER_DESIRED = 10;
 const int InboundAudioStream::WINDOW_STARVE_THRESHOLD = 3;
 const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES = 50;
 const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_REDUCTION = 10;
+const float InboundAudioStream::JITTER_BUFFER_TARGET_PERCENTILE = 0.99f;
 const bool InboundAudioStream::USE_STDEV_FOR_JITTER = false;
 const bool InboundAudioStream::REPETITION_WITH_FADE = true;
 
 static const int STARVE_HISTORY_CAPACITY = 50;
 
+// The arrival gap histogram is aged once per second by this factor, which gives recent gaps a half-life of about 7s.
+// Predictions are only made once it holds about as many gaps as a second of packets.
+static const float ARRIVAL_GAP_DECAY = 0.9f;
+static const float MIN_ARRIVAL_GAPS_FOR_PREDICTION = 100.0f;
+
 // This is called 1x/s, and we want it to log the last 5s
 static const int UNPLAYED_MS_WINDOW_SECS = 5;
 
@@ -90,7 +96,10 @@ void InboundAudioStream::resetStats() {
     _incomingSequenceNumberStats.reset();
     _lastPacketReceivedTime = 0;
     _timeGapStatsForDesiredCalcOnTooManyStarves.reset();
-    _timeGapStatsForDesiredReduction.reset();
+    _arrivalGaps.reset();
+    _predictedJitterBufferFrames = 0;
+    _lastStarveTime = 0;
+    _concealedFrames = 0;
     _starveHistory.clear();
     _framesAvailableStat.reset();
     _currentJitterBufferFrames = 0;
@@ -113,9 +122,29 @@ void InboundAudioStream::setReverb(float reverbTime, float wetLevel) {
 void InboundAudioStream::perSecondCallbackForUpdatingStats() {
     _incomingSequenceNumberStats.pushStatsToHistory();
     _timeGapStatsForDesiredCalcOnTooManyStarves.currentIntervalComplete();
-    _timeGapStatsForDesiredReduction.currentIntervalComplete();
     _timeGapStatsForStatsPacket.currentIntervalComplete();
     _unplayedMs.currentIntervalComplete();
+
+    if (_arrivalGaps.getWeight() >= MIN_ARRIVAL_GAPS_FOR_PREDICTION) {
+        _predictedJitterBufferFrames = std::max((int)ceilf((float)getPercentileTimeGap()
+                                                           / (float)AudioConstants::NETWORK_FRAME_USECS), 1);
+
+        if (_dynamicJitterBufferEnabled) {
+            // grow ahead of starves when the gaps get longer, but hold off shrinking until a while after the last starve,
+            // so that a bad link that briefly looks good doesn't starve again right away
+            quint64 now = usecTimestampNow();
+            bool canReduce = now - _lastStarveTime > (quint64)WINDOW_SECONDS_FOR_DESIRED_REDUCTION * USECS_PER_SECOND;
+
+            if (_predictedJitterBufferFrames > _desiredJitterBufferFrames) {
+                _desiredJitterBufferFrames = _predictedJitterBufferFrames;
+                qCInfo(audiostream, "Set desired jitter frames to %d (predicted)", _desiredJitterBufferFrames);
+            } else if (_predictedJitterBufferFrames < _desiredJitterBufferFrames && canReduce) {
+                _desiredJitterBufferFrames = _predictedJitterBufferFrames;
+                qCInfo(audiostream, "Set desired jitter frames to %d (reduced)", _desiredJitterBufferFrames);
+            }
+        }
+    }
+    _arrivalGaps.decay(ARRIVAL_GAP_DECAY);
 }
 
 int InboundAudioStream::parseData(ReceivedMessage& message) {
@@ -148,7 +177,14 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
             // also result in allowing the codec to interpolate lost data. Then
             // fall through to the "on time" logic to actually handle this packet
             int packetsDropped = arrivalInfo._seqDiffFromExpected;
+            bool isCodedAudio = message.getType() != PacketType::SilentAudioFrame
+                && message.getType() != PacketType::ReplicatedSilentAudioFrame
+                && codecInPacket == _selectedCodecName;
+            if (isCodedAudio) {
+                _packetAfterLoss = message.peek(message.getBytesLeftToRead());
+            }
             lostAudioData(packetsDropped);
+            _packetAfterLoss.clear();
 
             // fall through to OnTime case
         }
@@ -256,13 +292,16 @@ int InboundAudioStream::lostAudioData(int numPackets) {
             qCInfo(audiostream, "Packet currently being unpacked or lost frame already being generated.  Not generating lost frame.");
             return 0;
         }
-        if (_decoder) {
+        if (_decoder && numPackets == 0 && !_packetAfterLoss.isEmpty()) {
+            _decoder->recoverFrame(_packetAfterLoss, decodedBuffer);
+        } else if (_decoder) {
             _decoder->lostFrame(decodedBuffer);
         } else {
             decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * _numChannels);
             memset(decodedBuffer.data(), 0, decodedBuffer.size());
         }
         _ringBuffer.writeData(decodedBuffer.data(), decodedBuffer.size());
+        _concealedFrames++;
     }
     return 0;
 }
@@ -430,6 +469,7 @@ void InboundAudioStream::setToStarved() {
     // record the time of this starve in the starve history
     quint64 now = usecTimestampNow();
     _starveHistory.insert(now);
+    _lastStarveTime = now;
 
     if (_dynamicJitterBufferEnabled) {
         // dynamic jitter buffers are enabled. check if this starve put us over the window
@@ -496,27 +536,13 @@ void InboundAudioStream::packetReceivedUpdateTimingStats() {
 
         // update all stats used for desired frames calculations under dynamic jitter buffer mode
         _timeGapStatsForDesiredCalcOnTooManyStarves.update(gap);
-        _timeGapStatsForDesiredReduction.update(gap);
+        _arrivalGaps.addGap(gap);
 
         if (_timeGapStatsForDesiredCalcOnTooManyStarves.getNewStatsAvailableFlag()) {
             _calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredCalcOnTooManyStarves.getWindowMax()
                                                              / (float) AudioConstants::NETWORK_FRAME_USECS);
             _timeGapStatsForDesiredCalcOnTooManyStarves.clearNewStatsAvailableFlag();
         }
-
-        if (_dynamicJitterBufferEnabled) {
-            // if the max gap in window B (_timeGapStatsForDesiredReduction) corresponds to a smaller number of frames than _desiredJitterBufferFrames,
-            // then reduce _desiredJitterBufferFrames to that number of frames.
-            if (_timeGapStatsForDesiredReduction.getNewStatsAvailableFlag() && _timeGapStatsForDesiredReduction.isWindowFilled()) {
-                int calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredReduction.getWindowMax()
-                                                         / (float)AudioConstants::NETWORK_FRAME_USECS);
-                if (calculatedJitterBufferFrames < _desiredJitterBufferFrames) {
-                    _desiredJitterBufferFrames = calculatedJitterBufferFrames;
-                    qCInfo(audiostream, "Set desired jitter frames to %d (reduced)", _desiredJitterBufferFrames);
-                }
-                _timeGapStatsForDesiredReduction.clearNewStatsAvailableFlag();
-            }
-        }
     }
 
     _lastPacketReceivedTime = now;
@@ -21,6 +21,7 @@
 
 #include <plugins/CodecPlugin.h>
 
+#include "ArrivalGapHistogram.h"
 #include "AudioRingBuffer.h"
 #include "MovingMinMaxAvg.h"
 #include "SequenceNumberStats.h"
@@ -44,6 +45,9 @@ public:
     static const int WINDOW_STARVE_THRESHOLD;
     static const int WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES;
     static const int WINDOW_SECONDS_FOR_DESIRED_REDUCTION;
+    // fraction of packet arrival gaps the dynamic jitter buffer is sized to absorb
+    static const float JITTER_BUFFER_TARGET_PERCENTILE;
+
     // unused (eradicated) settings
     static const bool USE_STDEV_FOR_JITTER;
     static const bool REPETITION_WITH_FADE;
@@ -75,6 +79,10 @@ public:
 
     /// returns the desired number of jitter buffer frames under the dyanmic jitter buffers scheme
     int getCalculatedJitterBufferFrames() const { return _calculatedJitterBufferFrames; }
+
+    /// returns the number of jitter buffer frames that covers the target percentile of recent packet arrival gaps
+    int getPredictedJitterBufferFrames() const { return _predictedJitterBufferFrames; }
+    quint64 getPercentileTimeGap() const { return _arrivalGaps.getPercentileGap(JITTER_BUFFER_TARGET_PERCENTILE); }
     
     bool dynamicJitterBufferEnabled() const { return _dynamicJitterBufferEnabled; }
     int getStaticJitterBufferFrames() { return _staticJitterBufferFrames; }
@@ -93,6 +101,7 @@ public:
     int getStarveCount() const { return _starveCount; }
     int getSilentFramesDropped() const { return _silentFramesDropped; }
     int getOverflowCount() const { return _ringBuffer.getOverflowCount(); }
+    int getConcealedFrames() const { return _concealedFrames; }
 
     int getPacketsReceived() const { return _incomingSequenceNumberStats.getReceived(); }
     
@@ -161,13 +170,16 @@ protected:
     int _starveCount { 0 };
     int _silentFramesDropped { 0 };
     int _oldFramesDropped { 0 };
+    int _concealedFrames { 0 };
 
     SequenceNumberStats _incomingSequenceNumberStats;
 
     quint64 _lastPacketReceivedTime { 0 };
     MovingMinMaxAvg<quint64> _timeGapStatsForDesiredCalcOnTooManyStarves { 0, WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES };
     int _calculatedJitterBufferFrames { 0 };
-    MovingMinMaxAvg<quint64> _timeGapStatsForDesiredReduction { 0, WINDOW_SECONDS_FOR_DESIRED_REDUCTION };
+    ArrivalGapHistogram _arrivalGaps;
+    int _predictedJitterBufferFrames { 0 };
+    quint64 _lastStarveTime { 0 };
 
     RingBufferHistory<quint64> _starveHistory;
 
@@ -190,6 +202,9 @@ protected:
     QMutex _decoderMutex;
     Decoder* _decoder { nullptr };
     int _mismatchedAudioCodecCount { 0 };
+
+    // the packet that arrived after a loss, the last lost frame is recovered from it by lostAudioData
+    QByteArray _packetAfterLoss;
 };
 
 float calculateRepeatedFrameFadeFactor(int indexOfRepeat);
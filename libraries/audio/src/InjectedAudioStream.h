@@ -18,6 +18,12 @@
 
 using LoopbackFlag = uchar;
 
+// the command leading a HostedInjectorControl packet, hosted injectors are stopped with a StopInjector packet
+enum class HostedInjectorCommand : uint8_t {
+    Start,
+    Update
+};
+
 class InjectedAudioStream : public PositionalAudioStream {
 public:
     InjectedAudioStream(const QUuid& streamIdentifier, bool isStereo, int numStaticJitterFrames = -1);
@@ -35,6 +41,7 @@ private:
     AudioStreamStats getAudioStreamStats() const override;
     int parseStreamProperties(PacketType type, const QByteArray& packetAfterSeqNum, int& numAudioSamples) override;
 
+protected:
     const QUuid _streamIdentifier;
     float _radius;
     float _attenuationRatio;
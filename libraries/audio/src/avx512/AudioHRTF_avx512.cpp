@@ -87,4 +87,75 @@ void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* ds
     _mm256_zeroupper();
 }
 
+// apply gain crossfade with accumulation (interleaved)
+void gainfade_1x2_AVX512(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m512 g1 = _mm512_set1_ps(gain1 * (1/32768.0f));  // int16_t to float
+    __m512 gd = _mm512_set1_ps((gain0 - gain1) * (1/32768.0f));
+
+    // duplicate each of 16 frames to stereo
+    const __m512i lo = _mm512_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+    const __m512i hi = _mm512_setr_epi32(8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15);
+
+    assert(numFrames % 16 == 0);
+
+    for (int i = 0; i < numFrames; i += 16) {
+
+        __m512 f0 = _mm512_loadu_ps(&win[i]);
+        __m512 g0 = _mm512_fmadd_ps(f0, gd, g1);
+
+        __m512 x0 = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((__m256i*)&src[i])));
+        x0 = _mm512_mul_ps(x0, g0);
+
+        __m512 y0 = _mm512_loadu_ps(&dst[2*i+0]);
+        __m512 y1 = _mm512_loadu_ps(&dst[2*i+16]);
+
+        // accumulate
+        y0 = _mm512_add_ps(y0, _mm512_permutexvar_ps(lo, x0));
+        y1 = _mm512_add_ps(y1, _mm512_permutexvar_ps(hi, x0));
+
+        _mm512_storeu_ps(&dst[2*i+0], y0);
+        _mm512_storeu_ps(&dst[2*i+16], y1);
+    }
+
+    _mm256_zeroupper();
+}
+
+// apply gain crossfade with accumulation (interleaved)
+void gainfade_2x2_AVX512(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m512 g1 = _mm512_set1_ps(gain1 * (1/32768.0f));  // int16_t to float
+    __m512 gd = _mm512_set1_ps((gain0 - gain1) * (1/32768.0f));
+
+    // same gain for both channels of each of 16 frames
+    const __m512i lo = _mm512_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+    const __m512i hi = _mm512_setr_epi32(8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15);
+
+    assert(numFrames % 16 == 0);
+
+    for (int i = 0; i < numFrames; i += 16) {
+
+        __m512 f0 = _mm512_loadu_ps(&win[i]);
+        __m512 g0 = _mm512_fmadd_ps(f0, gd, g1);
+
+        __m512 x0 = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((__m256i*)&src[2*i+0])));
+        __m512 x1 = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((__m256i*)&src[2*i+16])));
+
+        x0 = _mm512_mul_ps(x0, _mm512_permutexvar_ps(lo, g0));
+        x1 = _mm512_mul_ps(x1, _mm512_permutexvar_ps(hi, g0));
+
+        __m512 y0 = _mm512_loadu_ps(&dst[2*i+0]);
+        __m512 y1 = _mm512_loadu_ps(&dst[2*i+16]);
+
+        // accumulate
+        y0 = _mm512_add_ps(y0, x0);
+        y1 = _mm512_add_ps(y1, x1);
+
+        _mm512_storeu_ps(&dst[2*i+0], y0);
+        _mm512_storeu_ps(&dst[2*i+16], y1);
+    }
+
+    _mm256_zeroupper();
+}
+
 #endif
@@ -1408,6 +1408,35 @@ glm::quat Avatar::jointToWorldRotation(const glm::quat& jointSpaceRot, const int
 }
 
 
+// the joint names in the order of their indices
+static QStringList buildJointNames(const QHash<QString, int>& jointIndices) {
+    // find out how large the vector needs to be
+    int maxJointIndex = -1;
+    for (auto k = jointIndices.constBegin(); k != jointIndices.constEnd(); k++) {
+        int index = k.value();
+        if (index > maxJointIndex) {
+            maxJointIndex = index;
+        }
+    }
+    // iterate through the hash and put joint names
+    // into the vector at their indices
+    QVector<QString> resultVector(maxJointIndex+1);
+    for (auto i = jointIndices.constBegin(); i != jointIndices.constEnd(); i++) {
+        int index = i.value();
+        resultVector[index] = i.key();
+    }
+    // convert to QList and drop out blanks
+    QStringList result = resultVector.toList();
+    QMutableListIterator<QString> j(result);
+    while (j.hasNext()) {
+        QString jointName = j.next();
+        if (jointName.isEmpty()) {
+            j.remove();
+        }
+    }
+    return result;
+}
+
 void Avatar::invalidateJointIndicesCache() const {
     QWriteLocker writeLock(&_modelJointIndicesCacheLock);
     _modelJointsCached = false;
@@ -1423,8 +1452,10 @@ void Avatar::withValidJointIndicesCache(std::function<void()> const& worker) con
             QWriteLocker writeLock(&_modelJointIndicesCacheLock);
             if (!_modelJointsCached) {
                 _modelJointIndicesCache.clear();
+                _modelJointNamesCache.clear();
                 if (_skeletonModel && _skeletonModel->isActive()) {
                     _modelJointIndicesCache = _skeletonModel->getHFMModel().jointIndices;
+                    _modelJointNamesCache = buildJointNames(_modelJointIndicesCache);
                     _modelJointsCached = true;
                 }
             }
@@ -1440,44 +1471,41 @@ int Avatar::getJointIndex(const QString& name) const {
     }
 
     withValidJointIndicesCache([&]() {
-        if (_modelJointIndicesCache.contains(name)) {
-            result = _modelJointIndicesCache.value(name) - 1;
+        auto it = _modelJointIndicesCache.constFind(name);
+        if (it != _modelJointIndicesCache.constEnd()) {
+            result = it.value() - 1;
         }
     });
     return result;
 }
 
-QStringList Avatar::getJointNames() const {
-    QStringList result;
+QVariantList Avatar::getJointIndices(const QStringList& names) const {
+    QVariantList result;
+    result.reserve(names.size());
     withValidJointIndicesCache([&]() {
-        // find out how large the vector needs to be
-        int maxJointIndex = -1;
-        for (auto k = _modelJointIndicesCache.constBegin(); k != _modelJointIndicesCache.constEnd(); k++) {
-            int index = k.value();
-            if (index > maxJointIndex) {
-                maxJointIndex = index;
-            }
-        }
-        // iterate through the hash and put joint names
-        // into the vector at their indices
-        QVector<QString> resultVector(maxJointIndex+1);
-        for (auto i = _modelJointIndicesCache.constBegin(); i != _modelJointIndicesCache.constEnd(); i++) {
-            int index = i.value();
-            resultVector[index] = i.key();
-        }
-        // convert to QList and drop out blanks
-        result = resultVector.toList();
-        QMutableListIterator<QString> j(result);
-        while (j.hasNext()) {
-            QString jointName = j.next();
-            if (jointName.isEmpty()) {
-                j.remove();
+        for (const auto& name : names) {
+            int index = getFauxJointIndex(name);
+            if (index == -1) {
+                auto it = _modelJointIndicesCache.constFind(name);
+                if (it != _modelJointIndicesCache.constEnd()) {
+                    index = it.value() - 1;
+                }
             }
+            result.push_back(index);
         }
     });
     return result;
 }
 
+QStringList Avatar::getJointNames() const {
+    // the names are only built with the cache, scripts ask for them every frame
+    QStringList result;
+    withValidJointIndicesCache([&]() {
+        result = _modelJointNamesCache;
+    });
+    return result;
+}
+
 std::vector<AvatarSkeletonTrait::UnpackedJointData> Avatar::getSkeletonDefaultData() {
     std::vector<AvatarSkeletonTrait::UnpackedJointData> defaultSkeletonData;
     if (_skeletonModel->isLoaded()) {
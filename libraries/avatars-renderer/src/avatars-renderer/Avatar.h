@@ -183,6 +183,10 @@ public:
     /// Returns the distance to use as a LOD parameter.
     float getLODDistance() const;
 
+    // the avatars too far away for their expressions to be seen keep a neutral face, which costs nothing to deform
+    void setRendersBlendshapes(bool rendersBlendshapes) { _rendersBlendshapes = rendersBlendshapes; }
+    bool getRendersBlendshapes() const { return _rendersBlendshapes; }
+
     virtual void createOrb() { }
 
     enum class LoadingStatus {
@@ -200,6 +204,7 @@ public:
     using AvatarData::getJointTranslation;
     virtual glm::vec3 getJointTranslation(int index) const override;
     virtual int getJointIndex(const QString& name) const override;
+    virtual QVariantList getJointIndices(const QStringList& names) const override;
     virtual QStringList getJointNames() const override;
 
     std::vector<AvatarSkeletonTrait::UnpackedJointData> getSkeletonDefaultData();
@@ -652,6 +657,7 @@ protected:
     void invalidateJointIndicesCache() const;
     void withValidJointIndicesCache(std::function<void()> const& worker) const;
     mutable QHash<QString, int> _modelJointIndicesCache;
+    mutable QStringList _modelJointNamesCache;
     mutable QReadWriteLock _modelJointIndicesCacheLock;
     mutable bool _modelJointsCached { false };
 
@@ -733,6 +739,7 @@ protected:
     bool _isAnimatingScale { false };
     bool _mustFadeIn { false };
     bool _reconstructSoftEntitiesJointMap { false };
+    bool _rendersBlendshapes { true };
     float _modelScale { 1.0f };
 
     AvatarTransit _transit;
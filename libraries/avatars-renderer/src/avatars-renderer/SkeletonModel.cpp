@@ -154,7 +154,11 @@ void SkeletonModel::updateAttitude(const glm::quat& orientation) {
 // but just before head has been simulated.
 void SkeletonModel::simulate(float deltaTime, bool fullUpdate) {
     updateAttitude(_owningAvatar->getWorldOrientation());
-    setBlendshapeCoefficients(_owningAvatar->getHead()->getSummedBlendshapeCoefficients());
+    if (_owningAvatar->getRendersBlendshapes()) {
+        setBlendshapeCoefficients(_owningAvatar->getHead()->getSummedBlendshapeCoefficients());
+    } else if (!getBlendshapeCoefficients().isEmpty()) {
+        setBlendshapeCoefficients(QVector<float>());
+    }
 
     if (fullUpdate) {
 
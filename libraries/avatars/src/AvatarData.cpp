@@ -44,6 +44,7 @@
 #include "AvatarLogging.h"
 #include "AvatarTraits.h"
 #include "ClientTraitsHandler.h"
+#include "QuantizedJointCodec.h"
 #include "ResourceRequestObserver.h"
 
 //#define WANT_DEBUG
@@ -67,26 +68,22 @@ size_t AvatarDataPacket::maxFaceTrackerInfoSize(size_t numBlendshapeCoefficients
 }
 
 size_t AvatarDataPacket::maxJointDataSize(size_t numJoints) {
-    const size_t validityBitsSize = calcBitVectorSize((int)numJoints);
-
     size_t totalSize = sizeof(uint8_t); // numJoints
 
-    totalSize += validityBitsSize; // Orientations mask
-    totalSize += numJoints * sizeof(SixByteQuat); // Orientations
-    totalSize += validityBitsSize; // Translations mask
+    totalSize += sizeof(uint8_t); // numRotations
+    totalSize += numJoints * QuantizedJointCodec::MAX_ROTATION_BYTES; // Orientations
+    totalSize += sizeof(uint8_t); // numTranslations
     totalSize += sizeof(float); // maxTranslationDimension
-    totalSize += numJoints * sizeof(SixByteTrans); // Translations
+    totalSize += numJoints * QuantizedJointCodec::MAX_TRANSLATION_BYTES; // Translations
     return totalSize;
 }
 
 size_t AvatarDataPacket::minJointDataSize(size_t numJoints) {
-    const size_t validityBitsSize = calcBitVectorSize((int)numJoints);
-
     size_t totalSize = sizeof(uint8_t); // numJoints
 
-    totalSize += validityBitsSize; // Orientations mask
+    totalSize += sizeof(uint8_t); // numRotations
     // assume no valid rotations
-    totalSize += validityBitsSize; // Translations mask
+    totalSize += sizeof(uint8_t); // numTranslations
     totalSize += sizeof(float); // maxTranslationDimension
     // assume no valid translations
 
@@ -282,6 +279,73 @@ QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail, bool dro
     return avatarByteArray;
 }
 
+AvatarDataPacket::HasFlags AvatarData::getWantedFlags(AvatarDataDetail dataDetail, quint64 lastSentTime,
+                                                      bool dropFaceTracking) const {
+    bool sendAll = (dataDetail == SendAllData);
+    bool sendMinimum = (dataDetail == MinimumData);
+    bool sendPALMinimum = (dataDetail == PALMinimum);
+
+    lazyInitHeadData();
+
+    bool hasAvatarGlobalPosition = true; // always include global position
+    bool hasAvatarOrientation = false;
+    bool hasAvatarBoundingBox = false;
+    bool hasAvatarScale = false;
+    bool hasLookAtPosition = false;
+    bool hasAudioLoudness = false;
+    bool hasSensorToWorldMatrix = false;
+    bool hasJointData = false;
+    bool hasJointDefaultPoseFlags = false;
+    bool hasAdditionalFlags = false;
+
+    // local position, and parent info only apply to avatars that are parented. The local position
+    // and the parent info can change independently though, so we track their "changed since"
+    // separately
+    bool hasParentInfo = false;
+    bool hasAvatarLocalPosition = false;
+    bool hasHandControllers = false;
+
+    bool hasFaceTrackerInfo = false;
+
+    if (sendPALMinimum) {
+        hasAudioLoudness = true;
+    } else {
+        hasAvatarOrientation = sendAll || rotationChangedSince(lastSentTime);
+        hasAvatarBoundingBox = sendAll || avatarBoundingBoxChangedSince(lastSentTime);
+        hasAvatarScale = sendAll || avatarScaleChangedSince(lastSentTime);
+        hasLookAtPosition = sendAll || lookAtPositionChangedSince(lastSentTime);
+        hasAudioLoudness = sendAll || audioLoudnessChangedSince(lastSentTime);
+        hasSensorToWorldMatrix = sendAll || sensorToWorldMatrixChangedSince(lastSentTime);
+        hasAdditionalFlags = sendAll || additionalFlagsChangedSince(lastSentTime);
+        hasParentInfo = sendAll || parentInfoChangedSince(lastSentTime);
+        hasAvatarLocalPosition = hasParent() && (sendAll ||
+            tranlationChangedSince(lastSentTime) ||
+            parentInfoChangedSince(lastSentTime));
+        hasHandControllers = _controllerLeftHandMatrixCache.isValid() || _controllerRightHandMatrixCache.isValid();
+        hasFaceTrackerInfo = !dropFaceTracking && getHasScriptedBlendshapes() &&
+            (sendAll || faceTrackerInfoChangedSince(lastSentTime));
+        hasJointData = !sendMinimum;
+        hasJointDefaultPoseFlags = hasJointData;
+    }
+
+    return
+        (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
+        | (hasAvatarBoundingBox ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
+        | (hasAvatarOrientation ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
+        | (hasAvatarScale ? AvatarDataPacket::PACKET_HAS_AVATAR_SCALE : 0)
+        | (hasLookAtPosition ? AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION : 0)
+        | (hasAudioLoudness ? AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS : 0)
+        | (hasSensorToWorldMatrix ? AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX : 0)
+        | (hasAdditionalFlags ? AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS : 0)
+        | (hasParentInfo ? AvatarDataPacket::PACKET_HAS_PARENT_INFO : 0)
+        | (hasAvatarLocalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
+        | (hasHandControllers ? AvatarDataPacket::PACKET_HAS_HAND_CONTROLLERS : 0)
+        | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
+        | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
+        | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0)
+        | (hasJointData ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
+}
+
 QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime,
                                    const QVector<JointData>& lastSentJointData, AvatarDataPacket::SendStatus& sendStatus,
                                    bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
@@ -290,8 +354,6 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     bool cullSmallChanges = (dataDetail == CullSmallData);
     bool sendAll = (dataDetail == SendAllData);
-    bool sendMinimum = (dataDetail == MinimumData);
-    bool sendPALMinimum = (dataDetail == PALMinimum);
 
     lazyInitHeadData();
     ASSERT(maxDataSize == 0 || (size_t)maxDataSize >= AvatarDataPacket::MIN_BULK_PACKET_SIZE);
@@ -341,63 +403,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     if (sendStatus.itemFlags == 0) {
         // New avatar ...
-        bool hasAvatarGlobalPosition = true; // always include global position
-        bool hasAvatarOrientation = false;
-        bool hasAvatarBoundingBox = false;
-        bool hasAvatarScale = false;
-        bool hasLookAtPosition = false;
-        bool hasAudioLoudness = false;
-        bool hasSensorToWorldMatrix = false;
-        bool hasJointData = false;
-        bool hasJointDefaultPoseFlags = false;
-        bool hasAdditionalFlags = false;
-
-        // local position, and parent info only apply to avatars that are parented. The local position
-        // and the parent info can change independently though, so we track their "changed since"
-        // separately
-        bool hasParentInfo = false;
-        bool hasAvatarLocalPosition = false;
-        bool hasHandControllers = false;
-
-        bool hasFaceTrackerInfo = false;
-
-        if (sendPALMinimum) {
-            hasAudioLoudness = true;
-        } else {
-            hasAvatarOrientation = sendAll || rotationChangedSince(lastSentTime);
-            hasAvatarBoundingBox = sendAll || avatarBoundingBoxChangedSince(lastSentTime);
-            hasAvatarScale = sendAll || avatarScaleChangedSince(lastSentTime);
-            hasLookAtPosition = sendAll || lookAtPositionChangedSince(lastSentTime);
-            hasAudioLoudness = sendAll || audioLoudnessChangedSince(lastSentTime);
-            hasSensorToWorldMatrix = sendAll || sensorToWorldMatrixChangedSince(lastSentTime);
-            hasAdditionalFlags = sendAll || additionalFlagsChangedSince(lastSentTime);
-            hasParentInfo = sendAll || parentInfoChangedSince(lastSentTime);
-            hasAvatarLocalPosition = hasParent() && (sendAll ||
-                tranlationChangedSince(lastSentTime) ||
-                parentInfoChangedSince(lastSentTime));
-            hasHandControllers = _controllerLeftHandMatrixCache.isValid() || _controllerRightHandMatrixCache.isValid();
-            hasFaceTrackerInfo = !dropFaceTracking && getHasScriptedBlendshapes() &&
-                (sendAll || faceTrackerInfoChangedSince(lastSentTime));
-            hasJointData = !sendMinimum;
-            hasJointDefaultPoseFlags = hasJointData;
-        }
-
-        wantedFlags =
-            (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
-            | (hasAvatarBoundingBox ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
-            | (hasAvatarOrientation ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
-            | (hasAvatarScale ? AvatarDataPacket::PACKET_HAS_AVATAR_SCALE : 0)
-            | (hasLookAtPosition ? AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION : 0)
-            | (hasAudioLoudness ? AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS : 0)
-            | (hasSensorToWorldMatrix ? AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX : 0)
-            | (hasAdditionalFlags ? AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS : 0)
-            | (hasParentInfo ? AvatarDataPacket::PACKET_HAS_PARENT_INFO : 0)
-            | (hasAvatarLocalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
-            | (hasHandControllers ? AvatarDataPacket::PACKET_HAS_HAND_CONTROLLERS : 0)
-            | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
-            | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
-            | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0)
-            | (hasJointData ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
+        wantedFlags = getWantedFlags(dataDetail, lastSentTime, dropFaceTracking);
 
             sendStatus.itemFlags = wantedFlags;
             sendStatus.rotationsSent = 0;
@@ -690,8 +696,9 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
     // include jointData if there is room for the most minimal section. i.e. no translations or rotations.
     IF_AVATAR_SPACE(PACKET_HAS_JOINT_DATA, AvatarDataPacket::minJointDataSize(numJoints)) {
         // Minimum space required for another rotation joint -
-        // size of joint + following translation bit-vector + translation scale:
-        const ptrdiff_t minSizeForJoint = sizeof(AvatarDataPacket::SixByteQuat) + jointBitVectorSize + sizeof(float);
+        // the most a joint can take + the translation count and scale that follow:
+        const ptrdiff_t minSizeForJoint = QuantizedJointCodec::MAX_ROTATION_BYTES + sizeof(uint8_t) + sizeof(float);
+        const ptrdiff_t minSizeForTranslation = QuantizedJointCodec::MAX_TRANSLATION_BYTES;
 
         auto startSection = destinationBuffer;
 
@@ -709,16 +716,14 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         // joint rotation data
         *destinationBuffer++ = (uint8_t)numJoints;
 
-        unsigned char* validityPosition = destinationBuffer;
-        memset(validityPosition, 0, jointBitVectorSize);
+        // filled in once we know how many fit
+        unsigned char* numRotationsPosition = destinationBuffer++;
+        int numRotationsSent = 0;
 
 #ifdef WANT_DEBUG
-        int rotationSentCount = 0;
         unsigned char* beforeRotations = destinationBuffer;
 #endif
 
-        destinationBuffer += jointBitVectorSize; // Move pointer past the validity bytes
-
         // sentJointDataOut and lastSentJointData might be the same vector
         if (sentJointDataOut) {
             sentJointDataOut->resize(numJoints); // Make sure the destination is resized before using it
@@ -728,22 +733,27 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         float minRotationDOT = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinRotationDOT(viewerPosition) : AVATAR_MIN_ROTATION_DOT;
 
+        // quantize no finer than the receiver can tell apart
+        int rotationPrecision = QuantizedJointCodec::rotationPrecisionFor(minRotationDOT);
+
+        QuantizedJointCodec::BitWriter rotationWriter(destinationBuffer);
+        int lastSentIndex = -1;
+
         int i = sendStatus.rotationsSent;
         for (; i < numJoints; ++i) {
             const JointData& data = joints[i];
             const JointData& last = lastSentJointData[i];
 
-            if (packetEnd - destinationBuffer >= minSizeForJoint) {
+            if (packetEnd - rotationWriter.end() >= minSizeForJoint) {
                 if (!data.rotationIsDefaultPose) {
                     // The dot product for larger rotations is a lower number,
                     // so if the dot() is less than the value, then the rotation is a larger angle of rotation
                     if (sendAll || last.rotationIsDefaultPose || (!cullSmallChanges && last.rotation != data.rotation)
                         || (cullSmallChanges && fabsf(glm::dot(last.rotation, data.rotation)) < minRotationDOT)) {
-                        validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
-#ifdef WANT_DEBUG
-                        rotationSentCount++;
-#endif
-                        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                        rotationWriter.writeGap(i - lastSentIndex - 1);
+                        QuantizedJointCodec::writeRotation(rotationWriter, data.rotation, rotationPrecision);
+                        lastSentIndex = i;
+                        ++numRotationsSent;
 
                         if (sentJoints) {
                             sentJoints[i].rotation = data.rotation;
@@ -760,39 +770,38 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         }
         sendStatus.rotationsSent = i;
+        *numRotationsPosition = (uint8_t)numRotationsSent;
+        destinationBuffer = rotationWriter.end();
 
         // joint translation data
-        validityPosition = destinationBuffer;
+        unsigned char* numTranslationsPosition = destinationBuffer++;
+        int numTranslationsSent = 0;
 
 #ifdef WANT_DEBUG
-        int translationSentCount = 0;
         unsigned char* beforeTranslations = destinationBuffer;
 #endif
 
-        memset(destinationBuffer, 0, jointBitVectorSize);
-        destinationBuffer += jointBitVectorSize; // Move pointer past the validity bytes
-
         // write maxTranslationDimension
         AVATAR_MEMCPY(maxTranslationDimension);
 
         float minTranslation = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinTranslationDistance(viewerPosition) : AVATAR_MIN_TRANSLATION;
 
+        QuantizedJointCodec::BitWriter translationWriter(destinationBuffer);
+        lastSentIndex = -1;
+
         i = sendStatus.translationsSent;
         for (; i < numJoints; ++i) {
             const JointData& data = joints[i];
             const JointData& last = lastSentJointData[i];
 
-            // Note minSizeForJoint is conservative since there isn't a following bit-vector + scale.
-            if (packetEnd - destinationBuffer >= minSizeForJoint) {
+            if (packetEnd - translationWriter.end() >= minSizeForTranslation) {
                 if (!data.translationIsDefaultPose) {
                     if (sendAll || last.translationIsDefaultPose || (!cullSmallChanges && last.translation != data.translation)
                         || (cullSmallChanges && glm::distance(data.translation, lastSentJointData[i].translation) > minTranslation)) {
-                        validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
-#ifdef WANT_DEBUG
-                        translationSentCount++;
-#endif
-                        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation / maxTranslationDimension,
-                                                                               TRANSLATION_COMPRESSION_RADIX);
+                        translationWriter.writeGap(i - lastSentIndex - 1);
+                        QuantizedJointCodec::writeTranslation(translationWriter, data.translation / maxTranslationDimension);
+                        lastSentIndex = i;
+                        ++numTranslationsSent;
 
                         if (sentJoints) {
                             sentJoints[i].translation = data.translation;
@@ -809,6 +818,8 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         }
         sendStatus.translationsSent = i;
+        *numTranslationsPosition = (uint8_t)numTranslationsSent;
+        destinationBuffer = translationWriter.end();
 
         IF_AVATAR_SPACE(PACKET_HAS_GRAB_JOINTS, sizeof (AvatarDataPacket::FarGrabJoints)) {
             // the far-grab joints may range further than 3 meters, so we can't use packFloatVec3ToSignedTwoByteFixed etc
@@ -842,7 +853,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 #ifdef WANT_DEBUG
         if (sendAll) {
             qCDebug(avatars) << "AvatarData::toByteArray" << cullSmallChanges << sendAll
-                << "rotations:" << rotationSentCount << "translations:" << translationSentCount
+                << "rotations:" << numRotationsSent << "translations:" << numTranslationsSent
                 << "largest:" << maxTranslationDimension
                 << "size:"
                 << (beforeRotations - startPosition) << "+"
@@ -1325,64 +1336,36 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
 
         PACKET_READ_CHECK(NumJoints, sizeof(uint8_t));
         int numJoints = *sourceBuffer++;
-        const int bytesOfValidity = (int)ceil((float)numJoints / (float)BITS_IN_BYTE);
-        PACKET_READ_CHECK(JointRotationValidityBits, bytesOfValidity);
-
-        int numValidJointRotations = 0;
-        QVector<bool> validRotations;
-        validRotations.resize(numJoints);
-        { // rotation validity bits
-            unsigned char validity = 0;
-            int validityBit = 0;
-            for (int i = 0; i < numJoints; i++) {
-                if (validityBit == 0) {
-                    validity = *sourceBuffer++;
-                }
-                bool valid = (bool)(validity & (1 << validityBit));
-                if (valid) {
-                    ++numValidJointRotations;
-                }
-                validRotations[i] = valid;
-                validityBit = (validityBit + 1) % BITS_IN_BYTE;
-            }
-        }
 
-        // each joint rotation is stored in 6 bytes.
+        PACKET_READ_CHECK(NumJointRotations, sizeof(uint8_t));
+        int numValidJointRotations = *sourceBuffer++;
+
         QWriteLocker writeLock(&_jointDataLock);
         _jointData.resize(numJoints);
 
-        const int COMPRESSED_QUATERNION_SIZE = 6;
-        PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
-        for (int i = 0; i < numJoints; i++) {
-            JointData& data = _jointData[i];
-            if (validRotations[i]) {
-                sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
-                _hasNewJointData = true;
-                data.rotationIsDefaultPose = false;
+        // each joint rotation is bit-packed along with the number of unchanged joints before it
+        QuantizedJointCodec::BitReader rotationReader(sourceBuffer, endPosition);
+        int jointIndex = -1;
+        for (int i = 0; i < numValidJointRotations; i++) {
+            int gap;
+            glm::quat rotation;
+            if (!rotationReader.readGap(gap) || !QuantizedJointCodec::readRotation(rotationReader, rotation) ||
+                (jointIndex += gap + 1) >= numJoints) {
+                if (shouldLogError(now)) {
+                    qCWarning(avatars) << "AvatarData packet has bad JointRotations, " << getSessionUUID();
+                }
+                return buffer.size();
             }
-        }
 
-        PACKET_READ_CHECK(JointTranslationValidityBits, bytesOfValidity);
+            JointData& data = _jointData[jointIndex];
+            data.rotation = rotation;
+            _hasNewJointData = true;
+            data.rotationIsDefaultPose = false;
+        }
+        sourceBuffer = rotationReader.end();
 
-        // get translation validity bits -- these indicate which translations were packed
-        int numValidJointTranslations = 0;
-        QVector<bool> validTranslations;
-        validTranslations.resize(numJoints);
-        { // translation validity bits
-            unsigned char validity = 0;
-            int validityBit = 0;
-            for (int i = 0; i < numJoints; i++) {
-                if (validityBit == 0) {
-                    validity = *sourceBuffer++;
-                }
-                bool valid = (bool)(validity & (1 << validityBit));
-                if (valid) {
-                    ++numValidJointTranslations;
-                }
-                validTranslations[i] = valid;
-                validityBit = (validityBit + 1) % BITS_IN_BYTE;
-            }
-        } // 1 + bytesOfValidity bytes
+        PACKET_READ_CHECK(NumJointTranslations, sizeof(uint8_t));
+        int numValidJointTranslations = *sourceBuffer++;
 
         // read maxTranslationDimension
         float maxTranslationDimension;
@@ -1390,19 +1373,25 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         memcpy(&maxTranslationDimension, sourceBuffer, sizeof(float));
         sourceBuffer += sizeof(float);
 
-        // each joint translation component is stored in 6 bytes.
-        const int COMPRESSED_TRANSLATION_SIZE = 6;
-        PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
-
-        for (int i = 0; i < numJoints; i++) {
-            JointData& data = _jointData[i];
-            if (validTranslations[i]) {
-                sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
-                data.translation *= maxTranslationDimension;
-                _hasNewJointData = true;
-                data.translationIsDefaultPose = false;
+        QuantizedJointCodec::BitReader translationReader(sourceBuffer, endPosition);
+        jointIndex = -1;
+        for (int i = 0; i < numValidJointTranslations; i++) {
+            int gap;
+            glm::vec3 translation;
+            if (!translationReader.readGap(gap) || !QuantizedJointCodec::readTranslation(translationReader, translation) ||
+                (jointIndex += gap + 1) >= numJoints) {
+                if (shouldLogError(now)) {
+                    qCWarning(avatars) << "AvatarData packet has bad JointTranslations, " << getSessionUUID();
+                }
+                return buffer.size();
             }
+
+            JointData& data = _jointData[jointIndex];
+            data.translation = translation * maxTranslationDimension;
+            _hasNewJointData = true;
+            data.translationIsDefaultPose = false;
         }
+        sourceBuffer = translationReader.end();
 
 #ifdef WANT_DEBUG
         if (numValidJointRotations > 15) {
@@ -1938,6 +1927,10 @@ void AvatarData::clearJointsData() {
 }
 
 int AvatarData::getFauxJointIndex(const QString& name) const {
+    // all the faux joints start with an underscore, none of the joints of the models do
+    if (!name.startsWith('_')) {
+        return -1;
+    }
     if (name == "_SENSOR_TO_WORLD_MATRIX") {
         return SENSOR_TO_WORLD_MATRIX_INDEX;
     }
@@ -1973,6 +1966,15 @@ int AvatarData::getJointIndex(const QString& name) const {
     return result;
 }
 
+QVariantList AvatarData::getJointIndices(const QStringList& names) const {
+    QVariantList result;
+    result.reserve(names.size());
+    for (const auto& name : names) {
+        result.push_back(getJointIndex(name));
+    }
+    return result;
+}
+
 QStringList AvatarData::getJointNames() const {
     return QStringList();
 }
@@ -2841,6 +2843,106 @@ void AvatarData::fromJson(const QJsonObject& json, bool useFrameSkeleton) {
     }
 }
 
+// The frames of the newer recordings are tagged, and hold the avatar's JSON without the joints, followed by the joints
+// packed the way the avatar data packets do, at the finest precision and without the ones in their default pose.
+// The older frames are all JSON
+static const char PACKED_AVATAR_FRAME_TAG[] = { 'h', 'f', 'a', 'f' };
+static const int PACKED_AVATAR_FRAME_TAG_SIZE = (int)sizeof(PACKED_AVATAR_FRAME_TAG);
+// the gaps between the packed joints are coded for at most this many joints
+static const int MAX_PACKED_FRAME_JOINTS = 256;
+
+static void packFrameJoints(const QVector<JointData>& jointData, QByteArray& frame) {
+    const int numJoints = jointData.size();
+    const int maxJointsSize = (int)(3 * sizeof(uint16_t) + sizeof(float)) +
+        numJoints * (QuantizedJointCodec::MAX_ROTATION_BYTES + QuantizedJointCodec::MAX_TRANSLATION_BYTES);
+    const int start = frame.size();
+    frame.append(QByteArray(maxJointsSize, 0));
+    unsigned char* destinationBuffer = reinterpret_cast<unsigned char*>(frame.data()) + start;
+
+    float maxTranslationDimension = 0.001f;
+    uint16_t numRotations = 0;
+    uint16_t numTranslations = 0;
+    for (const auto& data : jointData) {
+        if (!data.rotationIsDefaultPose) {
+            ++numRotations;
+        }
+        if (!data.translationIsDefaultPose) {
+            ++numTranslations;
+            maxTranslationDimension = glm::max(glm::compMax(glm::abs(data.translation)), maxTranslationDimension);
+        }
+    }
+    uint16_t header[] = { (uint16_t)numJoints, numRotations, numTranslations };
+    memcpy(destinationBuffer, header, sizeof(header));
+    destinationBuffer += sizeof(header);
+    memcpy(destinationBuffer, &maxTranslationDimension, sizeof(float));
+    destinationBuffer += sizeof(float);
+
+    QuantizedJointCodec::BitWriter rotationWriter(destinationBuffer);
+    int lastIndex = -1;
+    for (int i = 0; i < numJoints; ++i) {
+        if (!jointData[i].rotationIsDefaultPose) {
+            rotationWriter.writeGap(i - lastIndex - 1);
+            QuantizedJointCodec::writeRotation(rotationWriter, jointData[i].rotation,
+                QuantizedJointCodec::NUM_ROTATION_PRECISIONS - 1);
+            lastIndex = i;
+        }
+    }
+
+    QuantizedJointCodec::BitWriter translationWriter(rotationWriter.end());
+    lastIndex = -1;
+    for (int i = 0; i < numJoints; ++i) {
+        if (!jointData[i].translationIsDefaultPose) {
+            translationWriter.writeGap(i - lastIndex - 1);
+            QuantizedJointCodec::writeTranslation(translationWriter, jointData[i].translation / maxTranslationDimension);
+            lastIndex = i;
+        }
+    }
+
+    frame.resize((int)(translationWriter.end() - reinterpret_cast<unsigned char*>(frame.data())));
+}
+
+static bool unpackFrameJoints(const unsigned char* sourceBuffer, const unsigned char* end, QVector<JointData>& jointData) {
+    uint16_t header[3];
+    float maxTranslationDimension;
+    if (end - sourceBuffer < (ptrdiff_t)(sizeof(header) + sizeof(float))) {
+        return false;
+    }
+    memcpy(header, sourceBuffer, sizeof(header));
+    sourceBuffer += sizeof(header);
+    memcpy(&maxTranslationDimension, sourceBuffer, sizeof(float));
+    sourceBuffer += sizeof(float);
+
+    const int numJoints = header[0];
+    const int numRotations = header[1];
+    const int numTranslations = header[2];
+    jointData.fill(JointData(), numJoints);
+
+    QuantizedJointCodec::BitReader rotationReader(sourceBuffer, end);
+    int index = -1;
+    for (int i = 0; i < numRotations; ++i) {
+        int gap;
+        if (!rotationReader.readGap(gap) || (index += gap + 1) >= numJoints ||
+                !QuantizedJointCodec::readRotation(rotationReader, jointData[index].rotation)) {
+            return false;
+        }
+        jointData[index].rotationIsDefaultPose = false;
+    }
+
+    QuantizedJointCodec::BitReader translationReader(rotationReader.end(), end);
+    index = -1;
+    for (int i = 0; i < numTranslations; ++i) {
+        int gap;
+        glm::vec3 normalizedTranslation;
+        if (!translationReader.readGap(gap) || (index += gap + 1) >= numJoints ||
+                !QuantizedJointCodec::readTranslation(translationReader, normalizedTranslation)) {
+            return false;
+        }
+        jointData[index].translation = normalizedTranslation * maxTranslationDimension;
+        jointData[index].translationIsDefaultPose = false;
+    }
+    return true;
+}
+
 // Every frame will store both a basis for the recording and a relative transform
 // This allows the application to decide whether playback should be relative to an avatar's
 // transform at the start of playback, or relative to the transform of the recorded
@@ -2854,11 +2956,45 @@ QByteArray AvatarData::toFrame(const AvatarData& avatar) {
         qCDebug(avatars).noquote() << QJsonDocument(obj).toJson(QJsonDocument::JsonFormat::Indented);
     }
 #endif
-    return QJsonDocument(root).toBinaryData();
+    QVector<JointData> jointData = avatar.getRawJointData();
+    if (jointData.size() > MAX_PACKED_FRAME_JOINTS) {
+        return QJsonDocument(root).toBinaryData();
+    }
+
+    root.remove(JSON_AVATAR_JOINT_ARRAY);
+    QByteArray json = QJsonDocument(root).toBinaryData();
+    uint32_t jsonSize = (uint32_t)json.size();
+
+    QByteArray frame;
+    frame.reserve(PACKED_AVATAR_FRAME_TAG_SIZE + (int)sizeof(jsonSize) + json.size());
+    frame.append(PACKED_AVATAR_FRAME_TAG, PACKED_AVATAR_FRAME_TAG_SIZE);
+    frame.append(reinterpret_cast<const char*>(&jsonSize), (int)sizeof(jsonSize));
+    frame.append(json);
+    packFrameJoints(jointData, frame);
+    return frame;
 }
 
 
 void AvatarData::fromFrame(const QByteArray& frameData, AvatarData& result, bool useFrameSkeleton) {
+    if (frameData.startsWith(QByteArray::fromRawData(PACKED_AVATAR_FRAME_TAG, PACKED_AVATAR_FRAME_TAG_SIZE))) {
+        const int jsonStart = PACKED_AVATAR_FRAME_TAG_SIZE + (int)sizeof(uint32_t);
+        uint32_t jsonSize = 0;
+        if (frameData.size() >= jsonStart) {
+            memcpy(&jsonSize, frameData.constData() + PACKED_AVATAR_FRAME_TAG_SIZE, sizeof(jsonSize));
+        }
+        const unsigned char* frameStart = reinterpret_cast<const unsigned char*>(frameData.constData());
+        QVector<JointData> jointData;
+        if (frameData.size() < jsonStart || jsonSize > (uint32_t)(frameData.size() - jsonStart) ||
+                !unpackFrameJoints(frameStart + jsonStart + jsonSize, frameStart + frameData.size(), jointData)) {
+            qCWarning(avatars) << "AvatarData::fromFrame, invalid packed frame of size" << frameData.size();
+            return;
+        }
+        QJsonDocument doc = QJsonDocument::fromBinaryData(frameData.mid(jsonStart, (int)jsonSize));
+        result.fromJson(doc.object(), useFrameSkeleton);
+        result.setRawJointData(jointData);
+        return;
+    }
+
     QJsonDocument doc = QJsonDocument::fromBinaryData(frameData);
 
 #ifdef WANT_JSON_DEBUG
@@ -3010,7 +3146,8 @@ void AvatarData::storeAvatarEntityDataPayload(const QUuid& entityID, const QByte
                 _packedAvatarEntityData.insert(entityID, data);
                 changed = true;
             }
-        } else {
+        } else if (itr.value() != data) {
+            // the entities that are rewritten with the same properties aren't sent again
             itr.value() = data;
             changed = true;
         }
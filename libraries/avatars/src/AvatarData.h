@@ -339,11 +339,13 @@ namespace AvatarDataPacket {
     /*
     struct JointData {
         uint8_t numJoints;
-        uint8_t rotationValidityBits[ceil(numJoints / 8)];     // one bit per joint, if true then a compressed rotation follows.
-        SixByteQuat rotation[numValidRotations];               // encodeded and compressed by packOrientationQuatToSixBytes()
-        uint8_t translationValidityBits[ceil(numJoints / 8)];  // one bit per joint, if true then a compressed translation follows.
+        uint8_t numValidRotations;
+        bits rotations[numValidRotations];                     // unchanged joints skipped + smallest three quaternion,
+                                                               // bit-packed by QuantizedJointCodec, padded to a byte.
+        uint8_t numValidTranslations;
         float maxTranslationDimension;                         // used to normalize fixed point translation values.
-        SixByteTrans translation[numValidTranslations];        // normalized and compressed by packFloatVec3ToSignedTwoByteFixed()
+        bits translations[numValidTranslations];               // unchanged joints skipped + normalized fixed point,
+                                                               // bit-packed by QuantizedJointCodec, padded to a byte.
         SixByteQuat leftHandControllerRotation;
         SixByteTrans leftHandControllerTranslation;
         SixByteQuat rightHandControllerRotation;
@@ -624,6 +626,9 @@ public:
         AvatarDataPacket::SendStatus& sendStatus, bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
         QVector<JointData>* sentJointDataOut, int maxDataSize = 0, AvatarDataRate* outboundDataRateOut = nullptr) const;
 
+    // the sections toByteArray() puts in a new avatar's data at this level of detail, if they all fit
+    AvatarDataPacket::HasFlags getWantedFlags(AvatarDataDetail dataDetail, quint64 lastSentTime, bool dropFaceTracking) const;
+
     virtual void doneEncoding(bool cullSmallChanges);
 
     /// \return true if an error should be logged
@@ -1117,6 +1122,20 @@ public:
     /// Returns the index of the joint with the specified name, or -1 if not found/unknown.
     Q_INVOKABLE virtual int getJointIndex(const QString& name) const;
 
+    /**jsdoc
+     * Gets the joint indexes for several named joints at once. This is quicker than calling {@link Avatar.getJointIndex} for 
+     * each of them, and the indexes can be kept and used with the joint functions that take an index, for as long as the 
+     * avatar's model doesn't change, rather than looking up the names every frame.
+     * @function Avatar.getJointIndices
+     * @param {string[]} names - The names of the joints.
+     * @returns {number[]} The index of each joint if valid, otherwise <code>-1</code>, in the order of the names.
+     * @example <caption>Report the indexes of your avatar's arm joints.</caption>
+     * print(JSON.stringify(MyAvatar.getJointIndices(["LeftArm", "LeftForeArm", "RightArm", "RightForeArm"])));
+     *
+     * // Note: If using from the Avatar API, replace "MyAvatar" with "Avatar".
+     */
+    Q_INVOKABLE virtual QVariantList getJointIndices(const QStringList& names) const;
+
     /**jsdoc
      * Gets the names of all the joints in the current avatar.
      * @function Avatar.getJointNames
@@ -133,6 +133,8 @@ AvatarHashMap::AvatarHashMap() {
     connect(nodeList.data(), &NodeList::nodeKilled, this, [this](SharedNodePointer killedNode){
         if (killedNode->getType() == NodeType::AvatarMixer) {
             clearOtherAvatars();
+            // a new mixer starts from an empty copy of our blobs
+            _traitBlobs.clear();
         }
     });
 }
@@ -389,7 +391,9 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
             message->readPrimitive(&packetTraitVersion);
 
             AvatarTraits::TraitWireSize traitBinarySize;
-            bool skipBinaryTrait = false;
+            QByteArray traitData;
+
+            // the data is read even for traits we skip, the mixer expects every shared blob it sent to be cached
 
             if (AvatarTraits::isSimpleTrait(traitType)) {
                 // Trying to read more bytes than available, bail
@@ -401,19 +405,17 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
                 message->readPrimitive(&traitBinarySize);
 
                 // Trying to read more bytes than available, bail
-                if (message->getBytesLeftToRead() < traitBinarySize) {
+                if (traitBinarySize == AvatarTraits::DELETED_TRAIT_SIZE ||
+                    !readTraitBinaryData(*message, traitBinarySize, traitData)) {
                     qWarning() << "Malformed bulk trait packet, bailling";
                     return;
                 }
 
                 // check if this trait version is newer than what we already have for this avatar
                 if (packetTraitVersion > lastProcessedVersions[traitType]) {
-                    auto traitData = message->read(traitBinarySize);
                     avatar->processTrait(traitType, traitData);
                     _replicas.processTrait(avatarID, traitType, traitData);
                     lastProcessedVersions[traitType] = packetTraitVersion;
-                } else {
-                    skipBinaryTrait = true;
                 }
             } else {
                 // Trying to read more bytes than available, bail
@@ -429,7 +431,7 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
                 message->readPrimitive(&traitBinarySize);
 
                 // Trying to read more bytes than available, bail
-                if (traitBinarySize < -1 || message->getBytesLeftToRead() < traitBinarySize) {
+                if (!readTraitBinaryData(*message, traitBinarySize, traitData)) {
                     qWarning() << "Malformed bulk trait packet, bailling";
                     return;
                 }
@@ -440,27 +442,72 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
                         avatar->processDeletedTraitInstance(traitType, traitInstanceID);
                         _replicas.processDeletedTraitInstance(avatarID, traitType, traitInstanceID);
                     } else {
-                        auto traitData = message->read(traitBinarySize);
                         avatar->processTraitInstance(traitType, traitInstanceID, traitData);
                         _replicas.processTraitInstance(avatarID, traitType, traitInstanceID, traitData);
                     }
                     processedInstanceVersion = packetTraitVersion;
-                } else {
-                    skipBinaryTrait = true;
                 }
             }
 
-            if (skipBinaryTrait && traitBinarySize > 0) {
-                // we didn't read this trait because it was older or because we didn't have an avatar to process it for
-                message->seek(message->getPosition() + traitBinarySize);
-            }
-
             // read the next trait type, which is null if there are no more traits for this avatar
             message->readPrimitive(&traitType);
         }
     }
 }
 
+bool AvatarHashMap::readTraitBinaryData(ReceivedMessage& message, AvatarTraits::TraitWireSize traitBinarySize,
+                                        QByteArray& traitData) {
+    if (traitBinarySize >= 0) {
+        if (message.getBytesLeftToRead() < traitBinarySize) {
+            return false;
+        }
+        traitData = message.read(traitBinarySize);
+        return true;
+    }
+
+    if (traitBinarySize == AvatarTraits::DELETED_TRAIT_SIZE) {
+        traitData = QByteArray();
+        return true;
+    }
+
+    if (traitBinarySize != AvatarTraits::COMPRESSED_TRAIT_SIZE && traitBinarySize != AvatarTraits::CACHED_TRAIT_SIZE) {
+        return false;
+    }
+
+    if (message.getBytesLeftToRead() < AvatarTraits::TRAIT_BLOB_HASH_SIZE) {
+        return false;
+    }
+    auto hash = message.read(AvatarTraits::TRAIT_BLOB_HASH_SIZE);
+
+    if (traitBinarySize == AvatarTraits::COMPRESSED_TRAIT_SIZE) {
+        AvatarTraits::TraitWireSize compressedSize;
+        if (message.getBytesLeftToRead() < qint64(sizeof(AvatarTraits::TraitWireSize))) {
+            return false;
+        }
+        message.readPrimitive(&compressedSize);
+
+        if (compressedSize < 0 || message.getBytesLeftToRead() < compressedSize) {
+            return false;
+        }
+        // shared blobs are never empty, so this is data that didn't decompress
+        traitData = qUncompress(message.read(compressedSize));
+        if (traitData.isEmpty()) {
+            return false;
+        }
+    } else {
+        traitData = _traitBlobs.find(hash);
+        if (traitData.isNull()) {
+            // only happens if we got out of step with the mixer
+            qCWarning(avatars) << "Received a trait blob we don't hold" << hash.toHex();
+            return false;
+        }
+    }
+
+    // keep the same blobs as the mixer thinks we have, in the same order
+    _traitBlobs.touch(hash, traitData);
+    return true;
+}
+
 void AvatarHashMap::processKillAvatar(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     // read the node id
     QUuid sessionUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
@@ -31,6 +31,7 @@
 
 #include "AvatarData.h"
 #include "AssociatedTraitValues.h"
+#include "TraitBlobCache.h"
 
 const int CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 50;
 const quint64 MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS = USECS_PER_SECOND / CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
@@ -243,6 +244,13 @@ protected:
     AvatarReplicas _replicas;
 
 private:
+    // reads the data of a trait whose wire size was just read, resolving shared blobs, false if it is malformed
+    bool readTraitBinaryData(ReceivedMessage& message, AvatarTraits::TraitWireSize traitBinarySize,
+                             QByteArray& traitData);
+
+    // the shared trait blobs the avatar mixer knows we hold
+    AvatarTraits::TraitBlobCache _traitBlobs;
+
     QUuid _lastOwnerSessionUUID;
 };
 
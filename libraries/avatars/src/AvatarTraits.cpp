@@ -14,9 +14,34 @@
 #include <ExtendedIODevice.h>
 
 #include "AvatarData.h"
+#include "TraitBlobCache.h"
 
 namespace AvatarTraits {
 
+    static qint64 packTraitBlobData(const TraitBlob& blob, ExtendedIODevice& destination,
+                                    TraitBlobCache& receiverBlobs) {
+        qint64 bytesWritten = 0;
+
+        if (!blob.isShared()) {
+            bytesWritten += destination.writePrimitive((TraitWireSize)blob.data.size());
+            bytesWritten += destination.write(blob.data);
+            return bytesWritten;
+        }
+
+        if (receiverBlobs.contains(blob.hash)) {
+            bytesWritten += destination.writePrimitive(CACHED_TRAIT_SIZE);
+            bytesWritten += destination.write(blob.hash);
+        } else {
+            bytesWritten += destination.writePrimitive(COMPRESSED_TRAIT_SIZE);
+            bytesWritten += destination.write(blob.hash);
+            bytesWritten += destination.writePrimitive((TraitWireSize)blob.compressedData.size());
+            bytesWritten += destination.write(blob.compressedData);
+        }
+        receiverBlobs.touch(blob.hash);
+
+        return bytesWritten;
+    }
+
     qint64 packTrait(TraitType traitType, ExtendedIODevice& destination, const AvatarData& avatar) {
         // Call packer function
         auto traitBinaryData = avatar.packTrait(traitType);
@@ -121,6 +146,48 @@ namespace AvatarTraits {
     }
 
 
+    qint64 packVersionedTraitBlob(TraitType traitType, ExtendedIODevice& destination, TraitVersion traitVersion,
+                                  const TraitBlob& blob, TraitBlobCache& receiverBlobs) {
+        // Verify packed data
+        if (blob.data.size() > MAXIMUM_TRAIT_SIZE) {
+            qWarning() << "Refusing to pack simple trait" << traitType << "of size" << blob.data.size()
+                        << "bytes since it exceeds the maximum size" << MAXIMUM_TRAIT_SIZE << "bytes";
+            return 0;
+        }
+
+        // Write packed data to stream
+        qint64 bytesWritten = 0;
+        bytesWritten += destination.writePrimitive((TraitType)traitType);
+        bytesWritten += destination.writePrimitive((TraitVersion)traitVersion);
+        bytesWritten += packTraitBlobData(blob, destination, receiverBlobs);
+        return bytesWritten;
+    }
+
+    qint64 packVersionedTraitInstanceBlob(TraitType traitType, TraitInstanceID traitInstanceID,
+                                          ExtendedIODevice& destination, TraitVersion traitVersion,
+                                          const TraitBlob& blob, TraitBlobCache& receiverBlobs) {
+        // Verify packed data
+        if (blob.data.size() > AvatarTraits::MAXIMUM_TRAIT_SIZE) {
+            qWarning() << "Refusing to pack instanced trait" << traitType << "of size" << blob.data.size()
+                        << "bytes since it exceeds the maximum size " << AvatarTraits::MAXIMUM_TRAIT_SIZE << "bytes";
+            return 0;
+        }
+
+        // Write packed data to stream
+        qint64 bytesWritten = 0;
+        bytesWritten += destination.writePrimitive((TraitType)traitType);
+        bytesWritten += destination.writePrimitive((TraitVersion)traitVersion);
+        bytesWritten += destination.write(traitInstanceID.toRfc4122());
+
+        if (!blob.data.isNull()) {
+            bytesWritten += packTraitBlobData(blob, destination, receiverBlobs);
+        } else {
+            bytesWritten += destination.writePrimitive(AvatarTraits::DELETED_TRAIT_SIZE);
+        }
+
+        return bytesWritten;
+    }
+
     qint64 packInstancedTraitDelete(TraitType traitType, TraitInstanceID instanceID, ExtendedIODevice& destination,
                                          TraitVersion traitVersion) {
         qint64 bytesWritten = 0;
@@ -55,6 +55,8 @@ namespace AvatarTraits {
 
     using TraitWireSize = int16_t;
     const TraitWireSize DELETED_TRAIT_SIZE = -1;
+    const TraitWireSize COMPRESSED_TRAIT_SIZE = -2; // followed by the blob hash, compressed size and compressed data
+    const TraitWireSize CACHED_TRAIT_SIZE = -3; // followed by the hash of a blob the receiver already holds
     const TraitWireSize MAXIMUM_TRAIT_SIZE = INT16_MAX;
 
     using TraitMessageSequence = int64_t;
@@ -71,6 +73,17 @@ namespace AvatarTraits {
                                       ExtendedIODevice& destination, TraitVersion traitVersion,
                                       AvatarData& avatar);
 
+    struct TraitBlob;
+    class TraitBlobCache;
+
+    // write an already packed trait, as just its hash if it is a shared blob the receiver holds
+    // and compressed if it is one the receiver doesn't, receiverBlobs is updated to match what the receiver will hold
+    qint64 packVersionedTraitBlob(TraitType traitType, ExtendedIODevice& destination, TraitVersion traitVersion,
+                                  const TraitBlob& blob, TraitBlobCache& receiverBlobs);
+    qint64 packVersionedTraitInstanceBlob(TraitType traitType, TraitInstanceID traitInstanceID,
+                                          ExtendedIODevice& destination, TraitVersion traitVersion,
+                                          const TraitBlob& blob, TraitBlobCache& receiverBlobs);
+
     qint64 packInstancedTraitDelete(TraitType traitType, TraitInstanceID instanceID, ExtendedIODevice& destination,
                                            TraitVersion traitVersion = NULL_TRAIT_VERSION);
 
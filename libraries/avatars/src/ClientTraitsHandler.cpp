@@ -18,6 +18,8 @@
 
 #include "AvatarData.h"
 
+static const quint64 MIN_AVATAR_ENTITY_SEND_INTERVAL_USECS = USECS_PER_SECOND / 10;
+
 ClientTraitsHandler::ClientTraitsHandler(AvatarData* owningAvatar) :
     _owningAvatar(owningAvatar)
 {
@@ -60,6 +62,7 @@ void ClientTraitsHandler::resetForNewMixer() {
 
     // reset the trait statuses
     _traitStatuses.reset();
+    _avatarEntitySendTimes.clear();
 
     // pre-fill the instanced statuses that we will need to send next frame
     _owningAvatar->prepareResetTraitInstances();
@@ -97,8 +100,12 @@ int ClientTraitsHandler::sendChangedTraitsToMixer() {
 
         // we can release the lock here since we've taken a copy of statuses
         // and will setup the packet using the information in the copy
+        auto avatarEntitySendTimes = _avatarEntitySendTimes;
         lock.unlock();
 
+        auto now = usecTimestampNow();
+        std::vector<QUuid> deferredAvatarEntities;
+
         auto simpleIt = traitStatusesCopy.simpleCBegin();
         while (simpleIt != traitStatusesCopy.simpleCEnd()) {
             // because the vector contains all trait types (for access using trait type as index)
@@ -119,25 +126,56 @@ int ClientTraitsHandler::sendChangedTraitsToMixer() {
 
         auto instancedIt = traitStatusesCopy.instancedCBegin();
         while (instancedIt != traitStatusesCopy.instancedCEnd()) {
+            bool isAvatarEntity = instancedIt->traitType == AvatarTraits::AvatarEntity;
             for (auto& instanceIDValuePair : instancedIt->instances) {
                 if ((initialSend && instanceIDValuePair.value != Deleted)
                     || instanceIDValuePair.value == Updated) {
+                    if (isAvatarEntity && !initialSend) {
+                        auto sendTimeIt = avatarEntitySendTimes.find(instanceIDValuePair.id);
+                        if (sendTimeIt != avatarEntitySendTimes.end() &&
+                            now - sendTimeIt.value() < MIN_AVATAR_ENTITY_SEND_INTERVAL_USECS) {
+                            // sent too recently, it goes in a later packet with whatever it has become by then
+                            deferredAvatarEntities.push_back(instanceIDValuePair.id);
+                            continue;
+                        }
+                    }
+
                     // this is a changed trait we need to send or we haven't send out trait information yet
                     // ask the owning avatar to pack it
                     bytesWritten += AvatarTraits::packTraitInstance(instancedIt->traitType, instanceIDValuePair.id,
                                                                     *traitsPacketList, *_owningAvatar);
+                    if (isAvatarEntity) {
+                        avatarEntitySendTimes[instanceIDValuePair.id] = now;
+                    }
 
                 } else if (!initialSend && instanceIDValuePair.value == Deleted) {
                     // pack delete for this trait instance
                     bytesWritten += AvatarTraits::packInstancedTraitDelete(instancedIt->traitType, instanceIDValuePair.id,
                                                            *traitsPacketList);
+                    if (isAvatarEntity) {
+                        avatarEntitySendTimes.remove(instanceIDValuePair.id);
+                    }
                 }
             }
 
             ++instancedIt;
         }
 
-        nodeList->sendPacketList(std::move(traitsPacketList), *avatarMixer);
+        lock.lock();
+        _avatarEntitySendTimes = avatarEntitySendTimes;
+        for (const auto& entityID : deferredAvatarEntities) {
+            // unless it was deleted meanwhile
+            auto& status = _traitStatuses.getInstanceValueRef(AvatarTraits::AvatarEntity, entityID);
+            if (status == Unchanged) {
+                status = Updated;
+            }
+            _hasChangedTraits = true;
+        }
+        lock.unlock();
+
+        if (bytesWritten > 0) {
+            nodeList->sendPacketList(std::move(traitsPacketList), *avatarMixer);
+        }
     }
 
     return bytesWritten;
@@ -12,6 +12,8 @@
 #ifndef hifi_ClientTraitsHandler_h
 #define hifi_ClientTraitsHandler_h
 
+#include <QtCore/QHash>
+
 #include <ReceivedMessage.h>
 
 #include "AssociatedTraitValues.h"
@@ -52,6 +54,10 @@ private:
     Mutex _traitLock;
     AvatarTraits::AssociatedTraitValues<ClientTraitStatus, Unchanged> _traitStatuses;
 
+    // when each avatar entity was last sent, the scripts that change one every frame only get it sent at a bounded rate,
+    // with the properties it has by then
+    QHash<QUuid, quint64> _avatarEntitySendTimes;
+
     AvatarTraits::TraitVersion _currentTraitVersion { AvatarTraits::DEFAULT_TRAIT_VERSION };
     AvatarTraits::TraitVersion _currentSkeletonVersion { AvatarTraits::NULL_TRAIT_VERSION };
     
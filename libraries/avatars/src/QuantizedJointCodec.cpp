@@ -0,0 +1,181 @@
+//
+//  QuantizedJointCodec.cpp
+//  libraries/avatars/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "QuantizedJointCodec.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace QuantizedJointCodec {
+
+// bits per component for each precision, the last one is about a hundredth of a degree
+static const int ROTATION_COMPONENT_BITS[NUM_ROTATION_PRECISIONS] = { 7, 9, 11, MAX_ROTATION_COMPONENT_BITS };
+
+// the smallest three components of a unit quaternion with a negative largest one are within this of zero
+static const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+
+static const float TRANSLATION_RANGE = (float)((1 << (TRANSLATION_COMPONENT_BITS - 1)) - 1);
+
+void BitWriter::write(uint32_t value, int numBits) {
+    for (int i = numBits - 1; i >= 0; --i) {
+        if (value & (1U << i)) {
+            _buffer[_numBits / 8] |= 0x80 >> (_numBits % 8);
+        }
+        ++_numBits;
+    }
+}
+
+void BitWriter::writeGap(int gap) {
+    // Exp-Golomb: as many zeros as gap + 1 has bits after its leading one, then gap + 1 itself
+    uint32_t value = (uint32_t)gap + 1;
+    int numBits = 0;
+    while ((value >> (numBits + 1)) != 0) {
+        ++numBits;
+    }
+    write(0, numBits);
+    write(value, numBits + 1);
+}
+
+bool BitReader::read(int numBits, uint32_t& value) {
+    if (_numBits + numBits > _numBitsAvailable) {
+        return false;
+    }
+
+    uint32_t result = 0;
+    for (int i = 0; i < numBits; ++i) {
+        int bit = (_buffer[_numBits / 8] >> (7 - _numBits % 8)) & 1;
+        result = (result << 1) | bit;
+        ++_numBits;
+    }
+    value = result;
+    return true;
+}
+
+bool BitReader::readGap(int& gap) {
+    const int MAX_LEADING_ZEROS = MAX_GAP_BITS / 2;
+
+    int numLeadingZeros = 0;
+    uint32_t bit = 0;
+    while (read(1, bit) && bit == 0) {
+        if (++numLeadingZeros > MAX_LEADING_ZEROS) {
+            return false;
+        }
+    }
+
+    uint32_t rest = 0;
+    if (bit == 0 || !read(numLeadingZeros, rest)) {
+        return false;
+    }
+    gap = (int)(((1U << numLeadingZeros) | rest) - 1);
+    return true;
+}
+
+// the worst angle between a rotation and its quantized self: rounding leaves each sent component within half a step,
+// and the reconstructed largest component is at most as far off again
+static float maxRotationError(int componentBits) {
+    float step = 2.0f * MAGNITUDE / (float)((1 << componentBits) - 1);
+    return 3.0f * step;
+}
+
+int rotationPrecisionFor(float minRotationDOT) {
+    float tolerance = 2.0f * (float)acos(std::min(std::max((double)minRotationDOT, 0.0), 1.0));
+
+    for (int precision = 0; precision < NUM_ROTATION_PRECISIONS - 1; ++precision) {
+        if (maxRotationError(ROTATION_COMPONENT_BITS[precision]) < tolerance) {
+            return precision;
+        }
+    }
+    return NUM_ROTATION_PRECISIONS - 1;
+}
+
+void writeRotation(BitWriter& writer, const glm::quat& rotation, int precision) {
+    int largestComponent = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabsf(rotation[i]) > fabsf(rotation[largestComponent])) {
+            largestComponent = i;
+        }
+    }
+
+    // ensure that the sign of the dropped component is always negative
+    glm::quat q = rotation[largestComponent] > 0.0f ? -rotation : rotation;
+
+    int componentBits = ROTATION_COMPONENT_BITS[precision];
+    float range = (float)((1 << componentBits) - 1);
+
+    writer.write((uint32_t)precision, ROTATION_PRECISION_BITS);
+    writer.write((uint32_t)largestComponent, LARGEST_COMPONENT_BITS);
+    for (int i = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            float value = (q[i] + MAGNITUDE) / (2.0f * MAGNITUDE);
+            float quantized = std::min(std::max(roundf(value * range), 0.0f), range);
+            writer.write((uint32_t)quantized, componentBits);
+        }
+    }
+}
+
+bool readRotation(BitReader& reader, glm::quat& rotation) {
+    uint32_t precision;
+    uint32_t largestComponent;
+    if (!reader.read(ROTATION_PRECISION_BITS, precision) || !reader.read(LARGEST_COMPONENT_BITS, largestComponent)) {
+        return false;
+    }
+
+    int componentBits = ROTATION_COMPONENT_BITS[precision];
+    float range = (float)((1 << componentBits) - 1);
+
+    float components[3];
+    float sumOfSquares = 0.0f;
+    for (int j = 0; j < 3; j++) {
+        uint32_t quantized;
+        if (!reader.read(componentBits, quantized)) {
+            return false;
+        }
+        components[j] = ((float)quantized / range) * (2.0f * MAGNITUDE) - MAGNITUDE;
+        sumOfSquares += components[j] * components[j];
+    }
+
+    // the dropped component is always negative, rounding can push the others' magnitude just past one
+    float missingComponent = -sqrtf(std::max(1.0f - sumOfSquares, 0.0f));
+
+    for (int i = 0, j = 0; i < 4; i++) {
+        if (i != (int)largestComponent) {
+            rotation[i] = components[j];
+            j++;
+        } else {
+            rotation[i] = missingComponent;
+        }
+    }
+    return true;
+}
+
+void writeTranslation(BitWriter& writer, const glm::vec3& normalizedTranslation) {
+    for (int i = 0; i < 3; i++) {
+        float quantized = std::min(std::max(roundf(normalizedTranslation[i] * TRANSLATION_RANGE), -TRANSLATION_RANGE),
+                                   TRANSLATION_RANGE);
+        writer.write((uint32_t)(int32_t)quantized, TRANSLATION_COMPONENT_BITS);
+    }
+}
+
+bool readTranslation(BitReader& reader, glm::vec3& normalizedTranslation) {
+    glm::vec3 result;
+    for (int i = 0; i < 3; i++) {
+        uint32_t quantized;
+        if (!reader.read(TRANSLATION_COMPONENT_BITS, quantized)) {
+            return false;
+        }
+        // sign extend
+        int32_t value = (int32_t)(quantized << (32 - TRANSLATION_COMPONENT_BITS)) >> (32 - TRANSLATION_COMPONENT_BITS);
+        result[i] = (float)value / TRANSLATION_RANGE;
+    }
+    normalizedTranslation = result;
+    return true;
+}
+
+}
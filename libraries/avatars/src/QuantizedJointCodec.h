@@ -0,0 +1,87 @@
+//
+//  QuantizedJointCodec.h
+//  libraries/avatars/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_QuantizedJointCodec_h
+#define hifi_QuantizedJointCodec_h
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// The bit-packed encoding of the joint data section of an avatar data packet.
+//
+// Each section is a run of joints that changed, each one prefixed by the number of unchanged joints skipped since the
+// previous one (Exp-Golomb coded, so the common runs of consecutive changes cost a single bit). Rotations are sent as the
+// smallest three components of the quaternion at one of a few bit depths, chosen per joint so that the quantization
+// error stays under the change the receiver ignores anyway. Translations are normalized fixed point.
+namespace QuantizedJointCodec {
+
+    class BitWriter {
+    public:
+        // the buffer must be zeroed
+        BitWriter(unsigned char* buffer) : _buffer(buffer) {}
+
+        void write(uint32_t value, int numBits);
+        void writeGap(int gap);
+
+        // one past the last byte written to
+        unsigned char* end() const { return _buffer + (_numBits + 7) / 8; }
+
+    private:
+        unsigned char* _buffer;
+        int _numBits { 0 };
+    };
+
+    class BitReader {
+    public:
+        BitReader(const unsigned char* buffer, const unsigned char* bufferEnd) :
+            _buffer(buffer), _numBitsAvailable((int)(bufferEnd - buffer) * 8) {}
+
+        // these return false, leaving the value untouched, once the buffer runs out
+        bool read(int numBits, uint32_t& value);
+        bool readGap(int& gap);
+
+        // one past the last byte read from
+        const unsigned char* end() const { return _buffer + (_numBits + 7) / 8; }
+
+    private:
+        const unsigned char* _buffer;
+        int _numBits { 0 };
+        int _numBitsAvailable;
+    };
+
+    // the largest gap is between the start and the last of 256 joints
+    const int MAX_GAP_BITS = 17;
+
+    const int NUM_ROTATION_PRECISIONS = 4;
+    const int ROTATION_PRECISION_BITS = 2;
+    const int LARGEST_COMPONENT_BITS = 2;
+    const int MAX_ROTATION_COMPONENT_BITS = 13;
+    const int TRANSLATION_COMPONENT_BITS = 16;
+
+    // the most a joint can add to a section, gap included
+    const int MAX_ROTATION_BYTES =
+        (MAX_GAP_BITS + ROTATION_PRECISION_BITS + LARGEST_COMPONENT_BITS + 3 * MAX_ROTATION_COMPONENT_BITS + 7) / 8;
+    const int MAX_TRANSLATION_BYTES = (MAX_GAP_BITS + 3 * TRANSLATION_COMPONENT_BITS + 7) / 8;
+
+    // the precision whose worst rotation error is under the change a receiver ignores, given as the smallest dot
+    // product between two rotations that are considered the same
+    int rotationPrecisionFor(float minRotationDOT);
+
+    void writeRotation(BitWriter& writer, const glm::quat& rotation, int precision);
+    bool readRotation(BitReader& reader, glm::quat& rotation);
+
+    // translation components are normalized to [-1, 1]
+    void writeTranslation(BitWriter& writer, const glm::vec3& normalizedTranslation);
+    bool readTranslation(BitReader& reader, glm::vec3& normalizedTranslation);
+}
+
+#endif // hifi_QuantizedJointCodec_h
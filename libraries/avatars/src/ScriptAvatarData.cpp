@@ -250,6 +250,13 @@ int ScriptAvatarData::getJointIndex(const QString& name) const {
         return -1;
     }
 }
+QVariantList ScriptAvatarData::getJointIndices(const QStringList& names) const {
+    if (AvatarSharedPointer sharedAvatarData = _avatarData.lock()) {
+        return sharedAvatarData->getJointIndices(names);
+    } else {
+        return QVariantList();
+    }
+}
 QStringList ScriptAvatarData::getJointNames() const {
     if (AvatarSharedPointer sharedAvatarData = _avatarData.lock()) {
         return sharedAvatarData->getJointNames();
@@ -162,6 +162,7 @@ public:
     Q_INVOKABLE QVector<glm::vec3> getJointTranslations() const;
     Q_INVOKABLE bool isJointDataValid(const QString& name) const;
     Q_INVOKABLE int getJointIndex(const QString& name) const;
+    Q_INVOKABLE QVariantList getJointIndices(const QStringList& names) const;
     Q_INVOKABLE QStringList getJointNames() const;
     Q_INVOKABLE QVector<AttachmentData> getAttachmentData() const;
 
@@ -0,0 +1,61 @@
+//
+//  TraitBlobCache.cpp
+//  libraries/avatars/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TraitBlobCache.h"
+
+#include <QtCore/QCryptographicHash>
+
+#include "AvatarTraits.h"
+
+namespace AvatarTraits {
+
+    TraitBlob TraitBlob::fromData(const QByteArray& data) {
+        TraitBlob blob;
+        blob.data = data;
+
+        if (data.size() >= MIN_SHARED_TRAIT_SIZE) {
+            auto compressedData = qCompress(data);
+
+            // the compressed size goes out in the same field as a plain trait's
+            if (compressedData.size() <= MAXIMUM_TRAIT_SIZE) {
+                blob.hash = QCryptographicHash::hash(data, QCryptographicHash::Md5);
+                blob.compressedData = compressedData;
+            }
+        }
+
+        return blob;
+    }
+
+    QByteArray TraitBlobCache::find(const QByteArray& hash) const {
+        auto it = _entries.find(hash);
+        return it != _entries.end() ? (*it)->data : QByteArray();
+    }
+
+    void TraitBlobCache::touch(const QByteArray& hash, const QByteArray& data) {
+        auto it = _entries.find(hash);
+        if (it != _entries.end()) {
+            _recency.splice(_recency.begin(), _recency, *it);
+            return;
+        }
+
+        if (_entries.size() >= MAX_CACHED_TRAIT_BLOBS) {
+            _entries.remove(_recency.back().hash);
+            _recency.pop_back();
+        }
+
+        _recency.push_front({ hash, data });
+        _entries.insert(hash, _recency.begin());
+    }
+
+    void TraitBlobCache::clear() {
+        _entries.clear();
+        _recency.clear();
+    }
+};
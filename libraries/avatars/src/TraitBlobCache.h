@@ -0,0 +1,65 @@
+//
+//  TraitBlobCache.h
+//  libraries/avatars/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TraitBlobCache_h
+#define hifi_TraitBlobCache_h
+
+#include <list>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+
+namespace AvatarTraits {
+    // traits at least this big are sent as shared blobs, smaller ones aren't worth the hash
+    const int MIN_SHARED_TRAIT_SIZE = 64;
+    const int TRAIT_BLOB_HASH_SIZE = 16;
+    const int MAX_CACHED_TRAIT_BLOBS = 256;
+
+    // A packed trait along with what it takes to send it as a shared blob, the hash and compressed data are empty
+    // for traits that are sent as they are.
+    struct TraitBlob {
+        QByteArray data;
+        QByteArray hash;
+        QByteArray compressedData;
+
+        bool isShared() const { return !hash.isEmpty(); }
+
+        static TraitBlob fromData(const QByteArray& data);
+    };
+
+    // The trait blobs the receiving end of a traits stream holds, the most recently used first.
+    // The client keeps the data, the avatar mixer keeps a copy of each listener's cache without it. Traits are sent
+    // reliably and in order, so as long as both ends touch their cache for every blob in the same order the mixer
+    // knows exactly which blobs it can send as just their hash.
+    class TraitBlobCache {
+    public:
+        bool contains(const QByteArray& hash) const { return _entries.contains(hash); }
+
+        // returns a null array for blobs that aren't held or whose data isn't kept
+        QByteArray find(const QByteArray& hash) const;
+
+        // marks the blob as the most recently used, adding it and evicting the least recently used one if needed
+        void touch(const QByteArray& hash, const QByteArray& data = QByteArray());
+
+        void clear();
+
+        int size() const { return _entries.size(); }
+
+    private:
+        struct Entry {
+            QByteArray hash;
+            QByteArray data;
+        };
+        std::list<Entry> _recency;
+        QHash<QByteArray, std::list<Entry>::iterator> _entries;
+    };
+};
+
+#endif // hifi_TraitBlobCache_h
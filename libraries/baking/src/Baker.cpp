@@ -44,6 +44,12 @@ void Baker::handleWarning(const QString& warning) {
     _warningList.append(warning);
 }
 
+void Baker::endStage(const QString& stage) {
+    if (_stageTimer.isValid()) {
+        _stageTimes.emplace_back(stage, _stageTimer.restart());
+    }
+}
+
 void Baker::setIsFinished(bool isFinished) {
     _isFinished.store(isFinished);
 
@@ -12,6 +12,9 @@
 #ifndef hifi_Baker_h
 #define hifi_Baker_h
 
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
 
 class Baker : public QObject {
@@ -37,6 +40,9 @@ public:
 
     bool wasAborted() const { return _wasAborted.load(); }
 
+    // the milliseconds that each stage of the bake took, in the order they ran
+    std::vector<std::pair<QString, qint64>> getStageTimes() const { return _stageTimes; }
+
 public slots:
     virtual void bake() = 0;
     virtual void abort() { _shouldAbort.store(true); }
@@ -51,6 +57,10 @@ protected:
 
     void handleErrors(const QStringList& errors);
 
+    void startStages() { _stageTimer.start(); }
+    // records the time since the end of the last stage, or since the stages started, as the time of this one
+    void endStage(const QString& stage);
+
     // List of baked output files. For instance, for an FBX this would
     // include the .fbx, a .fst pointing to the fbx, and all of the fbx texture files.
     std::vector<QString> _outputFiles;
@@ -62,6 +72,9 @@ protected:
 
     std::atomic<bool> _shouldAbort { false };
     std::atomic<bool> _wasAborted { false };
+
+    std::vector<std::pair<QString, qint64>> _stageTimes;
+    QElapsedTimer _stageTimer;
 };
 
 #endif // hifi_Baker_h
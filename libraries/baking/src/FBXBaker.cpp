@@ -50,7 +50,7 @@ void FBXBaker::bakeProcessedSource(const hfm::Model::Pointer& hfmModel, const st
     rewriteAndBakeSceneModels(hfmModel->meshes, dracoMeshes, dracoMaterialLists);
 }
 
-void FBXBaker::replaceMeshNodeWithDraco(FBXNode& meshNode, const QByteArray& dracoMeshBytes, const std::vector<hifi::ByteArray>& dracoMaterialList) {
+void FBXBaker::replaceMeshNodeWithDraco(FBXNode& meshNode, const hfm::Mesh& mesh, const QByteArray& dracoMeshBytes, const std::vector<hifi::ByteArray>& dracoMaterialList) {
     // Compress mesh information and store in dracoMeshNode
     FBXNode dracoMeshNode;
     bool success = buildDracoMeshNode(dracoMeshNode, dracoMeshBytes, dracoMaterialList);
@@ -58,6 +58,7 @@ void FBXBaker::replaceMeshNodeWithDraco(FBXNode& meshNode, const QByteArray& dra
     if (!success) {
         return;
     } else {
+        addMeshLodNodes(dracoMeshNode, mesh);
         meshNode.children.push_back(dracoMeshNode);
 
         static const std::vector<QString> nodeNamesToDelete {
@@ -108,7 +109,7 @@ void FBXBaker::rewriteAndBakeSceneModels(const QVector<hfm::Mesh>& meshes, const
                 if (object->name == "Geometry") {
                     if (object->properties.at(2) == "Mesh") {
                         int meshNum = meshIndexToRuntimeOrder[meshIndex];
-                        replaceMeshNodeWithDraco(*object, dracoMeshes[meshNum], dracoMaterialLists[meshNum]);
+                        replaceMeshNodeWithDraco(*object, meshes[meshNum], dracoMeshes[meshNum], dracoMaterialLists[meshNum]);
                         meshIndex++;
                     }
                     object++;
@@ -133,7 +134,7 @@ void FBXBaker::rewriteAndBakeSceneModels(const QVector<hfm::Mesh>& meshes, const
                         } else if (modelChild.name == "Vertices") {
                             // This model is also a mesh
                             int meshNum = meshIndexToRuntimeOrder[meshIndex];
-                            replaceMeshNodeWithDraco(*object, dracoMeshes[meshNum], dracoMaterialLists[meshNum]);
+                            replaceMeshNodeWithDraco(*object, meshes[meshNum], dracoMeshes[meshNum], dracoMaterialLists[meshNum]);
                             meshIndex++;
                         }
                     }
@@ -11,10 +11,12 @@
 
 #include "MaterialBaker.h"
 
+#include <map>
 #include <unordered_map>
 
 #include "QJsonObject"
 #include "QJsonDocument"
+#include <QtCore/QBuffer>
 
 #include "MaterialBakingLoggingCategory.h"
 
@@ -23,7 +25,10 @@
 
 #include <graphics-scripting/GraphicsScriptingInterface.h>
 
-std::function<QThread*()> MaterialBaker::_getNextOvenWorkerThreadOperator;
+#include "baking/BakeScheduler.h"
+#include "baking/TextureAtlasPacker.h"
+
+bool MaterialBaker::_textureAtlasesEnabled = false;
 
 static int materialNum = 0;
 
@@ -38,6 +43,7 @@ MaterialBaker::MaterialBaker(const QString& materialData, bool isURL, const QStr
 
 void MaterialBaker::bake() {
     qDebug(material_baking) << "Material Baker" << _materialData << "bake starting";
+    startStages();
 
     // once our script is loaded, kick off a the processing
     connect(this, &MaterialBaker::originalMaterialLoaded, this, &MaterialBaker::processMaterial);
@@ -87,6 +93,8 @@ void MaterialBaker::loadMaterial() {
 }
 
 void MaterialBaker::processMaterial() {
+    endStage("load");
+
     if (!_materialResource || _materialResource->parsedMaterials.networkMaterials.size() == 0) {
         handleError("Error processing " + _materialData);
         return;
@@ -101,8 +109,12 @@ void MaterialBaker::processMaterial() {
         }
     }
 
+    if (_textureAtlasesEnabled) {
+        packTextureAtlases();
+    }
+
     for (auto networkMaterial : _materialResource->parsedMaterials.networkMaterials) {
-        if (networkMaterial.second) {
+        if (networkMaterial.second && _atlasedMaterials.find(networkMaterial.first) == _atlasedMaterials.end()) {
             auto textures = networkMaterial.second->getTextures();
             for (auto texturePair : textures) {
                 auto mapChannel = texturePair.first;
@@ -134,24 +146,7 @@ void MaterialBaker::processMaterial() {
 
                     if (QImageReader::supportedImageFormats().contains(extension.toLatin1())) {
                         TextureKey textureKey(textureURL, type);
-                        if (!_textureBakers.contains(textureKey)) {
-                            auto baseTextureFileName = _textureFileNamer.createBaseTextureFileName(textureURL.fileName(), type);
-
-                            QSharedPointer<TextureBaker> textureBaker {
-                                new TextureBaker(textureURL, type, _textureOutputDir, baseTextureFileName, content),
-                                &TextureBaker::deleteLater
-                            };
-                            textureBaker->setMapChannel(mapChannel);
-                            connect(textureBaker.data(), &TextureBaker::finished, this, &MaterialBaker::handleFinishedTextureBaker);
-                            _textureBakers.insert(textureKey, textureBaker);
-                            textureBaker->moveToThread(_getNextOvenWorkerThreadOperator ? _getNextOvenWorkerThreadOperator() : thread());
-                            // By default, Qt will invoke this bake immediately if the TextureBaker is on the same worker thread as this MaterialBaker.
-                            // We don't want that, because threads may be waiting for work while this thread is stuck processing a TextureBaker.
-                            // On top of that, _textureBakers isn't fully populated.
-                            // So, use Qt::QueuedConnection.
-                            // TODO: Better thread utilization at the top level, not just the MaterialBaker level
-                            QMetaObject::invokeMethod(textureBaker.data(), "bake", Qt::QueuedConnection);
-                        }
+                        bakeTexture(textureKey, content, mapChannel);
                         _materialsNeedingRewrite.insert(textureKey, networkMaterial.second);
                     } else {
                         qCDebug(material_baking) << "Texture extension not supported: " << extension;
@@ -166,6 +161,155 @@ void MaterialBaker::processMaterial() {
     }
 }
 
+void MaterialBaker::bakeTexture(const TextureKey& textureKey, const QByteArray& content, graphics::Material::MapChannel mapChannel) {
+    if (_textureBakers.contains(textureKey)) {
+        return;
+    }
+
+    auto& textureURL = textureKey.first;
+    auto type = textureKey.second;
+    auto baseTextureFileName = _textureFileNamer.createBaseTextureFileName(textureURL.fileName(), type);
+
+    QSharedPointer<TextureBaker> textureBaker {
+        new TextureBaker(textureURL, type, _textureOutputDir, baseTextureFileName, content),
+        &TextureBaker::deleteLater
+    };
+    textureBaker->setMapChannel(mapChannel);
+    connect(textureBaker.data(), &TextureBaker::finished, this, &MaterialBaker::handleFinishedTextureBaker);
+    _textureBakers.insert(textureKey, textureBaker);
+    // the scheduler starts the bake on a worker thread once one is free, never right away on this one, since
+    // _textureBakers isn't fully populated yet
+    BakeScheduler::instance().schedule(textureBaker.data());
+}
+
+QImage MaterialBaker::loadAtlasImage(const std::string& materialName, image::TextureUsage::Type type, const QUrl& textureURL) {
+    auto textureContentMapIter = _textureContentMap.find(materialName);
+    if (textureContentMapIter != _textureContentMap.end()) {
+        auto textureUsageIter = textureContentMapIter->second.find(type);
+        if (textureUsageIter != textureContentMapIter->second.end()) {
+            return QImage::fromData(textureUsageIter->second.first);
+        }
+    }
+    // the remote textures are only downloaded by their own bakers
+    if (textureURL.isLocalFile()) {
+        return QImage(textureURL.toLocalFile());
+    }
+    return QImage();
+}
+
+void MaterialBaker::packTextureAtlases() {
+    using MapChannel = graphics::Material::MapChannel;
+    using AtlasMap = std::pair<MapChannel, image::TextureUsage::Type>;
+    struct Candidate {
+        std::string name;
+        std::shared_ptr<NetworkMaterial> material;
+        std::vector<QImage> images;
+        QSize size;
+    };
+
+    // the materials are packed with the ones that have the same maps, so that none of the atlases has holes
+    std::map<std::vector<AtlasMap>, std::vector<Candidate>> groups;
+    for (auto& name : _materialResource->parsedMaterials.names) {
+        if (_atlasableMaterials.find(name) == _atlasableMaterials.end()) {
+            continue;
+        }
+        auto materialIter = _materialResource->parsedMaterials.networkMaterials.find(name);
+        if (materialIter == _materialResource->parsedMaterials.networkMaterials.end() || !materialIter->second ||
+                materialIter->second->getTexCoordTransform(0) != glm::mat4()) {
+            continue;
+        }
+
+        Candidate candidate { name, materialIter->second, {}, QSize() };
+        std::vector<AtlasMap> maps;
+        bool isAtlasable = true;
+        auto textures = candidate.material->getTextures();
+        for (int channel = 0; channel < MapChannel::NUM_MAP_CHANNELS && isAtlasable; ++channel) {
+            auto textureIter = textures.find((MapChannel)channel);
+            if (textureIter == textures.end() || !textureIter->second.texture || !textureIter->second.texture->_textureSource) {
+                continue;
+            }
+            // these are read with the second set of texture coordinates
+            if (channel == MapChannel::OCCLUSION_MAP || channel == MapChannel::LIGHT_MAP) {
+                isAtlasable = false;
+                break;
+            }
+            auto type = textureIter->second.texture->getTextureType();
+            auto textureURL = textureIter->second.texture->_textureSource->getUrl().adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment);
+            QImage image = loadAtlasImage(name, type, textureURL);
+            // the alpha of a texture decides the opacity mode of its materials, so none of them is shared
+            if (image.isNull() || image.hasAlphaChannel() || image.width() > TextureAtlasPacker::MAX_PACKED_TEXTURE_SIZE ||
+                    image.height() > TextureAtlasPacker::MAX_PACKED_TEXTURE_SIZE) {
+                isAtlasable = false;
+                break;
+            }
+            maps.push_back({ (MapChannel)channel, type });
+            candidate.images.push_back(image);
+            candidate.size = candidate.size.expandedTo(image.size());
+        }
+        if (isAtlasable && !maps.empty()) {
+            groups[maps].push_back(std::move(candidate));
+        }
+    }
+
+    int atlasNum = 0;
+    for (auto& group : groups) {
+        auto& maps = group.first;
+        auto& candidates = group.second;
+        if (candidates.size() < 2) {
+            continue;
+        }
+
+        std::vector<QSize> sizes;
+        for (auto& candidate : candidates) {
+            sizes.push_back(candidate.size);
+        }
+        TextureAtlasPacker packer;
+        packer.pack(sizes);
+        auto& placements = packer.getPlacements();
+        auto& pageSizes = packer.getPageSizes();
+
+        for (int page = 0; page < (int)pageSizes.size(); ++page) {
+            std::vector<size_t> pageCandidates;
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                if (placements[i].page == page) {
+                    pageCandidates.push_back(i);
+                }
+            }
+            if (pageCandidates.size() < 2) {
+                continue;
+            }
+
+            auto atlasName = "atlas" + QString::number(atlasNum++);
+            for (size_t mapIndex = 0; mapIndex < maps.size(); ++mapIndex) {
+                QImage atlas(pageSizes[page], QImage::Format_ARGB32);
+                atlas.fill(Qt::black);
+                for (auto i : pageCandidates) {
+                    TextureAtlasPacker::draw(atlas, candidates[i].images[mapIndex], placements[i].rect);
+                }
+
+                QByteArray content;
+                QBuffer buffer(&content);
+                buffer.open(QIODevice::WriteOnly);
+                atlas.save(&buffer, "PNG");
+
+                auto atlasURL = QUrl::fromLocalFile(_textureOutputDir + "/" + atlasName + "_" + QString::number(maps[mapIndex].first) + ".png");
+                TextureKey textureKey(atlasURL, maps[mapIndex].second);
+                bakeTexture(textureKey, content, maps[mapIndex].first);
+                for (auto i : pageCandidates) {
+                    _materialsNeedingRewrite.insert(textureKey, candidates[i].material);
+                }
+            }
+
+            for (auto i : pageCandidates) {
+                _atlasedMaterials.insert(candidates[i].name);
+                _atlasTexCoordTransforms[candidates[i].material.get()] =
+                    TextureAtlasPacker::evalTexCoordTransform(placements[i].rect, pageSizes[page]);
+            }
+            qCDebug(material_baking) << "Packed the textures of" << pageCandidates.size() << "materials into" << atlasName;
+        }
+    }
+}
+
 void MaterialBaker::handleFinishedTextureBaker() {
     auto baker = qobject_cast<TextureBaker*>(sender());
 
@@ -185,6 +329,11 @@ void MaterialBaker::handleFinishedTextureBaker() {
             // Replace the old texture URLs
             for (auto networkMaterial : _materialsNeedingRewrite.values(textureKey)) {
                 networkMaterial->getTextureMap(baker->getMapChannel())->getTextureSource()->setUrl(relativeURL);
+
+                auto atlasIter = _atlasTexCoordTransforms.find(networkMaterial.get());
+                if (atlasIter != _atlasTexCoordTransforms.end()) {
+                    networkMaterial->setTexCoordTransform(0, atlasIter->second);
+                }
             }
         } else {
             // this texture failed to bake - this doesn't fail the entire bake but we need to add the errors from
@@ -204,6 +353,8 @@ void MaterialBaker::handleFinishedTextureBaker() {
 }
 
 void MaterialBaker::outputMaterial() {
+    endStage("textures");
+
     if (_materialResource) {
         QJsonObject json;
         if (_materialResource->parsedMaterials.networkMaterials.size() == 1) {
@@ -12,6 +12,8 @@
 #ifndef hifi_MaterialBaker_h
 #define hifi_MaterialBaker_h
 
+#include <unordered_set>
+
 #include "Baker.h"
 
 #include "TextureBaker.h"
@@ -35,9 +37,12 @@ public:
     void setMaterials(const QHash<QString, hfm::Material>& materials, const QString& baseURL);
     void setMaterials(const NetworkMaterialResourcePointer& materialResource);
 
+    // the materials whose texture coordinates stay within their textures, so that they can be moved into an atlas
+    void setAtlasableMaterials(const std::unordered_set<std::string>& materialNames) { _atlasableMaterials = materialNames; }
+
     NetworkMaterialResourcePointer getNetworkMaterialResource() const { return _materialResource; }
 
-    static void setNextOvenWorkerThreadOperator(std::function<QThread*()> getNextOvenWorkerThreadOperator) { _getNextOvenWorkerThreadOperator = getNextOvenWorkerThreadOperator; }
+    static void setTextureAtlasesEnabled(bool enabled) { _textureAtlasesEnabled = enabled; }
 
 public slots:
     virtual void bake() override;
@@ -53,6 +58,10 @@ private slots:
 
 private:
     void loadMaterial();
+    void bakeTexture(const TextureKey& textureKey, const QByteArray& content, graphics::Material::MapChannel mapChannel);
+
+    QImage loadAtlasImage(const std::string& materialName, image::TextureUsage::Type type, const QUrl& textureURL);
+    void packTextureAtlases();
 
     QString _materialData;
     bool _isURL;
@@ -63,12 +72,17 @@ private:
     QHash<TextureKey, QSharedPointer<TextureBaker>> _textureBakers;
     QMultiHash<TextureKey, std::shared_ptr<NetworkMaterial>> _materialsNeedingRewrite;
 
+    std::unordered_set<std::string> _atlasableMaterials;
+    std::unordered_set<std::string> _atlasedMaterials;
+    // where the materials moved into an atlas find their textures in it
+    std::unordered_map<NetworkMaterial*, glm::mat4> _atlasTexCoordTransforms;
+    static bool _textureAtlasesEnabled;
+
     QString _bakedOutputDir;
     QString _textureOutputDir;
     QString _bakedMaterialData;
 
     QScriptEngine _scriptEngine;
-    static std::function<QThread*()> _getNextOvenWorkerThreadOperator;
     TextureFileNamer _textureFileNamer;
 
     void addTexture(const QString& materialName, image::TextureUsage::Type textureUsage, const hfm::Texture& texture);
@@ -81,6 +81,7 @@ QUrl ModelBaker::getFullOutputMappingURL() const {
 
 void ModelBaker::bake() {
     qDebug() << "ModelBaker" << _modelURL << "bake starting";
+    startStages();
 
     // Setup the output folders for the results of this bake
     initializeOutputDirs();
@@ -207,6 +208,8 @@ void ModelBaker::handleModelNetworkReply() {
 }
 
 void ModelBaker::bakeSourceCopy() {
+    endStage("load");
+
     QFile modelFile(_originalOutputModelPath);
     if (!modelFile.open(QIODevice::ReadOnly)) {
         handleError("Error opening " + _originalOutputModelPath + " for reading");
@@ -226,6 +229,7 @@ void ModelBaker::bakeSourceCopy() {
         hifi::VariantHash serializerMapping = _mapping;
         serializerMapping["combineParts"] = true; // set true so that OBJSerializer reads material info from material library
         serializerMapping["deduplicateIndices"] = true; // Draco compression also deduplicates, but we might as well shave it off to save on some earlier processing (currently FBXSerializer only)
+        serializerMapping["keepFBXNodes"] = true; // FBXBaker re-writes the geometry nodes of the parsed file
         hfm::Model::Pointer loadedModel = serializer->read(modelData, serializerMapping, _modelURL);
 
         // Temporarily support copying the pre-parsed node from FBXSerializer, for better performance in FBXBaker
@@ -240,6 +244,8 @@ void ModelBaker::bakeSourceCopy() {
         auto config = baker.getConfiguration();
         // Enable compressed draco mesh generation
         config->getJobConfig("BuildDracoMesh")->setEnabled(true);
+        // Enable the simplified levels of the meshes, stored along with the draco meshes
+        config->getJobConfig("BuildMeshLods")->setEnabled(true);
         // Do not permit potentially lossy modification of joint data meant for runtime
         ((PrepareJointsConfig*)config->getJobConfig("PrepareJoints"))->passthrough = true;
     
@@ -264,6 +270,7 @@ void ModelBaker::bakeSourceCopy() {
     if (shouldStop()) {
         return;
     }
+    endStage("process");
 
     if (!_hfmModel->materials.isEmpty()) {
         _materialBaker = QSharedPointer<MaterialBaker>(
@@ -271,6 +278,7 @@ void ModelBaker::bakeSourceCopy() {
             &MaterialBaker::deleteLater
         );
         _materialBaker->setMaterials(_hfmModel->materials, _modelURL.toString());
+        _materialBaker->setAtlasableMaterials(getAtlasableMaterials(*_hfmModel));
         connect(_materialBaker.data(), &MaterialBaker::finished, this, &ModelBaker::handleFinishedMaterialBaker);
         _materialBaker->bake();
     } else {
@@ -278,6 +286,47 @@ void ModelBaker::bakeSourceCopy() {
     }
 }
 
+std::unordered_set<std::string> ModelBaker::getAtlasableMaterials(const hfm::Model& hfmModel) {
+    // small enough to allow for the rounding of the texture coordinates exported right on the edges
+    const float TEXCOORD_EPSILON = 0.001f;
+
+    std::unordered_set<std::string> repeatingMaterials;
+    std::unordered_set<std::string> materials;
+    for (const auto& mesh : hfmModel.meshes) {
+        for (const auto& part : mesh.parts) {
+            auto materialIter = hfmModel.materials.find(part.materialID);
+            if (materialIter == hfmModel.materials.end()) {
+                continue;
+            }
+            auto name = materialIter->name.toStdString();
+            materials.insert(name);
+
+            bool isRepeating = mesh.texCoords.isEmpty();
+            for (const auto* indices : { &part.triangleIndices, &part.quadTrianglesIndices }) {
+                for (auto index : *indices) {
+                    if (isRepeating || index >= mesh.texCoords.size()) {
+                        isRepeating = true;
+                        break;
+                    }
+                    const auto& texCoord = mesh.texCoords[index];
+                    if (glm::any(glm::lessThan(texCoord, glm::vec2(-TEXCOORD_EPSILON))) ||
+                            glm::any(glm::greaterThan(texCoord, glm::vec2(1.0f + TEXCOORD_EPSILON)))) {
+                        isRepeating = true;
+                    }
+                }
+            }
+            if (isRepeating) {
+                repeatingMaterials.insert(name);
+            }
+        }
+    }
+
+    for (auto& name : repeatingMaterials) {
+        materials.erase(name);
+    }
+    return materials;
+}
+
 void ModelBaker::handleFinishedMaterialBaker() {
     auto baker = qobject_cast<MaterialBaker*>(sender());
 
@@ -397,6 +446,8 @@ void ModelBaker::outputUnbakedFST() {
 }
 
 void ModelBaker::outputBakedFST() {
+    endStage("materials");
+
     // Output FST file, copying over input mappings if available
     QString outputFSTFilename = !_mappingURL.isEmpty() ? _mappingURL.fileName() : _modelURL.fileName();
     auto extensionStart = outputFSTFilename.indexOf(".");
@@ -429,6 +480,7 @@ void ModelBaker::outputBakedFST() {
     _outputMappingURL = outputFSTURL;
 
     exportScene();
+    endStage("output");
     qCDebug(model_baking) << "Finished baking, emitting finished" << _modelURL;
     emit finished();
 }
@@ -473,6 +525,42 @@ bool ModelBaker::buildDracoMeshNode(FBXNode& dracoMeshNode, const QByteArray& dr
     return true;
 }
 
+void ModelBaker::addMeshLodNodes(FBXNode& dracoMeshNode, const hfm::Mesh& mesh) {
+    // The parts of a level are matched to the parts of the draco mesh through the index of their material,
+    // in the order of the material list of the draco mesh
+    std::vector<QString> materialList;
+    std::vector<int> partMaterialIndices;
+    for (const auto& part : mesh.parts) {
+        auto materialIt = std::find(materialList.cbegin(), materialList.cend(), part.materialID);
+        partMaterialIndices.push_back((int)(materialIt - materialList.cbegin()));
+        if (materialIt == materialList.cend()) {
+            materialList.push_back(part.materialID);
+        }
+    }
+
+    for (const auto& lod : mesh.lods) {
+        FBXNode lodNode;
+        lodNode.name = "MeshLod";
+        for (int i = 0; i < lod.partTriangleIndices.size() && i < (int)partMaterialIndices.size(); i++) {
+            const auto& triangleIndices = lod.partTriangleIndices[i];
+            if (triangleIndices.isEmpty()) {
+                continue;
+            }
+            FBXNode partNode;
+            partNode.name = "LodPart";
+            partNode.properties.append(partMaterialIndices[i]);
+
+            FBXNode indicesNode;
+            indicesNode.name = "TriangleIndices";
+            indicesNode.properties.append(QVariant::fromValue(triangleIndices));
+            partNode.children.append(indicesNode);
+
+            lodNode.children.append(partNode);
+        }
+        dracoMeshNode.children.append(lodNode);
+    }
+}
+
 void ModelBaker::setWasAborted(bool wasAborted) {
     if (wasAborted != _wasAborted.load()) {
         Baker::setWasAborted(wasAborted);
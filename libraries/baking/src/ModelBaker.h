@@ -48,6 +48,8 @@ public:
     void initializeOutputDirs();
 
     bool buildDracoMeshNode(FBXNode& dracoMeshNode, const QByteArray& dracoMeshBytes, const std::vector<hifi::ByteArray>& dracoMaterialList);
+    // Adds the simplified levels of the mesh to its draco mesh node
+    void addMeshLodNodes(FBXNode& dracoMeshNode, const hfm::Mesh& mesh);
     virtual void setWasAborted(bool wasAborted) override;
 
     QUrl getModelURL() const { return _modelURL; }
@@ -90,6 +92,9 @@ private:
     void outputBakedFST();
     void bakeMaterialMap();
 
+    // the materials of the parts with all of their texture coordinates within the textures
+    static std::unordered_set<std::string> getAtlasableMaterials(const hfm::Model& hfmModel);
+
     bool _hasBeenBaked { false };
 
     hfm::Model::Pointer _hfmModel;
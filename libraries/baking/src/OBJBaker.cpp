@@ -127,6 +127,7 @@ void OBJBaker::createFBXNodeTree(FBXNode& rootNode, const hfm::Model::Pointer& h
         }
         FBXNode dracoNode;
         buildDracoMeshNode(dracoNode, dracoMesh, newMaterialList);
+        addMeshLodNodes(dracoNode, hfmModel->meshes[0]);
         geometryNode.children.append(dracoNode);
     } else {
         handleWarning("Baked mesh for OBJ model '" + _modelURL.toString() + "' is empty");
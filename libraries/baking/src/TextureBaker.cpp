@@ -14,8 +14,10 @@
 #include <QtCore/QDir>
 #include <QtCore/QEventLoop>
 #include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
 #include <QtNetwork/QNetworkReply>
 
+#include <image/BasisTexture.h>
 #include <image/TextureProcessing.h>
 #include <ktx/KTX.h>
 #include <NetworkAccessManager.h>
@@ -31,6 +33,12 @@ const QString BAKED_TEXTURE_BCN_SUFFIX = "_bcn.ktx";
 const QString BAKED_META_TEXTURE_SUFFIX = ".texmeta.json";
 
 bool TextureBaker::_compressionEnabled = true;
+QString TextureBaker::_bakeCacheDirectory;
+
+// bump when the baked textures change, so that the ones in the bake caches are no longer used
+static const int BAKE_CACHE_VERSION = 1;
+// the base filename of the textures in the bake cache, replaced by the one of the baker as they are copied out
+static const QString BAKE_CACHE_BASE_FILENAME = "texture";
 
 TextureBaker::TextureBaker(const QUrl& textureURL, image::TextureUsage::Type textureType,
                            const QDir& outputDirectory, const QString& baseFilename,
@@ -57,6 +65,8 @@ TextureBaker::TextureBaker(const QUrl& textureURL, image::TextureUsage::Type tex
 }
 
 void TextureBaker::bake() {
+    startStages();
+
     // once our texture is loaded, kick off a the processing
     connect(this, &TextureBaker::originalTextureLoaded, this, &TextureBaker::processTexture);
 
@@ -128,6 +138,8 @@ void TextureBaker::handleTextureNetworkReply() {
 }
 
 void TextureBaker::processTexture() {
+    endStage("load");
+
     // the baked textures need to have the source hash added for cache checks in Interface
     // so we add that to the processed texture before handling it off to be serialized
     QCryptographicHash hasher(QCryptographicHash::Md5);
@@ -136,6 +148,15 @@ void TextureBaker::processTexture() {
     auto hashData = hasher.result();
     std::string hash = hashData.toHex().toStdString();
 
+    // the bake cache also needs to tell apart the textures baked with other settings and versions of the baker
+    QCryptographicHash cacheHasher(QCryptographicHash::Md5);
+    cacheHasher.addData(hashData);
+    cacheHasher.addData((const char*)&BAKE_CACHE_VERSION, sizeof(BAKE_CACHE_VERSION));
+    bool isBasisEnabled = image::isBasisEncodingSupported();
+    cacheHasher.addData((const char*)&_compressionEnabled, sizeof(_compressionEnabled));
+    cacheHasher.addData((const char*)&isBasisEnabled, sizeof(isBasisEnabled));
+    QString cacheKey = cacheHasher.result().toHex();
+
     TextureMeta meta;
 
     QString originalCopyFilePath = _originalCopyFilePath.toString();
@@ -153,6 +174,13 @@ void TextureBaker::processTexture() {
         meta.original = _originalCopyFilePath.fileName();
     }
 
+    if (!_bakeCacheDirectory.isEmpty() && loadFromBakeCache(cacheKey, meta)) {
+        _isCached = true;
+        endStage("cache");
+        outputMetaTexture(meta);
+        return;
+    }
+
     // Load the copy of the original file from the baked output directory. New images will be created using the original as the source data.
     auto buffer = std::static_pointer_cast<QIODevice>(std::make_shared<QFile>(originalCopyFilePath));
     if (!buffer->open(QIODevice::ReadOnly)) {
@@ -160,8 +188,43 @@ void TextureBaker::processTexture() {
         return;
     }
 
+    bool isCubeMap = _textureType == image::TextureUsage::Type::SKY_TEXTURE ||
+        _textureType == image::TextureUsage::Type::AMBIENT_TEXTURE;
+
+    // Basis Universal, one file that clients transcode to the compressed format of their backend
+    bool hasBasis = false;
+    if (_compressionEnabled && !isCubeMap && image::isBasisEncodingSupported()) {
+        auto processedTexture = image::processImage(buffer, _textureURL.toString().toStdString(), image::ColorChannel::NONE,
+                                                    ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, _textureType, false,
+                                                    gpu::BackendTarget::GL45, _abortProcessing);
+        if (!processedTexture) {
+            handleError("Could not process texture " + _textureURL.toString());
+            return;
+        }
+
+        if (shouldStop()) {
+            return;
+        }
+
+        // the textures that can't be encoded, like HDR ones, are baked to KTX below
+        auto data = image::encodeBasisTexture(*processedTexture, _abortProcessing);
+        if (!data.isEmpty()) {
+            auto fileName = _baseFilename + ".basis";
+            auto filePath = _outputDirectory.absoluteFilePath(fileName);
+            QFile bakedTextureFile { filePath };
+            if (!bakedTextureFile.open(QIODevice::WriteOnly) || bakedTextureFile.write(data) == -1) {
+                handleError("Could not write baked texture for " + _textureURL.toString());
+                return;
+            }
+            _outputFiles.push_back(filePath);
+            meta.basis = fileName;
+            hasBasis = true;
+        }
+        buffer->reset();
+    }
+
     // Compressed KTX
-    if (_compressionEnabled) {
+    if (_compressionEnabled && !hasBasis) {
         constexpr std::array<gpu::BackendTarget, 2> BACKEND_TARGETS {{
             gpu::BackendTarget::GL45,
             gpu::BackendTarget::GLES32
@@ -208,7 +271,7 @@ void TextureBaker::processTexture() {
     }
 
     // Uncompressed KTX
-    if (_textureType == image::TextureUsage::Type::SKY_TEXTURE || _textureType == image::TextureUsage::Type::AMBIENT_TEXTURE) {
+    if (isCubeMap) {
         buffer->reset();
         auto processedTexture = image::processImage(std::move(buffer), _textureURL.toString().toStdString(), image::ColorChannel::NONE,
                                                     ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, _textureType, false, gpu::BackendTarget::GL45, _abortProcessing);
@@ -243,23 +306,116 @@ void TextureBaker::processTexture() {
     } else {
         buffer.reset();
     }
+    endStage("process");
 
-    {
-        auto data = meta.serialize();
-        _metaTextureFileName = _outputDirectory.absoluteFilePath(_baseFilename + BAKED_META_TEXTURE_SUFFIX);
-        QFile file { _metaTextureFileName };
-        if (!file.open(QIODevice::WriteOnly) || file.write(data) == -1) {
-            handleError("Could not write meta texture for " + _textureURL.toString());
-            return;
-        } else {
-            _outputFiles.push_back(_metaTextureFileName);
-        }
+    if (!_bakeCacheDirectory.isEmpty()) {
+        storeInBakeCache(cacheKey, meta);
+    }
+
+    outputMetaTexture(meta);
+}
+
+void TextureBaker::outputMetaTexture(TextureMeta& meta) {
+    auto data = meta.serialize();
+    _metaTextureFileName = _outputDirectory.absoluteFilePath(_baseFilename + BAKED_META_TEXTURE_SUFFIX);
+    QFile file { _metaTextureFileName };
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) == -1) {
+        handleError("Could not write meta texture for " + _textureURL.toString());
+        return;
     }
+    _outputFiles.push_back(_metaTextureFileName);
 
-    qCDebug(model_baking) << "Baked texture" << _textureURL;
+    qCDebug(model_baking) << (_isCached ? "Copied cached texture" : "Baked texture") << _textureURL;
     setIsFinished(true);
 }
 
+// Copies the baked textures of a meta texture from one folder and base filename to another, the original is left out
+static bool copyBakedTextures(const TextureMeta& meta, const QDir& fromDirectory, const QString& fromBaseFilename,
+                              const QDir& toDirectory, const QString& toBaseFilename, TextureMeta& copiedMeta) {
+    auto copy = [&](const QUrl& url, QUrl& copiedURL) {
+        if (url.isEmpty()) {
+            return true;
+        }
+        auto fileName = url.fileName();
+        if (!fileName.startsWith(fromBaseFilename)) {
+            return false;
+        }
+        auto copiedFileName = toBaseFilename + fileName.mid(fromBaseFilename.length());
+        auto copiedFilePath = toDirectory.absoluteFilePath(copiedFileName);
+        QFile::remove(copiedFilePath);
+        if (!QFile::copy(fromDirectory.absoluteFilePath(fileName), copiedFilePath)) {
+            return false;
+        }
+        copiedURL = copiedFileName;
+        return true;
+    };
+
+    if (!copy(meta.uncompressed, copiedMeta.uncompressed) || !copy(meta.basis, copiedMeta.basis)) {
+        return false;
+    }
+    for (const auto& textureType : meta.availableTextureTypes) {
+        if (!copy(textureType.second, copiedMeta.availableTextureTypes[textureType.first])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TextureBaker::loadFromBakeCache(const QString& cacheKey, TextureMeta& meta) {
+    QDir entryDirectory { QDir(_bakeCacheDirectory).filePath(cacheKey) };
+    QFile cachedMetaFile { entryDirectory.filePath(BAKE_CACHE_BASE_FILENAME + BAKED_META_TEXTURE_SUFFIX) };
+    if (!cachedMetaFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    TextureMeta cachedMeta;
+    if (!TextureMeta::deserialize(cachedMetaFile.readAll(), &cachedMeta)) {
+        return false;
+    }
+
+    if (!copyBakedTextures(cachedMeta, entryDirectory, BAKE_CACHE_BASE_FILENAME, _outputDirectory, _baseFilename, meta)) {
+        qCWarning(model_baking) << "Could not copy the cached textures of" << _textureURL << "from" << entryDirectory.path();
+        return false;
+    }
+    for (const auto* url : { &meta.uncompressed, &meta.basis }) {
+        if (!url->isEmpty()) {
+            _outputFiles.push_back(_outputDirectory.absoluteFilePath(url->fileName()));
+        }
+    }
+    for (const auto& textureType : meta.availableTextureTypes) {
+        _outputFiles.push_back(_outputDirectory.absoluteFilePath(textureType.second.fileName()));
+    }
+    return true;
+}
+
+void TextureBaker::storeInBakeCache(const QString& cacheKey, const TextureMeta& meta) {
+    QDir cacheDirectory { _bakeCacheDirectory };
+    if (!cacheDirectory.mkpath(".")) {
+        qCWarning(model_baking) << "Could not create the bake cache at" << _bakeCacheDirectory;
+        return;
+    }
+
+    // the entry is written to a temporary folder that is then renamed, so that it is never read half written by the bakers
+    // of the same texture on the other threads
+    QTemporaryDir entryDirectory { cacheDirectory.filePath(cacheKey + "-XXXXXX") };
+    if (!entryDirectory.isValid()) {
+        return;
+    }
+    TextureMeta cachedMeta;
+    if (!copyBakedTextures(meta, _outputDirectory, _baseFilename, QDir(entryDirectory.path()), BAKE_CACHE_BASE_FILENAME, cachedMeta)) {
+        return;
+    }
+    QFile cachedMetaFile { QDir(entryDirectory.path()).filePath(BAKE_CACHE_BASE_FILENAME + BAKED_META_TEXTURE_SUFFIX) };
+    if (!cachedMetaFile.open(QIODevice::WriteOnly) || cachedMetaFile.write(cachedMeta.serialize()) == -1) {
+        return;
+    }
+    cachedMetaFile.close();
+
+    // another baker of the same texture may have stored it first, its entry is kept
+    if (cacheDirectory.rename(entryDirectory.path(), cacheDirectory.filePath(cacheKey))) {
+        entryDirectory.setAutoRemove(false);
+    }
+}
+
 void TextureBaker::setWasAborted(bool wasAborted) {
     Baker::setWasAborted(wasAborted);
 
@@ -24,6 +24,8 @@
 
 #include <graphics/Material.h>
 
+struct TextureMeta;
+
 extern const QString BAKED_TEXTURE_KTX_EXT;
 extern const QString BAKED_META_TEXTURE_SUFFIX;
 
@@ -47,6 +49,13 @@ public:
 
     static void setCompressionEnabled(bool enabled) { _compressionEnabled = enabled; }
 
+    // The folder where the baked textures are kept by the hash of their content and usage, so that the same texture is only
+    // baked once for all of the models and bakes that use it. Empty by default, which turns the cache off
+    static void setBakeCacheDirectory(const QString& bakeCacheDirectory) { _bakeCacheDirectory = bakeCacheDirectory; }
+
+    // whether the baked textures were copied from the bake cache
+    bool isCached() const { return _isCached; }
+
     void setMapChannel(graphics::Material::MapChannel mapChannel) { _mapChannel = mapChannel; }
     graphics::Material::MapChannel getMapChannel() const { return _mapChannel; }
     image::TextureUsage::Type getTextureType() const { return _textureType; }
@@ -64,6 +73,9 @@ private slots:
 private:
     void loadTexture();
     void handleTextureNetworkReply();
+    bool loadFromBakeCache(const QString& cacheKey, TextureMeta& meta);
+    void storeInBakeCache(const QString& cacheKey, const TextureMeta& meta);
+    void outputMetaTexture(TextureMeta& meta);
 
     QUrl _textureURL;
     QByteArray _originalTexture;
@@ -77,8 +89,10 @@ private:
     QUrl _originalCopyFilePath;
 
     std::atomic<bool> _abortProcessing { false };
+    bool _isCached { false };
 
     static bool _compressionEnabled;
+    static QString _bakeCacheDirectory;
 };
 
 #endif // hifi_TextureBaker_h
@@ -0,0 +1,67 @@
+//
+//  BakeScheduler.cpp
+//  libraries/baking/src/baking
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeScheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QThread>
+
+BakeScheduler& BakeScheduler::instance() {
+    static BakeScheduler scheduler;
+    return scheduler;
+}
+
+void BakeScheduler::setMaxConcurrentBakes(int maxConcurrentBakes) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _maxConcurrentBakes = (size_t)std::max(maxConcurrentBakes, 1);
+    startPendingBakes(lock);
+}
+
+void BakeScheduler::schedule(Baker* baker) {
+    // a baker can only be moved from its own thread, so it goes to its worker thread now and only its bake waits
+    baker->moveToThread(_getWorkerThreadOperator ? _getWorkerThreadOperator() : baker->thread());
+
+    // the aborted bakers never emit finished, they are only deleted
+    QObject::connect(baker, &Baker::finished, [this, baker] { handleBakeEnded(baker); });
+    QObject::connect(baker, &QObject::destroyed, [this, baker] { handleBakeEnded(baker); });
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _pendingBakes.emplace_back(baker);
+    startPendingBakes(lock);
+}
+
+void BakeScheduler::handleBakeEnded(Baker* baker) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_runningBakes.erase(baker) > 0) {
+        startPendingBakes(lock);
+    }
+}
+
+void BakeScheduler::startPendingBakes(std::unique_lock<std::mutex>& lock) {
+    std::vector<QPointer<Baker>> bakesToStart;
+    while (!_pendingBakes.empty() && _runningBakes.size() < _maxConcurrentBakes) {
+        auto baker = _pendingBakes.front();
+        _pendingBakes.pop_front();
+        if (baker) {
+            _runningBakes.insert(baker.data());
+            bakesToStart.push_back(baker);
+        }
+    }
+    lock.unlock();
+
+    // queued, so that the bakes never start on the thread that scheduled or finished another one
+    for (auto& baker : bakesToStart) {
+        if (baker) {
+            QMetaObject::invokeMethod(baker.data(), "bake", Qt::QueuedConnection);
+        }
+    }
+}
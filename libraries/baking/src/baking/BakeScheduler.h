@@ -0,0 +1,51 @@
+//
+//  BakeScheduler.h
+//  libraries/baking/src/baking
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakeScheduler_h
+#define hifi_BakeScheduler_h
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+
+#include <QtCore/QPointer>
+
+#include "Baker.h"
+
+class QThread;
+
+// Starts the bakes that don't wait on any other, like the ones of textures and scripts, no more of them at a time than there
+// are worker threads. The bakes that wait on them, like the ones of models and materials, still start right away, so that
+// they never hold a slot while the bakes they wait on are queued behind them
+class BakeScheduler {
+public:
+    static BakeScheduler& instance();
+
+    void setWorkerThreadOperator(std::function<QThread*()> getWorkerThreadOperator) { _getWorkerThreadOperator = getWorkerThreadOperator; }
+    void setMaxConcurrentBakes(int maxConcurrentBakes);
+
+    // From the thread of the baker, moves it to a worker thread then queues its bake, which starts once fewer than the
+    // maximum number of scheduled bakes are running
+    void schedule(Baker* baker);
+
+private:
+    void handleBakeEnded(Baker* baker);
+    void startPendingBakes(std::unique_lock<std::mutex>& lock);
+
+    std::function<QThread*()> _getWorkerThreadOperator;
+
+    std::mutex _mutex;
+    std::deque<QPointer<Baker>> _pendingBakes;
+    std::unordered_set<Baker*> _runningBakes;
+    size_t _maxConcurrentBakes { 1 };
+};
+
+#endif // hifi_BakeScheduler_h
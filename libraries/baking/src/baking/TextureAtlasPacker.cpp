@@ -0,0 +1,92 @@
+//
+//  TextureAtlasPacker.cpp
+//  libraries/baking/src/baking
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureAtlasPacker.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+void TextureAtlasPacker::pack(const std::vector<QSize>& sizes) {
+    _placements.assign(sizes.size(), Placement());
+    _pageSizes.clear();
+
+    std::vector<size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    // ties keep their order, so that the same inputs are always packed the same way
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return sizes[a].height() > sizes[b].height();
+    });
+
+    // the pages are about square, as wide as all of the textures with their gutters would need
+    int64_t area = 0;
+    int maxWidth = 0;
+    for (auto& size : sizes) {
+        area += (int64_t)(size.width() + 2 * GUTTER_SIZE) * (size.height() + 2 * GUTTER_SIZE);
+        maxWidth = std::max(maxWidth, size.width() + 2 * GUTTER_SIZE);
+    }
+    int pageWidth = 1;
+    while (pageWidth < MAX_ATLAS_SIZE && ((int64_t)pageWidth * pageWidth < area || pageWidth < maxWidth)) {
+        pageWidth *= 2;
+    }
+
+    int page = 0;
+    int shelfX = 0;
+    int shelfY = 0;
+    int shelfHeight = 0;
+    _pageSizes.push_back(QSize(pageWidth, 0));
+    for (auto index : order) {
+        int width = sizes[index].width() + 2 * GUTTER_SIZE;
+        int height = sizes[index].height() + 2 * GUTTER_SIZE;
+        if (shelfX + width > pageWidth) {
+            shelfX = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (shelfY + height > MAX_ATLAS_SIZE) {
+            ++page;
+            shelfX = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+            _pageSizes.push_back(QSize(pageWidth, 0));
+        }
+        _placements[index].page = page;
+        _placements[index].rect = QRect(shelfX + GUTTER_SIZE, shelfY + GUTTER_SIZE, sizes[index].width(), sizes[index].height());
+        shelfX += width;
+        shelfHeight = std::max(shelfHeight, height);
+        _pageSizes[page].setHeight(std::max(_pageSizes[page].height(), shelfY + shelfHeight));
+    }
+}
+
+void TextureAtlasPacker::draw(QImage& atlas, const QImage& image, const QRect& rect) {
+    QImage scaled = image.convertToFormat(QImage::Format_ARGB32);
+    if (scaled.size() != rect.size()) {
+        scaled = scaled.scaled(rect.size(), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    int top = std::max(rect.top() - GUTTER_SIZE, 0);
+    int bottom = std::min(rect.bottom() + GUTTER_SIZE, atlas.height() - 1);
+    int left = std::max(rect.left() - GUTTER_SIZE, 0);
+    int right = std::min(rect.right() + GUTTER_SIZE, atlas.width() - 1);
+    for (int y = top; y <= bottom; ++y) {
+        auto source = reinterpret_cast<const QRgb*>(scaled.constScanLine(glm::clamp(y - rect.top(), 0, rect.height() - 1)));
+        auto destination = reinterpret_cast<QRgb*>(atlas.scanLine(y));
+        for (int x = left; x <= right; ++x) {
+            destination[x] = source[glm::clamp(x - rect.left(), 0, rect.width() - 1)];
+        }
+    }
+}
+
+glm::mat4 TextureAtlasPacker::evalTexCoordTransform(const QRect& rect, const QSize& pageSize) {
+    glm::vec2 offset((float)rect.x() / (float)pageSize.width(), (float)rect.y() / (float)pageSize.height());
+    glm::vec2 scale((float)rect.width() / (float)pageSize.width(), (float)rect.height() / (float)pageSize.height());
+    return glm::scale(glm::translate(glm::mat4(), glm::vec3(offset, 0.0f)), glm::vec3(scale, 1.0f));
+}
@@ -0,0 +1,51 @@
+//
+//  TextureAtlasPacker.h
+//  libraries/baking/src/baking
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureAtlasPacker_h
+#define hifi_TextureAtlasPacker_h
+
+#include <vector>
+
+#include <QtCore/QRect>
+#include <QtGui/QImage>
+
+#include <glm/glm.hpp>
+
+// Packs the textures of small materials into shared atlases, the textures of one material are given the same place in the
+// atlas of each of its maps so that a single texcoord transform moves its texture coordinates into all of them
+class TextureAtlasPacker {
+public:
+    static const int MAX_ATLAS_SIZE = 2048;
+    static const int MAX_PACKED_TEXTURE_SIZE = 256;
+    // the edge texels of a texture are repeated this far around it, so that filtering and the first mips don't bleed
+    static const int GUTTER_SIZE = 8;
+
+    struct Placement {
+        int page { 0 };
+        QRect rect;
+    };
+
+    // Places rectangles of these sizes on shelves, from the tallest, and starts a new page when one is full
+    void pack(const std::vector<QSize>& sizes);
+
+    const std::vector<Placement>& getPlacements() const { return _placements; }
+    const std::vector<QSize>& getPageSizes() const { return _pageSizes; }
+
+    // draws the image scaled to the rectangle, with its gutter
+    static void draw(QImage& atlas, const QImage& image, const QRect& rect);
+
+    static glm::mat4 evalTexCoordTransform(const QRect& rect, const QSize& pageSize);
+
+private:
+    std::vector<Placement> _placements;
+    std::vector<QSize> _pageSizes;
+};
+
+#endif // hifi_TextureAtlasPacker_h
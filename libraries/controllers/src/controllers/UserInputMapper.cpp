@@ -8,6 +8,7 @@
 
 #include "UserInputMapper.h"
 
+#include <algorithm>
 #include <set>
 
 #include <QtCore/QThread>
@@ -485,12 +486,12 @@ void UserInputMapper::runMappings() {
         qCDebug(controllers) << "Processing device routes";
     }
     // Now process the current values for each level of the stack
-    applyRoutes(_deviceRoutes);
+    applyRoutes(_deviceRouteTable);
 
     if (debugRoutes) {
         qCDebug(controllers) << "Processing standard routes";
     }
-    applyRoutes(_standardRoutes);
+    applyRoutes(_standardRouteTable);
 
     InputRecorder* inputRecorder = InputRecorder::getInstance();
     if (inputRecorder->isPlayingback()) {
@@ -513,41 +514,60 @@ void UserInputMapper::runMappings() {
     debugRoutes = false;
 }
 
+void UserInputMapper::compileRoutes() {
+    auto compileRouteTable = [](const Route::List& routes, RouteTable& table) {
+        table.clear();
+        for (const auto& route : routes) {
+            // a route without a destination never does anything, unless it's there to be debugged
+            if (!route || (!route->destination && !route->debug)) {
+                continue;
+            }
+            CompiledRoute compiledRoute;
+            compiledRoute.route = route.get();
+            for (const auto& filter : route->filters) {
+                compiledRoute.filters.push_back(filter.get());
+            }
+            compiledRoute.hasStandardSource = route->source->getInput().device == STANDARD_DEVICE;
+            table.push_back(std::move(compiledRoute));
+        }
+    };
+    compileRouteTable(_deviceRoutes, _deviceRouteTable);
+    compileRouteTable(_standardRoutes, _standardRouteTable);
+}
+
 // Encapsulate the logic that routes should not be read before they are written
-void UserInputMapper::applyRoutes(const Route::List& routes) {
-    Route::List deferredRoutes;
+void UserInputMapper::applyRoutes(const RouteTable& routes) {
+    _deferredRoutes.clear();
 
     for (const auto& route : routes) {
-        if (!route) {
-            continue;
-        }
-
         // Try all the deferred routes
-        deferredRoutes.remove_if([](Route::Pointer route) {
-            return UserInputMapper::applyRoute(route);
-        });
+        if (!_deferredRoutes.empty()) {
+            _deferredRoutes.erase(std::remove_if(_deferredRoutes.begin(), _deferredRoutes.end(), [](const CompiledRoute* route) {
+                return UserInputMapper::applyRoute(*route);
+            }), _deferredRoutes.end());
+        }
 
         if (!applyRoute(route)) {
-            deferredRoutes.push_back(route);
+            _deferredRoutes.push_back(&route);
         }
     }
 
     bool force = true;
-    for (const auto& route : deferredRoutes) {
-        UserInputMapper::applyRoute(route, force);
+    for (const auto& route : _deferredRoutes) {
+        UserInputMapper::applyRoute(*route, force);
     }
 }
 
 
-bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
+bool UserInputMapper::applyRoute(const CompiledRoute& compiledRoute, bool force) {
+    const auto& route = compiledRoute.route;
     if (debugRoutes && route->debug) {
         qCDebug(controllers) << "Applying route " << route->json;
     }
 
     // If the source hasn't been written yet, defer processing of this route
     auto& source = route->source;
-    auto& sourceInput = source->getInput();
-    if (sourceInput.device == STANDARD_DEVICE && !force && source->writeable()) {
+    if (compiledRoute.hasStandardSource && !force && source->writeable()) {
         if (debugRoutes && route->debug) {
             qCDebug(controllers) << "Source not yet written, deferring";
         }
@@ -603,7 +623,7 @@ bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
             qCDebug(controllers) << "Value was t:" << value.translation << "r:" << value.rotation;
         }
         // Apply each of the filters.
-        for (const auto& filter : route->filters) {
+        for (const auto& filter : compiledRoute.filters) {
             value = filter->apply(value);
         }
 
@@ -628,7 +648,7 @@ bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
             qCDebug(controllers) << "Value was " << value.value << value.timestamp;
         }
         // Apply each of the filters.
-        for (const auto& filter : route->filters) {
+        for (const auto& filter : compiledRoute.filters) {
             value = filter->apply(value);
         }
 
@@ -1214,6 +1234,7 @@ void UserInputMapper::enableMapping(const Mapping::Pointer& mapping) {
         return (value->source->getInput().device == STANDARD_DEVICE);
     });
     _deviceRoutes.insert(_deviceRoutes.begin(), deviceRoutes.begin(), deviceRoutes.end());
+    compileRoutes();
 
     if (!debuggableRoutes) {
         debuggableRoutes = hasDebuggableRoute(_deviceRoutes) || hasDebuggableRoute(_standardRoutes);
@@ -1230,6 +1251,7 @@ void UserInputMapper::disableMapping(const Mapping::Pointer& mapping) {
     _standardRoutes.remove_if([&](const Route::Pointer& value) {
         return routeSet.count(value) != 0;
     });
+    compileRoutes();
 
     if (debuggableRoutes) {
         debuggableRoutes = hasDebuggableRoute(_deviceRoutes) || hasDebuggableRoute(_standardRoutes);
@@ -13,6 +13,7 @@
 #include <glm/glm.hpp>
 
 #include <unordered_set>
+#include <vector>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -159,8 +160,18 @@ namespace controller {
 
         void runMappings();
 
-        static void applyRoutes(const RouteList& route);
-        static bool applyRoute(const RoutePointer& route, bool force = false);
+        // a route as runMappings evaluates it, with what never changes between frames worked out once
+        struct CompiledRoute {
+            Route* route;
+            std::vector<Filter*> filters;
+            bool hasStandardSource;
+        };
+        using RouteTable = std::vector<CompiledRoute>;
+
+        // rebuilds the route tables from _deviceRoutes and _standardRoutes, leaving out the routes that can never apply
+        void compileRoutes();
+        void applyRoutes(const RouteTable& routes);
+        static bool applyRoute(const CompiledRoute& route, bool force = false);
         void enableMapping(const MappingPointer& mapping);
         void disableMapping(const MappingPointer& mapping);
         EndpointPointer endpointFor(const QJSValue& endpoint);
@@ -191,6 +202,9 @@ namespace controller {
 
         RouteList _deviceRoutes;
         RouteList _standardRoutes;
+        RouteTable _deviceRouteTable;
+        RouteTable _standardRouteTable;
+        std::vector<const CompiledRoute*> _deferredRoutes; // reused by applyRoutes
 
         QSet<QString> _loadedRouteJsonFiles;
 
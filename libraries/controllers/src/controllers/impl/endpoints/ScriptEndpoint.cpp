@@ -41,9 +41,13 @@ AxisValue ScriptEndpoint::peek() const {
 
 void ScriptEndpoint::updateValue() {
     if (QThread::currentThread() != thread()) {
-        QMetaObject::invokeMethod(this, "updateValue", Qt::QueuedConnection);
+        // the reads from other threads get the last value read, a single update brings it up to date for all of them
+        if (!_isValueUpdateQueued.exchange(true)) {
+            QMetaObject::invokeMethod(this, "updateValue", Qt::QueuedConnection);
+        }
         return;
     }
+    _isValueUpdateQueued = false;
 
     QScriptValue result = _callable.call();
     if (result.isError()) {
@@ -51,7 +55,7 @@ void ScriptEndpoint::updateValue() {
         qCDebug(controllers).noquote() << formatException(result);
         _lastValueRead = 0.0f;
     } else if (result.isNumber()) {
-        _lastValueRead = (float)_callable.call().toNumber();
+        _lastValueRead = (float)result.toNumber();
     } else {
         Pose::fromScriptValue(result, _lastPoseRead);
         _returnPose = true;
@@ -88,9 +92,12 @@ Pose ScriptEndpoint::peekPose() const {
 
 void ScriptEndpoint::updatePose() {
     if (QThread::currentThread() != thread()) {
-        QMetaObject::invokeMethod(this, "updatePose", Qt::QueuedConnection);
+        if (!_isPoseUpdateQueued.exchange(true)) {
+            QMetaObject::invokeMethod(this, "updatePose", Qt::QueuedConnection);
+        }
         return;
     }
+    _isPoseUpdateQueued = false;
     QScriptValue result = _callable.call();
     if (result.isError()) {
         // print JavaScript exception
@@ -10,6 +10,8 @@
 #ifndef hifi_Controllers_ScriptEndpoint_h
 #define hifi_Controllers_ScriptEndpoint_h
 
+#include <atomic>
+
 #include <QtScript/QScriptValue>
 
 #include "../Endpoint.h"
@@ -46,6 +48,9 @@ private:
     bool _returnPose { false };
     Pose _lastPoseRead;
     Pose _lastPoseWritten;
+
+    std::atomic<bool> _isValueUpdateQueued { false };
+    std::atomic<bool> _isPoseUpdateQueued { false };
 };
 
 }
@@ -326,6 +326,8 @@ void HmdDisplayPlugin::updatePresentPose() {
     _currentPresentFrameInfo.presentPose = _currentPresentFrameInfo.renderPose;
 }
 
+static const float LATE_LATCH_AVERAGE_WEIGHT = 0.05f;
+
 void HmdDisplayPlugin::updateFrameData() {
     // Check if we have old frame data to discard
     static const uint32_t INVALID_FRAME = (uint32_t)(~0);
@@ -349,6 +351,27 @@ void HmdDisplayPlugin::updateFrameData() {
     }
 
     updatePresentPose();
+
+    if (_currentFrame) {
+        if (oldFrameIndex == newFrameIndex) {
+            _reprojectedPresents++;
+        }
+        glm::quat correction = glm::quat_cast(glm::inverse(_currentPresentFrameInfo.renderPose) * _currentPresentFrameInfo.presentPose);
+        float correctionDegrees = glm::degrees(glm::angle(correction));
+        _averageLateLatchDegrees = LATE_LATCH_AVERAGE_WEIGHT * correctionDegrees +
+            (1.0f - LATE_LATCH_AVERAGE_WEIGHT) * _averageLateLatchDegrees;
+        if (correctionDegrees > _maxLateLatchDegrees) {
+            _maxLateLatchDegrees = correctionDegrees;
+        }
+    }
+}
+
+QJsonObject HmdDisplayPlugin::getHardwareStats() const {
+    QJsonObject hardwareStats;
+    hardwareStats["reprojected_present_count"] = (int)_reprojectedPresents.load();
+    hardwareStats["late_latch_correction_degrees"] = _averageLateLatchDegrees.load();
+    hardwareStats["max_late_latch_correction_degrees"] = _maxLateLatchDegrees.load();
+    return hardwareStats;
 }
 
 glm::mat4 HmdDisplayPlugin::getViewCorrection() {
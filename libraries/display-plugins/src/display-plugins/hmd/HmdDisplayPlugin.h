@@ -10,6 +10,7 @@
 #include <ThreadSafeValueCache.h>
 
 #include <array>
+#include <atomic>
 
 #include <QtGlobal>
 #include <Transform.h>
@@ -39,6 +40,7 @@ public:
     QRect getRecommendedHUDRect() const override final;
 
     virtual glm::mat4 getHeadPose() const override;
+    QJsonObject getHardwareStats() const override;
 
     bool wantVsync() const override {
         return false;
@@ -97,6 +99,12 @@ protected:
     FrameInfo _currentRenderFrameInfo;
     RateCounter<> _stutterRate;
 
+    // The presents that showed a frame again, with the view corrected to the pose latched for them, since a new frame
+    // wasn't ready, and how far the latched poses turned the views from the poses the frames were rendered with
+    std::atomic<uint32_t> _reprojectedPresents { 0 };
+    std::atomic<float> _averageLateLatchDegrees { 0.0f };
+    std::atomic<float> _maxLateLatchDegrees { 0.0f };
+
     bool _disablePreview { true };
 
     class VisionSqueezeParameters {
@@ -303,6 +303,8 @@ void EntityTreeRenderer::clear() {
     }
     _entitiesInScene.clear();
     _renderablesToUpdate.clear();
+    _zoneCandidates.clear();
+    _zoneCandidatesDirty = true;
 
     // reset the zone to the default (while we load the next scene)
     _layeredZones.clear();
@@ -421,6 +423,12 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
             if (renderable) {
                 // only add valid renderables _renderablesToUpdate
                 _renderablesToUpdate.insert(renderable);
+
+                // a zone or a scripted entity that changed may have moved in or out of the zone candidates
+                const auto& entity = renderable->getEntity();
+                if (entity->getType() == EntityTypes::Zone || !entity->getScript().isEmpty()) {
+                    _zoneCandidatesDirty = true;
+                }
             }
         }
     }
@@ -572,24 +580,39 @@ void EntityTreeRenderer::handleSpaceUpdate(std::pair<int32_t, glm::vec4> proxyUp
     _spaceUpdates.emplace_back(proxyUpdate.first, proxyUpdate.second);
 }
 
-void EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QSet<EntityItemID>& entitiesContainingAvatar) {
-    float radius = 0.01f; // for now, assume 0.01 meter radius, because we actually check the point inside later
+void EntityTreeRenderer::updateZoneCandidates() {
+    PROFILE_RANGE(simulation_physics, "ZoneCandidates");
+    auto entityTree = std::static_pointer_cast<EntityTree>(_tree);
     QVector<QUuid> entityIDs;
+    entityTree->evalEntitiesInSphere(_avatarPosition, ZONE_CANDIDATES_RADIUS, PickFilter(), entityIDs);
+
+    // only zones and entities with scripts can have events fired on them, all other entities can be ignored
+    _zoneCandidates.clear();
+    for (auto& entityID : entityIDs) {
+        auto entity = entityTree->findEntityByID(entityID);
+        if (entity && (entity->getType() == EntityTypes::Zone || !entity->getScript().isEmpty())) {
+            _zoneCandidates.push_back(entity);
+        }
+    }
+    _zoneCandidatesCenter = _avatarPosition;
+    _lastZoneCandidatesUpdate = usecTimestampNow();
+    _zoneCandidatesDirty = false;
+}
 
-    // find the entities near us
+void EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QSet<EntityItemID>& entitiesContainingAvatar) {
     // don't let someone else change our tree while we search
     _tree->withReadLock([&] {
-        auto entityTree = std::static_pointer_cast<EntityTree>(_tree);
-
-        // FIXME - if EntityTree had a findEntitiesContainingPoint() this could theoretically be a little faster
-        entityTree->evalEntitiesInSphere(_avatarPosition, radius, PickFilter(), entityIDs);
+        if (_zoneCandidatesDirty || glm::distance(_avatarPosition, _zoneCandidatesCenter) > ZONE_CANDIDATES_RADIUS ||
+                usecTimestampNow() - _lastZoneCandidatesUpdate > ZONE_CANDIDATES_INTERVAL) {
+            updateZoneCandidates();
+        }
 
         LayeredZones oldLayeredZones(_layeredZones);
         _layeredZones.clear();
 
         // create a list of entities that actually contain the avatar's position
-        for (auto& entityID : entityIDs) {
-            auto entity = entityTree->findEntityByID(entityID);
+        for (auto& weakEntity : _zoneCandidates) {
+            auto entity = weakEntity.lock();
             if (!entity) {
                 continue;
             }
@@ -597,8 +620,6 @@ void EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QSet<EntityItemI
             auto isZone = entity->getType() == EntityTypes::Zone;
             auto hasScript = !entity->getScript().isEmpty();
 
-            // only consider entities that are zones or have scripts, all other entities can
-            // be ignored because they can't have events fired on them.
             // FIXME - this could be optimized further by determining if the script is loaded
             // and if it has either an enterEntity or leaveEntity method
             //
@@ -715,6 +736,7 @@ void EntityTreeRenderer::leaveAllEntities() {
 
 void EntityTreeRenderer::forceRecheckEntities() {
     _forceRecheckEntities = true;
+    _zoneCandidatesDirty = true;
 }
 
 bool EntityTreeRenderer::applyLayeredZones() {
@@ -1033,6 +1055,9 @@ void EntityTreeRenderer::addingEntity(const EntityItemID& entityID) {
     auto entity = std::static_pointer_cast<EntityTree>(_tree)->findEntityByID(entityID);
     if (entity) {
         _entitiesToAdd.insert({ entity->getEntityItemID(),  entity });
+        if (entity->getType() == EntityTypes::Zone || !entity->getScript().isEmpty()) {
+            _zoneCandidatesDirty = true;
+        }
     }
 }
 
@@ -171,6 +171,7 @@ private:
 
     void resetEntitiesScriptEngine();
 
+    void updateZoneCandidates();
     void findBestZoneAndMaybeContainingEntities(QSet<EntityItemID>& entitiesContainingAvatar);
 
     bool applyLayeredZones();
@@ -244,6 +245,16 @@ private:
     const uint64_t ZONE_CHECK_INTERVAL = USECS_PER_MSEC * 100; // ~10hz
     const float ZONE_CHECK_DISTANCE = 0.001f;
 
+    // The zones and scripted entities that overlap a sphere around the avatar, the only ones that can contain it for as long
+    // as it stays in the sphere. The checks test these alone, and the tree is only searched again when the avatar leaves the
+    // sphere, when a zone or a scripted entity is added or changed, or once in a while for the ones the changes don't reach
+    std::vector<EntityItemWeakPointer> _zoneCandidates;
+    glm::vec3 _zoneCandidatesCenter { 0.0f };
+    uint64_t _lastZoneCandidatesUpdate { 0 };
+    bool _zoneCandidatesDirty { true };
+    const float ZONE_CANDIDATES_RADIUS = 8.0f;
+    const uint64_t ZONE_CANDIDATES_INTERVAL = USECS_PER_SECOND;
+
     float _avgRenderableUpdateCost { 0.0f };
 
     ReadWriteLockable _changedEntitiesGuard;
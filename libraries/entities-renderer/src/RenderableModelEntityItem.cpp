@@ -1078,6 +1078,11 @@ uint32_t ModelEntityRenderer::metaFetchMetaSubItems(ItemIDs& subItems) const {
     if (_model) {
         auto metaSubItems = _model->fetchRenderItemIDs();
         subItems.insert(subItems.end(), metaSubItems.begin(), metaSubItems.end());
+        auto imposterItemID = _model->getImposterItemID();
+        if (imposterItemID != render::Item::INVALID_ITEM_ID) {
+            subItems.push_back(imposterItemID);
+            return (uint32_t)metaSubItems.size() + 1;
+        }
         return (uint32_t)metaSubItems.size();
     }
     return 0;
@@ -1421,6 +1426,9 @@ void ModelEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& sce
         }
     }
 
+    // the imposter of a model is captured once, animated models keep drawing their parts
+    model->setUseImposter(!_animating);
+
     {
         DETAILED_PROFILE_RANGE(simulation_physics, "Fixup");
         if (model->needsFixupInScene()) {
@@ -41,12 +41,14 @@ static ShapePipelinePointer shapePipelineFactory(const ShapePlumber& plumber, co
 }
 
 struct GpuParticle {
-    GpuParticle(const glm::vec3& xyzIn, const glm::vec2& uvIn) : xyz(xyzIn), uv(uvIn) {}
-    glm::vec3 xyz; // Position
-    glm::vec2 uv; // Lifetime + seed
+    glm::vec3 position; // at birth: in the world if the particle trails behind the emitter, else relative to it
+    glm::vec2 birthAndSeed;
+    glm::vec3 velocity; // at birth
+    glm::vec3 acceleration;
 };
 
-using GpuParticles = std::vector<GpuParticle>;
+// past this, the birth times are rebased so that they keep their precision as floats
+static const uint64_t MAX_EPOCH_AGE = 10 * 60 * USECS_PER_SECOND;
 
 ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPointer& entity) : Parent(entity) {
     ParticleUniforms uniforms;
@@ -58,9 +60,13 @@ ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPoint
         CUSTOM_PIPELINE_NUMBER = render::ShapePipeline::registerCustomShapePipelineFactory(shapePipelineFactory);
         _vertexFormat = std::make_shared<Format>();
         _vertexFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element::VEC3F_XYZ,
-            offsetof(GpuParticle, xyz), gpu::Stream::PER_INSTANCE);
+            offsetof(GpuParticle, position), gpu::Stream::PER_INSTANCE);
         _vertexFormat->setAttribute(gpu::Stream::COLOR, 0, gpu::Element::VEC2F_UV,
-            offsetof(GpuParticle, uv), gpu::Stream::PER_INSTANCE);
+            offsetof(GpuParticle, birthAndSeed), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element::VEC3F_XYZ,
+            offsetof(GpuParticle, velocity), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::TANGENT, 0, gpu::Element::VEC3F_XYZ,
+            offsetof(GpuParticle, acceleration), gpu::Stream::PER_INSTANCE);
     });
 }
 
@@ -145,8 +151,11 @@ void ParticleEffectEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEn
         particleUniforms.lifespan = _particleProperties.lifespan;
         particleUniforms.rotateWithEntity = _particleProperties.rotateWithEntity ? 1 : 0;
     });
-    // Update particle uniforms
-    memcpy(&_uniformBuffer.edit<ParticleUniforms>(), &particleUniforms, sizeof(ParticleUniforms));
+    // Update particle uniforms, the time and the emitter are kept up to date by the render
+    auto& uniforms = _uniformBuffer.edit<ParticleUniforms>();
+    particleUniforms.time = uniforms.time;
+    particleUniforms.emitter = uniforms.emitter;
+    memcpy(&uniforms, &particleUniforms, sizeof(ParticleUniforms));
 }
 
 ItemKey ParticleEffectEntityRenderer::getKey() {
@@ -217,6 +226,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
     const auto& polarFinish = particleProperties.polar.finish;
 
     particle.seed = randFloatInRange(-1.0f, 1.0f);
+    particle.birth = now;
     particle.expiration = now + (uint64_t)(particleProperties.lifespan * USECS_PER_SECOND);
 
     particle.relativePosition = glm::vec3(0.0f);
@@ -373,9 +383,30 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
     return particle;
 }
 
+void ParticleEffectEntityRenderer::uploadParticle(const CpuParticle& particle, size_t slot) {
+    GpuParticle gpuParticle;
+    gpuParticle.position = particle.relativePosition + (_prevEmitterShouldTrail ? particle.basePosition : glm::vec3(0.0f));
+    gpuParticle.birthAndSeed = glm::vec2((float)(particle.birth - _epoch) / (float)USECS_PER_SECOND, particle.seed);
+    gpuParticle.velocity = particle.velocity;
+    gpuParticle.acceleration = particle.acceleration;
+    _particleBuffer->setSubData(slot, gpuParticle);
+}
+
+void ParticleEffectEntityRenderer::uploadParticles() {
+    _particleBuffer->resize(sizeof(GpuParticle) * _numSlots);
+    _firstSlot = 0;
+    if (!_cpuParticles.empty()) {
+        _epoch = _cpuParticles.front().birth;
+    }
+    for (size_t i = 0; i < _cpuParticles.size(); i++) {
+        uploadParticle(_cpuParticles[i], i);
+    }
+}
+
 void ParticleEffectEntityRenderer::stepSimulation() {
     if (_lastSimulated == 0) {
         _lastSimulated = usecTimestampNow();
+        _epoch = _lastSimulated;
         return;
     }
 
@@ -393,6 +424,41 @@ void ParticleEffectEntityRenderer::stepSimulation() {
     });
 
     const auto& modelTransform = getModelTransform();
+
+    // Rebase the particles when the emitter stops or starts trailing them, and send them all again
+    bool needsUpload = false;
+    if (_prevEmitterShouldTrail != particleProperties.emission.shouldTrail) {
+        for (auto& particle : _cpuParticles) {
+            if (_prevEmitterShouldTrail) {
+                particle.relativePosition = particle.relativePosition + particle.basePosition - modelTransform.getTranslation();
+            }
+            particle.basePosition = modelTransform.getTranslation();
+        }
+        _prevEmitterShouldTrail = particleProperties.emission.shouldTrail;
+        needsUpload = true;
+    }
+    if (_numSlots != particleProperties.maxParticles) {
+        _numSlots = particleProperties.maxParticles;
+        needsUpload = true;
+    }
+    if (_cpuParticles.empty()) {
+        _epoch = now;
+    } else if (now - _epoch > MAX_EPOCH_AGE) {
+        needsUpload = true;
+    }
+
+    // Kill any particles that have expired or are over the max size
+    auto killParticles = [&] {
+        while (_cpuParticles.size() > particleProperties.maxParticles || (!_cpuParticles.empty() && _cpuParticles.front().expiration <= now)) {
+            _cpuParticles.pop_front();
+            _firstSlot = _numSlots > 0 ? (_firstSlot + 1) % _numSlots : 0;
+        }
+    };
+    if (needsUpload) {
+        killParticles();
+        uploadParticles();
+    }
+
     if (_emitting && particleProperties.emitting() &&
         (shapeType != SHAPE_TYPE_COMPOUND || (geometryResource && geometryResource->isLoaded()))) {
         uint64_t emitInterval = particleProperties.emitIntervalUsecs();
@@ -402,8 +468,12 @@ void ParticleEffectEntityRenderer::stepSimulation() {
                 if (_shapeType == SHAPE_TYPE_COMPOUND && !_hasComputedTriangles) {
                     computeTriangles(geometryResource->getHFMModel());
                 }
-                // emit particle
+                // emit particle, into the slot after the last one. Past maxParticles that is the slot of the oldest
+                // particle, which is killed below
                 _cpuParticles.push_back(createParticle(now, modelTransform, particleProperties, shapeType, geometryResource, _triangleInfo));
+                if (_numSlots > 0) {
+                    uploadParticle(_cpuParticles.back(), (_firstSlot + _cpuParticles.size() - 1) % _numSlots);
+                }
                 _timeUntilNextEmit = emitInterval;
                 if (emitInterval < timeRemaining) {
                     timeRemaining -= emitInterval;
@@ -414,40 +484,7 @@ void ParticleEffectEntityRenderer::stepSimulation() {
         }
     }
 
-    // Kill any particles that have expired or are over the max size
-    while (_cpuParticles.size() > particleProperties.maxParticles || (!_cpuParticles.empty() && _cpuParticles.front().expiration <= now)) {
-        _cpuParticles.pop_front();
-    }
-
-    const float deltaTime = (float)interval / (float)USECS_PER_SECOND;
-    // update the particles
-    for (auto& particle : _cpuParticles) {
-        if (_prevEmitterShouldTrail != particleProperties.emission.shouldTrail) {
-            if (_prevEmitterShouldTrail) {
-                particle.relativePosition = particle.relativePosition + particle.basePosition - modelTransform.getTranslation();
-            }
-            particle.basePosition = modelTransform.getTranslation();
-        }
-        particle.integrate(deltaTime);
-    }
-    _prevEmitterShouldTrail = particleProperties.emission.shouldTrail;
-
-    // Build particle primitives
-    static GpuParticles gpuParticles;
-    gpuParticles.clear();
-    gpuParticles.reserve(_cpuParticles.size()); // Reserve space
-    std::transform(_cpuParticles.begin(), _cpuParticles.end(), std::back_inserter(gpuParticles), [&particleProperties, &modelTransform] (const CpuParticle& particle) {
-        glm::vec3 position = particle.relativePosition + (particleProperties.emission.shouldTrail ? particle.basePosition : modelTransform.getTranslation());
-        return GpuParticle(position, glm::vec2(particle.lifetime, particle.seed));
-    });
-
-    // Update particle buffer
-    auto& particleBuffer = _particleBuffer;
-    size_t numBytes = sizeof(GpuParticle) * gpuParticles.size();
-    particleBuffer->resize(numBytes);
-    if (numBytes != 0) {
-        particleBuffer->setData(numBytes, (const gpu::Byte*)gpuParticles.data());
-    }
+    killParticles();
 }
 
 void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
@@ -455,12 +492,12 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
         return;
     }
 
-    // FIXME migrate simulation to a compute stage
     stepSimulation();
 
     gpu::Batch& batch = *args->_batch;
     batch.setResourceTexture(0, _networkTexture->getGPUTexture());
 
+    glm::vec4 emitter = glm::vec4(getModelTransform().getTranslation(), _prevEmitterShouldTrail ? 1.0f : 0.0f);
     Transform transform;
     // The particles are in world space, so the transform is unused, except for the rotation, which we use
     // if the particles are marked rotateWithEntity
@@ -471,16 +508,27 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
         color.middle = EntityRenderer::calculatePulseColor(_particleProperties.getColorMiddle(), _pulseProperties, _created);
         color.finish = EntityRenderer::calculatePulseColor(_particleProperties.getColorFinish(), _pulseProperties, _created);
         color.spread = EntityRenderer::calculatePulseColor(_particleProperties.getColorSpread(), _pulseProperties, _created);
+        auto& uniforms = _uniformBuffer.edit<ParticleUniforms>();
+        uniforms.time = (float)(_lastSimulated - _epoch) / (float)USECS_PER_SECOND;
+        uniforms.emitter = emitter;
     });
 
     batch.setModelTransform(transform);
     batch.setUniformBuffer(0, _uniformBuffer);
     batch.setInputFormat(_vertexFormat);
-    batch.setInputBuffer(0, _particleBuffer, 0, sizeof(GpuParticle));
 
-    auto numParticles = _particleBuffer->getSize() / sizeof(GpuParticle);
+    // the live particles are one range of the ring, which may wrap around its end
     static const size_t VERTEX_PER_PARTICLE = 4;
-    batch.drawInstanced((gpu::uint32)numParticles, gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+    size_t numParticles = std::min(_cpuParticles.size(), _numSlots);
+    size_t numFirstParticles = std::min(numParticles, _numSlots - _firstSlot);
+    if (numFirstParticles > 0) {
+        batch.setInputBuffer(0, _particleBuffer, _firstSlot * sizeof(GpuParticle), sizeof(GpuParticle));
+        batch.drawInstanced((gpu::uint32)numFirstParticles, gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+    }
+    if (numParticles > numFirstParticles) {
+        batch.setInputBuffer(0, _particleBuffer, 0, sizeof(GpuParticle));
+        batch.drawInstanced((gpu::uint32)(numParticles - numFirstParticles), gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+    }
 }
 
 void ParticleEffectEntityRenderer::fetchGeometryResource() {
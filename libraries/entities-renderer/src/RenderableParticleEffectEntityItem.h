@@ -41,23 +41,17 @@ private:
     using Buffer = gpu::Buffer;
     using BufferView = gpu::BufferView;
 
-    // CPU particles
-    // FIXME either switch to GPU compute particles or switch to simd updating of the particles
+    // The particles move on the GPU: a particle is uploaded once, when it is emitted, with its state at birth, and the
+    // vertex shader integrates its motion from there. The CPU only keeps what it needs to emit the particles, retire them
+    // and rebase them when the emitter stops or starts trailing them
     struct CpuParticle {
         float seed { 0.0f };
+        uint64_t birth { 0 };
         uint64_t expiration { 0 };
-        float lifetime { 0.0f };
         glm::vec3 basePosition;
-        glm::vec3 relativePosition;
-        glm::vec3 velocity;
+        glm::vec3 relativePosition; // at birth
+        glm::vec3 velocity; // at birth
         glm::vec3 acceleration;
-
-        void integrate(float deltaTime) {
-            glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * acceleration;
-            relativePosition += velocity * deltaTime + atSquared;
-            velocity += acceleration * deltaTime;
-            lifetime += deltaTime;
-        }
     };
     using CpuParticles = std::deque<CpuParticle>;
 
@@ -76,7 +70,9 @@ private:
         InterpolationData<float> spin;
         float lifespan;
         int rotateWithEntity;
-        glm::vec2 spare;
+        float time { 0.0f }; // seconds since _epoch
+        float spare { 0.0f };
+        glm::vec4 emitter { 0.0f }; // xyz: the position of the emitter, w: 1 if the particles trail behind it
     };
 
     void computeTriangles(const hfm::Model& hfmModel);
@@ -92,6 +88,8 @@ private:
                                       const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
                                       const TriangleInfo& triangleInfo);
     void stepSimulation();
+    void uploadParticle(const CpuParticle& particle, size_t slot);
+    void uploadParticles();
 
     particle::Properties _particleProperties;
     bool _prevEmitterShouldTrail;
@@ -99,7 +97,11 @@ private:
     CpuParticles _cpuParticles;
     bool _emitting { false };
     uint64_t _timeUntilNextEmit { 0 };
+    // a ring of maxParticles slots, where _cpuParticles.front() is in _firstSlot and the others follow it
     BufferPointer _particleBuffer { std::make_shared<Buffer>() };
+    size_t _numSlots { 0 };
+    size_t _firstSlot { 0 };
+    uint64_t _epoch { 0 }; // the birth times on the GPU are relative to it, to keep them precise
     BufferView _uniformBuffer;
     quint64 _lastSimulated { 0 };
 
@@ -48,6 +48,7 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <JobSystem.h>
 #include <Model.h>
 #include <PerfStat.h>
 #include <render/Scene.h>
@@ -76,6 +77,15 @@
 
 const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
 
+// the mesh is made of chunks of this many voxels a side
+const int MESH_CHUNK_SIZE = 16;
+
+// the extractors read the voxels around those of the region they mesh, for the faces and the normals
+const int MESH_CHUNK_PADDING = 2;
+
+// the "outside of voxel-space" value of _volData and of the copies of its chunks
+const uint8_t VOLUME_BORDER_VALUE = 255;
+
 /*
   A PolyVoxEntity has several interdependent parts:
 
@@ -92,6 +102,10 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
   _volDataDirty    -- does recomputeMesh need to be called?
   _shapeReady      -- are we ready to tell bullet our shape?
 
+  The mesh is made of the meshes of chunks of MESH_CHUNK_SIZE voxels a side.  Changing a voxel marks the chunks that read
+  it in _dirtyChunks, and recomputeMesh only meshes those again, in parallel, each from a copy of its voxels so that
+  the entity isn't locked while it is meshed.
+
 
   Here is a simplified diagram of the state machine implemented in RenderablePolyVoxEntityItem::update
 
@@ -939,7 +953,14 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
 
         _volData.reset(new PolyVox::SimpleVolume<uint8_t>(PolyVox::Region(lowCorner, highCorner)));
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
-        _volData->setBorderValue(255);
+        _volData->setBorderValue(VOLUME_BORDER_VALUE);
+
+        // the chunks share their upper faces with the next ones, as the extractors mesh up to the upper corner
+        ivec3 upperCorner(highCorner.getX(), highCorner.getY(), highCorner.getZ());
+        _numChunks = glm::max((upperCorner + MESH_CHUNK_SIZE - 1) / MESH_CHUNK_SIZE, ivec3(1));
+        size_t numChunks = (size_t)(_numChunks.x * _numChunks.y * _numChunks.z);
+        _meshChunks.assign(numChunks, MeshChunkPointer());
+        _dirtyChunks.assign(numChunks, true);
     });
 
     tellNeighborsToRecopyEdges(true);
@@ -990,8 +1011,19 @@ uint8_t RenderablePolyVoxEntityItem::getVoxelInternal(const ivec3& v) const {
 }
 
 
+void RenderablePolyVoxEntityItem::markChunksDirty(int x, int y, int z) {
+    // the voxel is read by the chunks whose padded regions hold it.  This assumes that the caller has write-locked the entity.
+    ivec3 voxel(x, y, z);
+    ivec3 low = glm::max(voxel - MESH_CHUNK_PADDING - 1, ivec3(0)) / MESH_CHUNK_SIZE;
+    ivec3 high = glm::min((voxel + MESH_CHUNK_PADDING) / MESH_CHUNK_SIZE, _numChunks - 1);
+    loop3(low, high + 1, [&](const ivec3& chunk) {
+        _dirtyChunks[(chunk.z * _numChunks.y + chunk.y) * _numChunks.x + chunk.x] = true;
+    });
+}
+
 void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue) {
     _volData->setVoxelAt(x, y, z, toValue);
+    markChunksDirty(x, y, z);
     if (x == 0) {
         _neighborXNeedsUpdate = true;
         startUpdates();
@@ -1244,6 +1276,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markChunksDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1264,6 +1297,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markChunksDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1284,6 +1318,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markChunksDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1324,49 +1359,59 @@ void RenderablePolyVoxEntityItem::tellNeighborsToRecopyEdges(bool force) {
 
 
 void RenderablePolyVoxEntityItem::recomputeMesh() {
-    // use _volData to make a renderable mesh
+    // use _volData to make a renderable mesh, meshing again only the chunks that changed
     PolyVoxSurfaceStyle voxelSurfaceStyle;
-    withReadLock([&] {
+    ivec3 numChunks;
+    MeshChunks meshChunks;
+    std::vector<ivec3> dirtyChunks;
+    withWriteLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
+        numChunks = _numChunks;
+        meshChunks = _meshChunks;
+        // the chunks that change while they are meshed are marked again, and meshed by the next bake
+        size_t index = 0;
+        loop3(ivec3(0), numChunks, [&](const ivec3& chunk) {
+            if (_dirtyChunks[index]) {
+                _dirtyChunks[index] = false;
+                dirtyChunks.push_back(chunk);
+            }
+            index++;
+        });
     });
 
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
-        graphics::MeshPointer mesh(new graphics::Mesh());
+    QtConcurrent::run([entity, voxelSurfaceStyle, numChunks, meshChunks, dirtyChunks]() mutable {
+        jobs::parallelFor(0, dirtyChunks.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const ivec3& chunk = dirtyChunks[i];
+                meshChunks[(chunk.z * numChunks.y + chunk.y) * numChunks.x + chunk.x] =
+                    entity->computeMeshChunk(chunk, voxelSurfaceStyle);
+            }
+        }, jobs::Priority::Low);
 
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
-
-        entity->withReadLock([&] {
-            PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
+        std::vector<PolyVox::PositionMaterialNormal> vecVertices;
+        std::vector<uint32_t> vecIndices;
+        for (const auto& meshChunk : meshChunks) {
+            if (!meshChunk) {
+                continue;
             }
-        });
+            uint32_t baseVertex = (uint32_t)vecVertices.size();
+            vecVertices.insert(vecVertices.end(), meshChunk->vertices.begin(), meshChunk->vertices.end());
+            for (uint32_t index : meshChunk->indices) {
+                vecIndices.push_back(baseVertex + index);
+            }
+        }
+
+        graphics::MeshPointer mesh(new graphics::Mesh());
 
         // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
         auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
                                                          (gpu::Byte*)vecIndices.data());
         auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
         gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
         mesh->setIndexBuffer(indexBufferView);
 
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getRawVertexData();
         auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
                                                           (gpu::Byte*)vecVertices.data());
         auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
@@ -1391,11 +1436,73 @@ void RenderablePolyVoxEntityItem::recomputeMesh() {
                                              graphics::Mesh::TRIANGLES)); // topology
         mesh->setPartBuffer(gpu::BufferView(new gpu::Buffer(parts.size() * sizeof(graphics::Mesh::Part), (gpu::Byte*) parts.data()),
                                             gpu::Element::PART_DRAWCALL));
-        entity->setMesh(mesh);
+        entity->setMesh(mesh, numChunks, meshChunks);
+    });
+}
+
+RenderablePolyVoxEntityItem::MeshChunkPointer RenderablePolyVoxEntityItem::computeMeshChunk(const ivec3& chunk,
+        PolyVoxSurfaceStyle voxelSurfaceStyle) const {
+    // copy the voxels of the chunk and around it, so that the chunk is meshed without locking the entity
+    ivec3 low = chunk * MESH_CHUNK_SIZE;
+    ivec3 high;
+    std::unique_ptr<PolyVox::SimpleVolume<uint8_t>> volData;
+    withReadLock([&] {
+        if (!_volData) {
+            return;
+        }
+        const PolyVox::Vector3DInt32& upperCorner = _volData->getEnclosingRegion().getUpperCorner();
+        high = glm::min(low + MESH_CHUNK_SIZE, ivec3(upperCorner.getX(), upperCorner.getY(), upperCorner.getZ()));
+        if (glm::any(glm::lessThan(high, low))) {
+            // the volume was resized since the chunk was marked, it will be meshed again
+            return;
+        }
+        ivec3 paddedLow = low - MESH_CHUNK_PADDING;
+        ivec3 paddedHigh = high + MESH_CHUNK_PADDING;
+        volData.reset(new PolyVox::SimpleVolume<uint8_t>(PolyVox::Region(
+            PolyVox::Vector3DInt32(paddedLow.x, paddedLow.y, paddedLow.z),
+            PolyVox::Vector3DInt32(paddedHigh.x, paddedHigh.y, paddedHigh.z))));
+        volData->setBorderValue(VOLUME_BORDER_VALUE);
+        loop3(paddedLow, paddedHigh + 1, [&](const ivec3& v) {
+            volData->setVoxelAt(v.x, v.y, v.z, _volData->getVoxelAt(v.x, v.y, v.z));
+        });
     });
+
+    auto meshChunk = std::make_shared<MeshChunk>();
+    if (!volData) {
+        return meshChunk;
+    }
+
+    // A mesh object to hold the result of surface extraction
+    PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+    PolyVox::Region region(PolyVox::Vector3DInt32(low.x, low.y, low.z), PolyVox::Vector3DInt32(high.x, high.y, high.z));
+    switch (voxelSurfaceStyle) {
+        case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
+        case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
+            PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                (volData.get(), region, &polyVoxMesh);
+            surfaceExtractor.execute();
+            break;
+        }
+        case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
+        case PolyVoxEntityItem::SURFACE_CUBIC: {
+            PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                (volData.get(), region, &polyVoxMesh);
+            surfaceExtractor.execute();
+            break;
+        }
+    }
+
+    // the extractors place the vertices from the lower corner of the region
+    PolyVox::Vector3DFloat offset((float)low.x, (float)low.y, (float)low.z);
+    meshChunk->vertices = polyVoxMesh.getRawVertexData();
+    for (auto& vertex : meshChunk->vertices) {
+        vertex.setPosition(vertex.getPosition() + offset);
+    }
+    meshChunk->indices = polyVoxMesh.getIndices();
+    return meshChunk;
 }
 
-void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
+void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh, const ivec3& numChunks, const MeshChunks& meshChunks) {
     // this catches the payload from recomputeMesh
     withWriteLock([&] {
         if (!_collisionless) {
@@ -1403,6 +1510,9 @@ void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
         }
         _shapeReady = false;
         _mesh = mesh;
+        if (numChunks == _numChunks) {
+            _meshChunks = meshChunks;
+        }
         _state = PolyVoxState::BakingMeshFinished;
         _meshReady = true;
         startUpdates();
@@ -1477,20 +1587,31 @@ void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
                 pointCollection[i++] << pointsInPart;
             }
         } else {
+            // copy the voxels, so that the entity is only locked for the copy
+            ivec3 size(voxelVolumeSize);
+            std::vector<uint8_t> voxels((size_t)(size.x * size.y * size.z));
+            auto voxelIndex = [&](int x, int y, int z) {
+                return (size_t)((z * size.y + y) * size.x + x);
+            };
+            polyVoxEntity->forEachVoxelValue(size, [&](const ivec3& v, uint8_t value) {
+                voxels[voxelIndex(v.x, v.y, v.z)] = value;
+            });
+
             unsigned int i = 0;
-            polyVoxEntity->forEachVoxelValue(voxelVolumeSize, [&](const ivec3& v, uint8_t value) {
+            loop3(ivec3(0), size, [&](const ivec3& v) {
+                uint8_t value = voxels[voxelIndex(v.x, v.y, v.z)];
                 if (value > 0) {
                     const auto& x = v.x;
                     const auto& y = v.y;
                     const auto& z = v.z;
                     if (glm::all(glm::greaterThan(v, ivec3(0))) &&
-                        glm::all(glm::lessThan(v, ivec3(voxelVolumeSize) - 1)) &&
-                        (polyVoxEntity->getVoxelInternal({ x - 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y - 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z - 1 }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x + 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y + 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z + 1 }) > 0)) {
+                        glm::all(glm::lessThan(v, size - 1)) &&
+                        (voxels[voxelIndex(x - 1, y, z)] > 0) &&
+                        (voxels[voxelIndex(x, y - 1, z)] > 0) &&
+                        (voxels[voxelIndex(x, y, z - 1)] > 0) &&
+                        (voxels[voxelIndex(x + 1, y, z)] > 0) &&
+                        (voxels[voxelIndex(x, y + 1, z)] > 0) &&
+                        (voxels[voxelIndex(x, y, z + 1)] > 0)) {
                         // this voxel has neighbors in every cardinal direction, so there's no need
                         // to include it in the collision hull.
                         return;
@@ -18,6 +18,7 @@
 
 #include <PolyVoxCore/SimpleVolume.h>
 #include <PolyVoxCore/Raycast.h>
+#include <PolyVoxCore/VertexTypes.h>
 
 #include <gpu/Forward.h>
 #include <gpu/Context.h>
@@ -125,7 +126,15 @@ public:
     void forEachVoxelValue(const ivec3& voxelSize, std::function<void(const ivec3&, uint8_t)> thunk);
     QByteArray volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const;
 
-    void setMesh(graphics::MeshPointer mesh);
+    // the volume is meshed in chunks, so that an edit only re-meshes the chunks around it
+    struct MeshChunk {
+        std::vector<PolyVox::PositionMaterialNormal> vertices; // in voxel space
+        std::vector<uint32_t> indices;
+    };
+    using MeshChunkPointer = std::shared_ptr<const MeshChunk>;
+    using MeshChunks = std::vector<MeshChunkPointer>;
+
+    void setMesh(graphics::MeshPointer mesh, const ivec3& numChunks, const MeshChunks& meshChunks);
     void setCollisionPoints(ShapeInfo::PointCollection points, AABox box);
     PolyVox::SimpleVolume<uint8_t>* getVolData() { return _volData.get(); }
 
@@ -153,6 +162,8 @@ private:
     void stopUpdates();
 
     void recomputeMesh();
+    void markChunksDirty(int x, int y, int z);
+    MeshChunkPointer computeMeshChunk(const ivec3& chunk, PolyVoxSurfaceStyle voxelSurfaceStyle) const;
     void cacheNeighbors();
     void copyUpperEdgesFromNeighbors();
     void tellNeighborsToRecopyEdges(bool force);
@@ -174,6 +185,11 @@ private:
 
     graphics::MeshPointer _mesh;
 
+    // the meshes of the chunks that _mesh is made of, and the chunks that need to be meshed again
+    ivec3 _numChunks { 0 };
+    MeshChunks _meshChunks;
+    std::vector<bool> _dirtyChunks;
+
     ShapeInfo _shapeInfo;
 
     std::shared_ptr<PolyVox::SimpleVolume<uint8_t>> _volData;
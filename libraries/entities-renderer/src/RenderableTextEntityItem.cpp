@@ -357,10 +357,11 @@ void entities::TextPayload::render(RenderArgs* args) {
     modelTransform.setScale(scale);
     batch.setModelTransform(modelTransform);
 
+    // the opaque text of all of the text entities is drawn in a few instanced calls, translucent text is drawn here to stay sorted
     glm::vec2 bounds = glm::vec2(dimensions.x - (leftMargin + rightMargin), dimensions.y - (topMargin + bottomMargin));
     textRenderer->draw(batch, leftMargin / scale, -topMargin / scale, bounds / scale, scale,
                        text, font, textColor, effectColor, effectThickness, effect,
-                       textRenderable->_unlit, forward);
+                       textRenderable->_unlit, forward, true);
 }
 
 namespace render {
@@ -43,8 +43,16 @@ static int MAX_WINDOW_SIZE = 4096;
 const float METERS_TO_INCHES = 39.3701f;
 static float OPAQUE_ALPHA_THRESHOLD = 0.99f;
 
-// If a web-view hasn't been rendered for 30 seconds, de-allocate the framebuffer
-static uint64_t MAX_NO_RENDER_INTERVAL = 30 * USECS_PER_SECOND;
+// If a web-view hasn't been rendered for a second it is out of view, and its surface stops rendering until it is seen again
+static uint64_t MAX_NO_RENDER_INTERVAL = USECS_PER_SECOND;
+
+// If a web-view has been out of view for 30 seconds, its surface is released, and its last frame stands in for it until
+// it comes back into view. This frees the surface for the web-views in view, since there are only so many of them
+static uint64_t MAX_OUT_OF_VIEW_INTERVAL = 30 * USECS_PER_SECOND;
+
+// Further than this from the camera, the frame rate of a web-view drops with its distance, down to MIN_DISTANT_FPS
+static const float MAX_FULL_FPS_DISTANCE = 5.0f;
+static const uint8_t MIN_DISTANT_FPS = 5;
 
 static uint8_t YOUTUBE_MAX_FPS = 30;
 
@@ -87,6 +95,7 @@ WebEntityRenderer::WebEntityRenderer(const EntityItemPointer& entity) : Parent(e
 
     _timer.setInterval(MSECS_PER_SECOND);
     connect(&_timer, &QTimer::timeout, this, &WebEntityRenderer::onTimeout);
+    _timer.start();
 }
 
 WebEntityRenderer::~WebEntityRenderer() {
@@ -132,16 +141,41 @@ bool WebEntityRenderer::needsRenderUpdate() const {
 }
 
 void WebEntityRenderer::onTimeout() {
-    uint64_t lastRenderTime;
-    if (!resultWithReadLock<bool>([&] {
-        lastRenderTime = _lastRenderTime;
-        return (_lastRenderTime != 0 && (bool)_webSurface);
-    })) {
-        return;
-    }
+    bool shouldRelease = false;
+    withWriteLock([&] {
+        if (_lastRenderTime == 0 || !_webSurface) {
+            return;
+        }
+
+        uint64_t sinceLastRender = usecTimestampNow() - _lastRenderTime;
+        if (sinceLastRender > MAX_OUT_OF_VIEW_INTERVAL) {
+            shouldRelease = true;
+            return;
+        }
 
-    if (usecTimestampNow() - lastRenderTime > MAX_NO_RENDER_INTERVAL) {
+        if (sinceLastRender > MAX_NO_RENDER_INTERVAL) {
+            if (!_webSurface->isPaused()) {
+                _webSurface->pause();
+                _pausedOutOfView = true;
+            }
+            return;
+        }
+
+        uint8_t fps = _surfaceMaxFPS;
+        if (_viewDistance > MAX_FULL_FPS_DISTANCE && fps > MIN_DISTANT_FPS) {
+            fps = (uint8_t)glm::max((float)MIN_DISTANT_FPS, fps * MAX_FULL_FPS_DISTANCE / _viewDistance);
+        }
+        if (fps != _budgetFPS) {
+            _webSurface->setMaxFps(fps);
+            _budgetFPS = fps;
+        }
+    });
+
+    if (shouldRelease) {
         destroyWebSurface();
+        withWriteLock([&] {
+            _isShowingLastFrame = true;
+        });
     }
 }
 
@@ -167,6 +201,19 @@ void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene
         }
     }
 
+    withWriteLock([&] {
+        // a released web-view that is back in view gets a new surface once there is one to spare, and the properties are
+        // all given to it again
+        if (_isShowingLastFrame && _currentWebCount < MAX_CONCURRENT_WEB_VIEWS &&
+                (urlChanged || usecTimestampNow() - _lastRenderTime < MAX_NO_RENDER_INTERVAL)) {
+            _isShowingLastFrame = false;
+            _contentType = getContentType(newSourceURL);
+            _maxFPS = 0;
+            _scriptURL = QString();
+            _contextPosition = glm::vec3(NAN);
+        }
+    });
+
     withWriteLock([&] {
         _inputMode = entity->getInputMode();
         _dpi = entity->getDPI();
@@ -218,10 +265,13 @@ void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene
                         // We special case YouTube URLs since we know they are videos that we should play with at least 30 FPS.
                         // FIXME this doesn't handle redirects or shortened URLs, consider using a signaling method from the web entity
                         if (QUrl(_sourceURL).host().endsWith("youtube.com", Qt::CaseInsensitive)) {
-                            _webSurface->setMaxFps(YOUTUBE_MAX_FPS);
+                            _surfaceMaxFPS = YOUTUBE_MAX_FPS;
                         } else {
-                            _webSurface->setMaxFps(maxFPS);
+                            _surfaceMaxFPS = maxFPS;
                         }
+                        // onTimeout lowers it with the distance from there
+                        _webSurface->setMaxFps(_surfaceMaxFPS);
+                        _budgetFPS = _surfaceMaxFPS;
                         _maxFPS = maxFPS;
                     }
                 }
@@ -263,16 +313,31 @@ Item::Bound WebEntityRenderer::getBound() {
 
 void WebEntityRenderer::doRender(RenderArgs* args) {
     PerformanceTimer perfTimer("WebEntityRenderer::render");
+    bool wasPausedOutOfView = false;
     withWriteLock([&] {
         _lastRenderTime = usecTimestampNow();
+        _viewDistance = glm::distance(args->getViewFrustum().getPosition(), _renderTransform.getTranslation());
+        wasPausedOutOfView = _pausedOutOfView;
+        _pausedOutOfView = false;
     });
+    if (wasPausedOutOfView) {
+        // back in view, the surface is resumed on the thread that owns it
+        QMetaObject::invokeMethod(this, [this] {
+            withReadLock([&] {
+                if (_webSurface) {
+                    _webSurface->resume();
+                }
+            });
+        });
+    }
 
     // Try to update the texture
     OffscreenQmlSurface::TextureAndFence newTextureAndFence;
     bool newTextureAvailable = false;
     if (!resultWithReadLock<bool>([&] {
         if (!_webSurface) {
-            return false;
+            // a released web-view still shows its last frame
+            return _isShowingLastFrame;
         }
 
         newTextureAvailable = _webSurface->fetchTexture(newTextureAndFence);
@@ -326,6 +391,7 @@ void WebEntityRenderer::buildWebSurface(const EntityItemPointer& entity, const Q
     WebEntityRenderer::acquireWebSurface(newSourceURL, _contentType == ContentType::HtmlContent, _webSurface, _cachedWebSurface);
     _fadeStartTime = usecTimestampNow();
     _webSurface->resume();
+    _pausedOutOfView = false;
 
     _connections.push_back(QObject::connect(this, &WebEntityRenderer::scriptEventReceived, _webSurface.data(), &OffscreenQmlSurface::emitScriptEvent));
     _connections.push_back(QObject::connect(_webSurface.data(), &OffscreenQmlSurface::webEventReceived, this, &WebEntityRenderer::webEventReceived));
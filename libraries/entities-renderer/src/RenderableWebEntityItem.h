@@ -99,6 +99,11 @@ private:
 
     QTimer _timer;
     uint64_t _lastRenderTime { 0 };
+    float _viewDistance { 0.0f };
+    uint8_t _surfaceMaxFPS { 0 }; // the frame rate asked by the entity
+    uint8_t _budgetFPS { 0 }; // the frame rate given to the surface, lower when it is far away
+    bool _pausedOutOfView { false };
+    bool _isShowingLastFrame { false }; // the surface was released while out of view, and _texture holds its last frame
 
     std::vector<QMetaObject::Connection> _connections;
 
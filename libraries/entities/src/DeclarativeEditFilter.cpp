@@ -0,0 +1,209 @@
+//
+//  DeclarativeEditFilter.cpp
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DeclarativeEditFilter.h"
+
+#include <cfloat>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QMap>
+
+#include <NumericalConstants.h>
+#include <RegisteredMetaTypes.h>
+#include <SharedUtil.h>
+
+#include "EntitiesLogging.h"
+
+#define CLAMP_FLOAT_PROPERTY(n, N)                                                          \
+    { #n, [](EntityItemProperties& properties, float minimum, float maximum) {              \
+        if (!properties.n##Changed()) {                                                     \
+            return false;                                                                   \
+        }                                                                                   \
+        float value = properties.get##N();                                                  \
+        float clamped = glm::clamp(value, minimum, maximum);                                \
+        if (clamped == value) {                                                             \
+            return false;                                                                   \
+        }                                                                                   \
+        properties.set##N(clamped);                                                         \
+        return true;                                                                        \
+    } }
+
+#define CLAMP_VEC3_PROPERTY(n, N)                                                           \
+    { #n, [](EntityItemProperties& properties, float minimum, float maximum) {              \
+        if (!properties.n##Changed()) {                                                     \
+            return false;                                                                   \
+        }                                                                                   \
+        glm::vec3 value = properties.get##N();                                              \
+        glm::vec3 clamped = glm::clamp(value, glm::vec3(minimum), glm::vec3(maximum));      \
+        if (clamped == value) {                                                             \
+            return false;                                                                   \
+        }                                                                                   \
+        properties.set##N(clamped);                                                         \
+        return true;                                                                        \
+    } }
+
+static bool clampLifetime(EntityItemProperties& properties, float minimum, float maximum) {
+    if (!properties.lifetimeChanged()) {
+        return false;
+    }
+    // immortal entities are clamped like ones that live for ever
+    float value = properties.getLifetime();
+    float clamped = glm::clamp(value == ENTITY_ITEM_IMMORTAL_LIFETIME ? FLT_MAX : value, minimum, maximum);
+    if (clamped == value || (clamped == FLT_MAX && value == ENTITY_ITEM_IMMORTAL_LIFETIME)) {
+        return false;
+    }
+    properties.setLifetime(clamped);
+    return true;
+}
+
+static const QMap<QString, std::function<bool(EntityItemProperties&, float, float)>>& getClampOperators() {
+    static const QMap<QString, std::function<bool(EntityItemProperties&, float, float)>> CLAMP_OPERATORS {
+        { "lifetime", clampLifetime },
+        CLAMP_FLOAT_PROPERTY(density, Density),
+        CLAMP_FLOAT_PROPERTY(damping, Damping),
+        CLAMP_FLOAT_PROPERTY(angularDamping, AngularDamping),
+        CLAMP_FLOAT_PROPERTY(restitution, Restitution),
+        CLAMP_FLOAT_PROPERTY(friction, Friction),
+        CLAMP_VEC3_PROPERTY(dimensions, Dimensions),
+        CLAMP_VEC3_PROPERTY(velocity, Velocity),
+        CLAMP_VEC3_PROPERTY(angularVelocity, AngularVelocity),
+        CLAMP_VEC3_PROPERTY(gravity, Gravity)
+    };
+    return CLAMP_OPERATORS;
+}
+
+DeclarativeEditFilter::Pointer DeclarativeEditFilter::compile(const QJsonObject& description, const QString& fileName) {
+    auto filter = std::make_shared<DeclarativeEditFilter>();
+
+    // the defaults are the same as for script filters
+    filter->_filterTypes = (1 << EntityTree::FilterType::Add) | (1 << EntityTree::FilterType::Edit) |
+        (1 << EntityTree::FilterType::Physics);
+    if (description.contains("filterTypes")) {
+        static const QMap<QString, EntityTree::FilterType> FILTER_TYPES {
+            { "add", EntityTree::FilterType::Add },
+            { "edit", EntityTree::FilterType::Edit },
+            { "physics", EntityTree::FilterType::Physics },
+            { "delete", EntityTree::FilterType::Delete }
+        };
+        filter->_filterTypes = 0;
+        for (const auto& value : description["filterTypes"].toArray()) {
+            if (!FILTER_TYPES.contains(value.toString())) {
+                qCCritical(entities) << "Unknown filter type" << value.toString() << "in" << fileName;
+                return Pointer();
+            }
+            filter->_filterTypes |= 1 << FILTER_TYPES[value.toString()];
+        }
+    }
+
+    if (description.contains("allowedProperties")) {
+        filter->_hasAllowedProperties = true;
+        for (const auto& value : description["allowedProperties"].toArray()) {
+            EntityPropertyInfo propertyInfo;
+            if (!EntityItemProperties::getPropertyInfo(value.toString(), propertyInfo)) {
+                qCCritical(entities) << "Unknown property" << value.toString() << "in" << fileName;
+                return Pointer();
+            }
+            filter->_allowedProperties.setHasProperty(propertyInfo.propertyEnum);
+        }
+    }
+
+    QJsonValue region = description["region"];
+    if (region.isString() && region.toString() == "zone") {
+        filter->_regionIsZone = true;
+    } else if (region.isObject()) {
+        bool minimumValid = false;
+        bool maximumValid = false;
+        glm::vec3 minimum = vec3FromVariant(region.toObject()["min"].toVariant(), minimumValid);
+        glm::vec3 maximum = vec3FromVariant(region.toObject()["max"].toVariant(), maximumValid);
+        if (!minimumValid || !maximumValid || glm::any(glm::greaterThan(minimum, maximum))) {
+            qCCritical(entities) << "Invalid region in" << fileName;
+            return Pointer();
+        }
+        filter->_hasRegion = true;
+        filter->_region = AABox(minimum, maximum - minimum);
+    } else if (!region.isUndefined()) {
+        qCCritical(entities) << "Invalid region in" << fileName;
+        return Pointer();
+    }
+
+    QJsonObject clamps = description["clamp"].toObject();
+    for (auto it = clamps.begin(); it != clamps.end(); ++it) {
+        const auto& clampOperators = getClampOperators();
+        if (!clampOperators.contains(it.key())) {
+            qCCritical(entities) << "Property" << it.key() << "can't be clamped, in" << fileName;
+            return Pointer();
+        }
+        QJsonObject range = it.value().toObject();
+        Clamp clamp { clampOperators[it.key()], (float)range["min"].toDouble(-FLT_MAX),
+            (float)range["max"].toDouble(FLT_MAX) };
+        if (clamp.minimum > clamp.maximum) {
+            qCCritical(entities) << "Invalid range for" << it.key() << "in" << fileName;
+            return Pointer();
+        }
+        filter->_clamps.push_back(clamp);
+    }
+
+    if (description.contains("rateLimit")) {
+        QJsonObject rateLimit = description["rateLimit"].toObject();
+        filter->_ratePerSecond = (float)rateLimit["perSecond"].toDouble();
+        filter->_burst = (float)rateLimit["burst"].toDouble(filter->_ratePerSecond);
+        if (filter->_ratePerSecond <= 0.0f || filter->_burst < 1.0f) {
+            qCCritical(entities) << "Invalid rate limit in" << fileName;
+            return Pointer();
+        }
+        filter->_rateTokens = filter->_burst;
+        filter->_lastRateRefill = usecTimestampNow();
+    }
+
+    return filter;
+}
+
+bool DeclarativeEditFilter::takeRateToken() {
+    std::lock_guard<std::mutex> lock(_rateMutex);
+    quint64 now = usecTimestampNow();
+    _rateTokens = std::min(_burst, _rateTokens + _ratePerSecond * (float)(now - _lastRateRefill) / (float)USECS_PER_SECOND);
+    _lastRateRefill = now;
+    if (_rateTokens < 1.0f) {
+        return false;
+    }
+    _rateTokens -= 1.0f;
+    return true;
+}
+
+bool DeclarativeEditFilter::filter(EntityItemProperties& properties, const EntityItemPointer& zone, bool& wasChanged) {
+    if (_hasAllowedProperties) {
+        EntityPropertyFlags changedProperties = properties.getChangedProperties();
+        for (int flag = changedProperties.firstFlag(); flag <= changedProperties.lastFlag(); flag++) {
+            if (changedProperties.getHasProperty((EntityPropertyList)flag) &&
+                !_allowedProperties.getHasProperty((EntityPropertyList)flag)) {
+                return false;
+            }
+        }
+    }
+
+    if (properties.positionChanged()) {
+        if (_hasRegion && !_region.contains(properties.getPosition())) {
+            return false;
+        }
+        if (_regionIsZone && zone && !zone->contains(properties.getPosition())) {
+            return false;
+        }
+    }
+
+    // the rate is only counted for the messages that get this far
+    if (_ratePerSecond > 0.0f && !takeRateToken()) {
+        return false;
+    }
+
+    for (auto& clamp : _clamps) {
+        wasChanged |= clamp.clamp(properties, clamp.minimum, clamp.maximum);
+    }
+    return true;
+}
@@ -0,0 +1,80 @@
+//
+//  DeclarativeEditFilter.h
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DeclarativeEditFilter_h
+#define hifi_DeclarativeEditFilter_h
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+
+#include <AABox.h>
+
+#include "EntityItemProperties.h"
+#include "EntityTree.h"
+
+// An edit filter described by a JSON document rather than a script, and checked directly against the
+// properties of the edit:
+//
+//  {
+//      "filterTypes": [ "add", "edit", "physics", "delete" ],  the messages it filters, all but deletes by default
+//      "allowedProperties": [ "position", "rotation" ],        rejects messages that set any other property
+//      "region": { "min": { "x": 0, "y": 0, "z": 0 }, "max": { "x": 10, "y": 10, "z": 10 } },
+//                                                              rejects messages that put the entity outside the box,
+//                                                              "zone" for the zone the filter belongs to
+//      "clamp": { "lifetime": { "max": 3600 }, "dimensions": { "min": 0.01, "max": 100 } },
+//                                                              limits the values of the properties, vectors per component
+//      "rateLimit": { "perSecond": 50, "burst": 100 }          rejects messages beyond this rate, across all entities
+//  }
+class DeclarativeEditFilter {
+public:
+    using Pointer = std::shared_ptr<DeclarativeEditFilter>;
+
+    // returns null, having logged why, if the description isn't a valid filter
+    static Pointer compile(const QJsonObject& description, const QString& fileName);
+
+    bool wantsToFilter(EntityTree::FilterType filterType) const { return _filterTypes & (1 << filterType); }
+
+    // returns false to reject the message, otherwise clamps the properties in place and sets wasChanged if it did.
+    // The zone is the one the filter belongs to, null for the domain wide filter.
+    bool filter(EntityItemProperties& properties, const EntityItemPointer& zone, bool& wasChanged);
+
+private:
+    using ClampOperator = std::function<bool(EntityItemProperties& properties, float minimum, float maximum)>;
+    struct Clamp {
+        ClampOperator clamp;
+        float minimum;
+        float maximum;
+    };
+
+    bool takeRateToken();
+
+    int _filterTypes { 0 };
+
+    bool _hasAllowedProperties { false };
+    EntityPropertyFlags _allowedProperties;
+
+    bool _regionIsZone { false };
+    bool _hasRegion { false };
+    AABox _region;
+
+    std::vector<Clamp> _clamps;
+
+    float _ratePerSecond { 0.0f };
+    float _burst { 0.0f };
+    std::mutex _rateMutex;
+    float _rateTokens { 0.0f };
+    quint64 _lastRateRefill { 0 };
+};
+
+#endif // hifi_DeclarativeEditFilter_h
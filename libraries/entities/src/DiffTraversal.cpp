@@ -15,6 +15,18 @@
 
 #include "EntityPriorityQueue.h"
 
+// how long a shared traversal is handed to the clients that start one in its cell
+const uint64_t SHARED_TRAVERSAL_MAX_AGE = 100 * USECS_PER_MSEC;
+
+// the view cells: positions are binned by CELL_SIZE, directions by their yaw and pitch and
+// the shape of the frustum is rounded up
+const float CELL_SIZE = 1.0f; // meters
+const float CELL_HALF_DIAGONAL = 0.5f * SQRT_THREE * CELL_SIZE;
+const float DIRECTION_BIN = 10.0f * RADIANS_PER_DEGREE;
+const float ANGLE_BIN = 1.0f * RADIANS_PER_DEGREE;
+const float RADIUS_BIN = 1.0f; // meters
+const float FAR_CLIP_BIN = 16.0f; // meters
+
 DiffTraversal::Waypoint::Waypoint(EntityTreeElementPointer& element) : _nextIndex(0) {
     assert(element);
     _weakElement = element;
@@ -102,14 +114,15 @@ void DiffTraversal::Waypoint::getNextVisibleElementDifferential(DiffTraversal::V
 }
 
 bool DiffTraversal::View::usesViewFrustums() const {
-    return !viewFrustums.empty();
+    return !viewFrustums.empty() || !regions.empty();
 }
 
 bool DiffTraversal::View::isVerySimilar(const View& view) const {
     auto size = view.viewFrustums.size();
 
     if (view.lodScaleFactor != lodScaleFactor ||
-        viewFrustums.size() != size) {
+        viewFrustums.size() != size ||
+        regions.size() != view.regions.size()) {
         return false;
     }
 
@@ -118,9 +131,26 @@ bool DiffTraversal::View::isVerySimilar(const View& view) const {
             return false;
         }
     }
+    for (size_t i = 0; i < regions.size(); ++i) {
+        if (!regions[i].isVerySimilar(view.regions[i])) {
+            return false;
+        }
+    }
     return true;
 }
 
+uint64_t DiffTraversal::View::getUpdatePeriod() const {
+    if (!viewFrustums.empty() || regions.empty()) {
+        return 0;
+    }
+    // the region that needs the most frequent updates sets the pace for all of them
+    uint32_t updatePeriod = regions.front().getUpdatePeriod();
+    for (const auto& region : regions) {
+        updatePeriod = std::min(updatePeriod, region.getUpdatePeriod());
+    }
+    return (uint64_t)updatePeriod * USECS_PER_MSEC;
+}
+
 float DiffTraversal::View::computePriority(const EntityItemPointer& entity) const {
     if (!entity) {
         return PrioritizedEntity::DO_NOT_SEND;
@@ -159,6 +189,13 @@ float DiffTraversal::View::computePriority(const EntityItemPointer& entity) cons
         }
     }
 
+    for (const auto& region : regions) {
+        float regionPriority = region.computePriority(center, radius);
+        if (regionPriority >= 0.0f) {
+            priority = std::max(priority, regionPriority);
+        }
+    }
+
     return priority;
 }
 
@@ -173,6 +210,13 @@ bool DiffTraversal::View::shouldTraverseElement(const EntityTreeElement& element
     auto radius = 0.5f * SQRT_THREE * cube.getScale(); // radius of bounding sphere
 
 
+    // elements hold entities smaller than themselves, so only the frustums cull them by size
+    if (any_of(begin(regions), end(regions), [&](const InterestRegion& region) {
+        return region.intersects(center, radius);
+    })) {
+        return true;
+    }
+
     return any_of(begin(viewFrustums), end(viewFrustums), [&](const ConicalViewFrustum& frustum) {
         auto position = center - frustum.getPosition(); // position of bounding sphere in view-frame
         float distance = glm::length(position); // distance to center of bounding sphere
@@ -194,7 +238,7 @@ DiffTraversal::DiffTraversal() {
 }
 
 DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root,
-                                                       bool forceFirstPass) {
+                                                       bool forceFirstPass, DiffTraversalCache* cache) {
     assert(root);
     // there are three types of traversal:
     //
@@ -216,6 +260,7 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
     if (forceFirstPass || _completedView.startTime == 0 || _currentView.usesViewFrustums() != _completedView.usesViewFrustums()) {
         type = Type::First;
         _currentView.viewFrustums = view.viewFrustums;
+        _currentView.regions = view.regions;
         _currentView.lodScaleFactor = view.lodScaleFactor;
         _getNextVisibleElementCallback = [this](DiffTraversal::VisibleElement& next) {
             _path.back().getNextVisibleElementFirstTime(next, _currentView);
@@ -228,6 +273,7 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
     } else {
         type = Type::Differential;
         _currentView.viewFrustums = view.viewFrustums;
+        _currentView.regions = view.regions;
         _currentView.lodScaleFactor = view.lodScaleFactor;
         _getNextVisibleElementCallback = [this](DiffTraversal::VisibleElement& next) {
             _path.back().getNextVisibleElementDifferential(next, _currentView, _completedView);
@@ -235,6 +281,17 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
     }
 
     _path.clear();
+    _sharedTraversal.reset();
+    if (cache && type != Type::Repeat && _currentView.regions.empty()) {
+        // First and Differential traversals both find every element in view, so they can share the work, except for
+        // views with interest regions which are rare enough to traverse on their own. The traversal counts as having
+        // started when the shared one did, for the next Repeat to find what changed since.
+        _sharedTraversal = cache->getTraversal(_currentView, root);
+        _sharedElementIndex = 0;
+        _currentView.startTime = _sharedTraversal->getStartTime();
+        return type;
+    }
+
     _path.push_back(DiffTraversal::Waypoint(root));
     // set root fork's index such that root element returned at getNextElement()
     _path.back().initRootNextIndex();
@@ -285,6 +342,11 @@ void DiffTraversal::setScanCallback(std::function<void (DiffTraversal::VisibleEl
 
 void DiffTraversal::traverse(uint64_t timeBudget) {
     uint64_t expiry = usecTimestampNow() + timeBudget;
+    if (_sharedTraversal) {
+        traverseShared(expiry);
+        return;
+    }
+
     DiffTraversal::VisibleElement next;
     getNextVisibleElement(next);
     while (next.element) {
@@ -297,3 +359,127 @@ void DiffTraversal::traverse(uint64_t timeBudget) {
         getNextVisibleElement(next);
     }
 }
+
+void DiffTraversal::traverseShared(uint64_t expiry) {
+    uint64_t now = usecTimestampNow();
+    if (!_sharedTraversal->traverse(expiry > now ? expiry - now : 0)) {
+        return;
+    }
+
+    // the shared traversal used a wider view than ours, so the elements still need to be culled with ours
+    const auto& elements = _sharedTraversal->getElements();
+    DiffTraversal::VisibleElement next;
+    while (_sharedElementIndex < elements.size()) {
+        next.element = elements[_sharedElementIndex++].lock();
+        if (next.element && next.element->hasContent() && _currentView.shouldTraverseElement(*next.element)) {
+            _scanElementCallback(next);
+        }
+        if (usecTimestampNow() > expiry) {
+            return;
+        }
+    }
+
+    _completedView = _currentView;
+    _sharedTraversal.reset();
+}
+
+SharedDiffTraversal::SharedDiffTraversal(const DiffTraversal::View& cellView, EntityTreeElementPointer root) {
+    const bool FORCE_FIRST_PASS = true;
+    _traversal.prepareNewTraversal(cellView, root, FORCE_FIRST_PASS);
+    _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
+        _elements.push_back(next.element);
+    });
+    _startTime = _traversal.getCurrentView().startTime;
+}
+
+bool SharedDiffTraversal::traverse(uint64_t timeBudget) {
+    if (_finished.load(std::memory_order_acquire)) {
+        return true;
+    }
+
+    // the clients waiting on a traversal another one is advancing have nothing else to do in the meantime
+    std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return false;
+    }
+
+    if (!_traversal.finished()) {
+        _traversal.traverse(timeBudget);
+    }
+    if (!_traversal.finished()) {
+        return false;
+    }
+
+    _finished.store(true, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+static void appendValue(QByteArray& key, const T& value) {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// returns a frustum that contains every frustum in the cell of this one, and appends the cell to the key
+static ConicalViewFrustum computeCellFrustum(const ConicalViewFrustum& frustum, QByteArray& key) {
+    glm::ivec3 cell = glm::ivec3(glm::floor(frustum.getPosition() / CELL_SIZE));
+    const glm::vec3& direction = frustum.getDirection();
+    int32_t yawBin = (int32_t)floorf(atan2f(direction.x, direction.z) / DIRECTION_BIN);
+    int32_t pitchBin = (int32_t)floorf(asinf(glm::clamp(direction.y, -1.0f, 1.0f)) / DIRECTION_BIN);
+    int32_t angleBin = (int32_t)ceilf(frustum.getAngle() / ANGLE_BIN);
+    int32_t radiusBin = (int32_t)ceilf(frustum.getRadius() / RADIUS_BIN);
+    int32_t farClipBin = (int32_t)ceilf(frustum.getFarClip() / FAR_CLIP_BIN);
+
+    appendValue(key, cell);
+    appendValue(key, yawBin);
+    appendValue(key, pitchBin);
+    appendValue(key, angleBin);
+    appendValue(key, radiusBin);
+    appendValue(key, farClipBin);
+
+    glm::vec3 cellPosition = (glm::vec3(cell) + 0.5f) * CELL_SIZE;
+    float yaw = ((float)yawBin + 0.5f) * DIRECTION_BIN;
+    float pitch = ((float)pitchBin + 0.5f) * DIRECTION_BIN;
+    glm::vec3 cellDirection { cosf(pitch) * sinf(yaw), sinf(pitch), cosf(pitch) * cosf(yaw) };
+
+    // a direction is at most DIRECTION_BIN away from the middle of its bin, and past the keyhole a point seen from
+    // anywhere in the cell is at most asin(CELL_HALF_DIAGONAL / radius) further off the axis seen from its center,
+    // which is doubled to allow for the apparent size of what is seen
+    float radius = (float)radiusBin * RADIUS_BIN;
+    float apexSlop = asinf(std::min(1.0f, 2.0f * CELL_HALF_DIAGONAL / std::max(radius, EPSILON)));
+    float cellAngle = std::min((float)angleBin * ANGLE_BIN + DIRECTION_BIN + apexSlop, PI);
+
+    ConicalViewFrustum cellFrustum;
+    cellFrustum.set(cellPosition, cellDirection, cellAngle, radius + CELL_HALF_DIAGONAL,
+                    (float)farClipBin * FAR_CLIP_BIN + CELL_HALF_DIAGONAL);
+    return cellFrustum;
+}
+
+SharedDiffTraversal::Pointer DiffTraversalCache::getTraversal(const DiffTraversal::View& view,
+                                                              const EntityTreeElementPointer& root) {
+    QByteArray key;
+    appendValue(key, view.lodScaleFactor);
+
+    DiffTraversal::View cellView;
+    for (const auto& frustum : view.viewFrustums) {
+        cellView.viewFrustums.push_back(computeCellFrustum(frustum, key));
+    }
+    // seen from the center of the cell, what is just big enough to be seen from elsewhere in it looks at most
+    // half as big, for anything further away from the viewer than CELL_HALF_DIAGONAL
+    cellView.lodScaleFactor = view.usesViewFrustums() ? 0.5f * view.lodScaleFactor : view.lodScaleFactor;
+
+    uint64_t now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto it = _traversals.begin(); it != _traversals.end();) {
+        if (now - (*it)->getStartTime() > SHARED_TRAVERSAL_MAX_AGE) {
+            it = _traversals.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    auto& traversal = _traversals[key];
+    if (!traversal) {
+        traversal = std::make_shared<SharedDiffTraversal>(cellView, root);
+    }
+    return traversal;
+}
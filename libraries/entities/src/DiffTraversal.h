@@ -12,10 +12,19 @@
 #ifndef hifi_DiffTraversal_h
 #define hifi_DiffTraversal_h
 
+#include <atomic>
+#include <mutex>
+
+#include <QtCore/QHash>
+
 #include <shared/ConicalViewFrustum.h>
+#include <shared/InterestRegion.h>
 
 #include "EntityTreeElement.h"
 
+class DiffTraversalCache;
+class SharedDiffTraversal;
+
 // DiffTraversal traverses the tree and applies _scanElementCallback on elements it finds
 class DiffTraversal {
 public:
@@ -26,16 +35,21 @@ public:
         EntityTreeElementPointer element;
     };
 
-    // View is a struct with a ViewFrustum and LOD parameters
+    // View is a struct with the ViewFrustums and InterestRegions a client wants the entities in, and LOD parameters
     class View {
     public:
+        // whether the view culls anything, a view with neither frustums nor regions sees everything
         bool usesViewFrustums() const;
         bool isVerySimilar(const View& view) const;
 
         bool shouldTraverseElement(const EntityTreeElement& element) const;
         float computePriority(const EntityItemPointer& entity) const;
 
+        // how often everything in the view needs to be checked for changes, zero for as often as possible
+        uint64_t getUpdatePeriod() const;
+
         ConicalViewFrustums viewFrustums;
+        InterestRegions regions;
         uint64_t startTime { 0 };
         float lodScaleFactor { 1.0f };
     };
@@ -61,26 +75,70 @@ public:
 
     DiffTraversal();
 
-    Type prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root, bool forceFirstPass = false);
+    // First and Differential traversals go through the cache when one is given, see DiffTraversalCache
+    Type prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root, bool forceFirstPass = false,
+                             DiffTraversalCache* cache = nullptr);
 
     const View& getCurrentView() const { return _currentView; }
 
     uint64_t getStartOfCompletedTraversal() const { return _completedView.startTime; }
-    bool finished() const { return _path.empty(); }
+    bool finished() const { return _path.empty() && !_sharedTraversal; }
 
     void setScanCallback(std::function<void (VisibleElement&)> cb);
     void traverse(uint64_t timeBudget);
 
-    void reset() { _path.clear(); _completedView.startTime = 0; } // resets our state to force a new "First" traversal
+    void reset() { _path.clear(); _sharedTraversal.reset(); _completedView.startTime = 0; } // resets our state to force a new "First" traversal
 
 private:
     void getNextVisibleElement(VisibleElement& next);
+    void traverseShared(uint64_t expiry);
 
     View _currentView;
     View _completedView;
     std::vector<Waypoint> _path;
     std::function<void (VisibleElement&)> _getNextVisibleElementCallback { nullptr };
     std::function<void (VisibleElement&)> _scanElementCallback { [](VisibleElement& e){} };
+
+    std::shared_ptr<SharedDiffTraversal> _sharedTraversal;
+    size_t _sharedElementIndex { 0 };
+};
+
+// The elements with content in view of a view cell, found by a single traversal that the clients whose views
+// fall in the cell take turns advancing. Each of them then only has to go over the list with its own view.
+class SharedDiffTraversal {
+public:
+    using Pointer = std::shared_ptr<SharedDiffTraversal>;
+
+    SharedDiffTraversal(const DiffTraversal::View& cellView, EntityTreeElementPointer root);
+
+    // advances the traversal unless another thread already is, returns true once it has finished
+    bool traverse(uint64_t timeBudget);
+
+    uint64_t getStartTime() const { return _startTime; }
+
+    // only valid once traverse() has returned true
+    const std::vector<EntityTreeElementWeakPointer>& getElements() const { return _elements; }
+
+private:
+    std::mutex _mutex;
+    std::atomic<bool> _finished { false };
+    DiffTraversal _traversal;
+    std::vector<EntityTreeElementWeakPointer> _elements;
+    uint64_t _startTime { 0 };
+};
+
+// The traversals shared by the clients of a server. Views are quantized into cells of position, direction and
+// frustum shape, and a cell's traversal uses a view that contains every view in the cell, so that a client
+// never misses an element it would have found on its own. Traversals are only shared with clients that start
+// theirs shortly after, the changes made since are picked up by each client's next Repeat traversal.
+class DiffTraversalCache {
+public:
+    // returns the traversal for the view's cell, starting one if there is none recent enough
+    SharedDiffTraversal::Pointer getTraversal(const DiffTraversal::View& view, const EntityTreeElementPointer& root);
+
+private:
+    std::mutex _mutex;
+    QHash<QByteArray, SharedDiffTraversal::Pointer> _traversals;
 };
 
 #endif // hifi_EntityPriorityQueue_h
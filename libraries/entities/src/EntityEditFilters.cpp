@@ -11,6 +11,7 @@
 
 #include "EntityEditFilters.h"
 
+#include <QJsonDocument>
 #include <QUrl>
 
 #include <ResourceManager.h>
@@ -42,6 +43,20 @@ QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
     return zones;
 }
 
+static void recordFilterStats(EntityEditFilters::FilterStats* stats, quint64 startTime, bool accepted) {
+    if (!stats) {
+        return;
+    }
+    uint64_t usecs = usecTimestampNow() - startTime;
+    stats->numMessages++;
+    if (!accepted) {
+        stats->numRejected++;
+    }
+    stats->totalUsecs += usecs;
+    uint64_t maxUsecs = stats->maxUsecs;
+    while (usecs > maxUsecs && !stats->maxUsecs.compare_exchange_weak(maxUsecs, usecs)) {}
+}
+
 bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut,
         bool& wasChanged, EntityTree::FilterType filterType, EntityItemID& itemID, EntityItemPointer& existingEntity) {
     
@@ -73,6 +88,20 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 return true; // accept the message
             }
 
+            quint64 startTime = usecTimestampNow();
+            if (filterData.declarativeFilter) {
+                EntityItemPointer zoneEntity = id.isInvalidID() ? EntityItemPointer() : _tree->findEntityByEntityItemID(id);
+                bool accepted = filterData.declarativeFilter->filter(propertiesIn, zoneEntity, wasChanged);
+                recordFilterStats(filterData.stats.get(), startTime, accepted);
+                if (!accepted) {
+                    return false;
+                }
+                if (&propertiesOut != &propertiesIn) {
+                    propertiesOut = propertiesIn;
+                }
+                continue;
+            }
+
             auto oldProperties = propertiesIn.getDesiredProperties();
             auto specifiedProperties = propertiesIn.getChangedProperties();
             propertiesIn.setDesiredProperties(specifiedProperties);
@@ -131,7 +160,9 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
 
             QScriptValue result = filterData.filterFn.call(_nullObjectForFilter, args);
 
-            if (filterData.uncaughtExceptions()) {
+            bool accepted = !filterData.uncaughtExceptions() && (result.isObject() || (result.isBool() && result.toBool()));
+            recordFilterStats(filterData.stats.get(), startTime, accepted);
+            if (!accepted) {
                 return false;
             }
 
@@ -144,19 +175,10 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 // Javascript objects are == only if they are the same object. To compare arbitrary values, we need to use JSON.
                 auto out = QJsonValue::fromVariant(result.toVariant());
                 wasChanged |= (in != out);
-            } else if (result.isBool()) {
-
-                // if the filter returned false, then it's authoritative
-                if (!result.toBool()) {
-                    return false;
-                }
-
-                // otherwise, assume it wants to pass all properties
+            } else {
+                // the filter returned true, assume it wants to pass all properties
                 propertiesOut = propertiesIn;
                 wasChanged = false;
-                
-            } else {
-                return false;
             }
         }
     }
@@ -164,6 +186,26 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
     return true;
 }
 
+QString EntityEditFilters::getStatsString() {
+    QString statsString;
+    QReadLocker readLock(&_lock);
+    for (auto it = _filterDataMap.begin(); it != _filterDataMap.end(); ++it) {
+        auto stats = it.value().stats;
+        if (!stats) {
+            continue;
+        }
+        uint64_t numMessages = stats->numMessages;
+        statsString += QString("%1 %2\r\n").arg(it.key().isInvalidID() ? "domain" : it.key().toString(), stats->url);
+        statsString += QString("    %1 %2 messages, %3 rejected, %4 usecs average, %5 usecs max\r\n")
+            .arg(it.value().declarativeFilter ? "declarative" : "script")
+            .arg(numMessages)
+            .arg((uint64_t)stats->numRejected)
+            .arg(numMessages > 0 ? (double)stats->totalUsecs / (double)numMessages : 0.0, 0, 'f', 1)
+            .arg((uint64_t)stats->maxUsecs);
+    }
+    return statsString;
+}
+
 void EntityEditFilters::removeFilter(EntityItemID entityID) {
     QWriteLocker writeLock(&_lock);
     FilterData filterData = _filterDataMap.value(entityID);
@@ -255,6 +297,34 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
         const QString urlString = scriptRequest->getUrl().toString();
         auto scriptContents = scriptRequest->getData();
         qInfo() << "Downloaded script:" << scriptContents;
+
+        // a JSON document describes a declarative filter, which doesn't need a script engine
+        QJsonDocument filterDocument = QJsonDocument::fromJson(scriptContents);
+        if (filterDocument.isObject()) {
+            auto declarativeFilter = DeclarativeEditFilter::compile(filterDocument.object(), urlString);
+            if (declarativeFilter) {
+                FilterData filterData;
+                filterData.declarativeFilter = declarativeFilter;
+                filterData.stats = std::make_shared<FilterStats>();
+                filterData.stats->url = urlString;
+                filterData.wantsToFilterAdd = declarativeFilter->wantsToFilter(EntityTree::FilterType::Add);
+                filterData.wantsToFilterEdit = declarativeFilter->wantsToFilter(EntityTree::FilterType::Edit);
+                filterData.wantsToFilterPhysics = declarativeFilter->wantsToFilter(EntityTree::FilterType::Physics);
+                filterData.wantsToFilterDelete = declarativeFilter->wantsToFilter(EntityTree::FilterType::Delete);
+
+                _lock.lockForWrite();
+                _filterDataMap.insert(entityID, filterData);
+                _lock.unlock();
+
+                qDebug() << "declarative filter processed for entity id " << entityID;
+
+                emit filterAdded(entityID, true);
+                return;
+            }
+            emit filterAdded(entityID, false);
+            return;
+        }
+
         QScriptProgram program(scriptContents, urlString);
         if (hasCorrectSyntax(program)) {
             // create a QScriptEngine for this script
@@ -271,6 +341,8 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
                 FilterData filterData;
                 filterData.engine = engine;
                 filterData.rejectAll = false;
+                filterData.stats = std::make_shared<FilterStats>();
+                filterData.stats->url = urlString;
                 
                 // define the uncaughtException function
                 QScriptEngine& engineRef = *engine;
@@ -17,8 +17,11 @@
 #include <QScriptEngine>
 #include <glm/glm.hpp>
 
+#include <atomic>
 #include <functional>
+#include <memory>
 
+#include "DeclarativeEditFilter.h"
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
 #include "EntityTree.h"
@@ -26,8 +29,20 @@
 class EntityEditFilters : public QObject, public Dependency {
     Q_OBJECT
 public:
+    // shared by the copies of a filter's data
+    struct FilterStats {
+        QString url;
+        std::atomic<uint64_t> numMessages { 0 };
+        std::atomic<uint64_t> numRejected { 0 };
+        std::atomic<uint64_t> totalUsecs { 0 };
+        std::atomic<uint64_t> maxUsecs { 0 };
+    };
+
     struct FilterData {
         QScriptValue filterFn;
+        // filters loaded from a JSON document are run natively, without the script engine
+        DeclarativeEditFilter::Pointer declarativeFilter;
+        std::shared_ptr<FilterStats> stats;
         bool wantsOriginalProperties { false };
         bool wantsZoneProperties { false };
 
@@ -45,7 +60,9 @@ public:
         bool rejectAll;
         
         FilterData(): engine(nullptr), rejectAll(false) {};
-        bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
+        bool valid() {
+            return (rejectAll || declarativeFilter || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions));
+        }
     };
 
     EntityEditFilters() {};
@@ -57,6 +74,9 @@ public:
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
                 EntityTree::FilterType filterType, EntityItemID& entityID, EntityItemPointer& existingEntity);
 
+    // the number of messages each filter has seen, rejected, and the time it took, for the server stats page
+    QString getStatsString();
+
 signals:
     void filterAdded(EntityItemID id, bool success);
 
@@ -0,0 +1,77 @@
+//
+//  EntityEncodeCache.cpp
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEncodeCache.h"
+
+#include <NumericalConstants.h>
+
+#include "EntityTreeElement.h"
+
+const quint64 ENCODING_MAX_AGE = USECS_PER_SECOND;
+
+bool EntityEncodeCache::isCurrent(const Encoding& encoding, const EntityItemPointer& entity, quint64 now) const {
+    return now - encoding.encodedTime < ENCODING_MAX_AGE && encoding.lastEdited == entity->getLastEdited() &&
+        encoding.lastUpdated == entity->getLastUpdated() && encoding.lastSimulated == entity->getLastSimulated();
+}
+
+void EntityEncodeCache::pruneEncodings(quint64 now) {
+    if (now - _lastPruneTime < ENCODING_MAX_AGE) {
+        return;
+    }
+    _lastPruneTime = now;
+    for (auto& encodings : _encodings) {
+        for (auto it = encodings.begin(); it != encodings.end();) {
+            if (now - it->encodedTime >= ENCODING_MAX_AGE) {
+                it = encodings.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+bool EntityEncodeCache::appendEntity(OctreePacketData* packetData, EncodeBitstreamParams& params,
+                                     const EntityItemPointer& entity, bool withPrivateUserData) {
+    auto& encodings = _encodings[withPrivateUserData ? 1 : 0];
+    quint64 now = usecTimestampNow();
+    QByteArray data;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = encodings.find(entity->getID());
+        if (it != encodings.end() && isCurrent(*it, entity, now)) {
+            data = it->data;
+        }
+    }
+
+    if (data.isEmpty()) {
+        // the encoding doesn't depend on who it is for, past the private user data
+        Encoding encoding { QByteArray(), entity->getLastEdited(), entity->getLastUpdated(), entity->getLastSimulated(), now };
+        OctreePacketData encodingData;
+        EncodeBitstreamParams encodingParams(params.includeExistsBits);
+        auto extraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+        if (entity->appendEntityData(&encodingData, encodingParams, extraEncodeData, withPrivateUserData) !=
+            OctreeElement::COMPLETED) {
+            return false;
+        }
+        data = QByteArray(reinterpret_cast<const char*>(encodingData.getUncompressedData()),
+                          encodingData.getUncompressedSize());
+        encoding.data = data;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        pruneEncodings(now);
+        encodings[entity->getID()] = encoding;
+    }
+
+    if (!packetData->appendRawData(reinterpret_cast<const unsigned char*>(data.constData()), data.size())) {
+        return false;
+    }
+    params.trackSend(entity->getID(), entity->getLastEdited());
+    return true;
+}
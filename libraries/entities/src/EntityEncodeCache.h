@@ -0,0 +1,53 @@
+//
+//  EntityEncodeCache.h
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEncodeCache_h
+#define hifi_EntityEncodeCache_h
+
+#include <mutex>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+
+#include <Octree.h>
+#include <OctreePacketData.h>
+
+#include "EntityItem.h"
+
+// The full encodings of entities, as appendEntityData writes them for a client that doesn't know about them yet, shared
+// by the send threads of a server. A crowd of clients arriving together then has each entity they load encoded once
+// rather than once per client. An encoding is used until its entity is edited, updated or simulated, and for no more
+// than a second in any case, since a few changes don't touch any of those times.
+class EntityEncodeCache {
+public:
+    // appends the entity's full encoding, making it first if there is none current. returns false when it doesn't fit
+    // in what is left of the packet, or doesn't fit in a packet at all, for the caller to encode it as usual.
+    bool appendEntity(OctreePacketData* packetData, EncodeBitstreamParams& params, const EntityItemPointer& entity,
+                      bool withPrivateUserData);
+
+private:
+    class Encoding {
+    public:
+        QByteArray data;
+        quint64 lastEdited;
+        quint64 lastUpdated;
+        quint64 lastSimulated;
+        quint64 encodedTime;
+    };
+
+    bool isCurrent(const Encoding& encoding, const EntityItemPointer& entity, quint64 now) const;
+    void pruneEncodings(quint64 now);
+
+    std::mutex _mutex;
+    QHash<QUuid, Encoding> _encodings[2]; // without and with the private user data
+    quint64 _lastPruneTime { 0 };
+};
+
+#endif // hifi_EntityEncodeCache_h
@@ -2622,6 +2622,14 @@ void EntityItem::dimensionsChanged() {
     somethingChangedNotification();
 }
 
+void EntityItem::queryAACubeChanged() {
+    // only the entities that are in a tree are in its spatial index
+    EntityTreeElementPointer element = _element;
+    if (element) {
+        element->getTree()->getSpatialIndex().update(getThisPointer());
+    }
+}
+
 bool EntityItem::getScalesWithParent() const {
     // keep this logic the same as in EntityItemProperties::getScalesWithParent
     if (isAvatarEntity()) {
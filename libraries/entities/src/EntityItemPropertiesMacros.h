@@ -33,6 +33,24 @@
             propertiesDidntFit -= P;                                \
         }
 
+// like APPEND_ENTITY_PROPERTY, but sends the value as a delta from what the node has, see EntityPropertyDelta.h
+#define APPEND_ENTITY_PROPERTY_DELTA(P,V) \
+        if (requestedProperties.getHasProperty(P)) {                \
+            LevelDetails propertyLevel = packetData->startLevel();  \
+            successPropertyFits = EntityPropertyDelta::appendValue(packetData, params, getID(), P, V); \
+            if (successPropertyFits) {                              \
+                propertyFlags |= P;                                 \
+                propertiesDidntFit -= P;                            \
+                propertyCount++;                                    \
+                packetData->endLevel(propertyLevel);                \
+            } else {                                                \
+                packetData->discardLevel(propertyLevel);            \
+                appendState = OctreeElement::PARTIAL;               \
+            }                                                       \
+        } else {                                                    \
+            propertiesDidntFit -= P;                                \
+        }
+
 #define READ_ENTITY_PROPERTY(P,T,S)                                                \
         if (propertyFlags.getHasProperty(P)) {                                     \
             T fromBuffer;                                                          \
@@ -45,6 +63,20 @@
             somethingChanged = true;                                               \
         }
 
+// reads a value appended with APPEND_ENTITY_PROPERTY_DELTA, given the getter for the value it may be a delta from
+#define READ_ENTITY_PROPERTY_DELTA(P,T,G,S)                                        \
+        if (propertyFlags.getHasProperty(P)) {                                     \
+            QVector<T> fromBuffer;                                                 \
+            bool deltaApplies;                                                     \
+            int bytes = EntityPropertyDelta::decode(dataAt, G(), fromBuffer, deltaApplies); \
+            dataAt += bytes;                                                       \
+            bytesRead += bytes;                                                    \
+            if (overwriteLocalData && deltaApplies) {                              \
+                S(fromBuffer);                                                     \
+            }                                                                      \
+            somethingChanged = true;                                               \
+        }
+
 #define SKIP_ENTITY_PROPERTY(P,T)                                                  \
         if (propertyFlags.getHasProperty(P)) {                                     \
             T fromBuffer;                                                          \
@@ -28,3 +28,42 @@ bool EntityNodeData::isEntityFlaggedAsExtra(const QUuid& entityID) const {
 
     return false;
 }
+
+const QByteArray* EntityNodeData::findAckedPropertyValue(const QUuid& entityID, EntityPropertyList property) {
+    auto entityValues = _sentPropertyValues.find(entityID);
+    if (entityValues == _sentPropertyValues.end()) {
+        return nullptr;
+    }
+    auto sentValue = entityValues->find(property);
+    if (sentValue == entityValues->end()) {
+        return nullptr;
+    }
+
+    if (sentValue->hasPendingValue) {
+        OCTREE_PACKET_SEQUENCE ackedSequenceNumber;
+        if (!getAckedSequenceNumber(ackedSequenceNumber) ||
+            (int16_t)(ackedSequenceNumber - sentValue->pendingSequenceNumber) < 0) {
+            // the client has either the value before or the one still on its way
+            return nullptr;
+        }
+        sentValue->ackedValue = sentValue->pendingValue;
+        sentValue->hasAckedValue = true;
+        sentValue->pendingValue.clear();
+        sentValue->hasPendingValue = false;
+    }
+    return sentValue->hasAckedValue ? &sentValue->ackedValue : nullptr;
+}
+
+void EntityNodeData::stageSentPropertyValue(const QUuid& entityID, EntityPropertyList property, const QByteArray& value) {
+    _stagedPropertyValues.push_back({ entityID, property, value });
+}
+
+void EntityNodeData::commitSentPropertyValues(OCTREE_PACKET_SEQUENCE sequenceNumber) {
+    for (auto& staged : _stagedPropertyValues) {
+        SentPropertyValue& sentValue = _sentPropertyValues[staged.entityID][staged.property];
+        sentValue.pendingValue = staged.value;
+        sentValue.pendingSequenceNumber = sequenceNumber;
+        sentValue.hasPendingValue = true;
+    }
+    _stagedPropertyValues.clear();
+}
@@ -12,10 +12,14 @@
 #ifndef hifi_EntityNodeData_h
 #define hifi_EntityNodeData_h
 
+#include <vector>
+
 #include <udt/PacketHeaders.h>
 
 #include <OctreeQueryNode.h>
 
+#include "EntityPropertyFlags.h"
+
 namespace EntityJSONQueryProperties {
     static const QString SERVER_SCRIPTS_PROPERTY = "serverScripts";
     static const QString FLAGS_PROPERTY = "flags";
@@ -44,11 +48,41 @@ public:
     bool isEntityFlaggedAsExtra(const QUuid& entityID) const;
     void resetFlaggedExtraEntities() { _previousFlaggedExtraEntities = _flaggedExtraEntities; _flaggedExtraEntities.clear(); }
 
+    // the following sent property value methods can only be called from the OctreeSendThread for the given Node
+
+    // returns the value of the property the client is known to have, or null if that isn't certain
+    const QByteArray* findAckedPropertyValue(const QUuid& entityID, EntityPropertyList property);
+
+    // values are staged as they are appended, then committed once the entity is in the packet, or discarded if it isn't
+    void stageSentPropertyValue(const QUuid& entityID, EntityPropertyList property, const QByteArray& value);
+    void commitSentPropertyValues(OCTREE_PACKET_SEQUENCE sequenceNumber);
+    void discardSentPropertyValues() { _stagedPropertyValues.clear(); }
+
+    void removeSentPropertyValues(const QUuid& entityID) { _sentPropertyValues.remove(entityID); }
+    void resetSentPropertyValues() { _sentPropertyValues.clear(); _stagedPropertyValues.clear(); }
+
 private:
+    struct SentPropertyValue {
+        QByteArray ackedValue;
+        bool hasAckedValue { false };
+        // the last value sent, until the client acknowledges the packet it went out in
+        QByteArray pendingValue;
+        OCTREE_PACKET_SEQUENCE pendingSequenceNumber { 0 };
+        bool hasPendingValue { false };
+    };
+    struct StagedPropertyValue {
+        QUuid entityID;
+        EntityPropertyList property;
+        QByteArray value;
+    };
+
     quint64 _lastDeletedEntitiesSentAt { usecTimestampNow() };
     QSet<QUuid> _sentFilteredEntities;
     QHash<QUuid, QSet<QUuid>> _flaggedExtraEntities;
     QHash<QUuid, QSet<QUuid>> _previousFlaggedExtraEntities;
+
+    QHash<QUuid, QHash<int, SentPropertyValue>> _sentPropertyValues;
+    std::vector<StagedPropertyValue> _stagedPropertyValues;
 };
 
 #endif // hifi_EntityNodeData_h
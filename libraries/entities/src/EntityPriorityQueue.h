@@ -12,8 +12,7 @@
 #ifndef hifi_EntityPriorityQueue_h
 #define hifi_EntityPriorityQueue_h
 
-#include <queue>
-#include <unordered_set>
+#include <IndexedHeap.h>
 
 #include "EntityItem.h"
 
@@ -32,7 +31,7 @@ public:
 
     class Compare {
     public:
-        bool operator() (const PrioritizedEntity& A, const PrioritizedEntity& B) { return A._priority < B._priority; }
+        bool operator() (const PrioritizedEntity& A, const PrioritizedEntity& B) const { return A._priority < B._priority; }
     };
     friend class Compare;
 
@@ -43,50 +42,60 @@ private:
     bool _forceRemove;
 };
 
+// EntityPriorityQueue holds each entity at most once, so that an entity that is edited while it is queued has its place
+// in the queue changed rather than being queued again.
 class EntityPriorityQueue {
 public:
-    inline bool empty() const {
-        assert(_queue.empty() == _entities.empty());
-        return _queue.empty();
-    }
+    inline bool empty() const { return _queue.empty(); }
+    inline size_t size() const { return _queue.size(); }
 
     inline const PrioritizedEntity& top() const {
         assert(!_queue.empty());
         return _queue.top();
     }
 
-    inline bool contains(const EntityItem* entity) const {
-        return _entities.find(entity) != std::end(_entities);
-    }
+    inline bool contains(const EntityItem* entity) const { return _queue.contains(entity); }
+    inline const PrioritizedEntity* find(const EntityItem* entity) const { return _queue.find(entity); }
 
     inline void emplace(const EntityItemPointer& entity, float priority, bool forceRemove = false) {
         assert(entity && !contains(entity.get()));
-        _queue.emplace(entity, priority, forceRemove);
-        _entities.insert(entity.get());
-        assert(_queue.size() == _entities.size());
+        _queue.set(entity.get(), PrioritizedEntity(entity, priority, forceRemove));
+    }
+
+    // queues the entity, or moves it to its new place if it is already queued
+    inline void update(const EntityItemPointer& entity, float priority, bool forceRemove = false) {
+        assert(entity);
+        _queue.set(entity.get(), PrioritizedEntity(entity, priority, forceRemove));
     }
 
     inline void pop() {
         assert(!empty());
-        _entities.erase(_queue.top().getRawEntityPointer());
         _queue.pop();
-        assert(_queue.size() == _entities.size());
     }
 
-    inline void swap(EntityPriorityQueue& other) {
-        std::swap(_queue, other._queue);
-        std::swap(_entities, other._entities);
+    inline bool remove(const EntityItem* entity) { return _queue.remove(entity); }
+
+    // calls the operator on every queued entity for its new priority, dropping the ones it returns DO_NOT_SEND for
+    template <typename Operator>
+    void reprioritize(const Operator& priorityOperator) {
+        _queue.update([&](PrioritizedEntity& queued) {
+            EntityItemPointer entity = queued.getEntity();
+            if (!entity) {
+                return false;
+            }
+            float priority = priorityOperator(entity, queued);
+            if (priority == PrioritizedEntity::DO_NOT_SEND) {
+                return false;
+            }
+            queued = PrioritizedEntity(entity, priority, queued.shouldForceRemove());
+            return true;
+        });
     }
 
-private:
-    using PriorityQueue = std::priority_queue<PrioritizedEntity,
-                                              std::vector<PrioritizedEntity>,
-                                              PrioritizedEntity::Compare>;
-
-    PriorityQueue _queue;
-    // Keep dictionary of all the entities in the queue for fast contain checks.
-    std::unordered_set<const EntityItem*> _entities;
+    inline void swap(EntityPriorityQueue& other) { _queue.swap(other._queue); }
 
+private:
+    IndexedHeap<const EntityItem*, PrioritizedEntity, PrioritizedEntity::Compare> _queue;
 };
 
 #endif // hifi_EntityPriorityQueue_h
@@ -0,0 +1,42 @@
+//
+//  EntityPropertyDelta.cpp
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPropertyDelta.h"
+
+#include <atomic>
+
+#include "EntitiesLogging.h"
+
+namespace EntityPropertyDelta {
+
+static std::atomic<bool> failedDecodes { false };
+
+uint32_t hashBytes(const char* data, int size) {
+    // FNV-1a, which unlike qHash is the same on the server and the client
+    const uint32_t FNV_OFFSET_BASIS = 2166136261u;
+    const uint32_t FNV_PRIME = 16777619u;
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for (int i = 0; i < size; i++) {
+        hash = (hash ^ (uint8_t)data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+void noteFailedDecode() {
+    if (!failedDecodes.exchange(true)) {
+        qCDebug(entities) << "Received a property delta against a value we don't have";
+    }
+}
+
+bool takeFailedDecodes() {
+    return failedDecodes.exchange(false);
+}
+
+}
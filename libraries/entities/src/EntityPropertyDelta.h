@@ -0,0 +1,164 @@
+//
+//  EntityPropertyDelta.h
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPropertyDelta_h
+#define hifi_EntityPropertyDelta_h
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QUuid>
+#include <QtCore/QVector>
+
+#include <Octree.h>
+#include <OctreePacketData.h>
+
+#include "EntityNodeData.h"
+#include "EntityPropertyFlags.h"
+
+// Encodes the large array properties of entities (line points, stroke widths and the like) sent by the entity server
+// as the difference from the value the client last acknowledged, when that is smaller than the whole value:
+//
+//  0xFFFF                        in place of the element count of the whole value
+//  uint16 baseCount              the number of elements in the acknowledged value
+//  uint32 baseHash               a hash of the acknowledged value, so the client can tell whether it still has it
+//  uint16 newCount               the number of elements in the new value
+//  changed mask                  a bit for each of the first min(baseCount, newCount) elements that has changed
+//  changed elements              the elements that are set in the mask
+//  appended elements             the elements from baseCount up to newCount
+//
+// Otherwise they are sent whole, exactly as OctreePacketData::appendValue would. Only arrays of plain values, which
+// OctreePacketData copies as they are, can be sent this way.
+namespace EntityPropertyDelta {
+    const uint16_t DELTA_MARKER = 0xFFFF;
+
+    uint32_t hashBytes(const char* data, int size);
+
+    // a client notes when a delta arrives against a value it no longer has, and takes whether that happened since it
+    // last asked, in which case the server should forget what it thinks the client has
+    void noteFailedDecode();
+    bool takeFailedDecodes();
+
+    template <typename T>
+    QByteArray encode(const QVector<T>& value, const QByteArray* base) {
+        const int elementSize = sizeof(T);
+        const char* valueData = reinterpret_cast<const char*>(value.constData());
+        uint16_t newCount = (uint16_t)value.size();
+
+        QByteArray whole;
+        whole.reserve(sizeof(newCount) + newCount * elementSize);
+        whole.append(reinterpret_cast<const char*>(&newCount), sizeof(newCount));
+        whole.append(valueData, newCount * elementSize);
+        if (!base || base->size() % elementSize != 0 || newCount == DELTA_MARKER) {
+            return whole;
+        }
+
+        uint16_t baseCount = (uint16_t)(base->size() / elementSize);
+        uint32_t baseHash = hashBytes(base->constData(), base->size());
+        int numCompared = std::min((int)baseCount, (int)newCount);
+
+        QByteArray mask((numCompared + 7) / 8, 0);
+        QByteArray changed;
+        for (int i = 0; i < numCompared; i++) {
+            const char* element = valueData + i * elementSize;
+            if (memcmp(element, base->constData() + i * elementSize, elementSize) != 0) {
+                mask[i / 8] = (char)(mask[i / 8] | (1 << (i % 8)));
+                changed.append(element, elementSize);
+            }
+        }
+
+        QByteArray delta;
+        delta.append(reinterpret_cast<const char*>(&DELTA_MARKER), sizeof(DELTA_MARKER));
+        delta.append(reinterpret_cast<const char*>(&baseCount), sizeof(baseCount));
+        delta.append(reinterpret_cast<const char*>(&baseHash), sizeof(baseHash));
+        delta.append(reinterpret_cast<const char*>(&newCount), sizeof(newCount));
+        delta.append(mask);
+        delta.append(changed);
+        if (newCount > baseCount) {
+            delta.append(valueData + baseCount * elementSize, (newCount - baseCount) * elementSize);
+        }
+        return delta.size() < whole.size() ? delta : whole;
+    }
+
+    // reads a value written by encode, returning the number of bytes read. applies is false when the value is a delta
+    // against something other than the current value, which is then left as it is.
+    template <typename T>
+    int decode(const unsigned char* dataBytes, const QVector<T>& current, QVector<T>& result, bool& applies) {
+        uint16_t count;
+        memcpy(&count, dataBytes, sizeof(count));
+        if (count != DELTA_MARKER) {
+            applies = true;
+            return OctreePacketData::unpackDataFromBytes(dataBytes, result);
+        }
+
+        const int elementSize = sizeof(T);
+        const unsigned char* dataAt = dataBytes + sizeof(count);
+        uint16_t baseCount;
+        uint32_t baseHash;
+        uint16_t newCount;
+        memcpy(&baseCount, dataAt, sizeof(baseCount));
+        dataAt += sizeof(baseCount);
+        memcpy(&baseHash, dataAt, sizeof(baseHash));
+        dataAt += sizeof(baseHash);
+        memcpy(&newCount, dataAt, sizeof(newCount));
+        dataAt += sizeof(newCount);
+
+        int numCompared = std::min((int)baseCount, (int)newCount);
+        const unsigned char* mask = dataAt;
+        dataAt += (numCompared + 7) / 8;
+
+        applies = current.size() == (int)baseCount &&
+            hashBytes(reinterpret_cast<const char*>(current.constData()), baseCount * elementSize) == baseHash;
+        if (applies) {
+            result = current;
+            result.resize(newCount);
+        }
+
+        for (int i = 0; i < numCompared; i++) {
+            if (mask[i / 8] & (1 << (i % 8))) {
+                if (applies) {
+                    memcpy(&result[i], dataAt, elementSize);
+                }
+                dataAt += elementSize;
+            }
+        }
+        if (newCount > baseCount) {
+            if (applies) {
+                memcpy(&result[baseCount], dataAt, (newCount - baseCount) * elementSize);
+            }
+            dataAt += (newCount - baseCount) * elementSize;
+        }
+
+        if (!applies) {
+            noteFailedDecode();
+        }
+        return (int)(dataAt - dataBytes);
+    }
+
+    // appends the value for the node the params are for, against what it has acknowledged of the property, and
+    // stages the value to be committed along with the packet it goes out in.
+    template <typename T>
+    bool appendValue(OctreePacketData* packetData, EncodeBitstreamParams& params, const QUuid& entityID,
+                     EntityPropertyList property, const QVector<T>& value) {
+        auto nodeData = static_cast<EntityNodeData*>(params.nodeData);
+        QByteArray encoded = encode(value, nodeData ? nodeData->findAckedPropertyValue(entityID, property) : nullptr);
+        if (!packetData->appendRawData(reinterpret_cast<const unsigned char*>(encoded.constData()), encoded.size())) {
+            return false;
+        }
+        if (nodeData) {
+            nodeData->stageSentPropertyValue(entityID, property,
+                QByteArray(reinterpret_cast<const char*>(value.constData()), value.size() * (int)sizeof(T)));
+        }
+        return true;
+    }
+}
+
+#endif // hifi_EntityPropertyDelta_h
@@ -19,6 +19,7 @@
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <QMetaMethod>
 
 #include <shared/QtHelpers.h>
 #include <VariantMapToScriptValue.h>
@@ -113,6 +114,11 @@ bool EntityScriptingInterface::canGetAndSetPrivateUserData() {
     return nodeList->getThisNodeCanGetAndSetPrivateUserData();
 }
 
+bool EntityScriptingInterface::hasCollisionListeners() const {
+    static const QMetaMethod collisionWithEntitySignal = QMetaMethod::fromSignal(&EntityScriptingInterface::collisionWithEntity);
+    return isSignalConnected(collisionWithEntitySignal);
+}
+
 void EntityScriptingInterface::setEntityTree(EntityTreePointer elementTree) {
     if (_entityTree) {
         disconnect(_entityTree.get(), &EntityTree::addingEntityPointer, this, &EntityScriptingInterface::onAddingEntity);
@@ -659,21 +665,16 @@ struct EntityPropertiesResult {
     bool scalesWithParent{ false };
 };
 
-// Static method to make sure that we have the right script engine.
-// Using sender() or QtScriptable::engine() does not work for classes used by multiple threads (script-engines)
-QScriptValue EntityScriptingInterface::getMultipleEntityProperties(QScriptContext* context, QScriptEngine* engine) {
-    const int ARGUMENT_ENTITY_IDS = 0;
-    const int ARGUMENT_EXTENDED_DESIRED_PROPERTIES = 1;
-
-    auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
-    const auto entityIDs = qscriptvalue_cast<QVector<QUuid>>(context->argument(ARGUMENT_ENTITY_IDS));
-    return entityScriptingInterface->getMultipleEntityPropertiesInternal(engine, entityIDs, context->argument(ARGUMENT_EXTENDED_DESIRED_PROPERTIES));
-}
-
-QScriptValue EntityScriptingInterface::getMultipleEntityPropertiesInternal(QScriptEngine* engine, QVector<QUuid> entityIDs, const QScriptValue& extendedDesiredProperties) {
-    PROFILE_RANGE(script_entities, __FUNCTION__);
-
+// The properties a script asked for, which are the same for all of the entities of one call
+struct DesiredEntityProperties {
     EntityPsuedoPropertyFlags psuedoPropertyFlags;
+    EntityPropertyFlags desiredProperties;
+    bool needsScriptSemantics { false };
+};
+
+static DesiredEntityProperties readDesiredEntityProperties(const QScriptValue& extendedDesiredProperties) {
+    DesiredEntityProperties desired;
+    EntityPsuedoPropertyFlags& psuedoPropertyFlags = desired.psuedoPropertyFlags;
     const auto readExtendedPropertyStringValue = [&](QScriptValue extendedProperty) {
         const auto extendedPropertyString = extendedProperty.toString();
         if (extendedPropertyString == "id") {
@@ -716,22 +717,84 @@ QScriptValue EntityScriptingInterface::getMultipleEntityPropertiesInternal(QScri
         psuedoPropertyFlags.set(EntityPsuedoPropertyFlag::FlagsActive);
     }
 
-    EntityPropertyFlags desiredProperties = qscriptvalue_cast<EntityPropertyFlags>(extendedDesiredProperties);
-    bool needsScriptSemantics = desiredProperties.getHasProperty(PROP_POSITION) ||
+    EntityPropertyFlags& desiredProperties = desired.desiredProperties;
+    desiredProperties = qscriptvalue_cast<EntityPropertyFlags>(extendedDesiredProperties);
+    desired.needsScriptSemantics = desiredProperties.getHasProperty(PROP_POSITION) ||
         desiredProperties.getHasProperty(PROP_ROTATION) ||
         desiredProperties.getHasProperty(PROP_LOCAL_POSITION) ||
         desiredProperties.getHasProperty(PROP_LOCAL_ROTATION) ||
         desiredProperties.getHasProperty(PROP_LOCAL_VELOCITY) ||
         desiredProperties.getHasProperty(PROP_LOCAL_ANGULAR_VELOCITY) ||
         desiredProperties.getHasProperty(PROP_LOCAL_DIMENSIONS);
-    if (needsScriptSemantics) {
+    if (desired.needsScriptSemantics) {
         // if we are explicitly getting position or rotation, we need parent information to make sense of them.
         desiredProperties.setHasProperty(PROP_PARENT_ID);
         desiredProperties.setHasProperty(PROP_PARENT_JOINT_INDEX);
     }
+    return desired;
+}
+
+// NOTE: assumes caller has handled locking
+static void appendEntityPropertiesResult(const EntityItemPointer& entity, DesiredEntityProperties& desired,
+                                         QVector<EntityPropertiesResult>& resultProperties) {
+    if (desired.psuedoPropertyFlags.none() && desired.desiredProperties.isEmpty()) {
+        // these are left out of EntityItem::getEntityProperties so that localPosition and localRotation
+        // don't end up in json saves, etc.  We still want them here, though.
+        EncodeBitstreamParams params; // unknown
+        desired.desiredProperties = entity->getEntityProperties(params);
+        desired.desiredProperties.setHasProperty(PROP_LOCAL_POSITION);
+        desired.desiredProperties.setHasProperty(PROP_LOCAL_ROTATION);
+        desired.desiredProperties.setHasProperty(PROP_LOCAL_VELOCITY);
+        desired.desiredProperties.setHasProperty(PROP_LOCAL_ANGULAR_VELOCITY);
+        desired.desiredProperties.setHasProperty(PROP_LOCAL_DIMENSIONS);
+        desired.psuedoPropertyFlags.set();
+        desired.needsScriptSemantics = true;
+    }
+
+    auto properties = entity->getProperties(desired.desiredProperties, true);
+    EntityPropertiesResult result(properties, entity->getScalesWithParent());
+    resultProperties.append(result);
+}
+
+static QScriptValue entityPropertiesResultsToScriptValue(QScriptEngine* engine, const DesiredEntityProperties& desired,
+                                                         const QVector<EntityPropertiesResult>& resultProperties) {
+    QScriptValue finalResult = engine->newArray(resultProperties.size());
+    quint32 i = 0;
+    if (desired.needsScriptSemantics) {
+        PROFILE_RANGE(script_entities, "EntityScriptingInterface::getMultipleEntityProperties>Script Semantics");
+        foreach(const auto& result, resultProperties) {
+            finalResult.setProperty(i++, convertPropertiesToScriptSemantics(result.properties, result.scalesWithParent)
+                .copyToScriptValue(engine, false, false, false, desired.psuedoPropertyFlags));
+        }
+    } else {
+        PROFILE_RANGE(script_entities, "EntityScriptingInterface::getMultipleEntityProperties>Skip Script Semantics");
+        foreach(const auto& result, resultProperties) {
+            finalResult.setProperty(i++, result.properties.copyToScriptValue(engine, false, false, false,
+                                                                            desired.psuedoPropertyFlags));
+        }
+    }
+    return finalResult;
+}
+
+// Static method to make sure that we have the right script engine.
+// Using sender() or QtScriptable::engine() does not work for classes used by multiple threads (script-engines)
+QScriptValue EntityScriptingInterface::getMultipleEntityProperties(QScriptContext* context, QScriptEngine* engine) {
+    const int ARGUMENT_ENTITY_IDS = 0;
+    const int ARGUMENT_EXTENDED_DESIRED_PROPERTIES = 1;
+
+    auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    const auto entityIDs = qscriptvalue_cast<QVector<QUuid>>(context->argument(ARGUMENT_ENTITY_IDS));
+    return entityScriptingInterface->getMultipleEntityPropertiesInternal(engine, entityIDs, context->argument(ARGUMENT_EXTENDED_DESIRED_PROPERTIES));
+}
+
+QScriptValue EntityScriptingInterface::getMultipleEntityPropertiesInternal(QScriptEngine* engine, QVector<QUuid> entityIDs, const QScriptValue& extendedDesiredProperties) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    DesiredEntityProperties desired = readDesiredEntityProperties(extendedDesiredProperties);
     QVector<EntityPropertiesResult> resultProperties;
     if (_entityTree) {
         PROFILE_RANGE(script_entities, "EntityScriptingInterface::getMultipleEntityProperties>Obtaining Properties");
+        resultProperties.reserve(entityIDs.size());
         int i = 0;
         const int lockAmount = 500;
         int size = entityIDs.size();
@@ -741,43 +804,50 @@ QScriptValue EntityScriptingInterface::getMultipleEntityPropertiesInternal(QScri
                     const auto& entityID = entityIDs.at(i);
                     const EntityItemPointer entity = _entityTree->findEntityByEntityItemID(EntityItemID(entityID));
                     if (entity) {
-                        if (psuedoPropertyFlags.none() && desiredProperties.isEmpty()) {
-                            // these are left out of EntityItem::getEntityProperties so that localPosition and localRotation
-                            // don't end up in json saves, etc.  We still want them here, though.
-                            EncodeBitstreamParams params; // unknown
-                            desiredProperties = entity->getEntityProperties(params);
-                            desiredProperties.setHasProperty(PROP_LOCAL_POSITION);
-                            desiredProperties.setHasProperty(PROP_LOCAL_ROTATION);
-                            desiredProperties.setHasProperty(PROP_LOCAL_VELOCITY);
-                            desiredProperties.setHasProperty(PROP_LOCAL_ANGULAR_VELOCITY);
-                            desiredProperties.setHasProperty(PROP_LOCAL_DIMENSIONS);
-                            psuedoPropertyFlags.set();
-                            needsScriptSemantics = true;
-                        }
-
-                        auto properties = entity->getProperties(desiredProperties, true);
-                        EntityPropertiesResult result(properties, entity->getScalesWithParent());
-                        resultProperties.append(result);
+                        appendEntityPropertiesResult(entity, desired, resultProperties);
                     }
                 }
             });
         }
     }
-    QScriptValue finalResult = engine->newArray(resultProperties.size());
-    quint32 i = 0;
-    if (needsScriptSemantics) {
-        PROFILE_RANGE(script_entities, "EntityScriptingInterface::getMultipleEntityProperties>Script Semantics");
-        foreach(const auto& result, resultProperties) {
-            finalResult.setProperty(i++, convertPropertiesToScriptSemantics(result.properties, result.scalesWithParent)
-                .copyToScriptValue(engine, false, false, false, psuedoPropertyFlags));
-        }
-    } else {
-        PROFILE_RANGE(script_entities, "EntityScriptingInterface::getMultipleEntityProperties>Skip Script Semantics");
-        foreach(const auto& result, resultProperties) {
-            finalResult.setProperty(i++, result.properties.copyToScriptValue(engine, false, false, false, psuedoPropertyFlags));
-        }
+    return entityPropertiesResultsToScriptValue(engine, desired, resultProperties);
+}
+
+QScriptValue EntityScriptingInterface::findEntitiesWithProperties(QScriptContext* context, QScriptEngine* engine) {
+    const int ARGUMENT_CENTER = 0;
+    const int ARGUMENT_RADIUS = 1;
+    const int ARGUMENT_EXTENDED_DESIRED_PROPERTIES = 2;
+
+    auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    glm::vec3 center;
+    vec3FromScriptValue(context->argument(ARGUMENT_CENTER), center);
+    float radius = (float)context->argument(ARGUMENT_RADIUS).toNumber();
+    return entityScriptingInterface->findEntitiesWithPropertiesInternal(engine, center, radius,
+                                                                        context->argument(ARGUMENT_EXTENDED_DESIRED_PROPERTIES));
+}
+
+QScriptValue EntityScriptingInterface::findEntitiesWithPropertiesInternal(QScriptEngine* engine, const glm::vec3& center,
+                                                                          float radius, const QScriptValue& extendedDesiredProperties) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    DesiredEntityProperties desired = readDesiredEntityProperties(extendedDesiredProperties);
+    QVector<EntityPropertiesResult> resultProperties;
+    if (_entityTree) {
+        unsigned int searchFilter = PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES) | PickFilter::getBitMask(PickFilter::FlagBit::AVATAR_ENTITIES);
+        // the search and the properties of what it finds all come from the one read of the tree
+        _entityTree->withReadLock([&] {
+            QVector<QUuid> entityIDs;
+            _entityTree->evalEntitiesInSphere(center, radius, PickFilter(searchFilter), entityIDs);
+            resultProperties.reserve(entityIDs.size());
+            for (const auto& entityID : entityIDs) {
+                const EntityItemPointer entity = _entityTree->findEntityByEntityItemID(EntityItemID(entityID));
+                if (entity) {
+                    appendEntityPropertiesResult(entity, desired, resultProperties);
+                }
+            }
+        });
     }
-    return finalResult;
+    return entityPropertiesResultsToScriptValue(engine, desired, resultProperties);
 }
 
 QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProperties& scriptSideProperties) {
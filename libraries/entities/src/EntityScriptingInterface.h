@@ -179,6 +179,9 @@ public:
     void resetActivityTracking();
     ActivityTracking getActivityTracking() const { return _activityTracking; }
 
+    // whether any script listens to the collisions of all the entities, through the signal or per entity handlers
+    bool hasCollisionListeners() const;
+
     RayToEntityIntersectionResult evalRayIntersectionVector(const PickRay& ray, PickFilter searchFilter,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard);
     ParabolaToEntityIntersectionResult evalParabolaIntersectionVector(const PickParabola& parabola, PickFilter searchFilter,
@@ -203,6 +206,24 @@ public:
     static QScriptValue getMultipleEntityProperties(QScriptContext* context, QScriptEngine* engine);
     QScriptValue getMultipleEntityPropertiesInternal(QScriptEngine* engine, QVector<QUuid> entityIDs, const QScriptValue& extendedDesiredProperties);
 
+    /**jsdoc
+     * Finds all domain and avatar entities that intersect a sphere and gets their properties, in one go. This is quicker
+     * than calling {@link Entities.findEntities|findEntities} and then getting the properties of each entity found.
+     * @function Entities.findEntitiesWithProperties
+     * @param {Vec3} center - The point about which to search.
+     * @param {number} radius - The radius within which to search.
+     * @param {string[]|string} [desiredProperties=[]] - The name or names of the properties to get, as for
+     *     {@link Entities.getMultipleEntityProperties|getMultipleEntityProperties}.
+     * @returns {Entities.EntityProperties[]} The specified properties of each entity that intersects the search sphere. The
+     *     array is empty if no entities could be found.
+     * @example <caption>Report the names of the entities within 10m of your avatar.</caption>
+     * var propertySets = Entities.findEntitiesWithProperties(MyAvatar.position, 10, ["id", "name"]);
+     * print("Nearby entity names: " + JSON.stringify(propertySets));
+     */
+    static QScriptValue findEntitiesWithProperties(QScriptContext* context, QScriptEngine* engine);
+    QScriptValue findEntitiesWithPropertiesInternal(QScriptEngine* engine, const glm::vec3& center, float radius,
+                                                    const QScriptValue& extendedDesiredProperties);
+
     QUuid addEntityInternal(const EntityItemProperties& properties, entity::HostType entityHostType);
 
 public slots:
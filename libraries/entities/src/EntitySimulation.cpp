@@ -142,8 +142,8 @@ void EntitySimulation::sortEntitiesThatMoved() {
         }
     }
     if (moveOperator.hasMovingEntities()) {
-        PerformanceTimer perfTimer("recurseTreeWithOperator");
-        _entityTree->recurseTreeWithOperator(&moveOperator);
+        PerformanceTimer perfTimer("moveEntities");
+        moveOperator.moveEntities();
     }
 
     _entitiesToSort.clear();
@@ -0,0 +1,193 @@
+//
+//  EntitySpatialIndex.cpp
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndex.h"
+
+#include <algorithm>
+
+#include <OctreeConstants.h>
+
+// nodes stop being split once they are this small, about a quarter of a meter
+const int MAX_NODE_DEPTH = 17;
+const float MIN_NODE_SCALE = (float)TREE_SCALE / (float)(1 << MAX_NODE_DEPTH);
+
+EntitySpatialIndex::EntitySpatialIndex() :
+    _root(glm::vec3(-HALF_TREE_SCALE), (float)TREE_SCALE, nullptr)
+{
+}
+
+EntitySpatialIndex::Node* EntitySpatialIndex::findNodeFor(const Entry& entry, bool create) {
+    Node* node = &_root;
+    if (!entry.bounded) {
+        return node;
+    }
+
+    glm::vec3 center = entry.cube.calcCenter();
+    float scale = entry.cube.getScale();
+    while (true) {
+        float childScale = 0.5f * node->scale;
+        if (scale > childScale || childScale < MIN_NODE_SCALE) {
+            return node;
+        }
+
+        // entities centered outside of the world stay in the root
+        glm::vec3 offset = center - node->corner;
+        if (glm::any(glm::lessThan(offset, glm::vec3(0.0f))) || glm::any(glm::greaterThanEqual(offset, glm::vec3(node->scale)))) {
+            return node;
+        }
+
+        glm::ivec3 octant = glm::ivec3(glm::greaterThanEqual(offset, glm::vec3(childScale)));
+        int childIndex = octant.x | (octant.y << 1) | (octant.z << 2);
+        if (!node->children[childIndex]) {
+            if (!create) {
+                return nullptr;
+            }
+            node->children[childIndex].reset(new Node(node->corner + glm::vec3(octant) * childScale, childScale, node));
+            node->numChildren++;
+        }
+        node = node->children[childIndex].get();
+    }
+}
+
+void EntitySpatialIndex::removeEntry(Node* node, const EntityItem* entity) {
+    auto it = std::find_if(node->entries.begin(), node->entries.end(), [&](const Entry& entry) {
+        return entry.entity == entity;
+    });
+    if (it != node->entries.end()) {
+        *it = node->entries.back();
+        node->entries.pop_back();
+    }
+
+    // prune the branch that is left empty
+    while (node->parent && node->entries.empty() && node->numChildren == 0) {
+        Node* parent = node->parent;
+        for (auto& child : parent->children) {
+            if (child.get() == node) {
+                child.reset();
+                parent->numChildren--;
+                break;
+            }
+        }
+        node = parent;
+    }
+}
+
+void EntitySpatialIndex::update(const EntityItemPointer& entity) {
+    bool success;
+    AACube cube = entity->getQueryAACube(success);
+    Entry entry { entity.get(), cube, success && !cube.containsNaN() };
+
+    QWriteLocker locker(&_lock);
+    auto it = _nodes.find(entity.get());
+    if (it != _nodes.end()) {
+        Node* node = it->second;
+        if (findNodeFor(entry, false) == node) {
+            // most moves keep the entity in the same node
+            for (auto& nodeEntry : node->entries) {
+                if (nodeEntry.entity == entry.entity) {
+                    nodeEntry = entry;
+                    break;
+                }
+            }
+            return;
+        }
+        removeEntry(node, entity.get());
+    }
+
+    Node* node = findNodeFor(entry, true);
+    node->entries.push_back(entry);
+    _nodes[entity.get()] = node;
+}
+
+void EntitySpatialIndex::remove(const EntityItem* entity) {
+    QWriteLocker locker(&_lock);
+    auto it = _nodes.find(entity);
+    if (it != _nodes.end()) {
+        removeEntry(it->second, entity);
+        _nodes.erase(it);
+    }
+}
+
+void EntitySpatialIndex::clear() {
+    QWriteLocker locker(&_lock);
+    for (auto& child : _root.children) {
+        child.reset();
+    }
+    _root.numChildren = 0;
+    _root.entries.clear();
+    _nodes.clear();
+}
+
+size_t EntitySpatialIndex::size() const {
+    QReadLocker locker(&_lock);
+    return _nodes.size();
+}
+
+template <typename Test, typename Operator>
+void EntitySpatialIndex::forEachEntry(const Node* node, const Test& test, const Operator& entryOperator) const {
+    for (const auto& entry : node->entries) {
+        entryOperator(entry);
+    }
+    if (node->numChildren == 0) {
+        return;
+    }
+    for (const auto& child : node->children) {
+        if (child && test(child->getLooseBounds())) {
+            forEachEntry(child.get(), test, entryOperator);
+        }
+    }
+}
+
+void EntitySpatialIndex::findInBox(const AABox& box, std::vector<EntityItemPointer>& foundEntities) const {
+    QReadLocker locker(&_lock);
+    forEachEntry(&_root, [&](const AABox& bounds) {
+        return bounds.touches(box);
+    }, [&](const Entry& entry) {
+        if (!entry.bounded || entry.cube.touches(box)) {
+            foundEntities.push_back(entry.entity->getThisPointer());
+        }
+    });
+}
+
+void EntitySpatialIndex::findInSphere(const glm::vec3& center, float radius,
+                                      std::vector<EntityItemPointer>& foundEntities) const {
+    QReadLocker locker(&_lock);
+    forEachEntry(&_root, [&](const AABox& bounds) {
+        return bounds.touchesSphere(center, radius);
+    }, [&](const Entry& entry) {
+        if (!entry.bounded || entry.cube.touchesSphere(center, radius)) {
+            foundEntities.push_back(entry.entity->getThisPointer());
+        }
+    });
+}
+
+void EntitySpatialIndex::findOnRay(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
+                                   std::vector<RayCandidate>& foundEntities) const {
+    {
+        QReadLocker locker(&_lock);
+        float distance;
+        BoxFace face;
+        glm::vec3 surfaceNormal;
+        forEachEntry(&_root, [&](const AABox& bounds) {
+            return bounds.contains(origin) || bounds.findRayIntersection(origin, direction, invDirection, distance, face,
+                                                                         surfaceNormal);
+        }, [&](const Entry& entry) {
+            if (!entry.bounded || entry.cube.contains(origin)) {
+                foundEntities.push_back({ 0.0f, entry.entity->getThisPointer() });
+            } else if (entry.cube.findRayIntersection(origin, direction, invDirection, distance, face, surfaceNormal)) {
+                foundEntities.push_back({ distance, entry.entity->getThisPointer() });
+            }
+        });
+    }
+
+    std::sort(foundEntities.begin(), foundEntities.end(), [](const RayCandidate& a, const RayCandidate& b) {
+        return a.distance < b.distance;
+    });
+}
@@ -0,0 +1,90 @@
+//
+//  EntitySpatialIndex.h
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySpatialIndex_h
+#define hifi_EntitySpatialIndex_h
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QReadWriteLock>
+
+#include <AABox.h>
+#include <AACube.h>
+
+#include "EntityItem.h"
+
+// A loose octree of the entities in an EntityTree, used for its spatial queries. Unlike the EntityTree's own elements,
+// which an entity has to fit inside of, a node here holds every entity whose query cube is centered in it and is no
+// bigger than it, so its bounds are the node grown by half its size on every side. Large entities therefore only end up
+// near the root when they really are big, rather than whenever they straddle a boundary between elements.
+//
+// The index is kept in sync by EntityTreeElement as entities are added to and removed from elements, and by EntityItem
+// whenever its query cube changes. It has its own lock so that it can be updated from any thread.
+class EntitySpatialIndex {
+public:
+    class RayCandidate {
+    public:
+        float distance;
+        EntityItemPointer entity;
+    };
+
+    EntitySpatialIndex();
+
+    // adds the entity, or moves it if it is already in the index
+    void update(const EntityItemPointer& entity);
+    void remove(const EntityItem* entity);
+    void clear();
+
+    // finds the entities whose query cube touches the box or sphere
+    void findInBox(const AABox& box, std::vector<EntityItemPointer>& foundEntities) const;
+    void findInSphere(const glm::vec3& center, float radius, std::vector<EntityItemPointer>& foundEntities) const;
+
+    // finds the entities whose query cube the ray hits, sorted by the distance to that cube
+    void findOnRay(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
+                   std::vector<RayCandidate>& foundEntities) const;
+
+    size_t size() const;
+
+private:
+    class Entry {
+    public:
+        EntityItem* entity;
+        AACube cube;
+        bool bounded;
+    };
+
+    class Node {
+    public:
+        Node(const glm::vec3& corner, float scale, Node* parent) : corner(corner), scale(scale), parent(parent) {}
+
+        AABox getLooseBounds() const { return AABox(corner - glm::vec3(0.5f * scale), 2.0f * scale); }
+
+        glm::vec3 corner;
+        float scale;
+        Node* parent;
+        std::unique_ptr<Node> children[8];
+        int numChildren { 0 };
+        std::vector<Entry> entries;
+    };
+
+    Node* findNodeFor(const Entry& entry, bool create);
+    void removeEntry(Node* node, const EntityItem* entity);
+
+    template <typename Test, typename Operator>
+    void forEachEntry(const Node* node, const Test& test, const Operator& entryOperator) const;
+
+    mutable QReadWriteLock _lock;
+    Node _root;
+    std::unordered_map<const EntityItem*, Node*> _nodes;
+};
+
+#endif // hifi_EntitySpatialIndex_h
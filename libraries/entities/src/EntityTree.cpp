@@ -23,11 +23,13 @@
 #include <QJsonArray>
 
 #include <QtScript/QScriptEngine>
+#include <glm/gtx/norm.hpp>
 
 #include <Extents.h>
 #include <PerfStat.h>
 #include <Profile.h>
 #include <AddressManager.h>
+#include <OctreeEntitiesFileParser.h>
 
 #include "EntitySimulation.h"
 #include "VariantMapToScriptValue.h"
@@ -76,7 +78,7 @@ void EntityTree::createRootElement() {
 }
 
 OctreeElementPointer EntityTree::createNewElement(unsigned char* octalCode) {
-    auto newElement = EntityTreeElementPointer(new EntityTreeElement(octalCode));
+    auto newElement = EntityTreeElement::create(octalCode);
     newElement->setTree(std::static_pointer_cast<EntityTree>(shared_from_this()));
     return std::static_pointer_cast<OctreeElement>(newElement);
 }
@@ -151,6 +153,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
                 _staleProxies.push_back(spaceIndex);
             }
         }
+        _spatialIndex.clear();
     });
     localMap.clear();
     Octree::eraseAllOctreeElements(createNewRoot);
@@ -180,9 +183,8 @@ void EntityTree::readBitstreamToTree(const unsigned char* bitstream,
 
     // move entities
     if (_entityMover.hasMovingEntities()) {
-        PerformanceTimer perfTimer("recurseTreeWithOperator");
-        recurseTreeWithOperator(&_entityMover);
-        _entityMover.reset();
+        PerformanceTimer perfTimer("moveEntities");
+        _entityMover.moveEntities();
     }
 }
 
@@ -301,6 +303,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    recordChangeToPersist(entity->getEntityItemID());
 
     // find and hook up any entities with this entity as a (previously) missing parent
     fixupNeedsParentFixups();
@@ -367,6 +370,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                     emit editingEntityPointer(entity);
                 }
                 _isDirty = true;
+                recordChangeToPersist(entity->getEntityItemID());
             }
         }
     } else {
@@ -502,6 +506,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         }
 
         _isDirty = true;
+        recordChangeToPersist(entity->getEntityItemID());
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -751,6 +756,7 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
             // set up the deleted entities ID
             QWriteLocker recentlyDeletedEntitiesLocker(&_recentlyDeletedEntitiesLock);
             _recentlyDeletedEntityItemIDs.insert(deletedAt, theEntity->getEntityItemID());
+            recordChangeToPersist(theEntity->getEntityItemID(), true);
         } else {
             // on the client side, we also remember that we deleted this entity, we don't care about the time
             trackDeletedEntity(theEntity->getEntityItemID());
@@ -768,61 +774,6 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
     }
 }
 
-class RayArgs {
-public:
-    // Inputs
-    glm::vec3 origin;
-    glm::vec3 direction;
-    glm::vec3 invDirection;
-    const QVector<EntityItemID>& entityIdsToInclude;
-    const QVector<EntityItemID>& entityIdsToDiscard;
-    PickFilter searchFilter;
-
-    // Outputs
-    OctreeElementPointer& element;
-    float& distance;
-    BoxFace& face;
-    glm::vec3& surfaceNormal;
-    QVariantMap& extraInfo;
-    EntityItemID entityID;
-};
-
-bool evalRayIntersectionOp(const OctreeElementPointer& element, void* extraData) {
-    RayArgs* args = static_cast<RayArgs*>(extraData);
-    bool keepSearching = true;
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
-    EntityItemID entityID = entityTreeElementPointer->evalRayIntersection(args->origin, args->direction,
-        args->element, args->distance, args->face, args->surfaceNormal, args->entityIdsToInclude,
-        args->entityIdsToDiscard, args->searchFilter, args->extraInfo);
-    if (!entityID.isNull()) {
-        args->entityID = entityID;
-        // We recurse OctreeElements in order, so if we hit something, we can stop immediately
-        keepSearching = false;
-    }
-    return keepSearching;
-}
-
-float evalRayIntersectionSortingOp(const OctreeElementPointer& element, void* extraData) {
-    RayArgs* args = static_cast<RayArgs*>(extraData);
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
-    float distance = FLT_MAX;
-    // If origin is inside the cube, always check this element first
-    if (entityTreeElementPointer->getAACube().contains(args->origin)) {
-        distance = 0.0f;
-    } else {
-        float boundDistance = FLT_MAX;
-        BoxFace face;
-        glm::vec3 surfaceNormal;
-        if (entityTreeElementPointer->getAACube().findRayIntersection(args->origin, args->direction, args->invDirection, boundDistance, face, surfaceNormal)) {
-            // Don't add this cell if it's already farther than our best distance so far
-            if (boundDistance < args->distance) {
-                distance = boundDistance;
-            }
-        }
-    }
-    return distance;
-}
-
 EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
                                     QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
                                     PickFilter searchFilter, OctreeElementPointer& element, float& distance,
@@ -833,20 +784,32 @@ EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm:
     vec3 dirReciprocal = glm::vec3(direction.x == 0.0f ? 0.0f : 1.0f / direction.x,
                                    direction.y == 0.0f ? 0.0f : 1.0f / direction.y,
                                    direction.z == 0.0f ? 0.0f : 1.0f / direction.z);
-    RayArgs args = { origin, direction, dirReciprocal, entityIdsToInclude, entityIdsToDiscard,
-            searchFilter, element, distance, face, surfaceNormal, extraInfo, EntityItemID() };
+    EntityItemID entityID;
     distance = FLT_MAX;
 
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&]{
-        recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
+        std::vector<EntitySpatialIndex::RayCandidate> candidates;
+        _spatialIndex.findOnRay(origin, direction, dirReciprocal, candidates);
+        for (const auto& candidate : candidates) {
+            // the candidates are sorted by the distance to their query cube, so none of the rest can be any closer
+            if (candidate.distance > distance) {
+                break;
+            }
+            OctreeElementPointer entityElement = candidate.entity->getElement();
+            if (EntityTreeElement::evalEntityRayIntersection(candidate.entity, origin, direction, entityElement, distance,
+                    face, surfaceNormal, entityIdsToInclude, entityIdsToDiscard, searchFilter, extraInfo)) {
+                entityID = candidate.entity->getEntityItemID();
+                element = entityElement;
+            }
+        }
     }, requireLock);
 
     if (accurateResult) {
         *accurateResult = lockResult; // if user asked to accuracy or result, let them know this is accurate
     }
 
-    return args.entityID;
+    return entityID;
 }
 
 class ParabolaArgs {
@@ -932,219 +895,98 @@ EntityItemID EntityTree::evalParabolaIntersection(const PickParabola& parabola,
     return args.entityID;
 }
 
-class FindClosestEntityArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    PickFilter searchFilter;
-
-    // Outputs
-    QUuid closestEntity;
-    float closestEntityDistance;
-};
-
-
-bool evalClosestEntityOperation(const OctreeElementPointer& element, void* extraData) {
-    FindClosestEntityArgs* args = static_cast<FindClosestEntityArgs*>(extraData);
-    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-
-    glm::vec3 penetration;
-    bool sphereIntersection = entityTreeElement->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this entityTreeElement contains the point, then search it...
-    if (sphereIntersection) {
-        float closestDistanceSquared = FLT_MAX;
-        QUuid thisClosestEntity = entityTreeElement->evalClosetEntity(args->position, args->searchFilter, closestDistanceSquared);
-
-        // we may have gotten NULL back, meaning no entity was available
-        if (!thisClosestEntity.isNull()) {
-            float distanceFromPointToEntity = glm::sqrt(closestDistanceSquared);
-
-            // If we're within our target radius
-            if (distanceFromPointToEntity <= args->targetRadius) {
-                // we are closer than anything else we've found
-                if (distanceFromPointToEntity < args->closestEntityDistance) {
-                    args->closestEntity = thisClosestEntity;
-                    args->closestEntityDistance = distanceFromPointToEntity;
-                }
-            }
-        }
-
-        // we should be able to optimize this...
-        return true; // keep searching in case children have closer entities
-    }
-
-    // if this element doesn't contain the point, then none of its children can contain the point, so stop searching
-    return false;
-}
-
 // NOTE: assumes caller has handled locking
 QUuid EntityTree::evalClosestEntity(const glm::vec3& position, float targetRadius, PickFilter searchFilter) {
-    FindClosestEntityArgs args = { position, targetRadius, searchFilter, QUuid(), FLT_MAX };
-    recurseTreeWithOperation(evalClosestEntityOperation, &args);
-    return args.closestEntity;
-}
-
-class FindEntitiesInSphereArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    PickFilter searchFilter;
+    std::vector<EntityItemPointer> candidates;
+    _spatialIndex.findInSphere(position, targetRadius, candidates);
 
-    // Outputs
-    QVector<QUuid> entities;
-};
-
-bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInSphereArgs* args = static_cast<FindEntitiesInSphereArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphere(args->position, args->targetRadius, args->searchFilter, args->entities);
-        return true; // keep searching in case children have closer entities
+    QUuid closestEntity;
+    float targetRadiusSquared = targetRadius * targetRadius;
+    float closestDistanceSquared = FLT_MAX;
+    for (const auto& entity : candidates) {
+        if (!EntityTreeElement::checkFilterSettings(entity, searchFilter)) {
+            continue;
+        }
+        float distanceSquared = glm::distance2(position, entity->getWorldPosition());
+        if (distanceSquared <= targetRadiusSquared && distanceSquared < closestDistanceSquared) {
+            closestEntity = entity->getID();
+            closestDistanceSquared = distanceSquared;
+        }
     }
-
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
+    return closestEntity;
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereOperation, &args);
-    foundEntities.swap(args.entities);
-}
+    std::vector<EntityItemPointer> candidates;
+    _spatialIndex.findInSphere(center, radius, candidates);
 
-class FindEntitiesInSphereWithTypeArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    EntityTypes::EntityType type;
-    PickFilter searchFilter;
-
-    // Outputs
     QVector<QUuid> entities;
-};
-
-bool evalInSphereWithTypeOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInSphereWithTypeArgs* args = static_cast<FindEntitiesInSphereWithTypeArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphereWithType(args->position, args->targetRadius, args->type, args->searchFilter, args->entities);
-        return true; // keep searching in case children have closer entities
+    for (const auto& entity : candidates) {
+        if (EntityTreeElement::checkFilterSettings(entity, searchFilter) &&
+            EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+            entities.push_back(entity->getID());
+        }
     }
-
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereWithTypeArgs args = { center, radius, type, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
-    foundEntities.swap(args.entities);
-}
+    std::vector<EntityItemPointer> candidates;
+    _spatialIndex.findInSphere(center, radius, candidates);
 
-class FindEntitiesInSphereWithNameArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    QString name;
-    bool caseSensitive;
-    PickFilter searchFilter;
-
-    // Outputs
     QVector<QUuid> entities;
-};
-
-bool evalInSphereWithNameOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInSphereWithNameArgs* args = static_cast<FindEntitiesInSphereWithNameArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphereWithName(args->position, args->targetRadius, args->name, args->caseSensitive, args->searchFilter, args->entities);
-        return true; // keep searching in case children have closer entities
+    for (const auto& entity : candidates) {
+        if (type == entity->getType() && EntityTreeElement::checkFilterSettings(entity, searchFilter) &&
+            EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+            entities.push_back(entity->getID());
+        }
     }
-
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithName(const glm::vec3& center, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereWithNameArgs args = { center, radius, name, caseSensitive, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInCubeArgs {
-public:
-    // Inputs
-    AACube cube;
-    PickFilter searchFilter;
+    std::vector<EntityItemPointer> candidates;
+    _spatialIndex.findInSphere(center, radius, candidates);
 
-    // Outputs
+    QString lowerName = name.toLower();
     QVector<QUuid> entities;
-};
-
-bool findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInCubeArgs* args = static_cast<FindEntitiesInCubeArgs*>(extraData);
-    if (element->getAACube().touches(args->cube)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInCube(args->cube, args->searchFilter, args->entities);
-        return true;
+    for (const auto& entity : candidates) {
+        if (!EntityTreeElement::checkFilterSettings(entity, searchFilter)) {
+            continue;
+        }
+        QString entityName = entity->getName();
+        if ((caseSensitive && name != entityName) || (!caseSensitive && lowerName != entityName.toLower())) {
+            continue;
+        }
+        if (EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+            entities.push_back(entity->getID());
+        }
     }
-    return false;
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInCubeArgs args { cube, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(findInCubeOperation, &args);
-    foundEntities.swap(args.entities);
+    evalEntitiesInBox(AABox(cube), searchFilter, foundEntities);
 }
 
-class FindEntitiesInBoxArgs {
-public:
-    // Inputs
-    AABox box;
-    PickFilter searchFilter;
+// NOTE: assumes caller has handled locking
+void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    std::vector<EntityItemPointer> candidates;
+    _spatialIndex.findInBox(box, candidates);
 
-    // Outputs
     QVector<QUuid> entities;
-};
-
-bool findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInBoxArgs* args = static_cast<FindEntitiesInBoxArgs*>(extraData);
-    if (element->getAACube().touches(args->box)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInBox(args->box, args->searchFilter, args->entities);
-        return true;
+    for (const auto& entity : candidates) {
+        if (EntityTreeElement::checkFilterSettings(entity, searchFilter) &&
+            EntityTreeElement::entityTouchesBox(entity, box)) {
+            entities.push_back(entity->getID());
+        }
     }
-    return false;
-}
-
-// NOTE: assumes caller has handled locking
-void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
     // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
+    foundEntities.swap(entities);
 }
 
 class FindEntitiesInFrustumArgs {
@@ -1765,7 +1607,9 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     switch (message.getType()) {
         case PacketType::EntityErase: {
             QByteArray dataByteArray = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-            processedBytes = processEraseMessageDetails(dataByteArray, senderNode);
+            withWriteLock([&] {
+                processedBytes = processEraseMessageDetails(dataByteArray, senderNode);
+            });
             break;
         }
 
@@ -1913,6 +1757,18 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                 }
             }
 
+            // entities are added by the server that owns the region they're in, children go with their parents
+            if (isAdd && validEditPacket && _hasOwnedRegion && properties.getParentID().isNull() &&
+                !_ownedRegion.contains(properties.getPosition())) {
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID()
+                        << "] is attempting to add an entity outside of the region this server owns; add rejected...";
+                }
+                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+                validEditPacket = false;
+            }
+
             // If we got a valid edit packet, then it could be a new entity or it could be an update to
             // an existing entity... handle appropriately
             if (validEditPacket) {
@@ -1933,129 +1789,137 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                 }
                 endFilter = usecTimestampNow();
 
-                if (existingEntity && !isAdd) {
-
-                    if (suppressDisallowedClientScript) {
-                        bumpTimestamp(properties);
-                        properties.setScript(existingEntity->getScript());
+                // the edit is only applied under the lock, so that the send threads aren't held up by the decode and filter
+                withWriteLock([&] {
+                    if (existingEntity && !isAdd && findEntityByEntityItemID(entityItemID) != existingEntity) {
+                        // it was deleted while the edit was being filtered
+                        existingEntity.reset();
                     }
 
-                    if (suppressDisallowedServerScript) {
-                        bumpTimestamp(properties);
-                        properties.setServerScripts(existingEntity->getServerScripts());
-                    }
+                    if (existingEntity && !isAdd) {
 
-                    if (suppressDisallowedPrivateUserData) {
-                        bumpTimestamp(properties);
-                        properties.setPrivateUserData(existingEntity->getPrivateUserData());
-                    }
+                        if (suppressDisallowedClientScript) {
+                            bumpTimestamp(properties);
+                            properties.setScript(existingEntity->getScript());
+                        }
 
-                    // if the EntityItem exists, then update it
-                    startLogging = usecTimestampNow();
-                    if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
-                        qCDebug(entities) << "   properties:" << properties;
-                    }
-                    if (wantTerseEditLogging()) {
-                        QList<QString> changedProperties = properties.listChangedProperties();
-                        fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
-                    }
-                    endLogging = usecTimestampNow();
+                        if (suppressDisallowedServerScript) {
+                            bumpTimestamp(properties);
+                            properties.setServerScripts(existingEntity->getServerScripts());
+                        }
 
-                    startUpdate = usecTimestampNow();
-                    if (!isPhysics) {
-                        properties.setLastEditedBy(senderNode->getUUID());
-                    }
-                    updateEntity(existingEntity, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (isAdd) {
-                    bool failedAdd = !allowed;
-                    bool isCertified = !properties.getCertificateID().isEmpty();
-                    bool isCloneable = properties.getCloneable();
-                    int cloneLimit = properties.getCloneLimit();
-                    if (!allowed) {
-                        qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
-                    } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add an uncertified entity with ID:" << entityItemID;
-                    } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add a certified entity with ID:" << entityItemID;
-                    } else if (isClone && isCertified && !properties.getCertificateType().contains(DOMAIN_UNLIMITED)) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && !isCloneable) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
-                    } else {
-                        if (isClone) {
-                            properties.convertToCloneProperties(entityIDToClone);
+                        if (suppressDisallowedPrivateUserData) {
+                            bumpTimestamp(properties);
+                            properties.setPrivateUserData(existingEntity->getPrivateUserData());
                         }
 
-                        // this is a new entity... assign a new entityID
-                        properties.setLastEditedBy(senderNode->getUUID());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-
-                        if (newEntity && isCertified && getIsServer()) {
-                            if (!properties.verifyStaticCertificateProperties()) {
-                                qCDebug(entities) << "User" << senderNode->getUUID()
-                                    << "attempted to add a certified entity with ID" << entityItemID << "which failed"
-                                    << "static certificate verification.";
-                                // Delete the entity we just added if it doesn't pass static certificate verification
-                                deleteEntity(entityItemID, true);
-                            } else {
-                                validatePop(properties.getCertificateID(), entityItemID, senderNode);
-                            }
+                        // if the EntityItem exists, then update it
+                        startLogging = usecTimestampNow();
+                        if (wantEditLogging()) {
+                            qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                            qCDebug(entities) << "   properties:" << properties;
                         }
+                        if (wantTerseEditLogging()) {
+                            QList<QString> changedProperties = properties.listChangedProperties();
+                            fixupTerseEditLogging(properties, changedProperties);
+                            qCDebug(entities) << senderNode->getUUID() << "edit" <<
+                                existingEntity->getDebugName() << changedProperties;
+                        }
+                        endLogging = usecTimestampNow();
 
-                        if (newEntity && isClone) {
-                            entityToClone->addCloneID(newEntity->getEntityItemID());
-                            newEntity->setCloneOriginID(entityIDToClone);
+                        startUpdate = usecTimestampNow();
+                        if (!isPhysics) {
+                            properties.setLastEditedBy(senderNode->getUUID());
                         }
+                        updateEntity(existingEntity, properties, senderNode);
+                        existingEntity->markAsChangedOnServer();
+                        endUpdate = usecTimestampNow();
+                        _totalUpdates++;
+                    } else if (isAdd) {
+                        bool failedAdd = !allowed;
+                        bool isCertified = !properties.getCertificateID().isEmpty();
+                        bool isCloneable = properties.getCloneable();
+                        int cloneLimit = properties.getCloneLimit();
+                        if (!allowed) {
+                            qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
+                        } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
+                            failedAdd = true;
+                            qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
+                                << "] attempted to add an uncertified entity with ID:" << entityItemID;
+                        } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
+                            failedAdd = true;
+                            qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
+                                << "] attempted to add a certified entity with ID:" << entityItemID;
+                        } else if (isClone && isCertified && !properties.getCertificateType().contains(DOMAIN_UNLIMITED)) {
+                            failedAdd = true;
+                            qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
+                        } else if (isClone && !isCloneable) {
+                            failedAdd = true;
+                            qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
+                        } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
+                            failedAdd = true;
+                            qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
+                        } else {
+                            if (isClone) {
+                                properties.convertToCloneProperties(entityIDToClone);
+                            }
 
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-                            
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                  << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
+                            // this is a new entity... assign a new entityID
+                            properties.setLastEditedBy(senderNode->getUUID());
+                            startCreate = usecTimestampNow();
+                            EntityItemPointer newEntity = addEntity(entityItemID, properties);
+                            endCreate = usecTimestampNow();
+                            _totalCreates++;
+
+                            if (newEntity && isCertified && getIsServer()) {
+                                if (!properties.verifyStaticCertificateProperties()) {
+                                    qCDebug(entities) << "User" << senderNode->getUUID()
+                                        << "attempted to add a certified entity with ID" << entityItemID << "which failed"
+                                        << "static certificate verification.";
+                                    // Delete the entity we just added if it doesn't pass static certificate verification
+                                    deleteEntity(entityItemID, true);
+                                } else {
+                                    validatePop(properties.getCertificateID(), entityItemID, senderNode);
+                                }
                             }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
+
+                            if (newEntity && isClone) {
+                                entityToClone->addCloneID(newEntity->getEntityItemID());
+                                newEntity->setCloneOriginID(entityIDToClone);
                             }
-                            endLogging = usecTimestampNow();
 
-                        } else {
-                            failedAdd = true;
-                            qCDebug(entities) << "Add entity failed ID:" << entityItemID;
+                            if (newEntity) {
+                                newEntity->markAsChangedOnServer();
+                                notifyNewlyCreatedEntity(*newEntity, senderNode);
+                            
+                                startLogging = usecTimestampNow();
+                                if (wantEditLogging()) {
+                                    qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                                      << newEntity->getEntityItemID();
+                                    qCDebug(entities) << "   properties:" << properties;
+                                }
+                                if (wantTerseEditLogging()) {
+                                    QList<QString> changedProperties = properties.listChangedProperties();
+                                    fixupTerseEditLogging(properties, changedProperties);
+                                    qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
+                                }
+                                endLogging = usecTimestampNow();
+
+                            } else {
+                                failedAdd = true;
+                                qCDebug(entities) << "Add entity failed ID:" << entityItemID;
+                            }
                         }
+                        if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
+                            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+                        }
+                    } else {
+                        HIFI_FCDEBUG(entities(), "Edit failed. [" << message.getType() <<"] " <<
+                                "entity id:" << entityItemID << 
+                                "existingEntity pointer:" << existingEntity.get());
                     }
-                    if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
-                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    }
-                } else {
-                    HIFI_FCDEBUG(entities(), "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get());
-                }
+                });
             }
 
 
@@ -2205,8 +2069,8 @@ void EntityTree::fixupNeedsParentFixups() {
     }
 
     if (moveOperator.hasMovingEntities()) {
-        PerformanceTimer perfTimer("recurseTreeWithOperator");
-        recurseTreeWithOperator(&moveOperator);
+        PerformanceTimer perfTimer("moveEntities");
+        moveOperator.moveEntities();
     }
 
     {
@@ -2630,8 +2494,8 @@ QVector<EntityItemID> EntityTree::sendEntities(EntityEditPacketSender* packetSen
         }
     }
     if (moveOperator.hasMovingEntities()) {
-        PerformanceTimer perfTimer("recurseTreeWithOperator");
-        localTree->recurseTreeWithOperator(&moveOperator);
+        PerformanceTimer perfTimer("moveEntities");
+        moveOperator.moveEntities();
     }
 
     if (!_serverlessDomain) {
@@ -2861,10 +2725,7 @@ void convertGrabUserDataToProperties(EntityItemProperties& properties) {
 }
 
 
-bool EntityTree::readFromMap(QVariantMap& map) {
-    // These are needed to deal with older content (before adding inheritance modes)
-    int contentVersion = map["Version"].toInt();
-
+int EntityTree::readPersistHeaderFromMap(const QVariantMap& map) {
     if (map.contains("Id")) {
         _persistID = map["Id"].toUuid();
     }
@@ -2883,6 +2744,161 @@ bool EntityTree::readFromMap(QVariantMap& map) {
         }
     }
 
+    // These are needed to deal with older content (before adding inheritance modes)
+    return map["Version"].toInt();
+}
+
+EntityItemPointer EntityTree::addEntityFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine) {
+    // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
+
+    // handle parentJointName for wearables
+    if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
+        QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+
+        entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+
+        qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
+            " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+    }
+
+    QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+    EntityItemProperties properties;
+    EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+    EntityItemID entityItemID;
+    if (entityMap.contains("id")) {
+        entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        entityItemID = EntityItemID(QUuid::createUuid());
+    }
+
+    // Convert old clientOnly bool to new entityHostType enum
+    // (must happen before setOwningAvatarID below)
+    if (contentVersion < (int)EntityVersion::EntityHostTypes) {
+        if (entityMap.contains("clientOnly")) {
+            properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        }
+    }
+
+    if (properties.getEntityHostType() == entity::HostType::AVATAR) {
+        auto nodeList = DependencyManager::get<NodeList>();
+        const QUuid myNodeID = nodeList->getSessionUUID();
+        properties.setOwningAvatarID(myNodeID);
+    }
+
+    // Fix for older content not containing mode fields in the zones
+    if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
+        // The legacy version had no keylight mode - this is set to on
+        properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+
+        // The ambient URL has been moved from "keyLight" to "ambientLight"
+        if (entityMap.contains("keyLight")) {
+            QVariantMap keyLightObject = entityMap["keyLight"].toMap();
+            properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
+        }
+
+        // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
+        // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
+        properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
+        if (properties.getAmbientLight().getAmbientURL() == "") {
+            if (properties.getSkybox().getURL() != "") {
+                properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
+            } else {
+                properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
+            }
+        }
+
+        // The background should be enabled if the mode is skybox
+        // Note that if the values are default then they are not stored in the JSON file
+        if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
+            properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
+        } else {
+            properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+        }
+    }
+
+    // Convert old materials so that they use materialData instead of userData
+    if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
+        if (properties.getMaterialURL().startsWith("userData")) {
+            QString materialURL = properties.getMaterialURL();
+            properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+
+            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+            QJsonObject materialData;
+            QJsonValue materialVersion = userData["materialVersion"];
+            if (!materialVersion.isNull()) {
+                materialData.insert("materialVersion", materialVersion);
+                userData.remove("materialVersion");
+            }
+            QJsonValue materials = userData["materials"];
+            if (!materials.isNull()) {
+                materialData.insert("materials", materials);
+                userData.remove("materials");
+            }
+
+            properties.setMaterialData(QJsonDocument(materialData).toJson());
+            properties.setUserData(QJsonDocument(userData).toJson());
+        }
+    }
+
+    // Convert old cloneable entities so they use cloneableData instead of userData
+    if (contentVersion < (int)EntityVersion::CloneableData) {
+        QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+        QJsonObject grabbableKey = userData["grabbableKey"].toObject();
+        QJsonValue cloneable = grabbableKey["cloneable"];
+        if (cloneable.isBool() && cloneable.toBool()) {
+            QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
+            QJsonValue cloneLimit = grabbableKey["cloneLimit"];
+            QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
+            QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+
+            // This is cloneable, we need to convert the properties
+            properties.setCloneable(true);
+            properties.setCloneLifetime(cloneLifetime.toInt());
+            properties.setCloneLimit(cloneLimit.toInt());
+            properties.setCloneDynamic(cloneDynamic.toBool());
+            properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+        }
+    }
+
+    // convert old grab-related userData to new grab properties
+    if (contentVersion < (int)EntityVersion::GrabProperties) {
+        convertGrabUserDataToProperties(properties);
+    }
+
+    // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
+    if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
+        properties.setRadiusSpread(0.0f);
+        properties.setAlphaSpread(0.0f);
+        properties.setColorSpread({0, 0, 0});
+    }
+
+    if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
+        if (entityMap.contains("created")) {
+            quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
+            properties.setCreated(created);
+        }
+    }
+
+    EntityItemPointer entity = addEntity(entityItemID, properties);
+    if (!entity) {
+        qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+    }
+    return entity;
+}
+
+void EntityTree::setCloneIDsFromMap(const QMap<QUuid, QVector<QUuid>>& cloneIDs) {
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
+        }
+    }
+}
+
+bool EntityTree::readFromMap(QVariantMap& map) {
+    int contentVersion = readPersistHeaderFromMap(map);
+
     // map will have a top-level list keyed as "Entities".  This will be extracted
     // and iterated over.  Each member of this list is converted to a QVariantMap, then
     // to a QScriptValue, and then to EntityItemProperties.  These properties are used
@@ -2899,151 +2915,171 @@ bool EntityTree::readFromMap(QVariantMap& map) {
 
     bool success = true;
     foreach (QVariant entityVariant, entitiesQList) {
-        // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
         QVariantMap entityMap = entityVariant.toMap();
+        EntityItemPointer entity = addEntityFromMap(entityMap, contentVersion, scriptEngine);
+        if (!entity) {
+            success = false;
+            continue;
+        }
 
-        // handle parentJointName for wearables
-        if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
-            QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
-
-            entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
-
-            qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
-                " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
         }
+    }
 
-        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
-        EntityItemProperties properties;
-        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+    setCloneIDsFromMap(cloneIDs);
+    return success;
+}
 
-        EntityItemID entityItemID;
-        if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
-        } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
+bool EntityTree::readFromJSONParser(OctreeEntitiesFileParser& parser, const QString& marketplaceID) {
+    // the entities are added as they are parsed, so only one of them is ever held as a QVariantMap. Parents that
+    // come after their children in the file are found by the usual missing parent fixup.
+    QVariantMap map;
+    QScriptEngine scriptEngine;
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    QSet<EntityItemID> addedEntityIDs;
+    int contentVersion = 0;
+    bool gotHeader = false;
+
+    bool success = true;
+    bool parsed = parser.parseEntities(map, [&](QJsonObject& entityObject) {
+        if (!gotHeader) {
+            // the parser has read all the other top-level entries by the time it gets to the first entity
+            contentVersion = readPersistHeaderFromMap(map);
+            gotHeader = true;
         }
 
-        // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
-        if (contentVersion < (int)EntityVersion::EntityHostTypes) {
-            if (entityMap.contains("clientOnly")) {
-                properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
-            }
+        QVariantMap entityMap = entityObject.toVariantMap();
+        if (!marketplaceID.isEmpty()) {
+            entityMap["marketplaceID"] = marketplaceID;
         }
 
-        if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
+        EntityItemPointer entity = addEntityFromMap(entityMap, contentVersion, scriptEngine);
+        if (!entity) {
+            success = false;
+            return true;
         }
+        addedEntityIDs.insert(entity->getEntityItemID());
 
-        // Fix for older content not containing mode fields in the zones
-        if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
-            // The legacy version had no keylight mode - this is set to on
-            properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+        }
+        return true;
+    });
 
-            // The ambient URL has been moved from "keyLight" to "ambientLight"
-            if (entityMap.contains("keyLight")) {
-                QVariantMap keyLightObject = entityMap["keyLight"].toMap();
-                properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
-            }
+    if (!parsed) {
+        // don't leave half of a broken file behind
+        qCritical() << "Couldn't parse Entities JSON:" << parser.getErrorString().c_str();
+        deleteEntities(addedEntityIDs, true, true);
+        return false;
+    }
 
-            // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
-            // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
-            properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
-            if (properties.getAmbientLight().getAmbientURL() == "") {
-                if (properties.getSkybox().getURL() != "") {
-                    properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
-                } else {
-                    properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
-                }
-            }
+    if (!gotHeader) {
+        // Empty map or invalidly formed file.
+        readPersistHeaderFromMap(map);
+        return false;
+    }
 
-            // The background should be enabled if the mode is skybox
-            // Note that if the values are default then they are not stored in the JSON file
-            if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
-                properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
-            } else {
-                properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
-            }
-        }
+    setCloneIDsFromMap(cloneIDs);
+    return success;
+}
 
-        // Convert old materials so that they use materialData instead of userData
-        if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
-            if (properties.getMaterialURL().startsWith("userData")) {
-                QString materialURL = properties.getMaterialURL();
-                properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
+    QScriptEngine scriptEngine;
+    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
+    withReadLock([&] {
+        recurseTreeWithOperator(&theOperator);
+    });
 
-                QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-                QJsonObject materialData;
-                QJsonValue materialVersion = userData["materialVersion"];
-                if (!materialVersion.isNull()) {
-                    materialData.insert("materialVersion", materialVersion);
-                    userData.remove("materialVersion");
-                }
-                QJsonValue materials = userData["materials"];
-                if (!materials.isNull()) {
-                    materialData.insert("materials", materials);
-                    userData.remove("materials");
-                }
+    jsonString = theOperator.getJson();
+    return true;
+}
 
-                properties.setMaterialData(QJsonDocument(materialData).toJson());
-                properties.setUserData(QJsonDocument(userData).toJson());
-            }
-        }
+// no single property can be bigger than 64KB in the wire encoding, so an entity that doesn't fit in this is broken
+static const unsigned int MAX_BINARY_ENTITY_SIZE = 16 * 1024 * 1024;
 
-        // Convert old cloneable entities so they use cloneableData instead of userData
-        if (contentVersion < (int)EntityVersion::CloneableData) {
-            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-            QJsonObject grabbableKey = userData["grabbableKey"].toObject();
-            QJsonValue cloneable = grabbableKey["cloneable"];
-            if (cloneable.isBool() && cloneable.toBool()) {
-                QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
-                QJsonValue cloneLimit = grabbableKey["cloneLimit"];
-                QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
-                QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+// journal records start with what they record, followed by the entity's wire encoding or, for deletes, its ID
+enum JournalRecordType : quint8 {
+    JOURNAL_ENTITY_CHANGED = 0,
+    JOURNAL_ENTITY_DELETED
+};
 
-                // This is cloneable, we need to convert the properties
-                properties.setCloneable(true);
-                properties.setCloneLifetime(cloneLifetime.toInt());
-                properties.setCloneLimit(cloneLimit.toInt());
-                properties.setCloneDynamic(cloneDynamic.toBool());
-                properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
-            }
+// the record keeps everything the server knows about the entity, private user data included
+static bool encodeEntityToPersist(const EntityItemPointer& entity, OctreePacketData& packetData,
+                                  const QByteArray& prefix = QByteArray()) {
+    EncodeBitstreamParams params;
+    while (true) {
+        packetData.reset();
+        packetData.appendRawData(prefix);
+        if (entity->appendEntityData(&packetData, params, nullptr, true) == OctreeElement::COMPLETED) {
+            return true;
         }
 
-        // convert old grab-related userData to new grab properties
-        if (contentVersion < (int)EntityVersion::GrabProperties) {
-            convertGrabUserDataToProperties(properties);
+        if (packetData.getTargetSize() >= MAX_BINARY_ENTITY_SIZE) {
+            qCWarning(entities) << "Entity" << entity->getEntityItemID() << "is too big to persist";
+            return false;
         }
+        packetData.changeSettings(false, packetData.getTargetSize() * 2);
+    }
+}
 
-        // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
-        if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
-            properties.setRadiusSpread(0.0f);
-            properties.setAlphaSpread(0.0f);
-            properties.setColorSpread({0, 0, 0});
-        }
+bool EntityTree::writeToBinary(OctreeBinaryFile::Writer& writer, const OctreeElementPointer& element) {
+    OctreePacketData packetData(false, MAX_OCTREE_UNCOMRESSED_PACKET_SIZE);
+    bool success = true;
 
-        if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
-            if (entityMap.contains("created")) {
-                quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
-                properties.setCreated(created);
-            }
-        }
+    withReadLock([&] {
+        recurseElementWithOperation(element, [&](const OctreeElementPointer& element, void* extraData) {
+            EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+            entityTreeElement->forEachEntity([&](const EntityItemPointer& entity) {
+                success = success && encodeEntityToPersist(entity, packetData) &&
+                    writer.appendRecord(packetData.getUncompressedData(), packetData.getUncompressedSize());
+            });
+            return success;
+        }, nullptr);
+    });
 
-        EntityItemPointer entity = addEntity(entityItemID, properties);
+    return success;
+}
+
+EntityItemPointer EntityTree::addEntityFromBinary(const unsigned char* data, int size, ReadBitstreamToTreeParams& args) {
+    // entities are read straight from their wire encoding and added the way entities received from a server are
+    EntityItemPointer entity = EntityTypes::constructEntityItem(data, size);
+    if (!entity || entity->readEntityDataFromBuffer(data, size, args) == 0) {
+        qCDebug(entities) << "reading Entity from binary file failed";
+        return nullptr;
+    }
+
+    if (getContainingElement(entity->getEntityItemID())) {
+        qCWarning(entities) << "Entity" << entity->getEntityItemID() << "appears more than once in binary file";
+        return nullptr;
+    }
+
+    AddEntityOperator theOperator(getThisPointer(), entity);
+    recurseTreeWithOperator(&theOperator);
+    postAddEntity(entity);
+    return entity;
+}
+
+bool EntityTree::readFromBinary(OctreeBinaryFile::Reader& reader) {
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    ReadBitstreamToTreeParams args;
+    bool success = true;
+
+    bool isFileIntact = reader.forEachRecord([&](const unsigned char* data, int size) {
+        EntityItemPointer entity = addEntityFromBinary(data, size, args);
         if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
             success = false;
+            return true;
         }
 
-        if (entity) {
-            const QUuid& cloneOriginID = entity->getCloneOriginID();
-            if (!cloneOriginID.isNull()) {
-                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
-            }
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
         }
-    }
+        return true;
+    });
 
     for (const auto& entityID : cloneIDs.keys()) {
         auto entity = findEntityByID(entityID);
@@ -3052,18 +3088,120 @@ bool EntityTree::readFromMap(QVariantMap& map) {
         }
     }
 
-    return success;
+    return isFileIntact && success;
 }
 
-bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
-    QScriptEngine scriptEngine;
-    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
+void EntityTree::setTrackChangesToPersist(bool trackChanges) {
+    QWriteLocker locker(&_changesToPersistLock);
+    _isTrackingChangesToPersist = trackChanges;
+    _changedEntitiesToPersist.clear();
+    _deletedEntitiesToPersist.clear();
+}
+
+void EntityTree::clearChangesToPersist() {
+    QWriteLocker locker(&_changesToPersistLock);
+    _changedEntitiesToPersist.clear();
+    _deletedEntitiesToPersist.clear();
+}
+
+void EntityTree::recordChangeToPersist(const EntityItemID& entityID, bool isDeleted) {
+    QWriteLocker locker(&_changesToPersistLock);
+    if (!_isTrackingChangesToPersist) {
+        return;
+    }
+
+    if (isDeleted) {
+        _changedEntitiesToPersist.remove(entityID);
+        _deletedEntitiesToPersist.insert(entityID);
+    } else {
+        _deletedEntitiesToPersist.remove(entityID);
+        _changedEntitiesToPersist.insert(entityID);
+    }
+}
+
+bool EntityTree::writeChangesToBinary(OctreeBinaryFile::Writer& writer) {
+    // on failure the caller saves a full snapshot instead, so the changes taken here needn't be put back
+    QSet<EntityItemID> changedEntities;
+    QSet<EntityItemID> deletedEntities;
+    bool success = true;
+
     withReadLock([&] {
-        recurseTreeWithOperator(&theOperator);
+        {
+            QWriteLocker locker(&_changesToPersistLock);
+            changedEntities.swap(_changedEntitiesToPersist);
+            deletedEntities.swap(_deletedEntitiesToPersist);
+        }
+
+        QByteArray record;
+        for (const auto& entityID : deletedEntities) {
+            record = QByteArray(1, (char)JOURNAL_ENTITY_DELETED) + entityID.toRfc4122();
+            success = success && writer.appendRecord((const unsigned char*)record.constData(), record.size());
+        }
+
+        static const QByteArray CHANGED_PREFIX(1, (char)JOURNAL_ENTITY_CHANGED);
+        OctreePacketData packetData(false, MAX_OCTREE_UNCOMRESSED_PACKET_SIZE);
+        for (const auto& entityID : changedEntities) {
+            EntityItemPointer entity = findEntityByEntityItemID(entityID);
+            if (entity) {
+                success = success && encodeEntityToPersist(entity, packetData, CHANGED_PREFIX) &&
+                    writer.appendRecord(packetData.getUncompressedData(), packetData.getUncompressedSize());
+            }
+        }
     });
 
-    jsonString = theOperator.getJson();
-    return true;
+    return success;
+}
+
+bool EntityTree::readChangesFromBinary(OctreeBinaryFile::Reader& reader) {
+    ReadBitstreamToTreeParams args;
+
+    bool success = reader.forEachRecord([&](const unsigned char* data, int size) {
+        if (size < 1 + NUM_BYTES_RFC4122_UUID) {
+            qCWarning(entities) << "Malformed journal record";
+            return false;
+        }
+        JournalRecordType recordType = (JournalRecordType)data[0];
+        data++;
+        size--;
+        EntityItemID entityID(QUuid::fromRfc4122(QByteArray::fromRawData((const char*)data, NUM_BYTES_RFC4122_UUID)));
+
+        if (recordType == JOURNAL_ENTITY_DELETED) {
+            deleteEntity(entityID, true, true);
+            return true;
+        } else if (recordType != JOURNAL_ENTITY_CHANGED) {
+            qCWarning(entities) << "Unknown journal record type" << (int)recordType;
+            return false;
+        }
+
+        // like entity data from a server, the record carries every property and is newer than what's in the tree
+        EntityItemPointer entity = findEntityByEntityItemID(entityID);
+        if (!entity) {
+            entity = addEntityFromBinary(data, size, args);
+            if (entity && !entity->getCloneOriginID().isNull()) {
+                auto cloneOrigin = findEntityByID(entity->getCloneOriginID());
+                if (cloneOrigin) {
+                    cloneOrigin->addCloneID(entityID);
+                }
+            }
+            return true;
+        }
+
+        QUuid parentIDBefore = entity->getParentID();
+        entity->readEntityDataFromBuffer(data, size, args);
+        if (entity->getDirtyFlags()) {
+            entityChanged(entity);
+        }
+        _entityMover.addEntityToMoveList(entity, entity->getQueryAACube());
+        if (parentIDBefore != entity->getParentID()) {
+            addToNeedsParentFixupList(entity);
+        }
+        return true;
+    });
+
+    if (_entityMover.hasMovingEntities()) {
+        _entityMover.moveEntities();
+    }
+    return success;
 }
 
 void EntityTree::resetClientEditStats() {
@@ -3203,7 +3341,7 @@ void EntityTree::updateEntityQueryAACube(SpatiallyNestablePointer object, Entity
     updateEntityQueryAACubeWorker(object, packetSender, moveOperator, force, tellServer);
 
     if (moveOperator.hasMovingEntities()) {
-        PerformanceTimer perfTimer("recurseTreeWithOperator");
-        recurseTreeWithOperator(&moveOperator);
+        PerformanceTimer perfTimer("moveEntities");
+        moveOperator.moveEntities();
     }
 }
@@ -21,12 +21,14 @@
 #include "AddEntityOperator.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
+#include "EntitySpatialIndex.h"
 #include "MovingEntitiesOperator.h"
 
 class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
 
 class EntitySimulation;
+class QScriptEngine;
 
 namespace EntityQueryFilterSymbol {
     static const QString NonDefault = "+";
@@ -61,6 +63,11 @@ public:
 
 
     void setEntityMaxTmpLifetime(float maxTmpEntityLifetime) { _maxTmpEntityLifetime = maxTmpEntityLifetime; }
+
+    // the part of the domain this tree's server owns, new entities outside of it are rejected
+    void setOwnedRegion(const AABox& ownedRegion) { _ownedRegion = ownedRegion; _hasOwnedRegion = true; }
+    bool hasOwnedRegion() const { return _hasOwnedRegion; }
+    const AABox& getOwnedRegion() const { return _ownedRegion; }
     void setEntityScriptSourceWhitelist(const QString& entityScriptSourceWhitelist);
 
     /// Implements our type specific root element factory
@@ -89,6 +96,7 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual bool locksForEditPackets() const override { return true; }
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
@@ -142,6 +150,8 @@ public:
     void evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities);
     void evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities);
 
+    EntitySpatialIndex& getSpatialIndex() { return _spatialIndex; }
+
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
@@ -194,7 +204,14 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
+    virtual bool readFromJSONParser(OctreeEntitiesFileParser& parser, const QString& marketplaceID) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
+    virtual bool writeToBinary(OctreeBinaryFile::Writer& writer, const OctreeElementPointer& element) override;
+    virtual bool readFromBinary(OctreeBinaryFile::Reader& reader) override;
+    virtual void setTrackChangesToPersist(bool trackChanges) override;
+    virtual void clearChangesToPersist() override;
+    virtual bool writeChangesToBinary(OctreeBinaryFile::Writer& writer) override;
+    virtual bool readChangesFromBinary(OctreeBinaryFile::Reader& reader) override;
 
 
     glm::vec3 getContentsDimensions();
@@ -326,6 +343,9 @@ protected:
     mutable QReadWriteLock _entityMapLock;
     QHash<EntityItemID, EntityItemPointer> _entityMap;
 
+    // the entities that are in the tree, by their query cube
+    EntitySpatialIndex _spatialIndex;
+
     mutable QReadWriteLock _entityCertificateIDMapLock;
     QHash<QString, QList<EntityItemID>> _entityCertificateIDMap;
 
@@ -366,6 +386,8 @@ protected:
     QHash<QUuid, QSet<EntityItemID>> _childrenOfAvatars;  // which entities are children of which avatars
 
     float _maxTmpEntityLifetime { DEFAULT_MAX_TMP_ENTITY_LIFETIME };
+    bool _hasOwnedRegion { false };
+    AABox _ownedRegion;
 
     bool filterProperties(EntityItemPointer& existingEntity, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, FilterType filterType);
     bool _hasEntityEditFilter{ false };
@@ -397,6 +419,20 @@ private:
 
     std::map<QString, QString> _namedPaths;
 
+    // returns the persist file's content version
+    int readPersistHeaderFromMap(const QVariantMap& map);
+    EntityItemPointer addEntityFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine);
+    void setCloneIDsFromMap(const QMap<QUuid, QVector<QUuid>>& cloneIDs);
+
+    EntityItemPointer addEntityFromBinary(const unsigned char* data, int size, ReadBitstreamToTreeParams& args);
+    void recordChangeToPersist(const EntityItemID& entityID, bool isDeleted = false);
+
+    // server side changes since the persist thread last journaled them
+    mutable QReadWriteLock _changesToPersistLock;
+    bool _isTrackingChangesToPersist { false };
+    QSet<EntityItemID> _changedEntitiesToPersist;
+    QSet<EntityItemID> _deletedEntitiesToPersist;
+
     void updateEntityQueryAACubeWorker(SpatiallyNestablePointer object, EntityEditPacketSender* packetSender,
                                        MovingEntitiesOperator& moveOperator, bool force, bool tellServer);
 };
@@ -16,6 +16,7 @@
 #include <GeometryUtil.h>
 #include <OctreeUtils.h>
 #include <Extents.h>
+#include <PoolAllocator.h>
 
 #include "EntitiesLogging.h"
 #include "EntityNodeData.h"
@@ -31,8 +32,17 @@ EntityTreeElement::~EntityTreeElement() {
     _octreeMemoryUsage -= sizeof(EntityTreeElement);
 }
 
+EntityTreeElementPointer EntityTreeElement::create(unsigned char* octalCode) {
+    using ElementPool = FixedBlockPool<sizeof(EntityTreeElement), alignof(EntityTreeElement)>;
+    auto element = new (ElementPool::getInstance().allocate()) EntityTreeElement(octalCode);
+    return EntityTreeElementPointer(element, [](EntityTreeElement* element) {
+        element->~EntityTreeElement();
+        ElementPool::getInstance().deallocate(element);
+    }, PoolAllocator<EntityTreeElement>());
+}
+
 OctreeElementPointer EntityTreeElement::createNewElement(unsigned char* octalCode) {
-    auto newChild = EntityTreeElementPointer(new EntityTreeElement(octalCode));
+    auto newChild = create(octalCode);
     newChild->setTree(_myTree);
     return newChild;
 }
@@ -189,84 +199,96 @@ EntityItemID EntityTreeElement::evalRayIntersection(const glm::vec3& origin, con
     return result;
 }
 
-EntityItemID EntityTreeElement::evalDetailedRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
-                                    OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
-                                    const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIDsToDiscard,
-                                    PickFilter searchFilter, QVariantMap& extraInfo) {
-
-    // only called if we do intersect our bounding cube, but find if we actually intersect with entities...
-    EntityItemID entityID;
-    forEachEntity([&](EntityItemPointer entity) {
-        if (entity->getIgnorePickIntersection()) {
-            return;
-        }
+bool EntityTreeElement::evalEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+                                    const glm::vec3& direction, OctreeElementPointer& element, float& distance, BoxFace& face,
+                                    glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
+                                    const QVector<EntityItemID>& entityIDsToDiscard, PickFilter searchFilter,
+                                    QVariantMap& extraInfo) {
+    if (entity->getIgnorePickIntersection()) {
+        return false;
+    }
 
-        // use simple line-sphere for broadphase check
-        // (this is faster and more likely to cull results than the filter check below so we do it first)
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        if (!success) {
-            return;
-        }
-        if (!entityBox.rayHitsBoundingSphere(origin, direction)) {
-            return;
-        }
+    // use simple line-sphere for broadphase check
+    // (this is faster and more likely to cull results than the filter check below so we do it first)
+    bool success;
+    AABox entityBox = entity->getAABox(success);
+    if (!success) {
+        return false;
+    }
+    if (!entityBox.rayHitsBoundingSphere(origin, direction)) {
+        return false;
+    }
 
-        if (!checkFilterSettings(entity, searchFilter) ||
-            (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
-            (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())) ) {
-            return;
-        }
+    if (!checkFilterSettings(entity, searchFilter) ||
+        (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
+        (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())) ) {
+        return false;
+    }
 
-        // extents is the entity relative, scaled, centered extents of the entity
-        glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-        glm::mat4 translation = glm::translate(entity->getWorldPosition());
-        glm::mat4 entityToWorldMatrix = translation * rotation;
-        glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+    // extents is the entity relative, scaled, centered extents of the entity
+    glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
+    glm::mat4 translation = glm::translate(entity->getWorldPosition());
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
 
-        glm::vec3 dimensions = entity->getRaycastDimensions();
-        glm::vec3 registrationPoint = entity->getRegistrationPoint();
-        glm::vec3 corner = -(dimensions * registrationPoint);
+    glm::vec3 dimensions = entity->getRaycastDimensions();
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint);
 
-        AABox entityFrameBox(corner, dimensions);
+    AABox entityFrameBox(corner, dimensions);
 
-        glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
-        glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
+    glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
+    glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
 
-        // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
-        // and testing intersection there.
-        float localDistance;
-        BoxFace localFace { UNKNOWN_FACE };
-        glm::vec3 localSurfaceNormal;
-        if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, 1.0f / entityFrameDirection, localDistance,
-                                                localFace, localSurfaceNormal)) {
-            if (entityFrameBox.contains(entityFrameOrigin) || localDistance < distance) {
-                // now ask the entity if we actually intersect
-                if (entity->supportsDetailedIntersection()) {
-                    QVariantMap localExtraInfo;
-                    if (entity->findDetailedRayIntersection(origin, direction, element, localDistance,
-                            localFace, localSurfaceNormal, localExtraInfo, searchFilter.isPrecise())) {
-                        if (localDistance < distance) {
-                            distance = localDistance;
-                            face = localFace;
-                            surfaceNormal = localSurfaceNormal;
-                            extraInfo = localExtraInfo;
-                            entityID = entity->getEntityItemID();
-                        }
-                    }
-                } else {
-                    // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
-                    // Never intersect with particle entities
-                    if (localDistance < distance && entity->getType() != EntityTypes::ParticleEffect) {
+    // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
+    // and testing intersection there.
+    float localDistance;
+    BoxFace localFace { UNKNOWN_FACE };
+    glm::vec3 localSurfaceNormal;
+    if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, 1.0f / entityFrameDirection, localDistance,
+                                            localFace, localSurfaceNormal)) {
+        if (entityFrameBox.contains(entityFrameOrigin) || localDistance < distance) {
+            // now ask the entity if we actually intersect
+            if (entity->supportsDetailedIntersection()) {
+                QVariantMap localExtraInfo;
+                if (entity->findDetailedRayIntersection(origin, direction, element, localDistance,
+                        localFace, localSurfaceNormal, localExtraInfo, searchFilter.isPrecise())) {
+                    if (localDistance < distance) {
                         distance = localDistance;
                         face = localFace;
-                        surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 0.0f));
-                        extraInfo = QVariantMap();
-                        entityID = entity->getEntityItemID();
+                        surfaceNormal = localSurfaceNormal;
+                        extraInfo = localExtraInfo;
+                        return true;
                     }
                 }
+            } else {
+                // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
+                // Never intersect with particle entities
+                if (localDistance < distance && entity->getType() != EntityTypes::ParticleEffect) {
+                    distance = localDistance;
+                    face = localFace;
+                    surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 0.0f));
+                    extraInfo = QVariantMap();
+                    return true;
+                }
             }
         }
+    }
+    return false;
+}
+
+EntityItemID EntityTreeElement::evalDetailedRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
+                                    OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+                                    const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIDsToDiscard,
+                                    PickFilter searchFilter, QVariantMap& extraInfo) {
+
+    // only called if we do intersect our bounding cube, but find if we actually intersect with entities...
+    EntityItemID entityID;
+    forEachEntity([&](EntityItemPointer entity) {
+        if (evalEntityRayIntersection(entity, origin, direction, element, distance, face, surfaceNormal,
+                                      entityIdsToInclude, entityIDsToDiscard, searchFilter, extraInfo)) {
+            entityID = entity->getEntityItemID();
+        }
     });
     return entityID;
 }
@@ -421,247 +443,69 @@ EntityItemID EntityTreeElement::evalDetailedParabolaIntersection(const glm::vec3
     return entityID;
 }
 
-QUuid EntityTreeElement::evalClosetEntity(const glm::vec3& position, PickFilter searchFilter, float& closestDistanceSquared) const {
-    QUuid closestEntity;
-    forEachEntity([&](EntityItemPointer entity) {
-        if (!checkFilterSettings(entity, searchFilter)) {
-            return;
-        }
-
-        float distanceToEntity = glm::distance2(position, entity->getWorldPosition());
-        if (distanceToEntity < closestDistanceSquared) {
-            closestEntity = entity->getID();
-            closestDistanceSquared = distanceToEntity;
-        }
-    });
-    return closestEntity;
-}
-
-void EntityTreeElement::evalEntitiesInSphere(const glm::vec3& position, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
-        if (!checkFilterSettings(entity, searchFilter)) {
-            return;
-        }
-
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-
-        // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
-        glm::vec3 penetration;
-        if (success && entityBox.findSpherePenetration(position, radius, penetration)) {
-
-            glm::vec3 dimensions = entity->getRaycastDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably do actual hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-
-                bool success;
-                if (findSphereSpherePenetration(position, radius, entity->getCenterPosition(success), entityTrueRadius, penetration)) {
-                    if (success) {
-                        foundEntities.push_back(entity->getID());
-                    }
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-                glm::mat4 translation = glm::translate(entity->getWorldPosition());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
-
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint);
-
-                AABox entityFrameBox(corner, dimensions);
-
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(position, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, radius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            }
-        }
-    });
-}
-
-void EntityTreeElement::evalEntitiesInSphereWithType(const glm::vec3& position, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
-        if (!checkFilterSettings(entity, searchFilter) || type != entity->getType()) {
-            return;
-        }
-
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-
-        // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
-        glm::vec3 penetration;
-        if (success && entityBox.findSpherePenetration(position, radius, penetration)) {
-
-            glm::vec3 dimensions = entity->getRaycastDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably do actual hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-
-                bool success;
-                if (findSphereSpherePenetration(position, radius, entity->getCenterPosition(success), entityTrueRadius, penetration)) {
-                    if (success) {
-                        foundEntities.push_back(entity->getID());
-                    }
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-                glm::mat4 translation = glm::translate(entity->getWorldPosition());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
-
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint);
-
-                AABox entityFrameBox(corner, dimensions);
-
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(position, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, radius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            }
-        }
-    });
-}
-
-void EntityTreeElement::evalEntitiesInSphereWithName(const glm::vec3& position, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
-        if (!checkFilterSettings(entity, searchFilter)) {
-            return;
-        }
-
-        QString entityName = entity->getName();
-        if ((caseSensitive && name != entityName) || (!caseSensitive && name.toLower() != entityName.toLower())) {
-            return;
-        }
+bool EntityTreeElement::entityTouchesSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius) {
+    bool success;
+    AABox entityBox = entity->getAABox(success);
 
-        bool success;
-        AABox entityBox = entity->getAABox(success);
+    // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
+    glm::vec3 penetration;
+    if (!success || !entityBox.findSpherePenetration(position, radius, penetration)) {
+        return false;
+    }
 
-        // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
-        glm::vec3 penetration;
-        if (success && entityBox.findSpherePenetration(position, radius, penetration)) {
+    glm::vec3 dimensions = entity->getRaycastDimensions();
 
-            glm::vec3 dimensions = entity->getRaycastDimensions();
+    // FIXME - consider allowing the entity to determine penetration so that
+    //         entities could presumably do actual hull testing if they wanted to
+    // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
+    //         can we handle the ellipsoid case better? We only currently handle perfect spheres
+    //         with centered registration points
+    if (entity->getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
 
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably do actual hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
+        // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
+        //       maximum bounding sphere, which is actually larger than our actual radius
+        float entityTrueRadius = dimensions.x / 2.0f;
 
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
+        glm::vec3 entityCenter = entity->getCenterPosition(success);
+        return success && findSphereSpherePenetration(position, radius, entityCenter, entityTrueRadius, penetration);
+    }
 
-                bool success;
-                if (findSphereSpherePenetration(position, radius, entity->getCenterPosition(success), entityTrueRadius, penetration)) {
-                    if (success) {
-                        foundEntities.push_back(entity->getID());
-                    }
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-                glm::mat4 translation = glm::translate(entity->getWorldPosition());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+    // determine the worldToEntityMatrix that doesn't include scale because
+    // we're going to use the registration aware aa box in the entity frame
+    glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
+    glm::mat4 translation = glm::translate(entity->getWorldPosition());
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
 
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint);
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint);
 
-                AABox entityFrameBox(corner, dimensions);
+    AABox entityFrameBox(corner, dimensions);
 
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(position, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, radius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            }
-        }
-    });
+    glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(position, 1.0f));
+    return entityFrameBox.findSpherePenetration(entityFrameSearchPosition, radius, penetration);
 }
 
-void EntityTreeElement::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
-        if (!checkFilterSettings(entity, searchFilter)) {
-            return;
-        }
-
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better
-        // FIXME - consider allowing the entity to determine penetration so that
-        //         entities could presumably dull actuall hull testing if they wanted to
-        // FIXME - is there an easy way to translate the search cube into something in the
-        //         entity frame that can be easily tested against?
-        //         simple algorithm is probably:
-        //             if target box is fully inside search box == yes
-        //             if search box is fully inside target box == yes
-        //             for each face of search box:
-        //                 translate the triangles of the face into the box frame
-        //                 test the triangles of the face against the box?
-        //                 if translated search face triangle intersect target box
-        //                     add to result
-        //
-
-        // If the entities AABox touches the search cube then consider it to be found
-        if (success && entityBox.touches(cube)) {
-            foundEntities.push_back(entity->getID());
-        }
-    });
-}
-
-void EntityTreeElement::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
-        if (!checkFilterSettings(entity, searchFilter)) {
-            return;
-        }
-
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better
-        // FIXME - consider allowing the entity to determine penetration so that
-        //         entities could presumably dull actuall hull testing if they wanted to
-        // FIXME - is there an easy way to translate the search cube into something in the
-        //         entity frame that can be easily tested against?
-        //         simple algorithm is probably:
-        //             if target box is fully inside search box == yes
-        //             if search box is fully inside target box == yes
-        //             for each face of search box:
-        //                 translate the triangles of the face into the box frame
-        //                 test the triangles of the face against the box?
-        //                 if translated search face triangle intersect target box
-        //                     add to result
-        //
-
-        // If the entities AABox touches the search cube then consider it to be found
-        if (success && entityBox.touches(box)) {
-            foundEntities.push_back(entity->getID());
-        }
-    });
+bool EntityTreeElement::entityTouchesBox(const EntityItemPointer& entity, const AABox& box) {
+    bool success;
+    AABox entityBox = entity->getAABox(success);
+    // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better
+    // FIXME - consider allowing the entity to determine penetration so that
+    //         entities could presumably dull actuall hull testing if they wanted to
+    // FIXME - is there an easy way to translate the search cube into something in the
+    //         entity frame that can be easily tested against?
+    //         simple algorithm is probably:
+    //             if target box is fully inside search box == yes
+    //             if search box is fully inside target box == yes
+    //             for each face of search box:
+    //                 translate the triangles of the face into the box frame
+    //                 test the triangles of the face against the box?
+    //                 if translated search face triangle intersect target box
+    //                     add to result
+    //
+
+    // If the entities AABox touches the search box then consider it to be found
+    return success && entityBox.touches(box);
 }
 
 void EntityTreeElement::evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
@@ -708,6 +552,7 @@ void EntityTreeElement::cleanupDomainAndNonOwnedEntities() {
             if (!(entity->isLocalEntity() || (entity->isAvatarEntity() && entity->getOwningAvatarID() == getTree()->getMyAvatarSessionUUID()))) {
                 entity->preDelete();
                 entity->_element = NULL;
+                _myTree->getSpatialIndex().remove(entity.get());
             } else {
                 savedEntities.push_back(entity);
             }
@@ -727,6 +572,7 @@ void EntityTreeElement::cleanupEntities() {
             // access it by smart pointers, when we remove it from the _entityItems
             // we know that it will be deleted.
             entity->_element = NULL;
+            _myTree->getSpatialIndex().remove(entity.get());
         }
         _entityItems.clear();
     });
@@ -745,6 +591,7 @@ bool EntityTreeElement::removeEntityItem(EntityItemPointer entity, bool deletion
         // NOTE: only EntityTreeElement should ever be changing the value of entity->_element
         assert(entity->_element.get() == this);
         entity->_element = NULL;
+        _myTree->getSpatialIndex().remove(entity.get());
         bumpChangedContent();
         return true;
     }
@@ -765,6 +612,7 @@ void EntityTreeElement::addEntityItem(EntityItemPointer entity) {
     });
     bumpChangedContent();
     entity->_element = getThisPointer();
+    _myTree->getSpatialIndex().update(entity);
 }
 
 // will average a "common reduced LOD view" from the the child elements...
@@ -83,6 +83,9 @@ class EntityTreeElement : public OctreeElement, ReadWriteLockable {
 
     EntityTreeElement(unsigned char* octalCode = NULL);
 
+    // elements, and their shared_ptr control blocks, come from pools rather than from the heap one by one
+    static EntityTreeElementPointer create(unsigned char* octalCode);
+
     virtual OctreeElementPointer createNewElement(unsigned char* octalCode = NULL) override;
 
 public:
@@ -135,6 +138,16 @@ public:
     virtual bool deleteApproved() const override { return !hasEntities(); }
 
     static bool checkFilterSettings(const EntityItemPointer& entity, PickFilter searchFilter);
+
+    // the precise tests of a single entity, used by the queries of the EntityTree once its spatial index has found the
+    // entities near enough to be worth testing
+    static bool evalEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+        const glm::vec3& direction, OctreeElementPointer& element, float& distance, BoxFace& face,
+        glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
+        const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
+    static bool entityTouchesSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius);
+    static bool entityTouchesBox(const EntityItemPointer& entity, const AABox& box);
+
     virtual bool canPickIntersect() const override { return hasEntities(); }
     virtual EntityItemID evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
         OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
@@ -173,12 +186,6 @@ public:
 
     void addEntityItem(EntityItemPointer entity);
 
-    QUuid evalClosetEntity(const glm::vec3& position, PickFilter searchFilter, float& closestDistanceSquared) const;
-    void evalEntitiesInSphere(const glm::vec3& position, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
-    void evalEntitiesInSphereWithType(const glm::vec3& position, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
-    void evalEntitiesInSphereWithName(const glm::vec3& position, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
-    void evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
-    void evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
     void evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
 
     /// finds all entities that match filter
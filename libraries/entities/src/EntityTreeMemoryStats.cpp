@@ -0,0 +1,149 @@
+//
+//  EntityTreeMemoryStats.cpp
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeMemoryStats.h"
+
+#include <QtCore/QLocale>
+
+#include "EntityTypes.h"
+
+// large enough for all but the biggest poly voxes, which are counted at this
+const int MAX_MEASURED_ENCODING_SIZE = 1 << 20;
+
+// a QMultiMap node holds the key, the value and the links of the skip list, roughly
+const quint64 RECENTLY_DELETED_ENTRY_BYTES = sizeof(quint64) + sizeof(QUuid) + 4 * sizeof(void*);
+
+static int entityCountBucket(int numEntities) {
+    int bucket = 0;
+    while (numEntities > 0 && bucket < EntityTreeMemoryStats::NUM_ENTITY_COUNT_BUCKETS - 1) {
+        numEntities >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void EntityTreeMemoryStats::collect(const EntityTreePointer& tree) {
+    *this = EntityTreeMemoryStats();
+    _collectedTime = usecTimestampNow();
+
+    OctreePacketData packetData(false, MAX_MEASURED_ENCODING_SIZE);
+    tree->withReadLock([&] {
+        collectElement(std::static_pointer_cast<EntityTreeElement>(tree->getRoot()), packetData);
+    });
+
+    _numRecentlyDeleted = tree->getRecentlyDeletedEntityIDs().size();
+    _recentlyDeletedBytes = _numRecentlyDeleted * RECENTLY_DELETED_ENTRY_BYTES;
+}
+
+void EntityTreeMemoryStats::collectElement(const EntityTreeElementPointer& element, OctreePacketData& packetData) {
+    if (!element) {
+        return;
+    }
+
+    int numEntities = 0;
+    element->forEachEntity([&](const EntityItemPointer& entity) {
+        auto& typeStats = _types[EntityTypes::getEntityTypeName(entity->getType())];
+        typeStats.count++;
+        typeStats.objectBytes += EntityTypes::getEntityItemSize(entity->getType());
+
+        packetData.reset();
+        EncodeBitstreamParams params;
+        auto extraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+        entity->appendEntityData(&packetData, params, extraEncodeData, true);
+        typeStats.payloadBytes += packetData.getUncompressedSize();
+        numEntities++;
+    });
+
+    _numElements++;
+    _elementBytes += sizeof(EntityTreeElement) + numEntities * sizeof(EntityItemPointer);
+    _childCountHistogram[element->getChildCount()]++;
+    _entityCountHistogram[entityCountBucket(numEntities)]++;
+
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        collectElement(element->getChildAtIndex(i), packetData);
+    }
+}
+
+static QString entityCountBucketName(int bucket) {
+    if (bucket < 2) {
+        return QString::number(bucket);
+    }
+    int minimum = 1 << (bucket - 1);
+    if (bucket == EntityTreeMemoryStats::NUM_ENTITY_COUNT_BUCKETS - 1) {
+        return QString("%1+").arg(minimum);
+    }
+    return QString("%1-%2").arg(minimum).arg(2 * minimum - 1);
+}
+
+QJsonObject EntityTreeMemoryStats::toJson() const {
+    QJsonObject types;
+    for (auto it = _types.begin(); it != _types.end(); ++it) {
+        QJsonObject typeStats;
+        typeStats["1. count"] = it->count;
+        typeStats["2. objectBytes"] = (double)it->objectBytes;
+        typeStats["3. payloadBytes"] = (double)it->payloadBytes;
+        types[it.key()] = typeStats;
+    }
+
+    QJsonObject childCounts;
+    for (int i = 0; i <= NUMBER_OF_CHILDREN; i++) {
+        childCounts[QString::number(i)] = _childCountHistogram[i];
+    }
+    QJsonObject entityCounts;
+    for (int i = 0; i < NUM_ENTITY_COUNT_BUCKETS; i++) {
+        entityCounts[QString("%1. %2").arg(i + 1).arg(entityCountBucketName(i))] = _entityCountHistogram[i];
+    }
+    QJsonObject elements;
+    elements["1. count"] = _numElements;
+    elements["2. bytes"] = (double)_elementBytes;
+    elements["3. byChildCount"] = childCounts;
+    elements["4. byEntityCount"] = entityCounts;
+
+    QJsonObject recentlyDeleted;
+    recentlyDeleted["1. count"] = _numRecentlyDeleted;
+    recentlyDeleted["2. bytes"] = (double)_recentlyDeletedBytes;
+
+    QJsonObject stats;
+    stats["1. entityTypes"] = types;
+    stats["2. elements"] = elements;
+    stats["3. recentlyDeleted"] = recentlyDeleted;
+    return stats;
+}
+
+QString EntityTreeMemoryStats::toString() const {
+    QLocale locale(QLocale::English);
+    const int COLUMN_WIDTH = 16;
+    QString statsString;
+
+    statsString += "Entity Type       Count            Object Bytes     Payload Bytes\r\n";
+    for (auto it = _types.begin(); it != _types.end(); ++it) {
+        statsString += it.key().leftJustified(COLUMN_WIDTH + 2);
+        statsString += locale.toString(it->count).leftJustified(COLUMN_WIDTH + 1);
+        statsString += locale.toString(it->objectBytes).leftJustified(COLUMN_WIDTH + 1);
+        statsString += locale.toString(it->payloadBytes) + "\r\n";
+    }
+    statsString += "\r\n";
+
+    statsString += QString("Elements... %1 taking %2 bytes\r\n").arg(locale.toString(_numElements))
+        .arg(locale.toString(_elementBytes));
+    statsString += "    by child count:";
+    for (int i = 0; i <= NUMBER_OF_CHILDREN; i++) {
+        statsString += QString("  %1: %2").arg(i).arg(locale.toString(_childCountHistogram[i]));
+    }
+    statsString += "\r\n    by entity count:";
+    for (int i = 0; i < NUM_ENTITY_COUNT_BUCKETS; i++) {
+        statsString += QString("  %1: %2").arg(entityCountBucketName(i)).arg(locale.toString(_entityCountHistogram[i]));
+    }
+    statsString += "\r\n";
+
+    statsString += QString("Recently deleted entity IDs... %1 taking %2 bytes\r\n")
+        .arg(locale.toString(_numRecentlyDeleted)).arg(locale.toString(_recentlyDeletedBytes));
+    return statsString;
+}
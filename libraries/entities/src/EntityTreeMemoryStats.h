@@ -0,0 +1,60 @@
+//
+//  EntityTreeMemoryStats.h
+//  libraries/entities/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeMemoryStats_h
+#define hifi_EntityTreeMemoryStats_h
+
+#include <array>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+
+#include "EntityTree.h"
+
+// A rough account of the memory the entities and elements of a tree take up, for a server's stats. An entity is counted
+// as the size of its class plus its encoded size, which stands in for what its strings, variants and arrays allocate.
+// Collecting it encodes every entity in the tree, under the tree's read lock, so it is not something to do often.
+class EntityTreeMemoryStats {
+public:
+    class TypeStats {
+    public:
+        int count { 0 };
+        quint64 objectBytes { 0 };
+        quint64 payloadBytes { 0 };
+    };
+
+    // elements are counted by how many entities they hold: none, one, 2-3, 4-7, ... and 128 or more
+    static const int NUM_ENTITY_COUNT_BUCKETS = 9;
+
+    void collect(const EntityTreePointer& tree);
+
+    QJsonObject toJson() const;
+    QString toString() const;
+
+    quint64 getCollectedTime() const { return _collectedTime; }
+
+private:
+    void collectElement(const EntityTreeElementPointer& element, OctreePacketData& packetData);
+
+    quint64 _collectedTime { 0 };
+
+    QMap<QString, TypeStats> _types;
+
+    int _numElements { 0 };
+    quint64 _elementBytes { 0 };
+    std::array<int, NUMBER_OF_CHILDREN + 1> _childCountHistogram {};
+    std::array<int, NUM_ENTITY_COUNT_BUCKETS> _entityCountHistogram {};
+
+    int _numRecentlyDeleted { 0 };
+    quint64 _recentlyDeletedBytes { 0 };
+};
+
+#endif // hifi_EntityTreeMemoryStats_h
@@ -113,6 +113,43 @@ EntityItemPointer EntityTypes::constructEntityItem(EntityType entityType, const
     return newEntityItem;
 }
 
+size_t EntityTypes::getEntityItemSize(EntityType entityType) {
+    switch (entityType) {
+        case Box:
+        case Sphere:
+        case Shape:
+            return sizeof(ShapeEntityItem);
+        case Model:
+            return sizeof(ModelEntityItem);
+        case Text:
+            return sizeof(TextEntityItem);
+        case Image:
+            return sizeof(ImageEntityItem);
+        case Web:
+            return sizeof(WebEntityItem);
+        case ParticleEffect:
+            return sizeof(ParticleEffectEntityItem);
+        case Line:
+            return sizeof(LineEntityItem);
+        case PolyLine:
+            return sizeof(PolyLineEntityItem);
+        case PolyVox:
+            return sizeof(PolyVoxEntityItem);
+        case Grid:
+            return sizeof(GridEntityItem);
+        case Gizmo:
+            return sizeof(GizmoEntityItem);
+        case Light:
+            return sizeof(LightEntityItem);
+        case Zone:
+            return sizeof(ZoneEntityItem);
+        case Material:
+            return sizeof(MaterialEntityItem);
+        default:
+            return sizeof(EntityItem);
+    }
+}
+
 void EntityTypes::extractEntityTypeAndID(const unsigned char* data, int dataLength, EntityTypes::EntityType& typeOut, QUuid& idOut) {
 
     // Header bytes
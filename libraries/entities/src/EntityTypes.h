@@ -119,6 +119,8 @@ public:
     static EntityItemPointer constructEntityItem(EntityType entityType, const EntityItemID& entityID, const EntityItemProperties& properties);
     static EntityItemPointer constructEntityItem(const unsigned char* data, int bytesToRead);
     static EntityItemPointer constructEntityItem(const QUuid& id, const EntityItemProperties& properties);
+    // the size of the class entities of the type are made of, not counting what they allocate
+    static size_t getEntityItemSize(EntityType entityType);
 
 private:
     static QMap<EntityType, QString> _typeToNameMap;
@@ -277,6 +277,63 @@ OctreeElementPointer MovingEntitiesOperator::possiblyCreateChildAt(const OctreeE
     return NULL; 
 }
 
+void MovingEntitiesOperator::moveEntities() {
+    foreach(const EntityToMoveDetails& details, _entitiesToMove) {
+        moveEntity(details);
+    }
+    reset();
+}
+
+void MovingEntitiesOperator::moveEntity(const EntityToMoveDetails& details) {
+    EntityTreeElementPointer oldElement = details.entity->getElement();
+    if (!oldElement) {
+        return;
+    }
+
+    // climb until the element contains the new bounds, the root always does unless they're bad
+    EntityTreeElementPointer element = oldElement;
+    while (!element->containsBounds(details.newCubeClamped)) {
+        EntityTreeElementPointer parent = std::static_pointer_cast<EntityTreeElement>(element->getParent());
+        if (!parent) {
+            if (_wantDebug) {
+                qCDebug(entities) << "MovingEntitiesOperator::moveEntity() no element contains" << details.newCubeClamped;
+            }
+            return;
+        }
+        element = parent;
+    }
+
+    // then descend to the best fit, making the elements that aren't there yet
+    while (!element->bestFitBounds(details.newCube)) {
+        int childIndex = element->getMyChildContaining(details.newCubeClamped);
+        if (childIndex == OctreeElement::CHILD_UNKNOWN) {
+            break;
+        }
+        EntityTreeElementPointer child = element->getChildAtIndex(childIndex);
+        if (!child) {
+            child = std::static_pointer_cast<EntityTreeElement>(element->addChildAtIndex(childIndex));
+        }
+        element = child;
+    }
+
+    if (element == oldElement) {
+        element->bumpChangedContent();
+    } else {
+        oldElement->removeEntityItem(details.entity);
+        element->addEntityItem(details.entity);
+    }
+
+    // mark both paths up to the root as changed, pruning what the entity left empty along the old one
+    for (OctreeElementPointer ancestor = element; ancestor; ancestor = ancestor->getParent()) {
+        ancestor->markWithChangedTime();
+    }
+    for (OctreeElementPointer ancestor = oldElement->getParent(); ancestor; ancestor = ancestor->getParent()) {
+        ancestor->markWithChangedTime();
+        std::static_pointer_cast<EntityTreeElement>(ancestor)->pruneChildren();
+    }
+    oldElement->markWithChangedTime();
+}
+
 void MovingEntitiesOperator::reset() {
     _entitiesToMove.clear();
     _foundOldCount = 0;
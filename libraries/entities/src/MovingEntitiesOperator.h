@@ -47,8 +47,15 @@ public:
     virtual OctreeElementPointer possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) override;
     bool hasMovingEntities() const { return _entitiesToMove.size() > 0; }
     void reset();
+
+    // Moves the entities in the list without recursing the tree from its root: each one climbs from the element it is
+    // in until it still fits, using the parent pointers, then goes down to its new best fit element. Only the elements on
+    // those paths are marked as changed and pruned. Resets the list when it is done.
+    void moveEntities();
+
 private:
     bool shouldRecurseSubTree(const OctreeElementPointer& element);
+    void moveEntity(const EntityToMoveDetails& details);
 
     QSet<EntityToMoveDetails> _entitiesToMove;
     int _foundOldCount { 0 };
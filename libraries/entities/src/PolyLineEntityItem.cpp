@@ -18,6 +18,7 @@
 
 #include "EntitiesLogging.h"
 #include "EntityItemProperties.h"
+#include "EntityPropertyDelta.h"
 #include "EntityTree.h"
 #include "EntityTreeElement.h"
 #include "OctreeConstants.h"
@@ -166,10 +167,10 @@ int PolyLineEntityItem::readEntitySubclassDataFromBuffer(const unsigned char* da
     READ_ENTITY_PROPERTY(PROP_COLOR, glm::u8vec3, setColor);
     READ_ENTITY_PROPERTY(PROP_TEXTURES, QString, setTextures);
 
-    READ_ENTITY_PROPERTY(PROP_LINE_POINTS, QVector<glm::vec3>, setLinePoints);
-    READ_ENTITY_PROPERTY(PROP_STROKE_WIDTHS, QVector<float>, setStrokeWidths);
-    READ_ENTITY_PROPERTY(PROP_STROKE_NORMALS, QVector<glm::vec3>, setNormals);
-    READ_ENTITY_PROPERTY(PROP_STROKE_COLORS, QVector<glm::vec3>, setStrokeColors);
+    READ_ENTITY_PROPERTY_DELTA(PROP_LINE_POINTS, glm::vec3, getLinePoints, setLinePoints);
+    READ_ENTITY_PROPERTY_DELTA(PROP_STROKE_WIDTHS, float, getStrokeWidths, setStrokeWidths);
+    READ_ENTITY_PROPERTY_DELTA(PROP_STROKE_NORMALS, glm::vec3, getNormals, setNormals);
+    READ_ENTITY_PROPERTY_DELTA(PROP_STROKE_COLORS, glm::vec3, getStrokeColors, setStrokeColors);
     READ_ENTITY_PROPERTY(PROP_IS_UV_MODE_STRETCH, bool, setIsUVModeStretch);
     READ_ENTITY_PROPERTY(PROP_LINE_GLOW, bool, setGlow);
     READ_ENTITY_PROPERTY(PROP_LINE_FACE_CAMERA, bool, setFaceCamera);
@@ -205,10 +206,10 @@ void PolyLineEntityItem::appendSubclassData(OctreePacketData* packetData, Encode
     APPEND_ENTITY_PROPERTY(PROP_COLOR, getColor());
     APPEND_ENTITY_PROPERTY(PROP_TEXTURES, getTextures());
 
-    APPEND_ENTITY_PROPERTY(PROP_LINE_POINTS, getLinePoints());
-    APPEND_ENTITY_PROPERTY(PROP_STROKE_WIDTHS, getStrokeWidths());
-    APPEND_ENTITY_PROPERTY(PROP_STROKE_NORMALS, getNormals());
-    APPEND_ENTITY_PROPERTY(PROP_STROKE_COLORS, getStrokeColors());
+    APPEND_ENTITY_PROPERTY_DELTA(PROP_LINE_POINTS, getLinePoints());
+    APPEND_ENTITY_PROPERTY_DELTA(PROP_STROKE_WIDTHS, getStrokeWidths());
+    APPEND_ENTITY_PROPERTY_DELTA(PROP_STROKE_NORMALS, getNormals());
+    APPEND_ENTITY_PROPERTY_DELTA(PROP_STROKE_COLORS, getStrokeColors());
     APPEND_ENTITY_PROPERTY(PROP_IS_UV_MODE_STRETCH, getIsUVModeStretch());
     APPEND_ENTITY_PROPERTY(PROP_LINE_GLOW, getGlow());
     APPEND_ENTITY_PROPERTY(PROP_LINE_FACE_CAMERA, getFaceCamera());
@@ -393,8 +393,10 @@ hifi::ByteArray fileOnUrl(const hifi::ByteArray& filepath, const QString& url) {
 }
 
 HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const QString& url) {
-    const FBXNode& node = _rootNode;
     bool deduplicateIndices = mapping["deduplicateIndices"].toBool();
+    // the bakers that re-write the parsed nodes need them to stay whole, otherwise the geometry nodes are cleared as they
+    // are extracted so that the parsed arrays are not held along with the meshes extracted from them
+    bool keepNodes = mapping["keepFBXNodes"].toBool();
 
     QMap<QString, ExtractedMesh> meshes;
     QHash<QString, QString> modelIDsToNames;
@@ -453,7 +455,7 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
     unsigned int meshIndex = 0;
     haveReportedUnhandledRotationOrder = false;
     int fbxVersionNumber = -1;
-    foreach (const FBXNode& child, node.children) {
+    for (FBXNode& child : _rootNode.children) {
 
         if (child.name == "FBXHeaderExtension") {
             foreach (const FBXNode& object, child.children) {
@@ -510,14 +512,20 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
                 }
             }
         } else if (child.name == "Objects") {
-            foreach (const FBXNode& object, child.children) {
+            // the draco meshes of the baked models are decoded all at once, then extracted with the rest of their geometry
+            DracoMeshes dracoMeshes = decodeDracoMeshes(child);
+            for (FBXNode& object : child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex, deduplicateIndices));
+                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex, deduplicateIndices, dracoMeshes));
+                        dracoMeshes.erase(&object);
                     } else { // object.properties.at(2) == "Shape"
                         ExtractedBlendshape extracted = { getID(object.properties), extractBlendshape(object) };
                         blendshapes.append(extracted);
                     }
+                    if (!keepNodes) {
+                        object.children.clear();
+                    }
                 } else if (object.name == "Model") {
                     QString name = getModelName(object.properties);
                     QString id = getID(object.properties);
@@ -1674,6 +1682,11 @@ HFMModel::Pointer FBXSerializer::read(const hifi::ByteArray& data, const hifi::V
     _rootNode = parseFBX(&buffer);
 
     // FBXSerializer's mapping parameter supports the bool "deduplicateIndices," which is passed into FBXSerializer::extractMesh as "deduplicate"
+    // and the bool "keepFBXNodes," which keeps the parsed nodes whole in _rootNode once the model is extracted from them
 
-    return HFMModel::Pointer(extractHFMModel(mapping, url.toString()));
+    auto hfmModel = HFMModel::Pointer(extractHFMModel(mapping, url.toString()));
+    if (!mapping["keepFBXNodes"].toBool()) {
+        _rootNode = FBXNode();
+    }
+    return hfmModel;
 }
@@ -12,6 +12,9 @@
 #ifndef hifi_FBXSerializer_h
 #define hifi_FBXSerializer_h
 
+#include <memory>
+#include <unordered_map>
+
 #include <QtGlobal>
 #include <QMetaType>
 #include <QSet>
@@ -33,6 +36,10 @@
 class QIODevice;
 class FBXNode;
 
+namespace draco {
+    class Mesh;
+}
+
 class TextureParam {
 public:
     glm::vec4 cropping;
@@ -119,7 +126,12 @@ public:
 
     HFMModel* extractHFMModel(const hifi::VariantHash& mapping, const QString& url);
 
-    static ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex, bool deduplicate);
+    // the draco meshes of the mesh geometries under the objects node, keyed by their geometry node
+    using DracoMeshes = std::unordered_map<const FBXNode*, std::shared_ptr<draco::Mesh>>;
+    static DracoMeshes decodeDracoMeshes(const FBXNode& objectsNode);
+
+    static ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex, bool deduplicate,
+        const DracoMeshes& decodedDracoMeshes = DracoMeshes());
     QHash<QString, ExtractedMesh> meshes;
 
     HFMTexture getTexture(const QString& textureID, const QString& materialID);
@@ -48,6 +48,8 @@
 #include <glm/detail/type_half.hpp>
 #include <glm/gtc/packing.hpp>
 
+#include <TBBHelpers.h>
+
 using vec2h = glm::tvec2<glm::detail::hdata>;
 
 class Vertex {
@@ -189,7 +191,70 @@ void appendIndex(MeshData& data, QVector<int>& indices, int index, bool deduplic
     }
 }
 
-ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& meshIndex, bool deduplicate) {
+static std::shared_ptr<draco::Mesh> decodeDracoMesh(const FBXNode& dracoMeshNode) {
+    draco::Decoder decoder;
+    draco::DecoderBuffer decodedBuffer;
+    hifi::ByteArray dracoArray = dracoMeshNode.properties.at(0).value<hifi::ByteArray>();
+    decodedBuffer.Init(dracoArray.data(), dracoArray.size());
+
+    auto dracoMesh = std::make_shared<draco::Mesh>();
+    decoder.DecodeBufferToGeometry(&decodedBuffer, dracoMesh.get());
+    return dracoMesh;
+}
+
+FBXSerializer::DracoMeshes FBXSerializer::decodeDracoMeshes(const FBXNode& objectsNode) {
+    std::vector<std::pair<const FBXNode*, const FBXNode*>> dracoMeshNodes;
+    for (const FBXNode& object : objectsNode.children) {
+        if (object.name != "Geometry" || object.properties.size() < 3 || object.properties.at(2) != "Mesh") {
+            continue;
+        }
+        for (const FBXNode& child : object.children) {
+            if (child.name == "DracoMesh" && !child.properties.isEmpty()) {
+                dracoMeshNodes.emplace_back(&object, &child);
+                break;
+            }
+        }
+    }
+
+    // each mesh has its own decoder, so they decode side by side
+    std::vector<std::shared_ptr<draco::Mesh>> decoded(dracoMeshNodes.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, dracoMeshNodes.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+            decoded[i] = decodeDracoMesh(*dracoMeshNodes[i].second);
+        }
+    });
+
+    DracoMeshes dracoMeshes;
+    for (size_t i = 0; i < dracoMeshNodes.size(); ++i) {
+        dracoMeshes.emplace(dracoMeshNodes[i].first, std::move(decoded[i]));
+    }
+    return dracoMeshes;
+}
+
+// Reads the N float components of an attribute for each point of a draco mesh. The float attributes that are stored
+// once per point, as the decoder leaves them when the mesh was baked without sharing values between points,
+// are copied in one go
+template <int N>
+static void readDracoAttribute(const draco::PointAttribute& attribute, uint32_t numPoints, float* values) {
+    const size_t VALUE_SIZE = N * sizeof(float);
+    bool isFloat = attribute.data_type() == draco::DT_FLOAT32 && attribute.num_components() == N &&
+        attribute.byte_stride() == (int64_t)VALUE_SIZE;
+    if (isFloat && attribute.is_mapping_identity() && attribute.size() >= numPoints) {
+        memcpy(values, attribute.GetAddress(draco::AttributeValueIndex(0)), numPoints * VALUE_SIZE);
+        return;
+    }
+    for (uint32_t i = 0; i < numPoints; ++i) {
+        auto mappedIndex = attribute.mapped_index(draco::PointIndex(i));
+        if (isFloat) {
+            memcpy(values + i * N, attribute.GetAddress(mappedIndex), VALUE_SIZE);
+        } else {
+            attribute.ConvertValue<float, N>(mappedIndex, values + i * N);
+        }
+    }
+}
+
+ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& meshIndex, bool deduplicate,
+        const DracoMeshes& decodedDracoMeshes) {
     MeshData data;
     data.extracted.mesh.meshIndex = meshIndex++;
 
@@ -369,14 +434,14 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
                 }
             }
 
-            // load the draco mesh from the FBX and create a draco::Mesh
-            draco::Decoder decoder;
-            draco::DecoderBuffer decodedBuffer;
-            hifi::ByteArray dracoArray = child.properties.at(0).value<hifi::ByteArray>();
-            decodedBuffer.Init(dracoArray.data(), dracoArray.size());
-
-            std::unique_ptr<draco::Mesh> dracoMesh(new draco::Mesh());
-            decoder.DecodeBufferToGeometry(&decodedBuffer, dracoMesh.get());
+            // use the draco mesh decoded with the others of the model, or decode it from the FBX
+            std::shared_ptr<draco::Mesh> dracoMesh;
+            auto decodedIt = decodedDracoMeshes.find(&object);
+            if (decodedIt != decodedDracoMeshes.end()) {
+                dracoMesh = decodedIt->second;
+            } else {
+                dracoMesh = decodeDracoMesh(child);
+            }
 
             // prepare attributes for this mesh
             auto positionAttribute = dracoMesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
@@ -386,6 +451,7 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
             auto colorAttribute = dracoMesh->GetNamedAttribute(draco::GeometryAttribute::COLOR);
             auto materialIDAttribute = dracoMesh->GetAttributeByUniqueId(DRACO_ATTRIBUTE_MATERIAL_ID);
             auto originalIndexAttribute = dracoMesh->GetAttributeByUniqueId(DRACO_ATTRIBUTE_ORIGINAL_INDEX);
+            auto vertexIndexAttribute = dracoMesh->GetAttributeByUniqueId(DRACO_ATTRIBUTE_VERTEX_INDEX);
 
             // setup extracted mesh data structures given number of points
             auto numVertices = dracoMesh->num_points();
@@ -393,67 +459,43 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
             QHash<QPair<int, int>, int> materialTextureParts;
 
             data.extracted.mesh.vertices.resize(numVertices);
+            if (positionAttribute) {
+                readDracoAttribute<3>(*positionAttribute, numVertices,
+                                      reinterpret_cast<float*>(data.extracted.mesh.vertices.data()));
+            }
 
             if (normalAttribute) {
                 data.extracted.mesh.normals.resize(numVertices);
+                readDracoAttribute<3>(*normalAttribute, numVertices,
+                                      reinterpret_cast<float*>(data.extracted.mesh.normals.data()));
             }
 
             if (texCoordAttribute) {
                 data.extracted.mesh.texCoords.resize(numVertices);
+                readDracoAttribute<2>(*texCoordAttribute, numVertices,
+                                      reinterpret_cast<float*>(data.extracted.mesh.texCoords.data()));
             }
 
             if (extraTexCoordAttribute) {
+                // some meshes have a second set of UVs
                 data.extracted.mesh.texCoords1.resize(numVertices);
+                readDracoAttribute<2>(*extraTexCoordAttribute, numVertices,
+                                      reinterpret_cast<float*>(data.extracted.mesh.texCoords1.data()));
             }
 
             if (colorAttribute) {
                 data.extracted.mesh.colors.resize(numVertices);
+                readDracoAttribute<3>(*colorAttribute, numVertices,
+                                      reinterpret_cast<float*>(data.extracted.mesh.colors.data()));
             }
 
-            // enumerate the vertices and construct the extracted mesh
+            // the point of each vertex of the mesh as it was baked, that the triangles of its simplified levels refer to
+            std::vector<int> bakedVertexPoints;
+
+            // enumerate the vertices and map them to the original and baked ones
             for (uint32_t i = 0; i < numVertices; ++i) {
                 draco::PointIndex vertexIndex(i);
 
-                if (positionAttribute) {
-                    // read position from draco mesh to extracted mesh
-                    auto mappedIndex = positionAttribute->mapped_index(vertexIndex);
-
-                    positionAttribute->ConvertValue<float, 3>(mappedIndex,
-                                                              reinterpret_cast<float*>(&data.extracted.mesh.vertices[i]));
-                }
-
-                if (normalAttribute) {
-                    // read normals from draco mesh to extracted mesh
-                    auto mappedIndex = normalAttribute->mapped_index(vertexIndex);
-
-                    normalAttribute->ConvertValue<float, 3>(mappedIndex,
-                                                            reinterpret_cast<float*>(&data.extracted.mesh.normals[i]));
-                }
-
-                if (texCoordAttribute) {
-                    // read UVs from draco mesh to extracted mesh
-                    auto mappedIndex = texCoordAttribute->mapped_index(vertexIndex);
-
-                    texCoordAttribute->ConvertValue<float, 2>(mappedIndex,
-                                                              reinterpret_cast<float*>(&data.extracted.mesh.texCoords[i]));
-                }
-
-                if (extraTexCoordAttribute) {
-                    // some meshes have a second set of UVs, read those to extracted mesh
-                    auto mappedIndex = extraTexCoordAttribute->mapped_index(vertexIndex);
-
-                    extraTexCoordAttribute->ConvertValue<float, 2>(mappedIndex,
-                                                                   reinterpret_cast<float*>(&data.extracted.mesh.texCoords1[i]));
-                }
-
-                if (colorAttribute) {
-                    // read vertex colors from draco mesh to extracted mesh
-                    auto mappedIndex = colorAttribute->mapped_index(vertexIndex);
-
-                    colorAttribute->ConvertValue<float, 3>(mappedIndex,
-                                                           reinterpret_cast<float*>(&data.extracted.mesh.colors[i]));
-                }
-
                 if (originalIndexAttribute) {
                     auto mappedIndex = originalIndexAttribute->mapped_index(vertexIndex);
 
@@ -465,6 +507,21 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
                 } else {
                     data.extracted.newIndices.insert(i, i);
                 }
+
+                if (vertexIndexAttribute) {
+                    auto mappedIndex = vertexIndexAttribute->mapped_index(vertexIndex);
+
+                    int32_t bakedVertexIndex;
+
+                    vertexIndexAttribute->ConvertValue<int32_t, 1>(mappedIndex, &bakedVertexIndex);
+
+                    if (bakedVertexIndex >= 0) {
+                        if ((size_t)bakedVertexIndex >= bakedVertexPoints.size()) {
+                            bakedVertexPoints.resize(bakedVertexIndex + 1, -1);
+                        }
+                        bakedVertexPoints[bakedVertexIndex] = i;
+                    }
+                }
             }
 
             for (uint32_t i = 0; i < dracoMesh->num_faces(); ++i) {
@@ -509,6 +566,48 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
                 part.triangleIndices.append(dracoFace[1].value());
                 part.triangleIndices.append(dracoFace[2].value());
             }
+
+            // the simplified levels of the mesh, their parts are found through their material like the faces above
+            if (vertexIndexAttribute) {
+                for (const auto& dracoChild : child.children) {
+                    if (dracoChild.name != "MeshLod") {
+                        continue;
+                    }
+                    HFMMeshLod lod;
+                    lod.partTriangleIndices.resize(data.extracted.mesh.parts.size());
+                    for (const auto& lodPart : dracoChild.children) {
+                        if (lodPart.name != "LodPart" || lodPart.properties.isEmpty()) {
+                            continue;
+                        }
+                        int partIndexPlusOne = materialTextureParts.value(QPair<int, int>(lodPart.properties[0].toInt(), 0));
+                        if (partIndexPlusOne == 0) {
+                            continue;
+                        }
+                        auto& triangleIndices = lod.partTriangleIndices[partIndexPlusOne - 1];
+                        for (const auto& lodPartChild : lodPart.children) {
+                            if (lodPartChild.name != "TriangleIndices") {
+                                continue;
+                            }
+                            auto bakedIndices = getIntVector(lodPartChild);
+                            for (int i = 0; (i + 2) < bakedIndices.size(); i += 3) {
+                                int triangle[3];
+                                bool isValid = true;
+                                for (int j = 0; j < 3; j++) {
+                                    int bakedIndex = bakedIndices[i + j];
+                                    triangle[j] = (bakedIndex >= 0 && (size_t)bakedIndex < bakedVertexPoints.size()) ? bakedVertexPoints[bakedIndex] : -1;
+                                    isValid = isValid && triangle[j] >= 0;
+                                }
+                                if (isValid) {
+                                    triangleIndices.append(triangle[0]);
+                                    triangleIndices.append(triangle[1]);
+                                    triangleIndices.append(triangle[2]);
+                                }
+                            }
+                        }
+                    }
+                    data.extracted.mesh.lods.append(lod);
+                }
+            }
         }
     }
 
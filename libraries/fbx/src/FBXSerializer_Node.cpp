@@ -21,6 +21,8 @@
 #include <QtCore/QtEndian>
 #include <QtCore/QFileInfo>
 
+#include <zlib.h>
+
 #include <shared/NsightHelpers.h>
 #include <hfm/ModelFormatLogging.h>
 
@@ -34,6 +36,36 @@ int streamSize() {
     return 1;
 }
 
+// Inflates a zlib compressed array of the file straight into its values. The files are parsed from memory, so the compressed
+// data is also read from where it is in the buffer rather than from a copy
+static bool inflateBinaryArray(QIODevice* device, quint32 compressedLength, char* data, int size) {
+    hifi::ByteArray compressedCopy;
+    const char* compressed;
+    auto buffer = qobject_cast<QBuffer*>(device);
+    if (buffer && buffer->pos() + compressedLength <= buffer->size()) {
+        compressed = buffer->data().constData() + buffer->pos();
+        buffer->seek(buffer->pos() + compressedLength);
+    } else {
+        compressedCopy = device->read(compressedLength);
+        if ((quint32)compressedCopy.size() != compressedLength) {
+            return false;
+        }
+        compressed = compressedCopy.constData();
+    }
+
+    z_stream stream {};
+    stream.next_in = (Bytef*)compressed;
+    stream.avail_in = compressedLength;
+    stream.next_out = (Bytef*)data;
+    stream.avail_out = (uInt)size;
+    if (inflateInit(&stream) != Z_OK) {
+        return false;
+    }
+    int result = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+    return result == Z_STREAM_END && stream.total_out == (uLong)size;
+}
+
 template<class T>
 QVariant readBinaryArray(QDataStream& in, int& position) {
     quint32 arrayLength;
@@ -53,27 +85,21 @@ QVariant readBinaryArray(QDataStream& in, int& position) {
 
     QVector<T> values;
     if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
+        // the values are read straight into the array, without going through an intermediate buffer
         values.resize(arrayLength);
-        hifi::ByteArray arrayData;
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
+        char* arrayData = reinterpret_cast<char*>(values.data());
+        int arraySize = (int)(sizeof(T) * arrayLength);
+        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG && arraySize == 0) {
+            in.skipRawData(compressedLength);
             position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
+        } else if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+            if (!inflateBinaryArray(in.device(), compressedLength, arrayData, arraySize)) {
                 throw QString("corrupt fbx file");
             }
-        } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
-        }
-
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
+            position += compressedLength;
+        } else if (arraySize > 0) {
+            position += arraySize;
+            in.readRawData(arrayData, arraySize);
         }
     } else {
         values.reserve(arrayLength);
@@ -214,6 +240,7 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
     node.name = in.device()->read(nameLength);
     position += nameLength;
 
+    node.properties.reserve((int)propertyCount);
     for (quint32 i = 0; i < propertyCount; i++) {
         node.properties.append(parseBinaryFBXProperty(in, position));
     }
@@ -11,8 +11,11 @@
 
 #include "GLTFSerializer.h"
 
+#include <type_traits>
+
 #include <QtCore/QBuffer>
 #include <QtCore/QIODevice>
+#include <QtCore/QtEndian>
 #include <QtCore/QEventLoop>
 #include <QtCore/qjsondocument.h>
 #include <QtCore/qjsonobject.h>
@@ -148,27 +151,33 @@ bool GLTFSerializer::getObjectArrayVal(const QJsonObject& object, const QString&
     return _defined;
 }
 
+// A binary glTF is a 12 byte header followed by its chunks, the JSON and then the binary buffer, each with its length
+// and type. The chunks are views into the data, which is kept for as long as the serializer, rather than copies of it
 hifi::ByteArray GLTFSerializer::setGLBChunks(const hifi::ByteArray& data) {
-    int byte = 4; 
-    int jsonStart = data.indexOf("JSON", Qt::CaseSensitive);
-    int binStart = data.indexOf("BIN", Qt::CaseSensitive);
-    int jsonLength, binLength;
-    hifi::ByteArray jsonLengthChunk, binLengthChunk;
-
-    jsonLengthChunk = data.mid(jsonStart - byte, byte);
-    QDataStream tempJsonLen(jsonLengthChunk);
-    tempJsonLen.setByteOrder(QDataStream::LittleEndian);
-    tempJsonLen >> jsonLength;
-    hifi::ByteArray jsonChunk = data.mid(jsonStart + byte, jsonLength);
-
-    if (binStart != -1) {
-        binLengthChunk = data.mid(binStart - byte, byte);
-
-        QDataStream tempBinLen(binLengthChunk);
-        tempBinLen.setByteOrder(QDataStream::LittleEndian);
-        tempBinLen >> binLength;
-
-        _glbBinary = data.mid(binStart + byte, binLength);
+    static const int GLB_HEADER_SIZE = 12;
+    static const int GLB_CHUNK_HEADER_SIZE = 8;
+    static const quint32 GLB_CHUNK_TYPE_JSON = 0x4E4F534A;
+    static const quint32 GLB_CHUNK_TYPE_BIN = 0x004E4942;
+
+    _glbData = data;
+    _glbBinary.clear();
+    hifi::ByteArray jsonChunk;
+    int offset = GLB_HEADER_SIZE;
+    while (offset + GLB_CHUNK_HEADER_SIZE <= _glbData.size()) {
+        quint32 chunkLength = qFromLittleEndian<quint32>(_glbData.constData() + offset);
+        quint32 chunkType = qFromLittleEndian<quint32>(_glbData.constData() + offset + 4);
+        offset += GLB_CHUNK_HEADER_SIZE;
+        if (chunkLength > (quint32)(_glbData.size() - offset)) {
+            qCWarning(modelformat) << "Truncated GLB chunk in" << _url;
+            break;
+        }
+        hifi::ByteArray chunk = hifi::ByteArray::fromRawData(_glbData.constData() + offset, (int)chunkLength);
+        if (chunkType == GLB_CHUNK_TYPE_JSON && jsonChunk.isEmpty()) {
+            jsonChunk = chunk;
+        } else if (chunkType == GLB_CHUNK_TYPE_BIN && _glbBinary.isEmpty()) {
+            _glbBinary = chunk;
+        }
+        offset += (int)chunkLength;
     }
     return jsonChunk;
 }
@@ -387,6 +396,7 @@ bool GLTFSerializer::addBufferView(const QJsonObject& object) {
     getIntVal(object, "buffer", bufferview.buffer, bufferview.defined);
     getIntVal(object, "byteLength", bufferview.byteLength, bufferview.defined);
     getIntVal(object, "byteOffset", bufferview.byteOffset, bufferview.defined);
+    getIntVal(object, "byteStride", bufferview.byteStride, bufferview.defined);
     getIntVal(object, "target", bufferview.target, bufferview.defined);
     
     _file.bufferviews.push_back(bufferview);
@@ -1752,7 +1762,10 @@ HFMTexture GLTFSerializer::getHFMTexture(const GLTFTexture& texture) {
             int offset = imagesBufferview.byteOffset;
             int length = imagesBufferview.byteLength;
 
-            fbxtex.content = _glbBinary.mid(offset, length);
+            // the texture outlives the data of the file, so its content is copied out of it
+            if (offset >= 0 && length >= 0 && offset + length <= _glbBinary.size()) {
+                fbxtex.content = hifi::ByteArray(_glbBinary.constData() + offset, length);
+            }
             fbxtex.filename = textureUrl.toEncoded().append(texture.source);
         }
 
@@ -1834,15 +1847,8 @@ void GLTFSerializer::setHFMMaterial(HFMMaterial& hfmMat, const GLTFMaterial& mat
 }
 
 template<typename T, typename L>
-bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int count,
+bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int count, int byteStride,
                            QVector<L>& outarray, int accessorType) {
-    
-    QDataStream blobstream(bin);
-    blobstream.setByteOrder(QDataStream::LittleEndian);
-    blobstream.setVersion(QDataStream::Qt_5_9);
-    blobstream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::SinglePrecision);
-    blobstream.skipRawData(byteOffset);
-
     int bufferCount = 0;
     switch (accessorType) {
     case GLTFAccessorType::SCALAR:
@@ -1868,45 +1874,62 @@ bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int c
         break;
     default:
         qWarning(modelformat) << "Unknown accessorType: " << accessorType;
-        blobstream.setDevice(nullptr);
         return false;
     }
+    if (count <= 0) {
+        return true;
+    }
+
+    // the elements are packed together unless the buffer view interleaves them with others
+    const int elementSize = bufferCount * (int)sizeof(T);
+    if (byteStride < elementSize) {
+        byteStride = elementSize;
+    }
+    if (byteOffset < 0 || (qint64)byteOffset + (qint64)(count - 1) * byteStride + elementSize > (qint64)bin.size()) {
+        return false;
+    }
+
+    // the buffers are little endian, like all the platforms we run on
+    const char* data = bin.constData() + byteOffset;
+    int start = outarray.size();
+    outarray.resize(start + count * bufferCount);
+    L* out = outarray.data() + start;
+    const bool isSameLayout = std::is_same<T, L>::value ||
+        (std::is_integral<T>::value && std::is_integral<L>::value && sizeof(T) == sizeof(L));
+    if (isSameLayout && byteStride == elementSize) {
+        memcpy(out, data, (size_t)count * elementSize);
+        return true;
+    }
     for (int i = 0; i < count; ++i) {
+        const char* element = data + (qint64)i * byteStride;
         for (int j = 0; j < bufferCount; ++j) {
-            if (!blobstream.atEnd()) {
-                T value;
-                blobstream >> value;
-                outarray.push_back(value);
-            } else {
-                blobstream.setDevice(nullptr);
-                return false;
-            }
+            T value;
+            memcpy(&value, element + j * sizeof(T), sizeof(T));
+            *out++ = (L)value;
         }
     }
-
-    blobstream.setDevice(nullptr);
     return true;
 }
 template<typename T>
-bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int count,
+bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int count, int byteStride,
                                 QVector<T>& outarray, int accessorType, int componentType) {
     
     switch (componentType) {
     case GLTFAccessorComponentType::BYTE: {}
     case GLTFAccessorComponentType::UNSIGNED_BYTE: {
-        return readArray<uchar>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<uchar>(bin, byteOffset, count, byteStride, outarray, accessorType);
     }
     case GLTFAccessorComponentType::SHORT: {
-        return readArray<short>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<short>(bin, byteOffset, count, byteStride, outarray, accessorType);
     }
     case GLTFAccessorComponentType::UNSIGNED_INT: {
-        return readArray<uint>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<uint>(bin, byteOffset, count, byteStride, outarray, accessorType);
     }
     case GLTFAccessorComponentType::UNSIGNED_SHORT: {
-        return readArray<ushort>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<ushort>(bin, byteOffset, count, byteStride, outarray, accessorType);
     }
     case GLTFAccessorComponentType::FLOAT: {
-        return readArray<float>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<float>(bin, byteOffset, count, byteStride, outarray, accessorType);
     }
     }
     return false;
@@ -1922,8 +1945,8 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
         int accBoffset = accessor.defined["byteOffset"] ? accessor.byteOffset : 0;
 
-        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, accessor.count, outarray, accessor.type,
-                                 accessor.componentType);
+        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, accessor.count, bufferview.byteStride,
+                                 outarray, accessor.type, accessor.componentType);
     } else {
         for (int i = 0; i < accessor.count; ++i) {
             T value;
@@ -1942,7 +1965,7 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
             int accSIBoffset = accessor.sparse.indices.defined["byteOffset"] ? accessor.sparse.indices.byteOffset : 0;
 
             success = addArrayOfType(sparseIndicesBuffer.blob, sparseIndicesBufferview.byteOffset + accSIBoffset,
-                                     accessor.sparse.count, out_sparse_indices_array, GLTFAccessorType::SCALAR,
+                                     accessor.sparse.count, 0, out_sparse_indices_array, GLTFAccessorType::SCALAR,
                                      accessor.sparse.indices.componentType);
             if (success) {
                 QVector<T> out_sparse_values_array;
@@ -1953,7 +1976,8 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
                 int accSVBoffset = accessor.sparse.values.defined["byteOffset"] ? accessor.sparse.values.byteOffset : 0;
 
                 success = addArrayOfType(sparseValuesBuffer.blob, sparseValuesBufferview.byteOffset + accSVBoffset,
-                                         accessor.sparse.count, out_sparse_values_array, accessor.type, accessor.componentType);
+                                         accessor.sparse.count, 0, out_sparse_values_array, accessor.type,
+                                         accessor.componentType);
 
                 if (success) {
                     for (int i = 0; i < accessor.sparse.count; ++i) {
@@ -1,5 +1,6 @@
 #include "GLShaders.h"
 
+#include "GLHelpers.h"
 #include "GLLogging.h"
 
 #include <QtCore/QJsonDocument>
@@ -436,6 +437,14 @@ const QString& getShaderCacheFile() {
 static const char* SHADER_JSON_TYPE_KEY = "type";
 static const char* SHADER_JSON_SOURCE_KEY = "source";
 static const char* SHADER_JSON_DATA_KEY = "data";
+static const char* SHADER_JSON_DRIVER_KEY = "driver";
+static const char* SHADER_JSON_PROGRAMS_KEY = "programs";
+
+// The binaries are only good for the driver that made them, the cache starts over with any other
+static QString getShaderCacheDriver() {
+    const auto& contextInfo = ContextInfo::get(true);
+    return QString("%1 %2 %3").arg(contextInfo.vendor.c_str(), contextInfo.renderer.c_str(), contextInfo.version.c_str());
+}
 
 void gl::loadShaderCache(ShaderCache& cache) {
 #if !defined(DISABLE_QML)
@@ -443,8 +452,14 @@ void gl::loadShaderCache(ShaderCache& cache) {
     if (QFileInfo(shaderCacheFile).exists()) {
         QString json = FileUtils::readFile(shaderCacheFile);
         auto root = QJsonDocument::fromJson(json.toUtf8()).object();
-        for (const auto& qhash : root.keys()) {
-            auto programObject = root[qhash].toObject();
+        auto driver = getShaderCacheDriver();
+        if (root[SHADER_JSON_DRIVER_KEY].toString() != driver) {
+            qCDebug(glLogging) << "Ignoring the shader cache of another driver than" << driver;
+            return;
+        }
+        auto programs = root[SHADER_JSON_PROGRAMS_KEY].toObject();
+        for (const auto& qhash : programs.keys()) {
+            auto programObject = programs[qhash].toObject();
             QByteArray qbinary = QByteArray::fromBase64(programObject[SHADER_JSON_DATA_KEY].toString().toUtf8());
             std::string hash = qhash.toStdString();
             auto& cachedShader = cache[hash];
@@ -471,7 +486,10 @@ void gl::saveShaderCache(const ShaderCache& cache) {
             qentry[SHADER_JSON_DATA_KEY] = QByteArray{ binary.data(), (int)binary.size() }.toBase64();
             variantMap[key.c_str()] = qentry;
         }
-        json = QJsonDocument::fromVariant(variantMap).toJson(QJsonDocument::Indented);
+        QVariantMap rootMap;
+        rootMap[SHADER_JSON_DRIVER_KEY] = getShaderCacheDriver();
+        rootMap[SHADER_JSON_PROGRAMS_KEY] = variantMap;
+        json = QJsonDocument::fromVariant(rootMap).toJson(QJsonDocument::Indented);
     }
 
     if (!json.isEmpty()) {
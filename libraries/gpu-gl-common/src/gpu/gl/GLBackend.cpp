@@ -165,6 +165,7 @@ GLBackend::GLBackend() {
 GLBackend::~GLBackend() {}
 
 void GLBackend::shutdown() {
+    processFramebufferReads(true);
     if (_mipGenerationFramebufferId) {
         glDeleteFramebuffers(1, &_mipGenerationFramebufferId);
         _mipGenerationFramebufferId = 0;
@@ -881,6 +882,8 @@ void GLBackend::recycle() const {
         _previousFrameTrashes.back().fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
     }
     
+    processFramebufferReads();
+
     _textureManagement._transferEngine->manageMemory();
 }
 
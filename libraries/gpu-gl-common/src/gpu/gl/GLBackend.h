@@ -112,6 +112,11 @@ public:
                                      const Vec4i& region,
                                      QImage& destImage) final override;
 
+    // Reads the pixels into a pixel pack buffer, the handler gets them once its fence has been signaled
+    void readFramebufferAsync(const FramebufferPointer& srcFramebuffer,
+                              const Vec4i& region,
+                              const FramebufferReadHandler& handler) final override;
+
     // this is the maximum numeber of available input buffers
     size_t getNumInputBuffers() const { return _input._invalidBuffers.size(); }
 
@@ -306,6 +311,15 @@ protected:
     std::list<std::string> profileRanges;
     mutable std::list<std::function<void()>> _lambdaQueue;
 
+    struct FramebufferRead {
+        GLuint buffer { 0 };
+        GLsync fence { nullptr };
+        size_t numPixels { 0 };
+        FramebufferReadHandler handler;
+    };
+    mutable std::list<FramebufferRead> _framebufferReads;
+    void processFramebufferReads(bool cancel = false) const;
+
     void renderPassTransfer(const Batch& batch);
     void renderPassDraw(const Batch& batch);
 
@@ -355,7 +369,7 @@ protected:
     } _input;
 
     virtual void initTransform() = 0;
-    void killTransform();
+    virtual void killTransform();
     // Synchronize the state cache of this Backend with the actual real state of the GL Context
     void syncTransformStateCache();
     virtual void updateTransform(const Batch& batch) = 0;
@@ -398,6 +412,9 @@ protected:
 
         GLuint _objectBuffer{ 0 };
         GLuint _cameraBuffer{ 0 };
+        // where the cameras of the current batch are when the backend streams them rather than using _cameraBuffer
+        mutable GLuint _cameraStreamBuffer{ 0 };
+        mutable size_t _cameraStreamOffset{ 0 };
         GLuint _drawCallInfoBuffer{ 0 };
         GLuint _objectBufferTexture{ 0 };
         size_t _cameraUboSize{ 0 };
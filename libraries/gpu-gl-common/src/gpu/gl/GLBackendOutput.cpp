@@ -204,3 +204,65 @@ void GLBackend::downloadFramebuffer(const FramebufferPointer& srcFramebuffer, co
 
     (void) CHECK_GL_ERROR();
 }
+
+void GLBackend::readFramebufferAsync(const FramebufferPointer& srcFramebuffer, const Vec4i& region, const FramebufferReadHandler& handler) {
+#if !defined(USE_GLES)
+    auto readFBO = getFramebufferID(srcFramebuffer);
+    if (!srcFramebuffer || !readFBO || region.z <= 0 || region.w <= 0) {
+        return;
+    }
+    if ((srcFramebuffer->getWidth() < (region.x + region.z)) || (srcFramebuffer->getHeight() < (region.y + region.w))) {
+        qCWarning(gpugllogging) << "GLBackend::readFramebufferAsync : srcFramebuffer is too small to provide the region queried";
+        return;
+    }
+
+    FramebufferRead read;
+    read.numPixels = (size_t)region.z * (size_t)region.w;
+    read.handler = handler;
+
+    glGenBuffers(1, &read.buffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, read.numPixels * sizeof(float), nullptr, GL_STREAM_READ);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, readFBO);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glReadPixels(region.x, region.y, region.z, region.w, GL_RED, GL_FLOAT, nullptr);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    read.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _framebufferReads.push_back(read);
+
+    (void) CHECK_GL_ERROR();
+#endif
+}
+
+void GLBackend::processFramebufferReads(bool cancel) const {
+    while (!_framebufferReads.empty()) {
+        auto& read = _framebufferReads.front();
+        if (!cancel) {
+            // the reads finish in order, once one isn't there yet neither are the ones after it
+            auto result = glClientWaitSync(read.fence, 0, 0);
+            if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+                break;
+            }
+
+            std::vector<float> pixels(read.numPixels);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer);
+            auto data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, read.numPixels * sizeof(float), GL_MAP_READ_BIT);
+            if (data) {
+                memcpy(pixels.data(), data, read.numPixels * sizeof(float));
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            if (data && read.handler) {
+                read.handler(pixels);
+            }
+        }
+
+        glDeleteSync(read.fence);
+        glDeleteBuffers(1, &read.buffer);
+        _framebufferReads.pop_front();
+    }
+    (void) CHECK_GL_ERROR();
+}
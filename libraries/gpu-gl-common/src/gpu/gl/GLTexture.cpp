@@ -213,6 +213,20 @@ void GLVariableAllocationSupport::decrementPopulatedSize(Size delta) const {
     }
 }
 
+// How long a texture keeps the mips it was last asked for once no view draws it anymore
+static const uint32_t MAX_FRAMES_WITHOUT_DESIRED_MIP_REQUEST = 90;
+
+void GLVariableAllocationSupport::updateDesiredMip(uint16 requestedMip) {
+    if (requestedMip != Texture::NO_DESIRED_MIP) {
+        _hasDesiredMipRequests = true;
+        _framesSinceDesiredMipRequest = 0;
+        _desiredMip = std::min(requestedMip, _maxAllocatedMip);
+    } else if (_hasDesiredMipRequests && ++_framesSinceDesiredMipRequest > MAX_FRAMES_WITHOUT_DESIRED_MIP_REQUEST) {
+        // out of sight, its mips only stay while there's room for them
+        _desiredMip = _maxAllocatedMip;
+    }
+}
+
 void GLVariableAllocationSupport::sanityCheck() const {
     if (_populatedMip < _allocatedMip) {
         qCWarning(gpugllogging) << "Invalid mip levels";
@@ -262,7 +276,14 @@ TransferJob::TransferJob(const Texture& texture,
     };
 
     _transferLambda = [=](const TexturePointer& texture) {
-        if (_mipData) {
+        if (_stagingBuffer) {
+            auto gltexture = Backend::getGPUObject<GLTexture>(*texture);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _stagingBuffer);
+            gltexture->copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, internalFormat, format,
+                type, _stagingSize, reinterpret_cast<const void*>(_stagingOffset));
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            _stagingBuffer = 0;
+        } else if (_mipData) {
             auto gltexture = Backend::getGPUObject<GLTexture>(*texture);
             gltexture->copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, internalFormat, format,
                 type, _mipData->size(), _mipData->readData());
@@ -281,3 +302,18 @@ TransferJob::~TransferJob() {
     Backend::texturePendingGPUTransferMemSize.update(_transferSize, 0);
 }
 
+void TransferJob::stage(GLTextureStagingRing& ring) {
+    if (!_mipData) {
+        return;
+    }
+    auto size = _mipData->size();
+    if (!ring.allocate(size, _stagingOffset, _stagingSpan)) {
+        // uploads from the buffered data instead
+        return;
+    }
+    memcpy(ring.getPointer(_stagingOffset), _mipData->readData(), size);
+    _stagingBuffer = ring.getBuffer();
+    _stagingSize = size;
+    _mipData.reset();
+}
+
@@ -14,6 +14,7 @@
 #include "GLShared.h"
 #include "GLBackend.h"
 #include "GLTexelFormat.h"
+#include <deque>
 #include <thread>
 
 namespace gpu { namespace gl {
@@ -52,6 +53,50 @@ private:
     std::list<TextureWeakPointer> _registeredTextures;
 };
 
+// A fixed size buffer, persistently mapped, that the buffering thread copies the mip data into and the transfers
+// upload from as a pixel unpack buffer, instead of the driver copying the data once more from client memory.
+// The ranges of the ring are reused in order, once the fence of the frame that uploaded them has signaled
+class GLTextureStagingRing {
+public:
+    using Pointer = std::shared_ptr<GLTextureStagingRing>;
+
+    // On the GL thread, returns null when persistent mapping isn't available
+    static Pointer create(size_t size);
+    ~GLTextureStagingRing();
+
+    GLuint getBuffer() const { return _buffer; }
+    uint8_t* getPointer(size_t offset) const { return _mapped + offset; }
+    size_t getUsedSize() const;
+
+    // On any thread, reserves size contiguous bytes at offset, span being what they take from the ring with their padding.
+    // Returns false while the ring is too full for them
+    bool allocate(size_t size, size_t& offset, size_t& span);
+
+    // On the GL thread, once the upload from a range was issued, or dropped
+    void release(size_t span);
+    // On the GL thread after the transfers of a frame, fences the ranges released since the last one and frees the ones
+    // whose fence has signaled
+    void fenceAndRetire();
+
+private:
+    GLTextureStagingRing(GLuint buffer, uint8_t* mapped, size_t size) : _buffer(buffer), _mapped(mapped), _size(size) {}
+
+    struct Fence {
+        GLsync sync;
+        size_t span;
+    };
+
+    const GLuint _buffer;
+    uint8_t* const _mapped;
+    const size_t _size;
+
+    mutable Mutex _mutex;
+    size_t _head { 0 };
+    size_t _used { 0 };
+    size_t _released { 0 };
+    std::deque<Fence> _fences;
+};
+
 /**
   A transfer job encapsulates an individual piece of work required to upload texture data to the GPU.  
   The work can be broken down into two parts, expressed as lambdas.  The buffering lambda is repsonsible
@@ -77,6 +122,11 @@ private:
     bool _bufferingRequired{ true };
     Lambda _transferLambda{ [](const TexturePointer&) {} };
     Lambda _bufferingLambda{ [](const TexturePointer&) {} };
+    // Where the buffered data was copied to in the staging ring, if it was
+    GLuint _stagingBuffer{ 0 };
+    size_t _stagingOffset{ 0 };
+    size_t _stagingSize{ 0 };
+    size_t _stagingSpan{ 0 };
 public:
     TransferJob(const TransferJob& other) = delete;
     TransferJob(uint16_t sourceMip, const std::function<void()>& transferLambda);
@@ -87,6 +137,10 @@ public:
     bool bufferingRequired() const { return _bufferingRequired; }
     void buffer(const TexturePointer& texture) { _bufferingLambda(texture); }
     void transfer(const TexturePointer& texture) { _transferLambda(texture); }
+    // On the buffering thread after buffer, moves the buffered data into the staging ring when there's room for it
+    void stage(GLTextureStagingRing& ring);
+    // The part of the staging ring held until the transfer is issued
+    size_t stagingSpan() const { return _stagingSpan; }
 };
 
 using TransferJobPointer = std::shared_ptr<TransferJob>;
@@ -102,10 +156,19 @@ public:
 
     void sanityCheck() const;
     uint16 populatedMip() const { return _populatedMip; }
+    uint16 allocatedMip() const { return _allocatedMip; }
     bool canPromote() const { return _allocatedMip > _minAllocatedMip; }
     bool canDemote() const { return _allocatedMip < _maxAllocatedMip; }
     bool hasPendingTransfers() const { return _populatedMip > _allocatedMip; }
 
+    // Once a frame, with the mip the views drawing the texture asked for since the last frame
+    void updateDesiredMip(uint16 requestedMip);
+    uint16 desiredMip() const { return _desiredMip; }
+    // Whether the views drawing the texture need finer mips than the allocated ones
+    bool wantsPromote() const { return canPromote() && _allocatedMip > _desiredMip; }
+    // Whether the texture has finer mips than the views drawing it need, the first to go when memory runs out
+    bool hasUnwantedMips() const { return canDemote() && _allocatedMip < _desiredMip; }
+
     virtual size_t promote() = 0;
     virtual size_t demote() = 0;
 
@@ -136,6 +199,11 @@ protected:
     // The lowest (highest resolution) mip that we will support, relative to the number
     // of mips in the gpu::Texture object
     uint16 _minAllocatedMip { 0 };
+    // The lowest mip the views drawing the texture need, relative to the number of mips in
+    // the gpu::Texture object.  All of them until a view asks
+    uint16 _desiredMip { 0 };
+    bool _hasDesiredMipRequests { false };
+    uint32_t _framesSinceDesiredMipRequest { 0 };
 };
 
 class GLTexture : public GLObject<Texture> {
@@ -19,8 +19,15 @@
 #define MAX_RESOURCE_TEXTURES_PER_FRAME 2
 #define NO_BUFFER_WORK_SLEEP_TIME_MS 2
 #define THREADED_TEXTURE_BUFFERING 1
+#define STAGING_RING_SIZE_MB ((size_t)16)
+#define MAX_TRANSFER_BYTES_PER_FRAME_MB ((size_t)2)
+#define STAGING_RING_ALIGNMENT ((size_t)64)
 
 static const size_t DEFAULT_ALLOWED_TEXTURE_MEMORY = MB_TO_BYTES(DEFAULT_ALLOWED_TEXTURE_MEMORY_MB);
+// Room for the jobs being buffered and the uploads of the frames still in flight
+static const size_t STAGING_RING_SIZE = MB_TO_BYTES(STAGING_RING_SIZE_MB);
+// Past this the rest of the buffered jobs wait for the next frame, there's always at least one upload per frame
+static const size_t MAX_TRANSFER_BYTES_PER_FRAME = MB_TO_BYTES(MAX_TRANSFER_BYTES_PER_FRAME_MB);
 
 namespace gpu { namespace gl {
 
@@ -38,6 +45,12 @@ struct LessPairSecond {
     bool operator()(const T& a, const T& b) { return a.second < b.second; }
 };
 
+// Promote the textures missing the most of the mips their views need first, the smallest first among those
+static float evalPromotePriority(const GLTexture* gltexture, const GLVariableAllocationSupport* vartexture) {
+    float missingMips = (float)(vartexture->allocatedMip() - vartexture->desiredMip());
+    return missingMips + 1.0f / (float)(gltexture->size() + 1);
+}
+
 using QueuePair = std::pair<TextureWeakPointer, float>;
 // Contains a priority sorted list of textures on which work is to be done over many frames
 // Uses a weak pointer to the texture to avoid keeping it in scope if the client stops using it
@@ -107,7 +120,12 @@ private:
     Mutex _bufferMutex;
     // The buffering thread which drains the _activeBufferQueue and populates the _activeTransferQueue
     TextureBufferThread* _transferThread{ nullptr };
-    // The amount of buffering work currently represented by the _activeBufferQueue
+    // Where the buffering thread copies the mips to be uploaded, when the GL has persistent mapping. Created with the
+    // buffering thread
+    GLTextureStagingRing::Pointer _stagingRing;
+    bool _stagingRingCreated{ false };
+    // The amount of buffering work currently represented by the _activeBufferQueue and the _activeTransferQueue, so that
+    // the buffering doesn't run ahead of the uploads held back by MAX_TRANSFER_BYTES_PER_FRAME
     std::atomic<size_t> _queuedBufferSize{ 0 };
     // This contains a map of all textures to queues of pending transfer jobs.  While in the transfer state, this map is used to
     // populate the _activeBufferQueue up to the limit specified in GLVariableAllocationTexture::MAX_BUFFER_SIZE
@@ -160,12 +178,14 @@ void GLTextureTransferEngineDefault::shutdown() {
         _transferThread = nullptr;
     }
 #endif
+    _stagingRing.reset();
 }
 
 void GLTextureTransferEngineDefault::manageMemory() {
     PROFILE_RANGE(render_gpu_gl, __FUNCTION__);
     // reset the count used to limit the number of textures created per frame
     resetFrameTextureCreated();
+    Backend::textureFrameTransferMemSize.set(0);
     // Determine the current memory management state.  It will be either idle (no work to do),
     // undersubscribed (need to do more allocation) or transfer (need to upload content from the
     // backing store to the GPU
@@ -200,6 +220,7 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vartexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
         vartexture->sanityCheck();
+        vartexture->updateDesiredMip(texture->takeDesiredMip());
 
         // Track how much the texture thinks it should be using
         idealMemoryAllocation += texture->evalTotalSize();
@@ -208,7 +229,7 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
         if (vartexture->canDemote()) {
             canDemote |= true;
         }
-        if (vartexture->canPromote()) {
+        if (vartexture->wantsPromote()) {
             canPromote |= true;
         }
         if (vartexture->hasPendingTransfers()) {
@@ -254,9 +275,8 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
         for (const auto& texture : strongTextures) {
             GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
             GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
-            if (MemoryPressureState::Undersubscribed == _memoryPressureState && vargltexture->canPromote()) {
-                // Promote smallest first
-                _promoteQueue.push({ texture, 1.0f / (float)gltexture->size() });
+            if (MemoryPressureState::Undersubscribed == _memoryPressureState && vargltexture->wantsPromote()) {
+                _promoteQueue.push({ texture, evalPromotePriority(gltexture, vargltexture) });
             } else if (MemoryPressureState::Transfer == _memoryPressureState && vargltexture->hasPendingTransfers()) {
                 populateTransferQueue(texture);
             }
@@ -266,6 +286,10 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
 
 // Manage the _activeBufferQueue and _activeTransferQueue queues
 void GLTextureTransferEngineDefault::processTransferQueues() {
+    if (!_stagingRingCreated) {
+        _stagingRingCreated = true;
+        _stagingRing = GLTextureStagingRing::create(STAGING_RING_SIZE);
+    }
 #if THREADED_TEXTURE_BUFFERING
     if (!_transferThread) {
         _transferThread = new TextureBufferThread(*this);
@@ -284,7 +308,8 @@ void GLTextureTransferEngineDefault::processTransferQueues() {
 #endif
 
     // Take any tasks which have completed buffering and process them, uploading the buffered
-    // data to the GPU.  Drains the _activeTransferQueue
+    // data to the GPU, up to MAX_TRANSFER_BYTES_PER_FRAME.  The rest go back to the front of
+    // the _activeTransferQueue for the next frame
     {
         ActiveTransferQueue activeTransferQueue;
         {
@@ -292,19 +317,41 @@ void GLTextureTransferEngineDefault::processTransferQueues() {
             activeTransferQueue.swap(_activeTransferQueue);
         }
 
+        size_t frameTransferSize{ 0 };
         while (!activeTransferQueue.empty()) {
             const auto& activeTransferJob = activeTransferQueue.front();
             const auto& texturePointer = activeTransferJob.first;
             GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texturePointer);
             GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
             const auto& tranferJob = activeTransferJob.second;
+            const auto transferSize = tranferJob->bufferingRequired() ? tranferJob->size() : 0;
+            if (frameTransferSize > 0 && frameTransferSize + transferSize > MAX_TRANSFER_BYTES_PER_FRAME) {
+                break;
+            }
             if (tranferJob->sourceMip() < vargltexture->populatedMip()) {
                 tranferJob->transfer(texturePointer);
+                frameTransferSize += transferSize;
+            }
+            if (_stagingRing && tranferJob->stagingSpan() > 0) {
+                _stagingRing->release(tranferJob->stagingSpan());
             }
+            Q_ASSERT(_queuedBufferSize >= transferSize);
+            _queuedBufferSize -= transferSize;
             // The pop_front MUST be the last call since all of these varaibles in scope are
             // references that will be invalid after the pop
             activeTransferQueue.pop_front();
         }
+        Backend::textureFrameTransferMemSize.set(frameTransferSize);
+
+        if (!activeTransferQueue.empty()) {
+            Lock lock(_bufferMutex);
+            _activeTransferQueue.splice(_activeTransferQueue.begin(), activeTransferQueue);
+        }
+    }
+
+    if (_stagingRing) {
+        _stagingRing->fenceAndRetire();
+        Backend::textureStagingGPUMemSize.set(_stagingRing->getUsedSize());
     }
 
     // If we have no more work in any of the structures, reset the memory state to idle to
@@ -394,10 +441,10 @@ bool GLTextureTransferEngineDefault::processActiveBufferQueue() {
         if (!transferJob->bufferingRequired()) {
             continue;
         }
-        const auto& transferSize = transferJob->size();
         transferJob->buffer(texture);
-        Q_ASSERT(_queuedBufferSize >= transferSize);
-        _queuedBufferSize -= transferSize;
+        if (_stagingRing) {
+            transferJob->stage(*_stagingRing);
+        }
     }
 
     {
@@ -444,9 +491,8 @@ void GLTextureTransferEngineDefault::processPromotes() {
         auto originalSize = gltexture->size();
         vartexture->promote();
         auto allocationDelta = gltexture->size() - originalSize;
-        if (vartexture->canPromote()) {
-            // Promote smallest first
-            _promoteQueue.push({ texture, 1.0f / (float)gltexture->size() });
+        if (vartexture->wantsPromote()) {
+            _promoteQueue.push({ texture, evalPromotePriority(gltexture, vartexture) });
         }
         allocatedBytes += allocationDelta;
         if (++allocations >= MAX_ALLOCATIONS_PER_FRAME) {
@@ -465,29 +511,126 @@ void GLTextureTransferEngineDefault::processPromotes() {
 }
 
 void GLTextureTransferEngineDefault::processDemotes(size_t reliefRequired, const std::vector<TexturePointer>& strongTextures) {
-    // Demote largest first
+    // Demote the textures with more mips than their views need first, then the others, largest first
+    ImmediateWorkQueue unwantedDemoteQueue;
     ImmediateWorkQueue demoteQueue;
     for (const auto& texture : strongTextures) {
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
-        if (vargltexture->canDemote()) {
+        if (vargltexture->hasUnwantedMips()) {
+            unwantedDemoteQueue.push({ texture, (float)gltexture->size() });
+        } else if (vargltexture->canDemote()) {
             demoteQueue.push({ texture, (float)gltexture->size() });
         }
     }
 
     size_t relieved = 0;
-    while (!demoteQueue.empty() && relieved < reliefRequired) {
-        {
-            const auto& target = demoteQueue.top();
-            const auto& texture = target.first;
-            GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
-            auto oldSize = gltexture->size();
-            GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
-            vargltexture->demote();
-            auto newSize = gltexture->size();
-            relieved += (oldSize - newSize);
+    for (auto queue : { &unwantedDemoteQueue, &demoteQueue }) {
+        while (!queue->empty() && relieved < reliefRequired) {
+            {
+                const auto& target = queue->top();
+                const auto& texture = target.first;
+                GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
+                auto oldSize = gltexture->size();
+                GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
+                vargltexture->demote();
+                auto newSize = gltexture->size();
+                relieved += (oldSize - newSize);
+            }
+            queue->pop();
         }
-        demoteQueue.pop();
+    }
+}
+
+GLTextureStagingRing::Pointer GLTextureStagingRing::create(size_t size) {
+#if !defined(USE_GLES)
+    if (!GLAD_GL_VERSION_4_4) {
+        return nullptr;
+    }
+
+    static const GLbitfield MAP_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, MAP_FLAGS);
+    auto mapped = static_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, MAP_FLAGS));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    (void)CHECK_GL_ERROR();
+    if (!mapped) {
+        qCWarning(gpugllogging) << "Failed to map the texture staging buffer, uploading the textures from client memory";
+        glDeleteBuffers(1, &buffer);
+        return nullptr;
+    }
+    return Pointer(new GLTextureStagingRing(buffer, mapped, size));
+#else
+    return nullptr;
+#endif
+}
+
+GLTextureStagingRing::~GLTextureStagingRing() {
+    for (const auto& fence : _fences) {
+        glDeleteSync(fence.sync);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _buffer);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glDeleteBuffers(1, &_buffer);
+}
+
+size_t GLTextureStagingRing::getUsedSize() const {
+    Lock lock(_mutex);
+    return _used;
+}
+
+bool GLTextureStagingRing::allocate(size_t size, size_t& offset, size_t& span) {
+    Lock lock(_mutex);
+    if (_used == 0) {
+        _head = 0;
+    }
+
+    // the bytes in use are the ones before the head, wrapping around, so the free ones start at the head
+    size_t start = (_head + STAGING_RING_ALIGNMENT - 1) & ~(STAGING_RING_ALIGNMENT - 1);
+    if (start + size > _size) {
+        start = 0;
+    }
+    size_t padding = (start >= _head) ? start - _head : _size - _head;
+    if (_used + padding + size > _size) {
+        return false;
+    }
+
+    offset = start;
+    span = padding + size;
+    _head = start + size;
+    _used += span;
+    return true;
+}
+
+void GLTextureStagingRing::release(size_t span) {
+    _released += span;
+}
+
+void GLTextureStagingRing::fenceAndRetire() {
+    if (_released > 0) {
+        _fences.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), _released });
+        _released = 0;
+    }
+
+    // the fences signal in order, once one hasn't the ones after it haven't either
+    size_t retired = 0;
+    while (!_fences.empty()) {
+        auto result = glClientWaitSync(_fences.front().sync, 0, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        glDeleteSync(_fences.front().sync);
+        retired += _fences.front().span;
+        _fences.pop_front();
+    }
+
+    if (retired > 0) {
+        Lock lock(_mutex);
+        Q_ASSERT(_used >= retired);
+        _used -= retired;
     }
 }
 
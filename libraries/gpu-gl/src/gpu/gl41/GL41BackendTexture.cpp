@@ -511,7 +511,7 @@ size_t GL41VariableAllocationTexture::promote() {
     Q_ASSERT(_allocatedMip > 0);
 
     uint16_t targetAllocatedMip = _allocatedMip - std::min<uint16_t>(_allocatedMip, 2);
-    targetAllocatedMip = std::max<uint16_t>(_minAllocatedMip, targetAllocatedMip);
+    targetAllocatedMip = std::max<uint16_t>(std::max(_minAllocatedMip, _desiredMip), targetAllocatedMip);
 
     GLuint oldId = _id;
     auto oldSize = _size;
@@ -40,6 +40,7 @@ GL45Backend::GL45Backend() : Parent() {
 
 void GL45Backend::recycle() const {
     Parent::recycle();
+    _transformRing.nextFrame();
 }
 
 void GL45Backend::draw(GLenum mode, uint32 numVertices, uint32 startVertex) {
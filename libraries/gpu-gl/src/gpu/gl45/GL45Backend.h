@@ -15,6 +15,7 @@
 #include <gpu/gl/GLBackend.h>
 #include <gpu/gl/GLTexture.h>
 
+#include <array>
 #include <thread>
 #include <gpu/TextureTable.h>
 
@@ -50,6 +51,7 @@ public:
 
     static const std::string GL45_VERSION;
     const std::string& getVersion() const override { return GL45_VERSION; }
+    bool supportsMultiDrawIndirect() const override { return true; }
 
     bool supportedTextureFormat(const gpu::Element& format) override;
 
@@ -263,8 +265,42 @@ protected:
     // Synchronize the state cache of this Backend with the actual real state of the GL Context
     void transferTransformState(const Batch& batch) const override;
     void initTransform() override;
+    void killTransform() override;
     void updateTransform(const Batch& batch) override;
 
+    // The cameras, object transforms and draw call infos of each batch are written straight into one persistently
+    // mapped buffer, split into a region for each frame in flight, rather than uploaded with a new buffer store for
+    // every batch. A region is written again once the fence for the frame that last used it has passed. A batch that
+    // doesn't fit in what is left of the region uploads into the plain transform buffers as before.
+    class TransformRing {
+    public:
+        static const size_t NUM_REGIONS { 3 };
+        static const size_t REGION_SIZE { 8 * 1024 * 1024 };
+
+        void init();
+        void kill();
+
+        // the offset in the buffer to write size bytes at, or INVALID_OFFSET if the region for this frame is full
+        size_t allocate(size_t size);
+        // fences the region of the frame just done, and waits for the next one to be free
+        void nextFrame();
+
+        bool isValid() const { return _mappedData != nullptr; }
+
+        GLuint _buffer { 0 };
+        uint8_t* _mappedData { nullptr };
+
+        // the buffer the draw call infos of the current batch are in
+        GLuint _drawCallInfoBuffer { 0 };
+
+    private:
+        size_t _alignment { 1 };
+        size_t _region { 0 };
+        size_t _offset { 0 };
+        std::array<GLsync, NUM_REGIONS> _fences {};
+    };
+    mutable TransformRing _transformRing;
+
     // Resource Stage
     bool bindResourceBuffer(uint32_t slot, const BufferPointer& buffer) override;
     void releaseResourceBuffer(uint32_t slot) override;
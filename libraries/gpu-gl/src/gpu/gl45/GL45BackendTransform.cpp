@@ -13,6 +13,80 @@
 using namespace gpu;
 using namespace gpu::gl45;
 
+// how long the wait for a region of the transform ring checks its fence for
+static const GLuint64 TRANSFORM_RING_WAIT_NSECS = 1000 * 1000;
+
+void GL45Backend::TransformRing::init() {
+    GLint uniformAlignment { 1 };
+    GLint storageAlignment { 1 };
+    GLint textureBufferAlignment { 1 };
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+    glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, &textureBufferAlignment);
+    _alignment = (size_t)std::max(std::max(uniformAlignment, storageAlignment), std::max(textureBufferAlignment, 1));
+
+    static const GLbitfield RING_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    size_t size = NUM_REGIONS * REGION_SIZE;
+    glCreateBuffers(1, &_buffer);
+    glNamedBufferStorage(_buffer, size, nullptr, RING_FLAGS);
+    _mappedData = static_cast<uint8_t*>(glMapNamedBufferRange(_buffer, 0, size, RING_FLAGS));
+    if (!_mappedData) {
+        qCWarning(gpugl45logging) << "Unable to map the transform ring, transforms will be uploaded for each batch";
+        glDeleteBuffers(1, &_buffer);
+        _buffer = 0;
+    }
+    (void)CHECK_GL_ERROR();
+}
+
+void GL45Backend::TransformRing::kill() {
+    for (auto& fence : _fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = 0;
+        }
+    }
+    if (_buffer) {
+        glUnmapNamedBuffer(_buffer);
+        glDeleteBuffers(1, &_buffer);
+        _buffer = 0;
+    }
+    _mappedData = nullptr;
+}
+
+size_t GL45Backend::TransformRing::allocate(size_t size) {
+    if (!isValid()) {
+        return INVALID_OFFSET;
+    }
+
+    size_t alignedOffset = ((_offset + _alignment - 1) / _alignment) * _alignment;
+    if (alignedOffset + size > REGION_SIZE) {
+        return INVALID_OFFSET;
+    }
+    _offset = alignedOffset + size;
+    return _region * REGION_SIZE + alignedOffset;
+}
+
+void GL45Backend::TransformRing::nextFrame() {
+    if (!isValid()) {
+        return;
+    }
+
+    _fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _region = (_region + 1) % NUM_REGIONS;
+    _offset = 0;
+
+    auto& fence = _fences[_region];
+    if (fence) {
+        // only waits when the GPU is more than NUM_REGIONS - 1 frames behind
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, TRANSFORM_RING_WAIT_NSECS);
+        while (result == GL_TIMEOUT_EXPIRED) {
+            result = glClientWaitSync(fence, 0, TRANSFORM_RING_WAIT_NSECS);
+        }
+        glDeleteSync(fence);
+        fence = 0;
+    }
+}
+
 void GL45Backend::initTransform() {
     GLuint transformBuffers[3];
     glCreateBuffers(3, transformBuffers);
@@ -27,41 +101,97 @@ void GL45Backend::initTransform() {
     while (_transform._cameraUboSize < cameraSize) {
         _transform._cameraUboSize += UNIFORM_BUFFER_OFFSET_ALIGNMENT;
     }
+
+    _transformRing.init();
+}
+
+void GL45Backend::killTransform() {
+    _transformRing.kill();
+    Parent::killTransform();
 }
 
 void GL45Backend::transferTransformState(const Batch& batch) const {
-    // FIXME not thread safe
-    static std::vector<uint8_t> bufferData;
-    if (!_transform._cameras.empty()) {
-        bufferData.resize(_transform._cameraUboSize * _transform._cameras.size());
+    size_t camerasSize = _transform._cameraUboSize * _transform._cameras.size();
+    size_t objectsSize = batch._objects.size() * sizeof(Batch::TransformObject);
+    size_t drawCallInfosSize = 0;
+    for (auto& data : batch._namedData) {
+        drawCallInfosSize += data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
+    }
+
+    size_t camerasOffset = _transformRing.allocate(camerasSize);
+    size_t objectsOffset = _transformRing.allocate(objectsSize);
+    size_t drawCallInfosOffset = _transformRing.allocate(drawCallInfosSize);
+
+    bool isStreamed = camerasOffset != INVALID_OFFSET && objectsOffset != INVALID_OFFSET &&
+        drawCallInfosOffset != INVALID_OFFSET;
+
+    if (isStreamed) {
+        uint8_t* cameras = _transformRing._mappedData + camerasOffset;
         for (size_t i = 0; i < _transform._cameras.size(); ++i) {
-            memcpy(bufferData.data() + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
+            memcpy(cameras + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
         }
-        glNamedBufferData(_transform._cameraBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
-    }
+        _transform._cameraStreamBuffer = _transformRing._buffer;
+        _transform._cameraStreamOffset = camerasOffset;
 
-    if (!batch._objects.empty()) {
-        glNamedBufferData(_transform._objectBuffer, batch._objects.size() * sizeof(Batch::TransformObject), batch._objects.data(), GL_STREAM_DRAW);
-    }
+        if (objectsSize > 0) {
+            memcpy(_transformRing._mappedData + objectsOffset, batch._objects.data(), objectsSize);
+        }
 
-    if (!batch._namedData.empty()) {
-        bufferData.clear();
+        size_t currentSize = 0;
         for (auto& data : batch._namedData) {
-            auto currentSize = bufferData.size();
             auto bytesToCopy = data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
-            bufferData.resize(currentSize + bytesToCopy);
-            memcpy(bufferData.data() + currentSize, data.second.drawCallInfos.data(), bytesToCopy);
-            _transform._drawCallInfoOffsets[data.first] = (GLvoid*)currentSize;
+            memcpy(_transformRing._mappedData + drawCallInfosOffset + currentSize, data.second.drawCallInfos.data(), bytesToCopy);
+            _transform._drawCallInfoOffsets[data.first] = (GLvoid*)(drawCallInfosOffset + currentSize);
+            currentSize += bytesToCopy;
         }
-        glNamedBufferData(_transform._drawCallInfoBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+        _transformRing._drawCallInfoBuffer = _transformRing._buffer;
+    } else {
+        // FIXME not thread safe
+        static std::vector<uint8_t> bufferData;
+        if (!_transform._cameras.empty()) {
+            bufferData.resize(camerasSize);
+            for (size_t i = 0; i < _transform._cameras.size(); ++i) {
+                memcpy(bufferData.data() + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
+            }
+            glNamedBufferData(_transform._cameraBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+        }
+        _transform._cameraStreamBuffer = 0;
+        _transform._cameraStreamOffset = 0;
+
+        if (!batch._objects.empty()) {
+            glNamedBufferData(_transform._objectBuffer, objectsSize, batch._objects.data(), GL_STREAM_DRAW);
+        }
+
+        if (!batch._namedData.empty()) {
+            bufferData.clear();
+            for (auto& data : batch._namedData) {
+                auto currentSize = bufferData.size();
+                auto bytesToCopy = data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
+                bufferData.resize(currentSize + bytesToCopy);
+                memcpy(bufferData.data() + currentSize, data.second.drawCallInfos.data(), bytesToCopy);
+                _transform._drawCallInfoOffsets[data.first] = (GLvoid*)currentSize;
+            }
+            glNamedBufferData(_transform._drawCallInfoBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+        }
+        _transformRing._drawCallInfoBuffer = _transform._drawCallInfoBuffer;
     }
 
+    // a batch without objects leaves whatever was bound before, as the plain buffer always has
+    bool isObjectsStreamed = isStreamed && objectsSize > 0;
 #ifdef GPU_SSBO_TRANSFORM_OBJECT
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot::storage::ObjectTransforms, _transform._objectBuffer);
+    if (isObjectsStreamed) {
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, slot::storage::ObjectTransforms, _transformRing._buffer, objectsOffset, objectsSize);
+    } else {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot::storage::ObjectTransforms, _transform._objectBuffer);
+    }
 #else
     glActiveTexture(GL_TEXTURE0 + slot::texture::ObjectTransforms);
     glBindTexture(GL_TEXTURE_BUFFER, _transform._objectBufferTexture);
-    glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, _transform._objectBuffer);
+    if (isObjectsStreamed) {
+        glTextureBufferRange(_transform._objectBufferTexture, GL_RGBA32F, _transformRing._buffer, objectsOffset, objectsSize);
+    } else {
+        glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, _transform._objectBuffer);
+    }
 #endif
 
     CHECK_GL_ERROR();
@@ -97,7 +227,7 @@ void GL45Backend::updateTransform(const Batch& batch) {
         // NOTE: A stride of zero in BindVertexBuffer signifies that all elements are sourced from the same location,
         //       so we must provide a stride.
         //       This is in contrast to VertexAttrib*Pointer, where a zero signifies tightly-packed elements.
-        glBindVertexBuffer(gpu::Stream::DRAW_CALL_INFO, _transform._drawCallInfoBuffer, (GLintptr)_transform._drawCallInfoOffsets[batch._currentNamedCall], 2 * sizeof(GLushort));
+        glBindVertexBuffer(gpu::Stream::DRAW_CALL_INFO, _transformRing._drawCallInfoBuffer, (GLintptr)_transform._drawCallInfoOffsets[batch._currentNamedCall], 2 * sizeof(GLushort));
     }
 
     (void)CHECK_GL_ERROR();
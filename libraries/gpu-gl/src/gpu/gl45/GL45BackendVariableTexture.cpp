@@ -145,7 +145,7 @@ size_t GL45ResourceTexture::promote() {
     Q_ASSERT(_allocatedMip > 0);
 
     uint16_t targetAllocatedMip = _allocatedMip - std::min<uint16_t>(_allocatedMip, 2);
-    targetAllocatedMip = std::max<uint16_t>(_minAllocatedMip, targetAllocatedMip);
+    targetAllocatedMip = std::max<uint16_t>(std::max(_minAllocatedMip, _desiredMip), targetAllocatedMip);
 
 #if GPU_BINDLESS_TEXTURES
     bool bindless = isBindless();
@@ -84,6 +84,13 @@ void Batch::clear() {
     _framebuffers.clear();
     _lambdas.clear();
     _names.clear();
+    for (auto& namedCallData : _namedData) {
+        for (auto& buffer : namedCallData.second.buffers) {
+            if (buffer && buffer.use_count() == 1) {
+                _namedBufferPool.push_back(std::move(buffer));
+            }
+        }
+    }
     _namedData.clear();
     _objects.clear();
     _params.clear();
@@ -506,13 +513,13 @@ bool Batch::isSkyboxEnabled() const {
     return _enableSkybox;
 }
 
-void Batch::setupNamedCalls(const std::string& instanceName, NamedBatchData::Function function) {
+void Batch::setupNamedCalls(const std::string& instanceName, NamedBatchData::Function function, uint32 numInstances) {
     NamedBatchData& instance = _namedData[instanceName];
     if (!instance.function) {
         instance.function = function;
     }
 
-    captureNamedDrawCallInfo(instanceName);
+    captureNamedDrawCallInfo(instanceName, numInstances);
 }
 
 const BufferPointer& Batch::getNamedBuffer(const std::string& instanceName, uint8_t index) {
@@ -521,7 +528,13 @@ const BufferPointer& Batch::getNamedBuffer(const std::string& instanceName, uint
         instance.buffers.resize(index + 1);
     }
     if (!instance.buffers[index]) {
-        instance.buffers[index] = std::make_shared<Buffer>();
+        if (!_namedBufferPool.empty()) {
+            instance.buffers[index] = std::move(_namedBufferPool.back());
+            _namedBufferPool.pop_back();
+            instance.buffers[index]->resize(0);
+        } else {
+            instance.buffers[index] = std::make_shared<Buffer>();
+        }
     }
     return instance.buffers[index];
 }
@@ -544,7 +557,7 @@ const Batch::DrawCallInfoBuffer& Batch::getDrawCallInfoBuffer() const {
     }
 }
 
-void Batch::captureDrawCallInfoImpl() {
+void Batch::captureDrawCallInfoImpl(uint32 numInstances) {
     if (_invalidModel) {
         TransformObject object;
         _currentModel.getMatrix(object._model);
@@ -562,7 +575,7 @@ void Batch::captureDrawCallInfoImpl() {
     }
 
     auto& drawCallInfos = getDrawCallInfoBuffer();
-    drawCallInfos.emplace_back((uint16)_objects.size() - 1, _drawcallUniform);
+    drawCallInfos.insert(drawCallInfos.end(), numInstances, DrawCallInfo((uint16)_objects.size() - 1, _drawcallUniform));
     _drawcallUniform = _drawcallUniformReset;
 }
 
@@ -575,9 +588,9 @@ void Batch::captureDrawCallInfo() {
     captureDrawCallInfoImpl();
 }
 
-void Batch::captureNamedDrawCallInfo(std::string name) {
+void Batch::captureNamedDrawCallInfo(std::string name, uint32 numInstances) {
     std::swap(_currentNamedCall, name);  // Set and save _currentNamedCall
-    captureDrawCallInfoImpl();
+    captureDrawCallInfoImpl(numInstances);
     std::swap(_currentNamedCall, name);  // Restore _currentNamedCall
 }
 
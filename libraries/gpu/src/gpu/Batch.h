@@ -87,7 +87,7 @@ public:
     DrawCallInfoBuffer& getDrawCallInfoBuffer();
 
     void captureDrawCallInfo();
-    void captureNamedDrawCallInfo(std::string name);
+    void captureNamedDrawCallInfo(std::string name, uint32 numInstances = 1);
 
     Batch(const std::string& name = "");
     // Disallow copy construction and assignement of batches
@@ -128,7 +128,8 @@ public:
     void multiDrawIndirect(uint32 numCommands, Primitive primitiveType);
     void multiDrawIndexedIndirect(uint32 numCommands, Primitive primitiveType);
 
-    void setupNamedCalls(const std::string& instanceName, NamedBatchData::Function function);
+    // adds numInstances instances to the named call, all with the current model transform
+    void setupNamedCalls(const std::string& instanceName, NamedBatchData::Function function, uint32 numInstances = 1);
     const BufferPointer& getNamedBuffer(const std::string& instanceName, uint8_t index = 0);
 
     // Input Stage
@@ -522,6 +523,8 @@ public:
     StringCaches _names;
 
     NamedBatchDataMap _namedData;
+    // the named buffers of the previous uses of the batch, which are filled again rather than reallocated every frame
+    std::vector<BufferPointer> _namedBufferPool;
 
     uint16_t _drawcallUniform{ 0 };
     uint16_t _drawcallUniformReset{ 0 };
@@ -550,7 +553,7 @@ protected:
 
 
 
-    void captureDrawCallInfoImpl();
+    void captureDrawCallInfoImpl(uint32 numInstances = 1);
 };
 
 template <typename T>
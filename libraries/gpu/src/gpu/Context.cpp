@@ -72,6 +72,10 @@ const std::string& Context::getBackendVersion() const {
     return _backend->getVersion();
 }
 
+bool Context::supportsMultiDrawIndirect() const {
+    return _backend->supportsMultiDrawIndirect();
+}
+
 void Context::beginFrame(const glm::mat4& renderView, const glm::mat4& renderPose) {
     assert(!_frameActive);
     _frameActive = true;
@@ -191,6 +195,10 @@ void Context::downloadFramebuffer(const FramebufferPointer& srcFramebuffer, cons
     _backend->downloadFramebuffer(srcFramebuffer, region, destImage);
 }
 
+void Context::readFramebufferAsync(const FramebufferPointer& srcFramebuffer, const Vec4i& region, const Backend::FramebufferReadHandler& handler) {
+    _backend->readFramebufferAsync(srcFramebuffer, region, handler);
+}
+
 void Context::resetStats() const {
     _backend->resetStats();
 }
@@ -285,6 +293,9 @@ ContextMetricSize  Backend::texturePendingGPUTransferMemSize;
 ContextMetricSize  Backend::textureResourcePopulatedGPUMemSize;
 ContextMetricSize  Backend::textureResourceIdealGPUMemSize;
 
+ContextMetricSize  Backend::textureStagingGPUMemSize;
+ContextMetricSize  Backend::textureFrameTransferMemSize;
+
 Size Context::getFreeGPUMemSize() {
     return Backend::freeGPUMemSize.getValue();
 }
@@ -359,6 +370,14 @@ Size Context::getTextureResourceIdealGPUMemSize() {
     return Backend::textureResourceIdealGPUMemSize.getValue();
 }
 
+Size Context::getTextureStagingGPUMemSize() {
+    return Backend::textureStagingGPUMemSize.getValue();
+}
+
+Size Context::getTextureFrameTransferMemSize() {
+    return Backend::textureFrameTransferMemSize.getValue();
+}
+
 void Context::pushProgramsToSync(const std::vector<uint32_t>& programIDs, std::function<void()> callback, size_t rate) {
     std::vector<gpu::ShaderPointer> programs;
     for (auto programID : programIDs) {
@@ -54,6 +54,9 @@ public:
 
 class Backend {
 public:
+    // Receives the pixels of a framebuffer read, row after row from the bottom one
+    using FramebufferReadHandler = std::function<void(const std::vector<float>& pixels)>;
+
     virtual ~Backend(){};
 
     virtual void shutdown() {}
@@ -66,6 +69,7 @@ public:
     virtual void syncProgram(const gpu::ShaderPointer& program) = 0;
     virtual void recycle() const = 0;
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) = 0;
+    virtual void readFramebufferAsync(const FramebufferPointer& srcFramebuffer, const Vec4i& region, const FramebufferReadHandler& handler) {}
     virtual void setCameraCorrection(const Mat4& correction, const Mat4& prevRenderView, bool reset = false) {}
 
     virtual bool supportedTextureFormat(const gpu::Element& format) = 0;
@@ -96,6 +100,9 @@ public:
 
     virtual bool isTextureManagementSparseEnabled() const = 0;
 
+    // Whether the multiDrawXXXIndirect calls are executed, the backends that don't have them skip those draws
+    virtual bool supportsMultiDrawIndirect() const { return false; }
+
     // These should only be accessed by Backend implementation to report the buffer and texture allocations,
     // they are NOT public objects
     static ContextMetricSize freeGPUMemSize;
@@ -118,6 +125,10 @@ public:
     static ContextMetricSize textureResourcePopulatedGPUMemSize;
     static ContextMetricSize textureResourceIdealGPUMemSize;
 
+    // the part of the texture staging buffer in use, and how much texture data was uploaded in the last frame
+    static ContextMetricSize textureStagingGPUMemSize;
+    static ContextMetricSize textureFrameTransferMemSize;
+
     virtual bool isStereo() const {
         return _stereo.isStereo();
     }
@@ -159,6 +170,7 @@ public:
 
     void shutdown();
     const std::string& getBackendVersion() const;
+    bool supportsMultiDrawIndirect() const;
 
     void beginFrame(const glm::mat4& renderView = glm::mat4(), const glm::mat4& renderPose = glm::mat4());
     void appendFrameBatch(const BatchPointer& batch);
@@ -220,6 +232,12 @@ public:
     // It s here for convenience to easily capture a snapshot
     void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage);
 
+    // Reads the single float channel of the first color buffer of the framebuffer back without waiting for the GPU, the
+    // handler is called from the rendering thread once the pixels are there, usually a frame or two later.
+    // Backends that can't read back never call the handler.
+    // MUST only be called on the rendering thread, such as from a Batch::runLambda
+    void readFramebufferAsync(const FramebufferPointer& srcFramebuffer, const Vec4i& region, const Backend::FramebufferReadHandler& handler);
+
     // Repporting stats of the context
     void resetStats() const;
     void getStats(ContextStats& stats) const;
@@ -256,6 +274,9 @@ public:
     static Size getTextureResourcePopulatedGPUMemSize();
     static Size getTextureResourceIdealGPUMemSize();
 
+    static Size getTextureStagingGPUMemSize();
+    static Size getTextureFrameTransferMemSize();
+
     struct ProgramsToSync {
         ProgramsToSync(const std::vector<gpu::ShaderPointer>& programs, std::function<void()> callback, size_t rate) :
             programs(programs), callback(callback), rate(rate) {}
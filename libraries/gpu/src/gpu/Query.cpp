@@ -50,6 +50,7 @@ RangeTimer::RangeTimer(const std::string& name) :
 
             _movingAverageGPU.addSample(query.getGPUElapsedTime());
             _movingAverageBatch.addSample(query.getBatchElapsedTime());
+            _historyGPU.addSample(query.getGPUElapsedTime());
         }, _name));
     }
 }
@@ -16,6 +16,7 @@
 #include <functional>
 #include <vector>
 #include <string>
+#include <RunTimeHistory.h>
 #include <SimpleMovingAverage.h>
 
 #include "Format.h"
@@ -66,6 +67,9 @@ namespace gpu {
         double getGPUAverage() const;
         double getBatchAverage() const;
 
+        // over the last RunTimeHistory::NUM_SAMPLES ranges, not their moving averages
+        double getGPUPercentile(double percentile) const { return _historyGPU.getPercentile(percentile); }
+
     protected:
         
         static const int QUERY_QUEUE_SIZE { 4 };
@@ -77,6 +81,7 @@ namespace gpu {
 
         MovingAverage<double, QUERY_QUEUE_SIZE * 2> _movingAverageGPU;
         MovingAverage<double, QUERY_QUEUE_SIZE * 2> _movingAverageBatch;
+        RunTimeHistory _historyGPU;
 
         int rangeIndex(int index) const { return (index % QUERY_QUEUE_SIZE); }
     };
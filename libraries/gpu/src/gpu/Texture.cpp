@@ -909,6 +909,12 @@ bool Texture::incremementMinMip(uint16 count) {
     return setMinMip(_minMip + count);
 }
 
+void Texture::requestDesiredMip(uint16 mip) {
+    uint16 desiredMip = _desiredMip;
+    while (mip < desiredMip && !_desiredMip.compare_exchange_weak(desiredMip, mip)) {
+    }
+}
+
 Vec3u Texture::evalMipDimensions(uint16 level) const { 
     auto dimensions = getDimensions();
     dimensions >>= level; 
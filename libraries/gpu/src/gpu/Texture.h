@@ -355,7 +355,8 @@ public:
 
         void reset() override { }
 
-        // Don't keep files open forever.  We close them at the beginning of each frame (GLBackend::recycle)
+        // Don't keep files open forever.  We close them at the beginning of each frame (GLBackend::recycle),
+        // the ones with mips still waiting for their transfer stay mapped until the views returned by getMipFace go away
         static void releaseOpenKtxFiles();
 
     protected:
@@ -514,6 +515,12 @@ public:
     uint16 getMinMip() const { return _minMip; }
     uint16 usedMipLevels() const { return (getNumMips() - _minMip); }
 
+    // The finest mip the views drawing the texture need, estimated from how large it is on screen. The backend keeps the
+    // finest one requested until it takes it once per frame, a texture that is never requested keeps all of its mips
+    static const uint16 NO_DESIRED_MIP = 0xFFFF;
+    void requestDesiredMip(uint16 mip);
+    uint16 takeDesiredMip() const { return _desiredMip.exchange(NO_DESIRED_MIP); }
+
     // Generate the sub mips automatically for the texture
     // If the storage version is not available (from CPU memory)
     // Only works for the standard formats
@@ -623,6 +630,7 @@ protected:
     uint16 _maxMipLevel { 0 };
 
     uint16 _minMip { 0 };
+    mutable std::atomic<uint16> _desiredMip { NO_DESIRED_MIP };
  
     Type _type { TEX_1D };
 
@@ -270,7 +270,9 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
         qWarning() << "Failed to get a valid storageView for faceSize=" << faceSize << "  faceOffset=" << faceOffset
                     << "out of valid file " << QString::fromStdString(_filename);
     }
-    return storageView->toMemoryStorage();
+    // The view keeps the mapping of the file alive until the mip is uploaded, so its pages are only read in from the disk
+    // by the buffering of the transfer that copies them, without another copy of the whole mip in memory first
+    return storageView;
 }
 
 Size KtxStorage::getMipFaceSize(uint16 level, uint8 face) const {
@@ -134,6 +134,12 @@ public:
     const BufferView& getPartBuffer() const { return _partBuffer; }
     size_t getNumParts() const { return _partBuffer.getNumElements(); }
 
+    // The parts of the simplified levels of the mesh, getNumParts() of them per level, coarser as they go.
+    // Their indices follow the ones of the parts in the index buffer, past the end of its view
+    void setLodPartBuffer(const BufferView& buffer) { _lodPartBuffer = buffer; }
+    const BufferView& getLodPartBuffer() const { return _lodPartBuffer; }
+    size_t getNumLods() const { return getNumParts() ? _lodPartBuffer.getNumElements() / getNumParts() : 0; }
+
     // evaluate the bounding box of A part
     Box evalPartBound(int partNum) const;
     // evaluate the bounding boxes of the parts in the range [start, end]
@@ -170,6 +176,7 @@ protected:
     BufferView _indexBuffer;
 
     BufferView _partBuffer;
+    BufferView _lodPartBuffer;
 
     void evalVertexFormat();
     void evalVertexStream();
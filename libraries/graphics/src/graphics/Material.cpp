@@ -259,8 +259,14 @@ void Material::setTextureTransforms(const Transform& transform, MaterialMappingM
 }
 
 MultiMaterial::MultiMaterial() {
-    Schema schema;
-    _schemaBuffer = gpu::BufferView(std::make_shared<gpu::Buffer>(sizeof(Schema), (const gpu::Byte*) &schema, sizeof(Schema)));
+    // all the multi-materials start from the same default schema and empty texture table
+    static const gpu::BufferView defaultSchemaBuffer = [] {
+        Schema schema;
+        return gpu::BufferView(std::make_shared<gpu::Buffer>(sizeof(Schema), (const gpu::Byte*) &schema, sizeof(Schema)));
+    }();
+    static const gpu::TextureTablePointer defaultTextureTable = std::make_shared<gpu::TextureTable>();
+    _schemaBuffer = defaultSchemaBuffer;
+    _textureTable = defaultTextureTable;
 }
 
 void MultiMaterial::calculateMaterialInfo() const {
@@ -536,9 +536,13 @@ public:
         }
     };
 
+    // The schema buffer and the texture table are shared by the multi-materials with the same contents, so they are
+    // never edited in place but replaced when the materials change
     gpu::BufferView& getSchemaBuffer() { return _schemaBuffer; }
+    void setSchemaBuffer(const gpu::BufferView& schemaBuffer) { _schemaBuffer = schemaBuffer; }
     graphics::MaterialKey getMaterialKey() const { return graphics::MaterialKey(_schemaBuffer.get<graphics::MultiMaterial::Schema>()._key); }
     const gpu::TextureTablePointer& getTextureTable() const { return _textureTable; }
+    void setTextureTable(const gpu::TextureTablePointer& textureTable) { _textureTable = textureTable; }
 
     void setCullFaceMode(graphics::MaterialKey::CullFaceMode cullFaceMode) { _cullFaceMode = cullFaceMode; }
     graphics::MaterialKey::CullFaceMode getCullFaceMode() const { return _cullFaceMode; }
@@ -556,7 +560,7 @@ public:
 private:
     gpu::BufferView _schemaBuffer;
     graphics::MaterialKey::CullFaceMode _cullFaceMode { graphics::Material::DEFAULT_CULL_FACE_MODE };
-    gpu::TextureTablePointer _textureTable { std::make_shared<gpu::TextureTable>() };
+    gpu::TextureTablePointer _textureTable;
     bool _needsUpdate { false };
     bool _texturesLoading { false };
     bool _initialized { false };
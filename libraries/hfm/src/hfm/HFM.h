@@ -62,6 +62,8 @@ static const int DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES = 1000;
 static const int DRACO_ATTRIBUTE_MATERIAL_ID = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES;
 static const int DRACO_ATTRIBUTE_TEX_COORD_1 = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES + 1;
 static const int DRACO_ATTRIBUTE_ORIGINAL_INDEX = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES + 2;
+// The index of the vertex in the baked mesh, that the triangles of its simplified levels refer to
+static const int DRACO_ATTRIBUTE_VERTEX_INDEX = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES + 3;
 
 // High Fidelity Model namespace
 namespace hfm {
@@ -159,6 +161,13 @@ public:
     QString materialID;
 };
 
+/// A simplified level of a mesh, made when it is baked.
+class MeshLod {
+public:
+
+    QVector<QVector<int>> partTriangleIndices; // for each part of the mesh, the triangles left of it, into the same vertices
+};
+
 class Material {
 public:
     Material() {};
@@ -232,6 +241,7 @@ class Mesh {
 public:
 
     QVector<MeshPart> parts;
+    QVector<MeshLod> lods; // coarser as they go
 
     QVector<glm::vec3> vertices;
     QVector<glm::vec3> normals;
@@ -359,6 +369,7 @@ typedef hfm::Joint HFMJoint;
 typedef hfm::Cluster HFMCluster;
 typedef hfm::Texture HFMTexture;
 typedef hfm::MeshPart HFMMeshPart;
+typedef hfm::MeshLod HFMMeshLod;
 typedef hfm::Material HFMMaterial;
 typedef hfm::Mesh HFMMesh;
 typedef hfm::AnimationFrame HFMAnimationFrame;
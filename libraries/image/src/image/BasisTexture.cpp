@@ -0,0 +1,267 @@
+//
+//  BasisTexture.cpp
+//  image/src/image
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BasisTexture.h"
+
+#include <mutex>
+
+#include <Profile.h>
+
+#include "ImageLogging.h"
+
+#ifdef HAVE_BASISU
+#include <basisu/encoder/basisu_comp.h>
+#include <basisu/transcoder/basisu_transcoder.h>
+#endif
+
+namespace image {
+
+#ifdef HAVE_BASISU
+
+// what the texture holds, in the second user data field of the file
+enum BasisContent : uint32_t {
+    BASIS_CONTENT_COLOR = 0,
+    BASIS_CONTENT_RED,
+    BASIS_CONTENT_XY,
+};
+
+// the largest mip that GLES devices load, same as for the other baked textures
+static const uint32_t MAX_TEXTURE_SIZE_GLES = 2048;
+
+// ETC1S trades quality for size, 128 is the middle of the range of the encoder
+static const int ETC1S_QUALITY_LEVEL = 128;
+
+bool isBasisEncodingSupported() {
+    return true;
+}
+
+bool isBasisTranscodingSupported() {
+    return true;
+}
+
+static void initTranscoder() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        basist::basisu_transcoder_init();
+    });
+}
+
+static void initEncoder() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        basisu::basisu_encoder_init();
+    });
+}
+
+static basisu::image toBasisImage(const gpu::Texture& texture, uint16_t level, const gpu::Element& format, BasisContent content) {
+    auto width = texture.evalMipWidth(level);
+    auto height = texture.evalMipHeight(level);
+    auto lineSize = texture.evalStoredMipLineSize(level, format);
+    auto mip = texture.accessStoredMipFace(level);
+    const uint8_t* bytes = mip->readData();
+
+    basisu::image image(width, height);
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* line = bytes + y * lineSize;
+        for (uint32_t x = 0; x < width; ++x) {
+            switch (content) {
+                case BASIS_CONTENT_RED: {
+                    uint8_t red = line[x];
+                    image(x, y) = basisu::color_rgba(red, red, red, 255);
+                    break;
+                }
+                case BASIS_CONTENT_XY: {
+                    // the transcoder reads the two channels of BC5 and EAC RG11 from the red and alpha of the blocks
+                    const uint8_t* texel = line + 2 * x;
+                    image(x, y) = basisu::color_rgba(texel[0], texel[0], texel[0], texel[1]);
+                    break;
+                }
+                default: {
+                    const uint8_t* texel = line + 4 * x;
+                    if (format == gpu::Element::COLOR_SBGRA_32) {
+                        image(x, y) = basisu::color_rgba(texel[2], texel[1], texel[0], texel[3]);
+                    } else {
+                        image(x, y) = basisu::color_rgba(texel[0], texel[1], texel[2], texel[3]);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    return image;
+}
+
+QByteArray encodeBasisTexture(const gpu::Texture& texture, const std::atomic<bool>& abortProcessing) {
+    PROFILE_RANGE(resource_parse, "encodeBasisTexture");
+
+    if (texture.getType() != gpu::Texture::TEX_2D || texture.getNumMips() == 0) {
+        return QByteArray();
+    }
+
+    auto format = texture.getStoredMipFormat();
+    BasisContent content;
+    if (format == gpu::Element::COLOR_SBGRA_32 || format == gpu::Element::COLOR_SRGBA_32) {
+        content = BASIS_CONTENT_COLOR;
+    } else if (format == gpu::Element::COLOR_R_8) {
+        content = BASIS_CONTENT_RED;
+    } else if (format == gpu::Element::VEC2NU8_XY) {
+        content = BASIS_CONTENT_XY;
+    } else {
+        return QByteArray();
+    }
+
+    initEncoder();
+
+    basisu::basis_compressor_params params;
+    params.m_source_images.push_back(toBasisImage(texture, 0, format, content));
+    params.m_source_mipmap_images.resize(1);
+    for (uint16_t level = 1; level < texture.getNumMips() && texture.isStoredMipFaceAvailable(level); ++level) {
+        if (abortProcessing.load()) {
+            return QByteArray();
+        }
+        params.m_source_mipmap_images[0].push_back(toBasisImage(texture, level, format, content));
+    }
+
+    // the mips were already filtered by the texture processing, the normals are better kept in UASTC
+    params.m_uastc = content == BASIS_CONTENT_XY;
+    params.m_perceptual = content == BASIS_CONTENT_COLOR;
+    params.m_quality_level = ETC1S_QUALITY_LEVEL;
+    params.m_mip_gen = false;
+    params.m_read_source_images = false;
+    params.m_write_output_basis_files = false;
+    params.m_status_output = false;
+    params.m_multithreading = false;
+    params.m_userdata0 = (uint32_t)texture.getUsage()._flags.to_ulong();
+    params.m_userdata1 = content;
+
+    basisu::job_pool jobPool(1);
+    params.m_pJob_pool = &jobPool;
+
+    basisu::basis_compressor compressor;
+    if (!compressor.init(params) || compressor.process() != basisu::basis_compressor::cECSuccess) {
+        qCWarning(imagelogging) << "Failed to encode Basis texture" << QString::fromStdString(texture.source());
+        return QByteArray();
+    }
+
+    const auto& output = compressor.get_output_basis_file();
+    return QByteArray(reinterpret_cast<const char*>(output.data()), (int)output.size());
+}
+
+gpu::TexturePointer transcodeBasisTexture(const QByteArray& data, const std::string& filename, gpu::BackendTarget target) {
+    PROFILE_RANGE(resource_parse, "transcodeBasisTexture");
+
+    initTranscoder();
+
+    const void* bytes = data.constData();
+    auto size = (uint32_t)data.size();
+
+    basist::basisu_transcoder transcoder;
+    basist::basisu_file_info fileInfo;
+    basist::basisu_image_info imageInfo;
+    if (!transcoder.validate_header(bytes, size) || !transcoder.get_file_info(bytes, size, fileInfo) ||
+            fileInfo.m_total_images == 0 || !transcoder.get_image_info(bytes, size, imageInfo, 0) ||
+            !transcoder.start_transcoding(bytes, size)) {
+        qCWarning(imagelogging) << "Invalid Basis texture" << QString::fromStdString(filename);
+        return nullptr;
+    }
+
+    gpu::Texture::Usage usage { gpu::Texture::Usage::Flags(fileInfo.m_userdata0) };
+    auto content = (BasisContent)fileInfo.m_userdata1;
+
+    bool isGLES = target == gpu::BackendTarget::GLES32;
+    basist::transcoder_texture_format transcodeFormat;
+    gpu::Element formatGPU;
+    switch (content) {
+        case BASIS_CONTENT_RED:
+            transcodeFormat = isGLES ? basist::transcoder_texture_format::cTFETC2_EAC_R11 : basist::transcoder_texture_format::cTFBC4_R;
+            formatGPU = isGLES ? gpu::Element::COLOR_COMPRESSED_EAC_RED : gpu::Element::COLOR_COMPRESSED_BCX_RED;
+            break;
+        case BASIS_CONTENT_XY:
+            transcodeFormat = isGLES ? basist::transcoder_texture_format::cTFETC2_EAC_RG11 : basist::transcoder_texture_format::cTFBC5_RG;
+            formatGPU = isGLES ? gpu::Element::COLOR_COMPRESSED_EAC_XY : gpu::Element::COLOR_COMPRESSED_BCX_XY;
+            break;
+        default:
+            if (usage.isAlpha()) {
+                transcodeFormat = isGLES ? basist::transcoder_texture_format::cTFETC2_RGBA : basist::transcoder_texture_format::cTFBC7_RGBA;
+                formatGPU = isGLES ? gpu::Element::COLOR_COMPRESSED_ETC2_SRGBA : gpu::Element::COLOR_COMPRESSED_BCX_SRGBA_HIGH;
+            } else {
+                // ETC1 blocks are valid ETC2 ones
+                transcodeFormat = isGLES ? basist::transcoder_texture_format::cTFETC1_RGB : basist::transcoder_texture_format::cTFBC1_RGB;
+                formatGPU = isGLES ? gpu::Element::COLOR_COMPRESSED_ETC2_SRGB : gpu::Element::COLOR_COMPRESSED_BCX_SRGB;
+            }
+            break;
+    }
+
+    // GLES devices start from the first mip that fits
+    uint32_t firstLevel = 0;
+    if (isGLES) {
+        while (firstLevel + 1 < imageInfo.m_total_levels &&
+                std::max(imageInfo.m_orig_width >> firstLevel, imageInfo.m_orig_height >> firstLevel) > MAX_TEXTURE_SIZE_GLES) {
+            ++firstLevel;
+        }
+    }
+
+    basist::basisu_image_level_info firstLevelInfo;
+    if (!transcoder.get_image_level_info(bytes, size, firstLevelInfo, 0, firstLevel)) {
+        qCWarning(imagelogging) << "Invalid Basis texture" << QString::fromStdString(filename);
+        return nullptr;
+    }
+
+    auto numMips = (uint16_t)(imageInfo.m_total_levels - firstLevel);
+    auto texture = gpu::Texture::create2D(formatGPU, firstLevelInfo.m_orig_width, firstLevelInfo.m_orig_height, numMips,
+        gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR));
+    texture->setSource(filename);
+    texture->setUsage(usage);
+    texture->setStoredMipFormat(formatGPU);
+
+    auto bytesPerBlock = basist::basis_get_bytes_per_block_or_pixel(transcodeFormat);
+    std::vector<uint8_t> blocks;
+    for (uint16_t mip = 0; mip < numMips; ++mip) {
+        basist::basisu_image_level_info levelInfo;
+        if (!transcoder.get_image_level_info(bytes, size, levelInfo, 0, firstLevel + mip)) {
+            return nullptr;
+        }
+        blocks.resize(levelInfo.m_total_blocks * bytesPerBlock);
+        if (!transcoder.transcode_image_level(bytes, size, 0, firstLevel + mip, blocks.data(), levelInfo.m_total_blocks,
+                transcodeFormat, 0)) {
+            qCWarning(imagelogging) << "Failed to transcode Basis texture" << QString::fromStdString(filename) << "mip" << mip;
+            return nullptr;
+        }
+        texture->assignStoredMip(mip, blocks.size(), blocks.data());
+    }
+    return texture;
+}
+
+#else
+
+bool isBasisEncodingSupported() {
+    return false;
+}
+
+bool isBasisTranscodingSupported() {
+    return false;
+}
+
+QByteArray encodeBasisTexture(const gpu::Texture& texture, const std::atomic<bool>& abortProcessing) {
+    return QByteArray();
+}
+
+gpu::TexturePointer transcodeBasisTexture(const QByteArray& data, const std::string& filename, gpu::BackendTarget target) {
+    return nullptr;
+}
+
+#endif
+
+bool isBasisImage(const QByteArray& peek) {
+    // the signature of the header of .basis files, 'sB' in little endian
+    return peek.size() >= 2 && peek[0] == 's' && peek[1] == 'B';
+}
+
+}
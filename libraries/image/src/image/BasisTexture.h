@@ -0,0 +1,39 @@
+//
+//  BasisTexture.h
+//  image/src/image
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_image_BasisTexture_h
+#define hifi_image_BasisTexture_h
+
+#include <atomic>
+#include <string>
+
+#include <QByteArray>
+
+#include <gpu/Texture.h>
+
+namespace image {
+
+    // Basis Universal textures are baked once and transcoded on load to whichever block compressed format the backend
+    // supports, BC on desktop and ETC2/EAC on GLES. Both are only available when the library was built with basisu
+    bool isBasisEncodingSupported();
+    bool isBasisTranscodingSupported();
+
+    // whether the start of the file is the signature of a .basis file
+    bool isBasisImage(const QByteArray& peek);
+
+    // Encodes the mips of an uncompressed 2D texture, as processed for GL45, into a .basis file. Returns an empty array
+    // if the texture format isn't one that can be encoded
+    QByteArray encodeBasisTexture(const gpu::Texture& texture, const std::atomic<bool>& abortProcessing);
+
+    gpu::TexturePointer transcodeBasisTexture(const QByteArray& data, const std::string& filename, gpu::BackendTarget target);
+
+}
+
+#endif // hifi_image_BasisTexture_h
@@ -13,6 +13,9 @@
 
 #include <glm/gtc/packing.hpp>
 
+#include <mutex>
+#include <thread>
+
 #include <QtCore/QtGlobal>
 #include <QUrl>
 #include <QRgb>
@@ -23,6 +26,8 @@
 #include <Profile.h>
 #include <StatTracker.h>
 #include <GLMHelpers.h>
+#include <TBBHelpers.h>
+#include <tbb/task_group.h>
 
 #include "TGAReader.h"
 #if !defined(Q_OS_ANDROID)
@@ -30,6 +35,7 @@
 #endif
 #include "ImageLogging.h"
 #include "CubeMap.h"
+#include "BasisTexture.h"
 
 using namespace gpu;
 
@@ -40,6 +46,7 @@ using namespace gpu;
 #include <Etc2/EtcFilter.h>
 
 static const glm::uvec2 SPARSE_PAGE_SIZE(128);
+static const qint64 BASIS_SIGNATURE_SIZE = 2;
 static const glm::uvec2 MAX_TEXTURE_SIZE_GLES(2048);
 static const glm::uvec2 MAX_TEXTURE_SIZE_GL(4096);
 bool DEV_DECIMATE_TEXTURES = false;
@@ -342,6 +349,19 @@ gpu::TexturePointer processImage(std::shared_ptr<QIODevice> content, const std::
                                  int maxNumPixels, TextureUsage::Type textureType,
                                  bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
 
+    // Baked Basis Universal textures already have their mips, they are transcoded to the block format of the target
+    if (isBasisTranscodingSupported()) {
+        if (!content->isReadable()) {
+            content->open(QIODevice::ReadOnly);
+        }
+        content->reset();
+        if (isBasisImage(content->peek(BASIS_SIGNATURE_SIZE))) {
+            auto data = content->readAll();
+            content.reset();
+            return transcodeBasisTexture(data, filename, target);
+        }
+    }
+
     Image image = processRawImageData(*content.get(), filename);
     // Texture content can take up a lot of memory. Here we release our ownership of that content
     // in case it can be released.
@@ -420,6 +440,9 @@ Image processSourceImage(Image&& srcImage, bool cubemap, BackendTarget target) {
     return localCopy;
 }
 
+// the faces and mips of a texture are compressed in parallel, but its storage is assigned one mip at a time
+static std::mutex assignStoredMipMutex;
+
 #if defined(NVTT_API)
 struct OutputHandler : public nvtt::OutputHandler {
     OutputHandler(gpu::Texture* texture, int face) : _texture(texture), _face(face) {}
@@ -440,6 +463,7 @@ struct OutputHandler : public nvtt::OutputHandler {
     }
 
     virtual void endImage() override {
+        std::lock_guard<std::mutex> lock(assignStoredMipMutex);
         if (_face >= 0) {
             _texture->assignStoredMipFace(_miplevel, _face, _size, static_cast<const gpu::Byte*>(_data));
         } else {
@@ -518,6 +542,23 @@ public:
         }
     }
 };
+
+// Compresses the blocks of a mip in parallel, each of them only depends on its own texels so the output is the same
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
+public:
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing) : _abortProcessing(abortProcessing) {
+    }
+
+    const std::atomic<bool>& _abortProcessing;
+
+    void dispatch(nvtt::Task* task, void* context, int count) override {
+        tbb::parallel_for(0, count, [&](int i) {
+            if (!_abortProcessing.load()) {
+                task(context, i);
+            }
+        });
+    }
+};
 #endif
 
 void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
@@ -622,8 +663,7 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
-    nvtt::Compressor compressor;
+    ParallelTaskDispatcher dispatcher(abortProcessing);
     context.setTaskDispatcher(&dispatcher);
 
     context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
@@ -752,23 +792,36 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             return;
         }
 
-        nvtt::OutputOptions outputOptions;
-        outputOptions.setOutputHeader(false);
-        OutputHandler outputHandler(texture, face);
-        outputOptions.setOutputHandler(&outputHandler);
-        MyErrorHandler errorHandler;
-        outputOptions.setErrorHandler(&errorHandler);
-
-        SequentialTaskDispatcher dispatcher(abortProcessing);
-        nvtt::Compressor context;
+        // Each mip is compressed on its own task as soon as it is built from the previous one
+        tbb::task_group compressions;
+        auto compressMip = [&](const nvtt::Surface& mip, int level) {
+            compressions.run([&, mip, level] {
+                if (abortProcessing.load()) {
+                    return;
+                }
+                nvtt::OutputOptions outputOptions;
+                outputOptions.setOutputHeader(false);
+                OutputHandler outputHandler(texture, face);
+                outputOptions.setOutputHandler(&outputHandler);
+                MyErrorHandler errorHandler;
+                outputOptions.setErrorHandler(&errorHandler);
+
+                ParallelTaskDispatcher dispatcher(abortProcessing);
+                nvtt::Compressor context;
+                context.setTaskDispatcher(&dispatcher);
+
+                context.compress(mip, face, level, compressionOptions, outputOptions);
+            });
+        };
 
-        context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
+        compressMip(surface, mipLevel++);
         if (buildMips) {
             while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
                 surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-                context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
+                compressMip(surface, mipLevel++);
             }
         }
+        compressions.wait();
     } else {
         int numMips = 1;
     
@@ -807,7 +860,7 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
         const Etc::ErrorMetric errorMetric = Etc::ErrorMetric::RGBA;
         const float effort = 1.0f;
-        const int numEncodeThreads = 4;
+        const int numEncodeThreads = (int)std::max(1u, std::thread::hardware_concurrency());
         int encodingTime;
 
         if (localCopy.getFormat() != Image::Format_RGBAF) {
@@ -822,6 +875,7 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             mipMaps, &encodingTime
         );
 
+        std::lock_guard<std::mutex> lock(assignStoredMipMutex);
         for (int i = 0; i < numMips; i++) {
             if (mipMaps[i].paucEncodingBits.get()) {
                 if (face >= 0) {
@@ -1491,11 +1545,13 @@ void convolveForGGX(const std::vector<Image>& faces, gpu::Texture* texture, Back
         output.applyGamma(1.0f/2.2f);
     }
 
-    for (int face = 0; face < 6; face++) {
-        for (gpu::uint16 mipLevel = 0; mipLevel < output.getMipCount(); mipLevel++) {
-            convertToTexture(texture, output.getFaceImage(mipLevel, face), target, abortProcessing, face, mipLevel);
+    tbb::parallel_for(tbb::blocked_range2d<int, int>(0, 6, 1, 0, (int)output.getMipCount(), 1), [&](const tbb::blocked_range2d<int, int>& range) {
+        for (int face = range.rows().begin(); face < range.rows().end(); face++) {
+            for (int mipLevel = range.cols().begin(); mipLevel < range.cols().end(); mipLevel++) {
+                convertToTexture(texture, output.getFaceImage(mipLevel, face), target, abortProcessing, face, mipLevel);
+            }
         }
-    }
+    });
 }
 
 gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcImage, const std::string& srcImageName,
@@ -1601,10 +1657,9 @@ gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcIm
             convolveForGGX(faces, theTexture.get(), target, abortProcessing);
         } else {
             // Create mip maps and compress to final format in one go
-            for (uint8 face = 0; face < faces.size(); ++face) {
-                // Force building the mip maps right now on CPU if we are convolving for GGX later on
+            tbb::parallel_for(0, (int)faces.size(), [&](int face) {
                 convertToTextureWithMips(theTexture.get(), std::move(faces[face]), target, abortProcessing, face);
-            }
+            });
         }
     }
 
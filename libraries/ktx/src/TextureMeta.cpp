@@ -37,6 +37,9 @@ bool TextureMeta::deserialize(const QByteArray& data, TextureMeta* meta) {
     if (root.contains("uncompressed")) {
         meta->uncompressed = root["uncompressed"].toString();
     }
+    if (root.contains("basis")) {
+        meta->basis = root["basis"].toString();
+    }
     if (root.contains("compressed")) {
         auto compressed = root["compressed"].toObject();
         for (auto it = compressed.constBegin(); it != compressed.constEnd(); it++) {
@@ -66,6 +69,9 @@ QByteArray TextureMeta::serialize() {
     root["original"] = original.toString();
     root["uncompressed"] = uncompressed.toString();
     root["compressed"] = compressed;
+    if (!basis.isEmpty()) {
+        root["basis"] = basis.toString();
+    }
     root["version"] = KTX_VERSION;
     doc.setObject(root);
 
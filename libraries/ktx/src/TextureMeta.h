@@ -37,6 +37,8 @@ struct TextureMeta {
 
     QUrl original;
     QUrl uncompressed;
+    // a Basis Universal file, transcoded on load to any of the compressed formats
+    QUrl basis;
     std::unordered_map<khronos::gl::texture::InternalFormat, QUrl> availableTextureTypes;
     uint16_t version { 0 };
 };
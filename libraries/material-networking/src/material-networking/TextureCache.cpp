@@ -34,6 +34,7 @@
 #include <gl/GLHelpers.h>
 #include <gpu/Batch.h>
 
+#include <image/BasisTexture.h>
 #include <image/TextureProcessing.h>
 
 #include <NumericalConstants.h>
@@ -1090,6 +1091,20 @@ void NetworkTexture::loadMetaContent(const QByteArray& content) {
         }
     }
 
+    // the Basis file is processed like an original, transcoded to the compressed format of the backend
+    if (!meta.basis.isEmpty() && image::isBasisTranscodingSupported()) {
+        _currentlyLoadingResourceType = ResourceType::ORIGINAL;
+        _activeUrl = _activeUrl.resolved(meta.basis);
+
+        auto textureCache = DependencyManager::get<TextureCache>();
+        auto self = _self.lock();
+        if (!self) {
+            return;
+        }
+        QMetaObject::invokeMethod(this, "attemptRequest", Qt::QueuedConnection);
+        return;
+    }
+
 #ifndef Q_OS_ANDROID
     if (!meta.uncompressed.isEmpty()) {
         _currentlyLoadingResourceType = ResourceType::KTX;
@@ -35,6 +35,9 @@ namespace baker {
     using BlendshapeTangents = std::vector<glm::vec3>;
     using TangentsPerBlendshape = std::vector<std::vector<glm::vec3>>;
 
+    using MeshLods = std::vector<hfm::MeshLod>;
+    using LodsPerMesh = std::vector<std::vector<hfm::MeshLod>>;
+
     using MeshIndicesToModelNames = QHash<int, QString>;
 };
 
@@ -35,6 +35,8 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <TBBHelpers.h>
+
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
 
@@ -51,7 +53,7 @@ std::vector<hifi::ByteArray> createMaterialList(const hfm::Mesh& mesh) {
     return materialList;
 }
 
-std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals, const std::vector<glm::vec3>& tangents, const std::vector<hifi::ByteArray>& materialList) {
+std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals, const std::vector<glm::vec3>& tangents, const std::vector<hifi::ByteArray>& materialList, bool hasLods) {
     Q_ASSERT(normals.size() == 0 || (int)normals.size() == mesh.vertices.size());
     Q_ASSERT(mesh.colors.size() == 0 || mesh.colors.size() == mesh.vertices.size());
     Q_ASSERT(mesh.texCoords.size() == 0 || mesh.texCoords.size() == mesh.vertices.size());
@@ -81,6 +83,8 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
     bool hasTexCoords1{ mesh.texCoords1.size() > 0 };
     bool hasPerFaceMaterials{ mesh.parts.size() > 1 };
     bool needsOriginalIndices{ (!mesh.clusterIndices.empty() || !mesh.blendshapes.empty()) && mesh.originalIndices.size() > 0 };
+    // the triangles of the simplified levels refer to the vertices of the mesh, which draco renumbers
+    bool needsVertexIndices{ hasLods };
 
     int normalsAttributeID { -1 };
     int colorsAttributeID { -1 };
@@ -88,6 +92,7 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
     int texCoords1AttributeID { -1 };
     int faceMaterialAttributeID { -1 };
     int originalIndexAttributeID { -1 };
+    int vertexIndexAttributeID { -1 };
 
     const int positionAttributeID = meshBuilder.AddAttribute(draco::GeometryAttribute::POSITION,
         3, draco::DT_FLOAT32);
@@ -97,6 +102,12 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
             1, draco::DT_INT32);
     }
 
+    if (needsVertexIndices) {
+        vertexIndexAttributeID = meshBuilder.AddAttribute(
+            (draco::GeometryAttribute::Type)DRACO_ATTRIBUTE_VERTEX_INDEX,
+            1, draco::DT_INT32);
+    }
+
     if (hasNormals) {
         normalsAttributeID = meshBuilder.AddAttribute(draco::GeometryAttribute::NORMAL,
             3, draco::DT_FLOAT32);
@@ -147,6 +158,9 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
                     &mesh.originalIndices[idx1],
                     &mesh.originalIndices[idx2]);
             }
+            if (needsVertexIndices) {
+                meshBuilder.SetAttributeValuesForFace(vertexIndexAttributeID, face, &idx0, &idx1, &idx2);
+            }
             if (hasNormals) {
                 meshBuilder.SetAttributeValuesForFace(normalsAttributeID, face,
                     &normals[idx0], &normals[idx1],
@@ -200,6 +214,10 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
     if (needsOriginalIndices) {
         dracoMesh->attribute(originalIndexAttributeID)->set_unique_id(DRACO_ATTRIBUTE_ORIGINAL_INDEX);
     }
+
+    if (needsVertexIndices) {
+        dracoMesh->attribute(vertexIndexAttributeID)->set_unique_id(DRACO_ATTRIBUTE_VERTEX_INDEX);
+    }
     
     return std::make_tuple(std::move(dracoMesh), false);
 }
@@ -217,28 +235,33 @@ void BuildDracoMeshTask::run(const baker::BakeContextPointer& context, const Inp
     const auto& meshes = input.get0();
     const auto& normalsPerMesh = input.get1();
     const auto& tangentsPerMesh = input.get2();
+    const auto& lodsPerMesh = input.get3();
     auto& dracoBytesPerMesh = output.edit0();
     auto& dracoErrorsPerMesh = output.edit1();
     auto& materialLists = output.edit2();
 
-    dracoBytesPerMesh.reserve(meshes.size());
+    dracoBytesPerMesh.clear();
+    dracoBytesPerMesh.resize(meshes.size());
+    materialLists.clear();
+    materialLists.resize(meshes.size());
     // vector<bool> is an exception to the std::vector conventions as it is a bit field
-    // So a bool reference to an element doesn't work
-    dracoErrorsPerMesh.resize(meshes.size());
-    materialLists.reserve(meshes.size());
-    for (size_t i = 0; i < meshes.size(); i++) {
+    // So a bool reference to an element doesn't work, and neither do writes to neighbouring elements from different threads
+    std::vector<uint8_t> dracoErrors(meshes.size(), 0);
+
+    // the meshes are encoded on their own threads
+    tbb::parallel_for((size_t)0, meshes.size(), [&](size_t i) {
         const auto& mesh = meshes[i];
         const auto& normals = baker::safeGet(normalsPerMesh, i);
         const auto& tangents = baker::safeGet(tangentsPerMesh, i);
-        dracoBytesPerMesh.emplace_back();
-        auto& dracoBytes = dracoBytesPerMesh.back();
-        materialLists.push_back(createMaterialList(mesh));
-        const auto& materialList = materialLists.back();
+        auto& dracoBytes = dracoBytesPerMesh[i];
+        materialLists[i] = createMaterialList(mesh);
+        const auto& materialList = materialLists[i];
 
         bool dracoError;
         std::unique_ptr<draco::Mesh> dracoMesh;
-        std::tie(dracoMesh, dracoError) = createDracoMesh(mesh, normals, tangents, materialList);
-        dracoErrorsPerMesh[i] = dracoError;
+        bool hasLods = !baker::safeGet(lodsPerMesh, i).empty();
+        std::tie(dracoMesh, dracoError) = createDracoMesh(mesh, normals, tangents, materialList, hasLods);
+        dracoErrors[i] = dracoError ? 1 : 0;
 
         if (dracoMesh) {
             draco::Encoder encoder;
@@ -253,6 +276,8 @@ void BuildDracoMeshTask::run(const baker::BakeContextPointer& context, const Inp
 
             dracoBytes = hifi::ByteArray(buffer.data(), (int)buffer.size());
         }
-    }
+    });
+
+    dracoErrorsPerMesh.assign(dracoErrors.cbegin(), dracoErrors.cend());
 #endif // not Q_OS_ANDROID
 }
@@ -33,7 +33,7 @@ public:
 class BuildDracoMeshTask {
 public:
     using Config = BuildDracoMeshConfig;
-    using Input = baker::VaryingSet3<std::vector<hfm::Mesh>, baker::NormalsPerMesh, baker::TangentsPerMesh>;
+    using Input = baker::VaryingSet4<std::vector<hfm::Mesh>, baker::NormalsPerMesh, baker::TangentsPerMesh, baker::LodsPerMesh>;
     using Output = baker::VaryingSet3<std::vector<hifi::ByteArray>, std::vector<bool>, std::vector<std::vector<hifi::ByteArray>>>;
     using JobModel = baker::Job::ModelIO<BuildDracoMeshTask, Input, Output, Config>;
 
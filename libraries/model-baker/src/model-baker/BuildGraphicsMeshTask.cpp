@@ -14,6 +14,8 @@
 #include <glm/gtc/packing.hpp>
 
 #include <LogHandler.h>
+#include <TBBHelpers.h>
+
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
 
@@ -319,8 +321,21 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
         return;
     }
 
+    // the simplified levels only count when they have all the parts
+    unsigned int totalLodIndices = 0;
+    QVector<HFMMeshLod> lods;
+    foreach(const HFMMeshLod& lod, hfmMesh.lods) {
+        if (lod.partTriangleIndices.size() != hfmMesh.parts.size()) {
+            break;
+        }
+        lods.push_back(lod);
+        foreach(const QVector<int>& triangleIndices, lod.partTriangleIndices) {
+            totalLodIndices += triangleIndices.size();
+        }
+    }
+
     auto indexBuffer = std::make_shared<gpu::Buffer>();
-    indexBuffer->resize(totalIndices * sizeof(int));
+    indexBuffer->resize((totalIndices + totalLodIndices) * sizeof(int));
 
     int indexNum = 0;
     int offset = 0;
@@ -353,7 +368,23 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
         parts.push_back(modelPart);
     }
 
-    gpu::BufferView indexBufferView(indexBuffer, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::XYZ));
+    std::vector< graphics::Mesh::Part > lodParts;
+    foreach(const HFMMeshLod& lod, lods) {
+        foreach(const QVector<int>& triangleIndices, lod.partTriangleIndices) {
+            graphics::Mesh::Part lodPart(indexNum, triangleIndices.size(), 0, graphics::Mesh::TRIANGLES);
+            if (triangleIndices.size()) {
+                indexBuffer->setSubData(offset,
+                    triangleIndices.size() * sizeof(int),
+                    (gpu::Byte*) triangleIndices.constData());
+                offset += triangleIndices.size() * sizeof(int);
+                indexNum += triangleIndices.size();
+            }
+            lodParts.push_back(lodPart);
+        }
+    }
+
+    // the view only covers the indices of the parts, the ones of the levels are drawn from the same buffer
+    gpu::BufferView indexBufferView(indexBuffer, 0, totalIndices * sizeof(int), gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::XYZ));
     graphicsMesh->setIndexBuffer(indexBufferView);
 
     if (parts.size()) {
@@ -361,6 +392,12 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
         pb->setData(parts.size() * sizeof(graphics::Mesh::Part), (const gpu::Byte*) parts.data());
         gpu::BufferView pbv(pb, gpu::Element(gpu::VEC4, gpu::UINT32, gpu::XYZW));
         graphicsMesh->setPartBuffer(pbv);
+
+        if (lodParts.size()) {
+            auto lpb = std::make_shared<gpu::Buffer>();
+            lpb->setData(lodParts.size() * sizeof(graphics::Mesh::Part), (const gpu::Byte*) lodParts.data());
+            graphicsMesh->setLodPartBuffer(gpu::BufferView(lpb, gpu::Element(gpu::VEC4, gpu::UINT32, gpu::XYZW)));
+        }
     } else {
         HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "BuildGraphicsMeshTask failed -- no parts");
         return;
@@ -381,10 +418,11 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
     auto& graphicsMeshes = output;
 
     int n = (int)meshes.size();
-    for (int i = 0; i < n; i++) {
-        graphicsMeshes.emplace_back();
+    graphicsMeshes.clear();
+    graphicsMeshes.resize(n);
+    tbb::parallel_for(0, n, [&](int i) {
         auto& graphicsMesh = graphicsMeshes[i];
-        
+
         // Try to create the graphics::Mesh
         buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i));
 
@@ -395,5 +433,5 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
                 graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
             }
         }
-    }
+    });
 }
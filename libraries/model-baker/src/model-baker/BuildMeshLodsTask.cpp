@@ -0,0 +1,76 @@
+//
+//  BuildMeshLodsTask.cpp
+//  model-baker/src/model-baker
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BuildMeshLodsTask.h"
+
+#include <TBBHelpers.h>
+
+#include "MeshSimplifier.h"
+#include "ModelBakerLogging.h"
+
+// a level has to drop at least this much of the triangles of the one before to be worth keeping
+static const float MIN_LOD_REDUCTION = 0.1f;
+
+void BuildMeshLodsTask::configure(const Config& config) {
+    _numLods = config.numLods;
+    _triangleRatio = config.triangleRatio;
+    _maxError = config.maxError;
+    _minTriangles = config.minTriangles;
+}
+
+void BuildMeshLodsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
+    const auto& meshes = input;
+    auto& lodsPerMesh = output;
+
+    lodsPerMesh.clear();
+    lodsPerMesh.resize(meshes.size());
+    tbb::parallel_for((size_t)0, meshes.size(), [&](size_t i) {
+        const auto& mesh = meshes[i];
+
+        std::vector<std::vector<int>> partTriangleIndices;
+        partTriangleIndices.reserve(mesh.parts.size());
+        size_t numTriangles = 0;
+        for (const auto& part : mesh.parts) {
+            partTriangleIndices.emplace_back(part.quadTrianglesIndices.cbegin(), part.quadTrianglesIndices.cend());
+            auto& indices = partTriangleIndices.back();
+            indices.insert(indices.end(), part.triangleIndices.cbegin(), part.triangleIndices.cend());
+            numTriangles += indices.size() / 3;
+        }
+        if ((int)numTriangles < _minTriangles) {
+            return;
+        }
+
+        Extents extents;
+        for (const auto& vertex : mesh.vertices) {
+            extents.addPoint(vertex);
+        }
+        float maxError = _maxError * glm::length(extents.size());
+
+        baker::MeshSimplifier simplifier(mesh.vertices.toStdVector(), partTriangleIndices);
+        auto& lods = lodsPerMesh[i];
+        size_t lodTriangles = simplifier.getTriangleCount();
+        for (int lod = 0; lod < _numLods; lod++) {
+            simplifier.simplify((size_t)(lodTriangles * _triangleRatio), maxError);
+            if (simplifier.getTriangleCount() > lodTriangles * (1.0f - MIN_LOD_REDUCTION)) {
+                break;
+            }
+            lodTriangles = simplifier.getTriangleCount();
+
+            hfm::MeshLod meshLod;
+            for (const auto& indices : simplifier.getPartTriangleIndices()) {
+                meshLod.partTriangleIndices.push_back(QVector<int>::fromStdVector(indices));
+            }
+            lods.push_back(meshLod);
+        }
+        if (!lods.empty()) {
+            qCDebug(model_baker) << "Built" << lods.size() << "levels for a mesh of" << numTriangles << "triangles, down to" << lodTriangles;
+        }
+    });
+}
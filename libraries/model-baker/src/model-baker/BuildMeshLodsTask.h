@@ -0,0 +1,56 @@
+//
+//  BuildMeshLodsTask.h
+//  model-baker/src/model-baker
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BuildMeshLodsTask_h
+#define hifi_BuildMeshLodsTask_h
+
+#include <hfm/HFM.h>
+
+#include "Engine.h"
+#include "BakerTypes.h"
+
+// BuildMeshLodsTask is disabled by default, it is enabled when baking
+class BuildMeshLodsConfig : public baker::JobConfig {
+    Q_OBJECT
+    Q_PROPERTY(int numLods MEMBER numLods)
+    Q_PROPERTY(float triangleRatio MEMBER triangleRatio)
+    Q_PROPERTY(float maxError MEMBER maxError)
+    Q_PROPERTY(int minTriangles MEMBER minTriangles)
+public:
+    BuildMeshLodsConfig() : baker::JobConfig(false) {}
+
+    int numLods { 3 };
+    // of the triangles of a level that are left in the next one
+    float triangleRatio { 0.5f };
+    // how far the simplified surface can move, relative to the size of the mesh
+    float maxError { 0.02f };
+    // meshes with fewer triangles are left as they are
+    int minTriangles { 256 };
+};
+
+// Simplifies each mesh in levels that each have a fraction of the triangles of the one before, with the same vertices
+class BuildMeshLodsTask {
+public:
+    using Config = BuildMeshLodsConfig;
+    using Input = std::vector<hfm::Mesh>;
+    using Output = baker::LodsPerMesh;
+    using JobModel = baker::Job::ModelIO<BuildMeshLodsTask, Input, Output, Config>;
+
+    void configure(const Config& config);
+    void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
+
+protected:
+    int _numLods { 3 };
+    float _triangleRatio { 0.5f };
+    float _maxError { 0.02f };
+    int _minTriangles { 256 };
+};
+
+#endif // hifi_BuildMeshLodsTask_h
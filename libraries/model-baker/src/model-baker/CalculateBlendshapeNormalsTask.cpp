@@ -11,6 +11,8 @@
 
 #include "CalculateBlendshapeNormalsTask.h"
 
+#include <TBBHelpers.h>
+
 #include "ModelMath.h"
 
 void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -18,53 +20,57 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
     const auto& meshes = input.get1();
     auto& normalsPerBlendshapePerMeshOut = output;
 
-    normalsPerBlendshapePerMeshOut.reserve(blendshapesPerMesh.size());
+    // avatars have most of their blendshapes on one mesh, so they are spread over the threads across all of the meshes
+    std::vector<std::pair<size_t, size_t>> meshBlendshapes;
+    normalsPerBlendshapePerMeshOut.clear();
+    normalsPerBlendshapePerMeshOut.resize(blendshapesPerMesh.size());
     for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
-        const auto& mesh = meshes[i];
-        const auto& blendshapes = blendshapesPerMesh[i];
-        normalsPerBlendshapePerMeshOut.emplace_back();
-        auto& normalsPerBlendshapeOut = normalsPerBlendshapePerMeshOut[normalsPerBlendshapePerMeshOut.size()-1];
-
-        normalsPerBlendshapeOut.reserve(blendshapes.size());
-        for (size_t j = 0; j < blendshapes.size(); j++) {
-            const auto& blendshape = blendshapes[j];
-            const auto& normalsIn = blendshape.normals;
-            // Check if normals are already defined. Otherwise, calculate them from existing blendshape vertices.
-            if (!normalsIn.empty()) {
-                normalsPerBlendshapeOut.push_back(normalsIn.toStdVector());
-            } else {
-                // Create lookup to get index in blendshape from vertex index in mesh
-                std::vector<int> reverseIndices;
-                reverseIndices.resize(mesh.vertices.size());
-                std::iota(reverseIndices.begin(), reverseIndices.end(), 0);
-                for (int indexInBlendShape = 0; indexInBlendShape < blendshape.indices.size(); ++indexInBlendShape) {
-                    auto indexInMesh = blendshape.indices[indexInBlendShape];
-                    reverseIndices[indexInMesh] = indexInBlendShape;
-                }
+        normalsPerBlendshapePerMeshOut[i].resize(blendshapesPerMesh[i].size());
+        for (size_t j = 0; j < blendshapesPerMesh[i].size(); j++) {
+            meshBlendshapes.emplace_back(i, j);
+        }
+    }
 
-                normalsPerBlendshapeOut.emplace_back();
-                auto& normals = normalsPerBlendshapeOut[normalsPerBlendshapeOut.size()-1];
-                normals.resize(mesh.vertices.size());
-                baker::calculateNormals(mesh,
-                    [&reverseIndices, &blendshape, &normals](int normalIndex) /* NormalAccessor */ {
-                        const auto lookupIndex = reverseIndices[normalIndex];
-                        if (lookupIndex < blendshape.vertices.size()) {
-                            return &normals[lookupIndex];
-                        } else {
-                            // Index isn't in the blendshape. Request that the normal not be calculated.
-                            return (glm::vec3*)nullptr;
-                        }
-                    },
-                    [&mesh, &reverseIndices, &blendshape](int vertexIndex, glm::vec3& outVertex) /* VertexSetter */ {
-                        const auto lookupIndex = reverseIndices[vertexIndex];
-                        if (lookupIndex < blendshape.vertices.size()) {
-                            outVertex = blendshape.vertices[lookupIndex];
-                        } else {
-                            // Index isn't in the blendshape, so return vertex from mesh
-                            outVertex = baker::safeGet(mesh.vertices, lookupIndex);
-                        }
-                    });
+    tbb::parallel_for((size_t)0, meshBlendshapes.size(), [&](size_t index) {
+        size_t i = meshBlendshapes[index].first;
+        size_t j = meshBlendshapes[index].second;
+        const auto& mesh = meshes[i];
+        const auto& blendshape = blendshapesPerMesh[i][j];
+        const auto& normalsIn = blendshape.normals;
+        auto& normals = normalsPerBlendshapePerMeshOut[i][j];
+        // Check if normals are already defined. Otherwise, calculate them from existing blendshape vertices.
+        if (!normalsIn.empty()) {
+            normals = normalsIn.toStdVector();
+        } else {
+            // Create lookup to get index in blendshape from vertex index in mesh
+            std::vector<int> reverseIndices;
+            reverseIndices.resize(mesh.vertices.size());
+            std::iota(reverseIndices.begin(), reverseIndices.end(), 0);
+            for (int indexInBlendShape = 0; indexInBlendShape < blendshape.indices.size(); ++indexInBlendShape) {
+                auto indexInMesh = blendshape.indices[indexInBlendShape];
+                reverseIndices[indexInMesh] = indexInBlendShape;
             }
+
+            normals.resize(mesh.vertices.size());
+            baker::calculateNormals(mesh,
+                [&reverseIndices, &blendshape, &normals](int normalIndex) /* NormalAccessor */ {
+                    const auto lookupIndex = reverseIndices[normalIndex];
+                    if (lookupIndex < blendshape.vertices.size()) {
+                        return &normals[lookupIndex];
+                    } else {
+                        // Index isn't in the blendshape. Request that the normal not be calculated.
+                        return (glm::vec3*)nullptr;
+                    }
+                },
+                [&mesh, &reverseIndices, &blendshape](int vertexIndex, glm::vec3& outVertex) /* VertexSetter */ {
+                    const auto lookupIndex = reverseIndices[vertexIndex];
+                    if (lookupIndex < blendshape.vertices.size()) {
+                        outVertex = blendshape.vertices[lookupIndex];
+                    } else {
+                        // Index isn't in the blendshape, so return vertex from mesh
+                        outVertex = baker::safeGet(mesh.vertices, lookupIndex);
+                    }
+                });
         }
-    }
+    });
 }
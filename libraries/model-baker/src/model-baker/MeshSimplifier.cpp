@@ -0,0 +1,268 @@
+//
+//  MeshSimplifier.cpp
+//  model-baker/src/model-baker
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+
+using namespace baker;
+
+void MeshSimplifier::Quadric::addPlane(const glm::dvec3& normal, double distance) {
+    a2 += normal.x * normal.x;
+    ab += normal.x * normal.y;
+    ac += normal.x * normal.z;
+    ad += normal.x * distance;
+    b2 += normal.y * normal.y;
+    bc += normal.y * normal.z;
+    bd += normal.y * distance;
+    c2 += normal.z * normal.z;
+    cd += normal.z * distance;
+    d2 += distance * distance;
+}
+
+void MeshSimplifier::Quadric::add(const Quadric& other) {
+    a2 += other.a2;
+    ab += other.ab;
+    ac += other.ac;
+    ad += other.ad;
+    b2 += other.b2;
+    bc += other.bc;
+    bd += other.bd;
+    c2 += other.c2;
+    cd += other.cd;
+    d2 += other.d2;
+}
+
+double MeshSimplifier::Quadric::evalError(const glm::dvec3& p) const {
+    // the sum of the squared distances of the point to the planes
+    return a2 * p.x * p.x + 2.0 * ab * p.x * p.y + 2.0 * ac * p.x * p.z + 2.0 * ad * p.x +
+        b2 * p.y * p.y + 2.0 * bc * p.y * p.z + 2.0 * bd * p.y +
+        c2 * p.z * p.z + 2.0 * cd * p.z +
+        d2;
+}
+
+MeshSimplifier::MeshSimplifier(const std::vector<glm::vec3>& positions, const std::vector<std::vector<int>>& partTriangleIndices) :
+    _positions(positions),
+    _numParts(partTriangleIndices.size()) {
+    const int numVertices = (int)_positions.size();
+
+    for (size_t part = 0; part < partTriangleIndices.size(); part++) {
+        const auto& indices = partTriangleIndices[part];
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            std::array<int, 3> triangle {{ indices[i], indices[i + 1], indices[i + 2] }};
+            bool isValid = triangle[0] != triangle[1] && triangle[1] != triangle[2] && triangle[2] != triangle[0];
+            for (auto index : triangle) {
+                isValid = isValid && index >= 0 && index < numVertices;
+            }
+            if (isValid) {
+                _triangles.push_back(triangle);
+                _trianglePart.push_back((int)part);
+            }
+        }
+    }
+    _triangleCount = _triangles.size();
+    _isTriangleRemoved.resize(_triangles.size(), false);
+
+    _vertexTriangles.resize(numVertices);
+    _quadrics.resize(numVertices);
+    _isVertexLocked.resize(numVertices, false);
+    _isVertexRemoved.resize(numVertices, false);
+    _vertexVersions.resize(numVertices, 0);
+
+    // the edges used by one triangle are on a border or a seam, more than two is a non manifold edge,
+    // and the ones between two parts keep the boundaries of the materials where they are
+    std::unordered_map<uint64_t, int> edgeUses;
+    std::unordered_map<uint64_t, int> edgeParts;
+    auto edgeKey = [](int a, int b) {
+        return ((uint64_t)std::min(a, b) << 32) | (uint64_t)(uint32_t)std::max(a, b);
+    };
+
+    for (int t = 0; t < (int)_triangles.size(); t++) {
+        const auto& triangle = _triangles[t];
+        glm::dvec3 p0 = _positions[triangle[0]];
+        glm::dvec3 normal = glm::cross(glm::dvec3(_positions[triangle[1]]) - p0, glm::dvec3(_positions[triangle[2]]) - p0);
+        double length = glm::length(normal);
+        if (length > 0.0) {
+            normal /= length;
+            Quadric quadric;
+            quadric.addPlane(normal, -glm::dot(normal, p0));
+            for (auto index : triangle) {
+                _quadrics[index].add(quadric);
+            }
+        }
+        for (int i = 0; i < 3; i++) {
+            _vertexTriangles[triangle[i]].push_back(t);
+            auto key = edgeKey(triangle[i], triangle[(i + 1) % 3]);
+            edgeUses[key]++;
+            edgeParts.emplace(key, _trianglePart[t]);
+        }
+    }
+
+    for (int t = 0; t < (int)_triangles.size(); t++) {
+        const auto& triangle = _triangles[t];
+        for (int i = 0; i < 3; i++) {
+            auto key = edgeKey(triangle[i], triangle[(i + 1) % 3]);
+            if (edgeUses[key] != 2 || edgeParts[key] != _trianglePart[t]) {
+                _isVertexLocked[triangle[i]] = true;
+                _isVertexLocked[triangle[(i + 1) % 3]] = true;
+            }
+        }
+    }
+
+    for (const auto& triangle : _triangles) {
+        for (int i = 0; i < 3; i++) {
+            pushCollapse(triangle[i], triangle[(i + 1) % 3]);
+            pushCollapse(triangle[(i + 1) % 3], triangle[i]);
+        }
+    }
+}
+
+void MeshSimplifier::pushCollapse(int from, int to) {
+    if (_isVertexLocked[from]) {
+        return;
+    }
+    Quadric quadric = _quadrics[from];
+    quadric.add(_quadrics[to]);
+    Collapse collapse { quadric.evalError(_positions[to]), from, to, _vertexVersions[from], _vertexVersions[to] };
+    _collapses.push_back(collapse);
+    std::push_heap(_collapses.begin(), _collapses.end());
+}
+
+bool MeshSimplifier::canCollapse(int from, int to) const {
+    // the edge must still be there, and the vertices can't share more neighbors than the triangles on the edge,
+    // or the collapse would fold the surface onto itself
+    std::vector<int> fromNeighbors;
+    std::vector<int> toNeighbors;
+    int sharedTriangles = 0;
+    for (auto t : _vertexTriangles[from]) {
+        if (_isTriangleRemoved[t]) {
+            continue;
+        }
+        const auto& triangle = _triangles[t];
+        bool hasTo = false;
+        for (auto index : triangle) {
+            if (index != from) {
+                fromNeighbors.push_back(index);
+            }
+            hasTo = hasTo || index == to;
+        }
+        if (hasTo) {
+            sharedTriangles++;
+            continue;
+        }
+
+        // the triangles left around the vertex can't flip over
+        glm::vec3 p[3];
+        glm::vec3 q[3];
+        for (int i = 0; i < 3; i++) {
+            p[i] = _positions[triangle[i]];
+            q[i] = triangle[i] == from ? _positions[to] : p[i];
+        }
+        glm::vec3 oldNormal = glm::cross(p[1] - p[0], p[2] - p[0]);
+        glm::vec3 newNormal = glm::cross(q[1] - q[0], q[2] - q[0]);
+        if (glm::dot(oldNormal, newNormal) <= 0.0f) {
+            return false;
+        }
+    }
+    if (sharedTriangles == 0) {
+        return false;
+    }
+
+    for (auto t : _vertexTriangles[to]) {
+        if (!_isTriangleRemoved[t]) {
+            for (auto index : _triangles[t]) {
+                if (index != to) {
+                    toNeighbors.push_back(index);
+                }
+            }
+        }
+    }
+    std::sort(fromNeighbors.begin(), fromNeighbors.end());
+    fromNeighbors.erase(std::unique(fromNeighbors.begin(), fromNeighbors.end()), fromNeighbors.end());
+    std::sort(toNeighbors.begin(), toNeighbors.end());
+    toNeighbors.erase(std::unique(toNeighbors.begin(), toNeighbors.end()), toNeighbors.end());
+
+    std::vector<int> sharedNeighbors;
+    std::set_intersection(fromNeighbors.begin(), fromNeighbors.end(), toNeighbors.begin(), toNeighbors.end(),
+        std::back_inserter(sharedNeighbors));
+    return (int)sharedNeighbors.size() <= sharedTriangles;
+}
+
+void MeshSimplifier::collapse(int from, int to) {
+    auto& toTriangles = _vertexTriangles[to];
+    for (auto t : _vertexTriangles[from]) {
+        if (_isTriangleRemoved[t]) {
+            continue;
+        }
+        auto& triangle = _triangles[t];
+        if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+            _isTriangleRemoved[t] = true;
+            _triangleCount--;
+        } else {
+            for (auto& index : triangle) {
+                if (index == from) {
+                    index = to;
+                }
+            }
+            toTriangles.push_back(t);
+        }
+    }
+    _vertexTriangles[from].clear();
+    toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(), [&](int t) {
+        return _isTriangleRemoved[t];
+    }), toTriangles.end());
+
+    _quadrics[to].add(_quadrics[from]);
+    _isVertexRemoved[from] = true;
+    _vertexVersions[to]++;
+
+    // the errors of the edges around the vertex changed with its quadric
+    for (auto t : toTriangles) {
+        for (auto index : _triangles[t]) {
+            if (index != to) {
+                pushCollapse(index, to);
+                pushCollapse(to, index);
+            }
+        }
+    }
+}
+
+void MeshSimplifier::simplify(size_t targetTriangleCount, float maxError) {
+    const double maxErrorSquared = (double)maxError * (double)maxError;
+    while (_triangleCount > targetTriangleCount && !_collapses.empty()) {
+        if (_collapses.front().error > maxErrorSquared) {
+            break;
+        }
+        std::pop_heap(_collapses.begin(), _collapses.end());
+        Collapse next = _collapses.back();
+        _collapses.pop_back();
+
+        if (_isVertexRemoved[next.from] || _isVertexRemoved[next.to] ||
+                _vertexVersions[next.from] != next.fromVersion || _vertexVersions[next.to] != next.toVersion) {
+            continue;
+        }
+        if (canCollapse(next.from, next.to)) {
+            collapse(next.from, next.to);
+        }
+    }
+}
+
+std::vector<std::vector<int>> MeshSimplifier::getPartTriangleIndices() const {
+    std::vector<std::vector<int>> partTriangleIndices(_numParts);
+    for (size_t t = 0; t < _triangles.size(); t++) {
+        if (!_isTriangleRemoved[t]) {
+            auto& indices = partTriangleIndices[_trianglePart[t]];
+            indices.insert(indices.end(), _triangles[t].begin(), _triangles[t].end());
+        }
+    }
+    return partTriangleIndices;
+}
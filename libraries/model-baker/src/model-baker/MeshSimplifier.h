@@ -0,0 +1,82 @@
+//
+//  MeshSimplifier.h
+//  model-baker/src/model-baker
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MeshSimplifier_h
+#define hifi_MeshSimplifier_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace baker {
+
+// Simplifies the triangles of a mesh by collapsing its edges in the order of their quadric error. The edges collapse
+// onto one of their vertices, so the simplified triangles refer to the vertices of the mesh and only need their own indices.
+// The vertices on the borders of the mesh, which include its UV seams, and between its parts stay where they are.
+class MeshSimplifier {
+public:
+    MeshSimplifier(const std::vector<glm::vec3>& positions, const std::vector<std::vector<int>>& partTriangleIndices);
+
+    // Collapses edges until there are at most targetTriangleCount triangles left, or until the next collapse
+    // would move the surface by more than maxError. Can go on from a previous call with a smaller target
+    void simplify(size_t targetTriangleCount, float maxError);
+
+    size_t getTriangleCount() const { return _triangleCount; }
+    std::vector<std::vector<int>> getPartTriangleIndices() const;
+
+private:
+    struct Quadric {
+        double a2 { 0.0 }, ab { 0.0 }, ac { 0.0 }, ad { 0.0 };
+        double b2 { 0.0 }, bc { 0.0 }, bd { 0.0 };
+        double c2 { 0.0 }, cd { 0.0 };
+        double d2 { 0.0 };
+
+        void addPlane(const glm::dvec3& normal, double distance);
+        void add(const Quadric& other);
+        double evalError(const glm::dvec3& point) const;
+    };
+
+    struct Collapse {
+        double error;
+        int from;
+        int to;
+        uint32_t fromVersion;
+        uint32_t toVersion;
+
+        bool operator<(const Collapse& other) const { return error > other.error; }
+    };
+
+    void pushCollapse(int from, int to);
+    bool canCollapse(int from, int to) const;
+    void collapse(int from, int to);
+
+    std::vector<glm::vec3> _positions;
+    std::vector<std::array<int, 3>> _triangles;
+    std::vector<int> _trianglePart;
+    std::vector<bool> _isTriangleRemoved;
+    size_t _numParts { 0 };
+    size_t _triangleCount { 0 };
+
+    std::vector<std::vector<int>> _vertexTriangles;
+    std::vector<Quadric> _quadrics;
+    std::vector<bool> _isVertexLocked;
+    std::vector<bool> _isVertexRemoved;
+    std::vector<uint32_t> _vertexVersions;
+
+    // a heap of the candidate collapses, the ones made stale by a collapse near them are skipped as they come out
+    std::vector<Collapse> _collapses;
+};
+
+}
+
+#endif // hifi_MeshSimplifier_h
@@ -16,6 +16,10 @@
 #include <gpu/Batch.h>
 #include <gpu/Stream.h>
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
 #include <QThreadPool>
 
 #include <Gzip.h>
@@ -85,7 +89,7 @@ namespace std {
     };
 }
 
-class GeometryReader : public QRunnable {
+class GeometryReader {
 public:
     GeometryReader(const ModelLoader& modelLoader, QWeakPointer<Resource>& resource, const QUrl& url, const GeometryMappingPair& mapping,
                    const QByteArray& data, bool combineParts, const QString& webMediaType) :
@@ -94,7 +98,7 @@ public:
         DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
     }
 
-    virtual void run() override;
+    void run();
 
 private:
     ModelLoader _modelLoader;
@@ -128,13 +132,6 @@ void GeometryReader::run() {
             throw QString("reply is NULL");
         }
 
-        // Ensure the resource has not been deleted
-        auto resource = _resource.toStrongRef();
-        if (!resource) {
-            qCWarning(modelnetworking) << "Abandoning load of" << _url << "; could not get strong ref";
-            return;
-        }
-
         if (_url.path().isEmpty()) {
             throw QString("url is invalid");
         }
@@ -174,6 +171,12 @@ void GeometryReader::run() {
             }
         }
 
+        // the resource isn't held while decoding, so that one released meanwhile isn't baked for nothing
+        if (!_resource.data()) {
+            qCDebug(modelnetworking) << "Abandoning load of" << _url << "; it was released";
+            return;
+        }
+
         // Do processing on the model
         baker::Baker modelBaker(hfmModel, _mapping.second, _mapping.first);
         modelBaker.run();
@@ -181,6 +184,13 @@ void GeometryReader::run() {
         auto processedHFMModel = modelBaker.getHFMModel();
         auto materialMapping = modelBaker.getMaterialMapping();
 
+        // Ensure the resource has not been deleted
+        auto resource = _resource.toStrongRef();
+        if (!resource) {
+            qCDebug(modelnetworking) << "Abandoning load of" << _url << "; it was released";
+            return;
+        }
+
         QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
                 Q_ARG(HFMModel::Pointer, processedHFMModel), Q_ARG(MaterialMapping, materialMapping));
     } catch (const std::exception&) {
@@ -199,6 +209,85 @@ void GeometryReader::run() {
     }
 }
 
+// The models waiting to be decoded, on threads of their own rather than on the global pool. The next decode to start is
+// the one whose resource has the highest load priority, and the decodes of the resources released while they waited
+// are dropped
+class GeometryDecodeQueue {
+public:
+    GeometryDecodeQueue() {
+        // leaves the rest of the cores to the rendering and to the other work of the global pool
+        _threadPool.setMaxThreadCount(std::max(QThread::idealThreadCount() / 2, 1));
+    }
+
+    ~GeometryDecodeQueue() {
+        _threadPool.clear();
+        _threadPool.waitForDone();
+    }
+
+    void push(const QWeakPointer<Resource>& resource, GeometryReader* reader, float priority) {
+        {
+            Lock lock(_mutex);
+            _entries.push_back({ resource, std::unique_ptr<GeometryReader>(reader), priority });
+        }
+        // every task runs the entry that is first when it starts, not the one pushed with it
+        _threadPool.start(new Task(*this));
+    }
+
+    void reprioritize(const QWeakPointer<Resource>& resource, float priority) {
+        Lock lock(_mutex);
+        for (auto& entry : _entries) {
+            if (entry.resource == resource) {
+                entry.priority = priority;
+            }
+        }
+    }
+
+private:
+    using Lock = std::lock_guard<std::mutex>;
+
+    class Task : public QRunnable {
+    public:
+        Task(GeometryDecodeQueue& queue) : _queue(queue) {}
+        void run() override {
+            if (auto reader = _queue.pop()) {
+                reader->run();
+            }
+        }
+    private:
+        GeometryDecodeQueue& _queue;
+    };
+
+    std::unique_ptr<GeometryReader> pop() {
+        Lock lock(_mutex);
+        _entries.erase(std::remove_if(_entries.begin(), _entries.end(), [](const Entry& entry) {
+            if (entry.resource.isNull()) {
+                DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
+                return true;
+            }
+            return false;
+        }), _entries.end());
+        auto first = std::max_element(_entries.begin(), _entries.end(), [](const Entry& a, const Entry& b) {
+            return a.priority < b.priority;
+        });
+        if (first == _entries.end()) {
+            return nullptr;
+        }
+        auto reader = std::move(first->reader);
+        _entries.erase(first);
+        return reader;
+    }
+
+    struct Entry {
+        QWeakPointer<Resource> resource;
+        std::unique_ptr<GeometryReader> reader;
+        float priority;
+    };
+
+    std::mutex _mutex;
+    std::vector<Entry> _entries;
+    QThreadPool _threadPool;
+};
+
 QUrl resolveTextureBaseUrl(const QUrl& url, const QUrl& textureBaseUrl) {
     return textureBaseUrl.isValid() ? textureBaseUrl : url;
 }
@@ -287,7 +376,8 @@ void GeometryResource::downloadFinished(const QByteArray& data) {
             _url = _effectiveBaseURL;
             _textureBaseURL = _effectiveBaseURL;
         }
-        QThreadPool::globalInstance()->start(new GeometryReader(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data, _combineParts, _request->getWebMediaType()));
+        DependencyManager::get<ModelCache>()->_decodeQueue->push(_self, new GeometryReader(_modelLoader, _self,
+            _effectiveBaseURL, _mappingPair, data, _combineParts, _request->getWebMediaType()), getLoadPriority());
     }
 }
 
@@ -348,6 +438,14 @@ void GeometryResource::setGeometryDefinition(HFMModel::Pointer hfmModel, const M
     finishedLoading(true);
 }
 
+void GeometryResource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
+    Resource::setLoadPriority(owner, priority);
+    // the decode may be waiting its turn
+    if (!isLoaded()) {
+        DependencyManager::get<ModelCache>()->_decodeQueue->reprioritize(_self, getLoadPriority());
+    }
+}
+
 void GeometryResource::deleter() {
     resetTextures();
     Resource::deleter();
@@ -365,7 +463,9 @@ void GeometryResource::resetTextures() {
     _materials.clear();
 }
 
-ModelCache::ModelCache() {
+ModelCache::ModelCache() :
+    _decodeQueue(new GeometryDecodeQueue())
+{
     const qint64 GEOMETRY_DEFAULT_UNUSED_MAX_SIZE = DEFAULT_UNUSED_MAX_SIZE;
     setUnusedResourceCacheSize(GEOMETRY_DEFAULT_UNUSED_MAX_SIZE);
     setObjectName("ModelCache");
@@ -376,6 +476,9 @@ ModelCache::ModelCache() {
     modelFormatRegistry->addFormat(GLTFSerializer());
 }
 
+ModelCache::~ModelCache() {
+}
+
 QSharedPointer<Resource> ModelCache::createResource(const QUrl& url) {
     return QSharedPointer<Resource>(new GeometryResource(url, _modelLoader), &GeometryResource::deleter);
 }
@@ -12,6 +12,8 @@
 #ifndef hifi_ModelCache_h
 #define hifi_ModelCache_h
 
+#include <memory>
+
 #include <DependencyManager.h>
 #include <ResourceCache.h>
 
@@ -23,6 +25,7 @@
 #include "ModelLoader.h"
 
 class MeshPart;
+class GeometryDecodeQueue;
 
 using GeometryMappingPair = std::pair<QUrl, QVariantHash>;
 Q_DECLARE_METATYPE(GeometryMappingPair)
@@ -88,6 +91,8 @@ public:
 
     virtual void deleter() override;
 
+    virtual void setLoadPriority(const QPointer<QObject>& owner, float priority) override;
+
     virtual void downloadFinished(const QByteArray& data) override;
     void setExtra(void* extra) override;
 
@@ -132,6 +137,11 @@ public:
     void setResource(GeometryResource::Pointer resource);
 
     QUrl getURL() const { return (bool)_resource ? _resource->getURL() : QUrl(); }
+    void setLoadPriority(const QPointer<QObject>& owner, float priority) {
+        if (_resource && !_resource->isLoaded()) {
+            _resource->setLoadPriority(owner, priority);
+        }
+    }
     int getResourceDownloadAttempts() { return _resource ? _resource->getDownloadAttempts() : 0; }
     int getResourceDownloadAttemptsRemaining() { return _resource ? _resource->getDownloadAttemptsRemaining() : 0; }
 
@@ -176,8 +186,9 @@ protected:
 
 private:
     ModelCache();
-    virtual ~ModelCache() = default;
+    virtual ~ModelCache();
     ModelLoader _modelLoader;
+    std::unique_ptr<GeometryDecodeQueue> _decodeQueue;
 };
 
 class MeshPart {
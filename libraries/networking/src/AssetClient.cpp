@@ -11,9 +11,11 @@
 
 #include "AssetClient.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include <QtCore/QBuffer>
+#include <QtCore/QDir>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QThread>
 #include <QtScript/QScriptEngine>
@@ -22,6 +24,7 @@
 #include <shared/GlobalAppProperties.h>
 #include <shared/MiniPromises.h>
 
+#include "AssetDiskCache.h"
 #include "AssetRequest.h"
 #include "AssetUpload.h"
 #include "AssetUtils.h"
@@ -53,6 +56,8 @@ AssetClient::AssetClient() {
             this, &AssetClient::handleNodeClientConnectionReset);
 }
 
+static const QString ASSET_CACHE_DIRECTORY = "assets";
+
 void AssetClient::initCaching() {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -79,6 +84,15 @@ void AssetClient::initCaching() {
                 << "(size:" << cache->maximumCacheSize() / BYTES_PER_GIGABYTES << "GB)";
     }
 
+    // whole assets are kept apart from the URLs in the disk cache, by their hash
+    if (!DependencyManager::isSet<AssetDiskCache>()) {
+        auto cacheDir = qobject_cast<QNetworkDiskCache*>(networkAccessManager.cache())->cacheDirectory();
+        auto assetCache = DependencyManager::set<AssetDiskCache>(QDir(cacheDir).filePath(ASSET_CACHE_DIRECTORY),
+                                                                 MAXIMUM_CACHE_SIZE);
+        assetCache->startScan();
+        qInfo() << "AssetClient asset cache setup at" << assetCache->getDirectory()
+                << "(size:" << MAXIMUM_CACHE_SIZE / BYTES_PER_GIGABYTES << "GB)";
+    }
 }
 
 namespace {
@@ -91,6 +105,8 @@ namespace {
  * @property {string} cacheDirectory - The path of the cache directory.
  * @property {number} cacheSize - The current cache size, in bytes.
  * @property {number} maximumCacheSize - The maximum cache size, in bytes.
+ * @property {number} assetCacheSize - The current size of the cache of ATP assets by their hash, in bytes.
+ * @property {number} maximumAssetCacheSize - The maximum size of the cache of ATP assets by their hash, in bytes.
  */
 MiniPromise::Promise AssetClient::cacheInfoRequestAsync(MiniPromise::Promise deferred) {
     if (!deferred) {
@@ -101,10 +117,19 @@ MiniPromise::Promise AssetClient::cacheInfoRequestAsync(MiniPromise::Promise def
     } else {
         auto cache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache());
         if (cache) {
+            qint64 assetCacheSize = 0;
+            qint64 maximumAssetCacheSize = 0;
+            if (DependencyManager::isSet<AssetDiskCache>()) {
+                auto assetCache = DependencyManager::get<AssetDiskCache>();
+                assetCacheSize = assetCache->getSize();
+                maximumAssetCacheSize = assetCache->getMaximumSize();
+            }
             deferred->resolve({
                 { "cacheDirectory", cache->cacheDirectory() },
                 { "cacheSize", cache->cacheSize() },
                 { "maximumCacheSize", cache->maximumCacheSize() },
+                { "assetCacheSize", assetCacheSize },
+                { "maximumAssetCacheSize", maximumAssetCacheSize },
             });
         } else {
             deferred->reject(CACHE_ERROR_MESSAGE.arg(__FUNCTION__).arg("cache unavailable"));
@@ -314,6 +339,10 @@ void AssetClient::clearCache() {
     } else {
         qCWarning(asset_client) << "No disk cache to clear.";
     }
+
+    if (DependencyManager::isSet<AssetDiskCache>()) {
+        DependencyManager::get<AssetDiskCache>()->clear();
+    }
 }
 
 void AssetClient::handleAssetMappingOperationReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -470,6 +499,41 @@ MessageID AssetClient::getAsset(const QString& hash, AssetUtils::DataOffset star
     return INVALID_MESSAGE_ID;
 }
 
+bool AssetClient::takeExtraStripe(AssetRequest* request) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    int budget = 0;
+    if (DependencyManager::isSet<ResourceCacheSharedItems>()) {
+        auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+        budget = (int)sharedItems->getRequestLimit() - (int)sharedItems->getLoadingRequestsCount();
+    }
+
+    if (_numExtraStripes < budget) {
+        _numExtraStripes++;
+        return true;
+    }
+
+    if (std::find(_requestsWaitingForStripes.begin(), _requestsWaitingForStripes.end(), request) ==
+        _requestsWaitingForStripes.end()) {
+        _requestsWaitingForStripes.push_back(request);
+    }
+    return false;
+}
+
+void AssetClient::releaseExtraStripe() {
+    _numExtraStripes--;
+
+    // wake up the request that has waited the longest, later, so that it isn't started from inside of another
+    while (!_requestsWaitingForStripes.empty()) {
+        QPointer<AssetRequest> request = _requestsWaitingForStripes.front();
+        _requestsWaitingForStripes.pop_front();
+        if (request) {
+            QMetaObject::invokeMethod(request, "requestNextStripes", Qt::QueuedConnection);
+            break;
+        }
+    }
+}
+
 MessageID AssetClient::getAssetInfo(const QString& hash, GetInfoCallback callback) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -545,7 +609,7 @@ void AssetClient::handleAssetGetReply(QSharedPointer<ReceivedMessage> message, S
     message->readHeadPrimitive(&error);
 
     AssetUtils::DataOffset length = 0;
-    if (!error) {
+    if (!error || error == AssetUtils::AssetServerError::Redirected) {
         message->readHeadPrimitive(&length);
     } else {
         qCWarning(asset_client) << "Failure getting asset: " << error;
@@ -697,7 +761,8 @@ MessageID AssetClient::getAssetMapping(const AssetUtils::AssetPath& path, Mappin
     return INVALID_MESSAGE_ID;
 }
 
-MessageID AssetClient::getAllAssetMappings(MappingOperationCallback callback) {
+MessageID AssetClient::getAllAssetMappings(const AssetUtils::AssetPath& afterPath, uint32_t limit,
+                                           MappingOperationCallback callback) {
     Q_ASSERT(QThread::currentThread() == thread());
 
     auto nodeList = DependencyManager::get<LimitedNodeList>();
@@ -711,6 +776,10 @@ MessageID AssetClient::getAllAssetMappings(MappingOperationCallback callback) {
 
         packetList->writePrimitive(AssetUtils::AssetMappingOperationType::GetAll);
 
+        // asset servers from before pages were added ignore these and reply with every mapping
+        packetList->writeString(afterPath);
+        packetList->writePrimitive(limit);
+
         if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
             _pendingMappingRequests[assetServer][messageID] = callback;
 
@@ -996,10 +1065,13 @@ void AssetClient::handleNodeClientConnectionReset(SharedNodePointer node) {
 
 void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
 
+    // the callbacks can cancel or make other requests, so work from lists of our own
     {
         auto messageMapIt = _pendingRequests.find(node);
         if (messageMapIt != _pendingRequests.end()) {
-            for (const auto& value : messageMapIt->second) {
+            std::unordered_map<MessageID, GetAssetRequestData> pendingRequests;
+            pendingRequests.swap(messageMapIt->second);
+            for (const auto& value : pendingRequests) {
                 auto& message = value.second.message;
                 if (message) {
                     // Disconnect from all signals emitting from the pending message
@@ -1008,18 +1080,18 @@ void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
 
                 value.second.completeCallback(false, AssetUtils::AssetServerError::NoError, QByteArray());
             }
-            messageMapIt->second.clear();
         }
     }
 
     {
         auto messageMapIt = _pendingInfoRequests.find(node);
         if (messageMapIt != _pendingInfoRequests.end()) {
+            std::unordered_map<MessageID, GetInfoCallback> pendingInfoRequests;
+            pendingInfoRequests.swap(messageMapIt->second);
             AssetInfo info { "", 0 };
-            for (const auto& value : messageMapIt->second) {
+            for (const auto& value : pendingInfoRequests) {
                 value.second(false, AssetUtils::AssetServerError::NoError, info);
             }
-            messageMapIt->second.clear();
         }
     }
 
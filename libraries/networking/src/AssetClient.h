@@ -12,10 +12,12 @@
 #ifndef hifi_AssetClient_h
 #define hifi_AssetClient_h
 
+#include <QPointer>
 #include <QStandardItemModel>
 #include <QtQml/QJSEngine>
 #include <QString>
 
+#include <deque>
 #include <map>
 
 #include <DependencyManager.h>
@@ -84,7 +86,7 @@ private slots:
 
 private:
     MessageID getAssetMapping(const AssetUtils::AssetHash& hash, MappingOperationCallback callback);
-    MessageID getAllAssetMappings(MappingOperationCallback callback);
+    MessageID getAllAssetMappings(const AssetUtils::AssetPath& afterPath, uint32_t limit, MappingOperationCallback callback);
     MessageID setAssetMapping(const QString& path, const AssetUtils::AssetHash& hash, MappingOperationCallback callback);
     MessageID deleteAssetMappings(const AssetUtils::AssetPathList& paths, MappingOperationCallback callback);
     MessageID renameAssetMapping(const AssetUtils::AssetPath& oldPath, const AssetUtils::AssetPath& newPath, MappingOperationCallback callback);
@@ -105,6 +107,12 @@ private:
 
     void forceFailureOfPendingRequests(SharedNodePointer node);
 
+    // the stripes of whole assets beyond the one each request always has in flight share the part of the ResourceCache
+    // request limit that no resource is loading with. requests that are turned away are woken up, in the order they
+    // asked, as stripes come back.
+    bool takeExtraStripe(AssetRequest* request);
+    void releaseExtraStripe();
+
     struct GetAssetRequestData {
         QSharedPointer<ReceivedMessage> message;
         ReceivedAssetCallback completeCallback;
@@ -117,6 +125,9 @@ private:
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadResultCallback>> _pendingUploads;
 
+    int _numExtraStripes { 0 };
+    std::deque<QPointer<AssetRequest>> _requestsWaitingForStripes;
+
     QString _cacheDir;
 
     friend class AssetRequest;
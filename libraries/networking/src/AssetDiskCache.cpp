@@ -0,0 +1,212 @@
+//
+//  AssetDiskCache.cpp
+//  libraries/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetDiskCache.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QRunnable>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThreadPool>
+
+#include "NetworkingConstants.h"
+#include "NetworkLogging.h"
+
+namespace {
+    // work on the cache off of the thread using it, for as long as the cache is still there
+    class AssetDiskCacheTask : public QRunnable {
+    public:
+        AssetDiskCacheTask(std::function<void(AssetDiskCache&)> task) : _task(task) {}
+
+        void run() override {
+            if (auto cache = DependencyManager::get<AssetDiskCache>()) {
+                _task(*cache);
+            }
+        }
+
+    private:
+        std::function<void(AssetDiskCache&)> _task;
+    };
+}
+
+AssetDiskCache::AssetDiskCache(const QString& directory, qint64 maximumSize) :
+    _directory(directory),
+    _maximumSize(maximumSize)
+{
+    _directory.mkpath(".");
+}
+
+void AssetDiskCache::startScan() {
+    QThreadPool::globalInstance()->start(new AssetDiskCacheTask([](AssetDiskCache& cache) {
+        cache.scan();
+    }));
+}
+
+AssetUtils::AssetHash AssetDiskCache::getHash(const QUrl& url) {
+    if (url.scheme() != URL_SCHEME_ATP || url.hasQuery()) {
+        return AssetUtils::AssetHash();
+    }
+    auto hash = url.path();
+    return AssetUtils::isValidHash(hash) ? hash.toLower() : AssetUtils::AssetHash();
+}
+
+QString AssetDiskCache::getFilePath(const AssetUtils::AssetHash& hash) const {
+    // spread the files over directories by the start of their hash, so that none of them gets too big
+    return _directory.filePath(hash.left(2) + "/" + hash);
+}
+
+QByteArray AssetDiskCache::load(const AssetUtils::AssetHash& hash) {
+    QFile file(getFilePath(hash));
+    if (!file.open(QIODevice::ReadOnly)) {
+        QMutexLocker locker(&_mutex);
+        auto it = _entries.find(hash);
+        if (it != _entries.end()) {
+            // deleted from under us
+            _size -= it->size;
+            _entries.erase(it);
+        }
+        return QByteArray();
+    }
+
+    QByteArray data = file.readAll();
+    if (data.size() != file.size()) {
+        qCWarning(asset_client) << "Failed to read" << hash << "from the asset cache";
+        return QByteArray();
+    }
+
+    // the modification time is when the asset was last used, so that the order survives a restart
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    touch(hash, data.size());
+    return data;
+}
+
+bool AssetDiskCache::save(const AssetUtils::AssetHash& hash, const QByteArray& data) {
+    if (data.size() > _maximumSize) {
+        return false;
+    }
+
+    QString filePath = getFilePath(hash);
+    QFile existingFile(filePath);
+    if (existingFile.exists() && existingFile.size() == data.size()) {
+        // the same hash is the same asset
+        existingFile.open(QIODevice::ReadWrite);
+        existingFile.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        touch(hash, data.size());
+        return true;
+    }
+
+    _directory.mkpath(hash.left(2));
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(asset_client) << "Failed to save" << hash << "to the asset cache at" << filePath;
+        return false;
+    }
+
+    touch(hash, data.size());
+    scheduleEviction();
+    return true;
+}
+
+void AssetDiskCache::touch(const AssetUtils::AssetHash& hash, qint64 size) {
+    QMutexLocker locker(&_mutex);
+    auto& entry = _entries[hash];
+    _size += size - entry.size;
+    entry.size = size;
+    entry.lastUsed = QDateTime::currentMSecsSinceEpoch();
+}
+
+void AssetDiskCache::clear() {
+    {
+        QMutexLocker locker(&_mutex);
+        _entries.clear();
+        _size = 0;
+    }
+
+    _directory.removeRecursively();
+    _directory.mkpath(".");
+}
+
+qint64 AssetDiskCache::getSize() const {
+    QMutexLocker locker(&_mutex);
+    return _size;
+}
+
+void AssetDiskCache::scheduleEviction() {
+    {
+        QMutexLocker locker(&_mutex);
+        if (_size <= _maximumSize || _evictionScheduled) {
+            return;
+        }
+        _evictionScheduled = true;
+    }
+
+    QThreadPool::globalInstance()->start(new AssetDiskCacheTask([](AssetDiskCache& cache) {
+        cache.evict();
+    }));
+}
+
+void AssetDiskCache::scan() {
+    QDirIterator it(_directory.absolutePath(), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        QFileInfo fileInfo = it.fileInfo();
+        auto hash = fileInfo.fileName();
+        if (!AssetUtils::isValidHash(hash)) {
+            continue;
+        }
+
+        QMutexLocker locker(&_mutex);
+        if (!_entries.contains(hash)) {
+            _entries[hash] = { fileInfo.size(), fileInfo.lastModified().toMSecsSinceEpoch() };
+            _size += fileInfo.size();
+        }
+    }
+
+    qCDebug(asset_client) << "Asset cache at" << _directory.absolutePath() << "holds" << getSize() << "bytes";
+    scheduleEviction();
+}
+
+void AssetDiskCache::evict() {
+    std::vector<AssetUtils::AssetHash> evicted;
+    {
+        QMutexLocker locker(&_mutex);
+        _evictionScheduled = false;
+
+        std::vector<std::pair<qint64, AssetUtils::AssetHash>> byLastUsed;
+        byLastUsed.reserve(_entries.size());
+        for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+            byLastUsed.emplace_back(it->lastUsed, it.key());
+        }
+        std::sort(byLastUsed.begin(), byLastUsed.end());
+
+        qint64 targetSize = _maximumSize / 100 * EVICT_TO_PERCENT;
+        for (auto& used : byLastUsed) {
+            if (_size <= targetSize) {
+                break;
+            }
+            auto it = _entries.find(used.second);
+            _size -= it->size;
+            _entries.erase(it);
+            evicted.push_back(used.second);
+        }
+    }
+
+    // an asset saved again while this runs is only downloaded again the next time it is used
+    for (auto& hash : evicted) {
+        QFile::remove(getFilePath(hash));
+    }
+    qCDebug(asset_client) << "Evicted" << evicted.size() << "assets from the asset cache";
+}
@@ -0,0 +1,75 @@
+//
+//  AssetDiskCache.h
+//  libraries/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetDiskCache_h
+#define hifi_AssetDiskCache_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QUrl>
+
+#include <DependencyManager.h>
+
+#include "AssetUtils.h"
+
+// An on disk cache of whole ATP assets, kept by the hash of what is in them rather than by the domain or URL they came
+// from, so an asset that has been downloaded once is never downloaded again from any domain while it is in the cache.
+// The least recently used assets are deleted on a background thread once the cache grows past its size.
+class AssetDiskCache : public Dependency {
+    SINGLETON_DEPENDENCY
+
+public:
+    // once full the cache is cut back to this part of its size, so that it isn't evicting after every asset
+    static const int EVICT_TO_PERCENT = 90;
+
+    // the hash of the whole asset an ATP URL is for, or an empty string when it isn't one
+    static AssetUtils::AssetHash getHash(const QUrl& url);
+
+    // counts up the assets already on disk, in the background, once the cache is set as a dependency
+    void startScan();
+
+    // the asset, or a null byte array when it isn't in the cache
+    QByteArray load(const AssetUtils::AssetHash& hash);
+    bool save(const AssetUtils::AssetHash& hash, const QByteArray& data);
+    void clear();
+
+    QString getDirectory() const { return _directory.absolutePath(); }
+    qint64 getSize() const;
+    qint64 getMaximumSize() const { return _maximumSize; }
+
+private:
+    class Entry {
+    public:
+        qint64 size { 0 };
+        qint64 lastUsed { 0 };
+    };
+
+    AssetDiskCache(const QString& directory, qint64 maximumSize);
+
+    QString getFilePath(const AssetUtils::AssetHash& hash) const;
+    void touch(const AssetUtils::AssetHash& hash, qint64 size);
+    void scheduleEviction();
+
+    // run on the thread pool
+    void scan();
+    void evict();
+
+    QDir _directory;
+    const qint64 _maximumSize;
+
+    mutable QMutex _mutex;
+    QHash<AssetUtils::AssetHash, Entry> _entries;
+    qint64 _size { 0 };
+    bool _evictionScheduled { false };
+};
+
+#endif // hifi_AssetDiskCache_h
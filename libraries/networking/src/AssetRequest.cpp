@@ -12,6 +12,7 @@
 #include "AssetRequest.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include <QtCore/QThread>
 
@@ -19,9 +20,11 @@
 #include <Trace.h>
 
 #include "AssetClient.h"
+#include "NetworkingConstants.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
 #include "ResourceCache.h"
+#include "ResourceManager.h"
 
 static int requestID = 0;
 
@@ -34,10 +37,7 @@ AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
 }
 
 AssetRequest::~AssetRequest() {
-    auto assetClient = DependencyManager::get<AssetClient>();
-    if (_assetRequestID) {
-        assetClient->cancelGetAssetRequest(_assetRequestID);
-    }
+    cancelPendingRequests();
 }
 
 void AssetRequest::start() {
@@ -75,6 +75,57 @@ void AssetRequest::start() {
 
     _state = WaitingForData;
 
+    if (_byteRange.isSet()) {
+        requestRange();
+        return;
+    }
+
+    // ask how big the asset is while the first stripe is on its way, which is all there is to small assets
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+    _assetInfoRequestID = assetClient->getAssetInfo(_hash,
+        [this, that](bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info) {
+
+        if (!that) {
+            return;
+        }
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+
+        if (_state == Finished || _size >= 0) {
+            return;
+        }
+
+        if (!responseReceived) {
+            fail(NetworkError);
+        } else if (serverError != AssetUtils::AssetServerError::NoError) {
+            fail(toError(serverError));
+        } else {
+            _size = info.size;
+            requestNextStripes();
+            checkFinished();
+        }
+    });
+
+    if (_state == Finished) {
+        return;
+    }
+
+    _nextStripeStart = STRIPE_SIZE;
+    requestStripe(0, STRIPE_SIZE, false);
+}
+
+AssetRequest::Error AssetRequest::toError(AssetUtils::AssetServerError serverError) {
+    switch (serverError) {
+        case AssetUtils::AssetServerError::AssetNotFound:
+            return NotFound;
+        case AssetUtils::AssetServerError::InvalidByteRange:
+            return InvalidByteRange;
+        default:
+            return UnknownError;
+    }
+}
+
+void AssetRequest::requestRange() {
     auto assetClient = DependencyManager::get<AssetClient>();
     auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
     auto hash = _hash;
@@ -89,41 +140,38 @@ void AssetRequest::start() {
         }
         _assetRequestID = INVALID_MESSAGE_ID;
 
+        if (responseReceived && serverError == AssetUtils::AssetServerError::Redirected) {
+            _httpRequest = requestFromURL(QUrl::fromEncoded(data), _byteRange, [this](bool success, const QByteArray& data) {
+                _httpRequest = nullptr;
+                if (success) {
+                    _data = data;
+                    _totalReceived += data.size();
+                    emit progress(_totalReceived, data.size());
+                } else {
+                    _error = NetworkError;
+                    qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+                }
+
+                _state = Finished;
+                emit finished(this);
+            });
+            return;
+        }
+
         if (!responseReceived) {
             _error = NetworkError;
         } else if (serverError != AssetUtils::AssetServerError::NoError) {
-            switch (serverError) {
-                case AssetUtils::AssetServerError::AssetNotFound:
-                    _error = NotFound;
-                    break;
-                case AssetUtils::AssetServerError::InvalidByteRange:
-                    _error = InvalidByteRange;
-                    break;
-                default:
-                    _error = UnknownError;
-                    break;
-            }
+            _error = toError(serverError);
         } else {
-            if (!_byteRange.isSet() && AssetUtils::hashData(data).toHex() != _hash) {
-                // the hash of the received data does not match what we expect, so we return an error
-                _error = HashVerificationFailed;
-            }
-
-            if (_error == NoError) {
-                _data = data;
-                _totalReceived += data.size();
-                emit progress(_totalReceived, data.size());
-
-                if (!_byteRange.isSet()) {
-                    AssetUtils::saveToCache(getUrl(), data);
-                }
-            }
+            _data = data;
+            _totalReceived += data.size();
+            emit progress(_totalReceived, data.size());
         }
-        
+
         if (_error != NoError) {
             qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
         }
-        
+
         _state = Finished;
         emit finished(this);
     }, [this, that](qint64 totalReceived, qint64 total) {
@@ -135,6 +183,261 @@ void AssetRequest::start() {
     });
 }
 
+void AssetRequest::requestStripe(int64_t start, int64_t end, bool extra) {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+    auto messageID = assetClient->getAsset(_hash, start, end,
+        [this, that, start](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
+
+        if (!that) {
+            return;
+        }
+
+        if (responseReceived && serverError == AssetUtils::AssetServerError::Redirected && _state != Finished) {
+            redirectStripe(start, QUrl::fromEncoded(data));
+            return;
+        }
+
+        Stripe stripe = takeStripe(start);
+        if (_state == Finished) {
+            return;
+        }
+
+        if (!responseReceived) {
+            fail(NetworkError);
+        } else if (serverError == AssetUtils::AssetServerError::InvalidByteRange && start == 0 && _size < 0) {
+            // an asset server that doesn't cut ranges short at the end of the file, and an asset smaller than a stripe
+            requestStripe(0, 0, false);
+        } else if (serverError != AssetUtils::AssetServerError::NoError) {
+            fail(toError(serverError));
+        } else {
+            handleStripe(start, stripe, data);
+        }
+    }, [this, that, start](qint64 totalReceived, qint64 total) {
+        if (!that) {
+            return;
+        }
+        auto it = _stripes.find(start);
+        if (it != _stripes.end()) {
+            it->second.received = totalReceived;
+            emitProgress();
+        }
+    });
+
+    if (messageID == INVALID_MESSAGE_ID) {
+        if (extra) {
+            assetClient->releaseExtraStripe();
+        }
+        return;
+    }
+    _stripes[start] = { messageID, end, 0, extra };
+}
+
+AssetRequest::Stripe AssetRequest::takeStripe(int64_t start) {
+    // whoever takes the stripe out of the map gives back its share, a stripe that failed to go out never got in
+    Stripe stripe { INVALID_MESSAGE_ID, 0, 0, false };
+    auto it = _stripes.find(start);
+    if (it != _stripes.end()) {
+        stripe = it->second;
+        _stripes.erase(it);
+        if (stripe.extra) {
+            DependencyManager::get<AssetClient>()->releaseExtraStripe();
+        }
+    }
+    return stripe;
+}
+
+void AssetRequest::redirectStripe(int64_t start, const QUrl& url) {
+    auto it = _stripes.find(start);
+    if (it == _stripes.end()) {
+        return;
+    }
+    it->second.messageID = INVALID_MESSAGE_ID;
+    it->second.received = 0;
+
+    ByteRange byteRange;
+    byteRange.fromInclusive = start;
+    byteRange.toExclusive = it->second.end;
+    auto request = requestFromURL(url, byteRange, [this, start](bool success, const QByteArray& data) {
+        Stripe stripe = takeStripe(start);
+        if (_state == Finished) {
+            return;
+        }
+
+        if (!success) {
+            fail(NetworkError);
+        } else {
+            handleStripe(start, stripe, data);
+        }
+    });
+
+    it = _stripes.find(start);
+    if (request && it != _stripes.end()) {
+        it->second.httpRequest = request;
+        connect(request, &ResourceRequest::progress, this, [this, start](qint64 bytesReceived, qint64 bytesTotal) {
+            auto it = _stripes.find(start);
+            if (it != _stripes.end()) {
+                it->second.received = bytesReceived;
+                emitProgress();
+            }
+        });
+    }
+}
+
+ResourceRequest* AssetRequest::requestFromURL(const QUrl& url, const ByteRange& byteRange,
+                                              std::function<void(bool success, const QByteArray& data)> callback) {
+    ResourceRequest* request = nullptr;
+    if ((url.scheme() == HIFI_URL_SCHEME_HTTP || url.scheme() == HIFI_URL_SCHEME_HTTPS) &&
+        DependencyManager::isSet<ResourceManager>()) {
+        request = DependencyManager::get<ResourceManager>()->createResourceRequest(nullptr, url,
+                                                                                ResourceRequest::IS_NOT_OBSERVABLE);
+    }
+    if (!request) {
+        qCWarning(asset_client) << "Asset server sent" << _hash << "to" << url << "which can't be fetched";
+        callback(false, QByteArray());
+        return nullptr;
+    }
+
+    // the asset cache keeps the whole asset once it is verified
+    request->setCacheEnabled(false);
+    request->setByteRange(byteRange);
+
+    connect(request, &ResourceRequest::finished, this, [request, byteRange, callback] {
+        request->deleteLater();
+        if (request->getResult() != ResourceRequest::Success) {
+            callback(false, QByteArray());
+            return;
+        }
+
+        auto data = request->getData();
+        if (byteRange.isSet() && !request->getRangeRequestSuccessful()) {
+            // the HTTP server ignored the range and sent all of it
+            data = byteRange.fromInclusive < 0 ? data.right((int)-byteRange.fromInclusive) :
+                data.mid((int)byteRange.fromInclusive, byteRange.toExclusive > 0 ? (int)byteRange.size() : -1);
+        }
+        callback(true, data);
+    });
+    request->send();
+    return request;
+}
+
+void AssetRequest::requestNextStripes() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    while (_state == WaitingForData && _size >= 0 && _nextStripeStart < _size &&
+           (int)_stripes.size() < MAX_STRIPES_IN_FLIGHT) {
+        bool extra = !_stripes.empty();
+        if (extra && !assetClient->takeExtraStripe(this)) {
+            break;
+        }
+        int64_t start = _nextStripeStart;
+        _nextStripeStart = std::min(start + STRIPE_SIZE, _size);
+        requestStripe(start, _nextStripeStart, extra);
+    }
+}
+
+void AssetRequest::handleStripe(int64_t start, const Stripe& stripe, const QByteArray& data) {
+    int64_t size = data.size();
+    if (stripe.end == 0) {
+        // the whole asset in one go
+        _size = size;
+    } else if (size < stripe.end - start) {
+        // only the first stripe can come back short, when the asset ends inside of it
+        if (start != 0 || (_size >= 0 && _size != size)) {
+            fail(SizeVerificationFailed);
+            return;
+        }
+        _size = size;
+    } else if (size != stripe.end - start) {
+        fail(SizeVerificationFailed);
+        return;
+    }
+
+    if (_data.size() < start + size) {
+        _data.resize((int)std::max(start + size, _size));
+    }
+    memcpy(_data.data() + start, data.constData(), size);
+    _totalReceived += size;
+    emitProgress();
+
+    requestNextStripes();
+    checkFinished();
+}
+
+void AssetRequest::checkFinished() {
+    if (_state == Finished || _size < 0 || _nextStripeStart < _size || !_stripes.empty() ||
+        (int64_t)_totalReceived < _size) {
+        return;
+    }
+
+    cancelPendingRequests();
+    _data.resize((int)_size);
+
+    if (AssetUtils::hashData(_data).toHex() != _hash) {
+        // the hash of the received data does not match what we expect, so we return an error
+        fail(HashVerificationFailed);
+        return;
+    }
+
+    AssetUtils::saveToCache(getUrl(), _data);
+
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::fail(Error error) {
+    cancelPendingRequests();
+
+    _error = error;
+    _data.clear();
+    qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::cancelPendingRequests() {
+    if (_assetRequestID == INVALID_MESSAGE_ID && _assetInfoRequestID == INVALID_MESSAGE_ID && _stripes.empty() &&
+        !_httpRequest) {
+        return;
+    }
+
+    auto assetClient = DependencyManager::get<AssetClient>();
+    if (_assetRequestID != INVALID_MESSAGE_ID) {
+        assetClient->cancelGetAssetRequest(_assetRequestID);
+        _assetRequestID = INVALID_MESSAGE_ID;
+    }
+    if (_assetInfoRequestID != INVALID_MESSAGE_ID) {
+        assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+    }
+    if (_httpRequest) {
+        _httpRequest->disconnect(this);
+        _httpRequest->deleteLater();
+        _httpRequest = nullptr;
+    }
+    for (auto& stripe : _stripes) {
+        if (stripe.second.httpRequest) {
+            stripe.second.httpRequest->disconnect(this);
+            stripe.second.httpRequest->deleteLater();
+        } else {
+            assetClient->cancelGetAssetRequest(stripe.second.messageID);
+        }
+        if (stripe.second.extra) {
+            assetClient->releaseExtraStripe();
+        }
+    }
+    _stripes.clear();
+}
+
+void AssetRequest::emitProgress() {
+    qint64 totalReceived = _totalReceived;
+    for (auto& stripe : _stripes) {
+        totalReceived += stripe.second.received;
+    }
+    emit progress(totalReceived, std::max(_size, (int64_t)0));
+}
+
 
 const QString AssetRequest::getErrorString() const {
     QString result;
@@ -12,6 +12,9 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <functional>
+#include <map>
+
 #include <QByteArray>
 #include <QObject>
 #include <QString>
@@ -21,6 +24,8 @@
 
 #include "ByteRange.h"
 
+class ResourceRequest;
+
 const QString ATP_SCHEME { "atp:" };
 
 class AssetRequest : public QObject {
@@ -43,6 +48,11 @@ public:
         UnknownError
     };
     Q_ENUM(Error)
+
+    // whole assets are fetched in stripes of this many bytes, up to this many at a time
+    static const int64_t STRIPE_SIZE = 1024 * 1024;
+    static const int MAX_STRIPES_IN_FLIGHT = 4;
+
     AssetRequest(const QString& hash, const ByteRange& byteRange = ByteRange());
     virtual ~AssetRequest() override;
 
@@ -62,6 +72,30 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    class Stripe {
+    public:
+        MessageID messageID;
+        int64_t end;
+        qint64 received;
+        bool extra;
+        ResourceRequest* httpRequest { nullptr }; // when the asset server has sent it to an HTTP server for it
+    };
+
+    static Error toError(AssetUtils::AssetServerError serverError);
+
+    void requestRange();
+    void requestStripe(int64_t start, int64_t end, bool extra);
+    Stripe takeStripe(int64_t start);
+    void redirectStripe(int64_t start, const QUrl& url);
+    ResourceRequest* requestFromURL(const QUrl& url, const ByteRange& byteRange,
+                                    std::function<void(bool success, const QByteArray& data)> callback);
+    Q_INVOKABLE void requestNextStripes();
+    void handleStripe(int64_t start, const Stripe& stripe, const QByteArray& data);
+    void checkFinished();
+    void fail(Error error);
+    void cancelPendingRequests();
+    void emitProgress();
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
@@ -70,8 +104,18 @@ private:
     QByteArray _data;
     int _numPendingRequests { 0 };
     MessageID _assetRequestID { INVALID_MESSAGE_ID };
+    ResourceRequest* _httpRequest { nullptr };
     const ByteRange _byteRange;
     bool _loadedFromCache { false };
+
+    // a whole asset comes in stripes, keyed by where they start, the first of which also tells how big a small asset
+    // is. the request can always have one stripe in flight, the others are shared with every other request.
+    int64_t _size { -1 };
+    int64_t _nextStripeStart { 0 };
+    std::map<int64_t, Stripe> _stripes;
+    MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
+
+    friend class AssetClient;
 };
 
 #endif
@@ -18,6 +18,7 @@
 #include <QtCore/QFileInfo> // for baseName
 #include <QtNetwork/QAbstractNetworkCache>
 
+#include "AssetDiskCache.h"
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 #include "NetworkingConstants.h"
@@ -64,11 +65,30 @@ QByteArray hashData(const QByteArray& data) {
 }
 
 QByteArray loadFromCache(const QUrl& url) {
+    // whole assets are looked for by their hash first, which doesn't depend on the domain they came from
+    auto hash = AssetDiskCache::getHash(url);
+    QSharedPointer<AssetDiskCache> assetCache;
+    if (!hash.isEmpty() && DependencyManager::isSet<AssetDiskCache>()) {
+        assetCache = DependencyManager::get<AssetDiskCache>();
+
+        auto data = assetCache->load(hash);
+        if (!data.isNull()) {
+            return data;
+        }
+    }
+
     if (auto cache = NetworkAccessManager::getInstance().cache()) {
 
         // caller is responsible for the deletion of the ioDevice, hence the unique_ptr
         if (auto ioDevice = std::unique_ptr<QIODevice>(cache->data(url))) {
-            return ioDevice->readAll();
+            auto data = ioDevice->readAll();
+            ioDevice.reset();
+
+            // move what was cached before there was an asset cache over to it
+            if (assetCache && assetCache->save(hash, data)) {
+                cache->remove(url);
+            }
+            return data;
         }
 
     }
@@ -77,6 +97,11 @@ QByteArray loadFromCache(const QUrl& url) {
 }
 
 bool saveToCache(const QUrl& url, const QByteArray& file) {
+    auto hash = AssetDiskCache::getHash(url);
+    if (!hash.isEmpty() && DependencyManager::isSet<AssetDiskCache>()) {
+        return DependencyManager::get<AssetDiskCache>()->save(hash, file);
+    }
+
     if (auto cache = NetworkAccessManager::getInstance().cache()) {
         if (!cache->metaData(url).isValid()) {
             QNetworkCacheMetaData metaData;
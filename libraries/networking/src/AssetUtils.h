@@ -46,7 +46,8 @@ enum AssetServerError : uint8_t {
     MappingOperationFailed,
     FileOperationFailed,
     NoAssetServer,
-    LostConnection
+    LostConnection,
+    Redirected // followed by the size and bytes of an HTTP URL to get the asset from
 };
 
 enum AssetMappingOperationType : uint8_t {
@@ -19,28 +19,43 @@
 #include <cassert>
 
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
-HMACAuth::HMACAuth(AuthMethod authMethod)
-    : _hmacContext(HMAC_CTX_new())
-    , _authMethod(authMethod) { }
+static HMAC_CTX* newContext() {
+    return HMAC_CTX_new();
+}
 
-HMACAuth::~HMACAuth()
-{
-    HMAC_CTX_free(_hmacContext);
+static void freeContext(HMAC_CTX* context) {
+    HMAC_CTX_free(context);
 }
 
 #else
 
+static HMAC_CTX* newContext() {
+    auto context = new HMAC_CTX();
+    HMAC_CTX_init(context);
+    return context;
+}
+
+static void freeContext(HMAC_CTX* context) {
+    HMAC_CTX_cleanup(context);
+    delete context;
+}
+#endif
+
 HMACAuth::HMACAuth(AuthMethod authMethod)
-    : _hmacContext(new HMAC_CTX())
+    : _hmacContext(newContext())
     , _authMethod(authMethod) {
-    HMAC_CTX_init(_hmacContext);
+    for (auto& pooledContext : _pooledContexts) {
+        pooledContext.context = newContext();
+    }
 }
 
 HMACAuth::~HMACAuth() {
-    HMAC_CTX_cleanup(_hmacContext);
-    delete _hmacContext;
+    freeContext(_hmacContext);
+
+    for (auto& pooledContext : _pooledContexts) {
+        freeContext(pooledContext.context);
+    }
 }
-#endif
 
 bool HMACAuth::setKey(const char* keyValue, int keyLen) {
     const EVP_MD* sslStruct = nullptr;
@@ -70,6 +85,9 @@ bool HMACAuth::setKey(const char* keyValue, int keyLen) {
         return false;
     }
 
+    // the pooled contexts pick this up the next time they're claimed
+    std::atomic_store(&_key, KeyPointer(new Key { QByteArray(keyValue, keyLen), sslStruct }));
+
     QMutexLocker lock(&_lock);
     return (bool) HMAC_Init_ex(_hmacContext, keyValue, keyLen, sslStruct, nullptr);
 }
@@ -105,6 +123,19 @@ HMACAuth::HMACHash HMACAuth::result() {
 }
 
 bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen) {
+    auto key = std::atomic_load(&_key);
+    if (!key) {
+        qCWarning(networking) << "HMACAuth::calculateHash called before a key was set";
+        return false;
+    }
+
+    if (auto pooledContext = acquireContext(key)) {
+        bool success = hashWithContext(pooledContext->context, hashResult, data, dataLen);
+        releaseContext(pooledContext);
+        return success;
+    }
+
+    // every pooled context is busy, share the locked one
     QMutexLocker lock(&_lock);
     if (!addData(data, dataLen)) {
         qCWarning(networking) << "Error occured calling HMACAuth::addData()";
@@ -115,3 +146,75 @@ bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen
     hashResult = result();
     return true;
 }
+
+bool HMACAuth::calculateHashes(const std::vector<HashInput>& inputs, std::vector<HMACHash>& hashResults) {
+    hashResults.resize(inputs.size());
+
+    auto key = std::atomic_load(&_key);
+    if (!key) {
+        qCWarning(networking) << "HMACAuth::calculateHashes called before a key was set";
+        return false;
+    }
+
+    auto pooledContext = acquireContext(key);
+    if (!pooledContext) {
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (!calculateHash(hashResults[i], inputs[i].first, inputs[i].second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool success = true;
+    for (size_t i = 0; i < inputs.size() && success; ++i) {
+        success = hashWithContext(pooledContext->context, hashResults[i], inputs[i].first, inputs[i].second);
+    }
+
+    releaseContext(pooledContext);
+    return success;
+}
+
+HMACAuth::PooledContext* HMACAuth::acquireContext(const KeyPointer& key) {
+    for (auto& pooledContext : _pooledContexts) {
+        if (!pooledContext.isInUse.load(std::memory_order_relaxed)
+            && !pooledContext.isInUse.exchange(true, std::memory_order_acquire)) {
+
+            if (pooledContext.key != key) {
+                if (!HMAC_Init_ex(pooledContext.context, key->value.constData(), key->value.length(), key->digest, nullptr)) {
+                    pooledContext.key.reset();
+                    releaseContext(&pooledContext);
+                    return nullptr;
+                }
+                pooledContext.key = key;
+            }
+
+            return &pooledContext;
+        }
+    }
+
+    return nullptr;
+}
+
+void HMACAuth::releaseContext(PooledContext* pooledContext) {
+    pooledContext->isInUse.store(false, std::memory_order_release);
+}
+
+bool HMACAuth::hashWithContext(HMAC_CTX* context, HMACHash& hashResult, const char* data, int dataLen) {
+    hashResult.resize(EVP_MAX_MD_SIZE);
+    unsigned int hashLen;
+
+    if (!HMAC_Update(context, reinterpret_cast<const unsigned char*>(data), dataLen)
+        || !HMAC_Final(context, hashResult.data(), &hashLen)) {
+        qCWarning(networking) << "Error occured calculating an HMAC";
+        // leave the context ready for the next hash
+        HMAC_Init_ex(context, nullptr, 0, nullptr, nullptr);
+        return false;
+    }
+
+    hashResult.resize((size_t)hashLen);
+
+    // Clear state for reuse with the same key.
+    HMAC_Init_ex(context, nullptr, 0, nullptr, nullptr);
+    return true;
+}
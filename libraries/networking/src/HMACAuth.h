@@ -12,8 +12,11 @@
 #ifndef hifi_HMACAuth_h
 #define hifi_HMACAuth_h
 
+#include <array>
+#include <atomic>
 #include <vector>
 #include <memory>
+#include <QtCore/QByteArray>
 #include <QtCore/QMutex>
 
 class QUuid;
@@ -22,6 +25,7 @@ class HMACAuth {
 public:
     enum AuthMethod { MD5, SHA1, SHA224, SHA256, RIPEMD160 };
     using HMACHash = std::vector<unsigned char>;
+    using HashInput = std::pair<const char*, int>;
     
     explicit HMACAuth(AuthMethod authMethod = MD5);
     ~HMACAuth();
@@ -29,7 +33,10 @@ public:
     bool setKey(const char* keyValue, int keyLen);
     bool setKey(const QUuid& uidKey);
     // Calculate complete hash in one.
+    // Safe to call from several threads at once, it only falls back to locking when they outnumber the pooled contexts.
     bool calculateHash(HMACHash& hashResult, const char* data, int dataLen);
+    // Calculate the hashes of several inputs with one context, results are in input order.
+    bool calculateHashes(const std::vector<HashInput>& inputs, std::vector<HMACHash>& hashResults);
 
     // Append to data to be hashed.
     bool addData(const char* data, int dataLen);
@@ -39,9 +46,30 @@ public:
     HMACHash result();
 
 private:
+    struct Key {
+        QByteArray value;
+        const struct evp_md_st* digest;
+    };
+    using KeyPointer = std::shared_ptr<const Key>;
+
+    // a context claimed by one calculateHash(es) call at a time, it is re-keyed lazily after setKey
+    struct PooledContext {
+        std::atomic<bool> isInUse { false };
+        struct hmac_ctx_st* context { nullptr };
+        KeyPointer key;
+    };
+    static const int NUM_POOLED_CONTEXTS = 4;
+
+    PooledContext* acquireContext(const KeyPointer& key);
+    void releaseContext(PooledContext* pooledContext);
+    static bool hashWithContext(struct hmac_ctx_st* context, HMACHash& hashResult, const char* data, int dataLen);
+
     QMutex _lock { QMutex::Recursive };
     struct hmac_ctx_st* _hmacContext;
     AuthMethod _authMethod;
+
+    KeyPointer _key; // published with std::atomic_store by setKey
+    std::array<PooledContext, NUM_POOLED_CONTEXTS> _pooledContexts;
 };
 
 #endif  // hifi_HMACAuth_h
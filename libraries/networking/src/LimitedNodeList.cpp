@@ -35,6 +35,7 @@
 #include "Assignment.h"
 #include "HifiSockAddr.h"
 #include "NetworkLogging.h"
+#include "udt/NetworkMetrics.h"
 #include "udt/Packet.h"
 #include "HMACAuth.h"
 
@@ -46,6 +47,8 @@
 
 static Setting::Handle<quint16> LIMITED_NODELIST_LOCAL_PORT("LimitedNodeList.LocalPort", 0);
 
+static const QString NETWORK_RECEIVE_THREAD_ENV = "HIFI_NETWORK_RECEIVE_THREAD";
+
 using namespace std::chrono_literals;
 static const std::chrono::milliseconds CONNECTION_RATE_INTERVAL_MS = 1s;
 
@@ -111,6 +114,9 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     // set our isPacketVerified method as the verify operator for the udt::Socket
     using std::placeholders::_1;
     _nodeSocket.setPacketFilterOperator(std::bind(&LimitedNodeList::isPacketVerified, this, _1));
+    // and verifyPacketBatch for the packets it reads in batches
+    using std::placeholders::_2;
+    _nodeSocket.setPacketBatchFilterOperator(std::bind(&LimitedNodeList::verifyPacketBatch, this, _1, _2));
 
     // set our socketBelongsToNode method as the connection creation filter operator for the udt::Socket
     _nodeSocket.setConnectionCreationFilterOperator(std::bind(&LimitedNodeList::sockAddrBelongsToNode, this, _1));
@@ -125,6 +131,43 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
         // we know the stun server socket, add it to unfiltered now
         addSTUNHandlerToUnfiltered();
     }
+
+    if (QProcessEnvironment::systemEnvironment().contains(NETWORK_RECEIVE_THREAD_ENV)) {
+        startDedicatedReceiveThread();
+    }
+}
+
+LimitedNodeList::~LimitedNodeList() {
+    stopDedicatedReceiveThread();
+}
+
+void LimitedNodeList::startDedicatedReceiveThread() {
+    if (_receiveThread) {
+        return;
+    }
+
+    _receiveThread = new QThread;
+    _receiveThread->setObjectName("Networking: Receive");
+    _receiveThread->start();
+
+    _nodeSocket.setSocketThread(_receiveThread);
+
+    qCDebug(networking) << "NodeList socket is now reading on a dedicated receive thread";
+}
+
+void LimitedNodeList::stopDedicatedReceiveThread() {
+    if (!_receiveThread) {
+        return;
+    }
+
+    // bring the socket back before the thread goes away, it is destroyed along with us
+    _nodeSocket.clearConnections();
+    _nodeSocket.setSocketThread(thread());
+
+    _receiveThread->quit();
+    _receiveThread->wait();
+    delete _receiveThread;
+    _receiveThread = nullptr;
 }
 
 QUuid LimitedNodeList::getSessionUUID() const {
@@ -286,7 +329,81 @@ bool LimitedNodeList::packetVersionMatch(const udt::Packet& packet) {
     }
 }
 
-bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet, Node* sourceNode) {
+bool LimitedNodeList::packetNeedsVerification(PacketType headerType) const {
+    bool verifiedPacket = !PacketTypeEnum::getNonVerifiedPackets().contains(headerType);
+    bool verificationEnabled = !(isDomainServer() && PacketTypeEnum::getDomainIgnoredVerificationPackets().contains(headerType))
+        && _useAuthentication;
+
+    return verifiedPacket && verificationEnabled;
+}
+
+void LimitedNodeList::verifyPacketBatch(const std::vector<const udt::Packet*>& packets, std::vector<bool>& verified) {
+    verified.assign(packets.size(), false);
+
+    std::vector<SharedNodePointer> sourceNodes(packets.size());
+    std::vector<QByteArray> expectedHashes(packets.size());
+    std::vector<bool> hasExpectedHash(packets.size(), false);
+
+    // look up each packet's source once, and group the packets that need a hash by the key that signed them
+    std::unordered_map<HMACAuth*, std::vector<size_t>> packetsByHMACAuth;
+    for (size_t i = 0; i < packets.size(); ++i) {
+        auto& packet = *packets[i];
+        PacketType headerType = NLPacket::typeInHeader(packet);
+
+        if (PacketTypeEnum::getNonSourcedPackets().contains(headerType)) {
+            continue;
+        }
+
+        sourceNodes[i] = nodeWithLocalID(NLPacket::sourceIDInHeader(packet));
+        if (sourceNodes[i] && sourceNodes[i]->getAuthenticateHash() && packetNeedsVerification(headerType)) {
+            packetsByHMACAuth[sourceNodes[i]->getAuthenticateHash()].push_back(i);
+        }
+    }
+
+    if (!packetsByHMACAuth.empty()) {
+        auto startTime = p_high_resolution_clock::now();
+        int numHashed = 0;
+
+        std::vector<HMACAuth::HashInput> inputs;
+        std::vector<HMACAuth::HMACHash> hashes;
+
+        for (auto& pair : packetsByHMACAuth) {
+            inputs.clear();
+            for (auto index : pair.second) {
+                inputs.push_back(NLPacket::hashedDataForPacket(*packets[index]));
+            }
+
+            if (!pair.first->calculateHashes(inputs, hashes)) {
+                // leave these to the per packet path, which reports the mismatch
+                continue;
+            }
+
+            for (size_t i = 0; i < pair.second.size(); ++i) {
+                auto index = pair.second[i];
+                expectedHashes[index] = QByteArray((const char*)hashes[i].data(), (int)hashes[i].size());
+                hasExpectedHash[index] = true;
+            }
+            numHashed += (int)pair.second.size();
+        }
+
+        recordPacketHashing(numHashed, p_high_resolution_clock::now() - startTime);
+    }
+
+    for (size_t i = 0; i < packets.size(); ++i) {
+        verified[i] = packetVersionMatch(*packets[i])
+            && packetSourceAndHashMatchAndTrackBandwidth(*packets[i], sourceNodes[i].data(),
+                                                         hasExpectedHash[i] ? &expectedHashes[i] : nullptr);
+    }
+}
+
+void LimitedNodeList::recordPacketHashing(int numPackets, p_high_resolution_clock::duration duration) {
+    _numHashedPackets.fetch_add(numPackets, std::memory_order_relaxed);
+    _packetHashingUsecs.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(duration).count(),
+                                  std::memory_order_relaxed);
+}
+
+bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet, Node* sourceNode,
+                                                                const QByteArray* precalculatedHash) {
 
     PacketType headerType = NLPacket::typeInHeader(packet);
 
@@ -341,17 +458,17 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
         }
 
         if (sourceNode) {
-            bool verifiedPacket = !PacketTypeEnum::getNonVerifiedPackets().contains(headerType);
-            bool verificationEnabled = !(isDomainServer() && PacketTypeEnum::getDomainIgnoredVerificationPackets().contains(headerType))
-                && _useAuthentication;
-
-            if (verifiedPacket && verificationEnabled) {
+            if (packetNeedsVerification(headerType)) {
 
                 QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
                 QByteArray expectedHash;
                 auto sourceNodeHMACAuth = sourceNode->getAuthenticateHash();
-                if (sourceNode->getAuthenticateHash()) {
+                if (precalculatedHash) {
+                    expectedHash = *precalculatedHash;
+                } else if (sourceNodeHMACAuth) {
+                    auto startTime = p_high_resolution_clock::now();
                     expectedHash = NLPacket::hashForPacketAndHMAC(packet, *sourceNodeHMACAuth);
+                    recordPacketHashing(1, p_high_resolution_clock::now() - startTime);
                 }
 
                 // check if the HMAC-md5 hash in the header matches the hash we would expect
@@ -386,6 +503,8 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
 }
 
 void LimitedNodeList::fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAuth) {
+    udt::NetworkMetrics::getInstance().recordSentPacket(packet.getType(), packet.getDataSize());
+
     if (!PacketTypeEnum::getNonSourcedPackets().contains(packet.getType())) {
         packet.writeSourceID(getSessionLocalID());
     }
@@ -577,17 +696,38 @@ NodeData* LimitedNodeList::getOrCreateLinkedData(SharedNodePointer node) {
 }
 
 SharedNodePointer LimitedNodeList::nodeWithUUID(const QUuid& nodeUUID) {
-    QReadLocker readLocker(&_nodeMutex);
+    auto snapshot = getNodeSnapshot();
 
-    NodeHash::const_iterator it = _nodeHash.find(nodeUUID);
-    return it == _nodeHash.cend() ? SharedNodePointer() : it->second;
+    auto it = snapshot->nodesByUUID.find(nodeUUID);
+    return it == snapshot->nodesByUUID.cend() ? SharedNodePointer() : it->second;
  }
 
 SharedNodePointer LimitedNodeList::nodeWithLocalID(Node::LocalID localID) const {
-    QReadLocker readLocker(&_nodeMutex);
+    auto snapshot = getNodeSnapshot();
+
+    auto idIter = snapshot->nodesByLocalID.find(localID);
+    return idIter == snapshot->nodesByLocalID.cend() ? nullptr : idIter->second;
+}
+
+void LimitedNodeList::updateNodeSnapshot() {
+    std::lock_guard<std::mutex> snapshotLock(_nodeSnapshotMutex);
+
+    // rebuilds are serialized and each one happens after the change that triggered it,
+    // so the last snapshot published always reflects every completed change
+    auto snapshot = std::make_shared<NodeSnapshot>();
+    snapshot->nodes.reserve(_nodeHash.size());
+    snapshot->nodesByUUID.reserve(_nodeHash.size());
+    for (const auto& pair : _nodeHash) {
+        snapshot->nodes.push_back(pair.second);
+        snapshot->nodesByUUID.emplace(pair.first, pair.second);
+    }
+
+    snapshot->nodesByLocalID.reserve(_localIDMap.size());
+    for (const auto& pair : _localIDMap) {
+        snapshot->nodesByLocalID.emplace(pair.first, pair.second);
+    }
 
-    LocalIDMapping::const_iterator idIter = _localIDMap.find(localID);
-    return idIter == _localIDMap.cend() ? nullptr : idIter->second;
+    std::atomic_store(&_nodeSnapshot, NodeSnapshotPointer(std::move(snapshot)));
 }
 
 void LimitedNodeList::eraseAllNodes(QString reason) {
@@ -608,6 +748,7 @@ void LimitedNodeList::eraseAllNodes(QString reason) {
         }
         _localIDMap.clear();
         _nodeHash.clear();
+        updateNodeSnapshot();
     }
 
     foreach(const SharedNodePointer& killedNode, killedNodes) {
@@ -633,6 +774,7 @@ bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID, ConnectionID newCo
             QWriteLocker writeLocker(&_nodeMutex);
             _localIDMap.unsafe_erase(matchingNode->getLocalID());
             _nodeHash.unsafe_erase(matchingNode->getUUID());
+            updateNodeSnapshot();
         }
 
         handleNodeKill(matchingNode, newConnectionID);
@@ -693,6 +835,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
                 QWriteLocker writeLocker(&_nodeMutex);
                 _localIDMap.unsafe_erase(node->getLocalID());
                 _nodeHash.unsafe_erase(node->getUUID());
+                updateNodeSnapshot();
             }
             handleNodeKill(node);
         }
@@ -737,6 +880,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         // insert the new node and release our read lock
         _nodeHash.insert({ newNode->getUUID(), newNodePointer });
         _localIDMap.insert({ localID, newNodePointer });
+        updateNodeSnapshot();
     }
 
     qCDebug(networking) << "Added" << *newNode;
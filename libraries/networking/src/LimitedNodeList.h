@@ -14,10 +14,13 @@
 
 #include <assert.h>
 #include <stdint.h>
+#include <atomic>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #ifndef _WIN32
 #include <unistd.h> // not on windows, not needed for mac or windows
@@ -34,6 +37,7 @@
 #include <TBBHelpers.h>
 
 #include <DependencyManager.h>
+#include <PortableHighResolutionClock.h>
 #include <SharedUtil.h>
 
 #include "DomainHandler.h"
@@ -73,6 +77,16 @@ const ConnectionID INITIAL_CONNECTION_ID { 0 };
 typedef std::pair<QUuid, SharedNodePointer> UUIDNodePair;
 typedef tbb::concurrent_unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
 
+// Immutable view of the node list. A new one is built whenever a node is added or removed and swapped in
+// atomically, so readers holding on to a snapshot never need the node mutex and never hold up a join or leave.
+// Nodes removed after a snapshot was taken remain visible (and alive) through it until it is released.
+struct NodeSnapshot {
+    std::vector<SharedNodePointer> nodes;
+    std::unordered_map<QUuid, SharedNodePointer, UUIDHasher> nodesByUUID;
+    std::unordered_map<Node::LocalID, SharedNodePointer> nodesByLocalID;
+};
+using NodeSnapshotPointer = std::shared_ptr<const NodeSnapshot>;
+
 typedef quint8 PingType_t;
 namespace PingType {
     const PingType_t Agnostic = 0;
@@ -81,6 +95,13 @@ namespace PingType {
     const PingType_t Symmetric = 3;
 }
 
+// what each record in a DomainList packet is about, a node that was added or changed or one that was removed
+typedef quint8 DomainListRecordType_t;
+namespace DomainListRecordType {
+    const DomainListRecordType_t Node = 0;
+    const DomainListRecordType_t RemovedNode = 1;
+}
+
 class LimitedNodeList : public QObject, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
@@ -116,6 +137,8 @@ public:
     };
     Q_ENUM(ConnectReason);
 
+    virtual ~LimitedNodeList();
+
     QUuid getSessionUUID() const;
     void setSessionUUID(const QUuid& sessionUUID);
     Node::LocalID getSessionLocalID() const;
@@ -166,7 +189,9 @@ public:
 
     std::function<void(Node*)> linkedDataCreateCallback;
 
-    size_t size() const { QReadLocker readLock(&_nodeMutex); return _nodeHash.size(); }
+    size_t size() const { return getNodeSnapshot()->nodes.size(); }
+
+    NodeSnapshotPointer getNodeSnapshot() const { return std::atomic_load(&_nodeSnapshot); }
 
     SharedNodePointer nodeWithUUID(const QUuid& nodeUUID);
     SharedNodePointer nodeWithLocalID(Node::LocalID localID) const;
@@ -205,10 +230,10 @@ public:
     using value_type = SharedNodePointer;
     using const_iterator = std::vector<value_type>::const_iterator;
 
-    // Cede control of iteration under a single read lock (e.g. for use by thread pools)
-    // Use this for nested loops instead of taking nested read locks!
-    //   This allows multiple threads (i.e. a thread pool) to share a lock
-    //   without deadlocking when a dying node attempts to acquire a write lock
+    // Cede control of iteration over a snapshot of the nodes (e.g. for use by thread pools)
+    // Use this for nested loops instead of nesting eachNode calls!
+    //   Every thread of the pool iterates the same snapshot without taking the node mutex,
+    //   so a dying node's write lock can never stall the pool
     template<typename NestedNodeLambda>
     void nestedEach(NestedNodeLambda functor,
                     int* lockWaitOut = nullptr,
@@ -217,29 +242,16 @@ public:
         quint64 start, endTransform, endFunctor;
 
         start = usecTimestampNow();
-        std::vector<SharedNodePointer> nodes;
-        {
-            QReadLocker readLock(&_nodeMutex);
-            auto endLock = usecTimestampNow();
-            if (lockWaitOut) {
-                *lockWaitOut = (endLock - start);
-            }
-
-            // Size of _nodeHash could change at any time,
-            // so reserve enough memory for the current size
-            // and then back insert all the nodes found
-            nodes.reserve(_nodeHash.size());
-            std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(nodes), [&](const NodeHash::value_type& it) {
-                return it.second;
-            });
-
-            endTransform = usecTimestampNow();
-            if (nodeTransformOut) {
-                *nodeTransformOut = (endTransform - endLock);
-            }
+        auto snapshot = getNodeSnapshot();
+        endTransform = usecTimestampNow();
+        if (lockWaitOut) {
+            *lockWaitOut = 0;
+        }
+        if (nodeTransformOut) {
+            *nodeTransformOut = (endTransform - start);
         }
 
-        functor(nodes.cbegin(), nodes.cend());
+        functor(snapshot->nodes.cbegin(), snapshot->nodes.cend());
         endFunctor = usecTimestampNow();
         if (functorOut) {
             *functorOut = (endFunctor - endTransform);
@@ -248,30 +260,30 @@ public:
 
     template<typename NodeLambda>
     void eachNode(NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        for (const auto& node : snapshot->nodes) {
+            functor(node);
         }
     }
 
     template<typename PredLambda, typename NodeLambda>
     void eachMatchingNode(PredLambda predicate, NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                functor(it->second);
+        for (const auto& node : snapshot->nodes) {
+            if (predicate(node)) {
+                functor(node);
             }
         }
     }
 
     template<typename BreakableNodeLambda>
     void eachNodeBreakable(BreakableNodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (!functor(it->second)) {
+        for (const auto& node : snapshot->nodes) {
+            if (!functor(node)) {
                 break;
             }
         }
@@ -279,11 +291,11 @@ public:
 
     template<typename PredLambda>
     SharedNodePointer nodeMatchingPredicate(const PredLambda predicate) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                return it->second;
+        for (const auto& node : snapshot->nodes) {
+            if (predicate(node)) {
+                return node;
             }
         }
 
@@ -311,11 +323,20 @@ public:
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
 
+    // sends any small unreliable packets being held for coalescing (HIFI_UDT_COALESCE_PACKETS), call after a frame's sends
+    void flushCoalescedPackets() { _nodeSocket.flushCoalescedPackets(); }
+
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
 
     bool isPacketVerifiedWithSource(const udt::Packet& packet, Node* sourceNode = nullptr);
     bool isPacketVerified(const udt::Packet& packet) { return isPacketVerifiedWithSource(packet); }
+    // verifies a batch of received packets, hashing all of the packets signed with the same key in one go
+    void verifyPacketBatch(const std::vector<const udt::Packet*>& packets, std::vector<bool>& verified);
+
+    // time spent calculating packet verification hashes on receipt, and how many were calculated
+    quint64 getPacketHashingUsecs() const { return _packetHashingUsecs.load(std::memory_order_relaxed); }
+    quint64 getNumHashedPackets() const { return _numHashedPackets.load(std::memory_order_relaxed); }
     void setAuthenticatePackets(bool useAuthentication) { _useAuthentication = useAuthentication; }
     bool getAuthenticatePackets() const { return _useAuthentication; }
 
@@ -338,6 +359,12 @@ public:
 
     void setDropOutgoingNodeTraffic(bool squelchOutgoingNodeTraffic) { _dropOutgoingNodeTraffic = squelchOutgoingNodeTraffic; }
 
+    // moves the udt::Socket (and so packet parsing, verification and PacketReceiver dispatch) off of the
+    // NodeList thread onto a thread of its own, opt-in with HIFI_NETWORK_RECEIVE_THREAD
+    void startDedicatedReceiveThread();
+    void stopDedicatedReceiveThread();
+    bool hasDedicatedReceiveThread() const { return _receiveThread != nullptr; }
+
     const std::set<NodeType_t> SOLO_NODE_TYPES = {
         NodeType::AvatarMixer,
         NodeType::AudioMixer,
@@ -419,7 +446,10 @@ protected:
 
     void setLocalSocket(const HifiSockAddr& sockAddr);
 
-    bool packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet, Node* sourceNode = nullptr);
+    bool packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet, Node* sourceNode = nullptr,
+                                                   const QByteArray* precalculatedHash = nullptr);
+    bool packetNeedsVerification(PacketType headerType) const;
+    void recordPacketHashing(int numPackets, p_high_resolution_clock::duration duration);
     void processSTUNResponse(std::unique_ptr<udt::BasePacket> packet);
 
     void handleNodeKill(const SharedNodePointer& node, ConnectionID newConnectionID = NULL_CONNECTION_ID);
@@ -438,6 +468,8 @@ protected:
 
     NodeHash _nodeHash;
     mutable QReadWriteLock _nodeMutex { QReadWriteLock::Recursive };
+    std::mutex _nodeSnapshotMutex; // serializes snapshot rebuilds, inserts happen under a read lock
+    NodeSnapshotPointer _nodeSnapshot { std::make_shared<NodeSnapshot>() };
     udt::Socket _nodeSocket;
     QUdpSocket* _dtlsSocket { nullptr };
     HifiSockAddr _localSockAddr;
@@ -445,8 +477,11 @@ protected:
     HifiSockAddr _stunSockAddr { STUN_SERVER_HOSTNAME, STUN_SERVER_PORT };
     bool _hasTCPCheckedLocalSocket { false };
     bool _useAuthentication { true };
+    std::atomic<quint64> _packetHashingUsecs { 0 };
+    std::atomic<quint64> _numHashedPackets { 0 };
 
     PacketReceiver* _packetReceiver;
+    QThread* _receiveThread { nullptr };
 
     NodePermissions _permissions;
 
@@ -469,8 +504,13 @@ protected:
         while (it != _nodeHash.end()) {
             functor(it);
         }
+
+        updateNodeSnapshot();
     }
 
+    // must be called after every change to _nodeHash or _localIDMap
+    void updateNodeSnapshot();
+
     std::unordered_map<QUuid, ConnectionID> _connectionIDs;
     quint64 _nodeConnectTimestamp{ 0 };
     quint64 _nodeDisconnectTimestamp{ 0 };
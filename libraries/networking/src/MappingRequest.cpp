@@ -104,8 +104,12 @@ void GetMappingRequest::doStart() {
 };
 
 void GetAllMappingsRequest::doStart() {
+    requestPage(AssetUtils::AssetPath());
+};
+
+void GetAllMappingsRequest::requestPage(const AssetUtils::AssetPath& afterPath) {
     auto assetClient = DependencyManager::get<AssetClient>();
-    _mappingRequestID = assetClient->getAllAssetMappings(
+    _mappingRequestID = assetClient->getAllAssetMappings(afterPath, MAPPINGS_PER_PAGE,
             [this, assetClient](bool responseReceived, AssetUtils::AssetServerError error, QSharedPointer<ReceivedMessage> message) {
 
         _mappingRequestID = INVALID_MESSAGE_ID;
@@ -138,10 +142,19 @@ void GetAllMappingsRequest::doStart() {
                 }
                 _mappings[path] = { hash, status, lastBakeErrors };
             }
+
+            // the path to carry on after, which is empty for the last page or from an asset server without pages
+            if (message->getBytesLeftToRead() > 0) {
+                auto nextPath = message->readString();
+                if (!nextPath.isEmpty()) {
+                    requestPage(nextPath);
+                    return;
+                }
+            }
         }
         emit finished(this);
     });
-};
+}
 
 SetMappingRequest::SetMappingRequest(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) :
     _path(path.trimmed()),
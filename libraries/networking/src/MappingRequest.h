@@ -126,7 +126,11 @@ signals:
     void finished(GetAllMappingsRequest* thisRequest);
 
 private:
+    // the mappings are asked for a page at a time, so that a big asset server isn't tied up by one reply
+    static const uint32_t MAPPINGS_PER_PAGE = 1000;
+
     virtual void doStart() override;
+    void requestPage(const AssetUtils::AssetPath& afterPath);
 
     AssetUtils::AssetMappings _mappings;
 };
@@ -59,58 +59,52 @@ void MessagesClient::decodeMessagesPacket(QSharedPointer<ReceivedMessage> receiv
     }
 }
 
-std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesPacket(QString channel, QString message, QUuid senderID) {
-    auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+QByteArray MessagesClient::encodeMessage(const QString& channel, bool isText, const QByteArray& payload,
+                                         const QUuid& senderID) {
+    QByteArray encoded;
 
     auto channelUtf8 = channel.toUtf8();
     quint16 channelLength = channelUtf8.length();
-    packetList->writePrimitive(channelLength);
-    packetList->write(channelUtf8);
+    encoded.append(reinterpret_cast<const char*>(&channelLength), sizeof(channelLength));
+    encoded.append(channelUtf8);
 
-    bool isTextMessage = true;
-    packetList->writePrimitive(isTextMessage);
+    encoded.append(reinterpret_cast<const char*>(&isText), sizeof(isText));
 
-    auto messageUtf8 = message.toUtf8();
-    quint32 messageLength = messageUtf8.length();
-    packetList->writePrimitive(messageLength);
-    packetList->write(messageUtf8);
+    quint32 payloadLength = payload.length();
+    encoded.append(reinterpret_cast<const char*>(&payloadLength), sizeof(payloadLength));
+    encoded.append(payload);
 
-    packetList->write(senderID.toRfc4122());
+    encoded.append(senderID.toRfc4122());
 
+    return encoded;
+}
+
+std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesPacket(QString channel, QString message, QUuid senderID) {
+    auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+    packetList->write(encodeMessage(channel, true, message.toUtf8(), senderID));
     return packetList;
 }
 
 std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID) {
     auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
-
-    auto channelUtf8 = channel.toUtf8();
-    quint16 channelLength = channelUtf8.length();
-    packetList->writePrimitive(channelLength);
-    packetList->write(channelUtf8);
-
-    bool isTextMessage = false;
-    packetList->writePrimitive(isTextMessage);
-
-    quint32 dataLength = data.length();
-    packetList->writePrimitive(dataLength);
-    packetList->write(data);
-
-    packetList->write(senderID.toRfc4122());
-
+    packetList->write(encodeMessage(channel, false, data, senderID));
     return packetList;
 }
 
-
 void MessagesClient::handleMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
     QString channel, message;
     QByteArray data;
     bool isText { false };
     QUuid senderID;
-    decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
-    if (isText) {
-        emit messageReceived(channel, message, senderID, false);
-    } else {
-        emit dataReceived(channel, data, senderID, false);
+
+    // the messages mixer sends all of the messages for a node since its last flush in one packet list
+    while (receivedMessage->getBytesLeftToRead() > 0) {
+        decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+        if (isText) {
+            emit messageReceived(channel, message, senderID, false);
+        } else {
+            emit dataReceived(channel, data, senderID, false);
+        }
     }
 }
 
@@ -164,6 +164,9 @@ public:
     static void decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
                                            bool& isText, QString& message, QByteArray& data, QUuid& senderID);
 
+    // one message as it is written in a MessagesData packet list, which can hold several of them one after another
+    static QByteArray encodeMessage(const QString& channel, bool isText, const QByteArray& payload, const QUuid& senderID);
+
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID);
 
@@ -51,7 +51,7 @@ public:
     static std::unique_ptr<NLPacket> create(PacketType type, qint64 size = -1,
                     bool isReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
     
-    static std::unique_ptr<NLPacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<NLPacket> fromReceivedPacket(udt::PacketBuffer data, qint64 size,
                                                         const HifiSockAddr& senderSockAddr);
 
     static std::unique_ptr<NLPacket> fromBase(std::unique_ptr<Packet> packet);
@@ -72,6 +72,8 @@ public:
     static LocalID sourceIDInHeader(const udt::Packet& packet);
     static QByteArray verificationHashInHeader(const udt::Packet& packet);
     static QByteArray hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& hash);
+    // the part of the packet covered by its verification hash
+    static std::pair<const char*, int> hashedDataForPacket(const udt::Packet& packet);
     
     PacketType getType() const { return _type; }
     void setType(PacketType type);
@@ -87,7 +89,7 @@ public:
 protected:
     
     NLPacket(PacketType type, qint64 size = -1, bool forceReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
-    NLPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr);
+    NLPacket(udt::PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr);
     
     NLPacket(const NLPacket& other);
     NLPacket(NLPacket&& other);
@@ -110,6 +110,14 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     // anytime we get a new node we may need to re-send our set of ignored node IDs to it
     connect(this, &LimitedNodeList::nodeActivated, this, &NodeList::maybeSendIgnoreSetToNode);
 
+    // a node we drop on our own, such as one gone silent, isn't in what changed on the domain server since our
+    // version of the list, ask for all of it again so that it comes back if it is still there
+    connect(this, &LimitedNodeList::nodeKilled, this, [this] {
+        if (!_isKillingNodeRemovedByDomainServer) {
+            _domainListVersion = 0;
+        }
+    });
+
     // setup our timer to send keepalive pings (it's started and stopped on domain connect/disconnect)
     _keepAlivePingTimer.setInterval(KEEPALIVE_PING_INTERVAL_MS); // 1s, Qt::CoarseTimer acceptable
     connect(&_keepAlivePingTimer, &QTimer::timeout, this, &NodeList::sendKeepAlivePings);
@@ -288,6 +296,10 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
 
+    // the next domain list has to be all of it
+    _domainListVersion = 0;
+    _pendingDomainListRecords.clear();
+
     // if we setup the DTLS socket, also disconnect from the DTLS socket readyRead() so it can handle handshaking
     if (_dtlsSocket) {
         disconnect(_dtlsSocket, 0, this, 0);
@@ -475,6 +487,9 @@ void NodeList::sendDomainServerCheckIn() {
                 const QByteArray& usernameSignature = accountManager->getAccountInfo().getUsernameSignature(connectionToken);
                 packetStream << usernameSignature;
             }
+        } else {
+            // the version of the domain list we already have, so that we're only sent what changed since
+            packetStream << _domainListVersion;
         }
 
         flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SendDSCheckIn);
@@ -707,6 +722,16 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     bool newConnection;
     packetStream >> newConnection;
 
+    // the version of the list this brings us to, and the version it has the changes since, 0 for all of the list
+    quint32 domainListVersion;
+    packetStream >> domainListVersion;
+
+    quint32 domainListBaseVersion;
+    packetStream >> domainListBaseVersion;
+
+    quint32 numRecords;
+    packetStream >> numRecords;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -786,9 +811,37 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
 
+    if (newConnection) {
+        _domainListVersion = 0;
+    }
+
+    // the list can be spread over packets that don't all make it here, and a check-in sent more than once is answered
+    // more than once, we only have the version once we've had every node in it
+    if (domainListVersion != _pendingDomainListVersion || connectRequestTimestamp != _pendingDomainListRequestTime) {
+        _pendingDomainListVersion = domainListVersion;
+        _pendingDomainListRequestTime = connectRequestTimestamp;
+        _pendingDomainListRecords.clear();
+    }
+
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        DomainListRecordType_t recordType;
+        packetStream >> recordType;
+
+        if (recordType == DomainListRecordType::RemovedNode) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            killNodeRemovedByDomainServer(nodeUUID);
+            _pendingDomainListRecords.insert(nodeUUID);
+        } else {
+            _pendingDomainListRecords.insert(parseNodeFromPacketStream(packetStream));
+        }
+    }
+
+    // changes are only good on top of the version they were made from, which we lose if we drop a node on our own
+    bool isBasedOnOurVersion = domainListBaseVersion == 0 || domainListBaseVersion == _domainListVersion;
+    if (isBasedOnOurVersion && (quint32)_pendingDomainListRecords.size() >= numRecords) {
+        _domainListVersion = domainListVersion;
     }
 }
 
@@ -804,11 +857,17 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     // read the UUID from the packet, remove it if it exists
     QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
     qCDebug(networking) << "Received packet from domain-server to remove node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
+    killNodeRemovedByDomainServer(nodeUUID);
+}
+
+void NodeList::killNodeRemovedByDomainServer(const QUuid& nodeUUID) {
+    _isKillingNodeRemovedByDomainServer = true;
     killNodeWithUUID(nodeUUID);
     removeDelayedAdd(nodeUUID);
+    _isKillingNodeRemovedByDomainServer = false;
 }
 
-void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
+QUuid NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     NewNodeInfo info;
 
     packetStream >> info.type
@@ -827,6 +886,7 @@ void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     }
 
     addNewNode(info);
+    return info.uuid;
 }
 
 void NodeList::sendAssignment(Assignment& assignment) {
@@ -160,7 +160,8 @@ private:
 
     void sendDSPathQuery(const QString& newPath);
 
-    void parseNodeFromPacketStream(QDataStream& packetStream);
+    QUuid parseNodeFromPacketStream(QDataStream& packetStream);
+    void killNodeRemovedByDomainServer(const QUuid& nodeUUID);
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
 
@@ -176,6 +177,14 @@ private:
 
     bool _sendDomainServerCheckInEnabled { true };
 
+    // the version of the domain list we have all of, the domain server only sends what changed since then
+    quint32 _domainListVersion { 0 };
+    // the version still being received, and the nodes of it received so far
+    quint32 _pendingDomainListVersion { 0 };
+    quint64 _pendingDomainListRequestTime { 0 };
+    QSet<QUuid> _pendingDomainListRecords;
+    bool _isKillingNodeRemovedByDomainServer { false };
+
     mutable QReadWriteLock _ignoredSetLock;
     tbb::concurrent_unordered_set<QUuid, UUIDHasher> _ignoredNodeIDs;
     mutable QReadWriteLock _personalMutedSetLock;
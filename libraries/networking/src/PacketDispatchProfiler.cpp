@@ -0,0 +1,112 @@
+//
+//  PacketDispatchProfiler.cpp
+//  libraries/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketDispatchProfiler.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QMetaEnum>
+#include <QtCore/QProcessEnvironment>
+
+static const QString PACKET_DISPATCH_PROFILING_ENV = "HIFI_PACKET_DISPATCH_PROFILING";
+
+PacketDispatchProfiler& PacketDispatchProfiler::getInstance() {
+    static PacketDispatchProfiler instance;
+    return instance;
+}
+
+const char* PacketDispatchProfiler::nameForType(PacketType type) {
+    static const QMetaEnum metaEnum =
+        PacketTypeEnum::staticMetaObject.enumerator(PacketTypeEnum::staticMetaObject.enumeratorOffset());
+    return metaEnum.valueToKey((int)type);
+}
+
+PacketDispatchProfiler::PacketDispatchProfiler() {
+    auto value = QProcessEnvironment::systemEnvironment().value(PACKET_DISPATCH_PROFILING_ENV);
+    _isEnabled = !value.isEmpty() && value != "0";
+}
+
+void PacketDispatchProfiler::recordDispatch(PacketType type, quint64 waitUsecs, quint64 dispatchUsecs) {
+    auto& stats = _types[(size_t)type];
+    stats.count.fetch_add(1, std::memory_order_relaxed);
+    stats.wait.record(waitUsecs);
+    stats.dispatch.record(dispatchUsecs);
+}
+
+QJsonObject PacketDispatchProfiler::toJson() const {
+    QJsonObject json;
+    for (size_t i = 0; i < _types.size(); ++i) {
+        auto& stats = _types[i];
+        auto count = stats.count.load(std::memory_order_relaxed);
+        if (count == 0) {
+            continue;
+        }
+
+        QJsonObject typeJson;
+        typeJson["count"] = (double)count;
+        typeJson["wait_usecs"] = stats.wait.toJson();
+        typeJson["dispatch_usecs"] = stats.dispatch.toJson();
+
+        json[nameForType((PacketType)i)] = typeJson;
+    }
+
+    return json;
+}
+
+void PacketDispatchProfiler::reset() {
+    for (auto& stats : _types) {
+        stats.count.store(0, std::memory_order_relaxed);
+        stats.wait.reset();
+        stats.dispatch.reset();
+    }
+}
+
+void PacketDispatchProfiler::Histogram::record(quint64 usecs) {
+    int bucket = 0;
+    while (bucket < NUM_BUCKETS - 1 && usecs >= ((quint64)1 << bucket)) {
+        ++bucket;
+    }
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    totalUsecs.fetch_add(usecs, std::memory_order_relaxed);
+
+    auto currentMax = maxUsecs.load(std::memory_order_relaxed);
+    while (usecs > currentMax && !maxUsecs.compare_exchange_weak(currentMax, usecs, std::memory_order_relaxed)) {}
+}
+
+QJsonObject PacketDispatchProfiler::Histogram::toJson() const {
+    QJsonArray bucketsJson;
+    quint64 count = 0;
+
+    // trim trailing empty buckets, the array index is the log2 upper bound
+    int lastBucket = NUM_BUCKETS - 1;
+    while (lastBucket > 0 && buckets[lastBucket].load(std::memory_order_relaxed) == 0) {
+        --lastBucket;
+    }
+
+    for (int i = 0; i <= lastBucket; ++i) {
+        auto value = buckets[i].load(std::memory_order_relaxed);
+        count += value;
+        bucketsJson.append((double)value);
+    }
+
+    QJsonObject json;
+    json["log2_buckets"] = bucketsJson;
+    json["avg"] = count > 0 ? (double)totalUsecs.load(std::memory_order_relaxed) / count : 0.0;
+    json["max"] = (double)maxUsecs.load(std::memory_order_relaxed);
+    return json;
+}
+
+void PacketDispatchProfiler::Histogram::reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    totalUsecs.store(0, std::memory_order_relaxed);
+    maxUsecs.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,70 @@
+//
+//  PacketDispatchProfiler.h
+//  libraries/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketDispatchProfiler_h
+#define hifi_PacketDispatchProfiler_h
+
+#include <array>
+#include <atomic>
+
+#include <QtCore/QJsonObject>
+
+#include "udt/PacketHeaders.h"
+
+// Opt-in timing of how PacketReceiver hands messages to their listeners, kept per PacketType.
+//
+// For every dispatched message it records how long the message waited between its first packet arriving at the socket
+// and its listener starting on it, and how long the listener took. Both go into log2 histograms of microseconds.
+// It is off by default since it takes timestamps around every dispatch; set HIFI_PACKET_DISPATCH_PROFILING=1 or
+// call setEnabled. The trace_network category additionally gets a trace range per dispatch while enabled.
+class PacketDispatchProfiler {
+public:
+    // bucket i counts samples below 2^i microseconds (bucket 0 is below 1us), the last bucket takes everything else
+    static const int NUM_BUCKETS = 20;
+
+    static PacketDispatchProfiler& getInstance();
+
+    static const char* nameForType(PacketType type);
+
+    bool isEnabled() const { return _isEnabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool isEnabled) { _isEnabled.store(isEnabled, std::memory_order_relaxed); }
+
+    void recordDispatch(PacketType type, quint64 waitUsecs, quint64 dispatchUsecs);
+
+    // per type counts and histograms for every type seen since the last reset
+    QJsonObject toJson() const;
+    void reset();
+
+private:
+    PacketDispatchProfiler();
+
+    struct Histogram {
+        void record(quint64 usecs);
+        QJsonObject toJson() const;
+        void reset();
+
+        std::array<std::atomic<quint32>, NUM_BUCKETS> buckets {};
+        std::atomic<quint64> totalUsecs { 0 };
+        std::atomic<quint64> maxUsecs { 0 };
+    };
+
+    struct TypeStats {
+        std::atomic<quint64> count { 0 };
+        Histogram wait;
+        Histogram dispatch;
+    };
+
+    std::array<TypeStats, (size_t)PacketType::NUM_PACKET_TYPE> _types;
+    std::atomic<bool> _isEnabled { false };
+};
+
+#endif // hifi_PacketDispatchProfiler_h
@@ -13,11 +13,80 @@
 #include "PacketReceiver.h"
 
 #include <QMutexLocker>
+#include <QThread>
+
+#include <PortableHighResolutionClock.h>
+#include <Profile.h>
 
 #include "DependencyManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
+#include "PacketDispatchProfiler.h"
 #include "SharedUtil.h"
+#include "udt/NetworkMetrics.h"
+
+static quint64 usecsSinceFirstPacket(const ReceivedMessage& message, p_high_resolution_clock::time_point now) {
+    auto nowUsecs = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+    auto receiveUsecs = message.getFirstPacketReceiveTime();
+    return nowUsecs > receiveUsecs ? (quint64)(nowUsecs - receiveUsecs) : 0;
+}
+
+// runs dispatch for the message, recording it with the PacketDispatchProfiler
+template <typename Dispatch>
+static void profileDispatch(const ReceivedMessage& message, Dispatch&& dispatch) {
+    auto startTime = p_high_resolution_clock::now();
+    {
+        PROFILE_RANGE(network, PacketDispatchProfiler::nameForType(message.getType()));
+        dispatch();
+    }
+    auto endTime = p_high_resolution_clock::now();
+
+    auto dispatchUsecs = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+    PacketDispatchProfiler::getInstance().recordDispatch(message.getType(), usecsSinceFirstPacket(message, startTime),
+                                                         dispatchUsecs);
+}
+
+static bool invokeListener(QObject* object, const QMetaMethod& metaMethod, Qt::ConnectionType connectionType,
+                           const QSharedPointer<ReceivedMessage>& receivedMessage, const SharedNodePointer& matchingNode) {
+    static const QByteArray QSHAREDPOINTER_NODE_NORMALIZED = QMetaObject::normalizedType("QSharedPointer<Node>");
+    static const QByteArray SHARED_NODE_NORMALIZED = QMetaObject::normalizedType("SharedNodePointer");
+
+    if (metaMethod.parameterTypes().contains(SHARED_NODE_NORMALIZED)) {
+        return metaMethod.invoke(object,
+                                 connectionType,
+                                 Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage),
+                                 Q_ARG(SharedNodePointer, matchingNode));
+
+    } else if (metaMethod.parameterTypes().contains(QSHAREDPOINTER_NODE_NORMALIZED)) {
+        return metaMethod.invoke(object,
+                                 connectionType,
+                                 Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage),
+                                 Q_ARG(QSharedPointer<Node>, matchingNode));
+
+    } else {
+        return metaMethod.invoke(object,
+                                 connectionType,
+                                 Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage));
+    }
+}
+
+static bool invokeProfiledListener(QObject* object, const QMetaMethod& metaMethod, Qt::ConnectionType connectionType,
+                                   QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer matchingNode) {
+    if (connectionType == Qt::DirectConnection || object->thread() == QThread::currentThread()) {
+        bool success = false;
+        profileDispatch(*receivedMessage, [&] {
+            success = invokeListener(object, metaMethod, Qt::DirectConnection, receivedMessage, matchingNode);
+        });
+        return success;
+    }
+
+    // queue it to the listener's thread like the plain invoke would, so that we can time it once it gets there
+    return QMetaObject::invokeMethod(object, [object, metaMethod, receivedMessage, matchingNode] {
+        profileDispatch(*receivedMessage, [&] {
+            invokeListener(object, metaMethod, Qt::DirectConnection, receivedMessage, matchingNode);
+        });
+    }, Qt::QueuedConnection);
+}
 
 PacketReceiver::PacketReceiver(QObject* parent) : QObject(parent) {
     qRegisterMetaType<QSharedPointer<NLPacket>>();
@@ -66,6 +135,99 @@ bool PacketReceiver::registerListenerForTypes(PacketTypeList types, QObject* lis
     return true;
 }
 
+PacketReceiver::MessageQueuePointer PacketReceiver::registerQueuedListenerForTypes(PacketTypeList types, QObject* listener,
+                                                                                  const char* slot) {
+    Q_ASSERT_X(!types.empty(), "PacketReceiver::registerQueuedListenerForTypes", "No types to register");
+    Q_ASSERT_X(listener, "PacketReceiver::registerQueuedListenerForTypes", "No object to register");
+    Q_ASSERT_X(slot, "PacketReceiver::registerQueuedListenerForTypes", "No slot to register");
+
+    // queued listeners are woken with a slot that takes no arguments, the messages come out of the queue
+    static const QString QUEUED_SIGNATURE_TEMPLATE("%1()");
+    QByteArray normalizedSlot = QMetaObject::normalizedSignature(QUEUED_SIGNATURE_TEMPLATE.arg(slot).toStdString().c_str());
+    int methodIndex = listener->metaObject()->indexOfSlot(normalizedSlot.constData());
+
+    if (methodIndex < 0) {
+        qCWarning(networking) << "PacketReceiver::registerQueuedListenerForTypes expected a slot with signature"
+            << normalizedSlot << "- but such a slot was not found.";
+        Q_ASSERT(methodIndex >= 0);
+        return MessageQueuePointer();
+    }
+
+    auto queue = std::make_shared<MessageQueue>();
+    queue->_object = listener;
+    queue->_wakeMethod = listener->metaObject()->method(methodIndex);
+
+    QMutexLocker locker(&_packetListenerLock);
+    for (auto type : types) {
+        if (_messageListenerMap.contains(type)) {
+            qCWarning(networking) << "Registering a queued packet listener for packet type" << type
+                << "that will remove a previously registered listener";
+        }
+
+        qCDebug(networking) << "Registering a queued packet listener for packet type" << type;
+        _messageListenerMap[type] = { QPointer<QObject>(listener), QMetaMethod(), false, queue };
+    }
+
+    return queue;
+}
+
+void PacketReceiver::MessageQueue::push(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    _messages.push({ message, sendingNode });
+
+    // only the first message since the last drain needs to go through the event loop
+    if (!_isWakePending.exchange(true, std::memory_order_acq_rel)) {
+        wake();
+    }
+}
+
+void PacketReceiver::MessageQueue::wake() {
+    if (_object) {
+        _wakeMethod.invoke(_object, Qt::QueuedConnection);
+    }
+}
+
+int PacketReceiver::MessageQueue::drain(const QueuedMessageHandler& handler, int maxMessages) {
+    int numHandled = 0;
+    QueuedMessage queuedMessage;
+
+    while (maxMessages < 0 || numHandled < maxMessages) {
+        if (!_messages.pop(queuedMessage)) {
+            // we're about to go idle - clear the pending flag, then look one more time so that a message pushed
+            // between the failed pop and the clear cannot be stranded without a wake
+            _isWakePending.store(false, std::memory_order_release);
+
+            if (_messages.isEmpty() || _isWakePending.exchange(true, std::memory_order_acq_rel)) {
+                // either there's nothing left or the producer already scheduled another wake for us
+                return numHandled;
+            }
+
+            continue;
+        }
+
+        if (PacketDispatchProfiler::getInstance().isEnabled()) {
+            profileDispatch(*queuedMessage.first, [&] {
+                handler(queuedMessage.first, queuedMessage.second);
+            });
+        } else {
+            handler(queuedMessage.first, queuedMessage.second);
+        }
+        queuedMessage = QueuedMessage();
+        ++numHandled;
+    }
+
+    // hit the batch limit with the wake flag still set, come back to the rest after the event loop has had a turn
+    if (!_messages.isEmpty()) {
+        wake();
+    } else {
+        _isWakePending.store(false, std::memory_order_release);
+        if (!_messages.isEmpty() && !_isWakePending.exchange(true, std::memory_order_acq_rel)) {
+            wake();
+        }
+    }
+
+    return numHandled;
+}
+
 void PacketReceiver::registerDirectListener(PacketType type, QObject* listener, const char* slot) {
     Q_ASSERT_X(listener, "PacketReceiver::registerDirectListener", "No object to register");
     Q_ASSERT_X(slot, "PacketReceiver::registerDirectListener", "No slot to register");
@@ -210,6 +372,7 @@ void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
     
     // setup an NLPacket from the packet we were passed
     auto nlPacket = NLPacket::fromBase(std::move(packet));
+    udt::NetworkMetrics::getInstance().recordReceivedPacket(nlPacket->getType(), nlPacket->getDataSize());
     auto receivedMessage = QSharedPointer<ReceivedMessage>::create(*nlPacket);
 
     handleVerifiedMessage(receivedMessage, true);
@@ -217,6 +380,7 @@ void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
 
 void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> packet) {
     auto nlPacket = NLPacket::fromBase(std::move(packet));
+    udt::NetworkMetrics::getInstance().recordReceivedPacket(nlPacket->getType(), nlPacket->getDataSize());
 
     auto key = std::pair<HifiSockAddr, udt::Packet::MessageNumber>(nlPacket->getSenderSockAddr(), nlPacket->getMessageNumber());
     auto it = _pendingMessages.find(key);
@@ -231,7 +395,8 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
         handleVerifiedMessage(message, true);
     } else {
         message = it->second;
-        message->appendPacket(*nlPacket);
+        // hand the packet over so its payload is read in place instead of being copied into the message
+        message->appendPacket(std::move(nlPacket));
 
         if (message->isComplete()) {
             _pendingMessages.erase(it);
@@ -261,7 +426,18 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
     QMutexLocker packetListenerLocker(&_packetListenerLock);
     
     auto it = _messageListenerMap.find(receivedMessage->getType());
-    if (it != _messageListenerMap.end() && it->method.isValid()) {
+    if (it != _messageListenerMap.end() && it->queue) {
+        // queued listeners only ever see complete messages
+        if (receivedMessage->isComplete()) {
+            if (it->object) {
+                it->queue->push(receivedMessage, matchingNode);
+            } else {
+                qCDebug(networking).nospace() << "Queued listener for packet " << receivedMessage->getType()
+                    << " has been destroyed. Removing from listener map.";
+                _messageListenerMap.erase(it);
+            }
+        }
+    } else if (it != _messageListenerMap.end() && it->method.isValid()) {
          
         auto listener = it.value();
 
@@ -280,27 +456,12 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
 
         QMetaMethod metaMethod = listener.method;
 
-        static const QByteArray QSHAREDPOINTER_NODE_NORMALIZED = QMetaObject::normalizedType("QSharedPointer<Node>");
-        static const QByteArray SHARED_NODE_NORMALIZED = QMetaObject::normalizedType("SharedNodePointer");
-
         // one final check on the QPointer before we go to invoke
         if (listener.object) {
-            if (metaMethod.parameterTypes().contains(SHARED_NODE_NORMALIZED)) {
-                success = metaMethod.invoke(listener.object,
-                                            connectionType,
-                                            Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage),
-                                            Q_ARG(SharedNodePointer, matchingNode));
-
-            } else if (metaMethod.parameterTypes().contains(QSHAREDPOINTER_NODE_NORMALIZED)) {
-                success = metaMethod.invoke(listener.object,
-                                            connectionType,
-                                            Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage),
-                                            Q_ARG(QSharedPointer<Node>, matchingNode));
-
+            if (PacketDispatchProfiler::getInstance().isEnabled()) {
+                success = invokeProfiledListener(listener.object, metaMethod, connectionType, receivedMessage, matchingNode);
             } else {
-                success = metaMethod.invoke(listener.object,
-                                            connectionType,
-                                            Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage));
+                success = invokeListener(listener.object, metaMethod, connectionType, receivedMessage, matchingNode);
             }
         } else {
             qCDebug(networking).nospace() << "Listener for packet " << receivedMessage->getType()
@@ -13,6 +13,9 @@
 #ifndef hifi_PacketReceiver_h
 #define hifi_PacketReceiver_h
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
@@ -23,8 +26,11 @@
 #include <QtCore/QPointer>
 #include <QtCore/QSet>
 
+#include <SPSCQueue.h>
+
 #include "NLPacket.h"
 #include "NLPacketList.h"
+#include "Node.h"
 #include "ReceivedMessage.h"
 #include "udt/PacketHeaders.h"
 
@@ -44,7 +50,33 @@ class PacketReceiver : public QObject {
     Q_OBJECT
 public:
     using PacketTypeList = std::vector<PacketType>;
-    
+    using QueuedMessageHandler = std::function<void(QSharedPointer<ReceivedMessage>, SharedNodePointer)>;
+
+    // Messages for a queued listener are pushed into a lock-free queue instead of being delivered one at a time
+    // through the Qt event loop. The listener's slot (taking no arguments) is invoked once whenever the queue goes
+    // from empty to non-empty and is expected to drain the queue it was handed at registration.
+    // The queue has a single producer (the thread running the udt::Socket) and a single consumer (the listener).
+    class MessageQueue {
+    public:
+        // hands queued messages to the handler in arrival order, returns the number of messages handled
+        // if maxMessages is hit with messages remaining, the listener slot is invoked again from the event loop
+        int drain(const QueuedMessageHandler& handler, int maxMessages = -1);
+
+    private:
+        using QueuedMessage = std::pair<QSharedPointer<ReceivedMessage>, SharedNodePointer>;
+
+        void push(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+        void wake();
+
+        SPSCQueue<QueuedMessage> _messages;
+        std::atomic<bool> _isWakePending { false };
+        QPointer<QObject> _object;
+        QMetaMethod _wakeMethod;
+
+        friend class PacketReceiver;
+    };
+    using MessageQueuePointer = std::shared_ptr<MessageQueue>;
+
     PacketReceiver(QObject* parent = 0);
     PacketReceiver(const PacketReceiver&) = delete;
 
@@ -57,6 +89,7 @@ public:
     // for the message is received.
     bool registerListener(PacketType type, QObject* listener, const char* slot, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
+    MessageQueuePointer registerQueuedListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
     void unregisterListener(QObject* listener);
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
@@ -68,6 +101,7 @@ private:
         QPointer<QObject> object;
         QMetaMethod method;
         bool deliverPending;
+        MessageQueuePointer queue;
     };
 
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
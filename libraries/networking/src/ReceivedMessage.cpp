@@ -32,6 +32,7 @@ ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
       _packetVersion(packetList.getVersion()),
       _senderSockAddr(packetList.getSenderSockAddr())
 {
+    _size = _data.size();
     _firstPacketReceiveTime = duration_cast<microseconds>(packetList.getFirstPacketReceiveTime().time_since_epoch()).count();
 }
 
@@ -45,6 +46,7 @@ ReceivedMessage::ReceivedMessage(NLPacket& packet)
       _senderSockAddr(packet.getSenderSockAddr()),
       _isComplete(packet.getPacketPosition() == NLPacket::ONLY)
 {
+    _size = _data.size();
     _firstPacketReceiveTime = duration_cast<microseconds>(packet.getReceiveTime().time_since_epoch()).count();
 }
 
@@ -60,6 +62,7 @@ ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, Pa
     _senderSockAddr(senderSockAddr),
     _isComplete(true)
 {
+    _size = _data.size();
 }
 
 void ReceivedMessage::setFailed() {
@@ -72,21 +75,39 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
     Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
                "We should not be appending to a complete message");
 
+    // we don't own this packet, so its payload has to be copied
+    auto packetCopy = NLPacket::createCopy(packet);
+    appendPacket(std::move(packetCopy));
+}
+
+void ReceivedMessage::appendPacket(std::unique_ptr<NLPacket> packet) {
+    Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket",
+               "We should not be appending to a complete message");
+
     // Limit progress signal to every X packets
     const int EMIT_PROGRESS_EVERY_X_PACKETS = 50;
 
     ++_numPackets;
 
-    _data.append(packet.getPayload(), packet.getPayloadSize());
+    if (_segments.empty()) {
+        segment();
+    }
+
+    // point straight into the packet payload and keep the packet alive for as long as we need it
+    _segments.push_back({ packet->getPayload(), packet->getPayloadSize(), _size });
+    _size += packet->getPayloadSize();
+
+    auto packetPosition = packet->getPacketPosition();
+    auto receiveTime = packet->getReceiveTime();
+    _segmentPackets.push_back(std::move(packet));
 
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
         emit progress(getSize());
     }
 
-    auto packetPosition = packet.getPacketPosition();
     if ((packetPosition == NLPacket::PacketPosition::FIRST) ||
         (packetPosition == NLPacket::PacketPosition::ONLY)) {
-        _firstPacketReceiveTime = duration_cast<microseconds>(packet.getReceiveTime().time_since_epoch()).count();
+        _firstPacketReceiveTime = duration_cast<microseconds>(receiveTime.time_since_epoch()).count();
     }
 
     if (packetPosition == NLPacket::PacketPosition::LAST) {
@@ -95,7 +116,66 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
     }
 }
 
+void ReceivedMessage::segment() {
+    // whatever we already hold contiguously becomes the first segment
+    _firstSegmentData = _data;
+    _data = QByteArray();
+
+    if (_firstSegmentData.size() > 0) {
+        _segments.push_back({ _firstSegmentData.constData(), _firstSegmentData.size(), 0 });
+    }
+}
+
+void ReceivedMessage::coalesce() const {
+    if (_segments.empty()) {
+        return;
+    }
+
+    QByteArray data;
+    data.resize(_size);
+    for (const auto& segment : _segments) {
+        memcpy(data.data() + segment.offset, segment.data, segment.size);
+    }
+
+    _data = data;
+
+    _segments.clear();
+    _segmentPackets.clear();
+    _firstSegmentData = QByteArray();
+}
+
+int ReceivedMessage::segmentIndexForPosition(qint64 position) const {
+    // find the last segment starting at or before position
+    auto it = std::upper_bound(_segments.begin(), _segments.end(), position, [](qint64 position, const Segment& segment) {
+        return position < segment.offset;
+    });
+    return (int)(it - _segments.begin()) - 1;
+}
+
+qint64 ReceivedMessage::copySegmented(char* data, qint64 position, qint64 size) const {
+    qint64 bytesLeft = std::max(_size - position, (qint64)0);
+    qint64 sizeToCopy = std::min(size, bytesLeft);
+    qint64 copied = 0;
+
+    int index = segmentIndexForPosition(position);
+    while (copied < sizeToCopy && index >= 0 && index < (int)_segments.size()) {
+        const auto& segment = _segments[index];
+        qint64 offsetInSegment = position + copied - segment.offset;
+        qint64 chunkSize = std::min(segment.size - offsetInSegment, sizeToCopy - copied);
+
+        memcpy(data + copied, segment.data + offsetInSegment, chunkSize);
+        copied += chunkSize;
+        ++index;
+    }
+
+    return copied;
+}
+
 qint64 ReceivedMessage::peek(char* data, qint64 size) {
+    if (!_segments.empty()) {
+        return copySegmented(data, _position, size);
+    }
+
     size_t bytesLeft = _data.size() - _position;
     size_t sizeRead = std::min((size_t)size, bytesLeft);
     memcpy(data, _data.constData() + _position, sizeRead);
@@ -103,6 +183,12 @@ qint64 ReceivedMessage::peek(char* data, qint64 size) {
 }
 
 qint64 ReceivedMessage::read(char* data, qint64 size) {
+    if (!_segments.empty()) {
+        auto sizeRead = copySegmented(data, _position, size);
+        _position += sizeRead;
+        return sizeRead;
+    }
+
     size_t bytesLeft = _data.size() - _position;
     size_t sizeRead = std::min((size_t)size, bytesLeft);
     memcpy(data, _data.constData() + _position, sizeRead);
@@ -119,11 +205,18 @@ qint64 ReceivedMessage::readHead(char* data, qint64 size) {
 }
 
 QByteArray ReceivedMessage::peek(qint64 size) {
+    if (!_segments.empty()) {
+        QByteArray data;
+        data.resize(std::max(std::min(size, getBytesLeftToRead()), (qint64)0));
+        copySegmented(data.data(), _position, data.size());
+        return data;
+    }
+
     return _data.mid(_position, size);
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
+    auto data = peek(size);
     _position += size;
     return data;
 }
@@ -142,12 +235,32 @@ QString ReceivedMessage::readString() {
     uint32_t size;
     readPrimitive(&size);
     //Q_ASSERT(size <= _size - _position);
+    if (!_segments.empty()) {
+        return QString::fromUtf8(read(size));
+    }
+
     auto string = QString::fromUtf8(_data.constData() + _position, size);
     _position += size;
     return string;
 }
 
 QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
+    if (!_segments.empty()) {
+        int index = segmentIndexForPosition(_position);
+        if (index >= 0) {
+            const auto& segment = _segments[index];
+            qint64 offsetInSegment = _position - segment.offset;
+            if (offsetInSegment + size <= segment.size) {
+                // the whole range lives in one packet, hand out a view of it
+                QByteArray data { QByteArray::fromRawData(segment.data + offsetInSegment, size) };
+                _position += size;
+                return data;
+            }
+        }
+
+        coalesce();
+    }
+
     QByteArray data { QByteArray::fromRawData(_data.constData() + _position, size) };
     _position += size;
     return data;
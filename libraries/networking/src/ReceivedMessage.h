@@ -16,6 +16,8 @@
 #include <QObject>
 
 #include <atomic>
+#include <memory>
+#include <vector>
 
 #include "NLPacketList.h"
 
@@ -27,8 +29,10 @@ public:
     ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                     const HifiSockAddr& senderSockAddr, NLPacket::LocalID sourceID = NLPacket::NULL_LOCAL_ID);
 
-    QByteArray getMessage() const { return _data; }
-    const char* getRawMessage() const { return _data.constData(); }
+    // these need the message in one contiguous block, a message assembled from multiple packets is coalesced
+    // the first time either is called - prefer the read methods below for large messages
+    QByteArray getMessage() const { coalesce(); return _data; }
+    const char* getRawMessage() const { coalesce(); return _data.constData(); }
 
     PacketType getType() const { return _packetType; }
     PacketVersion getVersion() const { return _packetVersion; }
@@ -37,6 +41,12 @@ public:
 
     void appendPacket(NLPacket& packet);
 
+    // takes ownership of the packet and reads its payload in place, without copying it into the message
+    void appendPacket(std::unique_ptr<NLPacket> packet);
+
+    // true while the message is stored as a chain of packet payloads rather than a single block
+    bool isSegmented() const { return !_segments.empty(); }
+
     bool failed() const { return _failed; }
     bool isComplete() const { return _isComplete; }
 
@@ -50,9 +60,9 @@ public:
 
     qint64 getFirstPacketReceiveTime() const { return _firstPacketReceiveTime; }
 
-    qint64 getSize() const { return _data.size(); }
+    qint64 getSize() const { return _size; }
 
-    qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
+    qint64 getBytesLeftToRead() const { return _size -  _position; }
 
     void seek(qint64 position) { _position = position; }
 
@@ -74,6 +84,7 @@ public:
     // This will return a QByteArray referencing the underlying data _without_ refcounting that data.
     // Be careful when using this method, only use it when the lifetime of the returned QByteArray will not
     // exceed that of the ReceivedMessage.
+    // If the requested range spans more than one packet of a segmented message the message is coalesced first.
     QByteArray readWithoutCopy(qint64 size);
 
     template<typename T> qint64 peekPrimitive(T* data);
@@ -89,9 +100,30 @@ private slots:
     void onComplete();
 
 private:
-    QByteArray _data;
+    struct Segment {
+        const char* data;
+        qint64 size;
+        qint64 offset; // position of the first byte of this segment in the message
+    };
+
+    qint64 copySegmented(char* data, qint64 position, qint64 size) const;
+    int segmentIndexForPosition(qint64 position) const;
+    void segment();
+    void coalesce() const;
+
+    // contiguous message data, empty while the message is segmented
+    mutable QByteArray _data;
     QByteArray _headData;
 
+    // Scatter/gather representation for messages that arrive over multiple packets.
+    // Segments are only appended by the thread receiving the message and are expected to be read once the message
+    // is complete (or through readHead) - coalescing is not safe while packets are still being appended.
+    mutable std::vector<Segment> _segments;
+    mutable QByteArray _firstSegmentData;
+    mutable std::vector<std::unique_ptr<NLPacket>> _segmentPackets;
+
+    std::atomic<qint64> _size { 0 };
+
     std::atomic<qint64> _position { 0 };
     std::atomic<qint64> _numPackets { 0 };
     std::atomic<quint64> _firstPacketReceiveTime { 0 };
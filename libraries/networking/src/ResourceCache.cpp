@@ -27,18 +27,88 @@
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
+#include "ResourceMemoryGovernor.h"
+
+// how many bytes are assumed to be left in a request that hasn't heard how big it is yet
+static const qint64 UNKNOWN_REQUEST_SIZE = 256 * 1024;
+
+// a protocol always has room for this many requests, so that a big download doesn't hold up all of the others
+static const int MIN_REQUESTS_PER_PROTOCOL = 2;
+
+static const qint64 DEFAULT_ATP_REQUEST_BYTE_LIMIT = 16 * BYTES_PER_MEGABYTES;
+static const qint64 DEFAULT_HTTP_REQUEST_BYTE_LIMIT = 32 * BYTES_PER_MEGABYTES;
+
+ResourceCacheSharedItems::ResourceCacheSharedItems() {
+    _requestByteLimits[File] = 0;
+    _requestByteLimits[ATP] = DEFAULT_ATP_REQUEST_BYTE_LIMIT;
+    _requestByteLimits[HTTP] = DEFAULT_HTTP_REQUEST_BYTE_LIMIT;
+}
+
+ResourceCacheSharedItems::Protocol ResourceCacheSharedItems::getProtocol(const QUrl& url) {
+    auto scheme = url.scheme();
+    if (scheme == HIFI_URL_SCHEME_FILE || scheme == URL_SCHEME_QRC) {
+        return File;
+    } else if (scheme == URL_SCHEME_ATP) {
+        return ATP;
+    }
+    return HTTP;
+}
 
 bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
+    auto locked = resource.lock();
+    if (!locked) {
+        return false;
+    }
+
     Lock lock(_mutex);
-    if ((uint32_t)_loadingRequests.size() < _requestLimit) {
+    if ((uint32_t)_loadingRequests.size() < _requestLimit && hasRoomFor(getProtocol(locked->getURL()))) {
         _loadingRequests.append(resource);
         return true;
     } else {
-        _pendingRequests.append(resource);
+        queueRequest(locked);
         return false;
     }
 }
 
+void ResourceCacheSharedItems::queueRequest(const QSharedPointer<Resource>& resource) {
+    // any place the resource already had in a queue is left behind, and skipped when it comes up
+    auto order = _nextOrder++;
+    _pendingOrders[resource.data()] = order;
+    _pendingQueues[getProtocol(resource->getURL())].push({ resource->getLoadPriority(), order, resource.data(), resource });
+}
+
+void ResourceCacheSharedItems::reprioritizeRequest(QWeakPointer<Resource> request) {
+    auto resource = request.lock();
+    if (!resource) {
+        return;
+    }
+
+    Lock lock(_mutex);
+    if (_pendingOrders.contains(resource.data())) {
+        queueRequest(resource);
+    }
+}
+
+bool ResourceCacheSharedItems::hasRoomFor(Protocol protocol) const {
+    auto byteLimit = _requestByteLimits[protocol];
+    if (byteLimit <= 0) {
+        return true;
+    }
+
+    int numRequests = 0;
+    qint64 bytesInFlight = 0;
+    for (const auto& request : _loadingRequests) {
+        auto resource = request.lock();
+        if (!resource || getProtocol(resource->getURL()) != protocol) {
+            continue;
+        }
+        ++numRequests;
+        auto bytesTotal = resource->getBytesTotal();
+        bytesInFlight += bytesTotal > 0 ? std::max(bytesTotal - resource->getBytesReceived(), (qint64)0) : UNKNOWN_REQUEST_SIZE;
+    }
+    return numRequests < MIN_REQUESTS_PER_PROTOCOL || bytesInFlight < byteLimit;
+}
+
 void ResourceCacheSharedItems::setRequestLimit(uint32_t limit) {
     Lock lock(_mutex);
     _requestLimit = limit;
@@ -49,14 +119,33 @@ uint32_t ResourceCacheSharedItems::getRequestLimit() const {
     return _requestLimit;
 }
 
+void ResourceCacheSharedItems::setRequestByteLimit(Protocol protocol, qint64 limit) {
+    Lock lock(_mutex);
+    _requestByteLimits[protocol] = limit;
+}
+
+qint64 ResourceCacheSharedItems::getRequestByteLimit(Protocol protocol) const {
+    Lock lock(_mutex);
+    return _requestByteLimits[protocol];
+}
+
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach (QWeakPointer<Resource> resource, _pendingRequests) {
-        auto locked = resource.lock();
-        if (locked) {
-            result.append(locked);
+    for (const auto& queue : _pendingQueues) {
+        // the queues only give access to the top, so walk a copy of each
+        auto requests = queue;
+        while (!requests.empty()) {
+            const auto& request = requests.top();
+            auto it = _pendingOrders.find(request.key);
+            if (it != _pendingOrders.end() && it.value() == request.order) {
+                auto locked = request.resource.lock();
+                if (locked) {
+                    result.append(locked);
+                }
+            }
+            requests.pop();
         }
     }
 
@@ -65,7 +154,7 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return _pendingOrders.size();
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() const {
@@ -104,45 +193,75 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     }
 }
 
-QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
-    Lock lock(_mutex);
-
-    bool currentHighestIsFile = false;
+const ResourceCacheSharedItems::PendingRequest* ResourceCacheSharedItems::getTopRequest(Protocol protocol) {
+    auto& queue = _pendingQueues[protocol];
+    while (!queue.empty()) {
+        auto& request = queue.top();
+        auto it = _pendingOrders.find(request.key);
+        if (it == _pendingOrders.end() || it.value() != request.order) {
+            // this request was queued again since, or has already been taken
+            queue.pop();
+            continue;
+        }
 
-    for (int i = 0; i < _pendingRequests.size();) {
-        // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
+        auto resource = request.resource.lock();
         if (!resource) {
-            _pendingRequests.removeAt(i);
+            _pendingOrders.erase(it);
+            queue.pop();
             continue;
         }
 
-        // Check load priority
-        float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
-            currentHighestIsFile = isFile;
+        // the owners of a priority can go away without telling the resource
+        if (resource->getLoadPriority() != request.priority) {
+            queue.pop();
+            queueRequest(resource);
+            continue;
         }
-        i++;
+        return &request;
+    }
+    return nullptr;
+}
+
+QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
+    Lock lock(_mutex);
+    if ((uint32_t)_loadingRequests.size() >= _requestLimit) {
+        return QSharedPointer<Resource>();
     }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+    // local files go before anything else, then the highest priority request of a protocol with room for it
+    const PendingRequest* highestRequest = nullptr;
+    Protocol highestProtocol = File;
+    for (int i = File; i < NUM_PROTOCOLS; ++i) {
+        auto protocol = (Protocol)i;
+        auto request = getTopRequest(protocol);
+        if (!request || !hasRoomFor(protocol)) {
+            continue;
+        }
+        if (!highestRequest || highestRequest->priority < request->priority) {
+            highestRequest = request;
+            highestProtocol = protocol;
+        }
+        if (protocol == File) {
+            break;
+        }
     }
 
+    if (!highestRequest) {
+        return QSharedPointer<Resource>();
+    }
+
+    auto highestResource = highestRequest->resource.lock();
+    _pendingOrders.remove(highestRequest->key);
+    _pendingQueues[highestProtocol].pop();
     return highestResource;
 }
 
 void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
-    _pendingRequests.clear();
+    for (auto& queue : _pendingQueues) {
+        queue = std::priority_queue<PendingRequest>();
+    }
+    _pendingOrders.clear();
     _loadingRequests.clear();
 }
 
@@ -251,7 +370,13 @@ ScriptableResource* ResourceCache::prefetch(const QUrl& url, void* extra, size_t
     return result;
 }
 
+static std::atomic<int> lastLRUKey { 0 };
+
 ResourceCache::ResourceCache(QObject* parent) : QObject(parent) {
+    if (DependencyManager::isSet<ResourceMemoryGovernor>()) {
+        DependencyManager::get<ResourceMemoryGovernor>()->addCache(this);
+    }
+
     if (DependencyManager::isSet<NodeList>()) {
         auto nodeList = DependencyManager::get<NodeList>();
         auto& domainHandler = nodeList->getDomainHandler();
@@ -261,9 +386,23 @@ ResourceCache::ResourceCache(QObject* parent) : QObject(parent) {
 }
 
 ResourceCache::~ResourceCache() {
+    if (DependencyManager::isSet<ResourceMemoryGovernor>()) {
+        DependencyManager::get<ResourceMemoryGovernor>()->removeCache(this);
+    }
+
     clearUnusedResources();
 }
 
+int ResourceCache::getLastLRUKey() {
+    return lastLRUKey;
+}
+
+static void enforceMemoryBudget() {
+    if (DependencyManager::isSet<ResourceMemoryGovernor>()) {
+        DependencyManager::get<ResourceMemoryGovernor>()->enforceBudget();
+    }
+}
+
 void ResourceCache::clearATPAssets() {
     {
         QWriteLocker locker(&_resourcesLock);
@@ -344,9 +483,14 @@ void ResourceCache::setRequestLimit(uint32_t limit) {
     sharedItems->setRequestLimit(limit);
 
     // Now go fill any new request spots
-    while (sharedItems->getLoadingRequestsCount() < limit && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
-    }
+    while (attemptHighestPriorityRequest()) {}
+}
+
+void ResourceCache::setRequestByteLimit(ResourceCacheSharedItems::Protocol protocol, qint64 limit) {
+    DependencyManager::get<ResourceCacheSharedItems>()->setRequestByteLimit(protocol, limit);
+
+    // Now go fill any new request spots
+    while (attemptHighestPriorityRequest()) {}
 }
 
 QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl& fallback, void* extra, size_t extraHash) {
@@ -418,7 +562,7 @@ void ResourceCache::addUnusedResource(const QSharedPointer<Resource>& resource)
     }
     reserveUnusedResource(resource->getBytes());
     
-    resource->setLRUKey(++_lastLRUKey);
+    resource->setLRUKey(++lastLRUKey);
 
     {
         QWriteLocker locker(&_unusedResourcesLock);
@@ -427,6 +571,7 @@ void ResourceCache::addUnusedResource(const QSharedPointer<Resource>& resource)
     }
 
     resetUnusedResourceCounter();
+    enforceMemoryBudget();
 }
 
 void ResourceCache::removeUnusedResource(const QSharedPointer<Resource>& resource) {
@@ -459,6 +604,32 @@ void ResourceCache::reserveUnusedResource(qint64 resourceSize) {
     }
 }
 
+QSharedPointer<Resource> ResourceCache::getOldestUnusedResource() {
+    QReadLocker locker(&_unusedResourcesLock);
+    if (_unusedResources.isEmpty()) {
+        return QSharedPointer<Resource>();
+    }
+    return _unusedResources.first();
+}
+
+bool ResourceCache::evictUnusedResource(const QSharedPointer<Resource>& resource) {
+    QWriteLocker locker(&_unusedResourcesLock);
+    auto it = _unusedResources.find(resource->getLRUKey());
+    if (it == _unusedResources.end() || it.value() != resource) {
+        return false;
+    }
+
+    resource->setCache(nullptr);
+    auto size = resource->getBytes();
+    _unusedResourcesSize -= size;
+    _unusedResources.erase(it);
+    locker.unlock();
+
+    removeResource(resource->getURL(), resource->getExtraHash(), size);
+    resetResourceCounters();
+    return true;
+}
+
 void ResourceCache::clearUnusedResources() {
     // the unused resources may themselves reference resources that will be added to the unused
     // list on destruction, so keep clearing until there are no references left
@@ -515,6 +686,10 @@ void ResourceCache::updateTotalSize(const qint64& deltaSize) {
     assert(_totalResourcesSize < (1024 * BYTES_PER_GIGABYTES));
 
     emit dirty();
+
+    if (deltaSize > 0) {
+        enforceMemoryBudget();
+    }
 }
 
 QList<QSharedPointer<Resource>> ResourceCache::getLoadingRequests() {
@@ -546,9 +721,7 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
     sharedItems->removeRequest(resource);
 
     // Now go fill any new request spots
-    while (sharedItems->getLoadingRequestsCount() < sharedItems->getRequestLimit() && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
-    }
+    while (attemptHighestPriorityRequest()) {}
 }
 
 bool ResourceCache::attemptHighestPriorityRequest() {
@@ -559,6 +732,13 @@ bool ResourceCache::attemptHighestPriorityRequest() {
 
 static int requestID = 0;
 
+static void reprioritizePendingRequest(const QWeakPointer<Resource>& resource) {
+    // resources can outlive the shared items of the assignment that used them
+    if (DependencyManager::isSet<ResourceCacheSharedItems>()) {
+        DependencyManager::get<ResourceCacheSharedItems>()->reprioritizeRequest(resource);
+    }
+}
+
 Resource::Resource(const Resource& other) :
     QObject(),
     _url(other._url),
@@ -606,6 +786,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!_failedToLoad) {
         _loadPriorities.insert(owner, priority);
+        reprioritizePendingRequest(_self);
     }
 }
 
@@ -617,11 +798,13 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    reprioritizePendingRequest(_self);
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!_failedToLoad) {
         _loadPriorities.remove(owner);
+        reprioritizePendingRequest(_self);
     }
 }
 
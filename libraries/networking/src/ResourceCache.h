@@ -12,8 +12,10 @@
 #ifndef hifi_ResourceCache_h
 #define hifi_ResourceCache_h
 
+#include <array>
 #include <atomic>
 #include <mutex>
+#include <queue>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -66,11 +68,31 @@ class ResourceCacheSharedItems : public Dependency  {
     using Lock = std::unique_lock<Mutex>;
 
 public:
+    // requests are limited by how many bytes they still have to download from each kind of source, as well as by count
+    enum Protocol {
+        File,   // file and qrc URLs, to which local files always go first
+        ATP,
+        HTTP,   // and anything else
+        NUM_PROTOCOLS
+    };
+
+    static Protocol getProtocol(const QUrl& url);
+
     bool appendRequest(QWeakPointer<Resource> newRequest);
     void removeRequest(QWeakPointer<Resource> doneRequest);
     void setRequestLimit(uint32_t limit);
     uint32_t getRequestLimit() const;
+
+    // 0 means no limit on the bytes in flight
+    void setRequestByteLimit(Protocol protocol, qint64 limit);
+    qint64 getRequestByteLimit(Protocol protocol) const;
+
+    // moves a pending request to where its current load priority puts it
+    void reprioritizeRequest(QWeakPointer<Resource> request);
+
     QList<QSharedPointer<Resource>> getPendingRequests() const;
+
+    // the highest priority pending request there is room to load now, if any
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests() const;
@@ -78,13 +100,39 @@ public:
     void clear();
 
 private:
-    ResourceCacheSharedItems() = default;
+    class PendingRequest {
+    public:
+        float priority;
+        uint64_t order;
+        Resource* key;
+        QWeakPointer<Resource> resource;
+
+        // the highest priority comes out of the queue first, and the last requested of those with the same priority
+        bool operator<(const PendingRequest& other) const {
+            return priority < other.priority || (priority == other.priority && order < other.order);
+        }
+    };
+
+    ResourceCacheSharedItems();
+
+    void queueRequest(const QSharedPointer<Resource>& resource);
+    bool hasRoomFor(Protocol protocol) const;
+
+    // drops what is left in the queue by requests that were reprioritized, loaded or deleted, and puts the request
+    // on top back in its place if its priority has changed since
+    const PendingRequest* getTopRequest(Protocol protocol);
 
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
+
+    // each pending request is in the queue for its protocol, keyed on the order it was last queued in
+    std::array<std::priority_queue<PendingRequest>, NUM_PROTOCOLS> _pendingQueues;
+    QHash<Resource*, uint64_t> _pendingOrders;
+    uint64_t _nextOrder { 0 };
+
     QList<QWeakPointer<Resource>> _loadingRequests;
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
+    std::array<qint64, NUM_PROTOCOLS> _requestByteLimits;
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -211,6 +259,11 @@ public:
 
     static void setRequestLimit(uint32_t limit);
     static uint32_t getRequestLimit() { return DependencyManager::get<ResourceCacheSharedItems>()->getRequestLimit(); }
+
+    static void setRequestByteLimit(ResourceCacheSharedItems::Protocol protocol, qint64 limit);
+    static qint64 getRequestByteLimit(ResourceCacheSharedItems::Protocol protocol) {
+        return DependencyManager::get<ResourceCacheSharedItems>()->getRequestByteLimit(protocol);
+    }
     
     void setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize);
     qint64 getUnusedResourceCacheSize() const { return _unusedResourcesMaxSize; }
@@ -274,6 +327,16 @@ protected:
 private:
     friend class Resource;
     friend class ScriptableResourceCache;
+    friend class ResourceMemoryGovernor;
+
+    // the LRU keys count up across all of the caches
+    static int getLastLRUKey();
+
+    /// The least recently used of the resources nothing is using, for the memory governor to weigh against other caches
+    QSharedPointer<Resource> getOldestUnusedResource();
+
+    /// Returns false if the resource was used again, and isn't unused anymore
+    bool evictUnusedResource(const QSharedPointer<Resource>& resource);
 
     void reserveUnusedResource(qint64 resourceSize);
     void removeResource(const QUrl& url, size_t extraHash, qint64 size = 0);
@@ -285,7 +348,6 @@ private:
     // Resources
     QHash<QUrl, QHash<size_t, QWeakPointer<Resource>>> _resources;
     QReadWriteLock _resourcesLock { QReadWriteLock::Recursive };
-    int _lastLRUKey = 0;
 
     std::atomic<size_t> _numTotalResources { 0 };
     std::atomic<qint64> _totalResourcesSize { 0 };
@@ -0,0 +1,150 @@
+//
+//  ResourceMemoryGovernor.cpp
+//  libraries/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceMemoryGovernor.h"
+
+#include <algorithm>
+
+#include "NetworkLogging.h"
+#include "ResourceCache.h"
+
+void ResourceMemoryGovernor::setMemoryBudget(qint64 budget) {
+    {
+        Lock lock(_mutex);
+        _memoryBudget = std::max(budget, (qint64)0);
+    }
+    enforceBudget();
+}
+
+qint64 ResourceMemoryGovernor::getMemoryBudget() const {
+    Lock lock(_mutex);
+    return _memoryBudget;
+}
+
+void ResourceMemoryGovernor::setGPUMemoryUsageOperator(std::function<qint64()> gpuMemoryUsageOperator) {
+    Lock lock(_mutex);
+    _gpuMemoryUsageOperator = gpuMemoryUsageOperator;
+}
+
+void ResourceMemoryGovernor::addCache(ResourceCache* cache) {
+    Lock lock(_mutex);
+    _caches.insert(cache, CacheStats());
+}
+
+void ResourceMemoryGovernor::removeCache(ResourceCache* cache) {
+    // waits for an eviction from the cache to finish
+    Lock lock(_mutex);
+    _caches.remove(cache);
+}
+
+qint64 ResourceMemoryGovernor::getMemoryUsage() const {
+    Lock lock(_mutex);
+    qint64 usage = _gpuMemoryUsageOperator ? _gpuMemoryUsageOperator() : 0;
+    for (auto it = _caches.begin(); it != _caches.end(); ++it) {
+        usage += (qint64)it.key()->getSizeTotalResources();
+    }
+    return usage;
+}
+
+QSharedPointer<Resource> ResourceMemoryGovernor::getCheapestUnusedResource(ResourceCache*& cheapestCache) const {
+    // the LRU keys are handed out across all of the caches, so they can be compared between caches
+    auto currentLRUKey = ResourceCache::getLastLRUKey();
+
+    QSharedPointer<Resource> cheapestResource;
+    qint64 highestAge = -1;
+    for (auto it = _caches.begin(); it != _caches.end(); ++it) {
+        auto resource = it.key()->getOldestUnusedResource();
+        if (!resource) {
+            continue;
+        }
+
+        qint64 age = (qint64)currentLRUKey - resource->getLRUKey();
+        auto scheme = resource->getURL().scheme();
+        if (scheme == HIFI_URL_SCHEME_FILE || scheme == URL_SCHEME_QRC) {
+            age *= LOCAL_RELOAD_DISCOUNT;
+        }
+        if (age > highestAge) {
+            highestAge = age;
+            cheapestResource = resource;
+            cheapestCache = it.key();
+        }
+    }
+    return cheapestResource;
+}
+
+void ResourceMemoryGovernor::enforceBudget() {
+    Lock lock(_mutex);
+
+    // evicting a resource can release resources it holds to their own caches, which ask for the budget again
+    if (_memoryBudget <= 0 || _isEnforcing) {
+        return;
+    }
+    _isEnforcing = true;
+
+    auto usage = getMemoryUsage();
+    int numEvictions = 0;
+    while (usage > _memoryBudget) {
+        ResourceCache* cache = nullptr;
+        auto resource = getCheapestUnusedResource(cache);
+        if (!resource) {
+            break;
+        }
+
+        auto bytes = resource->getBytes();
+        if (!cache->evictUnusedResource(resource)) {
+            // used again since it was picked
+            continue;
+        }
+        resource.reset();
+
+        auto& stats = _caches[cache];
+        ++stats.numEvictions;
+        stats.evictedBytes += bytes;
+        ++numEvictions;
+
+        usage = getMemoryUsage();
+    }
+
+    if (numEvictions > 0) {
+        qCDebug(resourceLog) << "Evicted" << numEvictions << "unused resources to keep under the memory budget of"
+            << _memoryBudget << "bytes, now using" << usage;
+    }
+    _isEnforcing = false;
+}
+
+QVariantMap ResourceMemoryGovernor::getStats() const {
+    Lock lock(_mutex);
+
+    QVariantMap caches;
+    for (auto it = _caches.begin(); it != _caches.end(); ++it) {
+        auto cache = it.key();
+        qint64 total = cache->getSizeTotalResources();
+
+        QVariantMap cacheStats;
+        cacheStats["total"] = total;
+        cacheStats["unused"] = (qint64)cache->getSizeCachedResources();
+        cacheStats["evictions"] = it->numEvictions;
+        cacheStats["evictedBytes"] = it->evictedBytes;
+        if (_memoryBudget > 0) {
+            cacheStats["pressure"] = (float)total / _memoryBudget;
+        }
+        caches[cache->metaObject()->className()] = cacheStats;
+    }
+
+    QVariantMap stats;
+    stats["budget"] = _memoryBudget;
+    stats["gpu"] = _gpuMemoryUsageOperator ? _gpuMemoryUsageOperator() : 0;
+    stats["total"] = getMemoryUsage();
+    if (_memoryBudget > 0) {
+        stats["pressure"] = (float)getMemoryUsage() / _memoryBudget;
+    }
+    stats["caches"] = caches;
+    return stats;
+}
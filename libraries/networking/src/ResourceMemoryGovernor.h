@@ -0,0 +1,76 @@
+//
+//  ResourceMemoryGovernor.h
+//  libraries/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceMemoryGovernor_h
+#define hifi_ResourceMemoryGovernor_h
+
+#include <functional>
+#include <mutex>
+
+#include <QtCore/QHash>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVariantMap>
+
+#include <DependencyManager.h>
+
+class Resource;
+class ResourceCache;
+
+// Keeps the resources of every ResourceCache together under one memory budget, on top of each cache's own limit on
+// the resources nothing is using. Once the bytes held by all of the caches, plus what is in GPU memory, go over the
+// budget, the unused resources are evicted from whichever cache has the one that is cheapest to lose: the least
+// recently used, with resources that reload from local files counted as older than those that reload over the network.
+class ResourceMemoryGovernor : public Dependency {
+    SINGLETON_DEPENDENCY
+
+    using Mutex = std::recursive_mutex;
+    using Lock = std::unique_lock<Mutex>;
+
+public:
+    // local resources are evicted as if they had been unused this many times longer
+    static const int LOCAL_RELOAD_DISCOUNT = 4;
+
+    // 0 means no budget, the caches only keep to their own limits
+    void setMemoryBudget(qint64 budget);
+    qint64 getMemoryBudget() const;
+
+    // how many bytes are in GPU memory, for the governor to count along with the caches
+    void setGPUMemoryUsageOperator(std::function<qint64()> gpuMemoryUsageOperator);
+
+    void addCache(ResourceCache* cache);
+    void removeCache(ResourceCache* cache);
+
+    qint64 getMemoryUsage() const;
+
+    // evicts unused resources until everything fits in the budget, or there is nothing left to evict
+    void enforceBudget();
+
+    // the memory used by each cache, what it has had evicted and its part of the budget
+    QVariantMap getStats() const;
+
+private:
+    class CacheStats {
+    public:
+        int numEvictions { 0 };
+        qint64 evictedBytes { 0 };
+    };
+
+    ResourceMemoryGovernor() = default;
+
+    QSharedPointer<Resource> getCheapestUnusedResource(ResourceCache*& cache) const;
+
+    mutable Mutex _mutex;
+    QHash<ResourceCache*, CacheStats> _caches;
+    qint64 _memoryBudget { 0 };
+    std::function<qint64()> _gpuMemoryUsageOperator;
+    bool _isEnforcing { false };
+};
+
+#endif // hifi_ResourceMemoryGovernor_h
@@ -90,6 +90,7 @@ public:
     PacketStreamStats getStatsForHistoryWindow() const;
     PacketStreamStats getStatsForLastHistoryInterval() const;
     const QSet<quint16>& getMissingSet() const { return _missingSet; }
+    quint16 getLastReceivedSequence() const { return _lastReceivedSequence; }
 
 private:
     void receivedUnreasonable(quint16 incoming);
@@ -18,10 +18,12 @@
 #include <QtCore/QTimer>
 
 #include <LogHandler.h>
+#include <StatTracker.h>
 #include <shared/QtHelpers.h>
 
 #include <platform/Platform.h>
 #include "NetworkLogging.h"
+#include "PacketDispatchProfiler.h"
 
 ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
     Assignment(message),
@@ -118,6 +120,8 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["inbound_pps"] = nodeList->getInboundPPS();
     ioStats["outbound_kbps"] = nodeList->getOutboundKbps();
     ioStats["outbound_pps"] = nodeList->getOutboundPPS();
+    ioStats["hashed_packets"] = (double)nodeList->getNumHashedPackets();
+    ioStats["packet_hashing_usecs"] = (double)nodeList->getPacketHashingUsecs();
 
     statsObject["io_stats"] = ioStats;
 
@@ -126,6 +130,15 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
 
     statsObject["assignmentStats"] = assignmentStats;
 
+    auto& dispatchProfiler = PacketDispatchProfiler::getInstance();
+    if (dispatchProfiler.isEnabled()) {
+        statsObject["packet_dispatch"] = dispatchProfiler.toJson();
+    }
+
+    if (DependencyManager::isSet<StatTracker>()) {
+        statsObject["metrics"] = DependencyManager::get<StatTracker>()->toJson();
+    }
+
     nodeList->sendStatsToDomainServer(statsObject);
 }
 
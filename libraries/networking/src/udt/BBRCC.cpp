@@ -0,0 +1,318 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QtCore/QtGlobal>
+
+using namespace udt;
+using namespace std::chrono;
+
+// 2 / ln(2), the smallest gain that lets startup double the delivery rate every round
+static const double STARTUP_GAIN = 2.885;
+static const double DRAIN_GAIN = 1.0 / STARTUP_GAIN;
+static const double PROBE_BANDWIDTH_CONGESTION_WINDOW_GAIN = 2.0;
+
+// probe for more bandwidth for one min RTT, drain the queue that made for one min RTT, then cruise
+static const std::array<double, 8> PROBE_BANDWIDTH_GAIN_CYCLE {{ 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 }};
+
+// the pipe is considered full once the bandwidth has not grown by 25% for three rounds
+static const double FULL_BANDWIDTH_THRESHOLD = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const auto MIN_RTT_FILTER_WINDOW = seconds(10);
+static const auto PROBE_RTT_DURATION = milliseconds(200);
+
+static const int MIN_CONGESTION_WINDOW_PACKETS = 4;
+
+static const double USECS_PER_SECOND = 1000000.0;
+
+BBRCC::BBRCC() :
+    _pacingGain(STARTUP_GAIN),
+    _congestionWindowGain(STARTUP_GAIN)
+{
+    // let the initial window go out unpaced until we have a first bandwidth sample
+    _packetSendPeriod = 0.0;
+    _bandwidthSamples.fill(0.0);
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    auto previousAck = _lastACK;
+    _lastACK = ack;
+
+    if (ack == previousAck) {
+        // nothing new was delivered, the model doesn't change
+        return needsFastRetransmit(ack, receiveTime);
+    }
+
+    auto it = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [ack](SentPacketData& sentPacketData) {
+        return sentPacketData.sequenceNumber == ack;
+    });
+
+    if (it != _sentPacketDatas.end()) {
+        auto end = it + 1;
+
+        // an RTT is only unambiguous if none of the packets this ACK covers were re-sent
+        bool canBeUsedForRTT = std::none_of(_sentPacketDatas.begin(), end, [](SentPacketData& sentPacketData) {
+            return sentPacketData.wasResent;
+        });
+
+        std::for_each(_sentPacketDatas.begin(), end, [this](SentPacketData& sentPacketData) {
+            _delivered += sentPacketData.wireSize;
+        });
+        _deliveredTime = receiveTime;
+
+        // the delivery rate is measured over the time it took to deliver everything sent after the newest ACKed packet
+        const auto& newest = *it;
+        auto interval = duration_cast<microseconds>(receiveTime - newest.deliveredTime).count();
+        double deliveryRate = interval > 0 ? (double)(_delivered - newest.delivered) / interval : 0.0;
+
+        if (canBeUsedForRTT) {
+            updateRTT(duration_cast<microseconds>(receiveTime - newest.timePoint).count(), receiveTime);
+        }
+
+        updateBandwidth(deliveryRate, newest.delivered);
+
+        _sentPacketDatas.erase(_sentPacketDatas.begin(), end);
+    } else {
+        _isRoundStart = false;
+    }
+
+    updateMode(receiveTime);
+    updateControlParameters();
+
+    // loss recovery is left to NAKs and timeouts, BBR does not use loss as a congestion signal
+    return false;
+}
+
+void BBRCC::onTimeout() {
+    // the model may be stale, fall back to a minimal window until the next ACK refreshes it
+    _priorCongestionWindowSize = std::max(_priorCongestionWindowSize, _congestionWindowSize);
+    _congestionWindowSize = MIN_CONGESTION_WINDOW_PACKETS;
+}
+
+void BBRCC::updateRTT(int lastRTT, p_high_resolution_clock::time_point now) {
+    const int MAX_RTT_SAMPLE_MICROSECONDS = 10000000;
+
+    if (lastRTT < 0) {
+        Q_ASSERT_X(false, __FUNCTION__, "calculated an RTT that is not > 0");
+        return;
+    }
+
+    lastRTT = std::min(std::max(lastRTT, 1), MAX_RTT_SAMPLE_MICROSECONDS);
+
+    if (_ewmaRTT == -1) {
+        _ewmaRTT = lastRTT;
+        _rttVariance = lastRTT / 2;
+    } else {
+        // same Jacobson estimator as TCPVegasCC, only used for the retransmission timeout
+        static const int RTT_ESTIMATION_ALPHA = 8;
+        static const int RTT_ESTIMATION_VARIANCE_ALPHA = 4;
+
+        _ewmaRTT = (_ewmaRTT * (RTT_ESTIMATION_ALPHA - 1) + lastRTT) / RTT_ESTIMATION_ALPHA;
+        _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA - 1)
+                        + abs(lastRTT - _ewmaRTT)) / RTT_ESTIMATION_VARIANCE_ALPHA;
+    }
+
+    _isMinRTTExpired = _minRTT != -1 && now > _minRTTTimestamp + MIN_RTT_FILTER_WINDOW;
+
+    if (_minRTT == -1 || lastRTT <= _minRTT || _isMinRTTExpired) {
+        _minRTT = lastRTT;
+        _minRTTTimestamp = now;
+    }
+}
+
+void BBRCC::updateBandwidth(double sample, int64_t packetDelivered) {
+    // a round trip ends once a packet sent after the start of the round is ACKed
+    _isRoundStart = packetDelivered >= _nextRoundDelivered;
+
+    if (_isRoundStart) {
+        _nextRoundDelivered = _delivered;
+        ++_roundCount;
+
+        // forget the sample that just aged out of the filter window
+        _bandwidthSamples[_roundCount % BANDWIDTH_FILTER_ROUNDS] = 0.0;
+    }
+
+    auto& roundSample = _bandwidthSamples[_roundCount % BANDWIDTH_FILTER_ROUNDS];
+    roundSample = std::max(roundSample, sample);
+}
+
+void BBRCC::updateMode(p_high_resolution_clock::time_point now) {
+    int packetsInFlight = (int)_sentPacketDatas.size();
+
+    if (_mode == Mode::Startup && _isRoundStart && !_isPipeFilled) {
+        auto currentBandwidth = bandwidth();
+
+        if (currentBandwidth >= _fullBandwidth * FULL_BANDWIDTH_THRESHOLD) {
+            // still growing, keep going
+            _fullBandwidth = currentBandwidth;
+            _fullBandwidthCount = 0;
+        } else if (++_fullBandwidthCount >= FULL_BANDWIDTH_ROUNDS) {
+            // the bottleneck is full, drain the queue startup built up
+            _isPipeFilled = true;
+            _mode = Mode::Drain;
+            _pacingGain = DRAIN_GAIN;
+            _congestionWindowGain = STARTUP_GAIN;
+        }
+    }
+
+    if (_mode == Mode::Drain && packetsInFlight <= bandwidthDelayProduct(1.0)) {
+        enterProbeBandwidth(now);
+    }
+
+    if (_mode == Mode::ProbeBandwidth) {
+        bool isCycleDone = now - _cycleStart > microseconds(_minRTT);
+
+        // leave the draining phase early once the queue is gone
+        if (_pacingGain < 1.0 && packetsInFlight <= bandwidthDelayProduct(1.0)) {
+            isCycleDone = true;
+        }
+
+        if (isCycleDone) {
+            _cycleIndex = (_cycleIndex + 1) % PROBE_BANDWIDTH_GAIN_CYCLE.size();
+            _cycleStart = now;
+            _pacingGain = PROBE_BANDWIDTH_GAIN_CYCLE[_cycleIndex];
+        }
+    }
+
+    if (_mode != Mode::ProbeRTT && _isMinRTTExpired) {
+        // the min RTT hasn't been seen in a while, briefly empty the queue to measure it again
+        _mode = Mode::ProbeRTT;
+        _pacingGain = 1.0;
+        _congestionWindowGain = 1.0;
+        _priorCongestionWindowSize = std::max(_priorCongestionWindowSize, _congestionWindowSize);
+        _probeRTTDoneTime = p_high_resolution_clock::time_point();
+        _isMinRTTExpired = false;
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        if (_probeRTTDoneTime == p_high_resolution_clock::time_point()) {
+            if (packetsInFlight <= MIN_CONGESTION_WINDOW_PACKETS) {
+                // the queue is drained, hold the window down for the probe duration and at least one round
+                _probeRTTDoneTime = now + PROBE_RTT_DURATION;
+                _isProbeRTTRoundDone = false;
+                _nextRoundDelivered = _delivered;
+            }
+        } else {
+            if (_isRoundStart) {
+                _isProbeRTTRoundDone = true;
+            }
+
+            if (_isProbeRTTRoundDone && now >= _probeRTTDoneTime) {
+                _minRTTTimestamp = now;
+                exitProbeRTT(now);
+            }
+        }
+    }
+}
+
+void BBRCC::enterProbeBandwidth(p_high_resolution_clock::time_point now) {
+    _mode = Mode::ProbeBandwidth;
+    _congestionWindowGain = PROBE_BANDWIDTH_CONGESTION_WINDOW_GAIN;
+
+    // start anywhere in the cycle except the draining phase, so connections sharing a bottleneck don't probe in lockstep
+    _cycleIndex = qrand() % (PROBE_BANDWIDTH_GAIN_CYCLE.size() - 1);
+    if (_cycleIndex >= 1) {
+        ++_cycleIndex;
+    }
+
+    _cycleStart = now;
+    _pacingGain = PROBE_BANDWIDTH_GAIN_CYCLE[_cycleIndex];
+}
+
+void BBRCC::exitProbeRTT(p_high_resolution_clock::time_point now) {
+    _congestionWindowSize = std::max(_congestionWindowSize, _priorCongestionWindowSize);
+    _priorCongestionWindowSize = 0;
+
+    if (_isPipeFilled) {
+        enterProbeBandwidth(now);
+    } else {
+        _mode = Mode::Startup;
+        _pacingGain = STARTUP_GAIN;
+        _congestionWindowGain = STARTUP_GAIN;
+    }
+}
+
+void BBRCC::updateControlParameters() {
+    auto currentBandwidth = bandwidth();
+
+    if (currentBandwidth <= 0.0) {
+        // no model yet, stay on the initial window
+        return;
+    }
+
+    setPacketSendPeriod(packetSize() / (_pacingGain * currentBandwidth));
+
+    if (_mode == Mode::ProbeRTT) {
+        _congestionWindowSize = MIN_CONGESTION_WINDOW_PACKETS;
+    } else if (_minRTT != -1) {
+        _congestionWindowSize = bandwidthDelayProduct(_congestionWindowGain);
+    }
+
+    _congestionWindowSize = std::min(std::max(_congestionWindowSize, MIN_CONGESTION_WINDOW_PACKETS),
+                                     udt::MAX_PACKETS_IN_FLIGHT);
+}
+
+bool BBRCC::needsFastRetransmit(SequenceNumber ack, p_high_resolution_clock::time_point now) {
+    // re-send ack + 1 right away if it has been outstanding for longer than our timeout
+    auto nextIt = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [ack](SentPacketData& sentPacketData) {
+        return sentPacketData.sequenceNumber == ack + 1;
+    });
+
+    return nextIt != _sentPacketDatas.end()
+        && duration_cast<microseconds>(now - nextIt->timePoint).count() >= estimatedTimeout();
+}
+
+double BBRCC::bandwidth() const {
+    return *std::max_element(_bandwidthSamples.begin(), _bandwidthSamples.end());
+}
+
+int BBRCC::bandwidthDelayProduct(double gain) const {
+    if (_minRTT == -1) {
+        return _congestionWindowSize;
+    }
+
+    double bdpBytes = gain * bandwidth() * _minRTT;
+    return (int)std::min(std::ceil(bdpBytes / packetSize()), (double)udt::MAX_PACKETS_IN_FLIGHT);
+}
+
+int BBRCC::estimatedTimeout() const {
+    return _ewmaRTT == -1 ? DEFAULT_SYN_INTERVAL : _ewmaRTT + _rttVariance * 4;
+}
+
+int BBRCC::estimatedBandwidth() const {
+    double packetsPerSecond = bandwidth() * USECS_PER_SECOND / packetSize();
+    return (int)std::min(packetsPerSecond, (double)std::numeric_limits<int>::max());
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sentPacketDatas.empty()) {
+        // nothing was in flight, don't count the idle time against the next delivery rate sample
+        _deliveredTime = timePoint;
+    }
+
+    _sentPacketDatas.emplace_back(seqNum, timePoint, wireSize, _delivered, _deliveredTime);
+}
+
+void BBRCC::onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    auto it = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [seqNum](SentPacketData& sentPacketData) {
+        return sentPacketData.sequenceNumber == seqNum;
+    });
+
+    // re-sent packets can't be used for RTT samples
+    if (it != _sentPacketDatas.end()) {
+        it->wasResent = true;
+    }
+}
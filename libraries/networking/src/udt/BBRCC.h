@@ -0,0 +1,129 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <array>
+#include <deque>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+// Model based congestion control in the spirit of BBR (https://queue.acm.org/detail.cfm?id=3022184).
+//
+// Instead of reacting to loss or RTT growth like TCPVegasCC, this keeps a windowed max of the measured delivery
+// rate and a windowed min of the RTT, paces packets out at that bottleneck bandwidth and sizes the congestion
+// window to a small multiple of the bandwidth-delay product. This keeps long, high-RTT links full where a
+// loss or delay based window never grows large enough.
+class BBRCC : public CongestionControl {
+public:
+    enum class Mode {
+        Startup,
+        Drain,
+        ProbeBandwidth,
+        ProbeRTT
+    };
+
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onTimeout() override;
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+    virtual void onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+    virtual int estimatedTimeout() const override;
+    virtual int estimatedBandwidth() const override;
+    virtual int estimatedRTT() const override { return _ewmaRTT == -1 ? 0 : _ewmaRTT; }
+    virtual int minRTT() const override { return _minRTT == -1 ? 0 : _minRTT; }
+
+    Mode getMode() const { return _mode; }
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    struct SentPacketData {
+        SentPacketData(SequenceNumber seqNum, p_high_resolution_clock::time_point tPoint, int size,
+                       int64_t deliveredBytes, p_high_resolution_clock::time_point deliveredTimePoint) :
+            sequenceNumber(seqNum), timePoint(tPoint), wireSize(size),
+            delivered(deliveredBytes), deliveredTime(deliveredTimePoint) {};
+
+        SequenceNumber sequenceNumber;
+        p_high_resolution_clock::time_point timePoint;
+        int wireSize;
+        bool wasResent { false };
+
+        // connection delivery state when this packet was sent, for the delivery rate sample
+        int64_t delivered;
+        p_high_resolution_clock::time_point deliveredTime;
+    };
+
+    void updateRTT(int lastRTT, p_high_resolution_clock::time_point now);
+    void updateBandwidth(double sample, int64_t packetDelivered);
+    void updateMode(p_high_resolution_clock::time_point now);
+    void updateControlParameters();
+
+    void enterProbeBandwidth(p_high_resolution_clock::time_point now);
+    void exitProbeRTT(p_high_resolution_clock::time_point now);
+
+    bool needsFastRetransmit(SequenceNumber ack, p_high_resolution_clock::time_point now);
+
+    double bandwidth() const; // bottleneck bandwidth estimate, in bytes per microsecond
+    int bandwidthDelayProduct(double gain) const; // in packets
+    int packetSize() const { return _mss > 0 ? _mss : udt::MAX_PACKET_SIZE; }
+
+    static const int BANDWIDTH_FILTER_ROUNDS = 10;
+
+    std::deque<SentPacketData> _sentPacketDatas; // un-ACKed packets, in send order
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _congestionWindowGain;
+
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+
+    int64_t _delivered { 0 }; // Total bytes ACKed over the connection
+    p_high_resolution_clock::time_point _deliveredTime; // Time _delivered was last updated
+
+    // windowed max filter of the delivery rate, one slot per round trip
+    std::array<double, BANDWIDTH_FILTER_ROUNDS> _bandwidthSamples;
+    int64_t _roundCount { 0 }; // Number of round trips since the connection started
+    int64_t _nextRoundDelivered { 0 }; // _delivered value that marks the end of the current round trip
+    bool _isRoundStart { false };
+
+    // startup full pipe detection
+    double _fullBandwidth { 0.0 };
+    int _fullBandwidthCount { 0 };
+    bool _isPipeFilled { false };
+
+    int _minRTT { -1 }; // Lowest RTT in the min RTT filter window, in microseconds
+    p_high_resolution_clock::time_point _minRTTTimestamp;
+    bool _isMinRTTExpired { false }; // min RTT was not refreshed during the last filter window
+
+    int _ewmaRTT { -1 }; // Exponential weighted moving average RTT
+    int _rttVariance { 0 }; // Variance in collected RTT values
+
+    int _cycleIndex { 0 }; // Current position in the probe bandwidth gain cycle
+    p_high_resolution_clock::time_point _cycleStart;
+
+    p_high_resolution_clock::time_point _probeRTTDoneTime;
+    bool _isProbeRTTRoundDone { false };
+    int _priorCongestionWindowSize { 0 }; // window to restore once probe RTT is over
+};
+
+}
+
+#endif // hifi_BBRCC_h
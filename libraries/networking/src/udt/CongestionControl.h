@@ -49,6 +49,11 @@ public:
 
     virtual int estimatedTimeout() const = 0;
 
+    // estimates reported in the connection stats, zero if the implementation doesn't track them
+    virtual int estimatedBandwidth() const { return 0; } // packets per second
+    virtual int estimatedRTT() const { return 0; } // microseconds
+    virtual int minRTT() const { return 0; } // microseconds
+
 protected:
     void setMSS(int mss) { _mss = mss; }
     virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) = 0;
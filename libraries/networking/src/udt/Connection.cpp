@@ -13,7 +13,6 @@
 
 #include <random>
 
-#include <QtCore/QThread>
 
 #include <NumericalConstants.h>
 
@@ -33,7 +32,8 @@ using namespace std::chrono;
 Connection::Connection(Socket* parentSocket, HifiSockAddr destination, std::unique_ptr<CongestionControl> congestionControl) :
     _parentSocket(parentSocket),
     _destination(destination),
-    _congestionControl(move(congestionControl))
+    _congestionControl(move(congestionControl)),
+    _metrics(NetworkMetrics::getInstance().addConnection(destination))
 {
     Q_ASSERT_X(parentSocket, "Connection::Connection", "Must be called with a valid Socket*");
     
@@ -64,24 +64,19 @@ Connection::~Connection() {
     for (auto& pendingMessage : _pendingReceivedMessages) {
         _parentSocket->messageFailed(this, pendingMessage.first);
     }
+
+    NetworkMetrics::getInstance().removeConnection(_metrics);
 }
 
 void Connection::stopSendQueue() {
     if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
         // tell the send queue to stop and be deleted
-        
+        // once stop returns the scheduler is done with it, so we know it won't send anything else
         sendQueue->stop();
 
         _lastMessageNumber = sendQueue->getCurrentMessageNumber();
 
         sendQueue->deleteLater();
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
     }
 }
 
@@ -189,6 +184,8 @@ void Connection::sync() {
 void Connection::recordSentPackets(int wireSize, int payloadSize,
                                    SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
     _stats.recordSentPackets(payloadSize, wireSize);
+    _metrics->sentPackets.fetch_add(1, std::memory_order_relaxed);
+    _metrics->sentBytes.fetch_add(wireSize, std::memory_order_relaxed);
 
     _congestionControl->onPacketSent(wireSize, seqNum, timePoint);
 }
@@ -196,6 +193,7 @@ void Connection::recordSentPackets(int wireSize, int payloadSize,
 void Connection::recordRetransmission(int wireSize, int payloadSize,
                                       SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
     _stats.recordRetransmittedPackets(payloadSize, wireSize);
+    _metrics->retransmittedPackets.fetch_add(1, std::memory_order_relaxed);
 
     _congestionControl->onPacketReSent(wireSize, seqNum, timePoint);
 }
@@ -281,8 +279,11 @@ bool Connection::processReceivedSequenceNumber(SequenceNumber sequenceNumber, in
     
     if (wasDuplicate) {
         _stats.recordDuplicatePackets(payloadSize, packetSize);
+        _metrics->duplicatePackets.fetch_add(1, std::memory_order_relaxed);
     } else {
         _stats.recordReceivedPackets(payloadSize, packetSize);
+        _metrics->receivedPackets.fetch_add(1, std::memory_order_relaxed);
+        _metrics->receivedBytes.fetch_add(packetSize, std::memory_order_relaxed);
     }
 
     return !wasDuplicate;
@@ -443,6 +444,15 @@ void Connection::updateCongestionControlAndSendQueue(std::function<void ()> cong
     // record connection stats
     _stats.recordPacketSendPeriod(_congestionControl->_packetSendPeriod);
     _stats.recordCongestionWindowSize(_congestionControl->_congestionWindowSize);
+    _stats.recordEstimatedBandwidth(_congestionControl->estimatedBandwidth());
+    _stats.recordRTT(_congestionControl->estimatedRTT());
+    _stats.recordMinRTT(_congestionControl->minRTT());
+
+    _metrics->packetSendPeriod.store((int)_congestionControl->_packetSendPeriod, std::memory_order_relaxed);
+    _metrics->congestionWindowSize.store(_congestionControl->_congestionWindowSize, std::memory_order_relaxed);
+    _metrics->estimatedBandwidth.store(_congestionControl->estimatedBandwidth(), std::memory_order_relaxed);
+    _metrics->rtt.store(_congestionControl->estimatedRTT(), std::memory_order_relaxed);
+    _metrics->minRTT.store(_congestionControl->minRTT(), std::memory_order_relaxed);
 }
 
 void PendingReceivedMessage::enqueuePacket(std::unique_ptr<Packet> packet) {
@@ -22,6 +22,7 @@
 #include "ConnectionStats.h"
 #include "Constants.h"
 #include "LossList.h"
+#include "NetworkMetrics.h"
 #include "SendQueue.h"
 #include "../HifiSockAddr.h"
 
@@ -137,6 +138,7 @@ private:
     ControlPacketPointer _handshakeACK;
 
     ConnectionStats _stats;
+    NetworkMetrics::ConnectionMetricsPointer _metrics;
 };
     
 }
@@ -90,6 +90,18 @@ void ConnectionStats::recordPacketSendPeriod(int sample) {
     _currentSample.packetSendPeriod = sample;
 }
 
+void ConnectionStats::recordEstimatedBandwidth(int sample) {
+    _currentSample.estimatedBandwith = sample;
+}
+
+void ConnectionStats::recordRTT(int sample) {
+    _currentSample.rtt = sample;
+}
+
+void ConnectionStats::recordMinRTT(int sample) {
+    _currentSample.minRTT = sample;
+}
+
 QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "Connection stats:\n";
 #define HIFI_LOG_EVENT(x) << "    " #x " events: " << stats.events[ConnectionStats::Stats::Event::x] << "\n"
@@ -106,6 +118,9 @@ QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "\n     Duplicate packets: " << stats.duplicatePackets;
     debug << "\n     Sent util bytes: " << stats.sentUtilBytes;
     debug << "\n     Sent bytes: " << stats.sentBytes;
-    debug << "\n     Received bytes: " << stats.receivedBytes << "\n";
+    debug << "\n     Received bytes: " << stats.receivedBytes;
+    debug << "\n     Estimated bandwidth: " << stats.estimatedBandwith;
+    debug << "\n     RTT: " << stats.rtt;
+    debug << "\n     Min RTT: " << stats.minRTT << "\n";
     return debug;
 }
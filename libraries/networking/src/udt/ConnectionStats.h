@@ -68,6 +68,7 @@ public:
         int rtt { 0 };
         int congestionWindowSize { 0 };
         int packetSendPeriod { 0 };
+        int minRTT { 0 };
         
         // TODO: Remove once Win build supports brace initialization: `Events events {{ 0 }};`
         Stats() { events.fill(0); }
@@ -93,6 +94,9 @@ public:
 
     void recordCongestionWindowSize(int sample);
     void recordPacketSendPeriod(int sample);
+    void recordEstimatedBandwidth(int sample);
+    void recordRTT(int sample);
+    void recordMinRTT(int sample);
     
 private:
     Stats _currentSample;
@@ -25,7 +25,7 @@ int ControlPacket::maxPayloadSize() {
     return BasePacket::maxPayloadSize() - ControlPacket::localHeaderSize();
 }
 
-std::unique_ptr<ControlPacket> ControlPacket::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+std::unique_ptr<ControlPacket> ControlPacket::fromReceivedPacket(PacketBuffer data, qint64 size,
                                                                  const HifiSockAddr &senderSockAddr) {
     // Fail with null data
     Q_ASSERT(data);
@@ -41,6 +41,50 @@ std::unique_ptr<ControlPacket> ControlPacket::fromReceivedPacket(std::unique_ptr
     return packet;
 }
 
+int ControlPacket::varUIntSize(uint32_t value) {
+    int size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+qint64 ControlPacket::writeVarUInt(uint32_t value) {
+    uint8_t bytes[5];
+    int size = 0;
+
+    while (value >= 0x80) {
+        bytes[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    bytes[size++] = (uint8_t)value;
+
+    return write(reinterpret_cast<const char*>(bytes), size);
+}
+
+qint64 ControlPacket::readVarUInt(uint32_t* value) {
+    static const int MAX_VAR_UINT_SIZE = 5;
+
+    uint32_t result = 0;
+    for (int i = 0; i < MAX_VAR_UINT_SIZE; ++i) {
+        uint8_t byte;
+        if (readPrimitive(&byte) != sizeof(byte)) {
+            return 0;
+        }
+
+        result |= (uint32_t)(byte & 0x7F) << (7 * i);
+
+        if (!(byte & 0x80)) {
+            *value = result;
+            return i + 1;
+        }
+    }
+
+    // too long to be a uint32_t
+    return 0;
+}
+
 std::unique_ptr<ControlPacket> ControlPacket::create(Type type, qint64 size) {
     return std::unique_ptr<ControlPacket>(new ControlPacket(type, size));
 }
@@ -56,7 +100,7 @@ ControlPacket::ControlPacket(Type type, qint64 size) :
     writeType();
 }
 
-ControlPacket::ControlPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr) :
+ControlPacket::ControlPacket(PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr) :
     BasePacket(std::move(data), size, senderSockAddr)
 {
     // sanity check before we decrease the payloadSize with the payloadCapacity
@@ -100,7 +144,7 @@ void ControlPacket::readType() {
     Q_ASSERT_X(bitAndType & CONTROL_BIT_MASK, "ControlPacket::readHeader()", "This should be a control packet");
     
     uint16_t packetType = (bitAndType & ~CONTROL_BIT_MASK) >> (8 * sizeof(Type));
-    Q_ASSERT_X(packetType <= ControlPacket::Type::HandshakeRequest, "ControlPacket::readType()", "Received a control packet with wrong type");
+    Q_ASSERT_X(packetType <= ControlPacket::Type::Coalesced, "ControlPacket::readType()", "Received a control packet with wrong type");
     
     // read the type
     _type = (Type) packetType;
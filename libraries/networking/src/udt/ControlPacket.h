@@ -30,11 +30,12 @@ public:
         ACK,
         Handshake,
         HandshakeACK,
-        HandshakeRequest
+        HandshakeRequest,
+        Coalesced // several small unreliable data packets for the same destination, see Socket::writePacket
     };
     
     static std::unique_ptr<ControlPacket> create(Type type, qint64 size = -1);
-    static std::unique_ptr<ControlPacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<ControlPacket> fromReceivedPacket(PacketBuffer data, qint64 size,
                                                              const HifiSockAddr& senderSockAddr);
     // Current level's header size
     static int localHeaderSize();
@@ -45,10 +46,15 @@ public:
     
     Type getType() const { return _type; }
     void setType(Type type);
+
+    // unsigned LEB128 (7 bits per byte) for compact payloads like loss list ranges, small values take one byte
+    static int varUIntSize(uint32_t value);
+    qint64 writeVarUInt(uint32_t value);
+    qint64 readVarUInt(uint32_t* value); // returns 0 if the payload ends before the value does
     
 private:
     ControlPacket(Type type, qint64 size = -1);
-    ControlPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr);
+    ControlPacket(PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr);
     ControlPacket(ControlPacket&& other);
     ControlPacket(const ControlPacket& other) = delete;
     
@@ -11,34 +11,37 @@
 
 #include "LossList.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "ControlPacket.h"
 
 using namespace udt;
 using namespace std;
 
 void LossList::append(SequenceNumber seq) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
+    Q_ASSERT_X(_lossList.empty() || (_lossList.rbegin()->second < seq), "LossList::append(SequenceNumber)",
                "SequenceNumber appended is not greater than the last SequenceNumber in the list");
     
-    if (getLength() > 0 && _lossList.back().second + 1 == seq) {
-        ++_lossList.back().second;
+    if (getLength() > 0 && _lossList.rbegin()->second + 1 == seq) {
+        ++_lossList.rbegin()->second;
     } else {
-        _lossList.push_back(make_pair(seq, seq));
+        _lossList.emplace_hint(_lossList.end(), seq, seq);
     }
     _length += 1;
 }
 
 void LossList::append(SequenceNumber start, SequenceNumber end) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < start),
+    Q_ASSERT_X(_lossList.empty() || (_lossList.rbegin()->second < start),
                "LossList::append(SequenceNumber, SequenceNumber)",
                "SequenceNumber range appended is not greater than the last SequenceNumber in the list");
     Q_ASSERT_X(start <= end,
                "LossList::append(SequenceNumber, SequenceNumber)", "Range start greater than range end");
 
-    if (getLength() > 0 && _lossList.back().second + 1 == start) {
-        _lossList.back().second = end;
+    if (getLength() > 0 && _lossList.rbegin()->second + 1 == start) {
+        _lossList.rbegin()->second = end;
     } else {
-        _lossList.push_back(make_pair(start, end));
+        _lossList.emplace_hint(_lossList.end(), start, end);
     }
     _length += seqlen(start, end);
 }
@@ -47,118 +50,96 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::insert(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     
-    auto it = find_if_not(_lossList.begin(), _lossList.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
-        return pair.second < start;
-    });
+    // find the first range that overlaps or touches the new one
+    auto it = _lossList.upper_bound(start);
+    if (it != _lossList.begin() && std::prev(it)->second + 1 >= start) {
+        --it;
+    }
     
-    if (it == _lossList.end() || end < it->first) {
+    if (it == _lossList.end() || end + 1 < it->first) {
         // No overlap, simply insert
         _length += seqlen(start, end);
-        _lossList.insert(it, make_pair(start, end));
-    } else {
-        // If it starts before segment, extend segment
-        if (start < it->first) {
-            _length += seqlen(start, it->first - 1);
-            it->first = start;
-        }
-        
-        // If it ends after segment, extend segment
-        if (end > it->second) {
-            _length += seqlen(it->second + 1, end);
-            it->second = end;
-        }
-        
-        auto it2 = it;
-        ++it2;
-        // For all ranges touching the current range
-        while (it2 != _lossList.end() && it->second >= it2->first - 1) {
-            // extend current range if necessary
-            if (it->second < it2->second) {
-                _length += seqlen(it->second + 1, it2->second);
-                it->second = it2->second;
-            }
-            
-            // Remove overlapping range
-            _length -= seqlen(it2->first, it2->second);
-            it2 = _lossList.erase(it2);
-        }
+        _lossList.emplace_hint(it, start, end);
+        return;
+    }
+    
+    // merge every range the new one overlaps or touches into a single one
+    auto mergedStart = std::min(start, it->first);
+    auto mergedEnd = end;
+    
+    while (it != _lossList.end() && it->first <= mergedEnd + 1) {
+        mergedEnd = std::max(mergedEnd, it->second);
+        _length -= seqlen(it->first, it->second);
+        it = _lossList.erase(it);
     }
+    
+    _length += seqlen(mergedStart, mergedEnd);
+    _lossList.emplace_hint(it, mergedStart, mergedEnd);
 }
 
 bool LossList::remove(SequenceNumber seq) {
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
-        return pair.first <= seq && seq <= pair.second;
-    });
-    
-    if (it != end(_lossList)) {
-        if (it->first == it->second) {
-            _lossList.erase(it);
-        } else if (seq == it->first) {
-            ++it->first;
-        } else if (seq == it->second) {
-            --it->second;
-        } else {
-            auto temp = it->second;
-            it->second = seq - 1;
-            _lossList.insert(++it, make_pair(seq + 1, temp));
-        }
-        _length -= 1;
-        
-        // this sequence number was found in the loss list, return true
-        return true;
-    } else {
+    // the only range that can contain seq is the last one starting at or before it
+    auto it = _lossList.upper_bound(seq);
+    if (it == _lossList.begin() || (--it)->second < seq) {
         // this sequence number was not found in the loss list, return false
         return false;
     }
+    
+    auto rangeStart = it->first;
+    auto rangeEnd = it->second;
+    
+    if (rangeStart == rangeEnd) {
+        _lossList.erase(it);
+    } else if (seq == rangeStart) {
+        // the start is the key, re-insert the rest of the range in place
+        it = _lossList.erase(it);
+        _lossList.emplace_hint(it, seq + 1, rangeEnd);
+    } else if (seq == rangeEnd) {
+        --it->second;
+    } else {
+        it->second = seq - 1;
+        _lossList.emplace_hint(std::next(it), seq + 1, rangeEnd);
+    }
+    _length -= 1;
+    
+    // this sequence number was found in the loss list, return true
+    return true;
 }
 
 void LossList::remove(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
+    
     // Find the first segment sharing sequence numbers
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
-        return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
-    });
+    auto it = _lossList.upper_bound(start);
+    if (it != _lossList.begin() && std::prev(it)->second >= start) {
+        --it;
+    }
     
-    // If we found one
-    if (it != _lossList.end()) {
+    while (it != _lossList.end() && it->first <= end) {
+        auto rangeStart = it->first;
+        auto rangeEnd = it->second;
+        
+        _length -= seqlen(rangeStart, rangeEnd);
+        it = _lossList.erase(it);
         
-        // While the end of the current segment is contained, either shorten it (first one only - sometimes)
-        // or remove it altogether since it is fully contained it the range
-        while (it != _lossList.end() && end >= it->second) {
-            if (start <= it->first) {
-                // Segment is contained, update new length and erase it.
-                _length -= seqlen(it->first, it->second);
-                it = _lossList.erase(it);
-            } else {
-                // Beginning of segment not contained, modify end of segment.
-                // Will only occur sometimes one the first loop
-                _length -= seqlen(start, it->second);
-                it->second = start - 1;
-                ++it;
-            }
+        // put back whatever sticks out of the removed range on either side
+        if (rangeStart < start) {
+            _length += seqlen(rangeStart, start - 1);
+            _lossList.emplace_hint(it, rangeStart, start - 1);
         }
         
-        // There might be more to remove
-        if (it != _lossList.end() && it->first <= end) {
-            if (start <= it->first) {
-                // Truncate beginning of segment
-                _length -= seqlen(it->first, end);
-                it->first = end + 1;
-            } else {
-                // Cut it in half if the range we are removing is contained within one segment
-                _length -= seqlen(start, end);
-                auto temp = it->second;
-                it->second = start - 1;
-                _lossList.insert(++it, make_pair(end + 1, temp));
-            }
+        if (rangeEnd > end) {
+            _length += seqlen(end + 1, rangeEnd);
+            _lossList.emplace_hint(it, end + 1, rangeEnd);
+            break;
         }
     }
 }
 
 SequenceNumber LossList::getFirstSequenceNumber() const {
     Q_ASSERT_X(getLength() > 0, "LossList::getFirstSequenceNumber()", "Trying to get first element of an empty list");
-    return _lossList.front().first;
+    return _lossList.begin()->first;
 }
 
 SequenceNumber LossList::popFirstSequenceNumber() {
@@ -167,18 +148,79 @@ SequenceNumber LossList::popFirstSequenceNumber() {
     return front;
 }
 
-void LossList::write(ControlPacket& packet, int maxPairs) {
-    int writtenPairs = 0;
+// The ranges are written as their count, the first start in full and then for every range the distance from the
+// previous range (minus one) and its length (minus one) as var uints. A burst of short losses takes a couple of
+// bytes per range instead of the eight of a raw pair.
+int LossList::write(ControlPacket& packet, int maxPairs) const {
+    // figure out how many ranges we can fit before writing anything
+    qint64 bytesAvailable = packet.bytesAvailableForWrite() - (qint64)(sizeof(uint16_t) + sizeof(SequenceNumber));
+    int numPairs = 0;
     
-    for (const auto& pair : _lossList) {
-        packet.writePrimitive(pair.first);
-        packet.writePrimitive(pair.second);
+    const SequenceNumber* previousEnd = nullptr;
+    for (const auto& range : _lossList) {
+        if ((maxPairs != -1 && numPairs >= maxPairs) || numPairs >= std::numeric_limits<uint16_t>::max()) {
+            break;
+        }
         
-        ++writtenPairs;
+        qint64 rangeSize = ControlPacket::varUIntSize(seqlen(range.first, range.second) - 1);
+        if (previousEnd) {
+            rangeSize += ControlPacket::varUIntSize(seqoff(*previousEnd, range.first) - 1);
+        }
         
-        // check if we've written the maximum number we were told to write
-        if (maxPairs != -1 && writtenPairs >= maxPairs) {
+        if (rangeSize > bytesAvailable) {
             break;
         }
+        
+        bytesAvailable -= rangeSize;
+        previousEnd = &range.second;
+        ++numPairs;
+    }
+    
+    if (numPairs == 0) {
+        return 0;
+    }
+    
+    packet.writePrimitive((uint16_t)numPairs);
+    packet.writePrimitive(_lossList.begin()->first);
+    
+    previousEnd = nullptr;
+    auto it = _lossList.begin();
+    for (int i = 0; i < numPairs; ++i, ++it) {
+        if (previousEnd) {
+            packet.writeVarUInt(seqoff(*previousEnd, it->first) - 1);
+        }
+        packet.writeVarUInt(seqlen(it->first, it->second) - 1);
+        
+        previousEnd = &it->second;
+    }
+    
+    return numPairs;
+}
+
+bool LossList::read(ControlPacket& packet) {
+    uint16_t numPairs;
+    SequenceNumber start;
+    if (packet.readPrimitive(&numPairs) != sizeof(numPairs) || packet.readPrimitive(&start) != sizeof(start)) {
+        return false;
+    }
+    
+    for (int i = 0; i < numPairs; ++i) {
+        uint32_t distance = 0;
+        uint32_t length;
+        
+        if ((i > 0 && !packet.readVarUInt(&distance)) || !packet.readVarUInt(&length)
+            || distance >= (uint32_t)SequenceNumber::THRESHOLD || length >= (uint32_t)SequenceNumber::THRESHOLD) {
+            return false;
+        }
+        
+        if (i > 0) {
+            start = start + (SequenceNumber::Type)(distance + 1);
+        }
+        
+        auto end = start + (SequenceNumber::Type)length;
+        insert(start, end);
+        start = end;
     }
+    
+    return true;
 }
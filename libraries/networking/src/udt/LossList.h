@@ -12,14 +12,17 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
-#include <list>
+#include <map>
 
 #include "SequenceNumber.h"
 
 namespace udt {
 
 class ControlPacket;
-    
+
+// Sorted set of lost sequence numbers, kept as disjoint ranges in a balanced tree so that every operation stays
+// O(log n) in the number of ranges, however fragmented a long loss burst leaves it.
+// All sequence numbers in the list must be within SequenceNumber::THRESHOLD of each other for the ordering to hold.
 class LossList {
 public:
     LossList() {}
@@ -30,21 +33,28 @@ public:
     void append(SequenceNumber seq);
     void append(SequenceNumber start, SequenceNumber end);
     
-    // inserts anywhere - MUCH slower
+    // inserts anywhere
     void insert(SequenceNumber start, SequenceNumber end);
     
     bool remove(SequenceNumber seq);
     void remove(SequenceNumber start, SequenceNumber end);
     
     int getLength() const { return _length; }
+    int getNumRanges() const { return (int)_lossList.size(); }
     bool isEmpty() const { return _length == 0; }
     SequenceNumber getFirstSequenceNumber() const;
     SequenceNumber popFirstSequenceNumber();
     
-    void write(ControlPacket& packet, int maxPairs = -1);
+    // writes as many ranges as fit (or maxPairs of them) in the compact multi-range encoding
+    // returns the number of ranges written
+    int write(ControlPacket& packet, int maxPairs = -1) const;
+
+    // adds the ranges of one write to this list, returns false if the encoding is malformed
+    bool read(ControlPacket& packet);
     
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    // range start to range end, ranges never overlap or touch
+    std::map<SequenceNumber, SequenceNumber> _lossList;
     int _length { 0 };
 };
     
@@ -0,0 +1,171 @@
+//
+//  NetworkMetrics.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NetworkMetrics.h"
+
+#include <algorithm>
+
+#include <QtCore/QMetaEnum>
+#include <QtCore/QTextStream>
+
+#include "PacketBufferPool.h"
+
+using namespace udt;
+
+NetworkMetrics& NetworkMetrics::getInstance() {
+    static NetworkMetrics instance;
+    return instance;
+}
+
+NetworkMetrics::ConnectionMetricsPointer NetworkMetrics::addConnection(const HifiSockAddr& destination) {
+    auto connection = std::make_shared<ConnectionMetrics>(destination);
+
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+
+    auto snapshot = std::make_shared<ConnectionsSnapshot>(*std::atomic_load(&_connections));
+    snapshot->push_back(connection);
+    std::atomic_store(&_connections, ConnectionsSnapshotPointer(std::move(snapshot)));
+
+    return connection;
+}
+
+void NetworkMetrics::removeConnection(const ConnectionMetricsPointer& connection) {
+    if (!connection) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+
+        auto snapshot = std::make_shared<ConnectionsSnapshot>(*std::atomic_load(&_connections));
+        snapshot->erase(std::remove(snapshot->begin(), snapshot->end(), connection), snapshot->end());
+        std::atomic_store(&_connections, ConnectionsSnapshotPointer(std::move(snapshot)));
+    }
+
+    _closedSentPackets.fetch_add(connection->sentPackets.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _closedReceivedPackets.fetch_add(connection->receivedPackets.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _closedRetransmittedPackets.fetch_add(connection->retransmittedPackets.load(std::memory_order_relaxed),
+                                          std::memory_order_relaxed);
+    _closedDuplicatePackets.fetch_add(connection->duplicatePackets.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _closedSentBytes.fetch_add(connection->sentBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _closedReceivedBytes.fetch_add(connection->receivedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void NetworkMetrics::recordSentPacket(PacketType type, qint64 wireSize) {
+    auto& counters = _sentByType[(size_t)type];
+    counters.packets.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(wireSize, std::memory_order_relaxed);
+}
+
+void NetworkMetrics::recordReceivedPacket(PacketType type, qint64 wireSize) {
+    auto& counters = _receivedByType[(size_t)type];
+    counters.packets.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(wireSize, std::memory_order_relaxed);
+}
+
+QByteArray NetworkMetrics::toOpenMetrics() const {
+    auto connections = std::atomic_load(&_connections);
+
+    QByteArray output;
+    QTextStream stream(&output);
+
+    auto writeFamily = [&stream](const char* name, const char* type, const char* help) {
+        stream << "# TYPE " << name << " " << type << "\n";
+        stream << "# HELP " << name << " " << help << "\n";
+    };
+
+    auto writeConnectionGauge = [&](const char* name, const char* help,
+                                    const std::atomic<int> ConnectionMetrics::* member) {
+        writeFamily(name, "gauge", help);
+        for (auto& connection : *connections) {
+            stream << name << "{peer=\"" << connection->destination.toString() << "\"} "
+                << ((*connection).*member).load(std::memory_order_relaxed) << "\n";
+        }
+    };
+
+    auto writeConnectionCounter = [&](const char* name, const char* help,
+                                      const std::atomic<uint64_t> ConnectionMetrics::* member,
+                                      const std::atomic<uint64_t>& closedTotal) {
+        // per connection, and for the whole process including connections that are gone
+        QByteArray connectionName = QByteArray("hifi_udt_connection_") + name;
+        writeFamily(connectionName.constData(), "counter", help);
+
+        uint64_t total = closedTotal.load(std::memory_order_relaxed);
+        for (auto& connection : *connections) {
+            auto value = ((*connection).*member).load(std::memory_order_relaxed);
+            total += value;
+            stream << connectionName << "_total{peer=\"" << connection->destination.toString() << "\"} " << value << "\n";
+        }
+
+        QByteArray processName = QByteArray("hifi_udt_") + name;
+        writeFamily(processName.constData(), "counter", help);
+        stream << processName << "_total " << total << "\n";
+    };
+
+    writeFamily("hifi_udt_connections", "gauge", "Open UDT connections.");
+    stream << "hifi_udt_connections " << connections->size() << "\n";
+
+    writeConnectionGauge("hifi_udt_connection_rtt_microseconds", "Estimated round trip time.",
+                         &ConnectionMetrics::rtt);
+    writeConnectionGauge("hifi_udt_connection_min_rtt_microseconds", "Minimum round trip time seen recently.",
+                         &ConnectionMetrics::minRTT);
+    writeConnectionGauge("hifi_udt_connection_congestion_window_packets", "Congestion window size.",
+                         &ConnectionMetrics::congestionWindowSize);
+    writeConnectionGauge("hifi_udt_connection_packet_send_period_microseconds", "Time between paced packets.",
+                         &ConnectionMetrics::packetSendPeriod);
+    writeConnectionGauge("hifi_udt_connection_estimated_bandwidth_packets_per_second", "Estimated bandwidth.",
+                         &ConnectionMetrics::estimatedBandwidth);
+
+    writeConnectionCounter("sent_packets", "Reliable packets sent, excluding retransmissions.",
+                           &ConnectionMetrics::sentPackets, _closedSentPackets);
+    writeConnectionCounter("received_packets", "Reliable packets received, excluding duplicates.",
+                           &ConnectionMetrics::receivedPackets, _closedReceivedPackets);
+    writeConnectionCounter("retransmitted_packets", "Reliable packets retransmitted.",
+                           &ConnectionMetrics::retransmittedPackets, _closedRetransmittedPackets);
+    writeConnectionCounter("duplicate_packets", "Duplicate reliable packets received.",
+                           &ConnectionMetrics::duplicatePackets, _closedDuplicatePackets);
+    writeConnectionCounter("sent_bytes", "Reliable bytes sent on the wire, excluding retransmissions.",
+                           &ConnectionMetrics::sentBytes, _closedSentBytes);
+    writeConnectionCounter("received_bytes", "Reliable bytes received on the wire, excluding duplicates.",
+                           &ConnectionMetrics::receivedBytes, _closedReceivedBytes);
+
+    writeFamily("hifi_udt_packet_pool_hits", "counter", "Packet buffers served from the pool.");
+    stream << "hifi_udt_packet_pool_hits_total " << PacketBufferPool::getNumPoolHits() << "\n";
+    writeFamily("hifi_udt_packet_pool_misses", "counter", "Packet buffers that had to be allocated.");
+    stream << "hifi_udt_packet_pool_misses_total " << PacketBufferPool::getNumPoolMisses() << "\n";
+    writeFamily("hifi_udt_packet_pool_buffers", "gauge", "Free buffers sitting in the packet pool.");
+    stream << "hifi_udt_packet_pool_buffers " << PacketBufferPool::getNumPooledBuffers() << "\n";
+
+    QMetaEnum metaEnum = PacketTypeEnum::staticMetaObject.enumerator(PacketTypeEnum::staticMetaObject.enumeratorOffset());
+
+    auto writePacketTypeCounters = [&](const char* name, const char* help, const PacketTypeCountersArray& counters,
+                                       bool isBytes) {
+        writeFamily(name, "counter", help);
+        for (size_t i = 0; i < counters.size(); ++i) {
+            // skip the types we've never seen to keep the scrape small
+            auto value = isBytes ? counters[i].bytes.load(std::memory_order_relaxed)
+                                 : counters[i].packets.load(std::memory_order_relaxed);
+            if (value > 0) {
+                stream << name << "_total{type=\"" << metaEnum.valueToKey((int)i) << "\"} " << value << "\n";
+            }
+        }
+    };
+
+    writePacketTypeCounters("hifi_packets_sent", "Packets sent by packet type.", _sentByType, false);
+    writePacketTypeCounters("hifi_packet_bytes_sent", "Bytes sent on the wire by packet type.", _sentByType, true);
+    writePacketTypeCounters("hifi_packets_received", "Packets received by packet type.", _receivedByType, false);
+    writePacketTypeCounters("hifi_packet_bytes_received", "Bytes received on the wire by packet type.",
+                            _receivedByType, true);
+
+    stream << "# EOF\n";
+    stream.flush();
+
+    return output;
+}
@@ -0,0 +1,99 @@
+//
+//  NetworkMetrics.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_NetworkMetrics_h
+#define hifi_NetworkMetrics_h
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "PacketHeaders.h"
+#include "../HifiSockAddr.h"
+
+namespace udt {
+
+// Process wide counters for the UDT layer, rendered in the OpenMetrics text format for scraping.
+//
+// Unlike ConnectionStats these are never reset by sampling. Everything the send and receive paths touch is a relaxed
+// atomic, and the list of connections is an immutable snapshot only rebuilt when a connection comes or goes,
+// so a scrape never contends with sending.
+class NetworkMetrics {
+public:
+    // live values for one connection, written by the connection and read by scrapes
+    struct ConnectionMetrics {
+        explicit ConnectionMetrics(const HifiSockAddr& destination) : destination(destination) {}
+
+        const HifiSockAddr destination;
+
+        // gauges, updated whenever congestion control is
+        std::atomic<int> rtt { 0 };
+        std::atomic<int> minRTT { 0 };
+        std::atomic<int> congestionWindowSize { 0 };
+        std::atomic<int> packetSendPeriod { 0 };
+        std::atomic<int> estimatedBandwidth { 0 };
+
+        // counters, reliable packets only
+        std::atomic<uint64_t> sentPackets { 0 };
+        std::atomic<uint64_t> receivedPackets { 0 };
+        std::atomic<uint64_t> retransmittedPackets { 0 };
+        std::atomic<uint64_t> duplicatePackets { 0 };
+        std::atomic<uint64_t> sentBytes { 0 };
+        std::atomic<uint64_t> receivedBytes { 0 };
+    };
+    using ConnectionMetricsPointer = std::shared_ptr<ConnectionMetrics>;
+
+    static NetworkMetrics& getInstance();
+
+    ConnectionMetricsPointer addConnection(const HifiSockAddr& destination);
+    // the connection's counters are folded into the process totals so they survive it
+    void removeConnection(const ConnectionMetricsPointer& connection);
+
+    void recordSentPacket(PacketType type, qint64 wireSize);
+    void recordReceivedPacket(PacketType type, qint64 wireSize);
+
+    QByteArray toOpenMetrics() const;
+
+private:
+    NetworkMetrics() = default;
+
+    struct PacketTypeCounters {
+        std::atomic<uint64_t> packets { 0 };
+        std::atomic<uint64_t> bytes { 0 };
+    };
+    using PacketTypeCountersArray = std::array<PacketTypeCounters, (size_t)PacketType::NUM_PACKET_TYPE>;
+
+    using ConnectionsSnapshot = std::vector<ConnectionMetricsPointer>;
+    using ConnectionsSnapshotPointer = std::shared_ptr<const ConnectionsSnapshot>;
+
+    PacketTypeCountersArray _sentByType;
+    PacketTypeCountersArray _receivedByType;
+
+    ConnectionsSnapshotPointer _connections { std::make_shared<ConnectionsSnapshot>() };
+    std::mutex _connectionsMutex; // serializes rebuilds of the snapshot, never held by readers
+
+    // counters of connections that are gone
+    std::atomic<uint64_t> _closedSentPackets { 0 };
+    std::atomic<uint64_t> _closedReceivedPackets { 0 };
+    std::atomic<uint64_t> _closedRetransmittedPackets { 0 };
+    std::atomic<uint64_t> _closedDuplicatePackets { 0 };
+    std::atomic<uint64_t> _closedSentBytes { 0 };
+    std::atomic<uint64_t> _closedReceivedBytes { 0 };
+};
+
+}
+
+#endif // hifi_NetworkMetrics_h
@@ -0,0 +1,85 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <cstring>
+
+#include <TBBHelpers.h>
+
+using namespace udt;
+
+const qint64 PacketBufferPool::BUFFER_SIZE;
+const size_t PacketBufferPool::MAX_POOLED_BUFFERS;
+
+std::atomic<size_t> PacketBufferPool::_numHits { 0 };
+std::atomic<size_t> PacketBufferPool::_numMisses { 0 };
+
+namespace {
+    struct FreeBuffers {
+        tbb::concurrent_queue<char*> buffers;
+        std::atomic<size_t> count { 0 };
+    };
+
+    FreeBuffers& freeBuffers() {
+        // intentionally never destroyed so that it outlives any packets released during static destruction
+        static FreeBuffers* instance = new FreeBuffers();
+        return *instance;
+    }
+}
+
+void PacketBufferDeleter::operator()(char* buffer) const {
+    if (isPooled) {
+        PacketBufferPool::release(buffer);
+    } else {
+        delete[] buffer;
+    }
+}
+
+PacketBuffer PacketBufferPool::allocate(qint64 size, bool shouldZero) {
+    if (size > BUFFER_SIZE) {
+        // too big for the pool, hand out a one-off
+        char* buffer = shouldZero ? new char[size]() : new char[size];
+        return PacketBuffer(buffer, PacketBufferDeleter(false));
+    }
+
+    auto& pool = freeBuffers();
+    char* buffer = nullptr;
+
+    if (pool.buffers.try_pop(buffer)) {
+        pool.count.fetch_sub(1, std::memory_order_relaxed);
+        _numHits.fetch_add(1, std::memory_order_relaxed);
+
+        if (shouldZero) {
+            memset(buffer, 0, size);
+        }
+    } else {
+        _numMisses.fetch_add(1, std::memory_order_relaxed);
+        buffer = shouldZero ? new char[BUFFER_SIZE]() : new char[BUFFER_SIZE];
+    }
+
+    return PacketBuffer(buffer, PacketBufferDeleter(true));
+}
+
+void PacketBufferPool::release(char* buffer) {
+    auto& pool = freeBuffers();
+
+    if (pool.count.load(std::memory_order_relaxed) >= MAX_POOLED_BUFFERS) {
+        delete[] buffer;
+        return;
+    }
+
+    pool.count.fetch_add(1, std::memory_order_relaxed);
+    pool.buffers.push(buffer);
+}
+
+size_t PacketBufferPool::getNumPooledBuffers() {
+    return freeBuffers().count.load(std::memory_order_relaxed);
+}
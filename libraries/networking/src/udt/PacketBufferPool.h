@@ -0,0 +1,67 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <atomic>
+#include <memory>
+
+#include <QtCore/QtGlobal>
+
+#include "Constants.h"
+
+namespace udt {
+
+// Deleter for packet storage, returns pooled buffers to the PacketBufferPool and frees everything else.
+// It is implicitly constructible from std::default_delete so a plain std::unique_ptr<char[]> can still be
+// handed to anything that takes a PacketBuffer.
+struct PacketBufferDeleter {
+    PacketBufferDeleter() = default;
+    PacketBufferDeleter(const std::default_delete<char[]>&) {}
+    explicit PacketBufferDeleter(bool isPooled) : isPooled(isPooled) {}
+
+    void operator()(char* buffer) const;
+
+    bool isPooled { false };
+};
+
+using PacketBuffer = std::unique_ptr<char[], PacketBufferDeleter>;
+
+// Recycles fixed size packet buffers so that building and receiving packets doesn't hit the allocator.
+// Buffers are freed on whatever thread is done with the packet, so the free list is shared between threads.
+class PacketBufferPool {
+public:
+    // every pooled buffer is this big, anything asking for more gets a one-off allocation
+    static const qint64 BUFFER_SIZE = MAX_PACKET_SIZE_WITH_UDP_HEADER;
+    // buffers released with this many already sitting in the pool are freed instead
+    static const size_t MAX_POOLED_BUFFERS = 4096;
+
+    // returns a buffer of at least size bytes, zeroed if shouldZero is set
+    static PacketBuffer allocate(qint64 size, bool shouldZero = false);
+
+    static size_t getNumPooledBuffers();
+    static size_t getNumPoolHits() { return _numHits.load(std::memory_order_relaxed); }
+    static size_t getNumPoolMisses() { return _numMisses.load(std::memory_order_relaxed); }
+
+private:
+    friend struct PacketBufferDeleter;
+
+    static void release(char* buffer);
+
+    static std::atomic<size_t> _numHits;
+    static std::atomic<size_t> _numMisses;
+};
+
+} // namespace udt
+
+#endif // hifi_PacketBufferPool_h
@@ -27,7 +27,9 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::StunResponse:
             return 17;
         case PacketType::DomainList:
-            return static_cast<PacketVersion>(DomainListVersion::HasConnectReason);
+            return static_cast<PacketVersion>(DomainListVersion::HasIncrementalUpdates);
+        case PacketType::DomainListRequest:
+            return static_cast<PacketVersion>(DomainListRequestVersion::HasDomainListVersion);
         case PacketType::EntityAdd:
         case PacketType::EntityClone:
         case PacketType::EntityEdit:
@@ -35,15 +37,17 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::EntityPhysics:
             return static_cast<PacketVersion>(EntityVersion::LAST_PACKET_TYPE);
         case PacketType::EntityQuery:
-            return static_cast<PacketVersion>(EntityQueryPacketVersion::ConicalFrustums);
+            return static_cast<PacketVersion>(EntityQueryPacketVersion::InterestRegions);
+        case PacketType::OctreeDataNack:
+            return static_cast<PacketVersion>(OctreeDataNackVersion::AckedSequenceNumber);
         case PacketType::AvatarIdentity:
         case PacketType::AvatarData:
-            return static_cast<PacketVersion>(AvatarMixerPacketVersion::ARKitBlendshapes);
+            return static_cast<PacketVersion>(AvatarMixerPacketVersion::QuantizedJoints);
         case PacketType::BulkAvatarData:
         case PacketType::KillAvatar:
-            return static_cast<PacketVersion>(AvatarMixerPacketVersion::ARKitBlendshapes);
+            return static_cast<PacketVersion>(AvatarMixerPacketVersion::QuantizedJoints);
         case PacketType::MessagesData:
-            return static_cast<PacketVersion>(MessageDataVersion::TextOrBinaryData);
+            return static_cast<PacketVersion>(MessageDataVersion::BatchedMessages);
         // ICE packets
         case PacketType::ICEServerPeerInformation:
             return 17;
@@ -64,7 +68,7 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::AssetGetInfo:
         case PacketType::AssetGet:
         case PacketType::AssetUpload:
-            return static_cast<PacketVersion>(AssetServerPacketVersion::BakingTextureMeta);
+            return static_cast<PacketVersion>(AssetServerPacketVersion::ContentDeliveryRedirects);
         case PacketType::NodeIgnoreRequest:
             return 18; // Introduction of node ignore request (which replaced an unused packet tpye)
 
@@ -88,6 +92,8 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::AudioStreamStats:
         case PacketType::StopInjector:
             return static_cast<PacketVersion>(AudioVersion::StopInjectors);
+        case PacketType::HostedInjectorControl:
+            return static_cast<PacketVersion>(AudioVersion::HostedInjectors);
         case PacketType::DomainSettings:
             return 18;  // replace min_avatar_scale and max_avatar_scale with min_avatar_height and max_avatar_height
         case PacketType::Ping:
@@ -98,7 +104,7 @@ PacketVersion versionForPacketType(PacketType packetType) {
             return static_cast<PacketVersion>(EntityVersion::ParticleSpin);
         case PacketType::BulkAvatarTraitsAck:
         case PacketType::BulkAvatarTraits:
-            return static_cast<PacketVersion>(AvatarMixerPacketVersion::AvatarTraitsAck);
+            return static_cast<PacketVersion>(AvatarMixerPacketVersion::SharedTraitBlobs);
         default:
             return 22;
     }
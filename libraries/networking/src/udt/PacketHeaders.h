@@ -135,6 +135,8 @@ public:
         AudioSoloRequest,
         BulkAvatarTraitsAck,
         StopInjector,
+        HostedInjectorControl,
+        AvatarReplicationInterest,
         NUM_PACKET_TYPE
     };
 
@@ -185,7 +187,8 @@ public:
             << PacketTypeEnum::Value::OctreeFileReplacement << PacketTypeEnum::Value::ReplicatedMicrophoneAudioNoEcho
             << PacketTypeEnum::Value::ReplicatedMicrophoneAudioWithEcho << PacketTypeEnum::Value::ReplicatedInjectAudio
             << PacketTypeEnum::Value::ReplicatedSilentAudioFrame << PacketTypeEnum::Value::ReplicatedAvatarIdentity
-            << PacketTypeEnum::Value::ReplicatedKillAvatar << PacketTypeEnum::Value::ReplicatedBulkAvatarData;
+            << PacketTypeEnum::Value::ReplicatedKillAvatar << PacketTypeEnum::Value::ReplicatedBulkAvatarData
+            << PacketTypeEnum::Value::AvatarReplicationInterest;
         return NON_SOURCED_PACKETS;
     }
 
@@ -275,6 +278,7 @@ enum class EntityVersion : PacketVersion {
     ShadowBiasAndDistance,
     TextEntityFonts,
     ScriptServerKinematicMotion,
+    PropertyDeltas,
 
     // Add new versions above here
     NUM_PACKET_TYPE,
@@ -286,20 +290,27 @@ enum class EntityScriptCallMethodVersion : PacketVersion {
     ClientCallable = 19
 };
 
+enum class OctreeDataNackVersion : PacketVersion {
+    MissingSequenceNumbers = 22,
+    AckedSequenceNumber
+};
+
 enum class EntityQueryPacketVersion: PacketVersion {
     JSONFilter = 18,
     JSONFilterWithFamilyTree = 19,
     ConnectionIdentifier = 20,
     RemovedJurisdictions = 21,
     MultiFrustumQuery = 22,
-    ConicalFrustums = 23
+    ConicalFrustums = 23,
+    InterestRegions = 24
 };
 
 enum class AssetServerPacketVersion: PacketVersion {
     VegasCongestionControl = 19,
     RangeRequestSupport,
     RedirectedMappings,
-    BakingTextureMeta
+    BakingTextureMeta,
+    ContentDeliveryRedirects
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
@@ -340,7 +351,9 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     FBXJointOrderChange,
     HandControllerSection,
     SendVerificationFailed,
-    ARKitBlendshapes
+    ARKitBlendshapes,
+    QuantizedJoints,
+    SharedTraitBlobs
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -374,7 +387,13 @@ enum class DomainListVersion : PacketVersion {
     GetMachineFingerprintFromUUIDSupport,
     AuthenticationOptional,
     HasTimestamp,
-    HasConnectReason
+    HasConnectReason,
+    HasIncrementalUpdates
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreDomainListVersion = 22,
+    HasDomainListVersion
 };
 
 enum class AudioVersion : PacketVersion {
@@ -385,11 +404,13 @@ enum class AudioVersion : PacketVersion {
     SpaceBubbleChanges,
     HasPersonalMute,
     HighDynamicRangeVolume,
-    StopInjectors
+    StopInjectors,
+    HostedInjectors
 };
 
 enum class MessageDataVersion : PacketVersion {
-    TextOrBinaryData = 18
+    TextOrBinaryData = 18,
+    BatchedMessages
 };
 
 enum class IcePingVersion : PacketVersion {
@@ -13,7 +13,6 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -31,6 +30,7 @@
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
+#include "SendQueueScheduler.h"
 
 namespace udt {
     
@@ -39,7 +39,9 @@ class ControlPacket;
 class Packet;
 class PacketList;
 class Socket;
-    
+
+// Reliable send state for one connection. Queues don't own a thread, the SendQueueScheduler steps every queue
+// from its shared workers, each step sending what the pacing allows and returning when it wants to go again.
 class SendQueue : public QObject {
     Q_OBJECT
     
@@ -85,14 +87,20 @@ signals:
 
     void timeout();
     
-private slots:
-    void run();
-    
 private:
+    friend class SendQueueScheduler;
+
     SendQueue(Socket* socket, HifiSockAddr dest, SequenceNumber currentSequenceNumber,
               MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK);
     SendQueue(SendQueue& other) = delete;
     SendQueue(SendQueue&& other) = delete;
+
+    // called by the scheduler, does one round of sending and returns when the queue should be stepped next
+    // (time_point::max() to only be stepped again when woken)
+    p_high_resolution_clock::time_point step();
+    void wake(); // asks the scheduler for a step as soon as possible
+
+    p_high_resolution_clock::time_point nextPacketTime(int newPacketCount);
     
     void sendHandshake();
     
@@ -102,7 +110,8 @@ private:
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
+    // nothing was sent this step - returns when to look again, deactivating the queue or timing out if it's time
+    p_high_resolution_clock::time_point checkInactive(p_high_resolution_clock::time_point now);
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
@@ -113,6 +122,7 @@ private:
     PacketQueue _packets;
     
     Socket* _socket { nullptr }; // Socket to send packet on
+    std::mutex _destinationLock; // Protects the destination, it can change while a worker is sending
     HifiSockAddr _destination; // Destination addr
     
     std::atomic<uint32_t> _lastACKSequenceNumber { 0 }; // Last ACKed sequence number
@@ -134,13 +144,17 @@ private:
     using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
     std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
-    
-    std::condition_variable_any _emptyCondition;
+    p_high_resolution_clock::time_point _nextHandshakeTime; // when to re-send the handshake if it isn't ACKed
+
+    SendQueueScheduler::Entry _schedulerEntry { this };
+    std::atomic<bool> _wasWoken { false }; // something happened since the last step that restarts idle waits
 
-    std::chrono::high_resolution_clock::time_point _lastPacketSentAt;
+    // only touched from step
+    p_high_resolution_clock::time_point _nextPacketTimestamp; // when the next packet should have been sent
+    bool _isIdle { false };
+    p_high_resolution_clock::time_point _idleSince; // start of the current wait for data, ACKs or a timeout
+    p_high_resolution_clock::time_point _lastPacketSentAt;
 
     static const std::chrono::microseconds MAXIMUM_ESTIMATED_TIMEOUT;
     static const std::chrono::microseconds MINIMUM_ESTIMATED_TIMEOUT;
@@ -0,0 +1,228 @@
+//
+//  SendQueueScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QProcessEnvironment>
+
+#include <ThreadHelpers.h>
+
+#include "../NetworkLogging.h"
+#include "SendQueue.h"
+
+using namespace udt;
+using namespace std::chrono;
+
+const microseconds SendQueueScheduler::TICK_DURATION { 100 };
+
+static const QString SEND_THREADS_ENV = "HIFI_UDT_SEND_THREADS";
+static const int MAX_DEFAULT_SEND_THREADS = 4;
+
+SendQueueScheduler& SendQueueScheduler::getInstance() {
+    static SendQueueScheduler instance;
+    return instance;
+}
+
+SendQueueScheduler::SendQueueScheduler() :
+    _startTime(p_high_resolution_clock::now())
+{
+    // sending is mostly syscalls and short waits, half the cores is plenty
+    int numWorkers = std::max(1, std::min(MAX_DEFAULT_SEND_THREADS, (int)std::thread::hardware_concurrency() / 2));
+
+    bool ok = false;
+    int requestedWorkers = QProcessEnvironment::systemEnvironment().value(SEND_THREADS_ENV).toInt(&ok);
+    if (ok && requestedWorkers > 0) {
+        numWorkers = requestedWorkers;
+    }
+
+    qCDebug(networking) << "Starting" << numWorkers << "SendQueue scheduler threads";
+
+    for (int i = 0; i < numWorkers; ++i) {
+        _workers.emplace_back([this] {
+            setThreadName("Hifi_SendQueueScheduler");
+            workerLoop();
+        });
+    }
+}
+
+SendQueueScheduler::~SendQueueScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+
+    _workCondition.notify_all();
+    _timekeeperCondition.notify_all();
+
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+void SendQueueScheduler::add(Entry* entry) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (entry->_state == Entry::State::NotAdded) {
+        makeReady(entry);
+    }
+}
+
+void SendQueueScheduler::remove(Entry* entry) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    entry->_isRemoving = true;
+
+    switch (entry->_state) {
+        case Entry::State::Waiting:
+            _wheel.cancel(entry);
+            break;
+        case Entry::State::Ready:
+            _readyEntries.erase(std::find(_readyEntries.begin(), _readyEntries.end(), entry));
+            break;
+        case Entry::State::Running:
+            // the worker stepping it marks it removed when it is done
+            _removeCondition.wait(lock, [entry] { return entry->_state == Entry::State::Removed; });
+            break;
+        default:
+            break;
+    }
+
+    entry->_state = Entry::State::Removed;
+}
+
+void SendQueueScheduler::wake(Entry* entry) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    switch (entry->_state) {
+        case Entry::State::Waiting:
+            _wheel.cancel(entry);
+            makeReady(entry);
+            break;
+        case Entry::State::Parked:
+            makeReady(entry);
+            break;
+        case Entry::State::Running:
+            entry->_isWakePending = true;
+            break;
+        default:
+            // already ready, or not ours to step
+            break;
+    }
+}
+
+void SendQueueScheduler::workerLoop() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_isStopping) {
+        // release everything that came due while we were busy or asleep
+        auto nowTick = tickFor(p_high_resolution_clock::now(), false);
+        if (nowTick > _wheel.getCurrentTick()) {
+            _wheel.advance(nowTick, [this](TimerWheel::Timer* timer) {
+                makeReady(static_cast<Entry*>(timer), false);
+            });
+        }
+
+        if (!_readyEntries.empty()) {
+            Entry* entry = _readyEntries.front();
+            _readyEntries.pop_front();
+
+            entry->_state = Entry::State::Running;
+            entry->_isWakePending = false;
+
+            // hand the rest of the ready queues to whoever is waiting
+            if (!_readyEntries.empty() && _numWaitingWorkers > 0) {
+                _workCondition.notify_one();
+            }
+
+            lock.unlock();
+            auto wakeTime = entry->_queue->step();
+            lock.lock();
+
+            if (entry->_isRemoving) {
+                entry->_state = Entry::State::Removed;
+                _removeCondition.notify_all();
+            } else if (entry->_isWakePending) {
+                makeReady(entry);
+            } else {
+                schedule(entry, wakeTime);
+            }
+        } else if (!_hasTimekeeper) {
+            // nothing to do right now, this worker watches the wheel until its next event
+            _hasTimekeeper = true;
+
+            if (_wheel.isEmpty()) {
+                _timekeeperTick = std::numeric_limits<TimerWheel::Tick>::max();
+                _timekeeperCondition.wait(lock);
+            } else {
+                _timekeeperTick = _wheel.getNextEventTick();
+                _timekeeperCondition.wait_until(lock, timeFor(_timekeeperTick));
+            }
+
+            _hasTimekeeper = false;
+        } else {
+            ++_numWaitingWorkers;
+            _workCondition.wait(lock);
+            --_numWaitingWorkers;
+        }
+    }
+}
+
+void SendQueueScheduler::makeReady(Entry* entry, bool shouldNotify) {
+    entry->_state = Entry::State::Ready;
+    _readyEntries.push_back(entry);
+
+    if (shouldNotify) {
+        if (_numWaitingWorkers > 0) {
+            _workCondition.notify_one();
+        } else if (_hasTimekeeper) {
+            _timekeeperCondition.notify_one();
+        }
+    }
+}
+
+void SendQueueScheduler::schedule(Entry* entry, p_high_resolution_clock::time_point wakeTime) {
+    if (wakeTime == p_high_resolution_clock::time_point::max()) {
+        entry->_state = Entry::State::Parked;
+        return;
+    }
+
+    // round up so a queue is never stepped before the time it asked for
+    auto tick = tickFor(wakeTime, true);
+
+    if (!_wheel.schedule(entry, tick)) {
+        // already due
+        makeReady(entry);
+        return;
+    }
+
+    entry->_state = Entry::State::Waiting;
+
+    if (_hasTimekeeper && tick < _timekeeperTick) {
+        // the timekeeper is asleep until after this is due
+        _timekeeperCondition.notify_one();
+    }
+}
+
+TimerWheel::Tick SendQueueScheduler::tickFor(p_high_resolution_clock::time_point timePoint, bool roundUp) const {
+    if (timePoint <= _startTime) {
+        return 0;
+    }
+
+    auto sinceStart = duration_cast<microseconds>(timePoint - _startTime).count();
+    auto tickUsecs = TICK_DURATION.count();
+
+    return (TimerWheel::Tick)(roundUp ? (sinceStart + tickUsecs - 1) / tickUsecs : sinceStart / tickUsecs);
+}
+
+p_high_resolution_clock::time_point SendQueueScheduler::timeFor(TimerWheel::Tick tick) const {
+    return _startTime + microseconds(tick * TICK_DURATION.count());
+}
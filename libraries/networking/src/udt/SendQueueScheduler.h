@@ -0,0 +1,109 @@
+//
+//  SendQueueScheduler.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SendQueueScheduler_h
+#define hifi_SendQueueScheduler_h
+
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <PortableHighResolutionClock.h>
+
+#include "TimerWheel.h"
+
+namespace udt {
+
+class SendQueue;
+
+// Services every SendQueue in the process from a small, fixed pool of threads.
+//
+// A SendQueue is stepped by whichever worker picks it up, and each step returns the time at which the queue wants
+// to be stepped again (its next paced send, handshake re-send or timeout). Those times are kept in a TimerWheel,
+// so the thread count and the cost of pacing stay flat no matter how many connections are open.
+// A queue is never stepped by two workers at once.
+class SendQueueScheduler {
+public:
+    // scheduling state of one queue, owned by the queue so that waking it never races with its removal
+    class Entry : private TimerWheel::Timer {
+    public:
+        explicit Entry(SendQueue* queue) : _queue(queue) {}
+
+    private:
+        friend class SendQueueScheduler;
+
+        enum class State {
+            NotAdded,
+            Waiting, // in the wheel
+            Parked, // not in the wheel, only stepped again when woken
+            Ready,
+            Running,
+            Removed
+        };
+
+        SendQueue* const _queue;
+        State _state { State::NotAdded };
+        bool _isWakePending { false }; // woken while running, step again right away
+        bool _isRemoving { false };
+    };
+
+    static SendQueueScheduler& getInstance();
+
+    // starts stepping the queue as soon as a worker is free
+    void add(Entry* entry);
+
+    // stops stepping the queue, blocking until no worker is stepping it, does nothing if it was already removed
+    void remove(Entry* entry);
+
+    // steps the queue as soon as possible instead of waiting for the time it asked for
+    void wake(Entry* entry);
+
+    int getNumWorkers() const { return (int)_workers.size(); }
+
+    // the wheel resolution, pacing is never finer than this
+    static const std::chrono::microseconds TICK_DURATION;
+
+private:
+    SendQueueScheduler();
+    ~SendQueueScheduler();
+
+    void workerLoop();
+
+    void makeReady(Entry* entry, bool shouldNotify = true);
+    void schedule(Entry* entry, p_high_resolution_clock::time_point wakeTime);
+
+    TimerWheel::Tick tickFor(p_high_resolution_clock::time_point timePoint, bool roundUp) const;
+    p_high_resolution_clock::time_point timeFor(TimerWheel::Tick tick) const;
+
+    std::mutex _mutex;
+    std::condition_variable _workCondition; // for workers waiting on ready queues
+    std::condition_variable _timekeeperCondition; // for the single worker waiting on the wheel
+    std::condition_variable _removeCondition; // for remove waiting on a queue to be done with its step
+
+    const p_high_resolution_clock::time_point _startTime;
+    TimerWheel _wheel;
+    std::deque<Entry*> _readyEntries;
+
+    bool _hasTimekeeper { false };
+    TimerWheel::Tick _timekeeperTick { 0 };
+    int _numWaitingWorkers { 0 };
+    bool _isStopping { false };
+
+    std::vector<std::thread> _workers;
+};
+
+}
+
+#endif // hifi_SendQueueScheduler_h
@@ -11,16 +11,23 @@
 
 #include "Socket.h"
 
-#ifdef Q_OS_ANDROID
+#if defined(Q_OS_ANDROID) || defined(Q_OS_LINUX)
 #include <sys/socket.h>
 #endif
 
+#if defined(Q_OS_LINUX)
+#include <errno.h>
+#include <string.h>
+#endif
+
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 
 #include <shared/QtHelpers.h>
 #include <LogHandler.h>
 
 #include "../NetworkLogging.h"
+#include "BBRCC.h"
 #include "Connection.h"
 #include "ControlPacket.h"
 #include "Packet.h"
@@ -38,6 +45,23 @@ using namespace udt;
 #include <netinet/in.h>
 #endif
 
+#if defined(Q_OS_LINUX)
+// number of datagrams pulled or pushed per recvmmsg/sendmmsg call
+static const int DATAGRAM_BATCH_SIZE = 64;
+// leave some room above MAX_PACKET_SIZE so that oversized datagrams are detected as truncated instead of silently cut
+static const int BATCHED_RECEIVE_BUFFER_SIZE = udt::MAX_PACKET_SIZE_WITH_UDP_HEADER;
+#endif
+
+static const QString DISABLE_BATCHED_IO_ENV = "HIFI_UDT_DISABLE_BATCHED_IO";
+static const QString CONGESTION_CONTROL_ENV = "HIFI_UDT_CONGESTION_CONTROL";
+static const QString COALESCE_PACKETS_ENV = "HIFI_UDT_COALESCE_PACKETS";
+
+// packets at least this big already make good use of a datagram, they are never held
+static const int MAX_COALESCED_PACKET_SIZE = MAX_PACKET_SIZE / 2;
+// the longest a packet waits for company when nobody flushes
+static const int COALESCING_FLUSH_INTERVAL_MSECS = 2;
+
+using CoalescedPacketSize = uint16_t;
 
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
@@ -56,6 +80,132 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     const int READY_READ_BACKUP_CHECK_MSECS = 2 * 1000;
     connect(_readyReadBackupTimer, &QTimer::timeout, this, &Socket::checkForReadyReadBackup);
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
+
+    setBatchedIOEnabled(!QProcessEnvironment::systemEnvironment().contains(DISABLE_BATCHED_IO_ENV));
+
+    _coalescingFlushTimer = new QTimer(this);
+    _coalescingFlushTimer->setTimerType(Qt::PreciseTimer);
+    _coalescingFlushTimer->setInterval(COALESCING_FLUSH_INTERVAL_MSECS);
+    connect(_coalescingFlushTimer, &QTimer::timeout, this, &Socket::flushCoalescedPackets);
+    setCoalescingEnabled(QProcessEnvironment::systemEnvironment().contains(COALESCE_PACKETS_ENV));
+
+    // TCPVegasCC stays the default, BBRCC can be picked for every connection of this socket
+    if (QProcessEnvironment::systemEnvironment().value(CONGESTION_CONTROL_ENV).toLower() == "bbr") {
+        setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<BBRCC>()));
+    }
+}
+
+void Socket::setBatchedIOEnabled(bool enabled) {
+#if defined(Q_OS_LINUX)
+    _isBatchedIOEnabled = enabled;
+
+    if (_isBatchedIOEnabled) {
+        _batchedReceiveBuffers.resize(DATAGRAM_BATCH_SIZE);
+    } else {
+        _batchedReceiveBuffers.clear();
+    }
+#else
+    // no batched path on this platform, always fall back to QUdpSocket
+    Q_UNUSED(enabled);
+    _isBatchedIOEnabled = false;
+#endif
+}
+
+void Socket::setCoalescingEnabled(bool enabled) {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, [this, enabled] { setCoalescingEnabled(enabled); });
+        return;
+    }
+
+    _isCoalescingEnabled = enabled;
+
+    if (enabled) {
+        _coalescingFlushTimer->start();
+    } else {
+        _coalescingFlushTimer->stop();
+        flushCoalescedPackets();
+    }
+}
+
+void Socket::flushCoalescedPackets() {
+    decltype(_coalescedPackets) coalescedPackets;
+    {
+        Lock lock(_coalescedPacketsMutex);
+        coalescedPackets.swap(_coalescedPackets);
+    }
+
+    for (auto& pair : coalescedPackets) {
+        writeBasePacket(*pair.second, pair.first);
+    }
+}
+
+bool Socket::coalescePacket(const Packet& packet, const HifiSockAddr& sockAddr) {
+    auto packetSize = packet.getDataSize();
+
+    std::unique_ptr<ControlPacket> fullPacket;
+
+    if (packetSize > MAX_COALESCED_PACKET_SIZE) {
+        // send what we're holding first so that this one doesn't overtake it
+        {
+            Lock lock(_coalescedPacketsMutex);
+            auto it = _coalescedPackets.find(sockAddr);
+            if (it != _coalescedPackets.end()) {
+                fullPacket = std::move(it->second);
+                _coalescedPackets.erase(it);
+            }
+        }
+
+        if (fullPacket) {
+            writeBasePacket(*fullPacket, sockAddr);
+        }
+        return false;
+    }
+
+    {
+        Lock lock(_coalescedPacketsMutex);
+
+        auto& coalescedPacket = _coalescedPackets[sockAddr];
+        if (coalescedPacket && coalescedPacket->bytesAvailableForWrite() < (qint64)sizeof(CoalescedPacketSize) + packetSize) {
+            // no room left, this one goes out now and the packet starts the next
+            fullPacket = std::move(coalescedPacket);
+        }
+
+        if (!coalescedPacket) {
+            coalescedPacket = ControlPacket::create(ControlPacket::Coalesced);
+        }
+
+        coalescedPacket->writePrimitive((CoalescedPacketSize)packetSize);
+        coalescedPacket->write(packet.getData(), packetSize);
+    }
+
+    if (fullPacket) {
+        writeBasePacket(*fullPacket, sockAddr);
+    }
+
+    return true;
+}
+
+void Socket::processCoalescedPacket(ControlPacket& coalescedPacket, p_high_resolution_clock::time_point receiveTime) {
+    while (coalescedPacket.bytesLeftToRead() >= (qint64)sizeof(CoalescedPacketSize)) {
+        CoalescedPacketSize packetSize;
+        coalescedPacket.readPrimitive(&packetSize);
+
+        if (packetSize < (qint64)sizeof(Packet::SequenceNumberAndBitField) || packetSize > coalescedPacket.bytesLeftToRead()) {
+            qCDebug(networking) << "Dropping malformed coalesced packet from" << coalescedPacket.getSenderSockAddr();
+            return;
+        }
+
+        auto buffer = PacketBufferPool::allocate(packetSize);
+        coalescedPacket.read(buffer.get(), packetSize);
+
+        // only unreliable data packets are ever coalesced, anything else would let a peer nest these
+        auto bitField = *reinterpret_cast<Packet::SequenceNumberAndBitField*>(buffer.get());
+        if (bitField & (CONTROL_BIT_MASK | RELIABILITY_BIT_MASK | MESSAGE_BIT_MASK)) {
+            continue;
+        }
+
+        processDatagram(std::move(buffer), packetSize, coalescedPacket.getSenderSockAddr(), receiveTime);
+    }
 }
 
 void Socket::bind(const QHostAddress& address, quint16 port) {
@@ -85,10 +235,34 @@ void Socket::rebind() {
 }
 
 void Socket::rebind(quint16 localPort) {
+    if (QThread::currentThread() != thread()) {
+        BLOCKING_INVOKE_METHOD(this, "rebind", Q_ARG(quint16, localPort));
+        return;
+    }
+
     _udpSocket.abort();
     bind(QHostAddress::AnyIPv4, localPort);
 }
 
+void Socket::setSocketThread(QThread* thread) {
+    if (QThread::currentThread() != this->thread()) {
+        BLOCKING_INVOKE_METHOD(this, "setSocketThread", Q_ARG(QThread*, thread));
+        return;
+    }
+
+    // objects with a parent can't be moved, and the QUdpSocket has to come along with us
+    setParent(nullptr);
+    _udpSocket.setParent(this);
+
+    moveToThread(thread);
+
+    // connections are not our children, move them explicitly so their timers keep firing on the socket thread
+    Lock connectionsLock(_connectionsHashMutex);
+    for (auto& connectionPair : _connectionsHash) {
+        connectionPair.second->moveToThread(thread);
+    }
+}
+
 void Socket::setSystemBufferSizes() {
     for (int i = 0; i < 2; i++) {
         QAbstractSocket::SocketOption bufferOpt;
@@ -151,6 +325,10 @@ qint64 Socket::writePacket(const Packet& packet, const HifiSockAddr& sockAddr) {
     // write the correct sequence number to the Packet here
     packet.writeSequenceNumber(sequenceNumber);
 
+    if (_isCoalescingEnabled.load(std::memory_order_relaxed) && !packet.isPartOfMessage() && coalescePacket(packet, sockAddr)) {
+        return packet.getDataSize();
+    }
+
     return writeDatagram(packet.getData(), packet.getDataSize(), sockAddr);
 }
 
@@ -198,6 +376,37 @@ qint64 Socket::writePacketList(std::unique_ptr<PacketList> packetList, const Hif
     }
 
     // Unerliable and Unordered
+    if (_isBatchedIOEnabled) {
+        // stamp every packet first so the whole list can go out in as few syscalls as possible
+        std::vector<std::unique_ptr<Packet>> packets;
+        DatagramBatch datagrams;
+        packets.reserve(packetList->getNumPackets());
+        datagrams.reserve(packetList->getNumPackets());
+
+        auto connection = findOrCreateConnection(sockAddr, true);
+
+        while (!packetList->_packets.empty()) {
+            auto packet = packetList->takeFront<Packet>();
+
+            SequenceNumber sequenceNumber;
+            {
+                Lock lock(_unreliableSequenceNumbersMutex);
+                sequenceNumber = ++_unreliableSequenceNumbers[sockAddr];
+            }
+
+            if (connection) {
+                connection->recordSentUnreliablePackets(packet->getWireSize(), packet->getPayloadSize());
+            }
+
+            packet->writeSequenceNumber(sequenceNumber);
+
+            datagrams.emplace_back(packet->getData(), packet->getDataSize());
+            packets.push_back(std::move(packet));
+        }
+
+        return writeDatagramBatch(datagrams, sockAddr);
+    }
+
     qint64 totalBytesSent = 0;
     while (!packetList->_packets.empty()) {
         totalBytesSent += writePacket(packetList->takeFront<Packet>(), sockAddr);
@@ -270,6 +479,178 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
     return bytesWritten;
 }
 
+qint64 Socket::writeDatagramBatch(const DatagramBatch& datagrams, const HifiSockAddr& sockAddr) {
+#if defined(Q_OS_LINUX)
+    if (_isBatchedIOEnabled && sockAddr.getAddress().protocol() == QAbstractSocket::IPv4Protocol
+        && _udpSocket.state() == QAbstractSocket::BoundState) {
+        return writeBatchedDatagrams(datagrams, sockAddr);
+    }
+#endif
+
+    qint64 totalBytesSent = 0;
+    for (const auto& datagram : datagrams) {
+        totalBytesSent += writeDatagram(datagram.first, datagram.second, sockAddr);
+    }
+    return totalBytesSent;
+}
+
+#if defined(Q_OS_LINUX)
+
+qint64 Socket::writeBatchedDatagrams(const DatagramBatch& datagrams, const HifiSockAddr& sockAddr) {
+    auto sd = _udpSocket.socketDescriptor();
+
+    sockaddr_in destination;
+    memset(&destination, 0, sizeof(destination));
+    destination.sin_family = AF_INET;
+    destination.sin_addr.s_addr = htonl(sockAddr.getAddress().toIPv4Address());
+    destination.sin_port = htons(sockAddr.getPort());
+
+    mmsghdr messages[DATAGRAM_BATCH_SIZE];
+    iovec iovecs[DATAGRAM_BATCH_SIZE];
+
+    qint64 totalBytesSent = 0;
+    size_t next = 0;
+
+    while (next < datagrams.size()) {
+        int batchSize = (int)std::min(datagrams.size() - next, (size_t)DATAGRAM_BATCH_SIZE);
+
+        memset(messages, 0, sizeof(mmsghdr) * batchSize);
+        for (int i = 0; i < batchSize; ++i) {
+            iovecs[i].iov_base = const_cast<char*>(datagrams[next + i].first);
+            iovecs[i].iov_len = datagrams[next + i].second;
+
+            messages[i].msg_hdr.msg_name = &destination;
+            messages[i].msg_hdr.msg_namelen = sizeof(destination);
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int numSent = sendmmsg((int)sd, messages, batchSize, MSG_DONTWAIT);
+
+        if (numSent <= 0) {
+            // the kernel didn't take anything (full send buffer or an error) - hand the rest to QUdpSocket,
+            // which takes care of error reporting
+            HIFI_FCDEBUG(networking(), "udt::Socket sendmmsg failed with errno" << errno << "- falling back to QUdpSocket");
+            for (; next < datagrams.size(); ++next) {
+                totalBytesSent += writeDatagram(datagrams[next].first, datagrams[next].second, sockAddr);
+            }
+            break;
+        }
+
+        for (int i = 0; i < numSent; ++i) {
+            totalBytesSent += messages[i].msg_len;
+        }
+        next += numSent;
+    }
+
+    return totalBytesSent;
+}
+
+void Socket::readBatchedDatagrams(std::chrono::system_clock::time_point abortTime) {
+    auto sd = _udpSocket.socketDescriptor();
+    if (sd < 0) {
+        return;
+    }
+
+    mmsghdr messages[DATAGRAM_BATCH_SIZE];
+    iovec iovecs[DATAGRAM_BATCH_SIZE];
+    sockaddr_storage senderAddresses[DATAGRAM_BATCH_SIZE];
+
+    while (std::chrono::system_clock::now() <= abortTime) {
+        memset(messages, 0, sizeof(messages));
+
+        for (int i = 0; i < DATAGRAM_BATCH_SIZE; ++i) {
+            auto& buffer = _batchedReceiveBuffers[i];
+            if (!buffer) {
+                // this buffer was handed off to a packet during the last pass, replace it
+                buffer = PacketBufferPool::allocate(BATCHED_RECEIVE_BUFFER_SIZE);
+            }
+
+            iovecs[i].iov_base = buffer.get();
+            iovecs[i].iov_len = BATCHED_RECEIVE_BUFFER_SIZE;
+
+            messages[i].msg_hdr.msg_name = &senderAddresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int numReceived = recvmmsg((int)sd, messages, DATAGRAM_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+
+        if (numReceived <= 0) {
+            if (numReceived < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                HIFI_FCDEBUG(networking(), "udt::Socket recvmmsg failed with errno" << errno);
+            }
+            break;
+        }
+
+        _readyReadBackupTimer->start();
+
+        auto receiveTime = p_high_resolution_clock::now();
+
+        // with a batch filter, the plain data packets of the batch are built and verified together up front
+        std::unique_ptr<Packet> dataPackets[DATAGRAM_BATCH_SIZE];
+        std::vector<bool> verified;
+        if (_packetBatchFilterOperator) {
+            std::vector<const Packet*> packetsToVerify;
+
+            for (int i = 0; i < numReceived; ++i) {
+                int sizeRead = (int)messages[i].msg_len;
+                auto& buffer = _batchedReceiveBuffers[i];
+
+                if (sizeRead <= 0 || (messages[i].msg_hdr.msg_flags & MSG_TRUNC)
+                    || (*reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK)) {
+                    continue;
+                }
+
+                HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&senderAddresses[i]));
+                if (hasUnfilteredHandlerFor(senderSockAddr)) {
+                    continue;
+                }
+
+                dataPackets[i] = Packet::fromReceivedPacket(std::move(buffer), sizeRead, senderSockAddr);
+                dataPackets[i]->setReceiveTime(receiveTime);
+                packetsToVerify.push_back(dataPackets[i].get());
+            }
+
+            if (!packetsToVerify.empty()) {
+                _packetBatchFilterOperator(packetsToVerify, verified);
+            }
+        }
+
+        // then everything is processed in the order it arrived
+        size_t verifiedIndex = 0;
+        for (int i = 0; i < numReceived; ++i) {
+            int sizeRead = (int)messages[i].msg_len;
+
+            if (sizeRead <= 0 || (messages[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+                HIFI_FCDEBUG(networking(), "udt::Socket dropping empty or truncated datagram of" << sizeRead << "bytes");
+                continue;
+            }
+
+            HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&senderAddresses[i]));
+
+            _lastPacketSizeRead = sizeRead;
+            _lastPacketSockAddr = senderSockAddr;
+
+            if (dataPackets[i]) {
+                bool isVerified = verifiedIndex < verified.size() && verified[verifiedIndex];
+                ++verifiedIndex;
+                processDataPacket(std::move(dataPackets[i]), isVerified);
+            } else {
+                processDatagram(std::move(_batchedReceiveBuffers[i]), sizeRead, senderSockAddr, receiveTime);
+            }
+        }
+
+        if (numReceived < DATAGRAM_BATCH_SIZE) {
+            // we drained everything the kernel had for us
+            break;
+        }
+    }
+}
+
+#endif // Q_OS_LINUX
+
 Connection* Socket::findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreate) {
     Lock connectionsLock(_connectionsHashMutex);
     auto it = _connectionsHash.find(sockAddr);
@@ -320,6 +701,12 @@ void Socket::clearConnections() {
 }
 
 void Socket::cleanupConnection(HifiSockAddr sockAddr) {
+    if (QThread::currentThread() != thread()) {
+        // connections live on the socket thread, make sure they are destroyed there
+        QMetaObject::invokeMethod(this, "cleanupConnection", Q_ARG(HifiSockAddr, sockAddr));
+        return;
+    }
+
     Lock connectionsLock(_connectionsHashMutex);
     auto numErased = _connectionsHash.erase(sockAddr);
 
@@ -394,7 +781,7 @@ void Socket::readPendingDatagrams() {
         HifiSockAddr senderSockAddr;
 
         // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        auto buffer = PacketBufferPool::allocate(packetSizeWithHeader);
 
         // pull the datagram
         auto sizeRead = _udpSocket.readDatagram(buffer.get(), packetSizeWithHeader,
@@ -410,78 +797,118 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
 
+#if defined(Q_OS_LINUX)
+        if (_isBatchedIOEnabled) {
+            // the QUdpSocket read above re-armed its read notifier, now drain whatever else is queued
+            // with as few syscalls as possible
+            readBatchedDatagrams(abortTime);
+        }
+#endif
+    }
+}
+
+void Socket::processDatagram(PacketBuffer buffer, int packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime) {
+    BasePacketHandler unfilteredHandler;
+    bool hasUnfilteredHandler = false;
+    {
+        Lock unfilteredHandlersLock(_unfilteredHandlersMutex);
+        auto it = _unfilteredHandlers.find(senderSockAddr);
         if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
-            }
+            hasUnfilteredHandler = true;
+            unfilteredHandler = it->second;
+        }
+    }
 
-            continue;
+    if (hasUnfilteredHandler) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (unfilteredHandler) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            unfilteredHandler(std::move(basePacket));
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        return;
+    }
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
-            }
+        if (controlPacket->getType() == ControlPacket::Coalesced) {
+            // these carry ordinary packets, they don't belong to a connection
+            processCoalescedPacket(*controlPacket, receiveTime);
+            return;
+        }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+        // call our verification operator to see if this packet is verified
+        bool isVerified = !_packetFilterOperator || _packetFilterOperator(*packet);
+        processDataPacket(std::move(packet), isVerified);
+    }
+}
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+void Socket::processDataPacket(std::unique_ptr<Packet> packet, bool isVerified) {
+    // save the sequence number in case this is the packet that sticks readyRead
+    _lastReceivedSequenceNumber = packet->getSequenceNumber();
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+    if (!isVerified) {
+        return;
+    }
+
+    const auto& senderSockAddr = packet->getSenderSockAddr();
+    auto connection = findOrCreateConnection(senderSockAddr, true);
+
+    if (packet->isReliable()) {
+        // if this was a reliable packet then signal the matching connection with the sequence number
+
+        if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                      packet->getDataSize(),
+                                                                      packet->getPayloadSize())) {
+            // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+            qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
-                }
+            return;
+        }
+    } else if (connection) {
+        connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                    packet->getPayloadSize());
+    }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
-                }
-            }
+    if (packet->isPartOfMessage()) {
+        if (connection) {
+            connection->queueReceivedMessagePacket(std::move(packet));
         }
+    } else if (_packetHandler) {
+        // call the verified packet callback to let it handle this packet
+        _packetHandler(std::move(packet));
     }
 }
 
+bool Socket::hasUnfilteredHandlerFor(const HifiSockAddr& senderSockAddr) {
+    Lock unfilteredHandlersLock(_unfilteredHandlersMutex);
+    return _unfilteredHandlers.find(senderSockAddr) != _unfilteredHandlers.end();
+}
+
 void Socket::connectToSendSignal(const HifiSockAddr& destinationAddr, QObject* receiver, const char* slot) {
     Lock connectionsLock(_connectionsHashMutex);
     auto it = _connectionsHash.find(destinationAddr);
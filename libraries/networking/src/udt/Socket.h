@@ -14,22 +14,28 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <unordered_map>
 #include <mutex>
 #include <list>
+#include <vector>
 
 #include <QtCore/QObject>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtNetwork/QUdpSocket>
 
 #include "../HifiSockAddr.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
+#include "PacketBufferPool.h"
 
 //#define UDT_CONNECTION_DEBUG
 
 class UDTTest;
+class BenchmarkSender;
 
 namespace udt {
 
@@ -39,6 +45,8 @@ class PacketList;
 class SequenceNumber;
 
 using PacketFilterOperator = std::function<bool(const Packet&)>;
+// fills in whether each packet passed, in order
+using PacketBatchFilterOperator = std::function<void(const std::vector<const Packet*>&, std::vector<bool>&)>;
 using ConnectionCreationFilterOperator = std::function<bool(const HifiSockAddr&)>;
 
 using BasePacketHandler = std::function<void(std::unique_ptr<BasePacket>)>;
@@ -68,10 +76,17 @@ public:
     qint64 writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr);
     
     void bind(const QHostAddress& address, quint16 port = 0);
-    void rebind(quint16 port);
+    Q_INVOKABLE void rebind(quint16 port);
     void rebind();
 
+    // moves the socket, its QUdpSocket and all of the receive-side processing onto the given thread
+    // blocks until the move is complete if called from a thread other than the current socket thread
+    Q_INVOKABLE void setSocketThread(QThread* thread);
+
     void setPacketFilterOperator(PacketFilterOperator filterOperator) { _packetFilterOperator = filterOperator; }
+    // used in place of the packet filter operator for packets that were read together, if set
+    void setPacketBatchFilterOperator(PacketBatchFilterOperator filterOperator)
+        { _packetBatchFilterOperator = filterOperator; }
     void setPacketHandler(PacketHandler handler) { _packetHandler = handler; }
     void setMessageHandler(MessageHandler handler) { _messageHandler = handler; }
     void setMessageFailureHandler(MessageFailureHandler handler) { _messageFailureHandler = handler; }
@@ -79,8 +94,21 @@ public:
         { _connectionCreationFilterOperator = filterOperator; }
     
     void addUnfilteredHandler(const HifiSockAddr& senderSockAddr, BasePacketHandler handler)
-        { _unfilteredHandlers[senderSockAddr] = handler; }
+        { Lock lock(_unfilteredHandlersMutex); _unfilteredHandlers[senderSockAddr] = handler; }
     
+    // when enabled, small unreliable packets are held and packed together with others for the same destination
+    // into a single datagram, sent when it is full or on the next flushCoalescedPackets
+    // only peers running a build that unpacks Coalesced control packets can receive them
+    bool isCoalescingEnabled() const { return _isCoalescingEnabled; }
+    void setCoalescingEnabled(bool enabled);
+    // sends everything held for coalescing, callers that produce a burst of packets per frame call this at frame end
+    // it is also called on a short timer so nothing is held for long
+    Q_INVOKABLE void flushCoalescedPackets();
+
+    // batched datagram I/O (recvmmsg/sendmmsg) is only available on Linux, QUdpSocket is used otherwise
+    bool isBatchedIOEnabled() const { return _isBatchedIOEnabled; }
+    void setBatchedIOEnabled(bool enabled);
+
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
@@ -109,10 +137,24 @@ private slots:
     void handleStateChanged(QAbstractSocket::SocketState socketState);
 
 private:
+    using DatagramBatch = std::vector<std::pair<const char*, qint64>>;
+
     void setSystemBufferSizes();
+    void processDatagram(PacketBuffer buffer, int packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
+    void processDataPacket(std::unique_ptr<Packet> packet, bool isVerified);
+    bool hasUnfilteredHandlerFor(const HifiSockAddr& senderSockAddr);
+    qint64 writeDatagramBatch(const DatagramBatch& datagrams, const HifiSockAddr& sockAddr);
+    bool coalescePacket(const Packet& packet, const HifiSockAddr& sockAddr);
+    void processCoalescedPacket(ControlPacket& coalescedPacket, p_high_resolution_clock::time_point receiveTime);
+#if defined(Q_OS_LINUX)
+    void readBatchedDatagrams(std::chrono::system_clock::time_point abortTime);
+    qint64 writeBatchedDatagrams(const DatagramBatch& datagrams, const HifiSockAddr& sockAddr);
+#endif
+
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreation = false);
    
-    // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
+    // privatized methods used by UDTTest and its benchmark - they are private since they must be called on the Socket thread
     ConnectionStats::Stats sampleStatsForConnection(const HifiSockAddr& destination);
     
     std::vector<HifiSockAddr> getConnectionSockAddrs();
@@ -123,6 +165,7 @@ private:
     
     QUdpSocket _udpSocket { this };
     PacketFilterOperator _packetFilterOperator;
+    PacketBatchFilterOperator _packetBatchFilterOperator;
     PacketHandler _packetHandler;
     MessageHandler _messageHandler;
     MessageFailureHandler _messageFailureHandler;
@@ -130,10 +173,13 @@ private:
 
     Mutex _unreliableSequenceNumbersMutex;
     Mutex _connectionsHashMutex;
+    Mutex _unfilteredHandlersMutex;
+    Mutex _coalescedPacketsMutex;
 
     std::unordered_map<HifiSockAddr, BasePacketHandler> _unfilteredHandlers;
     std::unordered_map<HifiSockAddr, SequenceNumber> _unreliableSequenceNumbers;
     std::unordered_map<HifiSockAddr, std::unique_ptr<Connection>> _connectionsHash;
+    std::unordered_map<HifiSockAddr, std::unique_ptr<ControlPacket>> _coalescedPackets;
 
     QTimer* _readyReadBackupTimer { nullptr };
 
@@ -143,11 +189,17 @@ private:
 
     bool _shouldChangeSocketOptions { true };
 
+    bool _isBatchedIOEnabled { false };
+    std::atomic<bool> _isCoalescingEnabled { false };
+    QTimer* _coalescingFlushTimer { nullptr };
+    std::vector<PacketBuffer> _batchedReceiveBuffers; // handed off to packets and refilled as they are consumed
+
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
     HifiSockAddr _lastPacketSockAddr;
     
     friend UDTTest;
+    friend BenchmarkSender;
 };
     
 } // namespace udt
@@ -14,6 +14,7 @@
 #ifndef hifi_TCPVegasCC_h
 #define hifi_TCPVegasCC_h
 
+#include <limits>
 #include <map>
 
 #include "CongestionControl.h"
@@ -33,6 +34,8 @@ public:
     virtual void onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
 
     virtual int estimatedTimeout() const override;
+    virtual int estimatedRTT() const override { return _ewmaRTT == -1 ? 0 : _ewmaRTT; }
+    virtual int minRTT() const override { return _baseRTT == std::numeric_limits<int>::max() ? 0 : _baseRTT; }
     
 protected:
     virtual void performCongestionAvoidance(SequenceNumber ack);
@@ -0,0 +1,107 @@
+//
+//  TimerWheel.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheel.h"
+
+using namespace udt;
+
+const TimerWheel::Tick TimerWheel::MAX_SPAN_TICKS;
+
+bool TimerWheel::schedule(Timer* timer, Tick expiry) {
+    if (timer->isScheduled()) {
+        unlink(timer);
+    }
+
+    if (expiry <= _currentTick) {
+        return false;
+    }
+
+    // clamp anything past the end of the wheel to its last slot
+    timer->_expiry = std::min(expiry, _currentTick + MAX_SPAN_TICKS - 1);
+    link(timer, slotFor(timer->_expiry));
+    return true;
+}
+
+void TimerWheel::cancel(Timer* timer) {
+    if (timer->isScheduled()) {
+        unlink(timer);
+    }
+}
+
+TimerWheel::Tick TimerWheel::getNextEventTick() const {
+    // look through the rest of this level 0 rotation, the wrap is the latest we need to be back for a cascade
+    for (Tick tick = _currentTick + 1; ; ++tick) {
+        auto index0 = tick & (LEVEL_0_SIZE - 1);
+        if (_level0[index0] || index0 == 0) {
+            return tick;
+        }
+    }
+}
+
+TimerWheel::Timer** TimerWheel::slotFor(Tick expiry) {
+    Tick delta = expiry - _currentTick;
+
+    if (delta < (Tick)LEVEL_0_SIZE) {
+        return &_level0[expiry & (LEVEL_0_SIZE - 1)];
+    } else if (delta < ((Tick)1 << (LEVEL_0_BITS + LEVEL_N_BITS))) {
+        return &_level1[(expiry >> LEVEL_0_BITS) & (LEVEL_N_SIZE - 1)];
+    } else {
+        return &_level2[(expiry >> (LEVEL_0_BITS + LEVEL_N_BITS)) & (LEVEL_N_SIZE - 1)];
+    }
+}
+
+void TimerWheel::cascade(Timer** slot) {
+    Timer* timer = *slot;
+    *slot = nullptr;
+
+    while (timer) {
+        Timer* next = timer->_next;
+
+        timer->_previous = nullptr;
+        timer->_next = nullptr;
+        timer->_slot = nullptr;
+        --_numTimers;
+
+        // everything in a cascaded slot is within the span of the finer level now
+        link(timer, slotFor(std::max(timer->_expiry, _currentTick)));
+
+        timer = next;
+    }
+}
+
+void TimerWheel::link(Timer* timer, Timer** slot) {
+    timer->_slot = slot;
+    timer->_previous = nullptr;
+    timer->_next = *slot;
+    if (*slot) {
+        (*slot)->_previous = timer;
+    }
+    *slot = timer;
+
+    ++_numTimers;
+}
+
+void TimerWheel::unlink(Timer* timer) {
+    if (timer->_previous) {
+        timer->_previous->_next = timer->_next;
+    } else {
+        *timer->_slot = timer->_next;
+    }
+
+    if (timer->_next) {
+        timer->_next->_previous = timer->_previous;
+    }
+
+    timer->_previous = nullptr;
+    timer->_next = nullptr;
+    timer->_slot = nullptr;
+
+    --_numTimers;
+}
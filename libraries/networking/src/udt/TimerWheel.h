@@ -0,0 +1,130 @@
+//
+//  TimerWheel.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace udt {
+
+// Hierarchical timing wheel (Varghese & Lauck) with three levels of 256, 64 and 64 slots.
+//
+// Scheduling and cancelling are O(1), and advancing costs one slot visit per tick plus an occasional cascade of
+// a coarser slot down a level. Expiries further out than the wheel's span are clamped to its last slot.
+// Timers are intrusive so the wheel never allocates. It is not thread safe, callers serialize access.
+class TimerWheel {
+public:
+    using Tick = uint64_t;
+
+    class Timer {
+    public:
+        bool isScheduled() const { return _slot != nullptr; }
+        Tick getExpiry() const { return _expiry; }
+
+    private:
+        friend class TimerWheel;
+
+        Timer* _previous { nullptr };
+        Timer* _next { nullptr };
+        Timer** _slot { nullptr };
+        Tick _expiry { 0 };
+    };
+
+    static const int LEVEL_0_BITS = 8;
+    static const int LEVEL_N_BITS = 6;
+    static const Tick MAX_SPAN_TICKS = (Tick)1 << (LEVEL_0_BITS + 2 * LEVEL_N_BITS);
+
+    explicit TimerWheel(Tick currentTick = 0) : _currentTick(currentTick) {}
+
+    // returns false without scheduling if the expiry is not after the current tick, the timer is due now
+    bool schedule(Timer* timer, Tick expiry);
+    void cancel(Timer* timer);
+
+    // moves the wheel forward to the given tick, calling onExpired(Timer*) for every timer that expires on the way
+    // onExpired may schedule timers again, including the one it was handed
+    template <typename ExpiredFunctor>
+    void advance(Tick toTick, ExpiredFunctor onExpired);
+
+    Tick getCurrentTick() const { return _currentTick; }
+    bool isEmpty() const { return _numTimers == 0; }
+    int getNumTimers() const { return _numTimers; }
+
+    // the next tick at which advance will have work to do (a timer expiry or a cascade), only valid if not empty
+    Tick getNextEventTick() const;
+
+private:
+    static const int LEVEL_0_SIZE = 1 << LEVEL_0_BITS;
+    static const int LEVEL_N_SIZE = 1 << LEVEL_N_BITS;
+
+    Timer** slotFor(Tick expiry);
+    void cascade(Timer** slot);
+    void link(Timer* timer, Timer** slot);
+    void unlink(Timer* timer);
+
+    std::array<Timer*, LEVEL_0_SIZE> _level0 {{}};
+    std::array<Timer*, LEVEL_N_SIZE> _level1 {{}};
+    std::array<Timer*, LEVEL_N_SIZE> _level2 {{}};
+
+    Tick _currentTick;
+    int _numTimers { 0 };
+};
+
+template <typename ExpiredFunctor>
+void TimerWheel::advance(Tick toTick, ExpiredFunctor onExpired) {
+    if (_numTimers == 0) {
+        // nothing to expire or cascade, jump straight there
+        _currentTick = std::max(_currentTick, toTick);
+        return;
+    }
+
+    while (_currentTick < toTick) {
+        ++_currentTick;
+
+        auto index0 = _currentTick & (LEVEL_0_SIZE - 1);
+        if (index0 == 0) {
+            // we wrapped level 0, bring the next coarser slots down
+            auto index1 = (_currentTick >> LEVEL_0_BITS) & (LEVEL_N_SIZE - 1);
+            if (index1 == 0) {
+                cascade(&_level2[(_currentTick >> (LEVEL_0_BITS + LEVEL_N_BITS)) & (LEVEL_N_SIZE - 1)]);
+            }
+            cascade(&_level1[index1]);
+        }
+
+        // detach the whole slot first, onExpired is allowed to schedule into it again
+        Timer* expired = _level0[index0];
+        _level0[index0] = nullptr;
+
+        while (expired) {
+            Timer* timer = expired;
+            expired = timer->_next;
+
+            timer->_previous = nullptr;
+            timer->_next = nullptr;
+            timer->_slot = nullptr;
+            --_numTimers;
+
+            onExpired(timer);
+        }
+
+        if (_numTimers == 0) {
+            _currentTick = std::max(_currentTick, toTick);
+            return;
+        }
+    }
+}
+
+}
+
+#endif // hifi_TimerWheel_h
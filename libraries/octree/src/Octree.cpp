@@ -52,7 +52,8 @@
 #include "OctreeUtils.h"
 #include "OctreeEntitiesFileParser.h"
 
-QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz", OctreeBinaryFile::FILE_TYPE};
+static const QVector<QString> JSON_PERSIST_EXTENSIONS = {"json", "json.gz"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -672,6 +673,20 @@ OctreeElementPointer Octree::getElementEnclosingPoint(const glm::vec3& point, Oc
 bool Octree::readFromFile(const char* fileName) {
     QString qFileName = findMostRecentFileExtension(fileName, PERSIST_EXTENSIONS);
 
+    if (qFileName.endsWith("." + OctreeBinaryFile::FILE_TYPE)) {
+        OctreeBinaryFile::Header header;
+        if (canReadBinaryFile(qFileName, header)) {
+            return readFromBinaryFile(qFileName);
+        }
+
+        // binary files are only readable by servers using the same data version, so fall back to the newest JSON file
+        qFileName = findMostRecentFileExtension(fileNameWithoutExtension(fileName, PERSIST_EXTENSIONS), JSON_PERSIST_EXTENSIONS);
+        if (!QFileInfo::exists(qFileName)) {
+            return false;
+        }
+        qCDebug(octree) << "Falling back to" << qFileName;
+    }
+
     if (qFileName.endsWith(".json.gz")) {
         return readJSONFromGzippedFile(qFileName);
     }
@@ -711,6 +726,32 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
     return readJSONFromStream(-1, jsonStream);
 }
 
+bool Octree::canReadBinaryFile(const QString& fileName, OctreeBinaryFile::Header& header) const {
+    if (!OctreeBinaryFile::readHeaderFromFile(fileName, header)) {
+        return false;
+    }
+
+    if (header.dataPacketType != expectedDataPacketType() || header.dataPacketVersion != expectedVersion()) {
+        qCWarning(octree) << "Binary octree file" << fileName << "was written with data version"
+            << (int)header.dataPacketVersion << "but this server uses" << (int)expectedVersion();
+        return false;
+    }
+    return true;
+}
+
+bool Octree::readFromBinaryFile(const QString& fileName) {
+    OctreeBinaryFile::Header header;
+    OctreeBinaryFile::Reader reader;
+    if (!canReadBinaryFile(fileName, header) || !reader.open(fileName)) {
+        return false;
+    }
+
+    qCDebug(octree) << "Reading binary octree file" << fileName;
+    _persistID = header.id;
+    _persistDataVersion = (int)header.dataVersion;
+    return readFromBinary(reader);
+}
+
 // hack to get the marketplace id into the entities.  We will create a way to get this from a hash of
 // the entity later, but this helps us move things along for now
 QString getMarketplaceID(const QString& urlString) {
@@ -834,14 +875,19 @@ bool Octree::readJSONFromStream(
         if (got == 0) {
             break;
         }
-        jsonBuffer += QByteArray(rawData, got);
+        jsonBuffer.append(rawData, got);
     }
+    delete[] rawData;
 
     OctreeEntitiesFileParser octreeParser;
     octreeParser.setEntitiesString(jsonBuffer);
+    return readFromJSONParser(octreeParser, marketplaceID);
+}
+
+bool Octree::readFromJSONParser(OctreeEntitiesFileParser& parser, const QString& marketplaceID) {
     QVariantMap asMap;
-    if (!octreeParser.parseEntities(asMap)) {
-        qCritical() << "Couldn't parse Entities JSON:" << octreeParser.getErrorString().c_str();
+    if (!parser.parseEntities(asMap)) {
+        qCritical() << "Couldn't parse Entities JSON:" << parser.getErrorString().c_str();
         return false;
     }
 
@@ -849,9 +895,7 @@ bool Octree::readJSONFromStream(
         addMarketplaceIDToDocumentEntities(asMap, marketplaceID);
     }
 
-    bool success = readFromMap(asMap);
-    delete[] rawData;
-    return success;
+    return readFromMap(asMap);
 }
 
 bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& element, QString persistAsFileType) {
@@ -865,6 +909,8 @@ bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& eleme
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == OctreeBinaryFile::FILE_TYPE) {
+        success = writeToBinaryFile(cFileName, element);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -970,6 +1016,68 @@ bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& e
     return success;
 }
 
+bool Octree::writeToBinaryFile(const char* fileName, const OctreeElementPointer& element) {
+    qCDebug(octree, "Saving binary octree to file %s...", fileName);
+
+    QSaveFile persistFile(fileName);
+    if (!persistFile.open(QIODevice::WriteOnly)) {
+        qCritical("Failed to open binary octree file for writing.");
+        return false;
+    }
+
+    // the records go out as the tree is walked, so nothing bigger than a chunk is ever held in memory
+    OctreeBinaryFile::Writer writer(persistFile);
+    if (!writer.writeHeader(getBinaryHeader()) || !writeToBinary(writer, element ? element : _rootElement) || !writer.finish()) {
+        qCritical() << "Failed to write to binary octree file:" << persistFile.errorString();
+        persistFile.cancelWriting();
+        return false;
+    }
+
+    if (!persistFile.commit()) {
+        qCritical() << "Failed to commit to binary octree save file:" << persistFile.errorString();
+        return false;
+    }
+    return true;
+}
+
+OctreeBinaryFile::Header Octree::getBinaryHeader() const {
+    OctreeBinaryFile::Header header;
+    header.dataPacketType = expectedDataPacketType();
+    header.dataPacketVersion = expectedVersion();
+    header.id = _persistID;
+    header.dataVersion = _persistDataVersion;
+    return header;
+}
+
+bool Octree::startBinaryJournal(QIODevice& journal) {
+    // the journal is tied to the snapshot it follows by the snapshot's id and data version
+    OctreeBinaryFile::Writer writer(journal);
+    return writer.writeHeader(getBinaryHeader());
+}
+
+bool Octree::appendToBinaryJournal(QIODevice& journal) {
+    OctreeBinaryFile::Writer writer(journal);
+    return writeChangesToBinary(writer) && writer.flush();
+}
+
+bool Octree::readBinaryJournal(const QString& fileName) {
+    OctreeBinaryFile::Reader reader;
+    if (!reader.open(fileName, true)) {
+        return false;
+    }
+
+    const auto& header = reader.getHeader();
+    const auto expectedHeader = getBinaryHeader();
+    if (header.dataPacketType != expectedHeader.dataPacketType || header.dataPacketVersion != expectedHeader.dataPacketVersion ||
+        header.id != expectedHeader.id || header.dataVersion != expectedHeader.dataVersion) {
+        qCDebug(octree) << "Ignoring journal" << fileName << "that doesn't follow the data that was loaded";
+        return false;
+    }
+
+    qCDebug(octree) << "Replaying journal" << fileName;
+    return readChangesFromBinary(reader);
+}
+
 uint64_t Octree::getOctreeElementsCount() {
     uint64_t nodeCount = 0;
     recurseTreeWithOperation(countOctreeElementsOperation, &nodeCount);
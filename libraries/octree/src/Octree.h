@@ -24,6 +24,7 @@
 #include <SimpleMovingAverage.h>
 #include <ViewFrustum.h>
 
+#include "OctreeBinaryFile.h"
 #include "OctreeElement.h"
 #include "OctreeElementBag.h"
 #include "OctreePacketData.h"
@@ -33,6 +34,7 @@
 class ReadBitstreamToTreeParams;
 class Octree;
 class OctreeElement;
+class OctreeEntitiesFileParser;
 class OctreePacketData;
 class Shape;
 using OctreePointer = std::shared_ptr<Octree>;
@@ -138,6 +140,9 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
+    // edit packets are processed with the tree write locked, unless the tree takes the lock itself for just the
+    // part of the edit that needs it
+    virtual bool locksForEditPackets() const { return false; }
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
@@ -213,6 +218,9 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
+    bool writeToBinaryFile(const char* filename, const OctreeElementPointer& element = nullptr);
+    /// Your tree class must implement this to support the binary persist format, it appends one record per item
+    virtual bool writeToBinary(OctreeBinaryFile::Writer& writer, const OctreeElementPointer& element) { return false; }
 
     // Octree importers
     bool readFromFile(const char* filename);
@@ -222,6 +230,24 @@ public:
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="");
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
+    /// Your tree class can override this to add the items as they are parsed rather than once the whole file is
+    virtual bool readFromJSONParser(OctreeEntitiesFileParser& parser, const QString& marketplaceID);
+    bool readFromBinaryFile(const QString& fileName);
+    /// returns false if the file isn't a binary octree file this tree can read, such as one written with another data version
+    bool canReadBinaryFile(const QString& fileName, OctreeBinaryFile::Header& header) const;
+    virtual bool readFromBinary(OctreeBinaryFile::Reader& reader) { return false; }
+
+    // Journaling: the changes made since the last binary snapshot are appended to a journal, which is replayed
+    // on top of the snapshot when it is loaded. Your tree class must implement these to support it.
+    virtual void setTrackChangesToPersist(bool trackChanges) { }
+    virtual void clearChangesToPersist() { }
+    /// appends one record per change since the last call, and forgets them
+    virtual bool writeChangesToBinary(OctreeBinaryFile::Writer& writer) { return false; }
+    virtual bool readChangesFromBinary(OctreeBinaryFile::Reader& reader) { return false; }
+    bool startBinaryJournal(QIODevice& journal);
+    bool appendToBinaryJournal(QIODevice& journal);
+    /// returns false if the journal doesn't belong to the data the tree was loaded from, or can't be read
+    bool readBinaryJournal(const QString& fileName);
 
     uint64_t getOctreeElementsCount();
 
@@ -260,6 +286,7 @@ public:
     virtual quint64 getAverageFilterTime() const { return 0; }
 
     void incrementPersistDataVersion() { _persistDataVersion++; }
+    OctreeBinaryFile::Header getBinaryHeader() const;
 
 
 protected:
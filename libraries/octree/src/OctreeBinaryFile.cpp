@@ -0,0 +1,183 @@
+//
+//  OctreeBinaryFile.cpp
+//  libraries/octree/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeBinaryFile.h"
+
+#include <cstring>
+
+#include "OctreeLogging.h"
+
+namespace OctreeBinaryFile {
+
+constexpr int NUM_BYTES_ID = 16;
+constexpr int HEADER_SIZE = sizeof(MAGIC) + sizeof(quint32) + sizeof(PacketType) + sizeof(PacketVersion) + NUM_BYTES_ID +
+    sizeof(OctreeUtils::Version);
+constexpr int CHUNK_HEADER_SIZE = 2 * sizeof(quint32);
+
+template <typename T>
+static void readValue(const uchar*& data, T& value) {
+    memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+}
+
+template <typename T>
+static void appendValue(QByteArray& buffer, const T& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static bool parseHeader(const uchar* data, qint64 size, Header& header) {
+    if (size < HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    data += sizeof(MAGIC);
+
+    quint32 formatVersion;
+    readValue(data, formatVersion);
+    if (formatVersion != FORMAT_VERSION) {
+        qCWarning(octree) << "Unsupported binary octree file format version" << formatVersion;
+        return false;
+    }
+
+    readValue(data, header.dataPacketType);
+    readValue(data, header.dataPacketVersion);
+    header.id = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(data), NUM_BYTES_ID));
+    data += NUM_BYTES_ID;
+    readValue(data, header.dataVersion);
+    return true;
+}
+
+bool readHeaderFromFile(const QString& path, Header& header) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QByteArray data = file.read(HEADER_SIZE);
+    return parseHeader(reinterpret_cast<const uchar*>(data.constData()), data.size(), header);
+}
+
+bool Writer::writeHeader(const Header& header) {
+    QByteArray buffer;
+    buffer.append(MAGIC, sizeof(MAGIC));
+    appendValue(buffer, FORMAT_VERSION);
+    appendValue(buffer, header.dataPacketType);
+    appendValue(buffer, header.dataPacketVersion);
+    buffer.append(header.id.toRfc4122());
+    appendValue(buffer, header.dataVersion);
+
+    _chunk.reserve(2 * TARGET_CHUNK_SIZE);
+    return _device.write(buffer) == buffer.size();
+}
+
+bool Writer::appendRecord(const unsigned char* data, int size) {
+    appendValue(_chunk, (quint32)size);
+    _chunk.append(reinterpret_cast<const char*>(data), size);
+    _numRecordsInChunk++;
+    _numRecords++;
+
+    return _chunk.size() < TARGET_CHUNK_SIZE || writeChunk();
+}
+
+bool Writer::flush() {
+    return _numRecordsInChunk == 0 || writeChunk();
+}
+
+bool Writer::finish() {
+    // the empty chunk that marks the end of the file
+    return flush() && writeChunk();
+}
+
+bool Writer::writeChunk() {
+    QByteArray compressedChunk = _numRecordsInChunk > 0 ? qCompress(_chunk) : QByteArray();
+
+    QByteArray chunkHeader;
+    appendValue(chunkHeader, _numRecordsInChunk);
+    appendValue(chunkHeader, (quint32)compressedChunk.size());
+
+    _chunk.clear();
+    _numRecordsInChunk = 0;
+
+    return _device.write(chunkHeader) == chunkHeader.size() && _device.write(compressedChunk) == compressedChunk.size();
+}
+
+bool Reader::open(const QString& path, bool isJournal) {
+    _isJournal = isJournal;
+    _file.setFileName(path);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(octree) << "Cannot open binary octree file for reading:" << path << _file.errorString();
+        return false;
+    }
+
+    _size = _file.size();
+    _data = _file.map(0, _size);
+    if (!_data) {
+        qCWarning(octree) << "Cannot map binary octree file:" << path << _file.errorString();
+        return false;
+    }
+
+    if (!parseHeader(_data, _size, _header)) {
+        qCWarning(octree) << "Not a binary octree file:" << path;
+        return false;
+    }
+    _offset = HEADER_SIZE;
+    return true;
+}
+
+bool Reader::forEachRecord(const RecordOperator& recordOperator) {
+    QByteArray chunk;
+    while (_offset + CHUNK_HEADER_SIZE <= _size) {
+        const uchar* chunkAt = _data + _offset;
+        quint32 numRecords;
+        quint32 compressedSize;
+        readValue(chunkAt, numRecords);
+        readValue(chunkAt, compressedSize);
+        _offset += CHUNK_HEADER_SIZE;
+
+        if (numRecords == 0) {
+            return true;
+        }
+
+        if (_offset + compressedSize > _size) {
+            break;
+        }
+        chunk = qUncompress(chunkAt, compressedSize);
+        _offset += compressedSize;
+
+        const uchar* recordAt = reinterpret_cast<const uchar*>(chunk.constData());
+        const uchar* chunkEnd = recordAt + chunk.size();
+        for (quint32 i = 0; i < numRecords; i++) {
+            quint32 recordSize;
+            if (chunkEnd - recordAt < (int)sizeof(recordSize)) {
+                qCWarning(octree) << "Malformed chunk in binary octree file" << _file.fileName();
+                return false;
+            }
+            readValue(recordAt, recordSize);
+            if ((quint32)(chunkEnd - recordAt) < recordSize) {
+                qCWarning(octree) << "Malformed chunk in binary octree file" << _file.fileName();
+                return false;
+            }
+
+            if (!recordOperator(recordAt, (int)recordSize)) {
+                return false;
+            }
+            recordAt += recordSize;
+        }
+    }
+
+    if (_isJournal) {
+        // whatever was left of the last chunk was never synced, and its records were never applied either
+        return true;
+    }
+
+    qCWarning(octree) << "Binary octree file is truncated:" << _file.fileName();
+    return false;
+}
+
+}
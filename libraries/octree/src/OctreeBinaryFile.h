@@ -0,0 +1,106 @@
+//
+//  OctreeBinaryFile.h
+//  libraries/octree/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeBinaryFile_h
+#define hifi_OctreeBinaryFile_h
+
+#include <functional>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QIODevice>
+#include <QtCore/QUuid>
+
+#include <udt/PacketHeaders.h>
+
+#include "OctreeDataUtils.h"
+
+// The binary persist format: a header followed by chunks of records, each record being one item of the tree in
+// the same encoding it is sent over the wire in. Each chunk is compressed on its own so that the file can be written
+// as the tree is walked and read back from a memory map without ever holding more than one chunk uncompressed.
+//
+//  header: magic [4 bytes], format version [4 bytes], data packet type [1 byte], data packet version [1 byte],
+//          id [16 bytes], data version [8 bytes]
+//  chunk:  number of records [4 bytes], compressed size [4 bytes], qCompress'ed records
+//  record: size [4 bytes], data
+//
+// The file ends with an empty chunk, so that a truncated file is told apart from a complete one. Journals are the
+// exception, they are appended to a chunk at a time and never end, so a crash can at most cut their last chunk short.
+namespace OctreeBinaryFile {
+
+const char MAGIC[] = { 'H', 'F', 'O', 'B' };
+const quint32 FORMAT_VERSION = 1;
+const QString FILE_TYPE = "bin";
+
+// records are gathered until the chunk is at least this big before it is compressed and written
+const int TARGET_CHUNK_SIZE = 1024 * 1024;
+
+class Header {
+public:
+    PacketType dataPacketType { PacketType::Unknown };
+    PacketVersion dataPacketVersion { 0 };
+    QUuid id;
+    OctreeUtils::Version dataVersion { OctreeUtils::INITIAL_VERSION };
+};
+
+// returns false if the file can't be opened or doesn't start with a valid header
+bool readHeaderFromFile(const QString& path, Header& header);
+
+class Writer {
+public:
+    Writer(QIODevice& device) : _device(device) {}
+
+    bool writeHeader(const Header& header);
+
+    // buffers the record, writing out the chunk once it is full
+    bool appendRecord(const unsigned char* data, int size);
+
+    // writes out the records buffered so far as a chunk
+    bool flush();
+
+    // writes out the last chunk and the end of the file
+    bool finish();
+
+    int getNumRecords() const { return _numRecords; }
+
+private:
+    bool writeChunk();
+
+    QIODevice& _device;
+    QByteArray _chunk;
+    quint32 _numRecordsInChunk { 0 };
+    int _numRecords { 0 };
+};
+
+class Reader {
+public:
+    using RecordOperator = std::function<bool(const unsigned char* data, int size)>;
+
+    // maps the file and reads its header, returns false if either fails
+    bool open(const QString& path, bool isJournal = false);
+
+    const Header& getHeader() const { return _header; }
+
+    // calls the operator with each record in turn, the data is only valid during the call. Returns false if the file
+    // is malformed or the operator returns false.
+    bool forEachRecord(const RecordOperator& recordOperator);
+
+private:
+    QFile _file;
+    const uchar* _data { nullptr };
+    qint64 _size { 0 };
+    qint64 _offset { 0 };
+    bool _isJournal { false };
+    Header _header;
+};
+
+}
+
+#endif // hifi_OctreeBinaryFile_h
@@ -35,13 +35,15 @@ bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromData(QByteArray data) {
         data = jsonData;
     }
 
+    // the entities are checked one at a time and kept as they are in the file, rather than held parsed
     OctreeEntitiesFileParser jsonParser;
     jsonParser.setEntitiesString(data);
     QVariantMap entitiesMap;
-    if (!jsonParser.parseEntities(entitiesMap)) {
+    if (!jsonParser.parseEntities(entitiesMap, [](QJsonObject& entity) { return true; })) {
         qCritical() << "Can't parse Entities JSON: " << jsonParser.getErrorString().c_str();
         return false;
     }
+    entitiesMap["Entities"] = jsonParser.getEntitiesArray();
 
     return readOctreeDataInfoFromMap(entitiesMap);
 }
@@ -97,20 +99,12 @@ void OctreeUtils::RawOctreeData::resetIdAndVersion() {
 }
 
 void OctreeUtils::RawEntityData::readSubclassData(const QVariantMap& root) {
-    variantEntityData = root["Entities"].toList();
+    entityData = root["Entities"].toByteArray();
 }
 
 void OctreeUtils::RawEntityData::writeSubclassData(QByteArray& root) const {
-    root += "  \"Entities\": [";
-    for (auto entityIter = variantEntityData.begin(); entityIter != variantEntityData.end(); ++entityIter) {
-        if (entityIter != variantEntityData.begin()) {
-            root += ",";
-        }
-        root += "\n    ";
-        // Convert to string and remove trailing LF.
-        root += QJsonDocument(entityIter->toJsonObject()).toJson().chopped(1);
-    }
-    root += "]";
+    root += "  \"Entities\": ";
+    root += entityData.isEmpty() ? QByteArray("[]") : entityData;
 }
 
 PacketType OctreeUtils::RawEntityData::dataPacketType() const { return PacketType::EntityData; }
@@ -51,7 +51,8 @@ public:
     void readSubclassData(const QVariantMap& root) override;
     void writeSubclassData(QByteArray& root) const override;
 
-    QVariantList variantEntityData;
+    // the Entities array as JSON text
+    QByteArray entityData;
 };
 
 }
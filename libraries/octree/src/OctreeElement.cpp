@@ -206,6 +206,7 @@ void OctreeElement::calculateAACube() {
 void OctreeElement::deleteChildAtIndex(int childIndex) {
     OctreeElementPointer childAt = getChildAtIndex(childIndex);
     if (childAt) {
+        childAt->_parent.reset();
         childAt.reset();
         setChildAtIndex(childIndex, NULL);
         _isDirty = true;
@@ -222,6 +223,7 @@ void OctreeElement::deleteChildAtIndex(int childIndex) {
 OctreeElementPointer OctreeElement::removeChildAtIndex(int childIndex) {
     OctreeElementPointer returnedChild = getChildAtIndex(childIndex);
     if (returnedChild) {
+        returnedChild->_parent.reset();
         setChildAtIndex(childIndex, NULL);
         _isDirty = true;
         markWithChangedTime();
@@ -390,6 +392,7 @@ OctreeElementPointer OctreeElement::addChildAtIndex(int childIndex) {
 
         unsigned char* newChildCode = childOctalCode(getOctalCode(), childIndex);
         childAt = createNewElement(newChildCode);
+        childAt->_parent = shared_from_this();
         setChildAtIndex(childIndex, childAt);
 
         _isDirty = true;
@@ -113,6 +113,7 @@ public:
     void deleteChildAtIndex(int childIndex);
     OctreeElementPointer removeChildAtIndex(int childIndex);
     bool isParentOf(const OctreeElementPointer& possibleChild) const;
+    OctreeElementPointer getParent() const { return _parent.lock(); }
 
     /// handles deletion of all descendants, returns false if delete not approved
     bool safeDeepDeleteChildAtIndex(int childIndex, int recursionCount = 0);
@@ -224,6 +225,8 @@ protected:
       unsigned char* pointer;
     } _octalCode;
 
+    OctreeElementWeakPointer _parent; /// Client and server, the element this is a child of, empty for the root
+
     quint64 _lastChanged; /// Client and server, timestamp this node was last changed, 8 bytes
     uint64_t _lastChangedContent { 0 };
 
@@ -35,9 +35,50 @@ void OctreeEntitiesFileParser::setEntitiesString(const QByteArray& entitiesConte
     _entitiesLength = _entitiesContents.length();
     _position = 0;
     _line = 1;
+    _entitiesBegin = -1;
+    _entitiesEnd = -1;
+    _entitiesLine = 1;
 }
 
 bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
+    QVariantList entitiesValue;
+    bool success = parseEntities(parsedEntities, [&](QJsonObject& entity) {
+        entitiesValue.append(entity);
+        return true;
+    });
+    if (!success) {
+        return false;
+    }
+
+    if (_entitiesBegin >= 0) {
+        parsedEntities["Entities"] = std::move(entitiesValue);
+    }
+    return true;
+}
+
+bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities, const EntityOperator& entityOperator) {
+    // the first pass only finds the entities, as the entries they depend on, such as the Version, may come after them
+    if (!readTopLevel(parsedEntities)) {
+        return false;
+    }
+
+    if (_entitiesBegin < 0) {
+        return true;
+    }
+
+    _position = _entitiesBegin;
+    _line = _entitiesLine;
+    return readEntitiesArray(&entityOperator);
+}
+
+QByteArray OctreeEntitiesFileParser::getEntitiesArray() const {
+    if (_entitiesBegin < 0) {
+        return QByteArray();
+    }
+    return _entitiesContents.mid(_entitiesBegin, _entitiesEnd - _entitiesBegin);
+}
+
+bool OctreeEntitiesFileParser::readTopLevel(QVariantMap& parsedEntities) {
     if (nextToken() != '{') {
         _errorString = "Text before start of object";
         return false;
@@ -85,12 +126,9 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
                 return false;
             }
 
-            QVariantList entitiesValue;
-            if (!readEntitiesArray(entitiesValue)) {
+            if (!readEntitiesArray(nullptr)) {
                 return false;
             }
-
-            parsedEntities["Entities"] = std::move(entitiesValue);
             gotEntities = true;
         } else if (key == "Id") {
             if (gotId) {
@@ -213,12 +251,24 @@ int OctreeEntitiesFileParser::readInteger() {
     return i;
 }
 
-bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
+bool OctreeEntitiesFileParser::readEntitiesArray(const EntityOperator* entityOperator) {
+    int entitiesLine = _line;
     if (nextToken() != '[') {
         _errorString = "Entities entry is not an array";
         return false;
     }
 
+    if (!entityOperator) {
+        _entitiesBegin = _position - 1;
+        _entitiesLine = entitiesLine;
+    }
+
+    if (nextToken() == ']') {
+        _entitiesEnd = _position;
+        return true;
+    }
+    --_position;
+
     while (true) {
         if (nextToken() != '{') {
             _errorString = "Entity array item is not an object";
@@ -230,17 +280,26 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
             return false;
         }
 
-        QByteArray jsonEntity = _entitiesContents.mid(_position - 1, matchingBrace - _position + 1);
-        QJsonDocument entity = QJsonDocument::fromJson(jsonEntity);
-        if (entity.isNull()) {
-            _errorString = "Ill-formed entity";
-            return false;
+        if (entityOperator) {
+            QByteArray jsonEntity = QByteArray::fromRawData(_entitiesContents.constData() + _position - 1,
+                                                            matchingBrace - _position + 1);
+            QJsonDocument entity = QJsonDocument::fromJson(jsonEntity);
+            if (entity.isNull()) {
+                _errorString = "Ill-formed entity";
+                return false;
+            }
+
+            QJsonObject entityObject = entity.object();
+            if (!(*entityOperator)(entityObject)) {
+                _errorString = "Entity rejected";
+                return false;
+            }
         }
 
-        entitiesArray.append(entity.object());
         _position = matchingBrace;
         char c = nextToken();
         if (c == ']') {
+            _entitiesEnd = _position;
             return true;
         } else if (c != ',') {
             _errorString = "Entity array item incorrectly terminated";
@@ -14,20 +14,36 @@
 #ifndef hifi_OctreeEntitiesFileParser_h
 #define hifi_OctreeEntitiesFileParser_h
 
+#include <functional>
+
 #include <QByteArray>
+#include <QJsonObject>
 #include <QVariant>
 
 class OctreeEntitiesFileParser {
 public:
+    using EntityOperator = std::function<bool(QJsonObject& entity)>;
+
     void setEntitiesString(const QByteArray& entitiesContents);
     bool parseEntities(QVariantMap& parsedEntities);
+
+    // Streaming mode: the other top-level entries are read into parsedEntities first, whatever order they come in,
+    // then each entity is handed to the operator in turn and dropped, so only one of them is ever held parsed.
+    // Parsing stops if the operator returns false.
+    bool parseEntities(QVariantMap& parsedEntities, const EntityOperator& entityOperator);
+
+    // the text of the Entities array as it is in the file, valid after parseEntities
+    QByteArray getEntitiesArray() const;
+
     std::string getErrorString() const;
 
 private:
     int nextToken();
     std::string readString();
     int readInteger();
-    bool readEntitiesArray(QVariantList& entitiesArray);
+    bool readTopLevel(QVariantMap& parsedEntities);
+    // skips over the entities when no operator is given
+    bool readEntitiesArray(const EntityOperator* entityOperator);
     int findMatchingBrace() const;
 
     QByteArray _entitiesContents;
@@ -35,6 +51,11 @@ private:
     int _line { 1 };
     int _entitiesLength { 0 };
     std::string _errorString;
+
+    // where the Entities array starts and ends, -1 if there isn't one
+    int _entitiesBegin { -1 };
+    int _entitiesEnd { -1 };
+    int _entitiesLine { 1 };
 };
 
 #endif  // hifi_OctreeEntitiesFileParser_h
@@ -52,6 +52,11 @@ typedef uint16_t OCTREE_PACKET_SEQUENCE;
 const uint16_t MAX_OCTREE_PACKET_SEQUENCE = 65535;
 typedef quint64 OCTREE_PACKET_SENT_TIME;
 typedef uint16_t OCTREE_PACKET_INTERNAL_SECTION_SIZE;
+
+// the flags at the start of every OctreeDataNack packet, ahead of the acknowledged sequence number
+typedef uint8_t OCTREE_NACK_FLAGS;
+const OCTREE_NACK_FLAGS OCTREE_NACK_HAS_ACK = 1 << 0;
+const OCTREE_NACK_FLAGS OCTREE_NACK_RESET_ACK = 1 << 1;
 const int MAX_OCTREE_PACKET_SIZE = udt::MAX_PACKET_SIZE;
 
 const unsigned int OCTREE_PACKET_EXTRA_HEADERS_SIZE = sizeof(OCTREE_PACKET_FLAGS)
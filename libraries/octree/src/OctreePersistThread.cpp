@@ -11,6 +11,7 @@
 
 #include "OctreePersistThread.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -37,9 +38,22 @@
 #include "OctreeUtils.h"
 #include "OctreeDataUtils.h"
 
+#ifdef Q_OS_WIN
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
 constexpr std::chrono::seconds OctreePersistThread::DEFAULT_PERSIST_INTERVAL { 30 };
 constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
 
+// the journal is compacted into a new snapshot once it is as big as the snapshot, but not before it is this big
+constexpr qint64 MIN_JOURNAL_SIZE_TO_COMPACT { 4 * 1024 * 1024 };
+
+// the DS gets a full copy on every snapshot, and at most this often in between
+constexpr std::chrono::minutes MIN_TIME_BETWEEN_DS_UPDATES { 5 };
+
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
 
@@ -58,6 +72,19 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     // in case the persist filename has an extension that doesn't match the file type
     QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
     _filename = sansExt + "." + _persistAsFileType;
+    _journalFilename = sansExt + ".journal";
+}
+
+// flushes the file all the way to the disk, so that what was written survives a crash
+static bool syncToDisk(QFile& file) {
+    if (!file.flush()) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    return FlushFileBuffers((HANDLE)_get_osfhandle(file.handle()));
+#else
+    return fsync(file.handle()) == 0;
+#endif
 }
 
 void OctreePersistThread::start() {
@@ -72,9 +99,24 @@ void OctreePersistThread::start() {
     auto packet = NLPacket::create(PacketType::OctreeDataFileRequest, -1, true, false);
 
     OctreeUtils::RawOctreeData data;
-    qCDebug(octree) << "Reading octree data from" << _filename;
-    QFile file(_filename);
-    if (file.open(QIODevice::ReadOnly)) {
+    OctreeBinaryFile::Header binaryHeader;
+    _dataFilename = findMostRecentFileExtension(_filename, PERSIST_EXTENSIONS);
+    qCDebug(octree) << "Reading octree data from" << _dataFilename;
+    QFile file(_dataFilename);
+    if (_dataFilename.endsWith("." + OctreeBinaryFile::FILE_TYPE)) {
+        // only the header is needed here, the entities are read straight from the file once the DS has replied
+        if (_tree->canReadBinaryFile(_dataFilename, binaryHeader)) {
+            qCDebug(octree) << "Current octree data: ID(" << binaryHeader.id << ") DataVersion(" << binaryHeader.dataVersion << ")";
+            packet->writePrimitive(true);
+            auto id = binaryHeader.id.toRfc4122();
+            packet->write(id);
+            packet->writePrimitive(binaryHeader.dataVersion);
+        } else {
+            // most likely written by a server with another data version, so ask the DS for its JSON copy
+            qCWarning(octree) << "No readable octree data found";
+            packet->writePrimitive(false);
+        }
+    } else if (file.open(QIODevice::ReadOnly)) {
         QByteArray jsonData(file.readAll());
         file.close();
         if (!gunzip(jsonData, _cachedJSONData)) {
@@ -115,21 +157,21 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     if (includesNewData) {
         _cachedJSONData.clear();
         replacementData = message->readAll();
-        replaceData(replacementData);
-        hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
+        hasValidOctreeData = data.readOctreeDataInfoFromFile(replaceData(replacementData));
         qDebug() << "Got OctreeDataFileReply, new data sent";
     } else {
         qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
         
         OctreeUtils::RawEntityData data;
-        qCDebug(octree) << "Reading octree data from" << _filename;
-        if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
+        qCDebug(octree) << "Reading octree data from" << _dataFilename;
+        // binary files carry their own id and version, which are read along with the entities
+        if (!_cachedJSONData.isEmpty() && data.readOctreeDataInfoFromData(_cachedJSONData)) {
             hasValidOctreeData = true;
             if (data.id.isNull()) {
                 qCDebug(octree) << "Current octree data has a null id, updating";
                 data.resetIdAndVersion();
 
-                QFile file(_filename);
+                QFile file(_dataFilename);
                 if (file.open(QIODevice::WriteOnly)) {
                     auto entityData = data.toGzippedByteArray();
                     file.write(entityData);
@@ -149,6 +191,7 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     }
 
     bool persistentFileRead;
+    bool hasReplayedJournal = false;
 
     _tree->withWriteLock([&] {
         PerformanceWarning warn(true, "Loading Octree File", true);
@@ -159,6 +202,11 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
             QDataStream jsonStream(_cachedJSONData);
             persistentFileRead = _tree->readFromStream(-1, jsonStream);
         }
+
+        // the journal is only replayed on top of the data it follows, and is compacted away by the first persist
+        if (persistentFileRead && isJournaling() && _tree->readBinaryJournal(_journalFilename)) {
+            hasReplayedJournal = true;
+        }
         _tree->pruneTree();
     });
 
@@ -166,7 +214,14 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     quint64 loadDone = usecTimestampNow();
     _loadTimeUSecs = loadDone - loadStarted;
 
-    _tree->clearDirtyBit(); // the tree is clean since we just loaded it
+    if (hasReplayedJournal) {
+        _tree->setDirtyBit();
+    } else {
+        _tree->clearDirtyBit(); // the tree is clean since we just loaded it
+    }
+    if (isJournaling()) {
+        _tree->setTrackChangesToPersist(true);
+    }
 
     unsigned long nodeCount = OctreeElement::getNodeCount();
     unsigned long internalNodeCount = OctreeElement::getInternalNodeCount();
@@ -204,22 +259,31 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 QString OctreePersistThread::getPersistFileMimeType() const {
     if (_persistAsFileType == "json") {
         return "application/json";
-    } if (_persistAsFileType == "json.gz") {
+    } if (_persistAsFileType == "json.gz" || _persistAsFileType == OctreeBinaryFile::FILE_TYPE) {
         return "application/zip";
     }
     return "";
 }
 
-void OctreePersistThread::replaceData(QByteArray data) {
+QString OctreePersistThread::replaceData(QByteArray data) {
     backupCurrentFile();
 
-    QFile currentFile { _filename };
+    // the DS only deals in JSON, when persisting binary the replacement is loaded from JSON and saved as binary later
+    QString replacementFilename = _filename;
+    if (_persistAsFileType == OctreeBinaryFile::FILE_TYPE) {
+        static const QByteArray GZIP_MAGIC = "\x1f\x8b";
+        replacementFilename = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS) +
+            (data.startsWith(GZIP_MAGIC) ? ".json.gz" : ".json");
+    }
+
+    QFile currentFile { replacementFilename };
     if (currentFile.open(QIODevice::WriteOnly)) {
         currentFile.write(data);
         qDebug() << "Wrote replacement data";
     } else {
         qWarning() << "Failed to write replacement data";
     }
+    return replacementFilename;
 }
 
 // Return true if current file is backed up successfully or doesn't exist.
@@ -264,6 +328,12 @@ void OctreePersistThread::aboutToFinish() {
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
+    if (_persistAsFileType == OctreeBinaryFile::FILE_TYPE) {
+        // the binary format is only meant for this server, downloads get the JSON export
+        _tree->toJSON(&fileContents, nullptr, true);
+        return fileContents;
+    }
+
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
         fileContents = file.readAll();
@@ -303,6 +373,20 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
 
 void OctreePersistThread::persist() {
     if (_tree->isDirty() && _initialLoadComplete) {
+        // between snapshots only what changed is appended to the journal
+        if (_journal.isOpen() && _journal.size() < std::max(_snapshotSize, MIN_JOURNAL_SIZE_TO_COMPACT)) {
+            if (_tree->appendToBinaryJournal(_journal) && syncToDisk(_journal)) {
+                _tree->clearDirtyBit();
+
+                auto now = std::chrono::steady_clock::now();
+                if (now - _lastDSUpdate > MIN_TIME_BETWEEN_DS_UPDATES) {
+                    sendLatestEntityDataToDS();
+                }
+                return;
+            }
+            qCWarning(octree) << "Failed to append to journal" << _journalFilename << "- saving a full snapshot instead";
+        }
+        _journal.close();
 
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
@@ -312,10 +396,17 @@ void OctreePersistThread::persist() {
 
         _tree->incrementPersistDataVersion();
 
+        // everything changed so far is in the snapshot
+        _tree->clearChangesToPersist();
+
         qCDebug(octree) << "Saving Octree data to:" << _filename;
         if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
             _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
+
+            if (isJournaling()) {
+                startJournal();
+            }
         } else {
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
         }
@@ -324,8 +415,21 @@ void OctreePersistThread::persist() {
     }
 }
 
+void OctreePersistThread::startJournal() {
+    _snapshotSize = QFileInfo(_filename).size();
+
+    // the previous journal only applies to the previous snapshot, so it is started over
+    _journal.setFileName(_journalFilename);
+    if (!_journal.open(QIODevice::WriteOnly | QIODevice::Truncate) || !_tree->startBinaryJournal(_journal) ||
+        !syncToDisk(_journal)) {
+        qCWarning(octree) << "Failed to start journal" << _journalFilename << _journal.errorString();
+        _journal.close();
+    }
+}
+
 void OctreePersistThread::sendLatestEntityDataToDS() {
     qDebug() << "Sending latest entity data to DS";
+    _lastDSUpdate = std::chrono::steady_clock::now();
     auto nodeList = DependencyManager::get<NodeList>();
     const DomainHandler& domainHandler = nodeList->getDomainHandler();
 
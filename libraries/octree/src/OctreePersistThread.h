@@ -14,6 +14,7 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <QFile>
 #include <QString>
 #include <GenericThread.h>
 #include "Octree.h"
@@ -62,9 +63,13 @@ protected:
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
-    void replaceData(QByteArray data);
+    QString replaceData(QByteArray data); /// returns the file the data was written to
     void sendLatestEntityDataToDS();
 
+    // binary snapshots are followed by a journal of the changes made since
+    bool isJournaling() const { return _persistAsFileType == OctreeBinaryFile::FILE_TYPE; }
+    void startJournal();
+
 private:
     OctreePointer _tree;
     QString _filename;
@@ -79,6 +84,12 @@ private:
 
     QString _persistAsFileType;
     QByteArray _cachedJSONData;
+    QString _dataFilename;
+
+    QString _journalFilename;
+    QFile _journal;
+    qint64 _snapshotSize { 0 };
+    std::chrono::steady_clock::time_point _lastDSUpdate;
 };
 
 #endif // hifi_OctreePersistThread_h
@@ -11,6 +11,8 @@
 #include "OctreeProcessor.h"
 
 #include <stdint.h>
+#include <memory>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -96,10 +98,11 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
 
         const QUuid& sourceUUID = sourceNode->getUUID();
 
-        int subsection = 1;
-
         bool error = false;
 
+        // the sections are uncompressed before taking the lock, so that the tree is only locked while they are read into it
+        std::vector<std::unique_ptr<OctreePacketData>> sections;
+        quint64 startUncompress = usecTimestampNow();
         while (message.getBytesLeftToRead() > 0 && !error) {
             if (packetIsCompressed) {
                 if (message.getBytesLeftToRead() > (qint64) sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE)) {
@@ -113,58 +116,56 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
             }
 
             if (sectionLength) {
-                // ask the VoxelTree to read the bitstream into the tree
-                ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, NULL,
-                                               sourceUUID, sourceNode);
-                quint64 startUncompress, startLock = usecTimestampNow();
-                quint64 startReadBitsteam, endReadBitsteam;
-                // FIXME STUTTER - there may be an opportunity to bump this lock outside of the
-                // loop to reduce the amount of locking/unlocking we're doing
-                _tree->withWriteLock([&] {
-                    startUncompress = usecTimestampNow();
-
-                    OctreePacketData packetData(packetIsCompressed);
-                    packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
-                        sectionLength);
-                    if (extraDebugging) {
-                        qCDebug(octree) << "OctreeProcessor::processDatagram() ... "
-                            "Got Packet Section color:" << packetIsColored <<
-                            "compressed:" << packetIsCompressed <<
-                            "sequence: " << sequence <<
-                            "flight: " << flightTime << " usec" <<
-                            "size:" << message.getSize() <<
-                            "data:" << message.getBytesLeftToRead() <<
-                            "subsection:" << subsection <<
-                            "sectionLength:" << sectionLength <<
-                            "uncompressed:" << packetData.getUncompressedSize();
-                    }
+                auto packetData = std::unique_ptr<OctreePacketData>(new OctreePacketData(packetIsCompressed));
+                packetData->loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
+                    sectionLength);
+                if (extraDebugging) {
+                    qCDebug(octree) << "OctreeProcessor::processDatagram() ... "
+                        "Got Packet Section color:" << packetIsColored <<
+                        "compressed:" << packetIsCompressed <<
+                        "sequence: " << sequence <<
+                        "flight: " << flightTime << " usec" <<
+                        "size:" << message.getSize() <<
+                        "data:" << message.getBytesLeftToRead() <<
+                        "subsection:" << (sections.size() + 1) <<
+                        "sectionLength:" << sectionLength <<
+                        "uncompressed:" << packetData->getUncompressedSize();
+                }
+                sections.push_back(std::move(packetData));
+
+                // seek forwards in packet
+                message.seek(message.getPosition() + sectionLength);
+            }
+        }
 
+        if (!sections.empty()) {
+            quint64 startLock = usecTimestampNow();
+            totalUncompress = startLock - startUncompress;
+            quint64 startReadBitsteam = startLock;
+            // all the sections of the packet go into the tree under a single lock
+            _tree->withWriteLock([&] {
+                startReadBitsteam = usecTimestampNow();
+                for (const auto& packetData : sections) {
+                    // ask the VoxelTree to read the bitstream into the tree
+                    ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, NULL,
+                                                   sourceUUID, sourceNode);
                     if (extraDebugging) {
                         qCDebug(octree) << "OctreeProcessor::processDatagram() ******* START _tree->readBitstreamToTree()...";
                     }
-                    startReadBitsteam = usecTimestampNow();
-                    _tree->readBitstreamToTree(packetData.getUncompressedData(), packetData.getUncompressedSize(), args);
-                    endReadBitsteam = usecTimestampNow();
+                    _tree->readBitstreamToTree(packetData->getUncompressedData(), packetData->getUncompressedSize(), args);
                     if (extraDebugging) {
                         qCDebug(octree) << "OctreeProcessor::processDatagram() ******* END _tree->readBitstreamToTree()...";
                     }
-                });
-
-                // seek forwards in packet
-                message.seek(message.getPosition() + sectionLength);
 
-                elementsPerPacket += args.elementsPerPacket;
-                entitiesPerPacket += args.entitiesPerPacket;
-
-                _elementsInLastWindow += args.elementsPerPacket;
-                _entitiesInLastWindow += args.entitiesPerPacket;
-
-                totalWaitingForLock += (startUncompress - startLock);
-                totalUncompress += (startReadBitsteam - startUncompress);
-                totalReadBitsteam += (endReadBitsteam - startReadBitsteam);
+                    elementsPerPacket += args.elementsPerPacket;
+                    entitiesPerPacket += args.entitiesPerPacket;
+                }
+            });
+            totalWaitingForLock = startReadBitsteam - startLock;
+            totalReadBitsteam = usecTimestampNow() - startReadBitsteam;
 
-            }
-            subsection++;
+            _elementsInLastWindow += elementsPerPacket;
+            _entitiesInLastWindow += entitiesPerPacket;
         }
         _elementsPerPacket.updateAverage(elementsPerPacket);
         _entitiesPerPacket.updateAverage(entitiesPerPacket);
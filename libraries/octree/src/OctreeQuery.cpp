@@ -11,6 +11,7 @@
 
 #include "OctreeQuery.h"
 
+#include <algorithm>
 #include <random>
 
 #include <QtCore/QJsonDocument>
@@ -18,6 +19,8 @@
 #include <GLMHelpers.h>
 #include <udt/PacketHeaders.h>
 
+const size_t MAX_INTEREST_REGIONS = 16;
+
 OctreeQuery::OctreeQuery(bool randomizeConnectionID) {
     if (randomizeConnectionID) {
         // randomize our initial octree query connection ID using random_device
@@ -48,6 +51,15 @@ int OctreeQuery::getBroadcastData(unsigned char* destinationBuffer) {
         for (const auto& view : _conicalViews) {
             destinationBuffer += view.serialize(destinationBuffer);
         }
+
+        // Number of interest regions, as many as fit in the packet alongside the views
+        uint8_t numRegions = (uint8_t)std::min(_interestRegions.size(), MAX_INTEREST_REGIONS);
+        memcpy(destinationBuffer, &numRegions, sizeof(numRegions));
+        destinationBuffer += sizeof(numRegions);
+
+        for (uint8_t i = 0; i < numRegions; ++i) {
+            destinationBuffer += _interestRegions[i].serialize(destinationBuffer);
+        }
     }
     
     // desired Max Octree PPS
@@ -128,6 +140,17 @@ int OctreeQuery::parseData(ReceivedMessage& message) {
             sourceBuffer += view.deserialize(sourceBuffer);
             _conicalViews.push_back(view);
         }
+
+        uint8_t numRegions = 0;
+        memcpy(&numRegions, sourceBuffer, sizeof(numRegions));
+        sourceBuffer += sizeof(numRegions);
+
+        _interestRegions.clear();
+        for (int i = 0; i < numRegions; ++i) {
+            InterestRegion region;
+            sourceBuffer += region.deserialize(sourceBuffer);
+            _interestRegions.push_back(region);
+        }
     }
 
     // desired Max Octree PPS
@@ -17,6 +17,7 @@
 
 #include <NodeData.h>
 #include <shared/ConicalViewFrustum.h>
+#include <shared/InterestRegion.h>
 
 #include "OctreeConstants.h"
 
@@ -38,6 +39,12 @@ public:
         { QMutexLocker lock(&_conicalViewsLock); _conicalViews = views; }
     void clearConicalViews() { QMutexLocker lock(&_conicalViewsLock); _conicalViews.clear(); }
 
+    // regions the client wants the entities in, besides those in its views
+    bool hasInterestRegions() const { QMutexLocker lock(&_conicalViewsLock); return !_interestRegions.empty(); }
+    void setInterestRegions(InterestRegions regions)
+        { QMutexLocker lock(&_conicalViewsLock); _interestRegions = regions; }
+    void clearInterestRegions() { QMutexLocker lock(&_conicalViewsLock); _interestRegions.clear(); }
+
     // getters/setters for JSON filter
     QJsonObject getJSONParameters() { QReadLocker locker { &_jsonParametersLock }; return _jsonParameters; }
     void setJSONParameters(const QJsonObject& jsonParameters)
@@ -67,6 +74,7 @@ public slots:
 protected:
     mutable QMutex _conicalViewsLock;
     ConicalViewFrustums _conicalViews;
+    InterestRegions _interestRegions;
 
     // octree server sending items
     int _maxQueryPPS = DEFAULT_MAX_OCTREE_PPS;
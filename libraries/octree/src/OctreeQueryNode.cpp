@@ -145,7 +145,7 @@ bool OctreeQueryNode::updateCurrentViewFrustum() {
         return false;
     }
     
-    if (!hasConicalViews()) {
+    if (!hasConicalViews() && !hasInterestRegions() && _currentInterestRegions.empty()) {
         // this client does not use a view frustum so the view frustum for this query has not changed
         return false;
     }
@@ -167,6 +167,15 @@ bool OctreeQueryNode::updateCurrentViewFrustum() {
             _currentConicalViews = _conicalViews;
             currentViewFrustumChanged = true;
         }
+
+        bool regionsChanged = _interestRegions.size() != _currentInterestRegions.size();
+        for (size_t i = 0; !regionsChanged && i < _interestRegions.size(); ++i) {
+            regionsChanged = !_interestRegions[i].isVerySimilar(_currentInterestRegions[i]);
+        }
+        if (regionsChanged) {
+            _currentInterestRegions = _interestRegions;
+            currentViewFrustumChanged = true;
+        }
     }
 
     // Also check for LOD changes from the client
@@ -223,12 +232,34 @@ const NLPacket* OctreeQueryNode::getNextNackedPacket() {
 }
 
 void OctreeQueryNode::parseNackPacket(ReceivedMessage& message) {
+    // every packet starts with the acknowledgement flags and sequence number
+    OCTREE_NACK_FLAGS ackFlags;
+    OCTREE_PACKET_SEQUENCE ackedSequenceNumber;
+    message.readPrimitive(&ackFlags);
+    message.readPrimitive(&ackedSequenceNumber);
+    if (ackFlags & OCTREE_NACK_RESET_ACK) {
+        _ackedSequenceNumber = -1;
+        _ackResetRequested = true;
+    } else if (ackFlags & OCTREE_NACK_HAS_ACK) {
+        _ackedSequenceNumber = ackedSequenceNumber;
+    }
+
     // read sequence numbers
     while (message.getBytesLeftToRead()) {
         OCTREE_PACKET_SEQUENCE sequenceNumber;
         message.readPrimitive(&sequenceNumber);
         _nackedSequenceNumbers.enqueue(sequenceNumber);
+        _numNackedPackets++;
+    }
+}
+
+bool OctreeQueryNode::getAckedSequenceNumber(OCTREE_PACKET_SEQUENCE& sequenceNumber) const {
+    int ackedSequenceNumber = _ackedSequenceNumber;
+    if (ackedSequenceNumber < 0) {
+        return false;
     }
+    sequenceNumber = (OCTREE_PACKET_SEQUENCE)ackedSequenceNumber;
+    return true;
 }
 
 bool OctreeQueryNode::haveJSONParametersChanged() {
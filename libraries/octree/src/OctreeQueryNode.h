@@ -12,6 +12,7 @@
 #ifndef hifi_OctreeQueryNode_h
 #define hifi_OctreeQueryNode_h
 
+#include <atomic>
 #include <iostream>
 
 #include <qqueue.h>
@@ -50,6 +51,7 @@ public:
     OctreeElementExtraEncodeData extraEncodeData;
 
     const ConicalViewFrustums& getCurrentViews() const { return _currentConicalViews; }
+    const InterestRegions& getCurrentInterestRegions() const { return _currentInterestRegions; }
 
     // These are not classic setters because they are calculating and maintaining state
     // which is set asynchronously through the network receive
@@ -80,6 +82,13 @@ public:
     bool hasNextNackedPacket() const;
     const NLPacket* getNextNackedPacket();
 
+    // the latest sequence number the client has received everything up to, if it has said
+    bool getAckedSequenceNumber(OCTREE_PACKET_SEQUENCE& sequenceNumber) const;
+    // whether the client has asked, since this was last called, for what it acknowledged to be forgotten
+    bool takeAckResetRequest() { return _ackResetRequested.exchange(false); }
+    // the number of packets the client has said it missed since this was last called
+    int takeNumNackedPackets() { return _numNackedPackets.exchange(0); }
+
     // call only from OctreeSendThread for the given node
     bool haveJSONParametersChanged();
 
@@ -96,6 +105,7 @@ private:
     quint64 _firstSuppressedPacket { usecTimestampNow() };
 
     ConicalViewFrustums _currentConicalViews;
+    InterestRegions _currentInterestRegions;
     bool _viewFrustumChanging { false };
     bool _viewFrustumJustStoppedChanging { true };
 
@@ -112,6 +122,9 @@ private:
 
     SentPacketHistory _sentPacketHistory;
     QQueue<OCTREE_PACKET_SEQUENCE> _nackedSequenceNumbers;
+    std::atomic<int> _ackedSequenceNumber { -1 };
+    std::atomic<bool> _ackResetRequested { false };
+    std::atomic<int> _numNackedPackets { 0 };
 
     std::array<char, udt::MAX_PACKET_SIZE> _lastOctreePayload;
 
@@ -28,6 +28,9 @@
 const uint8_t LOOPS_FOR_SIMULATION_ORPHAN = 50;
 const quint64 USECS_BETWEEN_OWNERSHIP_BIDS = USECS_PER_SECOND / 5;
 
+uint8_t EntityMotionState::_volunteerPriority { VOLUNTEER_SIMULATION_PRIORITY };
+std::atomic<bool> EntityMotionState::_allCollisionEventsWanted { true };
+
 
 EntityMotionState::EntityMotionState(btCollisionShape* shape, EntityItemPointer entity) :
     ObjectMotionState(nullptr),
@@ -748,7 +751,7 @@ bool EntityMotionState::shouldSendBid() const {
     return _body->isActive()
         && (_region == workload::Region::R1)
         && _ownershipState != EntityMotionState::OwnershipState::Unownable
-        && glm::max(glm::max(VOLUNTEER_SIMULATION_PRIORITY, _bumpedPriority), _entity->getScriptSimulationPriority()) >= _entity->getSimulationPriority()
+        && glm::max(glm::max(_volunteerPriority, _bumpedPriority), _entity->getScriptSimulationPriority()) >= _entity->getSimulationPriority()
         && !_entity->getLocked()
         && (!_body->isStaticOrKinematicObject() || _entity->stillHasMyGrab());
 }
@@ -764,7 +767,7 @@ void EntityMotionState::setRigidBody(btRigidBody* body) {
 
 uint8_t EntityMotionState::computeFinalBidPriority() const {
     return (_region == workload::Region::R1) ?
-        glm::max(glm::max(VOLUNTEER_SIMULATION_PRIORITY, _bumpedPriority), _entity->getScriptSimulationPriority()) : 0;
+        glm::max(glm::max(_volunteerPriority, _bumpedPriority), _entity->getScriptSimulationPriority()) : 0;
 }
 
 bool EntityMotionState::isLocallyOwned() const {
@@ -781,8 +784,25 @@ bool EntityMotionState::isLocallyOwnedOrShouldBe() const {
     }
 }
 
+float EntityMotionState::getSleepingThresholdScale() const {
+    const float DISTANT_SLEEPING_THRESHOLD_SCALE = 4.0f;
+    return (_region == workload::Region::R1) ? 1.0f : DISTANT_SLEEPING_THRESHOLD_SCALE;
+}
+
+bool EntityMotionState::wantsCollisionEvents() const {
+    return _allCollisionEventsWanted || !_entity->getScript().isEmpty() || !_entity->getCollisionSoundURL().isEmpty();
+}
+
 void EntityMotionState::setRegion(uint8_t region) {
+    if (region == _region) {
+        return;
+    }
     _region = region;
+    if (_body && _motionType == MOTION_TYPE_DYNAMIC) {
+        float sleepingThresholdScale = getSleepingThresholdScale();
+        _body->setSleepingThresholds(sleepingThresholdScale * DYNAMIC_LINEAR_SPEED_THRESHOLD,
+            sleepingThresholdScale * DYNAMIC_ANGULAR_SPEED_THRESHOLD);
+    }
 }
 
 void EntityMotionState::initForBid() {
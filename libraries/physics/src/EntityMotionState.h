@@ -12,6 +12,8 @@
 #ifndef hifi_EntityMotionState_h
 #define hifi_EntityMotionState_h
 
+#include <atomic>
+
 #include <EntityItem.h>
 #include <EntityTypes.h>
 #include <AACube.h>
@@ -37,6 +39,11 @@ public:
     EntityMotionState(btCollisionShape* shape, EntityItemPointer item);
     virtual ~EntityMotionState();
 
+    // the least priority the simulation bids with for the objects it wants to own, raised by the servers that simulate
+    // physics so that they take over the objects they bump into from the clients
+    static void setVolunteerPriority(uint8_t priority) { _volunteerPriority = priority; }
+    static uint8_t getVolunteerPriority() { return _volunteerPriority; }
+
     void handleDeactivation();
     virtual void handleEasyChanges(uint32_t& flags) override;
 
@@ -45,6 +52,13 @@ public:
 
     virtual bool isMoving() const override;
 
+    // the objects out of R1 are only simulated until the entity-server catches up with them, they fall asleep sooner
+    virtual float getSleepingThresholdScale() const override;
+
+    // only the entities with a script or a collision sound get collision events, unless scripts listen to those of all
+    virtual bool wantsCollisionEvents() const override;
+    static void setAllCollisionEventsWanted(bool wanted) { _allCollisionEventsWanted = wanted; }
+
     // this relays incoming position/rotation to the RigidBody
     virtual void getWorldTransform(btTransform& worldTrans) const override;
 
@@ -158,6 +172,9 @@ protected:
     uint8_t _region { workload::Region::INVALID };
 
     bool isServerlessMode();
+
+    static uint8_t _volunteerPriority;
+    static std::atomic<bool> _allCollisionEventsWanted;
 };
 
 #endif // hifi_EntityMotionState_h
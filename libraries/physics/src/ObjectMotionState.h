@@ -133,6 +133,12 @@ public:
 
     virtual bool isMoving() const = 0;
 
+    // scales the speeds under which the body falls asleep
+    virtual float getSleepingThresholdScale() const { return 1.0f; }
+
+    // whether the contacts of the object are tracked into collision events
+    virtual bool wantsCollisionEvents() const { return true; }
+
     // These pure virtual methods must be implemented for each MotionState type
     // and make it possible to implement more complicated methods in this base class.
 
@@ -39,6 +39,11 @@ void PhysicalEntitySimulation::init(
     _entityPacketSender = packetSender;
 }
 
+uint8_t PhysicalEntitySimulation::getEntityRegion(const EntityItemPointer& entity) const {
+    // without a workload space, as on the servers that simulate physics, every entity is in the nearest region
+    return _space ? _space->getRegion(entity->getSpaceIndex()) : (uint8_t)workload::Region::R1;
+}
+
 // begin EntitySimulation overrides
 void PhysicalEntitySimulation::updateEntitiesInternal(uint64_t now) {
     // Do nothing here because the "internal" update the PhysicsEngine::stepSimulation() which is done elsewhere.
@@ -48,7 +53,7 @@ void PhysicalEntitySimulation::addEntityInternal(EntityItemPointer entity) {
     QMutexLocker lock(&_mutex);
     assert(entity);
     assert(!entity->isDead());
-    uint8_t region = _space->getRegion(entity->getSpaceIndex());
+    uint8_t region = getEntityRegion(entity);
     bool maybeShouldBePhysical = (region < workload::Region::R3 || region == workload::Region::UNKNOWN) && entity->shouldBePhysical();
     bool canBeKinematic = region <= workload::Region::R3;
     if (maybeShouldBePhysical) {
@@ -137,7 +142,7 @@ void PhysicalEntitySimulation::processChangedEntity(const EntityItemPointer& ent
 
     // queue incoming changes: from external sources (script, EntityServer, etc) to physics engine
     EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
-    uint8_t region = _space->getRegion(entity->getSpaceIndex());
+    uint8_t region = getEntityRegion(entity);
     bool shouldBePhysical = region < workload::Region::R3 && entity->shouldBePhysical();
     bool canBeKinematic = region <= workload::Region::R3;
     if (motionState) {
@@ -243,7 +248,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
     auto buildMotionState = [&](btCollisionShape* shape, EntityItemPointer entity) {
         EntityMotionState* motionState = new EntityMotionState(shape, entity);
         entity->setPhysicsInfo(static_cast<void*>(motionState));
-        motionState->setRegion(_space->getRegion(entity->getSpaceIndex()));
+        motionState->setRegion(getEntityRegion(entity));
         _physicalObjects.insert(motionState);
         _incomingChanges.insert(motionState);
     };
@@ -277,7 +282,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                         // bummer, the hashes are different and we no longer want the shape we've received
                         ObjectMotionState::getShapeManager()->releaseShape(shape);
                         // try again
-                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo, true));
                         if (shape) {
                             buildMotionState(shape, entity);
                             requestItr = _shapeRequests.erase(requestItr);
@@ -331,7 +336,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
             continue;
         }
 
-        uint8_t region = _space->getRegion(entity->getSpaceIndex());
+        uint8_t region = getEntityRegion(entity);
         if (region == workload::Region::UNKNOWN) {
             // the workload hasn't categorized it yet --> skip for later
             ++entityItr;
@@ -351,7 +356,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                 ShapeInfo shapeInfo;
                 entity->computeShapeInfo(shapeInfo);
                 uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo, true));
                 if (shape) {
                     buildMotionState(shape, entity);
                 } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
@@ -407,14 +412,14 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
         bool needsNewShape = object->needsNewShape();
         if (needsNewShape) {
             ShapeType shapeType = object->getShapeType();
-            if (shapeType == SHAPE_TYPE_STATIC_MESH) {
+            if (ShapeManager::canBuildOnWorker(shapeType)) {
                 ShapeRequest shapeRequest(object->_entity);
                 ShapeRequests::iterator  requestItr = _shapeRequests.find(shapeRequest);
                 if (requestItr == _shapeRequests.end()) {
                     ShapeInfo shapeInfo;
                     object->_entity->computeShapeInfo(shapeInfo);
                     uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo, true));
                     if (shape) {
                         object->setShape(shape);
                         handledFlags |= Simulation::DIRTY_SHAPE;
@@ -75,6 +75,8 @@ protected: // only called by EntitySimulation
     void processChangedEntity(const EntityItemPointer& entity) override;
     virtual void clearEntitiesInternal() override;
 
+    uint8_t getEntityRegion(const EntityItemPointer& entity) const;
+
     void removeOwnershipData(EntityMotionState* motionState);
     void clearOwnershipData();
 
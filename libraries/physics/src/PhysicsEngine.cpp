@@ -18,37 +18,68 @@
 #include <PerfStat.h>
 #include <PhysicsCollisionGroups.h>
 #include <Profile.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/CollisionShapes/btTriangleShape.h>
 
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
 #include "PhysicsHelpers.h"
 #include "PhysicsDebugDraw.h"
+#include "PhysicsTaskScheduler.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
 
+bool PhysicsEngine::_isMultithreaded { false };
+std::unique_ptr<PhysicsTaskScheduler> PhysicsEngine::_taskScheduler;
+
+// how many pairs of overlapping objects each task of the multithreaded narrowphase takes
+const int NARROWPHASE_GRAIN_SIZE = 40;
+
 PhysicsEngine::PhysicsEngine(const glm::vec3& offset) :
         _originOffset(offset),
         _myAvatarController(nullptr) {
 }
 
 PhysicsEngine::~PhysicsEngine() {
+    if (_stepThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(_stepMutex);
+            _isStopping = true;
+        }
+        _stepCondition.notify_all();
+        _stepThread.join();
+    }
     _myAvatarController = nullptr;
     delete _collisionConfig;
     delete _collisionDispatcher;
     delete _broadphaseFilter;
-    delete _constraintSolver;
     delete _dynamicsWorld;
+    delete _solverPool;
     delete _ghostPairCallback;
 }
 
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
         _collisionConfig = new btDefaultCollisionConfiguration();
-        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+        int numSolvers = 1;
+#if BT_THREADSAFE
+        if (_isMultithreaded) {
+            // the scheduler is global to Bullet, it is set once for all the engines
+            if (!_taskScheduler) {
+                _taskScheduler.reset(new PhysicsTaskScheduler());
+                btSetTaskScheduler(_taskScheduler.get());
+            }
+            numSolvers = _taskScheduler->getNumThreads();
+        }
+#endif
+        if (numSolvers > 1) {
+            _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig, NARROWPHASE_GRAIN_SIZE);
+        } else {
+            _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+        }
         _broadphaseFilter = new btDbvtBroadphase();
-        _constraintSolver = new btSequentialImpulseConstraintSolver;
-        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+        _solverPool = new btConstraintSolverPoolMt(numSolvers);
+        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _solverPool, _collisionConfig);
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -128,7 +159,9 @@ void PhysicsEngine::addObjectToDynamicsWorld(ObjectMotionState* motionState) {
 
             // NOTE: Bullet will deactivate any object whose velocity is below these thresholds for longer than 2 seconds.
             // (the 2 seconds is determined by: static btRigidBody::gDeactivationTime
-            body->setSleepingThresholds(DYNAMIC_LINEAR_SPEED_THRESHOLD, DYNAMIC_ANGULAR_SPEED_THRESHOLD);
+            float sleepingThresholdScale = motionState->getSleepingThresholdScale();
+            body->setSleepingThresholds(sleepingThresholdScale * DYNAMIC_LINEAR_SPEED_THRESHOLD,
+                sleepingThresholdScale * DYNAMIC_ANGULAR_SPEED_THRESHOLD);
             if (!motionState->isMoving()) {
                 // try to initialize this object as inactive
                 body->forceActivationState(ISLAND_SLEEPING);
@@ -251,6 +284,8 @@ void PhysicsEngine::reinsertObject(ObjectMotionState* object) {
 }
 
 void PhysicsEngine::processTransaction(PhysicsEngine::Transaction& transaction) {
+    waitForStepSimulation();
+
     // removes
     for (auto object : transaction.objectsToRemove) {
         bumpAndPruneContacts(object);
@@ -331,6 +366,41 @@ void PhysicsEngine::stepSimulation() {
     }
 }
 
+void PhysicsEngine::startStepSimulation(std::function<void()> step) {
+    std::unique_lock<std::mutex> lock(_stepMutex);
+    if (!_stepThread.joinable()) {
+        _stepThread = std::thread([this] { runStepThread(); });
+    }
+    _stepCondition.wait(lock, [this] { return !_isStepping; });
+    _pendingStep = std::move(step);
+    _isStepping = true;
+    lock.unlock();
+    _stepCondition.notify_all();
+}
+
+void PhysicsEngine::waitForStepSimulation() const {
+    std::unique_lock<std::mutex> lock(_stepMutex);
+    _stepCondition.wait(lock, [this] { return !_isStepping; });
+}
+
+void PhysicsEngine::runStepThread() {
+    std::unique_lock<std::mutex> lock(_stepMutex);
+    while (true) {
+        _stepCondition.wait(lock, [this] { return _isStepping || _isStopping; });
+        if (_isStepping) {
+            auto step = std::move(_pendingStep);
+            lock.unlock();
+            step();
+            step = nullptr;
+            lock.lock();
+            _isStepping = false;
+            _stepCondition.notify_all();
+        } else {
+            break;
+        }
+    }
+}
+
 class CProfileOperator {
 public:
     CProfileOperator() {}
@@ -415,6 +485,12 @@ void PhysicsEngine::harvestPerformanceStats() {
             itr->Next();
         }
     }
+
+    // the Bullet profile only has the total of the substeps, how long each of them took shows when some steps cost more
+    const auto& substepTimes = _dynamicsWorld->getLastSubstepTimes();
+    for (size_t i = 0; i < substepTimes.size(); ++i) {
+        PerformanceTimer::addTimerRecord(QString("physics/substep%1").arg(i), substepTimes[i]);
+    }
 }
 
 void PhysicsEngine::printPerformanceStatsToFile(const QString& filename) {
@@ -486,7 +562,10 @@ void PhysicsEngine::updateContactMap() {
 
             ObjectMotionState* a = static_cast<ObjectMotionState*>(objectA->getUserPointer());
             ObjectMotionState* b = static_cast<ObjectMotionState*>(objectB->getUserPointer());
-            if (a || b) {
+            // a missing MotionState is MyAvatar, whose collisions are always reported, the contacts between objects
+            // that nobody listens to are left out of the map and never turn into events
+            bool wantsEvents = (!a || a->wantsCollisionEvents()) || (!b || b->wantsCollisionEvents());
+            if ((a || b) && wantsEvents) {
                 // the manifold has up to 4 distinct points, but only extract info from the first
                 _contactMap[ContactKey(a, b)].update(_numContactFrames, contactManifold->getContactPoint(0));
             }
@@ -689,6 +768,7 @@ void PhysicsEngine::bumpAndPruneContacts(ObjectMotionState* motionState) {
 }
 
 void PhysicsEngine::setCharacterController(CharacterController* character) {
+    waitForStepSimulation();
     _myAvatarController = character;
 }
 
@@ -907,6 +987,8 @@ protected:
 };
 
 std::vector<ContactTestResult> PhysicsEngine::contactTest(uint16_t mask, const ShapeInfo& regionShapeInfo, const Transform& regionTransform, uint16_t group, float threshold) const {
+    waitForStepSimulation();
+
     // TODO: Give MyAvatar a motion state so we don't have to do this
     btCollisionObject* myAvatarCollisionObject = nullptr;
     if ((mask & USER_COLLISION_GROUP_MY_AVATAR) && _myAvatarController) {
@@ -13,7 +13,11 @@
 #define hifi_PhysicsEngine_h
 
 #include <stdint.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <set>
+#include <thread>
 #include <vector>
 
 #include <QUuid>
@@ -31,6 +35,7 @@ const float HALF_SIMULATION_EXTENT = 512.0f; // meters
 
 class CharacterController;
 class PhysicsDebugDraw;
+class PhysicsTaskScheduler;
 
 // simple class for keeping track of contacts
 class ContactKey {
@@ -94,6 +99,11 @@ public:
 
     PhysicsEngine(const glm::vec3& offset);
     ~PhysicsEngine();
+
+    // whether the engines initialized from then on run their narrowphase and solve their islands on all threads
+    static void setMultithreaded(bool multithreaded) { _isMultithreaded = multithreaded; }
+    static bool isMultithreaded() { return _isMultithreaded; }
+
     void init();
 
     uint32_t getNumSubsteps() const;
@@ -109,6 +119,12 @@ public:
     void processTransaction(Transaction& transaction);
 
     void stepSimulation();
+
+    // Runs the step, which calls stepSimulation() within the locks it needs, on the physics thread while the caller
+    // goes on with its frame. Only one step is in flight at a time, the changes of a step are read after waiting for it
+    void startStepSimulation(std::function<void()> step);
+    void waitForStepSimulation() const;
+
     void harvestPerformanceStats();
     void printPerformanceStatsToFile(const QString& filename);
     void updateContactMap();
@@ -168,11 +184,13 @@ private:
 
     void doOwnershipInfection(const btCollisionObject* objectA, const btCollisionObject* objectB);
 
+    void runStepThread();
+
     btClock _clock;
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
-    btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolverPoolMt* _solverPool = NULL;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
@@ -194,6 +212,15 @@ private:
     bool _saveNextStats { false };
     bool _hasOutgoingChanges { false };
 
+    std::thread _stepThread;
+    mutable std::mutex _stepMutex;
+    mutable std::condition_variable _stepCondition;
+    std::function<void()> _pendingStep;
+    bool _isStepping { false };
+    bool _isStopping { false };
+
+    static bool _isMultithreaded;
+    static std::unique_ptr<PhysicsTaskScheduler> _taskScheduler;
 };
 
 typedef std::shared_ptr<PhysicsEngine> PhysicsEnginePointer;
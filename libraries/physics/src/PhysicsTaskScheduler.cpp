@@ -0,0 +1,45 @@
+//
+//  PhysicsTaskScheduler.cpp
+//  libraries/physics/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsTaskScheduler.h"
+
+#include <algorithm>
+#include <functional>
+
+#include <tbb/parallel_reduce.h>
+
+PhysicsTaskScheduler::PhysicsTaskScheduler() : btITaskScheduler("TBB") {
+    setNumThreads(tbb::this_task_arena::max_concurrency());
+}
+
+void PhysicsTaskScheduler::setNumThreads(int numThreads) {
+    _numThreads = std::max(1, std::min(numThreads, (int)BT_MAX_THREAD_COUNT));
+    _arena.terminate();
+    _arena.initialize(_numThreads);
+}
+
+void PhysicsTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) {
+    _arena.execute([&] {
+        tbb::parallel_for(tbb::blocked_range<int>(iBegin, iEnd, grainSize), [&](const tbb::blocked_range<int>& range) {
+            body.forLoop(range.begin(), range.end());
+        }, tbb::simple_partitioner());
+    });
+}
+
+btScalar PhysicsTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) {
+    btScalar sum = btScalar(0);
+    _arena.execute([&] {
+        sum = tbb::parallel_reduce(tbb::blocked_range<int>(iBegin, iEnd, grainSize), btScalar(0),
+            [&](const tbb::blocked_range<int>& range, btScalar partialSum) {
+                return partialSum + body.sumLoop(range.begin(), range.end());
+            }, std::plus<btScalar>(), tbb::simple_partitioner());
+    });
+    return sum;
+}
@@ -0,0 +1,37 @@
+//
+//  PhysicsTaskScheduler.h
+//  libraries/physics/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsTaskScheduler_h
+#define hifi_PhysicsTaskScheduler_h
+
+#include <LinearMath/btThreads.h>
+
+#include <TBBHelpers.h>
+#include <tbb/task_arena.h>
+
+// Runs the parallel loops of the multithreaded dynamics world on the TBB workers, the same ones the render jobs
+// spread their work over. The arena keeps the number of threads within what Bullet can index
+class PhysicsTaskScheduler : public btITaskScheduler {
+public:
+    PhysicsTaskScheduler();
+
+    int getMaxNumThreads() const override { return BT_MAX_THREAD_COUNT; }
+    int getNumThreads() const override { return _numThreads; }
+    void setNumThreads(int numThreads) override;
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+private:
+    int _numThreads { 1 };
+    tbb::task_arena _arena;
+};
+
+#endif // hifi_PhysicsTaskScheduler_h
@@ -11,11 +11,18 @@
 
 #include "ShapeFactory.h"
 
+#include <algorithm>
+
 #include <glm/gtx/norm.hpp>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
 
+#include <NumericalConstants.h>
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
+#include "PhysicsLogging.h"
 
 
 class StaticMeshShape : public btBvhTriangleMeshShape {
@@ -27,6 +34,13 @@ public:
         assert(_dataArray);
     }
 
+    // uses a BVH read back from the cache instead of building it, it lives in the buffer the shape now owns
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, btOptimizedBvh* bvh, void* bvhBuffer)
+    :   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _bvhBuffer(bvhBuffer) {
+        assert(_dataArray);
+        setOptimizedBvh(bvh);
+    }
+
     ~StaticMeshShape() {
         assert(_dataArray);
         IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
@@ -42,13 +56,133 @@ public:
         meshes.clear();
         delete _dataArray;
         _dataArray = nullptr;
+        if (_bvhBuffer) {
+            // the BVH was deserialized in place and doesn't own any memory of its own
+            btAlignedFree(_bvhBuffer);
+            _bvhBuffer = nullptr;
+        }
     }
 
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    void* _bvhBuffer { nullptr };
+};
+
+static QString _cacheDirectory;
+
+// bump when the layout of the cached BVHs or how the meshes are built changes
+static const uint32_t STATIC_MESH_CACHE_VERSION = 1;
+static const qint64 MAX_CACHE_SIZE = (qint64)MB_TO_BYTES(256);
+static const int BVH_ALIGNMENT = 16;
+
+class StaticMeshCacheHeader {
+public:
+    uint32_t version;
+    uint32_t bvhSize;
+    uint64_t hash;
+    int32_t numTriangles;
+    int32_t numVertices;
+    uint32_t scalarSize;
+    uint32_t padding;
 };
 
+static QString getCachePath(uint64_t hash) {
+    return _cacheDirectory + QString("%1.bvh").arg(hash, 16, 16, QChar('0'));
+}
+
+static const btIndexedMesh& getCachedMesh(btTriangleIndexVertexArray* dataArray) {
+    // createStaticMeshArray only ever makes one mesh
+    return dataArray->getIndexedMeshArray()[0];
+}
+
+static StaticMeshShape* loadCachedStaticMesh(uint64_t hash, btTriangleIndexVertexArray* dataArray) {
+    QFile file(getCachePath(hash));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    const btIndexedMesh& mesh = getCachedMesh(dataArray);
+    StaticMeshCacheHeader header;
+    if (file.read(reinterpret_cast<char*>(&header), sizeof(header)) != (qint64)sizeof(header) ||
+            header.version != STATIC_MESH_CACHE_VERSION || header.hash != hash ||
+            header.numTriangles != mesh.m_numTriangles || header.numVertices != mesh.m_numVertices ||
+            header.scalarSize != sizeof(btScalar) || file.size() != (qint64)(sizeof(header) + header.bvhSize)) {
+        return nullptr;
+    }
+
+    void* buffer = btAlignedAlloc(header.bvhSize, BVH_ALIGNMENT);
+    btOptimizedBvh* bvh = nullptr;
+    if (file.read(static_cast<char*>(buffer), header.bvhSize) == (qint64)header.bvhSize) {
+        bvh = btOptimizedBvh::deSerializeInPlace(buffer, header.bvhSize, false);
+    }
+    if (!bvh) {
+        btAlignedFree(buffer);
+        return nullptr;
+    }
+    return new StaticMeshShape(dataArray, bvh, buffer);
+}
+
+static void storeCachedStaticMesh(uint64_t hash, btTriangleIndexVertexArray* dataArray, StaticMeshShape* shape) {
+    const btOptimizedBvh* bvh = shape->getOptimizedBvh();
+    if (!bvh) {
+        return;
+    }
+    const btIndexedMesh& mesh = getCachedMesh(dataArray);
+    StaticMeshCacheHeader header;
+    header.version = STATIC_MESH_CACHE_VERSION;
+    header.bvhSize = bvh->calculateSerializeBufferSize();
+    header.hash = hash;
+    header.numTriangles = mesh.m_numTriangles;
+    header.numVertices = mesh.m_numVertices;
+    header.scalarSize = sizeof(btScalar);
+    header.padding = 0;
+
+    void* buffer = btAlignedAlloc(header.bvhSize, BVH_ALIGNMENT);
+    if (bvh->serializeInPlace(buffer, header.bvhSize, false)) {
+        // the file only shows up once it's complete, in case another session reads it at the same time
+        QSaveFile file(getCachePath(hash));
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(static_cast<const char*>(buffer), header.bvhSize);
+            file.commit();
+        }
+    }
+    btAlignedFree(buffer);
+}
+
+static const btCollisionShape* createStaticMeshShape(const ShapeInfo& info, btTriangleIndexVertexArray* dataArray) {
+    if (_cacheDirectory.isEmpty()) {
+        return new StaticMeshShape(dataArray);
+    }
+    uint64_t hash = info.getHash();
+    StaticMeshShape* shape = loadCachedStaticMesh(hash, dataArray);
+    if (!shape) {
+        shape = new StaticMeshShape(dataArray);
+        storeCachedStaticMesh(hash, dataArray, shape);
+    }
+    return shape;
+}
+
+void ShapeFactory::setCacheDirectory(const QString& directory) {
+    _cacheDirectory.clear();
+    if (directory.isEmpty() || !QDir().mkpath(directory)) {
+        return;
+    }
+    _cacheDirectory = QDir(directory).absolutePath() + "/";
+
+    // the cache only grows between sessions, the BVHs that were written last are kept
+    QDir cacheDir(_cacheDirectory);
+    QFileInfoList entries = cacheDir.entryInfoList({ "*.bvh" }, QDir::Files, QDir::Time);
+    qint64 cacheSize = 0;
+    for (const auto& entry : entries) {
+        cacheSize += entry.size();
+        if (cacheSize > MAX_CACHE_SIZE) {
+            QFile::remove(entry.absoluteFilePath());
+        }
+    }
+    qCDebug(physics) << "ShapeFactory: static mesh cache in" << _cacheDirectory << "holds" << std::min(cacheSize, MAX_CACHE_SIZE) << "bytes";
+}
+
 // the dataArray must be created before we create the StaticMeshShape
 
 // These are the same normalized directions used by the btShapeHull class.
@@ -431,7 +565,7 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         case SHAPE_TYPE_STATIC_MESH: {
             btTriangleIndexVertexArray* dataArray = createStaticMeshArray(info);
             if (dataArray) {
-                shape = new StaticMeshShape(dataArray);
+                shape = const_cast<btCollisionShape*>(createStaticMeshShape(info, dataArray));
             }
         }
         break;
@@ -15,7 +15,7 @@
 #include <btBulletDynamicsCommon.h>
 #include <glm/glm.hpp>
 #include <QObject>
-#include <QtCore/QRunnable>
+#include <QString>
 
 #include <ShapeInfo.h>
 
@@ -25,11 +25,15 @@ namespace ShapeFactory {
     const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
     void deleteShape(const btCollisionShape* shape);
 
-    class Worker : public QObject, public QRunnable {
+    // Where the BVHs of the static meshes are kept between sessions, keyed by the hash of their ShapeInfo.
+    // They take much longer to build than to read back. Set before any shape is built, not cached when empty
+    void setCacheDirectory(const QString& directory);
+
+    class Worker : public QObject {
         Q_OBJECT
     public:
         Worker(const ShapeInfo& info) : shapeInfo(info), shape(nullptr) {}
-        void run() override;
+        void run();
         ShapeInfo shapeInfo;
         const btCollisionShape* shape;
     signals:
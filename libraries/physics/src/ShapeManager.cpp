@@ -12,8 +12,7 @@
 #include "ShapeManager.h"
 
 #include <glm/gtx/norm.hpp>
-#include <QThreadPool>
-
+#include <JobSystem.h>
 #include <NumericalConstants.h>
 
 const int MAX_RING_SIZE = 256;
@@ -36,7 +35,11 @@ ShapeManager::~ShapeManager() {
     }
 }
 
-const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
+bool ShapeManager::canBuildOnWorker(ShapeType type) {
+    return type == SHAPE_TYPE_STATIC_MESH || type == SHAPE_TYPE_COMPOUND || type == SHAPE_TYPE_SIMPLE_COMPOUND;
+}
+
+const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info, bool buildOnWorker) {
     if (info.getType() == SHAPE_TYPE_NONE) {
         return nullptr;
     }
@@ -47,7 +50,7 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         return shapeRef->shape;
     }
     const btCollisionShape* shape = nullptr;
-    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+    if (info.getType() == SHAPE_TYPE_STATIC_MESH || (buildOnWorker && canBuildOnWorker(info.getType()))) {
         uint64_t hash = info.getHash();
 
         // bump the request count to the caller knows we're 
@@ -67,9 +70,10 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
                 _deadWorker = nullptr;
             }
             // we will delete worker manually later
-            worker->setAutoDelete(false);
             QObject::connect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
-            QThreadPool::globalInstance()->start(worker);
+            jobs::run([worker] {
+                worker->run();
+            });
         }
         // else we're still waiting for the shape to be created on another thread
     } else {
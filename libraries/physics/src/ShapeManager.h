@@ -55,8 +55,10 @@ public:
     ShapeManager();
     ~ShapeManager();
 
-    /// \return pointer to shape
-    const btCollisionShape* getShape(const ShapeInfo& info);
+    /// \return pointer to shape, or nullptr while it is built on a worker
+    /// static meshes are always built on a worker, compounds too when the caller waits for them like static meshes
+    const btCollisionShape* getShape(const ShapeInfo& info, bool buildOnWorker = false);
+    static bool canBuildOnWorker(ShapeType type);
     const btCollisionShape* getShapeByKey(uint64_t key);
     bool hasShapeWithKey(uint64_t key) const;
 
@@ -19,25 +19,30 @@
 #define hifi_ThreadSafeDynamicsWorld_h
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
-#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 
 #include "ObjectMotionState.h"
 
 #include <functional>
+#include <vector>
 
 using SubStepCallback = std::function<void()>;
 
-ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorld {
+// The islands are solved by the solvers of the pool, side by side when a task scheduler with more than one thread is set,
+// or one after the other on the calling thread like btDiscreteDynamicsWorld does
+ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorldMt {
 public:
     BT_DECLARE_ALIGNED_ALLOCATOR();
 
     ThreadSafeDynamicsWorld(
             btDispatcher* dispatcher,
             btBroadphaseInterface* pairCache,
-            btConstraintSolver* constraintSolver,
+            btConstraintSolverPoolMt* solverPool,
             btCollisionConfiguration* collisionConfiguration);
 
     int getNumSubsteps() const { return _numSubsteps; }
+    // in microseconds, how long each substep of the last step took
+    const std::vector<uint64_t>& getLastSubstepTimes() const { return _lastSubstepTimes; }
     int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps = 1,
                                           btScalar fixedTimeStep = btScalar(1.)/btScalar(60.),
                                           SubStepCallback onSubStep = []() { });
@@ -65,6 +70,7 @@ private:
     VectorOfMotionStates _deactivatedStates;
     SetOfMotionStates _activeStates;
     SetOfMotionStates _lastActiveStates;
+    std::vector<uint64_t> _lastSubstepTimes;
     int _numSubsteps { 0 };
 };
 
@@ -16,6 +16,17 @@ class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // true if every frame is encoded independently of the ones before it
+    virtual bool isStateless() const { return false; }
+
+    // makes this encoder continue from where another encoder of the same codec and format left off,
+    // returns false if the codec can't do that
+    virtual bool copyStateFrom(const Encoder& other) { return false; }
+
+    // trades the quality of the encoded frames, from 0 to 1, for their size and the time spent encoding them, and
+    // their robustness for the expected fraction of them that are lost, for the codecs that can
+    virtual void adapt(float quality, float expectedLoss) { }
 };
 
 class Decoder {
@@ -24,6 +35,9 @@ public:
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) = 0;
 
     virtual void lostFrame(QByteArray& decodedBuffer) = 0;
+
+    // conceals the frame lost just before the next one received, from the redundancy that one carries if the codec has any
+    virtual void recoverFrame(const QByteArray& nextEncodedBuffer, QByteArray& decodedBuffer) { lostFrame(decodedBuffer); }
 };
 
 class CodecPlugin : public Plugin {
@@ -91,17 +91,48 @@ int PluginManager::instantiate() {
     return std::count_if(loaders.begin(), loaders.end(), [](const auto& loader) { return (bool)loader->instance(); });
 }
 
- auto PluginManager::getLoadedPlugins() const -> const LoaderList& {
-    static std::once_flag once;
-    static LoaderList loadedPlugins;
-    std::call_once(once, [&] {
+static QString getPluginPath() {
 #if defined(Q_OS_ANDROID)
-        QString pluginPath = QCoreApplication::applicationDirPath() + "/";
+    return QCoreApplication::applicationDirPath() + "/";
 #elif defined(Q_OS_MAC)
-        QString pluginPath = QCoreApplication::applicationDirPath() + "/../PlugIns/";
+    return QCoreApplication::applicationDirPath() + "/../PlugIns/";
 #else
-        QString pluginPath = QCoreApplication::applicationDirPath() + "/plugins/";
+    return QCoreApplication::applicationDirPath() + "/plugins/";
 #endif
+}
+
+bool PluginManager::isCodecPlugin(const QJsonObject& metaData) {
+    QJsonValue nameValue = metaData["MetaData"]["name"];
+    return nameValue.toString().contains("codec", Qt::CaseInsensitive);
+}
+
+void PluginManager::preloadPluginLibraries(PluginFilter pluginFilter) {
+    // the libraries stay loaded for as long as a loader that loaded them is around
+    static LoaderList preloadedPlugins;
+
+    QString pluginPath = getPluginPath();
+    QDir pluginDir(pluginPath);
+    pluginDir.setFilter(QDir::Files);
+    for (auto plugin : pluginDir.entryList()) {
+        QSharedPointer<QPluginLoader> loader(new QPluginLoader(pluginPath + plugin));
+        const QJsonObject pluginMetaData = loader->metaData();
+        if (pluginMetaData.isEmpty() || isDisabled(pluginMetaData) || !pluginFilter(pluginMetaData)
+            || getPluginInterfaceVersionFromMetaData(pluginMetaData) != HIFI_PLUGIN_INTERFACE_VERSION) {
+            continue;
+        }
+
+        if (loader->load()) {
+            qCDebug(plugins) << "Plugin" << qPrintable(plugin) << "preloaded";
+            preloadedPlugins.push_back(loader);
+        }
+    }
+}
+
+ auto PluginManager::getLoadedPlugins() const -> const LoaderList& {
+    static std::once_flag once;
+    static LoaderList loadedPlugins;
+    std::call_once(once, [&] {
+        QString pluginPath = getPluginPath();
         QDir pluginDir(pluginPath);
         pluginDir.setSorting(QDir::Name);
         pluginDir.setFilter(QDir::Files);
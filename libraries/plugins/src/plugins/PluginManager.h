@@ -51,6 +51,14 @@ public:
 
     using PluginFilter = std::function<bool(const QJsonObject&)>;
     void setPluginFilter(PluginFilter pluginFilter) { _pluginFilter = pluginFilter; }
+
+    // for now assume codec plugins have 'codec' in their name
+    static bool isCodecPlugin(const QJsonObject& metaData);
+
+    // maps the libraries of the plugins that pass the filter into memory, without instantiating them, so that a
+    // PluginManager loading them later doesn't have to wait on it
+    static void preloadPluginLibraries(PluginFilter pluginFilter);
+
     Q_INVOKABLE DisplayPluginList getAllDisplayPlugins();
 
 signals:
@@ -28,6 +28,40 @@
 
 Q_LOGGING_CATEGORY(proceduralLog, "hifi.gpu.procedural")
 
+// The programs are shared by all the procedurals built from the same sources, with the same shaders, version and uniforms,
+// so that the entities using the same procedural shader only compile it once
+static std::mutex programCacheMutex;
+static std::unordered_map<std::string, std::weak_ptr<gpu::Shader>> programCache;
+
+static std::string getProgramCacheKey(const gpu::Shader::Source& vertexSource, const gpu::Shader::Source& fragmentSource,
+        uint8_t version, const QString& vertexShaderSource, const QString& fragmentShaderSource, const QJsonObject& uniforms) {
+    std::string key = std::to_string(vertexSource.id) + ":" + std::to_string(fragmentSource.id) + ":" + std::to_string(version);
+    // the uniform slots follow the order of their names
+    for (const auto& name : uniforms.keys()) {
+        key += ":" + name.toStdString();
+    }
+    key += "\n" + vertexShaderSource.toStdString() + "\n" + fragmentShaderSource.toStdString();
+    return key;
+}
+
+static gpu::ShaderPointer findCachedProgram(const std::string& key) {
+    std::lock_guard<std::mutex> lock(programCacheMutex);
+    auto it = programCache.find(key);
+    return it != programCache.end() ? it->second.lock() : gpu::ShaderPointer();
+}
+
+static void cacheProgram(const std::string& key, const gpu::ShaderPointer& program) {
+    std::lock_guard<std::mutex> lock(programCacheMutex);
+    for (auto it = programCache.begin(); it != programCache.end();) {
+        if (it->second.expired()) {
+            it = programCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    programCache[key] = program;
+}
+
 // User-data parsing constants
 static const QString PROCEDURAL_USER_DATA_KEY = "ProceduralEntity";
 static const QString VERTEX_URL_KEY = "vertexShaderURL";
@@ -325,55 +359,61 @@ void Procedural::prepare(gpu::Batch& batch,
 
         gpu::Shader::Source& fragmentSource = (key.isTransparent() && _transparentFragmentSource.valid()) ? _transparentFragmentSource : _opaqueFragmentSource;
 
-        // Build the fragment and vertex shaders
-        auto versionDefine = "#define PROCEDURAL_V" + std::to_string(_data.version);
-        fragmentSource.replacements.clear();
-        fragmentSource.replacements[PROCEDURAL_VERSION] = versionDefine;
-        if (!_fragmentShaderSource.isEmpty()) {
-            fragmentSource.replacements[PROCEDURAL_BLOCK] = _fragmentShaderSource.toStdString();
-        }
-        vertexSource.replacements.clear();
-        vertexSource.replacements[PROCEDURAL_VERSION] = versionDefine;
-        if (!_vertexShaderSource.isEmpty()) {
-            vertexSource.replacements[PROCEDURAL_BLOCK] = _vertexShaderSource.toStdString();
-        }
-
-        // Set any userdata specified uniforms (if any)
-        if (!_data.uniforms.empty()) {
-            // First grab all the possible dialect/variant/reflections
-            std::vector<shader::Reflection*> allFragmentReflections;
-            for (auto dialectIt = fragmentSource.dialectSources.begin(); dialectIt != fragmentSource.dialectSources.end(); ++dialectIt) {
-                for (auto variantIt = (*dialectIt).second.variantSources.begin(); variantIt != (*dialectIt).second.variantSources.end(); ++variantIt) {
-                    allFragmentReflections.push_back(&(*variantIt).second.reflection);
-                }
+        std::string programKey = getProgramCacheKey(vertexSource, fragmentSource, _data.version, _vertexShaderSource,
+            _fragmentShaderSource, _data.uniforms);
+        gpu::ShaderPointer program = findCachedProgram(programKey);
+        if (!program) {
+            // Build the fragment and vertex shaders
+            auto versionDefine = "#define PROCEDURAL_V" + std::to_string(_data.version);
+            fragmentSource.replacements.clear();
+            fragmentSource.replacements[PROCEDURAL_VERSION] = versionDefine;
+            if (!_fragmentShaderSource.isEmpty()) {
+                fragmentSource.replacements[PROCEDURAL_BLOCK] = _fragmentShaderSource.toStdString();
             }
-            std::vector<shader::Reflection*> allVertexReflections;
-            for (auto dialectIt = vertexSource.dialectSources.begin(); dialectIt != vertexSource.dialectSources.end(); ++dialectIt) {
-                for (auto variantIt = (*dialectIt).second.variantSources.begin(); variantIt != (*dialectIt).second.variantSources.end(); ++variantIt) {
-                    allVertexReflections.push_back(&(*variantIt).second.reflection);
-                }
+            vertexSource.replacements.clear();
+            vertexSource.replacements[PROCEDURAL_VERSION] = versionDefine;
+            if (!_vertexShaderSource.isEmpty()) {
+                vertexSource.replacements[PROCEDURAL_BLOCK] = _vertexShaderSource.toStdString();
             }
-            // Then fill in every reflections the new custom bindings
-            int customSlot = procedural::slot::uniform::Custom;
-            for (const auto& key : _data.uniforms.keys()) {
-                std::string uniformName = key.toLocal8Bit().data();
-                for (auto reflection : allFragmentReflections) {
-                    reflection->uniforms[uniformName] = customSlot;
+
+            // Set any userdata specified uniforms (if any)
+            if (!_data.uniforms.empty()) {
+                // First grab all the possible dialect/variant/reflections
+                std::vector<shader::Reflection*> allFragmentReflections;
+                for (auto dialectIt = fragmentSource.dialectSources.begin(); dialectIt != fragmentSource.dialectSources.end(); ++dialectIt) {
+                    for (auto variantIt = (*dialectIt).second.variantSources.begin(); variantIt != (*dialectIt).second.variantSources.end(); ++variantIt) {
+                        allFragmentReflections.push_back(&(*variantIt).second.reflection);
+                    }
+                }
+                std::vector<shader::Reflection*> allVertexReflections;
+                for (auto dialectIt = vertexSource.dialectSources.begin(); dialectIt != vertexSource.dialectSources.end(); ++dialectIt) {
+                    for (auto variantIt = (*dialectIt).second.variantSources.begin(); variantIt != (*dialectIt).second.variantSources.end(); ++variantIt) {
+                        allVertexReflections.push_back(&(*variantIt).second.reflection);
+                    }
                 }
-                for (auto reflection : allVertexReflections) {
-                    reflection->uniforms[uniformName] = customSlot;
+                // Then fill in every reflections the new custom bindings
+                int customSlot = procedural::slot::uniform::Custom;
+                for (const auto& key : _data.uniforms.keys()) {
+                    std::string uniformName = key.toLocal8Bit().data();
+                    for (auto reflection : allFragmentReflections) {
+                        reflection->uniforms[uniformName] = customSlot;
+                    }
+                    for (auto reflection : allVertexReflections) {
+                        reflection->uniforms[uniformName] = customSlot;
+                    }
+                    ++customSlot;
                 }
-                ++customSlot;
             }
-        }
 
-        // Leave this here for debugging
-        //qCDebug(proceduralLog) << "FragmentShader:\n" << fragmentSource.getSource(shader::Dialect::glsl450, shader::Variant::Mono).c_str();
-        //qCDebug(proceduralLog) << "VertexShader:\n" << vertexSource.getSource(shader::Dialect::glsl450, shader::Variant::Mono).c_str();
+            // Leave this here for debugging
+            //qCDebug(proceduralLog) << "FragmentShader:\n" << fragmentSource.getSource(shader::Dialect::glsl450, shader::Variant::Mono).c_str();
+            //qCDebug(proceduralLog) << "VertexShader:\n" << vertexSource.getSource(shader::Dialect::glsl450, shader::Variant::Mono).c_str();
 
-        gpu::ShaderPointer vertexShader = gpu::Shader::createVertex(vertexSource);
-        gpu::ShaderPointer fragmentShader = gpu::Shader::createPixel(fragmentSource);
-        gpu::ShaderPointer program = gpu::Shader::createProgram(vertexShader, fragmentShader);
+            gpu::ShaderPointer vertexShader = gpu::Shader::createVertex(vertexSource);
+            gpu::ShaderPointer fragmentShader = gpu::Shader::createPixel(fragmentSource);
+            program = gpu::Shader::createProgram(vertexShader, fragmentShader);
+            cacheProgram(programKey, program);
+        }
 
         _proceduralPipelines[key] = gpu::Pipeline::create(program, key.isTransparent() ? _transparentState : _opaqueState);
 
@@ -396,9 +436,23 @@ void Procedural::prepare(gpu::Batch& batch,
     _prevKey = key;
     _shaderDirty = _uniformsDirty = false;
 
-    for (auto lambda : _uniforms) {
-        lambda(batch);
+    for (const auto& uniform : _customUniforms) {
+        switch (uniform.numComponents) {
+            case 1:
+                batch._glUniform1f(uniform.slot, uniform.value.x);
+                break;
+            case 2:
+                batch._glUniform2f(uniform.slot, uniform.value.x, uniform.value.y);
+                break;
+            case 3:
+                batch._glUniform3f(uniform.slot, uniform.value.x, uniform.value.y, uniform.value.z);
+                break;
+            default:
+                batch._glUniform4f(uniform.slot, uniform.value.x, uniform.value.y, uniform.value.z, uniform.value.w);
+                break;
+        }
     }
+    updateStandardInputs(batch);
 
     static gpu::Sampler sampler;
     static std::once_flag once;
@@ -420,97 +474,66 @@ void Procedural::prepare(gpu::Batch& batch,
 
 
 void Procedural::setupUniforms() {
-    _uniforms.clear();
+    _customUniforms.clear();
     // Set any userdata specified uniforms
     int slot = procedural::slot::uniform::Custom;
     for (const auto& key : _data.uniforms.keys()) {
-        std::string uniformName = key.toLocal8Bit().data();
         QJsonValue value = _data.uniforms[key];
+        CustomUniform uniform { slot, 0, glm::vec4(0.0f) };
         if (value.isDouble()) {
-            float v = value.toDouble();
-            _uniforms.push_back([slot, v](gpu::Batch& batch) { batch._glUniform1f(slot, v); });
+            uniform.numComponents = 1;
+            uniform.value.x = value.toDouble();
         } else if (value.isArray()) {
             auto valueArray = value.toArray();
-            switch (valueArray.size()) {
-            case 0:
-                break;
-
-            case 1: {
-                float v = valueArray[0].toDouble();
-                _uniforms.push_back([slot, v](gpu::Batch& batch) { batch._glUniform1f(slot, v); });
-                break;
-            }
-
-            case 2: {
-                glm::vec2 v{ valueArray[0].toDouble(), valueArray[1].toDouble() };
-                _uniforms.push_back([slot, v](gpu::Batch& batch) { batch._glUniform2f(slot, v.x, v.y); });
-                break;
-            }
-
-            case 3: {
-                glm::vec3 v{
-                    valueArray[0].toDouble(),
-                    valueArray[1].toDouble(),
-                    valueArray[2].toDouble(),
-                };
-                _uniforms.push_back([slot, v](gpu::Batch& batch) { batch._glUniform3f(slot, v.x, v.y, v.z); });
-                break;
-            }
-
-            default:
-            case 4: {
-                glm::vec4 v{
-                    valueArray[0].toDouble(),
-                    valueArray[1].toDouble(),
-                    valueArray[2].toDouble(),
-                    valueArray[3].toDouble(),
-                };
-                _uniforms.push_back([slot, v](gpu::Batch& batch) { batch._glUniform4f(slot, v.x, v.y, v.z, v.w); });
-                break;
-            }
+            uniform.numComponents = std::min(valueArray.size(), 4);
+            for (int i = 0; i < uniform.numComponents; i++) {
+                uniform.value[i] = valueArray[i].toDouble();
             }
         }
+        if (uniform.numComponents > 0) {
+            _customUniforms.push_back(uniform);
+        }
         slot++;
     }
+}
 
-    _uniforms.push_back([this](gpu::Batch& batch) {
-        _standardInputs.position = vec4(_entityPosition, 1.0f);
-        // Minimize floating point error by doing an integer division to milliseconds, before the floating point division to seconds
-        auto now = usecTimestampNow();
-        _standardInputs.timeSinceLastCompile = (float)((now - _lastCompile) / USECS_PER_MSEC) / MSECS_PER_SECOND;
-        _standardInputs.timeSinceFirstCompile = (float)((now - _firstCompile) / USECS_PER_MSEC) / MSECS_PER_SECOND;
-        _standardInputs.timeSinceEntityCreation = (float)((now - _entityCreated) / USECS_PER_MSEC) / MSECS_PER_SECOND;
-
-
-        // Date
-        {
-            QDateTime now = QDateTime::currentDateTimeUtc();
-            QDate date = now.date();
-            QTime time = now.time();
-            _standardInputs.date.x = date.year();
-            // Shadertoy month is 0 based
-            _standardInputs.date.y = date.month() - 1;
-            // But not the day... go figure
-            _standardInputs.date.z = date.day();
-            float fractSeconds = (time.msec() / 1000.0f);
-            _standardInputs.date.w = (time.hour() * 3600) + (time.minute() * 60) + time.second() + fractSeconds;
-        }
+void Procedural::updateStandardInputs(gpu::Batch& batch) {
+    _standardInputs.position = vec4(_entityPosition, 1.0f);
+    // Minimize floating point error by doing an integer division to milliseconds, before the floating point division to seconds
+    auto now = usecTimestampNow();
+    _standardInputs.timeSinceLastCompile = (float)((now - _lastCompile) / USECS_PER_MSEC) / MSECS_PER_SECOND;
+    _standardInputs.timeSinceFirstCompile = (float)((now - _firstCompile) / USECS_PER_MSEC) / MSECS_PER_SECOND;
+    _standardInputs.timeSinceEntityCreation = (float)((now - _entityCreated) / USECS_PER_MSEC) / MSECS_PER_SECOND;
 
-        _standardInputs.scale = vec4(_entityDimensions, 1.0f);
-        _standardInputs.frameCount = ++_frameCount;
-        _standardInputs.orientation = mat4(_entityOrientation);
 
-        for (size_t i = 0; i < MAX_PROCEDURAL_TEXTURE_CHANNELS; ++i) {
-            if (_channels[i]) {
-                _standardInputs.resolution[i] = vec4(_channels[i]->getWidth(), _channels[i]->getHeight(), 1.0f, 1.0f);
-            } else {
-                _standardInputs.resolution[i] = vec4(1.0f);
-            }
+    // Date
+    {
+        QDateTime now = QDateTime::currentDateTimeUtc();
+        QDate date = now.date();
+        QTime time = now.time();
+        _standardInputs.date.x = date.year();
+        // Shadertoy month is 0 based
+        _standardInputs.date.y = date.month() - 1;
+        // But not the day... go figure
+        _standardInputs.date.z = date.day();
+        float fractSeconds = (time.msec() / 1000.0f);
+        _standardInputs.date.w = (time.hour() * 3600) + (time.minute() * 60) + time.second() + fractSeconds;
+    }
+
+    _standardInputs.scale = vec4(_entityDimensions, 1.0f);
+    _standardInputs.frameCount = ++_frameCount;
+    _standardInputs.orientation = mat4(_entityOrientation);
+
+    for (size_t i = 0; i < MAX_PROCEDURAL_TEXTURE_CHANNELS; ++i) {
+        if (_channels[i]) {
+            _standardInputs.resolution[i] = vec4(_channels[i]->getWidth(), _channels[i]->getHeight(), 1.0f, 1.0f);
+        } else {
+            _standardInputs.resolution[i] = vec4(1.0f);
         }
+    }
 
-        _standardInputsBuffer->setSubData(0, _standardInputs);
-        batch.setUniformBuffer(procedural::slot::buffer::Inputs, _standardInputsBuffer, 0, sizeof(StandardInputs));
-    });
+    _standardInputsBuffer->setSubData(0, _standardInputs);
+    batch.setUniformBuffer(procedural::slot::buffer::Inputs, _standardInputsBuffer, 0, sizeof(StandardInputs));
 }
 
 glm::vec4 Procedural::getColor(const glm::vec4& entityColor) const {
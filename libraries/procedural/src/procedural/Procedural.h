@@ -23,7 +23,6 @@
 #include <material-networking/TextureCache.h>
 #include "ProceduralMaterialCache.h"
 
-using UniformLambdas = std::list<std::function<void(gpu::Batch& batch)>>;
 const size_t MAX_PROCEDURAL_TEXTURE_CHANNELS{ 4 };
 
 /**jsdoc
@@ -177,7 +176,13 @@ protected:
     bool _uniformsDirty { true };
 
     // Rendering objects
-    UniformLambdas _uniforms;
+    // the custom uniforms, unpacked from the user data once when it changes rather than every frame
+    struct CustomUniform {
+        int slot;
+        int numComponents;
+        glm::vec4 value;
+    };
+    std::vector<CustomUniform> _customUniforms;
     NetworkTexturePointer _channels[MAX_PROCEDURAL_TEXTURE_CHANNELS];
 
     std::unordered_map<ProceduralProgramKey, gpu::PipelinePointer> _proceduralPipelines;
@@ -193,6 +198,7 @@ protected:
 
 private:
     void setupUniforms();
+    void updateStandardInputs(gpu::Batch& batch);
 
     mutable uint64_t _fadeStartTime { 0 };
     mutable bool _hasStartedFade { false };
@@ -27,6 +27,8 @@ NetworkClipLoader::NetworkClipLoader(const QUrl& url) :
 }
 
 void NetworkClip::init(const QByteArray& clipData) {
+    Locker lock(_mutex);
+    stopPrefetching();
     _clipData = clipData;
     PointerClip::init((uchar*)_clipData.data(), _clipData.size());
 }
@@ -74,7 +74,12 @@ PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size)
     return results;
 }
 
+PointerClip::~PointerClip() {
+    stopPrefetching();
+}
+
 void PointerClip::reset() {
+    stopPrefetching();
     _frames.clear();
     _data = nullptr;
     _size = 0;
@@ -136,24 +141,90 @@ void PointerClip::init(uchar* data, size_t size) {
 
 }
 
+FramePointer PointerClip::decodeFrame(size_t frameIndex) const {
+    auto result = std::make_shared<Frame>();
+    const auto& header = _frames[frameIndex];
+    result->type = header.type;
+    result->timeOffset = header.timeOffset;
+    if (header.size) {
+        result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
+        if (_compressed) {
+            result->data = qUncompress(result->data);
+        }
+    }
+    return result;
+}
+
 // Internal only function, needs no locking
 FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
-    FramePointer result;
-    if (frameIndex < _frames.size()) {
-        result = std::make_shared<Frame>();
-        const auto& header = _frames[frameIndex];
-        result->type = header.type;
-        result->timeOffset = header.timeOffset;
-        if (header.size) {
-            result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
-            if (_compressed) {
-                result->data = qUncompress(result->data);
-            }
+    if (frameIndex >= _frames.size()) {
+        return FrameConstPointer();
+    }
+    if (!_compressed) {
+        return decodeFrame(frameIndex);
+    }
+
+    FrameConstPointer result;
+    {
+        std::lock_guard<std::mutex> lock(_prefetchMutex);
+        // drop the frames behind the playhead, and all of them after a seek
+        _prefetchedFrames.erase(_prefetchedFrames.begin(), _prefetchedFrames.lower_bound(frameIndex));
+        _prefetchedFrames.erase(_prefetchedFrames.lower_bound(frameIndex + PREFETCH_FRAME_COUNT), _prefetchedFrames.end());
+        auto itr = _prefetchedFrames.find(frameIndex);
+        if (itr != _prefetchedFrames.end()) {
+            result = itr->second;
+        }
+        _prefetchIndex = frameIndex;
+        if (!_prefetchThread.joinable()) {
+            _prefetchThread = std::thread([this] { prefetchFrames(); });
         }
     }
+    _prefetchCondition.notify_one();
+
+    if (!result) {
+        result = decodeFrame(frameIndex);
+    }
     return result;
 }
 
+void PointerClip::prefetchFrames() const {
+    std::unique_lock<std::mutex> lock(_prefetchMutex);
+    while (!_stopPrefetching) {
+        size_t endIndex = std::min(_prefetchIndex + PREFETCH_FRAME_COUNT, _frames.size());
+        size_t frameIndex = _prefetchIndex;
+        while (frameIndex < endIndex && _prefetchedFrames.count(frameIndex)) {
+            ++frameIndex;
+        }
+        if (frameIndex >= endIndex) {
+            _prefetchCondition.wait(lock);
+            continue;
+        }
+
+        lock.unlock();
+        FrameConstPointer frame = decodeFrame(frameIndex);
+        lock.lock();
+
+        // the playhead may have moved on in the meantime
+        if (frameIndex >= _prefetchIndex && frameIndex < _prefetchIndex + PREFETCH_FRAME_COUNT) {
+            _prefetchedFrames[frameIndex] = frame;
+        }
+    }
+}
+
+void PointerClip::stopPrefetching() {
+    {
+        std::lock_guard<std::mutex> lock(_prefetchMutex);
+        _stopPrefetching = true;
+    }
+    _prefetchCondition.notify_all();
+    if (_prefetchThread.joinable()) {
+        _prefetchThread.join();
+    }
+    std::lock_guard<std::mutex> lock(_prefetchMutex);
+    _prefetchedFrames.clear();
+    _stopPrefetching = false;
+}
+
 void PointerClip::addFrame(FrameConstPointer) {
     throw std::runtime_error("Pointer clips are read only, use duplicate to create a read/write clip");
 }
@@ -12,7 +12,10 @@
 
 #include "ArrayClip.h"
 
+#include <condition_variable>
+#include <map>
 #include <mutex>
+#include <thread>
 
 #include <QtCore/QJsonDocument>
 
@@ -35,6 +38,7 @@ public:
 
     PointerClip() {};
     PointerClip(uchar* data, size_t size) { init(data, size); }
+    virtual ~PointerClip();
 
     void init(uchar* data, size_t size);
     virtual void addFrame(FrameConstPointer) override;
@@ -44,13 +48,32 @@ public:
 
     // FIXME move to frame?
     static const qint64 MINIMUM_FRAME_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
+    // the compressed frames ahead of the last one read are decompressed on a thread of their own
+    static const size_t PREFETCH_FRAME_COUNT = 64;
+
 protected:
     void reset() override;
     virtual FrameConstPointer readFrame(size_t index) const override;
+
+    // stops the decompression of the frames ahead, the subclasses that own the data call it before they release it
+    void stopPrefetching();
+
     QJsonDocument _header;
     uchar* _data { nullptr };
     size_t _size { 0 };
     bool _compressed { true };
+
+private:
+    FramePointer decodeFrame(size_t frameIndex) const;
+    void prefetchFrames() const;
+
+    mutable std::mutex _prefetchMutex;
+    mutable std::condition_variable _prefetchCondition;
+    mutable std::thread _prefetchThread;
+    // the decompressed frames, from the last one read up to PREFETCH_FRAME_COUNT ahead
+    mutable std::map<size_t, FrameConstPointer> _prefetchedFrames;
+    mutable size_t _prefetchIndex { 0 };
+    bool _stopPrefetching { false };
 };
 
 }
@@ -828,7 +828,7 @@ void AmbientOcclusionEffect::run(const render::RenderContextPointer& renderConte
 
     // Update the timer
     auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
-    config->setGPUBatchRunTime(_gpuTimer->getGPUAverage(), _gpuTimer->getBatchAverage());
+    config->setGPUBatchRunTime(*_gpuTimer);
 }
 
 DebugAmbientOcclusion::DebugAmbientOcclusion() {
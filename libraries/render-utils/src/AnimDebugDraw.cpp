@@ -9,6 +9,8 @@
 
 #include "AnimDebugDraw.h"
 
+#include <numeric>
+
 #include <qmath.h>
 #include <gpu/Batch.h>
 #include <GLMHelpers.h>
@@ -424,10 +426,10 @@ void AnimDebugDraw::update() {
 
         data._isVisible = (numVerts > 0);
 
+        std::vector<uint32_t> indices(numVerts);
+        std::iota(indices.begin(), indices.end(), 0);
         data._indexBuffer->resize(sizeof(uint32_t) * numVerts);
-        for (int i = 0; i < numVerts; i++) {
-            data._indexBuffer->setSubData<uint32_t>(i, (uint32_t)i);
-        }
+        data._indexBuffer->setSubData<uint32_t>(0, indices);
     });
     scene->enqueueTransaction(transaction);
 }
@@ -576,7 +576,7 @@ void RenderDeferred::run(const RenderContextPointer& renderContext, const Inputs
      args->_batch = previousBatch;
 
     auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
-    config->setGPUBatchRunTime(_gpuTimer->getGPUAverage(), _gpuTimer->getBatchAverage());
+    config->setGPUBatchRunTime(*_gpuTimer);
 }
 
 void DefaultLightingSetup::run(const RenderContextPointer& renderContext) {
@@ -955,6 +955,15 @@ void GeometryCache::renderGrid(gpu::Batch& batch, const glm::vec2& minCorner, co
     renderQuad(batch, minCorner, maxCorner, MIN_TEX_COORD, MAX_TEX_COORD, color, id);
 }
 
+// the registered geometry that changes refills the buffers it already has, which keep their storage from one update to the next
+static gpu::BufferPointer refillBuffer(const gpu::BufferPointer& buffer) {
+    if (!buffer) {
+        return std::make_shared<gpu::Buffer>();
+    }
+    buffer->resize(0);
+    return buffer;
+}
+
 void GeometryCache::updateVertices(int id, const QVector<glm::vec2>& points, const QVector<glm::vec4>& colors) {
     BatchItemDetails& details = _registeredVertices[id];
 
@@ -972,8 +981,8 @@ void GeometryCache::updateVertices(int id, const QVector<glm::vec2>& points, con
     details.vertices = points.size();
     details.vertexSize = FLOATS_PER_VERTEX;
 
-    auto verticesBuffer = std::make_shared<gpu::Buffer>();
-    auto colorBuffer = std::make_shared<gpu::Buffer>();
+    auto verticesBuffer = refillBuffer(details.verticesBuffer);
+    auto colorBuffer = refillBuffer(details.colorBuffer);
     auto streamFormat = std::make_shared<gpu::Stream::Format>();
     auto stream = std::make_shared<gpu::BufferStream>();
 
@@ -1049,8 +1058,8 @@ void GeometryCache::updateVertices(int id, const QVector<glm::vec3>& points, con
     details.vertices = points.size();
     details.vertexSize = FLOATS_PER_VERTEX;
 
-    auto verticesBuffer = std::make_shared<gpu::Buffer>();
-    auto colorBuffer = std::make_shared<gpu::Buffer>();
+    auto verticesBuffer = refillBuffer(details.verticesBuffer);
+    auto colorBuffer = refillBuffer(details.colorBuffer);
     auto streamFormat = std::make_shared<gpu::Stream::Format>();
     auto stream = std::make_shared<gpu::BufferStream>();
 
@@ -1131,8 +1140,8 @@ void GeometryCache::updateVertices(int id, const QVector<glm::vec3>& points, con
     details.vertices = points.size();
     details.vertexSize = FLOATS_PER_VERTEX;
 
-    auto verticesBuffer = std::make_shared<gpu::Buffer>();
-    auto colorBuffer = std::make_shared<gpu::Buffer>();
+    auto verticesBuffer = refillBuffer(details.verticesBuffer);
+    auto colorBuffer = refillBuffer(details.colorBuffer);
     auto streamFormat = std::make_shared<gpu::Stream::Format>();
     auto stream = std::make_shared<gpu::BufferStream>();
 
@@ -1231,8 +1240,8 @@ void GeometryCache::renderBevelCornersRect(gpu::Batch& batch, int x, int y, int
         details.vertices = NUM_VERTICES;
         details.vertexSize = FLOATS_PER_VERTEX;
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
+        auto verticesBuffer = refillBuffer(details.verticesBuffer);
+        auto colorBuffer = refillBuffer(details.colorBuffer);
         auto streamFormat = std::make_shared<gpu::Stream::Format>();
         auto stream = std::make_shared<gpu::BufferStream>();
 
@@ -1335,8 +1344,8 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, co
         details.vertices = VERTICES;
         details.vertexSize = FLOATS_PER_VERTEX;
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
+        auto verticesBuffer = refillBuffer(details.verticesBuffer);
+        auto colorBuffer = refillBuffer(details.colorBuffer);
         auto streamFormat = std::make_shared<gpu::Stream::Format>();
         auto stream = std::make_shared<gpu::BufferStream>();
 
@@ -1424,8 +1433,8 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, co
         details.vertices = VERTICES;
         details.vertexSize = FLOATS_PER_VERTEX;
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
+        auto verticesBuffer = refillBuffer(details.verticesBuffer);
+        auto colorBuffer = refillBuffer(details.colorBuffer);
 
         auto streamFormat = std::make_shared<gpu::Stream::Format>();
         auto stream = std::make_shared<gpu::BufferStream>();
@@ -1504,8 +1513,8 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& minCorner, co
         details.vertices = VERTICES;
         details.vertexSize = FLOATS_PER_VERTEX;
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
+        auto verticesBuffer = refillBuffer(details.verticesBuffer);
+        auto colorBuffer = refillBuffer(details.colorBuffer);
 
         auto streamFormat = std::make_shared<gpu::Stream::Format>();
         auto stream = std::make_shared<gpu::BufferStream>();
@@ -1603,8 +1612,8 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& topLeft, cons
         details.vertices = VERTICES;
         details.vertexSize = FLOATS_PER_VERTEX; // NOTE: this isn't used for BatchItemDetails maybe we can get rid of it
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
+        auto verticesBuffer = refillBuffer(details.verticesBuffer);
+        auto colorBuffer = refillBuffer(details.colorBuffer);
         auto streamFormat = std::make_shared<gpu::Stream::Format>();
         auto stream = std::make_shared<gpu::BufferStream>();
 
@@ -1688,8 +1697,8 @@ void GeometryCache::renderDashedLine(gpu::Batch& batch, const glm::vec3& start,
         details.vertexSize = FLOATS_PER_VERTEX;
         details.isCreated = true;
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
+        auto verticesBuffer = refillBuffer(details.verticesBuffer);
+        auto colorBuffer = refillBuffer(details.colorBuffer);
         auto streamFormat = std::make_shared<gpu::Stream::Format>();
         auto stream = std::make_shared<gpu::BufferStream>();
 
@@ -1809,8 +1818,7 @@ GeometryCache::BatchItemDetails::~BatchItemDetails() {
 void GeometryCache::BatchItemDetails::clear() {
     isCreated = false;
     uniformBuffer.reset();
-    verticesBuffer.reset();
-    colorBuffer.reset();
+    // the vertices and colors buffers are kept to be refilled by the next update
     streamFormat.reset();
     stream.reset();
 }
@@ -1861,8 +1869,8 @@ void GeometryCache::renderLine(gpu::Batch& batch, const glm::vec3& p1, const glm
         details.vertices = vertices;
         details.vertexSize = FLOATS_PER_VERTEX;
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
+        auto verticesBuffer = refillBuffer(details.verticesBuffer);
+        auto colorBuffer = refillBuffer(details.colorBuffer);
         auto streamFormat = std::make_shared<gpu::Stream::Format>();
         auto stream = std::make_shared<gpu::BufferStream>();
 
@@ -1948,8 +1956,8 @@ void GeometryCache::renderLine(gpu::Batch& batch, const glm::vec2& p1, const glm
         details.vertices = vertices;
         details.vertexSize = FLOATS_PER_VERTEX;
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
+        auto verticesBuffer = refillBuffer(details.verticesBuffer);
+        auto colorBuffer = refillBuffer(details.colorBuffer);
         auto streamFormat = std::make_shared<gpu::Stream::Format>();
         auto stream = std::make_shared<gpu::BufferStream>();
 
@@ -13,6 +13,7 @@
 #include <gpu/Context.h>
 #include <shaders/Shaders.h>
 #include <graphics/ShaderConstants.h>
+#include <TBBHelpers.h>
 
 #include "RenderUtilsLogging.h"
 #include "render-utils/ShaderConstants.h"
@@ -254,66 +255,60 @@ uint32_t scanLightVolumeBox(FrustumGrid& grid, const FrustumGrid::Planes planes[
     return numClustersTouched;
 }
 
-uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
+uint32_t scanLightVolumeSphereSlice(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int z, const glm::ivec3& centerCluster, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
     std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
-    glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
     uint32_t numClustersTouched = 0;
     const auto& xPlanes = planes[0];
     const auto& yPlanes = planes[1];
     const auto& zPlanes = planes[2];
 
-    // FInd the light origin cluster
-    auto centerCluster = grid.frustumGrid_eyeToClusterPos(glm::vec3(eyePosRadius));
-
     int center_z = centerCluster.z;
     int center_y = centerCluster.y;
 
-    for (auto z = zMin; (z <= zMax); z++) {
-        auto zSphere = eyePosRadius;
-        if (z != center_z) {
-            auto plane = (z < center_z) ? zPlanes[z + 1] : -zPlanes[z];
-            if (!reduceSphereToPlane(zSphere, plane, zSphere)) {
+    auto zSphere = eyePosRadius;
+    if (z != center_z) {
+        auto plane = (z < center_z) ? zPlanes[z + 1] : -zPlanes[z];
+        if (!reduceSphereToPlane(zSphere, plane, zSphere)) {
+            // pass this slice!
+            return numClustersTouched;
+        }
+    }
+    for (auto y = yMin; (y <= yMax); y++) {
+        auto ySphere = zSphere;
+        if (y != center_y) {
+            auto plane = (y < center_y) ? yPlanes[y + 1] : -yPlanes[y];
+            if (!reduceSphereToPlane(ySphere, plane, ySphere)) {
                 // pass this slice!
                 continue;
             }
         }
-        for (auto y = yMin; (y <= yMax); y++) {
-            auto ySphere = zSphere;
-            if (y != center_y) {
-                auto plane = (y < center_y) ? yPlanes[y + 1] : -yPlanes[y];
-                if (!reduceSphereToPlane(ySphere, plane, ySphere)) {
-                    // pass this slice!
-                    continue;
-                }
-            }
 
-            glm::vec3 spherePoint(ySphere);
+        glm::vec3 spherePoint(ySphere);
 
-            auto x = xMin;
-            for (; (x < xMax); ++x) {
-                const auto& plane = xPlanes[x + 1];
-                auto testDistance = distanceToPlane(spherePoint, plane) + ySphere.w;
-                if (testDistance >= 0.0f) {
-                    break;
-                }
+        auto x = xMin;
+        for (; (x < xMax); ++x) {
+            const auto& plane = xPlanes[x + 1];
+            auto testDistance = distanceToPlane(spherePoint, plane) + ySphere.w;
+            if (testDistance >= 0.0f) {
+                break;
             }
-            auto xs = xMax;
-            for (; (xs >= x); --xs) {
-                auto plane = -xPlanes[xs];
-                auto testDistance = distanceToPlane(spherePoint, plane) + ySphere.w;
-                if (testDistance >= 0.0f) {
-                    break;
-                }
+        }
+        auto xs = xMax;
+        for (; (xs >= x); --xs) {
+            auto plane = -xPlanes[xs];
+            auto testDistance = distanceToPlane(spherePoint, plane) + ySphere.w;
+            if (testDistance >= 0.0f) {
+                break;
             }
+        }
 
-            for (; (x <= xs); x++) {
-                auto index = grid.frustumGrid_clusterToIndex(ivec3(x, y, z));
-                if (index < (int)clusterGrid.size()) {
-                    clusterGrid[index].emplace_back(lightId);
-                    numClustersTouched++;
-                } else {
-                    qCDebug(renderutils) << "WARNING: LightClusters::scanLightVolumeSphere invalid index found ? numClusters = " << clusterGrid.size() << " index = " << index << " found from cluster xyz = " << x << " " << y << " " << z;
-                }
+        for (; (x <= xs); x++) {
+            auto index = grid.frustumGrid_clusterToIndex(ivec3(x, y, z));
+            if (index < (int)clusterGrid.size()) {
+                clusterGrid[index].emplace_back(lightId);
+                numClustersTouched++;
+            } else {
+                qCDebug(renderutils) << "WARNING: LightClusters::scanLightVolumeSphere invalid index found ? numClusters = " << clusterGrid.size() << " index = " << index << " found from cluster xyz = " << x << " " << y << " " << z;
             }
         }
     }
@@ -346,6 +341,20 @@ glm::ivec3 LightClusters::updateClusters() {
     uint32_t numClusterTouched = 0;
     uint32_t numLightsIn = _visibleLightIndices[0];
     uint32_t numClusteredLights = 0;
+
+    // the lights and the range of clusters they might touch
+    struct ClusteredLight {
+        LightID id;
+        bool isSpot;
+        bool beyondFar;
+        glm::vec4 eyePosRadius;
+        glm::ivec3 centerCluster;
+        glm::ivec3 min;
+        glm::ivec3 max;
+    };
+    std::vector<ClusteredLight> clusteredLights;
+    clusteredLights.reserve(_visibleLightIndices.size());
+
     for (size_t lightNum = 1; lightNum < _visibleLightIndices.size(); ++lightNum) {
         auto lightId = _visibleLightIndices[lightNum];
         auto light = _lightStage->getLight(lightId);
@@ -472,17 +481,43 @@ glm::ivec3 LightClusters::updateClusters() {
             assert(yMin <= yMax);
         }
 
-        // now voxelize
-        auto& clusterGrid = (isSpot ? clusterGridSpot : clusterGridPoint);
-        if (beyondFar) {
-            numClusterTouched += scanLightVolumeBoxSlice(theFrustumGrid, _gridPlanes, zMin, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
-        } else {
-            numClusterTouched += scanLightVolumeSphere(theFrustumGrid, _gridPlanes, zMin, zMax, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
-        }
+        // voxelized below, slice by slice
+        ClusteredLight clusteredLight;
+        clusteredLight.id = lightId;
+        clusteredLight.isSpot = isSpot;
+        clusteredLight.beyondFar = beyondFar;
+        clusteredLight.eyePosRadius = glm::vec4(glm::vec3(eyeOri), radius);
+        clusteredLight.centerCluster = theFrustumGrid.frustumGrid_eyeToClusterPos(glm::vec3(eyeOri));
+        clusteredLight.min = glm::ivec3(xMin, yMin, zMin);
+        clusteredLight.max = glm::ivec3(xMax, yMax, beyondFar ? zMin : zMax);
+        clusteredLights.push_back(clusteredLight);
 
         numClusteredLights++;
     }
 
+    // Each z slice is voxelized on its own, going through the lights in order, so the clusters of a slice are only
+    // written by one worker and list their lights in the same order as when done one light after the other
+    std::vector<uint32_t> numSliceClustersTouched(theFrustumGrid.dims.z, 0);
+    tbb::parallel_for(0, theFrustumGrid.dims.z, [&](int z) {
+        auto& numTouched = numSliceClustersTouched[z];
+        for (const auto& light : clusteredLights) {
+            if (z < light.min.z || z > light.max.z) {
+                continue;
+            }
+            auto& clusterGrid = (light.isSpot ? clusterGridSpot : clusterGridPoint);
+            if (light.beyondFar) {
+                numTouched += scanLightVolumeBoxSlice(theFrustumGrid, _gridPlanes, z, light.min.y, light.max.y,
+                    light.min.x, light.max.x, light.id, light.eyePosRadius, clusterGrid);
+            } else {
+                numTouched += scanLightVolumeSphereSlice(theFrustumGrid, _gridPlanes, z, light.centerCluster, light.min.y,
+                    light.max.y, light.min.x, light.max.x, light.id, light.eyePosRadius, clusterGrid);
+            }
+        }
+    });
+    for (auto numTouched : numSliceClustersTouched) {
+        numClusterTouched += numTouched;
+    }
+
     // Lights have been gathered now reexpress in terms of 2 sequential buffers
     // Start filling from near to far and stops if it overflows
     bool checkBudget = false;
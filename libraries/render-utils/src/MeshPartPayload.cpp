@@ -21,12 +21,20 @@
 #include <procedural/Procedural.h>
 #include "DeferredLightingEffect.h"
 
+#include "ModelImposter.h"
+#include "SkinnedMesh.h"
 #include "RenderPipelines.h"
 
 // static const QString ENABLE_MATERIAL_PROCEDURAL_SHADERS_STRING { "HIFI_ENABLE_MATERIAL_PROCEDURAL_SHADERS" };
 // static bool ENABLE_MATERIAL_PROCEDURAL_SHADERS = QProcessEnvironment::systemEnvironment().contains(ENABLE_MATERIAL_PROCEDURAL_SHADERS_STRING);
 
 bool MeshPartPayload::enableMaterialProceduralShaders = false;
+bool MeshPartPayload::enableIndirectDraw = false;
+bool MeshPartPayload::enableInstancedDraw = false;
+bool MeshPartPayload::enableMeshLods = true;
+bool MeshPartPayload::enableTextureMipRequests = true;
+
+static const size_t INDIRECT_COMMAND_BUFFER = 0;
 
 using namespace render;
 
@@ -71,6 +79,82 @@ void MeshPartPayload::updateMeshPart(const std::shared_ptr<const graphics::Mesh>
         _hasColorAttrib = vertexFormat->hasAttribute(gpu::Stream::COLOR);
         _drawPart = _drawMesh->getPartBuffer().get<graphics::Mesh::Part>(partIndex);
         _localBound = _drawMesh->evalPartBound(partIndex);
+
+        _lodDrawParts.clear();
+        _lodDrawParts.push_back(_drawPart);
+        auto numParts = _drawMesh->getNumParts();
+        for (size_t lod = 0; lod < _drawMesh->getNumLods(); lod++) {
+            _lodDrawParts.push_back(_drawMesh->getLodPartBuffer().get<graphics::Mesh::Part>(lod * numParts + partIndex));
+        }
+    }
+}
+
+// The first level takes over once the part looks LOD_SWITCH_SCALE times bigger than the size under which the LOD manager
+// drops it, and each level after that at half the size of the one before
+static const float LOD_SWITCH_SCALE = 16.0f;
+
+size_t MeshPartPayload::evalLod(const RenderArgs* args) const {
+    size_t numLods = _lodDrawParts.empty() ? 0 : _lodDrawParts.size() - 1;
+    if (!enableMeshLods || numLods == 0 || !args->hasViewFrustum() || args->_lodAngleHalfTanSq <= 0.0f) {
+        return 0;
+    }
+    const auto& viewFrustum = args->getViewFrustum();
+    if (!viewFrustum.isPerspective()) {
+        return 0;
+    }
+
+    glm::vec3 dimensions = _worldBound.getDimensions();
+    glm::vec3 offset = _worldBound.calcCenter() - viewFrustum.getPosition();
+    float halfSizeSq = 0.25f * glm::dot(dimensions, dimensions);
+    float switchHalfSizeSq = LOD_SWITCH_SCALE * LOD_SWITCH_SCALE * args->_lodAngleHalfTanSq * glm::dot(offset, offset);
+
+    size_t lod = 0;
+    while (lod < numLods && halfSizeSq < switchHalfSizeSq) {
+        lod++;
+        switchHalfSizeSq *= 0.25f;
+    }
+    return lod;
+}
+
+void MeshPartPayload::requestDesiredTextureMips(const RenderArgs* args) {
+    if (_drawMaterials.empty() || args->_renderMode != RenderArgs::DEFAULT_RENDER_MODE || !args->hasViewFrustum()) {
+        return;
+    }
+    const auto& viewFrustum = args->getViewFrustum();
+
+    // without the requests, the textures that were drawn still ask for all of their mips
+    float pixels = 0.0f;
+    bool isSizedOnScreen = enableTextureMipRequests && viewFrustum.isPerspective();
+    if (isSizedOnScreen) {
+        // the pixels across the part where it is nearest to the eye, as if its textures covered it once
+        const float MIN_DISTANCE = 0.01f;
+        glm::vec3 eye = viewFrustum.getPosition();
+        glm::vec3 nearest = glm::clamp(eye, _worldBound.getMinimumPoint(), _worldBound.getMaximumPoint());
+        float distance = glm::max(glm::distance(eye, nearest), MIN_DISTANCE);
+        float size = glm::length(_worldBound.getDimensions());
+        pixels = size * viewFrustum.getProjection()[1][1] * (float)args->_viewport.w / (2.0f * distance);
+
+        // the textures repeat as many times across the part as the texcoords are scaled
+        const float MIN_TEXCOORD_SCALE = 0.001f;
+        const auto& texcoordTransform =
+            _drawMaterials.getSchemaBuffer().get<graphics::MultiMaterial::Schema>()._texcoordTransforms[0];
+        float texcoordScale = glm::max(glm::length(glm::vec3(texcoordTransform[0])), glm::length(glm::vec3(texcoordTransform[1])));
+        pixels = glm::max(pixels / glm::max(texcoordScale, MIN_TEXCOORD_SCALE), 1.0f);
+    }
+
+    // one finer than a texel per pixel, for the parts of the textures stretched over less of the part than the others
+    const float MIP_BIAS = 1.0f;
+    for (const auto& texture : _drawMaterials.getTextureTable()->getTextures()) {
+        if (!texture || texture->getUsageType() != gpu::TextureUsageType::RESOURCE) {
+            continue;
+        }
+        uint16_t mip = 0;
+        if (isSizedOnScreen) {
+            float texels = (float)glm::max(texture->getWidth(), texture->getHeight());
+            float level = glm::floor(glm::log2(glm::max(texels / pixels, 1.0f)) - MIP_BIAS);
+            mip = (uint16_t)glm::clamp(level, 0.0f, (float)texture->getMaxMip());
+        }
+        texture->requestDesiredMip(mip);
     }
 }
 
@@ -179,6 +263,8 @@ void MeshPartPayload::render(RenderArgs* args) {
         return;
     }
 
+    requestDesiredTextureMips(args);
+
     gpu::Batch& batch = *(args->_batch);
 
     // Bind the model transform and the skinCLusterMatrices if needed
@@ -311,6 +397,10 @@ void ModelMeshPartPayload::initCache(const ModelPointer& model) {
 
         _isBlendShaped = !mesh.blendshapes.isEmpty();
         _hasTangents = !mesh.tangents.isEmpty();
+        _numBlendshapes = mesh.blendshapes.size();
+        if (_isBlendShaped) {
+            _sparseBlendshapeBuffer = model->getSparseBlendshapeBuffer(_meshIndex);
+        }
     }
 
     auto networkMaterial = model->getGeometry()->getShapeMaterial(_shapeID);
@@ -460,7 +550,10 @@ ShapeKey ModelMeshPartPayload::getShapeKey() const {
 void ModelMeshPartPayload::bindMesh(gpu::Batch& batch) {
     batch.setIndexBuffer(gpu::UINT32, (_drawMesh->getIndexBuffer()._buffer), 0);
     batch.setInputFormat((_drawMesh->getVertexFormat()));
-    if (_meshBlendshapeBuffer) {
+    if (_blendshapeCoefficientsBuffer) {
+        batch.setResourceBuffer(0, _sparseBlendshapeBuffer);
+        batch.setResourceBuffer(1, _blendshapeCoefficientsBuffer);
+    } else if (_meshBlendshapeBuffer) {
         batch.setResourceBuffer(0, _meshBlendshapeBuffer);
     }
     batch.setInputStream(0, _drawMesh->getVertexStream());
@@ -480,6 +573,28 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
         return;
     }
 
+    // the imposter of the model is drawn instead
+    if (_imposter && _itemKey.isOpaque() && _imposter->isActive(args)) {
+        return;
+    }
+
+    if (!_lodDrawParts.empty()) {
+        _drawPart = _lodDrawParts[evalLod(args)];
+    }
+
+    requestDesiredTextureMips(args);
+
+    if (canDrawGrouped(args)) {
+        if (enableIndirectDraw && args->_context->supportsMultiDrawIndirect()) {
+            drawIndirect(args);
+            return;
+        }
+        if (enableInstancedDraw) {
+            drawInstanced(args);
+            return;
+        }
+    }
+
     gpu::Batch& batch = *(args->_batch);
 
     bindTransform(batch, args->_renderMode);
@@ -488,13 +603,26 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     bindMesh(batch);
 
     // IF deformed pass the mesh key
-    auto drawcallInfo = (uint16_t) (((_isBlendShaped && _meshBlendshapeBuffer && args->_enableBlendshape) << 0) | ((_isSkinned && args->_enableSkinning) << 1));
+    bool isBlendshapeSparse = _isBlendShaped && _blendshapeCoefficientsBuffer;
+    // blending in no blendshape at all leaves the vertices as they are, so it is skipped
+    bool isBlendShaped = _isBlendShaped && (isBlendshapeSparse ? _hasBlendshapeCoefficients : (bool)_meshBlendshapeBuffer) &&
+        args->_enableBlendshape;
+    auto drawcallInfo = (uint16_t) ((isBlendShaped << 0) | ((_isSkinned && args->_enableSkinning) << 1) | ((isBlendShaped && isBlendshapeSparse) << 3));
+    bool isProcedural = !_drawMaterials.empty() && _drawMaterials.top().material && _drawMaterials.top().material->isProcedural() &&
+        _drawMaterials.top().material->isReady();
+
+    // the procedural shaders still deform the vertices themselves
+    if (drawcallInfo && _skinnedMesh && !isProcedural && _shapeKey.isDeformed() &&
+            _skinnedMesh->requestSkinning(_drawMesh, _clusterBuffer, _shapeKey.isDualQuatSkinned(),
+                isBlendshapeSparse ? _sparseBlendshapeBuffer : _meshBlendshapeBuffer, _blendshapeCoefficientsBuffer, drawcallInfo)) {
+        _skinnedMesh->bind(batch);
+        drawcallInfo |= SkinnedMesh::SKINNED_VERTICES_BIT;
+    }
     if (drawcallInfo) {
         batch.setDrawcallUniform(drawcallInfo);
     }
 
-    if (!_drawMaterials.empty() && _drawMaterials.top().material && _drawMaterials.top().material->isProcedural() &&
-            _drawMaterials.top().material->isReady()) {
+    if (isProcedural) {
         if (!(enableMaterialProceduralShaders)) {
             return;
         }
@@ -522,6 +650,109 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
 }
 
+bool ModelMeshPartPayload::canDrawGrouped(RenderArgs* args) const {
+    if ((!enableIndirectDraw && !enableInstancedDraw) || !args->_shapePipeline) {
+        return false;
+    }
+
+    // translucent parts are drawn in depth order, and faded or deformed parts have their own per item state.
+    // Each part is drawn as one instance, stereo would need two
+    if (_shapeKey.isTranslucent() || _shapeKey.isFaded() || _shapeKey.isDeformed() || _shapeKey.hasOwnPipeline() ||
+            args->isStereo()) {
+        return false;
+    }
+
+    // the parts in a group draw with the material of the first one, so it has to be all that is in it
+    if (_drawMaterials.size() != 1 || _drawMaterials.shouldUpdate()) {
+        return false;
+    }
+    auto& material = _drawMaterials.top().material;
+    return material && !material->isProcedural();
+}
+
+void ModelMeshPartPayload::drawIndirect(RenderArgs* args) {
+    gpu::Batch& batch = *(args->_batch);
+
+    auto pipeline = args->_shapePipeline;
+    std::string instanceName = "mesh_parts_" + std::to_string(std::hash<std::shared_ptr<const graphics::Mesh>>()(_drawMesh)) +
+        "_" + std::to_string(std::hash<graphics::MaterialPointer>()(_drawMaterials.top().material)) +
+        "_" + std::to_string(std::hash<render::ShapePipelinePointer>()(pipeline));
+
+    // each part is a command, its instance picks its draw call info and so its transform
+    const gpu::BufferPointer& commandBuffer = batch.getNamedBuffer(instanceName, INDIRECT_COMMAND_BUFFER);
+    bool isFirstPart = commandBuffer->getSize() == 0;
+
+    gpu::Batch::DrawIndexedIndirectCommand command;
+    command._count = _drawPart._numIndices;
+    command._instanceCount = 1;
+    command._firstIndex = _drawPart._startIndex;
+    command._baseInstance = (uint)(commandBuffer->getSize() / sizeof(command));
+    commandBuffer->append(command);
+
+    batch.setModelTransform(_transform);
+
+    if (isFirstPart) {
+        auto renderMode = args->_renderMode;
+        auto enableTextures = args->_enableTexturing;
+        auto mesh = _drawMesh;
+        auto materials = _drawMaterials;
+        batch.setupNamedCalls(instanceName, [args, pipeline, renderMode, enableTextures, mesh, materials](gpu::Batch& batch,
+                gpu::Batch::NamedBatchData& data) mutable {
+            batch.setPipeline(pipeline->pipeline);
+            pipeline->prepare(batch, args);
+            RenderPipelines::bindMaterials(materials, batch, renderMode, enableTextures);
+
+            batch.setIndexBuffer(gpu::UINT32, mesh->getIndexBuffer()._buffer, 0);
+            batch.setInputFormat(mesh->getVertexFormat());
+            batch.setInputStream(0, mesh->getVertexStream());
+
+            batch.setIndirectBuffer(data.buffers[INDIRECT_COMMAND_BUFFER], 0, sizeof(gpu::Batch::DrawIndexedIndirectCommand));
+            batch.multiDrawIndexedIndirect((uint32)(data.buffers[INDIRECT_COMMAND_BUFFER]->getSize() /
+                sizeof(gpu::Batch::DrawIndexedIndirectCommand)), gpu::TRIANGLES);
+        });
+    } else {
+        batch.setupNamedCalls(instanceName, nullptr);
+    }
+
+    const int INDICES_PER_TRIANGLE = 3;
+    args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+}
+
+void ModelMeshPartPayload::drawInstanced(RenderArgs* args) {
+    gpu::Batch& batch = *(args->_batch);
+
+    // the copies of a model share the meshes and materials of its geometry, so the same part of each of them has the same name
+    auto pipeline = args->_shapePipeline;
+    std::string instanceName = "mesh_part_instances_" + std::to_string(std::hash<std::shared_ptr<const graphics::Mesh>>()(_drawMesh)) +
+        "_" + std::to_string(_drawPart._startIndex) + "_" + std::to_string(_drawPart._numIndices) +
+        "_" + std::to_string(std::hash<graphics::MaterialPointer>()(_drawMaterials.top().material)) +
+        "_" + std::to_string(std::hash<render::ShapePipelinePointer>()(pipeline));
+
+    // each instance picks its draw call info and so its transform
+    batch.setModelTransform(_transform);
+
+    auto renderMode = args->_renderMode;
+    auto enableTextures = args->_enableTexturing;
+    auto mesh = _drawMesh;
+    auto materials = _drawMaterials;
+    auto part = _drawPart;
+    batch.setupNamedCalls(instanceName, [args, pipeline, renderMode, enableTextures, mesh, materials, part](gpu::Batch& batch,
+            gpu::Batch::NamedBatchData& data) mutable {
+        batch.setPipeline(pipeline->pipeline);
+        pipeline->prepare(batch, args);
+        RenderPipelines::bindMaterials(materials, batch, renderMode, enableTextures);
+
+        batch.setIndexBuffer(gpu::UINT32, mesh->getIndexBuffer()._buffer, 0);
+        batch.setInputFormat(mesh->getVertexFormat());
+        batch.setInputStream(0, mesh->getVertexStream());
+
+        batch.drawIndexedInstanced((gpu::uint32)data.count(), gpu::TRIANGLES, part._numIndices, part._startIndex);
+    });
+
+    const int INDICES_PER_TRIANGLE = 3;
+    args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+}
+
 void ModelMeshPartPayload::computeAdjustedLocalBound(const std::vector<glm::mat4>& clusterMatrices) {
     _adjustedLocalBound = _localBound;
     if (clusterMatrices.size() > 0) {
@@ -559,6 +790,30 @@ void ModelMeshPartPayload::setBlendshapeBuffer(const std::unordered_map<int, gpu
         auto blendshapeBuffer = blendshapeBuffers.find(_meshIndex);
         if (blendshapeBuffer != blendshapeBuffers.end()) {
             _meshBlendshapeBuffer = blendshapeBuffer->second;
+            _blendshapeCoefficientsBuffer.reset();
         }
     }
 }
+
+void ModelMeshPartPayload::updateBlendshapeCoefficients(const QVector<float>& coefficients) {
+    if (!_sparseBlendshapeBuffer) {
+        return;
+    }
+
+    // padded to the blendshapes of the mesh, without the ones the Blender leaves out either
+    const float EPSILON = 0.0001f;
+    std::vector<float> data(4 * ((_numBlendshapes + 3) / 4), 0.0f);
+    _hasBlendshapeCoefficients = false;
+    for (int i = 0, n = std::min(coefficients.size(), _numBlendshapes); i < n; i++) {
+        float coefficient = coefficients.at(i);
+        data[i] = coefficient < EPSILON ? 0.0f : coefficient;
+        _hasBlendshapeCoefficients = _hasBlendshapeCoefficients || data[i] != 0.0f;
+    }
+
+    auto size = data.size() * sizeof(float);
+    if (!_blendshapeCoefficientsBuffer || _blendshapeCoefficientsBuffer->getSize() != size) {
+        _blendshapeCoefficientsBuffer = std::make_shared<gpu::Buffer>(size, reinterpret_cast<const gpu::Byte*>(data.data()), size);
+    } else {
+        _blendshapeCoefficientsBuffer->setSubData(0, size, reinterpret_cast<const gpu::Byte*>(data.data()));
+    }
+}
@@ -23,6 +23,8 @@
 #include "Model.h"
 
 class Model;
+class ModelImposter;
+class SkinnedMesh;
 
 class MeshPartPayload {
 public:
@@ -64,6 +66,8 @@ public:
 
     graphics::MultiMaterial _drawMaterials;
     graphics::Mesh::Part _drawPart;
+    // the full part first, then its simplified levels from the baker, coarser as they go
+    std::vector<graphics::Mesh::Part> _lodDrawParts;
 
     size_t getVerticesCount() const { return _drawMesh ? _drawMesh->getNumVertices() : 0; }
     size_t getMaterialTextureSize() { return _drawMaterials.getTextureSize(); }
@@ -77,7 +81,27 @@ public:
 
     static bool enableMaterialProceduralShaders;
 
+    // Rigid, opaque model parts that share a mesh, a material and a pipeline are drawn together with one
+    // multiDrawIndexedIndirect at the end of the batch, one indirect command per part
+    static bool enableIndirectDraw;
+
+    // Without the indirect draw, the same rigid, opaque parts of the copies of a model are drawn together with one
+    // drawIndexedInstanced at the end of the batch, one instance per copy
+    static bool enableInstancedDraw;
+
+    // Picks one of the simplified levels baked with the mesh once the part gets small enough on screen
+    static bool enableMeshLods;
+
+    // Asks for the mips of the material textures that the size of the part on screen needs, so that the texture memory
+    // goes to the textures seen up close rather than to all of them evenly
+    static bool enableTextureMipRequests;
+
 protected:
+    // the level of the part to draw in this view, 0 being the full part
+    size_t evalLod(const RenderArgs* args) const;
+
+    void requestDesiredTextureMips(const RenderArgs* args);
+
     render::ItemKey _itemKey{ render::ItemKey::Builder::opaqueShape().build() };
     bool _cullWithParent { false };
     uint64_t _created;
@@ -114,6 +138,9 @@ public:
 
     void setShapeKey(bool invalidateShapeKey, PrimitiveMode primitiveMode, bool useDualQuaternionSkinning);
     void setCauterized(bool cauterized) { _cauterized = cauterized; }
+    void setImposter(const std::shared_ptr<ModelImposter>& imposter) { _imposter = imposter; }
+    // shared by the parts of a deformed mesh
+    void setSkinnedMesh(const std::shared_ptr<SkinnedMesh>& skinnedMesh) { _skinnedMesh = skinnedMesh; }
 
     // ModelMeshPartPayload functions to perform render
     void bindMesh(gpu::Batch& batch) override;
@@ -135,18 +162,29 @@ public:
 
     bool _isSkinned{ false };
     bool _isBlendShaped { false };
+    bool _hasBlendshapeCoefficients { false }; // any of the coefficients of the gpu blending is not 0
     bool _hasTangents { false };
 
     void setBlendshapeBuffer(const std::unordered_map<int, gpu::BufferPointer>& blendshapeBuffers, const QVector<int>& blendedMeshSizes);
+    // blends the sparse blendshapes of the mesh on the gpu, until the next blendshape buffer from the Blender
+    void updateBlendshapeCoefficients(const QVector<float>& coefficients);
 
 private:
     void initCache(const ModelPointer& model);
 
+    bool canDrawGrouped(RenderArgs* args) const;
+    void drawIndirect(RenderArgs* args);
+    void drawInstanced(RenderArgs* args);
+
     gpu::BufferPointer _meshBlendshapeBuffer;
+    gpu::BufferPointer _sparseBlendshapeBuffer;
+    gpu::BufferPointer _blendshapeCoefficientsBuffer;
+    int _numBlendshapes { 0 };
     int _meshNumVertices;
     render::ShapeKey _shapeKey { render::ShapeKey::Builder::invalid() };
     bool _cauterized { false };
-
+    std::shared_ptr<ModelImposter> _imposter;
+    std::shared_ptr<SkinnedMesh> _skinnedMesh;
 };
 
 namespace render {
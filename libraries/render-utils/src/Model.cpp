@@ -12,8 +12,6 @@
 #include "Model.h"
 
 #include <QMetaType>
-#include <QRunnable>
-#include <QThreadPool>
 
 #include <glm/gtx/transform.hpp>
 #include <glm/gtx/norm.hpp>
@@ -24,6 +22,7 @@
 #include <PerfStat.h>
 #include <ViewFrustum.h>
 #include <GLMHelpers.h>
+#include <JobSystem.h>
 #include <TBBHelpers.h>
 
 #include <model-networking/SimpleMeshProxy.h>
@@ -35,6 +34,8 @@
 
 #include "AbstractViewStateInterface.h"
 #include "MeshPartPayload.h"
+#include "ModelImposter.h"
+#include "SkinnedMesh.h"
 
 #include "RenderUtilsLogging.h"
 #include <Trace.h>
@@ -273,6 +274,21 @@ void Model::updateRenderItems() {
             });
         }
 
+        if (self->_imposterItemID != render::Item::INVALID_ITEM_ID) {
+            Transform imposterTransform = self->getTransform();
+            AABox imposterBound = self->getRenderableMeshBound();
+            bool isReady = self->getGeometry() && self->getGeometry()->areTexturesLoaded();
+            bool cullWithParent = self->_cullWithParent;
+            transaction.updateItem<ImposterPayload>(self->_imposterItemID, [imposterTransform, imposterBound, isReady,
+                                                                           renderItemKeyGlobalFlags, cullWithParent](ImposterPayload& data) {
+                data.getImposter()->setModelTransform(imposterTransform);
+                data.getImposter()->setBound(imposterBound);
+                data.getImposter()->setReady(isReady);
+                data.setCullWithParent(cullWithParent);
+                data.updateKey(renderItemKeyGlobalFlags);
+            });
+        }
+
         AbstractViewStateInterface::instance()->getMain3DScene()->enqueueTransaction(transaction);
     });
 }
@@ -885,6 +901,11 @@ void Model::updateRenderItemsKey(const render::ScenePointer& scene) {
             data.updateKey(renderItemsKey);
         });
     }
+    if (_imposterItemID != render::Item::INVALID_ITEM_ID) {
+        transaction.updateItem<ImposterPayload>(_imposterItemID, [renderItemsKey](ImposterPayload& data) {
+            data.updateKey(renderItemsKey);
+        });
+    }
     scene->enqueueTransaction(transaction);
 }
 
@@ -972,10 +993,23 @@ void Model::setCullWithParent(bool cullWithParent) {
                 data.updateKey(renderItemsKey);
             });
         }
+        if (_imposterItemID != render::Item::INVALID_ITEM_ID) {
+            transaction.updateItem<ImposterPayload>(_imposterItemID, [cullWithParent, renderItemsKey](ImposterPayload& data) {
+                data.setCullWithParent(cullWithParent);
+                data.updateKey(renderItemsKey);
+            });
+        }
         AbstractViewStateInterface::instance()->getMain3DScene()->enqueueTransaction(transaction);
     }
 }
 
+void Model::setUseImposter(bool useImposter) {
+    if (_useImposter != useImposter) {
+        _useImposter = useImposter;
+        _needsFixupInScene = true;
+    }
+}
+
 const render::ItemKey Model::getRenderItemKeyGlobalFlags() const {
     return _renderItemKeyGlobalFlags;
 }
@@ -1013,6 +1047,15 @@ bool Model::addToScene(const render::ScenePointer& scene,
         }
         somethingAdded = !_modelMeshRenderItemsMap.empty();
 
+        if (somethingAdded && _useImposter) {
+            _imposter = std::make_shared<ModelImposter>(_modelMeshRenderItemIDs);
+            foreach(auto renderItem, _modelMeshRenderItems) {
+                renderItem->setImposter(_imposter);
+            }
+            _imposterItemID = scene->allocateID();
+            transaction.resetItem(_imposterItemID, std::make_shared<ImposterPayload::Payload>(std::make_shared<ImposterPayload>(_imposter)));
+        }
+
         _renderInfoVertexCount = verticesCount;
         _renderInfoDrawCalls = _modelMeshRenderItemsMap.count();
         _renderInfoHasTransparent = hasTransparent;
@@ -1021,6 +1064,8 @@ bool Model::addToScene(const render::ScenePointer& scene,
     if (somethingAdded) {
         applyMaterialMapping();
         _addedToScene = true;
+        // blend the new render items on the next simulation
+        _blendedBlendshapeCoefficients.clear();
         updateRenderItems();
         _needsFixupInScene = false;
     }
@@ -1032,6 +1077,11 @@ void Model::removeFromScene(const render::ScenePointer& scene, render::Transacti
     foreach (auto item, _modelMeshRenderItemsMap.keys()) {
         transaction.removeItem(item);
     }
+    if (_imposterItemID != render::Item::INVALID_ITEM_ID) {
+        transaction.removeItem(_imposterItemID);
+        _imposterItemID = render::Item::INVALID_ITEM_ID;
+    }
+    _imposter.reset();
     _modelMeshRenderItemIDs.clear();
     _modelMeshRenderItemsMap.clear();
     _modelMeshRenderItems.clear();
@@ -1224,6 +1274,13 @@ void Model::setURL(const QUrl& url) {
     onInvalidate();
 }
 
+void Model::setLoadingPriority(float priority) {
+    if (priority != _loadingPriority) {
+        _loadingPriority = priority;
+        _renderWatcher.setLoadPriority(this, priority);
+    }
+}
+
 void Model::loadURLFinished(bool success) {
     if (!success) {
         _visualGeometryRequestFailed = true;
@@ -1440,6 +1497,7 @@ void Model::deleteGeometry() {
     _meshStates.clear();
     _rig.destroyAnimGraph();
     _blendedBlendshapeCoefficients.clear();
+    _sparseBlendshapeBuffers.clear();
     _renderGeometry.reset();
 }
 
@@ -1502,10 +1560,15 @@ void Model::createRenderItemSet() {
             continue;
         }
 
-        // Create the render payloads
+        // Create the render payloads, the deformed ones share the skinning of their mesh
+        auto skinnedMesh = std::make_shared<SkinnedMesh>();
         int numParts = (int)mesh->getNumParts();
         for (int partIndex = 0; partIndex < numParts; partIndex++) {
-            _modelMeshRenderItems << std::make_shared<ModelMeshPartPayload>(shared_from_this(), i, partIndex, shapeID, transform, offset, _created);
+            auto renderItem = std::make_shared<ModelMeshPartPayload>(shared_from_this(), i, partIndex, shapeID, transform, offset, _created);
+            if (renderItem->_isSkinned || renderItem->_isBlendShaped) {
+                renderItem->setSkinnedMesh(skinnedMesh);
+            }
+            _modelMeshRenderItems << renderItem;
             auto material = getGeometry()->getShapeMaterial(shapeID);
             _modelMeshMaterialNames.push_back(material ? material->getName() : "");
             _modelMeshRenderItemShapes.emplace_back(ShapeInfo{ (int)i });
@@ -1758,12 +1821,12 @@ static void packBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, Blendshape
 static auto& packBlendshapeOffsets = packBlendshapeOffsets_ref;
 #endif
 
-class Blender : public QRunnable {
+class Blender {
 public:
 
     Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients);
 
-    virtual void run() override;
+    void run();
 
 private:
     ModelPointer _model;
@@ -1855,10 +1918,90 @@ void Blender::run() {
                               Q_ARG(QVector<int>, blendedMeshSizes));
 }
 
+// The deltas of the blendshapes that move each vertex, see getSparseBlendshapeOffset in Blendshape.slh. The buffer starts
+// with the range of entries of every vertex, each entry is the position delta and the index of its blendshape in a first
+// texel, then the normal and tangent deltas as halves in a second one
+static gpu::BufferPointer buildSparseBlendshapeBuffer(const HFMMesh& mesh) {
+    int numVertices = mesh.vertices.size();
+    std::vector<uint32_t> numEntries(numVertices, 0);
+    size_t totalEntries = 0;
+    for (const auto& blendshape : mesh.blendshapes) {
+        for (auto index : blendshape.indices) {
+            if (index >= 0 && index < numVertices) {
+                numEntries[index]++;
+                totalEntries++;
+            }
+        }
+    }
+
+    std::vector<glm::uvec4> texels(numVertices + 2 * totalEntries, glm::uvec4(0));
+    uint32_t nextEntry = (uint32_t)numVertices;
+    for (int i = 0; i < numVertices; i++) {
+        texels[i] = glm::uvec4(nextEntry, numEntries[i], 0, 0);
+        nextEntry += 2 * numEntries[i];
+    }
+
+    std::vector<uint32_t> filledEntries(numVertices, 0);
+    for (int i = 0; i < mesh.blendshapes.size(); i++) {
+        const HFMBlendshape& blendshape = mesh.blendshapes.at(i);
+        for (int j = 0; j < blendshape.indices.size(); j++) {
+            int index = blendshape.indices.at(j);
+            if (index < 0 || index >= numVertices) {
+                continue;
+            }
+            glm::vec3 position = j < blendshape.vertices.size() ? blendshape.vertices.at(j) : glm::vec3(0.0f);
+            glm::vec3 normal = j < blendshape.normals.size() ? blendshape.normals.at(j) : glm::vec3(0.0f);
+            glm::vec3 tangent = j < blendshape.tangents.size() ? blendshape.tangents.at(j) : glm::vec3(0.0f);
+
+            uint32_t entry = texels[index].x + 2 * filledEntries[index]++;
+            texels[entry] = glm::uvec4(glm::floatBitsToUint(position), (uint32_t)i);
+            texels[entry + 1] = glm::uvec4(glm::packHalf2x16(glm::vec2(normal.x, normal.y)),
+                glm::packHalf2x16(glm::vec2(normal.z, tangent.x)), glm::packHalf2x16(glm::vec2(tangent.y, tangent.z)), 0);
+        }
+    }
+
+    auto size = texels.size() * sizeof(glm::uvec4);
+    return std::make_shared<gpu::Buffer>(size, reinterpret_cast<const gpu::Byte*>(texels.data()), size);
+}
+
+const gpu::BufferPointer& Model::getSparseBlendshapeBuffer(int meshIndex) {
+    const auto& meshes = getHFMModel().meshes;
+    if ((int)_sparseBlendshapeBuffers.size() != meshes.size()) {
+        _sparseBlendshapeBuffers.clear();
+        _sparseBlendshapeBuffers.resize(meshes.size());
+    }
+    auto& buffer = _sparseBlendshapeBuffers[meshIndex];
+    if (!buffer && !meshes.at(meshIndex).blendshapes.isEmpty()) {
+        buffer = buildSparseBlendshapeBuffer(meshes.at(meshIndex));
+    }
+    return buffer;
+}
+
+void Model::applyBlendshapeCoefficients() {
+    if (_modelMeshRenderItemIDs.empty()) {
+        // try again once the render items are in the scene
+        _blendedBlendshapeCoefficients.clear();
+        return;
+    }
+
+    render::Transaction transaction;
+    auto coefficients = _blendshapeCoefficients;
+    for (auto itemID : _modelMeshRenderItemIDs) {
+        transaction.updateItem<ModelMeshPartPayload>(itemID, [coefficients](ModelMeshPartPayload& data) {
+            data.updateBlendshapeCoefficients(coefficients);
+        });
+    }
+    AbstractViewStateInterface::instance()->getMain3DScene()->enqueueTransaction(transaction);
+}
+
 bool Model::maybeStartBlender() {
     if (isLoaded()) {
-        QThreadPool::globalInstance()->start(new Blender(getThisPointer(), getGeometry()->getConstHFMModelPointer(),
-                                                         ++_blendNumber, _blendshapeCoefficients));
+        // the blended meshes are shown as soon as they are ready, ahead of the loading work
+        auto blender = std::make_shared<Blender>(getThisPointer(), getGeometry()->getConstHFMModelPointer(),
+                                                 ++_blendNumber, _blendshapeCoefficients);
+        jobs::run([blender] {
+            blender->run();
+        }, jobs::Priority::High);
         return true;
     }
     return false;
@@ -1872,6 +2015,11 @@ ModelBlender::~ModelBlender() {
 }
 
 void ModelBlender::noteRequiresBlend(ModelPointer model) {
+    if (_computeBlendshapesOnGPU) {
+        model->applyBlendshapeCoefficients();
+        return;
+    }
+
     Lock lock(_mutex);
     if (_modelsRequiringBlendsSet.find(model) == _modelsRequiringBlendsSet.end()) {
         _modelsRequiringBlendsQueue.push(model);
@@ -56,6 +56,7 @@ namespace render {
 class MeshPartPayload;
 class ModelMeshPartPayload;
 class ModelRenderLocations;
+class ModelImposter;
 
 inline uint qHash(const std::shared_ptr<MeshPartPayload>& a, uint seed) {
     return qHash(a.get(), seed);
@@ -131,6 +132,12 @@ public:
 
     void setCullWithParent(bool value);
 
+    // Far enough in the main view, the opaque parts of the model are drawn as one imposter captured from them.
+    // Takes effect when the model is next added to the scene
+    void setUseImposter(bool useImposter);
+    bool getUseImposter() const { return _useImposter; }
+    render::ItemID getImposterItemID() const { return _imposterItemID; }
+
     // Access the current RenderItemKey Global Flags used by the model and applied to the render items  representing the parts of the model.
     const render::ItemKey getRenderItemKeyGlobalFlags() const;
 
@@ -165,6 +172,12 @@ public:
 
     bool maybeStartBlender();
 
+    // hands the blendshape coefficients straight to the render items, which blend the sparse deltas on the gpu
+    void applyBlendshapeCoefficients();
+
+    // the deltas of all the blendshapes of a mesh, built once for the gpu blending
+    const gpu::BufferPointer& getSparseBlendshapeBuffer(int meshIndex);
+
     bool isLoaded() const { return (bool)_renderGeometry && _renderGeometry->isHFMModelLoaded(); }
     bool isAddedToScene() const { return _addedToScene; }
 
@@ -291,7 +304,8 @@ public:
     // returns 'true' if needs fullUpdate after geometry change
     virtual bool updateGeometry();
 
-    void setLoadingPriority(float priority) { _loadingPriority = priority; }
+    // also reorders the geometry of the model if it is still waiting to load
+    void setLoadingPriority(float priority);
 
     size_t getRenderInfoVertexCount() const { return _renderInfoVertexCount; }
     size_t getRenderInfoTextureSize();
@@ -446,6 +460,7 @@ protected:
     QVector<float> _blendshapeCoefficients;
     QVector<float> _blendedBlendshapeCoefficients;
     int _blendNumber { 0 };
+    std::vector<gpu::BufferPointer> _sparseBlendshapeBuffers;
 
     mutable QMutex _mutex{ QMutex::Recursive };
 
@@ -507,6 +522,10 @@ protected:
     bool _cauterized { false };
     bool _cullWithParent { false };
 
+    bool _useImposter { false };
+    std::shared_ptr<ModelImposter> _imposter;
+    render::ItemID _imposterItemID { render::Item::INVALID_ITEM_ID };
+
     bool shouldInvalidatePayloadShapeKey(int meshIndex);
 
     uint64_t _created;
@@ -534,10 +553,12 @@ public:
     void noteRequiresBlend(ModelPointer model);
 
     bool shouldComputeBlendshapes() { return _computeBlendshapes; }
+    bool shouldComputeBlendshapesOnGPU() { return _computeBlendshapesOnGPU; }
 
 public slots:
     void setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes);
     void setComputeBlendshapes(bool computeBlendshapes) { _computeBlendshapes = computeBlendshapes; }
+    void setComputeBlendshapesOnGPU(bool computeBlendshapesOnGPU) { _computeBlendshapesOnGPU = computeBlendshapesOnGPU; }
 
 private:
     using Mutex = std::mutex;
@@ -552,6 +573,7 @@ private:
     Mutex _mutex;
 
     bool _computeBlendshapes { true };
+    bool _computeBlendshapesOnGPU { true };
 };
 
 
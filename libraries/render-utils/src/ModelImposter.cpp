@@ -0,0 +1,305 @@
+//
+//  ModelImposter.cpp
+//  libraries/render-utils/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelImposter.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <gpu/Context.h>
+#include <render/DrawTask.h>
+#include <shaders/Shaders.h>
+
+#include "render-utils/ShaderConstants.h"
+#include "StencilMaskPass.h"
+
+namespace ru {
+    using render_utils::slot::texture::Texture;
+    using render_utils::slot::buffer::Buffer;
+}
+
+bool ModelImposter::enabled { true };
+float ModelImposter::maxAngleHalfTanSq { 0.0f };
+
+std::mutex ModelImposter::_pendingCapturesMutex;
+std::vector<std::weak_ptr<ModelImposter>> ModelImposter::_pendingCaptures;
+
+namespace {
+
+struct ImposterParameters {
+    glm::vec4 center;
+    glm::vec4 rotation[3];
+    glm::vec4 normalRotation[3];
+};
+
+// Same as octahedralDecode in Imposter.slh
+glm::vec3 octahedralDecode(const glm::vec2& uv) {
+    glm::vec2 f = uv * 2.0f - 1.0f;
+    glm::vec3 n(f.x, f.y, 1.0f - fabsf(f.x) - fabsf(f.y));
+    float t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return glm::normalize(n);
+}
+
+// Same as evalImposterCellBasis in Imposter.slh
+glm::quat evalCellRotation(const glm::vec3& back) {
+    glm::vec3 upHint = fabsf(back.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.0f, 0.0f, 1.0f);
+    glm::vec3 right = glm::normalize(glm::cross(upHint, back));
+    glm::vec3 up = glm::cross(back, right);
+    return glm::quat_cast(glm::mat3(right, up, back));
+}
+
+}
+
+void ModelImposter::setBound(const AABox& bound) {
+    _bound = bound;
+}
+
+bool ModelImposter::isFar(const RenderArgs* args) const {
+    // same test as the LOD culling, on the angle under which the bound is seen
+    glm::vec3 dimensions = _bound.getDimensions();
+    glm::vec3 position = _bound.calcCenter() - args->getViewFrustum().getPosition();
+    return 0.25f * glm::dot(dimensions, dimensions) < maxAngleHalfTanSq * glm::dot(position, position);
+}
+
+bool ModelImposter::isActive(const RenderArgs* args) const {
+    return enabled && isCaptured() && args->_renderMode == RenderArgs::DEFAULT_RENDER_MODE &&
+        args->_renderMethod == RenderArgs::DEFERRED && isFar(args);
+}
+
+void ModelImposter::requestCapture() {
+    if (!_isReady || _isCapturePending) {
+        return;
+    }
+    // the capture is done by the CaptureImposters job of a later frame, the parts are drawn until then
+    _isCapturePending = true;
+    std::lock_guard<std::mutex> lock(_pendingCapturesMutex);
+    _pendingCaptures.push_back(shared_from_this());
+}
+
+std::vector<std::weak_ptr<ModelImposter>> ModelImposter::takePendingCaptures(size_t maxCaptures) {
+    std::lock_guard<std::mutex> lock(_pendingCapturesMutex);
+    size_t count = std::min(maxCaptures, _pendingCaptures.size());
+    std::vector<std::weak_ptr<ModelImposter>> captures(_pendingCaptures.begin(), _pendingCaptures.begin() + count);
+    _pendingCaptures.erase(_pendingCaptures.begin(), _pendingCaptures.begin() + count);
+    return captures;
+}
+
+const gpu::PipelinePointer& ModelImposter::getPipeline() {
+    static gpu::PipelinePointer pipeline;
+    if (!pipeline) {
+        auto state = std::make_shared<gpu::State>();
+        state->setDepthTest(true, true, gpu::LESS_EQUAL);
+        state->setCullMode(gpu::State::CULL_NONE);
+        PrepareStencil::testMaskDrawShape(*state);
+        pipeline = gpu::Pipeline::create(gpu::Shader::createProgram(shader::render_utils::program::imposter), state);
+    }
+    return pipeline;
+}
+
+void ModelImposter::render(RenderArgs* args) {
+    if (!enabled || args->_renderMode != RenderArgs::DEFAULT_RENDER_MODE || args->_renderMethod != RenderArgs::DEFERRED ||
+            !isFar(args)) {
+        return;
+    }
+    if (!isCaptured()) {
+        requestCapture();
+        return;
+    }
+
+    glm::quat rotation = _modelTransform.getRotation();
+    glm::mat3 rotationMatrix = glm::mat3_cast(rotation);
+    glm::mat3 normalRotationMatrix = glm::mat3_cast(rotation * glm::inverse(_capturedRotation));
+    const glm::vec3& scale = _modelTransform.getScale();
+    float radius = _capturedRadius * std::max(scale.x, std::max(scale.y, scale.z)) / _capturedScale;
+
+    ImposterParameters parameters;
+    parameters.center = glm::vec4(_modelTransform.transform(_capturedLocalCenter), radius);
+    for (int i = 0; i < 3; i++) {
+        parameters.rotation[i] = glm::vec4(rotationMatrix[i], 0.0f);
+        parameters.normalRotation[i] = glm::vec4(normalRotationMatrix[i], 0.0f);
+    }
+    if (!_parametersBuffer) {
+        _parametersBuffer = std::make_shared<gpu::Buffer>(sizeof(ImposterParameters), (const gpu::Byte*) &parameters);
+    } else {
+        _parametersBuffer->setSubData(0, parameters);
+    }
+
+    gpu::Batch& batch = *(args->_batch);
+    batch.setPipeline(getPipeline());
+    batch.setModelTransform(Transform());
+    batch.setUniformBuffer(ru::Buffer::ImposterParams, _parametersBuffer);
+    batch.setResourceTexture(ru::Texture::ImposterColor, _atlas->getRenderBuffer(0));
+    batch.setResourceTexture(ru::Texture::ImposterNormal, _atlas->getRenderBuffer(1));
+    batch.setResourceTexture(ru::Texture::ImposterSpecular, _atlas->getRenderBuffer(2));
+    batch.setResourceTexture(ru::Texture::ImposterDepth, _atlas->getDepthStencilBuffer());
+    batch.draw(gpu::TRIANGLE_STRIP, 4);
+
+    // the pipeline of the next shape is set again, but not the textures
+    batch.setResourceTexture(ru::Texture::ImposterColor, nullptr);
+    batch.setResourceTexture(ru::Texture::ImposterNormal, nullptr);
+    batch.setResourceTexture(ru::Texture::ImposterSpecular, nullptr);
+    batch.setResourceTexture(ru::Texture::ImposterDepth, nullptr);
+}
+
+void ModelImposter::capture(const render::RenderContextPointer& renderContext, const render::ShapePlumberPointer& shapePlumber,
+        const LightingModelPointer& lightingModel) {
+    _isCapturePending = false;
+
+    RenderArgs* args = renderContext->args;
+    auto& scene = renderContext->_scene;
+
+    render::ItemBounds items;
+    AABox bound;
+    for (auto id : _partIDs) {
+        if (!scene->isAllocatedID(id)) {
+            continue;
+        }
+        auto& item = scene->getItem(id);
+        if (item.exist() && item.getKey().isOpaque()) {
+            items.emplace_back(id, item.getBound());
+            bound += item.getBound();
+        }
+    }
+    if (items.empty()) {
+        return;
+    }
+
+    glm::vec3 center = bound.calcCenter();
+    _capturedRadius = 0.5f * glm::length(bound.getDimensions());
+    _capturedRotation = _modelTransform.getRotation();
+    const glm::vec3& scale = _modelTransform.getScale();
+    _capturedScale = std::max(scale.x, std::max(scale.y, scale.z));
+    Transform inverseModel;
+    _capturedLocalCenter = _modelTransform.evalInverse(inverseModel).transform(center);
+    if (_capturedRadius <= 0.0f || _capturedScale <= 0.0f) {
+        return;
+    }
+
+    if (!_atlas) {
+        // the same formats as the deferred buffers the imposter is copied into
+        const int resolution = GRID_SIZE * CELL_RESOLUTION;
+        auto sampler = gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_POINT, gpu::Sampler::WRAP_CLAMP);
+        auto depthFormat = gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::DEPTH_STENCIL);
+        _atlas = gpu::FramebufferPointer(gpu::Framebuffer::create("imposter"));
+        _atlas->setRenderBuffer(0, gpu::Texture::createRenderBuffer(gpu::Element::COLOR_SRGBA_32, resolution, resolution,
+            gpu::Texture::SINGLE_MIP, sampler));
+        _atlas->setRenderBuffer(1, gpu::Texture::createRenderBuffer(gpu::Element::COLOR_RGBA_32, resolution, resolution,
+            gpu::Texture::SINGLE_MIP, sampler));
+        _atlas->setRenderBuffer(2, gpu::Texture::createRenderBuffer(gpu::Element::COLOR_RGBA_32, resolution, resolution,
+            gpu::Texture::SINGLE_MIP, sampler));
+        _atlas->setDepthStencilBuffer(gpu::Texture::createRenderBuffer(depthFormat, resolution, resolution,
+            gpu::Texture::SINGLE_MIP, sampler), depthFormat);
+    }
+
+    // From the lighting model define a global shapeKey ORED with individiual keys
+    render::ShapeKey::Builder keyBuilder;
+    if (lightingModel->isWireframeEnabled()) {
+        keyBuilder.withWireframe();
+    }
+    render::ShapeKey globalKey = keyBuilder.build();
+
+    glm::mat4 projMat = glm::ortho(-_capturedRadius, _capturedRadius, -_capturedRadius, _capturedRadius,
+        _capturedRadius, 3.0f * _capturedRadius);
+
+    // One batch per view, as the grouped draws of the parts are only recorded at the end of a batch
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            glm::vec3 back = _capturedRotation * octahedralDecode((glm::vec2(x, y) + 0.5f) / (float)GRID_SIZE);
+            Transform viewMat;
+            viewMat.setTranslation(center + 2.0f * _capturedRadius * back);
+            viewMat.setRotation(evalCellRotation(back));
+
+            gpu::doInBatch("ModelImposter::capture", args->_context, [&](gpu::Batch& batch) {
+                args->_batch = &batch;
+                batch.enableStereo(false);
+                batch.setFramebuffer(_atlas);
+                if (x == 0 && y == 0) {
+                    batch.clearFramebuffer(gpu::Framebuffer::BUFFER_COLORS | gpu::Framebuffer::BUFFER_DEPTH |
+                        gpu::Framebuffer::BUFFER_STENCIL, glm::vec4(0.0f), 1.0f, 0, true);
+                }
+
+                glm::ivec4 viewport(x * CELL_RESOLUTION, y * CELL_RESOLUTION, CELL_RESOLUTION, CELL_RESOLUTION);
+                batch.setViewportTransform(viewport);
+                batch.setStateScissorRect(viewport);
+
+                batch.setProjectionTransform(projMat);
+                batch.setProjectionJitter(0.0f, 0.0f);
+                batch.setViewTransform(viewMat);
+
+                batch.setUniformBuffer(ru::Buffer::LightModel, lightingModel->getParametersBuffer());
+                batch.setResourceTexture(ru::Texture::AmbientFresnel, lightingModel->getAmbientFresnelLUT());
+
+                render::renderShapes(renderContext, shapePlumber, items, -1, globalKey);
+                args->_batch = nullptr;
+            });
+        }
+    }
+
+    _isCaptured = true;
+}
+
+void ImposterPayload::updateKey(const render::ItemKey& key) {
+    // the imposter stands in for the opaque parts in the main view only
+    render::ItemKey::Builder builder(key);
+    builder.withTypeShape().withoutShadowCaster();
+    if (_cullWithParent) {
+        builder.withSubMetaCulled();
+    }
+    _itemKey = builder.build();
+}
+
+namespace render {
+template <> const ItemKey payloadGetKey(const ImposterPayload::Pointer& payload) {
+    if (payload) {
+        return payload->getKey();
+    }
+    return ItemKey::Builder::opaqueShape();
+}
+
+template <> const Item::Bound payloadGetBound(const ImposterPayload::Pointer& payload) {
+    if (payload) {
+        return payload->getBound();
+    }
+    return Item::Bound();
+}
+
+template <> const ShapeKey shapeGetShapeKey(const ImposterPayload::Pointer& payload) {
+    if (payload) {
+        return payload->getShapeKey();
+    }
+    return ShapeKey::Builder::invalid();
+}
+
+template <> void payloadRender(const ImposterPayload::Pointer& payload, RenderArgs* args) {
+    if (payload) {
+        payload->render(args);
+    }
+}
+}
+
+void CaptureImposters::configure(const Config& config) {
+    ModelImposter::enabled = config.useImposters;
+    float halfTan = tanf(glm::radians(config.maxAngle) * 0.5f);
+    ModelImposter::maxAngleHalfTanSq = halfTan * halfTan;
+    _capturesPerFrame = (size_t)std::max(config.capturesPerFrame, 0);
+}
+
+void CaptureImposters::run(const render::RenderContextPointer& renderContext, const LightingModelPointer& lightingModel) {
+    if (!ModelImposter::enabled) {
+        return;
+    }
+    for (auto& capture : ModelImposter::takePendingCaptures(_capturesPerFrame)) {
+        auto imposter = capture.lock();
+        if (imposter) {
+            imposter->capture(renderContext, _shapePlumber, lightingModel);
+        }
+    }
+}
@@ -0,0 +1,150 @@
+//
+//  ModelImposter.h
+//  libraries/render-utils/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ModelImposter_h
+#define hifi_ModelImposter_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <gpu/Batch.h>
+#include <render/Scene.h>
+#include <render/ShapePipeline.h>
+#include <Transform.h>
+
+#include "LightingModel.h"
+
+// An octahedral imposter of a model: its opaque parts captured into the deferred buffers from a grid of directions
+// all around it, drawn as a quad facing the nearest of them instead of the parts once the model is small enough on screen
+class ModelImposter : public std::enable_shared_from_this<ModelImposter> {
+public:
+    // the atlas has GRID_SIZE by GRID_SIZE views of CELL_RESOLUTION pixels
+    static const int GRID_SIZE = 8;
+    static const int CELL_RESOLUTION = 32;
+
+    // set from CaptureImposters config
+    static bool enabled;
+    // the square of the tangent of the half angle under which a model is drawn with its imposter
+    static float maxAngleHalfTanSq;
+
+    ModelImposter(const render::ItemIDs& partIDs) : _partIDs(partIDs) {}
+
+    // all of these are on the render thread, through the transactions of the model
+    void setBound(const AABox& bound);
+    void setModelTransform(const Transform& transform) { _modelTransform = transform; }
+    void setReady(bool ready) { _isReady = ready; }
+
+    const AABox& getBound() const { return _bound; }
+    const render::ItemIDs& getPartIDs() const { return _partIDs; }
+    bool isCaptured() const { return _atlas && _isCaptured; }
+
+    // whether the opaque parts give way to the imposter in this view
+    bool isActive(const RenderArgs* args) const;
+
+    void render(RenderArgs* args);
+    void capture(const render::RenderContextPointer& renderContext, const render::ShapePlumberPointer& shapePlumber,
+        const LightingModelPointer& lightingModel);
+
+    // the imposters that got far enough to be drawn before they were captured
+    static std::vector<std::weak_ptr<ModelImposter>> takePendingCaptures(size_t maxCaptures);
+
+private:
+    bool isFar(const RenderArgs* args) const;
+    void requestCapture();
+
+    static const gpu::PipelinePointer& getPipeline();
+
+    render::ItemIDs _partIDs;
+    AABox _bound;
+    Transform _modelTransform;
+    bool _isReady { false };
+
+    gpu::FramebufferPointer _atlas;
+    gpu::BufferPointer _parametersBuffer;
+    bool _isCaptured { false };
+    bool _isCapturePending { false };
+
+    // where the model was captured from, in its own frame so that it can move and scale since then
+    glm::vec3 _capturedLocalCenter;
+    float _capturedRadius { 0.0f };
+    float _capturedScale { 1.0f };
+    glm::quat _capturedRotation;
+
+    static std::mutex _pendingCapturesMutex;
+    static std::vector<std::weak_ptr<ModelImposter>> _pendingCaptures;
+};
+using ModelImposterPointer = std::shared_ptr<ModelImposter>;
+
+// The render item of an imposter, drawn with its own pipeline after the opaque parts of the deferred pass
+class ImposterPayload {
+public:
+    using Payload = render::Payload<ImposterPayload>;
+    using Pointer = Payload::DataPointer;
+
+    ImposterPayload(const ModelImposterPointer& imposter) : _imposter(imposter) {}
+
+    void updateKey(const render::ItemKey& key);
+    void setCullWithParent(bool value) { _cullWithParent = value; }
+
+    render::ItemKey getKey() const { return _itemKey; }
+    render::Item::Bound getBound() const { return _imposter->getBound(); }
+    render::ShapeKey getShapeKey() const { return render::ShapeKey::Builder::ownPipeline(); }
+    void render(RenderArgs* args) { _imposter->render(args); }
+
+    const ModelImposterPointer& getImposter() const { return _imposter; }
+
+private:
+    ModelImposterPointer _imposter;
+    render::ItemKey _itemKey { render::ItemKey::Builder::opaqueShape().withInvisible() };
+    bool _cullWithParent { false };
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const ImposterPayload::Pointer& payload);
+    template <> const Item::Bound payloadGetBound(const ImposterPayload::Pointer& payload);
+    template <> const ShapeKey shapeGetShapeKey(const ImposterPayload::Pointer& payload);
+    template <> void payloadRender(const ImposterPayload::Pointer& payload, RenderArgs* args);
+}
+
+class CaptureImpostersConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(bool useImposters MEMBER useImposters NOTIFY dirty)
+    Q_PROPERTY(float maxAngle MEMBER maxAngle NOTIFY dirty)
+    Q_PROPERTY(int capturesPerFrame MEMBER capturesPerFrame NOTIFY dirty)
+public:
+    // the job itself stays enabled, it turns the imposters on and off
+    bool useImposters { true };
+
+    // in degrees, the apparent size under which the models are drawn with their imposter
+    float maxAngle { 2.0f };
+
+    int capturesPerFrame { 1 };
+signals:
+    void dirty();
+};
+
+// Captures the imposters that were requested, a few per frame, before the deferred buffers of the frame are drawn
+class CaptureImposters {
+public:
+    using Config = CaptureImpostersConfig;
+    using JobModel = render::Job::ModelI<CaptureImposters, LightingModelPointer, Config>;
+
+    CaptureImposters(const render::ShapePlumberPointer& shapePlumber) : _shapePlumber(shapePlumber) {}
+
+    void configure(const Config& config);
+    void run(const render::RenderContextPointer& renderContext, const LightingModelPointer& lightingModel);
+
+private:
+    render::ShapePlumberPointer _shapePlumber;
+    size_t _capturesPerFrame { 1 };
+};
+
+#endif // hifi_ModelImposter_h
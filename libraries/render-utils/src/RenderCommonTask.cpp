@@ -42,7 +42,7 @@ void EndGPURangeTimer::run(const render::RenderContextPointer& renderContext, co
     });
     
     auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
-    config->setGPUBatchRunTime(timer->getGPUAverage(), timer->getBatchAverage());
+    config->setGPUBatchRunTime(*timer);
 }
 
 DrawLayered3D::DrawLayered3D(bool opaque) :
@@ -55,6 +55,7 @@
 #include "DrawHaze.h"
 #include "BloomEffect.h"
 #include "HighlightEffect.h"
+#include "ModelImposter.h"
 
 #include <sstream>
 
@@ -150,6 +151,9 @@ void RenderDeferredTask::build(JobModel& task, const render::Varying& input, ren
     // Prepare deferred, generate the shared Deferred Frame Transform. Only valid with the scaled frame buffer
     const auto deferredFrameTransform = task.addJob<GenerateDeferredFrameTransform>("DeferredFrameTransform", jitter);
 
+    // Capture the imposters of the models that got far enough, before the deferred buffers are bound for the frame
+    task.addJob<CaptureImposters>("CaptureImposters", lightingModel, shapePlumber);
+
     const auto prepareDeferredInputs = PrepareDeferred::Inputs(scaledPrimaryFramebuffer, lightingModel).asVarying();
     const auto prepareDeferredOutputs = task.addJob<PrepareDeferred>("PrepareDeferred", prepareDeferredInputs);
     const auto deferredFramebuffer = prepareDeferredOutputs.getN<PrepareDeferred::Outputs>(0);
@@ -168,6 +172,7 @@ void RenderDeferredTask::build(JobModel& task, const render::Varying& input, ren
     const auto linearDepthPassInputs = LinearDepthPass::Inputs(deferredFrameTransform, deferredFramebuffer).asVarying();
     const auto linearDepthPassOutputs = task.addJob<LinearDepthPass>("LinearDepth", linearDepthPassInputs);
     const auto linearDepthTarget = linearDepthPassOutputs.getN<LinearDepthPass::Outputs>(0);
+    task.addJob<ReadOcclusionDepth>("ReadOcclusionDepth", linearDepthTarget);
     
     // Curvature pass
     const auto surfaceGeometryPassInputs = SurfaceGeometryPass::Inputs(deferredFrameTransform, deferredFramebuffer, linearDepthTarget).asVarying();
@@ -428,13 +433,55 @@ gpu::FramebufferPointer PreparePrimaryFramebuffer::createFramebuffer(const char*
     return framebuffer;
 }
 
+// The dynamic scale changes by steps this big, once in that many frames at most, for the framebuffers not to be
+// rebuilt all the time and for the GPU frame time, averaged over frames, to catch up with the last change
+static const float DYNAMIC_SCALE_STEP = 0.05f;
+static const int DYNAMIC_SCALE_PERIOD = 30;
+
 void PreparePrimaryFramebuffer::configure(const Config& config) {
     _resolutionScale = config.getResolutionScale();
+    _dynamicResolution = config.dynamicResolution;
+    _targetFrameTime = config.targetFrameTime;
+    _minDynamicScale = glm::clamp(config.minDynamicScale, DYNAMIC_SCALE_STEP, 1.0f);
+}
+
+void PreparePrimaryFramebuffer::updateDynamicScale(double gpuFrameTime) {
+    if (!_dynamicResolution || _targetFrameTime <= 0.0f) {
+        _dynamicScale = 1.0f;
+        _numFramesSinceDynamicScale = 0;
+        return;
+    }
+
+    if (++_numFramesSinceDynamicScale < DYNAMIC_SCALE_PERIOD || gpuFrameTime <= 0.0) {
+        return;
+    }
+
+    // The GPU time goes with the number of pixels, the square of the scale. It goes back up one step at a time, and only
+    // with some room to spare, not to go back and forth around the target
+    const float SCALE_DOWN_THRESHOLD = 1.0f;
+    const float SCALE_UP_THRESHOLD = 0.8f;
+    float frameTimeRatio = (float)gpuFrameTime / _targetFrameTime;
+    float scale = _dynamicScale;
+    if (frameTimeRatio > SCALE_DOWN_THRESHOLD) {
+        scale = std::floor(_dynamicScale / sqrtf(frameTimeRatio) / DYNAMIC_SCALE_STEP) * DYNAMIC_SCALE_STEP;
+    } else if (frameTimeRatio < SCALE_UP_THRESHOLD) {
+        scale = _dynamicScale + DYNAMIC_SCALE_STEP;
+    }
+    scale = glm::clamp(scale, _minDynamicScale, 1.0f);
+
+    if (scale != _dynamicScale) {
+        _dynamicScale = scale;
+        _numFramesSinceDynamicScale = 0;
+    }
 }
 
 void PreparePrimaryFramebuffer::run(const RenderContextPointer& renderContext, Output& primaryFramebuffer) {
+    updateDynamicScale(renderContext->args->_context->getFrameTimerGPUAverage());
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+    config->dynamicScale = _dynamicScale;
+
     glm::uvec2 frameSize(renderContext->args->_viewport.z, renderContext->args->_viewport.w);
-    glm::uvec2 scaledFrameSize(glm::vec2(frameSize) * _resolutionScale);
+    glm::uvec2 scaledFrameSize(glm::vec2(frameSize) * _resolutionScale * _dynamicScale);
 
     // Resizing framebuffers instead of re-building them seems to cause issues with threaded 
     // rendering
@@ -467,9 +514,7 @@ void RenderTransparentDeferred::run(const RenderContextPointer& renderContext, c
 
     RenderArgs* args = renderContext->args;
 
-    gpu::doInBatch("RenderTransparentDeferred::run", args->_context, [&](gpu::Batch& batch) {
-        args->_batch = &batch;
-        
+    auto setupBatch = [&](gpu::Batch& batch) {
         // Setup camera, projection and viewport for all items
         batch.setViewportTransform(args->_viewport);
         batch.setStateScissorRect(args->_viewport);
@@ -499,24 +544,35 @@ void RenderTransparentDeferred::run(const RenderContextPointer& renderContext, c
                 batch.setUniformBuffer(graphics::slot::buffer::Buffer::HazeParams, hazePointer->getHazeParametersBuffer());
             }
         }
-
-        // From the lighting model define a global shapKey ORED with individiual keys
-        ShapeKey::Builder keyBuilder;
-        if (lightingModel->isWireframeEnabled()) {
-            keyBuilder.withWireframe();
-        }
-
-        ShapeKey globalKey = keyBuilder.build();
-        args->_globalShapeKey = globalKey._flags.to_ulong();
-
-        renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
-
-        args->_batch = nullptr;
-        args->_globalShapeKey = 0;
-
+    };
+    auto teardownBatch = [&](gpu::Batch& batch) {
         deferredLightingEffect->unsetLocalLightsBatch(batch);
         deferredLightingEffect->unsetKeyLightBatch(batch);
-    });
+    };
+
+    // From the lighting model define a global shapKey ORED with individiual keys
+    ShapeKey::Builder keyBuilder;
+    if (lightingModel->isWireframeEnabled()) {
+        keyBuilder.withWireframe();
+    }
+
+    ShapeKey globalKey = keyBuilder.build();
+    args->_globalShapeKey = globalKey._flags.to_ulong();
+
+    if (_parallelRecording) {
+        // the batches are appended in the order of their items, so the transparents still draw back to front
+        renderShapesInParallel(renderContext, _shapePlumber, inItems, "RenderTransparentDeferred::run", false,
+                               setupBatch, teardownBatch, _maxDrawn, globalKey);
+    } else {
+        gpu::doInBatch("RenderTransparentDeferred::run", args->_context, [&](gpu::Batch& batch) {
+            args->_batch = &batch;
+            setupBatch(batch);
+            renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            teardownBatch(batch);
+            args->_batch = nullptr;
+        });
+    }
+    args->_globalShapeKey = 0;
 
     config->setNumDrawn((int)inItems.size());
 }
@@ -533,9 +589,7 @@ void DrawStateSortDeferred::run(const RenderContextPointer& renderContext, const
 
     RenderArgs* args = renderContext->args;
 
-    gpu::doInBatch("DrawStateSortDeferred::run", args->_context, [&](gpu::Batch& batch) {
-        args->_batch = &batch;
-
+    auto setupBatch = [&](gpu::Batch& batch) {
         // Setup camera, projection and viewport for all items
         batch.setViewportTransform(args->_viewport);
         batch.setStateScissorRect(args->_viewport);
@@ -552,24 +606,33 @@ void DrawStateSortDeferred::run(const RenderContextPointer& renderContext, const
         // Setup lighting model for all items;
         batch.setUniformBuffer(ru::Buffer::LightModel, lightingModel->getParametersBuffer());
         batch.setResourceTexture(ru::Texture::AmbientFresnel, lightingModel->getAmbientFresnelLUT());
+    };
 
-        // From the lighting model define a global shapeKey ORED with individiual keys
-        ShapeKey::Builder keyBuilder;
-        if (lightingModel->isWireframeEnabled()) {
-            keyBuilder.withWireframe();
-        }
-
-        ShapeKey globalKey = keyBuilder.build();
-        args->_globalShapeKey = globalKey._flags.to_ulong();
+    // From the lighting model define a global shapeKey ORED with individiual keys
+    ShapeKey::Builder keyBuilder;
+    if (lightingModel->isWireframeEnabled()) {
+        keyBuilder.withWireframe();
+    }
 
-        if (_stateSort) {
-            renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
-        } else {
-            renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
-        }
-        args->_batch = nullptr;
-        args->_globalShapeKey = 0;
-    });
+    ShapeKey globalKey = keyBuilder.build();
+    args->_globalShapeKey = globalKey._flags.to_ulong();
+
+    if (_parallelRecording) {
+        renderShapesInParallel(renderContext, _shapePlumber, inItems, "DrawStateSortDeferred::run", _stateSort,
+                               setupBatch, nullptr, _maxDrawn, globalKey);
+    } else {
+        gpu::doInBatch("DrawStateSortDeferred::run", args->_context, [&](gpu::Batch& batch) {
+            args->_batch = &batch;
+            setupBatch(batch);
+            if (_stateSort) {
+                renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            } else {
+                renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            }
+            args->_batch = nullptr;
+        });
+    }
+    args->_globalShapeKey = 0;
 
     config->setNumDrawn((int)inItems.size());
 }
@@ -23,6 +23,7 @@ class RenderTransparentDeferredConfig : public render::Job::Config {
     Q_OBJECT
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY newStats)
     Q_PROPERTY(int maxDrawn MEMBER maxDrawn NOTIFY dirty)
+    Q_PROPERTY(bool parallelRecording MEMBER parallelRecording NOTIFY dirty)
 
 public:
     int getNumDrawn() { return _numDrawn; }
@@ -32,6 +33,7 @@ public:
     }
 
     int maxDrawn{ -1 };
+    bool parallelRecording{ false };
 
 signals:
     void newStats();
@@ -50,12 +52,16 @@ public:
     RenderTransparentDeferred(render::ShapePlumberPointer shapePlumber)
         : _shapePlumber{ shapePlumber } {}
 
-    void configure(const Config& config) { _maxDrawn = config.maxDrawn; }
+    void configure(const Config& config) {
+        _maxDrawn = config.maxDrawn;
+        _parallelRecording = config.parallelRecording;
+    }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
     int _maxDrawn;  // initialized by Config
+    bool _parallelRecording;
 };
 
 class DrawStateSortConfig : public render::Job::Config {
@@ -63,6 +69,7 @@ class DrawStateSortConfig : public render::Job::Config {
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
     Q_PROPERTY(int maxDrawn MEMBER maxDrawn NOTIFY dirty)
     Q_PROPERTY(bool stateSort MEMBER stateSort NOTIFY dirty)
+    Q_PROPERTY(bool parallelRecording MEMBER parallelRecording NOTIFY dirty)
 public:
     int getNumDrawn() { return numDrawn; }
     void setNumDrawn(int num) {
@@ -73,6 +80,9 @@ public:
     int maxDrawn{ -1 };
     bool stateSort{ true };
 
+    // records the items into several batches at once, on the render recording threads
+    bool parallelRecording{ false };
+
 signals:
     void numDrawnChanged();
     void dirty();
@@ -95,6 +105,7 @@ public:
     void configure(const Config& config) {
         _maxDrawn = config.maxDrawn;
         _stateSort = config.stateSort;
+        _parallelRecording = config.parallelRecording;
     }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
@@ -102,6 +113,7 @@ protected:
     render::ShapePlumberPointer _shapePlumber;
     int _maxDrawn;  // initialized by Config
     bool _stateSort;
+    bool _parallelRecording;
 };
 
 class SetSeparateDeferredDepthBuffer {
@@ -153,7 +165,20 @@ private:
 class PreparePrimaryFramebufferConfig : public render::Job::Config {
     Q_OBJECT
     Q_PROPERTY(float resolutionScale  WRITE setResolutionScale READ getResolutionScale)
+    Q_PROPERTY(bool dynamicResolution MEMBER dynamicResolution NOTIFY dirty)
+    Q_PROPERTY(float targetFrameTime MEMBER targetFrameTime NOTIFY dirty)
+    Q_PROPERTY(float minDynamicScale MEMBER minDynamicScale NOTIFY dirty)
+    Q_PROPERTY(float dynamicScale READ getDynamicScale)
 public:
+    // scale the resolution down, and back up, on top of the resolution scale to keep the GPU frame time,
+    // in msecs, under the target
+    bool dynamicResolution { false };
+    float targetFrameTime { 11.1f };
+    float minDynamicScale { 0.5f };
+
+    float dynamicScale { 1.0f };
+    float getDynamicScale() const { return dynamicScale; }
+
     float getResolutionScale() const { return resolutionScale; }
     void setResolutionScale(float scale) {
         const float SCALE_RANGE_MIN = 0.1f;
@@ -183,6 +208,14 @@ public:
     float _resolutionScale{ 1.0f };
 
 private:
+    void updateDynamicScale(double gpuFrameTime);
+
+    bool _dynamicResolution { false };
+    float _targetFrameTime { 11.1f };
+    float _minDynamicScale { 0.5f };
+    float _dynamicScale { 1.0f };
+    int _numFramesSinceDynamicScale { 0 };
+
 
     static gpu::FramebufferPointer createFramebuffer(const char* name, const glm::uvec2& size);
 };
@@ -13,6 +13,8 @@
 #include "RenderPipelines.h"
 
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 
 #include <gpu/Context.h>
 #include <material-networking/TextureCache.h>
@@ -373,10 +375,48 @@ bool RenderPipelines::bindMaterial(graphics::MaterialPointer& material, gpu::Bat
     return bindMaterials(multiMaterial, batch, renderMode, enableTextures);
 }
 
-void RenderPipelines::updateMultiMaterial(graphics::MultiMaterial& multiMaterial) {
-    auto& schemaBuffer = multiMaterial.getSchemaBuffer();
+static const size_t MIN_SHARED_MATERIAL_OBJECTS_PRUNE_SIZE = 64;
+
+// The schema buffers and texture tables of the multi-materials, keyed by their contents, so that all the items with the
+// same materials share them, upload them once and keep the same bindings from one draw to the next
+template <typename T>
+class SharedMaterialObjects {
+public:
+    std::shared_ptr<T> find(const std::string& key, const std::function<std::shared_ptr<T>()>& create) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _objects.find(key);
+        if (it != _objects.end()) {
+            if (auto object = it->second.lock()) {
+                return object;
+            }
+        }
+        if (_objects.size() >= _pruneSize) {
+            for (auto expiredIt = _objects.begin(); expiredIt != _objects.end();) {
+                if (expiredIt->second.expired()) {
+                    expiredIt = _objects.erase(expiredIt);
+                } else {
+                    ++expiredIt;
+                }
+            }
+            _pruneSize = std::max(MIN_SHARED_MATERIAL_OBJECTS_PRUNE_SIZE, 2 * _objects.size());
+        }
+        auto object = create();
+        _objects[key] = object;
+        return object;
+    }
 
-    auto& drawMaterialTextures = multiMaterial.getTextureTable();
+private:
+    std::mutex _mutex;
+    std::unordered_map<std::string, std::weak_ptr<T>> _objects;
+    size_t _pruneSize { MIN_SHARED_MATERIAL_OBJECTS_PRUNE_SIZE };
+};
+
+static SharedMaterialObjects<gpu::Buffer> sharedSchemaBuffers;
+static SharedMaterialObjects<gpu::TextureTable> sharedTextureTables;
+
+void RenderPipelines::updateMultiMaterial(graphics::MultiMaterial& multiMaterial) {
+    // the textures are set on a copy of the table, which is then swapped for the shared one with the same textures
+    auto drawMaterialTextures = std::make_shared<gpu::TextureTable>(multiMaterial.getTextureTable()->getTextures());
     multiMaterial.setTexturesLoading(false);
 
     // The total list of things we need to look for
@@ -737,7 +777,22 @@ void RenderPipelines::updateMultiMaterial(graphics::MultiMaterial& multiMaterial
     }
 
     schema._key = (uint32_t)schemaKey._flags.to_ulong();
-    schemaBuffer.edit<graphics::MultiMaterial::Schema>() = schema;
+
+    const auto schemaSize = sizeof(graphics::MultiMaterial::Schema);
+    std::string schemaKeyBytes((const char*)&schema, schemaSize);
+    multiMaterial.setSchemaBuffer(gpu::BufferView(sharedSchemaBuffers.find(schemaKeyBytes, [&] {
+        return std::make_shared<gpu::Buffer>(schemaSize, (const gpu::Byte*)&schema, schemaSize);
+    })));
+
+    auto textures = drawMaterialTextures->getTextures();
+    std::string texturesKey;
+    texturesKey.reserve(textures.size() * sizeof(const gpu::Texture*));
+    for (const auto& texture : textures) {
+        const gpu::Texture* pointer = texture.get();
+        texturesKey.append((const char*)&pointer, sizeof(pointer));
+    }
+    multiMaterial.setTextureTable(sharedTextureTables.find(texturesKey, [&] { return drawMaterialTextures; }));
+
     multiMaterial.setNeedsUpdate(false);
     multiMaterial.setInitialized();
 }
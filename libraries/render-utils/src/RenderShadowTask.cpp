@@ -13,6 +13,7 @@
 
 #include <gpu/Context.h>
 
+#include <RegisteredMetaTypes.h>
 #include <ViewFrustum.h>
 
 #include <render/CullTask.h>
@@ -203,6 +204,36 @@ static void adjustNearFar(const AABox& inShapeBounds, ViewFrustum& shadowFrustum
     }
 }
 
+// Hashes the casters and the stamps of their items, a change to any of them changes the hash whatever the order of the shapes.
+// The deformed and fading casters change every frame without their items being updated, so they can't be cached
+static size_t hashCasters(const render::ScenePointer& scene, const render::ShapeBounds& inShapes, bool& hasDynamicCasters) {
+    size_t hash = 0;
+    hasDynamicCasters = false;
+    for (const auto& items : inShapes) {
+        if (items.second.empty()) {
+            continue;
+        }
+        if (items.first.isDeformed() || items.first.isFaded()) {
+            hasDynamicCasters = true;
+        }
+        for (const auto& item : items.second) {
+            size_t itemHash = 0;
+            std::hash_combine(itemHash, item.id, scene->getItemStamp(item.id));
+            hash += itemHash;
+        }
+    }
+    return hash;
+}
+
+static bool isSameFrustum(const ViewFrustum& frustum, const ViewFrustum& otherFrustum) {
+    return frustum.getView() == otherFrustum.getView() && frustum.getProjection() == otherFrustum.getProjection();
+}
+
+void RenderShadowMap::configure(const Config& config) {
+    _cacheCascade = config.cacheCascade;
+    _farCascadeUpdatePeriod = config.farCascadeUpdatePeriod;
+}
+
 void RenderShadowMap::run(const render::RenderContextPointer& renderContext, const Inputs& inputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -228,6 +259,30 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
     // Adjust the frustum near and far depths based on the rendered items bounding box to have
     // the minimal Z range.
     adjustNearFar(inShapeBounds, adjustedShadowFrustum);
+
+    // The depth left in the cascade is kept, along with the frustum it was rendered with, if nothing changed since then.
+    // The far cascades are only rendered again once in a while, in which time they lag behind the view
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+    bool hasDynamicCasters;
+    auto castersHash = hashCasters(renderContext->_scene, inShapes, hasDynamicCasters);
+    ++_numFramesSinceRender;
+    if (_cacheCascade && _cachedShadow.lock() == shadow) {
+        bool isUnchanged = !hasDynamicCasters && castersHash == _cachedCastersHash &&
+            isSameFrustum(adjustedShadowFrustum, _cachedFrustum);
+        bool isDue = _cascadeIndex < FAR_CASCADE_INDEX || _numFramesSinceRender >= _farCascadeUpdatePeriod;
+        if (isUnchanged || !isDue) {
+            shadow->setCascadeFrustum(_cascadeIndex, _cachedFrustum);
+            args->popViewFrustum();
+            args->pushViewFrustum(_cachedFrustum);
+            config->cached = true;
+            return;
+        }
+    }
+    _cachedShadow = shadow;
+    _cachedFrustum = adjustedShadowFrustum;
+    _cachedCastersHash = castersHash;
+    _numFramesSinceRender = 0;
+    config->cached = false;
     // Reapply the frustum as it has been adjusted
     shadow->setCascadeFrustum(_cascadeIndex, adjustedShadowFrustum);
     args->popViewFrustum();
@@ -15,6 +15,8 @@
 #include <gpu/Framebuffer.h>
 #include <gpu/Pipeline.h>
 
+#include <ViewFrustum.h>
+
 #include <render/CullTask.h>
 
 #include "Shadows_shared.slh"
@@ -22,19 +24,50 @@
 #include "LightingModel.h"
 #include "LightStage.h"
 
-class ViewFrustum;
+class RenderShadowMapConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(bool cacheCascade MEMBER cacheCascade NOTIFY dirty)
+    Q_PROPERTY(int farCascadeUpdatePeriod MEMBER farCascadeUpdatePeriod NOTIFY dirty)
+    Q_PROPERTY(bool isCached READ isCached)
+public:
+    // keep the depth of the cascade from the last frame when neither its frustum nor its casters changed
+    bool cacheCascade { true };
+
+    // the far cascades are only rendered again once in this many frames, whatever changed in them
+    int farCascadeUpdatePeriod { 4 };
+
+    bool cached { false };
+    bool isCached() const { return cached; }
+
+signals:
+    void dirty();
+};
 
 class RenderShadowMap {
 public:
     using Inputs = render::VaryingSet3<render::ShapeBounds, AABox, LightStage::ShadowFramePointer>;
-    using JobModel = render::Job::ModelI<RenderShadowMap, Inputs>;
+    using Config = RenderShadowMapConfig;
+    using JobModel = render::Job::ModelI<RenderShadowMap, Inputs, Config>;
+
+    // the cascades from this one on are the far ones
+    static const unsigned int FAR_CASCADE_INDEX = 2;
 
     RenderShadowMap(render::ShapePlumberPointer shapePlumber, unsigned int cascadeIndex) : _shapePlumber{ shapePlumber }, _cascadeIndex{ cascadeIndex } {}
+    void configure(const Config& config);
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
     unsigned int _cascadeIndex;
+
+    bool _cacheCascade { true };
+    int _farCascadeUpdatePeriod { 4 };
+
+    // what the depth left in the cascade was rendered with
+    std::weak_ptr<LightStage::Shadow> _cachedShadow;
+    ViewFrustum _cachedFrustum;
+    size_t _cachedCastersHash { 0 };
+    int _numFramesSinceRender { 0 };
 };
 
 //class RenderShadowTaskConfig : public render::Task::Config::Persistent {
@@ -14,6 +14,7 @@
 #include "RenderCommonTask.h"
 #include "RenderDeferredTask.h"
 #include "RenderForwardTask.h"
+#include "SkinnedMesh.h"
 
 void RenderShadowsAndDeferredTask::build(JobModel& task, const render::Varying& input, render::Varying& output, render::CullFunctor cullFunctor, uint8_t tagBits, uint8_t tagMask) {
     task.addJob<SetRenderMethod>("SetRenderMethodTask", render::Args::DEFERRED);
@@ -47,6 +48,9 @@ void RenderViewTask::build(JobModel& task, const render::Varying& input, render:
     const auto lightingStageFramesAndZones = task.addJob<AssembleLightingStageTask>("AssembleStages", items);
 
 #ifndef Q_OS_ANDROID
+        // Deform the skinned meshes once for all the passes of the view
+        task.addJob<SkinMeshes>("SkinMeshes");
+
         const auto deferredForwardIn = DeferredForwardSwitchJob::Input(items, lightingModel, lightingStageFramesAndZones).asVarying();
         task.addJob<DeferredForwardSwitchJob>("DeferredForwardSwitch", deferredForwardIn, cullFunctor, tagBits, tagMask);
 #else
@@ -0,0 +1,202 @@
+//
+//  SkinnedMesh.cpp
+//  libraries/render-utils/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SkinnedMesh.h"
+
+#include <gpu/Context.h>
+#include <graphics/ShaderConstants.h>
+#include <shaders/Shaders.h>
+
+#include "render-utils/ShaderConstants.h"
+
+namespace ru {
+    using render_utils::slot::texture::Texture;
+}
+
+#ifdef Q_OS_ANDROID
+// the skinned vertices are rendered to float textures, which not every GLES device can do
+bool SkinnedMesh::enabled { false };
+#else
+bool SkinnedMesh::enabled { true };
+#endif
+
+std::atomic<uint32_t> SkinnedMesh::_frame { 0 };
+std::mutex SkinnedMesh::_activeMeshesMutex;
+std::vector<std::weak_ptr<SkinnedMesh>> SkinnedMesh::_activeMeshes;
+
+// how many frames a mesh is still skinned for after it was last drawn, so that it stays ready in the views that draw it
+// every other frame, like the secondary camera
+static const uint32_t MAX_IDLE_FRAMES = 4;
+
+bool SkinnedMesh::requestSkinning(const std::shared_ptr<const graphics::Mesh>& mesh, const gpu::BufferPointer& clusterBuffer,
+        bool isDualQuaternion, const gpu::BufferPointer& blendshapeBuffer, const gpu::BufferPointer& blendshapeCoefficientsBuffer,
+        uint16_t deformations) {
+    if (!enabled || !mesh || mesh->getNumVertices() == 0) {
+        return false;
+    }
+
+    bool isSkinned;
+    bool wasActive;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        uint32_t frame = _frame;
+        _mesh = mesh;
+        _clusterBuffer = clusterBuffer;
+        _isDualQuaternion = isDualQuaternion;
+        _blendshapeBuffer = blendshapeBuffer;
+        _blendshapeCoefficientsBuffer = blendshapeCoefficientsBuffer;
+        _deformations = deformations;
+        _requestedFrame = frame;
+        wasActive = _isActive;
+        _isActive = true;
+
+        // the cluster buffers of the parts of a mesh all hold the same clusters, a new blendshape buffer means new offsets,
+        // while the blendshape coefficients are updated in place before the frame
+        isSkinned = _framebuffer && _skinnedFrame == frame && _skinnedDeformations == deformations &&
+            _skinnedDualQuaternion == isDualQuaternion && _skinnedBlendshapeBuffer == blendshapeBuffer;
+    }
+
+    if (!wasActive) {
+        std::lock_guard<std::mutex> activeLock(_activeMeshesMutex);
+        _activeMeshes.push_back(shared_from_this());
+    }
+    return isSkinned;
+}
+
+void SkinnedMesh::bind(gpu::Batch& batch) const {
+    batch.setResourceTexture(ru::Texture::SkinnedPositionNormal, _framebuffer->getRenderBuffer(0));
+    batch.setResourceTexture(ru::Texture::SkinnedNormalTangent, _framebuffer->getRenderBuffer(1));
+}
+
+const gpu::PipelinePointer& SkinnedMesh::getPipeline(bool isDualQuaternion) {
+    static gpu::PipelinePointer pipeline;
+    static gpu::PipelinePointer dualQuaternionPipeline;
+    if (!pipeline) {
+        auto state = std::make_shared<gpu::State>();
+        state->setDepthTest(false, false, gpu::LESS_EQUAL);
+        state->setCullMode(gpu::State::CULL_NONE);
+        pipeline = gpu::Pipeline::create(gpu::Shader::createProgram(shader::render_utils::program::skin_vertices), state);
+        dualQuaternionPipeline = gpu::Pipeline::create(
+            gpu::Shader::createProgram(shader::render_utils::program::skin_vertices_deformeddq), state);
+    }
+    return isDualQuaternion ? dualQuaternionPipeline : pipeline;
+}
+
+void SkinnedMesh::skin(gpu::Batch& batch) {
+    std::shared_ptr<const graphics::Mesh> mesh;
+    gpu::BufferPointer clusterBuffer;
+    gpu::BufferPointer blendshapeBuffer;
+    gpu::BufferPointer blendshapeCoefficientsBuffer;
+    bool isDualQuaternion;
+    uint16_t deformations;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        mesh = _mesh;
+        clusterBuffer = _clusterBuffer;
+        blendshapeBuffer = _blendshapeBuffer;
+        blendshapeCoefficientsBuffer = _blendshapeCoefficientsBuffer;
+        isDualQuaternion = _isDualQuaternion;
+        deformations = _deformations;
+    }
+    if (!mesh || deformations == 0) {
+        return;
+    }
+
+    auto numVertices = (uint32_t)mesh->getNumVertices();
+    uint16_t rows = (uint16_t)((numVertices + TEXTURE_WIDTH - 1) / TEXTURE_WIDTH);
+    if (!_framebuffer || _framebuffer->getHeight() != rows) {
+        auto format = gpu::Element(gpu::VEC4, gpu::FLOAT, gpu::RGBA);
+        auto sampler = gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_POINT, gpu::Sampler::WRAP_CLAMP);
+        _framebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("skinnedMesh"));
+        _framebuffer->setRenderBuffer(0, gpu::Texture::createRenderBuffer(format, TEXTURE_WIDTH, rows, gpu::Texture::SINGLE_MIP, sampler));
+        _framebuffer->setRenderBuffer(1, gpu::Texture::createRenderBuffer(format, TEXTURE_WIDTH, rows, gpu::Texture::SINGLE_MIP, sampler));
+    }
+
+    batch.setFramebuffer(_framebuffer);
+    batch.setViewportTransform(glm::ivec4(0, 0, TEXTURE_WIDTH, rows));
+    batch.setPipeline(getPipeline(isDualQuaternion));
+    batch._glUniform1f(render_utils::slot::uniform::SkinnedVerticesRows, (float)rows);
+
+    batch.setInputFormat(mesh->getVertexFormat());
+    batch.setInputStream(0, mesh->getVertexStream());
+    if (clusterBuffer) {
+        batch.setUniformBuffer(graphics::slot::buffer::Skinning, clusterBuffer);
+    }
+    if (blendshapeBuffer) {
+        batch.setResourceBuffer(0, blendshapeBuffer);
+    }
+    if (blendshapeCoefficientsBuffer) {
+        batch.setResourceBuffer(1, blendshapeCoefficientsBuffer);
+    }
+    batch.setModelTransform(Transform());
+    batch.setDrawcallUniform(deformations);
+    batch.draw(gpu::POINTS, numVertices, 0);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _skinnedBlendshapeBuffer = blendshapeBuffer;
+    _skinnedDualQuaternion = isDualQuaternion;
+    _skinnedDeformations = deformations;
+    _skinnedFrame = _frame;
+}
+
+std::vector<std::shared_ptr<SkinnedMesh>> SkinnedMesh::beginFrame() {
+    uint32_t frame = ++_frame;
+
+    std::vector<std::shared_ptr<SkinnedMesh>> meshes;
+    std::lock_guard<std::mutex> activeLock(_activeMeshesMutex);
+    auto it = _activeMeshes.begin();
+    while (it != _activeMeshes.end()) {
+        auto mesh = it->lock();
+        bool isIdle = true;
+        if (mesh) {
+            std::lock_guard<std::mutex> lock(mesh->_mutex);
+            isIdle = !enabled || frame - mesh->_requestedFrame > MAX_IDLE_FRAMES;
+            if (isIdle) {
+                // the textures come back with the next request
+                mesh->_isActive = false;
+                mesh->_mesh.reset();
+                mesh->_clusterBuffer.reset();
+                mesh->_blendshapeBuffer.reset();
+                mesh->_blendshapeCoefficientsBuffer.reset();
+                mesh->_skinnedBlendshapeBuffer.reset();
+                mesh->_framebuffer.reset();
+            }
+        }
+        if (isIdle) {
+            it = _activeMeshes.erase(it);
+        } else {
+            meshes.push_back(mesh);
+            ++it;
+        }
+    }
+    return meshes;
+}
+
+void SkinMeshes::configure(const Config& config) {
+    SkinnedMesh::enabled = config.skinOnce;
+}
+
+void SkinMeshes::run(const render::RenderContextPointer& renderContext) {
+    auto meshes = SkinnedMesh::beginFrame();
+    if (meshes.empty()) {
+        return;
+    }
+
+    RenderArgs* args = renderContext->args;
+    gpu::doInBatch("SkinMeshes::run", args->_context, [&](gpu::Batch& batch) {
+        batch.enableStereo(false);
+        for (auto& mesh : meshes) {
+            mesh->skin(batch);
+        }
+        batch.setResourceBuffer(0, nullptr);
+        batch.setResourceBuffer(1, nullptr);
+        batch.setUniformBuffer(graphics::slot::buffer::Skinning, nullptr);
+    });
+}
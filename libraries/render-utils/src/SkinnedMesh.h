@@ -0,0 +1,95 @@
+//
+//  SkinnedMesh.h
+//  libraries/render-utils/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SkinnedMesh_h
+#define hifi_SkinnedMesh_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <gpu/Batch.h>
+#include <graphics/Geometry.h>
+#include <render/Engine.h>
+
+// The vertices of a deformed mesh of a model, skinned and blended once per frame by the SkinMeshes job into a pair of
+// textures that the parts of the mesh read from instead of deforming the vertices again in every pass that draws them
+class SkinnedMesh : public std::enable_shared_from_this<SkinnedMesh> {
+public:
+    // Must match SKINNED_VERTICES_WIDTH in SkinnedVertices.slh
+    static const int TEXTURE_WIDTH = 1024;
+
+    // Must match MESH_DEFORMER_SKINNED_VERTICES_BIT in MeshDeformer.slh
+    static const uint16_t SKINNED_VERTICES_BIT = 0x0004;
+
+    // set from SkinMeshes config
+    static bool enabled;
+
+    // On the render thread, from the parts of the mesh as they are drawn. The vertices are skinned with these inputs
+    // from the next frame on, returns whether they already were for this one
+    bool requestSkinning(const std::shared_ptr<const graphics::Mesh>& mesh, const gpu::BufferPointer& clusterBuffer,
+        bool isDualQuaternion, const gpu::BufferPointer& blendshapeBuffer, const gpu::BufferPointer& blendshapeCoefficientsBuffer,
+        uint16_t deformations);
+
+    void bind(gpu::Batch& batch) const;
+
+    void skin(gpu::Batch& batch);
+
+    // starts the frame of the skinning pre-pass, returns the meshes that were drawn in the last ones
+    static std::vector<std::shared_ptr<SkinnedMesh>> beginFrame();
+
+private:
+    static const gpu::PipelinePointer& getPipeline(bool isDualQuaternion);
+
+    mutable std::mutex _mutex;
+    std::shared_ptr<const graphics::Mesh> _mesh;
+    gpu::BufferPointer _clusterBuffer;
+    gpu::BufferPointer _blendshapeBuffer;
+    gpu::BufferPointer _blendshapeCoefficientsBuffer;
+    bool _isDualQuaternion { false };
+    uint16_t _deformations { 0 };
+    uint32_t _requestedFrame { 0 };
+    bool _isActive { false };
+
+    gpu::FramebufferPointer _framebuffer;
+    // what the vertices in the framebuffer were skinned with
+    gpu::BufferPointer _skinnedBlendshapeBuffer;
+    bool _skinnedDualQuaternion { false };
+    uint16_t _skinnedDeformations { 0 };
+    uint32_t _skinnedFrame { 0 };
+
+    static std::atomic<uint32_t> _frame;
+    static std::mutex _activeMeshesMutex;
+    static std::vector<std::weak_ptr<SkinnedMesh>> _activeMeshes;
+};
+using SkinnedMeshPointer = std::shared_ptr<SkinnedMesh>;
+
+class SkinMeshesConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(bool skinOnce MEMBER skinOnce NOTIFY dirty)
+public:
+    // the job itself stays enabled, without it the meshes are deformed in the vertex shader of every pass
+    bool skinOnce { true };
+signals:
+    void dirty();
+};
+
+// Skins the deformed meshes drawn in the last frames once, before any pass of the view draws them
+class SkinMeshes {
+public:
+    using Config = SkinMeshesConfig;
+    using JobModel = render::Job::Model<SkinMeshes, Config>;
+
+    void configure(const Config& config);
+    void run(const render::RenderContextPointer& renderContext);
+};
+
+#endif // hifi_SkinnedMesh_h
@@ -12,8 +12,10 @@
 
 #include <limits>
 #include <MathUtils.h>
+#include <SharedUtil.h>
 
 #include <gpu/Context.h>
+#include <render/OcclusionCulling.h>
 #include <shaders/Shaders.h>
 
 #include "StencilMaskPass.h"
@@ -219,10 +221,51 @@ void LinearDepthPass::run(const render::RenderContextPointer& renderContext, con
     });
 
     auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
-    config->setGPUBatchRunTime(_gpuTimer->getGPUAverage(), _gpuTimer->getBatchAverage());
+    config->setGPUBatchRunTime(*_gpuTimer);
 }
 
 
+void ReadOcclusionDepth::run(const render::RenderContextPointer& renderContext, const Inputs& linearDepthFramebuffer) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+    RenderArgs* args = renderContext->args;
+
+    if (args->_renderMode != RenderArgs::DEFAULT_RENDER_MODE || args->isStereo() || !linearDepthFramebuffer) {
+        return;
+    }
+    auto stage = renderContext->_scene->getStage<render::OcclusionStage>();
+    if (!stage || !stage->beginDepthRead()) {
+        return;
+    }
+
+    auto framebuffer = linearDepthFramebuffer->getDownsampleFramebuffer();
+    auto region = args->_viewport >> 1;
+    const auto& frustum = args->getViewFrustum();
+    auto view = frustum.getView();
+    auto projection = frustum.getProjection();
+    auto nearClip = frustum.getNearClip();
+    auto timestamp = usecTimestampNow();
+
+    std::weak_ptr<gpu::Context> weakContext = args->_context;
+    std::weak_ptr<render::OcclusionStage> weakStage = stage;
+    gpu::doInBatch("ReadOcclusionDepth::run", args->_context, [=](gpu::Batch& batch) {
+        batch.runLambda([=] {
+            auto context = weakContext.lock();
+            if (!context) {
+                return;
+            }
+            context->readFramebufferAsync(framebuffer, region, [=](const std::vector<float>& pixels) {
+                auto stage = weakStage.lock();
+                if (stage) {
+                    stage->setPyramid(std::make_shared<render::HiZPyramid>(pixels, glm::ivec2(region.z, region.w), view,
+                        projection, nearClip, timestamp));
+                    stage->endDepthRead();
+                }
+            });
+        });
+    });
+}
+
 const gpu::PipelinePointer& LinearDepthPass::getLinearDepthPipeline(const render::RenderContextPointer& renderContext) {
     gpu::ShaderPointer program;
     if (!_linearDepthPipeline) {
@@ -529,7 +572,7 @@ void SurfaceGeometryPass::run(const render::RenderContextPointer& renderContext,
        
  
     auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
-    config->setGPUBatchRunTime(_gpuTimer->getGPUAverage(), _gpuTimer->getBatchAverage());
+    config->setGPUBatchRunTime(*_gpuTimer);
 }
 
 const gpu::PipelinePointer& SurfaceGeometryPass::getCurvaturePipeline(const render::RenderContextPointer& renderContext) {
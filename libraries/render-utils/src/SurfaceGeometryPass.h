@@ -92,6 +92,17 @@ private:
     gpu::RangeTimerPointer _gpuTimer;
 };
 
+// Reads the half resolution linear depth of the main view back to build the Hi-Z pyramid the occlusion culling of the
+// frames after it tests against. The downsampled depth keeps the nearest of each 2 by 2 pixels, so a gap thinner than
+// that doesn't show what is behind it
+class ReadOcclusionDepth {
+public:
+    using Inputs = LinearDepthFramebufferPointer;
+    using JobModel = render::Job::ModelI<ReadOcclusionDepth, Inputs>;
+
+    void run(const render::RenderContextPointer& renderContext, const Inputs& linearDepthFramebuffer);
+};
+
 
 // SurfaceGeometryFramebuffer is  a helper class gathering in one place theframebuffers and targets describing the surface geometry linear depth and curvature generated
 // from a z buffer and a normal buffer
@@ -28,9 +28,10 @@ public:
     
     void draw(gpu::Batch& batch, float x, float y, const glm::vec2& bounds,
               const QString& str, const glm::vec4& color, bool unlit, bool forward);
+    // batched opaque text is drawn at the end of the batch, see Font::drawString
     void draw(gpu::Batch& batch, float x, float y, const glm::vec2& bounds, float scale,
               const QString& str, const QString& font, const glm::vec4& color, const glm::vec3& effectColor,
-              float effectThickness, TextEffect effect, bool unlit, bool forward);
+              float effectThickness, TextEffect effect, bool unlit, bool forward, bool batched = false);
 
 private:
     TextRenderer3D(const char* family);
@@ -140,7 +140,7 @@ void VelocityBufferPass::run(const render::RenderContextPointer& renderContext,
     });
 
     auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
-    config->setGPUBatchRunTime(_gpuTimer->getGPUAverage(), _gpuTimer->getBatchAverage());
+    config->setGPUBatchRunTime(*_gpuTimer);
 }
 
 
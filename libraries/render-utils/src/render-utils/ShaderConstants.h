@@ -127,6 +127,18 @@
 #define RENDER_UTILS_UNIFORM_TEXT_COLOR 0
 #define RENDER_UTILS_UNIFORM_TEXT_OUTLINE 1
 
+// Imposters
+#define RENDER_UTILS_BUFFER_IMPOSTER_PARAMS 1
+#define RENDER_UTILS_TEXTURE_IMPOSTER_COLOR 0
+#define RENDER_UTILS_TEXTURE_IMPOSTER_NORMAL 1
+#define RENDER_UTILS_TEXTURE_IMPOSTER_SPECULAR 2
+#define RENDER_UTILS_TEXTURE_IMPOSTER_DEPTH 3
+
+// Skinning pre-pass
+#define RENDER_UTILS_UNIFORM_SKINNED_VERTICES_ROWS 0
+#define RENDER_UTILS_TEXTURE_SKINNED_POSITION_NORMAL 13
+#define RENDER_UTILS_TEXTURE_SKINNED_NORMAL_TANGENT 15
+
 // Debugging 
 #define RENDER_UTILS_BUFFER_DEBUG_SKYBOX 5
 #define RENDER_UTILS_DEBUG_TEXTURE0 11
@@ -162,6 +174,7 @@ enum Buffer {
     ToneMappingParams = RENDER_UTILS_BUFFER_TM_PARAMS,
     ShadowParams = RENDER_UTILS_BUFFER_SHADOW_PARAMS,
     DebugDeferredParams = RENDER_UTILS_BUFFER_DEBUG_DEFERRED_PARAMS,
+    ImposterParams = RENDER_UTILS_BUFFER_IMPOSTER_PARAMS,
 };
 } // namespace buffer
 
@@ -202,10 +215,22 @@ enum Texture {
     ToneMappingColor = RENDER_UTILS_TEXTURE_TM_COLOR,
     TextFont = RENDER_UTILS_TEXTURE_TEXT_FONT,
     AmbientFresnel = RENDER_UTILS_TEXTURE_AMBIENT_FRESNEL,
+    ImposterColor = RENDER_UTILS_TEXTURE_IMPOSTER_COLOR,
+    ImposterNormal = RENDER_UTILS_TEXTURE_IMPOSTER_NORMAL,
+    ImposterSpecular = RENDER_UTILS_TEXTURE_IMPOSTER_SPECULAR,
+    ImposterDepth = RENDER_UTILS_TEXTURE_IMPOSTER_DEPTH,
+    SkinnedPositionNormal = RENDER_UTILS_TEXTURE_SKINNED_POSITION_NORMAL,
+    SkinnedNormalTangent = RENDER_UTILS_TEXTURE_SKINNED_NORMAL_TANGENT,
     DebugTexture0 = RENDER_UTILS_DEBUG_TEXTURE0,
 };
 } // namespace texture
 
+namespace uniform {
+enum Uniform {
+    SkinnedVerticesRows = RENDER_UTILS_UNIFORM_SKINNED_VERTICES_ROWS,
+};
+} // namespace uniform
+
 } } // namespace render_utils::slot
 
 // !>
@@ -20,6 +20,8 @@ static std::mutex fontMutex;
 
 std::map<std::tuple<bool, bool, bool>, gpu::PipelinePointer> Font::_pipelines;
 gpu::Stream::FormatPointer Font::_format;
+std::map<std::tuple<bool, bool>, gpu::PipelinePointer> Font::_instancedPipelines;
+gpu::Stream::FormatPointer Font::_instancedFormat;
 
 struct TextureVertex {
     glm::vec2 pos;
@@ -271,19 +273,33 @@ void Font::setupGPU() {
             std::make_tuple(false, false, true, sdf_text3D_forward), std::make_tuple(true, false, true, sdf_text3D_forward/*sdf_text3D_translucent_forward*/),
             std::make_tuple(false, true, true, sdf_text3D_translucent_unlit/*sdf_text3D_unlit_forward*/), std::make_tuple(true, true, true, sdf_text3D_translucent_unlit/*sdf_text3D_translucent_unlit_forward*/)
         };
-        for (auto& key : keys) {
+        auto createState = [](bool translucent) {
             auto state = std::make_shared<gpu::State>();
             state->setCullMode(gpu::State::CULL_BACK);
             state->setDepthTest(true, true, gpu::LESS_EQUAL);
-            state->setBlendFunction(std::get<0>(key),
+            state->setBlendFunction(translucent,
                 gpu::State::SRC_ALPHA, gpu::State::BLEND_OP_ADD, gpu::State::INV_SRC_ALPHA,
                 gpu::State::FACTOR_ALPHA, gpu::State::BLEND_OP_ADD, gpu::State::ONE);
-            if (std::get<0>(key)) {
+            if (translucent) {
                 PrepareStencil::testMask(*state);
             } else {
                 PrepareStencil::testMaskDrawShape(*state);
             }
-            _pipelines[std::make_tuple(std::get<0>(key), std::get<1>(key), std::get<2>(key))] = gpu::Pipeline::create(gpu::Shader::createProgram(std::get<3>(key)), state);
+            return state;
+        };
+        for (auto& key : keys) {
+            _pipelines[std::make_tuple(std::get<0>(key), std::get<1>(key), std::get<2>(key))] =
+                gpu::Pipeline::create(gpu::Shader::createProgram(std::get<3>(key)), createState(std::get<0>(key)));
+        }
+
+        // only opaque text is batched
+        static const std::vector<std::tuple<bool, bool, uint32_t>> instancedKeys = {
+            std::make_tuple(false, false, sdf_text3D_instanced), std::make_tuple(true, false, sdf_text3D_unlit_instanced),
+            std::make_tuple(false, true, sdf_text3D_forward_instanced), std::make_tuple(true, true, sdf_text3D_translucent_unlit_instanced/*sdf_text3D_unlit_forward_instanced*/)
+        };
+        for (auto& key : instancedKeys) {
+            _instancedPipelines[std::make_tuple(std::get<0>(key), std::get<1>(key))] =
+                gpu::Pipeline::create(gpu::Shader::createProgram(std::get<2>(key)), createState(false));
         }
 
         // Sanity checks
@@ -298,6 +314,16 @@ void Font::setupGPU() {
         _format->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::XYZ), 0);
         _format->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV), TEX_COORD_OFFSET);
         _format->setAttribute(gpu::Stream::TEXCOORD1, 0, gpu::Element(gpu::VEC4, gpu::FLOAT, gpu::XYZW), TEX_BOUNDS_OFFSET);
+
+        // the quad is made in sdf_text3D.slv from the glyph
+        const gpu::Element VEC4_ELEMENT(gpu::VEC4, gpu::FLOAT, gpu::XYZW);
+        _instancedFormat = std::make_shared<gpu::Stream::Format>();
+        _instancedFormat->setAttribute(gpu::Stream::POSITION, 0, VEC4_ELEMENT, offsetof(GlyphInstance, quad), gpu::Stream::PER_INSTANCE);
+        _instancedFormat->setAttribute(gpu::Stream::TEXCOORD0, 0, VEC4_ELEMENT, offsetof(GlyphInstance, texCoords), gpu::Stream::PER_INSTANCE);
+        _instancedFormat->setAttribute(gpu::Stream::TEXCOORD1, 0, VEC4_ELEMENT, offsetof(GlyphInstance, glyphBounds), gpu::Stream::PER_INSTANCE);
+        _instancedFormat->setAttribute(gpu::Stream::COLOR, 0, VEC4_ELEMENT, offsetof(GlyphInstance, color), gpu::Stream::PER_INSTANCE);
+        _instancedFormat->setAttribute(gpu::Stream::TEXCOORD2, 0, VEC4_ELEMENT, offsetof(GlyphInstance, effectColorAndThickness), gpu::Stream::PER_INSTANCE);
+        _instancedFormat->setAttribute(gpu::Stream::TEXCOORD3, 0, VEC4_ELEMENT, offsetof(GlyphInstance, effectAndIndex), gpu::Stream::PER_INSTANCE);
     }
 }
 
@@ -305,6 +331,7 @@ void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm
     drawInfo.verticesBuffer = std::make_shared<gpu::Buffer>();
     drawInfo.indicesBuffer = std::make_shared<gpu::Buffer>();
     drawInfo.indexCount = 0;
+    drawInfo.glyphs.clear();
     int numVertices = 0;
 
     drawInfo.string = str;
@@ -351,6 +378,13 @@ void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm
                 drawInfo.verticesBuffer->append(qd);
                 numVertices += VERTICES_PER_QUAD;
 
+                GlyphInstance glyphInstance;
+                glyphInstance.quad = glm::vec4(qd.vertices[0].pos, qd.vertices[3].pos - qd.vertices[0].pos);
+                glyphInstance.texCoords = glm::vec4(qd.vertices[2].tex, qd.vertices[1].tex - qd.vertices[2].tex);
+                glyphInstance.glyphBounds = qd.vertices[0].bounds;
+                glyphInstance.effectAndIndex.y = (float)drawInfo.glyphs.size();
+                drawInfo.glyphs.push_back(glyphInstance);
+
                 // Sam's recommended triangle slices
                 // Triangle tri1 = { v0, v1, v3 };
                 // Triangle tri2 = { v1, v2, v3 };
@@ -390,7 +424,8 @@ void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm
 
 void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString& str, const glm::vec4& color,
                       const glm::vec3& effectColor, float effectThickness, TextEffect effect,
-                      const glm::vec2& origin, const glm::vec2& bounds, float scale, bool unlit, bool forward) {
+                      const glm::vec2& origin, const glm::vec2& bounds, float scale, bool unlit, bool forward,
+                      bool batched) {
     if (!_loaded || str == "") {
         return;
     }
@@ -399,11 +434,13 @@ void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString
     const int SHADOW_EFFECT = (int)TextEffect::SHADOW_EFFECT;
 
     // If we're switching to or from shadow effect mode, we need to rebuild the vertices
+    bool glyphsDirty = false;
     if (str != drawInfo.string || bounds != drawInfo.bounds || origin != drawInfo.origin ||
             (drawInfo.params.effect != textEffect && (textEffect == SHADOW_EFFECT || drawInfo.params.effect == SHADOW_EFFECT)) ||
             (textEffect == SHADOW_EFFECT && scale != _scale)) {
         _scale = scale;
         buildVertices(drawInfo, str, origin, bounds, scale, textEffect == SHADOW_EFFECT);
+        glyphsDirty = true;
     }
 
     setupGPU();
@@ -425,6 +462,42 @@ void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString
             drawInfo.paramsBuffer = std::make_shared<gpu::Buffer>(sizeof(DrawParams), nullptr);
         }
         drawInfo.paramsBuffer->setSubData(0, sizeof(DrawParams), (const gpu::Byte*)&gpuDrawParams);
+        glyphsDirty = true;
+    }
+
+    // the glyphs of batched text carry the params of their text
+    if (glyphsDirty) {
+        glm::vec4 linearColor = ColorUtils::sRGBToLinearVec4(drawInfo.params.color);
+        glm::vec4 effectColorAndThickness(ColorUtils::sRGBToLinearVec3(drawInfo.params.effectColor), drawInfo.params.effectThickness);
+        for (auto& glyphInstance : drawInfo.glyphs) {
+            glyphInstance.color = linearColor;
+            glyphInstance.effectColorAndThickness = effectColorAndThickness;
+            glyphInstance.effectAndIndex.x = (float)drawInfo.params.effect;
+        }
+    }
+
+    if (batched && color.a >= 1.0f) {
+        if (drawInfo.glyphs.empty()) {
+            return;
+        }
+
+        // the text is copied into the glyphs of the named call, which are drawn in one instanced call with the
+        // transform of each text
+        std::string instanceName = "sdf_text3D_" + std::to_string(std::hash<Font*>()(this)) + (unlit ? "_unlit" : "") +
+            (forward ? "_forward" : "");
+        batch.getNamedBuffer(instanceName)->append(drawInfo.glyphs.size() * sizeof(GlyphInstance),
+            (const gpu::Byte*)drawInfo.glyphs.data());
+
+        auto pipeline = _instancedPipelines[std::make_tuple(unlit, forward)];
+        auto texture = _texture;
+        batch.setupNamedCalls(instanceName, [pipeline, texture](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+            batch.setPipeline(pipeline);
+            batch.setInputFormat(_instancedFormat);
+            batch.setInputBuffer(0, data.buffers[0], 0, sizeof(GlyphInstance));
+            batch.setResourceTexture(render_utils::slot::texture::TextFont, texture);
+            batch.drawInstanced((gpu::uint32)data.count(), gpu::TRIANGLE_STRIP, VERTICES_PER_QUAD);
+        }, (gpu::uint32)drawInfo.glyphs.size());
+        return;
     }
 
     batch.setPipeline(_pipelines[std::make_tuple(color.a < 1.0f, unlit, forward)]);
@@ -41,11 +41,22 @@ public:
         vec3 _spare;
     };
 
+    // a glyph of batched text, drawn as an instance of a quad.  The params are those of its text
+    struct GlyphInstance {
+        vec4 quad; // lower left corner and size
+        vec4 texCoords; // the same in the texture
+        vec4 glyphBounds; // the texture coordinates of the glyph before it is enlarged for shadows
+        vec4 color;
+        vec4 effectColorAndThickness;
+        vec4 effectAndIndex; // the effect, and the index of the glyph in its text
+    };
+
     struct DrawInfo {
         gpu::BufferPointer verticesBuffer { nullptr };
         gpu::BufferPointer indicesBuffer { nullptr };
         gpu::BufferPointer paramsBuffer { nullptr };
         uint32_t indexCount;
+        std::vector<GlyphInstance> glyphs;
 
         QString string;
         glm::vec2 origin;
@@ -56,10 +67,12 @@ public:
     glm::vec2 computeExtent(const QString& str) const;
     float getFontSize() const { return _fontSize; }
 
-    // Render string to batch
+    // Render string to batch.  Batched opaque text is drawn at the end of the batch, along with all of the other
+    // batched opaque text of this font and pipeline, in one instanced draw
     void drawString(gpu::Batch& batch, DrawInfo& drawInfo, const QString& str, const glm::vec4& color,
                     const glm::vec3& effectColor, float effectThickness, TextEffect effect, 
-                    const glm::vec2& origin, const glm::vec2& bound, float scale, bool unlit, bool forward);
+                    const glm::vec2& origin, const glm::vec2& bound, float scale, bool unlit, bool forward,
+                    bool batched = false);
 
     static Pointer load(const QString& family);
 
@@ -104,6 +117,8 @@ private:
 
     static std::map<std::tuple<bool, bool, bool>, gpu::PipelinePointer> _pipelines;
     static gpu::Stream::FormatPointer _format;
+    static std::map<std::tuple<bool, bool>, gpu::PipelinePointer> _instancedPipelines;
+    static gpu::Stream::FormatPointer _instancedFormat;
 };
 
 #endif
@@ -14,8 +14,10 @@
 #include <algorithm>
 #include <assert.h>
 
+#include <JobSystem.h>
 #include <PerfStat.h>
 #include <OctreeUtils.h>
+#include <TBBHelpers.h>
 
 using namespace render;
 
@@ -177,6 +179,58 @@ void FetchSpatialTree::run(const RenderContextPointer& renderContext, const Inpu
     }
 }
 
+// the selected items are culled in chunks of this many on the TBB workers, and gathered back in order
+static const size_t CULL_CHUNK_SIZE = 1024;
+
+using ItemCullTest = std::function<bool(CullTest&, const AABox&)>;
+
+// Filters the spatial items on the key and bound tables of the scene and, if there is a cull test, culls them,
+// adding the ones left and their meta sub items to outItems
+static void cullItemIDs(const ScenePointer& scene, const ItemFilter& filter, const ItemIDs& ids, CullFunctor& cullFunctor,
+        RenderArgs* args, RenderDetails::Item& details, ItemBounds& outItems, const ItemCullTest& cullTest) {
+    size_t numChunks = (ids.size() + CULL_CHUNK_SIZE - 1) / CULL_CHUNK_SIZE;
+    std::vector<ItemBounds> chunkItems(numChunks);
+    std::vector<RenderDetails::Item> chunkDetails(numChunks);
+
+    auto cullChunk = [&](size_t chunk) {
+        CullTest test(cullFunctor, args, chunkDetails[chunk]);
+        auto& items = chunkItems[chunk];
+        items.reserve(CULL_CHUNK_SIZE);
+
+        size_t end = std::min(ids.size(), (chunk + 1) * CULL_CHUNK_SIZE);
+        for (size_t i = chunk * CULL_CHUNK_SIZE; i < end; ++i) {
+            auto id = ids[i];
+            const auto& key = scene->getItemKey(id);
+            if (filter.test(key)) {
+                const auto& bound = scene->getItemBound(id);
+                if (!cullTest || cullTest(test, bound)) {
+                    items.emplace_back(ItemBound(id, bound));
+                    if (key.isMetaCullGroup()) {
+                        scene->getItem(id).fetchMetaSubItemBounds(items, (*scene));
+                    }
+                }
+            }
+        }
+    };
+
+    if (numChunks > 1) {
+        // the frame waits on the culling, so it goes ahead of the background work on the workers
+        jobs::parallelFor(0, numChunks, 1, [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                cullChunk(chunk);
+            }
+        }, jobs::Priority::High);
+    } else if (numChunks == 1) {
+        cullChunk(0);
+    }
+
+    for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+        outItems.insert(outItems.end(), chunkItems[chunk].begin(), chunkItems[chunk].end());
+        details._outOfView += chunkDetails[chunk]._outOfView;
+        details._tooSmall += chunkDetails[chunk]._tooSmall;
+    }
+}
+
 void CullSpatialSelection::configure(const Config& config) {
     _justFrozeFrustum = _justFrozeFrustum || (config.freezeFrustum && !_freezeFrustum);
     _freezeFrustum = config.freezeFrustum;
@@ -218,134 +272,44 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         // visibility cull if partially selected ( octree cell contianing it was partial)
         // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
         if (_skipCulling || _overrideSkipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
+            // filter only, culling is disabled
+            PerformanceTimer perfTimer("filterItems");
+            cullItemIDs(scene, filter, inSelection.insideItems, _cullFunctor, args, details, outItems, nullptr);
+            cullItemIDs(scene, filter, inSelection.insideSubcellItems, _cullFunctor, args, details, outItems, nullptr);
+            cullItemIDs(scene, filter, inSelection.partialItems, _cullFunctor, args, details, outItems, nullptr);
+            cullItemIDs(scene, filter, inSelection.partialSubcellItems, _cullFunctor, args, details, outItems, nullptr);
         } else {
-
             // inside & fit items: easy, just filter
             {
                 PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
+                cullItemIDs(scene, filter, inSelection.insideItems, _cullFunctor, args, details, outItems, nullptr);
             }
 
             // inside & subcell items: filter & distance cull
             {
                 PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
+                cullItemIDs(scene, filter, inSelection.insideSubcellItems, _cullFunctor, args, details, outItems,
+                    [](CullTest& test, const AABox& bound) {
+                        return test.solidAngleTest(bound);
+                    });
             }
 
             // partial & fit items: filter & frustum cull
             {
                 PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
+                cullItemIDs(scene, filter, inSelection.partialItems, _cullFunctor, args, details, outItems,
+                    [](CullTest& test, const AABox& bound) {
+                        return test.frustumTest(bound);
+                    });
             }
 
             // partial & subcell items:: filter & frutum cull & solidangle cull
             {
                 PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            if (test.solidAngleTest(itemBound.bound)) {
-                                outItems.emplace_back(itemBound);
-                                if (item.getKey().isMetaCullGroup()) {
-                                    item.fetchMetaSubItemBounds(outItems, (*scene));
-                                }
-                            }
-                        }
-                    }
-                }
+                cullItemIDs(scene, filter, inSelection.partialSubcellItems, _cullFunctor, args, details, outItems,
+                    [](CullTest& test, const AABox& bound) {
+                        return test.frustumTest(bound) && test.solidAngleTest(bound);
+                    });
             }
         }
     }
@@ -14,6 +14,10 @@
 #include <algorithm>
 #include <assert.h>
 
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
 #include <LogHandler.h>
 #include <PerfStat.h>
 #include <ViewFrustum.h>
@@ -42,6 +46,43 @@ void render::renderItems(const RenderContextPointer& renderContext, const ItemBo
 namespace {
     int repeatedInvalidKeyMessageID = 0;
     std::once_flag messageIDFlag;
+
+    // items aren't split into batches smaller than this, the batch would cost more than recording it alone saves
+    const int MIN_ITEMS_PER_RECORDING_BATCH = 128;
+
+    class RecordingTask : public QRunnable {
+    public:
+        RecordingTask(std::function<void()> task) : _task(task) {}
+
+        void run() override { _task(); }
+
+    private:
+        std::function<void()> _task;
+    };
+
+    QThreadPool& getRecordingThreadPool() {
+        static QThreadPool threadPool;
+        static std::once_flag once;
+        std::call_once(once, [] {
+            // the render thread records a batch of its own, and the present thread replays the frames
+            threadPool.setMaxThreadCount(std::max(QThread::idealThreadCount() - 2, 1));
+        });
+        return threadPool;
+    }
+
+    void addRenderDetails(RenderDetails& details, const RenderDetails& batchDetails) {
+        auto addItem = [](RenderDetails::Item& item, const RenderDetails::Item& batchItem) {
+            item._considered += batchItem._considered;
+            item._outOfView += batchItem._outOfView;
+            item._tooSmall += batchItem._tooSmall;
+            item._rendered += batchItem._rendered;
+        };
+        details._materialSwitches += batchDetails._materialSwitches;
+        details._trianglesRendered += batchDetails._trianglesRendered;
+        addItem(details._item, batchDetails._item);
+        addItem(details._shadow, batchDetails._shadow);
+        addItem(details._other, batchDetails._other);
+    }
 }
 
 void renderShape(RenderArgs* args, const ShapePlumberPointer& shapeContext, const Item& item, const ShapeKey& globalKey) {
@@ -139,6 +180,89 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
     args->_itemShapeKey = 0;
 }
 
+void render::renderShapesInParallel(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext,
+    const ItemBounds& inItems, const char* batchName, bool stateSort, const BatchOperator& setupBatch,
+    const BatchOperator& teardownBatch, int maxDrawnItems, const ShapeKey& globalKey) {
+    RenderArgs* args = renderContext->args;
+
+    int numItemsToDraw = (int)inItems.size();
+    if (maxDrawnItems != -1) {
+        numItemsToDraw = glm::min(numItemsToDraw, maxDrawnItems);
+    }
+
+    auto& threadPool = getRecordingThreadPool();
+    int numBatches = glm::clamp(numItemsToDraw / MIN_ITEMS_PER_RECORDING_BATCH, 1, threadPool.maxThreadCount() + 1);
+
+    auto renderBatchShapes = [&](const RenderContextPointer& batchContext, const ItemBounds& items, int maxDrawn) {
+        if (stateSort) {
+            renderStateSortShapes(batchContext, shapeContext, items, maxDrawn, globalKey);
+        } else {
+            renderShapes(batchContext, shapeContext, items, maxDrawn, globalKey);
+        }
+    };
+
+    if (numBatches == 1) {
+        gpu::doInBatch(batchName, args->_context, [&](gpu::Batch& batch) {
+            args->_batch = &batch;
+            if (setupBatch) {
+                setupBatch(batch);
+            }
+            renderBatchShapes(renderContext, inItems, numItemsToDraw);
+            if (teardownBatch) {
+                teardownBatch(batch);
+            }
+            args->_batch = nullptr;
+        });
+        return;
+    }
+
+    // each batch has its own copy of the args, the items keep their per item state in them while they record
+    std::vector<gpu::BatchPointer> batches(numBatches);
+    std::vector<RenderArgs> batchArgs(numBatches, *args);
+    std::vector<RenderContextPointer> batchContexts(numBatches);
+    std::vector<ItemBounds> batchItems(numBatches);
+    for (int i = 0; i < numBatches; ++i) {
+        batches[i] = gpu::Context::acquireBatch(batchName);
+        args->_batch = batches[i].get();
+        if (setupBatch) {
+            setupBatch(*batches[i]);
+        }
+
+        batchArgs[i]._batch = batches[i].get();
+        batchArgs[i]._details = RenderDetails();
+
+        auto batchContext = std::make_shared<RenderContext>(*renderContext);
+        batchContext->args = &batchArgs[i];
+        batchContexts[i] = batchContext;
+
+        auto begin = inItems.begin() + (i * numItemsToDraw) / numBatches;
+        auto end = inItems.begin() + ((i + 1) * numItemsToDraw) / numBatches;
+        batchItems[i].assign(begin, end);
+    }
+    args->_batch = nullptr;
+
+    {
+        PROFILE_RANGE(render, "recordBatchesInParallel");
+        for (int i = 1; i < numBatches; ++i) {
+            threadPool.start(new RecordingTask([&, i] {
+                renderBatchShapes(batchContexts[i], batchItems[i], -1);
+            }));
+        }
+        renderBatchShapes(batchContexts[0], batchItems[0], -1);
+        threadPool.waitForDone();
+    }
+
+    for (int i = 0; i < numBatches; ++i) {
+        if (teardownBatch) {
+            args->_batch = batches[i].get();
+            teardownBatch(*batches[i]);
+        }
+        args->_context->appendFrameBatch(batches[i]);
+        addRenderDetails(args->_details, batchArgs[i]._details);
+    }
+    args->_batch = nullptr;
+}
+
 void DrawLight::run(const RenderContextPointer& renderContext, const ItemBounds& inLights) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -20,6 +20,16 @@ void renderItems(const RenderContextPointer& renderContext, const ItemBounds& in
 void renderShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
 void renderStateSortShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
 
+using BatchOperator = std::function<void(gpu::Batch& batch)>;
+
+// Records the shapes into several batches at once, each with a run of the items, on the render recording threads and
+// this one, then appends the batches to the frame in the order of their items. Every batch gets setupBatch before its
+// items and teardownBatch after them, both called on this thread. With too few items to be worth splitting, it is
+// the same as recording them all in one batch.
+void renderShapesInParallel(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext,
+    const ItemBounds& inItems, const char* batchName, bool stateSort, const BatchOperator& setupBatch,
+    const BatchOperator& teardownBatch = nullptr, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
+
 class DrawLightConfig : public Job::Config {
     Q_OBJECT
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
@@ -24,6 +24,13 @@
 
 using namespace render;
 
+void GPUJobConfig::setGPUBatchRunTime(const gpu::RangeTimer& timer) {
+    setGPUBatchRunTime(timer.getGPUAverage(), timer.getBatchAverage());
+    _msGPURunTimeP95 = timer.getGPUPercentile(0.95);
+    _msGPURunTimeP99 = timer.getGPUPercentile(0.99);
+    PROFILE_COUNTER(render_gpu, objectName(), { { "gpu", _msGPURunTime } });
+}
+
 class EngineTask {
 public:
 
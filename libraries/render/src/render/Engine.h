@@ -42,9 +42,13 @@ namespace render {
         Q_OBJECT
             Q_PROPERTY(double gpuRunTime READ getGPURunTime)
             Q_PROPERTY(double batchRunTime READ getBatchRunTime)
+            Q_PROPERTY(double gpuRunTimeP95 READ getGPURunTimeP95)
+            Q_PROPERTY(double gpuRunTimeP99 READ getGPURunTimeP99)
 
             double _msGPURunTime { 0.0 };
         double _msBatchRunTime { 0.0 };
+        double _msGPURunTimeP95 { 0.0 };
+        double _msGPURunTimeP99 { 0.0 };
     public:
         using Persistent = PersistentConfig<GPUJobConfig>;
 
@@ -53,8 +57,12 @@ namespace render {
 
         // Running Time measurement on GPU and for Batch execution
         void setGPUBatchRunTime(double msGpuTime, double msBatchTime) { _msGPURunTime = msGpuTime; _msBatchRunTime = msBatchTime; }
+        // Takes the averages and percentiles of the timer, and traces its gpu time as a counter of the job
+        void setGPUBatchRunTime(const gpu::RangeTimer& timer);
         double getGPURunTime() const { return _msGPURunTime; }
         double getBatchRunTime() const { return _msBatchRunTime; }
+        double getGPURunTimeP95() const { return _msGPURunTimeP95; }
+        double getGPURunTimeP99() const { return _msGPURunTimeP99; }
     };
 
     class GPUTaskConfig : public TaskConfig {
@@ -47,6 +47,8 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
     config->texturePendingGPUTransferSize = gpu::Context::getTexturePendingGPUTransferMemSize();
 
     config->textureResourcePopulatedGPUMemSize = gpu::Context::getTextureResourcePopulatedGPUMemSize();
+    config->textureStagingGPUMemSize = gpu::Context::getTextureStagingGPUMemSize();
+    config->textureFrameTransferSize = gpu::Context::getTextureFrameTransferMemSize();
 
     renderContext->args->_context->getFrameStats(_gpuStats);
 
@@ -0,0 +1,173 @@
+//
+//  OcclusionCulling.cpp
+//  render/src/render
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OcclusionCulling.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <NumericalConstants.h>
+#include <PerfStat.h>
+#include <SharedUtil.h>
+
+using namespace render;
+
+std::string OcclusionStage::_name("Occlusion");
+
+HiZPyramid::HiZPyramid(const std::vector<float>& linearDepth, const glm::ivec2& size, const glm::mat4& view,
+        const glm::mat4& projection, float nearClip, uint64_t timestamp) :
+    _viewInverse(glm::inverse(view)),
+    _projection(projection),
+    _nearClip(nearClip),
+    _timestamp(timestamp) {
+    if (size.x <= 0 || size.y <= 0 || linearDepth.size() < (size_t)(size.x * size.y)) {
+        return;
+    }
+
+    // the base level keeps the farthest depth of each block of the depth
+    Level base;
+    base.size = (size + glm::ivec2(BASE_REDUCTION - 1)) / BASE_REDUCTION;
+    base.depths.resize(base.size.x * base.size.y, 0.0f);
+    for (int y = 0; y < size.y; ++y) {
+        auto row = &linearDepth[y * size.x];
+        auto baseRow = &base.depths[(y / BASE_REDUCTION) * base.size.x];
+        for (int x = 0; x < size.x; ++x) {
+            auto& depth = baseRow[x / BASE_REDUCTION];
+            depth = std::max(depth, row[x]);
+        }
+    }
+    _levels.push_back(std::move(base));
+
+    while (_levels.back().size.x > 1 || _levels.back().size.y > 1) {
+        const auto& previous = _levels.back();
+        Level level;
+        level.size = glm::max((previous.size + glm::ivec2(1)) / 2, glm::ivec2(1));
+        level.depths.resize(level.size.x * level.size.y);
+        for (int y = 0; y < level.size.y; ++y) {
+            int y0 = 2 * y;
+            int y1 = std::min(y0 + 1, previous.size.y - 1);
+            for (int x = 0; x < level.size.x; ++x) {
+                int x0 = 2 * x;
+                int x1 = std::min(x0 + 1, previous.size.x - 1);
+                level.depths[y * level.size.x + x] = std::max(std::max(previous.get(x0, y0), previous.get(x1, y0)),
+                    std::max(previous.get(x0, y1), previous.get(x1, y1)));
+            }
+        }
+        _levels.push_back(std::move(level));
+    }
+}
+
+bool HiZPyramid::isOccluded(const AABox& bound, float depthBias) const {
+    if (_levels.empty()) {
+        return false;
+    }
+
+    glm::vec2 minUV { 1.0f };
+    glm::vec2 maxUV { 0.0f };
+    float nearestDepth = std::numeric_limits<float>::max();
+    for (int i = 0; i < 8; ++i) {
+        glm::vec4 eyeCorner = _viewInverse * glm::vec4(bound.getVertex((BoxVertex)i), 1.0f);
+        float depth = -eyeCorner.z;
+        // a bound that reaches the near plane has nothing in front of it
+        if (depth < _nearClip) {
+            return false;
+        }
+        nearestDepth = std::min(nearestDepth, depth);
+
+        glm::vec4 clipCorner = _projection * eyeCorner;
+        glm::vec2 uv = glm::vec2(clipCorner) / clipCorner.w * 0.5f + 0.5f;
+        minUV = glm::min(minUV, uv);
+        maxUV = glm::max(maxUV, uv);
+    }
+
+    // whatever is out of the view is left to the frustum culling
+    if (minUV.x > 1.0f || minUV.y > 1.0f || maxUV.x < 0.0f || maxUV.y < 0.0f) {
+        return false;
+    }
+
+    const auto& baseSize = _levels.front().size;
+    glm::ivec2 minTexel = glm::clamp(glm::ivec2(glm::clamp(minUV, 0.0f, 1.0f) * glm::vec2(baseSize)), glm::ivec2(0), baseSize - 1);
+    glm::ivec2 maxTexel = glm::clamp(glm::ivec2(glm::clamp(maxUV, 0.0f, 1.0f) * glm::vec2(baseSize)), glm::ivec2(0), baseSize - 1);
+
+    // go up to the level where the bound covers at most 2 by 2 texels
+    size_t levelIndex = 0;
+    while (levelIndex + 1 < _levels.size() && (maxTexel.x - minTexel.x > 1 || maxTexel.y - minTexel.y > 1)) {
+        minTexel /= 2;
+        maxTexel /= 2;
+        ++levelIndex;
+    }
+
+    const auto& level = _levels[levelIndex];
+    maxTexel = glm::min(maxTexel, level.size - 1);
+    float farthestDepth = 0.0f;
+    for (int y = minTexel.y; y <= maxTexel.y; ++y) {
+        for (int x = minTexel.x; x <= maxTexel.x; ++x) {
+            farthestDepth = std::max(farthestDepth, level.get(x, y));
+        }
+    }
+    return nearestDepth > farthestDepth + depthBias;
+}
+
+HiZPyramidPointer OcclusionStage::getPyramid() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pyramid;
+}
+
+void OcclusionStage::setPyramid(const HiZPyramidPointer& pyramid) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pyramid = pyramid;
+}
+
+OcclusionStageSetup::OcclusionStageSetup() {
+}
+
+void OcclusionStageSetup::run(const RenderContextPointer& renderContext) {
+    auto stage = renderContext->_scene->getStage(OcclusionStage::getName());
+    if (!stage) {
+        stage = std::make_shared<OcclusionStage>();
+        renderContext->_scene->resetStage(OcclusionStage::getName(), stage);
+    }
+}
+
+void CullOcclusion::configure(const Config& config) {
+    _cullOccluded = config.cullOccluded;
+    _depthBias = config.depthBias;
+    _maxPyramidAge = (uint64_t)std::max(config.maxPyramidAge, 0) * USECS_PER_MSEC;
+}
+
+void CullOcclusion::run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems) {
+    assert(renderContext->args);
+    RenderArgs* args = renderContext->args;
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+
+    // only the main view has its depth read back
+    HiZPyramidPointer pyramid;
+    if (_cullOccluded && args->_renderMode == RenderArgs::DEFAULT_RENDER_MODE && !args->isStereo()) {
+        auto stage = renderContext->_scene->getStage<OcclusionStage>();
+        if (stage) {
+            pyramid = stage->getPyramid();
+        }
+    }
+    if (!pyramid || usecTimestampNow() - pyramid->getTimestamp() > _maxPyramidAge) {
+        outItems = inItems;
+        config->numCulled = 0;
+        return;
+    }
+
+    PerformanceTimer perfTimer("cullOcclusion");
+    outItems.clear();
+    outItems.reserve(inItems.size());
+    for (const auto& item : inItems) {
+        if (!pyramid->isOccluded(item.bound, _depthBias)) {
+            outItems.push_back(item);
+        }
+    }
+    config->numCulled = (int)(inItems.size() - outItems.size());
+}
@@ -0,0 +1,125 @@
+//
+//  OcclusionCulling.h
+//  render/src/render
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_OcclusionCulling_h
+#define hifi_render_OcclusionCulling_h
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "Engine.h"
+#include "Stage.h"
+
+namespace render {
+
+    // A Hi-Z pyramid of the linear depth of a rendered frame, each texel keeping the farthest depth under it.
+    // A bound is occluded if its nearest point is behind the farthest depth of the texels that it covers in a level
+    // where that is no more than 2 by 2 of them.
+    class HiZPyramid {
+    public:
+        // the pyramid starts at this many times less than the depth it is built from
+        static const int BASE_REDUCTION = 4;
+
+        // the linear depth is row after row from the bottom one, and was rendered with the view and projection
+        HiZPyramid(const std::vector<float>& linearDepth, const glm::ivec2& size, const glm::mat4& view, const glm::mat4& projection,
+            float nearClip, uint64_t timestamp);
+
+        bool isOccluded(const AABox& bound, float depthBias) const;
+
+        uint64_t getTimestamp() const { return _timestamp; }
+
+    private:
+        struct Level {
+            glm::ivec2 size;
+            std::vector<float> depths;
+
+            float get(int x, int y) const { return depths[y * size.x + x]; }
+        };
+
+        std::vector<Level> _levels;
+        glm::mat4 _viewInverse;
+        glm::mat4 _projection;
+        float _nearClip;
+        uint64_t _timestamp;
+    };
+    using HiZPyramidPointer = std::shared_ptr<const HiZPyramid>;
+
+    // Holds the last Hi-Z pyramid of the main view, built on the rendering thread as its depth comes back from the GPU
+    // and used by the culling of the frames after it
+    class OcclusionStage : public Stage {
+    public:
+        static const std::string& getName() { return _name; }
+
+        HiZPyramidPointer getPyramid() const;
+        void setPyramid(const HiZPyramidPointer& pyramid);
+
+        // only one depth read is in flight at a time, the GPU would have to keep up with one per frame otherwise
+        bool beginDepthRead() { return !_isDepthReadPending.exchange(true); }
+        void endDepthRead() { _isDepthReadPending = false; }
+
+    private:
+        static std::string _name;
+
+        mutable std::mutex _mutex;
+        HiZPyramidPointer _pyramid;
+        std::atomic<bool> _isDepthReadPending { false };
+    };
+    using OcclusionStagePointer = std::shared_ptr<OcclusionStage>;
+
+    class OcclusionStageSetup {
+    public:
+        using JobModel = render::Job::Model<OcclusionStageSetup>;
+
+        OcclusionStageSetup();
+        void run(const RenderContextPointer& renderContext);
+    };
+
+    class CullOcclusionConfig : public Job::Config {
+        Q_OBJECT
+        Q_PROPERTY(int numCulled READ getNumCulled)
+        Q_PROPERTY(bool cullOccluded MEMBER cullOccluded NOTIFY dirty)
+        Q_PROPERTY(float depthBias MEMBER depthBias NOTIFY dirty)
+        Q_PROPERTY(int maxPyramidAge MEMBER maxPyramidAge NOTIFY dirty)
+    public:
+        int numCulled { 0 };
+        int getNumCulled() { return numCulled; }
+
+        // the job itself stays enabled, it has to pass the items through when it doesn't cull
+        bool cullOccluded { false };
+
+        // how far behind the occluders, in meters, a bound has to be to be culled
+        float depthBias { 0.1f };
+
+        // in msecs, a pyramid older than this is too far from the current view to cull with
+        int maxPyramidAge { 100 };
+    signals:
+        void dirty();
+    };
+
+    // Culls the items of the main view that were hidden behind the depth of a frame or two before,
+    // the others, and frames that don't have a recent enough pyramid, pass through
+    class CullOcclusion {
+    public:
+        using Config = CullOcclusionConfig;
+        using JobModel = Job::ModelIO<CullOcclusion, ItemBounds, ItemBounds, Config>;
+
+        void configure(const Config& config);
+        void run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems);
+
+    private:
+        bool _cullOccluded { false };
+        float _depthBias { 0.1f };
+        uint64_t _maxPyramidAge { 0 };
+    };
+
+}
+
+#endif // hifi_render_OcclusionCulling_h
@@ -13,6 +13,7 @@
 
 #include "CullTask.h"
 #include "FilterTask.h"
+#include "OcclusionCulling.h"
 #include "SortTask.h"
 
 using namespace render;
@@ -60,9 +61,13 @@ void RenderFetchCullSortTask::build(JobModel& task, const Varying& input, Varyin
        task.addJob<MultiFilterItems<NUM_NON_SPATIAL_FILTERS>>("FilterLayeredSelection", nonspatialSelection, nonspatialFilters)
             .get<MultiFilterItems<NUM_NON_SPATIAL_FILTERS>::ItemBoundsArray>();
 
+    // Cull the shapes hidden behind the depth of the last frames, the lights still light what is in front of them
+    const auto unoccludedOpaques = task.addJob<CullOcclusion>("CullOccludedOpaque", filteredSpatialBuckets[OPAQUE_SHAPE_BUCKET]);
+    const auto unoccludedTransparents = task.addJob<CullOcclusion>("CullOccludedTransparent", filteredSpatialBuckets[TRANSPARENT_SHAPE_BUCKET]);
+
     // Extract opaques / transparents / lights / layered
-    const auto opaques = task.addJob<DepthSortItems>("DepthSortOpaque", filteredSpatialBuckets[OPAQUE_SHAPE_BUCKET]);
-    const auto transparents = task.addJob<DepthSortItems>("DepthSortTransparent", filteredSpatialBuckets[TRANSPARENT_SHAPE_BUCKET], DepthSortItems(false));
+    const auto opaques = task.addJob<DepthSortItems>("DepthSortOpaque", unoccludedOpaques);
+    const auto transparents = task.addJob<DepthSortItems>("DepthSortTransparent", unoccludedTransparents, DepthSortItems(false));
     const auto lights = filteredSpatialBuckets[LIGHT_BUCKET];
     const auto metas = filteredSpatialBuckets[META_BUCKET];
 
@@ -11,7 +11,9 @@
 #include "Scene.h"
 
 #include <numeric>
+#include <unordered_set>
 #include <gpu/Batch.h>
+#include <SharedUtil.h>
 #include "Logging.h"
 #include "TransitionStage.h"
 #include "HighlightStage.h"
@@ -185,6 +187,9 @@ Scene::Scene(glm::vec3 origin, float size) :
     _masterSpatialTree(origin, size)
 {
     _items.push_back(Item()); // add the itemID #0 to nothing
+    _itemKeys.emplace_back();
+    _itemBounds.emplace_back();
+    _itemStamps.emplace_back(0);
 }
 
 Scene::~Scene() {
@@ -202,21 +207,21 @@ bool Scene::isAllocatedID(const ItemID& id) const {
 
 /// Enqueue change batch to the scene
 void Scene::enqueueTransaction(const Transaction& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(transaction);
+    _transactionQueue.push(transaction);
 }
 
 void Scene::enqueueTransaction(Transaction&& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(std::move(transaction));
+    _transactionQueue.push(std::move(transaction));
 }
 
 uint32_t Scene::enqueueFrame() {
     PROFILE_RANGE(render, __FUNCTION__);
     TransactionQueue localTransactionQueue;
     {
-        std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-        localTransactionQueue.swap(_transactionQueue);
+        Transaction transaction;
+        while (_transactionQueue.try_pop(transaction)) {
+            localTransactionQueue.push_back(std::move(transaction));
+        }
     }
 
     Transaction consolidatedTransaction;
@@ -230,22 +235,26 @@ uint32_t Scene::enqueueFrame() {
 }
 
  
-void Scene::processTransactionQueue() {
+void Scene::processTransactionQueue(uint64_t timeBudget) {
     PROFILE_RANGE(render, __FUNCTION__);
 
-    static TransactionFrames queuedFrames;
     {
-        // capture the queued frames and clear the queue
+        // capture the queued frames, behind those left over from the last time, and clear the queue
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        queuedFrames.swap(_transactionFrames);
+        moveElements(_processingFrames, _transactionFrames);
     }
 
-    // go through the queue of frames and process them
-    for (auto& frame : queuedFrames) {
-        processTransactionFrame(frame);
+    // go through the queue of frames and process them, in order, until the budget is spent
+    auto start = usecTimestampNow();
+    size_t numProcessed = 0;
+    while (numProcessed < _processingFrames.size()) {
+        processTransactionFrame(_processingFrames[numProcessed++]);
+        if (timeBudget > 0 && usecTimestampNow() - start > timeBudget) {
+            break;
+        }
     }
 
-    queuedFrames.clear();
+    _processingFrames.erase(_processingFrames.begin(), _processingFrames.begin() + numProcessed);
 }
 
 void Scene::processTransactionFrame(const Transaction& transaction) {
@@ -257,6 +266,9 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
         ItemID maxID = _IDAllocator.load();
         if (maxID > _items.size()) {
             _items.resize(maxID + 100); // allocate the maxId and more
+            _itemKeys.resize(_items.size());
+            _itemBounds.resize(_items.size());
+            _itemStamps.resize(_items.size(), 0);
         }
         // Now we know for sure that we have enough items in the array to
         // capture anything coming from the transaction
@@ -305,10 +317,13 @@ void Scene::resetItems(const Transaction::Resets& transactions) {
         // Update the item's container
         assert((oldKey.isSpatial() == newKey.isSpatial()) || oldKey._flags.none());
         if (newKey.isSpatial()) {
-            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), itemId, newKey);
+            auto bound = item.getBound();
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, bound, itemId, newKey);
             item.resetCell(newCell, newKey.isSmall());
+            updateItemTables(itemId, bound);
         } else {
             _masterNonspatialSet.insert(itemId);
+            updateItemTables(itemId, Item::Bound());
         }
     }
 }
@@ -332,10 +347,23 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
 
         // Kill it
         item.kill();
+        updateItemTables(removedID, Item::Bound());
     }
 }
 
 void Scene::updateItems(const Transaction::Updates& transactions) {
+    // An item updated many times in the frame gets all of its functors, but is moved in the spatial tree only once,
+    // from where it was before the first of them
+    struct UpdatedItem {
+        ItemID id;
+        ItemCell oldCell;
+        ItemKey oldKey;
+    };
+    std::vector<UpdatedItem> updatedItems;
+    std::unordered_set<ItemID> updatedIDs;
+    updatedItems.reserve(transactions.size());
+    updatedIDs.reserve(transactions.size());
+
     for (auto& update : transactions) {
         auto updateID = std::get<0>(update);
         if (updateID == Item::INVALID_ITEM_ID) {
@@ -350,25 +378,36 @@ void Scene::updateItems(const Transaction::Updates& transactions) {
             continue;
         }
 
-        // Good to go, deal with the update
-        auto oldCell = item.getCell();
-        auto oldKey = item.getKey();
+        if (updatedIDs.insert(updateID).second) {
+            updatedItems.push_back({ updateID, item.getCell(), item.getKey() });
+        }
 
         // Update the item
         item.update(std::get<1>(update));
+    }
+
+    for (const auto& updatedItem : updatedItems) {
+        // Good to go, deal with the update
+        auto updateID = updatedItem.id;
+        auto& item = _items[updateID];
+        const auto& oldCell = updatedItem.oldCell;
+        const auto& oldKey = updatedItem.oldKey;
         auto newKey = item.getKey();
 
         // Update the item's container
+        Item::Bound bound;
         if (oldKey.isSpatial() == newKey.isSpatial()) {
             if (newKey.isSpatial()) {
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+                bound = item.getBound();
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, bound, updateID, newKey);
                 item.resetCell(newCell, newKey.isSmall());
             }
         } else {
             if (newKey.isSpatial()) {
                 _masterNonspatialSet.erase(updateID);
 
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+                bound = item.getBound();
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, bound, updateID, newKey);
                 item.resetCell(newCell, newKey.isSmall());
             } else {
                 _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
@@ -377,9 +416,17 @@ void Scene::updateItems(const Transaction::Updates& transactions) {
                 _masterNonspatialSet.insert(updateID);
             }
         }
+        updateItemTables(updateID, bound);
     }
 }
 
+void Scene::updateItemTables(ItemID id, const Item::Bound& bound) {
+    // the key is read back after the cell is reset, which decides if it is small
+    _itemKeys[id] = _items[id].getKey();
+    _itemBounds[id] = bound;
+    ++_itemStamps[id];
+}
+
 void Scene::resetTransitionItems(const Transaction::TransitionResets& transactions) {
     auto transitionStage = getStage<TransitionStage>(TransitionStage::getName());
 
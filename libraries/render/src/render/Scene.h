@@ -12,6 +12,8 @@
 #ifndef hifi_render_Scene_h
 #define hifi_render_Scene_h
 
+#include <TBBHelpers.h>
+
 #include "Item.h"
 #include "SpatialTree.h"
 #include "Stage.h"
@@ -156,7 +158,9 @@ public:
     uint32_t enqueueFrame();
 
     // Process the pending transactions queued
-    void processTransactionQueue();
+    // With a time budget, in usecs, the frames left once it is spent wait for the next call, a frame is never split
+    // and at least one is processed each time
+    void processTransactionQueue(uint64_t timeBudget = 0);
 
     // Access a particular selection (empty if doesn't exist)
     // Thread safe
@@ -175,6 +179,15 @@ public:
     // Same as getItem, checking if the id is valid
     const Item getItemSafe(const ItemID& id) const { if (isAllocatedID(id)) { return _items[id]; } else { return Item(); } }
 
+    // The key and bound of an item, read from tables kept side by side in the order of the ids so the culling doesn't
+    // go through the payloads. They are updated by the transactions, and the bound is only kept for the spatial items.
+    // WARNING, There is No check on the validity of the ID
+    const ItemKey& getItemKey(const ItemID& id) const { return _itemKeys[id]; }
+    const Item::Bound& getItemBound(const ItemID& id) const { return _itemBounds[id]; }
+
+    // Bumped by each reset, update and remove of the item, for what is cached from it to know when it changed
+    uint32_t getItemStamp(const ItemID& id) const { return _itemStamps[id]; }
+
     // Access the spatialized items
     const ItemSpatialTree& getSpatialTree() const { return _masterSpatialTree; }
 
@@ -199,13 +212,13 @@ protected:
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _transactionQueueMutex;
-    TransactionQueue _transactionQueue;
+    tbb::concurrent_queue<Transaction> _transactionQueue;
 
     
     std::mutex _transactionFramesMutex;
     using TransactionFrames = std::vector<Transaction>;
     TransactionFrames _transactionFrames;
+    TransactionFrames _processingFrames; // the frames that were over the time budget, before those queued since
     uint32_t _transactionFrameNumber{ 0 };
 
     // Process one transaction frame 
@@ -215,6 +228,9 @@ protected:
     // database of items is protected for editing by a mutex
     std::mutex _itemsMutex;
     Item::Vector _items;
+    std::vector<ItemKey> _itemKeys;
+    std::vector<Item::Bound> _itemBounds;
+    std::vector<uint32_t> _itemStamps;
     ItemSpatialTree _masterSpatialTree;
     ItemIDSet _masterNonspatialSet;
 
@@ -222,6 +238,7 @@ protected:
     void resetTransitionFinishedOperator(const Transaction::TransitionFinishedOperators& transactions);
     void removeItems(const Transaction::Removes& transactions);
     void updateItems(const Transaction::Updates& transactions);
+    void updateItemTables(ItemID id, const Item::Bound& bound);
 
     void resetTransitionItems(const Transaction::TransitionResets& transactions);
     void removeTransitionItems(const Transaction::TransitionRemoves& transactions);
@@ -10,12 +10,15 @@
 //
 #include "SceneTask.h"
 
+#include <algorithm>
+
 
 using namespace render;
 
 void PerformSceneTransaction::configure(const Config& config) {
+    _timeBudget = (uint64_t)std::max(config.timeBudget, 0);
 }
 
 void PerformSceneTransaction::run(const RenderContextPointer& renderContext) {
-    renderContext->_scene->processTransactionQueue();
+    renderContext->_scene->processTransactionQueue(_timeBudget);
 }
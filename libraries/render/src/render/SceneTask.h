@@ -18,7 +18,11 @@ namespace render {
 
     class PerformSceneTransactionConfig : public Job::Config {
         Q_OBJECT
+        Q_PROPERTY(int timeBudget MEMBER timeBudget NOTIFY dirty)
     public:
+        // in usecs, the transaction frames left once it is spent are processed the next frame, 0 processes all of them
+        int timeBudget { 0 };
+
     signals:
         void dirty();
 
@@ -33,6 +37,7 @@ namespace render {
         void configure(const Config& config);
         void run(const RenderContextPointer& renderContext);
     protected:
+        uint64_t _timeBudget { 0 };
     };
 
 
@@ -12,6 +12,7 @@
 #ifndef hifi_render_ShapePipeline_h
 #define hifi_render_ShapePipeline_h
 
+#include <mutex>
 #include <unordered_set>
 
 #include <gpu/Batch.h>
@@ -349,6 +350,9 @@ protected:
 
 private:
     mutable std::unordered_set<Key, Key::Hash, Key::KeyEqual> _missingKeys;
+
+    // the pipelines are picked by the batches recording in parallel, and a custom one is added the first time it is
+    mutable std::recursive_mutex _pipelineMapMutex;
 };
 
 
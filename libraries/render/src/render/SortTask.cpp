@@ -13,31 +13,34 @@
 #include "ShapePipeline.h"
 
 #include <assert.h>
+#include <string.h>
+
+#include <Radix2InplaceSort.h>
+#include <Radix2IntegerScanner.h>
 #include <ViewFrustum.h>
 
 using namespace render;
 
 struct ItemBoundSort {
-    float _centerDepth = 0.0f;
-    float _nearDepth = 0.0f;
-    float _farDepth = 0.0f;
+    uint32_t _key = 0;
     ItemID _id = 0;
     AABox _bounds;
 
     ItemBoundSort() {}
-    ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _bounds(bounds) {}
+    ItemBoundSort(uint32_t key, ItemID id, const AABox& bounds) : _key(key), _id(id), _bounds(bounds) {}
 };
 
-struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth < right._centerDepth);
-    }
-};
+// The bits of a float that isn't negative sort the same as the float, so the squared distances sort as integers,
+// flipped for back to front
+static uint32_t depthSortKey(float distanceSquared, bool frontToBack) {
+    uint32_t key;
+    memcpy(&key, &distanceSquared, sizeof(key));
+    return frontToBack ? key : ~key;
+}
 
-struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth > right._centerDepth);
-    }
+class ItemBoundSortScanner : public Radix2IntegerScanner<uint32_t> {
+public:
+    bool bit(const ItemBoundSort& item, const state_type& s) const { return Radix2IntegerScanner<uint32_t>::bit(item._key, s); }
 };
 
 void render::depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, 
@@ -45,8 +48,8 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
+    const auto& frustum = args->getViewFrustum();
 
 
     // Allocate and simply copy
@@ -56,24 +59,15 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
 
     // Make a local dataset of the center distance and closest point distance
     std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
+    itemBoundSorts.reserve(inItems.size());
 
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound();
-        float distanceSquared = args->getViewFrustum().distanceToCameraSquared(bound.calcCenter());
-
-        itemBoundSorts.emplace_back(ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, bound));
+    for (const auto& itemDetails : inItems) {
+        float distanceSquared = frustum.distanceToCameraSquared(itemDetails.bound.calcCenter());
+        itemBoundSorts.emplace_back(ItemBoundSort(depthSortKey(distanceSquared, frontToBack), itemDetails.id, itemDetails.bound));
     }
 
     // sort against Z
-    if (frontToBack) {
-        FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
-    } else {
-        BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
-    }
+    radix2InplaceSort(itemBoundSorts.begin(), itemBoundSorts.end(), ItemBoundSortScanner());
 
     // Finally once sorted result to a list of itemID and keep uniques
     render::ItemID previousID = Item::INVALID_ITEM_ID;
@@ -167,13 +167,26 @@ void ArrayBufferClass::fromScriptValue(const QScriptValue& object, QByteArray& b
         // Array of uint8s eg: [ 128, 3, 25, 234 ]
         auto Uint8Array = object.engine()->globalObject().property("Uint8Array");
         auto typedArray = Uint8Array.construct(QScriptValueList{object});
-        if (QByteArray* buffer = qscriptvalue_cast<QByteArray*>(typedArray.property("buffer"))) {
+        if (QByteArray* buffer = qscriptvalue_cast<QByteArray*>(typedArray.property("buffer").data())) {
             byteArray = *buffer;
         }
     } else if (object.isObject()) {
-        // ArrayBuffer instance (or any JS class that supports coercion into QByteArray*)
-        if (QByteArray* buffer = qscriptvalue_cast<QByteArray*>(object.data())) {
+        QScriptValue data = object.data();
+        if (QByteArray* buffer = qscriptvalue_cast<QByteArray*>(data)) {
+            // ArrayBuffer instance (or any JS class that supports coercion into QByteArray*)
+            // the bytes are shared, not copied, until either side writes to them
             byteArray = *buffer;
+        } else if (data.isObject()) {
+            // typed array or DataView, a view of a whole buffer shares it too
+            if (QByteArray* buffer = qscriptvalue_cast<QByteArray*>(data.property("buffer").data())) {
+                qint32 byteOffset = data.property("byteOffset").toInt32();
+                qint32 byteLength = data.property("byteLength").toInt32();
+                if (byteOffset == 0 && byteLength == buffer->size()) {
+                    byteArray = *buffer;
+                } else {
+                    byteArray = buffer->mid(byteOffset, byteLength);
+                }
+            }
         }
     }
 }
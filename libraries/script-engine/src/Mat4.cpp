@@ -65,6 +65,22 @@ glm::vec3 Mat4::transformVector(const glm::mat4& m, const glm::vec3& vector) con
     return ::transformVectorFast(m, vector);
 }
 
+QVector<glm::vec3> Mat4::transformPoints(const glm::mat4& m, const QVector<glm::vec3>& points) const {
+    QVector<glm::vec3> result(points.size());
+    for (int i = 0; i < points.size(); i++) {
+        result[i] = ::transformPoint(m, points[i]);
+    }
+    return result;
+}
+
+QVector<glm::vec3> Mat4::transformVectors(const glm::mat4& m, const QVector<glm::vec3>& vectors) const {
+    QVector<glm::vec3> result(vectors.size());
+    for (int i = 0; i < vectors.size(); i++) {
+        result[i] = ::transformVectorFast(m, vectors[i]);
+    }
+    return result;
+}
+
 glm::mat4 Mat4::inverse(const glm::mat4& m) const {
     return glm::inverse(m);
 }
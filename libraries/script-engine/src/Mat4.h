@@ -224,6 +224,30 @@ public slots:
      */
     glm::vec3 transformVector(const glm::mat4& m, const glm::vec3& vector) const;
 
+    /**jsdoc
+     * Transforms an array of points into a new coordinate system, in a single call. This is faster than calling 
+     * {@link Mat4(0).transformPoint|Mat4.transformPoint} for each point.
+     * @function Mat4(0).transformPoints
+     * @param {Mat4} m - The transform to the new coordinate system.
+     * @param {Vec3[]} points - The points to transform.
+     * @returns {Vec3[]} The points in the new coordinate system.
+     * @example <caption>Transform the corners of a quad.</caption>
+     * var matrix = Mat4.createFromRotAndTrans(Quat.fromPitchYawRollDegrees(0, 90, 0), { x: 0, y: 10, z: 0 });
+     * var corners = [{ x: -1, y: 0, z: -1 }, { x: 1, y: 0, z: -1 }, { x: 1, y: 0, z: 1 }, { x: -1, y: 0, z: 1 }];
+     * var transformedCorners = Mat4.transformPoints(matrix, corners);
+     */
+    QVector<glm::vec3> transformPoints(const glm::mat4& m, const QVector<glm::vec3>& points) const;
+
+    /**jsdoc
+     * Transforms an array of vectors into a new coordinate system, in a single call. This is faster than calling 
+     * {@link Mat4(0).transformVector|Mat4.transformVector} for each vector.
+     * @function Mat4(0).transformVectors
+     * @param {Mat4} m - The transform to the new coordinate system.
+     * @param {Vec3[]} vectors - The vectors to transform.
+     * @returns {Vec3[]} The vectors in the new coordinate system.
+     */
+    QVector<glm::vec3> transformVectors(const glm::mat4& m, const QVector<glm::vec3>& vectors) const;
+
 
     /**jsdoc
      * Calculates the inverse of a matrix.
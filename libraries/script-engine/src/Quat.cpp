@@ -11,6 +11,8 @@
 
 #include "Quat.h"
 
+#include <algorithm>
+
 #include <glm/gtx/vector_angle.hpp>
 #include <glm/gtx/string_cast.hpp>
 
@@ -106,6 +108,14 @@ glm::quat Quat::slerp(const glm::quat& q1, const glm::quat& q2, float alpha) {
     return glm::slerp(q1, q2, alpha);
 }
 
+QVector<glm::quat> Quat::slerpArrays(const QVector<glm::quat>& q1s, const QVector<glm::quat>& q2s, float alpha) {
+    QVector<glm::quat> result(std::min(q1s.size(), q2s.size()));
+    for (int i = 0; i < result.size(); i++) {
+        result[i] = glm::slerp(q1s[i], q2s[i], alpha);
+    }
+    return result;
+}
+
 // Spherical Quadratic Interpolation
 glm::quat Quat::squad(const glm::quat& q1, const glm::quat& q2, const glm::quat& s1, const glm::quat& s2, float h) {
     return glm::squad(q1, q2, s1, s2, h);
@@ -18,9 +18,11 @@
 
 #include <QObject>
 #include <QString>
+#include <QVector>
 #include <QtScript/QScriptable>
 
 #include <GLMHelpers.h>
+#include <RegisteredMetaTypes.h>
 
 /**jsdoc
  * A quaternion value. See also the {@link Quat(0)|Quat} API.
@@ -350,6 +352,21 @@ public slots:
      */
     glm::quat slerp(const glm::quat& q1, const glm::quat& q2, float alpha);
 
+    /**jsdoc
+     * Computes the spherical linear interpolations between two arrays of rotations, in a single call. This is faster than 
+     * calling {@link Quat(0).slerp|Quat.slerp} for each pair of rotations.
+     * @function Quat(0).slerpArrays
+     * @param {Quat[]} q1s - The beginning rotations.
+     * @param {Quat[]} q2s - The ending rotations.
+     * @param {number} alpha - The mixture coefficient between <code>0.0</code> and <code>1.0</code>, the same for all the 
+     *     rotations.
+     * @returns {Quat[]} The interpolations between the rotations of <code>q1s</code> and <code>q2s</code> at the same index, 
+     *     as many as there are in the shorter of the two arrays.
+     * @example <caption>Blend the rotations of the joints between two poses.</caption>
+     * var rotations = Quat.slerpArrays(startPose, endPose, blendFactor);
+     */
+    QVector<glm::quat> slerpArrays(const QVector<glm::quat>& q1s, const QVector<glm::quat>& q2s, float alpha);
+
     /**jsdoc
      * Computes a spherical quadrangle interpolation between two rotations along a path oriented toward two other rotations.
      * Equivalent to: <code>Quat.slerp(Quat.slerp(q1, q2, alpha), Quat.slerp(s1, s2, alpha), 2 * alpha * (1.0 - alpha))</code>.
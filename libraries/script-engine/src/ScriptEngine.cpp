@@ -350,6 +350,8 @@ void ScriptEngine::runDebuggable() {
             return;
         }
 
+        dispatchDueTimers();
+
         qint64 now = usecTimestampNow();
         // we check for 'now' in the past in case people set their clock back
         if (_lastUpdate < now) {
@@ -769,6 +771,7 @@ void ScriptEngine::init() {
 
     registerGlobalObject("Entities", entityScriptingInterface.data());
     registerFunction("Entities", "getMultipleEntityProperties", EntityScriptingInterface::getMultipleEntityProperties);
+    registerFunction("Entities", "findEntitiesWithProperties", EntityScriptingInterface::findEntitiesWithProperties);
     registerGlobalObject("Quat", &_quatLibrary);
     registerGlobalObject("Vec3", &_vec3Library);
     registerGlobalObject("Mat4", &_mat4Library);
@@ -1138,6 +1141,23 @@ QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fi
     return result;
 }
 
+QScriptProgram ScriptEngine::getProgram(const QString& sourceCode, const QString& fileName) {
+    // QtScript keeps the compiled form of a program for the last engine that evaluated it, so they can't be shared across
+    // engines
+    static const int MAX_PROGRAMS = 256;
+    QByteArray key = hashSourceCode(sourceCode) + fileName.toUtf8();
+    auto it = _programs.constFind(key);
+    if (it != _programs.constEnd()) {
+        return it.value();
+    }
+    if (_programs.size() >= MAX_PROGRAMS) {
+        _programs.clear();
+    }
+    QScriptProgram program { sourceCode, fileName };
+    _programs.insert(key, program);
+    return program;
+}
+
 void ScriptEngine::run() {
     if (QThread::currentThread() != qApp->thread() && _context == Context::CLIENT_SCRIPT) {
         // Flag that we're allowed to access local HTML files on UI created from C++ calls on this thread
@@ -1211,23 +1231,40 @@ void ScriptEngine::run() {
 
         // We don't want to actually sleep for too long, because it causes our scripts to hang
         // on shutdown and stop... so we want to loop and sleep until we've spent our time in
-        // purgatory, constantly checking to see if our script was asked to end
+        // purgatory, constantly checking to see if our script was asked to end.
+        // The sleep is cut short by the timers that come due in the meantime, all the timers that are due at
+        // once are called in the same pass
         bool processedEvents = false;
-        if (!_isFinished) {
+        while (!_isFinished) {
             PROFILE_RANGE(script, "processEvents-sleep");
-            std::chrono::milliseconds sleepFor =
-                std::chrono::duration_cast<std::chrono::milliseconds>(sleepUntil - clock::now());
-            if (sleepFor > std::chrono::milliseconds(0)) {
+            auto wakeUp = sleepUntil;
+            quint64 nextTimerDeadline = getNextTimerDeadline();
+            if (nextTimerDeadline != 0) {
+                quint64 now = usecTimestampNow();
+                auto timerWakeUp = clock::now() +
+                    std::chrono::microseconds(nextTimerDeadline > now ? nextTimerDeadline - now : 0);
+                wakeUp = std::min(wakeUp, timerWakeUp);
+            }
+            // round up, so that the timers are due when we wake up
+            auto sleepFor = std::chrono::duration_cast<std::chrono::microseconds>(wakeUp - clock::now());
+            if (sleepFor > std::chrono::microseconds(0)) {
                 QEventLoop loop;
                 QTimer timer;
                 timer.setSingleShot(true);
                 connect(&timer, SIGNAL(timeout()), &loop, SLOT(quit()));
-                timer.start(sleepFor.count());
+                timer.start((int)((sleepFor.count() + USECS_PER_MSEC - 1) / USECS_PER_MSEC));
                 loop.exec();
             } else {
                 QCoreApplication::processEvents();
             }
             processedEvents = true;
+
+            if (!_isFinished) {
+                dispatchDueTimers();
+            }
+            if (clock::now() >= sleepUntil) {
+                break;
+            }
         }
 
         PROFILE_RANGE(script, "ScriptMainLoop");
@@ -1282,6 +1319,8 @@ void ScriptEngine::run() {
                 auto preUpdate = clock::now();
                 {
                     PROFILE_RANGE(script, "ScriptUpdate");
+                    static const QString UPDATE_CALLBACK_NAME = "update";
+                    ScriptProfiler::Call call(_profiler, UPDATE_CALLBACK_NAME);
                     emit update(deltaTime);
                 }
                 auto postUpdate = clock::now();
@@ -1333,26 +1372,25 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
+    QList<QObject*> timers = _timerFunctionMap.keys();
     int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
+    for (auto timer : timers) {
         qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
         stopTimer(timer);
     }
+    _timerDeadlines = decltype(_timerDeadlines)();
 }
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
      // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
+    QVector<QObject*> toDelete;
+    QMutableHashIterator<QObject*, Timer> i(_timerFunctionMap);
     while (i.hasNext()) {
         i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
+        if (i.value().callback.definingEntityIdentifier != entityID) {
             continue;
         }
-        QTimer* timer = i.key();
+        QObject* timer = i.key();
         toDelete << timer; // don't delete while we're iterating. save it.
     }
     for (auto timer:toDelete) { // now reap 'em
@@ -1411,7 +1449,7 @@ void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
     }
 }
 
-void ScriptEngine::timerFired() {
+void ScriptEngine::timerFired(QObject* timer, quint64 id) {
     {
         QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
         if (!scriptEngines || scriptEngines->isStopped()) {
@@ -1420,20 +1458,34 @@ void ScriptEngine::timerFired() {
         }
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+    // the timer may have been stopped, or even replaced, by a timer called before it in the same pass
+    auto it = _timerFunctionMap.find(timer);
+    if (it == _timerFunctionMap.end() || it.value().id != id) {
+        return;
+    }
+    CallbackData timerData = it.value().callback;
 
-    if (!callingTimer->isActive()) {
+    quint64 now = usecTimestampNow();
+    quint64 latency = now > timerData.expectedFireTime ? now - timerData.expectedFireTime : 0;
+    if (it.value().isSingleShot) {
         // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
+        _timerFunctionMap.erase(it);
+        delete timer;
+    } else {
+        // keep to the original schedule, unless the timer fell a whole interval behind
+        quint64 nextFireTime = std::max(timerData.expectedFireTime + it.value().interval, now);
+        it.value().callback.expectedFireTime = nextFireTime;
+        _timerDeadlines.push({ nextFireTime, id, timer });
     }
 
     // call the associated JS function, if it exists
     if (timerData.function.isValid()) {
         PROFILE_RANGE(script, __FUNCTION__);
         auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+        {
+            ScriptProfiler::Call call(_profiler, timerData.profileName, latency);
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+        }
         auto postTimer = p_high_resolution_clock::now();
         auto elapsed = (postTimer - preTimer);
         _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
@@ -1442,27 +1494,57 @@ void ScriptEngine::timerFired() {
     }
 }
 
-QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
-
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
+void ScriptEngine::dispatchDueTimers() {
+    if (_timerDeadlines.empty()) {
+        return;
     }
+    // take all the due timers before calling any, so that the intervals the timers set or re-arm wait for the next pass
+    quint64 now = usecTimestampNow();
+    std::vector<TimerDeadline> dueTimers;
+    while (!_timerDeadlines.empty() && _timerDeadlines.top().time <= now) {
+        dueTimers.push_back(_timerDeadlines.top());
+        _timerDeadlines.pop();
+    }
+    if (dueTimers.empty()) {
+        return;
+    }
+    PROFILE_RANGE(script, "ScriptTimers");
+    for (const auto& dueTimer : dueTimers) {
+        if (_isFinished) {
+            break;
+        }
+        timerFired(dueTimer.timer, dueTimer.id);
+    }
+}
 
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
-
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
+quint64 ScriptEngine::getNextTimerDeadline() {
+    // drop the deadlines of the timers that were stopped
+    while (!_timerDeadlines.empty()) {
+        const TimerDeadline& deadline = _timerDeadlines.top();
+        auto it = _timerFunctionMap.constFind(deadline.timer);
+        if (it != _timerFunctionMap.constEnd() && it.value().id == deadline.id) {
+            return deadline.time;
+        }
+        _timerDeadlines.pop();
+    }
+    return 0;
+}
 
+QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
+    // create the handle of the timer, add it to the map, and schedule it
+    QObject* newTimer = new QObject(this);
 
-    CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
-    _timerFunctionMap.insert(newTimer, timerData);
+    QString functionName = function.property("name").toString();
+    QString profileName = "timer " + (functionName.isEmpty() ? QString("(anonymous)") : functionName);
+    if (!currentEntityIdentifier.isNull()) {
+        profileName = currentEntityIdentifier.toString() + " " + profileName;
+    }
+    quint64 interval = (quint64)std::max(intervalMS, 0) * USECS_PER_MSEC;
+    CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL, profileName, usecTimestampNow() + interval };
+    quint64 id = ++_nextTimerID;
+    _timerFunctionMap.insert(newTimer, { timerData, interval, isSingleShot, id });
+    _timerDeadlines.push({ timerData.expectedFireTime, id, newTimer });
 
-    newTimer->start(intervalMS);
     return newTimer;
 }
 
@@ -1486,9 +1568,9 @@ QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
+void ScriptEngine::stopTimer(QObject* timer) {
+    // its deadline is dropped from the heap when it comes up
     if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
         _timerFunctionMap.remove(timer);
         delete timer;
     } else {
@@ -2066,6 +2148,7 @@ void ScriptEngine::forwardHandlerCall(const EntityItemID& entityID, const QStrin
             // and the entity scripts may be for entities other than the one this is a handler for.
             // Fortunately, the definingEntityIdentifier captured the entity script id (if any) when the handler was added.
             CallbackData& handler = handlersForEvent[i];
+            ScriptProfiler::Call call(_profiler, "event " + eventName);
             callWithEnvironment(handler.definingEntityIdentifier, handler.definingSandboxURL, handler.function, QScriptValue(), eventHandlerArgs);
         }
     }
@@ -2082,6 +2165,31 @@ int ScriptEngine::getNumRunningEntityScripts() const {
     return sum;
 }
 
+QVariantMap ScriptEngine::getProfile() const {
+    QVariantMap profile;
+    profile["url"] = _fileNameString;
+    profile["callbacks"] = _profiler.getProfile();
+    return profile;
+}
+
+quint64 ScriptEngine::getEntityScriptsCPUTime() const {
+    QReadLocker locker { &_entityScriptsLock };
+    quint64 sum = 0;
+    for (const auto& st : _entityScripts) {
+        sum += st.cpuTime;
+    }
+    return sum;
+}
+
+uint32_t ScriptEngine::getNumLongEntityScriptCalls() const {
+    QReadLocker locker { &_entityScriptsLock };
+    uint32_t sum = 0;
+    for (const auto& st : _entityScripts) {
+        sum += st.numLongCalls;
+    }
+    return sum;
+}
+
 void ScriptEngine::setEntityScriptDetails(const EntityItemID& entityID, const EntityScriptDetails& details) {
     {
         QWriteLocker locker { &_entityScriptsLock };
@@ -2323,7 +2431,7 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         emit unhandledException(syntaxError);
         return;
     }
-    QScriptProgram program { contents, fileName };
+    QScriptProgram program = getProgram(contents, fileName);
     if (program.isNull()) {
         setError("Bad program (isNull)", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
         emit unhandledException(makeError("program.isNull"));
@@ -2353,7 +2461,8 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
                 );
         });
 
-        testConstructor = sandbox.evaluate(program);
+        // with a program of its own, so that the sandbox doesn't take over the compiled form of the cached one
+        testConstructor = sandbox.evaluate(QScriptProgram { contents, fileName });
 
         if (sandbox.hasUncaughtException()) {
             exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
@@ -2428,7 +2537,7 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
                     sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT)));
             });
 
-            testConstructor = sandbox.evaluate(program);
+            testConstructor = sandbox.evaluate(QScriptProgram { contents, fileName });
 
             if (sandbox.hasUncaughtException()) {
                 exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
@@ -2484,7 +2593,8 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
     QScriptValue entityScriptConstructor, entityScriptObject;
     QUrl sandboxURL = currentSandboxURL.isEmpty() ? scriptOrURL : currentSandboxURL;
     auto initialization = [&]{
-        entityScriptConstructor = evaluate(contents, fileName);
+        entityScriptConstructor = BaseScriptEngine::evaluate(program);
+        maybeEmitUncaughtException("evaluate");
         entityScriptObject = entityScriptConstructor.construct();
 
         if (hasUncaughtException()) {
@@ -2647,6 +2757,8 @@ void ScriptEngine::refreshFileScript(const EntityItemID& entityID) {
     recurseGuard = false;
 }
 
+static const uint32_t LONG_CALL_LOG_PERIOD = 100;
+
 // Execute operation in the appropriate context for (the possibly empty) entityID.
 // Even if entityID is supplied as currentEntityIdentifier, this still documents the source
 // of the code being executed (e.g., if we ever sandbox different entity scripts, or provide different
@@ -2657,6 +2769,10 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     currentEntityIdentifier = entityID;
     currentSandboxURL = sandboxURL;
 
+    // the calls made from another entity's script are counted in the time of that one
+    bool isAccounted = !entityID.isNull() && oldIdentifier.isNull();
+    quint64 startTime = isAccounted ? usecTimestampNow() : 0;
+
 #if DEBUG_CURRENT_ENTITY
     QScriptValue oldData = this->globalObject().property("debugEntityID");
     this->globalObject().setProperty("debugEntityID", entityID.toScriptValue(this)); // Make the entityID available to javascript as a global.
@@ -2665,6 +2781,26 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
 #else
     operation();
 #endif
+
+    if (isAccounted) {
+        quint64 callTime = usecTimestampNow() - startTime;
+        uint32_t numLongCalls = 0;
+        {
+            QWriteLocker locker { &_entityScriptsLock };
+            auto it = _entityScripts.find(entityID);
+            if (it != _entityScripts.end()) {
+                it->cpuTime += callTime;
+                if (callTime > ENTITY_SCRIPT_LONG_CALL_USECS) {
+                    numLongCalls = ++it->numLongCalls;
+                }
+            }
+        }
+        // every script that holds up its engine shows in the logs, without flooding them
+        if (numLongCalls == 1 || (numLongCalls > 0 && numLongCalls % LONG_CALL_LOG_PERIOD == 0)) {
+            qCWarning(scriptengine) << "Entity script" << entityID << "held up" << getFilename() << "for"
+                << callTime / USECS_PER_MSEC << "ms," << numLongCalls << "long calls so far";
+        }
+    }
     maybeEmitUncaughtException(!entityID.isNull() ? entityID.toString() : __FUNCTION__);
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
@@ -2738,6 +2874,7 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
 
             QScriptValue oldData = this->globalObject().property("Script").property("remoteCallerID");
             this->globalObject().property("Script").setProperty("remoteCallerID", remoteCallerID.toString()); // Make the remoteCallerID available to javascript as a global.
+            ScriptProfiler::Call call(_profiler, entityID.toString() + " " + methodName);
             callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
             this->globalObject().property("Script").setProperty("remoteCallerID", oldData);
         }
@@ -2776,6 +2913,7 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             QScriptValueList args;
             args << entityID.toScriptValue(this);
             args << event.toScriptValue(this);
+            ScriptProfiler::Call call(_profiler, entityID.toString() + " " + methodName);
             callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
         }
     }
@@ -2815,6 +2953,7 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             args << entityID.toScriptValue(this);
             args << otherID.toScriptValue(this);
             args << collisionToScriptValue(this, collision);
+            ScriptProfiler::Call call(_profiler, entityID.toString() + " " + methodName);
             callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
         }
     }
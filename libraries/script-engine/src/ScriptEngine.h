@@ -12,6 +12,7 @@
 #ifndef hifi_ScriptEngine_h
 #define hifi_ScriptEngine_h
 
+#include <queue>
 #include <unordered_map>
 #include <vector>
 
@@ -45,6 +46,7 @@
 #include "ConsoleScriptingInterface.h"
 #include "SettingHandle.h"
 #include "Profile.h"
+#include "ScriptProfiler.h"
 
 class QScriptEngineDebugger;
 
@@ -53,6 +55,8 @@ static const QString NO_SCRIPT("");
 static const int SCRIPT_FPS = 60;
 static const int DEFAULT_MAX_ENTITY_PPS = 9000;
 static const int DEFAULT_ENTITY_PPS_PER_SCRIPT = 900;
+// a call into an entity script that runs longer than this holds up the other scripts of its engine
+static const quint64 ENTITY_SCRIPT_LONG_CALL_USECS = 100 * 1000;
 
 class ScriptEngines;
 
@@ -63,6 +67,9 @@ public:
     QScriptValue function;
     EntityItemID definingEntityIdentifier;
     QUrl definingSandboxURL;
+    // for the profiler, of the timers
+    QString profileName;
+    quint64 expectedFireTime;
 };
 
 class DeferredLoadEntity {
@@ -97,6 +104,11 @@ public:
     QScriptValue scriptObject { QScriptValue() };
     int64_t lastModified { 0 };
     QUrl definingSandboxURL { QUrl("about:EntityScript") };
+
+    // the time spent in the calls into the script since it was loaded, in usecs, and how many of them took longer than
+    // ENTITY_SCRIPT_LONG_CALL_USECS
+    quint64 cpuTime { 0 };
+    uint32_t numLongCalls { 0 };
 };
 
 /**jsdoc
@@ -278,6 +290,37 @@ public:
      */
     Q_INVOKABLE QString getContext() const;
 
+    /**jsdoc
+     * Gets the time the script has spent in each of its callbacks since it started or {@link Script.resetProfile} was
+     * called.
+     * @function Script.getProfile
+     * @returns {Script.Profile} The time spent in each of the callbacks of the script.
+     */
+    /**jsdoc
+     * @typedef {object} Script.Profile
+     * @property {string} url - The URL of the script.
+     * @property {Script.ProfiledCallback[]} callbacks - The callbacks of the script, by decreasing total time.
+     */
+    /**jsdoc
+     * @typedef {object} Script.ProfiledCallback
+     * @property {string} name - <code>"update"</code> for the {@link Script.update} connections, <code>"timer"</code>
+     *     and the function name for the timers, <code>"event"</code> and the event name for the entity event handlers,
+     *     and the entity ID and method name for the methods of entity scripts.
+     * @property {number} calls - The number of calls.
+     * @property {number} totalTime - The total time of the calls, in ms.
+     * @property {number} averageTime - The average time of a call, in ms.
+     * @property {number} maxTime - The longest call, in ms.
+     * @property {number} averageLatency - How late a timer fires on average, in ms.
+     * @property {number} maxLatency - How late a timer fired at the most, in ms.
+     */
+    Q_INVOKABLE QVariantMap getProfile() const;
+
+    /**jsdoc
+     * Clears the times of the callbacks of the script, see {@link Script.getProfile}.
+     * @function Script.resetProfile
+     */
+    Q_INVOKABLE void resetProfile() { _profiler.reset(); }
+
     /**jsdoc
      * Checks whether the script is running as an Interface or avatar script.
      * @function Script.isClientScript
@@ -481,7 +524,7 @@ public:
      *     Script.clearInterval(timer);
      * }, 10000);
      */
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(timer); }
 
     /**jsdoc
      * Stops a timeout timer set by {@link Script.setTimeout|setTimeout}.
@@ -496,7 +539,7 @@ public:
      * // Uncomment the following line to stop the timer from firing.
      * //Script.clearTimeout(timer);
      */
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(timer); }
 
     /**jsdoc
      * Prints a message to the program log.
@@ -671,6 +714,9 @@ public:
     void scriptPrintedMessage(const QString& message);
     void clearDebugLogWindow();
     int getNumRunningEntityScripts() const;
+    // the time spent in the calls into the entity scripts of this engine, in usecs
+    quint64 getEntityScriptsCPUTime() const;
+    uint32_t getNumLongEntityScriptCalls() const;
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
     bool hasEntityScriptDetails(const EntityItemID& entityID) const;
 
@@ -897,7 +943,11 @@ protected:
     Q_INVOKABLE QString _requireResolve(const QString& moduleId, const QString& relativeTo = QString());
 
     QString logException(const QScriptValue& exception);
-    void timerFired();
+    void timerFired(QObject* timer, quint64 id);
+    // calls the timers that are due, in the order of their deadlines
+    void dispatchDueTimers();
+    // the deadline of the next timer, or 0 if there are none
+    quint64 getNextTimerDeadline();
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
     void refreshFileScript(const EntityItemID& entityID);
@@ -906,7 +956,10 @@ protected:
     void setParentURL(const QString& parentURL) { _parentURL = parentURL; }
 
     QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    void stopTimer(QObject* timer);
+
+    // the program of the source, compiled once for all the entity scripts of the engine that share it
+    QScriptProgram getProgram(const QString& sourceCode, const QString& fileName);
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
@@ -936,8 +989,26 @@ protected:
     std::atomic<bool> _isRunning { false };
     std::atomic<bool> _isStopping { false };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+    // The timers are handles to their entries in the map, the engine calls them from its own loop rather than each of them
+    // being a QTimer. The heap keeps their deadlines, of which the ones of the timers that were stopped stay in it until
+    // they come up
+    struct Timer {
+        CallbackData callback;
+        quint64 interval;
+        bool isSingleShot;
+        quint64 id;
+    };
+    struct TimerDeadline {
+        quint64 time;
+        quint64 id;
+        QObject* timer;
+        bool operator>(const TimerDeadline& other) const { return time > other.time; }
+    };
+    QHash<QObject*, Timer> _timerFunctionMap;
+    std::priority_queue<TimerDeadline, std::vector<TimerDeadline>, std::greater<TimerDeadline>> _timerDeadlines;
+    quint64 _nextTimerID { 0 };
     QSet<QUrl> _includedURLs;
+    QHash<QByteArray, QScriptProgram> _programs;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
     EntityScriptContentAvailableMap _contentAvailableQueue;
@@ -967,6 +1038,7 @@ protected:
     std::recursive_mutex _lock;
 
     std::chrono::microseconds _totalTimerExecution { 0 };
+    ScriptProfiler _profiler;
 
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
@@ -296,6 +296,17 @@ QVariantList ScriptEngines::getRunning() {
     return result;
 }
 
+QVariantList ScriptEngines::getProfiles() {
+    QVariantList result;
+    QMutexLocker locker(&_allScriptsMutex);
+    for (const auto& engine : _allKnownScriptEngines) {
+        if (engine && engine->isRunning()) {
+            result.append(engine->getProfile());
+        }
+    }
+    return result;
+}
+
 void ScriptEngines::loadDefaultScripts() {
     loadScript(DEFAULT_SCRIPTS_LOCATION);
 }
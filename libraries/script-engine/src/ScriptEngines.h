@@ -150,6 +150,13 @@ public:
      */
     Q_INVOKABLE QVariantList getRunning();
 
+    /**jsdoc
+     * Gets the time that each running script has spent in each of its callbacks.
+     * @function ScriptDiscoveryService.getProfiles
+     * @returns {Script.Profile[]} The profiles of all the running scripts, see {@link Script.getProfile}.
+     */
+    Q_INVOKABLE QVariantList getProfiles();
+
     /**jsdoc
      * Gets a list of all script files that are in the default scripts directory of the Interface installation.
      * @function ScriptDiscoveryService.getPublic
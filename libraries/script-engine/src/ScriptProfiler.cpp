@@ -0,0 +1,72 @@
+//
+//  ScriptProfiler.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProfiler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <SharedUtil.h>
+
+using Lock = std::lock_guard<std::mutex>;
+
+ScriptProfiler::Call::Call(ScriptProfiler& profiler, const QString& name, quint64 latency) :
+    _profiler(profiler),
+    _name(name),
+    _latency(latency),
+    _startTime(usecTimestampNow()),
+    _duration(trace_script_callbacks(), name) {
+}
+
+ScriptProfiler::Call::~Call() {
+    _profiler.addCall(_name, usecTimestampNow() - _startTime, _latency);
+}
+
+void ScriptProfiler::addCall(const QString& name, quint64 time, quint64 latency) {
+    Lock lock(_mutex);
+    Callback& callback = _callbacks[name];
+    callback.numCalls++;
+    callback.totalTime += time;
+    callback.maxTime = std::max(callback.maxTime, time);
+    callback.totalLatency += latency;
+    callback.maxLatency = std::max(callback.maxLatency, latency);
+}
+
+QVariantList ScriptProfiler::getProfile() const {
+    std::vector<std::pair<QString, Callback>> callbacks;
+    {
+        Lock lock(_mutex);
+        for (auto it = _callbacks.constBegin(); it != _callbacks.constEnd(); ++it) {
+            callbacks.emplace_back(it.key(), it.value());
+        }
+    }
+    std::sort(callbacks.begin(), callbacks.end(), [](const std::pair<QString, Callback>& a, const std::pair<QString, Callback>& b) {
+        return a.second.totalTime > b.second.totalTime;
+    });
+
+    QVariantList profile;
+    for (const auto& callback : callbacks) {
+        QVariantMap entry;
+        entry["name"] = callback.first;
+        entry["calls"] = (double)callback.second.numCalls;
+        entry["totalTime"] = (double)callback.second.totalTime / USECS_PER_MSEC;
+        entry["averageTime"] = (double)callback.second.totalTime / callback.second.numCalls / USECS_PER_MSEC;
+        entry["maxTime"] = (double)callback.second.maxTime / USECS_PER_MSEC;
+        entry["averageLatency"] = (double)callback.second.totalLatency / callback.second.numCalls / USECS_PER_MSEC;
+        entry["maxLatency"] = (double)callback.second.maxLatency / USECS_PER_MSEC;
+        profile.append(entry);
+    }
+    return profile;
+}
+
+void ScriptProfiler::reset() {
+    Lock lock(_mutex);
+    _callbacks.clear();
+}
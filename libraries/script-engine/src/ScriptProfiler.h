@@ -0,0 +1,59 @@
+//
+//  ScriptProfiler.h
+//  libraries/script-engine/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptProfiler_h
+#define hifi_ScriptProfiler_h
+
+#include <mutex>
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+
+#include <Profile.h>
+
+// The time a script spends in each of its callbacks: the updates, every timer, and the methods of its entity scripts,
+// along with how late the timers fire. The calls also show in the trace, in the trace.script.callbacks category
+class ScriptProfiler {
+public:
+    // profiles a call for as long as it is in scope
+    class Call {
+    public:
+        Call(ScriptProfiler& profiler, const QString& name, quint64 latency = 0);
+        ~Call();
+
+    private:
+        ScriptProfiler& _profiler;
+        const QString _name;
+        const quint64 _latency;
+        const quint64 _startTime;
+        Duration _duration;
+    };
+
+    void addCall(const QString& name, quint64 time, quint64 latency);
+
+    // the callbacks by decreasing total time, with their times in ms
+    QVariantList getProfile() const;
+    void reset();
+
+private:
+    struct Callback {
+        quint64 numCalls { 0 };
+        quint64 totalTime { 0 };
+        quint64 maxTime { 0 };
+        quint64 totalLatency { 0 };
+        quint64 maxLatency { 0 };
+    };
+
+    mutable std::mutex _mutex;
+    QHash<QString, Callback> _callbacks;
+};
+
+#endif // hifi_ScriptProfiler_h
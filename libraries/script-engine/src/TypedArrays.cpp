@@ -11,6 +11,8 @@
 
 #include "TypedArrays.h"
 
+#include <QtCore/QtEndian>
+
 #include <glm/glm.hpp>
 
 #include "ScriptEngine.h"
@@ -200,19 +202,31 @@ void TypedArray::setBytesPerElement(quint32 bytesPerElement) {
 }
 
 // templated helper functions
-// don't work for floats as they require single precision settings
+// the elements are read and written in place, in little endian, without wrapping the buffer in a stream for each access
+template<class T>
+bool readElement(const QByteArray* arrayBuffer, uint id, T& result) {
+    if (!arrayBuffer || id + sizeof(T) > (uint)arrayBuffer->size()) {
+        return false;
+    }
+    result = qFromLittleEndian<T>(arrayBuffer->constData() + id);
+    return true;
+}
+
+template<class T>
+void writeElement(QByteArray* arrayBuffer, uint id, T value) {
+    if (arrayBuffer && id + sizeof(T) <= (uint)arrayBuffer->size()) {
+        // data() only copies the bytes when they are still shared with a native QByteArray
+        qToLittleEndian<T>(value, arrayBuffer->data() + id);
+    }
+}
+
 template<class T>
 QScriptValue propertyHelper(const QByteArray* arrayBuffer, const QScriptString& name, uint id) {
     bool ok = false;
     name.toArrayIndex(&ok);
     
-    if (ok && arrayBuffer) {
-        QDataStream stream(*arrayBuffer);
-        stream.skipRawData(id);
-        
-        stream.setByteOrder(QDataStream::LittleEndian);
-        T result;
-        stream >> result;
+    T result;
+    if (ok && readElement(arrayBuffer, id, result)) {
         return result;
     }
     return QScriptValue();
@@ -220,12 +234,8 @@ QScriptValue propertyHelper(const QByteArray* arrayBuffer, const QScriptString&
 
 template<class T>
 void setPropertyHelper(QByteArray* arrayBuffer, const QScriptString& name, uint id, const QScriptValue& value) {
-    if (arrayBuffer && value.isNumber()) {
-        QDataStream stream(arrayBuffer, QIODevice::ReadWrite);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        
-        stream << (T)value.toNumber();
+    if (value.isNumber()) {
+        writeElement<T>(arrayBuffer, id, (T)value.toNumber());
     }
 }
 
@@ -274,15 +284,13 @@ QScriptValue Uint8ClampedArrayClass::property(const QScriptValue& object, const
 void Uint8ClampedArrayClass::setProperty(QScriptValue& object, const QScriptString& name,
                                   uint id, const QScriptValue& value) {
     QByteArray* ba = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
-    if (ba && value.isNumber()) {
-        QDataStream stream(ba, QIODevice::ReadWrite);
-        stream.skipRawData(id);
+    if (value.isNumber()) {
         if (value.toNumber() > 255) {
-            stream << (quint8)255;
+            writeElement<quint8>(ba, id, 255);
         } else if (value.toNumber() < 0) {
-            stream << (quint8)0;
+            writeElement<quint8>(ba, id, 0);
         } else {
-            stream << (quint8)glm::clamp(qRound(value.toNumber()), 0, 255);
+            writeElement<quint8>(ba, id, (quint8)glm::clamp(qRound(value.toNumber()), 0, 255));
         }
     }
 }
@@ -360,14 +368,8 @@ QScriptValue Float32ArrayClass::property(const QScriptValue& object, const QScri
     QByteArray* arrayBuffer = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());bool ok = false;
     name.toArrayIndex(&ok);
     
-    if (ok && arrayBuffer) {
-        QDataStream stream(*arrayBuffer);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
-        
-        float result;
-        stream >> result;
+    float result;
+    if (ok && readElement(arrayBuffer, id, result)) {
         if (isNaN(result)) {
             return QScriptValue();
         }
@@ -379,13 +381,8 @@ QScriptValue Float32ArrayClass::property(const QScriptValue& object, const QScri
 void Float32ArrayClass::setProperty(QScriptValue& object, const QScriptString& name,
                                   uint id, const QScriptValue& value) {
     QByteArray* ba = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
-    if (ba && value.isNumber()) {
-        QDataStream stream(ba, QIODevice::ReadWrite);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
-        
-        stream << (float)value.toNumber();
+    if (value.isNumber()) {
+        writeElement<float>(ba, id, (float)value.toNumber());
     }
 }
 
@@ -397,14 +394,8 @@ QScriptValue Float64ArrayClass::property(const QScriptValue& object, const QScri
     QByteArray* arrayBuffer = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());bool ok = false;
     name.toArrayIndex(&ok);
     
-    if (ok && arrayBuffer) {
-        QDataStream stream(*arrayBuffer);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
-        
-        double result;
-        stream >> result;
+    double result;
+    if (ok && readElement(arrayBuffer, id, result)) {
         if (isNaN(result)) {
             return QScriptValue();
         }
@@ -416,13 +407,8 @@ QScriptValue Float64ArrayClass::property(const QScriptValue& object, const QScri
 void Float64ArrayClass::setProperty(QScriptValue& object, const QScriptString& name,
                                   uint id, const QScriptValue& value) {
     QByteArray* ba = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
-    if (ba && value.isNumber()) {
-        QDataStream stream(ba, QIODevice::ReadWrite);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
-        
-        stream << (double)value.toNumber();
+    if (value.isNumber()) {
+        writeElement<double>(ba, id, (double)value.toNumber());
     }
 }
 
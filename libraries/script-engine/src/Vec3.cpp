@@ -28,6 +28,14 @@ float Vec3::orientedAngle(const glm::vec3& v1, const glm::vec3& v2, const glm::v
     return glm::degrees(radians);
 }
 
+QVector<glm::vec3> Vec3::multiplyQbyVArray(const glm::quat& q, const QVector<glm::vec3>& vs) {
+    QVector<glm::vec3> result(vs.size());
+    for (int i = 0; i < vs.size(); i++) {
+        result[i] = q * vs[i];
+    }
+    return result;
+}
+
 void Vec3::print(const QString& label, const glm::vec3& v) {
     QString message = QString("%1 %2").arg(qPrintable(label));
     message = message.arg(glm::to_string(glm::dvec3(v)).c_str());
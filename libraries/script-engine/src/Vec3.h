@@ -17,9 +17,11 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QString>
+#include <QtCore/QVector>
 #include <QtScript/QScriptable>
 
 #include "GLMHelpers.h"
+#include "RegisteredMetaTypes.h"
 
 /**jsdoc
  * The <code>Vec3</code> API provides facilities for generating and manipulating 3-dimensional vectors. High Fidelity uses a 
@@ -185,6 +187,16 @@ public slots:
      * print(JSON.stringify(result));  // {"x":0,"y":1.000,"z":1.19e-7}
      */
     glm::vec3 multiplyQbyV(const glm::quat& q, const glm::vec3& v) { return q * v; }
+
+    /**jsdoc
+     * Rotates an array of vectors, in a single call. This is faster than calling 
+     * {@link Vec3(0).multiplyQbyV|Vec3.multiplyQbyV} for each vector.
+     * @function Vec3(0).multiplyQbyVArray
+     * @param {Quat} q - The rotation to apply.
+     * @param {Vec3[]} vs - The vectors to rotate.
+     * @returns {Vec3[]} The vectors rotated by <code>q</code>.
+     */
+    QVector<glm::vec3> multiplyQbyVArray(const glm::quat& q, const QVector<glm::vec3>& vs);
     
     /**jsdoc
      * Calculates the sum of two vectors.
@@ -12,6 +12,10 @@
 #include "BaseScriptEngine.h"
 #include "SharedLogging.h"
 
+#include <mutex>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QSet>
 #include <QtCore/QString>
 #include <QtCore/QThread>
 #include <QtCore/QUrl>
@@ -73,10 +77,28 @@ QScriptValue BaseScriptEngine::makeError(const QScriptValue& _other, const QStri
 }
 
 // check syntax and when there are issues returns an actual "SyntaxError" with the details
+QByteArray BaseScriptEngine::hashSourceCode(const QString& sourceCode) {
+    return QCryptographicHash::hash(QByteArray::fromRawData(reinterpret_cast<const char*>(sourceCode.constData()),
+        sourceCode.size() * (int)sizeof(QChar)), QCryptographicHash::Sha1);
+}
+
+// The sources that passed the syntax check, in any engine of the process, so that the copies of a script that many entities
+// run are only checked once
+static std::mutex validSourcesMutex;
+static QSet<QByteArray> validSources;
+static const int MAX_VALID_SOURCES = 1024;
+
 QScriptValue BaseScriptEngine::lintScript(const QString& sourceCode, const QString& fileName, const int lineNumber) {
     if (!IS_THREADSAFE_INVOCATION(thread(), __FUNCTION__)) {
         return unboundNullValue();
     }
+    const auto sourceHash = hashSourceCode(sourceCode);
+    {
+        std::lock_guard<std::mutex> lock(validSourcesMutex);
+        if (validSources.contains(sourceHash)) {
+            return QScriptValue();
+        }
+    }
     const auto syntaxCheck = checkSyntax(sourceCode);
     if (syntaxCheck.state() != QScriptSyntaxCheckResult::Valid) {
         auto err = globalObject().property("SyntaxError")
@@ -95,6 +117,13 @@ QScriptValue BaseScriptEngine::lintScript(const QString& sourceCode, const QStri
         }
         return err;
     }
+    {
+        std::lock_guard<std::mutex> lock(validSourcesMutex);
+        if (validSources.size() >= MAX_VALID_SOURCES) {
+            validSources.clear();
+        }
+        validSources.insert(sourceHash);
+    }
     return QScriptValue();
 }
 
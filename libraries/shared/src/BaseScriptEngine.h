@@ -71,6 +71,9 @@ public:
 
     // helper to detect and log warnings when other code invokes QScriptEngine/BaseScriptEngine in thread-unsafe ways
     static bool IS_THREADSAFE_INVOCATION(const QThread *thread, const QString& method);
+
+    // a digest of the source code, that the caches of the scripts are keyed by
+    static QByteArray hashSourceCode(const QString& sourceCode);
 signals:
     /**jsdoc
      * @function Script.signalHandlerException
@@ -12,12 +12,17 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <mutex>
+
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QMutex>
 #include <QtCore/QQueue>
+#include <QtCore/QThread>
 #include <QtCore/QWaitCondition>
 
 #include "GenericThread.h"
+#include "MPSCQueue.h"
 #include "NumericalConstants.h"
 
 template <typename T>
@@ -96,4 +101,105 @@ protected:
     QMutex _hasItemsMutex;
 };
 
+// The same as GenericQueueThread, for the queues that many threads feed at a high rate. The items go through a
+// lock-free MPSCQueue, so the producers don't contend on a lock. The thread spins and then yields for a while when
+// the queue runs dry before it parks, and the producers only wake it while it is parked. A producer that finds the
+// queue full waits for the thread to catch up.
+template <typename T, size_t CAPACITY = 4096>
+class GenericMPSCQueueThread : public GenericThread {
+public:
+    using Queue = QQueue<T>;
+    GenericMPSCQueueThread(QObject* parent = nullptr)
+        : GenericThread() {}
+
+    virtual ~GenericMPSCQueueThread() {}
+
+    void queueItem(const T& t) {
+        while (!_queue.tryPush(t)) {
+            wakeParked();
+            QThread::yieldCurrentThread();
+        }
+        wakeParked();
+    }
+
+    void waitIdle(uint32_t maxWaitMs = UINT32_MAX) {
+        QElapsedTimer timer;
+        timer.start();
+        // FIXME as with GenericQueueThread, this only works if the waiting thread is the only producer
+        while (timer.elapsed() < maxWaitMs) {
+            if (isQueueEmpty()) {
+                return;
+            }
+        }
+    }
+
+    virtual bool process() override {
+        waitForItems();
+
+        Queue processItems;
+        {
+            std::lock_guard<std::mutex> lock(_consumerMutex);
+            _queue.popBatch(processItems, CAPACITY);
+        }
+        if (processItems.isEmpty()) {
+            return isStillRunning();
+        }
+        return processQueueItems(processItems);
+    }
+
+protected:
+    static const int MAX_SPINS = 64;
+    static const int MAX_YIELDS = 16;
+
+    virtual uint32_t getMaxWait() {
+        return MSECS_PER_SECOND;
+    }
+
+    virtual bool processQueueItems(const Queue& items) = 0;
+
+    // process may also be called from other threads than the queue's own, so the consumer side is still locked,
+    // which only the consumers ever contend on
+    bool isQueueEmpty() {
+        std::lock_guard<std::mutex> lock(_consumerMutex);
+        return _queue.isEmpty();
+    }
+
+    void waitForItems() {
+        for (int i = 0; i < MAX_SPINS + MAX_YIELDS; ++i) {
+            if (!isQueueEmpty()) {
+                return;
+            }
+            if (i >= MAX_SPINS) {
+                QThread::yieldCurrentThread();
+            }
+        }
+
+        _hasItemsMutex.lock();
+        _numParked.fetch_add(1, std::memory_order_relaxed);
+        // pairs with the fence in wakeParked, either the producer sees the thread parked or the thread sees the item
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (isQueueEmpty()) {
+            _hasItems.wait(&_hasItemsMutex, getMaxWait());
+        }
+        _numParked.fetch_sub(1, std::memory_order_relaxed);
+        _hasItemsMutex.unlock();
+    }
+
+    void wakeParked() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_numParked.load(std::memory_order_relaxed) > 0) {
+            // the thread holds this until it waits, so it can't miss the wake
+            _hasItemsMutex.lock();
+            _hasItems.wakeAll();
+            _hasItemsMutex.unlock();
+        }
+    }
+
+    MPSCQueue<T, CAPACITY> _queue;
+    std::mutex _consumerMutex;
+    std::atomic<int> _numParked { 0 };
+    QWaitCondition _hasItems;
+    QMutex _hasItemsMutex;
+};
+
 #endif // hifi_GenericQueueThread_h
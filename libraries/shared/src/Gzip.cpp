@@ -11,13 +11,38 @@
 
 #include "Gzip.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QtEndian>
+
 #include <zlib.h>
 
 const int GZIP_WINDOWS_BIT = 31;
-const int GZIP_CHUNK_SIZE = 4096;
+const int RAW_DEFLATE_WINDOWS_BIT = -15;
+const int GZIP_CHUNK_SIZE = 64 * 1024;
 const int DEFAULT_MEM_LEVEL = 8;
 
-bool gunzip(QByteArray source, QByteArray &destination) {
+const int GZIP_HEADER_SIZE = 10;
+const int GZIP_TRAILER_SIZE = 8;
+const char GZIP_HEADER[GZIP_HEADER_SIZE] = { '\x1f', '\x8b', Z_DEFLATED, 0, 0, 0, 0, 0, 0, 3 };
+
+// the size in the trailer is only a hint, the larger ones aren't trusted to reserve the destination
+const quint32 MAX_GUNZIP_RESERVE_SIZE = 256 * 1024 * 1024;
+
+// the sources this large are compressed in blocks on several threads
+const int PARALLEL_GZIP_MIN_SIZE = 4 * 1024 * 1024;
+const int PARALLEL_GZIP_BLOCK_SIZE = 1024 * 1024;
+
+// each block is primed with the end of the block before it, so they compress almost as well as a single stream
+const int DEFLATE_DICTIONARY_SIZE = 32 * 1024;
+
+// a sync flush ends a block with an empty stored block
+const int SYNC_FLUSH_SIZE = 16;
+
+bool gunzip(const QByteArray& source, QByteArray &destination) {
     destination.clear();
     if (source.length() == 0) {
         return true;
@@ -36,65 +61,153 @@ bool gunzip(QByteArray source, QByteArray &destination) {
         return false;
     }
 
-    char *sourceData = source.data();
-    int sourceDataLength = source.length();
+    // the trailer ends with the size of the data, modulo 2^32
+    if (source.length() >= GZIP_HEADER_SIZE + GZIP_TRAILER_SIZE) {
+        quint32 size = qFromLittleEndian<quint32>(source.constData() + source.length() - sizeof(quint32));
+        destination.reserve((int)std::min(size, MAX_GUNZIP_RESERVE_SIZE));
+    }
+
+    strm.next_in = (unsigned char*)source.constData();
+    strm.avail_in = (uInt)source.length();
+    int outputSize = 0;
 
     for (;;) {
-        int chunkSize = qMin(GZIP_CHUNK_SIZE, sourceDataLength);
-        if (chunkSize <= 0) {
-            break;
+        // the data is inflated straight into the destination, which grows as needed
+        if (destination.size() - outputSize < GZIP_CHUNK_SIZE) {
+            destination.resize(std::max(destination.capacity(), outputSize + std::max(GZIP_CHUNK_SIZE, outputSize / 2)));
         }
+        strm.next_out = (unsigned char*)destination.data() + outputSize;
+        strm.avail_out = (uInt)(destination.size() - outputSize);
 
-        strm.next_in = (unsigned char*)sourceData;
-        strm.avail_in = chunkSize;
-        sourceData += chunkSize;
-        sourceDataLength -= chunkSize;
+        status = inflate(&strm, Z_NO_FLUSH);
+        outputSize = destination.size() - (int)strm.avail_out;
 
-        for (;;) {
-            char out[GZIP_CHUNK_SIZE];
+        if (status == Z_STREAM_END) {
+            // another member follows, anything else after the end is ignored
+            if (strm.avail_in < 2 || strm.next_in[0] != (unsigned char)GZIP_HEADER[0] ||
+                    strm.next_in[1] != (unsigned char)GZIP_HEADER[1]) {
+                break;
+            }
+            if (inflateReset(&strm) != Z_OK) {
+                status = Z_STREAM_ERROR;
+                break;
+            }
+        } else if (status != Z_OK) {
+            // with room left to inflate into, a Z_BUF_ERROR means the data is truncated
+            break;
+        }
+    }
 
-            strm.next_out = (unsigned char*)out;
-            strm.avail_out = GZIP_CHUNK_SIZE;
+    inflateEnd(&strm);
+    destination.resize(outputSize);
+    return status == Z_STREAM_END;
+}
 
-            status = inflate(&strm, Z_NO_FLUSH);
+// Compresses a block of a source into raw deflate data. The blocks but the last end on a byte boundary, without
+// the final bit, so that they can be put one after the other into a deflate stream
+static bool deflateBlock(const char* data, int size, int dictionarySize, bool isLast, int compressionLevel,
+                         QByteArray& destination) {
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
 
-            switch (status) {
-                case Z_NEED_DICT:
-                    status = Z_DATA_ERROR;
-                    // FALLTHRU
-                case Z_DATA_ERROR:
-                case Z_MEM_ERROR:
-                case Z_STREAM_ERROR:
-                    inflateEnd(&strm);
-                    return false;
-            }
+    int status = deflateInit2(&strm, compressionLevel, Z_DEFLATED, RAW_DEFLATE_WINDOWS_BIT, DEFAULT_MEM_LEVEL,
+                              Z_DEFAULT_STRATEGY);
+    if (status != Z_OK) {
+        return false;
+    }
+    if (dictionarySize > 0) {
+        // the dictionary is the end of the previous block, right before this one in the source
+        status = deflateSetDictionary(&strm, (const unsigned char*)data - dictionarySize, (uInt)dictionarySize);
+        if (status != Z_OK) {
+            deflateEnd(&strm);
+            return false;
+        }
+    }
 
-            int available = (GZIP_CHUNK_SIZE - strm.avail_out);
-            if (available > 0) {
-                destination.append((char*)out, available);
-            }
+    destination.resize((int)deflateBound(&strm, (uLong)size) + SYNC_FLUSH_SIZE);
+    strm.next_in = (unsigned char*)data;
+    strm.avail_in = (uInt)size;
+    strm.next_out = (unsigned char*)destination.data();
+    strm.avail_out = (uInt)destination.size();
 
-            if (strm.avail_out != 0) {
-                break;
+    status = deflate(&strm, isLast ? Z_FINISH : Z_SYNC_FLUSH);
+    bool success = isLast ? (status == Z_STREAM_END) : (status == Z_OK && strm.avail_in == 0 && strm.avail_out > 0);
+    destination.resize((int)strm.total_out);
+    deflateEnd(&strm);
+    return success;
+}
+
+// Compresses the blocks of a large source on several threads, into the one deflate stream of a single gzip member,
+// the way pigz does
+static bool parallelGzip(const QByteArray& source, QByteArray &destination, int compressionLevel) {
+    const int sourceSize = source.length();
+    const int numBlocks = (sourceSize + PARALLEL_GZIP_BLOCK_SIZE - 1) / PARALLEL_GZIP_BLOCK_SIZE;
+    std::vector<QByteArray> blocks(numBlocks);
+    std::vector<uLong> blockCRCs(numBlocks);
+    std::atomic<int> nextBlock { 0 };
+    std::atomic<bool> failed { false };
+
+    auto compressBlocks = [&] {
+        for (int block = nextBlock++; block < numBlocks && !failed; block = nextBlock++) {
+            int offset = block * PARALLEL_GZIP_BLOCK_SIZE;
+            int size = std::min(PARALLEL_GZIP_BLOCK_SIZE, sourceSize - offset);
+            const char* data = source.constData() + offset;
+            blockCRCs[block] = crc32(0L, (const unsigned char*)data, (uInt)size);
+            if (!deflateBlock(data, size, std::min(offset, DEFLATE_DICTIONARY_SIZE), block == numBlocks - 1,
+                              compressionLevel, blocks[block])) {
+                failed = true;
             }
         }
+    };
 
-        if (status == Z_STREAM_END) {
-            break;
+    int numThreads = std::min(numBlocks, (int)std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+    for (int i = 1; i < numThreads; i++) {
+        threads.emplace_back(compressBlocks);
+    }
+    compressBlocks();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (failed) {
+        return false;
+    }
+
+    int compressedSize = GZIP_HEADER_SIZE + GZIP_TRAILER_SIZE;
+    uLong crc = blockCRCs[0];
+    for (int block = 0; block < numBlocks; block++) {
+        compressedSize += blocks[block].size();
+        if (block > 0) {
+            int size = std::min(PARALLEL_GZIP_BLOCK_SIZE, sourceSize - block * PARALLEL_GZIP_BLOCK_SIZE);
+            crc = crc32_combine(crc, blockCRCs[block], size);
         }
     }
 
-    inflateEnd(&strm);
-    return status == Z_STREAM_END;
+    destination.reserve(compressedSize);
+    destination.append(GZIP_HEADER, GZIP_HEADER_SIZE);
+    for (const auto& block : blocks) {
+        destination.append(block);
+    }
+    char trailer[GZIP_TRAILER_SIZE];
+    qToLittleEndian<quint32>((quint32)crc, trailer);
+    qToLittleEndian<quint32>((quint32)sourceSize, trailer + sizeof(quint32));
+    destination.append(trailer, GZIP_TRAILER_SIZE);
+    return true;
 }
 
-bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
+bool gzip(const QByteArray& source, QByteArray &destination, int compressionLevel) {
     destination.clear();
     if (source.length() == 0) {
         return true;
     }
 
-    int flushOrFinish = 0;
+    compressionLevel = qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel));
+    if (source.length() >= PARALLEL_GZIP_MIN_SIZE && std::thread::hardware_concurrency() > 1) {
+        return parallelGzip(source, destination, compressionLevel);
+    }
+
     z_stream strm;
     strm.zalloc = Z_NULL;
     strm.zfree = Z_NULL;
@@ -103,7 +216,7 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     strm.avail_in = 0;
 
     int status = deflateInit2(&strm,
-                              qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel)),
+                              compressionLevel,
                               Z_DEFLATED,
                               GZIP_WINDOWS_BIT,
                               DEFAULT_MEM_LEVEL,
@@ -111,44 +224,16 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     if (status != Z_OK) {
         return false;
     }
-    char *sourceData = source.data();
-    int sourceDataLength = source.length();
 
-    for (;;) {
-        int chunkSize = qMin(GZIP_CHUNK_SIZE, sourceDataLength);
-        strm.next_in = (unsigned char*)sourceData;
-        strm.avail_in = chunkSize;
-        sourceData += chunkSize;
-        sourceDataLength -= chunkSize;
-
-        if (sourceDataLength <= 0) {
-            flushOrFinish = Z_FINISH;
-        } else {
-            flushOrFinish = Z_NO_FLUSH;
-        }
+    // the bound is enough to compress the whole source in a single call, straight into the destination
+    destination.resize((int)deflateBound(&strm, (uLong)source.length()));
+    strm.next_in = (unsigned char*)source.constData();
+    strm.avail_in = (uInt)source.length();
+    strm.next_out = (unsigned char*)destination.data();
+    strm.avail_out = (uInt)destination.size();
 
-        for (;;) {
-            char out[GZIP_CHUNK_SIZE];
-            strm.next_out = (unsigned char*)out;
-            strm.avail_out = GZIP_CHUNK_SIZE;
-            status = deflate(&strm, flushOrFinish);
-            if (status == Z_STREAM_ERROR) {
-                deflateEnd(&strm);
-                return false;
-            }
-            int available = (GZIP_CHUNK_SIZE - strm.avail_out);
-            if (available > 0) {
-                destination.append((char*)out, available);
-            }
-            if (strm.avail_out != 0) {
-                break;
-            }
-        }
-
-        if (flushOrFinish == Z_FINISH) {
-            break;
-        }
-    }
+    status = deflate(&strm, Z_FINISH);
+    destination.resize((int)strm.total_out);
 
     deflateEnd(&strm);
     return status == Z_STREAM_END;
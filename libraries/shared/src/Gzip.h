@@ -19,9 +19,14 @@
 // compression at all (the input data is simply copied a block at a
 // time).  Z_DEFAULT_COMPRESSION requests a default compromise between
 // speed and compression (currently equivalent to level 6).
+//
+// The large sources are compressed in blocks on several threads, into a
+// single gzip stream that any gunzip reads. The source and the destination
+// must be distinct.
 
-bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1); // -1 is Z_DEFAULT_COMPRESSION
+bool gzip(const QByteArray& source, QByteArray &destination, int compressionLevel = -1); // -1 is Z_DEFAULT_COMPRESSION
 
-bool gunzip(QByteArray source, QByteArray &destination);
+// Reads the members of a gzip file one after the other, the way gunzip does
+bool gunzip(const QByteArray& source, QByteArray &destination);
 
 #endif
@@ -0,0 +1,182 @@
+//
+//  IndexedHeap.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_IndexedHeap_h
+#define hifi_IndexedHeap_h
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// A d-ary heap of values with unique keys. It keeps track of where each key is in the heap, so that membership is O(1)
+// and the value for a key can be replaced, or removed, in place rather than queued a second time. Like
+// std::priority_queue the top is the greatest value according to Compare.
+template <typename Key, typename Value, typename Compare = std::less<Value>, int ARITY = 4>
+class IndexedHeap {
+public:
+    static_assert(ARITY >= 2, "a heap needs at least two children per node");
+
+    bool empty() const { return _heap.empty(); }
+    size_t size() const { return _heap.size(); }
+
+    const Key& topKey() const { assert(!empty()); return _heap.front().key; }
+    const Value& top() const { assert(!empty()); return _heap.front().value; }
+
+    bool contains(const Key& key) const { return _index.find(key) != _index.end(); }
+
+    const Value* find(const Key& key) const {
+        auto it = _index.find(key);
+        return it != _index.end() ? &_heap[it->second].value : nullptr;
+    }
+
+    // adds the value for the key, or replaces the one it already has and moves it to its new place
+    void set(const Key& key, Value value) {
+        auto it = _index.find(key);
+        if (it == _index.end()) {
+            size_t i = _heap.size();
+            _index.emplace(key, i);
+            _heap.push_back({ key, std::move(value) });
+            siftUp(i);
+            return;
+        }
+
+        size_t i = it->second;
+        bool raised = _compare(_heap[i].value, value);
+        _heap[i].value = std::move(value);
+        if (raised) {
+            siftUp(i);
+        } else {
+            siftDown(i);
+        }
+    }
+
+    void pop() {
+        assert(!empty());
+        removeAt(0);
+    }
+
+    bool remove(const Key& key) {
+        auto it = _index.find(key);
+        if (it == _index.end()) {
+            return false;
+        }
+        removeAt(it->second);
+        return true;
+    }
+
+    // calls the operator on every value, which can change it and returns whether to keep it, then rebuilds the heap in
+    // linear time
+    template <typename Operator>
+    void update(const Operator& valueOperator) {
+        std::vector<Entry> oldHeap;
+        oldHeap.swap(_heap);
+        _index.clear();
+        for (auto& entry : oldHeap) {
+            if (valueOperator(entry.value)) {
+                _index.emplace(entry.key, _heap.size());
+                _heap.push_back(std::move(entry));
+            }
+        }
+        if (_heap.size() > 1) {
+            for (size_t i = (_heap.size() - 2) / ARITY + 1; i-- > 0;) {
+                siftDown(i);
+            }
+        }
+    }
+
+    void clear() {
+        _heap.clear();
+        _index.clear();
+    }
+
+    void swap(IndexedHeap& other) {
+        std::swap(_heap, other._heap);
+        std::swap(_index, other._index);
+    }
+
+private:
+    struct Entry {
+        Key key;
+        Value value;
+    };
+
+    void removeAt(size_t i) {
+        _index.erase(_heap[i].key);
+        size_t last = _heap.size() - 1;
+        if (i != last) {
+            _heap[i] = std::move(_heap[last]);
+            _heap.pop_back();
+            _index[_heap[i].key] = i;
+            if (i > 0 && _compare(_heap[(i - 1) / ARITY].value, _heap[i].value)) {
+                siftUp(i);
+            } else {
+                siftDown(i);
+            }
+        } else {
+            _heap.pop_back();
+        }
+    }
+
+    void siftUp(size_t i) {
+        Entry entry = std::move(_heap[i]);
+        while (i > 0) {
+            size_t parent = (i - 1) / ARITY;
+            if (!_compare(_heap[parent].value, entry.value)) {
+                break;
+            }
+            moveTo(parent, i);
+            i = parent;
+        }
+        place(std::move(entry), i);
+    }
+
+    void siftDown(size_t i) {
+        Entry entry = std::move(_heap[i]);
+        size_t size = _heap.size();
+        while (true) {
+            size_t firstChild = i * ARITY + 1;
+            if (firstChild >= size) {
+                break;
+            }
+            size_t largest = firstChild;
+            size_t lastChild = std::min(firstChild + ARITY, size);
+            for (size_t child = firstChild + 1; child < lastChild; child++) {
+                if (_compare(_heap[largest].value, _heap[child].value)) {
+                    largest = child;
+                }
+            }
+            if (!_compare(entry.value, _heap[largest].value)) {
+                break;
+            }
+            moveTo(largest, i);
+            i = largest;
+        }
+        place(std::move(entry), i);
+    }
+
+    void moveTo(size_t from, size_t to) {
+        _heap[to] = std::move(_heap[from]);
+        _index[_heap[to].key] = to;
+    }
+
+    void place(Entry&& entry, size_t i) {
+        _index[entry.key] = i;
+        _heap[i] = std::move(entry);
+    }
+
+    std::vector<Entry> _heap;
+    std::unordered_map<Key, size_t> _index;
+    Compare _compare;
+};
+
+#endif // hifi_IndexedHeap_h
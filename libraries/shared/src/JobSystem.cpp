@@ -0,0 +1,84 @@
+//
+//  JobSystem.cpp
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JobSystem.h"
+
+#include <cassert>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task.h>
+
+using namespace jobs;
+
+static tbb::priority_t toTBBPriority(Priority priority) {
+    switch (priority) {
+        case Priority::Low:
+            return tbb::priority_low;
+        case Priority::High:
+            return tbb::priority_high;
+        default:
+            return tbb::priority_normal;
+    }
+}
+
+class FunctionTask : public tbb::task {
+public:
+    FunctionTask(std::function<void()> job) : _job(std::move(job)) {}
+
+    tbb::task* execute() override {
+        _job();
+        return nullptr;
+    }
+
+private:
+    std::function<void()> _job;
+};
+
+void jobs::run(std::function<void()> job, Priority priority) {
+    tbb::task::enqueue(*new (tbb::task::allocate_root()) FunctionTask(std::move(job)), toTBBPriority(priority));
+}
+
+void jobs::parallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& body,
+        Priority priority) {
+    if (begin >= end) {
+        return;
+    }
+    tbb::task_group_context context;
+    context.set_priority(toTBBPriority(priority));
+    tbb::parallel_for(tbb::blocked_range<size_t>(begin, end, grainSize), [&](const tbb::blocked_range<size_t>& range) {
+        body(range.begin(), range.end());
+    }, tbb::auto_partitioner(), context);
+}
+
+Graph::Graph() : _graph(_context), _start(_graph) {
+}
+
+Graph::NodeID Graph::add(std::function<void()> job, std::initializer_list<NodeID> dependencies) {
+    NodeID id = _nodes.size();
+    _nodes.emplace_back(new Node(_graph, [job](const tbb::flow::continue_msg&) {
+        job();
+    }));
+    Node& node = *_nodes.back();
+    if (dependencies.size() == 0) {
+        tbb::flow::make_edge(_start, node);
+    }
+    for (NodeID dependency : dependencies) {
+        assert(dependency < id);
+        tbb::flow::make_edge(*_nodes[dependency], node);
+    }
+    return id;
+}
+
+void Graph::run(Priority priority) {
+    _context.set_priority(toTBBPriority(priority));
+    _start.try_put(tbb::flow::continue_msg());
+    _graph.wait_for_all();
+}
@@ -0,0 +1,76 @@
+//
+//  JobSystem.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_JobSystem_h
+#define hifi_JobSystem_h
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#ifdef _WIN32
+#pragma warning( push )
+#pragma warning( disable : 4334 )
+#endif
+
+#include <tbb/flow_graph.h>
+#include <tbb/task_group.h>
+
+#ifdef _WIN32
+#pragma warning( pop )
+#endif
+
+// The jobs of the render, workload, physics and animation all run on the one pool of worker threads of the process, TBB's,
+// which steal work from each other, rather than on threads of their own. The jobs that a frame waits on go ahead of the
+// others by their priority. The work that needs to stay within some number of threads runs in a tbb::task_arena, as
+// PhysicsTaskScheduler does
+namespace jobs {
+
+enum class Priority {
+    Low,
+    Normal,
+    High
+};
+
+// runs the job on a worker, without waiting for it
+void run(std::function<void()> job, Priority priority = Priority::Normal);
+
+// runs the body over [begin, end) in ranges of at least grainSize, and waits for all of them
+void parallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& body,
+    Priority priority = Priority::Normal);
+
+// The jobs of a frame and their dependencies, built once and run every frame. Each job runs once all of the jobs it
+// depends on have, and those that don't depend on each other run in parallel
+class Graph {
+public:
+    using NodeID = size_t;
+
+    Graph();
+
+    // the dependencies are jobs added before this one
+    NodeID add(std::function<void()> job, std::initializer_list<NodeID> dependencies = {});
+
+    // runs all of the jobs and waits for them
+    void run(Priority priority = Priority::Normal);
+
+private:
+    using Node = tbb::flow::continue_node<tbb::flow::continue_msg>;
+
+    tbb::task_group_context _context;
+    tbb::flow::graph _graph;
+    tbb::flow::broadcast_node<tbb::flow::continue_msg> _start;
+    std::vector<std::unique_ptr<Node>> _nodes;
+};
+
+}
+
+#endif // hifi_JobSystem_h
@@ -12,6 +12,7 @@
 
 #include "LogHandler.h"
 
+#include <algorithm>
 #include <mutex>
 
 #ifdef Q_OS_WIN
@@ -19,14 +20,37 @@
 #endif
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
 #include <QtCore/QDateTime>
 #include <QtCore/QDebug>
+#include <QtCore/QDir>
 #include <QtCore/QMutexLocker>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
+#include "GenericQueueThread.h"
+
 QMutex LogHandler::_mutex(QMutex::Recursive);
 
+// how long a fatal message waits for the messages before it to be written
+static const uint32_t MAX_FATAL_WAIT_MSECS = 100;
+// how long stopping the writer waits for it to write the messages it has
+static const uint32_t MAX_STOP_WAIT_MSECS = 1000;
+
+static const char BINARY_LOG_TAG[] = "HFLB";
+static const quint8 BINARY_LOG_VERSION = 1;
+
+class LogWriterThread : public GenericMPSCQueueThread<LogHandler::Record> {
+protected:
+    bool processQueueItems(const Queue& records) override {
+        auto& handler = LogHandler::getInstance();
+        for (const auto& record : records) {
+            handler.writeMessage(record, record.formatted.isEmpty() ? handler.formatMessage(record) : record.formatted);
+        }
+        return true;
+    }
+};
+
 LogHandler& LogHandler::getInstance() {
     static LogHandler staticInstance;
     return staticInstance;
@@ -78,71 +102,227 @@ void LogHandler::setShouldDisplayMilliseconds(bool shouldDisplayMilliseconds) {
 }
 
 
-void LogHandler::flushRepeatedMessages() {
+bool LogHandler::setBinarySinkFile(const QString& filename) {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    _binarySink.reset();
+    if (filename.isEmpty()) {
+        return true;
+    }
+
+    std::unique_ptr<QFile> file(new QFile(filename));
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    file->write(BINARY_LOG_TAG, sizeof(BINARY_LOG_TAG) - 1);
+    file->write((const char*)&BINARY_LOG_VERSION, sizeof(BINARY_LOG_VERSION));
+    _binarySink = std::move(file);
+    return true;
+}
+
+void LogHandler::setCategoryRateLimit(int messagesPerSecond) {
+    _categoryRateLimit = std::max(messagesPerSecond, 0);
+}
+
+void LogHandler::startAsyncWriter() {
     QMutexLocker lock(&_mutex);
+    if (_writer) {
+        return;
+    }
+
+    QString binaryLogPath = qEnvironmentVariable("HIFI_BINARY_LOG_PATH");
+    if (!binaryLogPath.isEmpty()) {
+        QString filename = QDir(binaryLogPath).filePath(QString("hifi-log_%1.bin").arg(QCoreApplication::applicationPid()));
+        if (!setBinarySinkFile(filename)) {
+            fprintf(stderr, "Failed to open binary log %s\n", qPrintable(filename));
+        }
+    }
+
+    auto writer = new LogWriterThread();
+    writer->setObjectName("LogWriter");
+    writer->initialize(true, QThread::LowPriority);
+    _writer = writer;
+
+    if (auto application = QCoreApplication::instance()) {
+        connect(application, &QCoreApplication::aboutToQuit, this, &LogHandler::stopAsyncWriter, Qt::DirectConnection);
+    }
+}
+
+void LogHandler::stopAsyncWriter() {
+    LogWriterThread* writer = _writer.exchange(nullptr);
+    if (!writer) {
+        return;
+    }
+    writer->waitIdle(MAX_STOP_WAIT_MSECS);
+    // the writer isn't deleted, other threads may still be queueing their last messages to it
+    writer->terminate();
+}
+
+bool LogHandler::isWithinRateLimit(LogMsgType type, const char* category) {
+    int limit = _categoryRateLimit;
+    if (limit == 0 || type == LogCritical || type == LogFatal || type == LogSuppressed) {
+        return true;
+    }
+
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QByteArray name = category ? QByteArray::fromRawData(category, (int)strlen(category)) : QByteArray();
+    std::lock_guard<std::mutex> lock(_categoryRatesMutex);
+    auto it = _categoryRates.find(name);
+    if (it == _categoryRates.end()) {
+        // the key outlives the category
+        it = _categoryRates.insert(QByteArray(name.constData(), name.size()), CategoryRate());
+    }
+    if (now - it->windowStart >= MSECS_PER_SECOND) {
+        it->windowStart = now;
+        it->count = 0;
+    }
+    if (++it->count > limit) {
+        ++it->numSuppressed;
+        return false;
+    }
+    return true;
+}
+
+void LogHandler::flushRepeatedMessages() {
+    std::vector<std::pair<QByteArray, int>> suppressedCategories;
+    {
+        std::lock_guard<std::mutex> lock(_categoryRatesMutex);
+        for (auto it = _categoryRates.begin(); it != _categoryRates.end(); ++it) {
+            if (it->numSuppressed > 0) {
+                suppressedCategories.emplace_back(it.key(), it->numSuppressed);
+                it->numSuppressed = 0;
+            }
+        }
+    }
+    for (const auto& suppressed : suppressedCategories) {
+        printMessage(LogSuppressed, QMessageLogContext(nullptr, 0, nullptr, suppressed.first.constData()),
+            QString("%1 log entries over the rate limit of %2 a second were suppressed")
+                .arg(suppressed.second).arg(_categoryRateLimit.load()));
+    }
+
+    // the messages are printed once the lock is released, the writer thread takes it to format them
+    std::vector<QString> repeatLogMessages;
+    {
+        QMutexLocker lock(&_mutex);
 
-    // New repeat-suppress scheme:
-    for (int m = 0; m < (int)_repeatedMessageRecords.size(); ++m) {
-        int repeatCount = _repeatedMessageRecords[m].repeatCount;
-        if (repeatCount > 1) {
-            QString repeatLogMessage = QString().setNum(repeatCount) + " repeated log entries - Last entry: \"" 
-                    + _repeatedMessageRecords[m].repeatString + "\"";
-            printMessage(LogSuppressed, QMessageLogContext(), repeatLogMessage);
-            _repeatedMessageRecords[m].repeatCount = 0;
-            _repeatedMessageRecords[m].repeatString = QString();
+        // New repeat-suppress scheme:
+        for (int m = 0; m < (int)_repeatedMessageRecords.size(); ++m) {
+            int repeatCount = _repeatedMessageRecords[m].repeatCount;
+            if (repeatCount > 1) {
+                repeatLogMessages.push_back(QString().setNum(repeatCount) + " repeated log entries - Last entry: \""
+                    + _repeatedMessageRecords[m].repeatString + "\"");
+                _repeatedMessageRecords[m].repeatCount = 0;
+                _repeatedMessageRecords[m].repeatString = QString();
+            }
         }
     }
+    for (const auto& repeatLogMessage : repeatLogMessages) {
+        printMessage(LogSuppressed, QMessageLogContext(), repeatLogMessage);
+    }
 }
 
 QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
-    if (message.isEmpty()) {
+    return logMessage(type, context, message, true);
+}
+
+QString LogHandler::logMessage(LogMsgType type, const QMessageLogContext& context, const QString& message,
+                               bool isFormatted) {
+    if (message.isEmpty() || !isWithinRateLimit(type, context.category)) {
         return QString();
     }
-    QMutexLocker lock(&_mutex);
+
+    Record record;
+    record.type = type;
+    record.timestamp = QDateTime::currentMSecsSinceEpoch();
+    record.category = context.category;
+    // for [qml] console.* messages include an abbreviated source filename
+    if (context.category && context.file && !strcmp("qml", context.category)) {
+        if (const char* basename = strrchr(context.file, '/')) {
+            record.fileName = basename + 1;
+        }
+    }
+    record.threadID = (quint64)QThread::currentThreadId();
+    record.message = message;
+
+    LogWriterThread* writer = _writer;
+    // the writer's own messages are written right away, it would wait on itself if its queue were full
+    if (writer && writer->thread() == QThread::currentThread()) {
+        writer = nullptr;
+    }
+    if (isFormatted || !writer) {
+        record.formatted = formatMessage(record);
+    }
+
+    if (writer && type != LogFatal) {
+        writer->queueItem(record);
+    } else {
+        if (writer) {
+            writer->waitIdle(MAX_FATAL_WAIT_MSECS);
+        }
+        writeMessage(record, record.formatted);
+    }
+    return record.formatted;
+}
+
+QString LogHandler::formatMessage(const Record& record) {
+    QString targetName;
+    bool shouldOutputProcessID;
+    bool shouldOutputThreadID;
+    bool shouldDisplayMilliseconds;
+    {
+        QMutexLocker lock(&_mutex);
+        targetName = _targetName;
+        shouldOutputProcessID = _shouldOutputProcessID;
+        shouldOutputThreadID = _shouldOutputThreadID;
+        shouldDisplayMilliseconds = _shouldDisplayMilliseconds;
+    }
 
     // log prefix is in the following format
     // [TIMESTAMP] [DEBUG] [PID] [TID] [TARGET] logged string
 
     const QString* dateFormatPtr = &DATE_STRING_FORMAT;
-    if (_shouldDisplayMilliseconds) {
+    if (shouldDisplayMilliseconds) {
         dateFormatPtr = &DATE_STRING_FORMAT_WITH_MILLISECONDS;
     }
 
-    QString prefixString = QString("[%1] [%2] [%3]").arg(QDateTime::currentDateTime().toString(*dateFormatPtr),
-        stringForLogType(type), context.category);
+    QString prefixString = QString("[%1] [%2] [%3]").arg(
+        QDateTime::fromMSecsSinceEpoch(record.timestamp).toString(*dateFormatPtr),
+        stringForLogType(record.type), QString::fromUtf8(record.category));
 
-    if (_shouldOutputProcessID) {
+    if (shouldOutputProcessID) {
         prefixString.append(QString(" [%1]").arg(QCoreApplication::applicationPid()));
     }
 
-    if (_shouldOutputThreadID) {
-        size_t threadID = (size_t)QThread::currentThreadId();
-        prefixString.append(QString(" [%1]").arg(threadID));
+    if (shouldOutputThreadID) {
+        prefixString.append(QString(" [%1]").arg(record.threadID));
     }
 
-    if (!_targetName.isEmpty()) {
-        prefixString.append(QString(" [%1]").arg(_targetName));
+    if (!targetName.isEmpty()) {
+        prefixString.append(QString(" [%1]").arg(targetName));
     }
 
-    // for [qml] console.* messages include an abbreviated source filename
-    if (context.category && context.file && !strcmp("qml", context.category)) {
-        if (const char* basename = strrchr(context.file, '/')) {
-            prefixString.append(QString(" [%1]").arg(basename+1));
-        }
+    if (!record.fileName.isEmpty()) {
+        prefixString.append(QString(" [%1]").arg(QString::fromUtf8(record.fileName)));
     }
 
-    QString logMessage = QString("%1 %2\n").arg(prefixString, message.split('\n').join('\n' + prefixString + " "));
+    return QString("%1 %2\n").arg(prefixString, record.message.split('\n').join('\n' + prefixString + " "));
+}
 
-    fprintf(stdout, "%s", qPrintable(logMessage));
+void LogHandler::writeMessage(const Record& record, const QString& formatted) {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    fprintf(stdout, "%s", qPrintable(formatted));
 #ifdef Q_OS_WIN
     // On windows, this will output log lines into the Visual Studio "output" tab
-    OutputDebugStringA(qPrintable(logMessage));
+    OutputDebugStringA(qPrintable(formatted));
 #endif
-    return logMessage;
+
+    if (_binarySink) {
+        QDataStream out(_binarySink.get());
+        out << (quint8)record.type << record.timestamp << record.threadID << record.category << record.message.toUtf8();
+    }
 }
 
 void LogHandler::verboseMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
-    getInstance().printMessage((LogMsgType) type, context, message);
+    getInstance().logMessage((LogMsgType) type, context, message, false);
 }
 
 void LogHandler::setupRepeatedMessageFlusher() {
@@ -166,16 +346,22 @@ int LogHandler::newRepeatedMessageID() {
 
 void LogHandler::printRepeatedMessage(int messageID, LogMsgType type, const QMessageLogContext& context,
                                       const QString& message) {
-    QMutexLocker lock(&_mutex);
-    if (messageID >= _currentMessageID) {
-        return;
+    bool isFirst;
+    {
+        QMutexLocker lock(&_mutex);
+        if (messageID >= _currentMessageID) {
+            return;
+        }
+
+        isFirst = _repeatedMessageRecords[messageID].repeatCount == 0;
+        if (!isFirst) {
+            _repeatedMessageRecords[messageID].repeatString = message;
+        }
+
+        ++_repeatedMessageRecords[messageID].repeatCount;
     }
 
-    if (_repeatedMessageRecords[messageID].repeatCount == 0) {
+    if (isFirst) {
         printMessage(type, context, message);
-    } else {
-        _repeatedMessageRecords[messageID].repeatString = message;
     }
- 
-    ++_repeatedMessageRecords[messageID].repeatCount;
 }
@@ -17,11 +17,20 @@
 #include <QString>
 #include <QRegExp>
 #include <QMutex>
+#include <QHash>
+#include <QFile>
+#include <atomic>
+#include <mutex>
 #include <vector>
 #include <memory>
 
+class LogWriterThread;
+
 const int VERBOSE_LOG_INTERVAL_SECONDS = 5;
 
+// the messages a second that the servers and the interface print from each category at most
+const int DEFAULT_CATEGORY_RATE_LIMIT = 100;
+
 enum LogMsgType {
     LogInfo = QtInfoMsg,
     LogDebug = QtDebugMsg,
@@ -45,6 +54,7 @@ public:
     void setShouldOutputThreadID(bool shouldOutputThreadID);
     void setShouldDisplayMilliseconds(bool shouldDisplayMilliseconds);
 
+    /// formats the message and prints it, returns the formatted message or an empty string if it wasn't printed
     QString printMessage(LogMsgType type, const QMessageLogContext& context, const QString &message);
 
     /// a qtMessageHandler that can be hooked up to a target that links to Qt
@@ -56,12 +66,52 @@ public:
 
     void setupRepeatedMessageFlusher();
 
+    /// moves the writing of the messages to a background thread, which also formats those that the caller doesn't need
+    /// formatted, until the application quits. If HIFI_BINARY_LOG_PATH names a directory, the messages are also written
+    /// there in binary, see setBinarySinkFile
+    void startAsyncWriter();
+    void stopAsyncWriter();
+
+    /// at most this many messages a second are printed from each category, 0 for no limit. The critical and fatal
+    /// messages are always printed, and the number of messages suppressed is printed with the repeated messages
+    void setCategoryRateLimit(int messagesPerSecond);
+
+    /// Also writes the messages to the file in a compact binary form, an empty name stops it. The file starts with
+    /// "HFLB" and a version byte, then a QDataStream of the records: the type as a quint8, the time as a qint64 of msecs
+    /// since the epoch, the thread ID as a quint64, and the category and the message as UTF-8 QByteArrays
+    bool setBinarySinkFile(const QString& filename);
+
+    /// a message, as the writer gets it
+    struct Record {
+        LogMsgType type { LogDebug };
+        qint64 timestamp { 0 };
+        QByteArray category;
+        QByteArray fileName;
+        quint64 threadID { 0 };
+        QString message;
+        // empty when the writer is to format it
+        QString formatted;
+    };
+
 private:
+    friend class LogWriterThread;
+
+    struct CategoryRate {
+        qint64 windowStart { 0 };
+        int count { 0 };
+        int numSuppressed { 0 };
+    };
+
     LogHandler() = default;
     ~LogHandler() = default;
 
     void flushRepeatedMessages();
 
+    QString logMessage(LogMsgType type, const QMessageLogContext& context, const QString& message, bool isFormatted);
+    bool isWithinRateLimit(LogMsgType type, const char* category);
+    QString formatMessage(const Record& record);
+    void writeMessage(const Record& record, const QString& formatted);
+
     QString _targetName;
     bool _shouldOutputProcessID { false };
     bool _shouldOutputThreadID { false };
@@ -74,6 +124,15 @@ private:
     };
     std::vector<RepeatedMessageRecord> _repeatedMessageRecords;
     static QMutex _mutex;
+
+    std::atomic<LogWriterThread*> _writer { nullptr };
+    // only taken by whoever writes, which is the writer thread once it is started
+    std::mutex _writeMutex;
+    std::unique_ptr<QFile> _binarySink;
+
+    std::atomic<int> _categoryRateLimit { 0 };
+    QHash<QByteArray, CategoryRate> _categoryRates;
+    std::mutex _categoryRatesMutex;
 };
 
 #define HIFI_FCDEBUG(category, message) \
@@ -0,0 +1,113 @@
+//
+//  MPSCQueue.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_MPSCQueue_h
+#define hifi_MPSCQueue_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Bounded lock-free queue for any number of producer threads and one consumer thread.
+//
+// The items live in a ring of CAPACITY cells, each with a sequence number that tells whose turn it is: the producers
+// claim a cell by moving the tail forward and publish it by bumping its sequence, so they only contend on the tail and
+// never wait on each other. tryPush fails rather than wait when the ring is full. T must be default constructible
+// and copyable.
+template <typename T, size_t CAPACITY = 1024>
+class MPSCQueue {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "MPSCQueue capacity must be a power of two");
+
+public:
+    MPSCQueue() : _cells(new Cell[CAPACITY]) {
+        for (size_t i = 0; i < CAPACITY; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // any thread, returns false if the queue was full
+    bool tryPush(const T& value) {
+        size_t position = _tail.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = _cells[position & MASK];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+            if (difference == 0) {
+                if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.item = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                // the consumer hasn't read this cell from the last time around yet
+                return false;
+            } else {
+                // another producer claimed the cell first
+                position = _tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // consumer thread only, returns false if nothing was available
+    bool pop(T& value) {
+        Cell& cell = _cells[_head & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != _head + 1) {
+            return false;
+        }
+        value = std::move(cell.item);
+        // don't keep whatever was moved-from alive until the cell is reused
+        cell.item = T();
+        cell.sequence.store(_head + CAPACITY, std::memory_order_release);
+        ++_head;
+        return true;
+    }
+
+    // consumer thread only, pops up to maxItems items into the container and returns how many it popped
+    template <typename C>
+    size_t popBatch(C& items, size_t maxItems = CAPACITY) {
+        size_t count = 0;
+        T value;
+        while (count < maxItems && pop(value)) {
+            items.push_back(std::move(value));
+            ++count;
+        }
+        return count;
+    }
+
+    // consumer thread only, a concurrent push may make this stale immediately
+    bool isEmpty() const {
+        return _cells[_head & MASK].sequence.load(std::memory_order_acquire) != _head + 1;
+    }
+
+private:
+    static const size_t MASK = CAPACITY - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T item;
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+
+    // consumer side
+    size_t _head { 0 };
+
+    // keep the producer side on its own cache line
+    alignas(64) std::atomic<size_t> _tail { 0 };
+
+    // no copies
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+};
+
+#endif // hifi_MPSCQueue_h
@@ -0,0 +1,124 @@
+//
+//  PoolAllocator.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PoolAllocator_h
+#define hifi_PoolAllocator_h
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// A thread safe pool of blocks of one size, carved out of chunks that grow as the pool does. Freed blocks go back on a
+// free list to be reused rather than back to the heap, so objects that are made and thrown away often, like the elements
+// of an octree, end up packed together instead of scattered wherever the heap had room.
+template <size_t BLOCK_SIZE, size_t BLOCK_ALIGNMENT>
+class FixedBlockPool {
+public:
+    static FixedBlockPool& getInstance() {
+        // never destroyed, blocks can still be in use by statics when the program exits
+        static FixedBlockPool* instance = new FixedBlockPool();
+        return *instance;
+    }
+
+    void* allocate() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_freeBlocks) {
+            addChunk();
+        }
+        Block* block = _freeBlocks;
+        _freeBlocks = block->next;
+        _numAllocated++;
+        return block;
+    }
+
+    void deallocate(void* pointer) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Block* block = static_cast<Block*>(pointer);
+        block->next = _freeBlocks;
+        _freeBlocks = block;
+        _numAllocated--;
+    }
+
+    size_t getNumAllocated() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _numAllocated;
+    }
+
+    size_t getCapacity() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _capacity;
+    }
+
+private:
+    union Block {
+        Block* next;
+        typename std::aligned_storage<BLOCK_SIZE, BLOCK_ALIGNMENT>::type storage;
+    };
+
+    enum : size_t {
+        MIN_BLOCKS_PER_CHUNK = 64,
+        MAX_BLOCKS_PER_CHUNK = 4096
+    };
+
+    FixedBlockPool() {}
+
+    void addChunk() {
+        size_t numBlocks = std::min(std::max(_capacity, (size_t)MIN_BLOCKS_PER_CHUNK), (size_t)MAX_BLOCKS_PER_CHUNK);
+        _chunks.emplace_back(new Block[numBlocks]);
+        Block* chunk = _chunks.back().get();
+        for (size_t i = numBlocks; i-- > 0;) {
+            chunk[i].next = _freeBlocks;
+            _freeBlocks = &chunk[i];
+        }
+        _capacity += numBlocks;
+    }
+
+    mutable std::mutex _mutex;
+    Block* _freeBlocks { nullptr };
+    std::vector<std::unique_ptr<Block[]>> _chunks;
+    size_t _numAllocated { 0 };
+    size_t _capacity { 0 };
+};
+
+// An allocator that takes single objects from the FixedBlockPool for their size. Handing it to std::allocate_shared, or
+// to a shared_ptr constructor, puts the shared_ptr control blocks in a pool of their own as well.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using Pool = FixedBlockPool<sizeof(T), alignof(T)>;
+
+    PoolAllocator() {}
+    template <typename U> PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        if (n != 1) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(Pool::getInstance().allocate());
+    }
+
+    void deallocate(T* pointer, size_t n) {
+        if (n != 1) {
+            ::operator delete(pointer);
+            return;
+        }
+        Pool::getInstance().deallocate(pointer);
+    }
+
+    template <typename U> bool operator==(const PoolAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const PoolAllocator<U>&) const { return false; }
+};
+
+#endif // hifi_PoolAllocator_h
@@ -65,6 +65,11 @@ namespace PrioritySortUtil {
             thing.setPriority(computePriority(thing));
             _vector.push_back(thing);
         }
+        // for things the caller has already scored more cheaply, such as those it knows are out of every view
+        void push(T thing, float priority) {
+            thing.setPriority(priority);
+            _vector.push_back(thing);
+        }
         void reserve(size_t num) {
             _vector.reserve(num);
         }
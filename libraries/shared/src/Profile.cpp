@@ -23,6 +23,7 @@ Q_LOGGING_CATEGORY(trace_resource_network, "trace.resource.network")
 Q_LOGGING_CATEGORY(trace_resource_parse, "trace.resource.parse")
 Q_LOGGING_CATEGORY(trace_script, "trace.script")
 Q_LOGGING_CATEGORY(trace_script_entities, "trace.script.entities")
+Q_LOGGING_CATEGORY(trace_script_callbacks, "trace.script.callbacks")
 Q_LOGGING_CATEGORY(trace_simulation, "trace.simulation")
 Q_LOGGING_CATEGORY(trace_simulation_detail, "trace.simulation.detail")
 Q_LOGGING_CATEGORY(trace_simulation_animation, "trace.simulation.animation")
@@ -48,6 +49,12 @@ static bool tracingEnabled() {
     return (tracer && tracer->isEnabled());
 }
 
+// the continuous trace drops the args, so they aren't built for it
+static bool tracingArgs() {
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    return (tracer && tracer->isFullTracing());
+}
+
 DurationBase::DurationBase(const QLoggingCategory& category, const QString& name) : _name(name), _category(category) {
 }
 
@@ -58,8 +65,11 @@ Duration::Duration(const QLoggingCategory& category,
                    const QVariantMap& baseArgs) :
     DurationBase(category, name) {
     if (tracingEnabled() && category.isDebugEnabled()) {
-        QVariantMap args = baseArgs;
-        args["nv_payload"] = QVariant::fromValue(payload);
+        QVariantMap args;
+        if (tracingArgs()) {
+            args = baseArgs;
+            args["nv_payload"] = QVariant::fromValue(payload);
+        }
         tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
 
 #if defined(NSIGHT_TRACING)
@@ -27,6 +27,7 @@ Q_DECLARE_LOGGING_CATEGORY(trace_resource_parse)
 Q_DECLARE_LOGGING_CATEGORY(trace_resource_network)
 Q_DECLARE_LOGGING_CATEGORY(trace_script)
 Q_DECLARE_LOGGING_CATEGORY(trace_script_entities)
+Q_DECLARE_LOGGING_CATEGORY(trace_script_callbacks)
 Q_DECLARE_LOGGING_CATEGORY(trace_simulation)
 Q_DECLARE_LOGGING_CATEGORY(trace_simulation_detail)
 Q_DECLARE_LOGGING_CATEGORY(trace_simulation_animation)
@@ -74,6 +74,15 @@ void registerMetaTypes(QScriptEngine* engine) {
     qScriptRegisterSequenceMetaType<QVector<unsigned int>>(engine);
 }
 
+// most of the components scripts pass are numbers, which don't need the round trip through a QVariant that
+// strings and the other values take
+static float scriptValueToFloat(const QScriptValue& value) {
+    if (value.isNumber()) {
+        return (float)value.toNumber();
+    }
+    return value.toVariant().toFloat();
+}
+
 QScriptValue vec2ToScriptValue(QScriptEngine* engine, const glm::vec2& vec2) {
     auto prototype = engine->globalObject().property("__hifi_vec2__");
     if (!prototype.property("defined").toBool()) {
@@ -96,7 +105,7 @@ QScriptValue vec2ToScriptValue(QScriptEngine* engine, const glm::vec2& vec2) {
 
 void vec2FromScriptValue(const QScriptValue& object, glm::vec2& vec2) {
     if (object.isNumber()) {
-        vec2 = glm::vec2(object.toVariant().toFloat());
+        vec2 = glm::vec2(scriptValueToFloat(object));
     } else if (object.isArray()) {
         QVariantList list = object.toVariant().toList();
         if (list.length() == 2) {
@@ -114,8 +123,8 @@ void vec2FromScriptValue(const QScriptValue& object, glm::vec2& vec2) {
             y = object.property("v");
         }
 
-        vec2.x = x.toVariant().toFloat();
-        vec2.y = y.toVariant().toFloat();
+        vec2.x = scriptValueToFloat(x);
+        vec2.y = scriptValueToFloat(y);
     }
 }
 
@@ -222,7 +231,7 @@ QScriptValue vec3ColorToScriptValue(QScriptEngine* engine, const glm::vec3& vec3
 
 void vec3FromScriptValue(const QScriptValue& object, glm::vec3& vec3) {
     if (object.isNumber()) {
-        vec3 = glm::vec3(object.toVariant().toFloat());
+        vec3 = glm::vec3(scriptValueToFloat(object));
     } else if (object.isString()) {
         QColor qColor(object.toString());
         if (qColor.isValid()) {
@@ -262,9 +271,9 @@ void vec3FromScriptValue(const QScriptValue& object, glm::vec3& vec3) {
             z = object.property("blue");
         }
 
-        vec3.x = x.toVariant().toFloat();
-        vec3.y = y.toVariant().toFloat();
-        vec3.z = z.toVariant().toFloat();
+        vec3.x = scriptValueToFloat(x);
+        vec3.y = scriptValueToFloat(y);
+        vec3.z = scriptValueToFloat(z);
     }
 }
 
@@ -548,10 +557,10 @@ QScriptValue vec4toScriptValue(QScriptEngine* engine, const glm::vec4& vec4) {
 }
 
 void vec4FromScriptValue(const QScriptValue& object, glm::vec4& vec4) {
-    vec4.x = object.property("x").toVariant().toFloat();
-    vec4.y = object.property("y").toVariant().toFloat();
-    vec4.z = object.property("z").toVariant().toFloat();
-    vec4.w = object.property("w").toVariant().toFloat();
+    vec4.x = scriptValueToFloat(object.property("x"));
+    vec4.y = scriptValueToFloat(object.property("y"));
+    vec4.z = scriptValueToFloat(object.property("z"));
+    vec4.w = scriptValueToFloat(object.property("w"));
 }
 
 QVariant vec4toVariant(const glm::vec4& vec4) {
@@ -626,22 +635,22 @@ QScriptValue mat4toScriptValue(QScriptEngine* engine, const glm::mat4& mat4) {
 }
 
 void mat4FromScriptValue(const QScriptValue& object, glm::mat4& mat4) {
-    mat4[0][0] = object.property("r0c0").toVariant().toFloat();
-    mat4[0][1] = object.property("r1c0").toVariant().toFloat();
-    mat4[0][2] = object.property("r2c0").toVariant().toFloat();
-    mat4[0][3] = object.property("r3c0").toVariant().toFloat();
-    mat4[1][0] = object.property("r0c1").toVariant().toFloat();
-    mat4[1][1] = object.property("r1c1").toVariant().toFloat();
-    mat4[1][2] = object.property("r2c1").toVariant().toFloat();
-    mat4[1][3] = object.property("r3c1").toVariant().toFloat();
-    mat4[2][0] = object.property("r0c2").toVariant().toFloat();
-    mat4[2][1] = object.property("r1c2").toVariant().toFloat();
-    mat4[2][2] = object.property("r2c2").toVariant().toFloat();
-    mat4[2][3] = object.property("r3c2").toVariant().toFloat();
-    mat4[3][0] = object.property("r0c3").toVariant().toFloat();
-    mat4[3][1] = object.property("r1c3").toVariant().toFloat();
-    mat4[3][2] = object.property("r2c3").toVariant().toFloat();
-    mat4[3][3] = object.property("r3c3").toVariant().toFloat();
+    mat4[0][0] = scriptValueToFloat(object.property("r0c0"));
+    mat4[0][1] = scriptValueToFloat(object.property("r1c0"));
+    mat4[0][2] = scriptValueToFloat(object.property("r2c0"));
+    mat4[0][3] = scriptValueToFloat(object.property("r3c0"));
+    mat4[1][0] = scriptValueToFloat(object.property("r0c1"));
+    mat4[1][1] = scriptValueToFloat(object.property("r1c1"));
+    mat4[1][2] = scriptValueToFloat(object.property("r2c1"));
+    mat4[1][3] = scriptValueToFloat(object.property("r3c1"));
+    mat4[2][0] = scriptValueToFloat(object.property("r0c2"));
+    mat4[2][1] = scriptValueToFloat(object.property("r1c2"));
+    mat4[2][2] = scriptValueToFloat(object.property("r2c2"));
+    mat4[2][3] = scriptValueToFloat(object.property("r3c2"));
+    mat4[3][0] = scriptValueToFloat(object.property("r0c3"));
+    mat4[3][1] = scriptValueToFloat(object.property("r1c3"));
+    mat4[3][2] = scriptValueToFloat(object.property("r2c3"));
+    mat4[3][3] = scriptValueToFloat(object.property("r3c3"));
 }
 
 QVariant mat4ToVariant(const glm::mat4& mat4) {
@@ -728,7 +737,7 @@ QScriptValue qVectorVec3ColorToScriptValue(QScriptEngine* engine, const QVector<
 }
 
 QScriptValue qVectorVec3ToScriptValue(QScriptEngine* engine, const QVector<glm::vec3>& vector) {
-    QScriptValue array = engine->newArray();
+    QScriptValue array = engine->newArray(vector.size());
     for (int i = 0; i < vector.size(); i++) {
         array.setProperty(i, vec3ToScriptValue(engine, vector.at(i)));
     }
@@ -738,6 +747,7 @@ QScriptValue qVectorVec3ToScriptValue(QScriptEngine* engine, const QVector<glm::
 QVector<glm::vec3> qVectorVec3FromScriptValue(const QScriptValue& array) {
     QVector<glm::vec3> newVector;
     int length = array.property("length").toInteger();
+    newVector.reserve(length);
 
     for (int i = 0; i < length; i++) {
         glm::vec3 newVec3 = glm::vec3();
@@ -771,10 +781,10 @@ QScriptValue quatToScriptValue(QScriptEngine* engine, const glm::quat& quat) {
 }
 
 void quatFromScriptValue(const QScriptValue& object, glm::quat &quat) {
-    quat.x = object.property("x").toVariant().toFloat();
-    quat.y = object.property("y").toVariant().toFloat();
-    quat.z = object.property("z").toVariant().toFloat();
-    quat.w = object.property("w").toVariant().toFloat();
+    quat.x = scriptValueToFloat(object.property("x"));
+    quat.y = scriptValueToFloat(object.property("y"));
+    quat.z = scriptValueToFloat(object.property("z"));
+    quat.w = scriptValueToFloat(object.property("w"));
 
     // enforce normalized quaternion
     float length = glm::length(quat);
@@ -843,7 +853,7 @@ QVariant quatToVariant(const glm::quat& quat) {
 }
 
 QScriptValue qVectorQuatToScriptValue(QScriptEngine* engine, const QVector<glm::quat>& vector) {
-    QScriptValue array = engine->newArray();
+    QScriptValue array = engine->newArray(vector.size());
     for (int i = 0; i < vector.size(); i++) {
         array.setProperty(i, quatToScriptValue(engine, vector.at(i)));
     }
@@ -911,7 +921,7 @@ void qVectorFloatFromScriptValue(const QScriptValue& array, QVector<float>& vect
     int length = array.property("length").toInteger();
     
     for (int i = 0; i < length; i++) {
-        vector << array.property(i).toVariant().toFloat();
+        vector << scriptValueToFloat(array.property(i));
     }
 }
 
@@ -926,6 +936,7 @@ void qVectorIntFromScriptValue(const QScriptValue& array, QVector<uint32_t>& vec
 QVector<glm::quat> qVectorQuatFromScriptValue(const QScriptValue& array){
     QVector<glm::quat> newVector;
     int length = array.property("length").toInteger();
+    newVector.reserve(length);
 
     for (int i = 0; i < length; i++) {
         glm::quat newQuat = glm::quat();
@@ -1020,10 +1031,10 @@ QScriptValue qRectFToScriptValue(QScriptEngine* engine, const QRectF& rect) {
 }
 
 void qRectFFromScriptValue(const QScriptValue &object, QRectF& rect) {
-    rect.setX(object.property("x").toVariant().toFloat());
-    rect.setY(object.property("y").toVariant().toFloat());
-    rect.setWidth(object.property("width").toVariant().toFloat());
-    rect.setHeight(object.property("height").toVariant().toFloat());
+    rect.setX(scriptValueToFloat(object.property("x")));
+    rect.setY(scriptValueToFloat(object.property("y")));
+    rect.setWidth(scriptValueToFloat(object.property("width")));
+    rect.setHeight(scriptValueToFloat(object.property("height")));
 }
 
 QVariant qRectFToVariant(const QRectF& rect) {
@@ -1087,10 +1098,10 @@ QScriptValue aaCubeToScriptValue(QScriptEngine* engine, const AACube& aaCube) {
 
 void aaCubeFromScriptValue(const QScriptValue &object, AACube& aaCube) {
     glm::vec3 corner;
-    corner.x = object.property("x").toVariant().toFloat();
-    corner.y = object.property("y").toVariant().toFloat();
-    corner.z = object.property("z").toVariant().toFloat();
-    float scale = object.property("scale").toVariant().toFloat();
+    corner.x = scriptValueToFloat(object.property("x"));
+    corner.y = scriptValueToFloat(object.property("y"));
+    corner.z = scriptValueToFloat(object.property("z"));
+    float scale = scriptValueToFloat(object.property("scale"));
 
     aaCube.setBox(corner, scale);
 }
@@ -1133,9 +1144,9 @@ void pickRayFromScriptValue(const QScriptValue& object, PickRay& pickRay) {
         auto y = originValue.property("y");
         auto z = originValue.property("z");
         if (x.isValid() && y.isValid() && z.isValid()) {
-            pickRay.origin.x = x.toVariant().toFloat();
-            pickRay.origin.y = y.toVariant().toFloat();
-            pickRay.origin.z = z.toVariant().toFloat();
+            pickRay.origin.x = scriptValueToFloat(x);
+            pickRay.origin.y = scriptValueToFloat(y);
+            pickRay.origin.z = scriptValueToFloat(z);
         }
     }
     QScriptValue directionValue = object.property("direction");
@@ -1144,9 +1155,9 @@ void pickRayFromScriptValue(const QScriptValue& object, PickRay& pickRay) {
         auto y = directionValue.property("y");
         auto z = directionValue.property("z");
         if (x.isValid() && y.isValid() && z.isValid()) {
-            pickRay.direction.x = x.toVariant().toFloat();
-            pickRay.direction.y = y.toVariant().toFloat();
-            pickRay.direction.z = z.toVariant().toFloat();
+            pickRay.direction.x = scriptValueToFloat(x);
+            pickRay.direction.y = scriptValueToFloat(y);
+            pickRay.direction.z = scriptValueToFloat(z);
         }
     }
 }
@@ -1214,8 +1225,8 @@ QScriptValue qSizeFToScriptValue(QScriptEngine* engine, const QSizeF& qSizeF) {
 }
 
 void qSizeFFromScriptValue(const QScriptValue& object, QSizeF& qSizeF) {
-    qSizeF.setWidth(object.property("width").toVariant().toFloat());
-    qSizeF.setHeight(object.property("height").toVariant().toFloat());
+    qSizeF.setWidth(scriptValueToFloat(object.property("width")));
+    qSizeF.setHeight(scriptValueToFloat(object.property("height")));
 }
 
 AnimationDetails::AnimationDetails() :
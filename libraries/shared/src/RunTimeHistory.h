@@ -0,0 +1,48 @@
+//
+//  RunTimeHistory.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RunTimeHistory_h
+#define hifi_RunTimeHistory_h
+
+#include <algorithm>
+#include <array>
+
+// The last run times of a job, in msecs, to know how long its slowest runs take
+class RunTimeHistory {
+public:
+    static const int NUM_SAMPLES = 128;
+
+    void addSample(double runTime) {
+        _samples[_nextIndex] = runTime;
+        _nextIndex = (_nextIndex + 1) % NUM_SAMPLES;
+        _numSamples = std::min(_numSamples + 1, NUM_SAMPLES);
+    }
+
+    // the run time that the given fraction of the samples are under, 0.95 for the 95th percentile
+    double getPercentile(double percentile) const {
+        if (_numSamples == 0) {
+            return 0.0;
+        }
+        auto sorted = _samples;
+        auto end = sorted.begin() + _numSamples;
+        auto nth = sorted.begin() + std::min((int)(percentile * (double)_numSamples), _numSamples - 1);
+        std::nth_element(sorted.begin(), nth, end);
+        return *nth;
+    }
+
+    int getNumSamples() const { return _numSamples; }
+
+private:
+    std::array<double, NUM_SAMPLES> _samples;
+    int _nextIndex { 0 };
+    int _numSamples { 0 };
+};
+
+#endif // hifi_RunTimeHistory_h
@@ -0,0 +1,111 @@
+//
+//  SPSCQueue.h
+//  libraries/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_SPSCQueue_h
+#define hifi_SPSCQueue_h
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Unbounded lock-free queue for exactly one producer thread and one consumer thread.
+//
+// Items are stored in fixed size blocks that are chained together as the producer fills them, so push only
+// allocates once every BLOCK_SIZE items and never waits on the consumer. The consumer frees blocks once it has
+// read past them. T must be default constructible and movable.
+template <typename T, size_t BLOCK_SIZE = 256>
+class SPSCQueue {
+public:
+    SPSCQueue() : _headBlock(new Block()), _tailBlock(_headBlock) {}
+
+    ~SPSCQueue() {
+        Block* block = _headBlock;
+        while (block) {
+            Block* next = block->next.load(std::memory_order_relaxed);
+            delete block;
+            block = next;
+        }
+    }
+
+    // producer thread only
+    void push(T value) {
+        if (_tailIndex == BLOCK_SIZE) {
+            Block* newBlock = new Block();
+            // publish the new block last, once published the consumer may free the old one
+            Block* oldBlock = _tailBlock;
+            _tailBlock = newBlock;
+            _tailIndex = 0;
+            oldBlock->next.store(newBlock, std::memory_order_release);
+        }
+
+        _tailBlock->items[_tailIndex] = std::move(value);
+        ++_tailIndex;
+        _tailBlock->written.store(_tailIndex, std::memory_order_release);
+    }
+
+    // consumer thread only, returns false if nothing was available
+    bool pop(T& value) {
+        while (true) {
+            size_t written = _headBlock->written.load(std::memory_order_acquire);
+            if (_headIndex < written) {
+                value = std::move(_headBlock->items[_headIndex]);
+                // don't keep whatever was moved-from alive until the block is freed
+                _headBlock->items[_headIndex] = T();
+                ++_headIndex;
+                return true;
+            }
+
+            if (_headIndex < BLOCK_SIZE) {
+                // the producer hasn't written past this point yet
+                return false;
+            }
+
+            Block* next = _headBlock->next.load(std::memory_order_acquire);
+            if (!next) {
+                return false;
+            }
+
+            delete _headBlock;
+            _headBlock = next;
+            _headIndex = 0;
+        }
+    }
+
+    // consumer thread only, a concurrent push may make this stale immediately
+    bool isEmpty() const {
+        if (_headIndex < _headBlock->written.load(std::memory_order_acquire)) {
+            return false;
+        }
+        return _headIndex < BLOCK_SIZE || !_headBlock->next.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Block {
+        std::array<T, BLOCK_SIZE> items;
+        std::atomic<size_t> written { 0 };
+        std::atomic<Block*> next { nullptr };
+    };
+
+    // consumer side
+    Block* _headBlock;
+    size_t _headIndex { 0 };
+
+    // keep the producer side on its own cache line
+    alignas(64) Block* _tailBlock;
+    size_t _tailIndex { 0 };
+
+    // no copies
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+};
+
+#endif // hifi_SPSCQueue_h
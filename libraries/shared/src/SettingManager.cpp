@@ -45,19 +45,37 @@ namespace Setting {
         });
     }
 
+    bool Manager::findUnsavedChange(const QString& key, QVariant& value) const {
+        std::lock_guard<std::mutex> lock(_pendingChangesMutex);
+        auto it = _pendingChanges.constFind(key);
+        if (it != _pendingChanges.constEnd()) {
+            value = it.value();
+            return true;
+        }
+        it = _savingChanges.constFind(key);
+        if (it != _savingChanges.constEnd()) {
+            value = it.value();
+            return true;
+        }
+        return false;
+    }
+
     void Manager::loadSetting(Interface* handle) {
         const auto& key = handle->getKey();
-        withWriteLock([&] {
-            QVariant loadedValue;
-            if (_pendingChanges.contains(key) && _pendingChanges[key] != UNSET_VALUE) {
-                loadedValue = _pendingChanges[key];
-            } else {
-                loadedValue = _qSettings.value(key);
-            }
-            if (loadedValue.isValid()) {
-                handle->setVariant(loadedValue);
+        QVariant loadedValue;
+        if (findUnsavedChange(key, loadedValue)) {
+            if (loadedValue == UNSET_VALUE) {
+                return;
             }
-        });
+        } else {
+            loadedValue = resultWithReadLock<QVariant>([&] {
+                return _qSettings.value(key);
+            });
+        }
+        // the handle saves the value it is set to, so none of the locks are held here
+        if (loadedValue.isValid()) {
+            handle->setVariant(loadedValue);
+        }
     }
 
 
@@ -68,9 +86,8 @@ namespace Setting {
             handleValue = handle->getVariant();
         }
 
-        withWriteLock([&] {
-            _pendingChanges[key] = handleValue;
-        });
+        std::lock_guard<std::mutex> lock(_pendingChangesMutex);
+        _pendingChanges[key] = handleValue;
     }
 
     static const int SAVE_INTERVAL_MSEC = 5 * 1000; // 5 sec
@@ -92,10 +109,23 @@ namespace Setting {
     }
 
     void Manager::saveAll() {
+        // the changes are taken all at once, the ones made while they are written wait for the next save.
+        // Until they are written, the loads still find them in _savingChanges
+        QHash<QString, QVariant> changes;
+        {
+            std::lock_guard<std::mutex> lock(_pendingChangesMutex);
+            _pendingChanges.swap(_savingChanges);
+            changes = _savingChanges;
+        }
+
         withWriteLock([&] {
+            if (changes.isEmpty()) {
+                return;
+            }
             bool forceSync = false;
-            for (auto key : _pendingChanges.keys()) {
-                auto newValue = _pendingChanges[key];
+            for (auto it = changes.constBegin(); it != changes.constEnd(); ++it) {
+                const QString& key = it.key();
+                const QVariant& newValue = it.value();
                 auto savedValue = _qSettings.value(key, UNSET_VALUE);
                 if (newValue == savedValue) {
                     continue;
@@ -107,13 +137,18 @@ namespace Setting {
                     _qSettings.setValue(key, newValue);
                 }
             }
-            _pendingChanges.clear();
 
+            // QSettings writes the file with a QSaveFile, so it is replaced at once
             if (forceSync) {
                 _qSettings.sync();
             }
         });
 
+        {
+            std::lock_guard<std::mutex> lock(_pendingChangesMutex);
+            _savingChanges.clear();
+        }
+
         // Restart timer
         if (_saveTimer) {
             _saveTimer->start();
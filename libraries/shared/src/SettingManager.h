@@ -12,6 +12,8 @@
 #ifndef hifi_SettingManager_h
 #define hifi_SettingManager_h
 
+#include <mutex>
+
 #include <QtCore/QPointer>
 #include <QtCore/QSettings>
 #include <QtCore/QTimer>
@@ -60,10 +62,18 @@ namespace Setting {
         void saveAll();
 
     private:
+        // the value of a key that was saved by its handle but isn't in the QSettings yet
+        bool findUnsavedChange(const QString& key, QVariant& value) const;
+
         QHash<QString, Interface*> _handles;
         QPointer<QTimer> _saveTimer = nullptr;
         const QVariant UNSET_VALUE { QUuid::createUuid() };
+
+        // The changes of the handles are kept apart from the QSettings, under a lock of their own, so that the handles
+        // never wait on the disk while the settings thread writes them
+        mutable std::mutex _pendingChangesMutex;
         QHash<QString, QVariant> _pendingChanges;
+        QHash<QString, QVariant> _savingChanges;
 
         friend class Interface;
         friend void cleanupSettingsSaveThread();
@@ -79,6 +79,9 @@ void SpatiallyNestable::setParentID(const QUuid& parentID) {
         }
     });
 
+    if (parentChanged) {
+        invalidateWorldTransforms();
+    }
     if (parentChanged && success && parent) {
         parent->recalculateChildCauterization();
     }
@@ -138,6 +141,7 @@ SpatiallyNestablePointer SpatiallyNestable::getParentPointer(bool& success) cons
         parent->forgetChild(getThisPointer());
         _parentKnowsMe = false;
         _parent.reset();
+        invalidateWorldTransforms();
     }
 
     // we have a _parentID but no parent pointer, or our parent pointer was to the wrong thing
@@ -153,6 +157,7 @@ SpatiallyNestablePointer SpatiallyNestable::getParentPointer(bool& success) cons
 
     parent = _parent.lock();
     if (parent) {
+        invalidateWorldTransforms();
 
         // it's possible for an entity with a parent of AVATAR_SELF_ID can be imported into a side-tree
         // such as the clipboard's.  if this is the case, we don't want the parent to consider this a
@@ -184,6 +189,7 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
     _parentJointIndex = parentJointIndex;
+    invalidateWorldTransforms();
     bool success = false;
     auto parent = getParentPointer(success);
     if (success && parent) {
@@ -515,6 +521,7 @@ void SpatiallyNestable::setWorldTransform(const glm::vec3& position, const glm::
             }
         });
         if (changed) {
+            invalidateWorldTransforms();
             locationChanged(false);
         }
     }
@@ -558,8 +565,11 @@ void SpatiallyNestable::setWorldPosition(const glm::vec3& position, bool& succes
             _translationChanged = usecTimestampNow();
         }
     });
-    if (success && changed) {
-        locationChanged(tellPhysics);
+    if (changed) {
+        invalidateWorldTransforms();
+        if (success) {
+            locationChanged(tellPhysics);
+        }
     }
 }
 
@@ -611,8 +621,11 @@ void SpatiallyNestable::setWorldOrientation(const glm::quat& orientation, bool&
             _rotationChanged = usecTimestampNow();
         }
     });
-    if (success && changed) {
-        locationChanged(tellPhysics);
+    if (changed) {
+        invalidateWorldTransforms();
+        if (success) {
+            locationChanged(tellPhysics);
+        }
     }
 }
 
@@ -745,15 +758,84 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 }
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
+    WorldTransformCache cache;
+    if (readWorldCache(cache) && cache.isValid && cache.version == _transformVersion.load(std::memory_order_acquire) &&
+            (!cache.hasParent || !_parent.expired())) {
+        success = true;
+        return Transform(cache.rotation, cache.scale, cache.translation);
+    }
+
+    // the version is read before the transform it is cached with, so that a change made meanwhile is caught
+    uint32_t version = _transformVersion.load(std::memory_order_acquire);
     Transform result;
     // return a world-space transform for this object's location
     Transform parentTransform = getParentTransform(success, depth);
     _transformLock.withReadLock([&] {
         Transform::mult(result, parentTransform, _transform);
     });
+    if (success && canCacheWorldTransform()) {
+        cacheWorldTransform(result, version);
+    }
     return result;
 }
 
+void SpatiallyNestable::invalidateWorldTransforms() const {
+    _transformVersion.fetch_add(1, std::memory_order_release);
+    forEachDescendant([](const SpatiallyNestablePointer& descendant) {
+        descendant->_transformVersion.fetch_add(1, std::memory_order_release);
+    });
+}
+
+bool SpatiallyNestable::readWorldCache(WorldTransformCache& cache) const {
+    uint32_t sequence = _worldCacheSequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+        return false;
+    }
+    cache = _worldCache;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return _worldCacheSequence.load(std::memory_order_relaxed) == sequence;
+}
+
+bool SpatiallyNestable::isWorldTransformCached() const {
+    WorldTransformCache cache;
+    return readWorldCache(cache) && cache.isValid && cache.version == _transformVersion.load(std::memory_order_acquire);
+}
+
+bool SpatiallyNestable::canCacheWorldTransform() const {
+    SpatiallyNestablePointer parent = _parent.lock();
+    if (!parent) {
+        return true;
+    }
+    // a parent that doesn't know about this object wouldn't bump its version
+    return _parentKnowsMe && _parentJointIndex == INVALID_JOINT_INDEX && !getScalesWithParent() &&
+        parent->isWorldTransformCached();
+}
+
+void SpatiallyNestable::cacheWorldTransform(const Transform& transform, uint32_t version) const {
+    uint32_t sequence = _worldCacheSequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) || !_worldCacheSequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+        // another thread is caching it
+        return;
+    }
+    _worldCache.rotation = transform.getRotation();
+    _worldCache.scale = transform.getScale();
+    _worldCache.translation = transform.getTranslation();
+    _worldCache.version = version;
+    _worldCache.hasParent = !_parent.expired();
+    _worldCache.isValid = true;
+    _worldCacheSequence.store(sequence + 2, std::memory_order_release);
+}
+
+void SpatiallyNestable::updateWorldTransforms() const {
+    bool success;
+    getTransform(success);
+    // forEachDescendant goes breadth first, so every parent is cached before its children
+    forEachDescendant([](const SpatiallyNestablePointer& descendant) {
+        bool success;
+        descendant->getTransform(success);
+    });
+}
+
 const Transform SpatiallyNestable::getTransform() const {
     bool success;
     Transform result = getTransform(success);
@@ -820,6 +902,7 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
             }
         });
         if (changed) {
+            invalidateWorldTransforms();
             locationChanged();
         }
     }
@@ -874,8 +957,11 @@ void SpatiallyNestable::setSNScale(const glm::vec3& scale, bool& success) {
             _scaleChanged = usecTimestampNow();
         }
     });
-    if (success && changed) {
-        dimensionsChanged();
+    if (changed) {
+        invalidateWorldTransforms();
+        if (success) {
+            dimensionsChanged();
+        }
     }
 }
 
@@ -906,6 +992,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
     });
 
     if (changed) {
+        invalidateWorldTransforms();
         locationChanged();
     }
 }
@@ -933,6 +1020,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
         }
     });
     if (changed) {
+        invalidateWorldTransforms();
         locationChanged(tellPhysics);
     }
 }
@@ -960,6 +1048,7 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
         }
     });
     if (changed) {
+        invalidateWorldTransforms();
         locationChanged();
     }
 }
@@ -1016,6 +1105,7 @@ void SpatiallyNestable::setLocalSNScale(const glm::vec3& scale) {
         }
     });
     if (changed) {
+        invalidateWorldTransforms();
         dimensionsChanged();
     }
 }
@@ -1115,6 +1205,7 @@ void SpatiallyNestable::forEachDescendantTest(const ChildLambdaTest& actor) cons
 }
 
 void SpatiallyNestable::locationChanged(bool tellPhysics, bool tellChildren) {
+    _transformVersion.fetch_add(1, std::memory_order_release);
     if (tellChildren) {
         forEachChild([&](SpatiallyNestablePointer object) {
             object->locationChanged(tellPhysics, tellChildren);
@@ -1170,6 +1261,7 @@ bool SpatiallyNestable::updateQueryAACube() {
     });
 
     _queryAACubeSet = true;
+    queryAACubeChanged();
 
     auto parent = getParentPointer(success);
     if (success && parent) {
@@ -1186,6 +1278,7 @@ void SpatiallyNestable::setQueryAACube(const AACube& queryAACube) {
     }
     _queryAACube = queryAACube;
     _queryAACubeSet = true;
+    queryAACubeChanged();
 }
 
 bool SpatiallyNestable::queryAACubeNeedsUpdate() const {
@@ -1332,6 +1425,7 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
     });
 
     if (changed) {
+        invalidateWorldTransforms();
         locationChanged(false);
     }
 }
@@ -213,6 +213,7 @@ public:
 
     virtual void locationChanged(bool tellPhysics = true, bool tellChildren = true); // called when a this object's location has changed
     virtual void dimensionsChanged() { _queryAACubeSet = false; } // called when a this object's dimensions have changed
+    virtual void queryAACubeChanged() { } // called when a this object's query cube has been set or updated
     virtual void parentDeleted() { } // called on children of a deleted parent
 
     virtual void addGrab(GrabPointer grab);
@@ -223,6 +224,10 @@ public:
 
     void bumpAncestorChainRenderableVersion(int depth = 0) const;
 
+    // caches the world transforms of this object and its descendants, parents before children, so that the queries
+    // that follow in the frame find them without walking up the parenting chain
+    void updateWorldTransforms() const;
+
 protected:
     QUuid _id;
     mutable SpatiallyNestableWeakPointer _parent;
@@ -264,6 +269,28 @@ private:
     bool _isDead { false };
     bool _queryAACubeIsPuffed { false };
 
+    // The world transform is cached for as long as _transformVersion holds. The version of an object is bumped when its
+    // local transform or its parent changes, along with the versions of all of its descendants. An object whose world
+    // transform also depends on the joints or the scale of its parent, which don't bump anything, is never cached, and
+    // neither are its descendants. The cache is a seqlock, so that reading it takes no lock
+    struct WorldTransformCache {
+        glm::quat rotation;
+        glm::vec3 scale;
+        glm::vec3 translation;
+        uint32_t version { 0 };
+        bool hasParent { false };
+        bool isValid { false };
+    };
+    mutable std::atomic<uint32_t> _transformVersion { 1 };
+    mutable std::atomic<uint32_t> _worldCacheSequence { 0 }; // odd while the cache is being written
+    mutable WorldTransformCache _worldCache;
+
+    void invalidateWorldTransforms() const;
+    bool readWorldCache(WorldTransformCache& cache) const;
+    bool isWorldTransformCached() const;
+    bool canCacheWorldTransform() const;
+    void cacheWorldTransform(const Transform& transform, uint32_t version) const;
+
     void breakParentingLoop() const;
 };
 
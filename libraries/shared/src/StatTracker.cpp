@@ -8,28 +8,146 @@
 
 #include "StatTracker.h"
 
+#include <algorithm>
+
+// the index of the highest bit that is set in a value that isn't 0
+static int highestBit(uint64_t value) {
+    int bit = 0;
+    for (int shift = 32; shift > 0; shift >>= 1) {
+        if (value >> shift) {
+            value >>= shift;
+            bit += shift;
+        }
+    }
+    return bit;
+}
+
+int StatHistogram::getBucket(uint64_t value) {
+    if (value < (uint64_t)NUM_SUB_BUCKETS) {
+        return (int)value;
+    }
+    int exponent = highestBit(value);
+    int subBucket = (int)(value >> (exponent - SUB_BUCKET_BITS)) & (NUM_SUB_BUCKETS - 1);
+    return (exponent - SUB_BUCKET_BITS + 1) * NUM_SUB_BUCKETS + subBucket;
+}
+
+uint64_t StatHistogram::getBucketValue(int bucket) {
+    if (bucket < NUM_SUB_BUCKETS) {
+        return (uint64_t)bucket;
+    }
+    // the middle of the bucket
+    int shift = bucket / NUM_SUB_BUCKETS - 1;
+    uint64_t lowest = (uint64_t)(NUM_SUB_BUCKETS + bucket % NUM_SUB_BUCKETS) << shift;
+    return lowest + (((uint64_t)1 << shift) >> 1);
+}
+
+void StatHistogram::record(uint64_t value) {
+    _buckets[getBucket(value)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max = _max.load(std::memory_order_relaxed);
+    while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+double StatHistogram::getMean() const {
+    uint64_t count = getCount();
+    return count > 0 ? (double)_sum.load(std::memory_order_relaxed) / (double)count : 0.0;
+}
+
+uint64_t StatHistogram::getPercentile(float fraction) const {
+    // the buckets may be updated while they are summed, so the count is theirs rather than _count
+    std::array<uint64_t, NUM_BUCKETS> counts;
+    uint64_t count = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        counts[i] = _buckets[i].load(std::memory_order_relaxed);
+        count += counts[i];
+    }
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = std::max<uint64_t>((uint64_t)(fraction * (double)count + 0.5), 1);
+    uint64_t total = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        total += counts[i];
+        if (total >= rank) {
+            return std::min(getBucketValue(i), getMax());
+        }
+    }
+    return getMax();
+}
+
+QJsonObject StatHistogram::toJson() const {
+    QJsonObject histogram;
+    histogram["count"] = (double)getCount();
+    histogram["mean"] = getMean();
+    histogram["p50"] = (double)getPercentile(0.5f);
+    histogram["p90"] = (double)getPercentile(0.9f);
+    histogram["p99"] = (double)getPercentile(0.99f);
+    histogram["max"] = (double)getMax();
+    return histogram;
+}
+
 StatTracker::StatTracker() {
     
 }
 
-QVariant StatTracker::getStat(const QString& name) {
-    std::lock_guard<std::mutex> lock(_statsLock);
-    return QVariant::fromValue<int64_t>(_stats[name]);
+template <typename T>
+static T& registerMetric(QHash<QString, std::shared_ptr<T>>& metrics, const QString& name) {
+    auto& metric = metrics[name];
+    if (!metric) {
+        metric = std::make_shared<T>();
+    }
+    return *metric;
 }
 
-void StatTracker::setStat(const QString& name, int64_t value) {
+StatCounter& StatTracker::registerCounter(const QString& name) {
     Lock lock(_statsLock);
-    _stats[name] = value;
+    return registerMetric(_counters, name);
 }
 
-void StatTracker::updateStat(const QString& name, int64_t value) {
+StatGauge& StatTracker::registerGauge(const QString& name) {
+    Lock lock(_statsLock);
+    return registerMetric(_gauges, name);
+}
+
+StatHistogram& StatTracker::registerHistogram(const QString& name) {
     Lock lock(_statsLock);
-    auto itr = _stats.find(name);
-    if (_stats.end() == itr) {
-        _stats[name] = value;
-    } else {
-        *itr = *itr + value;
+    return registerMetric(_histograms, name);
+}
+
+QJsonObject StatTracker::toJson() const {
+    Lock lock(_statsLock);
+    QJsonObject counters;
+    for (auto it = _counters.constBegin(); it != _counters.constEnd(); ++it) {
+        counters[it.key()] = (double)it.value()->get();
+    }
+    QJsonObject gauges;
+    for (auto it = _gauges.constBegin(); it != _gauges.constEnd(); ++it) {
+        gauges[it.key()] = (double)it.value()->get();
+    }
+    QJsonObject histograms;
+    for (auto it = _histograms.constBegin(); it != _histograms.constEnd(); ++it) {
+        histograms[it.key()] = it.value()->toJson();
     }
+
+    QJsonObject metrics;
+    metrics["counters"] = counters;
+    metrics["gauges"] = gauges;
+    metrics["histograms"] = histograms;
+    return metrics;
+}
+
+QVariant StatTracker::getStat(const QString& name) {
+    return QVariant::fromValue<int64_t>(registerGauge(name).get());
+}
+
+void StatTracker::setStat(const QString& name, int64_t value) {
+    registerGauge(name).set(value);
+}
+
+void StatTracker::updateStat(const QString& name, int64_t value) {
+    registerGauge(name).update(value);
 }
 
 void StatTracker::incrementStat(const QString& name) {
@@ -38,4 +156,4 @@ void StatTracker::incrementStat(const QString& name) {
 
 void StatTracker::decrementStat(const QString& name) {
     updateStat(name, -1);
-}
\ No newline at end of file
+}
@@ -12,7 +12,11 @@
 #include <QtCore/QVariant>
 #include <QtCore/QSet>
 #include <QtCore/QVariantMap>
+#include <QtCore/QJsonObject>
 
+#include <array>
+#include <atomic>
+#include <memory>
 #include <mutex>
 
 #include "DependencyManager.h"
@@ -20,9 +24,72 @@
 
 using EditStatFunction = std::function<QVariant(QVariant currentValue)>;
 
+// The metrics of the tracker are registered by name once, and then updated through the handle registering them returns.
+// The handles stay valid for as long as the tracker and update with relaxed atomics, so they can be kept and used
+// from any thread, the hot paths included
+
+// a count that only goes up
+class StatCounter {
+public:
+    void increment(int64_t count = 1) { _value.fetch_add(count, std::memory_order_relaxed); }
+    int64_t get() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> _value { 0 };
+};
+
+// a value that is set, or that goes up and down
+class StatGauge {
+public:
+    void set(int64_t value) { _value.store(value, std::memory_order_relaxed); }
+    void update(int64_t mod) { _value.fetch_add(mod, std::memory_order_relaxed); }
+    int64_t get() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> _value { 0 };
+};
+
+// The distribution of a value, such as a time in usecs. The values are counted in buckets that are a sixteenth of a
+// power of two wide, so the percentiles are within about 6% of the values recorded
+class StatHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 4;
+    static const int NUM_SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * NUM_SUB_BUCKETS;
+
+    void record(uint64_t value);
+
+    uint64_t getCount() const { return _count.load(std::memory_order_relaxed); }
+    uint64_t getMax() const { return _max.load(std::memory_order_relaxed); }
+    double getMean() const;
+    // the value below which the fraction of the values recorded are
+    uint64_t getPercentile(float fraction) const;
+
+    QJsonObject toJson() const;
+
+private:
+    static int getBucket(uint64_t value);
+    static uint64_t getBucketValue(int bucket);
+
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> _buckets {};
+    std::atomic<uint64_t> _count { 0 };
+    std::atomic<uint64_t> _sum { 0 };
+    std::atomic<uint64_t> _max { 0 };
+};
+
 class StatTracker : public Dependency {
 public:
     StatTracker();
+
+    // registering a name again returns the same metric
+    StatCounter& registerCounter(const QString& name);
+    StatGauge& registerGauge(const QString& name);
+    StatHistogram& registerHistogram(const QString& name);
+
+    // all of the metrics, in the format that the assignment clients and the interface report them in
+    QJsonObject toJson() const;
+
+    // the stats named here are the gauges of the same names, looked up on every call
     QVariant getStat(const QString& name);
     void setStat(const QString& name, int64_t value);
     void updateStat(const QString& name, int64_t mod);
@@ -31,18 +98,20 @@ public:
 private:
     using Mutex = std::mutex;
     using Lock = std::lock_guard<Mutex>;
-    Mutex _statsLock;
-    QHash<QString, int64_t> _stats;
+    mutable Mutex _statsLock;
+    QHash<QString, std::shared_ptr<StatCounter>> _counters;
+    QHash<QString, std::shared_ptr<StatGauge>> _gauges;
+    QHash<QString, std::shared_ptr<StatHistogram>> _histograms;
 };
 
 class CounterStat {
 public:
-    CounterStat(QString name) : _name(name) {
-        DependencyManager::get<StatTracker>()->incrementStat(_name);
+    CounterStat(QString name) : _gauge(DependencyManager::get<StatTracker>()->registerGauge(name)) {
+        _gauge.update(1);
     }    
     ~CounterStat() {
-        DependencyManager::get<StatTracker>()->decrementStat(_name);
+        _gauge.update(-1);
     }    
 private:
-    QString _name;
+    StatGauge& _gauge;
 };
@@ -8,6 +8,7 @@
 
 #include "Trace.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include <QtCore/QDebug>
@@ -29,6 +30,7 @@
 #include <BuildInfo.h>
 
 #include "Gzip.h"
+#include "NumericalConstants.h"
 #include "PortableHighResolutionClock.h"
 #include "SharedLogging.h"
 #include "shared/FileUtils.h"
@@ -36,10 +38,58 @@
 
 using namespace tracing;
 
+// the rings of this many finished threads are kept, for the events they recorded before they finished
+static const size_t MAX_FINISHED_RING_BUFFERS = 16;
+
+std::atomic<uint32_t> Tracer::_nextInstanceID { 1 };
+
+namespace {
+    // the ring of the thread, for the tracer it was made for
+    struct ThreadRingBuffer {
+        uint32_t tracerID { 0 };
+        std::shared_ptr<TraceRingBuffer> buffer;
+
+        ~ThreadRingBuffer() {
+            if (buffer) {
+                buffer->isFinished = true;
+            }
+        }
+    };
+
+    thread_local ThreadRingBuffer threadRingBuffer;
+}
+
 bool tracing::enabled() {
     return DependencyManager::get<Tracer>()->isEnabled();
 }
 
+void TraceRingBuffer::push(const TraceRecord& record) {
+    uint64_t index = _writeIndex.load(std::memory_order_relaxed);
+    _records[index % SIZE] = record;
+    _writeIndex.store(index + 1, std::memory_order_release);
+}
+
+void TraceRingBuffer::read(int64_t since, std::vector<TraceRecord>& recordsOut) const {
+    uint64_t end = _writeIndex.load(std::memory_order_acquire);
+    uint64_t begin = end > SIZE ? end - SIZE : 0;
+    size_t first = recordsOut.size();
+    for (uint64_t index = begin; index < end; index++) {
+        recordsOut.push_back(_records[index % SIZE]);
+    }
+
+    // the oldest records were overwritten if the thread kept writing meanwhile, and the one after them may be half written
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t writeEnd = _writeIndex.load(std::memory_order_relaxed) + 1;
+    if (writeEnd > begin + SIZE) {
+        size_t numDropped = (size_t)std::min<uint64_t>(writeEnd - (begin + SIZE), end - begin);
+        recordsOut.erase(recordsOut.begin() + first, recordsOut.begin() + first + numDropped);
+    }
+
+    recordsOut.erase(std::remove_if(recordsOut.begin() + first, recordsOut.end(), [&](const TraceRecord& record) {
+        return record.timestamp < since;
+    }), recordsOut.end());
+}
+
 void Tracer::startTracing() {
     std::lock_guard<std::mutex> guard(_eventsMutex);
     if (_enabled) {
@@ -60,6 +110,22 @@ void Tracer::stopTracing() {
     _enabled = false;
 }
 
+void Tracer::startContinuousTracing() {
+    if (_continuous) {
+        qWarning() << "Tried to enable continuous tracing, but already enabled";
+        return;
+    }
+    _continuous = true;
+}
+
+void Tracer::stopContinuousTracing() {
+    if (!_continuous) {
+        qWarning() << "Cannot stop continuous tracing, already disabled";
+        return;
+    }
+    _continuous = false;
+}
+
 void TraceEvent::writeJson(QTextStream& out) const {
 #if 0
     // FIXME QJsonObject serialization is very slow, so we should be using manual JSON serialization
@@ -121,13 +187,96 @@ void Tracer::serialize(const QString& filename) {
         }
     }
 
-    // If we can't open a temp file for writing, fail early
+    writeEvents(fullPath, currentEvents);
+
+#if 0
+    QByteArray data;
+    {
+
+        // "traceEvents":[
+        // {"args":{"nv_payload":0},"cat":"hifi.render","name":"render::Scene::processTransactionQueue","ph":"B","pid":14796,"tid":21636,"ts":68795933487}
+
+        QJsonArray traceEvents;
+
+        QJsonDocument document {
+            QJsonObject {
+                { "traceEvents", traceEvents },
+                { "otherData", QJsonObject {
+                    { "version", QString { "High Fidelity Interface v1.0" } +BuildInfo::VERSION }
+                } }
+            }
+        };
+        data = document.toJson(QJsonDocument::Compact);
+    }
+#endif
+}
+
+void Tracer::serializeRecent(const QString& filename, float seconds) {
+    QString fullPath = FileUtils::replaceDateTimeTokens(filename);
+    fullPath = FileUtils::computeDocumentPath(fullPath);
+    if (!FileUtils::canCreateFile(fullPath)) {
+        return;
+    }
+
+    int64_t since = now() - (int64_t)(seconds * USECS_PER_SECOND);
+    std::list<std::shared_ptr<TraceRingBuffer>> ringBuffers;
+    {
+        std::lock_guard<std::mutex> guard(_ringBuffersMutex);
+        ringBuffers = _ringBuffers;
+    }
+
+    std::list<TraceEvent> recentEvents;
+    {
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        recentEvents = _metadataEvents;
+    }
+
+    // the names are copied after the records, so that they hold all of the names the records refer to
+    std::vector<std::pair<int64_t, std::vector<TraceRecord>>> threadRecords;
+    for (const auto& ringBuffer : ringBuffers) {
+        threadRecords.emplace_back(ringBuffer->getThreadID(), std::vector<TraceRecord>());
+        ringBuffer->read(since, threadRecords.back().second);
+    }
+    std::vector<QString> names;
+    {
+        std::lock_guard<std::mutex> guard(_namesMutex);
+        names = _names;
+    }
+
+    auto processID = QCoreApplication::applicationPid();
+    for (const auto& records : threadRecords) {
+        for (const auto& record : records.second) {
+            QVariantMap args;
+            QVariantMap extra;
+            if (record.type == Complete) {
+                extra["dur"] = record.value;
+            } else if (record.type == Counter) {
+                args["value"] = record.value;
+            }
+            recentEvents.push_back({
+                "",
+                names[record.nameID],
+                record.type,
+                record.timestamp,
+                processID,
+                records.first,
+                *record.category,
+                args,
+                extra
+            });
+        }
+    }
+
+    writeEvents(fullPath, recentEvents);
+}
+
+void Tracer::writeEvents(const QString& fullPath, const std::list<TraceEvent>& events) {
     QByteArray data;
     {
         QTextStream out(&data);
         out << "[\n";
         bool first = true;
-        for (const auto& event : currentEvents) {
+        for (const auto& event : events) {
             if (first) {
                 first = false;
             } else {
@@ -153,27 +302,6 @@ void Tracer::serialize(const QString& filename) {
         file.write(data);
         file.close();
     }
-
-#if 0
-    QByteArray data;
-    {
-
-        // "traceEvents":[
-        // {"args":{"nv_payload":0},"cat":"hifi.render","name":"render::Scene::processTransactionQueue","ph":"B","pid":14796,"tid":21636,"ts":68795933487}
-
-        QJsonArray traceEvents;
-
-        QJsonDocument document {
-            QJsonObject {
-                { "traceEvents", traceEvents },
-                { "otherData", QJsonObject {
-                    { "version", QString { "High Fidelity Interface v1.0" } +BuildInfo::VERSION }
-                } }
-            }
-        };
-        data = document.toJson(QJsonDocument::Compact);
-    }
-#endif
 }
 
 int64_t Tracer::now() {
@@ -223,10 +351,73 @@ void Tracer::traceEvent(const QLoggingCategory& category,
     }
 }
 
+void Tracer::recordEvent(const QLoggingCategory& category, const QString& name, EventType type, int64_t timestamp,
+    const QVariantMap& args, const QVariantMap& extra) {
+    TraceRecord record { timestamp, 0.0, &category, 0, type };
+    switch (type) {
+        case DurationBegin:
+        case DurationEnd:
+        case Instant:
+            break;
+        case Complete:
+            record.value = extra.value("dur").toDouble();
+            break;
+        case Counter:
+            record.value = args.empty() ? 0.0 : args.first().toDouble();
+            break;
+        default:
+            // the async and flow events need their ids, which the records don't keep
+            return;
+    }
+
+    auto& ringBuffer = getThreadRingBuffer();
+    auto it = ringBuffer.nameIDs.constFind(name);
+    if (it != ringBuffer.nameIDs.constEnd()) {
+        record.nameID = it.value();
+    } else {
+        {
+            std::lock_guard<std::mutex> guard(_namesMutex);
+            auto nameIt = _nameIDs.constFind(name);
+            if (nameIt != _nameIDs.constEnd()) {
+                record.nameID = nameIt.value();
+            } else {
+                record.nameID = (uint32_t)_names.size();
+                _names.push_back(name);
+                _nameIDs.insert(name, record.nameID);
+            }
+        }
+        ringBuffer.nameIDs.insert(name, record.nameID);
+    }
+    ringBuffer.push(record);
+}
+
+TraceRingBuffer& Tracer::getThreadRingBuffer() {
+    auto& thread = threadRingBuffer;
+    if (thread.tracerID != _instanceID) {
+        if (thread.buffer) {
+            thread.buffer->isFinished = true;
+        }
+        thread.buffer = std::make_shared<TraceRingBuffer>(int64_t(QThread::currentThreadId()));
+        thread.tracerID = _instanceID;
+
+        std::lock_guard<std::mutex> guard(_ringBuffersMutex);
+        size_t numFinished = 0;
+        for (auto it = _ringBuffers.rbegin(); it != _ringBuffers.rend();) {
+            if ((*it)->isFinished && ++numFinished > MAX_FINISHED_RING_BUFFERS) {
+                it = decltype(it)(_ringBuffers.erase(std::next(it).base()));
+            } else {
+                ++it;
+            }
+        }
+        _ringBuffers.push_back(thread.buffer);
+    }
+    return *thread.buffer;
+}
+
 void Tracer::traceEvent(const QLoggingCategory& category, 
     const QString& name, EventType type, const QString& id, 
     const QVariantMap& args, const QVariantMap& extra) {
-    if (!_enabled && type != Metadata) {
+    if (!isEnabled() && type != Metadata) {
         return;
     }
 
@@ -236,6 +427,9 @@ void Tracer::traceEvent(const QLoggingCategory& category,
 void Tracer::traceEvent(const QLoggingCategory& category, 
     const QString& name, EventType type, int64_t timestamp, const QString& id, 
     const QVariantMap& args, const QVariantMap& extra) {
+    if (_continuous && type != Metadata) {
+        recordEvent(category, name, type, timestamp, args, extra);
+    }
     if (!_enabled && type != Metadata) {
         return;
     }
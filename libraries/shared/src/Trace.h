@@ -10,8 +10,12 @@
 #ifndef hifi_Trace_h
 #define hifi_Trace_h
 
+#include <atomic>
 #include <cstdint>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QString>
 #include <QtCore/QVariantMap>
@@ -76,6 +80,38 @@ struct TraceEvent {
     void writeJson(QTextStream& out) const;
 };
 
+// An event of the continuous trace. The records keep the name, category, type and time of the events but not their args,
+// so that recording one costs no allocation. The value is the duration of the complete events and the first arg of the counters
+struct TraceRecord {
+    int64_t timestamp;
+    double value;
+    const QLoggingCategory* category;
+    uint32_t nameID;
+    EventType type;
+};
+
+// The records of a thread, in a ring that its thread writes to without locking and that the dumps read from
+class TraceRingBuffer {
+public:
+    static const size_t SIZE = 1 << 14;
+
+    TraceRingBuffer(int64_t threadID) : _threadID(threadID), _records(SIZE) {}
+
+    void push(const TraceRecord& record);
+    // appends the records at or after the time, a record that was overwritten while it was read is dropped
+    void read(int64_t since, std::vector<TraceRecord>& recordsOut) const;
+    int64_t getThreadID() const { return _threadID; }
+
+    // the names this thread has interned, only used from the thread
+    QHash<QString, uint32_t> nameIDs;
+    std::atomic<bool> isFinished { false };
+
+private:
+    const int64_t _threadID;
+    std::vector<TraceRecord> _records;
+    std::atomic<uint64_t> _writeIndex { 0 };
+};
+
 class Tracer : public Dependency {
 public:
     static int64_t now();
@@ -93,9 +129,25 @@ public:
     void startTracing();
     void stopTracing();
     void serialize(const QString& file);
-    bool isEnabled() const { return _enabled; }
+
+    // The continuous trace is cheap enough to leave on: the threads record the recent events into their own rings,
+    // which serializeRecent writes out in the same format as serialize. The async and flow events are not kept, and
+    // the args only in part, see TraceRecord
+    void startContinuousTracing();
+    void stopContinuousTracing();
+    void serializeRecent(const QString& file, float seconds);
+
+    bool isEnabled() const { return _enabled || _continuous; }
+    // whether the args of the events are recorded, which only the full trace does
+    bool isFullTracing() const { return _enabled; }
+    bool isContinuousTracing() const { return _continuous; }
 
 private:
+    void recordEvent(const QLoggingCategory& category, const QString& name, EventType type, int64_t timestamp,
+        const QVariantMap& args, const QVariantMap& extra);
+    TraceRingBuffer& getThreadRingBuffer();
+    void writeEvents(const QString& fullPath, const std::list<TraceEvent>& events);
+
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
         qint64 timestamp, qint64 processID, qint64 threadID,
@@ -106,6 +158,17 @@ private:
     std::list<TraceEvent> _events;
     std::list<TraceEvent> _metadataEvents;
     std::mutex _eventsMutex;
+
+    const uint32_t _instanceID { _nextInstanceID++ };
+    std::atomic<bool> _continuous { false };
+    // the threads' rings, those of the threads that finished are kept until there are too many of them
+    std::list<std::shared_ptr<TraceRingBuffer>> _ringBuffers;
+    std::mutex _ringBuffersMutex;
+    std::vector<QString> _names;
+    QHash<QString, uint32_t> _nameIDs;
+    std::mutex _namesMutex;
+
+    static std::atomic<uint32_t> _nextInstanceID;
 };
 
 inline void traceEvent(const QLoggingCategory& category, int64_t timestamp, const QString& name, EventType type, const QString& id = "", const QVariantMap& args = {}, const QVariantMap& extra = {}) {
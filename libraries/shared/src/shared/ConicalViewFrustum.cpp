@@ -35,6 +35,16 @@ void ConicalViewFrustum::set(const ViewFrustum& viewFrustum) {
                                angleBetween(_direction, bottomRight)));
 }
 
+void ConicalViewFrustum::set(const glm::vec3& position, const glm::vec3& direction, float angle, float radius,
+                             float farClip) {
+    _position = position;
+    _direction = direction;
+    _angle = angle;
+    _radius = radius;
+    _farClip = farClip;
+    calculate();
+}
+
 void ConicalViewFrustum::calculate() {
     // Pre-compute cos and sin for faster checks
     _cosAngle = cosf(_angle);
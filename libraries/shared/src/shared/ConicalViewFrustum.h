@@ -33,6 +33,7 @@ public:
     ConicalViewFrustum(const ViewFrustum& viewFrustum) { set(viewFrustum); }
 
     void set(const ViewFrustum& viewFrustum);
+    void set(const glm::vec3& position, const glm::vec3& direction, float angle, float radius, float farClip);
     void calculate();
 
     const glm::vec3& getPosition() const { return _position; }
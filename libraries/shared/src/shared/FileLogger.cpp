@@ -22,7 +22,7 @@
 #include "../SharedUtil.h"
 #include "../SharedLogging.h"
 
-class FilePersistThread : public GenericQueueThread < QString > {
+class FilePersistThread : public GenericMPSCQueueThread<QString> {
     Q_OBJECT
 public:
     FilePersistThread(const FileLogger& logger);
@@ -0,0 +1,106 @@
+//
+//  InterestRegion.cpp
+//  libraries/shared/src/shared
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "InterestRegion.h"
+
+#include <cstring>
+
+#include <glm/gtx/norm.hpp>
+
+#include "../GLMHelpers.h"
+
+void InterestRegion::setSphere(const glm::vec3& center, float radius) {
+    _shape = Sphere;
+    _center = center;
+    _halfExtents = glm::vec3(radius, 0.0f, 0.0f);
+}
+
+void InterestRegion::setBox(const glm::vec3& corner, const glm::vec3& dimensions) {
+    _shape = Box;
+    _halfExtents = 0.5f * glm::abs(dimensions);
+    _center = corner + 0.5f * dimensions;
+}
+
+bool InterestRegion::isVerySimilar(const InterestRegion& other) const {
+    const float MIN_POSITION_SLOP_SQUARED = 0.25f; // half a meter squared
+    const float MIN_RELATIVE_ERROR = 0.01f; // 1%
+
+    return _shape == other._shape &&
+        glm::distance2(_center, other._center) < MIN_POSITION_SLOP_SQUARED &&
+        closeEnough(_halfExtents.x, other._halfExtents.x, MIN_RELATIVE_ERROR) &&
+        closeEnough(_halfExtents.y, other._halfExtents.y, MIN_RELATIVE_ERROR) &&
+        closeEnough(_halfExtents.z, other._halfExtents.z, MIN_RELATIVE_ERROR) &&
+        closeEnough(_minEntitySize, other._minEntitySize, MIN_RELATIVE_ERROR) &&
+        _updatePeriod == other._updatePeriod;
+}
+
+bool InterestRegion::intersects(const glm::vec3& center, float radius) const {
+    if (_shape == Sphere) {
+        float reach = _halfExtents.x + radius;
+        return glm::distance2(center, _center) <= reach * reach;
+    }
+    glm::vec3 offset = glm::max(glm::abs(center - _center) - _halfExtents, glm::vec3(0.0f));
+    return glm::length2(offset) <= radius * radius;
+}
+
+float InterestRegion::computePriority(const glm::vec3& center, float radius) const {
+    if (2.0f * radius < _minEntitySize || !intersects(center, radius)) {
+        return -1.0f;
+    }
+    const float AVOID_DIVIDE_BY_ZERO = 0.001f;
+    float size = _shape == Sphere ? _halfExtents.x : glm::length(_halfExtents);
+    return radius / (glm::distance(center, _center) + size + AVOID_DIVIDE_BY_ZERO);
+}
+
+int InterestRegion::serialize(unsigned char* destinationBuffer) const {
+    const unsigned char* startPosition = destinationBuffer;
+
+    memcpy(destinationBuffer, &_shape, sizeof(_shape));
+    destinationBuffer += sizeof(_shape);
+    memcpy(destinationBuffer, &_center, sizeof(_center));
+    destinationBuffer += sizeof(_center);
+    if (_shape == Sphere) {
+        memcpy(destinationBuffer, &_halfExtents.x, sizeof(_halfExtents.x));
+        destinationBuffer += sizeof(_halfExtents.x);
+    } else {
+        memcpy(destinationBuffer, &_halfExtents, sizeof(_halfExtents));
+        destinationBuffer += sizeof(_halfExtents);
+    }
+    memcpy(destinationBuffer, &_minEntitySize, sizeof(_minEntitySize));
+    destinationBuffer += sizeof(_minEntitySize);
+    memcpy(destinationBuffer, &_updatePeriod, sizeof(_updatePeriod));
+    destinationBuffer += sizeof(_updatePeriod);
+
+    return destinationBuffer - startPosition;
+}
+
+int InterestRegion::deserialize(const unsigned char* sourceBuffer) {
+    const unsigned char* startPosition = sourceBuffer;
+
+    memcpy(&_shape, sourceBuffer, sizeof(_shape));
+    sourceBuffer += sizeof(_shape);
+    memcpy(&_center, sourceBuffer, sizeof(_center));
+    sourceBuffer += sizeof(_center);
+    if (_shape == Sphere) {
+        _halfExtents = glm::vec3(0.0f);
+        memcpy(&_halfExtents.x, sourceBuffer, sizeof(_halfExtents.x));
+        sourceBuffer += sizeof(_halfExtents.x);
+    } else {
+        _shape = Box;
+        memcpy(&_halfExtents, sourceBuffer, sizeof(_halfExtents));
+        sourceBuffer += sizeof(_halfExtents);
+    }
+    memcpy(&_minEntitySize, sourceBuffer, sizeof(_minEntitySize));
+    sourceBuffer += sizeof(_minEntitySize);
+    memcpy(&_updatePeriod, sourceBuffer, sizeof(_updatePeriod));
+    sourceBuffer += sizeof(_updatePeriod);
+
+    return sourceBuffer - startPosition;
+}
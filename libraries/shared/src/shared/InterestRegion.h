@@ -0,0 +1,66 @@
+//
+//  InterestRegion.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_InterestRegion_h
+#define hifi_InterestRegion_h
+
+#include <stdint.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// InterestRegion is a sphere or box a client queries the entities in, for clients such as bots and recorders that
+// have no view to speak of. Each region carries hints for the server: the size of the smallest entities in it worth
+// sending, and how often it needs to hear about changes to them.
+class InterestRegion {
+public:
+    enum Shape : uint8_t {
+        Sphere = 0,
+        Box
+    };
+
+    InterestRegion() = default;
+
+    void setSphere(const glm::vec3& center, float radius);
+    void setBox(const glm::vec3& corner, const glm::vec3& dimensions);
+
+    // entities whose bounding sphere is smaller across than this are left out
+    void setMinEntitySize(float minEntitySize) { _minEntitySize = minEntitySize; }
+    // changes to entities only in this region are needed no more often than this
+    void setUpdatePeriod(uint32_t updatePeriodMsecs) { _updatePeriod = updatePeriodMsecs; }
+
+    Shape getShape() const { return _shape; }
+    const glm::vec3& getCenter() const { return _center; }
+    const glm::vec3& getHalfExtents() const { return _halfExtents; }
+    float getMinEntitySize() const { return _minEntitySize; }
+    uint32_t getUpdatePeriod() const { return _updatePeriod; }
+
+    bool isVerySimilar(const InterestRegion& other) const;
+
+    // whether the sphere touches the region
+    bool intersects(const glm::vec3& center, float radius) const;
+
+    // the priority of an entity with the bounding sphere in the region, or a negative value if it isn't of interest.
+    // Like the angular size in a view, it is highest for large entities near the middle of the region.
+    float computePriority(const glm::vec3& center, float radius) const;
+
+    int serialize(unsigned char* destinationBuffer) const;
+    int deserialize(const unsigned char* sourceBuffer);
+
+private:
+    Shape _shape { Sphere };
+    glm::vec3 _center { 0.0f };
+    glm::vec3 _halfExtents { 0.0f }; // just the x for a sphere
+    float _minEntitySize { 0.0f };
+    uint32_t _updatePeriod { 0 };
+};
+using InterestRegions = std::vector<InterestRegion>;
+
+#endif // hifi_InterestRegion_h
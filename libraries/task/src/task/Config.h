@@ -21,6 +21,8 @@
 #include <QtCore/QRegularExpression>
 #include <shared/JSONHelpers.h>
 
+#include <RunTimeHistory.h>
+
 #include "SettingHandle.h"
 
 namespace task {
@@ -99,6 +101,8 @@ public:
  * @hifi-avatar
  *
  * @property {number} cpuRunTime - <em>Read-only.</em>
+ * @property {number} cpuRunTimeP95 - <em>Read-only.</em> The 95th percentile of the last runs' CPU times.
+ * @property {number} cpuRunTimeP99 - <em>Read-only.</em> The 99th percentile of the last runs' CPU times.
  * @property {boolean} enabled
  * @property {number} branch
  */
@@ -106,10 +110,13 @@ public:
 class JobConfig : public QObject {
     Q_OBJECT
     Q_PROPERTY(double cpuRunTime READ getCPURunTime NOTIFY newStats()) //ms
+    Q_PROPERTY(double cpuRunTimeP95 READ getCPURunTimeP95 NOTIFY newStats()) //ms
+    Q_PROPERTY(double cpuRunTimeP99 READ getCPURunTimeP99 NOTIFY newStats()) //ms
     Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY dirtyEnabled())
     Q_PROPERTY(int branch READ getBranch WRITE setBranch NOTIFY dirtyEnabled)
 
     double _msCPURunTime{ 0.0 };
+    RunTimeHistory _cpuRunTimeHistory;
 
 protected:
     friend class TaskConfig;
@@ -147,8 +154,14 @@ public:
 
     // Running Time measurement
     // The new stats signal is emitted once per run time of a job when stats  (cpu runtime) are updated
-    void setCPURunTime(const std::chrono::nanoseconds& runtime) { _msCPURunTime = std::chrono::duration<double, std::milli>(runtime).count(); emit newStats(); }
+    void setCPURunTime(const std::chrono::nanoseconds& runtime) {
+        _msCPURunTime = std::chrono::duration<double, std::milli>(runtime).count();
+        _cpuRunTimeHistory.addSample(_msCPURunTime);
+        emit newStats();
+    }
     double getCPURunTime() const { return _msCPURunTime; }
+    double getCPURunTimeP95() const { return _cpuRunTimeHistory.getPercentile(0.95); }
+    double getCPURunTimeP99() const { return _cpuRunTimeHistory.getPercentile(0.99); }
 
     /**jsdoc
      * @function Workload.getConfig
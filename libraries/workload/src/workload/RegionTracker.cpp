@@ -46,5 +46,8 @@ void RegionTracker::run(const WorkloadContextPointer& context, Outputs& outputs)
                 outRegionChanges[2 * change.region + 1].push_back(change.proxyId);
             }
         }
+
+        auto config = std::static_pointer_cast<Config>(context->jobConfig);
+        config->setNum((uint32_t)outChanges.size(), space->getNumClassifiedProxies());
     }
 }
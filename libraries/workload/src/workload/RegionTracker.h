@@ -22,8 +22,26 @@ namespace workload {
 
     class RegionTrackerConfig : public Job::Config {
         Q_OBJECT
+        Q_PROPERTY(int numChanges READ getNumChanges NOTIFY dirty)
+        Q_PROPERTY(int numClassifiedProxies READ getNumClassifiedProxies NOTIFY dirty)
     public:
         RegionTrackerConfig() : Job::Config(true) {}
+
+        // the region transitions of the last frame, and the proxies that were classified again to find them
+        uint32_t getNumChanges() const { return data.numChanges; }
+        uint32_t getNumClassifiedProxies() const { return data.numClassifiedProxies; }
+
+        void setNum(const uint32_t changes, const uint32_t classifiedProxies) {
+            data.numChanges = changes; data.numClassifiedProxies = classifiedProxies; emit dirty();
+        }
+
+        struct Data {
+            uint32_t numChanges{ 0 };
+            uint32_t numClassifiedProxies{ 0 };
+        } data;
+
+    signals:
+        void dirty();
     };
 
     class RegionTracker {
@@ -13,6 +13,8 @@
 //
 
 #include "Space.h"
+#include <cfloat>
+#include <cmath>
 #include <cstring>
 #include <algorithm>
 
@@ -31,6 +33,7 @@ void Space::processTransactionFrame(const Transaction& transaction) {
     if (maxID > (Index) _proxies.size()) {
         _proxies.resize(maxID + 100); // allocate the maxId and more
         _owners.resize(maxID + 100);
+        _proxyDriftLimits.resize(maxID + 100, -1.0);
     }
     // Now we know for sure that we have enough items in the array to
     // capture anything coming from the transaction
@@ -54,6 +57,7 @@ void Space::processResets(const Transaction::Resets& transactions) {
         // Reset the item with a new payload
         item.sphere = (std::get<1>(reset));
         item.prevRegion = item.region = Region::UNKNOWN;
+        _proxyDriftLimits[proxyID] = -1.0;
 
         _owners[proxyID] = (std::get<2>(reset));
     }
@@ -87,6 +91,7 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
 
         // Update the item
         item.sphere = (std::get<1>(update));
+        _proxyDriftLimits[updateID] = -1.0;
     }
 }
 
@@ -94,23 +99,51 @@ void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
     uint32_t numProxies = (uint32_t)_proxies.size();
     uint32_t numViews = (uint32_t)_views.size();
+
+    // a region boundary moves by no more than the center of its sphere plus the change of its radius
+    bool areViewsNew = numViews != (uint32_t)_classifiedViews.size();
+    if (!areViewsNew) {
+        float maxDrift = 0.0f;
+        for (uint32_t j = 0; j < numViews; ++j) {
+            for (uint32_t k = 0; k < Region::NUM_TRACKED_REGIONS; ++k) {
+                const Sphere& region = _views[j].regions[k];
+                const Sphere& prevRegion = _classifiedViews[j].regions[k];
+                float drift = glm::distance(glm::vec3(region), glm::vec3(prevRegion)) + fabsf(region.w - prevRegion.w);
+                maxDrift = std::max(maxDrift, drift);
+            }
+        }
+        _viewDrift += maxDrift;
+    }
+    _classifiedViews = _views;
+
+    _numClassifiedProxies = 0;
     for (uint32_t i = 0; i < numProxies; ++i) {
         Proxy& proxy = _proxies[i];
         if (proxy.region < Region::INVALID) {
+            if (!areViewsNew && _viewDrift <= _proxyDriftLimits[i]) {
+                proxy.prevRegion = proxy.region;
+                continue;
+            }
+            ++_numClassifiedProxies;
             glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
             float proxyRadius = proxy.sphere.w;
             uint8_t region = Region::R4;
+            // the distance to the nearest of the boundaries that decided the region
+            float margin = FLT_MAX;
             for (uint32_t j = 0; j < numViews; ++j) {
                 auto& view = _views[j];
                 // for each 'view' we need only increment 'k' below the current value of 'region'
                 for (uint8_t k = 0; k < region; ++k) {
                     float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
+                    float gap = glm::distance(proxyCenter, glm::vec3(view.regions[k])) - touchDistance;
+                    margin = std::min(margin, fabsf(gap));
+                    if (gap < 0.0f) {
                         region = k;
                         break;
                     }
                 }
             }
+            _proxyDriftLimits[i] = _viewDrift + (double)margin;
             proxy.prevRegion = proxy.region;
             proxy.region = region;
             if (proxy.region != proxy.prevRegion) {
@@ -149,7 +182,10 @@ void Space::clear() {
     _IDAllocator.clear();
     _proxies.clear();
     _owners.clear();
+    _proxyDriftLimits.clear();
+    _viewDrift = 0.0;
     _views.clear();
+    _classifiedViews.clear();
 }
 
 void Space::setViews(const Views& views) {
@@ -46,6 +46,8 @@ public:
     uint32_t getNumAllocatedProxies() const { return (uint32_t)(_IDAllocator.getNumAllocatedIndices()); }
 
     void categorizeAndGetChanges(std::vector<Change>& changes);
+    // the number of proxies classified again by the last categorizeAndGetChanges
+    uint32_t getNumClassifiedProxies() const { return _numClassifiedProxies; }
     uint32_t copyProxyValues(Proxy* proxies, uint32_t numDestProxies) const;
 
     const Owner getOwner(int32_t proxyID) const;
@@ -64,7 +66,14 @@ private:
     Proxy::Vector _proxies;
     std::vector<Owner> _owners;
 
+    // The region of a proxy can't change until the spheres of the views have drifted past the limit of the proxy,
+    // so categorizeAndGetChanges only classifies again the proxies that moved and the ones near a region boundary
+    std::vector<double> _proxyDriftLimits;
+    double _viewDrift { 0.0 };
+    uint32_t _numClassifiedProxies { 0 };
+
     Views _views;
+    Views _classifiedViews;
 };
 
 using SpacePointer = std::shared_ptr<Space>;
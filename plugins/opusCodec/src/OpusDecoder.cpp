@@ -97,17 +97,28 @@ void AthenaOpusDecoder::decode(const QByteArray &encodedBuffer, QByteArray &deco
 }
 
 void AthenaOpusDecoder::lostFrame(QByteArray &decodedBuffer) {
-    assert(_decoder);
-
     PerformanceTimer perfTimer("AthenaOpusDecoder::lostFrame");
+    concealFrame(QByteArray(), decodedBuffer);
+}
+
+void AthenaOpusDecoder::recoverFrame(const QByteArray& nextEncodedBuffer, QByteArray& decodedBuffer) {
+    PerformanceTimer perfTimer("AthenaOpusDecoder::recoverFrame");
+    concealFrame(nextEncodedBuffer, decodedBuffer);
+}
+
+void AthenaOpusDecoder::concealFrame(const QByteArray& nextEncodedBuffer, QByteArray& decodedBuffer) {
+    assert(_decoder);
 
     int bufferSize = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * static_cast<int>(sizeof(int16_t))
         * _opusNumChannels;
     decodedBuffer.resize(bufferSize);
     int bufferFrames = decodedBuffer.size() / _opusNumChannels / static_cast<int>(sizeof(opus_int16));
 
-    int decoded_frames = opus_decode(_decoder, nullptr, 0, reinterpret_cast<opus_int16*>(decodedBuffer.data()),
-        bufferFrames, 1);
+    // without data, opus conceals the frame from the ones before it
+    const unsigned char* data = nextEncodedBuffer.isEmpty() ? nullptr :
+        reinterpret_cast<const unsigned char*>(nextEncodedBuffer.constData());
+    int decoded_frames = opus_decode(_decoder, data, nextEncodedBuffer.size(),
+        reinterpret_cast<opus_int16*>(decodedBuffer.data()), bufferFrames, 1);
 
     if (decoded_frames >= 0) {
 
@@ -24,9 +24,13 @@ public:
 
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override;
     virtual void lostFrame(QByteArray &decodedBuffer) override;
+    virtual void recoverFrame(const QByteArray& nextEncodedBuffer, QByteArray& decodedBuffer) override;
 
 
 private:
+    // conceals a lost frame, from the FEC data of the next frame if there is one
+    void concealFrame(const QByteArray& nextEncodedBuffer, QByteArray& decodedBuffer);
+
     int _encodedSize;
 
     OpusDecoder* _decoder = nullptr;
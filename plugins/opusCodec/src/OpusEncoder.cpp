@@ -8,6 +8,9 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+#include <cstring>
+
 #include <PerfStat.h>
 #include <QtCore/QLoggingCategory>
 #include <opus/opus.h>
@@ -89,6 +92,48 @@ void AthenaOpusEncoder::encode(const QByteArray& decodedBuffer, QByteArray& enco
 
 }
 
+bool AthenaOpusEncoder::copyStateFrom(const Encoder& other) {
+    auto otherOpus = dynamic_cast<const AthenaOpusEncoder*>(&other);
+    if (!otherOpus || !otherOpus->_encoder || !_encoder ||
+        otherOpus->_opusSampleRate != _opusSampleRate || otherOpus->_opusChannels != _opusChannels) {
+        return false;
+    }
+
+    // the encoder state is a single position independent block, settings included, so it can be copied as is
+    memcpy(_encoder, otherOpus->_encoder, opus_encoder_get_size(_opusChannels));
+    _opusExpectedLoss = otherOpus->_opusExpectedLoss;
+    _adaptedBitrate = otherOpus->_adaptedBitrate;
+    _adaptedComplexity = otherOpus->_adaptedComplexity;
+    return true;
+}
+
+void AthenaOpusEncoder::adapt(float quality, float expectedLoss) {
+    if (!_encoder) {
+        return;
+    }
+    quality = std::min(std::max(quality, 0.0f), 1.0f);
+
+    int bitrate = MIN_ADAPTED_BITRATE + (int)(quality * (DEFAULT_BITRATE - MIN_ADAPTED_BITRATE));
+    if (bitrate != _adaptedBitrate) {
+        setBitrate(bitrate);
+        _adaptedBitrate = bitrate;
+    }
+    int complexity = MIN_ADAPTED_COMPLEXITY + (int)(quality * (DEFAULT_COMPLEXITY - MIN_ADAPTED_COMPLEXITY) + 0.5f);
+    if (complexity != _adaptedComplexity) {
+        setComplexity(complexity);
+        _adaptedComplexity = complexity;
+    }
+
+    // the in-band FEC carries a coarser copy of every frame in the next one, at the cost of some of the bitrate,
+    // so it is only on when frames are actually lost
+    int expectedLossPercentage = std::min(std::max((int)(expectedLoss * 100.0f + 0.5f), 0), 100);
+    if (expectedLossPercentage != _opusExpectedLoss) {
+        setExpectedPacketLossPercentage(expectedLossPercentage);
+        setInbandFEC(expectedLossPercentage > 0 ? 1 : 0);
+        _opusExpectedLoss = expectedLossPercentage;
+    }
+}
+
 int AthenaOpusEncoder::getComplexity() const {
     assert(_encoder);
     int returnValue;
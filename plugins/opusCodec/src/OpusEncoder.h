@@ -21,6 +21,8 @@ public:
     ~AthenaOpusEncoder() override;
 
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override;
+    virtual bool copyStateFrom(const Encoder& other) override;
+    virtual void adapt(float quality, float expectedLoss) override;
 
 
     int getComplexity() const;
@@ -63,6 +65,8 @@ private:
 
     const int DEFAULT_BITRATE = 128000;
     const int DEFAULT_COMPLEXITY = 10;
+    const int MIN_ADAPTED_BITRATE = 32000;
+    const int MIN_ADAPTED_COMPLEXITY = 4;
     const int DEFAULT_APPLICATION = OPUS_APPLICATION_VOIP;
     const int DEFAULT_SIGNAL = OPUS_AUTO;
 
@@ -70,6 +74,10 @@ private:
     int _opusChannels = 0;
     int _opusExpectedLoss = 0;
 
+    // the settings last applied by adapt
+    int _adaptedBitrate = DEFAULT_BITRATE;
+    int _adaptedComplexity = DEFAULT_COMPLEXITY;
+
 
     OpusEncoder* _encoder = nullptr;
 };
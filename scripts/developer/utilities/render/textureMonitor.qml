@@ -70,6 +70,16 @@ Item {
                     prop: "texturePendingGPUTransferSize",
                     label: "Transfer",
                     color: "#FF6309"
+                },
+                {
+                    prop: "textureStagingGPUMemSize",
+                    label: "Staging",
+                    color: "#9495FF"
+                },
+                {
+                    prop: "textureFrameTransferSize",
+                    label: "Frame Upload",
+                    color: "#1AC567"
                 }
             ]
         }
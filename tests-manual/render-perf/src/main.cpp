@@ -16,8 +16,11 @@
 
 #include <QProcessEnvironment>
 
+#include <QtCore/QCommandLineParser>
 #include <QtCore/QDir>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QSettings>
@@ -86,6 +89,9 @@ Q_LOGGING_CATEGORY(renderperflogging, "hifi.render_perf")
 static const QString LAST_SCENE_KEY = "lastSceneFile";
 static const QString LAST_LOCATION_KEY = "lastLocation";
 
+// how far above the baseline the results can be before they count as regressions, a fraction of the baseline
+static const float DEFAULT_BASELINE_TOLERANCE = 0.1f;
+
 class ParentFinder : public SpatialParentFinder {
 public:
     EntityTreePointer _tree;
@@ -516,6 +522,8 @@ public:
         DependencyManager::destroy<NodeList>();
     }
 
+    void setOutputFile(const QString& filename) { _outputFile = filename; }
+
     void loadCommands(const QString& filename) {
         QFileInfo fileInfo(filename);
         if (!fileInfo.exists()) {
@@ -653,6 +661,7 @@ private:
 
         // Final framebuffer that will be handled to the display-plugin
         render(&renderArgs);
+        recordFrame();
 
         if (_fps != _renderThread._fps) {
             _fps = _renderThread._fps;
@@ -709,6 +718,15 @@ private:
 #endif
     }
 
+    // The commands, one per line of the script:
+    //   load <scene file>                 imports a scene, relative to the script
+    //   go <viewpoint>                    puts the camera at /x,y,z/qx,qy,qz,qw
+    //   move <frames> <viewpoint>         moves the camera there over a number of frames
+    //   wait <seconds>
+    //   loop [<max loops>]
+    //   record <name> <frames>            averages the job times and the draw counts over a number of frames
+    //   baseline <results file> [<tolerance>]
+    //   quit                              writes the results, compares them to the baseline and exits
     void runCommand(const QString& command) {
         qDebug() << "Running command: " << command;
         QStringList commandParams = command.split(QRegularExpression(QString("\\s")));
@@ -750,6 +768,32 @@ private:
                 return;
             }
             parsePath(commandParams[1]);
+        } else if (verb == "move") {
+            if (commandParams.length() < 3) {
+                qDebug() << "No frame count or destination specified for move command";
+                return;
+            }
+            startCameraMove(commandParams[1].toInt(), commandParams[2]);
+        } else if (verb == "record") {
+            if (commandParams.length() < 3) {
+                qDebug() << "No name or frame count specified for record command";
+                return;
+            }
+            _recording = Recording();
+            _recording.name = commandParams[1];
+            _recording.framesLeft = commandParams[2].toInt();
+        } else if (verb == "baseline") {
+            if (commandParams.length() < 2) {
+                qDebug() << "No baseline file specified";
+                return;
+            }
+            _baselineFile = commandParams[1];
+            if (QFileInfo(_baselineFile).isRelative()) {
+                _baselineFile = _commandPath + "/" + _baselineFile;
+            }
+            _baselineTolerance = commandParams.length() > 2 ? commandParams[2].toFloat() : DEFAULT_BASELINE_TOLERANCE;
+        } else if (verb == "quit") {
+            finishBenchmark();
         } else {
             qDebug() << "Unknown command " << command;
         }
@@ -769,6 +813,11 @@ private:
             return;
         }
 
+        // the moves and the recordings last a number of frames, so that the runs on a machine are all alike
+        if (_cameraMove.framesLeft > 0 || _recording.framesLeft > 0) {
+            return;
+        }
+
         _nextCommandTime = 0;
         QString command = _commands[_commandIndex++];
         runCommand(command);
@@ -783,6 +832,7 @@ private:
         float delta = now - last;
         // Update the camera
         _camera.update(delta / USECS_PER_SECOND);
+        updateCameraMove();
         {
             _viewFrustum = ViewFrustum();
             _viewFrustum.setProjection(_camera.matrices.perspective);
@@ -975,6 +1025,105 @@ private:
         }
     }
 
+    void startCameraMove(int numFrames, const QString& viewpointString) {
+        _cameraMove.startPosition = _camera.position;
+        _cameraMove.startOrientation = _camera.getOrientation();
+        parsePath(viewpointString);
+        _cameraMove.endPosition = _camera.position;
+        _cameraMove.endOrientation = _camera.getOrientation();
+        _cameraMove.numFrames = std::max(numFrames, 1);
+        _cameraMove.framesLeft = _cameraMove.numFrames;
+        _camera.setPosition(_cameraMove.startPosition);
+        _camera.setRotation(_cameraMove.startOrientation);
+    }
+
+    void updateCameraMove() {
+        if (_cameraMove.framesLeft <= 0) {
+            return;
+        }
+        _cameraMove.framesLeft--;
+        float alpha = 1.0f - (float)_cameraMove.framesLeft / (float)_cameraMove.numFrames;
+        _camera.setPosition(glm::mix(_cameraMove.startPosition, _cameraMove.endPosition, alpha));
+        _camera.setRotation(glm::slerp(_cameraMove.startOrientation, _cameraMove.endOrientation, alpha));
+    }
+
+    // adds the times of every job of the engine in the frame that was just run, along with what the last frame drew
+    void recordFrame() {
+        if (_recording.framesLeft <= 0) {
+            return;
+        }
+
+        auto engineConfig = _renderEngine->getConfiguration();
+        _recording.sums["cpu/" + engineConfig->objectName()] += engineConfig->getCPURunTime();
+        for (auto jobConfig : engineConfig->findChildren<task::JobConfig*>()) {
+            _recording.sums["cpu/" + jobConfig->objectName()] += jobConfig->getCPURunTime();
+            QVariant gpuRunTime = jobConfig->property("gpuRunTime");
+            if (gpuRunTime.isValid()) {
+                _recording.sums["gpu/" + jobConfig->objectName()] += gpuRunTime.toDouble();
+            }
+        }
+
+        gpu::ContextStats stats;
+        _renderThread._gpuContext->getFrameStats(stats);
+        _recording.sums["draw_calls"] += stats._DSNumDrawcalls;
+        _recording.sums["api_draw_calls"] += stats._DSNumAPIDrawcalls;
+        _recording.sums["triangles"] += stats._DSNumTriangles;
+        _recording.numFrames++;
+
+        if (--_recording.framesLeft == 0) {
+            QJsonObject averages;
+            for (const auto& sum : _recording.sums) {
+                averages[sum.first] = sum.second / _recording.numFrames;
+            }
+            _benchmarkResults[_recording.name] = averages;
+            qCDebug(renderperflogging) << "Recorded" << _recording.numFrames << "frames of" << _recording.name;
+        }
+    }
+
+    // Writes the results, and compares them to the baseline if there is one: a recording regresses when any of its times
+    // or counts is above the baseline's by more than the tolerance. The exit code is the number of regressions
+    void finishBenchmark() {
+        if (!_outputFile.isEmpty()) {
+            QFile output(_outputFile);
+            if (output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                output.write(QJsonDocument(_benchmarkResults).toJson());
+            } else {
+                qCWarning(renderperflogging) << "Cannot write the results to" << _outputFile;
+            }
+        }
+
+        int numRegressions = 0;
+        if (!_baselineFile.isEmpty()) {
+            QFile baselineFile(_baselineFile);
+            if (!baselineFile.open(QIODevice::ReadOnly)) {
+                qCWarning(renderperflogging) << "Cannot read the baseline" << _baselineFile;
+                numRegressions++;
+            }
+            QJsonObject baseline = QJsonDocument::fromJson(baselineFile.readAll()).object();
+            for (auto recording = baseline.constBegin(); recording != baseline.constEnd(); ++recording) {
+                if (!_benchmarkResults.contains(recording.key())) {
+                    qCWarning(renderperflogging) << "No results for" << recording.key();
+                    numRegressions++;
+                    continue;
+                }
+                QJsonObject expected = recording.value().toObject();
+                QJsonObject actual = _benchmarkResults[recording.key()].toObject();
+                for (auto metric = expected.constBegin(); metric != expected.constEnd(); ++metric) {
+                    double limit = metric.value().toDouble() * (1.0 + _baselineTolerance);
+                    double value = actual[metric.key()].toDouble();
+                    if (value > limit) {
+                        qCWarning(renderperflogging) << recording.key() << metric.key() << "regressed to" << value
+                            << "from" << metric.value().toDouble();
+                        numRegressions++;
+                    }
+                }
+            }
+        }
+
+        qCDebug(renderperflogging) << "Benchmark done," << numRegressions << "regressions";
+        QCoreApplication::exit(numRegressions);
+    }
+
     QSharedPointer<EntityTreeRenderer> getEntities() { return _octree; }
 
 private:
@@ -1004,10 +1153,32 @@ private:
 
     QStringList _commands;
     QString _commandPath;
+    QString _outputFile;
     int _commandLoops{ 0 };
     int _commandIndex{ -1 };
     uint64_t _nextCommandTime{ 0 };
 
+    struct CameraMove {
+        vec3 startPosition;
+        quat startOrientation;
+        vec3 endPosition;
+        quat endOrientation;
+        int numFrames{ 0 };
+        int framesLeft{ 0 };
+    };
+    CameraMove _cameraMove;
+
+    struct Recording {
+        QString name;
+        int framesLeft{ 0 };
+        int numFrames{ 0 };
+        std::map<QString, double> sums;
+    };
+    Recording _recording;
+    QJsonObject _benchmarkResults;
+    QString _baselineFile;
+    float _baselineTolerance{ DEFAULT_BASELINE_TOLERANCE };
+
     //TextOverlay* _textOverlay;
     static bool _cullingEnabled;
 
@@ -1034,10 +1205,21 @@ int main(int argc, char** argv) {
     QApplication app(argc, argv);
     logger.reset(new FileLogger());
 
+    // a benchmark runs a script of commands, see QTestWindow::runCommand, and ends with its quit command
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption benchmarkOption("benchmark", "Run the commands of a benchmark script.", "commands");
+    QCommandLineOption outputOption("output", "Write the results of the benchmark as JSON.", "file");
+    parser.addOption(benchmarkOption);
+    parser.addOption(outputOption);
+    parser.process(app);
+
     QLoggingCategory::setFilterRules(LOG_FILTER_RULES);
     QTestWindow::setup();
     QTestWindow window;
-    //window.loadCommands("C:/Users/bdavis/Git/dreaming/exports2/commands.txt");
-    app.exec();
-    return 0;
+    window.setOutputFile(parser.value(outputOption));
+    if (parser.isSet(benchmarkOption)) {
+        window.loadCommands(parser.value(benchmarkOption));
+    }
+    return app.exec();
 }
@@ -8,8 +8,12 @@
 //
 
 #include "AnimTests.h"
+
+#include <random>
+
 #include <AnimNodeLoader.h>
 #include <AnimClip.h>
+#include <AnimCompressedClip.h>
 #include <AnimBlendLinear.h>
 #include <AnimationLogging.h>
 #include <AnimVariant.h>
@@ -467,6 +471,108 @@ void AnimTests::testAnimPose() {
     QCOMPARE_WITH_ABS_ERROR(p.scale(), resultScale, TEST_EPSILON2);
 }
 
+static std::vector<AnimPose> randomPoses(std::mt19937& generator, size_t numPoses) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<AnimPose> poses;
+    for (size_t i = 0; i < numPoses; i++) {
+        glm::vec3 scale(distribution(generator), distribution(generator), distribution(generator));
+        glm::quat rot = glm::normalize(glm::quat(distribution(generator), distribution(generator),
+            distribution(generator), distribution(generator)));
+        glm::vec3 trans(distribution(generator), distribution(generator), distribution(generator));
+        poses.push_back(AnimPose(scale, rot, trans));
+    }
+    return poses;
+}
+
+void AnimTests::testBlend() {
+    // enough poses to leave some to the reference code after the vectorized ones
+    const size_t NUM_POSES = 37;
+    std::mt19937 generator(1);
+    std::vector<AnimPose> a = randomPoses(generator, NUM_POSES);
+    std::vector<AnimPose> b = randomPoses(generator, NUM_POSES);
+    std::vector<AnimPose> c = randomPoses(generator, NUM_POSES);
+    std::vector<AnimPose> d = randomPoses(generator, NUM_POSES);
+
+    const float ALPHA = 0.3f;
+    std::vector<AnimPose> result(NUM_POSES);
+    ::blend(NUM_POSES, a.data(), b.data(), ALPHA, result.data());
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        QCOMPARE_WITH_ABS_ERROR(result[i].scale(), lerp(a[i].scale(), b[i].scale(), ALPHA), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].rot(), safeLerp(a[i].rot(), b[i].rot(), ALPHA), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].trans(), lerp(a[i].trans(), b[i].trans(), ALPHA), TEST_EPSILON);
+    }
+
+    float alphas[4] = { 0.1f, 0.2f, 0.3f, 0.4f };
+    ::blend4(NUM_POSES, a.data(), b.data(), c.data(), d.data(), alphas, result.data());
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        glm::quat rot = safeLinearCombine4(a[i].rot(), b[i].rot(), c[i].rot(), d[i].rot(), alphas);
+        glm::vec3 trans = alphas[0] * a[i].trans() + alphas[1] * b[i].trans() + alphas[2] * c[i].trans() + alphas[3] * d[i].trans();
+        QCOMPARE_WITH_ABS_ERROR(result[i].rot(), rot, TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].trans(), trans, TEST_EPSILON);
+    }
+
+    // blending in place, as AnimOverlay does
+    std::vector<AnimPose> expected(NUM_POSES);
+    ::blend(NUM_POSES, a.data(), b.data(), ALPHA, expected.data());
+    ::blend(NUM_POSES, a.data(), b.data(), ALPHA, a.data());
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        QCOMPARE_WITH_ABS_ERROR(a[i].rot(), expected[i].rot(), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(a[i].trans(), expected[i].trans(), TEST_EPSILON);
+    }
+}
+
+void AnimTests::benchmarkBlend() {
+    // about the joints of an avatar
+    const size_t NUM_POSES = 100;
+    std::mt19937 generator(1);
+    std::vector<AnimPose> a = randomPoses(generator, NUM_POSES);
+    std::vector<AnimPose> b = randomPoses(generator, NUM_POSES);
+    std::vector<AnimPose> result(NUM_POSES);
+
+    QBENCHMARK {
+        for (int i = 0; i < 100; i++) {
+            ::blend(NUM_POSES, a.data(), b.data(), (float)i / 100.0f, result.data());
+        }
+    }
+}
+
+void AnimTests::testCompressedClip() {
+    const int NUM_FRAMES = 200;
+    const int NUM_JOINTS = 3;
+    const float ROTATION_TOLERANCE = 0.001f;
+    const float TRANSLATION_TOLERANCE = 0.001f;
+    const float SCALE_TOLERANCE = 0.001f;
+
+    // a joint that holds still, one that moves smoothly and one that jitters
+    std::mt19937 generator(1);
+    std::vector<AnimPoseVec> anim(NUM_FRAMES);
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        float t = (float)frame / (float)NUM_FRAMES;
+        anim[frame].push_back(AnimPose(glm::vec3(1.0f), glm::angleAxis(0.5f, Vectors::UNIT_Y), glm::vec3(0.0f, 1.0f, 0.0f)));
+        anim[frame].push_back(AnimPose(glm::vec3(1.0f), glm::angleAxis(sinf(TWO_PI * t), Vectors::UNIT_X),
+            glm::vec3(0.0f, 0.1f * sinf(TWO_PI * t), 0.5f * t)));
+        anim[frame].push_back(randomPoses(generator, 1)[0]);
+    }
+
+    AnimCompressedClip clip(anim, ROTATION_TOLERANCE, TRANSLATION_TOLERANCE, SCALE_TOLERANCE);
+    QCOMPARE(clip.getFrameCount(), NUM_FRAMES);
+    QCOMPARE(clip.getJointCount(), NUM_JOINTS);
+    QVERIFY(clip.getMemorySize() < NUM_FRAMES * NUM_JOINTS * sizeof(AnimPose) / 2);
+
+    // the quantization adds a little to the tolerances
+    const float MIN_COS_HALF_ANGLE = cosf(ROTATION_TOLERANCE);
+    AnimPoseVec poses(NUM_JOINTS);
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        clip.sampleFrame(frame, poses.data());
+        for (int joint = 0; joint < NUM_JOINTS; joint++) {
+            const AnimPose& expected = anim[frame][joint];
+            QVERIFY(fabsf(glm::dot(poses[joint].rot(), expected.rot())) >= MIN_COS_HALF_ANGLE);
+            QCOMPARE_WITH_ABS_ERROR(poses[joint].trans(), expected.trans(), 2.0f * TRANSLATION_TOLERANCE);
+            QCOMPARE_WITH_ABS_ERROR(poses[joint].scale(), expected.scale(), 2.0f * SCALE_TOLERANCE);
+        }
+    }
+}
+
 void AnimTests::testExpressionTokenizer() {
     QString str = "(10 +  x) >= 20.1 && (y != !z)";
     AnimExpression e("x");
@@ -27,6 +27,9 @@ private slots:
     void testVariant();
     void testAccumulateTime();
     void testAnimPose();
+    void testBlend();
+    void benchmarkBlend();
+    void testCompressedClip();
     void testExpressionTokenizer();
     void testExpressionParser();
     void testExpressionEvaluator();
@@ -0,0 +1,120 @@
+//
+//  AudioMixerTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerTests.h"
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <AudioLimiter.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(AudioMixerTests)
+
+static const int FRAME_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+static const int HRTF_DATASET_INDEX = 1;
+
+// the nodes stand on a circle a few meters across
+static const float CIRCLE_RADIUS = 5.0f;
+
+namespace {
+
+struct Node {
+    float angle;
+    int16_t frame[FRAME_SAMPLES];
+};
+
+struct Listener {
+    std::vector<std::unique_ptr<AudioHRTF>> hrtfs;
+    std::unique_ptr<AudioLimiter> limiter;
+    float mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    int16_t outputSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+};
+
+}
+
+void AudioMixerTests::benchmarkMixFrame_data() {
+    QTest::addColumn<int>("numNodes");
+    QTest::addColumn<int>("numThreads");
+
+    for (int numNodes : { 16, 64, 128 }) {
+        for (int numThreads : { 1, 2, 4 }) {
+            QTest::newRow(qPrintable(QString("%1 nodes, %2 threads").arg(numNodes).arg(numThreads))) << numNodes << numThreads;
+        }
+    }
+}
+
+// Every listener renders everyone else through its HRTF and its limiter, as AudioMixerSlave::mix does when nothing is
+// throttled or culled. The listeners are split over the threads like the slaves split the nodes
+void AudioMixerTests::benchmarkMixFrame() {
+    QFETCH(int, numNodes);
+    QFETCH(int, numThreads);
+
+    // a tone per node, so that no two streams are the same
+    std::vector<Node> nodes(numNodes);
+    for (int i = 0; i < numNodes; i++) {
+        nodes[i].angle = TWO_PI * i / numNodes;
+        float frequency = 200.0f + 10.0f * i;
+        for (int j = 0; j < FRAME_SAMPLES; j++) {
+            nodes[i].frame[j] = (int16_t)(8192.0f * sinf(TWO_PI * frequency * j / AudioConstants::SAMPLE_RATE));
+        }
+    }
+
+    std::vector<Listener> listeners(numNodes);
+    for (auto& listener : listeners) {
+        for (int i = 0; i < numNodes; i++) {
+            listener.hrtfs.emplace_back(new AudioHRTF);
+        }
+        listener.limiter.reset(new AudioLimiter(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO));
+    }
+
+    auto mixListener = [&](int index) {
+        Listener& listener = listeners[index];
+        memset(listener.mixSamples, 0, sizeof(listener.mixSamples));
+        glm::vec2 position = CIRCLE_RADIUS * glm::vec2(cosf(nodes[index].angle), sinf(nodes[index].angle));
+        for (int source = 0; source < numNodes; source++) {
+            if (source == index) {
+                continue;
+            }
+            glm::vec2 sourcePosition = CIRCLE_RADIUS * glm::vec2(cosf(nodes[source].angle), sinf(nodes[source].angle));
+            glm::vec2 relative = sourcePosition - position;
+            float azimuth = atan2f(relative.y, relative.x);
+            float distance = glm::length(relative);
+            listener.hrtfs[source]->render(nodes[source].frame, listener.mixSamples, HRTF_DATASET_INDEX, azimuth, distance,
+                1.0f / distance, FRAME_SAMPLES);
+        }
+        listener.limiter->render(listener.mixSamples, listener.outputSamples, FRAME_SAMPLES);
+    };
+
+    std::vector<std::thread> threads(numThreads);
+    QBENCHMARK {
+        for (int t = 0; t < numThreads; t++) {
+            threads[t] = std::thread([&, t] {
+                for (int index = t; index < numNodes; index += numThreads) {
+                    mixListener(index);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // the mixes go out uncompressed here, the codecs are plugins
+    qInfo() << numNodes << "nodes," << numThreads << "threads:" << AudioConstants::NETWORK_FRAME_BYTES_STEREO
+        << "bytes out per listener," << (numNodes - 1) << "HRTF renders per listener";
+}
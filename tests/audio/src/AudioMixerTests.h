@@ -0,0 +1,24 @@
+//
+//  AudioMixerTests.h
+//  tests/audio/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerTests_h
+#define hifi_AudioMixerTests_h
+
+#include <QtTest/QtTest>
+
+// The frame of an audio mixer with synthetic nodes that all speak and listen, over a number of threads
+class AudioMixerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void benchmarkMixFrame_data();
+    void benchmarkMixFrame();
+};
+
+#endif // hifi_AudioMixerTests_h
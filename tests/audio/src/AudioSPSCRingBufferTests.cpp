@@ -0,0 +1,180 @@
+//
+//  AudioSPSCRingBufferTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSPSCRingBufferTests.h"
+
+#include <mutex>
+#include <thread>
+
+#include <AudioConstants.h>
+#include <AudioRingBuffer.h>
+#include <AudioSPSCRingBuffer.h>
+
+QTEST_MAIN(AudioSPSCRingBufferTests)
+
+// a network frame at a time, like the client's injector and playback paths
+static const int FRAME_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
+static const int CAPACITY_SAMPLES = 4 * FRAME_SAMPLES;
+static const int NUM_FRAMES = 2000;
+
+void AudioSPSCRingBufferTests::testWrapAround() {
+    int16_t writeData[200];
+    for (int i = 0; i < 200; i++) { writeData[i] = i; }
+    int16_t readData[200];
+
+    // not a power of two, so the storage is larger than the capacity
+    AudioSPSCRingBuffer<int16_t> ringBuffer(100);
+    QCOMPARE(ringBuffer.getSampleCapacity(), 100);
+
+    for (int T = 0; T < 300; T++) {
+        QCOMPARE(ringBuffer.writeSamples(writeData, 73), 73);
+        QCOMPARE(ringBuffer.samplesAvailable(), 73);
+
+        // writes are clipped to the free space rather than overwriting
+        QCOMPARE(ringBuffer.writeSamples(&writeData[73], 50), 27);
+        QCOMPARE(ringBuffer.spaceAvailable(), 0);
+
+        // reads are clipped to the samples available
+        QCOMPARE(ringBuffer.readSamples(readData, 150), 100);
+        QCOMPARE(ringBuffer.samplesAvailable(), 0);
+        for (int i = 0; i < 100; i++) {
+            QCOMPARE(readData[i], writeData[i]);
+        }
+    }
+}
+
+void AudioSPSCRingBufferTests::testAppend() {
+    float source[10] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    float destination[10] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+    AudioSPSCRingBuffer<float> ringBuffer(8);
+    QCOMPARE(ringBuffer.writeSamples(source, 6), 6);
+    QCOMPARE(ringBuffer.skipSamples(2), 2);
+    QCOMPARE(ringBuffer.writeSamples(source + 6, 4), 4);
+
+    QCOMPARE(ringBuffer.appendSamples(destination, 10), 8);
+    for (int i = 0; i < 8; i++) {
+        QCOMPARE(destination[i], source[i + 2] + 1.0f);
+    }
+    QCOMPARE(destination[8], 1.0f);
+
+    ringBuffer.reset();
+    QCOMPARE(ringBuffer.samplesAvailable(), 0);
+}
+
+void AudioSPSCRingBufferTests::testConcurrentOrdering() {
+    AudioSPSCRingBuffer<int16_t> ringBuffer(CAPACITY_SAMPLES);
+
+    std::thread producer([&] {
+        int16_t frame[FRAME_SAMPLES];
+        int next = 0;
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            for (int j = 0; j < FRAME_SAMPLES; j++) {
+                frame[j] = (int16_t)(next + j);
+            }
+            int written = 0;
+            while ((written += ringBuffer.writeSamples(frame + written, FRAME_SAMPLES - written)) < FRAME_SAMPLES) {
+                std::this_thread::yield();
+            }
+            next += FRAME_SAMPLES;
+        }
+    });
+
+    // read in odd-sized chunks so that reads and writes straddle the wrap differently
+    int16_t chunk[137];
+    int expected = 0;
+    bool isInOrder = true;
+    while (expected < NUM_FRAMES * FRAME_SAMPLES) {
+        int numRead = ringBuffer.readSamples(chunk, 137);
+        if (numRead == 0) {
+            std::this_thread::yield();
+        }
+        for (int i = 0; i < numRead; i++) {
+            isInOrder = isInOrder && chunk[i] == (int16_t)(expected + i);
+        }
+        expected += numRead;
+    }
+
+    producer.join();
+    QVERIFY(isInOrder);
+    QCOMPARE(ringBuffer.samplesAvailable(), 0);
+}
+
+// a frame at a time from one thread to another, as from the network thread to the output device callback
+void AudioSPSCRingBufferTests::benchmarkSPSC() {
+    AudioSPSCRingBuffer<float> ringBuffer(CAPACITY_SAMPLES);
+
+    QBENCHMARK {
+        std::thread producer([&] {
+            float frame[FRAME_SAMPLES] = {};
+            for (int i = 0; i < NUM_FRAMES; i++) {
+                int written = 0;
+                while ((written += ringBuffer.writeSamples(frame + written, FRAME_SAMPLES - written)) < FRAME_SAMPLES) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        float frame[FRAME_SAMPLES];
+        int numRead = 0;
+        while (numRead < NUM_FRAMES * FRAME_SAMPLES) {
+            int samples = ringBuffer.readSamples(frame, FRAME_SAMPLES);
+            if (samples == 0) {
+                std::this_thread::yield();
+            }
+            numRead += samples;
+        }
+
+        producer.join();
+    }
+}
+
+// the same traffic through an AudioMixRingBuffer guarded by a mutex, for comparison
+void AudioSPSCRingBufferTests::benchmarkLocked() {
+    AudioMixRingBuffer ringBuffer(FRAME_SAMPLES, CAPACITY_SAMPLES / FRAME_SAMPLES);
+    std::mutex mutex;
+
+    QBENCHMARK {
+        std::thread producer([&] {
+            float frame[FRAME_SAMPLES] = {};
+            for (int i = 0; i < NUM_FRAMES; i++) {
+                int written = 0;
+                while (written < FRAME_SAMPLES) {
+                    int samples;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        int space = ringBuffer.getSampleCapacity() - ringBuffer.samplesAvailable();
+                        samples = ringBuffer.writeSamples(frame + written, std::min(space, FRAME_SAMPLES - written));
+                    }
+                    if (samples == 0) {
+                        std::this_thread::yield();
+                    }
+                    written += samples;
+                }
+            }
+        });
+
+        float frame[FRAME_SAMPLES];
+        int numRead = 0;
+        while (numRead < NUM_FRAMES * FRAME_SAMPLES) {
+            int samples;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                samples = ringBuffer.readSamples(frame, FRAME_SAMPLES);
+            }
+            if (samples == 0) {
+                std::this_thread::yield();
+            }
+            numRead += samples;
+        }
+
+        producer.join();
+    }
+}
@@ -0,0 +1,130 @@
+//
+//  AvatarMixerTests.cpp
+//  tests/avatars/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarMixerTests.h"
+
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <AvatarData.h>
+#include <NLPacket.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(AvatarMixerTests)
+
+static const int NUM_JOINTS = 60;
+
+// the avatars stand on a circle a few meters across
+static const float CIRCLE_RADIUS = 5.0f;
+
+namespace {
+
+// what a viewer was last sent of one of the other avatars, which the next encoding is a delta against
+struct SentAvatar {
+    quint64 lastEncodeTime { 0 };
+    QVector<JointData> sentJoints;
+};
+
+}
+
+// every joint turns a little from one frame to the next, by a different amount for every avatar
+static QVector<JointData> animateJoints(int avatarIndex, int frame) {
+    QVector<JointData> joints(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        float angle = 0.01f * (frame + avatarIndex) * (1 + i % 7);
+        joints[i].rotation = glm::angleAxis(angle, glm::normalize(glm::vec3(1.0f, (float)(i % 3), (float)(i % 5))));
+        joints[i].rotationIsDefaultPose = false;
+        joints[i].translation = glm::vec3(0.0f, 0.1f, 0.0f);
+        joints[i].translationIsDefaultPose = i != 0;
+    }
+    return joints;
+}
+
+void AvatarMixerTests::benchmarkBroadcastFrame_data() {
+    QTest::addColumn<int>("numAvatars");
+    QTest::addColumn<int>("numThreads");
+
+    for (int numAvatars : { 16, 64, 128 }) {
+        for (int numThreads : { 1, 2, 4 }) {
+            QTest::newRow(qPrintable(QString("%1 avatars, %2 threads").arg(numAvatars).arg(numThreads))) << numAvatars << numThreads;
+        }
+    }
+}
+
+// Every viewer gets everyone else delta encoded against what it was last sent, in packets of the bulk avatar data size,
+// as AvatarMixerSlave::broadcastAvatarDataToAgent does when nothing is culled. The viewers are split over the threads like
+// the slaves split the nodes
+void AvatarMixerTests::benchmarkBroadcastFrame() {
+    QFETCH(int, numAvatars);
+    QFETCH(int, numThreads);
+
+    std::vector<std::unique_ptr<AvatarData>> avatars;
+    for (int i = 0; i < numAvatars; i++) {
+        avatars.emplace_back(new AvatarData);
+        float angle = TWO_PI * i / numAvatars;
+        avatars.back()->setSessionUUID(QUuid::createUuid());
+        avatars.back()->setWorldPosition(CIRCLE_RADIUS * glm::vec3(cosf(angle), 0.0f, sinf(angle)));
+    }
+    std::vector<std::vector<SentAvatar>> sentAvatars(numAvatars, std::vector<SentAvatar>(numAvatars));
+    std::vector<quint64> bytesSent(numAvatars, 0);
+    const int packetCapacity = NLPacket::maxPayloadSize(PacketType::BulkAvatarData);
+
+    auto broadcastToViewer = [&](int viewer, quint64 now) {
+        glm::vec3 viewerPosition = avatars[viewer]->getWorldPosition();
+        int spaceAvailable = packetCapacity;
+        for (int source = 0; source < numAvatars; source++) {
+            if (source == viewer) {
+                continue;
+            }
+            SentAvatar& sent = sentAvatars[viewer][source];
+            AvatarDataPacket::SendStatus sendStatus;
+            do {
+                QByteArray bytes = avatars[source]->toByteArray(AvatarData::CullSmallData, sent.lastEncodeTime,
+                    sent.sentJoints, sendStatus, false, true, viewerPosition, &sent.sentJoints, spaceAvailable);
+                spaceAvailable -= bytes.size();
+                bytesSent[viewer] += bytes.size();
+                if (!sendStatus || spaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                    spaceAvailable = packetCapacity;
+                }
+            } while (!sendStatus);
+            sent.lastEncodeTime = now;
+        }
+    };
+
+    std::vector<std::thread> threads(numThreads);
+    int numFrames = 0;
+    QBENCHMARK {
+        // the avatars move on the mixer's own thread, from the packets it received
+        for (int i = 0; i < numAvatars; i++) {
+            avatars[i]->setRawJointData(animateJoints(i, numFrames));
+        }
+        quint64 now = usecTimestampNow();
+        for (int t = 0; t < numThreads; t++) {
+            threads[t] = std::thread([&, t] {
+                for (int viewer = t; viewer < numAvatars; viewer += numThreads) {
+                    broadcastToViewer(viewer, now);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        numFrames++;
+    }
+
+    quint64 totalBytesSent = 0;
+    for (auto bytes : bytesSent) {
+        totalBytesSent += bytes;
+    }
+    qInfo() << numAvatars << "avatars," << numThreads << "threads:"
+        << (double)totalBytesSent / (numFrames * numAvatars) << "bytes out per viewer per frame";
+}
@@ -0,0 +1,24 @@
+//
+//  AvatarMixerTests.h
+//  tests/avatars/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarMixerTests_h
+#define hifi_AvatarMixerTests_h
+
+#include <QtTest/QtTest>
+
+// The frame of an avatar mixer with synthetic avatars that all move and all watch each other, over a number of threads
+class AvatarMixerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void benchmarkBroadcastFrame_data();
+    void benchmarkBroadcastFrame();
+};
+
+#endif // hifi_AvatarMixerTests_h
@@ -0,0 +1,118 @@
+//
+//  MeshSimplifierTest.cpp
+//  tests/baking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshSimplifierTest.h"
+
+#include <set>
+
+#include <glm/gtc/constants.hpp>
+
+#include <model-baker/MeshSimplifier.h>
+
+QTEST_MAIN(MeshSimplifierTest)
+
+// a grid of rings by segments quads, wrapped around into a torus or left open as a plane
+static void makeGrid(int rings, int segments, bool wrap, std::vector<glm::vec3>& positions, std::vector<int>& triangles) {
+    int columns = wrap ? segments : segments + 1;
+    int rows = wrap ? rings : rings + 1;
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < columns; j++) {
+            if (wrap) {
+                float u = glm::two_pi<float>() * i / rings;
+                float v = glm::two_pi<float>() * j / segments;
+                float radius = 1.0f + 0.3f * cosf(v);
+                positions.emplace_back(radius * cosf(u), 0.3f * sinf(v), radius * sinf(u));
+            } else {
+                positions.emplace_back((float)j / segments, 0.0f, (float)i / rings);
+            }
+        }
+    }
+    auto index = [&](int i, int j) { return (i % rows) * columns + (j % columns); };
+    for (int i = 0; i < rings; i++) {
+        for (int j = 0; j < segments; j++) {
+            triangles.insert(triangles.end(), { index(i, j), index(i + 1, j), index(i + 1, j + 1) });
+            triangles.insert(triangles.end(), { index(i, j), index(i + 1, j + 1), index(i, j + 1) });
+        }
+    }
+}
+
+static std::set<int> usedVertices(const std::vector<std::vector<int>>& partTriangles) {
+    std::set<int> used;
+    for (const auto& triangles : partTriangles) {
+        used.insert(triangles.begin(), triangles.end());
+    }
+    return used;
+}
+
+void MeshSimplifierTest::testClosedMesh() {
+    std::vector<glm::vec3> positions;
+    std::vector<int> triangles;
+    makeGrid(32, 64, true, positions, triangles);
+
+    baker::MeshSimplifier simplifier(positions, { triangles });
+    QCOMPARE(simplifier.getTriangleCount(), triangles.size() / 3);
+
+    size_t target = triangles.size() / 3;
+    for (int lod = 0; lod < 3; lod++) {
+        target /= 2;
+        simplifier.simplify(target, 1.0f);
+        QVERIFY(simplifier.getTriangleCount() <= target);
+
+        auto parts = simplifier.getPartTriangleIndices();
+        QCOMPARE(parts.size(), (size_t)1);
+        QCOMPARE(parts[0].size(), simplifier.getTriangleCount() * 3);
+        for (size_t i = 0; i < parts[0].size(); i += 3) {
+            int a = parts[0][i], b = parts[0][i + 1], c = parts[0][i + 2];
+            QVERIFY(a >= 0 && a < (int)positions.size());
+            QVERIFY(b >= 0 && b < (int)positions.size());
+            QVERIFY(c >= 0 && c < (int)positions.size());
+            QVERIFY(a != b && b != c && c != a);
+        }
+    }
+}
+
+void MeshSimplifierTest::testBorderIsKept() {
+    const int SIZE = 16;
+    std::vector<glm::vec3> positions;
+    std::vector<int> triangles;
+    makeGrid(SIZE, SIZE, false, positions, triangles);
+
+    // split in two parts, the vertices between them are on the border of both
+    std::vector<int> left(triangles.begin(), triangles.begin() + triangles.size() / 2);
+    std::vector<int> right(triangles.begin() + triangles.size() / 2, triangles.end());
+    baker::MeshSimplifier simplifier(positions, { left, right });
+    simplifier.simplify(0, 1.0f);
+    QVERIFY(simplifier.getTriangleCount() < triangles.size() / 3);
+
+    auto parts = simplifier.getPartTriangleIndices();
+    QCOMPARE(parts.size(), (size_t)2);
+    QVERIFY(!parts[0].empty() && !parts[1].empty());
+
+    auto used = usedVertices(parts);
+    for (int i = 0; i <= SIZE; i++) {
+        QVERIFY(used.count(i) > 0);
+        QVERIFY(used.count(SIZE * (SIZE + 1) + i) > 0);
+        QVERIFY(used.count(i * (SIZE + 1)) > 0);
+        QVERIFY(used.count(i * (SIZE + 1) + SIZE) > 0);
+        QVERIFY(used.count((SIZE / 2) * (SIZE + 1) + i) > 0);
+    }
+}
+
+void MeshSimplifierTest::testMaxError() {
+    std::vector<glm::vec3> positions;
+    std::vector<int> triangles;
+    makeGrid(32, 64, true, positions, triangles);
+
+    baker::MeshSimplifier strict(positions, { triangles });
+    strict.simplify(0, 0.0001f);
+    baker::MeshSimplifier loose(positions, { triangles });
+    loose.simplify(0, 1.0f);
+    QVERIFY(strict.getTriangleCount() > loose.getTriangleCount());
+}
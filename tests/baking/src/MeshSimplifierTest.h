@@ -0,0 +1,25 @@
+//
+//  MeshSimplifierTest.h
+//  tests/baking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MeshSimplifierTest_h
+#define hifi_MeshSimplifierTest_h
+
+#include <QtTest/QtTest>
+
+class MeshSimplifierTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testClosedMesh();
+    void testBorderIsKept();
+    void testMaxError();
+};
+
+#endif
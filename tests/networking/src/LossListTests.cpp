@@ -0,0 +1,132 @@
+//
+//  LossListTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LossListTests.h"
+
+#include <udt/ControlPacket.h>
+#include <udt/LossList.h>
+
+QTEST_MAIN(LossListTests)
+
+using namespace udt;
+
+void LossListTests::insertTest() {
+    LossList lossList;
+
+    lossList.append(SequenceNumber(10));
+    lossList.append(SequenceNumber(11));
+    lossList.append(SequenceNumber(20), SequenceNumber(25));
+    QCOMPARE(lossList.getLength(), 8);
+    QCOMPARE(lossList.getNumRanges(), 2);
+
+    // between the two ranges
+    lossList.insert(SequenceNumber(15), SequenceNumber(16));
+    QCOMPARE(lossList.getLength(), 10);
+    QCOMPARE(lossList.getNumRanges(), 3);
+
+    // touching the first, overlapping the second and third
+    lossList.insert(SequenceNumber(12), SequenceNumber(21));
+    QCOMPARE(lossList.getLength(), 16);
+    QCOMPARE(lossList.getNumRanges(), 1);
+
+    // before everything, already present
+    lossList.insert(SequenceNumber(5), SequenceNumber(5));
+    lossList.insert(SequenceNumber(10), SequenceNumber(25));
+    QCOMPARE(lossList.getLength(), 17);
+    QCOMPARE(lossList.getFirstSequenceNumber(), SequenceNumber(5));
+}
+
+void LossListTests::removeTest() {
+    LossList lossList;
+    lossList.append(SequenceNumber(10), SequenceNumber(30));
+
+    // middle of a range splits it
+    QVERIFY(lossList.remove(SequenceNumber(20)));
+    QVERIFY(!lossList.remove(SequenceNumber(20)));
+    QCOMPARE(lossList.getNumRanges(), 2);
+    QCOMPARE(lossList.getLength(), 20);
+
+    // start and end of a range
+    QVERIFY(lossList.remove(SequenceNumber(10)));
+    QVERIFY(lossList.remove(SequenceNumber(30)));
+    QCOMPARE(lossList.getFirstSequenceNumber(), SequenceNumber(11));
+    QCOMPARE(lossList.getLength(), 18);
+
+    // a range removal across both ranges
+    lossList.remove(SequenceNumber(15), SequenceNumber(25));
+    QCOMPARE(lossList.getNumRanges(), 2);
+    QCOMPARE(lossList.getLength(), 8);
+
+    // a range removal inside one range
+    lossList.remove(SequenceNumber(12), SequenceNumber(13));
+    QCOMPARE(lossList.getNumRanges(), 3);
+    QCOMPARE(lossList.getLength(), 6);
+
+    QCOMPARE(lossList.popFirstSequenceNumber(), SequenceNumber(11));
+    QCOMPARE(lossList.popFirstSequenceNumber(), SequenceNumber(14));
+    QCOMPARE(lossList.popFirstSequenceNumber(), SequenceNumber(26));
+
+    lossList.remove(SequenceNumber(0), SequenceNumber(100));
+    QVERIFY(lossList.isEmpty());
+    QCOMPARE(lossList.getNumRanges(), 0);
+}
+
+void LossListTests::wrapTest() {
+    LossList lossList;
+
+    SequenceNumber nearMax(SequenceNumber::MAX - 2);
+    lossList.append(nearMax, nearMax + 5);
+    QCOMPARE(lossList.getLength(), 6);
+    QCOMPARE(lossList.getFirstSequenceNumber(), nearMax);
+
+    QVERIFY(lossList.remove(SequenceNumber(0)));
+    QCOMPARE(lossList.getNumRanges(), 2);
+
+    lossList.insert(SequenceNumber(0), SequenceNumber(0));
+    QCOMPARE(lossList.getNumRanges(), 1);
+
+    lossList.remove(nearMax, SequenceNumber(1));
+    QCOMPARE(lossList.getLength(), 1);
+    QCOMPARE(lossList.getFirstSequenceNumber(), SequenceNumber(2));
+}
+
+void LossListTests::writeReadTest() {
+    static const int NUM_RANGES = 500;
+
+    LossList lossList;
+    for (int i = 0; i < NUM_RANGES; ++i) {
+        lossList.append(SequenceNumber(1000 + i * 3), SequenceNumber(1000 + i * 3 + (i % 2)));
+    }
+
+    auto packet = ControlPacket::create(ControlPacket::ACK);
+    int numWritten = lossList.write(*packet);
+
+    // more short ranges fit than raw sequence number pairs would
+    QVERIFY(numWritten > ControlPacket::maxPayloadSize() / (int)(2 * sizeof(SequenceNumber)));
+    QVERIFY(packet->getPayloadSize() <= ControlPacket::maxPayloadSize());
+
+    packet->seek(0);
+
+    LossList readList;
+    QVERIFY(readList.read(*packet));
+    QCOMPARE(readList.getNumRanges(), numWritten);
+
+    for (int i = 0; i < numWritten; ++i) {
+        QCOMPARE(readList.popFirstSequenceNumber(), SequenceNumber(1000 + i * 3));
+        if (i % 2) {
+            QCOMPARE(readList.popFirstSequenceNumber(), SequenceNumber(1000 + i * 3 + 1));
+        }
+    }
+    QVERIFY(readList.isEmpty());
+
+    // limited number of ranges
+    auto limitedPacket = ControlPacket::create(ControlPacket::ACK);
+    QCOMPARE(lossList.write(*limitedPacket, 10), 10);
+}
@@ -0,0 +1,32 @@
+//
+//  LossListTests.h
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LossListTests_h
+#define hifi_LossListTests_h
+
+#include <QtTest/QtTest>
+
+class LossListTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test appends and inserts merge touching and overlapping ranges
+    void insertTest();
+
+    // Test single and range removals split ranges
+    void removeTest();
+
+    // Test ranges straddling the sequence number wrap
+    void wrapTest();
+
+    // Test the compact multi-range encoding round trips and respects the packet capacity
+    void writeReadTest();
+};
+
+#endif // hifi_LossListTests_h
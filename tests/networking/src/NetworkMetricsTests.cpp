@@ -0,0 +1,57 @@
+//
+//  NetworkMetricsTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NetworkMetricsTests.h"
+
+#include <udt/NetworkMetrics.h>
+
+QTEST_MAIN(NetworkMetricsTests)
+
+using namespace udt;
+
+void NetworkMetricsTests::packetTypeTest() {
+    auto& metrics = NetworkMetrics::getInstance();
+
+    metrics.recordSentPacket(PacketType::Ping, 100);
+    metrics.recordSentPacket(PacketType::Ping, 50);
+    metrics.recordReceivedPacket(PacketType::PingReply, 75);
+
+    auto output = metrics.toOpenMetrics();
+
+    QVERIFY(output.contains("hifi_packets_sent_total{type=\"Ping\"} 2\n"));
+    QVERIFY(output.contains("hifi_packet_bytes_sent_total{type=\"Ping\"} 150\n"));
+    QVERIFY(output.contains("hifi_packets_received_total{type=\"PingReply\"} 1\n"));
+    QVERIFY(!output.contains("hifi_packets_received_total{type=\"Ping\"}"));
+    QVERIFY(output.endsWith("# EOF\n"));
+}
+
+void NetworkMetricsTests::connectionTest() {
+    auto& metrics = NetworkMetrics::getInstance();
+
+    HifiSockAddr destination(QHostAddress::LocalHost, 40102);
+    auto connection = metrics.addConnection(destination);
+    connection->rtt = 1500;
+    connection->retransmittedPackets += 3;
+
+    auto output = metrics.toOpenMetrics();
+    QByteArray peer = "{peer=\"" + destination.toString().toUtf8() + "\"}";
+
+    QVERIFY(output.contains("hifi_udt_connections 1\n"));
+    QVERIFY(output.contains("hifi_udt_connection_rtt_microseconds" + peer + " 1500\n"));
+    QVERIFY(output.contains("hifi_udt_connection_retransmitted_packets_total" + peer + " 3\n"));
+    QVERIFY(output.contains("hifi_udt_retransmitted_packets_total 3\n"));
+
+    metrics.removeConnection(connection);
+
+    output = metrics.toOpenMetrics();
+    QVERIFY(output.contains("hifi_udt_connections 0\n"));
+    QVERIFY(!output.contains(peer));
+    QVERIFY(output.contains("hifi_udt_retransmitted_packets_total 3\n"));
+}
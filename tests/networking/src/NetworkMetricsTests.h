@@ -0,0 +1,26 @@
+//
+//  NetworkMetricsTests.h
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NetworkMetricsTests_h
+#define hifi_NetworkMetricsTests_h
+
+#include <QtTest/QtTest>
+
+class NetworkMetricsTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test per packet type counters show up in the scrape
+    void packetTypeTest();
+
+    // Test connection counters survive the connection in the process totals
+    void connectionTest();
+};
+
+#endif // hifi_NetworkMetricsTests_h
@@ -0,0 +1,50 @@
+//
+//  PacketDispatchProfilerTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketDispatchProfilerTests.h"
+
+#include <PacketDispatchProfiler.h>
+
+QTEST_MAIN(PacketDispatchProfilerTests)
+
+void PacketDispatchProfilerTests::histogramTest() {
+    auto& profiler = PacketDispatchProfiler::getInstance();
+    profiler.reset();
+
+    profiler.recordDispatch(PacketType::AvatarData, 0, 1);
+    profiler.recordDispatch(PacketType::AvatarData, 3, 5);
+    profiler.recordDispatch(PacketType::AvatarData, 3, 1000);
+
+    auto json = profiler.toJson();
+    QCOMPARE(json.size(), 1);
+
+    auto avatarData = json["AvatarData"].toObject();
+    QCOMPARE(avatarData["count"].toInt(), 3);
+
+    // 0 is below 1, 3 is below 4
+    auto wait = avatarData["wait_usecs"].toObject();
+    auto waitBuckets = wait["log2_buckets"].toArray();
+    QCOMPARE(waitBuckets.size(), 3);
+    QCOMPARE(waitBuckets[0].toInt(), 1);
+    QCOMPARE(waitBuckets[1].toInt(), 0);
+    QCOMPARE(waitBuckets[2].toInt(), 2);
+    QCOMPARE(wait["max"].toInt(), 3);
+    QCOMPARE(wait["avg"].toDouble(), 2.0);
+
+    // 1 is below 2, 5 is below 8, 1000 is below 1024
+    auto dispatchBuckets = avatarData["dispatch_usecs"].toObject()["log2_buckets"].toArray();
+    QCOMPARE(dispatchBuckets.size(), 11);
+    QCOMPARE(dispatchBuckets[1].toInt(), 1);
+    QCOMPARE(dispatchBuckets[3].toInt(), 1);
+    QCOMPARE(dispatchBuckets[10].toInt(), 1);
+
+    profiler.reset();
+    QVERIFY(profiler.toJson().isEmpty());
+}
@@ -0,0 +1,23 @@
+//
+//  PacketDispatchProfilerTests.h
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketDispatchProfilerTests_h
+#define hifi_PacketDispatchProfilerTests_h
+
+#include <QtTest/QtTest>
+
+class PacketDispatchProfilerTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test samples land in the right log2 buckets with the right summary
+    void histogramTest();
+};
+
+#endif // hifi_PacketDispatchProfilerTests_h
@@ -180,3 +180,40 @@ void PacketTests::primitiveTest() {
     QCOMPARE(recvPacket->peekPrimitive(&noValue), 0);
     QCOMPARE(recvPacket->readPrimitive(&noValue), 0);
 }
+
+void PacketTests::packetBufferPoolTest() {
+    using namespace udt;
+
+    // pooled buffers come back zeroed when asked
+    {
+        auto buffer = PacketBufferPool::allocate(PacketBufferPool::BUFFER_SIZE);
+        memset(buffer.get(), 0xFF, PacketBufferPool::BUFFER_SIZE);
+    }
+    {
+        auto buffer = PacketBufferPool::allocate(PacketBufferPool::BUFFER_SIZE, true);
+        for (int i = 0; i < PacketBufferPool::BUFFER_SIZE; ++i) {
+            QCOMPARE(buffer[i], (char)0);
+        }
+    }
+
+    // a released buffer is handed out again instead of allocating
+    auto pooledBefore = PacketBufferPool::getNumPooledBuffers();
+    {
+        auto packet = NLPacket::create(PacketType::Unknown);
+    }
+    QCOMPARE(PacketBufferPool::getNumPooledBuffers(), pooledBefore);
+
+    auto hitsBefore = PacketBufferPool::getNumPoolHits();
+    {
+        auto packet = NLPacket::create(PacketType::Unknown);
+        QCOMPARE(PacketBufferPool::getNumPoolHits(), hitsBefore + 1);
+        QCOMPARE(PacketBufferPool::getNumPooledBuffers(), pooledBefore - 1);
+    }
+
+    // oversized requests are never pooled
+    {
+        auto buffer = PacketBufferPool::allocate(PacketBufferPool::BUFFER_SIZE + 1);
+        QVERIFY(!buffer.get_deleter().isPooled);
+    }
+    QCOMPARE(PacketBufferPool::getNumPooledBuffers(), pooledBefore);
+}
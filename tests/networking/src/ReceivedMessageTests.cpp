@@ -0,0 +1,117 @@
+//
+//  ReceivedMessageTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReceivedMessageTests.h"
+
+#include <test-utils/QTestExtensions.h>
+
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+
+QTEST_MAIN(ReceivedMessageTests)
+
+static const int NUM_TEST_PACKETS = 4;
+static const int TEST_PAYLOAD_SIZE = 100;
+
+static std::unique_ptr<NLPacket> createReceivedPart(int partNumber) {
+    auto packet = NLPacket::create(PacketType::Unknown, -1, true, true);
+
+    QByteArray payload(TEST_PAYLOAD_SIZE, 0);
+    for (int i = 0; i < TEST_PAYLOAD_SIZE; ++i) {
+        payload[i] = (char)(partNumber * TEST_PAYLOAD_SIZE + i);
+    }
+    packet->write(payload);
+
+    auto position = partNumber == 0 ? udt::Packet::FIRST
+        : (partNumber == NUM_TEST_PACKETS - 1 ? udt::Packet::LAST : udt::Packet::MIDDLE);
+    packet->writeMessageNumber(1, position, partNumber);
+
+    // pretend it came in off the wire
+    auto size = packet->getDataSize();
+    auto buffer = udt::PacketBufferPool::allocate(size);
+    memcpy(buffer.get(), packet->getData(), size);
+    return NLPacket::fromReceivedPacket(std::move(buffer), size, HifiSockAddr());
+}
+
+static QSharedPointer<ReceivedMessage> createSegmentedMessage() {
+    auto first = createReceivedPart(0);
+    auto message = QSharedPointer<ReceivedMessage>::create(*first);
+    for (int i = 1; i < NUM_TEST_PACKETS; ++i) {
+        message->appendPacket(createReceivedPart(i));
+    }
+    return message;
+}
+
+static char expectedByte(int position) {
+    return (char)position;
+}
+
+void ReceivedMessageTests::segmentedReadTest() {
+    auto message = createSegmentedMessage();
+
+    QVERIFY(message->isComplete());
+    QVERIFY(message->isSegmented());
+    QCOMPARE(message->getSize(), (qint64)(NUM_TEST_PACKETS * TEST_PAYLOAD_SIZE));
+    QCOMPARE(message->getNumPackets(), (qint64)NUM_TEST_PACKETS);
+
+    // read a primitive straddling the first packet boundary
+    message->seek(TEST_PAYLOAD_SIZE - 2);
+    uint32_t straddling;
+    QCOMPARE(message->readPrimitive(&straddling), (qint64)sizeof(straddling));
+    const char* straddlingBytes = reinterpret_cast<const char*>(&straddling);
+    for (int i = 0; i < (int)sizeof(straddling); ++i) {
+        QCOMPARE(straddlingBytes[i], expectedByte(TEST_PAYLOAD_SIZE - 2 + i));
+    }
+
+    message->seek(0);
+    auto all = message->readAll();
+    QCOMPARE(all.size(), NUM_TEST_PACKETS * TEST_PAYLOAD_SIZE);
+    for (int i = 0; i < all.size(); ++i) {
+        QCOMPARE(all[i], expectedByte(i));
+    }
+    QCOMPARE(message->getBytesLeftToRead(), (qint64)0);
+
+    // reading past the end is short
+    char overflow[16];
+    QCOMPARE(message->read(overflow, sizeof(overflow)), (qint64)0);
+
+    // still chained, nothing asked for contiguous data
+    QVERIFY(message->isSegmented());
+}
+
+void ReceivedMessageTests::coalesceTest() {
+    auto message = createSegmentedMessage();
+
+    const char* raw = message->getRawMessage();
+    QVERIFY(!message->isSegmented());
+    for (int i = 0; i < NUM_TEST_PACKETS * TEST_PAYLOAD_SIZE; ++i) {
+        QCOMPARE(raw[i], expectedByte(i));
+    }
+    QCOMPARE(message->getMessage().size(), NUM_TEST_PACKETS * TEST_PAYLOAD_SIZE);
+}
+
+void ReceivedMessageTests::readWithoutCopyTest() {
+    auto message = createSegmentedMessage();
+
+    // entirely inside the second packet - no coalesce needed
+    message->seek(TEST_PAYLOAD_SIZE + 10);
+    auto inside = message->readWithoutCopy(20);
+    QVERIFY(message->isSegmented());
+    QCOMPARE(inside.size(), 20);
+    QCOMPARE(inside[0], expectedByte(TEST_PAYLOAD_SIZE + 10));
+
+    // across the second and third packet
+    message->seek(2 * TEST_PAYLOAD_SIZE - 5);
+    auto across = message->readWithoutCopy(10);
+    QVERIFY(!message->isSegmented());
+    for (int i = 0; i < across.size(); ++i) {
+        QCOMPARE(across[i], expectedByte(2 * TEST_PAYLOAD_SIZE - 5 + i));
+    }
+}
@@ -0,0 +1,29 @@
+//
+//  ReceivedMessageTests.h
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReceivedMessageTests_h
+#define hifi_ReceivedMessageTests_h
+
+#include <QtTest/QtTest>
+
+class ReceivedMessageTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test reads across the packets of a multi-packet message
+    void segmentedReadTest();
+
+    // Test contiguous access coalesces a segmented message
+    void coalesceTest();
+
+    // Test readWithoutCopy inside and across packet boundaries
+    void readWithoutCopyTest();
+};
+
+#endif // hifi_ReceivedMessageTests_h
@@ -93,3 +93,39 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+void ResourceTests::pendingRequestPriorities() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto requestLimit = sharedItems->getRequestLimit();
+
+    // queue everything up without starting any of it
+    sharedItems->setRequestLimit(0);
+
+    QObject owner;
+    auto createResource = [&](const QString& url, float priority) {
+        auto pendingResource = QSharedPointer<Resource>::create(QUrl(url));
+        pendingResource->setSelf(pendingResource);
+        pendingResource->setLoadPriority(&owner, priority);
+        sharedItems->appendRequest(pendingResource);
+        return pendingResource;
+    };
+    auto low = createResource("http://example.com/low.fbx", 1.0f);
+    auto high = createResource("atp:/high.fbx", 3.0f);
+    auto middle = createResource("http://example.com/middle.fbx", 2.0f);
+    auto file = createResource("file:///local.fbx", 0.0f);
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)4);
+
+    // the request that moves up overtakes the others without being queued twice
+    low->setLoadPriority(&owner, 4.0f);
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)4);
+
+    QVERIFY(!sharedItems->getHighestPendingRequest());
+    sharedItems->setRequestLimit(requestLimit);
+
+    QCOMPARE(sharedItems->getHighestPendingRequest(), file);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), low);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), high);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), middle);
+    QVERIFY(!sharedItems->getHighestPendingRequest());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)0);
+}
@@ -18,6 +18,7 @@ private slots:
     void initTestCase();
     void downloadFirst();
     void downloadAgain();
+    void pendingRequestPriorities();
     void cleanupTestCase();
 };
 
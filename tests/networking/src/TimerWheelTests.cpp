@@ -0,0 +1,96 @@
+//
+//  TimerWheelTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <random>
+
+#include <udt/TimerWheel.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+using namespace udt;
+
+void TimerWheelTests::expiryTest() {
+    static const int NUM_TIMERS = 1000;
+    static const TimerWheel::Tick START_TICK = 12345;
+
+    TimerWheel wheel(START_TICK);
+    std::vector<TimerWheel::Timer> timers(NUM_TIMERS);
+
+    // spread the expiries over all three levels
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<TimerWheel::Tick> distribution(1, TimerWheel::MAX_SPAN_TICKS - 1);
+    for (auto& timer : timers) {
+        QVERIFY(wheel.schedule(&timer, START_TICK + distribution(generator)));
+    }
+    QCOMPARE(wheel.getNumTimers(), NUM_TIMERS);
+
+    // an expiry that isn't in the future is due now
+    TimerWheel::Timer dueTimer;
+    QVERIFY(!wheel.schedule(&dueTimer, START_TICK));
+    QVERIFY(!dueTimer.isScheduled());
+
+    int numExpired = 0;
+    bool expiredOnTick = true;
+    while (!wheel.isEmpty()) {
+        auto nextTick = wheel.getNextEventTick();
+        QVERIFY(nextTick > wheel.getCurrentTick());
+
+        wheel.advance(nextTick, [&](TimerWheel::Timer* timer) {
+            expiredOnTick = expiredOnTick && timer->getExpiry() == wheel.getCurrentTick() && !timer->isScheduled();
+            ++numExpired;
+        });
+    }
+
+    QVERIFY(expiredOnTick);
+    QCOMPARE(numExpired, NUM_TIMERS);
+}
+
+void TimerWheelTests::cancelTest() {
+    TimerWheel wheel;
+    TimerWheel::Timer first;
+    TimerWheel::Timer second;
+
+    QVERIFY(wheel.schedule(&first, 10));
+    QVERIFY(wheel.schedule(&second, 5000));
+
+    wheel.cancel(&first);
+    QVERIFY(!first.isScheduled());
+    QCOMPARE(wheel.getNumTimers(), 1);
+
+    // rescheduling moves the timer
+    QVERIFY(wheel.schedule(&second, 20));
+    QCOMPARE(wheel.getNumTimers(), 1);
+
+    std::vector<TimerWheel::Timer*> expired;
+    wheel.advance(10000, [&](TimerWheel::Timer* timer) {
+        expired.push_back(timer);
+        QCOMPARE(wheel.getCurrentTick(), (TimerWheel::Tick)20);
+    });
+
+    QCOMPARE((int)expired.size(), 1);
+    QCOMPARE(expired[0], &second);
+    QCOMPARE(wheel.getCurrentTick(), (TimerWheel::Tick)10000);
+}
+
+void TimerWheelTests::clampTest() {
+    TimerWheel wheel;
+    TimerWheel::Timer timer;
+
+    QVERIFY(wheel.schedule(&timer, 4 * TimerWheel::MAX_SPAN_TICKS));
+    QCOMPARE(timer.getExpiry(), TimerWheel::MAX_SPAN_TICKS - 1);
+
+    TimerWheel::Tick expiredAt = 0;
+    wheel.advance(4 * TimerWheel::MAX_SPAN_TICKS, [&](TimerWheel::Timer* expired) {
+        expiredAt = wheel.getCurrentTick();
+    });
+    QCOMPARE(expiredAt, TimerWheel::MAX_SPAN_TICKS - 1);
+}
@@ -0,0 +1,29 @@
+//
+//  TimerWheelTests.h
+//  tests/networking/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimerWheelTests_h
+#define hifi_TimerWheelTests_h
+
+#include <QtTest/QtTest>
+
+class TimerWheelTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test timers expire on their tick, on every level of the wheel
+    void expiryTest();
+
+    // Test cancelled and rescheduled timers
+    void cancelTest();
+
+    // Test expiries past the span of the wheel are clamped
+    void clampTest();
+};
+
+#endif // hifi_TimerWheelTests_h
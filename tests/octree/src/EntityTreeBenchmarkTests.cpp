@@ -0,0 +1,266 @@
+//
+//  EntityTreeBenchmarkTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeBenchmarkTests.h"
+
+#include <random>
+
+#include <QtCore/QJsonDocument>
+
+#include <DiffTraversal.h>
+#include <EntityItemProperties.h>
+#include <EntityPriorityQueue.h>
+#include <GLMHelpers.h>
+#include <Node.h>
+#include <OctreeBinaryFile.h>
+#include <ReceivedMessage.h>
+#include <SharedUtil.h>
+#include <SimpleEntitySimulation.h>
+#include <ViewFrustum.h>
+
+QTEST_MAIN(EntityTreeBenchmarkTests)
+
+static const int NUM_ENTITIES = 100000;
+static const int NUM_EDITS = 20000;
+static const int NUM_QUERIES = 10000;
+static const int NUM_VIEWERS = 32;
+
+// the entities are spread over a cube this wide around the origin
+static const float CONTENT_SCALE = 1000.0f;
+static const float QUERY_RADIUS = 10.0f;
+
+static std::mt19937 randomEngine(42);
+
+static glm::vec3 randomPosition() {
+    std::uniform_real_distribution<float> distribution(-0.5f * CONTENT_SCALE, 0.5f * CONTENT_SCALE);
+    return glm::vec3(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine));
+}
+
+static glm::vec3 randomDirection() {
+    std::normal_distribution<float> distribution;
+    return glm::normalize(glm::vec3(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine)));
+}
+
+static EntityTreePointer createServerTree() {
+    EntityTreePointer tree = EntityTreePointer(new EntityTree(true));
+    tree->createRootElement();
+    tree->setIsServer(true);
+    SimpleEntitySimulationPointer simulation { new SimpleEntitySimulation() };
+    simulation->setEntityTree(tree);
+    tree->setSimulation(simulation);
+    return tree;
+}
+
+static PickFilter anyEntityFilter() {
+    return PickFilter(PickFilter::getBitMask(PickFilter::DOMAIN_ENTITIES) | PickFilter::getBitMask(PickFilter::VISIBLE) |
+        PickFilter::getBitMask(PickFilter::INVISIBLE) | PickFilter::getBitMask(PickFilter::COLLIDABLE) |
+        PickFilter::getBitMask(PickFilter::NONCOLLIDABLE) | PickFilter::getBitMask(PickFilter::COARSE));
+}
+
+void EntityTreeBenchmarkTests::addResult(const QString& name, double value) {
+    qInfo() << qPrintable(name) << value;
+    _results[name] = value;
+}
+
+void EntityTreeBenchmarkTests::initTestCase() {
+    QVERIFY(_persistDir.isValid());
+
+    _tree = createServerTree();
+    quint64 start = usecTimestampNow();
+    _tree->withWriteLock([&] {
+        for (int i = 0; i < NUM_ENTITIES; i++) {
+            EntityItemProperties properties;
+            properties.setType(EntityTypes::Box);
+            properties.setPosition(randomPosition());
+            properties.setDimensions(glm::vec3(1.0f));
+            _tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+        }
+    });
+    addResult("add_entities_per_second", NUM_ENTITIES / ((usecTimestampNow() - start) / (double)USECS_PER_SECOND));
+}
+
+// the content is loaded back into a fresh tree the way OctreePersistThread loads it on startup
+void EntityTreeBenchmarkTests::persistAndLoad(const QString& fileType) {
+    // a base name per type, since readFromFile loads the most recent of the files with the same base name
+    QString filename = _persistDir.filePath(fileType.section('.', 0, 0) + "-models." + fileType);
+
+    quint64 start = usecTimestampNow();
+    QVERIFY(_tree->writeToFile(filename.toLocal8Bit().constData(), nullptr, fileType));
+    addResult("persist_" + fileType + "_msecs", (usecTimestampNow() - start) / (double)USECS_PER_MSEC);
+    addResult("persist_" + fileType + "_bytes", (double)QFileInfo(filename).size());
+
+    EntityTreePointer loadedTree = createServerTree();
+    start = usecTimestampNow();
+    QVERIFY(loadedTree->readFromFile(filename.toLocal8Bit().constData()));
+    addResult("load_" + fileType + "_msecs", (usecTimestampNow() - start) / (double)USECS_PER_MSEC);
+
+    int numLoaded = 0;
+    loadedTree->withReadLock([&] {
+        loadedTree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+            std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](const EntityItemPointer& entity) {
+                numLoaded++;
+            });
+            return true;
+        }, nullptr);
+    });
+    QCOMPARE(numLoaded, NUM_ENTITIES);
+}
+
+void EntityTreeBenchmarkTests::persistAndLoadJSON() {
+    persistAndLoad("json.gz");
+}
+
+void EntityTreeBenchmarkTests::persistAndLoadBinary() {
+    persistAndLoad(OctreeBinaryFile::FILE_TYPE);
+}
+
+// edits of the positions of random entities, decoded from edit packets as they come from the clients
+void EntityTreeBenchmarkTests::editThroughput() {
+    QVector<EntityItemID> entityIDs;
+    _tree->withReadLock([&] {
+        _tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+            std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](const EntityItemPointer& entity) {
+                entityIDs.push_back(entity->getEntityItemID());
+            });
+            return true;
+        }, nullptr);
+    });
+    QCOMPARE(entityIDs.size(), NUM_ENTITIES);
+
+    std::vector<QByteArray> editPackets;
+    std::uniform_int_distribution<int> entityDistribution(0, NUM_ENTITIES - 1);
+    for (int i = 0; i < NUM_EDITS; i++) {
+        EntityItemProperties properties;
+        properties.setPosition(randomPosition());
+        properties.setLastEdited(usecTimestampNow());
+        QByteArray buffer(NLPacket::maxPayloadSize(PacketType::EntityEdit), 0);
+        EntityPropertyFlags didntFitProperties;
+        auto appendState = EntityItemProperties::encodeEntityEditPacket(PacketType::EntityEdit,
+            entityIDs[entityDistribution(randomEngine)], properties, buffer, properties.getChangedProperties(),
+            didntFitProperties);
+        QCOMPARE(appendState, OctreeElement::COMPLETED);
+        editPackets.push_back(buffer);
+    }
+
+    SharedNodePointer senderNode(new Node(QUuid::createUuid(), NodeType::Agent, HifiSockAddr(), HifiSockAddr()));
+    NodePermissions permissions;
+    permissions.setAll(true);
+    senderNode->setPermissions(permissions);
+
+    int numProcessed = 0;
+    quint64 start = usecTimestampNow();
+    for (const auto& editPacket : editPackets) {
+        ReceivedMessage message(editPacket, PacketType::EntityEdit, versionForPacketType(PacketType::EntityEdit), HifiSockAddr());
+        int processedBytes = _tree->processEditPacketData(message, reinterpret_cast<const unsigned char*>(editPacket.constData()),
+            editPacket.size(), senderNode);
+        numProcessed += processedBytes > 0 ? 1 : 0;
+    }
+    addResult("edits_per_second", NUM_EDITS / ((usecTimestampNow() - start) / (double)USECS_PER_SECOND));
+    QCOMPARE(numProcessed, NUM_EDITS);
+}
+
+void EntityTreeBenchmarkTests::rayQueryThroughput() {
+    std::vector<std::pair<glm::vec3, glm::vec3>> rays;
+    for (int i = 0; i < NUM_QUERIES; i++) {
+        rays.emplace_back(randomPosition(), randomDirection());
+    }
+
+    PickFilter filter = anyEntityFilter();
+    int numHits = 0;
+    quint64 start = usecTimestampNow();
+    for (const auto& ray : rays) {
+        OctreeElementPointer element;
+        float distance;
+        BoxFace face;
+        glm::vec3 surfaceNormal;
+        QVariantMap extraInfo;
+        EntityItemID entityID = _tree->evalRayIntersection(ray.first, ray.second, QVector<EntityItemID>(),
+            QVector<EntityItemID>(), filter, element, distance, face, surfaceNormal, extraInfo, Octree::Lock);
+        numHits += entityID.isNull() ? 0 : 1;
+    }
+    addResult("ray_queries_per_second", NUM_QUERIES / ((usecTimestampNow() - start) / (double)USECS_PER_SECOND));
+    qInfo() << numHits << "of" << NUM_QUERIES << "rays hit an entity";
+}
+
+void EntityTreeBenchmarkTests::sphereQueryThroughput() {
+    std::vector<glm::vec3> centers;
+    for (int i = 0; i < NUM_QUERIES; i++) {
+        centers.push_back(randomPosition());
+    }
+
+    PickFilter filter = anyEntityFilter();
+    int numFound = 0;
+    quint64 start = usecTimestampNow();
+    for (const auto& center : centers) {
+        QVector<QUuid> foundEntities;
+        _tree->withReadLock([&] {
+            _tree->evalEntitiesInSphere(center, QUERY_RADIUS, filter, foundEntities);
+        });
+        numFound += foundEntities.size();
+    }
+    addResult("sphere_queries_per_second", NUM_QUERIES / ((usecTimestampNow() - start) / (double)USECS_PER_SECOND));
+    qInfo() << numFound << "entities found by" << NUM_QUERIES << "sphere queries";
+}
+
+// the first traversal of every viewer, as when it connects, each from a random spot looking a random way
+void EntityTreeBenchmarkTests::viewerTraversals() {
+    EntityTreeElementPointer root = _tree->getRoot();
+    quint64 totalTime = 0;
+    quint64 maxTime = 0;
+    int numEntitiesInView = 0;
+
+    for (int i = 0; i < NUM_VIEWERS; i++) {
+        ViewFrustum viewFrustum;
+        viewFrustum.setPosition(randomPosition());
+        viewFrustum.setOrientation(rotationBetween(glm::vec3(0.0f, 0.0f, -1.0f), randomDirection()));
+        viewFrustum.setProjection(DEFAULT_FIELD_OF_VIEW_DEGREES, DEFAULT_ASPECT_RATIO, DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP);
+        viewFrustum.calculate();
+
+        DiffTraversal::View view;
+        view.viewFrustums.push_back(ConicalViewFrustum(viewFrustum));
+        view.startTime = usecTimestampNow();
+
+        DiffTraversal traversal;
+        quint64 start = usecTimestampNow();
+        _tree->withReadLock([&] {
+            traversal.prepareNewTraversal(view, root, true);
+            traversal.setScanCallback([&](DiffTraversal::VisibleElement& next) {
+                next.element->forEachEntity([&](const EntityItemPointer& entity) {
+                    if (traversal.getCurrentView().computePriority(entity) != PrioritizedEntity::DO_NOT_SEND) {
+                        numEntitiesInView++;
+                    }
+                });
+            });
+            while (!traversal.finished()) {
+                traversal.traverse(USECS_PER_SECOND);
+            }
+        });
+        quint64 elapsed = usecTimestampNow() - start;
+        totalTime += elapsed;
+        maxTime = std::max(maxTime, elapsed);
+    }
+
+    addResult("traversal_msecs_per_viewer", totalTime / (double)NUM_VIEWERS / USECS_PER_MSEC);
+    addResult("max_traversal_msecs", maxTime / (double)USECS_PER_MSEC);
+    addResult("entities_in_view_per_viewer", numEntitiesInView / (double)NUM_VIEWERS);
+}
+
+void EntityTreeBenchmarkTests::cleanupTestCase() {
+    QString outputPath = QProcessEnvironment::systemEnvironment().value("HIFI_BENCHMARK_OUTPUT");
+    if (!outputPath.isEmpty()) {
+        QJsonObject output;
+        output["num_entities"] = NUM_ENTITIES;
+        output["results"] = _results;
+        QFile file(outputPath);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(QJsonDocument(output).toJson());
+    }
+    _tree.reset();
+}
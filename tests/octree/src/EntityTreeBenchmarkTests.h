@@ -0,0 +1,45 @@
+//
+//  EntityTreeBenchmarkTests.h
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeBenchmarkTests_h
+#define hifi_EntityTreeBenchmarkTests_h
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include <EntityTree.h>
+
+// The throughput of a server's entity tree of 100k entities: the edits, the queries, the traversals of the viewers and
+// the persists. The results are also written as JSON to the file named by HIFI_BENCHMARK_OUTPUT, to follow them across
+// releases
+class EntityTreeBenchmarkTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void persistAndLoadJSON();
+    void persistAndLoadBinary();
+    void editThroughput();
+    void rayQueryThroughput();
+    void sphereQueryThroughput();
+    void viewerTraversals();
+    void cleanupTestCase();
+
+private:
+    void persistAndLoad(const QString& fileType);
+    void addResult(const QString& name, double value);
+
+    EntityTreePointer _tree;
+    QTemporaryDir _persistDir;
+    QJsonObject _results;
+};
+
+#endif // hifi_EntityTreeBenchmarkTests_h
@@ -0,0 +1,131 @@
+//
+//  OctreeBinaryFileTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeBinaryFileTests.h"
+
+#include <QtCore/QTemporaryFile>
+
+#include <OctreeBinaryFile.h>
+
+QTEST_MAIN(OctreeBinaryFileTests)
+
+static OctreeBinaryFile::Header makeHeader() {
+    OctreeBinaryFile::Header header;
+    header.dataPacketType = PacketType::EntityData;
+    header.dataPacketVersion = versionForPacketType(PacketType::EntityData);
+    header.id = QUuid::createUuid();
+    header.dataVersion = 42;
+    return header;
+}
+
+// enough records of varying size to span several chunks
+static QVector<QByteArray> makeRecords() {
+    QVector<QByteArray> records;
+    for (int i = 0; i < 2000; i++) {
+        records.push_back(QByteArray(1 + (i * 7919) % 4096, (char)i));
+    }
+    return records;
+}
+
+static void writeFile(QTemporaryFile& file, const OctreeBinaryFile::Header& header, const QVector<QByteArray>& records) {
+    QVERIFY(file.open());
+    OctreeBinaryFile::Writer writer(file);
+    QVERIFY(writer.writeHeader(header));
+    for (const auto& record : records) {
+        QVERIFY(writer.appendRecord(reinterpret_cast<const unsigned char*>(record.constData()), record.size()));
+    }
+    QVERIFY(writer.finish());
+    QCOMPARE(writer.getNumRecords(), records.size());
+    file.close();
+}
+
+void OctreeBinaryFileTests::roundTrip() {
+    auto header = makeHeader();
+    auto records = makeRecords();
+    QTemporaryFile file;
+    writeFile(file, header, records);
+
+    OctreeBinaryFile::Header headerOnly;
+    QVERIFY(OctreeBinaryFile::readHeaderFromFile(file.fileName(), headerOnly));
+    QCOMPARE(headerOnly.id, header.id);
+
+    OctreeBinaryFile::Reader reader;
+    QVERIFY(reader.open(file.fileName()));
+    QCOMPARE(reader.getHeader().dataPacketType, header.dataPacketType);
+    QCOMPARE(reader.getHeader().dataPacketVersion, header.dataPacketVersion);
+    QCOMPARE(reader.getHeader().id, header.id);
+    QCOMPARE(reader.getHeader().dataVersion, header.dataVersion);
+
+    int numRead = 0;
+    QVERIFY(reader.forEachRecord([&](const unsigned char* data, int size) {
+        bool matches = numRead < records.size() && QByteArray(reinterpret_cast<const char*>(data), size) == records[numRead];
+        numRead++;
+        return matches;
+    }));
+    QCOMPARE(numRead, records.size());
+}
+
+void OctreeBinaryFileTests::emptyFile() {
+    QTemporaryFile file;
+    writeFile(file, makeHeader(), {});
+
+    OctreeBinaryFile::Reader reader;
+    QVERIFY(reader.open(file.fileName()));
+    QVERIFY(reader.forEachRecord([](const unsigned char*, int) { return false; }));
+}
+
+void OctreeBinaryFileTests::truncatedFile() {
+    QTemporaryFile file;
+    writeFile(file, makeHeader(), makeRecords());
+    QVERIFY(file.open());
+    QVERIFY(file.resize(file.size() / 2));
+    file.close();
+
+    OctreeBinaryFile::Reader reader;
+    QVERIFY(reader.open(file.fileName()));
+    QVERIFY(!reader.forEachRecord([](const unsigned char*, int) { return true; }));
+
+    // a file that isn't one at all
+    QTemporaryFile notBinary;
+    QVERIFY(notBinary.open());
+    notBinary.write("{ \"Entities\": [] }");
+    notBinary.close();
+    OctreeBinaryFile::Header header;
+    QVERIFY(!OctreeBinaryFile::readHeaderFromFile(notBinary.fileName(), header));
+}
+
+void OctreeBinaryFileTests::tornJournal() {
+    // three appends of one chunk each, the last of which is cut short as if by a crash
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    OctreeBinaryFile::Writer writer(file);
+    QVERIFY(writer.writeHeader(makeHeader()));
+    for (char append = 0; append < 3; append++) {
+        QByteArray record(100, append);
+        QVERIFY(writer.appendRecord(reinterpret_cast<const unsigned char*>(record.constData()), record.size()));
+        QVERIFY(writer.flush());
+    }
+    QVERIFY(file.resize(file.size() - 1));
+    file.close();
+
+    OctreeBinaryFile::Reader reader;
+    QVERIFY(reader.open(file.fileName(), true));
+    QVector<char> appends;
+    QVERIFY(reader.forEachRecord([&](const unsigned char* data, int size) {
+        appends.push_back((char)data[0]);
+        return true;
+    }));
+    QCOMPARE(appends, QVector<char>({ 0, 1 }));
+
+    // the same file isn't a valid snapshot
+    OctreeBinaryFile::Reader snapshotReader;
+    QVERIFY(snapshotReader.open(file.fileName()));
+    QVERIFY(!snapshotReader.forEachRecord([](const unsigned char*, int) { return true; }));
+}
@@ -0,0 +1,26 @@
+//
+//  OctreeBinaryFileTests.h
+//  tests/octree/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeBinaryFileTests_h
+#define hifi_OctreeBinaryFileTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeBinaryFileTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void emptyFile();
+    void truncatedFile();
+    void tornJournal();
+};
+
+#endif // hifi_OctreeBinaryFileTests_h
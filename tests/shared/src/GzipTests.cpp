@@ -0,0 +1,82 @@
+//
+//  GzipTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GzipTests.h"
+
+#include <Gzip.h>
+
+QTEST_MAIN(GzipTests)
+
+// text that compresses like the json of the entity persist files
+static QByteArray makeSource(int size) {
+    QByteArray source;
+    source.reserve(size);
+    quint32 seed = 1;
+    while (source.size() < size) {
+        seed = seed * 1664525u + 1013904223u;
+        source.append("{\"id\":\"").append(QByteArray::number(seed % 1000)).append("\",\"type\":\"Box\"},");
+    }
+    source.resize(size);
+    return source;
+}
+
+void GzipTests::roundTrip() {
+    QByteArray source = makeSource(100 * 1024);
+    QByteArray compressed;
+    QVERIFY(gzip(source, compressed));
+    QVERIFY(compressed.size() < source.size());
+
+    QByteArray uncompressed;
+    QVERIFY(gunzip(compressed, uncompressed));
+    QCOMPARE(uncompressed, source);
+
+    QVERIFY(gzip(QByteArray(), compressed));
+    QVERIFY(compressed.isEmpty());
+}
+
+void GzipTests::parallelRoundTrip() {
+    // large enough to be compressed in blocks, and not a multiple of their size
+    QByteArray source = makeSource(9 * 1024 * 1024 + 12345);
+    for (int level : { 0, 1, -1, 9 }) {
+        QByteArray compressed;
+        QVERIFY(gzip(source, compressed, level));
+
+        QByteArray uncompressed;
+        QVERIFY(gunzip(compressed, uncompressed));
+        QCOMPARE(uncompressed.size(), source.size());
+        QVERIFY(uncompressed == source);
+    }
+}
+
+void GzipTests::concatenatedMembers() {
+    QByteArray first = makeSource(1000);
+    QByteArray second = makeSource(2000);
+    QByteArray firstCompressed;
+    QByteArray secondCompressed;
+    QVERIFY(gzip(first, firstCompressed));
+    QVERIFY(gzip(second, secondCompressed));
+
+    QByteArray uncompressed;
+    QVERIFY(gunzip(firstCompressed + secondCompressed, uncompressed));
+    QCOMPARE(uncompressed, first + second);
+
+    // what follows the last member is ignored
+    QVERIFY(gunzip(firstCompressed + QByteArray(4, '\0'), uncompressed));
+    QCOMPARE(uncompressed, first);
+}
+
+void GzipTests::truncated() {
+    QByteArray compressed;
+    QVERIFY(gzip(makeSource(10000), compressed));
+    compressed.chop(compressed.size() / 2);
+
+    QByteArray uncompressed;
+    QVERIFY(!gunzip(compressed, uncompressed));
+}
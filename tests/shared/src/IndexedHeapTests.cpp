@@ -0,0 +1,155 @@
+//
+//  IndexedHeapTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "IndexedHeapTests.h"
+
+#include <queue>
+#include <random>
+#include <unordered_set>
+
+#include <IndexedHeap.h>
+
+QTEST_MAIN(IndexedHeapTests)
+
+// about the number of entities a send thread has queued, and how many of them get edited while they are
+static const int NUM_KEYS = 10000;
+static const int NUM_EDITS = 20000;
+
+void IndexedHeapTests::orderTest() {
+    IndexedHeap<int, float> heap;
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(0.0f, 1000.0f);
+    for (int i = 0; i < 1000; i++) {
+        heap.set(i, distribution(generator));
+    }
+    QCOMPARE((int)heap.size(), 1000);
+
+    float previous = heap.top();
+    while (!heap.empty()) {
+        QVERIFY(heap.top() <= previous);
+        previous = heap.top();
+        heap.pop();
+    }
+}
+
+void IndexedHeapTests::updateKeyTest() {
+    IndexedHeap<int, float> heap;
+    for (int i = 0; i < 10; i++) {
+        heap.set(i, (float)i);
+    }
+
+    // raised to the top, then lowered to the bottom, without being queued twice
+    heap.set(3, 100.0f);
+    QCOMPARE(heap.topKey(), 3);
+    QCOMPARE((int)heap.size(), 10);
+
+    heap.set(3, -1.0f);
+    QCOMPARE(heap.topKey(), 9);
+    QCOMPARE(*heap.find(3), -1.0f);
+
+    std::vector<int> order;
+    while (!heap.empty()) {
+        order.push_back(heap.topKey());
+        heap.pop();
+    }
+    QCOMPARE(order.size(), (size_t)10);
+    QCOMPARE(order.back(), 3);
+}
+
+void IndexedHeapTests::removeTest() {
+    IndexedHeap<int, float> heap;
+    for (int i = 0; i < 100; i++) {
+        heap.set(i, (float)(i % 17));
+    }
+
+    for (int i = 0; i < 100; i += 3) {
+        QVERIFY(heap.remove(i));
+        QVERIFY(!heap.contains(i));
+    }
+    QVERIFY(!heap.remove(0));
+    QCOMPARE((int)heap.size(), 66);
+
+    float previous = heap.top();
+    while (!heap.empty()) {
+        QVERIFY(heap.topKey() % 3 != 0);
+        QVERIFY(heap.top() <= previous);
+        previous = heap.top();
+        heap.pop();
+    }
+}
+
+void IndexedHeapTests::rebuildTest() {
+    IndexedHeap<int, float> heap;
+    for (int i = 0; i < 100; i++) {
+        heap.set(i, (float)i);
+    }
+
+    // reverse the order and drop the odd keys
+    heap.update([](float& value) {
+        value = 100.0f - value;
+        return (int)value % 2 == 0;
+    });
+    QCOMPARE((int)heap.size(), 50);
+    QCOMPARE(heap.topKey(), 0);
+    QVERIFY(!heap.contains(1));
+
+    float previous = heap.top();
+    while (!heap.empty()) {
+        QVERIFY(heap.top() <= previous);
+        previous = heap.top();
+        heap.pop();
+    }
+}
+
+void IndexedHeapTests::benchmarkIndexedHeap() {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(0.0f, 1000.0f);
+    std::uniform_int_distribution<int> keys(0, NUM_KEYS - 1);
+
+    QBENCHMARK {
+        IndexedHeap<int, float> heap;
+        for (int i = 0; i < NUM_KEYS; i++) {
+            heap.set(i, distribution(generator));
+        }
+        for (int i = 0; i < NUM_EDITS; i++) {
+            heap.set(keys(generator), distribution(generator));
+        }
+        while (!heap.empty()) {
+            heap.pop();
+        }
+    }
+}
+
+// what EntityPriorityQueue did before: an edited entity that is already queued is queued again, and every entry has to
+// be popped, skipping the ones that were queued earlier
+void IndexedHeapTests::benchmarkPriorityQueue() {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(0.0f, 1000.0f);
+    std::uniform_int_distribution<int> keys(0, NUM_KEYS - 1);
+    using Entry = std::pair<float, int>;
+
+    QBENCHMARK {
+        std::priority_queue<Entry> queue;
+        std::unordered_set<int> queued;
+        for (int i = 0; i < NUM_KEYS; i++) {
+            queue.emplace(distribution(generator), i);
+            queued.insert(i);
+        }
+        for (int i = 0; i < NUM_EDITS; i++) {
+            int key = keys(generator);
+            queue.emplace(distribution(generator), key);
+            queued.insert(key);
+        }
+        while (!queue.empty()) {
+            queued.erase(queue.top().second);
+            queue.pop();
+        }
+    }
+}
@@ -0,0 +1,27 @@
+//
+//  IndexedHeapTests.h
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_IndexedHeapTests_h
+#define hifi_IndexedHeapTests_h
+
+#include <QtTest/QtTest>
+
+class IndexedHeapTests : public QObject {
+    Q_OBJECT
+private slots:
+    void orderTest();
+    void updateKeyTest();
+    void removeTest();
+    void rebuildTest();
+    void benchmarkIndexedHeap();
+    void benchmarkPriorityQueue();
+};
+
+#endif // hifi_IndexedHeapTests_h
@@ -0,0 +1,153 @@
+//
+//  MPSCQueueTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MPSCQueueTests.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <GenericQueueThread.h>
+#include <MPSCQueue.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(MPSCQueueTests)
+
+void MPSCQueueTests::pushPopTest() {
+    MPSCQueue<int, 4> queue;
+    int value = -1;
+
+    QVERIFY(queue.isEmpty());
+    QVERIFY(!queue.pop(value));
+
+    QVERIFY(queue.tryPush(1));
+    QVERIFY(queue.tryPush(2));
+    QVERIFY(!queue.isEmpty());
+
+    QVERIFY(queue.pop(value));
+    QCOMPARE(value, 1);
+    QVERIFY(queue.pop(value));
+    QCOMPARE(value, 2);
+
+    QVERIFY(queue.isEmpty());
+    QVERIFY(!queue.pop(value));
+}
+
+void MPSCQueueTests::fullTest() {
+    const size_t CAPACITY = 4;
+    MPSCQueue<int, CAPACITY> queue;
+
+    // go around the ring a few times
+    int next = 0;
+    int expected = 0;
+    for (int round = 0; round < 3; ++round) {
+        for (size_t i = 0; i < CAPACITY; ++i) {
+            QVERIFY(queue.tryPush(next++));
+        }
+        QVERIFY(!queue.tryPush(next));
+
+        std::vector<int> items;
+        QCOMPARE(queue.popBatch(items, 3), (size_t)3);
+        QVERIFY(queue.tryPush(next++));
+        QCOMPARE(queue.popBatch(items), (size_t)2);
+        for (int item : items) {
+            QCOMPARE(item, expected++);
+        }
+        QVERIFY(queue.isEmpty());
+    }
+}
+
+void MPSCQueueTests::threadedTest() {
+    const int NUM_PRODUCERS = 4;
+    const int NUM_ITEMS = 100000;
+    MPSCQueue<int, 64> queue;
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < NUM_PRODUCERS; ++producer) {
+        producers.emplace_back([&queue, producer] {
+            for (int i = 0; i < NUM_ITEMS; ++i) {
+                while (!queue.tryPush(producer * NUM_ITEMS + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // every producer's items come out in the order it pushed them
+    bool isInOrder = true;
+    std::vector<int> expected(NUM_PRODUCERS, 0);
+    int numPopped = 0;
+    int value = -1;
+    while (numPopped < NUM_PRODUCERS * NUM_ITEMS) {
+        if (queue.pop(value)) {
+            int producer = value / NUM_ITEMS;
+            isInOrder = isInOrder && value % NUM_ITEMS == expected[producer];
+            ++expected[producer];
+            ++numPopped;
+        }
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    QVERIFY(isInOrder);
+    QVERIFY(queue.isEmpty());
+}
+
+template <typename Base>
+class CountingQueueThread : public Base {
+public:
+    std::atomic<int> numProcessed { 0 };
+
+protected:
+    bool processQueueItems(const typename Base::Queue& items) override {
+        numProcessed += items.size();
+        return true;
+    }
+};
+
+// how long the producers take to queue their items, and the thread to process them all
+template <typename Thread>
+static quint64 timeQueueThread(int numProducers, int numItems) {
+    Thread thread;
+    thread.initialize(true);
+
+    auto start = usecTimestampNow();
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < numProducers; ++producer) {
+        producers.emplace_back([&thread, numItems] {
+            for (int i = 0; i < numItems; ++i) {
+                thread.queueItem(i);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    while (thread.numProcessed < numProducers * numItems) {
+        std::this_thread::yield();
+    }
+    auto duration = usecTimestampNow() - start;
+
+    thread.terminate();
+    return duration;
+}
+
+void MPSCQueueTests::queueThreadBenchmark() {
+    const int NUM_ITEMS = 200000;
+    for (int numProducers : { 1, 2, 4, 8 }) {
+        auto lockedTime = timeQueueThread<CountingQueueThread<GenericQueueThread<int>>>(numProducers, NUM_ITEMS);
+        auto lockFreeTime = timeQueueThread<CountingQueueThread<GenericMPSCQueueThread<int>>>(numProducers, NUM_ITEMS);
+        qDebug() << numProducers << "producers of" << NUM_ITEMS << "items, GenericQueueThread took"
+            << (float)lockedTime / USECS_PER_MSEC << "ms, GenericMPSCQueueThread took"
+            << (float)lockFreeTime / USECS_PER_MSEC << "ms";
+    }
+}
@@ -0,0 +1,69 @@
+//
+//  PoolAllocatorTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PoolAllocatorTests.h"
+
+#include <set>
+
+#include <PoolAllocator.h>
+
+QTEST_MAIN(PoolAllocatorTests)
+
+struct TestBlock {
+    double values[5];
+};
+
+void PoolAllocatorTests::reuseTest() {
+    using Pool = FixedBlockPool<sizeof(TestBlock), alignof(TestBlock)>;
+    auto& pool = Pool::getInstance();
+
+    std::vector<void*> blocks;
+    std::set<void*> unique;
+    for (int i = 0; i < 1000; i++) {
+        void* block = pool.allocate();
+        QVERIFY((reinterpret_cast<uintptr_t>(block) % alignof(TestBlock)) == 0);
+        blocks.push_back(block);
+        unique.insert(block);
+    }
+    QCOMPARE((int)unique.size(), 1000);
+    QCOMPARE((int)pool.getNumAllocated(), 1000);
+    size_t capacity = pool.getCapacity();
+
+    for (auto block : blocks) {
+        pool.deallocate(block);
+    }
+    QCOMPARE((int)pool.getNumAllocated(), 0);
+
+    // the freed blocks are handed out again before the pool grows
+    for (int i = 0; i < 1000; i++) {
+        QVERIFY(unique.count(pool.allocate()) == 1);
+    }
+    QCOMPARE(pool.getCapacity(), capacity);
+}
+
+void PoolAllocatorTests::sharedPointerTest() {
+    static int numDestroyed = 0;
+    struct Counted {
+        ~Counted() { numDestroyed++; }
+        int value { 0 };
+    };
+
+    {
+        std::vector<std::shared_ptr<Counted>> pointers;
+        for (int i = 0; i < 100; i++) {
+            pointers.push_back(std::allocate_shared<Counted>(PoolAllocator<Counted>()));
+            pointers.back()->value = i;
+        }
+        for (int i = 0; i < 100; i++) {
+            QCOMPARE(pointers[i]->value, i);
+        }
+    }
+    QCOMPARE(numDestroyed, 100);
+}
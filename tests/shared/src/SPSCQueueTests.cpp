@@ -0,0 +1,91 @@
+//
+//  SPSCQueueTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SPSCQueueTests.h"
+
+#include <memory>
+#include <thread>
+
+#include <SPSCQueue.h>
+
+QTEST_MAIN(SPSCQueueTests)
+
+void SPSCQueueTests::pushPopTest() {
+    SPSCQueue<int> queue;
+    int value = -1;
+
+    QVERIFY(queue.isEmpty());
+    QVERIFY(!queue.pop(value));
+
+    queue.push(1);
+    queue.push(2);
+    QVERIFY(!queue.isEmpty());
+
+    QVERIFY(queue.pop(value));
+    QCOMPARE(value, 1);
+    QVERIFY(queue.pop(value));
+    QCOMPARE(value, 2);
+
+    QVERIFY(queue.isEmpty());
+    QVERIFY(!queue.pop(value));
+}
+
+void SPSCQueueTests::blockBoundaryTest() {
+    const size_t BLOCK_SIZE = 4;
+    const int NUM_ITEMS = 37;
+    SPSCQueue<std::shared_ptr<int>, BLOCK_SIZE> queue;
+
+    auto tracked = std::make_shared<int>(-1);
+    queue.push(tracked);
+
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        queue.push(std::make_shared<int>(i));
+    }
+
+    std::shared_ptr<int> value;
+    QVERIFY(queue.pop(value));
+    QCOMPARE(*value, -1);
+    value.reset();
+
+    // the queue must not hang onto items it has already handed out
+    QCOMPARE(tracked.use_count(), 1L);
+
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        QVERIFY(queue.pop(value));
+        QCOMPARE(*value, i);
+    }
+    QVERIFY(!queue.pop(value));
+}
+
+void SPSCQueueTests::threadedTest() {
+    const int NUM_ITEMS = 100000;
+    SPSCQueue<int, 16> queue;
+
+    std::thread producer([&] {
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            queue.push(i);
+        }
+    });
+
+    // don't bail out of the test with the producer still running, check the order once it is done
+    bool isInOrder = true;
+    int expected = 0;
+    int value = -1;
+    while (expected < NUM_ITEMS) {
+        if (queue.pop(value)) {
+            isInOrder = isInOrder && value == expected;
+            ++expected;
+        }
+    }
+
+    producer.join();
+    QVERIFY(isInOrder);
+    QVERIFY(queue.isEmpty());
+}
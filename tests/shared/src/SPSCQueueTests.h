@@ -0,0 +1,24 @@
+//
+//  SPSCQueueTests.h
+//  tests/shared/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SPSCQueueTests_h
+#define hifi_SPSCQueueTests_h
+
+#include <QtTest/QtTest>
+
+class SPSCQueueTests : public QObject {
+    Q_OBJECT
+private slots:
+    void pushPopTest();
+    void blockBoundaryTest();
+    void threadedTest();
+};
+
+#endif // hifi_SPSCQueueTests_h
@@ -9,17 +9,22 @@
 #include "TraceTests.h"
 
 #include <QtTest/QtTest>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtGui/QDesktopServices>
 
 #include <Profile.h>
 
 #include <NumericalConstants.h>
+#include <shared/FileUtils.h>
 #include <test-utils/QTestExtensions.h>
 
 QTEST_MAIN(TraceTests)
 Q_LOGGING_CATEGORY(trace_test, "trace.test")
 
 const QString OUTPUT_FILE = "traces/testTrace.json.gz";
+const QString RECENT_OUTPUT_FILE = "traces/testRecentTrace.json";
 
 void TraceTests::testTraceSerialization() {
     auto tracer = DependencyManager::set<tracing::Tracer>();
@@ -45,3 +50,30 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+void TraceTests::testContinuousTraceSerialization() {
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startContinuousTracing();
+    {
+        auto start = usecTimestampNow();
+        for (size_t i = 0; i < 10000; ++i) {
+            PROFILE_RANGE(test, "TestEvent")
+        }
+        auto duration = usecTimestampNow() - start;
+        duration /= USECS_PER_MSEC;
+        qDebug() << "Recording took " << duration << "ms";
+    }
+    tracer->serializeRecent(RECENT_OUTPUT_FILE, 60.0f);
+    tracer->stopContinuousTracing();
+
+    QFile file(FileUtils::computeDocumentPath(RECENT_OUTPUT_FILE));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    auto events = QJsonDocument::fromJson(file.readAll()).array();
+    // the ring only keeps the most recent events of the thread
+    QVERIFY(events.size() > 0);
+    QVERIFY(events.size() <= (int)tracing::TraceRingBuffer::SIZE);
+    for (const auto& event : events) {
+        if (event.toObject()["ph"].toString() != "M") {
+            QCOMPARE(event.toObject()["name"].toString(), QString("TestEvent"));
+        }
+    }
+}
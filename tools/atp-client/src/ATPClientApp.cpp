@@ -11,6 +11,9 @@
 
 #include "ATPClientApp.h"
 
+#include <algorithm>
+#include <random>
+
 #include <QDataStream>
 #include <QTextStream>
 #include <QThread>
@@ -58,6 +61,16 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
     const QCommandLineOption listenPortOption("listenPort", "listen port", QString::number(INVALID_PORT));
     parser.addOption(listenPortOption);
 
+    const QCommandLineOption loadOption("load", "request the mapped assets for a number of seconds and report on them",
+                                        "seconds");
+    parser.addOption(loadOption);
+
+    const QCommandLineOption concurrencyOption("concurrency", "number of requests in flight with --load", "8");
+    parser.addOption(concurrencyOption);
+
+    const QCommandLineOption rangeOption("range", "request only the first bytes of the assets with --load", "bytes");
+    parser.addOption(rangeOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << endl;
         parser.showHelp();
@@ -126,6 +139,16 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
         _listenPort = parser.value(listenPortOption).toInt();
     }
 
+    if (parser.isSet(loadOption)) {
+        _loadSeconds = parser.value(loadOption).toInt();
+        if (parser.isSet(concurrencyOption)) {
+            _concurrency = std::max(parser.value(concurrencyOption).toInt(), 1);
+        }
+        if (parser.isSet(rangeOption)) {
+            _rangeSize = parser.value(rangeOption).toLongLong();
+        }
+    }
+
     _domainServerAddress = QString("127.0.0.1") + ":" + QString::number(domainPort);
     if (parser.isSet(domainAddressOption)) {
         _domainServerAddress = parser.value(domainAddressOption);
@@ -198,7 +221,10 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
     }
 
     auto assetClient = DependencyManager::set<AssetClient>();
-    assetClient->initCaching();
+    if (_loadSeconds == 0) {
+        // the load goes to the asset server every time
+        assetClient->initCaching();
+    }
 
     if (_verbose) {
         qDebug() << "domain-server address is" << _domainServerAddress;
@@ -206,7 +232,7 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
 
     DependencyManager::get<AddressManager>()->handleLookupString(_domainServerAddress, false);
 
-    QTimer* _timeoutTimer = new QTimer(this);
+    _timeoutTimer = new QTimer(this);
     _timeoutTimer->setSingleShot(true);
     connect(_timeoutTimer, &QTimer::timeout, this, &ATPClientApp::timedOut);
     _timeoutTimer->start(TIMEOUT_MILLISECONDS);
@@ -258,7 +284,9 @@ void ATPClientApp::go() {
         qDebug() << "path is " << path;
     }
 
-    if (!_localUploadFile.isEmpty()) {
+    if (_loadSeconds > 0) {
+        startLoad();
+    } else if (!_localUploadFile.isEmpty()) {
         uploadAsset();
     } else if (path == "/") {
         listAssets();
@@ -391,6 +419,99 @@ void ATPClientApp::download(AssetUtils::AssetHash hash) {
     assetRequest->start();
 }
 
+void ATPClientApp::startLoad() {
+    // the assets of the domain, so that the sizes requested are those of its content
+    auto request = DependencyManager::get<AssetClient>()->createGetAllMappingsRequest();
+    QObject::connect(request, &GetAllMappingsRequest::finished, this, [=](GetAllMappingsRequest* request) mutable {
+        if (request->getError() != GetAllMappingsRequest::NoError) {
+            qDebug() << "error -- " << request->getError() << " -- " << request->getErrorString();
+            request->deleteLater();
+            finish(1);
+            return;
+        }
+        for (auto& kv : request->getMappings()) {
+            _loadHashes.push_back(kv.second.hash);
+        }
+        request->deleteLater();
+
+        std::sort(_loadHashes.begin(), _loadHashes.end());
+        _loadHashes.erase(std::unique(_loadHashes.begin(), _loadHashes.end()), _loadHashes.end());
+        if (_loadHashes.empty()) {
+            qDebug() << "no assets to request";
+            finish(1);
+            return;
+        }
+
+        // the load runs for as long as it was asked to, rather than against the startup timeout
+        _timeoutTimer->stop();
+        _loadStartTime = usecTimestampNow();
+        _loadEndTime = _loadStartTime + _loadSeconds * USECS_PER_SECOND;
+        for (int i = 0; i < _concurrency; i++) {
+            sendLoadRequest();
+        }
+    });
+    request->start();
+}
+
+void ATPClientApp::sendLoadRequest() {
+    static std::mt19937 randomEngine(std::random_device{}());
+
+    if (usecTimestampNow() >= _loadEndTime) {
+        if (_numLoadRequestsInFlight == 0) {
+            reportLoad();
+        }
+        return;
+    }
+
+    std::uniform_int_distribution<size_t> hashDistribution(0, _loadHashes.size() - 1);
+    ByteRange byteRange;
+    if (_rangeSize > 0) {
+        byteRange.toExclusive = _rangeSize;
+    }
+    auto assetRequest = new AssetRequest(_loadHashes[hashDistribution(randomEngine)], byteRange);
+    quint64 startTime = usecTimestampNow();
+    _numLoadRequestsInFlight++;
+
+    connect(assetRequest, &AssetRequest::finished, this, [this, startTime](AssetRequest* request) mutable {
+        _numLoadRequestsInFlight--;
+        if (request->getError() == AssetRequest::Error::NoError) {
+            _loadLatencies.push_back(usecTimestampNow() - startTime);
+            _loadBytes += request->getData().size();
+        } else {
+            _numLoadErrors++;
+            if (_verbose) {
+                qDebug() << "request failed:" << request->getErrorString();
+            }
+        }
+        request->deleteLater();
+        sendLoadRequest();
+    });
+
+    assetRequest->start();
+}
+
+void ATPClientApp::reportLoad() {
+    float seconds = (float)(usecTimestampNow() - _loadStartTime) / USECS_PER_SECOND;
+    std::sort(_loadLatencies.begin(), _loadLatencies.end());
+    auto percentile = [&](float fraction) {
+        if (_loadLatencies.empty()) {
+            return 0.0f;
+        }
+        size_t index = std::min((size_t)(fraction * _loadLatencies.size()), _loadLatencies.size() - 1);
+        return (float)_loadLatencies[index] / USECS_PER_MSEC;
+    };
+
+    QTextStream cout(stdout);
+    cout << "assets: " << _loadHashes.size() << ", concurrency: " << _concurrency << endl;
+    cout << "requests: " << _loadLatencies.size() << ", errors: " << _numLoadErrors << endl;
+    cout << "throughput: " << _loadLatencies.size() / seconds << " requests/s, "
+         << (float)_loadBytes / MB_TO_BYTES(1) / seconds << " MB/s" << endl;
+    cout << "latency (ms): p50 " << percentile(0.5f) << ", p90 " << percentile(0.9f) << ", p99 " << percentile(0.99f)
+         << ", max " << percentile(1.0f) << endl;
+
+    finish(_numLoadErrors > 0 ? 1 : 0);
+}
+
 void ATPClientApp::finish(int exitCode) {
     auto nodeList = DependencyManager::get<NodeList>();
 
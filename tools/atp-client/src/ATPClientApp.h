@@ -46,9 +46,24 @@ private:
     void lookupAsset();
     void listAssets();
     void download(AssetUtils::AssetHash hash);
+    void startLoad();
+    void sendLoadRequest();
+    void reportLoad();
     void finish(int exitCode);
     bool _verbose;
 
+    // the load mode keeps a number of requests for the mapped assets in flight for a while, then reports on them
+    int _loadSeconds { 0 };
+    int _concurrency { 8 };
+    int64_t _rangeSize { 0 };
+    std::vector<AssetUtils::AssetHash> _loadHashes;
+    std::vector<quint64> _loadLatencies;
+    quint64 _loadStartTime { 0 };
+    quint64 _loadEndTime { 0 };
+    int64_t _loadBytes { 0 };
+    int _numLoadErrors { 0 };
+    int _numLoadRequestsInFlight { 0 };
+
     QUrl _url;
     QString _localOutputFile;
     QString _localUploadFile;
@@ -17,7 +17,7 @@
 
 #include <gpu/FrameIO.h>
 
-PlayerWindow::PlayerWindow() {
+PlayerWindow::PlayerWindow(bool visible) {
     installEventFilter(this);
     setFlags(Qt::MSWindowsOwnDC | Qt::Window | Qt::Dialog | Qt::WindowMinMaxButtonsHint | Qt::WindowTitleHint);
 
@@ -29,7 +29,9 @@ PlayerWindow::PlayerWindow() {
 
     setGeometry(QRect(QPoint(), QSize(800, 600)));
     create();
-    show();
+    if (visible) {
+        show();
+    }
     // Ensure the window is visible and the GL context is valid
     QCoreApplication::processEvents();
     _renderThread.initialize(this);
@@ -38,6 +40,14 @@ PlayerWindow::PlayerWindow() {
 PlayerWindow::~PlayerWindow() {
 }
 
+void PlayerWindow::benchmark(size_t warmup, size_t iterations, const RenderThread::BenchmarkHandler& handler) {
+    _renderThread.startBenchmark(warmup, iterations, handler);
+}
+
+void PlayerWindow::stop() {
+    _renderThread.terminate();
+}
+
 bool PlayerWindow::eventFilter(QObject* obj, QEvent* event)  {
     if (event->type() == QEvent::Close) {
         _renderThread.terminate();
@@ -106,13 +116,14 @@ void PlayerWindow::resizeEvent(QResizeEvent* ev) {
     _renderThread.resize(ev->size());
 }
 
-void PlayerWindow::loadFrame(const QString& path) {
+bool PlayerWindow::loadFrame(const QString& path) {
     auto frame = gpu::readFrame(path.toStdString(), _renderThread._externalTexture);
-    if (frame) {
-        _renderThread.submitFrame(frame);
-        if (!_renderThread.isThreaded()) {
-            _renderThread.process();
-        }
+    if (!frame) {
+        return false;
+    }
+    _renderThread.submitFrame(frame);
+    if (!_renderThread.isThreaded()) {
+        _renderThread.process();
     }
     if (frame->framebuffer) {
         const auto& fbo = *frame->framebuffer;
@@ -125,4 +136,5 @@ void PlayerWindow::loadFrame(const QString& path) {
         }
         resize(size.x, size.y);
     }
+    return true;
 }
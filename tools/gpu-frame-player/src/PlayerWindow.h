@@ -17,15 +17,19 @@
 class PlayerWindow : public QWindow {
 public:
 
-    PlayerWindow();
+    // A benchmark doesn't need the window to be shown, it only replays the frame in its context
+    PlayerWindow(bool visible = true);
     virtual ~PlayerWindow();
 
+    bool loadFrame(const QString& path);
+    void benchmark(size_t warmup, size_t iterations, const RenderThread::BenchmarkHandler& handler);
+    void stop();
+
 protected:
     bool eventFilter(QObject* obj, QEvent* event) override;
     void keyPressEvent(QKeyEvent* event) override;
     void resizeEvent(QResizeEvent* ev) override;
     void loadFrame();
-    void loadFrame(const QString& path);
 
 private:
     static void textureLoader(const std::vector<uint8_t>& filename, const gpu::TexturePointer& texture, uint16_t layer);
@@ -7,14 +7,30 @@
 //
 
 #include "RenderThread.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <QtCore/QJsonArray>
 #include <QtGui/QWindow>
 #include <gl/QOpenGLContextWrapper.h>
+#include <SharedUtil.h>
 
 void RenderThread::submitFrame(const gpu::FramePointer& frame) {
     std::unique_lock<std::mutex> lock(_frameLock);
     _pendingFrames.push(frame);
 }
 
+void RenderThread::startBenchmark(size_t warmup, size_t iterations, const BenchmarkHandler& handler) {
+    auto benchmark = std::make_shared<Benchmark>();
+    benchmark->warmup = warmup;
+    benchmark->iterations = std::max<size_t>(iterations, 1);
+    benchmark->handler = handler;
+
+    std::unique_lock<std::mutex> lock(_frameLock);
+    _pendingBenchmark = benchmark;
+}
+
 void RenderThread::resize(const QSize& newSize) {
     std::unique_lock<std::mutex> lock(_frameLock);
     _pendingSize.push(newSize);
@@ -169,6 +185,16 @@ void RenderThread::renderFrame(gpu::FramePointer& frame) {
     glClear(GL_DEPTH_BUFFER_BIT);
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
 
+    if (_benchmark) {
+        if (frame && !frame->batches.empty()) {
+            benchmarkFrame(frame);
+        }
+#ifdef USE_GL
+        _context.doneCurrent();
+#endif
+        return;
+    }
+
     //_gpuContext->enableStereo(true);
     if (frame && !frame->batches.empty()) {
         _gpuContext->executeFrame(frame);
@@ -219,6 +245,105 @@ void RenderThread::renderFrame(gpu::FramePointer& frame) {
 #endif
 }
 
+void RenderThread::benchmarkFrame(const gpu::FramePointer& frame) {
+    auto& benchmark = *_benchmark;
+    const auto& batches = frame->batches;
+    if (benchmark.batchQueries.size() != batches.size()) {
+        benchmark.batchQueries.clear();
+        for (size_t i = 0; i < batches.size(); ++i) {
+            auto benchmarkPointer = &benchmark;
+            benchmark.batchQueries.push_back(std::make_shared<gpu::Query>([benchmarkPointer, i](const gpu::Query& query) {
+                if (benchmarkPointer->replayIndex >= benchmarkPointer->warmup) {
+                    benchmarkPointer->batchGPUTimes[i] += query.getGPUElapsedTime();
+                    benchmarkPointer->replayGPUTime += query.getGPUElapsedTime();
+                }
+            }, batches[i]->getName()));
+        }
+        benchmark.batchCPUTimes.assign(batches.size(), 0.0);
+        benchmark.batchGPUTimes.assign(batches.size(), 0.0);
+    }
+    bool isTimed = benchmark.replayIndex >= benchmark.warmup;
+
+    _backend->setStereoState(frame->stereoState);
+    double replayCPUTime = 0.0;
+    benchmark.replayGPUTime = 0.0;
+    for (size_t i = 0; i < batches.size(); ++i) {
+        const auto& query = benchmark.batchQueries[i];
+        _gpuContext->executeBatch("RenderThread::benchmarkFrame::begin", [&](gpu::Batch& batch) {
+            batch.beginQuery(query);
+        });
+        auto start = usecTimestampNow();
+        _backend->render(*batches[i]);
+        double batchCPUTime = (double)(usecTimestampNow() - start) / (double)USECS_PER_MSEC;
+        _gpuContext->executeBatch("RenderThread::benchmarkFrame::end", [&](gpu::Batch& batch) {
+            batch.endQuery(query);
+        });
+        replayCPUTime += batchCPUTime;
+        if (isTimed) {
+            benchmark.batchCPUTimes[i] += batchCPUTime;
+        }
+    }
+
+    // The queries only come back once the GPU is done with the replay, waiting for it keeps each one
+    // to its own replay
+    glFinish();
+    _gpuContext->executeBatch("RenderThread::benchmarkFrame::results", [&](gpu::Batch& batch) {
+        for (const auto& query : benchmark.batchQueries) {
+            batch.getQuery(query);
+        }
+    });
+    (void)CHECK_GL_ERROR();
+
+    if (isTimed) {
+        benchmark.frameCPUTimes.push_back(replayCPUTime);
+        benchmark.frameGPUTimes.push_back(benchmark.replayGPUTime);
+    }
+    ++benchmark.replayIndex;
+    if (benchmark.replayIndex >= benchmark.warmup + benchmark.iterations) {
+        auto results = getBenchmarkResults(frame);
+        auto handler = benchmark.handler;
+        _benchmark.reset();
+        if (handler) {
+            handler(results);
+        }
+    }
+}
+
+static QJsonObject getTimingStats(std::vector<double> times) {
+    QJsonObject stats;
+    if (times.empty()) {
+        return stats;
+    }
+    std::sort(times.begin(), times.end());
+    stats["mean"] = std::accumulate(times.begin(), times.end(), 0.0) / (double)times.size();
+    stats["median"] = times[times.size() / 2];
+    stats["min"] = times.front();
+    stats["max"] = times.back();
+    return stats;
+}
+
+QJsonObject RenderThread::getBenchmarkResults(const gpu::FramePointer& frame) const {
+    const auto& benchmark = *_benchmark;
+    double iterations = (double)benchmark.iterations;
+
+    QJsonArray batches;
+    for (size_t i = 0; i < frame->batches.size(); ++i) {
+        QJsonObject batch;
+        batch["name"] = QString::fromStdString(frame->batches[i]->getName());
+        batch["cpu"] = benchmark.batchCPUTimes[i] / iterations;
+        batch["gpu"] = benchmark.batchGPUTimes[i] / iterations;
+        batches.append(batch);
+    }
+
+    QJsonObject results;
+    results["iterations"] = (int)benchmark.iterations;
+    results["backend"] = QString::fromStdString(_backend->getVersion());
+    results["cpu"] = getTimingStats(benchmark.frameCPUTimes);
+    results["gpu"] = getTimingStats(benchmark.frameGPUTimes);
+    results["batches"] = batches;
+    return results;
+}
+
 bool RenderThread::process() {
     std::queue<gpu::FramePointer> pendingFrames;
     std::queue<QSize> pendingSize;
@@ -227,6 +352,10 @@ bool RenderThread::process() {
         std::unique_lock<std::mutex> lock(_frameLock);
         pendingFrames.swap(_pendingFrames);
         pendingSize.swap(_pendingSize);
+        if (_pendingBenchmark) {
+            _benchmark = _pendingBenchmark;
+            _pendingBenchmark.reset();
+        }
     }
     
     while (!pendingFrames.empty()) {
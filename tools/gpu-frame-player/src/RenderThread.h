@@ -9,6 +9,7 @@
 #pragma once
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
 
 #include <GenericThread.h>
 #include <shared/RateCounter.h>
@@ -25,6 +26,9 @@
 class RenderThread : public GenericThread {
     using Parent = GenericThread;
 public:
+    // Called from the render thread with the timings of a benchmark
+    using BenchmarkHandler = std::function<void(const QJsonObject& results)>;
+
     QWindow* _window{ nullptr };
 
 #ifdef USE_GL
@@ -59,6 +63,30 @@ public:
     glm::mat4 _correction;
     gpu::PipelinePointer _presentPipeline;
 
+    // Replays of the active frame, each of its batches between its own GPU query, instead of presenting it
+    struct Benchmark {
+        size_t warmup { 0 };
+        size_t iterations { 0 };
+        BenchmarkHandler handler;
+
+        size_t replayIndex { 0 };
+        gpu::Queries batchQueries;
+        // in msecs, summed over the timed replays
+        std::vector<double> batchCPUTimes;
+        std::vector<double> batchGPUTimes;
+        // in msecs, one per timed replay
+        std::vector<double> frameCPUTimes;
+        std::vector<double> frameGPUTimes;
+        double replayGPUTime { 0.0 };
+    };
+    std::shared_ptr<Benchmark> _pendingBenchmark;
+    std::shared_ptr<Benchmark> _benchmark;
+
+    // Replays the active frame warmup times and then iterations times more that are timed
+    void startBenchmark(size_t warmup, size_t iterations, const BenchmarkHandler& handler);
+    void benchmarkFrame(const gpu::FramePointer& frame);
+    QJsonObject getBenchmarkResults(const gpu::FramePointer& frame) const;
+
     void resize(const QSize& newSize);
     void setup() override;
     bool process() override;
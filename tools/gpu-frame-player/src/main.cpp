@@ -6,6 +6,10 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
 #include <QtWidgets/QApplication>
 
 #include <shared/FileLogger.h>
@@ -22,13 +26,122 @@ static void setup() {
     DependencyManager::set<tracing::Tracer>(); 
 }
 
+static const int BENCHMARK_REGRESSION = 1;
+static const int BENCHMARK_FAILURE = 2;
+
+static QJsonObject readJson(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonObject();
+    }
+    return QJsonDocument::fromJson(file.readAll()).object();
+}
+
+static bool writeJson(const QString& path, const QJsonObject& object) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    file.write(QJsonDocument(object).toJson());
+    return true;
+}
+
+// Logs the timings that are more than tolerance (a fraction) above the baseline, returns how many there are
+static int compareToBaseline(const QJsonObject& results, const QJsonObject& baseline, double tolerance) {
+    int regressions = 0;
+    auto compare = [&](const QString& name, double time, double baselineTime) {
+        if (baselineTime > 0.0 && time > baselineTime * (1.0 + tolerance)) {
+            qCWarning(gpu_player_logging) << name << "took" << time << "msecs instead of" << baselineTime;
+            ++regressions;
+        }
+    };
+
+    for (const auto& key : { "cpu", "gpu" }) {
+        compare(QString("frame %1").arg(key), results[key].toObject()["median"].toDouble(),
+            baseline[key].toObject()["median"].toDouble());
+    }
+
+    // the batches only compare if they are the same ones, as they would be for the same capture
+    auto batches = results["batches"].toArray();
+    auto baselineBatches = baseline["batches"].toArray();
+    if (batches.size() != baselineBatches.size()) {
+        qCWarning(gpu_player_logging) << "The baseline has" << baselineBatches.size() << "batches instead of" << batches.size();
+        return regressions;
+    }
+    for (int i = 0; i < batches.size(); ++i) {
+        auto batch = batches[i].toObject();
+        auto baselineBatch = baselineBatches[i].toObject();
+        auto name = QString("batch %1 %2").arg(i).arg(batch["name"].toString());
+        compare(name + " cpu", batch["cpu"].toDouble(), baselineBatch["cpu"].toDouble());
+        compare(name + " gpu", batch["gpu"].toDouble(), baselineBatch["gpu"].toDouble());
+    }
+    return regressions;
+}
+
 int main(int argc, char** argv) {
     setupHifiApplication("gpuFramePlayer");
 
     QApplication app(argc, argv);
     logger.reset(new FileLogger());
     setup();
-    PlayerWindow window;
-    app.exec();
-    return 0;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Plays captured gpu frames, use -platform offscreen to benchmark without a display");
+    parser.addHelpOption();
+    parser.addPositionalArgument("frame", "Captured frame (.hfb) to play");
+    QCommandLineOption benchmarkOption("benchmark", "Replay the frame <iterations> times and quit with their timings", "iterations");
+    QCommandLineOption warmupOption("warmup", "Replays before the timed ones, default 10", "iterations", "10");
+    QCommandLineOption resultsOption("results", "Write the benchmark timings to <file> as JSON", "file");
+    QCommandLineOption baselineOption("baseline", "Compare the benchmark timings to the ones in <file>", "file");
+    QCommandLineOption toleranceOption("tolerance", "Percentage a timing can go over its baseline, default 10", "percent", "10");
+    parser.addOption(benchmarkOption);
+    parser.addOption(warmupOption);
+    parser.addOption(resultsOption);
+    parser.addOption(baselineOption);
+    parser.addOption(toleranceOption);
+    parser.process(app);
+
+    auto arguments = parser.positionalArguments();
+    bool isBenchmark = parser.isSet(benchmarkOption);
+    if (isBenchmark && arguments.empty()) {
+        qCCritical(gpu_player_logging) << "A benchmark needs a frame to replay";
+        return BENCHMARK_FAILURE;
+    }
+
+    PlayerWindow window(!isBenchmark);
+    if (!arguments.empty() && !window.loadFrame(arguments.front())) {
+        qCCritical(gpu_player_logging) << "Unable to load frame" << arguments.front();
+        if (isBenchmark) {
+            return BENCHMARK_FAILURE;
+        }
+    }
+
+    if (isBenchmark) {
+        auto resultsPath = parser.value(resultsOption);
+        auto baselinePath = parser.value(baselineOption);
+        double tolerance = parser.value(toleranceOption).toDouble() / 100.0;
+        window.benchmark(parser.value(warmupOption).toUInt(), parser.value(benchmarkOption).toUInt(), [&](const QJsonObject& results) {
+            QMetaObject::invokeMethod(&app, [&, results] {
+                int exitCode = 0;
+                qCInfo(gpu_player_logging).noquote() << QJsonDocument(results).toJson();
+                if (!resultsPath.isEmpty() && !writeJson(resultsPath, results)) {
+                    qCWarning(gpu_player_logging) << "Unable to write the results to" << resultsPath;
+                    exitCode = BENCHMARK_FAILURE;
+                }
+                if (!baselinePath.isEmpty()) {
+                    auto baseline = readJson(baselinePath);
+                    if (baseline.isEmpty()) {
+                        qCWarning(gpu_player_logging) << "Unable to read the baseline" << baselinePath;
+                        exitCode = BENCHMARK_FAILURE;
+                    } else if (compareToBaseline(results, baseline, tolerance) > 0) {
+                        exitCode = BENCHMARK_REGRESSION;
+                    }
+                }
+                window.stop();
+                app.exit(exitCode);
+            });
+        });
+    }
+
+    return app.exec();
 }
@@ -21,6 +21,7 @@
 #include "OvenCLIApplication.h"
 #include "ModelBakingLoggingCategory.h"
 #include "baking/BakerLibrary.h"
+#include "DomainBaker.h"
 #include "JSBaker.h"
 #include "TextureBaker.h"
 #include "MaterialBaker.h"
@@ -29,7 +30,7 @@ BakerCLI::BakerCLI(OvenCLIApplication* parent) : QObject(parent) {
     
 }
 
-void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type) {
+void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type, const QUrl& destinationUrl) {
 
     // if the URL doesn't have a scheme, assume it is a local file
     if (inputUrl.scheme() != "http" && inputUrl.scheme() != "https" && inputUrl.scheme() != "ftp" && inputUrl.scheme() != "file") {
@@ -42,6 +43,7 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
     static const QString FBX_EXTENSION { "fbx" };     // legacy
     static const QString MATERIAL_EXTENSION { "material" };
     static const QString SCRIPT_EXTENSION { "js" };
+    static const QString DOMAIN_EXTENSION { "domain" };
 
     _outputPath = outputPath;
 
@@ -58,6 +60,12 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
         // FIXME: disabled for now because it breaks some scripts
         //_baker = std::unique_ptr<Baker> { new JSBaker(inputUrl, outputPath) };
         //_baker->moveToThread(Oven::instance().getNextWorkerThread());
+    } else if (type == DOMAIN_EXTENSION) {
+        // the input is the entities file of a domain, everything it references is baked in one batch, next to a report of
+        // how long each bake took. Its URLs are re-written to the destination, or to the output folder without one
+        QUrl bakedContentURL = !destinationUrl.isEmpty() ? destinationUrl : QUrl::fromLocalFile(outputPath);
+        _baker = std::unique_ptr<Baker> { new DomainBaker(inputUrl, QString(), outputPath, bakedContentURL, false) };
+        _baker->moveToThread(Oven::instance().getNextWorkerThread());
     } else if (type == MATERIAL_EXTENSION) {
         _baker = std::unique_ptr<Baker> { new MaterialBaker(inputUrl.toDisplayString(), true, outputPath) };
         _baker->moveToThread(Oven::instance().getNextWorkerThread());
@@ -19,6 +19,7 @@
 
 #include "Gzip.h"
 #include "Oven.h"
+#include "baking/BakeScheduler.h"
 #include "baking/BakerLibrary.h"
 
 DomainBaker::DomainBaker(const QUrl& localModelFileURL, const QString& domainName,
@@ -38,6 +39,8 @@ DomainBaker::DomainBaker(const QUrl& localModelFileURL, const QString& domainNam
 }
 
 void DomainBaker::bake() {
+    startStages();
+
     setupOutputFolder();
 
     if (hasErrors()) {
@@ -55,6 +58,7 @@ void DomainBaker::bake() {
     if (hasErrors()) {
         return;
     }
+    endStage("enumerate");
 
     // in case we've baked and re-written all of our entities already, check if we're done
     checkIfRewritingComplete();
@@ -211,9 +215,8 @@ void DomainBaker::addTextureBaker(const QString& property, const QString& url, i
             // insert it into our bakers hash so we hold a strong pointer to it
             _textureBakers.insert(key, textureBaker);
 
-            // move the baker to a worker thread and kickoff the bake
-            textureBaker->moveToThread(Oven::instance().getNextWorkerThread());
-            QMetaObject::invokeMethod(textureBaker.data(), "bake", Qt::QueuedConnection);
+            // queue the bake, it starts on a worker thread once one is free
+            BakeScheduler::instance().schedule(textureBaker.data());
 
             // keep track of the total number of baking entities
             ++_totalNumberOfSubBakes;
@@ -247,9 +250,8 @@ void DomainBaker::addScriptBaker(const QString& property, const QString& url, co
         // insert it into our bakers hash so we hold a strong pointer to it
         _scriptBakers.insert(scriptURL, scriptBaker);
 
-        // move the baker to a worker thread and kickoff the bake
-        scriptBaker->moveToThread(Oven::instance().getNextWorkerThread());
-        QMetaObject::invokeMethod(scriptBaker.data(), "bake", Qt::QueuedConnection);
+        // queue the bake, it starts on a worker thread once one is free
+        BakeScheduler::instance().schedule(scriptBaker.data());
 
         // keep track of the total number of baking entities
         ++_totalNumberOfSubBakes;
@@ -484,6 +486,8 @@ void DomainBaker::handleFinishedModelBaker() {
             _warningList << baker->getErrors();
         }
 
+        addToBakeReport("model", baker->getModelURL().toString(), *baker);
+
         // remove the baked URL from the multi hash of entities needing a re-write
         _entitiesNeedingRewrite.remove(baker->getOriginalInputModelURL());
 
@@ -560,6 +564,8 @@ void DomainBaker::handleFinishedTextureBaker() {
             _warningList << baker->getWarnings();
         }
 
+        addToBakeReport("texture", baker->getTextureURL().toString(), *baker, baker->isCached());
+
         // remove the baked URL from the multi hash of entities needing a re-write
         _entitiesNeedingRewrite.remove(rewriteKey);
 
@@ -634,6 +640,8 @@ void DomainBaker::handleFinishedScriptBaker() {
             _warningList << baker->getErrors();
         }
 
+        addToBakeReport("script", baker->getJSPath(), *baker);
+
         // remove the baked URL from the multi hash of entities needing a re-write
         _entitiesNeedingRewrite.remove(baker->getJSPath());
 
@@ -724,6 +732,8 @@ void DomainBaker::handleFinishedMaterialBaker() {
             _warningList << baker->getErrors();
         }
 
+        addToBakeReport("material", baker->isURL() ? baker->getMaterialData() : QString(), *baker);
+
         // remove the baked URL from the multi hash of entities needing a re-write
         _entitiesNeedingRewrite.remove(baker->getMaterialData());
 
@@ -740,11 +750,16 @@ void DomainBaker::handleFinishedMaterialBaker() {
 
 void DomainBaker::checkIfRewritingComplete() {
     if (_entitiesNeedingRewrite.isEmpty()) {
+        endStage("bake");
+
         writeNewEntitiesFile();
 
         if (hasErrors()) {
             return;
         }
+        endStage("write");
+
+        writeBakeReport();
 
         // we've now written out our new models file - time to say that we are finished up
         emit finished();
@@ -783,3 +798,58 @@ void DomainBaker::writeNewEntitiesFile() {
 
     qDebug() << "Exported baked entities file to" << bakedEntitiesFilePath;
 }
+
+static QJsonObject stageTimesToJson(const std::vector<std::pair<QString, qint64>>& stageTimes) {
+    QJsonObject json;
+    for (const auto& stageTime : stageTimes) {
+        json[stageTime.first] = (double)stageTime.second;
+    }
+    return json;
+}
+
+void DomainBaker::addToBakeReport(const QString& type, const QString& input, const Baker& baker, bool isCached) {
+    QJsonObject bake;
+    bake["type"] = type;
+    if (!input.isEmpty()) {
+        bake["input"] = input;
+    }
+    bake["succeeded"] = !baker.hasErrors();
+    if (isCached) {
+        bake["cached"] = true;
+    }
+    bake["stages"] = stageTimesToJson(baker.getStageTimes());
+    _bakeReport.append(bake);
+
+    // the summed times of the stages of each type of bake
+    auto totals = _bakeReportTotals[type].toObject();
+    for (const auto& stageTime : baker.getStageTimes()) {
+        totals[stageTime.first] = totals[stageTime.first].toDouble() + (double)stageTime.second;
+    }
+    totals["count"] = totals["count"].toInt() + 1;
+    if (isCached) {
+        totals["cached"] = totals["cached"].toInt() + 1;
+    }
+    _bakeReportTotals[type] = totals;
+}
+
+void DomainBaker::writeBakeReport() {
+    // the milliseconds spent in each stage of the bake of the domain and of each of the bakes it ran, next to the models file
+    QJsonObject json;
+    json["domain"] = _domainName;
+    json["stages"] = stageTimesToJson(getStageTimes());
+    json["totals"] = _bakeReportTotals;
+    json["bakes"] = _bakeReport;
+
+    static const QString BAKE_REPORT_FILE_NAME = "bake-report.json";
+
+    auto bakeReportFilePath = QDir(_uniqueOutputPath).filePath(BAKE_REPORT_FILE_NAME);
+    QFile bakeReportFile { bakeReportFilePath };
+
+    // the report is only informative, not being able to write it doesn't fail the bake
+    if (!bakeReportFile.open(QIODevice::WriteOnly) || bakeReportFile.write(QJsonDocument(json).toJson()) == -1) {
+        handleWarning("Failed to export bake report");
+        return;
+    }
+
+    qDebug() << "Exported bake report to" << bakeReportFilePath;
+}
@@ -14,6 +14,7 @@
 
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
 #include <QtCore/QUrl>
 #include <QtCore/QThread>
@@ -50,6 +51,8 @@ private:
     void enumerateEntities();
     void checkIfRewritingComplete();
     void writeNewEntitiesFile();
+    void addToBakeReport(const QString& type, const QString& input, const Baker& baker, bool isCached = false);
+    void writeBakeReport();
 
     QUrl _localEntitiesFileURL;
     QString _domainName;
@@ -71,6 +74,9 @@ private:
     
     QMultiHash<QUrl, std::pair<QString, QJsonValueRef>> _entitiesNeedingRewrite;
 
+    QJsonArray _bakeReport;
+    QJsonObject _bakeReportTotals;
+
     int _totalNumberOfSubBakes { 0 };
     int _completedSubBakes { 0 };
 
@@ -27,7 +27,7 @@
 #include <FBXSerializer.h>
 #include <OBJSerializer.h>
 
-#include "MaterialBaker.h"
+#include "baking/BakeScheduler.h"
 
 Oven* Oven::_staticInstance { nullptr };
 
@@ -45,9 +45,12 @@ Oven::Oven() {
     DependencyManager::set<TextureCache>();
     DependencyManager::set<MaterialCache>();
 
-    MaterialBaker::setNextOvenWorkerThreadOperator([] {
+    // the textures and scripts are baked by as many bakers at a time as there are worker threads
+    auto& bakeScheduler = BakeScheduler::instance();
+    bakeScheduler.setWorkerThreadOperator([] {
         return Oven::instance().getNextWorkerThread();
     });
+    bakeScheduler.setMaxConcurrentBakes((int)_workerThreads.size());
 
     {
         auto modelFormatRegistry = DependencyManager::set<ModelFormatRegistry>();
@@ -84,9 +87,8 @@ void Oven::setupWorkerThreads(int numWorkerThreads) {
 }
 
 QThread* Oven::getNextWorkerThread() {
-    // FIXME: we assign these threads when we make the bakers, but if certain bakers finish quickly, we could end up
-    // in a situation where threads have finished and others have tons of work queued.  Instead of assigning them at initialization,
-    // we should build a queue of bakers, and when threads finish, they can take the next available baker.
+    // The bakes that don't wait on others are queued by the BakeScheduler, which only starts as many of them at a time as
+    // there are threads, so that they don't all compete for the cores and the memory at once.
 
     // Here we replicate some of the functionality of QThreadPool by giving callers an available worker thread to use.
     // We can't use QThreadPool because we want to put QObjects with signals/slots on these threads.
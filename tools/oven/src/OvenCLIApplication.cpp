@@ -17,6 +17,7 @@
 #include <iostream>
 
 #include <image/TextureProcessing.h>
+#include <MaterialBaker.h>
 #include <TextureBaker.h>
 
 #include "BakerCLI.h"
@@ -24,18 +25,23 @@
 static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
+static const QString CLI_DESTINATION_PARAMETER = "d";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_ENABLE_TEXTURE_ATLASES_PARAMETER = "enable-texture-atlases";
+static const QString CLI_BAKE_CACHE_PARAMETER = "bake-cache";
 
 QUrl OvenCLIApplication::_inputUrlParameter;
 QUrl OvenCLIApplication::_outputUrlParameter;
 QString OvenCLIApplication::_typeParameter;
+QUrl OvenCLIApplication::_destinationUrlParameter;
 
 OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
 {
     BakerCLI* cli = new BakerCLI(this);
     QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, _inputUrlParameter),
-                              Q_ARG(QString, _outputUrlParameter.toString()), Q_ARG(QString, _typeParameter));
+                              Q_ARG(QString, _outputUrlParameter.toString()), Q_ARG(QString, _typeParameter),
+                              Q_ARG(QUrl, _destinationUrlParameter));
 }
 
 void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
@@ -46,8 +52,11 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
     parser.addOptions({
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
-        { CLI_TYPE_PARAMETER, "Type of asset. [model|material]"/*|js]"*/, "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_TYPE_PARAMETER, "Type of asset. [model|material|domain]"/*|js]"*/, "type" },
+        { CLI_DESTINATION_PARAMETER, "URL the baked content of a domain will be served from.", "destination" },
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_ENABLE_TEXTURE_ATLASES_PARAMETER, "Pack the small textures of the materials of models into atlases." },
+        { CLI_BAKE_CACHE_PARAMETER, "Path to folder where baked textures are kept and reused by their content.", "cache" }
     });
 
     auto versionOption = parser.addVersionOption();
@@ -86,9 +95,23 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
     _outputUrlParameter = QDir::fromNativeSeparators(parser.value(CLI_OUTPUT_PARAMETER));
 
     _typeParameter = parser.isSet(CLI_TYPE_PARAMETER) ? parser.value(CLI_TYPE_PARAMETER) : QString::null;
+    if (parser.isSet(CLI_DESTINATION_PARAMETER)) {
+        _destinationUrlParameter = QUrl(parser.value(CLI_DESTINATION_PARAMETER));
+    }
 
     if (parser.isSet(CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER)) {
         qDebug() << "Disabling texture compression";
         TextureBaker::setCompressionEnabled(false);
     }
+
+    if (parser.isSet(CLI_ENABLE_TEXTURE_ATLASES_PARAMETER)) {
+        qDebug() << "Enabling texture atlases";
+        MaterialBaker::setTextureAtlasesEnabled(true);
+    }
+
+    if (parser.isSet(CLI_BAKE_CACHE_PARAMETER)) {
+        auto bakeCacheDirectory = QDir::fromNativeSeparators(parser.value(CLI_BAKE_CACHE_PARAMETER));
+        qDebug() << "Using bake cache" << bakeCacheDirectory;
+        TextureBaker::setBakeCacheDirectory(bakeCacheDirectory);
+    }
 }
@@ -0,0 +1,508 @@
+//
+//  UDTBenchmark.cpp
+//  tools/udt-test/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UDTBenchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+
+#include <SharedUtil.h>
+
+#include <udt/Packet.h>
+#include <udt/PacketList.h>
+
+static const double BYTES_PER_MEGABYTE = 1000000.0;
+static const double USECS_PER_SECOND = 1000000.0;
+static const double USECS_PER_MSEC = 1000.0;
+
+static const int UNRELIABLE_SEND_INTERVAL_MSECS = 10;
+
+// every packet and message starts with the time it was queued so the receiver can measure latency
+static const int TIMESTAMP_BYTES = sizeof(quint64);
+
+static const char* kindName(BenchmarkSender::Kind kind) {
+    switch (kind) {
+        case BenchmarkSender::Kind::Reliable:
+            return "reliable";
+        case BenchmarkSender::Kind::Unreliable:
+            return "unreliable";
+        case BenchmarkSender::Kind::Ordered:
+            return "ordered";
+    }
+    return "unknown";
+}
+
+static bool kindForName(const QString& name, BenchmarkSender::Kind& kind) {
+    for (auto candidate : { BenchmarkSender::Kind::Reliable, BenchmarkSender::Kind::Unreliable,
+                            BenchmarkSender::Kind::Ordered }) {
+        if (name == kindName(candidate)) {
+            kind = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+ImpairedLink::ImpairedLink(const HifiSockAddr& receiverAddr, double loss, int latencyUsecs, int jitterUsecs,
+                           QObject* parent) :
+    QObject(parent),
+    _receiverAddr(receiverAddr),
+    _loss(loss),
+    _latencyUsecs(latencyUsecs),
+    _jitterUsecs(jitterUsecs)
+{
+    _socket.bind(QHostAddress::LocalHost, 0);
+    connect(&_socket, &QUdpSocket::readyRead, this, &ImpairedLink::readDatagrams);
+
+    _sendTimer.setSingleShot(true);
+    _sendTimer.setTimerType(Qt::PreciseTimer);
+    connect(&_sendTimer, &QTimer::timeout, this, &ImpairedLink::sendDueDatagrams);
+}
+
+void ImpairedLink::readDatagrams() {
+    std::uniform_real_distribution<double> lossDistribution(0.0, 1.0);
+    std::uniform_int_distribution<int> jitterDistribution(-_jitterUsecs, _jitterUsecs);
+
+    while (_socket.hasPendingDatagrams()) {
+        QByteArray data(_socket.pendingDatagramSize(), 0);
+        QHostAddress senderAddress;
+        quint16 senderPort;
+        _socket.readDatagram(data.data(), data.size(), &senderAddress, &senderPort);
+
+        HifiSockAddr sender(senderAddress, senderPort);
+        HifiSockAddr destination;
+
+        if (sender == _receiverAddr) {
+            destination = _senderAddr;
+        } else {
+            _senderAddr = sender;
+            destination = _receiverAddr;
+        }
+
+        if (destination.isNull() || lossDistribution(_generator) < _loss) {
+            ++_numDroppedDatagrams;
+            continue;
+        }
+
+        int delayUsecs = std::max(0, _latencyUsecs + (_jitterUsecs > 0 ? jitterDistribution(_generator) : 0));
+        if (delayUsecs == 0 && _delayedDatagrams.empty()) {
+            _socket.writeDatagram(data, destination.getAddress(), destination.getPort());
+        } else {
+            _delayedDatagrams.emplace(usecTimestampNow() + delayUsecs, Datagram { data, destination });
+        }
+    }
+
+    scheduleNextSend();
+}
+
+void ImpairedLink::sendDueDatagrams() {
+    auto now = usecTimestampNow();
+
+    while (!_delayedDatagrams.empty() && _delayedDatagrams.begin()->first <= now) {
+        const auto& datagram = _delayedDatagrams.begin()->second;
+        _socket.writeDatagram(datagram.data, datagram.destination.getAddress(), datagram.destination.getPort());
+        _delayedDatagrams.erase(_delayedDatagrams.begin());
+    }
+
+    scheduleNextSend();
+}
+
+void ImpairedLink::scheduleNextSend() {
+    if (_delayedDatagrams.empty()) {
+        _sendTimer.stop();
+        return;
+    }
+
+    auto now = usecTimestampNow();
+    auto due = _delayedDatagrams.begin()->first;
+    _sendTimer.start(due > now ? (int)((due - now) / USECS_PER_MSEC) : 0);
+}
+
+BenchmarkSender::BenchmarkSender(const Config& config, const HifiSockAddr& target, QObject* parent) :
+    QObject(parent),
+    _config(config),
+    _target(target)
+{
+    _socket.bind(QHostAddress::LocalHost, 0);
+
+    _unreliableTimer.setTimerType(Qt::PreciseTimer);
+    connect(&_unreliableTimer, &QTimer::timeout, this, &BenchmarkSender::sendUnreliablePackets);
+}
+
+void BenchmarkSender::start() {
+    if (_config.kind == Kind::Unreliable) {
+        _unreliableStartUsecs = usecTimestampNow();
+        _unreliableTimer.start(UNRELIABLE_SEND_INTERVAL_MSECS);
+        return;
+    }
+
+    do {
+        if (_config.kind == Kind::Ordered) {
+            queueMessage();
+        } else {
+            queuePacket();
+        }
+    } while (_queuedPackets < _config.window);
+
+    // the connection exists now that we have written to it, top the queue back up as packets go out
+    _socket.connectToSendSignal(_target, this, SLOT(packetSent()));
+}
+
+void BenchmarkSender::stop() {
+    _isStopped = true;
+    _unreliableTimer.stop();
+}
+
+void BenchmarkSender::packetSent() {
+    ++_sentPackets;
+
+    while (!_isStopped && _queuedPackets - _sentPackets < _config.window) {
+        if (_config.kind == Kind::Ordered) {
+            queueMessage();
+        } else {
+            queuePacket();
+        }
+    }
+}
+
+void BenchmarkSender::sendUnreliablePackets() {
+    auto elapsedUsecs = usecTimestampNow() - _unreliableStartUsecs;
+    auto expectedPackets = (int)(_config.rate * (elapsedUsecs / USECS_PER_SECOND));
+
+    while (!_isStopped && _queuedPackets < expectedPackets) {
+        queuePacket();
+    }
+}
+
+void BenchmarkSender::queuePacket() {
+    bool isReliable = _config.kind == Kind::Reliable;
+    int payloadSize = std::max(TIMESTAMP_BYTES, _config.packetSize - udt::Packet::localHeaderSize(false));
+
+    auto packet = udt::Packet::create(payloadSize, isReliable);
+    packet->setPayloadSize(payloadSize);
+
+    quint64 now = usecTimestampNow();
+    memcpy(packet->getPayload(), &now, TIMESTAMP_BYTES);
+
+    _queuedBytes += payloadSize;
+    ++_queuedPackets;
+
+    if (isReliable) {
+        _socket.writePacket(std::move(packet), _target);
+    } else {
+        _socket.writePacket(*packet, _target);
+    }
+}
+
+void BenchmarkSender::queueMessage() {
+    auto packetList = udt::PacketList::create(PacketType::BulkAvatarData, QByteArray(), true, true);
+
+    QByteArray data(std::max(TIMESTAMP_BYTES, _config.messageSize), 0);
+    quint64 now = usecTimestampNow();
+    data.replace(0, TIMESTAMP_BYTES, reinterpret_cast<const char*>(&now), TIMESTAMP_BYTES);
+
+    packetList->write(data);
+    packetList->closeCurrentPacket();
+
+    _queuedBytes += packetList->getDataSize();
+    _queuedPackets += (int)packetList->getNumPackets();
+
+    _socket.writePacketList(std::move(packetList), _target);
+}
+
+UDTBenchmark::UDTBenchmark(const QString& scenarioPath, const QString& resultsPath, QObject* parent) :
+    QObject(parent),
+    _resultsPath(resultsPath)
+{
+    QFile scenarioFile(scenarioPath);
+    if (!scenarioFile.open(QIODevice::ReadOnly)) {
+        qCritical() << "Could not open scenario file" << scenarioPath;
+        return;
+    }
+
+    QJsonParseError error;
+    auto document = QJsonDocument::fromJson(scenarioFile.readAll(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        qCritical() << "Could not parse scenario file" << scenarioPath << "-" << error.errorString();
+        return;
+    }
+
+    // a file is either a single scenario, a list of them, or an object with a "scenarios" list
+    if (document.isArray()) {
+        _scenarios = document.array();
+    } else if (document.object().contains("scenarios")) {
+        _scenarios = document.object().value("scenarios").toArray();
+    } else {
+        _scenarios.append(document.object());
+    }
+}
+
+void UDTBenchmark::start() {
+    if (_scenarios.isEmpty()) {
+        fail("No scenarios to run");
+        return;
+    }
+
+    _currentScenario = 0;
+    startScenario();
+}
+
+void UDTBenchmark::startScenario() {
+    static const int DEFAULT_DURATION_SECONDS = 10;
+
+    _scenario = _scenarios[_currentScenario].toObject();
+    auto name = _scenario.value("name").toString(QString("scenario-%1").arg(_currentScenario));
+
+    double loss = _scenario.value("loss").toDouble(0.0);
+    int latencyUsecs = (int)(_scenario.value("latency").toDouble(0.0) * USECS_PER_MSEC);
+    int jitterUsecs = (int)(_scenario.value("jitter").toDouble(0.0) * USECS_PER_MSEC);
+
+    _receiver.reset(new udt::Socket());
+    _receiver->bind(QHostAddress::LocalHost, 0);
+    _receiver->setPacketHandler([this](std::unique_ptr<udt::Packet> packet) { receivePacket(std::move(packet)); });
+    _receiver->setMessageHandler([this](std::unique_ptr<udt::Packet> packet) {
+        receiveMessagePacket(std::move(packet));
+    });
+    _receiver->setMessageFailureHandler([this](HifiSockAddr from, udt::Packet::MessageNumber messageNumber) {
+        _pendingMessages[from].erase(messageNumber);
+    });
+
+    HifiSockAddr receiverAddr(QHostAddress::LocalHost, _receiver->localPort());
+
+    for (const auto& streamValue : _scenario.value("streams").toArray()) {
+        const auto streamObject = streamValue.toObject();
+
+        StreamResults stream;
+        if (!kindForName(streamObject.value("type").toString("reliable"), stream.config.kind)) {
+            fail("Unknown stream type " + streamObject.value("type").toString() + " in scenario " + name);
+            return;
+        }
+
+        stream.config.packetSize = streamObject.value("packetSize").toInt(stream.config.packetSize);
+        stream.config.messageSize = streamObject.value("messageSize").toInt(stream.config.messageSize);
+        stream.config.window = std::max(1, streamObject.value("window").toInt(stream.config.window));
+        stream.config.rate = streamObject.value("rate").toInt(stream.config.rate);
+        stream.numConnections = std::max(1, streamObject.value("connections").toInt(1));
+
+        if (stream.config.packetSize > udt::MAX_PACKET_SIZE) {
+            fail(QString("Packet size %1 is larger than the max of %2 in scenario %3")
+                 .arg(stream.config.packetSize).arg(udt::MAX_PACKET_SIZE).arg(name));
+            return;
+        }
+
+        int streamIndex = (int)_streams.size();
+        _streams.push_back(stream);
+
+        for (int i = 0; i < stream.numConnections; ++i) {
+            _links.emplace_back(new ImpairedLink(receiverAddr, loss, latencyUsecs, jitterUsecs));
+            _streamForLink[_links.back()->getSockAddr()] = streamIndex;
+            _senders.emplace_back(new BenchmarkSender(stream.config, _links.back()->getSockAddr()));
+        }
+    }
+
+    if (_senders.empty()) {
+        fail("Scenario " + name + " has no streams");
+        return;
+    }
+
+    qDebug() << "Running scenario" << name << "with" << _senders.size() << "connections";
+
+    _startUsecs = usecTimestampNow();
+    _startCPU = std::clock();
+
+    for (auto& sender : _senders) {
+        sender->start();
+    }
+
+    int durationMsecs = (int)(_scenario.value("duration").toDouble(DEFAULT_DURATION_SECONDS) * 1000);
+    QTimer::singleShot(durationMsecs, this, &UDTBenchmark::finishScenario);
+}
+
+void UDTBenchmark::receivePacket(std::unique_ptr<udt::Packet> packet) {
+    auto it = _streamForLink.find(packet->getSenderSockAddr());
+    if (it == _streamForLink.end() || packet->getPayloadSize() < TIMESTAMP_BYTES) {
+        return;
+    }
+
+    auto& stream = _streams[it->second];
+    stream.receivedBytes += packet->getPayloadSize();
+    ++stream.receivedPackets;
+
+    quint64 queuedUsecs;
+    memcpy(&queuedUsecs, packet->getPayload(), TIMESTAMP_BYTES);
+    stream.latencySamples.push_back((int)(usecTimestampNow() - queuedUsecs));
+}
+
+void UDTBenchmark::receiveMessagePacket(std::unique_ptr<udt::Packet> packet) {
+    auto it = _streamForLink.find(packet->getSenderSockAddr());
+    if (it == _streamForLink.end()) {
+        return;
+    }
+
+    auto& stream = _streams[it->second];
+    stream.receivedBytes += packet->getPayloadSize();
+    ++stream.receivedPackets;
+
+    auto& pendingMessages = _pendingMessages[packet->getSenderSockAddr()];
+    auto position = packet->getPacketPosition();
+    auto messageNumber = packet->getMessageNumber();
+
+    if (position == udt::Packet::FIRST || position == udt::Packet::ONLY) {
+        if (packet->getPayloadSize() < TIMESTAMP_BYTES) {
+            return;
+        }
+
+        quint64 queuedUsecs;
+        memcpy(&queuedUsecs, packet->getPayload(), TIMESTAMP_BYTES);
+        pendingMessages[messageNumber] = queuedUsecs;
+    }
+
+    if (position == udt::Packet::LAST || position == udt::Packet::ONLY) {
+        auto messageIt = pendingMessages.find(messageNumber);
+        if (messageIt != pendingMessages.end()) {
+            stream.latencySamples.push_back((int)(usecTimestampNow() - messageIt->second));
+            ++stream.receivedMessages;
+            pendingMessages.erase(messageIt);
+        }
+    }
+}
+
+static QJsonObject latencyPercentiles(std::vector<int>& samples) {
+    QJsonObject latency;
+    if (samples.empty()) {
+        return latency;
+    }
+
+    auto percentile = [&samples](double fraction) {
+        auto nth = samples.begin() + (size_t)(fraction * (samples.size() - 1));
+        std::nth_element(samples.begin(), nth, samples.end());
+        return *nth / USECS_PER_MSEC;
+    };
+
+    latency["p50"] = percentile(0.5);
+    latency["p99"] = percentile(0.99);
+    latency["max"] = *std::max_element(samples.begin(), samples.end()) / USECS_PER_MSEC;
+    return latency;
+}
+
+QJsonObject UDTBenchmark::resultsForScenario() {
+    double elapsedSeconds = (usecTimestampNow() - _startUsecs) / USECS_PER_SECOND;
+    double cpuSeconds = (double)(std::clock() - _startCPU) / CLOCKS_PER_SEC;
+
+    QJsonArray streams;
+    std::vector<int> allSamples;
+    quint64 totalReceivedBytes = 0;
+
+    size_t senderIndex = 0;
+    for (auto& stream : _streams) {
+        quint64 queuedBytes = 0;
+        int queuedPackets = 0;
+        int retransmittedPackets = 0;
+        int droppedDatagrams = 0;
+
+        for (int i = 0; i < stream.numConnections; ++i, ++senderIndex) {
+            auto& sender = _senders[senderIndex];
+            queuedBytes += sender->getQueuedBytes();
+            queuedPackets += sender->getQueuedPackets();
+            droppedDatagrams += _links[senderIndex]->getNumDroppedDatagrams();
+
+            for (const auto& stats : sender->getSocket().sampleStatsForAllConnections()) {
+                retransmittedPackets += stats.second.retransmittedPackets;
+            }
+        }
+
+        QJsonObject streamObject;
+        streamObject["type"] = kindName(stream.config.kind);
+        streamObject["connections"] = stream.numConnections;
+        streamObject["queuedPackets"] = queuedPackets;
+        streamObject["queuedBytes"] = (double)queuedBytes;
+        streamObject["receivedPackets"] = stream.receivedPackets;
+        streamObject["receivedBytes"] = (double)stream.receivedBytes;
+        streamObject["retransmittedPackets"] = retransmittedPackets;
+        streamObject["droppedDatagrams"] = droppedDatagrams;
+        if (stream.config.kind == BenchmarkSender::Kind::Ordered) {
+            streamObject["receivedMessages"] = stream.receivedMessages;
+        }
+        streamObject["throughputMbps"] = stream.receivedBytes * 8.0 / BYTES_PER_MEGABYTE / elapsedSeconds;
+        streamObject["latencyMsecs"] = latencyPercentiles(stream.latencySamples);
+
+        totalReceivedBytes += stream.receivedBytes;
+        allSamples.insert(allSamples.end(), stream.latencySamples.begin(), stream.latencySamples.end());
+
+        streams.append(streamObject);
+    }
+
+    double receivedMegabytes = totalReceivedBytes / BYTES_PER_MEGABYTE;
+
+    QJsonObject results;
+    results["name"] = _scenario.value("name").toString(QString("scenario-%1").arg(_currentScenario));
+    results["scenario"] = _scenario;
+    results["durationSeconds"] = elapsedSeconds;
+    results["throughputMbps"] = receivedMegabytes * 8.0 / elapsedSeconds;
+    results["latencyMsecs"] = latencyPercentiles(allSamples);
+    results["cpuSeconds"] = cpuSeconds;
+    results["cpuSecondsPerMB"] = receivedMegabytes > 0.0 ? cpuSeconds / receivedMegabytes : 0.0;
+    results["streams"] = streams;
+    return results;
+}
+
+void UDTBenchmark::finishScenario() {
+    for (auto& sender : _senders) {
+        sender->stop();
+    }
+
+    auto results = resultsForScenario();
+    qDebug() << "Scenario" << results.value("name").toString() << "received"
+        << results.value("throughputMbps").toDouble() << "Mb/s";
+    _results.append(results);
+
+    _receiver->setPacketHandler(nullptr);
+    _receiver->setMessageHandler(nullptr);
+    _receiver->setMessageFailureHandler(nullptr);
+
+    _senders.clear();
+    _links.clear();
+    _receiver.reset();
+    _streams.clear();
+    _streamForLink.clear();
+    _pendingMessages.clear();
+
+    if (++_currentScenario < _scenarios.size()) {
+        startScenario();
+        return;
+    }
+
+    QJsonObject output;
+    output["scenarios"] = _results;
+    auto json = QJsonDocument(output).toJson();
+
+    if (_resultsPath.isEmpty()) {
+        fprintf(stdout, "%s", json.constData());
+        fflush(stdout);
+    } else {
+        QFile resultsFile(_resultsPath);
+        if (!resultsFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || resultsFile.write(json) != json.size()) {
+            fail("Could not write results to " + _resultsPath);
+            return;
+        }
+    }
+
+    emit finished(true);
+}
+
+void UDTBenchmark::fail(const QString& reason) {
+    qCritical() << qPrintable(reason);
+    emit finished(false);
+}
@@ -0,0 +1,174 @@
+//
+//  UDTBenchmark.h
+//  tools/udt-test/src
+//
+//  Copyright 2020 Project Athena Contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_UDTBenchmark_h
+#define hifi_UDTBenchmark_h
+
+#include <ctime>
+#include <map>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtNetwork/QUdpSocket>
+
+#include <udt/Socket.h>
+
+// Forwards datagrams between one sender and the receiver over loopback, dropping and delaying them
+// in both directions to stand in for a real network path.
+class ImpairedLink : public QObject {
+    Q_OBJECT
+public:
+    ImpairedLink(const HifiSockAddr& receiverAddr, double loss, int latencyUsecs, int jitterUsecs, QObject* parent = nullptr);
+
+    HifiSockAddr getSockAddr() const { return HifiSockAddr(QHostAddress::LocalHost, _socket.localPort()); }
+
+    int getNumDroppedDatagrams() const { return _numDroppedDatagrams; }
+
+private slots:
+    void readDatagrams();
+    void sendDueDatagrams();
+
+private:
+    struct Datagram {
+        QByteArray data;
+        HifiSockAddr destination;
+    };
+
+    void scheduleNextSend();
+
+    QUdpSocket _socket;
+    QTimer _sendTimer;
+
+    HifiSockAddr _receiverAddr;
+    HifiSockAddr _senderAddr; // learned from the first datagram that does not come from the receiver
+
+    double _loss;
+    int _latencyUsecs;
+    int _jitterUsecs;
+
+    std::multimap<quint64, Datagram> _delayedDatagrams; // keyed by the time they are due
+
+    std::mt19937 _generator { std::random_device()() };
+
+    int _numDroppedDatagrams { 0 };
+};
+
+// One sending connection of a scenario, keeps its own send queue topped up with packets of a single kind.
+class BenchmarkSender : public QObject {
+    Q_OBJECT
+public:
+    enum class Kind {
+        Reliable,
+        Unreliable,
+        Ordered
+    };
+
+    struct Config {
+        Kind kind { Kind::Reliable };
+        int packetSize { udt::MAX_PACKET_SIZE };
+        int messageSize { 1000000 };
+        int window { 500 }; // packets kept queued for reliable and ordered sending
+        int rate { 1000 }; // packets per second for unreliable sending
+    };
+
+    BenchmarkSender(const Config& config, const HifiSockAddr& target, QObject* parent = nullptr);
+
+    void start();
+    void stop();
+
+    udt::Socket& getSocket() { return _socket; }
+
+    quint64 getQueuedBytes() const { return _queuedBytes; }
+    int getQueuedPackets() const { return _queuedPackets; }
+
+private slots:
+    void packetSent();
+    void sendUnreliablePackets();
+
+private:
+    void queuePacket();
+    void queueMessage();
+
+    Config _config;
+    udt::Socket _socket;
+    HifiSockAddr _target;
+
+    QTimer _unreliableTimer;
+    quint64 _unreliableStartUsecs { 0 };
+
+    bool _isStopped { false };
+
+    quint64 _queuedBytes { 0 };
+    int _queuedPackets { 0 };
+    int _sentPackets { 0 };
+};
+
+// Runs the scenarios in a JSON scenario file one after the other and writes the results as JSON.
+//
+// Every connection of a scenario sends from its own socket, through its own ImpairedLink, to a single receiving
+// socket, all in this process. Latency is measured from the time a packet (or the first packet of a message) is
+// queued until it is handed to the receiver, so it includes queueing in the SendQueue. CPU time is for the
+// whole process and so covers both ends of every connection.
+class UDTBenchmark : public QObject {
+    Q_OBJECT
+public:
+    UDTBenchmark(const QString& scenarioPath, const QString& resultsPath, QObject* parent = nullptr);
+
+    void start();
+
+signals:
+    void finished(bool success);
+
+private slots:
+    void finishScenario();
+
+private:
+    struct StreamResults {
+        BenchmarkSender::Config config;
+        int numConnections { 0 };
+        quint64 receivedBytes { 0 };
+        int receivedPackets { 0 };
+        int receivedMessages { 0 };
+        std::vector<int> latencySamples; // usecs
+    };
+
+    void startScenario();
+    void receivePacket(std::unique_ptr<udt::Packet> packet);
+    void receiveMessagePacket(std::unique_ptr<udt::Packet> packet);
+    QJsonObject resultsForScenario();
+    void fail(const QString& reason);
+
+    QString _resultsPath;
+    QJsonArray _scenarios;
+    QJsonArray _results;
+    int _currentScenario { -1 };
+
+    QJsonObject _scenario;
+    std::unique_ptr<udt::Socket> _receiver;
+    std::vector<std::unique_ptr<ImpairedLink>> _links;
+    std::vector<std::unique_ptr<BenchmarkSender>> _senders;
+    std::vector<StreamResults> _streams;
+    std::unordered_map<HifiSockAddr, int> _streamForLink; // the receiver sees each connection as its link
+    // queue time of the first packet of every message still being received, by link and message number
+    std::unordered_map<HifiSockAddr, std::unordered_map<udt::Packet::MessageNumber, quint64>> _pendingMessages;
+
+    quint64 _startUsecs { 0 };
+    std::clock_t _startCPU { 0 };
+};
+
+#endif // hifi_UDTBenchmark_h
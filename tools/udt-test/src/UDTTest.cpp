@@ -55,6 +55,12 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption SCENARIO_OPTION {
+    "scenario", "run the benchmark scenarios in a JSON file over loopback instead of the interactive test", "path"
+};
+const QCommandLineOption RESULTS_OPTION {
+    "results", "file to write benchmark results to as JSON (default is stdout)", "path"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
@@ -70,6 +76,15 @@ UDTTest::UDTTest(int& argc, char** argv) :
     QCoreApplication(argc, argv)
 {
     parseArguments();
+
+    if (_argumentParser.isSet(SCENARIO_OPTION)) {
+        _benchmark = new UDTBenchmark(_argumentParser.value(SCENARIO_OPTION), _argumentParser.value(RESULTS_OPTION), this);
+        connect(_benchmark, &UDTBenchmark::finished, this, [](bool success) {
+            QCoreApplication::exit(success ? 0 : 1);
+        });
+        QMetaObject::invokeMethod(this, [this] { _benchmark->start(); }, Qt::QueuedConnection);
+        return;
+    }
     
     // randomize the seed for packet size randomization
     srand(time(NULL));
@@ -224,7 +239,7 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, SCENARIO_OPTION, RESULTS_OPTION
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -414,7 +429,7 @@ void UDTTest::sampleStats() {
                 QString::number(stats.rtt / USECS_PER_MSEC, 'f', 2).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
                 QString::number(stats.congestionWindowSize).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
                 QString::number(stats.events[udt::ConnectionStats::Stats::SentACK]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
-                QString::number(stats.events[udt::ConnectionStats::Stats::Duplicate]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size())
+                QString::number(stats.duplicatePackets).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size())
             };
             
             // output this line of values
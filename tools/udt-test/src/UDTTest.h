@@ -25,6 +25,8 @@
 
 #include <ReceivedMessage.h>
 
+#include "UDTBenchmark.h"
+
 struct Message {
     udt::MessageNumber messageNumber;
     QByteArray data;
@@ -71,6 +73,8 @@ private:
     int _totalQueuedBytes { 0 }; // keeps track of the number of bytes we have already queued
     
     int _statsInterval { 100 }; // recording interval for stats in milliseconds
+
+    UDTBenchmark* _benchmark { nullptr }; // set when running scenarios instead of the interactive test
 };
 
 #endif // hifi_UDTTest_h